@@ -0,0 +1,98 @@
+#include "base/arena.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace base
+{
+// static
+size_t constexpr Arena::kDefaultBlockSize;
+
+Arena::Arena(size_t blockSize) : m_blockSize(max(blockSize, static_cast<size_t>(1))) {}
+
+// static
+Arena & Arena::ThreadLocal()
+{
+  thread_local Arena arena;
+  return arena;
+}
+
+void * Arena::Allocate(size_t size, size_t alignment)
+{
+  ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, (alignment));
+
+  ++m_stats.m_allocations;
+  m_stats.m_allocatedBytes += size;
+
+  if (auto * p = TryAllocate(size, alignment))
+    return p;
+
+  // Blocks after the current one are left from previous scopes.
+  while (m_position.m_block + 1 < m_blocks.size())
+  {
+    m_usedBefore += m_blocks[m_position.m_block].m_size;
+    ++m_position.m_block;
+    m_position.m_offset = 0;
+    if (auto * p = TryAllocate(size, alignment))
+      return p;
+  }
+
+  Block block;
+  block.m_size = max(m_blockSize, size + alignment);
+  block.m_data.reset(new char[block.m_size]);
+  ++m_stats.m_blockAllocations;
+  m_stats.m_reservedBytes += block.m_size;
+
+  if (!m_blocks.empty())
+  {
+    m_usedBefore += m_blocks[m_position.m_block].m_size;
+    ++m_position.m_block;
+  }
+  m_position.m_offset = 0;
+  m_blocks.push_back(move(block));
+
+  auto * p = TryAllocate(size, alignment);
+  CHECK(p, (size, alignment));
+  return p;
+}
+
+void Arena::Release()
+{
+  m_blocks.clear();
+  m_position = Position();
+  m_usedBefore = 0;
+  m_stats.m_reservedBytes = 0;
+  m_stats.m_usedBytes = 0;
+}
+
+void * Arena::TryAllocate(size_t size, size_t alignment)
+{
+  if (m_position.m_block >= m_blocks.size())
+    return nullptr;
+
+  auto const & block = m_blocks[m_position.m_block];
+  auto const base = reinterpret_cast<uintptr_t>(block.m_data.get());
+  auto const begin = ((base + m_position.m_offset + alignment - 1) & ~(alignment - 1)) - base;
+  if (begin > block.m_size || block.m_size - begin < size)
+    return nullptr;
+
+  m_position.m_offset = begin + size;
+  m_stats.m_usedBytes = m_usedBefore + m_position.m_offset;
+  m_stats.m_peakUsedBytes = max(m_stats.m_peakUsedBytes, m_stats.m_usedBytes);
+  return block.m_data.get() + begin;
+}
+
+void Arena::Rewind(Position const & position)
+{
+  ASSERT(position.m_block < m_position.m_block ||
+             (position.m_block == m_position.m_block && position.m_offset <= m_position.m_offset),
+         ("Scopes of the arena aren't nested."));
+
+  m_position = position;
+  m_usedBefore = 0;
+  for (size_t i = 0; i < m_position.m_block && i < m_blocks.size(); ++i)
+    m_usedBefore += m_blocks[i].m_size;
+  m_stats.m_usedBytes = m_usedBefore + m_position.m_offset;
+}
+}  // namespace base
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace base
+{
+// Monotonic allocator for short-lived scratch memory.
+//
+// Memory is taken from large blocks by bumping a pointer and isn't freed by deallocations.
+// Instead, Scope rewinds the arena to the position it had when the scope was opened, so
+// the blocks are reused by the next scopes and no system allocations are made after warm-up.
+//
+// *NOTE* The arena isn't thread-safe. Use ThreadLocal() and open a Scope around the code which
+// allocates scratch containers, the containers must be destroyed before the scope.
+class Arena
+{
+public:
+  struct Stats
+  {
+    // Number and total size of allocations from the arena.
+    uint64_t m_allocations = 0;
+    uint64_t m_allocatedBytes = 0;
+    // Number of blocks taken from the system.
+    uint64_t m_blockAllocations = 0;
+    size_t m_reservedBytes = 0;
+    size_t m_usedBytes = 0;
+    size_t m_peakUsedBytes = 0;
+  };
+
+  // Position of the next allocation.
+  struct Position
+  {
+    size_t m_block = 0;
+    size_t m_offset = 0;
+  };
+
+  // Rewinds the arena when destroyed. Scopes must be nested.
+  class Scope
+  {
+  public:
+    explicit Scope(Arena & arena = ThreadLocal()) : m_arena(arena), m_position(arena.m_position) {}
+    ~Scope() { m_arena.Rewind(m_position); }
+
+  private:
+    Arena & m_arena;
+    Position const m_position;
+
+    DISALLOW_COPY_AND_MOVE(Scope);
+  };
+
+  static size_t constexpr kDefaultBlockSize = 64 * 1024;
+
+  explicit Arena(size_t blockSize = kDefaultBlockSize);
+
+  // The arena of the calling thread.
+  static Arena & ThreadLocal();
+
+  // |alignment| must be a power of two.
+  void * Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  // Rewinds the arena to the beginning, blocks are kept.
+  void Reset() { Rewind(Position()); }
+  // Returns blocks to the system. Must not be called inside of scopes.
+  void Release();
+
+  Stats const & GetStats() const { return m_stats; }
+
+private:
+  struct Block
+  {
+    std::unique_ptr<char[]> m_data;
+    size_t m_size = 0;
+  };
+
+  void * TryAllocate(size_t size, size_t alignment);
+  void Rewind(Position const & position);
+
+  size_t const m_blockSize;
+  std::vector<Block> m_blocks;
+  Position m_position;
+  // Total size of blocks before the current one.
+  size_t m_usedBefore = 0;
+  Stats m_stats;
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+};
+
+// Allocator over Arena for standard containers. Deallocation is a no-op, the memory is
+// returned by rewinding the arena.
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  ArenaAllocator() : m_arena(&Arena::ThreadLocal()) {}
+  explicit ArenaAllocator(Arena & arena) : m_arena(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const & other) : m_arena(&other.GetArena())
+  {
+  }
+
+  T * allocate(size_t n)
+  {
+    CHECK_LESS_OR_EQUAL(n, std::numeric_limits<size_t>::max() / sizeof(T), ());
+    return static_cast<T *>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) {}
+
+  Arena & GetArena() const { return *m_arena; }
+
+  template <typename U>
+  bool operator==(ArenaAllocator<U> const & rhs) const
+  {
+    return m_arena == &rhs.GetArena();
+  }
+
+  template <typename U>
+  bool operator!=(ArenaAllocator<U> const & rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+private:
+  Arena * m_arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+}  // namespace base
@@ -0,0 +1,120 @@
+#include "testing/testing.hpp"
+
+#include "base/arena.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+bool IsAligned(void const * p, size_t alignment)
+{
+  return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+UNIT_TEST(Arena_Allocate)
+{
+  Arena arena(1024 /* blockSize */);
+
+  auto * a = arena.Allocate(1, 1);
+  auto * b = arena.Allocate(8, 8);
+  auto * c = arena.Allocate(3, 64);
+  TEST(IsAligned(b, 8), ());
+  TEST(IsAligned(c, 64), ());
+  TEST_LESS(a, b, ());
+  TEST_LESS(b, c, ());
+
+  // Allocations larger than a block get their own blocks.
+  auto * big = arena.Allocate(4096, 16);
+  TEST(IsAligned(big, 16), ());
+
+  auto const & stats = arena.GetStats();
+  TEST_EQUAL(stats.m_allocations, 4, ());
+  TEST_EQUAL(stats.m_allocatedBytes, 1 + 8 + 3 + 4096, ());
+  TEST_EQUAL(stats.m_blockAllocations, 2, ());
+  TEST_GREATER_OR_EQUAL(stats.m_reservedBytes, 1024 + 4096, ());
+  TEST_GREATER_OR_EQUAL(stats.m_usedBytes, 1024 + 4096, ());
+}
+
+UNIT_TEST(Arena_Scopes)
+{
+  Arena arena(256 /* blockSize */);
+  void * outer = nullptr;
+  {
+    Arena::Scope scope(arena);
+    outer = arena.Allocate(16);
+    void * inner = nullptr;
+    {
+      Arena::Scope nested(arena);
+      inner = arena.Allocate(16);
+      for (size_t i = 0; i < 100; ++i)
+        arena.Allocate(16);
+    }
+
+    // The nested scope returned its memory.
+    TEST_EQUAL(arena.Allocate(16), inner, ());
+  }
+
+  auto const blocks = arena.GetStats().m_blockAllocations;
+  TEST_GREATER(blocks, 1, ());
+  TEST_EQUAL(arena.GetStats().m_usedBytes, 0, ());
+
+  // Blocks are reused by the next scopes.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    Arena::Scope scope(arena);
+    TEST_EQUAL(arena.Allocate(16), outer, ());
+    for (size_t j = 0; j < 100; ++j)
+      arena.Allocate(16);
+  }
+  TEST_EQUAL(arena.GetStats().m_blockAllocations, blocks, ());
+  TEST_GREATER_OR_EQUAL(arena.GetStats().m_peakUsedBytes, 101 * 16, ());
+
+  arena.Release();
+  TEST_EQUAL(arena.GetStats().m_reservedBytes, 0, ());
+  TEST_EQUAL(arena.GetStats().m_usedBytes, 0, ());
+}
+
+UNIT_TEST(Arena_Containers)
+{
+  Arena arena;
+  Arena::Scope scope(arena);
+
+  ArenaVector<int> v{ArenaAllocator<int>(arena)};
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  TEST_EQUAL(v.size(), 1000, ());
+  TEST_EQUAL(v[999], 999, ());
+
+  ArenaString s{ArenaAllocator<char>(arena)};
+  s = "a long string which doesn't fit into the small buffer of std::string";
+  s += s;
+  TEST_EQUAL(string(s.begin(), s.end()).size(), s.size(), ());
+
+  using Map = map<int, int, less<int>, ArenaAllocator<pair<int const, int>>>;
+  Map m{less<int>(), ArenaAllocator<pair<int const, int>>(arena)};
+  for (int i = 0; i < 100; ++i)
+    m[i] = i * i;
+  TEST_EQUAL(m[9], 81, ());
+
+  TEST(ArenaAllocator<int>(arena) == ArenaAllocator<char>(arena), ());
+  TEST(ArenaAllocator<int>(arena) != ArenaAllocator<int>(), ());
+}
+
+UNIT_TEST(Arena_ThreadLocal)
+{
+  auto & arena = Arena::ThreadLocal();
+  auto const used = arena.GetStats().m_usedBytes;
+  {
+    Arena::Scope scope;
+    ArenaVector<double> v(100, 1.0);
+    TEST_EQUAL(&v.get_allocator().GetArena(), &arena, ());
+    TEST_GREATER(arena.GetStats().m_usedBytes, used, ());
+  }
+  TEST_EQUAL(arena.GetStats().m_usedBytes, used, ());
+}
+}  // namespace
@@ -93,6 +93,26 @@ UNIT_TEST(BitwiseMerge)
   }
 }
 
+UNIT_TEST(BitwiseSplit)
+{
+  uint32_t x = 0;
+  uint32_t y = 0;
+  bits::BitwiseSplit(11, x, y);
+  TEST_EQUAL(x, 1, ());
+  TEST_EQUAL(y, 3, ());
+
+  uint32_t const values[] = {0, 1, 0x12345678, 0x9ABCDEF0, 0x55555555, 0xFFFFFFFF};
+  for (uint32_t const vx : values)
+  {
+    for (uint32_t const vy : values)
+    {
+      bits::BitwiseSplit(bits::BitwiseMerge(vx, vy), x, y);
+      TEST_EQUAL(x, vx, (vx, vy));
+      TEST_EQUAL(y, vy, (vx, vy));
+    }
+  }
+}
+
 UNIT_TEST(ZigZagEncode)
 {
   TEST_EQUAL(bits::ZigZagEncode(0),  0, ());
@@ -0,0 +1,166 @@
+#include "testing/testing.hpp"
+
+#include "base/compact_trie.hpp"
+#include "base/mem_trie.hpp"
+#include "base/string_utils.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+using Key = string;
+using Value = int;
+using Trie = CompactTrie<Key, Value>;
+using Data = vector<pair<Key, Value>>;
+
+Data GetContents(Trie const & trie)
+{
+  Data data;
+  trie.ForEachInTrie([&data](Key const & k, Value v) { data.emplace_back(k, v); });
+  return data;
+}
+
+Data GetContentsByPrefix(Trie const & trie, Key const & prefix)
+{
+  Data data;
+  trie.ForEachInSubtree(prefix, [&data](Key const & k, Value v) { data.emplace_back(k, v); });
+  sort(data.begin(), data.end());
+  return data;
+}
+
+vector<Value> GetValuesByKey(Trie const & trie, Key const & key)
+{
+  vector<Value> values;
+  trie.ForEachInNode(key, [&values](Value v) { values.push_back(v); });
+  return values;
+}
+
+Data GenerateData(size_t size, size_t maxLength, uint32_t seed)
+{
+  mt19937 rng(seed);
+  Data data;
+  for (size_t i = 0; i < size; ++i)
+  {
+    Key key(rng() % (maxLength + 1), 'a');
+    for (auto & c : key)
+      c = static_cast<char>('a' + rng() % 4);
+    data.emplace_back(key, static_cast<Value>(i));
+  }
+  return data;
+}
+
+void TestSameAsMemTrie(Data const & data, Trie const & trie)
+{
+  MemTrie<Key, VectorValues<Value>> memTrie;
+  for (auto const & kv : data)
+    memTrie.Add(kv.first, kv.second);
+
+  auto expected = data;
+  stable_sort(expected.begin(), expected.end(),
+              [](pair<Key, Value> const & lhs, pair<Key, Value> const & rhs) {
+                return lhs.first < rhs.first;
+              });
+  TEST_EQUAL(GetContents(trie), expected, ());
+  TEST_EQUAL(trie.GetNumNodes(), memTrie.GetNumNodes(), ());
+
+  for (auto const & prefix : {"", "a", "ab", "abc", "dddd", "bad", "e"})
+  {
+    Data fromMemTrie;
+    memTrie.ForEachInSubtree(prefix, [&](Key const & k, Value v) { fromMemTrie.emplace_back(k, v); });
+    sort(fromMemTrie.begin(), fromMemTrie.end());
+    TEST_EQUAL(GetContentsByPrefix(trie, prefix), fromMemTrie, (prefix));
+
+    vector<Value> values;
+    memTrie.ForEachInNode(prefix, [&values](Value v) { values.push_back(v); });
+    TEST_EQUAL(GetValuesByKey(trie, prefix), values, (prefix));
+
+    TEST_EQUAL(trie.HasKey(prefix), memTrie.HasKey(prefix), (prefix));
+    TEST_EQUAL(trie.HasPrefix(prefix), memTrie.HasPrefix(prefix), (prefix));
+  }
+}
+
+UNIT_TEST(CompactTrie_Basic)
+{
+  {
+    Trie const trie;
+    TEST(GetContents(trie).empty(), ());
+    TEST(!trie.HasKey(""), ());
+    TEST(!trie.HasPrefix(""), ());
+    TEST_EQUAL(trie.GetNumNodes(), 1, ());
+  }
+
+  Data const data = {{"roger", 1}, {"amy", 2}, {"emma", 3}, {"ann", 4},
+                     {"rob", 5},   {"roger", 6}, {"", 7},   {"roger", 8}};
+  Trie const trie(data, nullptr /* scheduler */);
+
+  TEST_EQUAL(GetValuesByKey(trie, "roger"), vector<Value>({1, 6, 8}), ());
+  TEST_EQUAL(GetValuesByKey(trie, ""), vector<Value>({7}), ());
+  TEST(GetValuesByKey(trie, "rog").empty(), ());
+  TEST(GetValuesByKey(trie, "rogers").empty(), ());
+
+  TEST(trie.HasKey("amy"), ());
+  TEST(!trie.HasKey("am"), ());
+  TEST(trie.HasPrefix("am"), ());
+  TEST(!trie.HasPrefix("bob"), ());
+
+  TEST_EQUAL(GetContentsByPrefix(trie, "ro"), Data({{"rob", 5}, {"roger", 1}, {"roger", 6},
+                                                     {"roger", 8}}),
+             ());
+  TEST_EQUAL(GetContentsByPrefix(trie, "a"), Data({{"amy", 2}, {"ann", 4}}), ());
+  TEST(GetContentsByPrefix(trie, "x").empty(), ());
+
+  TestSameAsMemTrie(data, trie);
+}
+
+UNIT_TEST(CompactTrie_UniString)
+{
+  vector<pair<strings::UniString, Value>> data;
+  for (auto const * s : {"улица", "ул", "уличный", "street", "st"})
+    data.emplace_back(strings::MakeUniString(s), static_cast<Value>(data.size()));
+
+  CompactTrie<strings::UniString, Value> const trie(data, nullptr /* scheduler */);
+  TEST(trie.HasKey(strings::MakeUniString("ул")), ());
+  TEST(!trie.HasKey(strings::MakeUniString("ули")), ());
+
+  vector<string> keys;
+  trie.ForEachInSubtree(strings::MakeUniString("ули"),
+                        [&keys](strings::UniString const & k, Value) {
+                          keys.push_back(strings::ToUtf8(k));
+                        });
+  TEST_EQUAL(keys, vector<string>({"улица", "уличный"}), ());
+}
+
+UNIT_TEST(CompactTrie_Random)
+{
+  for (uint32_t seed = 0; seed < 10; ++seed)
+  {
+    auto const data = GenerateData(1000 /* size */, 8 /* maxLength */, seed);
+    TestSameAsMemTrie(data, Trie(data, nullptr /* scheduler */));
+  }
+}
+
+UNIT_TEST(CompactTrie_Parallel)
+{
+  TaskScheduler scheduler(4 /* workersCount */);
+  auto data = GenerateData(Trie::kMinParallelEntries + 100, 12 /* maxLength */, 0 /* seed */);
+  data.emplace_back("", -1);
+
+  Trie const sequential(data, nullptr /* scheduler */);
+  Trie const parallel(data, &scheduler);
+  TEST_EQUAL(GetContents(sequential), GetContents(parallel), ());
+  TEST_EQUAL(sequential.GetNumNodes(), parallel.GetNumNodes(), ());
+  TEST_EQUAL(GetValuesByKey(parallel, ""), GetValuesByKey(sequential, ""), ());
+  TEST_EQUAL(GetValuesByKey(parallel, "").back(), -1, ());
+  TestSameAsMemTrie(data, parallel);
+
+  scheduler.ShutdownAndJoin();
+}
+}  // namespace
@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "base/memory_budget.hpp"
+
+#include <cstddef>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+class TestClient : public MemoryBudget::Client
+{
+public:
+  // MemoryBudget::Client overrides:
+  void OnBudgetChanged(size_t budgetBytes) override
+  {
+    m_budget = budgetBytes;
+    ++m_calls;
+  }
+
+  size_t m_budget = 0;
+  size_t m_calls = 0;
+};
+
+UNIT_TEST(MemoryBudget_Unlimited)
+{
+  MemoryBudget budget;
+  TestClient a;
+  TestClient b;
+
+  TEST(budget.Register(a, "a", MemoryBudget::Priority::Low, 100), ());
+  TEST(!budget.Register(a, "a", MemoryBudget::Priority::Low, 100), ());
+  TEST(budget.Register(b, "b", MemoryBudget::Priority::High, 300), ());
+
+  TEST_EQUAL(a.m_budget, 100, ());
+  TEST_EQUAL(b.m_budget, 300, ());
+  TEST_EQUAL(a.m_calls, 1, ());
+  TEST_EQUAL(budget.GetBudget(b), 300, ());
+
+  TEST(budget.Unregister(b), ());
+  TEST(!budget.Unregister(b), ());
+  TEST_EQUAL(budget.GetBudget(b), 0, ());
+  TEST_EQUAL(a.m_calls, 1, ("Budget of a is not changed."));
+}
+
+UNIT_TEST(MemoryBudget_Shares)
+{
+  MemoryBudget budget(1000 /* totalBytes */);
+  TestClient low;
+  TestClient normal;
+  TestClient high;
+
+  budget.Register(low, "low", MemoryBudget::Priority::Low, 1000);
+  budget.Register(normal, "normal", MemoryBudget::Priority::Normal, 1000);
+  budget.Register(high, "high", MemoryBudget::Priority::High, 1000);
+
+  // Shares are proportional to weights 1:2:4.
+  TEST_EQUAL(low.m_budget, 142, ());
+  TEST_EQUAL(normal.m_budget, 285, ());
+  TEST_EQUAL(high.m_budget, 571, ());
+
+  // Unused part of the share of a small client is given to others.
+  budget.Unregister(high);
+  budget.Register(high, "high", MemoryBudget::Priority::High, 100);
+  TEST_EQUAL(high.m_budget, 100, ());
+  TEST_EQUAL(low.m_budget, 300, ());
+  TEST_EQUAL(normal.m_budget, 600, ());
+
+  budget.SetTotalBytes(10000);
+  TEST_EQUAL(low.m_budget, 1000, ());
+  TEST_EQUAL(normal.m_budget, 1000, ());
+  TEST_EQUAL(high.m_budget, 100, ());
+}
+
+UNIT_TEST(MemoryBudget_Pressure)
+{
+  MemoryBudget budget;
+  TestClient low;
+  TestClient high;
+
+  budget.Register(low, "low", MemoryBudget::Priority::Low, 400);
+  budget.Register(high, "high", MemoryBudget::Priority::High, 400);
+
+  budget.SetPressure(MemoryBudget::Pressure::Moderate);
+  TEST_EQUAL(budget.GetPressure(), MemoryBudget::Pressure::Moderate, ());
+  TEST_EQUAL(low.m_budget, 80, ());
+  TEST_EQUAL(high.m_budget, 320, ());
+
+  // Low priority clients drop everything on critical pressure.
+  budget.SetPressure(MemoryBudget::Pressure::Critical);
+  TEST_EQUAL(low.m_budget, 0, ());
+  TEST_EQUAL(high.m_budget, 100, ());
+
+  budget.SetPressure(MemoryBudget::Pressure::None);
+  TEST_EQUAL(low.m_budget, 400, ());
+  TEST_EQUAL(high.m_budget, 400, ());
+}
+}  // namespace
@@ -3,8 +3,11 @@
 #include "base/move_to_front.hpp"
 
 #include <cstdint>
+#include <random>
+#include <vector>
 
 using namespace base;
+using namespace std;
 
 namespace
 {
@@ -29,4 +32,20 @@ UNIT_TEST(MoveToFront_Smoke)
   for (size_t i = 4; i < 256; ++i)
     TEST_EQUAL(mtf[i], i, ());
 }
+
+UNIT_TEST(MoveToFront_InverseTransform)
+{
+  mt19937 engine(0);
+  vector<uint8_t> bytes(10000);
+  for (auto & b : bytes)
+    b = static_cast<uint8_t>(engine() % 16);
+
+  MoveToFront forward;
+  MoveToFront inverse;
+  for (auto const b : bytes)
+    TEST_EQUAL(inverse.InverseTransform(forward.Transform(b)), b, ());
+
+  for (size_t i = 0; i < 256; ++i)
+    TEST_EQUAL(forward[i], inverse[i], ());
+}
 }  // namespace
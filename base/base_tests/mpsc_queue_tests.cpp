@@ -0,0 +1,74 @@
+#include "testing/testing.hpp"
+
+#include "base/mpsc_queue.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(MpscQueue_Smoke)
+{
+  MpscQueue<unique_ptr<int>> queue;
+  TEST(queue.IsEmpty(), ());
+
+  for (int i = 0; i < 5; ++i)
+    queue.Push(make_unique<int>(i));
+  TEST(!queue.IsEmpty(), ());
+
+  vector<int> values;
+  TEST_EQUAL(queue.PopAll([&values](unique_ptr<int> && v) { values.push_back(*v); }), 5, ());
+  TEST_EQUAL(values, vector<int>({0, 1, 2, 3, 4}), ());
+  TEST(queue.IsEmpty(), ());
+  TEST_EQUAL(queue.PopAll([](unique_ptr<int> &&) {}), 0, ());
+
+  // Wake-ups aren't lost when the consumer isn't sleeping.
+  queue.Wake();
+  queue.Wait();
+}
+
+UNIT_TEST(MpscQueue_Producers)
+{
+  size_t const kProducers = 4;
+  int const kCount = 10000;
+
+  MpscQueue<pair<size_t, int>> queue;
+  vector<thread> producers;
+  for (size_t p = 0; p < kProducers; ++p)
+  {
+    producers.emplace_back([&queue, p]() {
+      for (int i = 0; i < kCount; ++i)
+        queue.Push(make_pair(p, i));
+    });
+  }
+
+  // Elements of every producer come in the order of pushes.
+  vector<int> next(kProducers, 0);
+  size_t received = 0;
+  while (received != kProducers * kCount)
+  {
+    queue.Wait();
+    received += queue.PopAll([&next](pair<size_t, int> && v) {
+      TEST_EQUAL(v.second, next[v.first], ());
+      ++next[v.first];
+    });
+  }
+
+  for (auto & producer : producers)
+    producer.join();
+  TEST(queue.IsEmpty(), ());
+}
+
+UNIT_TEST(MpscQueue_Wake)
+{
+  MpscQueue<int> queue;
+  thread waker([&queue]() { queue.Wake(); });
+  queue.Wait();
+  waker.join();
+  TEST(queue.IsEmpty(), ());
+}
+}  // namespace
@@ -0,0 +1,96 @@
+#include "testing/testing.hpp"
+
+#include "base/parallel.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(Parallel_ChunksCount)
+{
+  TEST_EQUAL(parallel::GetChunksCount(0, 4, 1), 1, ());
+  TEST_EQUAL(parallel::GetChunksCount(3, 4, 1), 3, ());
+  TEST_EQUAL(parallel::GetChunksCount(1000, 4, 1), 16, ());
+  TEST_EQUAL(parallel::GetChunksCount(1000, 4, 100), 10, ());
+  TEST_EQUAL(parallel::GetChunksCount(1000, 0, 1), 4, ());
+}
+
+UNIT_TEST(Parallel_For)
+{
+  for (size_t workers : {0, 1, 4})
+  {
+    TaskScheduler scheduler(workers);
+    vector<int> values(10007, 0);
+    ParallelFor(0, values.size(), [&values](size_t i) { values[i] += static_cast<int>(i); },
+                1 /* minChunkSize */, scheduler);
+    for (size_t i = 0; i < values.size(); ++i)
+      TEST_EQUAL(values[i], static_cast<int>(i), (workers));
+
+    ParallelFor(5, 5, [](size_t) { TEST(false, ()); }, 1 /* minChunkSize */, scheduler);
+  }
+}
+
+UNIT_TEST(Parallel_TransformReduce)
+{
+  TaskScheduler scheduler(3);
+  auto const sum = ParallelTransformReduce(
+      0, 100000, uint64_t(0), [](size_t i) { return static_cast<uint64_t>(i); },
+      [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; }, 1 /* minChunkSize */, scheduler);
+  TEST_EQUAL(sum, uint64_t(100000) * 99999 / 2, ());
+
+  // Chunks are reduced in order, so a non-commutative reduce gives the sequential result.
+  auto const s = ParallelTransformReduce(
+      0, 26, string(), [](size_t i) { return string(1, static_cast<char>('a' + i)); },
+      [](string const & lhs, string const & rhs) { return lhs + rhs; }, 1 /* minChunkSize */,
+      scheduler);
+  TEST_EQUAL(s, "abcdefghijklmnopqrstuvwxyz", ());
+}
+
+UNIT_TEST(Parallel_Sort)
+{
+  TaskScheduler scheduler(4);
+  mt19937 rng(0);
+  for (size_t size : {0, 1, 100, 12345, 100000})
+  {
+    vector<uint32_t> values(size);
+    for (auto & v : values)
+      v = rng() % 1000;
+    auto expected = values;
+    sort(expected.begin(), expected.end(), greater<uint32_t>());
+
+    ParallelSort(values.begin(), values.end(), greater<uint32_t>(), 100 /* minChunkSize */,
+                 scheduler);
+    TEST_EQUAL(values, expected, (size));
+  }
+}
+
+UNIT_TEST(Parallel_Exceptions)
+{
+  TaskScheduler scheduler(2);
+  atomic<size_t> calls(0);
+  TEST_THROW(ParallelFor(0, 1000, [&calls](size_t i) {
+               ++calls;
+               if (i == 500)
+                 throw runtime_error("Failure");
+             }, 1 /* minChunkSize */, scheduler),
+             runtime_error, ());
+  TEST_LESS_OR_EQUAL(calls, 1000, ());
+
+  // Algorithms may be nested.
+  atomic<size_t> count(0);
+  ParallelFor(0, 10, [&](size_t) {
+    ParallelFor(0, 100, [&count](size_t) { ++count; }, 1 /* minChunkSize */, scheduler);
+  }, 1 /* minChunkSize */, scheduler);
+  TEST_EQUAL(count, 1000, ());
+}
+}  // namespace
@@ -523,6 +523,48 @@ UNIT_TEST(UniStringToUtf8)
   TEST_EQUAL(std::string(utf8Text), strings::ToUtf8(uniS), ());
 }
 
+UNIT_TEST(UniStringToUtf8_Buffers)
+{
+  // ASCII prefixes of different lengths are converted by words and by bytes.
+  std::vector<std::string> const strs = {"",
+                                         "a",
+                                         "Utf8!",
+                                         "exactly8",
+                                         "more than sixteen bytes long",
+                                         "\xc3\x9f",
+                                         "ascii prefix of 17\xc3\x9f and tail",
+                                         "У нас исходники хранятся в Utf8!"};
+
+  strings::UniString uniS;
+  std::string utf8;
+  for (auto const & s : strs)
+  {
+    strings::UniString expected;
+    utf8::unchecked::utf8to32(s.begin(), s.end(), std::back_inserter(expected));
+
+    strings::MakeUniString(s, uniS);
+    TEST_EQUAL(uniS, expected, (s));
+    TEST_EQUAL(strings::IsASCIIString(s), uniS.size() == s.size(), (s));
+
+    strings::ToUtf8(uniS, utf8);
+    TEST_EQUAL(utf8, s, ());
+  }
+}
+
+UNIT_TEST(MakeLowerCase_Prefixes)
+{
+  std::string s = "ASCII PREFIX THEN \xD0\xA3\xD0\x9F \xc3\x9f END";
+  strings::MakeLowerCaseInplace(s);
+  TEST_EQUAL(s, "ascii prefix then \xD1\x83\xD0\xBF ss end", ());
+
+  // Chars which are folded to several chars go after the chars folded in place.
+  strings::UniChar const arr[] = {'A', 0x397, 0xdf, 'Z'};
+  strings::UniChar const carr[] = {'a', 0x3b7, 's', 's', 'z'};
+  strings::UniString us(&arr[0], &arr[0] + ARRAY_SIZE(arr));
+  strings::MakeLowerCaseInplace(us);
+  TEST_EQUAL(us, strings::UniString(&carr[0], &carr[0] + ARRAY_SIZE(carr)), ());
+}
+
 UNIT_TEST(StartsWith)
 {
   using namespace strings;
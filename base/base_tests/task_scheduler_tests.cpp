@@ -0,0 +1,125 @@
+#include "testing/testing.hpp"
+
+#include "base/task_scheduler.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+uint64_t Sum(TaskScheduler & scheduler, uint64_t from, uint64_t to)
+{
+  if (to - from <= 1000)
+  {
+    uint64_t sum = 0;
+    for (uint64_t i = from; i < to; ++i)
+      sum += i;
+    return sum;
+  }
+
+  uint64_t const middle = from + (to - from) / 2;
+  uint64_t left = 0;
+  uint64_t right = 0;
+  {
+    TaskGroup group(scheduler);
+    group.Push([&]() { left = Sum(scheduler, from, middle); });
+    group.Push([&]() { right = Sum(scheduler, middle, to); });
+    group.Wait();
+  }
+  return left + right;
+}
+
+UNIT_TEST(TaskScheduler_Smoke)
+{
+  {
+    TaskScheduler scheduler(2);
+  }
+
+  {
+    TaskScheduler scheduler(2);
+    TEST(scheduler.Shutdown(TaskScheduler::Exit::SkipPending), ());
+    TEST(!scheduler.Shutdown(TaskScheduler::Exit::SkipPending), ());
+    TEST(!scheduler.Push([]() {}), ());
+  }
+
+  TEST_GREATER(TaskScheduler::Instance().GetWorkersCount(), 0, ());
+}
+
+UNIT_TEST(TaskScheduler_ExecPending)
+{
+  for (size_t workers : {0, 1, 4})
+  {
+    atomic<int> counter(0);
+    {
+      TaskScheduler scheduler(workers, TaskScheduler::Exit::ExecPending);
+      for (int i = 0; i < 1000; ++i)
+        TEST(scheduler.Push([&counter]() { ++counter; }), ());
+    }
+    TEST_EQUAL(counter, 1000, (workers));
+  }
+}
+
+UNIT_TEST(TaskScheduler_Priorities)
+{
+  vector<int> order;
+  {
+    // Without workers tasks are executed in order of priorities on shutdown.
+    TaskScheduler scheduler(0, TaskScheduler::Exit::ExecPending);
+    scheduler.Push([&order]() { order.push_back(1); }, TaskScheduler::Priority::Normal);
+    scheduler.Push([&order]() { order.push_back(2); }, TaskScheduler::Priority::Low);
+    scheduler.Push([&order]() { order.push_back(3); }, TaskScheduler::Priority::Normal);
+    scheduler.Push([&order]() { order.push_back(4); }, TaskScheduler::Priority::High);
+  }
+  TEST_EQUAL(order, vector<int>({4, 1, 3, 2}), ());
+}
+
+UNIT_TEST(TaskScheduler_MoveOnlyTasks)
+{
+  TaskScheduler scheduler(2);
+  promise<int> p;
+  auto result = p.get_future();
+  auto value = make_unique<int>(42);
+  TEST(scheduler.Push([p = move(p), value = move(value)]() mutable { p.set_value(*value); },
+                      TaskScheduler::Priority::Normal),
+       ());
+  TEST_EQUAL(result.get(), 42, ());
+}
+
+UNIT_TEST(TaskScheduler_NestedGroups)
+{
+  TaskScheduler scheduler(2);
+  uint64_t const n = 1000000;
+  TEST_EQUAL(Sum(scheduler, 0, n), n * (n - 1) / 2, ());
+
+  auto const stats = scheduler.GetStats();
+  TEST_EQUAL(stats.m_workersCount, 2, ());
+  TEST_GREATER(stats.m_executed, 0, ());
+  TEST_GREATER_OR_EQUAL(stats.GetUtilization(), 0.0, ());
+  TEST_LESS_OR_EQUAL(stats.GetUtilization(), 1.0, ());
+}
+
+UNIT_TEST(TaskScheduler_CancelGroup)
+{
+  TaskScheduler scheduler(1);
+  promise<void> blocker;
+  auto blocked = blocker.get_future().share();
+  atomic<int> counter(0);
+
+  TaskGroup group(scheduler);
+  group.Push([blocked]() { blocked.wait(); });
+  for (int i = 0; i < 10; ++i)
+    group.Push([&counter]() { ++counter; });
+
+  group.Cancel();
+  TEST(group.IsCancelled(), ());
+  blocker.set_value();
+  group.Wait();
+  TEST_EQUAL(counter, 0, ());
+}
+}  // namespace
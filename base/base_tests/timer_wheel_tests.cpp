@@ -0,0 +1,214 @@
+#include "testing/testing.hpp"
+
+#include "base/deferred_task.hpp"
+#include "base/timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace base;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+class Counter
+{
+public:
+  void Increment()
+  {
+    lock_guard<mutex> lock(m_mu);
+    ++m_value;
+    m_cv.notify_all();
+  }
+
+  void WaitFor(size_t value)
+  {
+    unique_lock<mutex> lock(m_mu);
+    m_cv.wait(lock, [&]() { return m_value >= value; });
+  }
+
+  size_t Get()
+  {
+    lock_guard<mutex> lock(m_mu);
+    return m_value;
+  }
+
+private:
+  mutex m_mu;
+  condition_variable m_cv;
+  size_t m_value = 0;
+};
+
+UNIT_TEST(TimerWheel_Schedule)
+{
+  TimerWheel wheel(milliseconds(1));
+  Counter counter;
+  auto const key = wheel.NewKey();
+
+  auto const start = TimerWheel::Clock::now();
+  TimerWheel::Clock::time_point executed;
+  wheel.Schedule(key, milliseconds(30), [&]() {
+    executed = TimerWheel::Clock::now();
+    counter.Increment();
+  });
+  TEST(wheel.IsPending(key), ());
+
+  counter.WaitFor(1);
+  TEST(executed - start >= milliseconds(30), ());
+  TEST(!wheel.IsPending(key), ());
+  TEST_EQUAL(wheel.GetPendingCount(), 0, ());
+}
+
+UNIT_TEST(TimerWheel_Coalesce)
+{
+  TimerWheel wheel(milliseconds(1));
+  Counter counter;
+  atomic<int> last(0);
+  auto const key = wheel.NewKey();
+
+  for (int i = 1; i <= 100; ++i)
+  {
+    wheel.Schedule(key, milliseconds(20), [&, i]() {
+      last = i;
+      counter.Increment();
+    });
+  }
+  TEST_EQUAL(wheel.GetPendingCount(), 1, ());
+
+  // The earlier deadline is kept, the task is replaced.
+  auto const keepKey = wheel.NewKey();
+  wheel.Schedule(keepKey, milliseconds(10), []() {});
+  wheel.Schedule(keepKey, hours(1), [&]() { counter.Increment(); },
+                 TimerWheel::Coalesce::KeepEarlier);
+
+  counter.WaitFor(2);
+  this_thread::sleep_for(milliseconds(30));
+  TEST_EQUAL(counter.Get(), 2, ());
+  TEST_EQUAL(last, 100, ());
+}
+
+UNIT_TEST(TimerWheel_Cancel)
+{
+  TimerWheel wheel(milliseconds(1));
+  Counter counter;
+  auto const cancelled = wheel.NewKey();
+  auto const key = wheel.NewKey();
+
+  wheel.Schedule(cancelled, milliseconds(10), [&]() { counter.Increment(); });
+  wheel.Schedule(key, milliseconds(20), [&]() { counter.Increment(); });
+  TEST(wheel.Cancel(cancelled), ());
+  TEST(!wheel.Cancel(cancelled), ());
+
+  counter.WaitFor(1);
+  this_thread::sleep_for(milliseconds(20));
+  TEST_EQUAL(counter.Get(), 1, ());
+
+  // The key may be used again.
+  wheel.Schedule(cancelled, milliseconds(1), [&]() { counter.Increment(); });
+  counter.WaitFor(2);
+}
+
+UNIT_TEST(TimerWheel_CancelAndWait)
+{
+  TimerWheel wheel(milliseconds(1));
+  auto const key = wheel.NewKey();
+  atomic<bool> started(false);
+  atomic<bool> finished(false);
+  atomic<size_t> runs(0);
+
+  // The periodic task reschedules itself.
+  function<void()> task = [&]() {
+    ++runs;
+    started = true;
+    this_thread::sleep_for(milliseconds(20));
+    finished = true;
+    wheel.Schedule(key, milliseconds(1), TimerWheel::Task(task));
+  };
+  wheel.Schedule(key, milliseconds(1), TimerWheel::Task(task));
+
+  while (!started)
+    this_thread::yield();
+  wheel.CancelAndWait(key);
+  TEST(finished, ());
+  TEST(!wheel.IsPending(key), ());
+
+  auto const count = runs.load();
+  this_thread::sleep_for(milliseconds(20));
+  TEST_EQUAL(runs, count, ());
+}
+
+UNIT_TEST(TimerWheel_Levels)
+{
+  // Delays up to 50ms span three levels of the wheel.
+  TimerWheel wheel(microseconds(10));
+  size_t const kTimers = 500;
+
+  mt19937 rng(0);
+  vector<TimerWheel::Clock::time_point> deadlines(kTimers);
+  vector<TimerWheel::Clock::time_point> executed(kTimers);
+  Counter counter;
+  for (size_t i = 0; i < kTimers; ++i)
+  {
+    auto const delay = microseconds(rng() % 50000);
+    deadlines[i] = TimerWheel::Clock::now() + delay;
+    wheel.Schedule(wheel.NewKey(), delay, [&, i]() {
+      executed[i] = TimerWheel::Clock::now();
+      counter.Increment();
+    });
+  }
+
+  counter.WaitFor(kTimers);
+  for (size_t i = 0; i < kTimers; ++i)
+    TEST(executed[i] >= deadlines[i], (i));
+  TEST_EQUAL(wheel.GetPendingCount(), 0, ());
+}
+
+UNIT_TEST(TimerWheel_FarTimers)
+{
+  TimerWheel wheel(microseconds(1));
+  // The delay doesn't fit into the wheels.
+  auto const farKey = wheel.NewKey();
+  wheel.Schedule(farKey, hours(1), []() {});
+
+  Counter counter;
+  wheel.Schedule(wheel.NewKey(), milliseconds(5), [&]() { counter.Increment(); });
+  counter.WaitFor(1);
+  TEST(wheel.IsPending(farKey), ());
+}
+
+UNIT_TEST(DeferredTask_Restart)
+{
+  Counter counter;
+  atomic<int> last(0);
+  {
+    DeferredTask task(milliseconds(20));
+    for (int i = 1; i <= 10; ++i)
+    {
+      task.RestartWith([&, i]() {
+        last = i;
+        counter.Increment();
+      });
+    }
+    counter.WaitFor(1);
+    TEST_EQUAL(last, 10, ());
+
+    // Dropped functions aren't executed.
+    task.RestartWith([&]() { counter.Increment(); });
+    task.Drop();
+    this_thread::sleep_for(milliseconds(40));
+    TEST_EQUAL(counter.Get(), 1, ());
+
+    task.RestartWith([&]() { counter.Increment(); });
+  }
+
+  // The pending function is dropped with the task.
+  this_thread::sleep_for(milliseconds(40));
+  TEST_EQUAL(counter.Get(), 1, ());
+}
+}  // namespace
@@ -0,0 +1,127 @@
+#include "testing/testing.hpp"
+
+#include "base/trace.hpp"
+
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace base::trace;
+using namespace std;
+
+namespace
+{
+// The tracer is shared by the process, so every test starts and finishes with a clear one.
+class EnabledTracerGuard
+{
+public:
+  EnabledTracerGuard()
+  {
+    Tracer::Instance().Clear();
+    Tracer::Instance().SetEnabled(true);
+  }
+
+  ~EnabledTracerGuard()
+  {
+    Tracer::Instance().SetEnabled(false);
+    Tracer::Instance().Clear();
+  }
+};
+
+UNIT_TEST(Trace_Zones)
+{
+  EnabledTracerGuard guard;
+  auto & tracer = Tracer::Instance();
+  {
+    ScopedZone outer("outer");
+    {
+      ScopedZone inner("inner");
+    }
+    tracer.AddCounter("counter", 42);
+  }
+
+  tracer.SetEnabled(false);
+  {
+    ScopedZone ignored("ignored");
+  }
+
+  auto const events = tracer.GetEvents();
+  TEST_EQUAL(events.size(), 3, ());
+  TEST_EQUAL(string(events[0].m_name), "outer", ());
+  TEST_EQUAL(string(events[1].m_name), "inner", ());
+  TEST_EQUAL(string(events[2].m_name), "counter", ());
+
+  TEST(events[0].m_type == Event::Type::Zone, ());
+  TEST(events[2].m_type == Event::Type::Counter, ());
+  TEST_EQUAL(events[2].m_value, 42, ());
+
+  // The inner zone is nested in the outer one.
+  TEST(events[0].m_start <= events[1].m_start, ());
+  TEST(events[1].m_start + events[1].m_duration <= events[0].m_start + events[0].m_duration, ());
+}
+
+UNIT_TEST(Trace_RingBuffer)
+{
+  EnabledTracerGuard guard;
+  auto & tracer = Tracer::Instance();
+  int64_t const kOverflow = 10;
+  int64_t const count = static_cast<int64_t>(Tracer::kEventsPerThread) + kOverflow;
+  for (int64_t i = 0; i < count; ++i)
+    tracer.AddCounter("counter", i);
+
+  // The oldest events are overwritten.
+  auto const events = tracer.GetEvents();
+  TEST_EQUAL(events.size(), Tracer::kEventsPerThread, ());
+  TEST_EQUAL(events.front().m_value, kOverflow, ());
+  TEST_EQUAL(events.back().m_value, count - 1, ());
+}
+
+UNIT_TEST(Trace_Threads)
+{
+  EnabledTracerGuard guard;
+  auto & tracer = Tracer::Instance();
+  size_t const kThreads = 4;
+  size_t const kZones = 100;
+
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < kZones; ++j)
+        ScopedZone zone("zone");
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  auto const events = tracer.GetEvents();
+  TEST_EQUAL(events.size(), kThreads * kZones, ());
+
+  set<uint32_t> ids;
+  for (auto const & e : events)
+    ids.insert(e.m_threadId);
+  TEST_EQUAL(ids.size(), kThreads, ());
+}
+
+UNIT_TEST(Trace_ExportChromeTrace)
+{
+  EnabledTracerGuard guard;
+  auto & tracer = Tracer::Instance();
+  {
+    ScopedZone zone("zone \"quoted\"");
+  }
+  tracer.AddCounter("counter", 7);
+
+  ostringstream os;
+  tracer.ExportChromeTrace(os);
+  auto const json = os.str();
+
+  TEST_EQUAL(json.find("{\"traceEvents\":["), 0, (json));
+  TEST_NOT_EQUAL(json.find("\"name\":\"zone \\\"quoted\\\"\""), string::npos, (json));
+  TEST_NOT_EQUAL(json.find("\"ph\":\"X\",\"dur\":"), string::npos, (json));
+  TEST_NOT_EQUAL(json.find("\"ph\":\"C\",\"args\":{\"value\":7}"), string::npos, (json));
+}
+}  // namespace
@@ -5,6 +5,10 @@
 #include <limits>
 #include <type_traits>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 namespace bits
 {
   // Count the number of 1 bits. Implementation: see Hacker's delight book.
@@ -150,17 +154,26 @@ namespace bits
   // then the bits of the result are {y31, x31, y30, x30, ..., y0, x0}.
   inline uint64_t BitwiseMerge(uint32_t x, uint32_t y)
   {
+#if defined(__BMI2__)
+    return _pdep_u64(x, 0x5555555555555555ULL) | _pdep_u64(y, 0xAAAAAAAAAAAAAAAAULL);
+#else
     uint32_t const hi = PerfectShuffle((y & 0xFFFF0000) | (x >> 16));
     uint32_t const lo = PerfectShuffle(((y & 0xFFFF) << 16 ) | (x & 0xFFFF));
     return (static_cast<uint64_t>(hi) << 32) + lo;
+#endif
   }
 
   inline void BitwiseSplit(uint64_t v, uint32_t & x, uint32_t & y)
   {
+#if defined(__BMI2__)
+    x = static_cast<uint32_t>(_pext_u64(v, 0x5555555555555555ULL));
+    y = static_cast<uint32_t>(_pext_u64(v, 0xAAAAAAAAAAAAAAAAULL));
+#else
     uint32_t const hi = bits::PerfectUnshuffle(static_cast<uint32_t>(v >> 32));
     uint32_t const lo = bits::PerfectUnshuffle(static_cast<uint32_t>(v & 0xFFFFFFFFULL));
     x = ((hi & 0xFFFF) << 16) | (lo & 0xFFFF);
     y =     (hi & 0xFFFF0000) | (lo >> 16);
+#endif
   }
 
   // Returns 1 if bit is set and 0 otherwise.
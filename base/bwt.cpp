@@ -13,126 +13,6 @@ using namespace std;
 namespace
 {
 size_t const kNumBytes = 256;
-
-// Fake trailing '$' for the BWT, used for original string
-// reconstruction.
-uint32_t const kEOS = 256;
-
-// FirstColumn represents the first column in the BWT matrix. As
-// during reverse BWT we need to reconstruct canonical first column,
-// with '$' as the first element, this wrapper is used. Also note that
-// other characters in the first column are sorted, so we actually
-// don't need to store them explicitly, it's enough to store start
-// positions of the corresponding groups of consecutive characters.
-class FirstColumn
-{
-public:
-  FirstColumn(size_t n, uint8_t const * s) : m_n(n), m_starts({})
-  {
-    m_starts.fill(0);
-    for (size_t i = 0; i < n; ++i)
-      ++m_starts[s[i]];
-
-    size_t offset = 0;
-    for (size_t i = 0; i < m_starts.size(); ++i)
-    {
-      auto const count = m_starts[i];
-      m_starts[i] = offset;
-      offset += count;
-    }
-  }
-
-  size_t Size() const { return m_n + 1; }
-
-  uint32_t operator[](size_t i) const
-  {
-    ASSERT_LESS(i, Size(), ());
-    if (i == 0)
-      return kEOS;
-
-    --i;
-    auto it = upper_bound(m_starts.begin(), m_starts.end(), i);
-    ASSERT(it != m_starts.begin(), ());
-    --it;
-    return static_cast<uint32_t>(distance(m_starts.begin(), it));
-  }
-
-  // Returns the rank of the i-th symbol among symbols with the same
-  // value.
-  size_t Rank(size_t i) const
-  {
-    ASSERT_LESS(i, Size(), ());
-    if (i == 0)
-      return 0;
-
-    --i;
-    auto it = upper_bound(m_starts.begin(), m_starts.end(), i);
-    if (it == m_starts.begin())
-      return i;
-    --it;
-    return i - *it;
-  }
-
-private:
-  size_t const m_n;
-  array<size_t, kNumBytes> m_starts;
-};
-
-// LastColumn represents the last column in the BWT matrix. As during
-// reverse BWT we need to reconstruct canonical last column, |s| is
-// replaced by s[start] + s[0, start) + '$' + s[start, n).
-class LastColumn
-{
-public:
-  LastColumn(size_t n, size_t start, uint8_t const * s) : m_n(n), m_start(start), m_s(s)
-  {
-    for (size_t i = 0; i < Size(); ++i)
-    {
-      auto const b = (*this)[i];
-      if (b == kEOS)
-        continue;
-      ASSERT_LESS(b, kNumBytes, ());
-      m_table[b].push_back(i);
-    }
-  }
-
-  size_t Size() const { return m_n + 1; }
-
-  uint32_t operator[](size_t i) const
-  {
-    if (i == 0)
-    {
-      ASSERT_LESS(m_start, m_n, ());
-      return m_s[m_start];
-    }
-
-    if (i == m_start + 1)
-      return kEOS;
-
-    ASSERT_LESS_OR_EQUAL(i, m_n, ());
-    return m_s[i - 1];
-  }
-
-  // Returns the index of the |rank|-th |byte| in the canonical BWT
-  // last column.
-  size_t Select(uint32_t byte, size_t rank)
-  {
-    if (byte == kEOS)
-    {
-      ASSERT_EQUAL(rank, 0, ());
-      return 0;
-    }
-
-    ASSERT_LESS(rank, m_table[byte].size(), (byte, rank));
-    return m_table[byte][rank];
-  }
-
-private:
-  size_t const m_n;
-  size_t const m_start;
-  uint8_t const * const m_s;
-  array<vector<size_t>, kNumBytes> m_table;
-};
 }  // namespace
 
 namespace base
@@ -170,20 +50,48 @@ void RevBWT(size_t n, size_t start, uint8_t const * s, uint8_t * r)
   if (n == 0)
     return;
 
-  FirstColumn first(n, s);
-  LastColumn last(n, start, s);
+  CHECK_LESS(start, n, ());
+  CHECK_LESS(n, numeric_limits<uint32_t>::max(), ());
+
+  // The canonical last column of the BWT matrix is s[start] + s[0, start) + '$' + s[start + 1, n),
+  // the canonical first column is '$' followed by sorted bytes of |s|.
+  vector<uint8_t> last(n + 1);
+  last[0] = s[start];
+  copy(s, s + start, last.begin() + 1);
+  last[start + 1] = 0;
+  copy(s + start + 1, s + n, last.begin() + start + 2);
 
-  auto curr = start + 1;
+  // Positions of groups of equal bytes in the first column.
+  array<size_t, kNumBytes> starts;
+  starts.fill(0);
   for (size_t i = 0; i < n; ++i)
+    ++starts[s[i]];
+  size_t offset = 1;
+  for (auto & begin : starts)
   {
-    ASSERT_LESS(curr, first.Size(), ());
-    ASSERT(first[curr] != kEOS, ());
+    auto const count = begin;
+    begin = offset;
+    offset += count;
+  }
 
-    r[i] = first[curr];
-    curr = last.Select(r[i], first.Rank(curr));
+  // next[i] is the position in the last column of the i-th symbol of the first column: the
+  // k-th occurrence of a byte in the first column is the k-th occurrence in the last column.
+  vector<uint32_t> next(n + 1);
+  for (size_t i = 0; i <= n; ++i)
+  {
+    if (i != start + 1)
+      next[starts[last[i]]++] = static_cast<uint32_t>(i);
+  }
+
+  size_t curr = start + 1;
+  for (size_t i = 0; i < n; ++i)
+  {
+    curr = next[curr];
+    ASSERT_NOT_EQUAL(curr, start + 1, ());
+    r[i] = last[curr];
   }
 
-  ASSERT_EQUAL(first[curr], kEOS, ());
+  ASSERT_EQUAL(curr, 0, ());
 }
 
 void RevBWT(size_t start, string const & s, string & r)
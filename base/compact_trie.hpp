@@ -0,0 +1,347 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/parallel.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// Immutable radix trie which is built at once from key-value pairs. Unlike MemTrie, nodes,
+// edge labels and values are kept in three flat arrays, children of a node are adjacent and
+// sorted by the first chars of their edges, so lookups are binary searches over contiguous
+// memory and the trie takes a few allocations only.
+//
+// Large tries are built in parallel: subtrees of the root are built by tasks of a scheduler
+// and then concatenated.
+template <typename String, typename Value>
+class CompactTrie
+{
+public:
+  using Char = typename String::value_type;
+  using Entry = std::pair<String, Value>;
+
+  // Subtrees of the root are built in parallel when there are at least this number of entries.
+  static size_t constexpr kMinParallelEntries = 1 << 16;
+
+  CompactTrie() { Clear(); }
+
+  // Entries which are sorted by keys are used as is, otherwise they are sorted first.
+  // Values of the same key keep the order of |entries|. |scheduler| may be null to build
+  // the trie on the calling thread.
+  explicit CompactTrie(std::vector<Entry> entries,
+                       TaskScheduler * scheduler = &TaskScheduler::Instance())
+  {
+    auto const less = [](Entry const & lhs, Entry const & rhs) { return KeyLess(lhs, rhs); };
+    if (!std::is_sorted(entries.begin(), entries.end(), less))
+      std::stable_sort(entries.begin(), entries.end(), less);
+
+    CHECK_LESS(entries.size(), static_cast<size_t>(UINT32_MAX), ());
+    if (scheduler != nullptr && scheduler->GetWorkersCount() != 0 &&
+        entries.size() >= kMinParallelEntries)
+    {
+      BuildParallel(entries, *scheduler);
+    }
+    else
+    {
+      m_nodes.emplace_back();
+      Build(entries, 0 /* node */, 0 /* begin */, entries.size(), 0 /* depth */);
+    }
+  }
+
+  // Calls |toDo| for each value of |key|.
+  template <typename ToDo>
+  void ForEachInNode(String const & key, ToDo && toDo) const
+  {
+    uint32_t node;
+    size_t offset;
+    if (!MoveTo(key, node, offset) || offset != GetLabelSize(m_nodes[node]))
+      return;
+
+    auto const & n = m_nodes[node];
+    for (auto i = n.m_valuesBegin; i < n.m_valuesEnd; ++i)
+      toDo(m_values[i]);
+  }
+
+  // Calls |toDo| for each key-value pair of keys which start with |prefix|.
+  template <typename ToDo>
+  void ForEachInSubtree(String const & prefix, ToDo && toDo) const
+  {
+    uint32_t node;
+    size_t offset;
+    if (!MoveTo(prefix, node, offset))
+      return;
+
+    String key = prefix;
+    auto const & n = m_nodes[node];
+    key.insert(key.end(), m_labels.begin() + n.m_labelBegin + offset,
+               m_labels.begin() + n.m_labelEnd);
+    ForEachInSubtree(node, key, toDo);
+  }
+
+  // Calls |toDo| for each key-value pair in the order of keys.
+  template <typename ToDo>
+  void ForEachInTrie(ToDo && toDo) const
+  {
+    String key;
+    ForEachInSubtree(0 /* node */, key, toDo);
+  }
+
+  bool HasKey(String const & key) const
+  {
+    uint32_t node;
+    size_t offset;
+    if (!MoveTo(key, node, offset))
+      return false;
+    auto const & n = m_nodes[node];
+    return offset == GetLabelSize(n) && n.m_valuesBegin != n.m_valuesEnd;
+  }
+
+  bool HasPrefix(String const & prefix) const
+  {
+    uint32_t node;
+    size_t offset;
+    if (!MoveTo(prefix, node, offset))
+      return false;
+    auto const & n = m_nodes[node];
+    return n.m_valuesBegin != n.m_valuesEnd || n.m_childrenBegin != n.m_childrenEnd;
+  }
+
+  void Clear()
+  {
+    m_nodes.assign(1, Node());
+    m_labels.clear();
+    m_values.clear();
+  }
+
+  size_t GetNumNodes() const { return m_nodes.size(); }
+  size_t GetNumValues() const { return m_values.size(); }
+
+private:
+  // Edge from the parent is [m_labelBegin, m_labelEnd) of |m_labels|, children are
+  // [m_childrenBegin, m_childrenEnd) of |m_nodes|, values are [m_valuesBegin, m_valuesEnd)
+  // of |m_values|.
+  struct Node
+  {
+    uint32_t m_labelBegin = 0;
+    uint32_t m_labelEnd = 0;
+    uint32_t m_childrenBegin = 0;
+    uint32_t m_childrenEnd = 0;
+    uint32_t m_valuesBegin = 0;
+    uint32_t m_valuesEnd = 0;
+  };
+
+  static bool KeyLess(Entry const & lhs, Entry const & rhs)
+  {
+    return std::lexicographical_compare(lhs.first.begin(), lhs.first.end(), rhs.first.begin(),
+                                        rhs.first.end());
+  }
+
+  static size_t GetLabelSize(Node const & node) { return node.m_labelEnd - node.m_labelBegin; }
+
+  static uint32_t ToIndex(size_t n) { return base::checked_cast<uint32_t>(n); }
+
+  // Returns the end of the group of entries in [begin, end) with the same char at |depth|.
+  static size_t GetGroupEnd(std::vector<Entry> const & entries, size_t begin, size_t end,
+                            size_t depth)
+  {
+    auto const c = entries[begin].first[depth];
+    auto const it = std::partition_point(
+        entries.begin() + begin, entries.begin() + end,
+        [&](Entry const & e) { return !(c < e.first[depth]); });
+    return static_cast<size_t>(it - entries.begin());
+  }
+
+  // Entries in [begin, end) are sorted and have a common prefix of length |depth|, they are
+  // added to the subtree of |node|, which edge label is already set.
+  void Build(std::vector<Entry> const & entries, uint32_t node, size_t begin, size_t end,
+             size_t depth)
+  {
+    m_nodes[node].m_valuesBegin = ToIndex(m_values.size());
+    while (begin < end && entries[begin].first.size() == depth)
+      m_values.push_back(entries[begin++].second);
+    m_nodes[node].m_valuesEnd = ToIndex(m_values.size());
+
+    // Children are allocated before subtrees to be adjacent.
+    std::vector<std::pair<size_t, size_t>> groups;
+    for (size_t i = begin; i < end;)
+    {
+      auto const groupEnd = GetGroupEnd(entries, i, end, depth);
+      groups.emplace_back(i, groupEnd);
+      i = groupEnd;
+    }
+
+    auto const children = ToIndex(m_nodes.size());
+    m_nodes.resize(m_nodes.size() + groups.size());
+    m_nodes[node].m_childrenBegin = children;
+    m_nodes[node].m_childrenEnd = ToIndex(m_nodes.size());
+
+    for (size_t i = 0; i < groups.size(); ++i)
+      BuildChild(entries, children + ToIndex(i), groups[i].first, groups[i].second, depth);
+  }
+
+  // Builds the subtree of a child which edge starts with the char at |depth| of the entries.
+  void BuildChild(std::vector<Entry> const & entries, uint32_t child, size_t begin, size_t end,
+                  size_t depth)
+  {
+    // Entries are sorted, so the common prefix of the group is the one of its first and
+    // last entries.
+    auto const & first = entries[begin].first;
+    auto const & last = entries[end - 1].first;
+    size_t lcp = depth + 1;
+    while (lcp < first.size() && lcp < last.size() && first[lcp] == last[lcp])
+      ++lcp;
+
+    m_nodes[child].m_labelBegin = ToIndex(m_labels.size());
+    m_labels.insert(m_labels.end(), first.begin() + depth, first.begin() + lcp);
+    m_nodes[child].m_labelEnd = ToIndex(m_labels.size());
+
+    Build(entries, child, begin, end, lcp);
+  }
+
+  void BuildParallel(std::vector<Entry> const & entries, TaskScheduler & scheduler)
+  {
+    size_t begin = 0;
+    size_t const end = entries.size();
+    std::vector<Value> rootValues;
+    while (begin < end && entries[begin].first.empty())
+      rootValues.push_back(entries[begin++].second);
+
+    std::vector<std::pair<size_t, size_t>> groups;
+    for (size_t i = begin; i < end;)
+    {
+      auto const groupEnd = GetGroupEnd(entries, i, end, 0 /* depth */);
+      groups.emplace_back(i, groupEnd);
+      i = groupEnd;
+    }
+
+    // Every part is a trie which root is a child of the root.
+    std::vector<CompactTrie> parts(groups.size());
+    ParallelFor(0, groups.size(), [&](size_t i) {
+      auto & part = parts[i];
+      part.m_nodes.resize(1);
+      part.BuildChild(entries, 0 /* child */, groups[i].first, groups[i].second, 0 /* depth */);
+    }, 1 /* minChunkSize */, scheduler);
+
+    // The root and its children go first, then the rest of the parts. Node i > 0 of the part
+    // p becomes the node base[p] + i - 1.
+    size_t numNodes = 1 + parts.size();
+    size_t numLabels = 0;
+    std::vector<size_t> bases;
+    for (auto const & part : parts)
+    {
+      bases.push_back(numNodes);
+      numNodes += part.m_nodes.size() - 1;
+      numLabels += part.m_labels.size();
+    }
+
+    m_nodes.assign(1 + parts.size(), Node());
+    m_nodes.reserve(numNodes);
+    m_labels.reserve(numLabels);
+    m_values = std::move(rootValues);
+
+    auto & root = m_nodes[0];
+    root.m_valuesEnd = ToIndex(m_values.size());
+    root.m_childrenBegin = 1;
+    root.m_childrenEnd = ToIndex(1 + parts.size());
+
+    for (size_t p = 0; p < parts.size(); ++p)
+    {
+      auto const & part = parts[p];
+      auto const labelsBase = ToIndex(m_labels.size());
+      auto const valuesBase = ToIndex(m_values.size());
+      auto const nodesBase = ToIndex(bases[p] - 1);
+
+      m_labels.insert(m_labels.end(), part.m_labels.begin(), part.m_labels.end());
+      m_values.insert(m_values.end(), part.m_values.begin(), part.m_values.end());
+
+      for (size_t i = 0; i < part.m_nodes.size(); ++i)
+      {
+        auto node = part.m_nodes[i];
+        node.m_labelBegin += labelsBase;
+        node.m_labelEnd += labelsBase;
+        node.m_valuesBegin += valuesBase;
+        node.m_valuesEnd += valuesBase;
+        if (node.m_childrenBegin != node.m_childrenEnd)
+        {
+          node.m_childrenBegin += nodesBase;
+          node.m_childrenEnd += nodesBase;
+        }
+        else
+        {
+          node.m_childrenBegin = node.m_childrenEnd = 0;
+        }
+
+        if (i == 0)
+          m_nodes[1 + p] = node;
+        else
+          m_nodes.push_back(node);
+      }
+    }
+    ASSERT_EQUAL(m_nodes.size(), numNodes, ());
+  }
+
+  // Finds the node which edge contains the end of |prefix|. |offset| is the number of chars
+  // of the edge label in |prefix|.
+  bool MoveTo(String const & prefix, uint32_t & node, size_t & offset) const
+  {
+    node = 0;
+    offset = 0;
+    auto it = prefix.begin();
+    while (it != prefix.end())
+    {
+      auto const & n = m_nodes[node];
+      auto const begin = m_nodes.begin() + n.m_childrenBegin;
+      auto const end = m_nodes.begin() + n.m_childrenEnd;
+      auto const child =
+          std::lower_bound(begin, end, *it, [this](Node const & c, Char const & ch) {
+            return m_labels[c.m_labelBegin] < ch;
+          });
+      if (child == end || m_labels[child->m_labelBegin] != *it)
+        return false;
+
+      node = static_cast<uint32_t>(child - m_nodes.begin());
+      offset = 0;
+      for (auto i = child->m_labelBegin; i < child->m_labelEnd && it != prefix.end(); ++i, ++it)
+      {
+        if (m_labels[i] != *it)
+          return false;
+        ++offset;
+      }
+    }
+    return true;
+  }
+
+  template <typename ToDo>
+  void ForEachInSubtree(uint32_t node, String & key, ToDo && toDo) const
+  {
+    auto const & n = m_nodes[node];
+    for (auto i = n.m_valuesBegin; i < n.m_valuesEnd; ++i)
+      toDo(static_cast<String const &>(key), m_values[i]);
+
+    for (auto c = n.m_childrenBegin; c < n.m_childrenEnd; ++c)
+    {
+      auto const size = key.size();
+      auto const & child = m_nodes[c];
+      key.insert(key.end(), m_labels.begin() + child.m_labelBegin,
+                 m_labels.begin() + child.m_labelEnd);
+      ForEachInSubtree(c, key, toDo);
+      key.resize(size);
+    }
+  }
+
+  std::vector<Node> m_nodes;
+  std::vector<Char> m_labels;
+  std::vector<Value> m_values;
+};
+
+// static
+template <typename String, typename Value>
+size_t constexpr CompactTrie<String, Value>::kMinParallelEntries;
+}  // namespace base
@@ -2,48 +2,14 @@
 
 namespace base
 {
-DeferredTask::DeferredTask(Duration const & duration) : m_duration(duration)
+DeferredTask::DeferredTask(Duration const & duration)
+  : m_wheel(TimerWheel::Instance())
+  , m_key(m_wheel.NewKey())
+  , m_duration(std::chrono::duration_cast<TimerWheel::Duration>(duration))
 {
-  m_thread = threads::SimpleThread([this]
-  {
-    std::unique_lock<std::mutex> l(m_mutex);
-    while (!m_terminate)
-    {
-      if (!m_fn)
-      {
-        m_cv.wait(l);
-        continue;
-      }
-
-      if (m_cv.wait_for(l, m_duration) != std::cv_status::timeout || !m_fn)
-        continue;
-
-      auto fn = move(m_fn);
-      m_fn = nullptr;
-
-      l.unlock();
-      fn();
-      l.lock();
-    }
-  });
 }
 
-DeferredTask::~DeferredTask()
-{
-  {
-    std::unique_lock<std::mutex> l(m_mutex);
-    m_terminate = true;
-  }
-  m_cv.notify_one();
-  m_thread.join();
-}
+DeferredTask::~DeferredTask() { m_wheel.CancelAndWait(m_key); }
 
-void DeferredTask::Drop()
-{
-  {
-    std::unique_lock<std::mutex> l(m_mutex);
-    m_fn = nullptr;
-  }
-  m_cv.notify_one();
-}
+void DeferredTask::Drop() { m_wheel.Cancel(m_key); }
 }  // namespace base
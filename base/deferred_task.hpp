@@ -1,20 +1,21 @@
 #pragma once
 
-#include "base/thread.hpp"
+#include "base/timer_wheel.hpp"
 
 #include <chrono>
-#include <condition_variable>
 #include <functional>
-#include <mutex>
 
 namespace base
 {
+// Executes the last function it was restarted with when |duration| passes after the restart.
+// Functions are executed on the thread of the shared timer wheel and must be short.
 class DeferredTask
 {
 public:
   using Duration = std::chrono::duration<double>;
 
   DeferredTask(Duration const & duration);
+  // Drops the pending function and waits for the running one.
   ~DeferredTask();
 
   void Drop();
@@ -22,19 +23,12 @@ public:
   template <typename Fn>
   void RestartWith(Fn const && fn)
   {
-    {
-      std::unique_lock<std::mutex> l(m_mutex);
-      m_fn = fn;
-    }
-    m_cv.notify_one();
+    m_wheel.Schedule(m_key, m_duration, TimerWheel::Task(fn));
   }
 
 private:
-  threads::SimpleThread m_thread;
-  std::mutex m_mutex;
-  std::condition_variable m_cv;
-  std::function<void()> m_fn;
-  Duration m_duration;
-  bool m_terminate = false;
+  TimerWheel & m_wheel;
+  TimerWheel::Key const m_key;
+  TimerWheel::Duration const m_duration;
 };
 }  // namespace base
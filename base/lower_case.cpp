@@ -178,9 +178,31 @@ void MakeLowerCaseInplace(UniString & s)
 {
   size_t const size = s.size();
 
+  // Chars are folded in place until a char which is replaced with several chars.
+  size_t i = 0;
+  for (; i < size; ++i)
+  {
+    UniChar const c = s[i];
+    if (c < 0x80)
+    {
+      if (c >= 'A' && c <= 'Z')
+        s[i] = c - 'A' + 'a';
+      continue;
+    }
+
+    UniChar const lc = LowerUniChar(c);
+    if (lc == 0)
+      break;
+    s[i] = lc;
+  }
+
+  if (i == size)
+    return;
+
   UniString r;
   r.reserve(size);
-  for (size_t i = 0; i < size; ++i)
+  r.append(s.begin(), s.begin() + i);
+  for (; i < size; ++i)
   {
     UniChar const c = LowerUniChar(s[i]);
     if (c != 0)
@@ -0,0 +1,215 @@
+#include "base/memory_budget.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace base
+{
+namespace
+{
+double GetWeight(MemoryBudget::Priority priority)
+{
+  switch (priority)
+  {
+  case MemoryBudget::Priority::Low: return 1.0;
+  case MemoryBudget::Priority::Normal: return 2.0;
+  case MemoryBudget::Priority::High: return 4.0;
+  }
+  CHECK_SWITCH();
+}
+
+// Part of the budget left on memory pressure.
+double GetPressureFactor(MemoryBudget::Pressure pressure)
+{
+  switch (pressure)
+  {
+  case MemoryBudget::Pressure::None: return 1.0;
+  case MemoryBudget::Pressure::Moderate: return 0.5;
+  case MemoryBudget::Pressure::Critical: return 0.25;
+  }
+  CHECK_SWITCH();
+}
+}  // namespace
+
+// static
+size_t constexpr MemoryBudget::kUnlimited;
+
+MemoryBudget::MemoryBudget(size_t totalBytes) : m_totalBytes(totalBytes) {}
+
+// static
+MemoryBudget & MemoryBudget::Instance()
+{
+  static MemoryBudget budget;
+  return budget;
+}
+
+bool MemoryBudget::Register(Client & client, string const & name, Priority priority,
+                            size_t requestedBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = find_if(m_entries.begin(), m_entries.end(),
+                          [&](Entry const & e) { return e.m_client == &client; });
+  if (it != m_entries.end())
+  {
+    LOG(LWARNING, ("Memory budget client is already registered:", name));
+    return false;
+  }
+
+  Entry entry;
+  entry.m_client = &client;
+  entry.m_name = name;
+  entry.m_priority = priority;
+  entry.m_requestedBytes = requestedBytes;
+  m_entries.push_back(move(entry));
+
+  Rebalance(&client);
+  return true;
+}
+
+bool MemoryBudget::Unregister(Client const & client)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = find_if(m_entries.begin(), m_entries.end(),
+                          [&](Entry const & e) { return e.m_client == &client; });
+  if (it == m_entries.end())
+    return false;
+
+  m_entries.erase(it);
+  Rebalance(nullptr /* newClient */);
+  return true;
+}
+
+void MemoryBudget::SetTotalBytes(size_t totalBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_totalBytes = totalBytes;
+  Rebalance(nullptr /* newClient */);
+}
+
+void MemoryBudget::SetPressure(Pressure pressure)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_pressure == pressure)
+    return;
+
+  LOG(LINFO, ("Memory pressure:", pressure));
+  m_pressure = pressure;
+  Rebalance(nullptr /* newClient */);
+}
+
+size_t MemoryBudget::GetBudget(Client const & client) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = find_if(m_entries.begin(), m_entries.end(),
+                          [&](Entry const & e) { return e.m_client == &client; });
+  return it == m_entries.end() ? 0 : it->m_budgetBytes;
+}
+
+size_t MemoryBudget::GetTotalBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_totalBytes;
+}
+
+MemoryBudget::Pressure MemoryBudget::GetPressure() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_pressure;
+}
+
+void MemoryBudget::Rebalance(Client const * newClient)
+{
+  vector<size_t> budgets(m_entries.size(), 0);
+  vector<size_t> pending;
+
+  size_t requested = 0;
+  for (size_t i = 0; i < m_entries.size(); ++i)
+  {
+    auto const & e = m_entries[i];
+    if (m_pressure == Pressure::Critical && e.m_priority == Priority::Low)
+      continue;
+    requested += min(e.m_requestedBytes, kUnlimited - requested);
+    pending.push_back(i);
+  }
+
+  // When everything fits, the budget is cut relative to the requested sizes only.
+  double remaining =
+      static_cast<double>(min(m_totalBytes, requested)) * GetPressureFactor(m_pressure);
+
+  // Clients which request less than their shares get what they request, and the rest
+  // is split again between other clients, until no client is satisfied.
+  while (!pending.empty())
+  {
+    double sumWeights = 0.0;
+    for (auto const i : pending)
+      sumWeights += GetWeight(m_entries[i].m_priority);
+
+    vector<size_t> unsatisfied;
+    double satisfied = 0.0;
+    for (auto const i : pending)
+    {
+      auto const & e = m_entries[i];
+      double const share = remaining * GetWeight(e.m_priority) / sumWeights;
+      // Half a byte is allowed for rounding errors.
+      if (static_cast<double>(e.m_requestedBytes) <= share + 0.5)
+      {
+        budgets[i] = e.m_requestedBytes;
+        satisfied += static_cast<double>(e.m_requestedBytes);
+      }
+      else
+      {
+        unsatisfied.push_back(i);
+      }
+    }
+
+    if (unsatisfied.size() == pending.size())
+    {
+      for (auto const i : pending)
+      {
+        double const weight = GetWeight(m_entries[i].m_priority);
+        budgets[i] = static_cast<size_t>(remaining * weight / sumWeights);
+      }
+      break;
+    }
+
+    remaining = max(remaining - satisfied, 0.0);
+    pending.swap(unsatisfied);
+  }
+
+  for (size_t i = 0; i < m_entries.size(); ++i)
+  {
+    auto & e = m_entries[i];
+    if (e.m_budgetBytes == budgets[i] && e.m_client != newClient)
+      continue;
+    e.m_budgetBytes = budgets[i];
+    LOG(LDEBUG, ("Memory budget of", e.m_name, "is", e.m_budgetBytes, "bytes"));
+    e.m_client->OnBudgetChanged(e.m_budgetBytes);
+  }
+}
+
+string DebugPrint(MemoryBudget::Priority priority)
+{
+  switch (priority)
+  {
+  case MemoryBudget::Priority::Low: return "Low";
+  case MemoryBudget::Priority::Normal: return "Normal";
+  case MemoryBudget::Priority::High: return "High";
+  }
+  CHECK_SWITCH();
+}
+
+string DebugPrint(MemoryBudget::Pressure pressure)
+{
+  switch (pressure)
+  {
+  case MemoryBudget::Pressure::None: return "None";
+  case MemoryBudget::Pressure::Moderate: return "Moderate";
+  case MemoryBudget::Pressure::Critical: return "Critical";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace base
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace base
+{
+// Governor of memory used by caches of the process.
+//
+// A cache registers itself as a client with a priority and the size it would like to have.
+// The total budget is split between clients in proportion to weights of their priorities,
+// a client never gets more than it requested and the rest is given to other clients.
+// When the budget of a client changes, OnBudgetChanged() is called and the client must
+// shrink to the new budget (or may grow up to it).
+//
+// On memory pressure signals from the OS the budget is cut, and on critical pressure clients
+// with low priority are asked to drop everything.
+//
+// *NOTE* All methods are thread-safe. OnBudgetChanged() is called under the governor lock,
+// so clients must not call the governor from it.
+class MemoryBudget
+{
+public:
+  enum class Priority
+  {
+    // Caches which are cheap to refill, e.g. caches of intermediate results.
+    Low,
+    Normal,
+    // Caches which are expensive to refill or needed for interactive work.
+    High
+  };
+
+  enum class Pressure
+  {
+    None,
+    Moderate,
+    Critical
+  };
+
+  class Client
+  {
+  public:
+    virtual ~Client() = default;
+
+    virtual void OnBudgetChanged(size_t budgetBytes) = 0;
+  };
+
+  static size_t constexpr kUnlimited = std::numeric_limits<size_t>::max();
+
+  explicit MemoryBudget(size_t totalBytes = kUnlimited);
+
+  // The governor shared by the whole process.
+  static MemoryBudget & Instance();
+
+  // Calls OnBudgetChanged() of |client| with its initial budget. Returns false if |client|
+  // is already registered.
+  bool Register(Client & client, std::string const & name, Priority priority,
+                size_t requestedBytes);
+  bool Unregister(Client const & client);
+
+  void SetTotalBytes(size_t totalBytes);
+  void SetPressure(Pressure pressure);
+
+  size_t GetBudget(Client const & client) const;
+  size_t GetTotalBytes() const;
+  Pressure GetPressure() const;
+
+private:
+  struct Entry
+  {
+    Client * m_client = nullptr;
+    std::string m_name;
+    Priority m_priority = Priority::Normal;
+    size_t m_requestedBytes = 0;
+    size_t m_budgetBytes = 0;
+  };
+
+  // Recomputes budgets of all clients and notifies clients whose budgets are changed
+  // and |newClient|, if any.
+  void Rebalance(Client const * newClient);
+
+  mutable std::mutex m_mutex;
+  std::vector<Entry> m_entries;
+  size_t m_totalBytes;
+  Pressure m_pressure = Pressure::None;
+
+  DISALLOW_COPY_AND_MOVE(MemoryBudget);
+};
+
+std::string DebugPrint(MemoryBudget::Priority priority);
+std::string DebugPrint(MemoryBudget::Pressure pressure);
+}  // namespace base
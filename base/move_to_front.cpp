@@ -30,4 +30,12 @@ uint8_t MoveToFront::Transform(uint8_t b)
   ASSERT_EQUAL(m_order[0], b, ());
   return static_cast<uint8_t>(result);
 }
+
+uint8_t MoveToFront::InverseTransform(uint8_t i)
+{
+  uint8_t const b = m_order[i];
+  memmove(m_order.data() + 1, m_order.data(), i);
+  m_order[0] = b;
+  return b;
+}
 }  // namespace base
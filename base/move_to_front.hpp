@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -17,6 +18,10 @@ public:
   // to the first positions.
   uint8_t Transform(uint8_t b);
 
+  // Returns the byte at the |i|-th position, then, moves it to the first position.
+  // Reverts Transform().
+  uint8_t InverseTransform(uint8_t i);
+
   uint8_t operator[](uint8_t i) const { return m_order[i]; }
 
 private:
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace base
+{
+// Lock-free multi-producer single-consumer queue.
+//
+// Producers push elements with a single CAS and never block each other. The consumer takes
+// all pushed elements at once, in the order of pushes. Several consumers are allowed only
+// when their PopAll() calls are serialized by the caller.
+//
+// The consumer may sleep in Wait() until an element is pushed. Producers take the lock
+// only when the consumer is sleeping, so pushes to a busy consumer are lock-free.
+template <typename T>
+class MpscQueue
+{
+public:
+  MpscQueue() = default;
+  ~MpscQueue() { Clear(); }
+
+  void Push(T && value) { PushNode(new Node(std::move(value))); }
+  void Push(T const & value) { PushNode(new Node(value)); }
+
+  // Calls |fn| for all pushed elements in the order of pushes. Returns the number of elements.
+  template <typename Fn>
+  size_t PopAll(Fn && fn)
+  {
+    // The stack of pushed nodes is reversed to restore the order of pushes.
+    Node * node = m_head.exchange(nullptr);
+    Node * reversed = nullptr;
+    while (node != nullptr)
+    {
+      Node * next = node->m_next;
+      node->m_next = reversed;
+      reversed = node;
+      node = next;
+    }
+
+    size_t count = 0;
+    while (reversed != nullptr)
+    {
+      std::unique_ptr<Node> current(reversed);
+      reversed = reversed->m_next;
+      fn(std::move(current->m_value));
+      ++count;
+    }
+    return count;
+  }
+
+  bool IsEmpty() const { return m_head.load() == nullptr; }
+
+  void Clear()
+  {
+    PopAll([](T &&) {});
+  }
+
+  // Blocks the consumer until the queue is not empty or Wake() is called.
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sleeping = true;
+    m_condition.wait(lock, [this]() { return m_woken || !IsEmpty(); });
+    m_sleeping = false;
+    m_woken = false;
+  }
+
+  // Wakes the consumer up. When the consumer isn't sleeping, its next Wait() returns
+  // immediately, so wake-ups aren't lost.
+  void Wake()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_woken = true;
+    m_condition.notify_all();
+  }
+
+private:
+  struct Node
+  {
+    explicit Node(T && value) : m_value(std::move(value)) {}
+    explicit Node(T const & value) : m_value(value) {}
+
+    T m_value;
+    Node * m_next = nullptr;
+  };
+
+  void PushNode(Node * node)
+  {
+    node->m_next = m_head.load();
+    while (!m_head.compare_exchange_weak(node->m_next, node))
+    {
+    }
+
+    // Both the push and the check are sequentially consistent, so either the consumer sees
+    // the node before sleeping or the producer sees that the consumer is sleeping.
+    if (m_sleeping.load())
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_condition.notify_all();
+    }
+  }
+
+  std::atomic<Node *> m_head{nullptr};
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::atomic<bool> m_sleeping{false};
+  bool m_woken = false;
+
+  DISALLOW_COPY_AND_MOVE(MpscQueue);
+};
+}  // namespace base
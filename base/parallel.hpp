@@ -0,0 +1,166 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Data-parallel algorithms over TaskScheduler. The calling thread executes a part of the work
+// too, so the algorithms may be called from tasks of the scheduler.
+//
+// When |fn| throws, chunks which haven't started yet are skipped and the first exception is
+// rethrown to the caller after all running chunks are done.
+namespace base
+{
+namespace parallel
+{
+// Number of chunks for |size| elements: a few chunks per worker to balance the load when
+// chunks take different time, but not less than |minChunkSize| elements per chunk so that
+// the overhead of tasks doesn't dominate.
+inline size_t GetChunksCount(size_t size, size_t workersCount, size_t minChunkSize)
+{
+  size_t const kChunksPerWorker = 4;
+  minChunkSize = std::max(minChunkSize, static_cast<size_t>(1));
+  size_t const maxChunks = std::max(workersCount, static_cast<size_t>(1)) * kChunksPerWorker;
+  return std::max(std::min(maxChunks, size / minChunkSize), static_cast<size_t>(1));
+}
+
+// Calls |fn(chunk)| for chunk in [0, chunksCount) on |scheduler| and on the calling thread.
+template <typename Fn>
+void RunChunks(size_t chunksCount, Fn && fn, TaskScheduler & scheduler)
+{
+  std::mutex mu;
+  std::exception_ptr error;
+  TaskGroup group(scheduler);
+
+  auto const run = [&](size_t chunk) {
+    try
+    {
+      fn(chunk);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      if (!error)
+        error = std::current_exception();
+      group.Cancel();
+    }
+  };
+
+  // Without workers pushed chunks would never be executed.
+  bool const push = scheduler.GetWorkersCount() != 0;
+  for (size_t chunk = 1; chunk < chunksCount; ++chunk)
+  {
+    if (!push || !group.Push([&run, chunk]() { run(chunk); }))
+      run(chunk);
+  }
+  if (chunksCount != 0)
+    run(0);
+  group.Wait();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+}  // namespace parallel
+
+// Calls |fn(i)| for every i in [begin, end).
+template <typename Fn>
+void ParallelFor(size_t begin, size_t end, Fn && fn, size_t minChunkSize = 1,
+                 TaskScheduler & scheduler = TaskScheduler::Instance())
+{
+  if (begin >= end)
+    return;
+
+  size_t const size = end - begin;
+  size_t const chunks =
+      parallel::GetChunksCount(size, scheduler.GetWorkersCount(), minChunkSize);
+  parallel::RunChunks(chunks, [&](size_t chunk) {
+    size_t const to = begin + size * (chunk + 1) / chunks;
+    for (size_t i = begin + size * chunk / chunks; i < to; ++i)
+      fn(i);
+  }, scheduler);
+}
+
+// Returns reduce(...reduce(reduce(init, transform(begin)), transform(begin + 1))...).
+// |reduce| must be associative, results of chunks are reduced in the order of chunks, so
+// the result doesn't depend on the number of workers when |reduce| isn't commutative.
+template <typename T, typename Transform, typename Reduce>
+T ParallelTransformReduce(size_t begin, size_t end, T init, Transform && transform,
+                          Reduce && reduce, size_t minChunkSize = 1,
+                          TaskScheduler & scheduler = TaskScheduler::Instance())
+{
+  if (begin >= end)
+    return init;
+
+  size_t const size = end - begin;
+  size_t const chunks =
+      parallel::GetChunksCount(size, scheduler.GetWorkersCount(), minChunkSize);
+  std::vector<T> results(chunks);
+  parallel::RunChunks(chunks, [&](size_t chunk) {
+    size_t const from = begin + size * chunk / chunks;
+    size_t const to = begin + size * (chunk + 1) / chunks;
+    ASSERT_LESS(from, to, ());
+    T result = transform(from);
+    for (size_t i = from + 1; i < to; ++i)
+      result = reduce(std::move(result), transform(i));
+    results[chunk] = std::move(result);
+  }, scheduler);
+
+  for (auto & result : results)
+    init = reduce(std::move(init), std::move(result));
+  return init;
+}
+
+// Sorts [first, last) by |comp|: chunks are sorted in parallel and then merged by pairs
+// in parallel rounds. Like std::sort, the sort isn't stable.
+template <typename It, typename Compare>
+void ParallelSort(It first, It last, Compare comp, size_t minChunkSize = 4096,
+                  TaskScheduler & scheduler = TaskScheduler::Instance())
+{
+  auto const size = static_cast<size_t>(std::distance(first, last));
+  size_t const chunks =
+      parallel::GetChunksCount(size, scheduler.GetWorkersCount(), minChunkSize);
+  if (chunks <= 1)
+  {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  std::vector<It> bounds;
+  for (size_t chunk = 0; chunk <= chunks; ++chunk)
+    bounds.push_back(std::next(first, size * chunk / chunks));
+
+  parallel::RunChunks(chunks, [&](size_t chunk) {
+    std::sort(bounds[chunk], bounds[chunk + 1], comp);
+  }, scheduler);
+
+  // Sorted runs [bounds[i], bounds[i + 1]) are merged by pairs until one run is left.
+  while (bounds.size() > 2)
+  {
+    size_t const pairs = (bounds.size() - 1) / 2;
+    parallel::RunChunks(pairs, [&](size_t pair) {
+      std::inplace_merge(bounds[2 * pair], bounds[2 * pair + 1], bounds[2 * pair + 2], comp);
+    }, scheduler);
+
+    std::vector<It> merged;
+    for (size_t i = 0; i < bounds.size(); i += 2)
+      merged.push_back(bounds[i]);
+    if (merged.back() != bounds.back())
+      merged.push_back(bounds.back());
+    bounds.swap(merged);
+  }
+}
+
+template <typename It>
+void ParallelSort(It first, It last)
+{
+  ParallelSort(first, last, std::less<typename std::iterator_traits<It>::value_type>());
+}
+}  // namespace base
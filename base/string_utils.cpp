@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iterator>
 
@@ -21,6 +23,39 @@
 
 namespace strings
 {
+namespace
+{
+// Returns the length of the ASCII prefix of [s, s + n). Eight bytes are checked at once.
+size_t GetASCIIPrefixLength(char const * s, size_t n)
+{
+  uint64_t constexpr kHighBits = 0x8080808080808080ULL;
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, s + i, sizeof(word));
+    if ((word & kHighBits) != 0)
+      break;
+  }
+
+  while (i < n && (s[i] & 0x80) == 0)
+    ++i;
+  return i;
+}
+
+char ascii_to_lower(char in)
+{
+  char const diff = 'z' - 'Z';
+  static_assert(diff == 'a' - 'A', "");
+  static_assert(diff > 0, "");
+
+  if (in >= 'A' && in <= 'Z')
+    return (in + diff);
+  return in;
+}
+}  // namespace
+
 bool UniString::IsEqualAscii(char const * s) const
 {
   return (size() == strlen(s) && std::equal(begin(), end(), s));
@@ -129,10 +164,18 @@ UniString MakeLowerCase(UniString const & s)
 
 void MakeLowerCaseInplace(std::string & s)
 {
+  // Case folding of ASCII chars doesn't depend on other chars, so the ASCII prefix is folded
+  // in place and only the rest is decoded.
+  size_t const prefix = GetASCIIPrefixLength(s.data(), s.size());
+  for (size_t i = 0; i < prefix; ++i)
+    s[i] = ascii_to_lower(s[i]);
+  if (prefix == s.size())
+    return;
+
   UniString uniStr;
-  utf8::unchecked::utf8to32(s.begin(), s.end(), std::back_inserter(uniStr));
+  utf8::unchecked::utf8to32(s.begin() + prefix, s.end(), std::back_inserter(uniStr));
   MakeLowerCaseInplace(uniStr);
-  s.clear();
+  s.resize(prefix);
   utf8::unchecked::utf32to8(uniStr.begin(), uniStr.end(), back_inserter(s));
 }
 
@@ -200,20 +243,6 @@ void NormalizeDigits(UniString & us)
   }
 }
 
-namespace
-{
-char ascii_to_lower(char in)
-{
-  char const diff = 'z' - 'Z';
-  static_assert(diff == 'a' - 'A', "");
-  static_assert(diff > 0, "");
-
-  if (in >= 'A' && in <= 'Z')
-    return (in + diff);
-  return in;
-}
-}
-
 void AsciiToLower(std::string & s) { transform(s.begin(), s.end(), s.begin(), &ascii_to_lower); }
 void Trim(std::string & s) { boost::trim(s); }
 void Trim(std::string & s, char const * anyOf) { boost::trim_if(s, boost::is_any_of(anyOf)); }
@@ -225,23 +254,46 @@ bool EqualNoCase(std::string const & s1, std::string const & s2)
 UniString MakeUniString(std::string const & utf8s)
 {
   UniString result;
-  utf8::unchecked::utf8to32(utf8s.begin(), utf8s.end(), std::back_inserter(result));
+  MakeUniString(utf8s, result);
   return result;
 }
 
+void MakeUniString(std::string const & utf8s, UniString & result)
+{
+  size_t const prefix = GetASCIIPrefixLength(utf8s.data(), utf8s.size());
+  result.resize_no_init(prefix);
+  for (size_t i = 0; i < prefix; ++i)
+    result[i] = static_cast<UniChar>(utf8s[i]);
+
+  // The number of chars isn't known here, so the rest isn't reserved to not make
+  // a dynamic buffer for short strings.
+  if (prefix != utf8s.size())
+    utf8::unchecked::utf8to32(utf8s.begin() + prefix, utf8s.end(), std::back_inserter(result));
+}
+
 std::string ToUtf8(UniString const & s)
 {
   std::string result;
-  utf8::unchecked::utf32to8(s.begin(), s.end(), back_inserter(result));
+  ToUtf8(s, result);
   return result;
 }
 
+void ToUtf8(UniString const & s, std::string & result)
+{
+  result.clear();
+  result.reserve(s.size());
+  for (UniChar const c : s)
+  {
+    if (c < 0x80)
+      result.push_back(static_cast<char>(c));
+    else
+      utf8::unchecked::append(c, back_inserter(result));
+  }
+}
+
 bool IsASCIIString(std::string const & str)
 {
-  for (size_t i = 0; i < str.size(); ++i)
-    if (str[i] & 0x80)
-      return false;
-  return true;
+  return GetASCIIPrefixLength(str.data(), str.size()) == str.size();
 }
 
 bool IsASCIIDigit(UniChar c) { return c >= '0' && c <= '9'; }
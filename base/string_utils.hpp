@@ -89,6 +89,10 @@ bool EqualNoCase(std::string const & s1, std::string const & s2);
 
 UniString MakeUniString(std::string const & utf8s);
 std::string ToUtf8(UniString const & s);
+/// Same as above but write to |result| and reuse its buffer, so no memory is allocated
+/// when the buffer is large enough.
+void MakeUniString(std::string const & utf8s, UniString & result);
+void ToUtf8(UniString const & s, std::string & result);
 bool IsASCIIString(std::string const & str);
 bool IsASCIIDigit(UniChar c);
 bool IsASCIISpace(UniChar c);
@@ -0,0 +1,294 @@
+#include "base/task_scheduler.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+namespace base
+{
+// TaskScheduler::Stats ----------------------------------------------------------------------------
+double TaskScheduler::Stats::GetUtilization() const
+{
+  if (m_workersCount == 0 || m_uptime.count() <= 0)
+    return 0.0;
+  return static_cast<double>(m_busy.count()) /
+         (static_cast<double>(m_uptime.count()) * m_workersCount);
+}
+
+// TaskScheduler -----------------------------------------------------------------------------------
+// static
+size_t constexpr TaskScheduler::kNoWorker;
+
+TaskScheduler::TaskScheduler(size_t workersCount, Exit e) : m_exit(e), m_start(Clock::now())
+{
+  // Workers wait for |m_ids| to be filled before taking tasks.
+  lock_guard<mutex> lk(m_startMu);
+  for (size_t i = 0; i < workersCount; ++i)
+    m_workers.push_back(make_unique<Worker>());
+  for (size_t i = 0; i < workersCount; ++i)
+  {
+    m_threads.emplace_back(threads::SimpleThread(&TaskScheduler::ProcessTasks, this, i));
+    m_ids.push_back(m_threads.back().get_id());
+  }
+}
+
+TaskScheduler::~TaskScheduler() { ShutdownAndJoin(); }
+
+// static
+TaskScheduler & TaskScheduler::Instance()
+{
+  static TaskScheduler scheduler(max(thread::hardware_concurrency(), 1U));
+  return scheduler;
+}
+
+bool TaskScheduler::Push(Task && task) { return Push(MoveOnlyTask(move(task)), Priority::Normal); }
+
+bool TaskScheduler::Push(Task const & task) { return Push(MoveOnlyTask(task), Priority::Normal); }
+
+bool TaskScheduler::Push(MoveOnlyTask && task, Priority priority)
+{
+  {
+    lock_guard<mutex> lk(m_mu);
+    if (m_shutdown)
+      return false;
+    ++m_queued;
+  }
+
+  auto const p = static_cast<size_t>(priority);
+  auto const index = GetWorkerIndex();
+  if (index == kNoWorker)
+  {
+    lock_guard<mutex> lk(m_sharedMu);
+    m_shared[p].push_back(move(task));
+  }
+  else
+  {
+    auto & worker = *m_workers[index];
+    lock_guard<mutex> lk(worker.m_mu);
+    worker.m_queues[p].push_back(move(task));
+  }
+
+  m_cv.notify_one();
+  return true;
+}
+
+bool TaskScheduler::RunPendingTask()
+{
+  auto const index = GetWorkerIndex();
+  MoveOnlyTask task;
+  if (!TakeTask(index, task))
+    return false;
+  Execute(index, task);
+  return true;
+}
+
+TaskScheduler::Stats TaskScheduler::GetStats() const
+{
+  Stats stats;
+  stats.m_workersCount = m_workers.size();
+  int64_t busyNs = 0;
+  for (auto const & worker : m_workers)
+  {
+    stats.m_executed += worker->m_executed;
+    stats.m_stolen += worker->m_stolen;
+    busyNs += worker->m_busyNs;
+  }
+  stats.m_busy = chrono::duration_cast<Clock::duration>(chrono::nanoseconds(busyNs));
+  stats.m_uptime = Clock::now() - m_start;
+  return stats;
+}
+
+bool TaskScheduler::Shutdown(Exit e)
+{
+  lock_guard<mutex> lk(m_mu);
+  if (m_shutdown)
+    return false;
+  m_shutdown = true;
+  m_exit = e;
+  m_cv.notify_all();
+  return true;
+}
+
+void TaskScheduler::ShutdownAndJoin()
+{
+  ASSERT(!IsWorkerThread(), ());
+  Shutdown(m_exit);
+  for (auto & thread : m_threads)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+  m_threads.clear();
+
+  if (m_exit == Exit::ExecPending)
+  {
+    MoveOnlyTask task;
+    while (TakeTask(kNoWorker, task))
+      task();
+    return;
+  }
+
+  for (auto & worker : m_workers)
+  {
+    lock_guard<mutex> lk(worker->m_mu);
+    for (auto & queue : worker->m_queues)
+      queue.clear();
+  }
+  lock_guard<mutex> lk(m_sharedMu);
+  for (auto & queue : m_shared)
+    queue.clear();
+}
+
+size_t TaskScheduler::GetWorkerIndex() const
+{
+  auto const it = find(m_ids.begin(), m_ids.end(), this_thread::get_id());
+  if (it == m_ids.end())
+    return kNoWorker;
+  return static_cast<size_t>(distance(m_ids.begin(), it));
+}
+
+bool TaskScheduler::TakeTask(size_t index, MoveOnlyTask & task)
+{
+  auto const take = [&](Queue & queue, bool back) {
+    if (queue.empty())
+      return false;
+    if (back)
+    {
+      task = move(queue.back());
+      queue.pop_back();
+    }
+    else
+    {
+      task = move(queue.front());
+      queue.pop_front();
+    }
+    --m_queued;
+    return true;
+  };
+
+  for (size_t p = 0; p < static_cast<size_t>(Priority::Count); ++p)
+  {
+    if (index != kNoWorker)
+    {
+      auto & worker = *m_workers[index];
+      lock_guard<mutex> lk(worker.m_mu);
+      if (take(worker.m_queues[p], true /* back */))
+        return true;
+    }
+
+    {
+      lock_guard<mutex> lk(m_sharedMu);
+      if (take(m_shared[p], false /* back */))
+        return true;
+    }
+
+    // Victims are visited starting from the next worker to spread the steals.
+    size_t const first = index == kNoWorker ? 0 : index + 1;
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      size_t const victim = (first + i) % m_workers.size();
+      if (victim == index)
+        continue;
+
+      auto & worker = *m_workers[victim];
+      lock_guard<mutex> lk(worker.m_mu);
+      if (take(worker.m_queues[p], false /* back */))
+      {
+        if (index != kNoWorker)
+          ++m_workers[index]->m_stolen;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void TaskScheduler::Execute(size_t index, MoveOnlyTask & task)
+{
+  if (index == kNoWorker)
+  {
+    task();
+    return;
+  }
+
+  // Tasks which are executed by waiters inside of other tasks are already in the busy time.
+  auto & worker = *m_workers[index];
+  bool const outermost = worker.m_depth++ == 0;
+  auto const start = Clock::now();
+  task();
+  --worker.m_depth;
+  if (outermost)
+    worker.m_busyNs += chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+  ++worker.m_executed;
+}
+
+void TaskScheduler::ProcessTasks(size_t index)
+{
+  {
+    lock_guard<mutex> lk(m_startMu);
+  }
+
+  while (true)
+  {
+    MoveOnlyTask task;
+    if (TakeTask(index, task))
+    {
+      Execute(index, task);
+      continue;
+    }
+
+    unique_lock<mutex> lk(m_mu);
+    m_cv.wait(lk, [this]() { return m_shutdown || m_queued != 0; });
+    if (m_shutdown && (m_exit == Exit::SkipPending || m_queued == 0))
+      break;
+  }
+}
+
+// TaskGroup ---------------------------------------------------------------------------------------
+TaskGroup::TaskGroup(TaskScheduler & scheduler)
+  : m_scheduler(scheduler), m_state(make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup() { Wait(); }
+
+bool TaskGroup::Push(MoveOnlyTask && task, TaskScheduler::Priority priority)
+{
+  ++m_state->m_pending;
+  bool const pushed = m_scheduler.Push(
+      [state = m_state, task = move(task)]() mutable {
+        if (!state->m_cancelled)
+          task();
+        if (--state->m_pending == 0)
+        {
+          lock_guard<mutex> lk(state->m_mu);
+          state->m_cv.notify_all();
+        }
+      },
+      priority);
+
+  if (!pushed)
+    --m_state->m_pending;
+  return pushed;
+}
+
+void TaskGroup::Wait()
+{
+  bool const help = m_scheduler.IsWorkerThread();
+  while (m_state->m_pending != 0)
+  {
+    if (help && m_scheduler.RunPendingTask())
+      continue;
+
+    unique_lock<mutex> lk(m_state->m_mu);
+    auto const done = [this]() { return m_state->m_pending == 0; };
+    if (help)
+      m_state->m_cv.wait_for(lk, chrono::milliseconds(1), done);
+    else
+      m_state->m_cv.wait(lk, done);
+  }
+}
+}  // namespace base
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/task_loop.hpp"
+#include "base/thread.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// Move-only callable. Unlike std::function it accepts lambdas which capture move-only values,
+// e.g. unique_ptr or promise.
+class MoveOnlyTask
+{
+public:
+  MoveOnlyTask() = default;
+
+  template <typename Fn, typename = std::enable_if_t<
+                             !std::is_same<std::decay_t<Fn>, MoveOnlyTask>::value>>
+  MoveOnlyTask(Fn && fn) : m_impl(std::make_unique<Impl<std::decay_t<Fn>>>(std::forward<Fn>(fn)))
+  {
+  }
+
+  MoveOnlyTask(MoveOnlyTask &&) = default;
+  MoveOnlyTask & operator=(MoveOnlyTask &&) = default;
+
+  void operator()() { m_impl->Run(); }
+  explicit operator bool() const { return m_impl != nullptr; }
+
+private:
+  struct Base
+  {
+    virtual ~Base() = default;
+    virtual void Run() = 0;
+  };
+
+  template <typename Fn>
+  struct Impl : Base
+  {
+    explicit Impl(Fn && fn) : m_fn(std::move(fn)) {}
+    explicit Impl(Fn const & fn) : m_fn(fn) {}
+
+    void Run() override { m_fn(); }
+
+    Fn m_fn;
+  };
+
+  std::unique_ptr<Base> m_impl;
+
+  DISALLOW_COPY(MoveOnlyTask);
+};
+
+// Thread pool with work stealing.
+//
+// Every worker has its own deques of tasks. Tasks which are pushed by a worker go to the back
+// of its deque and the worker takes them from the back, so nested tasks are executed while
+// their data is hot. Idle workers steal tasks from the fronts of deques of other workers.
+// Tasks which are pushed by other threads go to the shared queue and are executed in FIFO order.
+// High priority tasks are taken before normal priority ones.
+//
+// Subsystems should use Instance() or TaskGroup over it instead of their own threads, so
+// the whole process shares the cores.
+//
+// *NOTE* Push* methods are thread-safe, but the scheduler must not be shut down or destroyed
+// by its own workers.
+class TaskScheduler : public TaskLoop
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Priority
+  {
+    High,
+    Normal,
+    // Background work which is executed only when there are no other tasks.
+    Low,
+
+    Count
+  };
+
+  enum class Exit
+  {
+    ExecPending,
+    SkipPending
+  };
+
+  struct Stats
+  {
+    // Fraction of time the workers have spent in tasks since the start.
+    double GetUtilization() const;
+
+    size_t m_workersCount = 0;
+    uint64_t m_executed = 0;
+    uint64_t m_stolen = 0;
+    Clock::duration m_busy = {};
+    Clock::duration m_uptime = {};
+  };
+
+  // |workersCount| may be zero, pending tasks are executed by ShutdownAndJoin() then.
+  explicit TaskScheduler(size_t workersCount, Exit e = Exit::SkipPending);
+  ~TaskScheduler() override;
+
+  // The scheduler shared by the whole process, has a worker per hardware thread.
+  static TaskScheduler & Instance();
+
+  // TaskLoop overrides:
+  bool Push(Task && task) override;
+  bool Push(Task const & task) override;
+
+  // Returns false when the scheduler is shut down.
+  bool Push(MoveOnlyTask && task, Priority priority);
+
+  // Executes a single pending task on the calling thread. Returns false when there are
+  // no pending tasks. Used by waiters to help instead of blocking workers.
+  bool RunPendingTask();
+
+  // Returns true when the calling thread is a worker of this scheduler.
+  bool IsWorkerThread() const { return GetWorkerIndex() != kNoWorker; }
+
+  size_t GetWorkersCount() const { return m_workers.size(); }
+  Stats GetStats() const;
+
+  // Sends a signal to the workers to shut down. Returns false when the scheduler was shut
+  // down previously.
+  bool Shutdown(Exit e);
+
+  // Sends a signal to the workers to shut down and waits for completion. When pending tasks
+  // are executed, the ones left by the workers are executed on the calling thread.
+  void ShutdownAndJoin();
+
+private:
+  static size_t constexpr kNoWorker = static_cast<size_t>(-1);
+
+  using Queue = std::deque<MoveOnlyTask>;
+  using Queues = std::array<Queue, static_cast<size_t>(Priority::Count)>;
+
+  struct Worker
+  {
+    std::mutex m_mu;
+    Queues m_queues;
+
+    std::atomic<uint64_t> m_executed{0};
+    std::atomic<uint64_t> m_stolen{0};
+    std::atomic<int64_t> m_busyNs{0};
+    // Depth of nested executions, is used by the worker's thread only.
+    size_t m_depth = 0;
+  };
+
+  size_t GetWorkerIndex() const;
+  bool TakeTask(size_t index, MoveOnlyTask & task);
+  void Execute(size_t index, MoveOnlyTask & task);
+  void ProcessTasks(size_t index);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<threads::SimpleThread> m_threads;
+  // Ids of threads are written before the threads take tasks and aren't changed later.
+  std::vector<std::thread::id> m_ids;
+  std::mutex m_startMu;
+
+  std::mutex m_sharedMu;
+  Queues m_shared;
+
+  // Number of queued tasks, is increased under |m_mu| to not miss wakeups of workers.
+  std::atomic<size_t> m_queued{0};
+  std::mutex m_mu;
+  std::condition_variable m_cv;
+  bool m_shutdown = false;
+  Exit m_exit;
+
+  Clock::time_point const m_start;
+};
+
+// Group of tasks which are waited for and cancelled together.
+class TaskGroup
+{
+public:
+  explicit TaskGroup(TaskScheduler & scheduler = TaskScheduler::Instance());
+  // Waits for the tasks of the group.
+  ~TaskGroup();
+
+  // Returns false when the scheduler is shut down.
+  bool Push(MoveOnlyTask && task,
+            TaskScheduler::Priority priority = TaskScheduler::Priority::Normal);
+
+  // Waits until all pushed tasks are executed or skipped. Workers of the scheduler execute
+  // other pending tasks while waiting, so groups may be waited for inside of tasks.
+  void Wait();
+
+  // Tasks of the group which haven't started yet are skipped. Running tasks may check
+  // IsCancelled() to stop early.
+  void Cancel() { m_state->m_cancelled = true; }
+  bool IsCancelled() const { return m_state->m_cancelled; }
+
+private:
+  struct State
+  {
+    std::atomic<bool> m_cancelled{false};
+    std::atomic<size_t> m_pending{0};
+    std::mutex m_mu;
+    std::condition_variable m_cv;
+  };
+
+  TaskScheduler & m_scheduler;
+  std::shared_ptr<State> m_state;
+
+  DISALLOW_COPY_AND_MOVE(TaskGroup);
+};
+}  // namespace base
@@ -1,61 +1,19 @@
 #include "base/thread_pool.hpp"
 
+#include "base/task_scheduler.hpp"
 #include "base/thread.hpp"
-#include "base/threaded_list.hpp"
 
-#include <functional>
-#include <memory>
-#include <utility>
-#include <vector>
+#include <atomic>
 
 namespace threads
 {
-  namespace
-  {
-    typedef std::function<threads::IRoutine *()> TPopRoutineFn;
-
-    class PoolRoutine : public IRoutine
-    {
-    public:
-      PoolRoutine(const TPopRoutineFn & popFn, const TFinishRoutineFn & finishFn)
-        : m_popFn(popFn)
-        , m_finishFn(finishFn)
-      {
-      }
-
-      virtual void Do()
-      {
-        while (!IsCancelled())
-        {
-          threads::IRoutine * task = m_popFn();
-          if (task == NULL)
-          {
-            Cancel();
-            continue;
-          }
-
-          if (!task->IsCancelled())
-            task->Do();
-          m_finishFn(task);
-        }
-      }
-
-    private:
-      TPopRoutineFn m_popFn;
-      TFinishRoutineFn m_finishFn;
-    };
-  }
-
+  // Tasks are executed by a work-stealing scheduler, PushFront() uses the high priority.
   class ThreadPool::Impl
   {
   public:
-    Impl(size_t size, const TFinishRoutineFn & finishFn) : m_finishFn(finishFn), m_threads(size)
+    Impl(size_t size, const TFinishRoutineFn & finishFn)
+      : m_finishFn(finishFn), m_scheduler(size, base::TaskScheduler::Exit::ExecPending)
     {
-      for (auto & thread : m_threads)
-      {
-        thread.reset(new threads::Thread());
-        thread->Create(std::make_unique<PoolRoutine>(std::bind(&ThreadPool::Impl::PopFront, this), m_finishFn));
-      }
     }
 
     ~Impl()
@@ -65,50 +23,48 @@ namespace threads
 
     void PushBack(threads::IRoutine * routine)
     {
-      m_tasks.PushBack(routine);
+      Push(routine, base::TaskScheduler::Priority::Normal);
     }
 
     void PushFront(threads::IRoutine * routine)
     {
-      m_tasks.PushFront(routine);
+      Push(routine, base::TaskScheduler::Priority::High);
     }
 
-    threads::IRoutine * PopFront()
+    void PushBackLowPriority(threads::IRoutine * routine)
     {
-      return m_tasks.Front(true);
+      Push(routine, base::TaskScheduler::Priority::Low);
     }
 
     void Stop()
     {
-      m_tasks.Cancel();
-
-      for (auto & thread : m_threads)
-        thread->Cancel();
-      m_threads.clear();
-
-      m_tasks.ProcessList([this](std::list<threads::IRoutine *> & tasks)
-                          {
-                            FinishTasksOnStop(tasks);
-                          });
-      m_tasks.Clear();
+      m_stopped = true;
+      // Pending tasks are executed as cancelled ones, i.e. only finished.
+      m_scheduler.ShutdownAndJoin();
     }
 
   private:
-    void FinishTasksOnStop(std::list<threads::IRoutine *> & tasks)
+    void Push(threads::IRoutine * routine, base::TaskScheduler::Priority priority)
     {
-      typedef std::list<threads::IRoutine *>::iterator task_iter;
-      for (task_iter it = tasks.begin(); it != tasks.end(); ++it)
+      bool const pushed = m_scheduler.Push([this, routine]()
+                                           {
+                                             if (m_stopped)
+                                               routine->Cancel();
+                                             if (!routine->IsCancelled())
+                                               routine->Do();
+                                             m_finishFn(routine);
+                                           }, priority);
+      if (!pushed)
       {
-        (*it)->Cancel();
-        m_finishFn(*it);
+        routine->Cancel();
+        m_finishFn(routine);
       }
     }
 
-  private:
-    ThreadedList<threads::IRoutine *> m_tasks;
     TFinishRoutineFn m_finishFn;
+    std::atomic<bool> m_stopped{false};
 
-    std::vector<std::unique_ptr<threads::Thread>> m_threads;
+    base::TaskScheduler m_scheduler;
   };
 
   ThreadPool::ThreadPool(size_t size, const TFinishRoutineFn & finishFn)
@@ -129,6 +85,11 @@ namespace threads
     m_impl->PushFront(routine);
   }
 
+  void ThreadPool::PushBackLowPriority(IRoutine * routine)
+  {
+    m_impl->PushBackLowPriority(routine);
+  }
+
   void ThreadPool::Stop()
   {
     m_impl->Stop();
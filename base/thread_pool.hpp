@@ -2,6 +2,7 @@
 
 #include "base/base.hpp"
 
+#include <cstddef>
 #include <functional>
 
 namespace threads
@@ -19,6 +20,8 @@ namespace threads
     // ThreadPool will not delete routine. You can delete it in finish_routine_fn if need
     void PushBack(threads::IRoutine * routine);
     void PushFront(threads::IRoutine * routine);
+    // Routine is executed when there are no routines pushed by PushBack() and PushFront().
+    void PushBackLowPriority(threads::IRoutine * routine);
     void Stop();
 
   private:
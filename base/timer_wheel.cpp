@@ -0,0 +1,237 @@
+#include "base/timer_wheel.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace base
+{
+// static
+size_t constexpr TimerWheel::kLevels;
+// static
+size_t constexpr TimerWheel::kSlotBits;
+// static
+size_t constexpr TimerWheel::kSlots;
+// static
+TimerWheel::Tick constexpr TimerWheel::kNever;
+
+TimerWheel::TimerWheel(Duration const & tick)
+  : m_tick(max(tick, Duration(1))), m_start(Clock::now())
+{
+  m_thread = threads::SimpleThread(&TimerWheel::ThreadRoutine, this);
+}
+
+TimerWheel::~TimerWheel()
+{
+  {
+    lock_guard<mutex> lock(m_mu);
+    ASSERT(this_thread::get_id() != m_threadId, ("The wheel is destroyed by its own task."));
+    m_shutdown = true;
+  }
+  m_cv.notify_one();
+  m_thread.join();
+}
+
+// static
+TimerWheel & TimerWheel::Instance()
+{
+  static TimerWheel wheel;
+  return wheel;
+}
+
+void TimerWheel::Schedule(Key key, Duration const & delay, Task && task, Coalesce coalesce)
+{
+  ASSERT_NOT_EQUAL(key, 0, ());
+  auto const deadline = GetDeadline(delay);
+
+  {
+    lock_guard<mutex> lock(m_mu);
+    auto const it = m_timers.find(key);
+    if (it != m_timers.end() && coalesce == Coalesce::KeepEarlier &&
+        it->second.m_deadline <= deadline)
+    {
+      it->second.m_task = move(task);
+      return;
+    }
+
+    auto & timer = m_timers[key];
+    timer.m_deadline = deadline;
+    timer.m_task = move(task);
+    Insert(key, timer, m_now + 1);
+
+    // The thread recalculates its wake-up time after processing, so it's notified only when
+    // the new timer is due before it wakes up.
+    if (deadline >= m_wakeUp)
+      return;
+  }
+  m_cv.notify_one();
+}
+
+bool TimerWheel::Cancel(Key key)
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_timers.erase(key) != 0;
+}
+
+bool TimerWheel::CancelAndWait(Key key)
+{
+  unique_lock<mutex> lock(m_mu);
+  if (this_thread::get_id() != m_threadId)
+    m_runningCv.wait(lock, [this, key]() { return m_running != key; });
+  // The timer may be scheduled again by its task.
+  return m_timers.erase(key) != 0;
+}
+
+bool TimerWheel::IsPending(Key key) const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_timers.count(key) != 0;
+}
+
+size_t TimerWheel::GetPendingCount() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_timers.size();
+}
+
+TimerWheel::Tick TimerWheel::GetCurrentTick() const
+{
+  return static_cast<Tick>((Clock::now() - m_start) / m_tick);
+}
+
+TimerWheel::Tick TimerWheel::GetDeadline(Duration const & delay) const
+{
+  auto const time = Clock::now() - m_start + max(delay, Duration::zero());
+  return static_cast<Tick>((time + m_tick - Duration(1)) / m_tick);
+}
+
+void TimerWheel::Insert(Key key, Timer & timer, Tick earliest)
+{
+  auto const deadline = max(timer.m_deadline, earliest);
+  auto const delta = deadline - m_now;
+
+  size_t level = 0;
+  while (level + 1 < kLevels && delta >= (Tick(1) << (kSlotBits * (level + 1))))
+    ++level;
+
+  // Timers which don't fit into the wheels wait in the farthest slot and are put back to
+  // the top level by its cascade.
+  auto const slotTick = min(deadline, m_now + (Tick(1) << (kSlotBits * kLevels)) - 1);
+
+  timer.m_version = ++m_lastVersion;
+  auto const slot = (slotTick >> (kSlotBits * level)) & (kSlots - 1);
+  m_wheels[level][slot].emplace_back(key, timer.m_version);
+}
+
+void TimerWheel::Cascade()
+{
+  for (size_t level = 1; level < kLevels; ++level)
+  {
+    auto const shift = kSlotBits * level;
+    if ((m_now & ((Tick(1) << shift) - 1)) != 0)
+      break;
+
+    Slot entries;
+    entries.swap(m_wheels[level][(m_now >> shift) & (kSlots - 1)]);
+    for (auto const & entry : entries)
+    {
+      auto const it = m_timers.find(entry.first);
+      if (it != m_timers.end() && it->second.m_version == entry.second)
+        Insert(entry.first, it->second, m_now);
+    }
+  }
+}
+
+TimerWheel::Tick TimerWheel::GetNextTick() const
+{
+  auto next = kNever;
+  for (size_t level = 0; level < kLevels; ++level)
+  {
+    auto const shift = kSlotBits * level;
+    auto const base = m_now >> shift;
+    for (Tick i = 1; i <= kSlots; ++i)
+    {
+      if (!m_wheels[level][(base + i) & (kSlots - 1)].empty())
+      {
+        next = min(next, (base + i) << shift);
+        break;
+      }
+    }
+  }
+  return next;
+}
+
+void TimerWheel::ProcessTimers(unique_lock<mutex> & lock)
+{
+  auto const current = GetCurrentTick();
+  while (!m_shutdown)
+  {
+    if (m_timers.empty())
+    {
+      // Only stale entries are left.
+      for (auto & wheel : m_wheels)
+      {
+        for (auto & slot : wheel)
+          slot.clear();
+      }
+    }
+
+    // There is nothing to do at the ticks which are skipped.
+    auto const next = GetNextTick();
+    if (next > current)
+    {
+      m_now = max(m_now, current);
+      return;
+    }
+
+    m_now = next;
+    Cascade();
+
+    Slot entries;
+    entries.swap(m_wheels[0][m_now & (kSlots - 1)]);
+    for (auto const & entry : entries)
+    {
+      // Timers may be cancelled or rescheduled by the previous tasks.
+      auto const it = m_timers.find(entry.first);
+      if (it == m_timers.end() || it->second.m_version != entry.second)
+        continue;
+
+      ASSERT_LESS_OR_EQUAL(it->second.m_deadline, m_now, ());
+      auto task = move(it->second.m_task);
+      m_timers.erase(it);
+
+      m_running = entry.first;
+      lock.unlock();
+      if (task)
+        task();
+      lock.lock();
+      m_running = 0;
+      m_runningCv.notify_all();
+
+      if (m_shutdown)
+        return;
+    }
+  }
+}
+
+void TimerWheel::ThreadRoutine()
+{
+  unique_lock<mutex> lock(m_mu);
+  m_threadId = this_thread::get_id();
+  while (!m_shutdown)
+  {
+    m_wakeUp = 0;
+    ProcessTimers(lock);
+    if (m_shutdown)
+      break;
+
+    m_wakeUp = GetNextTick();
+    if (m_wakeUp == kNever)
+      m_cv.wait(lock);
+    else
+      m_cv.wait_until(lock, m_start + m_tick * static_cast<Duration::rep>(m_wakeUp));
+  }
+}
+}  // namespace base
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/thread.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// Hierarchical timer wheel, runs delayed tasks on a single thread.
+//
+// Timers are kept in kLevels wheels of kSlots slots, a slot of the level |l| spans
+// kSlots^l ticks. Scheduling and cancelling are O(1), far timers are moved to the lower
+// levels when the wheels turn. The thread sleeps until the next occupied slot, so idle
+// timers cost nothing.
+//
+// Every timer has a key, a task scheduled with the key of a pending timer replaces it,
+// so bursts of requests are coalesced into one run.
+//
+// Subsystems should use Instance() instead of own threads with delays. Tasks are executed
+// on the wheel's thread and must be short, long jobs should be pushed to other loops.
+//
+// *NOTE* All methods are thread-safe.
+class TimerWheel
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+  using Key = uint64_t;
+  using Task = std::function<void()>;
+
+  enum class Coalesce
+  {
+    // The pending timer is restarted with the new delay.
+    Restart,
+    // The pending timer keeps its deadline when it's earlier, only the task is replaced.
+    KeepEarlier
+  };
+
+  static size_t constexpr kLevels = 4;
+  static size_t constexpr kSlotBits = 6;
+  static size_t constexpr kSlots = 1 << kSlotBits;
+
+  explicit TimerWheel(Duration const & tick = std::chrono::milliseconds(10));
+  // Pending timers are dropped.
+  ~TimerWheel();
+
+  // The wheel shared by the whole process.
+  static TimerWheel & Instance();
+
+  // Returns a key which isn't used by other timers of the wheel.
+  Key NewKey() { return m_nextKey++; }
+
+  // Schedules |task| to be executed not earlier than after |delay|.
+  void Schedule(Key key, Duration const & delay, Task && task,
+                Coalesce coalesce = Coalesce::Restart);
+
+  // Drops the pending timer with |key|. Returns false when there was no pending timer.
+  bool Cancel(Key key);
+  // The same as Cancel() but when the task of the timer is being executed, waits for it
+  // unless called by the task itself.
+  bool CancelAndWait(Key key);
+
+  bool IsPending(Key key) const;
+  size_t GetPendingCount() const;
+
+private:
+  using Tick = uint64_t;
+
+  struct Timer
+  {
+    Tick m_deadline = 0;
+    // Is renewed every time the timer is put to a slot, entries of slots with other
+    // versions are stale.
+    uint64_t m_version = 0;
+    Task m_task;
+  };
+
+  using Slot = std::vector<std::pair<Key, uint64_t>>;
+
+  static Tick constexpr kNever = std::numeric_limits<Tick>::max();
+
+  Tick GetCurrentTick() const;
+  // Returns the first tick which starts not earlier than after |delay|.
+  Tick GetDeadline(Duration const & delay) const;
+
+  // All following methods must be called under |m_mu|.
+  // Puts |timer| to the slot of its deadline, or of |earliest| when the deadline has passed.
+  void Insert(Key key, Timer & timer, Tick earliest);
+  // Moves the timers of the higher levels whose slots start at |m_now|.
+  void Cascade();
+  // Returns the tick of the next occupied slot or of the next cascade of an occupied slot.
+  Tick GetNextTick() const;
+  // Executes the timers which are due by now, |lock| is released during execution.
+  void ProcessTimers(std::unique_lock<std::mutex> & lock);
+  void ThreadRoutine();
+
+  Duration const m_tick;
+  Clock::time_point const m_start;
+
+  std::atomic<Key> m_nextKey{1};
+
+  mutable std::mutex m_mu;
+  std::condition_variable m_cv;
+  std::condition_variable m_runningCv;
+  bool m_shutdown = false;
+
+  // The last processed tick and the tick the thread sleeps until.
+  Tick m_now = 0;
+  Tick m_wakeUp = 0;
+  uint64_t m_lastVersion = 0;
+  std::array<std::array<Slot, kSlots>, kLevels> m_wheels;
+  std::unordered_map<Key, Timer> m_timers;
+
+  // Key of the timer whose task is being executed.
+  Key m_running = 0;
+
+  threads::SimpleThread m_thread;
+  std::thread::id m_threadId;
+
+  DISALLOW_COPY_AND_MOVE(TimerWheel);
+};
+}  // namespace base
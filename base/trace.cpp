@@ -0,0 +1,157 @@
+#include "base/trace.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+namespace base
+{
+namespace trace
+{
+namespace
+{
+double ToMicroseconds(Clock::duration d)
+{
+  return chrono::duration_cast<chrono::duration<double, micro>>(d).count();
+}
+
+void WriteEscaped(ostream & out, char const * s)
+{
+  for (; *s != '\0'; ++s)
+  {
+    if (*s == '"' || *s == '\\')
+      out << '\\';
+    out << *s;
+  }
+}
+}  // namespace
+
+// static
+size_t constexpr Tracer::kEventsPerThread;
+
+Tracer::Tracer() : m_start(Clock::now()) {}
+
+// static
+Tracer & Tracer::Instance()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::AddZone(char const * name, Clock::time_point start, Clock::time_point end)
+{
+  Event event;
+  event.m_name = name;
+  event.m_type = Event::Type::Zone;
+  event.m_start = start;
+  event.m_duration = end - start;
+  Add(move(event));
+}
+
+void Tracer::AddCounter(char const * name, int64_t value)
+{
+  if (!IsEnabled())
+    return;
+
+  Event event;
+  event.m_name = name;
+  event.m_type = Event::Type::Counter;
+  event.m_start = Clock::now();
+  event.m_value = value;
+  Add(move(event));
+}
+
+vector<Event> Tracer::GetEvents() const
+{
+  vector<Event> events;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto const & buffer : m_buffers)
+    {
+      lock_guard<mutex> bufferLock(buffer->m_mutex);
+      // When the buffer is full, its oldest event is at |m_next|.
+      auto const & e = buffer->m_events;
+      auto const oldest = e.begin() + static_cast<ptrdiff_t>(buffer->m_next);
+      events.insert(events.end(), oldest, e.end());
+      events.insert(events.end(), e.begin(), oldest);
+    }
+  }
+
+  // Enclosing zones go before nested ones with the same start, events with equal times keep
+  // the order of recording.
+  stable_sort(events.begin(), events.end(), [](Event const & lhs, Event const & rhs) {
+    if (lhs.m_start != rhs.m_start)
+      return lhs.m_start < rhs.m_start;
+    return lhs.m_duration > rhs.m_duration;
+  });
+  return events;
+}
+
+void Tracer::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  for (auto const & buffer : m_buffers)
+  {
+    lock_guard<mutex> bufferLock(buffer->m_mutex);
+    buffer->m_events.clear();
+    buffer->m_next = 0;
+  }
+}
+
+void Tracer::ExportChromeTrace(ostream & out) const
+{
+  auto const events = GetEvents();
+  out << "{\"traceEvents\":[";
+  auto const flags = out.flags();
+  out << fixed << setprecision(3);
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    auto const & e = events[i];
+    out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"";
+    WriteEscaped(out, e.m_name);
+    out << "\",\"pid\":0,\"tid\":" << e.m_threadId
+        << ",\"ts\":" << ToMicroseconds(e.m_start - m_start);
+    switch (e.m_type)
+    {
+    case Event::Type::Zone: out << ",\"ph\":\"X\",\"dur\":" << ToMicroseconds(e.m_duration); break;
+    case Event::Type::Counter:
+      out << ",\"ph\":\"C\",\"args\":{\"value\":" << e.m_value << "}";
+      break;
+    }
+    out << "}";
+  }
+  out << "\n]}\n";
+  out.flags(flags);
+}
+
+void Tracer::Add(Event && event)
+{
+  auto & buffer = GetThreadBuffer();
+  event.m_threadId = buffer.m_threadId;
+
+  lock_guard<mutex> lock(buffer.m_mutex);
+  if (buffer.m_events.size() < kEventsPerThread)
+  {
+    buffer.m_events.push_back(move(event));
+    return;
+  }
+
+  buffer.m_events[buffer.m_next] = move(event);
+  buffer.m_next = (buffer.m_next + 1) % kEventsPerThread;
+}
+
+Tracer::ThreadBuffer & Tracer::GetThreadBuffer()
+{
+  // Buffers are owned by the tracer, so events of finished threads are kept.
+  thread_local ThreadBuffer * buffer = nullptr;
+  if (buffer != nullptr)
+    return *buffer;
+
+  lock_guard<mutex> lock(m_mutex);
+  m_buffers.push_back(make_shared<ThreadBuffer>(static_cast<uint32_t>(m_buffers.size())));
+  buffer = m_buffers.back().get();
+  return *buffer;
+}
+}  // namespace trace
+}  // namespace base
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// Scoped trace zones and counters for hot paths.
+//
+// TRACE_ZONE("name") records the time of the enclosing scope, nested zones are shown as nested
+// in the trace. TRACE_COUNTER("name", value) records a value of a counter. Names must be
+// string literals.
+//
+// Zones and counters are compiled in with USE_TRACE only, otherwise the macros are empty.
+// When compiled in, recording is started by Tracer::Instance().SetEnabled(true).
+#if defined(USE_TRACE)
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_ZONE(name) ::base::trace::ScopedZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER(name, value) ::base::trace::Tracer::Instance().AddCounter(name, value)
+#else
+#define TRACE_ZONE(name) static_cast<void>(0)
+#define TRACE_COUNTER(name, value) static_cast<void>(0)
+#endif
+
+namespace base
+{
+namespace trace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Event
+{
+  enum class Type : uint8_t
+  {
+    Zone,
+    Counter
+  };
+
+  char const * m_name = nullptr;
+  Type m_type = Type::Zone;
+  uint32_t m_threadId = 0;
+  Clock::time_point m_start;
+  // Duration of a zone.
+  Clock::duration m_duration = {};
+  // Value of a counter.
+  int64_t m_value = 0;
+};
+
+// Collects events of all threads. Every thread writes to its own ring buffer, so recording
+// doesn't contend between threads, and the oldest events of a thread are overwritten when
+// its buffer is full.
+class Tracer
+{
+public:
+  static size_t constexpr kEventsPerThread = 1 << 16;
+
+  static Tracer & Instance();
+
+  void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  void AddZone(char const * name, Clock::time_point start, Clock::time_point end);
+  void AddCounter(char const * name, int64_t value);
+
+  // Returns events of all threads ordered by start times.
+  std::vector<Event> GetEvents() const;
+  void Clear();
+
+  // Writes events in the Chrome trace event format, the output may be opened by
+  // chrome://tracing or https://ui.perfetto.dev.
+  void ExportChromeTrace(std::ostream & out) const;
+
+private:
+  struct ThreadBuffer
+  {
+    explicit ThreadBuffer(uint32_t threadId) : m_threadId(threadId) {}
+
+    // Is locked by the owner thread on every event, so it's contended only on export.
+    std::mutex m_mutex;
+    uint32_t const m_threadId;
+    std::vector<Event> m_events;
+    size_t m_next = 0;
+  };
+
+  Tracer();
+
+  void Add(Event && event);
+  ThreadBuffer & GetThreadBuffer();
+
+  std::atomic<bool> m_enabled{false};
+  Clock::time_point const m_start;
+
+  mutable std::mutex m_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+  DISALLOW_COPY_AND_MOVE(Tracer);
+};
+
+class ScopedZone
+{
+public:
+  explicit ScopedZone(char const * name)
+    : m_name(Tracer::Instance().IsEnabled() ? name : nullptr)
+  {
+    if (m_name != nullptr)
+      m_start = Clock::now();
+  }
+
+  ~ScopedZone()
+  {
+    if (m_name != nullptr)
+      Tracer::Instance().AddZone(m_name, m_start, Clock::now());
+  }
+
+private:
+  char const * m_name;
+  Clock::time_point m_start;
+
+  DISALLOW_COPY_AND_MOVE(ScopedZone);
+};
+}  // namespace trace
+}  // namespace base
@@ -0,0 +1,133 @@
+#include "coding/async_file_reader.hpp"
+
+#include "coding/internal/file_data.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+using namespace std;
+
+namespace coding
+{
+namespace
+{
+struct Batch
+{
+  string m_fileName;
+  vector<AsyncFileReader::Request> m_requests;
+  // Indices of requests sorted by positions.
+  vector<size_t> m_order;
+  AsyncFileReader::Buffers m_buffers;
+
+  promise<AsyncFileReader::Buffers> m_promise;
+  atomic<size_t> m_partsLeft{0};
+  mutex m_errorMutex;
+  exception_ptr m_error;
+};
+
+// Reads requests m_order[beg, end) of |batch|.
+void ReadPart(Batch & batch, size_t beg, size_t end)
+{
+  base::FileData file(batch.m_fileName, base::FileData::OP_READ);
+  vector<char> span;
+  size_t i = beg;
+  while (i < end)
+  {
+    // Close requests are read at once.
+    auto const & first = batch.m_requests[batch.m_order[i]];
+    uint64_t const spanBeg = first.m_pos;
+    uint64_t spanEnd = first.m_pos + first.m_size;
+    size_t j = i + 1;
+    for (; j < end; ++j)
+    {
+      auto const & r = batch.m_requests[batch.m_order[j]];
+      if (r.m_pos > spanEnd + AsyncFileReader::kMaxGap)
+        break;
+      spanEnd = max(spanEnd, r.m_pos + r.m_size);
+    }
+
+    span.resize(static_cast<size_t>(spanEnd - spanBeg));
+    if (!span.empty())
+      file.Read(spanBeg, span.data(), span.size());
+
+    for (; i < j; ++i)
+    {
+      size_t const index = batch.m_order[i];
+      auto const & r = batch.m_requests[index];
+      auto const from = span.begin() + static_cast<size_t>(r.m_pos - spanBeg);
+      batch.m_buffers[index].assign(from, from + r.m_size);
+    }
+  }
+}
+}  // namespace
+
+// static
+size_t const AsyncFileReader::kMaxGap = 4 * 1024;
+
+AsyncFileReader::AsyncFileReader(size_t threadsCount)
+  : m_workers(max(threadsCount, static_cast<size_t>(1)), base::WorkerThread::Exit::ExecPending)
+  , m_threadsCount(max(threadsCount, static_cast<size_t>(1)))
+{
+}
+
+AsyncFileReader::~AsyncFileReader() { m_workers.ShutdownAndJoin(); }
+
+future<AsyncFileReader::Buffers> AsyncFileReader::Read(string const & fileName,
+                                                       vector<Request> const & requests)
+{
+  auto batch = make_shared<Batch>();
+  batch->m_fileName = fileName;
+  batch->m_requests = requests;
+  batch->m_buffers.resize(requests.size());
+  batch->m_order.resize(requests.size());
+  iota(batch->m_order.begin(), batch->m_order.end(), 0);
+  sort(batch->m_order.begin(), batch->m_order.end(), [&requests](size_t lhs, size_t rhs) {
+    return requests[lhs].m_pos < requests[rhs].m_pos;
+  });
+
+  auto result = batch->m_promise.get_future();
+  if (requests.empty())
+  {
+    batch->m_promise.set_value({});
+    return result;
+  }
+
+  size_t const partsCount = min(m_threadsCount, requests.size());
+  batch->m_partsLeft = partsCount;
+  for (size_t part = 0; part < partsCount; ++part)
+  {
+    size_t const beg = requests.size() * part / partsCount;
+    size_t const end = requests.size() * (part + 1) / partsCount;
+    bool const pushed = m_workers.Push([batch, beg, end]() {
+      try
+      {
+        ReadPart(*batch, beg, end);
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(batch->m_errorMutex);
+        if (!batch->m_error)
+          batch->m_error = current_exception();
+      }
+
+      if (--batch->m_partsLeft != 0)
+        return;
+
+      if (batch->m_error)
+        batch->m_promise.set_exception(batch->m_error);
+      else
+        batch->m_promise.set_value(move(batch->m_buffers));
+    });
+    CHECK(pushed, ("Workers are shut down."));
+  }
+  return result;
+}
+}  // namespace coding
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/worker_thread.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace coding
+{
+// Reads batches of file ranges on worker threads, so a caller issues reads of many offsets
+// at once and continues when all of them are read, instead of blocking on every read.
+//
+// A batch is sorted by positions and split between |threadsCount| workers. Every worker reads
+// its part through an own file handle, close ranges are read by a single read call.
+//
+// *NOTE* Must be destroyed on the thread it was created on, pending batches are read before
+// the destruction.
+class AsyncFileReader
+{
+public:
+  struct Request
+  {
+    Request() = default;
+    Request(uint64_t pos, size_t size) : m_pos(pos), m_size(size) {}
+
+    uint64_t m_pos = 0;
+    size_t m_size = 0;
+  };
+
+  // Buffers are in the order of requests.
+  using Buffers = std::vector<std::vector<char>>;
+
+  // Ranges which are closer than |kMaxGap| bytes are read by a single read call.
+  static size_t const kMaxGap;
+
+  explicit AsyncFileReader(size_t threadsCount);
+  ~AsyncFileReader();
+
+  // Reads |requests| of |fileName|. The future throws Reader::Exception when the file can't be
+  // read.
+  std::future<Buffers> Read(std::string const & fileName, std::vector<Request> const & requests);
+
+private:
+  base::WorkerThread m_workers;
+  size_t const m_threadsCount;
+
+  DISALLOW_COPY_AND_MOVE(AsyncFileReader);
+};
+}  // namespace coding
@@ -0,0 +1,236 @@
+#include "coding/block_codec.hpp"
+
+#include "coding/zlib.hpp"
+
+#include <cstring>
+#include <iterator>
+
+using namespace std;
+
+namespace
+{
+size_t const kMinMatch = 4;
+size_t const kMaxOffset = 0xFFFF;
+size_t const kNibbleMax = 15;
+uint32_t const kLogHashSize = 14;
+
+uint32_t Load32(uint8_t const * p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+uint32_t Hash(uint32_t v) { return (v * 2654435761U) >> (32 - kLogHashSize); }
+
+void WriteLength(size_t length, vector<uint8_t> & out)
+{
+  while (length >= 0x80)
+  {
+    out.push_back(static_cast<uint8_t>(length | 0x80));
+    length >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(length));
+}
+
+bool ReadLength(uint8_t const *& p, uint8_t const * end, size_t & length)
+{
+  size_t value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    if (p == end)
+      return false;
+    uint8_t const b = *p++;
+    value |= static_cast<size_t>(b & 0x7F) << shift;
+    if ((b & 0x80) == 0)
+    {
+      length += value;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WriteSequence(uint8_t const * literals, size_t numLiterals, size_t offset, size_t matchLength,
+                   vector<uint8_t> & out)
+{
+  size_t const extraMatch = matchLength == 0 ? 0 : matchLength - kMinMatch;
+  out.push_back(static_cast<uint8_t>((min(numLiterals, kNibbleMax) << 4) |
+                                     min(extraMatch, kNibbleMax)));
+  if (numLiterals >= kNibbleMax)
+    WriteLength(numLiterals - kNibbleMax, out);
+  out.insert(out.end(), literals, literals + numLiterals);
+
+  if (matchLength == 0)
+    return;
+  out.push_back(static_cast<uint8_t>(offset & 0xFF));
+  out.push_back(static_cast<uint8_t>(offset >> 8));
+  if (extraMatch >= kNibbleMax)
+    WriteLength(extraMatch - kNibbleMax, out);
+}
+}  // namespace
+
+namespace coding
+{
+string DebugPrint(BlockCodec codec)
+{
+  switch (codec)
+  {
+  case BlockCodec::BWT: return "BWT";
+  case BlockCodec::ZLib: return "ZLib";
+  case BlockCodec::Lz: return "Lz";
+  case BlockCodec::Count: return "Count";
+  }
+  CHECK_SWITCH();
+}
+
+// static
+void LzCoder::Encode(uint8_t const * data, size_t size, string const & dict, vector<uint8_t> & out)
+{
+  // Matches are searched in the concatenation of the dictionary and the data.
+  vector<uint8_t> buffer(dict.begin(), dict.end());
+  buffer.insert(buffer.end(), data, data + size);
+  uint8_t const * const s = buffer.data();
+  size_t const n = buffer.size();
+
+  // Positions of the last occurrences of 4-byte sequences.
+  vector<size_t> table(static_cast<size_t>(1) << kLogHashSize, n);
+  size_t i = 0;
+  for (; i + kMinMatch <= dict.size(); ++i)
+    table[Hash(Load32(s + i))] = i;
+
+  i = dict.size();
+  size_t anchor = i;
+  while (i + kMinMatch <= n)
+  {
+    auto const h = Hash(Load32(s + i));
+    size_t const candidate = table[h];
+    table[h] = i;
+
+    if (candidate == n || i - candidate > kMaxOffset || Load32(s + candidate) != Load32(s + i))
+    {
+      ++i;
+      continue;
+    }
+
+    size_t length = kMinMatch;
+    while (i + length < n && s[candidate + length] == s[i + length])
+      ++length;
+
+    WriteSequence(s + anchor, i - anchor, i - candidate, length, out);
+    i += length;
+    anchor = i;
+  }
+
+  WriteSequence(s + anchor, n - anchor, 0 /* offset */, 0 /* matchLength */, out);
+}
+
+// static
+bool LzCoder::Decode(uint8_t const * data, size_t size, string const & dict, size_t rawSize,
+                     vector<uint8_t> & out)
+{
+  size_t const base = out.size();
+  out.resize(base + rawSize);
+  uint8_t * const dst = out.data() + base;
+  size_t pos = 0;
+
+  uint8_t const * p = data;
+  uint8_t const * const end = data + size;
+  while (p != end)
+  {
+    uint8_t const token = *p++;
+
+    size_t numLiterals = token >> 4;
+    if (numLiterals == kNibbleMax && !ReadLength(p, end, numLiterals))
+      return false;
+    if (numLiterals > static_cast<size_t>(end - p) || numLiterals > rawSize - pos)
+      return false;
+    memcpy(dst + pos, p, numLiterals);
+    p += numLiterals;
+    pos += numLiterals;
+
+    if (p == end)
+      break;
+
+    if (end - p < 2)
+      return false;
+    size_t const offset = p[0] | (static_cast<size_t>(p[1]) << 8);
+    p += 2;
+
+    size_t length = (token & 0xF);
+    if (length == kNibbleMax && !ReadLength(p, end, length))
+      return false;
+    length += kMinMatch;
+
+    if (offset == 0 || offset > pos + dict.size() || length > rawSize - pos)
+      return false;
+
+    // The part of the match which is in the dictionary.
+    if (offset > pos)
+    {
+      size_t const from = dict.size() - (offset - pos);
+      size_t const m = min(length, offset - pos);
+      memcpy(dst + pos, dict.data() + from, m);
+      pos += m;
+      length -= m;
+    }
+
+    uint8_t const * src = dst + pos - offset;
+    if (offset >= length)
+    {
+      memcpy(dst + pos, src, length);
+      pos += length;
+    }
+    else
+    {
+      // Overlapping match repeats the last |offset| bytes.
+      for (size_t k = 0; k < length; ++k)
+        dst[pos + k] = src[k];
+      pos += length;
+    }
+  }
+
+  return pos == rawSize;
+}
+
+namespace impl
+{
+void Encode(BlockCodec codec, string const & dict, size_t n, uint8_t const * s,
+            vector<uint8_t> & out)
+{
+  switch (codec)
+  {
+  case BlockCodec::ZLib:
+  {
+    CHECK(dict.empty(), ("Dictionaries aren't supported by", codec));
+    ZLib::Deflate deflate(ZLib::Deflate::Format::ZLib, ZLib::Deflate::Level::BestCompression);
+    CHECK(deflate(s, n, back_inserter(out)), ());
+    return;
+  }
+  case BlockCodec::Lz: LzCoder::Encode(s, n, dict, out); return;
+  case BlockCodec::BWT:
+  case BlockCodec::Count: CHECK(false, ("Unexpected codec", codec)); return;
+  }
+  CHECK_SWITCH();
+}
+
+bool Decode(BlockCodec codec, string const & dict, vector<uint8_t> const & encoded,
+            size_t rawSize, vector<uint8_t> & out)
+{
+  switch (codec)
+  {
+  case BlockCodec::ZLib:
+  {
+    out.reserve(rawSize);
+    ZLib::Inflate inflate(ZLib::Inflate::Format::ZLib);
+    return inflate(encoded.data(), encoded.size(), back_inserter(out)) && out.size() == rawSize;
+  }
+  case BlockCodec::Lz:
+    return LzCoder::Decode(encoded.data(), encoded.size(), dict, rawSize, out);
+  case BlockCodec::BWT:
+  case BlockCodec::Count: return false;
+  }
+  CHECK_SWITCH();
+}
+}  // namespace impl
+}  // namespace coding
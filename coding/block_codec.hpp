@@ -0,0 +1,102 @@
+#pragma once
+
+#include "coding/bwt_coder.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace coding
+{
+// Codecs of compressed blocks. Values are written to files, so don't change them.
+enum class BlockCodec : uint8_t
+{
+  // BWT + MTF + Huffman, see BWTCoder. The best ratio on short texts, the slowest decoding.
+  BWT = 0,
+  // Deflate, see ZLib.
+  ZLib = 1,
+  // Byte-aligned LZ77, see LzCoder. The worst ratio, the fastest decoding.
+  Lz = 2,
+
+  Count
+};
+
+std::string DebugPrint(BlockCodec codec);
+
+// LZ77 coder with byte-aligned tokens, decoding is a sequence of memcpy() calls.
+//
+// Format description: a sequence of tokens, every token is
+// * a byte with the number of literals in the high nibble and the match length minus 4
+//   in the low nibble, 15 in a nibble means that a varint with the remainder follows
+// * the remainder of the number of literals, literals
+// * the last token ends here, otherwise the 2-byte little endian match offset and
+//   the remainder of the match length follow.
+//
+// Matches may refer to a dictionary which is a sample of typical data, it improves the ratio
+// of small blocks. The same dictionary must be used for encoding and decoding.
+class LzCoder
+{
+public:
+  // Appends encoded [data, data + size) to |out|.
+  static void Encode(uint8_t const * data, size_t size, std::string const & dict,
+                     std::vector<uint8_t> & out);
+
+  // Appends |rawSize| bytes decoded from [data, data + size) to |out|.
+  // Returns false when data is malformed, |out| is partially formed then.
+  static bool Decode(uint8_t const * data, size_t size, std::string const & dict, size_t rawSize,
+                     std::vector<uint8_t> & out);
+};
+
+namespace impl
+{
+void Encode(BlockCodec codec, std::string const & dict, size_t n, uint8_t const * s,
+            std::vector<uint8_t> & out);
+bool Decode(BlockCodec codec, std::string const & dict, std::vector<uint8_t> const & encoded,
+            size_t rawSize, std::vector<uint8_t> & out);
+}  // namespace impl
+
+// Block of BlockCodec::BWT is written in BWTCoder format. Blocks of other codecs are
+// the varint size of the raw data, the varint size of the encoded data and the encoded data.
+// Dictionaries are supported by BlockCodec::Lz only.
+template <typename Sink>
+void EncodeAndWriteBlock(Sink & sink, BlockCodec codec, std::string const & dict, size_t n,
+                         uint8_t const * s)
+{
+  if (codec == BlockCodec::BWT)
+  {
+    CHECK(dict.empty(), ("Dictionaries aren't supported by", codec));
+    BWTCoder::EncodeAndWriteBlock(sink, n, s);
+    return;
+  }
+
+  std::vector<uint8_t> encoded;
+  impl::Encode(codec, dict, n, s, encoded);
+  WriteVarUint(sink, static_cast<uint64_t>(n));
+  WriteVarUint(sink, static_cast<uint64_t>(encoded.size()));
+  sink.Write(encoded.data(), encoded.size());
+}
+
+template <typename Source, typename OutIt>
+OutIt ReadAndDecodeBlock(Source & source, BlockCodec codec, std::string const & dict, OutIt it)
+{
+  if (codec == BlockCodec::BWT)
+    return BWTCoder::ReadAndDecodeBlock(source, it);
+
+  auto const rawSize = ReadVarUint<uint64_t, Source>(source);
+  auto const size = ReadVarUint<uint64_t, Source>(source);
+  CHECK_LESS_OR_EQUAL(size, source.Size(), ());
+
+  std::vector<uint8_t> encoded(static_cast<size_t>(size));
+  source.Read(encoded.data(), encoded.size());
+
+  std::vector<uint8_t> decoded;
+  if (!impl::Decode(codec, dict, encoded, static_cast<size_t>(rawSize), decoded))
+    MYTHROW(Reader::ReadException, ("Malformed", codec, "block."));
+  return std::copy(decoded.begin(), decoded.end(), it);
+}
+}  // namespace coding
@@ -46,6 +46,11 @@ public:
     return unique_ptr<Reader>(new BufferReader(*this, pos, size));
   }
 
+  inline uint8_t const * GetContiguousData() const
+  {
+    return reinterpret_cast<uint8_t const *>(m_data.get() + m_offset);
+  }
+
 private:
   BufferReader(BufferReader const & src, uint64_t pos, uint64_t size)
     : m_data(src.m_data)
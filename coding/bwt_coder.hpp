@@ -86,11 +86,7 @@ public:
     size_t const n = bwtBuffer.size();
     base::MoveToFront mtf;
     for (size_t i = 0; i < n; ++i)
-    {
-      auto const b = mtf[bwtBuffer[i]];
-      bwtBuffer[i] = b;
-      mtf.Transform(b);
-    }
+      bwtBuffer[i] = mtf.InverseTransform(bwtBuffer[i]);
 
     if (n != 0)
       CHECK_LESS(start, n, ());
@@ -0,0 +1,69 @@
+#include "testing/testing.hpp"
+
+#include "coding/async_file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+string const kFileName = "async_file_reader_test.tmp";
+}  // namespace
+
+UNIT_TEST(AsyncFileReader_Smoke)
+{
+  vector<char> data(200000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  {
+    FileWriter writer(kFileName);
+    writer.Write(data.data(), data.size());
+  }
+
+  {
+    AsyncFileReader reader(3 /* threadsCount */);
+    mt19937 rng(0);
+
+    vector<vector<AsyncFileReader::Request>> batches(5);
+    for (auto & requests : batches)
+    {
+      for (size_t i = 0; i < 300; ++i)
+      {
+        size_t const pos = rng() % data.size();
+        size_t const size = min(static_cast<size_t>(rng() % 100), data.size() - pos);
+        requests.emplace_back(pos, size);
+      }
+    }
+
+    // All batches are issued before waiting for any of them.
+    vector<future<AsyncFileReader::Buffers>> results;
+    for (auto const & requests : batches)
+      results.push_back(reader.Read(kFileName, requests));
+
+    for (size_t b = 0; b < batches.size(); ++b)
+    {
+      auto const buffers = results[b].get();
+      TEST_EQUAL(buffers.size(), batches[b].size(), ());
+      for (size_t i = 0; i < buffers.size(); ++i)
+      {
+        auto const & r = batches[b][i];
+        auto const from = data.begin() + static_cast<size_t>(r.m_pos);
+        TEST_EQUAL(buffers[i], vector<char>(from, from + r.m_size), (b, i));
+      }
+    }
+
+    TEST(reader.Read(kFileName, {}).get().empty(), ());
+
+    auto outOfFile = reader.Read(kFileName, {{0, 10}, {data.size() - 5, 10}});
+    TEST_ANY_THROW(outOfFile.get(), ());
+  }
+
+  FileWriter::DeleteFileX(kFileName);
+}
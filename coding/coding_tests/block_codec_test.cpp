@@ -0,0 +1,100 @@
+#include "testing/testing.hpp"
+
+#include "coding/block_codec.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+string EncodeDecode(BlockCodec codec, string const & dict, string const & s)
+{
+  vector<uint8_t> data;
+  {
+    MemWriter<decltype(data)> sink(data);
+    EncodeAndWriteBlock(sink, codec, dict, s.size(), reinterpret_cast<uint8_t const *>(s.data()));
+  }
+
+  string result;
+  {
+    MemReader reader(data.data(), data.size());
+    ReaderSource<MemReader> source(reader);
+    ReadAndDecodeBlock(source, codec, dict, back_inserter(result));
+    TEST_EQUAL(source.Size(), 0, ());
+  }
+  return result;
+}
+
+size_t EncodedSize(string const & dict, string const & s)
+{
+  vector<uint8_t> out;
+  LzCoder::Encode(reinterpret_cast<uint8_t const *>(s.data()), s.size(), dict, out);
+  return out.size();
+}
+
+UNIT_TEST(BlockCodec_Smoke)
+{
+  mt19937 engine(0);
+  vector<string> strings = {"", "a", "abcd", "abcdabcdabcdabcdabcdabcd", string(1000, 'z')};
+  {
+    string s;
+    for (size_t i = 0; i < 100000; ++i)
+      s.push_back(static_cast<char>('a' + engine() % 3));
+    strings.push_back(s);
+  }
+  {
+    string s;
+    for (size_t i = 0; i < 100000; ++i)
+      s.push_back(static_cast<char>(engine()));
+    strings.push_back(s);
+  }
+
+  for (auto const codec : {BlockCodec::BWT, BlockCodec::ZLib, BlockCodec::Lz})
+  {
+    for (auto const & s : strings)
+      TEST_EQUAL(EncodeDecode(codec, {} /* dict */, s), s, (codec, s.size()));
+  }
+}
+
+UNIT_TEST(BlockCodec_LzDictionary)
+{
+  string const dict = "Opening hours: Mo-Fr 09:00-18:00; Sa 10:00-16:00; Su off. ";
+  vector<string> const strings = {"", "O", "Opening hours: Mo-Fr 09:00-18:00; Sa 10:00-16:00",
+                                  "Sa 10:00-16:00; Su off. Opening hours: Mo-Fr 09:00-18:00",
+                                  "Su off. Su off. Su off. Su off."};
+
+  for (auto const & s : strings)
+    TEST_EQUAL(EncodeDecode(BlockCodec::Lz, dict, s), s, ());
+
+  TEST_LESS(EncodedSize(dict, strings[2]), EncodedSize({} /* dict */, strings[2]), ());
+}
+
+UNIT_TEST(BlockCodec_LzMalformed)
+{
+  string const s = "abcabcabcabcabcabcabc";
+  vector<uint8_t> encoded;
+  LzCoder::Encode(reinterpret_cast<uint8_t const *>(s.data()), s.size(), {} /* dict */, encoded);
+
+  vector<uint8_t> out;
+  TEST(LzCoder::Decode(encoded.data(), encoded.size(), {} /* dict */, s.size(), out), ());
+  TEST_EQUAL(string(out.begin(), out.end()), s, ());
+
+  out.clear();
+  TEST(!LzCoder::Decode(encoded.data(), encoded.size(), {} /* dict */, s.size() - 1, out), ());
+
+  out.clear();
+  TEST(!LzCoder::Decode(encoded.data(), encoded.size() - 2, {} /* dict */, s.size(), out), ());
+
+  // Offset of the first match points before the beginning of the data.
+  vector<uint8_t> const badOffset = {0x10, 'a', 0xFF, 0x00};
+  out.clear();
+  TEST(!LzCoder::Decode(badOffset.data(), badOffset.size(), {} /* dict */, 5, out), ());
+}
+}  // namespace
@@ -4,6 +4,9 @@
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include <algorithm>
 #include <iterator>
 #include <random>
@@ -103,4 +106,35 @@ UNIT_TEST(BWT_AllBytes)
   shuffle(s.begin(), s.end(), engine);
   TEST_EQUAL(s, EncodeDecode(BWTCoder::Params{}, s), ());
 }
+
+UNIT_TEST(BWT_DecodeThroughput)
+{
+  // Text-like data: random words from a small vocabulary.
+  vector<string> const words = {"street", "avenue", "cafe", "restaurant", "museum", "park",
+                                "Mo-Fr", "09:00-18:00", "+7 495", "http://", ".com", " "};
+  mt19937 engine(0);
+  string s;
+  while (s.size() < 1024 * 1024)
+    s += words[engine() % words.size()];
+
+  vector<uint8_t> data;
+  {
+    MemWriter<decltype(data)> sink(data);
+    BWTCoder::EncodeAndWrite(BWTCoder::Params{}, sink, s.size(),
+                             reinterpret_cast<uint8_t const *>(s.data()));
+  }
+
+  string result;
+  base::Timer timer;
+  {
+    MemReader reader(data.data(), data.size());
+    ReaderSource<MemReader> source(reader);
+    result.reserve(s.size());
+    BWTCoder::ReadAndDecode(source, back_inserter(result));
+  }
+  auto const seconds = timer.ElapsedSeconds();
+  TEST_EQUAL(s, result, ());
+  LOG(LINFO, ("BWT decoding:", s.size() / 1024 / 1024 / seconds, "MB/s,", data.size(),
+              "bytes compressed to", s.size()));
+}
 }  // namespace
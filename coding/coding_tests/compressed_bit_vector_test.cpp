@@ -3,9 +3,14 @@
 #include "coding/compressed_bit_vector.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/iterator.hpp"
+#include "std/random.hpp"
 #include "std/set.hpp"
+#include "std/string.hpp"
 
 namespace
 {
@@ -290,9 +295,10 @@ UNIT_TEST(CompressedBitVector_Union4)
 
   vector<uint64_t> setBits2 = {1000000000};
 
+  // A run of bits and a distant bit are more compact in chunks.
   CheckUnion(setBits1, coding::CompressedBitVector::StorageStrategy::Dense /* strategy1 */,
              setBits2, coding::CompressedBitVector::StorageStrategy::Sparse /* strategy2 */,
-             coding::CompressedBitVector::StorageStrategy::Sparse /* resultStrategy */);
+             coding::CompressedBitVector::StorageStrategy::Chunked /* resultStrategy */);
 }
 
 UNIT_TEST(CompressedBitVector_SerializationDense)
@@ -467,3 +473,149 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+UNIT_TEST(CompressedBitVector_Chunked)
+{
+  using Chunk = coding::ChunkedCBV::Chunk;
+  uint64_t const kChunkSize = coding::ChunkedCBV::kChunkSize;
+
+  // A chunk of a few bits, a chunk of one long run and a chunk of many sparse bits.
+  vector<uint64_t> setBits;
+  for (uint64_t i = 0; i < 10; ++i)
+    setBits.push_back(100 * i);
+  for (uint64_t i = 0; i < 30000; ++i)
+    setBits.push_back(3 * kChunkSize + 1000 + i);
+  for (uint64_t i = 0; i < 20000; ++i)
+    setBits.push_back(5 * kChunkSize + 3 * i);
+
+  auto const cbv = coding::CompressedBitVectorBuilder::FromBitPositions(setBits);
+  TEST_EQUAL(cbv->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Chunked,
+             ());
+  TEST_EQUAL(cbv->PopCount(), setBits.size(), ());
+
+  auto const & chunks = static_cast<coding::ChunkedCBV const &>(*cbv).GetChunks();
+  TEST_EQUAL(chunks.size(), 3, ());
+  TEST_EQUAL(chunks[0].m_type, Chunk::Type::Array, ());
+  TEST_EQUAL(chunks[1].m_type, Chunk::Type::Runs, ());
+  TEST_EQUAL(chunks[2].m_type, Chunk::Type::Bitmap, ());
+
+  vector<uint64_t> actual;
+  coding::CompressedBitVectorEnumerator::ForEach(
+      *cbv, [&actual](uint64_t pos) { actual.push_back(pos); });
+  TEST_EQUAL(actual, setBits, ());
+  TEST(cbv->GetBit(3 * kChunkSize + 1000), ());
+  TEST(cbv->GetBit(3 * kChunkSize + 30999), ());
+  TEST(!cbv->GetBit(3 * kChunkSize + 999), ());
+  TEST(!cbv->GetBit(3 * kChunkSize + 31000), ());
+  TEST(!cbv->GetBit(4 * kChunkSize), ());
+  TEST(!cbv->GetBit(5 * kChunkSize + 1), ());
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<vector<uint8_t>> writer(buf);
+    cbv->Serialize(writer);
+  }
+  MemReader reader(buf.data(), buf.size());
+  auto const copy = coding::CompressedBitVectorBuilder::DeserializeFromReader(reader);
+  TEST(copy.get(), ());
+  TEST_EQUAL(copy->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Chunked,
+             ());
+  TEST_EQUAL(coding::CompressedBitVectorHasher::Hash(*copy),
+             coding::CompressedBitVectorHasher::Hash(*cbv), ());
+
+  auto const first = cbv->LeaveFirstSetNBits(15);
+  TEST_EQUAL(first->PopCount(), 15, ());
+  TEST(first->GetBit(900), ());
+  TEST(first->GetBit(3 * kChunkSize + 1004), ());
+  TEST(!first->GetBit(3 * kChunkSize + 1005), ());
+}
+
+UNIT_TEST(CompressedBitVector_RandomOps)
+{
+  minstd_rand rng(0);
+  auto const makeBits = [&rng](size_t numBits, uint32_t maxBit) {
+    vector<uint64_t> bits;
+    uniform_int_distribution<uint32_t> distribution(0, maxBit);
+    for (size_t i = 0; i < numBits; ++i)
+      bits.push_back(distribution(rng));
+    sort(bits.begin(), bits.end());
+    bits.erase(unique(bits.begin(), bits.end()), bits.end());
+    return bits;
+  };
+
+  auto const makeClusteredBits = [&](size_t numClusters, size_t clusterSize, uint32_t maxBit) {
+    vector<uint64_t> bits;
+    for (auto const begin : makeBits(numClusters, maxBit))
+    {
+      for (size_t i = 0; i < clusterSize; ++i)
+        bits.push_back(begin + i);
+    }
+    sort(bits.begin(), bits.end());
+    bits.erase(unique(bits.begin(), bits.end()), bits.end());
+    return bits;
+  };
+
+  // Dense and sparse vectors of different lengths, including sparse vectors which differ
+  // in size enough to be intersected by searching one in another, and chunked vectors.
+  vector<vector<uint64_t>> const setBits = {makeBits(0, 1000),
+                                            makeBits(10, 100),
+                                            makeBits(500, 1000),
+                                            makeBits(5000, 10000),
+                                            makeBits(100, 100000),
+                                            makeBits(10, 1000000),
+                                            makeBits(10000, 1000000),
+                                            makeBits(100000, 1000000),
+                                            makeClusteredBits(100, 1000, 1000000),
+                                            makeClusteredBits(1000, 10, 10000000)};
+
+  for (auto bits1 : setBits)
+  {
+    for (auto bits2 : setBits)
+    {
+      auto const cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(bits1);
+      auto const cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(bits2);
+      CheckIntersection(bits1, bits2, *coding::CompressedBitVector::Intersect(*cbv1, *cbv2));
+      CheckSubtraction(bits1, bits2, *coding::CompressedBitVector::Subtract(*cbv1, *cbv2));
+      CheckUnion(bits1, bits2, *coding::CompressedBitVector::Union(*cbv1, *cbv2));
+    }
+  }
+}
+
+// Not a test actually: prints time of operations on vectors of typical search sizes.
+UNIT_TEST(CompressedBitVector_OpsBenchmark)
+{
+  minstd_rand rng(0);
+  auto const makeCBV = [&rng](size_t numBits, uint32_t maxBit) {
+    vector<uint64_t> bits;
+    uniform_int_distribution<uint32_t> distribution(0, maxBit);
+    for (size_t i = 0; i < numBits; ++i)
+      bits.push_back(distribution(rng));
+    sort(bits.begin(), bits.end());
+    bits.erase(unique(bits.begin(), bits.end()), bits.end());
+    return coding::CompressedBitVectorBuilder::FromBitPositions(move(bits));
+  };
+
+  uint32_t const kMaxBit = 1000000;
+  auto const dense1 = makeCBV(500000, kMaxBit);
+  auto const dense2 = makeCBV(500000, kMaxBit);
+  auto const sparse1 = makeCBV(100000, kMaxBit);
+  auto const sparse2 = makeCBV(100000, kMaxBit);
+  auto const small = makeCBV(100, kMaxBit);
+
+  auto const benchmark = [](string const & name, coding::CompressedBitVector const & a,
+                            coding::CompressedBitVector const & b) {
+    size_t const kNumIterations = 20;
+    uint64_t popCount = 0;
+    base::Timer timer;
+    for (size_t i = 0; i < kNumIterations; ++i)
+      popCount += coding::CompressedBitVector::Intersect(a, b)->PopCount();
+    LOG(LINFO, (name, DebugPrint(a.GetStorageStrategy()), DebugPrint(b.GetStorageStrategy()),
+                "intersection:", timer.ElapsedSeconds() / kNumIterations, "seconds",
+                popCount / kNumIterations, "bits"));
+  };
+
+  benchmark("Half and half full", *dense1, *dense2);
+  benchmark("Half and tenth full", *dense1, *sparse1);
+  benchmark("Tenth and tenth full", *sparse1, *sparse2);
+  benchmark("Almost empty and tenth full", *small, *sparse1);
+}
@@ -1,6 +1,8 @@
 #include "testing/testing.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/memory_region.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/varint.hpp"
 
 #include "base/logging.hpp"
@@ -368,3 +370,68 @@ UNIT_TEST(FilesMappingContainer_PageSize)
 
   FileWriter::DeleteFileX(fName);
 }
+
+#ifndef OMIM_OS_WINDOWS
+UNIT_TEST(FilesContainer_MappedSections)
+{
+  string const fName = "file_container.tmp";
+  char const * key[] = { "3", "2", "1" };
+  uint32_t const count = 1000;
+
+  {
+    FilesContainerW writer(fName);
+
+    for (size_t i = 0; i < ARRAY_SIZE(key); ++i)
+    {
+      FileWriter w = writer.GetWriter(key[i]);
+      for (uint32_t j = 0; j < count; ++j)
+      {
+        uint32_t v = j + static_cast<uint32_t>(i);
+        w.Write(&v, sizeof(v));
+      }
+    }
+  }
+
+  vector<unique_ptr<MemoryRegion>> regions;
+  {
+    FilesContainerR reader(make_unique<MmapReader>(fName));
+
+    for (size_t i = 0; i < ARRAY_SIZE(key); ++i)
+    {
+      FilesContainerR::TReader r = reader.GetReader(key[i]);
+      TEST(r.GetContiguousData() != nullptr, ());
+      TEST_EQUAL(r.Size(), count * sizeof(uint32_t), ());
+
+      regions.push_back(CreateMemoryRegion(*r.GetPtr(), 0 /* pos */, r.Size()));
+      TEST_EQUAL(regions.back()->ImmutableData(), r.GetContiguousData(), ());
+
+      // Unaligned data is copied.
+      auto const unaligned = CreateMemoryRegion(*r.GetPtr(), 1 /* pos */, 4 /* size */);
+      TEST_NOT_EQUAL(unaligned->ImmutableData(), r.GetContiguousData() + 1, ());
+      TEST_EQUAL(unaligned->Size(), 4, ());
+    }
+  }
+
+  // Regions keep the mapping alive.
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    uint32_t const * data = reinterpret_cast<uint32_t const *>(regions[i]->ImmutableData());
+    for (uint32_t j = 0; j < count; ++j)
+      TEST_EQUAL(j + i, data[j], ());
+  }
+  regions.clear();
+
+  {
+    FilesContainerR reader(fName);
+    FilesContainerR::TReader r = reader.GetReader(key[1]);
+    TEST(r.GetContiguousData() == nullptr, ());
+
+    auto const region = CreateMemoryRegion(*r.GetPtr(), 0 /* pos */, r.Size());
+    uint32_t const * data = reinterpret_cast<uint32_t const *>(region->ImmutableData());
+    for (uint32_t j = 0; j < count; ++j)
+      TEST_EQUAL(j + 1, data[j], ());
+  }
+
+  FileWriter::DeleteFileX(fName);
+}
+#endif
@@ -14,8 +14,13 @@
 #include "geometry/simplification.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <limits>
+#include <random>
 
 using namespace coding;
+using namespace std;
 
 using PU = m2::PointU;
 
@@ -125,6 +130,37 @@ UNIT_TEST(PredictPointsInPolyline2_Clamp0)
   TEST_EQUAL(PU(4, 0), PredictPointInPolyline(PU(5, 5), PU(4, 1), PU(4, 4)), ());
 }
 
+UNIT_TEST(PredictPoints_SameAsDoubles)
+{
+  // Reference predictions in doubles, the mwms are encoded with them.
+  auto const clamp = [](m2::PointU const & maxPoint, m2::PointD const & p) {
+    return PU(static_cast<uint32_t>(base::clamp(p.x, 0.0, static_cast<double>(maxPoint.x))),
+              static_cast<uint32_t>(base::clamp(p.y, 0.0, static_cast<double>(maxPoint.y))));
+  };
+
+  mt19937 rng(0);
+  m2::PointU const maxPoint = GetMaxPoint();
+  vector<uint32_t> const special = {0, 1, 2, maxPoint.x - 1, maxPoint.x, maxPoint.x + 1,
+                                    numeric_limits<uint32_t>::max()};
+  auto const coord = [&]() {
+    if (rng() % 4 == 0)
+      return special[rng() % special.size()];
+    return static_cast<uint32_t>(rng());
+  };
+
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    PU const p1(coord(), coord());
+    PU const p2(coord(), coord());
+    PU const p3(coord(), coord());
+    TEST_EQUAL(PredictPointInPolyline(maxPoint, p1, p2),
+               clamp(maxPoint, m2::PointD(p1) + (m2::PointD(p1) - m2::PointD(p2)) / 2.0),
+               (p1, p2));
+    TEST_EQUAL(PredictPointInTriangle(maxPoint, p1, p2, p3),
+               clamp(maxPoint, m2::PointD(p1 + p2 - p3)), (p1, p2, p3));
+  }
+}
+
 /*
 UNIT_TEST(PredictPointsInPolyline3_Square)
 {
@@ -183,3 +219,55 @@ UNIT_TEST(DecodeEncodePolyline_DataSet1)
 
   TestPolylineEncode("DataSet1", points, GetMaxPoint(), &EncodePolyline, &DecodePolyline);
 }
+
+UNIT_TEST(EncodeDecodeFixedWidth)
+{
+  mt19937 rng(0);
+  m2::PointU const basePoint(1 << 20, 1 << 20);
+  // Blocks with zero, one, two and four byte deltas.
+  uint32_t const kMaxDeltas[] = {0, 100, 30000, 1 << 28};
+  for (size_t count : {0, 1, 15, 16, 17, 100})
+  {
+    vector<m2::PointU> points;
+    m2::PointU p = basePoint;
+    for (size_t i = 0; i < count; ++i)
+    {
+      size_t const block = i / serial::kFixedWidthBlockSize;
+      uniform_int_distribution<uint32_t> delta(0, kMaxDeltas[block % ARRAY_SIZE(kMaxDeltas)]);
+      p = m2::PointU(p.x + delta(rng), p.y - delta(rng) / 2);
+      points.push_back(p);
+    }
+
+    vector<char> buffer;
+    serial::EncodeFixedWidth(points, basePoint, buffer);
+
+    serial::pts::PointsU decoded;
+    serial::DecodeFixedWidth(buffer.data(), buffer.data() + buffer.size(), basePoint, decoded);
+    TEST_EQUAL(vector<m2::PointU>(decoded.begin(), decoded.end()), points, (count));
+  }
+}
+
+UNIT_TEST(SaveLoadOuterPathIndexes)
+{
+  vector<m2::PointD> best;
+  for (size_t i = 0; i < 300; ++i)
+    best.emplace_back(i, i % 7);
+
+  // A gap of 200 points takes two bytes.
+  for (auto const & indexes : vector<vector<uint32_t>>{{}, {1}, {299}, {2, 3, 203, 299}})
+  {
+    vector<char> buffer;
+    MemWriter<vector<char>> writer(buffer);
+    serial::SaveOuterPathIndexes(indexes, writer);
+
+    vector<m2::PointD> points = {best[0]};
+    ArrayByteSource src(buffer.data());
+    serial::LoadOuterPathByIndexes(src, best, points);
+    TEST_EQUAL(static_cast<size_t>(src.PtrC() - buffer.data()), buffer.size(), (indexes));
+
+    vector<m2::PointD> expected = {best[0]};
+    for (auto const index : indexes)
+      expected.push_back(best[index]);
+    TEST_EQUAL(points, expected, (indexes));
+  }
+}
@@ -4,10 +4,16 @@
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
 #include "std/vector.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <random>
+
 namespace
 {
 vector<strings::UniString> MakeUniStringVector(vector<string> const & v)
@@ -127,4 +133,72 @@ UNIT_TEST(Huffman_Serialization_Data)
   TEST_EQUAL(expected, received, ());
 }
 
+UNIT_TEST(Huffman_LongCodes)
+{
+  // Fibonacci frequencies give codes which are longer than the decoding table.
+  vector<uint32_t> data;
+  uint32_t a = 1, b = 1;
+  for (uint32_t symbol = 0; symbol < 20; ++symbol)
+  {
+    data.insert(data.end(), a, symbol);
+    auto const c = a + b;
+    a = b;
+    b = c;
+  }
+  std::mt19937 engine(0);
+  std::shuffle(data.begin(), data.end(), engine);
+
+  HuffmanCoder hW;
+  hW.Init(data.begin(), data.end());
+  HuffmanCoder::Code code;
+  TEST(hW.Encode(0, code), ());
+  TEST_GREATER(code.len, 11, ());
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<vector<uint8_t>> writer(buf);
+    hW.WriteEncoding(writer);
+    hW.EncodeAndWrite(writer, data.begin(), data.end());
+    // Decoding must stop at the end of the encoded data.
+    WriteVarUint(writer, static_cast<uint32_t>(12345));
+  }
+
+  HuffmanCoder hR;
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> reader(memReader);
+  hR.ReadEncoding(reader);
+  vector<uint32_t> received;
+  hR.ReadAndDecode(reader, std::back_inserter(received));
+  TEST_EQUAL(data, received, ());
+  TEST_EQUAL(ReadVarUint<uint32_t>(reader), 12345, ());
+}
+
+UNIT_TEST(Huffman_DecodeThroughput)
+{
+  std::mt19937 engine(0);
+  std::geometric_distribution<uint32_t> distribution(0.2);
+  vector<uint32_t> data(1024 * 1024);
+  for (auto & d : data)
+    d = distribution(engine);
+
+  HuffmanCoder h;
+  h.Init(data.begin(), data.end());
+  vector<uint8_t> buf;
+  {
+    MemWriter<vector<uint8_t>> writer(buf);
+    h.EncodeAndWrite(writer, data.begin(), data.end());
+  }
+
+  vector<uint32_t> received;
+  received.reserve(data.size());
+  base::Timer timer;
+  {
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> reader(memReader);
+    h.ReadAndDecode(reader, std::back_inserter(received));
+  }
+  auto const seconds = timer.ElapsedSeconds();
+  TEST_EQUAL(data, received, ());
+  LOG(LINFO, ("Huffman decoding:", data.size() / seconds / 1e6, "M symbols/s"));
+}
 }  // namespace coding
@@ -145,3 +145,42 @@ UNIT_TEST(MultilangString_HasString)
   TEST(!s.HasString(1), ());
   TEST(!s.HasString(32), ());
 }
+
+UNIT_TEST(MultilangString_GetBestString)
+{
+  StringUtf8Multilang s;
+  s.AddString(0, "xxx");
+  s.AddString(18, "yyy");
+  s.AddString(63, "zzz");
+
+  string name;
+  TEST_EQUAL(s.GetBestString({1, 63, 18}, name), 63, ());
+  TEST_EQUAL(name, "zzz", ());
+  TEST_EQUAL(s.GetBestString({18, 0}, name), 18, ());
+  TEST_EQUAL(name, "yyy", ());
+
+  name = "unchanged";
+  TEST_EQUAL(s.GetBestString({1, 2}, name), StringUtf8Multilang::kUnsupportedLanguageCode, ());
+  TEST_EQUAL(s.GetBestString({}, name), StringUtf8Multilang::kUnsupportedLanguageCode, ());
+  TEST_EQUAL(name, "unchanged", ());
+
+  // Languages survive serialization.
+  vector<char> buffer;
+  {
+    MemWriter<vector<char>> writer(buffer);
+    s.Write(writer);
+  }
+  StringUtf8Multilang copy;
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  copy.Read(src);
+
+  TEST(copy.HasString(18), ());
+  TEST(!copy.HasString(1), ());
+  TEST_EQUAL(copy.GetBestString({2, 0}, name), 0, ());
+  TEST_EQUAL(name, "xxx", ());
+
+  copy.Clear();
+  TEST(!copy.HasString(0), ());
+  TEST(!copy.GetString(0, name), ());
+}
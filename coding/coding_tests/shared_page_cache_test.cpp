@@ -0,0 +1,118 @@
+#include "testing/testing.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+#include "coding/shared_page_cache.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+vector<char> MakeData(size_t size)
+{
+  vector<char> data(size);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+}  // namespace
+
+UNIT_TEST(SharedPageCache_ReadFromThreads)
+{
+  auto const data = MakeData(100000);
+  SharedPageCache cache(10 /* logPageSize */, 32 * 1024 /* maxBytes */);
+
+  vector<thread> threads;
+  vector<size_t> failures(4, 0);
+  for (size_t t = 0; t < failures.size(); ++t)
+  {
+    threads.emplace_back([&, t]() {
+      MemReader reader(data.data(), data.size());
+      auto const fileId = cache.GetFileId("data", data.size());
+      mt19937 rng(static_cast<uint32_t>(t));
+      for (size_t i = 0; i < 10000; ++i)
+      {
+        size_t const pos = rng() % data.size();
+        size_t const size = min(static_cast<size_t>(1 + rng() % 3000), data.size() - pos);
+        vector<char> buffer(size);
+        cache.Read(reader, fileId, pos, buffer.data(), size);
+        if (!equal(buffer.begin(), buffer.end(), data.begin() + pos))
+          ++failures[t];
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  for (auto const f : failures)
+    TEST_EQUAL(f, 0, ());
+
+  auto const stats = cache.GetStats();
+  TEST_GREATER(stats.m_hits, 0, ());
+  TEST_GREATER(stats.m_misses, 0, ());
+  TEST_GREATER(stats.m_evictions, 0, ());
+  TEST_LESS_OR_EQUAL(stats.m_bytes, 32 * 1024, ());
+}
+
+UNIT_TEST(SharedPageCache_PinnedPages)
+{
+  auto const data = MakeData(64 * 1024);
+  MemReader reader(data.data(), data.size());
+  SharedPageCache cache(10 /* logPageSize */, SharedPageCache::kShardsCount * 1024);
+  auto const fileId = cache.GetFileId("data", data.size());
+
+  auto const pinned = cache.GetPage(reader, fileId, 0 /* pageNum */);
+  for (uint64_t pageNum = 1; pageNum < 64; ++pageNum)
+    cache.GetPage(reader, fileId, pageNum);
+
+  // The pinned page is still cached.
+  auto const misses = cache.GetStats().m_misses;
+  TEST_EQUAL(cache.GetPage(reader, fileId, 0 /* pageNum */), pinned, ());
+  TEST_EQUAL(cache.GetStats().m_misses, misses, ());
+
+  // Other file and the same file of other size get other ids.
+  TEST_EQUAL(cache.GetFileId("data", data.size()), fileId, ());
+  TEST_NOT_EQUAL(cache.GetFileId("other", data.size()), fileId, ());
+  TEST_NOT_EQUAL(cache.GetFileId("data", data.size() + 1), fileId, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetStats().m_bytes, pinned->size(), ());
+}
+
+UNIT_TEST(SharedPageCache_FileReader)
+{
+  string const fileName = "shared_page_cache_test.tmp";
+  auto const data = MakeData(10000);
+  {
+    FileWriter writer(fileName);
+    writer.Write(data.data(), data.size());
+  }
+
+  {
+    SharedPageCache cache(10 /* logPageSize */, 1024 * 1024 /* maxBytes */);
+    FileReader reader1(fileName, cache);
+    FileReader reader2(fileName, cache);
+    auto const subReader = reader2.SubReader(100, 5000);
+
+    vector<char> buffer(3000);
+    reader1.Read(1000, buffer.data(), buffer.size());
+    TEST(equal(buffer.begin(), buffer.end(), data.begin() + 1000), ());
+
+    // Pages read by |reader1| are used by |reader2|.
+    auto const misses = cache.GetStats().m_misses;
+    subReader.Read(1000, buffer.data(), 2000);
+    TEST(equal(buffer.begin(), buffer.begin() + 2000, data.begin() + 1100), ());
+    TEST_EQUAL(cache.GetStats().m_misses, misses, ());
+  }
+
+  FileWriter::DeleteFileX(fileName);
+}
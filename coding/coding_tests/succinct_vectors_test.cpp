@@ -0,0 +1,219 @@
+#include "testing/testing.hpp"
+
+#include "coding/succinct_mapper.hpp"
+#include "coding/succinct_vectors.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+template <typename Container>
+void FreezeAndMap(Container & container, vector<uint8_t> & buffer, Container & mapped)
+{
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    Freeze(container, writer, "Container");
+  }
+  Map(mapped, buffer.data(), "Container");
+}
+
+vector<uint32_t> MakeIds(size_t size)
+{
+  // Sorted ids with runs of consecutive ids.
+  mt19937 engine(0);
+  vector<uint32_t> ids;
+  for (uint32_t id = 0; id < size; ++id)
+  {
+    if (engine() % 3 == 0)
+      ids.push_back(id);
+  }
+  return ids;
+}
+
+UNIT_TEST(EliasFanoSequence_Smoke)
+{
+  mt19937 engine(0);
+  vector<uint64_t> values;
+  uint64_t value = 0;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    value += engine() % 100;
+    values.push_back(value);
+  }
+
+  EliasFanoSequence sequence(values);
+  vector<uint8_t> buffer;
+  EliasFanoSequence mapped;
+  FreezeAndMap(sequence, buffer, mapped);
+
+  TEST_EQUAL(mapped.Size(), values.size(), ());
+  for (size_t i = 0; i < values.size(); ++i)
+    TEST_EQUAL(mapped.Get(i), values[i], (i));
+
+  auto const ids = MakeIds(values.size());
+  vector<uint64_t> many;
+  mapped.GetMany(ids, many);
+  TEST_EQUAL(many.size(), ids.size(), ());
+  for (size_t i = 0; i < ids.size(); ++i)
+    TEST_EQUAL(many[i], values[ids[i]], (i));
+
+  vector<uint64_t> const strict = {3, 10, 11, 100};
+  EliasFanoSequence strictSequence(strict);
+  TEST_EQUAL(strictSequence.Rank(0), 0, ());
+  TEST_EQUAL(strictSequence.Rank(3), 0, ());
+  TEST_EQUAL(strictSequence.Rank(4), 1, ());
+  TEST_EQUAL(strictSequence.Rank(11), 2, ());
+  TEST_EQUAL(strictSequence.Rank(100), 3, ());
+  TEST_EQUAL(strictSequence.Rank(1000), 4, ());
+
+  EliasFanoSequence empty{vector<uint64_t>()};
+  TEST_EQUAL(empty.Size(), 0, ());
+  TEST_EQUAL(empty.Rank(5), 0, ());
+}
+
+UNIT_TEST(BitPackedVector_Smoke)
+{
+  mt19937 engine(0);
+  vector<uint32_t> values(10000);
+  for (auto & v : values)
+    v = engine() % 1000;
+
+  BitPackedVector<uint32_t> packed(values);
+  TEST_EQUAL(packed.GetBitsCount(), 10, ());
+
+  vector<uint8_t> buffer;
+  BitPackedVector<uint32_t> mapped;
+  FreezeAndMap(packed, buffer, mapped);
+
+  TEST_EQUAL(mapped.Size(), values.size(), ());
+  for (size_t i = 0; i < values.size(); ++i)
+    TEST_EQUAL(mapped.Get(i), values[i], (i));
+
+  vector<uint32_t> unpacked(values.size());
+  mapped.Unpack(0, values.size(), unpacked.data());
+  TEST_EQUAL(unpacked, values, ());
+
+  auto const ids = MakeIds(values.size());
+  vector<uint32_t> many;
+  mapped.GetMany(ids, many);
+  for (size_t i = 0; i < ids.size(); ++i)
+    TEST_EQUAL(many[i], values[ids[i]], (i));
+
+  BitPackedVector<uint64_t> full({0, numeric_limits<uint64_t>::max(), 1});
+  TEST_EQUAL(full.GetBitsCount(), 64, ());
+  TEST_EQUAL(full.Get(1), numeric_limits<uint64_t>::max(), ());
+
+  BitPackedVector<uint8_t> zeros(vector<uint8_t>(10, 0));
+  TEST_EQUAL(zeros.GetBitsCount(), 0, ());
+  TEST_EQUAL(zeros.Get(5), 0, ());
+}
+
+UNIT_TEST(RankSelectBitmap_Smoke)
+{
+  mt19937 engine(0);
+  vector<bool> bits(10000);
+  for (size_t i = 0; i < bits.size(); ++i)
+    bits[i] = engine() % 5 == 0;
+
+  RankSelectBitmap bitmap(bits);
+  vector<uint8_t> buffer;
+  RankSelectBitmap mapped;
+  FreezeAndMap(bitmap, buffer, mapped);
+
+  uint64_t rank = 0;
+  for (size_t i = 0; i < bits.size(); ++i)
+  {
+    TEST_EQUAL(mapped.Get(i), bits[i], (i));
+    TEST_EQUAL(mapped.Rank(i), rank, (i));
+    if (bits[i])
+    {
+      TEST_EQUAL(mapped.Select(rank), i, ());
+      ++rank;
+    }
+  }
+  TEST_EQUAL(mapped.NumOnes(), rank, ());
+
+  auto const ids = MakeIds(bits.size());
+  vector<bool> many;
+  vector<uint64_t> ranks;
+  mapped.GetMany(ids, many);
+  mapped.RankMany(ids, ranks);
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    TEST_EQUAL(many[i], bits[ids[i]], (i));
+    TEST_EQUAL(ranks[i], mapped.Rank(ids[i]), (i));
+  }
+}
+
+UNIT_TEST(FixedBitsSuccinctVector_Smoke)
+{
+  using Vector = FixedBitsSuccinctVector<3>;
+
+  mt19937 engine(0);
+  vector<uint32_t> values(10000);
+  vector<bool> defined(values.size());
+  Vector::Builder builder;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    auto const r = engine() % 10;
+    defined[i] = r != 0;
+    values[i] = r < 8 ? r % 6 : static_cast<uint32_t>(engine() % 1000);
+    if (defined[i])
+      builder.PushBack(values[i]);
+    else
+      builder.PushBackUndefined();
+  }
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+  Vector mapped;
+  Map(mapped, buffer.data(), "FixedBitsSuccinctVector");
+
+  TEST_EQUAL(mapped.Size(), values.size(), ());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    uint32_t value;
+    TEST_EQUAL(mapped.Get(i, value), defined[i], (i));
+    if (defined[i])
+      TEST_EQUAL(value, values[i], (i));
+  }
+
+  auto const ids = MakeIds(values.size());
+  vector<uint32_t> many;
+  vector<bool> manyDefined;
+  mapped.GetMany(ids, many, manyDefined);
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    TEST_EQUAL(manyDefined[i], defined[ids[i]], (i));
+    if (manyDefined[i])
+      TEST_EQUAL(many[i], values[ids[i]], (i));
+  }
+
+  // Vector without large values.
+  Vector::Builder smallBuilder;
+  for (uint32_t v : {0, 1, 2, 3, 4, 5})
+    smallBuilder.PushBack(v);
+  vector<uint8_t> smallBuffer;
+  {
+    MemWriter<vector<uint8_t>> writer(smallBuffer);
+    smallBuilder.Freeze(writer);
+  }
+  Vector small;
+  Map(small, smallBuffer.data(), "FixedBitsSuccinctVector");
+  for (uint32_t i = 0; i < 6; ++i)
+  {
+    uint32_t value;
+    TEST(small.Get(i, value), (i));
+    TEST_EQUAL(value, i, ());
+  }
+}
+}  // namespace
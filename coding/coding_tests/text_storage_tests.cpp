@@ -31,10 +31,11 @@ string GenerateRandomString(Engine & engine)
   return s;
 }
 
-void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer)
+void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer,
+                 BlockCodec codec = BlockCodec::BWT, string const & dict = {})
 {
   MemWriter<vector<uint8_t>> writer(buffer);
-  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize);
+  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize, codec, dict);
   for (auto const & s : strings)
     ts.Append(s);
 }
@@ -129,4 +130,36 @@ UNIT_TEST(TextStorage_Random)
   for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
     TEST_EQUAL(ts.ExtractString(i), strings[i], ());
 }
+
+UNIT_TEST(TextStorage_Codecs)
+{
+  int const kSeed = 42;
+  int const kNumStrings = 500;
+  int const kBlockSize = 1000;
+  mt19937 engine(kSeed);
+
+  vector<string> strings;
+  for (int i = 0; i < kNumStrings; ++i)
+    strings.push_back(GenerateRandomString(engine));
+
+  string const dict = strings[0] + strings[1];
+  for (auto const codec : {BlockCodec::BWT, BlockCodec::ZLib, BlockCodec::Lz})
+  {
+    auto const & d = codec == BlockCodec::Lz ? dict : string();
+
+    vector<uint8_t> buffer;
+    DumpStrings(strings, kBlockSize, buffer, codec, d);
+
+    MemReader reader(buffer.data(), buffer.size());
+    BlockedTextStorageIndex index;
+    index.Read(reader);
+    TEST_EQUAL(index.GetCodec(), codec, ());
+    TEST_EQUAL(index.GetDictionarySize(), d.size(), ());
+
+    BlockedTextStorage<decltype(reader)> ts(reader, d);
+    TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
+    for (size_t i = 0; i < ts.GetNumStrings(); ++i)
+      TEST_EQUAL(ts.ExtractString(i), strings[i], (codec, i));
+  }
+}
 }  // namespace
@@ -4,6 +4,7 @@
 
 #include "base/assert.hpp"
 #include "base/bits.hpp"
+#include "base/checked_cast.hpp"
 
 #include "std/algorithm.hpp"
 
@@ -11,6 +12,264 @@ namespace coding
 {
 namespace
 {
+// Sparse vectors are intersected by searching elements of the smaller one in the larger one
+// when the larger one is at least this many times larger.
+size_t constexpr kGallopingRatio = 32;
+
+// Kernels below work on raw bit groups and positions without bounds checks and with
+// branchless inner loops, so compilers vectorize them for SIMD instructions of the
+// target (SSE/AVX on x86, NEON on ARM) and they don't suffer from branch mispredictions
+// on random data.
+template <typename TOp>
+void CombineBitGroups(uint64_t const * a, uint64_t const * b, size_t n, uint64_t * res, TOp op)
+{
+  for (size_t i = 0; i < n; ++i)
+    res[i] = op(a[i], b[i]);
+}
+
+inline uint64_t GetBit(uint64_t const * groups, uint64_t pos)
+{
+  return (groups[pos / DenseCBV::kBlockSize] >> (pos % DenseCBV::kBlockSize)) & 1;
+}
+
+// Returns the first position in [it, end) which is not less than |value|. Steps grow
+// exponentially, so the search is logarithmic in the distance to the result.
+SparseCBV::TIterator Gallop(SparseCBV::TIterator it, SparseCBV::TIterator end, uint64_t value)
+{
+  size_t step = 1;
+  auto hi = it;
+  while (hi != end && *hi < value)
+  {
+    it = hi + 1;
+    hi = static_cast<size_t>(end - hi) > step ? hi + step : end;
+    step *= 2;
+  }
+  return lower_bound(it, hi, value);
+}
+
+using Chunk = ChunkedCBV::Chunk;
+
+// Size of the key, the type and the size of values of a serialized chunk.
+size_t constexpr kChunkHeaderSizeBytes = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint32_t);
+
+// Returns the number of runs of consecutive set bits in kNumBitGroups bit groups.
+size_t CountRuns(uint64_t const * bitmap)
+{
+  size_t numRuns = 0;
+  uint64_t carry = 0;
+  for (size_t i = 0; i < Chunk::kNumBitGroups; ++i)
+  {
+    numRuns += bits::PopCount(bitmap[i] & ~((bitmap[i] << 1) | carry));
+    carry = bitmap[i] >> (DenseCBV::kBlockSize - 1);
+  }
+  return numRuns;
+}
+
+size_t CountRuns(vector<uint16_t> const & offsets)
+{
+  size_t numRuns = 0;
+  for (size_t i = 0; i < offsets.size(); ++i)
+    numRuns += i == 0 || offsets[i] != offsets[i - 1] + 1;
+  return numRuns;
+}
+
+// Returns the type of the most compact chunk with |popCount| bits in |numRuns| runs.
+Chunk::Type ChooseChunkType(size_t popCount, size_t numRuns)
+{
+  size_t const runsSize = 2 * sizeof(uint16_t) * numRuns;
+  size_t const arraySize = sizeof(uint16_t) * popCount;
+  size_t const bitmapSize = sizeof(uint64_t) * Chunk::kNumBitGroups;
+  if (runsSize < min(arraySize, bitmapSize))
+    return Chunk::Type::Runs;
+  return popCount <= Chunk::kMaxArraySize ? Chunk::Type::Array : Chunk::Type::Bitmap;
+}
+
+size_t GetChunkSizeBytes(size_t popCount, size_t numRuns)
+{
+  switch (ChooseChunkType(popCount, numRuns))
+  {
+  case Chunk::Type::Array: return kChunkHeaderSizeBytes + sizeof(uint16_t) * popCount;
+  case Chunk::Type::Bitmap: return kChunkHeaderSizeBytes + sizeof(uint64_t) * Chunk::kNumBitGroups;
+  case Chunk::Type::Runs: return kChunkHeaderSizeBytes + 2 * sizeof(uint16_t) * numRuns;
+  }
+  CHECK_SWITCH();
+}
+
+template <typename TOp>
+Chunk CombineChunkBitmaps(Chunk const & a, Chunk const & b, TOp op)
+{
+  ASSERT_EQUAL(a.m_key, b.m_key, ());
+  vector<uint64_t> bitmapA(Chunk::kNumBitGroups);
+  vector<uint64_t> bitmapB(Chunk::kNumBitGroups);
+  a.ToBitmap(bitmapA.data());
+  b.ToBitmap(bitmapB.data());
+  CombineBitGroups(bitmapA.data(), bitmapB.data(), Chunk::kNumBitGroups, bitmapA.data(), op);
+  return Chunk::FromBitmap(a.m_key, move(bitmapA));
+}
+
+Chunk IntersectChunks(Chunk const & a, Chunk const & b)
+{
+  if (a.m_type == Chunk::Type::Array && b.m_type == Chunk::Type::Array)
+  {
+    vector<uint16_t> offsets;
+    set_intersection(a.m_values.begin(), a.m_values.end(), b.m_values.begin(), b.m_values.end(),
+                     back_inserter(offsets));
+    return Chunk::FromOffsets(a.m_key, offsets);
+  }
+
+  if (b.m_type == Chunk::Type::Array)
+    return IntersectChunks(b, a);
+
+  if (a.m_type == Chunk::Type::Array)
+  {
+    vector<uint16_t> offsets;
+    copy_if(a.m_values.begin(), a.m_values.end(), back_inserter(offsets),
+            [&b](uint16_t offset) { return b.GetBit(offset); });
+    return Chunk::FromOffsets(a.m_key, offsets);
+  }
+
+  return CombineChunkBitmaps(a, b, [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+Chunk SubtractChunks(Chunk const & a, Chunk const & b)
+{
+  if (a.m_type == Chunk::Type::Array)
+  {
+    vector<uint16_t> offsets;
+    copy_if(a.m_values.begin(), a.m_values.end(), back_inserter(offsets),
+            [&b](uint16_t offset) { return !b.GetBit(offset); });
+    return Chunk::FromOffsets(a.m_key, offsets);
+  }
+
+  return CombineChunkBitmaps(a, b, [](uint64_t x, uint64_t y) { return x & ~y; });
+}
+
+Chunk UniteChunks(Chunk const & a, Chunk const & b)
+{
+  if (a.m_type == Chunk::Type::Array && b.m_type == Chunk::Type::Array &&
+      a.m_popCount + b.m_popCount <= Chunk::kMaxArraySize)
+  {
+    vector<uint16_t> offsets;
+    set_union(a.m_values.begin(), a.m_values.end(), b.m_values.begin(), b.m_values.end(),
+              back_inserter(offsets));
+    return Chunk::FromOffsets(a.m_key, offsets);
+  }
+
+  return CombineChunkBitmaps(a, b, [](uint64_t x, uint64_t y) { return x | y; });
+}
+
+// Combines chunks with equal keys by |fn|. Chunks present only in |a| or in |b| are kept
+// if |keepA| or |keepB| are set respectively.
+template <typename TFn>
+unique_ptr<CompressedBitVector> CombineChunked(ChunkedCBV const & a, ChunkedCBV const & b,
+                                               bool keepA, bool keepB, TFn && fn)
+{
+  auto const & chunksA = a.GetChunks();
+  auto const & chunksB = b.GetChunks();
+  vector<Chunk> chunks;
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < chunksA.size() || j < chunksB.size())
+  {
+    if (j == chunksB.size() || (i < chunksA.size() && chunksA[i].m_key < chunksB[j].m_key))
+    {
+      if (keepA)
+        chunks.push_back(chunksA[i]);
+      ++i;
+    }
+    else if (i == chunksA.size() || chunksB[j].m_key < chunksA[i].m_key)
+    {
+      if (keepB)
+        chunks.push_back(chunksB[j]);
+      ++j;
+    }
+    else
+    {
+      Chunk chunk = fn(chunksA[i], chunksB[j]);
+      if (chunk.m_popCount != 0)
+        chunks.push_back(move(chunk));
+      ++i;
+      ++j;
+    }
+  }
+
+  return make_unique<ChunkedCBV>(move(chunks));
+}
+
+// Combines every chunk of |a| with bits of |b| in the same range by |op|. Chunks after the last
+// bit group of |b| are kept if |keepA| is set.
+template <typename TOp>
+unique_ptr<CompressedBitVector> CombineChunkedAndDense(ChunkedCBV const & a, DenseCBV const & b,
+                                                       bool keepA, TOp op)
+{
+  auto const & groups = b.GetBitGroups();
+  vector<Chunk> chunks;
+  for (auto const & chunk : a.GetChunks())
+  {
+    size_t const begin = static_cast<size_t>(chunk.m_key) * Chunk::kNumBitGroups;
+    if (begin >= groups.size())
+    {
+      if (!keepA)
+        break;
+      chunks.push_back(chunk);
+      continue;
+    }
+
+    Chunk result;
+    if (chunk.m_type == Chunk::Type::Array)
+    {
+      uint64_t const * group = groups.data() + begin;
+      size_t const numBits = DenseCBV::kBlockSize * (groups.size() - begin);
+      vector<uint16_t> offsets;
+      copy_if(chunk.m_values.begin(), chunk.m_values.end(), back_inserter(offsets),
+              [&](uint16_t offset) {
+                uint64_t const bit = offset < numBits ? GetBit(group, offset) : 0;
+                return (op(static_cast<uint64_t>(1), bit) & 1) != 0;
+              });
+      result = Chunk::FromOffsets(chunk.m_key, offsets);
+    }
+    else
+    {
+      vector<uint64_t> bitmap(Chunk::kNumBitGroups);
+      vector<uint64_t> bitmapB(Chunk::kNumBitGroups);
+      chunk.ToBitmap(bitmap.data());
+      copy(groups.begin() + begin,
+           groups.begin() + min(groups.size(), begin + Chunk::kNumBitGroups), bitmapB.begin());
+      CombineBitGroups(bitmap.data(), bitmapB.data(), Chunk::kNumBitGroups, bitmap.data(), op);
+      result = Chunk::FromBitmap(chunk.m_key, move(bitmap));
+    }
+
+    if (result.m_popCount != 0)
+      chunks.push_back(move(result));
+  }
+  return make_unique<ChunkedCBV>(move(chunks));
+}
+
+unique_ptr<ChunkedCBV> ToChunked(DenseCBV const & cbv)
+{
+  auto const & groups = cbv.GetBitGroups();
+  vector<Chunk> chunks;
+  for (size_t begin = 0; begin < groups.size(); begin += Chunk::kNumBitGroups)
+  {
+    auto const first = groups.begin() + begin;
+    auto const last = groups.begin() + min(groups.size(), begin + Chunk::kNumBitGroups);
+    if (all_of(first, last, [](uint64_t group) { return group == 0; }))
+      continue;
+
+    vector<uint64_t> bitmap(Chunk::kNumBitGroups);
+    copy(first, last, bitmap.begin());
+    chunks.push_back(
+        Chunk::FromBitmap(base::asserted_cast<uint32_t>(begin / Chunk::kNumBitGroups), move(bitmap)));
+  }
+  return make_unique<ChunkedCBV>(move(chunks));
+}
+
+unique_ptr<ChunkedCBV> ToChunked(SparseCBV const & cbv)
+{
+  return make_unique<ChunkedCBV>(vector<uint64_t>(cbv.Begin(), cbv.End()));
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -21,8 +280,8 @@ struct IntersectOp
     size_t sizeA = a.NumBitGroups();
     size_t sizeB = b.NumBitGroups();
     vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+    CombineBitGroups(a.GetBitGroups().data(), b.GetBitGroups().data(), resGroups.size(),
+                     resGroups.data(), [](uint64_t x, uint64_t y) { return x & y; });
     return coding::CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -30,13 +289,18 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
-    vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
+    // Positions of |b| after the last bit group of |a| are not tested at all.
+    auto const end = lower_bound(b.Begin(), b.End(), a.NumBitGroups() * DenseCBV::kBlockSize);
+    vector<uint64_t> resPos(distance(b.Begin(), end));
+
+    uint64_t const * groups = a.GetBitGroups().data();
+    size_t n = 0;
+    for (auto it = b.Begin(); it != end; ++it)
     {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
-        resPos.push_back(pos);
+      resPos[n] = *it;
+      n += GetBit(groups, *it);
     }
+    resPos.resize(n);
     return make_unique<coding::SparseCBV>(move(resPos));
   }
 
@@ -48,11 +312,74 @@ struct IntersectOp
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
                                                      coding::SparseCBV const & b) const
+  {
+    if (a.PopCount() > b.PopCount())
+      return operator()(b, a);
+
+    vector<uint64_t> resPos;
+    if (b.PopCount() >= a.PopCount() * kGallopingRatio)
+    {
+      auto j = b.Begin();
+      for (auto i = a.Begin(); i != a.End() && j != b.End(); ++i)
+      {
+        j = Gallop(j, b.End(), *i);
+        if (j != b.End() && *j == *i)
+          resPos.push_back(*i);
+      }
+      return make_unique<coding::SparseCBV>(move(resPos));
+    }
+
+    resPos.resize(a.PopCount());
+    size_t n = 0;
+    auto i = a.Begin();
+    auto j = b.Begin();
+    while (i != a.End() && j != b.End())
+    {
+      uint64_t const x = *i;
+      uint64_t const y = *j;
+      resPos[n] = x;
+      n += x == y;
+      i += x <= y;
+      j += y <= x;
+    }
+    resPos.resize(n);
+    return make_unique<coding::SparseCBV>(move(resPos));
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    return CombineChunked(a, b, false /* keepA */, false /* keepB */, &IntersectChunks);
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::DenseCBV const & b) const
+  {
+    return CombineChunkedAndDense(a, b, false /* keepA */,
+                                  [](uint64_t x, uint64_t y) { return x & y; });
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    return operator()(b, a);
+  }
+
+  // The intersection of chunked and sparse is always sparse.
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    copy_if(b.Begin(), b.End(), back_inserter(resPos),
+            [&a](uint64_t pos) { return a.GetBit(pos); });
     return make_unique<coding::SparseCBV>(move(resPos));
   }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    return operator()(b, a);
+  }
 };
 
 struct SubtractOp
@@ -64,9 +391,9 @@ struct SubtractOp
   {
     size_t sizeA = a.NumBitGroups();
     size_t sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
+    vector<uint64_t> resGroups(a.GetBitGroups());
+    CombineBitGroups(resGroups.data(), b.GetBitGroups().data(), min(sizeA, sizeB),
+                     resGroups.data(), [](uint64_t x, uint64_t y) { return x & ~y; });
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -101,11 +428,18 @@ struct SubtractOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    vector<uint64_t> resPos;
-    copy_if(a.Begin(), a.End(), back_inserter(resPos), [&](uint64_t bit)
-            {
-              return !b.GetBit(bit);
-            });
+    vector<uint64_t> resPos(a.Begin(), a.End());
+
+    // Positions of |a| after the last bit group of |b| are kept as is.
+    auto const end = lower_bound(a.Begin(), a.End(), b.NumBitGroups() * DenseCBV::kBlockSize);
+    uint64_t const * groups = b.GetBitGroups().data();
+    size_t n = 0;
+    for (auto it = a.Begin(); it != end; ++it)
+    {
+      resPos[n] = *it;
+      n += GetBit(groups, *it) ^ 1;
+    }
+    resPos.erase(copy(end, a.End(), resPos.begin() + n), resPos.end());
     return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
   }
 
@@ -116,6 +450,40 @@ struct SubtractOp
     set_difference(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
     return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
   }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    return CombineChunked(a, b, true /* keepA */, false /* keepB */, &SubtractChunks);
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::DenseCBV const & b) const
+  {
+    return CombineChunkedAndDense(a, b, true /* keepA */,
+                                  [](uint64_t x, uint64_t y) { return x & ~y; });
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    return operator()(*ToChunked(a), b);
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::SparseCBV const & b) const
+  {
+    return operator()(a, *ToChunked(b));
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    vector<uint64_t> resPos;
+    copy_if(a.Begin(), a.End(), back_inserter(resPos),
+            [&b](uint64_t pos) { return !b.GetBit(pos); });
+    return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
+  }
 };
 
 struct UnionOp
@@ -128,21 +496,12 @@ struct UnionOp
     size_t sizeA = a.NumBitGroups();
     size_t sizeB = b.NumBitGroups();
 
-    size_t commonSize = min(sizeA, sizeB);
-    size_t resultSize = max(sizeA, sizeB);
-    vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    }
-    else
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
-    }
+    if (sizeA < sizeB)
+      return operator()(b, a);
+
+    vector<uint64_t> resGroups(a.GetBitGroups());
+    CombineBitGroups(resGroups.data(), b.GetBitGroups().data(), sizeB, resGroups.data(),
+                     [](uint64_t x, uint64_t y) { return x | y; });
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -158,10 +517,10 @@ struct UnionOp
       auto j = b.Begin();
       auto merge = [&](uint64_t va)
       {
-        while (j < b.End() && *j < va)
+        for (; j < b.End() && *j <= va; ++j)
         {
-          resPos.push_back(*j);
-          ++j;
+          if (*j != va)
+            resPos.push_back(*j);
         }
         resPos.push_back(va);
       };
@@ -206,40 +565,67 @@ struct UnionOp
     set_union(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
     return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
   }
-};
 
-template <typename TBinaryOp>
-unique_ptr<coding::CompressedBitVector> Apply(TBinaryOp const & op, CompressedBitVector const & lhs,
-                                              CompressedBitVector const & rhs)
-{
-  using strat = CompressedBitVector::StorageStrategy;
-  auto const stratA = lhs.GetStorageStrategy();
-  auto const stratB = rhs.GetStorageStrategy();
-  if (stratA == strat::Dense && stratB == strat::Dense)
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
+  {
+    return CombineChunked(a, b, true /* keepA */, true /* keepB */, &UniteChunks);
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::DenseCBV const & b) const
+  {
+    return operator()(a, *ToChunked(b));
+  }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
   {
-    DenseCBV const & a = static_cast<DenseCBV const &>(lhs);
-    DenseCBV const & b = static_cast<DenseCBV const &>(rhs);
-    return op(a, b);
+    return operator()(b, a);
   }
-  if (stratA == strat::Dense && stratB == strat::Sparse)
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::ChunkedCBV const & a,
+                                                     coding::SparseCBV const & b) const
   {
-    DenseCBV const & a = static_cast<DenseCBV const &>(lhs);
-    SparseCBV const & b = static_cast<SparseCBV const &>(rhs);
-    return op(a, b);
+    return operator()(a, *ToChunked(b));
   }
-  if (stratA == strat::Sparse && stratB == strat::Dense)
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
+                                                     coding::ChunkedCBV const & b) const
   {
-    SparseCBV const & a = static_cast<SparseCBV const &>(lhs);
-    DenseCBV const & b = static_cast<DenseCBV const &>(rhs);
-    return op(a, b);
+    return operator()(b, a);
   }
-  if (stratA == strat::Sparse && stratB == strat::Sparse)
+};
+
+template <typename TBinaryOp, typename TCBV>
+unique_ptr<coding::CompressedBitVector> Apply(TBinaryOp const & op, TCBV const & a,
+                                              CompressedBitVector const & rhs)
+{
+  switch (rhs.GetStorageStrategy())
   {
-    SparseCBV const & a = static_cast<SparseCBV const &>(lhs);
-    SparseCBV const & b = static_cast<SparseCBV const &>(rhs);
-    return op(a, b);
+  case CompressedBitVector::StorageStrategy::Dense:
+    return op(a, static_cast<DenseCBV const &>(rhs));
+  case CompressedBitVector::StorageStrategy::Sparse:
+    return op(a, static_cast<SparseCBV const &>(rhs));
+  case CompressedBitVector::StorageStrategy::Chunked:
+    return op(a, static_cast<ChunkedCBV const &>(rhs));
   }
+  return nullptr;
+}
 
+template <typename TBinaryOp>
+unique_ptr<coding::CompressedBitVector> Apply(TBinaryOp const & op, CompressedBitVector const & lhs,
+                                              CompressedBitVector const & rhs)
+{
+  switch (lhs.GetStorageStrategy())
+  {
+  case CompressedBitVector::StorageStrategy::Dense:
+    return Apply(op, static_cast<DenseCBV const &>(lhs), rhs);
+  case CompressedBitVector::StorageStrategy::Sparse:
+    return Apply(op, static_cast<SparseCBV const &>(lhs), rhs);
+  case CompressedBitVector::StorageStrategy::Chunked:
+    return Apply(op, static_cast<ChunkedCBV const &>(lhs), rhs);
+  }
   return nullptr;
 }
 
@@ -264,6 +650,9 @@ unique_ptr<CompressedBitVector> BuildFromBitPositions(TBitPositions && setBits)
   if (DenseEnough(setBits.size(), maxBit))
     return make_unique<DenseCBV>(forward<TBitPositions>(setBits));
 
+  if (ChunkedCBV::ChunkedEnough(setBits))
+    return make_unique<ChunkedCBV>(setBits);
+
   return make_unique<SparseCBV>(forward<TBitPositions>(setBits));
 }
 }  // namespace
@@ -409,6 +798,270 @@ unique_ptr<CompressedBitVector> SparseCBV::Clone() const
   return unique_ptr<CompressedBitVector>(cbv);
 }
 
+// static
+uint64_t const ChunkedCBV::kChunkSize;
+
+// static
+size_t const ChunkedCBV::Chunk::kNumBitGroups;
+
+// static
+size_t const ChunkedCBV::Chunk::kMaxArraySize;
+
+// static
+ChunkedCBV::Chunk ChunkedCBV::Chunk::FromOffsets(uint32_t key, vector<uint16_t> const & offsets)
+{
+  ASSERT(is_sorted(offsets.begin(), offsets.end()), ());
+
+  Chunk chunk;
+  chunk.m_key = key;
+  chunk.m_popCount = base::asserted_cast<uint32_t>(offsets.size());
+  chunk.m_type = ChooseChunkType(offsets.size(), CountRuns(offsets));
+  switch (chunk.m_type)
+  {
+  case Type::Array: chunk.m_values = offsets; break;
+  case Type::Bitmap:
+    chunk.m_bitmap.assign(kNumBitGroups, 0);
+    for (uint16_t const offset : offsets)
+    {
+      chunk.m_bitmap[offset / DenseCBV::kBlockSize] |= static_cast<uint64_t>(1)
+                                                       << (offset % DenseCBV::kBlockSize);
+    }
+    break;
+  case Type::Runs:
+    for (size_t i = 0; i < offsets.size(); ++i)
+    {
+      if (i == 0 || offsets[i] != offsets[i - 1] + 1)
+      {
+        chunk.m_values.push_back(offsets[i]);
+        chunk.m_values.push_back(offsets[i]);
+      }
+      else
+      {
+        chunk.m_values.back() = offsets[i];
+      }
+    }
+    break;
+  }
+  return chunk;
+}
+
+// static
+ChunkedCBV::Chunk ChunkedCBV::Chunk::FromBitmap(uint32_t key, vector<uint64_t> && bitmap)
+{
+  ASSERT_EQUAL(bitmap.size(), kNumBitGroups, ());
+
+  uint32_t popCount = 0;
+  for (uint64_t const group : bitmap)
+    popCount += bits::PopCount(group);
+
+  if (ChooseChunkType(popCount, CountRuns(bitmap.data())) == Type::Bitmap)
+  {
+    Chunk chunk;
+    chunk.m_key = key;
+    chunk.m_type = Type::Bitmap;
+    chunk.m_popCount = popCount;
+    chunk.m_bitmap = move(bitmap);
+    return chunk;
+  }
+
+  vector<uint16_t> offsets;
+  offsets.reserve(popCount);
+  for (size_t i = 0; i < kNumBitGroups; ++i)
+  {
+    for (uint64_t group = bitmap[i]; group != 0; group &= group - 1)
+    {
+      offsets.push_back(static_cast<uint16_t>(DenseCBV::kBlockSize * i +
+                                              bits::PopCount((group & (~group + 1)) - 1)));
+    }
+  }
+  return FromOffsets(key, offsets);
+}
+
+bool ChunkedCBV::Chunk::GetBit(uint16_t offset) const
+{
+  switch (m_type)
+  {
+  case Type::Array: return binary_search(m_values.begin(), m_values.end(), offset);
+  case Type::Bitmap:
+    return ((m_bitmap[offset / DenseCBV::kBlockSize] >> (offset % DenseCBV::kBlockSize)) & 1) > 0;
+  case Type::Runs:
+  {
+    // Finds the first run which ends not before |offset|.
+    size_t lo = 0;
+    size_t hi = m_values.size() / 2;
+    while (lo < hi)
+    {
+      size_t const mid = lo + (hi - lo) / 2;
+      if (m_values[2 * mid + 1] < offset)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo < m_values.size() / 2 && m_values[2 * lo] <= offset;
+  }
+  }
+  CHECK_SWITCH();
+}
+
+void ChunkedCBV::Chunk::ToBitmap(uint64_t * bitmap) const
+{
+  if (m_type == Type::Bitmap)
+  {
+    copy(m_bitmap.begin(), m_bitmap.end(), bitmap);
+    return;
+  }
+
+  fill(bitmap, bitmap + kNumBitGroups, 0);
+  uint64_t const begin = static_cast<uint64_t>(m_key) * kChunkSize;
+  ForEach([&](uint64_t pos) {
+    uint64_t const offset = pos - begin;
+    bitmap[offset / DenseCBV::kBlockSize] |= static_cast<uint64_t>(1)
+                                             << (offset % DenseCBV::kBlockSize);
+  });
+}
+
+void ChunkedCBV::Chunk::UpdatePopCount()
+{
+  m_popCount = 0;
+  switch (m_type)
+  {
+  case Type::Array: m_popCount = base::asserted_cast<uint32_t>(m_values.size()); break;
+  case Type::Bitmap:
+    for (uint64_t const group : m_bitmap)
+      m_popCount += bits::PopCount(group);
+    break;
+  case Type::Runs:
+    for (size_t i = 0; i + 1 < m_values.size(); i += 2)
+      m_popCount += m_values[i + 1] - m_values[i] + 1;
+    break;
+  }
+}
+
+ChunkedCBV::ChunkedCBV(vector<uint64_t> const & setBits)
+{
+  ASSERT(is_sorted(setBits.begin(), setBits.end()), ());
+
+  vector<uint16_t> offsets;
+  for (size_t i = 0; i < setBits.size();)
+  {
+    uint64_t const key = setBits[i] / kChunkSize;
+    offsets.clear();
+    for (; i < setBits.size() && setBits[i] / kChunkSize == key; ++i)
+      offsets.push_back(static_cast<uint16_t>(setBits[i] % kChunkSize));
+    m_chunks.push_back(Chunk::FromOffsets(base::asserted_cast<uint32_t>(key), offsets));
+  }
+  m_popCount = setBits.size();
+}
+
+ChunkedCBV::ChunkedCBV(vector<Chunk> && chunks) : m_chunks(move(chunks))
+{
+  ASSERT(is_sorted(m_chunks.begin(), m_chunks.end(),
+                   [](Chunk const & lhs, Chunk const & rhs) { return lhs.m_key < rhs.m_key; }),
+         ());
+  for (auto const & chunk : m_chunks)
+    m_popCount += chunk.m_popCount;
+}
+
+// static
+bool ChunkedCBV::ChunkedEnough(vector<uint64_t> const & setBits)
+{
+  // Vectors of a single chunk are small enough to be kept as is.
+  if (setBits.empty() || setBits.back() < kChunkSize)
+    return false;
+
+  size_t sizeBytes = sizeof(uint32_t);
+  for (size_t i = 0; i < setBits.size();)
+  {
+    uint64_t const key = setBits[i] / kChunkSize;
+    size_t popCount = 0;
+    size_t numRuns = 0;
+    for (; i < setBits.size() && setBits[i] / kChunkSize == key; ++i, ++popCount)
+      numRuns += popCount == 0 || setBits[i] != setBits[i - 1] + 1;
+    sizeBytes += GetChunkSizeBytes(popCount, numRuns);
+  }
+  return 2 * sizeBytes <= sizeof(uint64_t) * setBits.size();
+}
+
+size_t ChunkedCBV::GetSizeBytes() const
+{
+  size_t sizeBytes = 0;
+  for (auto const & chunk : m_chunks)
+  {
+    sizeBytes += sizeof(Chunk) + sizeof(uint16_t) * chunk.m_values.size() +
+                 sizeof(uint64_t) * chunk.m_bitmap.size();
+  }
+  return sizeBytes;
+}
+
+uint64_t ChunkedCBV::PopCount() const { return m_popCount; }
+
+bool ChunkedCBV::GetBit(uint64_t pos) const
+{
+  uint64_t const key = pos / kChunkSize;
+  auto const it = lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                              [](Chunk const & chunk, uint64_t key) { return chunk.m_key < key; });
+  if (it == m_chunks.end() || it->m_key != key)
+    return false;
+  return it->GetBit(static_cast<uint16_t>(pos % kChunkSize));
+}
+
+unique_ptr<CompressedBitVector> ChunkedCBV::LeaveFirstSetNBits(uint64_t n) const
+{
+  if (PopCount() <= n)
+    return Clone();
+
+  vector<Chunk> chunks;
+  for (size_t i = 0; i < m_chunks.size() && n != 0; ++i)
+  {
+    Chunk const & chunk = m_chunks[i];
+    if (chunk.m_popCount <= n)
+    {
+      n -= chunk.m_popCount;
+      chunks.push_back(chunk);
+      continue;
+    }
+
+    vector<uint16_t> offsets;
+    uint64_t const begin = static_cast<uint64_t>(chunk.m_key) * kChunkSize;
+    chunk.ForEach([&](uint64_t pos) {
+      if (offsets.size() < n)
+        offsets.push_back(static_cast<uint16_t>(pos - begin));
+    });
+    chunks.push_back(Chunk::FromOffsets(chunk.m_key, offsets));
+    n = 0;
+  }
+  return make_unique<ChunkedCBV>(move(chunks));
+}
+
+CompressedBitVector::StorageStrategy ChunkedCBV::GetStorageStrategy() const
+{
+  return CompressedBitVector::StorageStrategy::Chunked;
+}
+
+void ChunkedCBV::Serialize(Writer & writer) const
+{
+  uint8_t header = static_cast<uint8_t>(GetStorageStrategy());
+  WriteToSink(writer, header);
+  WriteToSink(writer, base::asserted_cast<uint32_t>(m_chunks.size()));
+  for (auto const & chunk : m_chunks)
+  {
+    WriteToSink(writer, chunk.m_key);
+    WriteToSink(writer, static_cast<uint8_t>(chunk.m_type));
+    if (chunk.m_type == Chunk::Type::Bitmap)
+      rw::WriteVectorOfPOD(writer, chunk.m_bitmap);
+    else
+      rw::WriteVectorOfPOD(writer, chunk.m_values);
+  }
+}
+
+unique_ptr<CompressedBitVector> ChunkedCBV::Clone() const
+{
+  ChunkedCBV * cbv = new ChunkedCBV();
+  cbv->m_chunks = m_chunks;
+  cbv->m_popCount = m_popCount;
+  return unique_ptr<CompressedBitVector>(cbv);
+}
+
 // static
 unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitPositions(
     vector<uint64_t> const & setBits)
@@ -460,6 +1113,18 @@ string DebugPrint(CompressedBitVector::StorageStrategy strat)
   {
   case CompressedBitVector::StorageStrategy::Dense: return "Dense";
   case CompressedBitVector::StorageStrategy::Sparse: return "Sparse";
+  case CompressedBitVector::StorageStrategy::Chunked: return "Chunked";
+  }
+  CHECK_SWITCH();
+}
+
+string DebugPrint(ChunkedCBV::Chunk::Type type)
+{
+  switch (type)
+  {
+  case ChunkedCBV::Chunk::Type::Array: return "Array";
+  case ChunkedCBV::Chunk::Type::Bitmap: return "Bitmap";
+  case ChunkedCBV::Chunk::Type::Runs: return "Runs";
   }
   CHECK_SWITCH();
 }
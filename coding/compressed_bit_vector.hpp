@@ -5,6 +5,7 @@
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/ref_counted.hpp"
 
 #include "std/algorithm.hpp"
@@ -20,7 +21,8 @@ public:
   enum class StorageStrategy
   {
     Dense,
-    Sparse
+    Sparse,
+    Chunked
   };
 
   virtual ~CompressedBitVector() = default;
@@ -68,7 +70,7 @@ public:
 
   // Writes the contents of a bit vector to writer.
   // The first byte is always the header that defines the format.
-  // Currently the header is 0 or 1 for Dense and Sparse strategies respectively.
+  // Currently the header is 0, 1 or 2 for Dense, Sparse and Chunked strategies respectively.
   // It is easier to dispatch via virtual method calls and not bother
   // with template TWriters here as we do in similar places in our code.
   // This should not pose too much a problem because commonly
@@ -99,6 +101,7 @@ public:
   static unique_ptr<DenseCBV> BuildFromBitGroups(vector<uint64_t> && bitGroups);
 
   size_t NumBitGroups() const { return m_bitGroups.size(); }
+  vector<uint64_t> const & GetBitGroups() const { return m_bitGroups; }
 
   template <typename TFn>
   void ForEach(TFn && f) const
@@ -167,6 +170,133 @@ private:
   vector<uint64_t> m_positions;
 };
 
+// Bit vector split into chunks of kChunkSize bits like Roaring bitmaps. Every non-empty chunk
+// stores its bits in the most compact of three ways: as a sorted array of offsets, as a bitmap
+// or as a list of runs of consecutive set bits. It suits clustered positions, like feature
+// indices of search index postings, which are too sparse for DenseCBV and too many for
+// SparseCBV.
+class ChunkedCBV : public CompressedBitVector
+{
+public:
+  static uint64_t const kChunkSize = 1 << 16;
+
+  struct Chunk
+  {
+    enum class Type : uint8_t
+    {
+      Array,
+      Bitmap,
+      Runs
+    };
+
+    static size_t const kNumBitGroups = kChunkSize / DenseCBV::kBlockSize;
+    // Chunks with more bits are stored as bitmaps unless runs are more compact.
+    static size_t const kMaxArraySize = 4096;
+
+    // Builds the most compact chunk from sorted offsets of set bits.
+    static Chunk FromOffsets(uint32_t key, vector<uint16_t> const & offsets);
+    // Builds the most compact chunk from kNumBitGroups bit groups.
+    static Chunk FromBitmap(uint32_t key, vector<uint64_t> && bitmap);
+
+    bool GetBit(uint16_t offset) const;
+    // Writes bits of the chunk to kNumBitGroups bit groups starting at |bitmap|.
+    void ToBitmap(uint64_t * bitmap) const;
+    void UpdatePopCount();
+
+    // Executes f for each set bit using its position in the whole bit vector as argument.
+    template <typename TFn>
+    void ForEach(TFn && f) const
+    {
+      uint64_t const begin = static_cast<uint64_t>(m_key) * kChunkSize;
+      switch (m_type)
+      {
+      case Type::Array:
+        for (uint16_t const offset : m_values)
+          f(begin + offset);
+        return;
+      case Type::Bitmap:
+        for (size_t i = 0; i < m_bitmap.size(); ++i)
+        {
+          for (uint64_t group = m_bitmap[i]; group != 0; group &= group - 1)
+            f(begin + DenseCBV::kBlockSize * i + bits::PopCount((group & (~group + 1)) - 1));
+        }
+        return;
+      case Type::Runs:
+        for (size_t i = 0; i < m_values.size(); i += 2)
+        {
+          for (uint64_t offset = m_values[i]; offset <= m_values[i + 1]; ++offset)
+            f(begin + offset);
+        }
+        return;
+      }
+    }
+
+    // Index of the chunk in the bit vector, i.e. bit position / kChunkSize.
+    uint32_t m_key = 0;
+    Type m_type = Type::Array;
+    uint32_t m_popCount = 0;
+    // Sorted offsets of set bits for Array, first and last offsets of every run for Runs.
+    vector<uint16_t> m_values;
+    // kNumBitGroups bit groups for Bitmap.
+    vector<uint64_t> m_bitmap;
+  };
+
+  ChunkedCBV() = default;
+
+  // Builds a chunked CBV from a sorted list of positions of set bits.
+  explicit ChunkedCBV(vector<uint64_t> const & setBits);
+
+  // |chunks| must be sorted by keys.
+  explicit ChunkedCBV(vector<Chunk> && chunks);
+
+  // Returns true if a sorted list of positions is at least twice more compact as
+  // a ChunkedCBV than as a SparseCBV.
+  static bool ChunkedEnough(vector<uint64_t> const & setBits);
+
+  template <typename TSource>
+  static unique_ptr<ChunkedCBV> DeserializeFromSource(TSource & src)
+  {
+    vector<Chunk> chunks(ReadPrimitiveFromSource<uint32_t>(src));
+    for (auto & chunk : chunks)
+    {
+      chunk.m_key = ReadPrimitiveFromSource<uint32_t>(src);
+      chunk.m_type = static_cast<Chunk::Type>(ReadPrimitiveFromSource<uint8_t>(src));
+      if (chunk.m_type == Chunk::Type::Bitmap)
+        rw::ReadVectorOfPOD(src, chunk.m_bitmap);
+      else
+        rw::ReadVectorOfPOD(src, chunk.m_values);
+      chunk.UpdatePopCount();
+    }
+    return make_unique<ChunkedCBV>(move(chunks));
+  }
+
+  vector<Chunk> const & GetChunks() const { return m_chunks; }
+
+  // Returns an estimate of the memory used by the bit vector.
+  size_t GetSizeBytes() const;
+
+  template <typename TFn>
+  void ForEach(TFn && f) const
+  {
+    for (auto const & chunk : m_chunks)
+      chunk.ForEach(f);
+  }
+
+  // CompressedBitVector overrides:
+  uint64_t PopCount() const override;
+  bool GetBit(uint64_t pos) const override;
+  unique_ptr<CompressedBitVector> LeaveFirstSetNBits(uint64_t n) const override;
+  StorageStrategy GetStorageStrategy() const override;
+  void Serialize(Writer & writer) const override;
+  unique_ptr<CompressedBitVector> Clone() const override;
+
+private:
+  vector<Chunk> m_chunks;
+  uint64_t m_popCount = 0;
+};
+
+string DebugPrint(ChunkedCBV::Chunk::Type type);
+
 class CompressedBitVectorBuilder
 {
 public:
@@ -211,6 +341,10 @@ public:
       rw::ReadVectorOfPOD(src, setBits);
       return make_unique<SparseCBV>(move(setBits));
     }
+    case CompressedBitVector::StorageStrategy::Chunked:
+    {
+      return ChunkedCBV::DeserializeFromSource(src);
+    }
     }
     return unique_ptr<CompressedBitVector>();
   }
@@ -240,6 +374,12 @@ public:
       sparseCBV.ForEach(f);
       return;
     }
+    case CompressedBitVector::StorageStrategy::Chunked:
+    {
+      ChunkedCBV const & chunkedCBV = static_cast<ChunkedCBV const &>(cbv);
+      chunkedCBV.ForEach(f);
+      return;
+    }
     }
   }
 };
@@ -1,6 +1,7 @@
 #include "coding/file_reader.hpp"
 
 #include "coding/reader_cache.hpp"
+#include "coding/shared_page_cache.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "base/logging.hpp"
@@ -48,6 +49,18 @@ public:
 #endif
   }
 
+  FileReaderData(string const & fileName, coding::SharedPageCache & sharedCache)
+    : m_fileData(fileName)
+    // The own cache isn't used, so it's as small as possible.
+    , m_readerCache(0 /* logPageSize */, 1 /* logPageCount */)
+    , m_sharedCache(&sharedCache)
+    , m_sharedFileId(sharedCache.GetFileId(fileName, m_fileData.Size()))
+  {
+#if LOG_FILE_READER_STATS
+    m_readCallCount = 0;
+#endif
+  }
+
   ~FileReaderData()
   {
 #if LOG_FILE_READER_STATS
@@ -66,12 +79,16 @@ public:
     }
 #endif
 
+    if (m_sharedCache != nullptr)
+      return m_sharedCache->Read(m_fileData, m_sharedFileId, pos, p, size);
     return m_readerCache.Read(m_fileData, pos, p, size);
   }
 
 private:
   FileDataWithCachedSize m_fileData;
   ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_readerCache;
+  coding::SharedPageCache * m_sharedCache = nullptr;
+  coding::SharedPageCache::FileId m_sharedFileId = 0;
 
 #if LOG_FILE_READER_STATS
   uint32_t m_readCallCount;
@@ -93,6 +110,21 @@ FileReader::FileReader(string const & fileName, uint32_t logPageSize, uint32_t l
 {
 }
 
+FileReader::FileReader(string const & fileName, coding::SharedPageCache & sharedCache)
+  : FileReader(fileName, make_shared<FileReaderData>(fileName, sharedCache))
+{
+}
+
+FileReader::FileReader(string const & fileName, shared_ptr<FileReaderData> fileData)
+  : ModelReader(fileName)
+  , m_logPageSize(kDefaultLogPageSize)
+  , m_logPageCount(kDefaultLogPageCount)
+  , m_fileData(move(fileData))
+  , m_offset(0)
+  , m_size(m_fileData->Size())
+{
+}
+
 FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size,
                        uint32_t logPageSize, uint32_t logPageCount)
   : ModelReader(reader.GetName())
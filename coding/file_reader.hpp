@@ -9,6 +9,11 @@
 #include <memory>
 #include <string>
 
+namespace coding
+{
+class SharedPageCache;
+}  // namespace coding
+
 // FileReader, cheap to copy, not thread safe.
 // It is assumed that file is not modified during FireReader lifetime,
 // because of caching and assumption that Size() is constant.
@@ -20,6 +25,9 @@ public:
 
   explicit FileReader(std::string const & fileName);
   FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount);
+  // Reads the file through |sharedCache| instead of an own page cache, so the pages are
+  // shared with all readers of the file which use the same cache.
+  FileReader(std::string const & fileName, coding::SharedPageCache & sharedCache);
 
   // Reader overrides:
   uint64_t Size() const override { return m_size; }
@@ -38,6 +46,7 @@ private:
 
   FileReader(FileReader const & reader, uint64_t offset, uint64_t size, uint32_t logPageSize,
              uint32_t logPageCount);
+  FileReader(std::string const & fileName, std::shared_ptr<FileReaderData> fileData);
 
   // Throws an exception if a (pos, size) read would result in an out-of-bounds access.
   void CheckPosAndSize(uint64_t pos, uint64_t size) const;
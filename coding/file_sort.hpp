@@ -5,9 +5,11 @@
 #include "base/logging.hpp"
 #include "base/exception.hpp"
 #include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
 #include "std/cstdlib.hpp"
+#include "std/deque.hpp"
 #include "std/functional.hpp"
-#include "std/queue.hpp"
+#include "std/future.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -24,6 +26,109 @@ struct Sorter
   }
 };
 
+// Merges sorted runs of a file with a loser tree: every item costs log2(runs) comparisons
+// along a single path of the tree. Runs are read by large sequential blocks.
+template <typename T, typename LessT>
+class RunsMerger
+{
+public:
+  // Run |i| takes items [runBegins[i], runBegins[i + 1]) of |reader|.
+  RunsMerger(FileReader const & reader, vector<uint64_t> const & runBegins, size_t bufferItems,
+             LessT fLess)
+    : m_reader(reader), m_less(fLess)
+  {
+    ASSERT_GREATER(runBegins.size(), 1, ());
+    size_t const runsCount = runBegins.size() - 1;
+    size_t const runBufferItems = max(bufferItems / runsCount, static_cast<size_t>(1));
+    m_runs.resize(runsCount);
+    for (size_t i = 0; i < runsCount; ++i)
+    {
+      m_runs[i].m_next = runBegins[i];
+      m_runs[i].m_end = runBegins[i + 1];
+      m_runs[i].m_buffer.reserve(runBufferItems);
+      Refill(m_runs[i], runBufferItems);
+    }
+
+    // Leaves of the tree are at [runsCount, 2 * runsCount), inner nodes keep losers.
+    m_losers.resize(runsCount);
+    vector<size_t> winners(2 * runsCount);
+    for (size_t i = 0; i < runsCount; ++i)
+      winners[runsCount + i] = i;
+    for (size_t n = runsCount - 1; n > 0; --n)
+    {
+      size_t const l = winners[2 * n];
+      size_t const r = winners[2 * n + 1];
+      bool const rightWins = IsLess(r, l);
+      winners[n] = rightWins ? r : l;
+      m_losers[n] = rightWins ? l : r;
+    }
+    m_winner = runsCount == 1 ? 0 : winners[1];
+  }
+
+  template <typename ToDo>
+  void ForEach(ToDo && toDo)
+  {
+    size_t const runsCount = m_runs.size();
+    while (!IsExhausted(m_winner))
+    {
+      Run & run = m_runs[m_winner];
+      toDo(run.m_buffer[run.m_pos++]);
+      if (run.m_pos == run.m_buffer.size())
+        Refill(run, run.m_buffer.capacity());
+
+      // Replays the path from the leaf of the winner to the root.
+      size_t s = m_winner;
+      for (size_t n = (s + runsCount) / 2; n > 0; n /= 2)
+      {
+        if (IsLess(m_losers[n], s))
+          swap(m_losers[n], s);
+      }
+      m_winner = s;
+    }
+  }
+
+private:
+  struct Run
+  {
+    vector<T> m_buffer;
+    size_t m_pos = 0;
+    uint64_t m_next = 0;
+    uint64_t m_end = 0;
+  };
+
+  void Refill(Run & run, size_t bufferItems)
+  {
+    size_t const count = static_cast<size_t>(min<uint64_t>(bufferItems, run.m_end - run.m_next));
+    run.m_buffer.resize(count);
+    run.m_pos = 0;
+    if (count != 0)
+      m_reader.Read(run.m_next * sizeof(T), &run.m_buffer[0], count * sizeof(T));
+    run.m_next += count;
+  }
+
+  bool IsExhausted(size_t i) const { return m_runs[i].m_pos == m_runs[i].m_buffer.size(); }
+
+  // Exhausted runs are greater than others, equal items are ordered by runs.
+  bool IsLess(size_t a, size_t b) const
+  {
+    if (IsExhausted(a) || IsExhausted(b))
+      return !IsExhausted(a) || (IsExhausted(b) && a < b);
+    T const & itemA = m_runs[a].m_buffer[m_runs[a].m_pos];
+    T const & itemB = m_runs[b].m_buffer[m_runs[b].m_pos];
+    if (m_less(itemA, itemB))
+      return true;
+    if (m_less(itemB, itemA))
+      return false;
+    return a < b;
+  }
+
+  FileReader const & m_reader;
+  LessT m_less;
+  vector<Run> m_runs;
+  vector<size_t> m_losers;
+  size_t m_winner = 0;
+};
+
 template <
     typename T,                                       // Item type.
     class OutputSinkT = FileWriter,                   // Sink to output into result file.
@@ -33,15 +138,19 @@ template <
 class FileSorter
 {
 public:
+  // With |threadsCount| > 1 up to |threadsCount| chunks of |bufferBytes| are sorted at once
+  // while the sorted ones are written, so the memory use is |threadsCount| * |bufferBytes|.
   FileSorter(size_t bufferBytes,
              string const & tmpFileName,
              OutputSinkT & outputSink,
-             LessT fLess = LessT()) :
+             LessT fLess = LessT(),
+             size_t threadsCount = 1) :
   m_TmpFileName(tmpFileName),
   m_BufferCapacity(max(size_t(16), bufferBytes / sizeof(T))),
   m_OutputSink(outputSink),
   m_ItemCount(0),
-  m_Less(fLess)
+  m_Less(fLess),
+  m_ThreadsCount(max(threadsCount, size_t(1)))
   {
     m_Buffer.reserve(m_BufferCapacity);
     m_pTmpWriter.reset(new FileWriter(tmpFileName));
@@ -59,28 +168,24 @@ public:
   {
     ASSERT(m_pTmpWriter.get(), ());
     FlushToTmpFile();
+    while (!m_SortedChunks.empty())
+      WriteOldestChunk();
 
     // Write output.
+    if (!m_ChunkBegins.empty())
     {
       m_pTmpWriter.reset();
-      FileReader reader(m_TmpFileName);
-      ItemIndexPairGreater fGreater(m_Less);
-      PriorityQueueType q(fGreater);
-      for (uint32_t i = 0; i < m_ItemCount; i += m_BufferCapacity)
-        Push(q, i, reader);
-
-      while (!q.empty())
-      {
-        m_OutputSink(q.top().first);
-        uint32_t const i = q.top().second + 1;
-        q.pop();
-        if (i % m_BufferCapacity != 0 && i < m_ItemCount)
-          Push(q, i, reader);
-      }
+      m_ChunkBegins.push_back(m_ItemCount);
+      // Runs are read by blocks of kLogReadPageSize.
+      FileReader reader(m_TmpFileName, kLogReadPageSize, 2 /* logPageCount */);
+      RunsMerger<T, LessT> merger(reader, m_ChunkBegins, m_BufferCapacity * m_ThreadsCount,
+                                  m_Less);
+      merger.ForEach([this](T const & item) { m_OutputSink(item); });
     }
+    m_pTmpWriter.reset();
+    m_ChunkBegins.clear();
     FileWriter::DeleteFileX(m_TmpFileName);
   }
-
   ~FileSorter()
   {
     if (m_pTmpWriter.get())
@@ -101,34 +206,51 @@ public:
   }
 
 private:
-  struct ItemIndexPairGreater
+  static uint32_t const kLogReadPageSize = 16;
+
+  void FlushToTmpFile()
   {
-    explicit ItemIndexPairGreater(LessT fLess) : m_Less(fLess) {}
-    inline bool operator() (pair<T, uint32_t> const & a, pair<T, uint32_t> const & b) const
+    if (m_Buffer.empty())
+      return;
+
+    m_ChunkBegins.push_back(m_ItemCount - m_Buffer.size());
+    if (m_ThreadsCount == 1)
     {
-      return m_Less(b.first, a.first);
+      SortChunk(m_Buffer);
+      WriteChunk(m_Buffer);
+      m_Buffer.clear();
+      return;
     }
-    LessT m_Less;
-  };
 
-  typedef priority_queue<pair<T, uint32_t>, vector<pair<T, uint32_t> >, ItemIndexPairGreater>
-      PriorityQueueType;
+    if (m_SortedChunks.size() == m_ThreadsCount)
+      WriteOldestChunk();
 
-  void FlushToTmpFile()
+    auto chunk = make_shared<vector<T>>();
+    chunk->swap(m_Buffer);
+    m_Buffer.reserve(m_BufferCapacity);
+    m_SortedChunks.push_back(async(launch::async, [this, chunk]() {
+      SortChunk(*chunk);
+      return chunk;
+    }));
+  }
+
+  void SortChunk(vector<T> & chunk) const
   {
-    if (m_Buffer.empty())
-      return;
     SorterT<LessT> sorter(m_Less);
-    sorter(m_Buffer.begin(), m_Buffer.end());
-    m_pTmpWriter->Write(&m_Buffer[0], m_Buffer.size() * sizeof(T));
-    m_Buffer.clear();
+    sorter(chunk.begin(), chunk.end());
+  }
+
+  void WriteChunk(vector<T> const & chunk)
+  {
+    m_pTmpWriter->Write(&chunk[0], chunk.size() * sizeof(T));
   }
 
-  void Push(PriorityQueueType & q, uint32_t i, FileReader const & reader)
+  // Chunks are written in the order of adding, the next ones are sorted meanwhile.
+  void WriteOldestChunk()
   {
-    T item;
-    reader.Read(static_cast<uint64_t>(i) * sizeof(T), &item, sizeof(T));
-    q.push(pair<T, uint32_t>(item, i));
+    auto chunk = m_SortedChunks.front().get();
+    m_SortedChunks.pop_front();
+    WriteChunk(*chunk);
   }
 
   string const m_TmpFileName;
@@ -136,6 +258,10 @@ private:
   OutputSinkT & m_OutputSink;
   unique_ptr<FileWriter> m_pTmpWriter;
   vector<T> m_Buffer;
-  uint32_t m_ItemCount;
+  uint64_t m_ItemCount;
   LessT m_Less;
+  size_t const m_ThreadsCount;
+  // First item of every chunk in the temporary file.
+  vector<uint64_t> m_ChunkBegins;
+  deque<future<shared_ptr<vector<T>>>> m_SortedChunks;
 };
@@ -1,12 +1,16 @@
 #include "coding/geometry_coding.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/point_to_integer.hpp"
 
 #include "geometry/mercator.hpp"
 
 #include "base/assert.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <limits>
+#include <type_traits>
 #include <stack>
 
 using namespace std;
@@ -26,6 +30,16 @@ inline m2::PointU ClampPoint(m2::PointU const & maxPoint, m2::Point<double> cons
       static_cast<uvalue_t>(base::clamp(point.y, 0.0, static_cast<double>(maxPoint.y))));
 }
 
+// Returns clamp(p1 + (p1 - p2) / 2, 0, maxCoord) rounded down.
+inline uint32_t PredictCoord(uint32_t maxCoord, uint32_t p1, uint32_t p2)
+{
+  int64_t const twice = 3 * static_cast<int64_t>(p1) - static_cast<int64_t>(p2);
+  if (twice < 0)
+    return 0;
+  return static_cast<uint32_t>(min(static_cast<uint64_t>(twice) >> 1,
+                                   static_cast<uint64_t>(maxCoord)));
+}
+
 struct edge_less_p0
 {
   using edge_t = tesselator::Edge;
@@ -62,9 +76,10 @@ bool TestDecoding(InPointsT const & points, m2::PointU const & basePoint,
 m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint, m2::PointU const & p1,
                                   m2::PointU const & p2)
 {
-  // return ClampPoint(maxPoint, m2::PointI64(p1) + m2::PointI64(p1) - m2::PointI64(p2));
-  // return ClampPoint(maxPoint, m2::PointI64(p1) + (m2::PointI64(p1) - m2::PointI64(p2)) / 2);
-  return ClampPoint(maxPoint, m2::PointD(p1) + (m2::PointD(p1) - m2::PointD(p2)) / 2.0);
+  // Integer form of ClampPoint(maxPoint, PointD(p1) + (PointD(p1) - PointD(p2)) / 2.0), the
+  // decoder calls it for every point. The results are the same: the sum is exact in doubles
+  // and the clamped value is truncated, i.e. floored.
+  return m2::PointU(PredictCoord(maxPoint.x, p1.x, p2.x), PredictCoord(maxPoint.y, p1.y, p2.y));
 }
 
 uint64_t EncodePointDeltaAsUint(m2::PointU const & actual, m2::PointU const & prediction)
@@ -108,8 +123,9 @@ m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint, m2::PointU const
 m2::PointU PredictPointInTriangle(m2::PointU const & maxPoint, m2::PointU const & p1,
                                   m2::PointU const & p2, m2::PointU const & p3)
 {
-  // parallelogram prediction
-  return ClampPoint(maxPoint, m2::PointD(p1 + p2 - p3));
+  // parallelogram prediction, the sum wraps around as PointU arithmetic does
+  m2::PointU const p = p1 + p2 - p3;
+  return m2::PointU(min(p.x, maxPoint.x), min(p.y, maxPoint.y));
 }
 
 void EncodePolylinePrev1(InPointsT const & points, m2::PointU const & basePoint,
@@ -381,6 +397,95 @@ void const * LoadInner(DecodeFunT fn, void const * pBeg, size_t count,
   return ret;
 }
 
+void EncodeFixedWidth(vector<m2::PointU> const & points, m2::PointU const & basePoint,
+                      vector<char> & buffer)
+{
+  MemWriter<vector<char>> writer(buffer);
+  WriteVarUint(writer, static_cast<uint32_t>(points.size()));
+
+  vector<uint32_t> coords;
+  coords.reserve(2 * kFixedWidthBlockSize);
+  m2::PointU prev = basePoint;
+  for (size_t i = 0; i < points.size(); i += kFixedWidthBlockSize)
+  {
+    size_t const end = min(points.size(), i + kFixedWidthBlockSize);
+    coords.clear();
+    uint32_t maxCoord = 0;
+    for (size_t j = i; j < end; ++j)
+    {
+      coords.push_back(bits::ZigZagEncode(static_cast<int32_t>(points[j].x - prev.x)));
+      coords.push_back(bits::ZigZagEncode(static_cast<int32_t>(points[j].y - prev.y)));
+      maxCoord = max(maxCoord, max(coords[coords.size() - 2], coords.back()));
+      prev = points[j];
+    }
+
+    uint8_t width = 4;
+    if (maxCoord == 0)
+      width = 0;
+    else if (maxCoord <= numeric_limits<uint8_t>::max())
+      width = 1;
+    else if (maxCoord <= numeric_limits<uint16_t>::max())
+      width = 2;
+
+    writer.Write(&width, sizeof(width));
+    for (auto c : coords)
+    {
+      for (uint8_t k = 0; k < width; ++k)
+      {
+        auto const byte = static_cast<uint8_t>(c >> (8 * k));
+        writer.Write(&byte, sizeof(byte));
+      }
+    }
+  }
+}
+
+void DecodeFixedWidth(char const * beg, char const * end, m2::PointU const & basePoint,
+                      pts::PointsU & points)
+{
+  ArrayByteSource src(beg);
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+
+  auto const * p = static_cast<uint8_t const *>(src.Ptr());
+  size_t const start = points.size();
+  points.resize(start + count);
+  m2::PointU * out = points.data() + start;
+  m2::PointU prev = basePoint;
+
+  // Reads |n| points of a block with |width| bytes coordinates.
+  auto const decodeBlock = [&](auto width, size_t n) {
+    size_t constexpr kWidth = decltype(width)::value;
+    for (size_t i = 0; i < n; ++i)
+    {
+      uint32_t x = 0;
+      uint32_t y = 0;
+      for (size_t k = 0; k < kWidth; ++k)
+      {
+        x |= static_cast<uint32_t>(p[k]) << (8 * k);
+        y |= static_cast<uint32_t>(p[kWidth + k]) << (8 * k);
+      }
+      p += 2 * kWidth;
+      prev = m2::PointU(prev.x + bits::ZigZagDecode(x), prev.y + bits::ZigZagDecode(y));
+      out[i] = prev;
+    }
+  };
+
+  for (uint32_t i = 0; i < count; i += kFixedWidthBlockSize)
+  {
+    size_t const n = min(static_cast<size_t>(count - i), kFixedWidthBlockSize);
+    uint8_t const width = *p++;
+    CHECK_LESS_OR_EQUAL(reinterpret_cast<char const *>(p) + 2 * n * width, end, (count, width));
+    switch (width)
+    {
+    case 0: fill(out, out + n, prev); break;
+    case 1: decodeBlock(integral_constant<size_t, 1>(), n); break;
+    case 2: decodeBlock(integral_constant<size_t, 2>(), n); break;
+    case 4: decodeBlock(integral_constant<size_t, 4>(), n); break;
+    default: CHECK(false, ("Bad fixed width geometry block", width));
+    }
+    out += n;
+  }
+}
+
 TrianglesChainSaver::TrianglesChainSaver(GeometryCodingParams const & params)
 {
   m_base = pts::GetBasePoint(params);
@@ -186,8 +186,9 @@ void DecodeImpl(TDecodeFun fn, DeltasT const & deltas, GeometryCodingParams cons
     points.reserve(count);
   }
 
-  std::transform(upoints.begin(), upoints.begin() + adapt.size(), std::back_inserter(points),
-                 std::bind(&pts::U2D, std::placeholders::_1, params.GetCoordBits()));
+  uint32_t const coordBits = params.GetCoordBits();
+  for (size_t i = 0; i < adapt.size(); ++i)
+    points.push_back(pts::U2D(upoints[i], coordBits));
 }
 
 template <class TSink>
@@ -245,8 +246,9 @@ void LoadOuter(DecodeFunT fn, TSource & src, GeometryCodingParams const & params
                size_t reserveF = 1)
 {
   uint32_t const count = ReadVarUint<uint32_t>(src);
-  std::vector<char> buffer(count);
-  char * p = &buffer[0];
+  // Most of the outer geometry chunks are short, keep them off the heap.
+  buffer_vector<char, 256> buffer(count);
+  char * p = buffer.data();
   src.Read(p, count);
 
   DeltasT deltas;
@@ -321,6 +323,99 @@ void LoadOuterTriangles(TSource & src, GeometryCodingParams const & params, OutP
     LoadOuter(&DecodeTriangles, src, params, triangles, 3);
 }
 
+/// @name Fixed width layout.
+/// It's larger than the varint layout but is decoded without a branch on every byte. Points are
+/// deltas from the previous point, the first one is a delta from the base point. Zigzag encoded
+/// deltas are grouped in blocks of kFixedWidthBlockSize points, coordinates of a block have the
+/// same byte width (0, 1, 2 or 4) which is written before the block. The chunk starts with
+/// its byte size and the number of points.
+size_t constexpr kFixedWidthBlockSize = 16;
+
+void EncodeFixedWidth(std::vector<m2::PointU> const & points, m2::PointU const & basePoint,
+                      std::vector<char> & buffer);
+/// Appends the decoded points to |points|.
+void DecodeFixedWidth(char const * beg, char const * end, m2::PointU const & basePoint,
+                      pts::PointsU & points);
+
+template <class TSink>
+void SaveOuterFixedWidth(std::vector<m2::PointD> const & points,
+                         GeometryCodingParams const & params, TSink & sink)
+{
+  std::vector<m2::PointU> upoints;
+  upoints.reserve(points.size());
+  for (auto const & p : points)
+    upoints.push_back(pts::D2U(p, params.GetCoordBits()));
+
+  std::vector<char> buffer;
+  EncodeFixedWidth(upoints, pts::GetBasePoint(params), buffer);
+  WriteBufferToSink(buffer, sink);
+}
+
+template <class TSource, class TPoints>
+void LoadOuterFixedWidth(TSource & src, GeometryCodingParams const & params, TPoints & points)
+{
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  buffer_vector<char, 256> buffer(count);
+  src.Read(buffer.data(), count);
+
+  pts::PointsU upoints;
+  DecodeFixedWidth(buffer.data(), buffer.data() + count, pts::GetBasePoint(params), upoints);
+
+  uint32_t const coordBits = params.GetCoordBits();
+  points.reserve(points.size() + upoints.size());
+  for (auto const & p : upoints)
+    points.push_back(pts::U2D(p, coordBits));
+}
+
+/// Triangles are stored as a list of 3 * n vertices.
+template <class TSink>
+void SaveOuterTrianglesFixedWidth(std::vector<m2::PointD> const & triangles,
+                                  GeometryCodingParams const & params, TSink & sink)
+{
+  ASSERT_EQUAL(triangles.size() % 3, 0, ());
+  SaveOuterFixedWidth(triangles, params, sink);
+}
+
+template <class TSource>
+void LoadOuterTrianglesFixedWidth(TSource & src, GeometryCodingParams const & params,
+                                  OutPointsT & triangles)
+{
+  LoadOuterFixedWidth(src, params, triangles);
+  ASSERT_EQUAL(triangles.size() % 3, 0, ());
+}
+
+/// @name Progressive layout.
+/// A coarser path is a subsequence of the best path of the feature and is saved as indexes of
+/// its points in the best path. The first point is shared by all the paths, so it isn't saved.
+/// The chunk is the number of indexes and varint gaps between the consecutive indexes.
+template <class TSink>
+void SaveOuterPathIndexes(std::vector<uint32_t> const & indexes, TSink & sink)
+{
+  WriteVarUint(sink, static_cast<uint32_t>(indexes.size()));
+  uint32_t prev = 0;
+  for (auto const index : indexes)
+  {
+    ASSERT_GREATER(index, prev, ());
+    WriteVarUint(sink, index - prev - 1);
+    prev = index;
+  }
+}
+
+/// Appends the points of |best| with the loaded indexes to |points|.
+template <class TSource, class TBestPoints, class TPoints>
+void LoadOuterPathByIndexes(TSource & src, TBestPoints const & best, TPoints & points)
+{
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  points.reserve(points.size() + count);
+  uint32_t index = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    index += ReadVarUint<uint32_t>(src) + 1;
+    CHECK_LESS(index, best.size(), ());
+    points.push_back(best[index]);
+  }
+}
+
 class TrianglesChainSaver
 {
   using TPoint = m2::PointU;
@@ -42,12 +42,70 @@ void HuffmanCoder::BuildTables(Node * root, uint32_t path)
   BuildTables(root->r, path + (static_cast<uint32_t>(1) << root->depth));
 }
 
+void HuffmanCoder::BuildDecodingTable()
+{
+  m_decodingTable.clear();
+  m_tableBits = 0;
+  if (!m_root || m_root->isLeaf)
+    return;
+
+  size_t maxLen = 0;
+  for (auto const & kv : m_decoderTable)
+    maxLen = std::max(maxLen, kv.first.len);
+  m_tableBits = static_cast<uint32_t>(std::min(maxLen, static_cast<size_t>(kMaxTableBits)));
+
+  size_t const size = static_cast<size_t>(1) << m_tableBits;
+  m_decodingTable.resize(size);
+  for (size_t index = 0; index < size; ++index)
+  {
+    Node const * cur = m_root;
+    uint32_t len = 0;
+    while (cur && !cur->isLeaf && len < m_tableBits)
+    {
+      cur = ((index >> len) & 1) == 0 ? cur->l : cur->r;
+      ++len;
+    }
+
+    auto & entry = m_decodingTable[index];
+    if (cur && cur->isLeaf)
+    {
+      entry.m_symbols[0] = cur->symbol;
+      entry.m_ends[0] = static_cast<uint8_t>(len);
+      entry.m_count = 1;
+    }
+    else
+    {
+      entry.m_node = cur;
+    }
+  }
+
+  // Appends symbols of the codes which follow the first one. The rest of an index is
+  // an index too, its entry is valid while the first code fits into the rest.
+  auto const singles = m_decodingTable;
+  for (size_t index = 0; index < size; ++index)
+  {
+    auto & entry = m_decodingTable[index];
+    while (entry.m_count != 0 && entry.m_count < DecodingTableEntry::kMaxSymbols)
+    {
+      uint32_t const used = entry.m_ends[entry.m_count - 1];
+      auto const & next = singles[index >> used];
+      if (next.m_count == 0 || next.m_ends[0] > m_tableBits - used)
+        break;
+      entry.m_symbols[entry.m_count] = next.m_symbols[0];
+      entry.m_ends[entry.m_count] = static_cast<uint8_t>(used + next.m_ends[0]);
+      ++entry.m_count;
+    }
+  }
+}
+
 void HuffmanCoder::Clear()
 {
   DeleteHuffmanTree(m_root);
   m_root = nullptr;
   m_encoderTable.clear();
   m_decoderTable.clear();
+  m_decodingTable.clear();
+  m_tableBits = 0;
 }
 
 void HuffmanCoder::DeleteHuffmanTree(Node * root)
@@ -8,6 +8,8 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <array>
+#include <climits>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -101,6 +103,7 @@ public:
     Clear();
     BuildHuffmanTree(Freqs(args...));
     BuildTables(m_root, 0);
+    BuildDecodingTable();
   }
 
   void Clear();
@@ -162,6 +165,8 @@ public:
       cur->isLeaf = true;
       cur->symbol = symbol;
     }
+
+    BuildDecodingTable();
   }
 
   bool Encode(uint32_t symbol, Code & code) const;
@@ -195,14 +200,76 @@ public:
     return EncodeAndWrite(writer, s.begin(), s.end());
   }
 
+  // Decodes symbols with the table of the next m_tableBits bits of the stream, several short
+  // codes are decoded by a single lookup. Bytes are read from |src| only when the current
+  // code needs them, so nothing is read beyond the encoded string.
   template <typename TSource, typename OutIt>
   OutIt ReadAndDecode(TSource & src, OutIt out) const
   {
-    BitReader<TSource> bitReader(src);
     size_t sz = static_cast<size_t>(ReadVarUint<uint32_t, TSource>(src));
-    std::vector<strings::UniChar> v(sz);
-    for (size_t i = 0; i < sz; ++i)
-      *out++ = ReadAndDecode(bitReader);
+    if (sz == 0)
+      return out;
+
+    CHECK(m_root, ("Could not decode a Huffman-encoded symbol."));
+    if (m_root->isLeaf)
+    {
+      for (size_t i = 0; i < sz; ++i)
+        *out++ = m_root->symbol;
+      return out;
+    }
+
+    // Bits of |buffer| above |numBits| are zeros.
+    uint64_t buffer = 0;
+    uint32_t numBits = 0;
+    uint64_t const mask = (static_cast<uint64_t>(1) << m_tableBits) - 1;
+    auto const readByte = [&]() {
+      uint8_t b;
+      src.Read(&b, 1);
+      buffer |= static_cast<uint64_t>(b) << numBits;
+      numBits += CHAR_BIT;
+    };
+
+    while (sz != 0)
+    {
+      auto const & entry = m_decodingTable[static_cast<size_t>(buffer & mask)];
+      if (entry.m_count != 0 && entry.m_ends[0] <= numBits)
+      {
+        size_t i = 0;
+        do
+        {
+          *out++ = entry.m_symbols[i];
+          ++i;
+          --sz;
+        } while (i < entry.m_count && sz != 0 && entry.m_ends[i] <= numBits);
+
+        buffer >>= entry.m_ends[i - 1];
+        numBits -= entry.m_ends[i - 1];
+        continue;
+      }
+
+      if (entry.m_count == 0 && numBits >= m_tableBits)
+      {
+        // A code which is longer than the table.
+        CHECK(entry.m_node, ("Could not decode a Huffman-encoded symbol."));
+        Node const * cur = entry.m_node;
+        uint32_t len = m_tableBits;
+        while (!cur->isLeaf)
+        {
+          if (len == numBits)
+            readByte();
+          cur = ((buffer >> len) & 1) == 0 ? cur->l : cur->r;
+          CHECK(cur, ("Could not decode a Huffman-encoded symbol."));
+          ++len;
+        }
+        *out++ = cur->symbol;
+        --sz;
+        buffer >>= len;
+        numBits -= len;
+        continue;
+      }
+
+      readByte();
+    }
     return out;
   }
 
@@ -271,28 +338,28 @@ private:
     return sz;
   }
 
-  template <typename TSource>
-  uint32_t ReadAndDecode(BitReader<TSource> & bitReader) const
+  // Symbols of codes which are the prefix of a table index.
+  struct DecodingTableEntry
   {
-    Node * cur = m_root;
-    while (cur)
-    {
-      if (cur->isLeaf)
-        return cur->symbol;
-      uint8_t bit = bitReader.Read(1);
-      if (bit == 0)
-        cur = cur->l;
-      else
-        cur = cur->r;
-    }
-    CHECK(false, ("Could not decode a Huffman-encoded symbol."));
-    return 0;
-  }
+    static size_t constexpr kMaxSymbols = 4;
+
+    std::array<uint32_t, kMaxSymbols> m_symbols = {};
+    // m_ends[i] is the total length of codes of symbols [0, i].
+    std::array<uint8_t, kMaxSymbols> m_ends = {};
+    uint8_t m_count = 0;
+    // When the index is a prefix of a longer code, the node of the index path.
+    Node const * m_node = nullptr;
+  };
+
+  static uint32_t const kMaxTableBits = 11;
 
   // Converts a Huffman tree into the more convenient representation
   // of encoding and decoding tables.
   void BuildTables(Node * root, uint32_t path);
 
+  // Builds m_decodingTable from the tree.
+  void BuildDecodingTable();
+
   void DeleteHuffmanTree(Node * root);
 
   void BuildHuffmanTree(Freqs const & freqs);
@@ -304,5 +371,8 @@ private:
   Node * m_root;
   std::map<Code, uint32_t> m_decoderTable;
   std::map<uint32_t, Code> m_encoderTable;
+
+  std::vector<DecodingTableEntry> m_decodingTable;
+  uint32_t m_tableBits = 0;
 };
 }  // namespace coding
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "coding/file_container.hpp"
+#include "coding/reader.hpp"
 
 #include "base/macros.hpp"
 
 #include "std/cstdint.hpp"
+#include "std/unique_ptr.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -48,3 +50,40 @@ private:
 
   DISALLOW_COPY(CopiedMemoryRegion);
 };
+
+// Region of the data of a contiguous reader, e.g. of a section of a mapped mwm, which is used
+// in place. Holds the reader, so the mapped data lives as long as the region.
+class ReaderMemoryRegion : public MemoryRegion
+{
+public:
+  explicit ReaderMemoryRegion(unique_ptr<Reader> && reader)
+    : m_reader(move(reader)), m_data(m_reader->GetContiguousData())
+  {
+    ASSERT(m_data, ());
+  }
+
+  // MemoryRegion overrides:
+  uint64_t Size() const override { return m_reader->Size(); }
+  uint8_t const * ImmutableData() const override { return m_data; }
+
+private:
+  unique_ptr<Reader> m_reader;
+  uint8_t const * m_data;
+
+  DISALLOW_COPY(ReaderMemoryRegion);
+};
+
+// Returns the region of [pos, pos + size) of |reader|. The data is used in place when
+// |reader| is contiguous and the data is 8-byte aligned as coding::Map() requires,
+// otherwise it is copied.
+inline unique_ptr<MemoryRegion> CreateMemoryRegion(Reader const & reader, uint64_t pos,
+                                                   uint64_t size)
+{
+  uint8_t const * data = reader.GetContiguousData();
+  if (data != nullptr && reinterpret_cast<uintptr_t>(data + pos) % 8 == 0)
+    return make_unique<ReaderMemoryRegion>(reader.CreateSubReader(pos, size));
+
+  vector<uint8_t> buffer(size);
+  reader.Read(pos, buffer.data(), buffer.size());
+  return make_unique<CopiedMemoryRegion>(move(buffer));
+}
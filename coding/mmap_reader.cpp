@@ -86,6 +86,11 @@ unique_ptr<Reader> MmapReader::CreateSubReader(uint64_t pos, uint64_t size) cons
   return unique_ptr<Reader>(new MmapReader(*this, m_offset + pos, size));
 }
 
+uint8_t const * MmapReader::GetContiguousData() const
+{
+  return m_data->m_memory + m_offset;
+}
+
 uint8_t * MmapReader::Data() const
 {
   return m_data->m_memory;
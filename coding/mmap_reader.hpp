@@ -22,6 +22,7 @@ public:
   uint64_t Size() const override;
   void Read(uint64_t pos, void * p, size_t size) const override;
   unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
+  uint8_t const * GetContiguousData() const override;
 
   /// Direct file/memory access
   uint8_t * Data() const;
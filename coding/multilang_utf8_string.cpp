@@ -176,10 +176,14 @@ void StringUtf8Multilang::AddString(int8_t lang, string const & utf8s)
 
   m_s.push_back(lang | 0x80);
   m_s.insert(m_s.end(), utf8s.begin(), utf8s.end());
+  m_langs |= static_cast<uint64_t>(1) << lang;
 }
 
 bool StringUtf8Multilang::GetString(int8_t lang, string & utf8s) const
 {
+  if (!HasString(lang))
+    return false;
+
   size_t i = 0;
   size_t const sz = m_s.size();
 
@@ -200,15 +204,31 @@ bool StringUtf8Multilang::GetString(int8_t lang, string & utf8s) const
   return false;
 }
 
-bool StringUtf8Multilang::HasString(int8_t lang) const
+int8_t StringUtf8Multilang::GetBestString(vector<int8_t> const & langs, string & utf8s) const
 {
-  for(size_t i = 0; i < m_s.size(); i = GetNextIndex(i))
+  size_t best = langs.size();
+  for (size_t i = 0; i < langs.size(); ++i)
   {
-    if ((m_s[i] & 0x3F) == lang)
-      return true;
+    if (HasString(langs[i]))
+    {
+      best = i;
+      break;
+    }
   }
-  
-  return false;
+  if (best == langs.size())
+    return kUnsupportedLanguageCode;
+
+  // The string of the best language is present, so the pass ends on it.
+  int8_t const lang = langs[best];
+  CHECK(GetString(lang, utf8s), (lang));
+  return lang;
+}
+
+void StringUtf8Multilang::UpdateLangs()
+{
+  m_langs = 0;
+  for (size_t i = 0; i < m_s.size(); i = GetNextIndex(i))
+    m_langs |= static_cast<uint64_t>(1) << (m_s[i] & 0x3F);
 }
 
 int8_t StringUtf8Multilang::FindString(string const & utf8s) const
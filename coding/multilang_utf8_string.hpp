@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace utils
 {
@@ -79,7 +80,11 @@ public:
   inline bool operator==(StringUtf8Multilang const & rhs) const { return m_s == rhs.m_s; }
   inline bool operator!=(StringUtf8Multilang const & rhs) const { return !(*this == rhs); }
 
-  inline void Clear() { m_s.clear(); }
+  inline void Clear()
+  {
+    m_s.clear();
+    m_langs = 0;
+  }
   inline bool IsEmpty() const { return m_s.empty(); }
 
   void AddString(int8_t lang, string const & utf8s);
@@ -116,7 +121,15 @@ public:
       return false;
   }
 
-  bool HasString(int8_t lang) const;
+  // Returns the language of the first of |langs| which has a string in this multilang string
+  // and sets |utf8s| to the string. Returns kUnsupportedLanguageCode when there is no string
+  // of |langs|. Makes a single pass for all |langs|.
+  int8_t GetBestString(std::vector<int8_t> const & langs, std::string & utf8s) const;
+
+  bool HasString(int8_t lang) const
+  {
+    return lang >= 0 && lang < kMaxSupportedLanguages && ((m_langs >> lang) & 1) != 0;
+  }
 
   int8_t FindString(string const & utf8s) const;
 
@@ -130,12 +143,16 @@ public:
   void Read(TSource & src)
   {
     utils::ReadString(src, m_s);
+    UpdateLangs();
   }
 
 private:
   size_t GetNextIndex(size_t i) const;
+  void UpdateLangs();
 
   std::string m_s;
+  // Bit mask of languages of strings, makes lookups of missing languages O(1).
+  uint64_t m_langs = 0;
 };
 
 std::string DebugPrint(StringUtf8Multilang const & s);
@@ -26,6 +26,10 @@ public:
   virtual void Read(uint64_t pos, void * p, size_t size) const = 0;
   virtual unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const = 0;
 
+  // Returns the Size() bytes of the reader if they are contiguous in memory (e.g. mmapped),
+  // nullptr otherwise. Hot decoding paths read such data in place, without Read() calls.
+  virtual uint8_t const * GetContiguousData() const { return nullptr; }
+
   void ReadAsString(string & s) const;
 
   static bool IsEqual(string const & name1, string const & name2);
@@ -65,6 +69,11 @@ public:
     return make_unique<MemReaderTemplate>(m_pData + pos, static_cast<size_t>(size));
   }
 
+  inline uint8_t const * GetContiguousData() const override
+  {
+    return reinterpret_cast<uint8_t const *>(m_pData);
+  }
+
 private:
   bool GoodPosAndSize(uint64_t pos, uint64_t size) const
   {
@@ -122,6 +131,8 @@ public:
     m_p->ReadAsString(s);
   }
 
+  uint8_t const * GetContiguousData() const { return m_p->GetContiguousData(); }
+
   ReaderPtr<Reader> SubReader(uint64_t pos, uint64_t size) const
   {
     return {m_p->CreateSubReader(pos, size)};
@@ -11,35 +11,70 @@
 #include "3party/liboauthcpp/src/base64.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace coding
 {
+SHA1::Calculator::Calculator() : m_sha1(std::make_unique<CSHA1>()) {}
+
+SHA1::Calculator::~Calculator() = default;
+
+void SHA1::Calculator::Update(void const * data, size_t size)
+{
+  auto bytes = static_cast<unsigned char *>(const_cast<void *>(data));
+  while (size != 0)
+  {
+    auto const toUpdate =
+        static_cast<uint32_t>(std::min<size_t>(size, std::numeric_limits<uint32_t>::max()));
+    m_sha1->Update(bytes, toUpdate);
+    bytes += toUpdate;
+    size -= toUpdate;
+  }
+}
+
+SHA1::Hash SHA1::Calculator::Finish()
+{
+  m_sha1->Final();
+
+  Hash result;
+  ASSERT_EQUAL(result.size(), ARRAY_SIZE(m_sha1->m_digest), ());
+  std::copy(std::begin(m_sha1->m_digest), std::end(m_sha1->m_digest), std::begin(result));
+  return result;
+}
+
 // static
 SHA1::Hash SHA1::Calculate(std::string const & filePath)
+{
+  uint64_t fileSize = 0;
+  if (!base::GetFileSize(filePath, fileSize))
+  {
+    LOG(LERROR, ("Error reading file:", filePath));
+    return {};
+  }
+  return Calculate(filePath, 0 /* offset */, fileSize);
+}
+
+// static
+SHA1::Hash SHA1::Calculate(std::string const & filePath, uint64_t offset, uint64_t size)
 {
   uint32_t constexpr kFileBufferSize = 8192;
   try
   {
     base::FileData file(filePath, base::FileData::OP_READ);
-    uint64_t const fileSize = file.Size();
 
-    CSHA1 sha1;
+    Calculator calculator;
     uint64_t currSize = 0;
     unsigned char buffer[kFileBufferSize];
-    while (currSize < fileSize)
+    while (currSize < size)
     {
-      auto const toRead = std::min(kFileBufferSize, static_cast<uint32_t>(fileSize - currSize));
-      file.Read(currSize, buffer, toRead);
-      sha1.Update(buffer, toRead);
+      auto const toRead =
+          static_cast<uint32_t>(std::min<uint64_t>(kFileBufferSize, size - currSize));
+      file.Read(offset + currSize, buffer, toRead);
+      calculator.Update(buffer, toRead);
       currSize += toRead;
     }
-    sha1.Final();
-
-    Hash result;
-    ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
-    std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
-    return result;
+    return calculator.Finish();
   }
   catch (Reader::Exception const & ex)
   {
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+class CSHA1;
+
 namespace coding
 {
 class SHA1
@@ -11,7 +15,23 @@ public:
   static size_t constexpr kHashSizeInBytes = 20;
   using Hash = std::array<uint8_t, kHashSizeInBytes>;
 
+  // Calculates hash of the data which is passed by parts, e.g. while the data is copied.
+  class Calculator
+  {
+  public:
+    Calculator();
+    ~Calculator();
+
+    void Update(void const * data, size_t size);
+    Hash Finish();
+
+  private:
+    std::unique_ptr<CSHA1> m_sha1;
+  };
+
   static Hash Calculate(std::string const & filePath);
+  // Hash of |size| bytes of the file starting at |offset|.
+  static Hash Calculate(std::string const & filePath, uint64_t offset, uint64_t size);
   static std::string CalculateBase64(std::string const & filePath);
 
   static Hash CalculateForString(std::string const & str);
@@ -0,0 +1,133 @@
+#include "coding/shared_page_cache.hpp"
+
+using namespace std;
+
+namespace coding
+{
+// static
+uint32_t const SharedPageCache::kDefaultLogPageSize = 12;
+// static
+size_t const SharedPageCache::kDefaultMaxBytes = 32 * 1024 * 1024;
+// static
+size_t const SharedPageCache::kShardsCount;
+
+SharedPageCache::SharedPageCache(uint32_t logPageSize, size_t maxBytes)
+  : m_logPageSize(logPageSize), m_shardMaxBytes(maxBytes / kShardsCount)
+{
+}
+
+// static
+SharedPageCache & SharedPageCache::Instance()
+{
+  static SharedPageCache cache(kDefaultLogPageSize, kDefaultMaxBytes);
+  return cache;
+}
+
+SharedPageCache::FileId SharedPageCache::GetFileId(string const & fileName, uint64_t fileSize)
+{
+  lock_guard<mutex> lock(m_filesMutex);
+  auto it = m_files.find(fileName);
+  if (it == m_files.end())
+    it = m_files.emplace(fileName, make_pair(fileSize, m_nextFileId++)).first;
+  else if (it->second.first != fileSize)
+    it->second = make_pair(fileSize, m_nextFileId++);
+  return it->second.second;
+}
+
+void SharedPageCache::SetMaxBytes(size_t maxBytes)
+{
+  m_shardMaxBytes = maxBytes / kShardsCount;
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    Shrink(shard);
+  }
+}
+
+SharedPageCache::Stats SharedPageCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    stats.m_bytes += shard.m_bytes;
+  }
+  return stats;
+}
+
+void SharedPageCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    for (auto it = shard.m_entries.begin(); it != shard.m_entries.end();)
+    {
+      if (it->second.m_page.use_count() > 1)
+      {
+        ++it;
+        continue;
+      }
+      shard.m_bytes -= it->second.m_page->size();
+      shard.m_lru.erase(it->second.m_lruIt);
+      it = shard.m_entries.erase(it);
+    }
+  }
+  m_hits = 0;
+  m_misses = 0;
+  m_evictions = 0;
+}
+
+SharedPageCache::Page SharedPageCache::Find(Key const & key)
+{
+  auto & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_mutex);
+  auto const it = shard.m_entries.find(key);
+  if (it == shard.m_entries.end())
+  {
+    ++m_misses;
+    return {};
+  }
+
+  ++m_hits;
+  shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second.m_lruIt);
+  return it->second.m_page;
+}
+
+SharedPageCache::Page SharedPageCache::Insert(Key const & key, Page page)
+{
+  auto & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_mutex);
+  auto const it = shard.m_entries.find(key);
+  if (it != shard.m_entries.end())
+    return it->second.m_page;
+
+  shard.m_lru.push_front(key);
+  shard.m_bytes += page->size();
+  shard.m_entries.emplace(key, Shard::Entry{page, shard.m_lru.begin()});
+  Shrink(shard);
+  return page;
+}
+
+void SharedPageCache::Shrink(Shard & shard)
+{
+  size_t const maxBytes = m_shardMaxBytes;
+  auto it = shard.m_lru.end();
+  while (shard.m_bytes > maxBytes && it != shard.m_lru.begin())
+  {
+    --it;
+    auto const entryIt = shard.m_entries.find(*it);
+    ASSERT(entryIt != shard.m_entries.end(), ());
+    // Pinned pages are kept.
+    if (entryIt->second.m_page.use_count() > 1)
+      continue;
+
+    shard.m_bytes -= entryIt->second.m_page->size();
+    shard.m_entries.erase(entryIt);
+    it = shard.m_lru.erase(it);
+    ++m_evictions;
+  }
+}
+}  // namespace coding
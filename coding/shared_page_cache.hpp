@@ -0,0 +1,151 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace coding
+{
+// Process-wide cache of file pages, shared by readers of all threads.
+// Unlike ReaderCache, which is owned by a single reader, pages of a file are cached once for all
+// readers of the file which opted in by its FileId.
+//
+// Pages are kept in kShardsCount shards with own mutex and LRU list each, the memory budget
+// is split between shards evenly. A page is pinned while somebody holds the Page returned
+// by GetPage(): such pages aren't evicted, so the budget may be exceeded by pinned pages.
+class SharedPageCache
+{
+public:
+  using FileId = uint32_t;
+  using Page = std::shared_ptr<std::vector<char> const>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_bytes = 0;
+  };
+
+  static uint32_t const kDefaultLogPageSize;
+  static size_t const kDefaultMaxBytes;
+  static size_t const kShardsCount = 16;
+
+  SharedPageCache(uint32_t logPageSize, size_t maxBytes);
+
+  static SharedPageCache & Instance();
+
+  // Returns the id of the |fileName| file of |fileSize| bytes. A file which is replaced with a
+  // file of other size gets a new id, so pages of the old file aren't used anymore.
+  FileId GetFileId(std::string const & fileName, uint64_t fileSize);
+
+  uint32_t GetLogPageSize() const { return m_logPageSize; }
+  size_t GetPageSize() const { return static_cast<size_t>(1) << m_logPageSize; }
+
+  void SetMaxBytes(size_t maxBytes);
+  Stats GetStats() const;
+  // Drops all unpinned pages and resets statistics.
+  void Clear();
+
+  // Returns the |pageNum| page of |fileId|, reads it from |reader| if it isn't cached.
+  // |reader| must have Size() and Read(pos, p, size) methods.
+  template <typename Reader>
+  Page GetPage(Reader & reader, FileId fileId, uint64_t pageNum)
+  {
+    Key const key(fileId, pageNum);
+    if (auto page = Find(key))
+      return page;
+
+    // The page is read without locks, so several threads may read the same page at once,
+    // only one of the copies is kept then.
+    uint64_t const pos = pageNum << m_logPageSize;
+    ASSERT_LESS(pos, reader.Size(), ());
+    auto page = std::make_shared<std::vector<char>>(
+        std::min(GetPageSize(), static_cast<size_t>(reader.Size() - pos)));
+    reader.Read(pos, page->data(), page->size());
+    return Insert(key, std::move(page));
+  }
+
+  // Reads [pos, pos + size) of |reader| identified by |fileId| through the cache.
+  template <typename Reader>
+  void Read(Reader & reader, FileId fileId, uint64_t pos, void * p, size_t size)
+  {
+    ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
+    char * dst = static_cast<char *>(p);
+    while (size > 0)
+    {
+      uint64_t const pageNum = pos >> m_logPageSize;
+      size_t const offset = static_cast<size_t>(pos - (pageNum << m_logPageSize));
+      size_t const copySize = std::min(size, GetPageSize() - offset);
+      auto const page = GetPage(reader, fileId, pageNum);
+      memcpy(dst, page->data() + offset, copySize);
+      size -= copySize;
+      pos += copySize;
+      dst += copySize;
+    }
+  }
+
+private:
+  using Key = std::pair<FileId, uint64_t>;
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const
+    {
+      return std::hash<uint64_t>()(key.second * 0x9E3779B97F4A7C15ULL ^ key.first);
+    }
+  };
+
+  struct Shard
+  {
+    using LruList = std::list<Key>;
+
+    struct Entry
+    {
+      Page m_page;
+      LruList::iterator m_lruIt;
+    };
+
+    mutable std::mutex m_mutex;
+    LruList m_lru;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    size_t m_bytes = 0;
+  };
+
+  Shard & GetShard(Key const & key) { return m_shards[KeyHash()(key) % kShardsCount]; }
+
+  Page Find(Key const & key);
+  Page Insert(Key const & key, Page page);
+  // Evicts least recently used unpinned pages of |shard| while it's over the budget.
+  // |shard| must be locked.
+  void Shrink(Shard & shard);
+
+  uint32_t const m_logPageSize;
+  std::atomic<size_t> m_shardMaxBytes;
+  std::array<Shard, kShardsCount> m_shards;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evictions{0};
+
+  std::mutex m_filesMutex;
+  // File name to its size and id.
+  std::map<std::string, std::pair<uint64_t, FileId>> m_files;
+  FileId m_nextFileId = 0;
+
+  DISALLOW_COPY_AND_MOVE(SharedPageCache);
+};
+}  // namespace coding
@@ -0,0 +1,27 @@
+#include "coding/succinct_vectors.hpp"
+
+using namespace std;
+
+namespace coding
+{
+EliasFanoSequence::EliasFanoSequence(vector<uint64_t> const & values)
+{
+  ASSERT(is_sorted(values.begin(), values.end()), ());
+  // Values of succinct::elias_fano are less than the universe.
+  uint64_t const universe = values.empty() ? 0 : values.back() + 1;
+  Builder builder(universe, values.size());
+  for (auto const v : values)
+    builder.PushBack(v);
+  EliasFanoSequence(builder).Swap(*this);
+}
+
+EliasFanoSequence::EliasFanoSequence(Builder & builder)
+{
+  succinct::elias_fano(&builder.m_builder, true /* with_rank_index */).swap(m_values);
+}
+
+RankSelectBitmap::RankSelectBitmap(vector<bool> const & bits)
+{
+  succinct::rs_bit_vector(bits, true /* with_select_hints */).swap(m_bits);
+}
+}  // namespace coding
@@ -0,0 +1,358 @@
+#pragma once
+
+#include "coding/succinct_mapper.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "3party/succinct/bit_vector.hpp"
+#include "3party/succinct/elias_fano.hpp"
+#include "3party/succinct/mappable_vector.hpp"
+#include "3party/succinct/rs_bit_vector.hpp"
+
+// Succinct containers for per-feature tables. All of them are stored by coding::Freeze() and
+// used in place of the mapped memory after coding::Map(), so nothing is decoded on loading.
+//
+// Get(i) decodes a single element, GetMany(ids, values) decodes elements of a batch of ids.
+// Runs of consecutive ids in a batch are decoded sequentially, which is much cheaper than
+// random access, so batches should be sorted when possible.
+namespace coding
+{
+// Non-decreasing sequence of uint64_t in Elias-Fano encoding, takes 2 + log(max / size) bits
+// per element.
+class EliasFanoSequence
+{
+public:
+  // Builds a sequence without keeping all the values in memory. All the values must be less
+  // than |universe| and exactly |size| values must be pushed.
+  class Builder
+  {
+  public:
+    Builder(uint64_t universe, uint64_t size) : m_builder(universe, size) {}
+
+    void PushBack(uint64_t value) { m_builder.push_back(value); }
+
+  private:
+    friend class EliasFanoSequence;
+
+    succinct::elias_fano::elias_fano_builder m_builder;
+  };
+
+  EliasFanoSequence() = default;
+  explicit EliasFanoSequence(std::vector<uint64_t> const & values);
+  explicit EliasFanoSequence(Builder & builder);
+
+  uint64_t Size() const { return m_values.num_ones(); }
+
+  uint64_t Get(uint64_t i) const
+  {
+    ASSERT_LESS(i, Size(), ());
+    return m_values.select(i);
+  }
+
+  // Returns the number of elements which are less than |value|.
+  // Works for strictly increasing sequences only.
+  uint64_t Rank(uint64_t value) const
+  {
+    if (value >= m_values.size())
+      return Size();
+    return m_values.rank(value);
+  }
+
+  template <typename Id>
+  void GetMany(std::vector<Id> const & ids, std::vector<uint64_t> & values) const
+  {
+    values.resize(ids.size());
+    size_t i = 0;
+    while (i < ids.size())
+    {
+      size_t j = i + 1;
+      while (j < ids.size() && ids[j] == ids[j - 1] + 1)
+        ++j;
+
+      if (j == i + 1)
+      {
+        values[i] = Get(ids[i]);
+        ++i;
+        continue;
+      }
+
+      ASSERT_LESS(ids[j - 1], Size(), ());
+      succinct::elias_fano::select_enumerator it(m_values, ids[i]);
+      for (; i < j; ++i)
+        values[i] = it.next();
+    }
+  }
+
+  void Swap(EliasFanoSequence & rhs) { m_values.swap(rhs.m_values); }
+
+  template <typename TVisitor>
+  void map(TVisitor & visitor)
+  {
+    visitor(m_values, "m_values");
+  }
+
+private:
+  succinct::elias_fano m_values;
+};
+
+// Vector of unsigned values of the same number of bits.
+template <typename Value>
+class BitPackedVector
+{
+public:
+  static_assert(std::is_unsigned<Value>::value, "");
+
+  BitPackedVector() = default;
+
+  // Values are packed into the minimal number of bits for the largest value.
+  explicit BitPackedVector(std::vector<Value> const & values)
+    : BitPackedVector(values, GetBitsCount(values))
+  {
+  }
+
+  BitPackedVector(std::vector<Value> const & values, uint8_t bits)
+    : m_size(values.size()), m_bits(bits)
+  {
+    CHECK_LESS_OR_EQUAL(m_bits, sizeof(Value) * CHAR_BIT, ());
+    succinct::bit_vector_builder builder;
+    for (auto const v : values)
+    {
+      ASSERT(m_bits == 64 || (static_cast<uint64_t>(v) >> m_bits) == 0, (v, m_bits));
+      builder.append_bits(v, static_cast<size_t>(m_bits));
+    }
+    succinct::bit_vector(&builder).swap(m_data);
+  }
+
+  uint64_t Size() const { return m_size; }
+  uint8_t GetBitsCount() const { return static_cast<uint8_t>(m_bits); }
+
+  Value Get(uint64_t i) const
+  {
+    ASSERT_LESS(i, m_size, ());
+    return static_cast<Value>(m_data.get_bits(i * m_bits, m_bits));
+  }
+
+  // Decodes elements [from, from + count) to |out|.
+  void Unpack(uint64_t from, size_t count, Value * out) const
+  {
+    ASSERT_LESS_OR_EQUAL(from + count, m_size, ());
+    if (m_bits == 0 || count == 0)
+    {
+      std::fill(out, out + count, Value(0));
+      return;
+    }
+
+    succinct::bit_vector::enumerator it(m_data, from * m_bits);
+    for (size_t i = 0; i < count; ++i)
+      out[i] = static_cast<Value>(it.take(m_bits));
+  }
+
+  template <typename Id>
+  void GetMany(std::vector<Id> const & ids, std::vector<Value> & values) const
+  {
+    values.resize(ids.size());
+    size_t i = 0;
+    while (i < ids.size())
+    {
+      size_t j = i + 1;
+      while (j < ids.size() && ids[j] == ids[j - 1] + 1)
+        ++j;
+      Unpack(ids[i], j - i, values.data() + i);
+      i = j;
+    }
+  }
+
+  template <typename TVisitor>
+  void map(TVisitor & visitor)
+  {
+    visitor(m_size, "m_size")(m_bits, "m_bits")(m_data, "m_data");
+  }
+
+private:
+  static uint8_t GetBitsCount(std::vector<Value> const & values)
+  {
+    uint8_t bits = 0;
+    for (auto const v : values)
+    {
+      while (bits < sizeof(Value) * CHAR_BIT && (static_cast<uint64_t>(v) >> bits) != 0)
+        ++bits;
+    }
+    return bits;
+  }
+
+  uint64_t m_size = 0;
+  uint64_t m_bits = 0;
+  succinct::bit_vector m_data;
+};
+
+// Bitmap with constant time rank and select.
+class RankSelectBitmap
+{
+public:
+  RankSelectBitmap() = default;
+  explicit RankSelectBitmap(std::vector<bool> const & bits);
+
+  uint64_t Size() const { return m_bits.size(); }
+  uint64_t NumOnes() const { return m_bits.num_ones(); }
+
+  bool Get(uint64_t i) const
+  {
+    ASSERT_LESS(i, Size(), ());
+    return m_bits[i];
+  }
+
+  // Returns the number of ones in [0, i).
+  uint64_t Rank(uint64_t i) const
+  {
+    ASSERT_LESS_OR_EQUAL(i, Size(), ());
+    return m_bits.rank(i);
+  }
+
+  // Returns the position of the |n|-th one.
+  uint64_t Select(uint64_t n) const
+  {
+    ASSERT_LESS(n, NumOnes(), ());
+    return m_bits.select(n);
+  }
+
+  template <typename Id>
+  void GetMany(std::vector<Id> const & ids, std::vector<bool> & values) const
+  {
+    values.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+      values[i] = Get(ids[i]);
+  }
+
+  template <typename Id>
+  void RankMany(std::vector<Id> const & ids, std::vector<uint64_t> & ranks) const
+  {
+    ranks.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+      ranks[i] = Rank(ids[i]);
+  }
+
+  template <typename TVisitor>
+  void map(TVisitor & visitor)
+  {
+    visitor(m_bits, "m_bits");
+  }
+
+private:
+  succinct::rs_bit_vector m_bits;
+};
+
+// Mapped replacement of FixedBitsDDVector: small values are packed into |Bits| bits, larger
+// values are stored separately and are found by the rank of the index among indices of
+// large values instead of a binary search. Values may be undefined.
+template <uint8_t Bits, typename Value = uint32_t>
+class FixedBitsSuccinctVector
+{
+public:
+  static_assert(std::is_unsigned<Value>::value, "");
+  static_assert(Bits > 1 && Bits < sizeof(Value) * CHAR_BIT, "");
+
+  class Builder
+  {
+  public:
+    void PushBack(Value v)
+    {
+      if (v >= kLargeValue)
+      {
+        m_largeIds.push_back(m_codes.size());
+        m_largeValues.push_back(v);
+        m_codes.push_back(kLargeValue);
+      }
+      else
+      {
+        m_codes.push_back(v);
+      }
+    }
+
+    void PushBackUndefined() { m_codes.push_back(kUndefined); }
+
+    // Writes the vector which is used after coding::Map().
+    template <typename Writer>
+    void Freeze(Writer & writer) const
+    {
+      FixedBitsSuccinctVector v(*this);
+      coding::Freeze(v, writer, "FixedBitsSuccinctVector");
+    }
+
+  private:
+    friend class FixedBitsSuccinctVector;
+
+    std::vector<Value> m_codes;
+    std::vector<uint64_t> m_largeIds;
+    std::vector<Value> m_largeValues;
+  };
+
+  FixedBitsSuccinctVector() = default;
+
+  explicit FixedBitsSuccinctVector(Builder const & builder)
+    : m_codes(builder.m_codes, Bits)
+  {
+    EliasFanoSequence(builder.m_largeIds).Swap(m_largeIds);
+    m_largeValues.assign(builder.m_largeValues);
+  }
+
+  uint64_t Size() const { return m_codes.Size(); }
+
+  bool Get(uint64_t i, Value & value) const
+  {
+    return Decode(i, m_codes.Get(i), value);
+  }
+
+  // |defined| is set to false for undefined values, their |values| aren't set.
+  template <typename Id>
+  void GetMany(std::vector<Id> const & ids, std::vector<Value> & values,
+               std::vector<bool> & defined) const
+  {
+    m_codes.GetMany(ids, values);
+    defined.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+      defined[i] = Decode(ids[i], values[i], values[i]);
+  }
+
+  template <typename TVisitor>
+  void map(TVisitor & visitor)
+  {
+    visitor(m_codes, "m_codes")(m_largeIds, "m_largeIds")(m_largeValues, "m_largeValues");
+  }
+
+private:
+  static Value constexpr kUndefined = (static_cast<Value>(1) << Bits) - 1;
+  static Value constexpr kLargeValue = kUndefined - 1;
+
+  bool Decode(uint64_t i, Value code, Value & value) const
+  {
+    if (code == kUndefined)
+      return false;
+    if (code == kLargeValue)
+    {
+      auto const rank = m_largeIds.Rank(i);
+      ASSERT_LESS(rank, m_largeValues.size(), ());
+      ASSERT_EQUAL(m_largeIds.Get(rank), i, ());
+      code = m_largeValues[rank];
+    }
+    value = code;
+    return true;
+  }
+
+  BitPackedVector<Value> m_codes;
+  EliasFanoSequence m_largeIds;
+  succinct::mapper::mappable_vector<Value> m_largeValues;
+};
+
+// static
+template <uint8_t Bits, typename Value>
+Value constexpr FixedBitsSuccinctVector<Bits, Value>::kUndefined;
+
+// static
+template <uint8_t Bits, typename Value>
+Value constexpr FixedBitsSuccinctVector<Bits, Value>::kLargeValue;
+}  // namespace coding
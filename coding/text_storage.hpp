@@ -1,6 +1,6 @@
 #pragma once
 
-#include "coding/bwt_coder.hpp"
+#include "coding/block_codec.hpp"
 #include "coding/reader.hpp"
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
@@ -23,21 +23,30 @@ namespace coding
 //
 // Format description:
 // * first 8 bytes - little endian-encoded offset of the index section
-// * data section - represents a catenated sequence of BWT-compressed blocks with
+// * data section - represents a catenated sequence of compressed blocks with
 //   a sequence of individual string lengths in the block
 // * index section - represents a delta-encoded sequence of
-//   BWT-compressed blocks offsets intermixed with the number of
-//   strings inside each block.
+//   compressed blocks offsets intermixed with the number of
+//   strings inside each block
+// * optional codec section - a byte with the BlockCodec of blocks and
+//   the size of the dictionary, absent for BlockCodec::BWT without a dictionary.
 //
-// All numbers except the first offset are varints.
+// All numbers except the first offset and the codec are varints.
 template <typename Writer>
 class BlockedTextStorageWriter
 {
 public:
-  BlockedTextStorageWriter(Writer & writer, uint64_t blockSize)
-    : m_writer(writer), m_blockSize(blockSize), m_startOffset(writer.Pos()), m_blocks(1)
+  BlockedTextStorageWriter(Writer & writer, uint64_t blockSize,
+                           BlockCodec codec = BlockCodec::BWT, std::string const & dict = {})
+    : m_writer(writer)
+    , m_blockSize(blockSize)
+    , m_codec(codec)
+    , m_dict(dict)
+    , m_startOffset(writer.Pos())
+    , m_blocks(1)
   {
     CHECK(m_blockSize != 0, ());
+    CHECK_LESS(m_codec, BlockCodec::Count, ());
     WriteToSink(m_writer, static_cast<uint64_t>(0));
     m_dataOffset = m_writer.Pos();
   }
@@ -71,6 +80,12 @@ public:
 
       prevOffset = block.m_offset;
     }
+
+    if (m_codec != BlockCodec::BWT || !m_dict.empty())
+    {
+      WriteToSink(m_writer, static_cast<uint8_t>(m_codec));
+      WriteVarUint(m_writer, static_cast<uint64_t>(m_dict.size()));
+    }
   }
 
   void Append(std::string const & s)
@@ -108,12 +123,14 @@ private:
   {
     for (auto const & length : lengths)
       WriteVarUint(m_writer, length);
-    BWTCoder::EncodeAndWriteBlock(m_writer, pool.size(),
-                                  reinterpret_cast<uint8_t const *>(pool.c_str()));
+    EncodeAndWriteBlock(m_writer, m_codec, m_dict, pool.size(),
+                        reinterpret_cast<uint8_t const *>(pool.c_str()));
   }
 
   Writer & m_writer;
   uint64_t const m_blockSize;
+  BlockCodec const m_codec;
+  std::string const m_dict;
   uint64_t m_startOffset = 0;
   uint64_t m_dataOffset = 0;
 
@@ -140,6 +157,8 @@ public:
   };
 
   size_t GetNumBlockInfos() const { return m_blocks.size(); }
+  BlockCodec GetCodec() const { return m_codec; }
+  uint64_t GetDictionarySize() const { return m_dictSize; }
   size_t GetNumStrings() const { return m_blocks.empty() ? 0 : m_blocks.back().To(); }
 
   BlockInfo const & GetBlockInfo(size_t blockIx) const
@@ -199,21 +218,37 @@ public:
       block.m_subs = ReadVarUint<uint64_t, NonOwningReaderSource>(source);
       CHECK_GREATER_OR_EQUAL(block.m_from + block.m_subs, block.m_from, ());
     }
+
+    m_codec = BlockCodec::BWT;
+    m_dictSize = 0;
+    if (source.Size() != 0)
+    {
+      m_codec = static_cast<BlockCodec>(ReadPrimitiveFromSource<uint8_t>(source));
+      CHECK_LESS(m_codec, BlockCodec::Count, ());
+      m_dictSize = ReadVarUint<uint64_t, NonOwningReaderSource>(source);
+    }
   }
 
 private:
   std::vector<BlockInfo> m_blocks;
+  BlockCodec m_codec = BlockCodec::BWT;
+  uint64_t m_dictSize = 0;
 };
 
 class BlockedTextStorageReader
 {
 public:
+  BlockedTextStorageReader() = default;
+  // |dict| must be the dictionary the storage was written with.
+  explicit BlockedTextStorageReader(std::string const & dict) : m_dict(dict) {}
+
   template <typename Reader>
   void InitializeIfNeeded(Reader & reader)
   {
     if (m_initialized)
       return;
     m_index.Read(reader);
+    CHECK_EQUAL(m_index.GetDictionarySize(), m_dict.size(), ("Wrong dictionary."));
     m_initialized = true;
   }
 
@@ -255,7 +290,7 @@ public:
         CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
         offset += sub.m_length;
       }
-      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(entry.m_value));
+      ReadAndDecodeBlock(source, m_index.GetCodec(), m_dict, std::back_inserter(entry.m_value));
       entry.m_valid = true;
     }
     ASSERT(entry.m_valid, ());
@@ -291,6 +326,7 @@ private:
     bool m_valid = false;
   };
 
+  std::string const m_dict;
   BlockedTextStorageIndex m_index;
   std::vector<CacheEntry> m_cache;
   bool m_initialized = false;
@@ -300,7 +336,8 @@ template <typename Reader>
 class BlockedTextStorage
 {
 public:
-  explicit BlockedTextStorage(Reader & reader) : m_reader(reader)
+  explicit BlockedTextStorage(Reader & reader, std::string const & dict = {})
+    : m_storage(dict), m_reader(reader)
   {
     m_storage.InitializeIfNeeded(m_reader);
   }
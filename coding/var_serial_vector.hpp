@@ -68,7 +68,8 @@ public:
   /// @todo Do this stuff in a better way.
   m_size(ReadPrimitiveFromSource<uint32_t>(source)),
   m_offsetsReader(source.SubReader(m_size * sizeof(uint32_t))),
-  m_dataReader(source.SubReader())
+  m_dataReader(source.SubReader()),
+  m_offsetsData(m_offsetsReader.GetContiguousData())
   {
   }
 
@@ -92,11 +93,21 @@ public:
   uint64_t Size() const { return m_size; }
 
 private:
+  uint32_t GetOffset(uint32_t i) const
+  {
+    if (m_offsetsData == nullptr)
+      return ReadPrimitiveFromPos<uint32_t>(m_offsetsReader, i * sizeof(uint32_t));
+
+    ASSERT_LESS(i, m_size, ());
+    uint32_t offset;
+    memcpy(&offset, m_offsetsData + i * sizeof(uint32_t), sizeof(offset));
+    return SwapIfBigEndianMacroBased(offset);
+  }
+
   pair<uint32_t, uint32_t> GetPosAndSize(uint32_t i) const
   {
-    uint32_t const begin =
-            i == 0 ? 0 : ReadPrimitiveFromPos<uint32_t>(m_offsetsReader, (i - 1) * sizeof(uint32_t));
-    uint32_t const end = ReadPrimitiveFromPos<uint32_t>(m_offsetsReader, i * sizeof(uint32_t));
+    uint32_t const begin = i == 0 ? 0 : GetOffset(i - 1);
+    uint32_t const end = GetOffset(i);
 
     ASSERT_LESS_OR_EQUAL(begin, end, ());
     return make_pair(begin, end - begin);
@@ -107,4 +118,6 @@ private:
   uint64_t m_size;
   ReaderT m_offsetsReader;
   ReaderT m_dataReader;
+  /// Offsets in place when |m_offsetsReader| is contiguous in memory, nullptr otherwise.
+  uint8_t const * m_offsetsData;
 };
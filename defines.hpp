@@ -31,6 +31,7 @@
 #define INDEX_FILE_TAG "idx"
 #define SEARCH_INDEX_FILE_TAG "sdx"
 #define SEARCH_ADDRESS_FILE_TAG "addr"
+#define HOUSE_TO_STREET_FILE_TAG "house_to_street"
 #define CITIES_BOUNDARIES_FILE_TAG "cities_boundaries"
 #define HEADER_FILE_TAG "header"
 #define VERSION_FILE_TAG "version"
@@ -40,7 +41,10 @@
 #define ROAD_ACCESS_FILE_TAG "roadaccess"
 #define RESTRICTIONS_FILE_TAG "restrictions"
 #define ROUTING_FILE_TAG "routing"
+#define ROUTING_MAPPED_FILE_TAG "routing_mapped"
 #define CROSS_MWM_FILE_TAG "cross_mwm"
+#define LANDMARKS_FILE_TAG "landmarks"
+#define SPEED_PROFILES_FILE_TAG "speed_profiles"
 #define FEATURE_OFFSETS_FILE_TAG "offs"
 #define SEARCH_RANKS_FILE_TAG "ranks"
 #define POPULARITY_RANKS_FILE_TAG "popularity"
@@ -50,10 +54,14 @@
 // Temporary addresses section that is used in search index generation.
 #define SEARCH_TOKENS_FILE_TAG "addrtags"
 #define TRAFFIC_KEYS_FILE_TAG "traffic"
+#define TRAFFIC_KEYS_MAPPED_FILE_TAG "traffic_mapped"
 #define TRANSIT_CROSS_MWM_FILE_TAG "transit_cross_mwm"
 #define TRANSIT_FILE_TAG "transit"
+#define TRANSIT_SCHEDULE_FILE_TAG "transit_schedule"
 #define UGC_FILE_TAG "ugc"
 #define CITY_ROADS_FILE_TAG "city_roads"
+#define SHORT_PREFIXES_FILE_TAG "short_prefixes"
+#define ADDRESS_POINTS_FILE_TAG "addrpts"
 
 #define LOCALITY_DATA_FILE_TAG "locdata"
 #define GEO_OBJECTS_INDEX_FILE_TAG "locidx"
@@ -91,6 +99,7 @@
 #define SEARCH_CUISINE_CATEGORIES_FILE_NAME "categories_cuisines.txt"
 
 #define PACKED_POLYGONS_INFO_TAG "info"
+#define PACKED_POLYGONS_RASTER_INDEX_TAG "raster"
 #define PACKED_POLYGONS_FILE "packed_polygons.bin"
 #define PACKED_POLYGONS_OBSOLETE_FILE "packed_polygons_obsolete.bin"
 
@@ -6,6 +6,7 @@
 
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/trace.hpp"
 
 #include <utility>
 
@@ -14,10 +15,12 @@ namespace dp
 class Batcher::CallbacksWrapper : public BatchCallbacks
 {
 public:
-  CallbacksWrapper(RenderState const & state, ref_ptr<OverlayHandle> overlay, ref_ptr<Batcher> batcher)
+  CallbacksWrapper(RenderState const & state, ref_ptr<OverlayHandle> overlay,
+                   ref_ptr<Batcher> batcher, IndexStorage & indexStorage)
     : m_state(state)
     , m_overlay(overlay)
     , m_batcher(batcher)
+    , m_indexStorage(indexStorage)
   {}
 
   void SetVAO(ref_ptr<VertexArrayBuffer> buffer)
@@ -81,6 +84,8 @@ public:
     return m_state;
   }
 
+  bool IsVAOChanged() const { return m_vaoChanged; }
+
   IndicesRange const & Finish()
   {
     if (!m_vaoChanged)
@@ -96,7 +101,7 @@ private:
   ref_ptr<OverlayHandle> m_overlay;
   ref_ptr<Batcher> m_batcher;
   ref_ptr<VertexArrayBuffer> m_buffer;
-  IndexStorage m_indexStorage;
+  IndexStorage & m_indexStorage;
   IndicesRange m_indicesRange;
   bool m_vaoChanged = false;
 };
@@ -249,22 +254,27 @@ ref_ptr<RenderBucket> Batcher::GetBucket(RenderState const & state)
 
 void Batcher::FinalizeBucket(ref_ptr<GraphicsContext> context, RenderState const & state)
 {
+  TRACE_ZONE("Batcher::FinalizeBucket");
   TBuckets::iterator it = m_buckets.find(state);
   ASSERT(it != m_buckets.end(), ("Have no bucket for finalize with given state"));
   drape_ptr<RenderBucket> bucket = std::move(it->second);
   m_buckets.erase(state);
 
-  bucket->GetBuffer()->Preflush(context);
+  if (m_preflushEnabled)
+    bucket->GetBuffer()->Preflush(context);
   m_flushInterface(state, std::move(bucket));
 }
 
 void Batcher::Flush(ref_ptr<GraphicsContext> context)
 {
+  TRACE_ZONE("Batcher::Flush");
+  TRACE_COUNTER("Batcher buckets", static_cast<int64_t>(m_buckets.size()));
   ASSERT(m_flushInterface != NULL, ());
   std::for_each(m_buckets.begin(), m_buckets.end(), [this, context](TBuckets::value_type & bucket)
   {
     ASSERT(bucket.second != nullptr, ());
-    bucket.second->GetBuffer()->Preflush(context);
+    if (m_preflushEnabled)
+      bucket.second->GetBuffer()->Preflush(context);
     m_flushInterface(bucket.first, std::move(bucket.second));
   });
 
@@ -277,14 +287,14 @@ IndicesRange Batcher::InsertPrimitives(ref_ptr<GraphicsContext> context, RenderS
                                        drape_ptr<OverlayHandle> && transferHandle,
                                        uint8_t vertexStride, TArgs... batcherArgs)
 {
-  ref_ptr<VertexArrayBuffer> vao = GetBucket(state)->GetBuffer();
+  ref_ptr<RenderBucket> bucket = GetBucket(state);
   IndicesRange range;
 
   drape_ptr<OverlayHandle> handle = std::move(transferHandle);
 
   {
-    Batcher::CallbacksWrapper wrapper(state, make_ref(handle), make_ref(this));
-    wrapper.SetVAO(vao);
+    Batcher::CallbacksWrapper wrapper(state, make_ref(handle), make_ref(this), m_indexStorage);
+    wrapper.SetVAO(bucket->GetBuffer());
 
     TBatcher batch(wrapper, batcherArgs ...);
     batch.SetCanDivideStreams(handle == nullptr);
@@ -292,10 +302,14 @@ IndicesRange Batcher::InsertPrimitives(ref_ptr<GraphicsContext> context, RenderS
     batch.BatchData(context, params);
 
     range = wrapper.Finish();
+
+    // The bucket is finalized and replaced when its buffer is overflowed.
+    if (wrapper.IsVAOChanged())
+      bucket = GetBucket(state);
   }
 
   if (handle != nullptr)
-    GetBucket(state)->AddOverlayHandle(std::move(handle));
+    bucket->AddOverlayHandle(std::move(handle));
 
   return range;
 }
@@ -2,6 +2,7 @@
 
 #include "drape/attribute_provider.hpp"
 #include "drape/graphics_context.hpp"
+#include "drape/index_storage.hpp"
 #include "drape/overlay_handle.hpp"
 #include "drape/pointers.hpp"
 #include "drape/render_bucket.hpp"
@@ -72,6 +73,11 @@ public:
 
   void SetFeatureMinZoom(int minZoom);
 
+  // Buckets are moved to GPU before flushing unless it's disabled. Without moving batching
+  // doesn't use the graphics context, so it can be done on any thread and buckets are
+  // moved to GPU by the receiver.
+  void SetPreflushEnabled(bool enabled) { m_preflushEnabled = enabled; }
+
 private:
   template <typename TBatcher, typename... TArgs>
   IndicesRange InsertPrimitives(ref_ptr<GraphicsContext> context, RenderState const & state,
@@ -91,10 +97,15 @@ private:
   using TBuckets = std::map<RenderState, drape_ptr<RenderBucket>>;
   TBuckets m_buckets;
 
+  // Indices of primitives without overlay handles are generated here. The storage is reused
+  // to avoid allocations on every insertion, e.g. for every POI icon.
+  IndexStorage m_indexStorage;
+
   uint32_t m_indexBufferSize;
   uint32_t m_vertexBufferSize;
 
   int m_featureMinZoom = 0;
+  bool m_preflushEnabled = true;
 };
 
 class BatcherFactory
@@ -7,6 +7,7 @@
 #include <boost/shared_array.hpp>
 
 #include <string>
+#include <type_traits>
 
 namespace dp
 {
@@ -17,6 +18,8 @@ struct BindingDecl
   glConst m_componentType;
   uint8_t m_stride;
   uint8_t m_offset;
+  // Integer components are converted to floats in [0, 1].
+  bool m_needNormalize = false;
 
   bool operator!=(BindingDecl const & other) const;
   bool operator<(BindingDecl const & other) const;
@@ -43,13 +46,22 @@ protected:
   uint16_t m_info;
 };
 
+// Packed attributes take less memory, shaders get them as normalized floats.
+template <typename TFieldType>
+bool IsPackedAttribute()
+{
+  return std::is_same<TFieldType, glsl::u16vec2>::value;
+}
+
 template <typename TFieldType, typename TVertexType>
 uint8_t FillDecl(size_t index, std::string const & attrName, dp::BindingInfo & info, uint8_t offset)
 {
   dp::BindingDecl & decl = info.GetBindingDecl(static_cast<uint16_t>(index));
   decl.m_attributeName = attrName;
   decl.m_componentCount = glsl::GetComponentCount<TFieldType>();
-  decl.m_componentType = gl_const::GLFloatType;
+  decl.m_componentType = IsPackedAttribute<TFieldType>() ? gl_const::GLUnsignedShortType
+                                                         : gl_const::GLFloatType;
+  decl.m_needNormalize = IsPackedAttribute<TFieldType>();
   decl.m_offset = offset;
   decl.m_stride = sizeof(TVertexType);
 
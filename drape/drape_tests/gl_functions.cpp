@@ -235,6 +235,12 @@ void GLFunctions::glTexSubImage2D(int x, int y, int width, int height, glConst l
   MOCK_CALL(glTexSubImage2D(x, y, width, height, layout, pixelType, data));
 }
 
+void GLFunctions::glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                         uint32_t dataSize, void const * data)
+{
+  MOCK_CALL(glCompressedTexImage2D(width, height, internalFormat, dataSize, data));
+}
+
 void GLFunctions::glTexParameter(glConst param, glConst value)
 {
   MOCK_CALL(glTexParameter(param, value));
@@ -0,0 +1,75 @@
+#include "testing/testing.hpp"
+
+#include "drape/glyph_sdf_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <string>
+
+using namespace dp;
+
+namespace
+{
+GlyphManager::Glyph MakeGlyph(strings::UniChar code, int fontIndex, uint32_t size, uint8_t value)
+{
+  GlyphManager::Glyph glyph;
+  glyph.m_metrics = {1.0f, 2.0f, 3.0f, 4.0f, true /* m_isValid */};
+  glyph.m_fontIndex = fontIndex;
+  glyph.m_code = code;
+  glyph.m_fixedSize = GlyphManager::kDynamicGlyphSize;
+  glyph.m_image.m_width = size;
+  glyph.m_image.m_height = size;
+  glyph.m_image.m_bitmapRows = 0;
+  glyph.m_image.m_bitmapPitch = 0;
+  glyph.m_image.m_data = SharedBufferManager::instance().reserveSharedBuffer(size * size);
+  glyph.m_image.m_data->assign(size * size, value);
+  return glyph;
+}
+}  // namespace
+
+UNIT_TEST(GlyphSdfCache_SaveLoad)
+{
+  std::string const path = GetPlatform().WritablePathForFile("glyph_sdf_cache_test.bin");
+  Platform::RemoveFileIfExists(path);
+  SCOPE_GUARD(deleteFile, [&path]() { Platform::RemoveFileIfExists(path); });
+
+  auto a = MakeGlyph('a', 0 /* fontIndex */, 10 /* size */, 100 /* value */);
+  auto b = MakeGlyph('b', 1 /* fontIndex */, 12 /* size */, 200 /* value */);
+  SCOPE_GUARD(destroyA, [&a]() { a.m_image.Destroy(); });
+  SCOPE_GUARD(destroyB, [&b]() { b.m_image.Destroy(); });
+
+  {
+    GlyphSdfCache cache(path, "fonts");
+    TEST_EQUAL(cache.GetSize(), 0, ());
+    cache.Add(a);
+    cache.Add(b);
+    cache.Save();
+  }
+
+  {
+    GlyphSdfCache cache(path, "fonts");
+    TEST_EQUAL(cache.GetSize(), 2, ());
+
+    GlyphManager::Glyph generated;
+    TEST(cache.Find(a, generated), ());
+    TEST_EQUAL(generated.m_code, 'a', ());
+    TEST_EQUAL(generated.m_image.m_width, 10, ());
+    TEST_EQUAL(generated.m_image.m_height, 10, ());
+    TEST_EQUAL((*generated.m_image.m_data)[0], 100, ());
+    TEST_EQUAL((*generated.m_image.m_data)[99], 100, ());
+    generated.m_image.Destroy();
+
+    // Glyph from another font isn't found.
+    auto c = MakeGlyph('b', 0 /* fontIndex */, 12 /* size */, 0 /* value */);
+    TEST(!cache.Find(c, generated), ());
+    c.m_image.Destroy();
+  }
+
+  {
+    // The cache is dropped when fonts are changed.
+    GlyphSdfCache cache(path, "other fonts");
+    TEST_EQUAL(cache.GetSize(), 0, ());
+  }
+}
@@ -0,0 +1,69 @@
+#include "testing/testing.hpp"
+
+#include "drape/ktx_image.hpp"
+
+#include "coding/writer.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace dp;
+
+namespace
+{
+std::vector<uint8_t> MakeKtx(uint32_t internalFormat, uint32_t width, uint32_t height,
+                             uint32_t imageSize)
+{
+  std::vector<uint8_t> ktx;
+  MemWriter<std::vector<uint8_t>> writer(ktx);
+  uint8_t const identifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  writer.Write(identifier, sizeof(identifier));
+  WriteToSink(writer, static_cast<uint32_t>(0x04030201));  // endianness
+  WriteToSink(writer, static_cast<uint32_t>(0));           // glType
+  WriteToSink(writer, static_cast<uint32_t>(1));           // glTypeSize
+  WriteToSink(writer, static_cast<uint32_t>(0));           // glFormat
+  WriteToSink(writer, internalFormat);
+  WriteToSink(writer, static_cast<uint32_t>(0x1908));      // glBaseInternalFormat
+  WriteToSink(writer, width);
+  WriteToSink(writer, height);
+  WriteToSink(writer, static_cast<uint32_t>(0));           // pixelDepth
+  WriteToSink(writer, static_cast<uint32_t>(0));           // numberOfArrayElements
+  WriteToSink(writer, static_cast<uint32_t>(1));           // numberOfFaces
+  WriteToSink(writer, static_cast<uint32_t>(1));           // numberOfMipmapLevels
+  WriteToSink(writer, static_cast<uint32_t>(4));           // bytesOfKeyValueData
+  WriteToSink(writer, static_cast<uint32_t>(0));
+  WriteToSink(writer, imageSize);
+  for (uint32_t i = 0; i < imageSize; ++i)
+    WriteToSink(writer, static_cast<uint8_t>(i));
+  return ktx;
+}
+}  // namespace
+
+UNIT_TEST(KtxImage_Read)
+{
+  uint32_t const kETC2 = 0x9278;
+
+  KtxImage image;
+  TEST(ReadKtxImage(MakeKtx(kETC2, 8 /* width */, 4 /* height */, 32 /* imageSize */), image), ());
+  TEST(image.m_format == TextureFormat::ETC2RGBA8, ());
+  TEST_EQUAL(image.m_width, 8, ());
+  TEST_EQUAL(image.m_height, 4, ());
+  TEST_EQUAL(image.m_data.size(), 32, ());
+  TEST_EQUAL(image.m_data[31], 31, ());
+
+  // Unsupported format.
+  TEST(!ReadKtxImage(MakeKtx(0x8C00 /* PVRTC */, 8, 4, 32), image), ());
+  // Size isn't a multiple of blocks.
+  TEST(!ReadKtxImage(MakeKtx(kETC2, 6, 4, 24), image), ());
+  // Wrong image size.
+  TEST(!ReadKtxImage(MakeKtx(kETC2, 8, 4, 16), image), ());
+
+  // Truncated data.
+  auto ktx = MakeKtx(kETC2, 8, 4, 32);
+  ktx.resize(ktx.size() - 1);
+  TEST(!ReadKtxImage(ktx, image), ());
+  ktx.resize(10);
+  TEST(!ReadKtxImage(ktx, image), ());
+}
@@ -0,0 +1,47 @@
+#include "testing/testing.hpp"
+
+#include "drape/overlay_grid.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+vector<int> Select(dp::OverlayGrid<int> const & grid, m2::RectD const & rect)
+{
+  vector<int> result;
+  grid.ForEachInRect(rect, [&result](int object) { result.push_back(object); });
+  sort(result.begin(), result.end());
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(OverlayGrid_Smoke)
+{
+  dp::OverlayGrid<int> grid(10.0 /* cellSize */);
+  grid.Add(1, m2::RectD(0.0, 0.0, 5.0, 5.0));
+  // The rect is in many cells but it's reported once.
+  grid.Add(2, m2::RectD(-25.0, -25.0, 45.0, 45.0));
+  grid.Add(3, m2::RectD(30.0, 30.0, 35.0, 35.0));
+  TEST_EQUAL(grid.GetSize(), 3, ());
+
+  TEST_EQUAL(Select(grid, m2::RectD(-100.0, -100.0, 100.0, 100.0)), vector<int>({1, 2, 3}), ());
+  TEST_EQUAL(Select(grid, m2::RectD(1.0, 1.0, 2.0, 2.0)), vector<int>({1, 2}), ());
+  TEST_EQUAL(Select(grid, m2::RectD(31.0, 1.0, 32.0, 2.0)), vector<int>({2}), ());
+  TEST_EQUAL(Select(grid, m2::RectD(50.0, 50.0, 60.0, 60.0)), vector<int>(), ());
+
+  // Touching rects don't intersect.
+  TEST_EQUAL(Select(grid, m2::RectD(5.0, 5.0, 6.0, 6.0)), vector<int>({2}), ());
+
+  grid.Erase(2);
+  grid.Erase(4);
+  TEST_EQUAL(grid.GetSize(), 2, ());
+  TEST_EQUAL(Select(grid, m2::RectD(-100.0, -100.0, 100.0, 100.0)), vector<int>({1, 3}), ());
+  TEST_EQUAL(Select(grid, m2::RectD(31.0, 1.0, 32.0, 2.0)), vector<int>(), ());
+
+  grid.Clear();
+  TEST_EQUAL(grid.GetSize(), 0, ());
+  TEST_EQUAL(Select(grid, m2::RectD(-100.0, -100.0, 100.0, 100.0)), vector<int>(), ());
+}
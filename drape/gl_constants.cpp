@@ -25,6 +25,10 @@
   #define GL_LUMINANCE8_ALPHA4_OES 0x8043
 #endif
 
+#if !defined(GL_COMPRESSED_RGBA8_ETC2_EAC)
+  #define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
 #if !defined(GL_LUMINANCE)
   #define GL_LUMINANCE 0x1909
 #endif
@@ -154,6 +158,8 @@ const glConst GLAlphaLuminance4     = GL_LUMINANCE8_ALPHA4_OES;
 const glConst GLRed                 = GL_RED;
 const glConst GLRedGreen            = GL_RG;
 
+const glConst GLCompressedRGBA8ETC2 = GL_COMPRESSED_RGBA8_ETC2_EAC;
+
 const glConst GL8BitOnChannel       = GL_UNSIGNED_BYTE;
 const glConst GL4BitOnChannel       = GL_UNSIGNED_SHORT_4_4_4_4;
 
@@ -72,6 +72,9 @@ extern const glConst GLAlphaLuminance4;
 extern const glConst GLRed;
 extern const glConst GLRedGreen;
 
+/// Compressed texture formats
+extern const glConst GLCompressedRGBA8ETC2;
+
 /// Pixel type for texture upload
 extern const glConst GL8BitOnChannel;
 extern const glConst GL4BitOnChannel;
@@ -1036,6 +1036,14 @@ void GLFunctions::glTexSubImage2D(int x, int y, int width, int height, glConst l
   GLCHECK(::glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, layout, pixelType, data));
 }
 
+void GLFunctions::glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                         uint32_t dataSize, void const * data)
+{
+  ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
+  GLCHECK(::glCompressedTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
+                                   static_cast<GLsizei>(dataSize), data));
+}
+
 void GLFunctions::glTexParameter(glConst param, glConst value)
 {
   ASSERT_NOT_EQUAL(CurrentApiVersion, dp::ApiVersion::Invalid, ());
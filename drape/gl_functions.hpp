@@ -135,6 +135,8 @@ public:
                            void const * data);
   static void glTexSubImage2D(int x, int y, int width, int height, glConst layout,
                               glConst pixelType, void const * data);
+  static void glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                     uint32_t dataSize, void const * data);
   static void glTexParameter(glConst param, glConst value);
 
   // Draw support
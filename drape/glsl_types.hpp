@@ -15,8 +15,11 @@
 #include <glm/mat4x2.hpp>
 #include <glm/mat4x3.hpp>
 
+#include <glm/gtc/type_precision.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <type_traits>
 
 namespace glsl
@@ -33,6 +36,8 @@ using glm::ivec2;
 using glm::ivec3;
 using glm::ivec4;
 
+using glm::u16vec2;
+
 using glm::mat3;
 using glm::mat4;
 using glm::mat4x2;
@@ -70,6 +75,17 @@ inline m2::PointD FromVec2(glsl::vec2 const & pt)
   return m2::PointD(pt.x, pt.y);
 }
 
+// Packs texture coordinates in [0, 1] to normalized unsigned shorts. Shaders get them as vec2,
+// see dp::IsPackedAttribute().
+inline u16vec2 PackTexCoord(vec2 const & texCoord)
+{
+  auto const pack = [](float v)
+  {
+    return static_cast<uint16_t>(std::round(std::min(std::max(v, 0.0f), 1.0f) * 65535.0f));
+  };
+  return u16vec2(pack(texCoord.x), pack(texCoord.y));
+}
+
 inline vec3 ToVec3(dp::Color const & color)
 {
   return glsl::vec3(static_cast<float>(color.GetRed()) / 255,
@@ -109,6 +125,12 @@ inline uint8_t GetComponentCount<vec2>()
   return 2;
 }
 
+template <>
+inline uint8_t GetComponentCount<u16vec2>()
+{
+  return 2;
+}
+
 template <>
 inline uint8_t GetComponentCount<vec3>()
 {
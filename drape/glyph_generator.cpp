@@ -1,11 +1,20 @@
 #include "drape/glyph_generator.hpp"
 
+#include "base/logging.hpp"
+#include "base/parallel.hpp"
+
 #include <iterator>
 
 using namespace std::placeholders;
 
 namespace dp
 {
+namespace
+{
+// Generation of a glyph takes less than a millisecond, so glyphs are generated by small groups.
+size_t constexpr kMinGlyphsPerTask = 4;
+}  // namespace
+
 GlyphGenerator::GlyphGenerator(uint32_t sdfScale)
   : m_sdfScale(sdfScale)
 {}
@@ -28,15 +37,31 @@ bool GlyphGenerator::IsSuspended() const
   return m_glyphsCounter == 0;
 }
 
+void GlyphGenerator::LoadCache(std::string const & path, std::string const & fingerprint)
+{
+  auto cache = std::make_shared<GlyphSdfCache>(path, fingerprint);
+  LOG(LINFO, ("Glyphs cache is loaded, glyphs count =", cache->GetSize()));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache = std::move(cache);
+}
+
 void GlyphGenerator::FinishGeneration()
 {
   m_activeTasks.FinishAll();
 
-  std::lock_guard<std::mutex> lock(m_mutex);
-  for (auto & data : m_queue)
-    data.DestroyGlyph();
+  std::shared_ptr<GlyphSdfCache> cache;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto & data : m_queue)
+      data.DestroyGlyph();
 
-  m_glyphsCounter = 0;
+    m_glyphsCounter = 0;
+    cache = m_cache;
+  }
+
+  if (cache)
+    cache->Save();
 }
 
 void GlyphGenerator::RegisterListener(ref_ptr<GlyphGenerator::Listener> listener)
@@ -79,7 +104,7 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
   m_glyphsCounter += queue.size();
 
   // Generate glyphs on the separate thread.
-  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(queue));
+  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(queue), m_cache);
   auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
   {
     generateTask->Run(m_sdfScale);
@@ -122,16 +147,24 @@ void GlyphGenerator::OnTaskFinished(ref_ptr<Listener> listener,
 
 void GlyphGenerator::GenerateGlyphTask::Run(uint32_t sdfScale)
 {
-  m_generatedGlyphs.reserve(m_glyphs.size());
-  for (auto & data : m_glyphs)
+  // Glyphs which aren't generated because of cancellation have no images.
+  m_generatedGlyphs.resize(m_glyphs.size());
+  base::ParallelFor(0, m_glyphs.size(), [this, sdfScale](size_t i)
   {
     if (m_isCancelled)
       return;
 
-    auto const g = GlyphManager::GenerateGlyph(data.m_glyph, sdfScale);
+    auto & data = m_glyphs[i];
+    GlyphManager::Glyph g;
+    if (m_cache == nullptr || !m_cache->Find(data.m_glyph, g))
+    {
+      g = GlyphManager::GenerateGlyph(data.m_glyph, sdfScale);
+      if (m_cache != nullptr)
+        m_cache->Add(g);
+    }
     data.DestroyGlyph();
-    m_generatedGlyphs.emplace_back(GlyphGenerator::GlyphGenerationData{data.m_rect, g});
-  }
+    m_generatedGlyphs[i] = GlyphGenerator::GlyphGenerationData{data.m_rect, g};
+  }, kMinGlyphsPerTask);
 }
 
 void GlyphGenerator::GenerateGlyphTask::DestroyAllGlyphs()
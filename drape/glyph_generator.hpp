@@ -2,6 +2,7 @@
 
 #include "drape/drape_routine.hpp"
 #include "drape/glyph_manager.hpp"
+#include "drape/glyph_sdf_cache.hpp"
 #include "drape/pointers.hpp"
 
 #include "geometry/rect2d.hpp"
@@ -11,6 +12,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 
 namespace dp
@@ -46,10 +48,12 @@ public:
   class GenerateGlyphTask
   {
   public:
-    explicit GenerateGlyphTask(GlyphGenerationDataArray && glyphs)
+    GenerateGlyphTask(GlyphGenerationDataArray && glyphs, std::shared_ptr<GlyphSdfCache> cache)
       : m_glyphs(std::move(glyphs))
+      , m_cache(std::move(cache))
       , m_isCancelled(false)
     {}
+    // Glyphs are generated in parallel on the task scheduler.
     void Run(uint32_t sdfScale);
     void Cancel() { m_isCancelled = true; }
 
@@ -60,6 +64,7 @@ public:
   private:
     GlyphGenerationDataArray m_glyphs;
     GlyphGenerationDataArray m_generatedGlyphs;
+    std::shared_ptr<GlyphSdfCache> m_cache;
     std::atomic<bool> m_isCancelled;
   };
 
@@ -74,6 +79,10 @@ public:
   void GenerateGlyphs(ref_ptr<Listener> listener, GlyphGenerationDataArray && generationData);
   bool IsSuspended() const;
 
+  // Loads the persistent cache of generated glyphs, see GlyphSdfCache.
+  void LoadCache(std::string const & path, std::string const & fingerprint);
+
+  // Waits for the active tasks and saves the cache.
   void FinishGeneration();
 
 private:
@@ -85,6 +94,7 @@ private:
 
   GlyphGenerationDataArray m_queue;
   size_t m_glyphsCounter = 0;
+  std::shared_ptr<GlyphSdfCache> m_cache;
   mutable std::mutex m_mutex;
 };
 }  // namespace dp
@@ -360,6 +360,7 @@ struct GlyphManager::Impl
 
   uint32_t m_baseGlyphHeight;
   uint32_t m_sdfScale;
+  std::string m_fingerprint;
 };
 
 GlyphManager::GlyphManager(GlyphManager::Params const & params)
@@ -395,6 +396,9 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
 
   FREETYPE_CHECK(FT_Init_FreeType(&m_impl->m_library));
 
+  std::ostringstream fingerprint;
+  fingerprint << m_impl->m_baseGlyphHeight << ' ' << m_impl->m_sdfScale << ' ' << kSdfBorder;
+
   for (auto const & fontName : params.m_fonts)
   {
     bool ignoreFont = false;
@@ -410,9 +414,12 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
     std::vector<FT_ULong> charCodes;
     try
     {
-      m_impl->m_fonts.emplace_back(std::make_unique<Font>(params.m_sdfScale, GetPlatform().GetReader(fontName),
+      ReaderPtr<Reader> fontReader = GetPlatform().GetReader(fontName);
+      auto const fontSize = fontReader.Size();
+      m_impl->m_fonts.emplace_back(std::make_unique<Font>(params.m_sdfScale, fontReader,
                                                           m_impl->m_library));
       m_impl->m_fonts.back()->GetCharcodes(charCodes);
+      fingerprint << ' ' << fontName << ' ' << fontSize;
     }
     catch(RootException const & e)
     {
@@ -486,6 +493,7 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
   }
 
   m_impl->m_lastUsedBlock = m_impl->m_blocks.end();
+  m_impl->m_fingerprint = fingerprint.str();
 }
 
 GlyphManager::~GlyphManager()
@@ -507,6 +515,11 @@ uint32_t GlyphManager::GetSdfScale() const
   return m_impl->m_sdfScale;
 }
 
+std::string const & GlyphManager::GetFingerprint() const
+{
+  return m_impl->m_fingerprint;
+}
+
 int GlyphManager::GetFontIndex(strings::UniChar unicodePoint)
 {
   TUniBlockIter iter = m_impl->m_blocks.end();
@@ -89,6 +89,9 @@ public:
   uint32_t GetBaseGlyphHeight() const;
   uint32_t GetSdfScale() const;
 
+  // Fonts and parameters which the generated glyphs depend on.
+  std::string const & GetFingerprint() const;
+
   static Glyph GenerateGlyph(Glyph const & glyph, uint32_t sdfScale);
 
 private:
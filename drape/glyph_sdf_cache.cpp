@@ -0,0 +1,182 @@
+#include "drape/glyph_sdf_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+
+namespace dp
+{
+namespace
+{
+// Protects from allocation of huge images when the file is broken.
+uint32_t constexpr kMaxGlyphSize = 1024;
+}  // namespace
+
+// static
+uint32_t constexpr GlyphSdfCache::kVersion;
+size_t constexpr GlyphSdfCache::kMaxGlyphsCount;
+
+GlyphSdfCache::GlyphSdfCache(std::string const & path, std::string const & fingerprint)
+  : m_path(path), m_fingerprint(fingerprint)
+{
+  Load();
+}
+
+bool GlyphSdfCache::Find(GlyphManager::Glyph const & glyph,
+                         GlyphManager::Glyph & generatedGlyph) const
+{
+  if (glyph.m_fixedSize != GlyphManager::kDynamicGlyphSize || glyph.m_image.m_data == nullptr)
+    return false;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_images.find(glyph.m_code);
+  if (it == m_images.end())
+    return false;
+
+  // Glyph may be taken from another font, e.g. when fonts are blacklisted.
+  auto const & image = it->second;
+  if (image.m_fontIndex != glyph.m_fontIndex || image.m_width != glyph.m_image.m_width ||
+      image.m_height != glyph.m_image.m_height)
+  {
+    return false;
+  }
+
+  generatedGlyph.m_metrics = glyph.m_metrics;
+  generatedGlyph.m_fontIndex = glyph.m_fontIndex;
+  generatedGlyph.m_code = glyph.m_code;
+  generatedGlyph.m_fixedSize = glyph.m_fixedSize;
+
+  size_t const bufferSize = base::NextPowOf2(image.m_width * image.m_height);
+  generatedGlyph.m_image.m_data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
+  std::copy(image.m_data.begin(), image.m_data.end(), generatedGlyph.m_image.m_data->begin());
+  generatedGlyph.m_image.m_width = image.m_width;
+  generatedGlyph.m_image.m_height = image.m_height;
+  generatedGlyph.m_image.m_bitmapRows = 0;
+  generatedGlyph.m_image.m_bitmapPitch = 0;
+  return true;
+}
+
+void GlyphSdfCache::Add(GlyphManager::Glyph const & generatedGlyph)
+{
+  auto const & glyphImage = generatedGlyph.m_image;
+  if (generatedGlyph.m_fixedSize != GlyphManager::kDynamicGlyphSize || glyphImage.m_data == nullptr)
+    return;
+
+  size_t const size = glyphImage.m_width * glyphImage.m_height;
+  ASSERT_LESS_OR_EQUAL(size, glyphImage.m_data->size(), ());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_images.size() >= kMaxGlyphsCount)
+    return;
+
+  Image image;
+  image.m_fontIndex = generatedGlyph.m_fontIndex;
+  image.m_width = glyphImage.m_width;
+  image.m_height = glyphImage.m_height;
+  image.m_data.assign(glyphImage.m_data->begin(), glyphImage.m_data->begin() + size);
+  m_isChanged |= m_images.emplace(generatedGlyph.m_code, std::move(image)).second;
+}
+
+size_t GlyphSdfCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_images.size();
+}
+
+void GlyphSdfCache::Save()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isChanged)
+    return;
+
+  // The cache is written to the temporary file so that a broken file isn't loaded.
+  std::string const tmpPath = m_path + ".tmp";
+  try
+  {
+    {
+      FileWriter writer(tmpPath);
+      WriteToSink(writer, kVersion);
+      WriteToSink(writer, static_cast<uint32_t>(m_fingerprint.size()));
+      writer.Write(m_fingerprint.data(), m_fingerprint.size());
+      WriteToSink(writer, static_cast<uint32_t>(m_images.size()));
+      for (auto const & item : m_images)
+      {
+        auto const & image = item.second;
+        WriteToSink(writer, static_cast<uint32_t>(item.first));
+        WriteToSink(writer, static_cast<int32_t>(image.m_fontIndex));
+        WriteToSink(writer, image.m_width);
+        WriteToSink(writer, image.m_height);
+        writer.Write(image.m_data.data(), image.m_data.size());
+      }
+    }
+
+    if (!base::RenameFileX(tmpPath, m_path))
+    {
+      LOG(LWARNING, ("Can't rename", tmpPath, "to", m_path));
+      base::DeleteFileX(tmpPath);
+      return;
+    }
+    m_isChanged = false;
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write glyphs cache", m_path, e.Msg()));
+    base::DeleteFileX(tmpPath);
+  }
+}
+
+void GlyphSdfCache::Load()
+{
+  if (!GetPlatform().IsFileExistsByFullPath(m_path))
+    return;
+
+  try
+  {
+    FileReader reader(m_path);
+    ReaderSource<FileReader> src(reader);
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kVersion)
+      return;
+
+    auto const fingerprintSize = ReadPrimitiveFromSource<uint32_t>(src);
+    if (fingerprintSize > src.Size())
+      MYTHROW(Reader::Exception, ("Wrong fingerprint size", fingerprintSize));
+    std::string fingerprint(fingerprintSize, '\0');
+    src.Read(&fingerprint[0], fingerprint.size());
+    if (fingerprint != m_fingerprint)
+    {
+      LOG(LINFO, ("Glyphs cache is dropped, fonts are changed."));
+      return;
+    }
+
+    auto const count = ReadPrimitiveFromSource<uint32_t>(src);
+    for (uint32_t i = 0; i < count && i < kMaxGlyphsCount; ++i)
+    {
+      auto const code = static_cast<strings::UniChar>(ReadPrimitiveFromSource<uint32_t>(src));
+      Image image;
+      image.m_fontIndex = ReadPrimitiveFromSource<int32_t>(src);
+      image.m_width = ReadPrimitiveFromSource<uint32_t>(src);
+      image.m_height = ReadPrimitiveFromSource<uint32_t>(src);
+      if (image.m_width > kMaxGlyphSize || image.m_height > kMaxGlyphSize)
+        MYTHROW(Reader::Exception, ("Wrong glyph size", image.m_width, image.m_height));
+      image.m_data.resize(image.m_width * image.m_height);
+      src.Read(image.m_data.data(), image.m_data.size());
+      m_images.emplace(code, std::move(image));
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read glyphs cache", m_path, e.Msg()));
+    m_images.clear();
+  }
+}
+}  // namespace dp
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "drape/glyph_manager.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dp
+{
+// Persistent cache of generated SDF glyphs. Generation of SDF is the most expensive part of
+// glyphs preparing, so the glyphs which are generated in previous sessions are loaded
+// at startup and are copied to font textures instead of generation.
+//
+// The cache is dropped when the fingerprint of fonts (see GlyphManager::GetFingerprint())
+// is changed. The methods are thread-safe.
+class GlyphSdfCache
+{
+public:
+  static uint32_t constexpr kVersion = 0;
+  // Limits the size of the file, it's about 1 Kb per glyph.
+  static size_t constexpr kMaxGlyphsCount = 4096;
+
+  GlyphSdfCache(std::string const & path, std::string const & fingerprint);
+
+  // Returns false if there is no generated |glyph|.
+  bool Find(GlyphManager::Glyph const & glyph, GlyphManager::Glyph & generatedGlyph) const;
+  void Add(GlyphManager::Glyph const & generatedGlyph);
+
+  size_t GetSize() const;
+
+  // Writes the cache if it has new glyphs.
+  void Save();
+
+private:
+  struct Image
+  {
+    int m_fontIndex = 0;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    std::vector<uint8_t> m_data;
+  };
+
+  void Load();
+
+  std::string const m_path;
+  std::string const m_fingerprint;
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<strings::UniChar, Image> m_images;
+  bool m_isChanged = false;
+
+  DISALLOW_COPY_AND_MOVE(GlyphSdfCache);
+};
+}  // namespace dp
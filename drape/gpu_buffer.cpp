@@ -2,6 +2,7 @@
 #include "drape/drape_diagnostics.hpp"
 #include "drape/gl_functions.hpp"
 #include "drape/utils/gpu_mem_tracker.hpp"
+#include "drape/utils/render_counters.hpp"
 
 #include "base/assert.hpp"
 
@@ -58,6 +59,15 @@ void GPUBuffer::UploadData(void const * data, uint32_t elementCount)
          ("Not enough memory to upload ", elementCount, " elements"));
   Bind();
 
+  // Uploading from the beginning means that the whole content is replaced, e.g. indices of
+  // visible overlays are rewritten on every change of visibility. The old storage is orphaned,
+  // so the driver allocates a new one instead of waiting for the draw calls which use the old one.
+  if (currentSize == 0 && m_hasUploadedData)
+  {
+    GLFunctions::glBufferData(glTarget(m_t), GetCapacity() * elementSize, nullptr,
+                              gl_const::GLDynamicDraw);
+  }
+
 #if defined(CHECK_VBO_BOUNDS)
   int32_t size = GLFunctions::glGetBufferParameter(glTarget(m_t), gl_const::GLBufferSize);
   ASSERT_EQUAL(GetCapacity() * elementSize, size, ());
@@ -67,6 +77,8 @@ void GPUBuffer::UploadData(void const * data, uint32_t elementCount)
   GLFunctions::glBufferSubData(glTarget(m_t), elementCount * elementSize, data,
                                currentSize * elementSize);
   TBase::UploadData(elementCount);
+  m_hasUploadedData = true;
+  RenderCounters::Instance().AddUploadedBytes(elementCount * elementSize);
 
 #if defined(TRACK_GPU_MEM)
   dp::GPUMemTracker::Inst().SetUsed("VBO", m_bufferID, (currentSize + elementCount) * elementSize);
@@ -119,6 +131,7 @@ void GPUBuffer::UpdateData(void * gpuPtr, void const * data, uint32_t elementOff
   ASSERT_LESS_OR_EQUAL(byteOffset + byteCount, size, ());
 #endif
 
+  RenderCounters::Instance().AddUploadedBytes(byteCount);
   if (IsMapBufferSupported())
   {
     ASSERT(gpuPtr != nullptr, ());
@@ -154,8 +167,12 @@ void GPUBuffer::Resize(void const * data, uint32_t elementCount)
                             gl_const::GLDynamicDraw);
 
   // If we have set up data already (in glBufferData), we have to call SetDataSize.
-  if (data != nullptr)
+  m_hasUploadedData = data != nullptr;
+  if (m_hasUploadedData)
+  {
     SetDataSize(elementCount);
+    RenderCounters::Instance().AddUploadedBytes(elementCount * GetElementSize());
+  }
 
 #if defined(TRACK_GPU_MEM)
   dp::GPUMemTracker & memTracker = dp::GPUMemTracker::Inst();
@@ -34,6 +34,8 @@ private:
   Target m_t;
   uint32_t m_bufferID;
   uint32_t m_mappingOffset;
+  // True if the buffer storage contains data which may be used by previous draw calls.
+  bool m_hasUploadedData = false;
 
 #ifdef DEBUG
   bool m_isMapped;
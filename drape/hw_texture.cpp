@@ -60,6 +60,13 @@ void UnpackFormat(ref_ptr<dp::GraphicsContext> context, TextureFormat format,
     pixelType = gl_const::GLUnsignedIntType;
     return;
 
+  case TextureFormat::ETC2RGBA8:
+    // Compressed textures are supported on OpenGL ES3 only.
+    CHECK(apiVersion != dp::ApiVersion::OpenGLES2, ());
+    layout = gl_const::GLCompressedRGBA8ETC2;
+    pixelType = gl_const::GL8BitOnChannel;
+    return;
+
   case TextureFormat::Unspecified:
     CHECK(false, ());
     return;
@@ -176,8 +183,18 @@ void OpenGLHWTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const
   UnpackFormat(context, m_params.m_format, m_unpackedLayout, m_unpackedPixelType);
 
   auto const f = DecodeTextureFilter(m_params.m_filter);
-  GLFunctions::glTexImage2D(m_params.m_width, m_params.m_height,
-                            m_unpackedLayout, m_unpackedPixelType, data.get());
+  if (IsCompressedFormat(m_params.m_format))
+  {
+    CHECK(data != nullptr, ("Compressed textures must be created with data."));
+    uint32_t const dataSize = m_params.m_width * m_params.m_height * GetBytesPerPixel(m_params.m_format);
+    GLFunctions::glCompressedTexImage2D(m_params.m_width, m_params.m_height, m_unpackedLayout,
+                                        dataSize, data.get());
+  }
+  else
+  {
+    GLFunctions::glTexImage2D(m_params.m_width, m_params.m_height,
+                              m_unpackedLayout, m_unpackedPixelType, data.get());
+  }
   GLFunctions::glTexParameter(gl_const::GLMinFilter, f);
   GLFunctions::glTexParameter(gl_const::GLMagFilter, f);
   GLFunctions::glTexParameter(gl_const::GLWrapS, DecodeTextureWrapping(m_params.m_wrapSMode));
@@ -200,6 +217,7 @@ void OpenGLHWTexture::UploadData(uint32_t x, uint32_t y, uint32_t width, uint32_
                                  ref_ptr<void> data)
 {
   ASSERT(Validate(), ());
+  CHECK(!IsCompressedFormat(m_params.m_format), ("Compressed textures can't be updated."));
   uint32_t const mappingSize = height * width * m_pixelBufferElementSize;
   if (m_pixelBufferID != 0 && m_pixelBufferSize != 0 && m_pixelBufferSize >= mappingSize)
   {
@@ -0,0 +1,93 @@
+#include "drape/ktx_image.hpp"
+
+#include "coding/reader.hpp"
+
+#include "base/logging.hpp"
+
+#include <cstring>
+
+namespace dp
+{
+namespace
+{
+uint8_t const kKtxIdentifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                  0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+uint32_t const kKtxEndianness = 0x04030201;
+uint32_t const kGLCompressedRGBA8ETC2EAC = 0x9278;
+
+// Fields of the header after the identifier, all of them are uint32_t.
+enum KtxHeaderField
+{
+  Endianness,
+  GLType,
+  GLTypeSize,
+  GLFormat,
+  GLInternalFormat,
+  GLBaseInternalFormat,
+  PixelWidth,
+  PixelHeight,
+  PixelDepth,
+  NumberOfArrayElements,
+  NumberOfFaces,
+  NumberOfMipmapLevels,
+  BytesOfKeyValueData,
+  Count
+};
+}  // namespace
+
+bool ReadKtxImage(std::vector<uint8_t> const & ktx, KtxImage & image)
+{
+  try
+  {
+    MemReader reader(ktx.data(), ktx.size());
+    ReaderSource<MemReader> src(reader);
+
+    uint8_t identifier[sizeof(kKtxIdentifier)];
+    src.Read(identifier, sizeof(identifier));
+    if (memcmp(identifier, kKtxIdentifier, sizeof(identifier)) != 0)
+      return false;
+
+    uint32_t header[KtxHeaderField::Count];
+    for (auto & field : header)
+      field = ReadPrimitiveFromSource<uint32_t>(src);
+
+    // Containers are written by skin_generator in little-endian byte order only.
+    if (header[KtxHeaderField::Endianness] != kKtxEndianness)
+      return false;
+
+    if (header[KtxHeaderField::GLInternalFormat] != kGLCompressedRGBA8ETC2EAC)
+    {
+      LOG(LWARNING, ("Unsupported KTX format", header[KtxHeaderField::GLInternalFormat]));
+      return false;
+    }
+
+    uint32_t const width = header[KtxHeaderField::PixelWidth];
+    uint32_t const height = header[KtxHeaderField::PixelHeight];
+    if (width == 0 || height == 0 || width % kCompressedBlockSize != 0 ||
+        height % kCompressedBlockSize != 0 || header[KtxHeaderField::PixelDepth] != 0 ||
+        header[KtxHeaderField::NumberOfFaces] != 1)
+    {
+      return false;
+    }
+
+    src.Skip(header[KtxHeaderField::BytesOfKeyValueData]);
+
+    auto const imageSize = ReadPrimitiveFromSource<uint32_t>(src);
+    auto const format = TextureFormat::ETC2RGBA8;
+    if (imageSize != width * height * GetBytesPerPixel(format) || imageSize > src.Size())
+      return false;
+
+    image.m_format = format;
+    image.m_width = width;
+    image.m_height = height;
+    image.m_data.resize(imageSize);
+    src.Read(image.m_data.data(), imageSize);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Broken KTX container", e.Msg()));
+    return false;
+  }
+  return true;
+}
+}  // namespace dp
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "drape/texture_types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace dp
+{
+// Compressed image stored in KTX 1.1 container, see
+// https://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/
+struct KtxImage
+{
+  TextureFormat m_format = TextureFormat::Unspecified;
+  uint32_t m_width = 0;
+  uint32_t m_height = 0;
+  std::vector<uint8_t> m_data;
+};
+
+// Reads the first mip level of a 2D texture in a compressed format from |ktx|.
+// Returns false if the container is broken or the format isn't supported.
+bool ReadKtxImage(std::vector<uint8_t> const & ktx, KtxImage & image);
+}  // namespace dp
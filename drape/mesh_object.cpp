@@ -6,6 +6,7 @@
 #include "drape/glsl_func.hpp"
 #include "drape/glsl_types.hpp"
 #include "drape/texture_manager.hpp"
+#include "drape/utils/render_counters.hpp"
 
 namespace
 {
@@ -252,6 +253,7 @@ void MeshObject::DrawPrimitives(ref_ptr<dp::GraphicsContext> context)
 
   CHECK(m_impl != nullptr, ());
   m_impl->DrawPrimitives(context, verticesCount);
+  RenderCounters::Instance().AddDrawCall();
 }
 
 void MeshObject::Unbind(ref_ptr<dp::GpuProgram> program)
@@ -1,4 +1,5 @@
 #include "drape/metal/metal_gpu_buffer_impl.hpp"
+#include "drape/utils/render_counters.hpp"
 
 #include "base/macros.hpp"
 
@@ -27,6 +28,7 @@ void MetalGPUBuffer::UploadData(void const * data, uint32_t elementCount)
   uint8_t * gpuPtr = static_cast<uint8_t *>([m_metalBuffer contents]) + byteOffset;
   memcpy(gpuPtr, data, sizeInBytes);
   BufferBase::UploadData(elementCount);
+  RenderCounters::Instance().AddUploadedBytes(sizeInBytes);
 }
 
 void * MetalGPUBuffer::Map(uint32_t elementOffset, uint32_t elementCount)
@@ -47,6 +49,7 @@ void MetalGPUBuffer::UpdateData(void * gpuPtr, void const * data,
 
   ASSERT(gpuPtr != nullptr, ());
   memcpy((uint8_t *)gpuPtr + byteOffset, data, byteCount);
+  RenderCounters::Instance().AddUploadedBytes(byteCount);
 }
 
 void MetalGPUBuffer::Resize(ref_ptr<MetalBaseContext> context, void const * data, uint32_t elementCount)
@@ -69,7 +72,10 @@ void MetalGPUBuffer::Resize(ref_ptr<MetalBaseContext> context, void const * data
   
   // If we have already set up data, we have to call SetDataSize.
   if (data != nullptr)
+  {
     SetDataSize(elementCount);
+    RenderCounters::Instance().AddUploadedBytes(elementCount * GetElementSize());
+  }
 }
 }  // namespace metal
   
@@ -29,6 +29,7 @@ MTLPixelFormat UnpackFormat(TextureFormat format)
   case TextureFormat::RedGreen: return MTLPixelFormatRG8Unorm;
   case TextureFormat::DepthStencil: return MTLPixelFormatDepth32Float_Stencil8;
   case TextureFormat::Depth: return MTLPixelFormatDepth32Float;
+  case TextureFormat::ETC2RGBA8: return MTLPixelFormatEAC_RGBA8;
   case TextureFormat::Unspecified:
     CHECK(false, ());
     return MTLPixelFormatInvalid;
@@ -71,7 +72,10 @@ void MetalTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const & p
     m_texture = [metalDevice newTextureWithDescriptor:texDesc];
     CHECK(m_texture != nil, ());
     MTLRegion region = MTLRegionMake2D(0, 0, m_params.m_width, m_params.m_height);
-    auto const rowBytes = m_params.m_width * GetBytesPerPixel(m_params.m_format);
+    auto rowBytes = m_params.m_width * GetBytesPerPixel(m_params.m_format);
+    // Rows of compressed textures are rows of blocks.
+    if (IsCompressedFormat(m_params.m_format))
+      rowBytes *= kCompressedBlockSize;
     [m_texture replaceRegion:region mipmapLevel:0 withBytes:data.get() bytesPerRow:rowBytes];
   }
 }
@@ -79,6 +83,7 @@ void MetalTexture::Create(ref_ptr<dp::GraphicsContext> context, Params const & p
 void MetalTexture::UploadData(uint32_t x, uint32_t y, uint32_t width, uint32_t height, ref_ptr<void> data)
 {
   CHECK(m_isMutable, ("Upload data is avaivable only for mutable textures."));
+  CHECK(!IsCompressedFormat(m_params.m_format), ("Compressed textures can't be updated."));
   MTLRegion region = MTLRegionMake2D(x, y, width, height);
   auto const rowBytes = width * GetBytesPerPixel(m_params.m_format);
   [m_texture replaceRegion:region mipmapLevel:0 withBytes:data.get() bytesPerRow:rowBytes];
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dp
+{
+// Spatial hash grid of objects with pixel rects. Sizes of overlays are close to each other, so
+// collision queries visit few cells and objects. Unlike m4::Tree objects are added and erased
+// without rebuilding the structure, so the grid suits the incremental overlays placement.
+template <typename T, typename Hash = std::hash<T>>
+class OverlayGrid
+{
+public:
+  explicit OverlayGrid(double cellSize) : m_cellSize(cellSize)
+  {
+    CHECK_GREATER(m_cellSize, 0.0, ());
+  }
+
+  void Add(T const & object, m2::RectD const & rect)
+  {
+    ASSERT(m_rects.find(object) == m_rects.end(), ());
+    m_rects.emplace(object, rect);
+    ForEachCell(rect, [&](int32_t x, int32_t y) { m_cells[GetKey(x, y)].push_back({object, rect}); });
+  }
+
+  void Erase(T const & object)
+  {
+    auto const it = m_rects.find(object);
+    if (it == m_rects.end())
+      return;
+
+    ForEachCell(it->second, [&](int32_t x, int32_t y)
+    {
+      auto const cellIt = m_cells.find(GetKey(x, y));
+      CHECK(cellIt != m_cells.end(), ());
+      auto & entries = cellIt->second;
+      auto const entryIt = std::find_if(entries.begin(), entries.end(),
+                                        [&object](Entry const & e) { return e.m_object == object; });
+      CHECK(entryIt != entries.end(), ());
+      *entryIt = entries.back();
+      entries.pop_back();
+      if (entries.empty())
+        m_cells.erase(cellIt);
+    });
+    m_rects.erase(it);
+  }
+
+  void Clear()
+  {
+    m_cells.clear();
+    m_rects.clear();
+  }
+
+  size_t GetSize() const { return m_rects.size(); }
+
+  // Calls |toDo| once for every object which rect intersects |rect|. Rects which only touch
+  // each other don't intersect like in m4::Tree.
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ForEachCell(rect, [&](int32_t x, int32_t y)
+    {
+      auto const cellIt = m_cells.find(GetKey(x, y));
+      if (cellIt == m_cells.end())
+        return;
+
+      for (auto const & e : cellIt->second)
+      {
+        if (!IsIntersect(e.m_rect, rect))
+          continue;
+
+        // An object may be in several cells, it's reported in the cell which has
+        // the min corner of the intersection of rects.
+        if (GetCell(std::max(e.m_rect.minX(), rect.minX())) == x &&
+            GetCell(std::max(e.m_rect.minY(), rect.minY())) == y)
+        {
+          toDo(e.m_object);
+        }
+      }
+    });
+  }
+
+private:
+  // Cell coordinates are limited to avoid overflows on far away rects.
+  static int32_t constexpr kMaxCell = 1 << 16;
+
+  struct Entry
+  {
+    T m_object;
+    m2::RectD m_rect;
+  };
+
+  static bool IsIntersect(m2::RectD const & r1, m2::RectD const & r2)
+  {
+    return !(r1.maxX() <= r2.minX() || r1.minX() >= r2.maxX() || r1.maxY() <= r2.minY() ||
+             r1.minY() >= r2.maxY());
+  }
+
+  static uint64_t GetKey(int32_t x, int32_t y)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+  }
+
+  int32_t GetCell(double coord) const
+  {
+    double const cell = std::floor(coord / m_cellSize);
+    if (cell <= -kMaxCell)
+      return -kMaxCell;
+    if (cell >= kMaxCell)
+      return kMaxCell;
+    return static_cast<int32_t>(cell);
+  }
+
+  template <typename ToDo>
+  void ForEachCell(m2::RectD const & rect, ToDo && toDo) const
+  {
+    int32_t const maxX = GetCell(rect.maxX());
+    int32_t const maxY = GetCell(rect.maxY());
+    for (int32_t x = GetCell(rect.minX()); x <= maxX; ++x)
+    {
+      for (int32_t y = GetCell(rect.minY()); y <= maxY; ++y)
+        toDo(x, y);
+    }
+  }
+
+  double const m_cellSize;
+  std::unordered_map<uint64_t, std::vector<Entry>> m_cells;
+  std::unordered_map<T, m2::RectD, Hash> m_rects;
+
+  DISALLOW_COPY_AND_MOVE(OverlayGrid);
+};
+}  // namespace dp
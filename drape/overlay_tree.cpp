@@ -3,6 +3,8 @@
 #include "drape/constants.hpp"
 #include "drape/debug_renderer.hpp"
 
+#include "base/timer.hpp"
+
 #include <algorithm>
 
 namespace dp
@@ -16,8 +18,20 @@ uint32_t const kMaxHandlesCount = 1000;
 size_t const kAverageHandlesCount[dp::OverlayRanksCount] = { 300, 200, 50 };
 int const kInvalidFrame = -1;
 
+// Size of the collisions grid cell in pixels, it's close to sizes of the most of overlays.
+double const kGridCellSize = 64.0;
+// Time budget of the incremental placement per frame in seconds.
+double const kMaxIncrementalPlacingTime = 0.003;
+
 namespace
 {
+bool IsSameScreen(ScreenBase const & s1, ScreenBase const & s2)
+{
+  return s1 == s2 && s1.isPerspective() == s2.isPerspective() &&
+         s1.GetRotationAngle() == s2.GetRotationAngle() &&
+         s1.PixelRectIn3d() == s2.PixelRectIn3d();
+}
+
 class HandleComparator
 {
 public:
@@ -68,6 +82,7 @@ private:
 
 OverlayTree::OverlayTree(double visualScale)
   : m_frameCounter(kInvalidFrame)
+  , m_grid(kGridCellSize * visualScale)
   , m_isDisplacementEnabled(true)
   , m_frameUpdatePeriod(kMinFrameUpdatePeriod)
 {
@@ -79,18 +94,25 @@ OverlayTree::OverlayTree(double visualScale)
 void OverlayTree::Clear()
 {
   InvalidateOnNextFrame();
-  TBase::Clear();
+  m_grid.Clear();
   m_handlesCache.clear();
   for (auto & handles : m_handles)
     handles.clear();
+  for (auto & handles : m_pendingHandles)
+    handles.clear();
+  m_placedCounts.fill(0);
   m_displacers.clear();
 }
 
-bool OverlayTree::Frame()
+bool OverlayTree::Frame(ScreenBase const & screen)
 {
   if (IsNeedUpdate())
     return true;
 
+  // The placement stays valid on the same screen, new handles are placed incrementally.
+  if (IsSameScreen(screen, GetModelView()))
+    return false;
+
   // Choose optimal frame update period.
   if (m_frameCounter == 0)
   {
@@ -123,8 +145,15 @@ void OverlayTree::InvalidateOnNextFrame()
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen, int zoomLevel)
 {
   ASSERT(IsNeedUpdate(), ());
-  TBase::Clear();
+  m_grid.Clear();
   m_handlesCache.clear();
+  // All the handles are collected again, so the incremental placement is dropped.
+  for (size_t rank = 0; rank < m_handles.size(); ++rank)
+  {
+    m_handles[rank].clear();
+    m_pendingHandles[rank].clear();
+  }
+  m_placedCounts.fill(0);
   m_traits.SetModelView(screen);
   m_displacementInfo.clear();
   m_zoomLevel = zoomLevel;
@@ -136,32 +165,75 @@ void OverlayTree::Remove(ref_ptr<OverlayHandle> handle)
     return;
 
   if (m_handlesCache.find(handle) != m_handlesCache.end())
+  {
     InvalidateOnNextFrame();
+    return;
+  }
+
+  // Remove the handle if it waits for the incremental placement.
+  ASSERT_GREATER_OR_EQUAL(handle->GetOverlayRank(), 0, ());
+  size_t const rank = static_cast<size_t>(handle->GetOverlayRank());
+  ASSERT_LESS(rank, m_handles.size(), ());
+
+  auto & pendingHandles = m_pendingHandles[rank];
+  pendingHandles.erase(std::remove(pendingHandles.begin(), pendingHandles.end(), handle),
+                       pendingHandles.end());
+
+  auto & handles = m_handles[rank];
+  auto const it = std::find(handles.begin(), handles.end(), handle);
+  if (it != handles.end())
+  {
+    if (static_cast<size_t>(std::distance(handles.begin(), it)) < m_placedCounts[rank])
+      --m_placedCounts[rank];
+    handles.erase(it);
+  }
 }
 
 void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
 {
-  ASSERT(IsNeedUpdate(), ());
+  if (!IsNeedUpdate())
+  {
+    handle->SetIsVisible(false);
+    if (m_zoomLevel < handle->GetMinVisibleScale())
+      return;
+
+    ASSERT_GREATER_OR_EQUAL(handle->GetOverlayRank(), 0, ());
+    size_t const rank = static_cast<size_t>(handle->GetOverlayRank());
+    ASSERT_LESS(rank, m_pendingHandles.size(), ());
+    m_pendingHandles[rank].emplace_back(handle);
+    return;
+  }
+
+  if (!PrepareHandle(handle))
+    return;
+
+  ASSERT_GREATER_OR_EQUAL(handle->GetOverlayRank(), 0, ());
+  size_t const rank = static_cast<size_t>(handle->GetOverlayRank());
+  ASSERT_LESS(rank, m_handles.size(), ());
+  m_handles[rank].emplace_back(handle);
+}
 
+bool OverlayTree::PrepareHandle(ref_ptr<OverlayHandle> handle)
+{
   ScreenBase const & modelView = GetModelView();
 
   handle->SetIsVisible(false);
 
   if (m_zoomLevel < handle->GetMinVisibleScale())
-    return;
+    return false;
 
   handle->SetCachingEnable(true);
 
   // Skip duplicates.
   if (m_handlesCache.find(handle) != m_handlesCache.end())
-    return;
+    return false;
 
   // Skip not-ready handles.
   if (!handle->Update(modelView))
   {
     InvalidateOnNextFrame();
     handle->SetReady(false);
-    return;
+    return false;
   }
   else
   {
@@ -176,20 +248,14 @@ void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
        !m_traits.GetExtendedScreenRect().IsIntersect(pixelRect)))
   {
     handle->SetIsVisible(false);
-    return;
+    return false;
   }
-
-  ASSERT_GREATER_OR_EQUAL(handle->GetOverlayRank(), 0, ());
-  size_t const rank = static_cast<size_t>(handle->GetOverlayRank());
-  ASSERT_LESS(rank, m_handles.size(), ());
-  m_handles[rank].emplace_back(handle);
+  return true;
 }
 
 void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                                ref_ptr<OverlayHandle> const & parentOverlay)
 {
-  ASSERT(IsNeedUpdate(), ());
-
 #ifdef DEBUG_OVERLAYS_OUTPUT
   string str = handle->GetOverlayDebugInfo();
   if (!str.empty())
@@ -201,7 +267,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
   if (!m_isDisplacementEnabled)
   {
     m_handlesCache.insert(handle);
-    TBase::Add(handle, pixelRect);
+    m_grid.Add(handle, pixelRect);
     return;
   }
 
@@ -210,7 +276,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
 
   // Find elements that already on OverlayTree and it's pixel rect
   // intersect with handle pixel rect ("Intersected elements").
-  ForEachInRect(pixelRect, [&] (ref_ptr<OverlayHandle> const & h)
+  m_grid.ForEachInRect(pixelRect, [&] (ref_ptr<OverlayHandle> const & h)
   {
     bool const isParent = (h == parentOverlay) ||
                           (h->GetOverlayID() == handle->GetOverlayID() &&
@@ -271,7 +337,8 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
       {
         if ((*it)->GetOverlayID() == rivalHandle->GetOverlayID())
         {
-          Erase(*it);
+          m_grid.Erase(*it);
+          HideDisplacedHandle(*it);
           StoreDisplacementInfo(2 /* case index */, handle, *it);
           it = m_handlesCache.erase(it);
         }
@@ -289,7 +356,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
   }
 
   m_handlesCache.insert(handle);
-  TBase::Add(handle, pixelRect);
+  m_grid.Add(handle, pixelRect);
 }
 
 void OverlayTree::EndOverlayPlacing()
@@ -338,6 +405,72 @@ void OverlayTree::EndOverlayPlacing()
 #endif
 }
 
+bool OverlayTree::HasPendingHandles() const
+{
+  for (size_t rank = 0; rank < m_handles.size(); ++rank)
+  {
+    if (!m_handles[rank].empty() || !m_pendingHandles[rank].empty())
+      return true;
+  }
+  return false;
+}
+
+void OverlayTree::PlacePendingHandles(ScreenBase const & screen)
+{
+  ASSERT(!IsNeedUpdate(), ());
+
+  // Pixel rects of the placed handles are valid only on the screen of the placement,
+  // on another screen the pending handles wait for the next full placement.
+  if (!HasPendingHandles() || !IsSameScreen(screen, GetModelView()))
+    return;
+
+  // Handles which are added during placing of a batch are placed in the next batch, so that
+  // the sorted order of the batch is kept. Processed handles stay in the batch until it's
+  // finished to find parents of the next ranks.
+  bool const isBatchStarted = std::any_of(m_handles.cbegin(), m_handles.cend(),
+                                          [](HandlesList const & handles) { return !handles.empty(); });
+  if (!isBatchStarted)
+  {
+    HandleComparator comparator(false /* enableMask */);
+    for (size_t rank = 0; rank < m_handles.size(); ++rank)
+    {
+      m_handles[rank].swap(m_pendingHandles[rank]);
+      std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
+    }
+    m_placedCounts.fill(0);
+  }
+
+  base::Timer timer;
+  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  {
+    auto const & handles = m_handles[rank];
+    for (; m_placedCounts[rank] < handles.size(); ++m_placedCounts[rank])
+    {
+      if (timer.ElapsedSeconds() > kMaxIncrementalPlacingTime)
+        return;
+
+      auto const & handle = handles[m_placedCounts[rank]];
+      ref_ptr<OverlayHandle> parentOverlay;
+      if (PrepareHandle(handle) && CheckHandle(handle, rank, parentOverlay))
+        InsertHandle(handle, rank, parentOverlay);
+
+      // A not-ready handle invalidates the tree, so all the handles will be placed again.
+      if (IsNeedUpdate())
+        return;
+
+      bool const isPlaced = m_handlesCache.find(handle) != m_handlesCache.end();
+      handle->SetDisplayFlag(isPlaced);
+      handle->SetIsVisible(isPlaced);
+      if (isPlaced)
+        handle->SetCachingEnable(false);
+    }
+  }
+
+  for (size_t rank = 0; rank < m_handles.size(); ++rank)
+    m_handles[rank].clear();
+  m_placedCounts.fill(0);
+}
+
 bool OverlayTree::CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                               ref_ptr<OverlayHandle> & parentOverlay) const
 {
@@ -364,7 +497,21 @@ void OverlayTree::DeleteHandle(ref_ptr<OverlayHandle> const & handle)
 {
   size_t const deletedCount = m_handlesCache.erase(handle);
   if (deletedCount != 0)
-    Erase(handle);
+  {
+    m_grid.Erase(handle);
+    HideDisplacedHandle(handle);
+  }
+}
+
+void OverlayTree::HideDisplacedHandle(ref_ptr<OverlayHandle> const & handle)
+{
+  // Visibility is updated at the end of the full placement, but the incremental placement
+  // displaces handles which are on the screen already.
+  if (IsNeedUpdate())
+    return;
+
+  handle->SetDisplayFlag(false);
+  handle->SetIsVisible(false);
 }
 
 void OverlayTree::DeleteHandleWithParents(ref_ptr<OverlayHandle> handle, int currentRank)
@@ -417,7 +564,7 @@ void OverlayTree::Select(m2::PointD const & glbPoint, TOverlayContainer & result
 void OverlayTree::Select(m2::RectD const & rect, TOverlayContainer & result) const
 {
   ScreenBase screen = GetModelView();
-  ForEachInRect(rect, [&](ref_ptr<OverlayHandle> const & h)
+  m_grid.ForEachInRect(rect, [&](ref_ptr<OverlayHandle> const & h)
   {
     if (!h->HasLinearFeatureShape() && h->IsVisible() && h->GetOverlayID().m_featureId.IsValid())
     {
@@ -445,7 +592,11 @@ void OverlayTree::SetDisplacementEnabled(bool enabled)
 
 void OverlayTree::SetSelectedFeature(FeatureID const & featureID)
 {
+  if (m_selectedFeatureID == featureID)
+    return;
   m_selectedFeatureID = featureID;
+  // The placement isn't updated periodically on the same screen.
+  InvalidateOnNextFrame();
 }
 
 OverlayTree::TDisplacementInfo const & OverlayTree::GetDisplacementInfo() const
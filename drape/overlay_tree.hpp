@@ -1,10 +1,10 @@
 #pragma once
 
 #include "drape/drape_diagnostics.hpp"
+#include "drape/overlay_grid.hpp"
 #include "drape/overlay_handle.hpp"
 
 #include "geometry/screenbase.hpp"
-#include "geometry/tree4d.hpp"
 
 #include "base/buffer_vector.hpp"
 
@@ -20,10 +20,6 @@ namespace detail
 class OverlayTraits
 {
 public:
-  m2::RectD const LimitRect(ref_ptr<OverlayHandle> const & handle)
-  {
-    return handle->GetExtendedPixelRect(m_modelView);
-  }
   ScreenBase const & GetModelView() const { return m_modelView; }
   m2::RectD const & GetExtendedScreenRect() const { return m_extendedScreenRect; }
   m2::RectD const & GetDisplacersFreeRect() const { return m_displacersFreeRect; }
@@ -53,25 +49,31 @@ class DebugRenderer;
 
 using TOverlayContainer = buffer_vector<ref_ptr<OverlayHandle>, 8>;
 
-class OverlayTree : public m4::Tree<ref_ptr<OverlayHandle>, detail::OverlayTraits>
+// Overlays are placed from scratch between StartOverlayPlacing() and EndOverlayPlacing()
+// when the tree is invalidated. While the screen isn't changed the placement stays valid,
+// handles which are added after it (e.g. from new tiles) are placed incrementally by
+// PlacePendingHandles() within the frame time budget, the rest of them waits for next frames.
+class OverlayTree
 {
-  using TBase = m4::Tree<ref_ptr<OverlayHandle>, detail::OverlayTraits>;
-
 public:
   using HandlesCache = std::unordered_set<ref_ptr<OverlayHandle>, detail::OverlayHasher>;
 
   explicit OverlayTree(double visualScale);
 
   void Clear();
-  bool Frame();
+  bool Frame(ScreenBase const & screen);
   bool IsNeedUpdate() const;
   void InvalidateOnNextFrame();
 
   void StartOverlayPlacing(ScreenBase const & screen, int zoomLevel);
+  // If the tree doesn't need update, the handle is placed by PlacePendingHandles().
   void Add(ref_ptr<OverlayHandle> handle);
   void Remove(ref_ptr<OverlayHandle> handle);
   void EndOverlayPlacing();
 
+  bool HasPendingHandles() const;
+  void PlacePendingHandles(ScreenBase const & screen);
+
   HandlesCache const & GetHandlesCache() const { return m_handlesCache; }
 
   void Select(m2::RectD const & rect, TOverlayContainer & result) const;
@@ -98,12 +100,16 @@ public:
   void SetDebugRectRenderer(ref_ptr<DebugRenderer> debugRectRenderer);
 
 private:
+  using HandlesList = std::vector<ref_ptr<OverlayHandle>>;
+
   ScreenBase const & GetModelView() const { return m_traits.GetModelView(); }
+  bool PrepareHandle(ref_ptr<OverlayHandle> handle);
   void InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                     ref_ptr<OverlayHandle> const & parentOverlay);
   bool CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                    ref_ptr<OverlayHandle> & parentOverlay) const;
   void DeleteHandle(ref_ptr<OverlayHandle> const & handle);
+  void HideDisplacedHandle(ref_ptr<OverlayHandle> const & handle);
 
   ref_ptr<OverlayHandle> FindParent(ref_ptr<OverlayHandle> handle, int searchingRank) const;
   void DeleteHandleWithParents(ref_ptr<OverlayHandle> handle, int currentRank);
@@ -111,9 +117,16 @@ private:
   void StoreDisplacementInfo(int caseIndex, ref_ptr<OverlayHandle> displacerHandle,
                              ref_ptr<OverlayHandle> displacedHandle);
   int m_frameCounter;
-  std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
+  detail::OverlayTraits m_traits;
+  OverlayGrid<ref_ptr<OverlayHandle>, detail::OverlayHasher> m_grid;
+  std::array<HandlesList, dp::OverlayRanksCount> m_handles;
   HandlesCache m_handlesCache;
 
+  // Handles which are added after the placement.
+  std::array<HandlesList, dp::OverlayRanksCount> m_pendingHandles;
+  // Counts of the placed handles of |m_handles| during the incremental placement.
+  std::array<size_t, dp::OverlayRanksCount> m_placedCounts = {};
+
   bool m_isDisplacementEnabled;
 
   FeatureID m_selectedFeatureID;
@@ -77,6 +77,24 @@ void SupportManager::Init(ref_ptr<GraphicsContext> context)
 //  }
 }
 
+// static
+bool SupportManager::IsTextureFormatSupported(ref_ptr<GraphicsContext> context, TextureFormat format)
+{
+  CHECK(context != nullptr, ());
+  if (!IsCompressedFormat(format))
+    return true;
+
+  ASSERT(format == TextureFormat::ETC2RGBA8, ());
+  // ETC2 is a mandatory format of OpenGL ES3 and Metal on iOS. Desktop drivers often decompress
+  // such textures on CPU, so compressed textures aren't used there.
+#if defined(OMIM_OS_MOBILE)
+  auto const apiVersion = context->GetApiVersion();
+  return apiVersion == dp::ApiVersion::OpenGLES3 || apiVersion == dp::ApiVersion::Metal;
+#else
+  return false;
+#endif
+}
+
 SupportManager & SupportManager::Instance()
 {
   static SupportManager manager;
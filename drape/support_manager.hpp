@@ -2,6 +2,7 @@
 
 #include "drape/graphics_context.hpp"
 #include "drape/pointers.hpp"
+#include "drape/texture_types.hpp"
 
 #include "base/macros.hpp"
 
@@ -24,6 +25,10 @@ public:
   int GetMaxLineWidth() const { return m_maxLineWidth; }
   bool IsAntialiasingEnabledByDefault() const { return m_isAntialiasingEnabledByDefault; }
 
+  // Textures are created on the backend renderer thread before Init() is called, so the support
+  // of texture formats is checked directly by the |context|.
+  static bool IsTextureFormatSupported(ref_ptr<GraphicsContext> context, TextureFormat format);
+
 private:
   SupportManager() = default;
 
@@ -1,4 +1,5 @@
 #include "drape/symbols_texture.hpp"
+#include "drape/ktx_image.hpp"
 #include "3party/stb_image/stb_image.h"
 
 #include "indexer/map_style_reader.hpp"
@@ -22,7 +23,8 @@ namespace dp
 namespace
 {
 using TDefinitionInserter = std::function<void(std::string const &, m2::RectF const &)>;
-using TSymbolsLoadingCompletion = std::function<void(unsigned char *, uint32_t, uint32_t)>;
+using TSymbolsLoadingCompletion =
+    std::function<void(unsigned char *, uint32_t, uint32_t, TextureFormat)>;
 using TSymbolsLoadingFailure = std::function<void(std::string const &)>;
 
 class DefinitionLoader
@@ -112,8 +114,28 @@ private:
   m2::RectF m_rect;
 };
 
+// Returns false if there is no compressed texture in the skin.
+bool ReadCompressedSymbols(std::string const & skinPathName, std::string const & textureName,
+                           KtxImage & image)
+{
+  std::vector<uint8_t> ktx;
+  try
+  {
+    ReaderPtr<Reader> reader =
+        GetStyleReader().GetResourceReader(textureName + ".ktx", skinPathName);
+    ktx.resize(static_cast<size_t>(reader.Size()));
+    reader.Read(0, ktx.data(), ktx.size());
+  }
+  catch (RootException const &)
+  {
+    return false;
+  }
+  return ReadKtxImage(ktx, image);
+}
+
 void LoadSymbols(std::string const & skinPathName, std::string const & textureName,
-                 bool convertToUV, TDefinitionInserter const & definitionInserter,
+                 bool convertToUV, bool allowCompressed,
+                 TDefinitionInserter const & definitionInserter,
                  TSymbolsLoadingCompletion const & completionHandler,
                  TSymbolsLoadingFailure const & failureHandler)
 {
@@ -142,6 +164,18 @@ void LoadSymbols(std::string const & skinPathName, std::string const & textureNa
       height = loader.GetHeight();
     }
 
+    // Compressed textures are optional, the skin may have PNG only.
+    KtxImage image;
+    if (allowCompressed && ReadCompressedSymbols(skinPathName, textureName, image))
+    {
+      if (image.m_width == width && image.m_height == height)
+      {
+        completionHandler(image.m_data.data(), width, height, image.m_format);
+        return;
+      }
+      LOG(LWARNING, ("Compressed symbols texture size mismatch", textureName, skinPathName));
+    }
+
     {
       ReaderPtr<Reader> reader =
           GetStyleReader().GetResourceReader(textureName + ".png", skinPathName);
@@ -165,7 +199,7 @@ void LoadSymbols(std::string const & skinPathName, std::string const & textureNa
 
   if (width == static_cast<uint32_t>(w) && height == static_cast<uint32_t>(h))
   {
-    completionHandler(data, width, height);
+    completionHandler(data, width, height, TextureFormat::RGBA8);
   }
   else
   {
@@ -203,45 +237,54 @@ SymbolsTexture::SymbolsTexture(ref_ptr<dp::GraphicsContext> context, std::string
                                std::string const & textureName, ref_ptr<HWTextureAllocator> allocator)
   : m_name(textureName)
 {
-  Load(context, skinPathName, allocator);
+  Skin skin;
+  DecodeSkin(skinPathName, m_name, false /* allowCompressed */, skin);
+  Load(context, std::move(skin), allocator);
 }
 
-void SymbolsTexture::Load(ref_ptr<dp::GraphicsContext> context, std::string const & skinPathName,
-                          ref_ptr<HWTextureAllocator> allocator)
+SymbolsTexture::SymbolsTexture(ref_ptr<dp::GraphicsContext> context, std::string const & textureName,
+                               Skin && skin, ref_ptr<HWTextureAllocator> allocator)
+  : m_name(textureName)
 {
-  auto definitionInserter = [this](std::string const & name, m2::RectF const & rect)
-  {
-    m_definition.insert(std::make_pair(name, SymbolsTexture::SymbolInfo(rect)));
-  };
+  Load(context, std::move(skin), allocator);
+}
 
-  auto completionHandler = [this, &allocator, context](unsigned char * data, uint32_t width, uint32_t height)
+void SymbolsTexture::Load(ref_ptr<dp::GraphicsContext> context, Skin && skin,
+                          ref_ptr<HWTextureAllocator> allocator)
+{
+  if (skin.m_data.empty())
   {
-    Texture::Params p;
-    p.m_allocator = allocator;
-    p.m_format = dp::TextureFormat::RGBA8;
-    p.m_width = width;
-    p.m_height = height;
+    Fail(context);
+    return;
+  }
 
-    Create(context, p, make_ref(data));
-  };
+  for (auto const & symbol : skin.m_definition)
+    m_definition.insert(std::make_pair(symbol.first, SymbolsTexture::SymbolInfo(symbol.second)));
 
-  auto failureHandler = [this, context](std::string const & reason)
-  {
-    LOG(LERROR, (reason));
-    Fail(context);
-  };
+  Texture::Params p;
+  p.m_allocator = allocator;
+  p.m_format = skin.m_format;
+  p.m_width = skin.m_width;
+  p.m_height = skin.m_height;
 
-  LoadSymbols(skinPathName, m_name, true /* convertToUV */, definitionInserter,
-              completionHandler, failureHandler);
+  Create(context, p, make_ref(skin.m_data.data()));
 }
 
 void SymbolsTexture::Invalidate(ref_ptr<dp::GraphicsContext> context, std::string const & skinPathName,
                                 ref_ptr<HWTextureAllocator> allocator)
+{
+  Skin skin;
+  DecodeSkin(skinPathName, m_name, false /* allowCompressed */, skin);
+  Invalidate(context, std::move(skin), allocator);
+}
+
+void SymbolsTexture::Invalidate(ref_ptr<dp::GraphicsContext> context, Skin && skin,
+                                ref_ptr<HWTextureAllocator> allocator)
 {
   Destroy();
   m_definition.clear();
 
-  Load(context, skinPathName, allocator);
+  Load(context, std::move(skin), allocator);
 }
 
 ref_ptr<Texture::ResourceInfo> SymbolsTexture::FindResource(Texture::Key const & key, bool & newResource)
@@ -287,7 +330,7 @@ bool SymbolsTexture::DecodeToMemory(std::string const & skinPathName, std::strin
 
   bool result = true;
   auto completionHandler = [&result, &symbolsSkin, &skinWidth, &skinHeight](unsigned char * data,
-      uint32_t width, uint32_t height)
+      uint32_t width, uint32_t height, TextureFormat /* format */)
   {
     size_t size = 4 * width * height;
     symbolsSkin.resize(size);
@@ -303,7 +346,37 @@ bool SymbolsTexture::DecodeToMemory(std::string const & skinPathName, std::strin
     result = false;
   };
 
-  LoadSymbols(skinPathName, textureName, false /* convertToUV */,
+  LoadSymbols(skinPathName, textureName, false /* convertToUV */, false /* allowCompressed */,
+              definitionInserter, completionHandler, failureHandler);
+  return result;
+}
+
+bool SymbolsTexture::DecodeSkin(std::string const & skinPathName, std::string const & textureName,
+                                bool allowCompressed, Skin & skin)
+{
+  auto definitionInserter = [&skin](std::string const & name, m2::RectF const & rect)
+  {
+    skin.m_definition.insert(std::make_pair(name, rect));
+  };
+
+  auto completionHandler = [&skin](unsigned char * data, uint32_t width, uint32_t height,
+                                   TextureFormat format)
+  {
+    skin.m_format = format;
+    skin.m_data.assign(data, data + GetBytesPerPixel(format) * width * height);
+    skin.m_width = width;
+    skin.m_height = height;
+  };
+
+  bool result = true;
+  auto failureHandler = [&result, &skin](std::string const & reason)
+  {
+    LOG(LERROR, (reason));
+    skin = {};
+    result = false;
+  };
+
+  LoadSymbols(skinPathName, textureName, true /* convertToUV */, allowCompressed,
               definitionInserter, completionHandler, failureHandler);
   return result;
 }
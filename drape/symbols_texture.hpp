@@ -29,13 +29,27 @@ public:
     ResourceType GetType() const override;
   };
 
+  // Decoded skin. Decoding doesn't use graphics API, so it may be done on any thread.
+  struct Skin
+  {
+    std::map<std::string, m2::RectF> m_definition;
+    TextureFormat m_format = TextureFormat::RGBA8;
+    std::vector<uint8_t> m_data;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+  };
+
   SymbolsTexture(ref_ptr<dp::GraphicsContext> context, std::string const & skinPathName,
                  std::string const & textureName, ref_ptr<HWTextureAllocator> allocator);
+  SymbolsTexture(ref_ptr<dp::GraphicsContext> context, std::string const & textureName,
+                 Skin && skin, ref_ptr<HWTextureAllocator> allocator);
 
   ref_ptr<ResourceInfo> FindResource(Key const & key, bool & newResource) override;
 
   void Invalidate(ref_ptr<dp::GraphicsContext> context, std::string const & skinPathName,
                   ref_ptr<HWTextureAllocator> allocator);
+  void Invalidate(ref_ptr<dp::GraphicsContext> context, Skin && skin,
+                  ref_ptr<HWTextureAllocator> allocator);
 
   bool IsSymbolContained(std::string const & symbolName) const;
 
@@ -43,9 +57,14 @@ public:
                              std::vector<uint8_t> & symbolsSkin,
                              std::map<std::string, m2::RectU> & symbolsIndex,
                              uint32_t & skinWidth, uint32_t & skinHeight);
+  // Returns false and empty |skin| on failure. If |allowCompressed| is true the compressed
+  // texture is loaded when it's available in the skin.
+  static bool DecodeSkin(std::string const & skinPathName, std::string const & textureName,
+                         bool allowCompressed, Skin & skin);
+
 private:
   void Fail(ref_ptr<dp::GraphicsContext> context);
-  void Load(ref_ptr<dp::GraphicsContext> context, std::string const & skinPathName,
+  void Load(ref_ptr<dp::GraphicsContext> context, Skin && skin,
             ref_ptr<HWTextureAllocator> allocator);
 
   using TSymDefinition = std::map<std::string, SymbolInfo>;
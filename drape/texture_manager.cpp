@@ -1,8 +1,10 @@
 #include "drape/texture_manager.hpp"
+#include "drape/drape_routine.hpp"
 #include "drape/symbols_texture.hpp"
 #include "drape/font_texture.hpp"
 #include "drape/static_texture.hpp"
 #include "drape/stipple_pen_resource.hpp"
+#include "drape/support_manager.hpp"
 #include "drape/texture_of_colors.hpp"
 #include "drape/gl_functions.hpp"
 #include "drape/utils/glyph_usage_tracker.hpp"
@@ -46,6 +48,41 @@ uint32_t const kDefaultSymbolsIndex = 0;
 
 namespace
 {
+using TSymbolSkins = std::vector<SymbolsTexture::Skin>;
+
+// Symbol skins are decoded from PNG on the routine threads in parallel. The returned results
+// must be waited before the skins are used.
+std::vector<DrapeRoutine::ResultPtr> DecodeSymbolSkinsAsync(std::string const & skinPathName,
+                                                            bool allowCompressed,
+                                                            TSymbolSkins & skins)
+{
+  skins.resize(ARRAY_SIZE(kSymbolTextures));
+
+  std::vector<DrapeRoutine::ResultPtr> results;
+  results.reserve(skins.size());
+  for (size_t i = 0; i < skins.size(); ++i)
+  {
+    auto & skin = skins[i];
+    auto const & textureName = kSymbolTextures[i];
+    auto result = DrapeRoutine::Run([skinPathName, textureName, allowCompressed, &skin]()
+    {
+      SymbolsTexture::DecodeSkin(skinPathName, textureName, allowCompressed, skin);
+    });
+
+    if (result)
+      results.push_back(result);
+    else
+      SymbolsTexture::DecodeSkin(skinPathName, textureName, allowCompressed, skin);
+  }
+  return results;
+}
+
+void WaitSymbolSkins(std::vector<DrapeRoutine::ResultPtr> const & results)
+{
+  for (auto const & result : results)
+    result->Wait();
+}
+
 void MultilineTextToUniString(TextureManager::TMultilineText const & text, strings::UniString & outString)
 {
   size_t cnt = 0;
@@ -489,12 +526,12 @@ void TextureManager::Init(ref_ptr<dp::GraphicsContext> context, Params const & p
     m_maxTextureSize = kMaxTextureSize;
   }
 
-  // Initialize symbols.
-  for (size_t i = 0; i < ARRAY_SIZE(kSymbolTextures); ++i)
-  {
-    m_symbolTextures.push_back(make_unique_dp<SymbolsTexture>(context, m_resPostfix, kSymbolTextures[i],
-                                                              make_ref(m_textureAllocator)));
-  }
+  // Symbols are decoded in background while the other resources are initialized.
+  TSymbolSkins symbolSkins;
+  m_useCompressedSymbols =
+      SupportManager::IsTextureFormatSupported(context, TextureFormat::ETC2RGBA8);
+  auto const symbolResults = DecodeSymbolSkinsAsync(m_resPostfix, m_useCompressedSymbols,
+                                                    symbolSkins);
 
   // Initialize static textures.
   m_trafficArrowTexture = make_unique_dp<StaticTexture>(context, "traffic-arrow", m_resPostfix,
@@ -545,6 +582,8 @@ void TextureManager::Init(ref_ptr<dp::GraphicsContext> context, Params const & p
 
   // Initialize glyphs.
   m_glyphManager = make_unique_dp<GlyphManager>(params.m_glyphMngParams);
+  if (!params.m_glyphsCachePath.empty())
+    m_glyphGenerator->LoadCache(params.m_glyphsCachePath, m_glyphManager->GetFingerprint());
 
   uint32_t const textureSquare = m_maxTextureSize * m_maxTextureSize;
   uint32_t const baseGlyphHeight =
@@ -570,18 +609,30 @@ void TextureManager::Init(ref_ptr<dp::GraphicsContext> context, Params const & p
       m_glyphGroups.push_back(GlyphGroup(start, end));
   });
 
+  // Initialize symbols.
+  WaitSymbolSkins(symbolResults);
+  for (size_t i = 0; i < symbolSkins.size(); ++i)
+  {
+    m_symbolTextures.push_back(make_unique_dp<SymbolsTexture>(context, kSymbolTextures[i],
+                                                              std::move(symbolSkins[i]),
+                                                              make_ref(m_textureAllocator)));
+  }
+
   m_nothingToUpload.clear();
 }
 
 void TextureManager::OnSwitchMapStyle(ref_ptr<dp::GraphicsContext> context)
 {
   // Here we need invalidate only textures which can be changed in map style switch.
+  TSymbolSkins symbolSkins;
+  WaitSymbolSkins(DecodeSymbolSkinsAsync(m_resPostfix, m_useCompressedSymbols, symbolSkins));
+  CHECK_EQUAL(symbolSkins.size(), m_symbolTextures.size(), ());
   for (size_t i = 0; i < m_symbolTextures.size(); ++i)
   {
     ASSERT(m_symbolTextures[i] != nullptr, ());
     ASSERT(dynamic_cast<SymbolsTexture *>(m_symbolTextures[i].get()) != nullptr, ());
     ref_ptr<SymbolsTexture> symbolsTexture = make_ref(m_symbolTextures[i]);
-    symbolsTexture->Invalidate(context, m_resPostfix, make_ref(m_textureAllocator));
+    symbolsTexture->Invalidate(context, std::move(symbolSkins[i]), make_ref(m_textureAllocator));
   }
 
   // Uncomment if static textures can be changed.
@@ -78,6 +78,8 @@ public:
     std::string m_colors;
     std::string m_patterns;
     GlyphManager::Params m_glyphMngParams;
+    // Path of the persistent cache of generated glyphs, the cache isn't used if it's empty.
+    std::string m_glyphsCachePath;
   };
 
   explicit TextureManager(ref_ptr<GlyphGenerator> glyphGenerator);
@@ -236,6 +238,7 @@ private:
 private:
   ref_ptr<GlyphGenerator> m_glyphGenerator;
   std::string m_resPostfix;
+  bool m_useCompressedSymbols = false;
   std::vector<drape_ptr<Texture>> m_symbolTextures;
   drape_ptr<Texture> m_stipplePenTexture;
   drape_ptr<Texture> m_colorTexture;
@@ -13,6 +13,8 @@ enum class TextureFormat : uint8_t
   RedGreen,
   DepthStencil,
   Depth,
+  // Compressed RGBA, see IsCompressedFormat().
+  ETC2RGBA8,
   Unspecified
 };
 
@@ -28,6 +30,15 @@ enum class TextureWrapping : uint8_t
   Repeat
 };
 
+// Compressed formats consist of blocks of kCompressedBlockSize x kCompressedBlockSize pixels.
+uint32_t constexpr kCompressedBlockSize = 4;
+
+inline bool IsCompressedFormat(TextureFormat format)
+{
+  return format == TextureFormat::ETC2RGBA8;
+}
+
+// Returns average size of a pixel for compressed formats.
 inline uint8_t GetBytesPerPixel(TextureFormat format)
 {
   uint8_t result = 0;
@@ -38,6 +49,7 @@ inline uint8_t GetBytesPerPixel(TextureFormat format)
   case TextureFormat::RedGreen: result = 2; break;
   case TextureFormat::DepthStencil: result = 4; break;
   case TextureFormat::Depth: result = 4; break;
+  case TextureFormat::ETC2RGBA8: result = 1; break;
   default: ASSERT(false, ()); break;
   }
   return result;
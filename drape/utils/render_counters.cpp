@@ -0,0 +1,18 @@
+#include "drape/utils/render_counters.hpp"
+
+namespace dp
+{
+RenderCounters & RenderCounters::Instance()
+{
+  static RenderCounters s_inst;
+  return s_inst;
+}
+
+RenderCounters::Snapshot RenderCounters::TakeSnapshot()
+{
+  Snapshot snapshot;
+  snapshot.m_drawCallsCount = m_drawCallsCount.exchange(0, std::memory_order_relaxed);
+  snapshot.m_uploadedBytes = m_uploadedBytes.exchange(0, std::memory_order_relaxed);
+  return snapshot;
+}
+}  // namespace dp
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace dp
+{
+// Counters of the work which is sent to GPU. Unlike GPUMemTracker they are cheap and collected
+// in all builds, so they can be used for runtime instrumentation.
+class RenderCounters
+{
+public:
+  struct Snapshot
+  {
+    uint64_t m_drawCallsCount = 0;
+    uint64_t m_uploadedBytes = 0;
+  };
+
+  static RenderCounters & Instance();
+
+  void AddDrawCall() { m_drawCallsCount.fetch_add(1, std::memory_order_relaxed); }
+  void AddUploadedBytes(uint64_t bytes)
+  {
+    m_uploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  // Returns the counters accumulated since the previous call and resets them.
+  Snapshot TakeSnapshot();
+
+private:
+  RenderCounters() = default;
+
+  // Draw calls are made on the rendering thread, data is uploaded from both rendering threads.
+  std::atomic<uint64_t> m_drawCallsCount = {0};
+  std::atomic<uint64_t> m_uploadedBytes = {0};
+
+  DISALLOW_COPY_AND_MOVE(RenderCounters);
+};
+}  // namespace dp
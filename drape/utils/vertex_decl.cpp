@@ -33,11 +33,11 @@ typedef dp::BindingInfo (*TInitFunction)();
 dp::BindingInfo AreaBindingInit()
 {
   static_assert(sizeof(AreaVertex) == (sizeof(AreaVertex::TPosition) +
-                                       sizeof(AreaVertex::TTexCoord)), "");
+                                       sizeof(AreaVertex::TPackedTexCoord)), "");
 
   dp::BindingFiller<AreaVertex> filler(2);
   filler.FillDecl<AreaVertex::TPosition>("a_position");
-  filler.FillDecl<AreaVertex::TTexCoord>("a_colorTexCoords");
+  filler.FillDecl<AreaVertex::TPackedTexCoord>("a_colorTexCoords");
 
   return filler.m_info;
 }
@@ -138,11 +138,11 @@ dp::BindingInfo LineBindingInit()
 {
   static_assert(sizeof(LineVertex) == sizeof(LineVertex::TPosition) +
                                       sizeof(LineVertex::TNormal) +
-                                      sizeof(LineVertex::TTexCoord), "");
+                                      sizeof(LineVertex::TPackedTexCoord), "");
   dp::BindingFiller<LineVertex> filler(3);
   filler.FillDecl<LineVertex::TPosition>("a_position");
   filler.FillDecl<LineVertex::TNormal>("a_normal");
-  filler.FillDecl<LineVertex::TTexCoord>("a_colorTexCoord");
+  filler.FillDecl<LineVertex::TPackedTexCoord>("a_colorTexCoord");
 
   return filler.m_info;
 }
@@ -240,12 +240,12 @@ dp::BindingInfo const & GetBinding(VertexType type)
 
 AreaVertex::AreaVertex()
   : m_position(0.0, 0.0, 0.0)
-  , m_colorTexCoord(0.0, 0.0)
+  , m_colorTexCoord(0, 0)
 {}
 
 AreaVertex::AreaVertex(TPosition const & position, TTexCoord const & colorTexCoord)
   : m_position(position)
-  , m_colorTexCoord(colorTexCoord)
+  , m_colorTexCoord(glsl::PackTexCoord(colorTexCoord))
 {}
 
 dp::BindingInfo const & AreaVertex::GetBindingInfo()
@@ -369,13 +369,13 @@ uint32_t TextDynamicVertex::GetDynamicStreamID()
 LineVertex::LineVertex()
   : m_position(0.0, 0.0, 0.0)
   , m_normal(0.0, 0.0, 0.0)
-  , m_colorTexCoord(0.0, 0.0)
+  , m_colorTexCoord(0, 0)
 {}
 
 LineVertex::LineVertex(TPosition const & position, TNormal const & normal, TTexCoord const & color)
   : m_position(position)
   , m_normal(normal)
-  , m_colorTexCoord(color)
+  , m_colorTexCoord(glsl::PackTexCoord(color))
 {}
 
 dp::BindingInfo const & LineVertex::GetBindingInfo()
@@ -15,6 +15,8 @@ struct BaseVertex
   using TNormal = glsl::vec2;
   using TNormal3d = glsl::vec3;
   using TTexCoord = glsl::vec2;
+  // Used by the largest buckets (lines and areas) to reduce memory.
+  using TPackedTexCoord = glsl::u16vec2;
 };
 
 struct AreaVertex : BaseVertex
@@ -23,7 +25,7 @@ struct AreaVertex : BaseVertex
   AreaVertex(TPosition const & position, TTexCoord const & colorTexCoord);
 
   TPosition m_position;
-  TTexCoord m_colorTexCoord;
+  TPackedTexCoord m_colorTexCoord;
 
   static dp::BindingInfo const & GetBindingInfo();
 };
@@ -134,7 +136,7 @@ struct LineVertex : BaseVertex
 
   TPosition m_position;
   TNormal m_normal;
-  TTexCoord m_colorTexCoord;
+  TPackedTexCoord m_colorTexCoord;
 
   static dp::BindingInfo const & GetBindingInfo();
 };
@@ -5,6 +5,7 @@
 #include "drape/gl_gpu_program.hpp"
 #include "drape/index_storage.hpp"
 #include "drape/support_manager.hpp"
+#include "drape/utils/render_counters.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
@@ -96,8 +97,8 @@ public:
         assert(attributeLocation != -1);
         GLFunctions::glEnableVertexAttribute(attributeLocation);
         GLFunctions::glVertexAttributePointer(attributeLocation, decl.m_componentCount,
-                                              decl.m_componentType, false, decl.m_stride,
-                                              decl.m_offset);
+                                              decl.m_componentType, decl.m_needNormalize,
+                                              decl.m_stride, decl.m_offset);
       }
     }
   }
@@ -188,6 +189,7 @@ void VertexArrayBuffer::RenderRange(ref_ptr<GraphicsContext> context,
 
     CHECK(m_impl != nullptr, ());
     m_impl->RenderRange(context, drawAsLine, range);
+    RenderCounters::Instance().AddDrawCall();
 
     Unbind();
   }
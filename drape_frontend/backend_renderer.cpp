@@ -1,7 +1,6 @@
 #include "drape_frontend/gui/drape_gui.hpp"
 
 #include "drape_frontend/backend_renderer.hpp"
-#include "drape_frontend/batchers_pool.hpp"
 #include "drape_frontend/circles_pack_shape.hpp"
 #include "drape_frontend/drape_api_builder.hpp"
 #include "drape_frontend/drape_measurer.hpp"
@@ -28,11 +27,17 @@ using namespace std::placeholders;
 
 namespace df
 {
+namespace
+{
+std::string const kGlyphsCacheFileName = "glyphs_cache.bin";
+}  // namespace
+
 BackendRenderer::BackendRenderer(Params && params)
   : BaseRenderer(ThreadsCommutator::ResourceUploadThread, params)
   , m_model(params.m_model)
   , m_readManager(make_unique_dp<ReadManager>(params.m_commutator, m_model,
                                               params.m_allow3dBuildings, params.m_trafficEnabled,
+                                              params.m_tileShapesCacheSize,
                                               std::move(params.m_isUGCFn)))
   , m_transitBuilder(make_unique_dp<TransitSchemeBuilder>(
         std::bind(&BackendRenderer::FlushTransitRenderData, this, _1)))
@@ -137,6 +142,13 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::Type::PrefetchTiles:
+    {
+      ref_ptr<PrefetchTilesMessage> msg = message;
+      m_readManager->Prefetch(msg->GetTiles(), m_texMng, make_ref(m_metalineManager));
+      break;
+    }
+
   case Message::Type::InvalidateReadManagerRect:
     {
       ref_ptr<InvalidateReadManagerRectMessage> msg = message;
@@ -173,21 +185,6 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
-  case Message::Type::TileReadStarted:
-    {
-      ref_ptr<TileReadStartMessage> msg = message;
-      m_batchersPool->ReserveBatcher(msg->GetKey());
-      break;
-    }
-
-  case Message::Type::TileReadEnded:
-    {
-      ref_ptr<TileReadEndMessage> msg = message;
-      CHECK(m_context != nullptr, ());
-      m_batchersPool->ReleaseBatcher(m_context, msg->GetKey());
-      break;
-    }
-
   case Message::Type::FinishTileRead:
     {
       ref_ptr<FinishTileReadMessage> msg = message;
@@ -220,56 +217,53 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
-  case Message::Type::MapShapeReaded:
+  case Message::Type::TileGeometryBatched:
     {
-      ref_ptr<MapShapeReadedMessage> msg = message;
+      ref_ptr<TileGeometryBatchedMessage> msg = message;
       auto const & tileKey = msg->GetKey();
       if (m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey))
       {
         CHECK(m_context != nullptr, ());
-        ref_ptr<dp::Batcher> batcher = m_batchersPool->GetBatcher(tileKey);
+        TTileRenderData renderData = msg->AcceptRenderData();
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
 #endif
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        // Shapes are batched by the reading threads, so buckets are only moved to GPU here.
+        for (auto & data : renderData)
         {
-          batcher->SetFeatureMinZoom(shape->GetFeatureMinZoom());
-          shape->Draw(m_context, batcher, m_texMng);
+          data.m_bucket->GetBuffer()->Preflush(m_context);
+          FlushGeometry(tileKey, data.m_state, std::move(data.m_bucket));
         }
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
-        DrapeMeasurer::Instance().EndShapesGeneration(static_cast<uint32_t>(msg->GetShapes().size()));
+        DrapeMeasurer::Instance().EndShapesGeneration(static_cast<uint32_t>(renderData.size()));
 #endif
       }
       break;
     }
 
-  case Message::Type::OverlayMapShapeReaded:
+  case Message::Type::TileOverlaysBatched:
     {
-      ref_ptr<OverlayMapShapeReadedMessage> msg = message;
+      ref_ptr<TileOverlaysBatchedMessage> msg = message;
       auto const & tileKey = msg->GetKey();
       if (m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey))
       {
         CHECK(m_context != nullptr, ());
         CleanupOverlays(tileKey);
 
+        TOverlaysRenderData renderData = msg->AcceptRenderData();
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartOverlayShapesGeneration();
 #endif
-        OverlayBatcher batcher(tileKey);
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
-          batcher.Batch(m_context, shape, m_texMng);
-
-        TOverlaysRenderData renderData;
-        batcher.Finish(m_context, renderData);
+        for (auto & data : renderData)
+          data.m_bucket->GetBuffer()->Preflush(m_context);
         if (!renderData.empty())
         {
           m_overlays.reserve(m_overlays.size() + renderData.size());
           std::move(renderData.begin(), renderData.end(), back_inserter(m_overlays));
         }
-
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().EndOverlayShapesGeneration(
-              static_cast<uint32_t>(msg->GetShapes().size()));
+              static_cast<uint32_t>(renderData.size()));
 #endif
       }
       break;
@@ -416,7 +410,8 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       if (m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey))
       {
         CHECK(m_context != nullptr, ());
-        m_trafficGenerator->FlushSegmentsGeometry(m_context, tileKey, msg->GetSegments(), m_texMng);
+        m_trafficGenerator->FlushSegmentsGeometry(m_context, tileKey, std::move(msg->GetSegments()),
+                                                  m_texMng);
       }
       break;
     }
@@ -424,9 +419,30 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::Type::UpdateTraffic:
     {
       ref_ptr<UpdateTrafficMessage> msg = message;
-      m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring());
+      auto const & coloring = msg->GetSegmentsColoring();
+      m_trafficGenerator->UpdateColoring(coloring);
+
+      // Tiles will be read again when the context is created.
+      if (m_context == nullptr)
+        break;
+
+      // Only traffic geometry is regenerated, tiles aren't read again.
+      std::vector<TileKey> tiles;
+      auto renderData = m_trafficGenerator->RegenerateSegmentsGeometry(
+          m_context, coloring, [this](TileKey const & tileKey)
+          {
+            return m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey);
+          }, m_texMng, tiles);
+
+      std::vector<MwmSet::MwmId> mwms;
+      mwms.reserve(coloring.size());
+      for (auto const & c : coloring)
+        mwms.push_back(c.first);
+
       m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                                make_unique_dp<RegenerateTrafficMessage>(),
+                                make_unique_dp<RegenerateTrafficMessage>(std::move(mwms),
+                                                                         std::move(tiles),
+                                                                         std::move(renderData)),
                                 MessagePriority::Normal);
       break;
     }
@@ -593,7 +609,6 @@ void BackendRenderer::ReleaseResources()
 
   m_readManager.reset();
   m_metalineManager.reset();
-  m_batchersPool.reset();
   m_routeBuilder.reset();
   m_overlays.clear();
   m_trafficGenerator.reset();
@@ -622,7 +637,6 @@ void BackendRenderer::OnContextDestroy()
 {
   LOG(LINFO, ("On context destroy."));
   m_readManager->Stop();
-  m_batchersPool.reset();
   m_metalineManager->Stop();
   m_texMng->Release();
   m_overlays.clear();
@@ -654,10 +668,6 @@ void BackendRenderer::Routine::Do()
 
 void BackendRenderer::InitContextDependentResources()
 {
-  uint32_t constexpr kBatchSize = 5000;
-  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(kReadingThreadsCount,
-                                               std::bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
-                                               kBatchSize, kBatchSize);
   m_trafficGenerator->Init();
 
   dp::TextureManager::Params params;
@@ -676,6 +686,7 @@ void BackendRenderer::InitContextDependentResources()
   params.m_glyphMngParams.m_sdfScale = VisualParams::Instance().GetGlyphSdfScale();
   params.m_glyphMngParams.m_baseGlyphHeight = VisualParams::Instance().GetGlyphBaseSize();
   GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+  params.m_glyphsCachePath = GetPlatform().WritablePathForFile(kGlyphsCacheFileName);
 
   CHECK(m_context != nullptr, ());
   m_texMng->Init(m_context, params);
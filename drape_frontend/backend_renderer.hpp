@@ -3,7 +3,6 @@
 #include "drape_frontend/gui/layer_render.hpp"
 
 #include "drape_frontend/base_renderer.hpp"
-#include "drape_frontend/batchers_pool.hpp"
 #include "drape_frontend/drape_api_builder.hpp"
 #include "drape_frontend/map_data_provider.hpp"
 #include "drape_frontend/overlay_batcher.hpp"
@@ -43,7 +42,7 @@ public:
            ref_ptr<dp::GraphicsContextFactory> factory, ref_ptr<dp::TextureManager> texMng,
            MapDataProvider const & model, TUpdateCurrentCountryFn const & updateCurrentCountryFn,
            ref_ptr<RequestedTiles> requestedTiles, bool allow3dBuildings, bool trafficEnabled,
-           bool simplifiedTrafficColors, TIsUGCFn && isUGCFn)
+           bool simplifiedTrafficColors, size_t tileShapesCacheSize, TIsUGCFn && isUGCFn)
       : BaseRenderer::Params(apiVersion, commutator, factory, texMng)
       , m_model(model)
       , m_updateCurrentCountryFn(updateCurrentCountryFn)
@@ -51,6 +50,7 @@ public:
       , m_allow3dBuildings(allow3dBuildings)
       , m_trafficEnabled(trafficEnabled)
       , m_simplifiedTrafficColors(simplifiedTrafficColors)
+      , m_tileShapesCacheSize(tileShapesCacheSize)
       , m_isUGCFn(std::move(isUGCFn))
     {}
 
@@ -60,6 +60,7 @@ public:
     bool m_allow3dBuildings;
     bool m_trafficEnabled;
     bool m_simplifiedTrafficColors;
+    size_t m_tileShapesCacheSize;
     TIsUGCFn m_isUGCFn;
   };
 
@@ -108,7 +109,6 @@ private:
   void CleanupOverlays(TileKey const & tileKey);
 
   MapDataProvider m_model;
-  drape_ptr<BatchersPool<TileKey, TileKeyStrictComparator>> m_batchersPool;
   drape_ptr<ReadManager> m_readManager;
   drape_ptr<RouteBuilder> m_routeBuilder;
   drape_ptr<TransitSchemeBuilder> m_transitBuilder;
@@ -99,6 +99,7 @@ DrapeEngine::DrapeEngine(Params && params)
                                    params.m_allow3dBuildings,
                                    params.m_trafficEnabled,
                                    params.m_simplifiedTrafficColors,
+                                   params.m_hints.m_tileShapesCacheSize,
                                    std::move(params.m_isUGCFn));
 
   m_backend = make_unique_dp<BackendRenderer>(std::move(brParams));
@@ -697,14 +698,9 @@ void DrapeEngine::EnableTraffic(bool trafficEnabled)
 
 void DrapeEngine::UpdateTraffic(traffic::TrafficInfo const & info)
 {
-  if (info.GetColoring().empty())
+  if (info.GetColoring().IsEmpty())
     return;
 
-#ifdef DEBUG
-  for (auto const & segmentPair : info.GetColoring())
-    ASSERT_NOT_EQUAL(segmentPair.second, traffic::SpeedGroup::Unknown, ());
-#endif
-
   df::TrafficSegmentsColoring segmentsColoring;
   segmentsColoring.emplace(info.GetMwmId(), info.GetColoring());
 
@@ -829,6 +825,11 @@ void DrapeEngine::ShowDebugInfo(bool shown)
                                   MessagePriority::Normal);
 }
 
+DrapeMeasurer::FrameStatistic DrapeEngine::TakeFrameStatistic() const
+{
+  return DrapeMeasurer::Instance().TakeFrameStatistic();
+}
+
 void DrapeEngine::EnableDebugRectRendering(bool enabled)
 {
   m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
@@ -870,6 +871,10 @@ drape_ptr<UserLineRenderParams> DrapeEngine::GenerateLineRenderInfo(UserLineMark
   renderInfo->m_minZoom = mark->GetMinZoom();
   renderInfo->m_depthLayer = mark->GetDepthLayer();
   renderInfo->m_spline = m2::SharedSpline(mark->GetPoints());
+  auto const & simplifiedPoints = mark->GetSimplifiedPoints();
+  renderInfo->m_simplifiedSplines.reserve(simplifiedPoints.size());
+  for (auto const & level : simplifiedPoints)
+    renderInfo->m_simplifiedSplines.emplace_back(level.first, m2::SharedSpline(level.second));
   renderInfo->m_layers.reserve(mark->GetLayerCount());
   for (size_t layerIndex = 0, layersCount = mark->GetLayerCount(); layerIndex < layersCount; ++layerIndex)
   {
@@ -4,6 +4,7 @@
 #include "drape_frontend/color_constants.hpp"
 #include "drape_frontend/custom_features_context.hpp"
 #include "drape_frontend/drape_hints.hpp"
+#include "drape_frontend/drape_measurer.hpp"
 #include "drape_frontend/frontend_renderer.hpp"
 #include "drape_frontend/route_shape.hpp"
 #include "drape_frontend/overlays_tracker.hpp"
@@ -228,6 +229,9 @@ public:
 
   void ShowDebugInfo(bool shown);
 
+  // Returns the statistic of frames which are rendered since the previous call.
+  DrapeMeasurer::FrameStatistic TakeFrameStatistic() const;
+
 private:
   void AddUserEvent(drape_ptr<UserEvent> && e);
   void PostUserEvent(drape_ptr<UserEvent> && e);
@@ -0,0 +1,48 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/frame_quality_controller.hpp"
+
+using namespace df;
+
+namespace
+{
+using Quality = FrameQualityController::Quality;
+
+double constexpr kBudget = 0.03;
+double constexpr kRestoringTime = 0.015;
+
+// Returns the number of quality changes.
+uint32_t RenderFrames(FrameQualityController & controller, double renderTime, uint32_t count)
+{
+  uint32_t changes = 0;
+  for (uint32_t i = 0; i < count; ++i)
+    changes += controller.OnFrameRendered(renderTime) ? 1 : 0;
+  return changes;
+}
+}  // namespace
+
+UNIT_TEST(FrameQualityController_Smoke)
+{
+  FrameQualityController controller(kBudget, kRestoringTime);
+  TEST(controller.GetQuality() == Quality::High, ());
+
+  // Frames within the budget don't change quality.
+  TEST_EQUAL(RenderFrames(controller, 0.02, 500), 0, ());
+  TEST(controller.GetQuality() == Quality::High, ());
+
+  // Slow frames lower the quality step by step.
+  TEST_EQUAL(RenderFrames(controller, 0.05, FrameQualityController::kMinFramesBetweenChanges), 1, ());
+  TEST(controller.GetQuality() == Quality::Medium, ());
+  TEST_EQUAL(RenderFrames(controller, 0.05, FrameQualityController::kMinFramesBetweenChanges), 1, ());
+  TEST(controller.GetQuality() == Quality::Low, ());
+  TEST_EQUAL(RenderFrames(controller, 0.05, 500), 0, ());
+  TEST(controller.GetQuality() == Quality::Low, ());
+
+  // Quality isn't restored immediately when frames become fast.
+  TEST_EQUAL(RenderFrames(controller, 0.005, FrameQualityController::kMinFramesBetweenChanges), 0, ());
+  TEST(controller.GetQuality() == Quality::Low, ());
+  TEST_EQUAL(RenderFrames(controller, 0.005, FrameQualityController::kMinFramesBeforeRestoring), 1, ());
+  TEST(controller.GetQuality() == Quality::Medium, ());
+  TEST_EQUAL(RenderFrames(controller, 0.005, 1000), 1, ());
+  TEST(controller.GetQuality() == Quality::High, ());
+}
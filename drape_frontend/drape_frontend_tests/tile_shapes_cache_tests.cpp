@@ -0,0 +1,58 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include <memory>
+
+using namespace df;
+
+namespace
+{
+std::shared_ptr<TileShapesCache::Entry const> MakeEntry(int8_t deviceLang)
+{
+  auto entry = std::make_shared<TileShapesCache::Entry>();
+  entry->m_shapes.emplace_back(false /* overlays */, std::make_shared<TMapShapes const>());
+  entry->m_deviceLang = deviceLang;
+  return entry;
+}
+}  // namespace
+
+UNIT_TEST(TileShapesCache_Smoke)
+{
+  TileShapesCache cache(2 /* maxTilesCount */);
+  TileKey const tile1(1, 1, 10);
+  TileKey const tile2(2, 1, 10);
+  TileKey const tile3(3, 1, 10);
+
+  auto epoch = cache.GetEpoch();
+  cache.Add(tile1, epoch, MakeEntry(0 /* deviceLang */));
+  cache.Add(tile2, epoch, MakeEntry(0 /* deviceLang */));
+
+  // Generations of tiles are ignored.
+  TEST(cache.Find(TileKey(tile1, 5 /* generation */, 5 /* userMarksGeneration */), 0), ());
+  TEST(!cache.Find(tile1, 1 /* deviceLang */), ());
+
+  // The least recently used tile is removed.
+  cache.Add(tile3, epoch, MakeEntry(0 /* deviceLang */));
+  TEST(cache.Find(tile1, 0), ());
+  TEST(!cache.Find(tile2, 0), ());
+  TEST(cache.Find(tile3, 0), ());
+
+  cache.Erase({tile1});
+  TEST(!cache.Find(tile1, 0), ());
+  TEST(cache.Find(tile3, 0), ());
+
+  // Tiles which were requested before erasing aren't added.
+  cache.Add(tile1, epoch, MakeEntry(0 /* deviceLang */));
+  TEST(!cache.Find(tile1, 0), ());
+
+  epoch = cache.GetEpoch();
+  cache.Add(tile1, epoch, MakeEntry(0 /* deviceLang */));
+  TEST(cache.Find(tile1, 0), ());
+
+  cache.Clear();
+  TEST(!cache.Find(tile1, 0), ());
+  TEST(!cache.Find(tile3, 0), ());
+  cache.Add(tile1, epoch, MakeEntry(0 /* deviceLang */));
+  TEST(!cache.Find(tile1, 0), ());
+}
@@ -0,0 +1,40 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_utils.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <vector>
+
+using namespace df;
+
+UNIT_TEST(TileUtils_GetTilesAlongPath)
+{
+  int const kZoom = 10;
+  double const tileSize = (MercatorBounds::maxX - MercatorBounds::minX) / (1 << (kZoom - 1));
+  std::vector<m2::PointD> const path = {m2::PointD(0.5 * tileSize, 0.5 * tileSize),
+                                        m2::PointD(3.5 * tileSize, 0.5 * tileSize)};
+  double const radius = 0.1 * tileSize;
+
+  std::vector<TileKey> const expected = {TileKey(0, 0, kZoom), TileKey(1, 0, kZoom),
+                                         TileKey(2, 0, kZoom), TileKey(3, 0, kZoom)};
+  TEST_EQUAL(GetTilesAlongPath(path, radius, kZoom, {} /* exceptTiles */, 10 /* maxCount */),
+             expected, ());
+
+  std::vector<TileKey> const reversedPath = {TileKey(3, 0, kZoom), TileKey(2, 0, kZoom),
+                                             TileKey(1, 0, kZoom), TileKey(0, 0, kZoom)};
+  TEST_EQUAL(GetTilesAlongPath({path[1], path[0]}, radius, kZoom, {} /* exceptTiles */,
+                               10 /* maxCount */),
+             reversedPath, ());
+
+  TTilesCollection const exceptTiles = {TileKey(1, 0, kZoom)};
+  TEST_EQUAL(GetTilesAlongPath(path, radius, kZoom, exceptTiles, 2 /* maxCount */),
+             std::vector<TileKey>({TileKey(0, 0, kZoom), TileKey(2, 0, kZoom)}), ());
+
+  // Neighbours of the path are taken in the order of the path too.
+  auto const tiles = GetTilesAlongPath(path, tileSize, kZoom, {} /* exceptTiles */,
+                                       100 /* maxCount */);
+  TEST_EQUAL(tiles.size(), 18, ());
+  TEST_EQUAL(tiles.front(), TileKey(0, 0, kZoom), ());
+  TEST_EQUAL(tiles.back().m_x, 4, ());
+}
@@ -0,0 +1,49 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/user_mark_generator.hpp"
+
+using namespace df;
+
+namespace
+{
+void AddMark(kml::MarkId id, m2::PointD const & pivot, UserMarksRenderCollection & marks,
+             kml::MarkIdCollection & ids)
+{
+  auto params = make_unique_dp<UserMarkRenderParams>();
+  params->m_pivot = pivot;
+  marks.emplace(id, std::move(params));
+  ids.push_back(id);
+}
+}  // namespace
+
+UNIT_TEST(ClusterUserMarks_Smoke)
+{
+  TileKey const tileKey(0, 0, 5);
+  m2::RectD const rect = tileKey.GetGlobalRect();
+
+  UserMarksRenderCollection marks;
+  kml::MarkIdCollection ids;
+  // All marks are in the same corner of the tile.
+  m2::PointD const size(rect.SizeX(), rect.SizeY());
+  for (kml::MarkId id = 0; id < 100; ++id)
+    AddMark(id, rect.LeftBottom() + size * (0.0001 * id), marks, ids);
+  // The mark in the opposite corner.
+  AddMark(100, rect.RightTop() - size * 0.01, marks, ids);
+
+  kml::MarkIdCollection clusteredIds;
+  TEST(ClusterUserMarks(tileKey, ids, marks, clusteredIds), ());
+  TEST_EQUAL(clusteredIds, kml::MarkIdCollection({0, 100}), ());
+
+  // Just created marks aren't clustered.
+  marks[50]->m_justCreated = true;
+  TEST(ClusterUserMarks(tileKey, ids, marks, clusteredIds), ());
+  TEST_EQUAL(clusteredIds, kml::MarkIdCollection({0, 50, 100}), ());
+
+  // Marks aren't clustered on high zoom levels.
+  TEST(!ClusterUserMarks(TileKey(0, 0, 15), ids, marks, clusteredIds), ());
+  TEST(clusteredIds.empty(), ());
+
+  // Sparse marks aren't clustered.
+  ids.resize(10);
+  TEST(!ClusterUserMarks(tileKey, ids, marks, clusteredIds), ());
+}
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstddef>
+
 namespace df
 {
 struct Hints
 {
   bool m_isFirstLaunch = false;
   bool m_isLaunchByDeepLink = false;
+  // Number of recently read tiles whose shapes are reused when the tiles are shown again,
+  // 0 disables the cache. Useful for displays which show the same areas all the time.
+  size_t m_tileShapesCacheSize = 0;
 };
 }  // namespace df
@@ -1,6 +1,10 @@
 #include "drape_frontend/drape_measurer.hpp"
 
+#include "drape/utils/render_counters.hpp"
+
+#include <algorithm>
 #include <iomanip>
+#include <sstream>
 
 namespace df
 {
@@ -480,4 +484,81 @@ DrapeMeasurer::DrapeStatistic DrapeMeasurer::GetDrapeStatistic()
 #endif
   return statistic;
 }
+
+std::string DrapeMeasurer::FrameStatistic::ToString() const
+{
+  std::ostringstream ss;
+  ss << " ----- Frame statistic report ----- \n";
+  ss << " Frames count = " << m_framesCount << "\n";
+  ss << " Avg frame time, ms = " << m_avgFrameTimeInMs << "\n";
+  ss << " Max frame time, ms = " << m_maxFrameTimeInMs << "\n";
+  ss << " Avg draw calls count = " << m_avgDrawCallsCount << "\n";
+  ss << " Uploaded to GPU, bytes = " << m_uploadedBytes << "\n";
+  for (size_t i = 0; i < m_avgLayerTimeInMs.size(); ++i)
+  {
+    if (m_avgLayerTimeInMs[i] > 0.0)
+    {
+      ss << " " << DebugPrint(static_cast<DepthLayer>(i)) << " avg time, ms = "
+         << m_avgLayerTimeInMs[i] << "\n";
+    }
+  }
+  ss << " ----- Frame statistic report ----- \n";
+
+  return ss.str();
+}
+
+void DrapeMeasurer::StartFrameRendering()
+{
+  m_startFrameTime = std::chrono::steady_clock::now();
+  m_frameLayersTime.fill(std::chrono::nanoseconds::zero());
+}
+
+void DrapeMeasurer::EndFrameRendering()
+{
+  auto const frameTime = std::chrono::steady_clock::now() - m_startFrameTime;
+
+  std::lock_guard<std::mutex> lock(m_framesMutex);
+  ++m_framesCount;
+  m_totalFramesTime += frameTime;
+  m_maxFrameTime = std::max(m_maxFrameTime, std::chrono::nanoseconds(frameTime));
+  for (size_t i = 0; i < m_totalLayersTime.size(); ++i)
+    m_totalLayersTime[i] += m_frameLayersTime[i];
+}
+
+void DrapeMeasurer::AddLayerRenderingTime(DepthLayer layer, std::chrono::nanoseconds time)
+{
+  m_frameLayersTime[static_cast<size_t>(layer)] += time;
+}
+
+DrapeMeasurer::FrameStatistic DrapeMeasurer::TakeFrameStatistic()
+{
+  using namespace std::chrono;
+
+  auto const toMs = [](nanoseconds const & time)
+  {
+    return duration_cast<duration<double, std::milli>>(time).count();
+  };
+
+  auto const counters = dp::RenderCounters::Instance().TakeSnapshot();
+
+  FrameStatistic statistic;
+  statistic.m_uploadedBytes = counters.m_uploadedBytes;
+
+  std::lock_guard<std::mutex> lock(m_framesMutex);
+  statistic.m_framesCount = m_framesCount;
+  if (m_framesCount != 0)
+  {
+    statistic.m_avgFrameTimeInMs = toMs(m_totalFramesTime) / m_framesCount;
+    statistic.m_maxFrameTimeInMs = toMs(m_maxFrameTime);
+    statistic.m_avgDrawCallsCount = static_cast<double>(counters.m_drawCallsCount) / m_framesCount;
+    for (size_t i = 0; i < m_totalLayersTime.size(); ++i)
+      statistic.m_avgLayerTimeInMs[i] = toMs(m_totalLayersTime[i]) / m_framesCount;
+  }
+
+  m_framesCount = 0;
+  m_totalFramesTime = nanoseconds::zero();
+  m_maxFrameTime = nanoseconds::zero();
+  m_totalLayersTime.fill(nanoseconds::zero());
+  return statistic;
+}
 }  // namespace df
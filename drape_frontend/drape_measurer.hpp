@@ -1,5 +1,7 @@
 #pragma once
 
+#include "drape_frontend/render_state_extension.hpp"
+
 #include "drape/drape_diagnostics.hpp"
 #include "drape/utils/gpu_mem_tracker.hpp"
 #include "drape/utils/glyph_usage_tracker.hpp"
@@ -7,6 +9,7 @@
 #include "base/thread.hpp"
 #include "base/timer.hpp"
 
+#include <array>
 #include <chrono>
 #include <map>
 #include <memory>
@@ -124,6 +127,31 @@ public:
 
   DrapeStatistic GetDrapeStatistic();
 
+  // Statistic of rendered frames. Unlike the statistics above it's collected in all builds.
+  struct FrameStatistic
+  {
+    std::string ToString() const;
+
+    uint32_t m_framesCount = 0;
+    // CPU time of scene rendering.
+    double m_avgFrameTimeInMs = 0.0;
+    double m_maxFrameTimeInMs = 0.0;
+    double m_avgDrawCallsCount = 0.0;
+    // Data which is uploaded to GPU by both renderers.
+    uint64_t m_uploadedBytes = 0;
+    // Average CPU time of rendering of a layer per frame.
+    std::array<double, static_cast<size_t>(DepthLayer::LayersCount)> m_avgLayerTimeInMs = {};
+  };
+
+  // These methods must be called on the frontend renderer thread.
+  void StartFrameRendering();
+  void EndFrameRendering();
+  void AddLayerRenderingTime(DepthLayer layer, std::chrono::nanoseconds time);
+
+  // Returns the statistic which is collected since the previous call and resets it.
+  // The method is thread-safe.
+  FrameStatistic TakeFrameStatistic();
+
 private:
   DrapeMeasurer() = default;
 
@@ -174,6 +202,17 @@ private:
   uint32_t m_totalFramesCount = 0;
 #endif
 
+  using LayersTime = std::array<std::chrono::nanoseconds, static_cast<size_t>(DepthLayer::LayersCount)>;
+
+  std::chrono::time_point<std::chrono::steady_clock> m_startFrameTime;
+  LayersTime m_frameLayersTime = {};
+
+  std::mutex m_framesMutex;
+  uint32_t m_framesCount = 0;
+  std::chrono::nanoseconds m_totalFramesTime = {};
+  std::chrono::nanoseconds m_maxFrameTime = {};
+  LayersTime m_totalLayersTime = {};
+
 #ifdef TRACK_GPU_MEM
   void TakeGPUMemorySnapshot();
 
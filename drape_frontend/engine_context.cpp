@@ -3,6 +3,8 @@
 #include "drape_frontend/message_subclasses.hpp"
 #include "drape/texture_manager.hpp"
 
+#include "base/assert.hpp"
+
 #include <utility>
 
 namespace df
@@ -15,7 +17,9 @@ EngineContext::EngineContext(TileKey tileKey,
                              bool is3dBuildingsEnabled,
                              bool isTrafficEnabled,
                              int displacementMode,
-                             TIsUGCFn const & isUGCFn)
+                             TIsUGCFn const & isUGCFn,
+                             ref_ptr<TileShapesCache> shapesCache,
+                             bool isPrefetching)
   : m_tileKey(tileKey)
   , m_commutator(commutator)
   , m_texMng(texMng)
@@ -25,7 +29,12 @@ EngineContext::EngineContext(TileKey tileKey,
   , m_trafficEnabled(isTrafficEnabled)
   , m_displacementMode(displacementMode)
   , m_isUGCFn(isUGCFn)
-{}
+  , m_shapesCache(shapesCache)
+  , m_shapesCacheEpoch(shapesCache != nullptr ? shapesCache->GetEpoch() : 0)
+  , m_isPrefetching(isPrefetching)
+{
+  ASSERT(!m_isPrefetching || m_shapesCache != nullptr, ());
+}
 
 ref_ptr<dp::TextureManager> EngineContext::GetTextureManager() const
 {
@@ -39,21 +48,33 @@ ref_ptr<MetalineManager> EngineContext::GetMetalineManager() const
 
 void EngineContext::BeginReadTile()
 {
-  PostMessage(make_unique_dp<TileReadStartMessage>(m_tileKey));
+  // Shapes of prefetched tiles are only cached.
+  if (!m_isPrefetching)
+    m_batcher = make_unique_dp<TileBatcher>();
 }
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapes)));
+  auto sharedShapes = std::make_shared<TMapShapes const>(std::move(shapes));
+  if (m_cacheEntry)
+    m_cacheEntry->m_shapes.emplace_back(false /* overlays */, sharedShapes);
+  BatchShapes(*sharedShapes);
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapes)));
+  auto sharedShapes = std::make_shared<TMapShapes const>(std::move(shapes));
+  if (m_cacheEntry)
+    m_cacheEntry->m_shapes.emplace_back(true /* overlays */, sharedShapes);
+  BatchOverlays(*sharedShapes);
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
+  if (m_cacheEntry)
+    m_cacheEntry->m_trafficGeometry = geometry;
+  if (m_isPrefetching)
+    return;
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                             make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(geometry)),
                             MessagePriority::Low);
@@ -61,11 +82,83 @@ void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 
 void EngineContext::EndReadTile()
 {
-  PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey));
+  if (m_batcher == nullptr)
+    return;
+
+  TTileRenderData renderData;
+  m_batcher->Finish(renderData);
+  m_batcher.reset();
+  if (!renderData.empty())
+    PostMessage(make_unique_dp<TileGeometryBatchedMessage>(m_tileKey, std::move(renderData)));
+}
+
+bool EngineContext::FlushCachedShapes(int8_t deviceLang)
+{
+  if (m_shapesCache == nullptr)
+    return false;
+
+  auto const entry = m_shapesCache->Find(m_tileKey, deviceLang);
+  if (entry == nullptr)
+  {
+    m_cacheEntry = std::make_shared<TileShapesCache::Entry>();
+    m_cacheEntry->m_deviceLang = deviceLang;
+    return false;
+  }
+
+  if (m_isPrefetching)
+    return true;
+
+  for (auto const & shapes : entry->m_shapes)
+  {
+    if (shapes.first)
+      BatchOverlays(*shapes.second);
+    else
+      BatchShapes(*shapes.second);
+  }
+
+  auto geometry = entry->m_trafficGeometry;
+  FlushTrafficGeometry(std::move(geometry));
+  return true;
+}
+
+void EngineContext::CacheShapes()
+{
+  if (m_cacheEntry == nullptr)
+    return;
+
+  m_shapesCache->Add(m_tileKey, m_shapesCacheEpoch, std::move(m_cacheEntry));
+}
+
+void EngineContext::BatchShapes(TMapShapes const & shapes)
+{
+  if (m_batcher == nullptr)
+    return;
+
+  TTileRenderData renderData;
+  m_batcher->Batch(shapes, m_texMng, renderData);
+  if (!renderData.empty())
+    PostMessage(make_unique_dp<TileGeometryBatchedMessage>(m_tileKey, std::move(renderData)));
+}
+
+void EngineContext::BatchOverlays(TMapShapes const & shapes)
+{
+  if (m_batcher == nullptr)
+    return;
+
+  OverlayBatcher batcher(m_tileKey);
+  for (auto const & shape : shapes)
+    batcher.Batch(shape, m_texMng);
+
+  // Overlays are posted even if there are none, so the outdated ones of the tile are removed.
+  TOverlaysRenderData renderData;
+  batcher.Finish(renderData);
+  PostMessage(make_unique_dp<TileOverlaysBatchedMessage>(m_tileKey, std::move(renderData)));
 }
 
 void EngineContext::PostMessage(drape_ptr<Message> && message)
 {
+  if (m_isPrefetching)
+    return;
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, std::move(message),
                             MessagePriority::Normal);
 }
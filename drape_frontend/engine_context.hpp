@@ -4,12 +4,16 @@
 #include "drape_frontend/map_shape.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_batcher.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/traffic_generator.hpp"
 
 #include "drape/constants.hpp"
 #include "drape/pointers.hpp"
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 
 namespace dp
 {
@@ -33,24 +37,37 @@ public:
                 bool is3dBuildingsEnabled,
                 bool isTrafficEnabled,
                 int displacementMode,
-                TIsUGCFn const & isUGCFn);
+                TIsUGCFn const & isUGCFn,
+                ref_ptr<TileShapesCache> shapesCache = nullptr,
+                bool isPrefetching = false);
 
   TileKey const & GetTileKey() const { return m_tileKey; }
   bool Is3dBuildingsEnabled() const { return m_3dBuildingsEnabled; }
   bool IsTrafficEnabled() const { return m_trafficEnabled; }
   bool IsUGC(FeatureID const & fid) { return m_isUGCFn ? m_isUGCFn(fid) : false; }
   int GetDisplacementMode() const { return m_displacementMode; }
+  // Shapes of prefetched tiles are only cached, nothing is posted to the backend renderer.
+  bool IsPrefetching() const { return m_isPrefetching; }
   CustomFeaturesContextWeakPtr GetCustomFeaturesContext() const { return m_customFeaturesContext; }
   ref_ptr<dp::TextureManager> GetTextureManager() const;
   ref_ptr<MetalineManager> GetMetalineManager() const;
 
+  // Shapes are batched on the calling thread, only buckets are posted to the backend renderer.
   void BeginReadTile();
   void Flush(TMapShapes && shapes);
   void FlushOverlays(TMapShapes && shapes);
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
   void EndReadTile();
 
+  // Posts the cached shapes of the tile if they are read for |deviceLang|. Otherwise returns
+  // false and records the flushed shapes until CacheShapes() is called.
+  bool FlushCachedShapes(int8_t deviceLang);
+  // Caches the recorded shapes, must be called only if the tile is read completely.
+  void CacheShapes();
+
 private:
+  void BatchShapes(TMapShapes const & shapes);
+  void BatchOverlays(TMapShapes const & shapes);
   void PostMessage(drape_ptr<Message> && message);
 
   TileKey m_tileKey;
@@ -62,5 +79,12 @@ private:
   bool m_trafficEnabled;
   int m_displacementMode;
   TIsUGCFn m_isUGCFn;
+  ref_ptr<TileShapesCache> m_shapesCache;
+  // Epoch of the cache when the tile was requested, so shapes which are read with
+  // outdated parameters aren't cached.
+  uint64_t m_shapesCacheEpoch = 0;
+  std::shared_ptr<TileShapesCache::Entry> m_cacheEntry;
+  bool m_isPrefetching;
+  drape_ptr<TileBatcher> m_batcher;
 };
 }  // namespace df
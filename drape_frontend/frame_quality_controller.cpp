@@ -0,0 +1,73 @@
+#include "drape_frontend/frame_quality_controller.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+namespace df
+{
+namespace
+{
+// Weight of the last frame in the average render time.
+double constexpr kAverageFactor = 0.1;
+}  // namespace
+
+// static
+uint32_t constexpr FrameQualityController::kMinFramesBetweenChanges;
+uint32_t constexpr FrameQualityController::kMinFramesBeforeRestoring;
+
+FrameQualityController::FrameQualityController(double frameBudget, double restoringFrameTime)
+  : m_frameBudget(frameBudget)
+  , m_restoringFrameTime(restoringFrameTime)
+{
+  ASSERT_LESS(m_restoringFrameTime, m_frameBudget, ());
+}
+
+bool FrameQualityController::OnFrameRendered(double renderTime)
+{
+  if (m_framesCount == 0)
+    m_averageRenderTime = renderTime;
+  else
+    m_averageRenderTime += kAverageFactor * (renderTime - m_averageRenderTime);
+  ++m_framesCount;
+
+  if (m_averageRenderTime < m_restoringFrameTime)
+    ++m_fastFramesCount;
+  else
+    m_fastFramesCount = 0;
+
+  if (m_framesCount < kMinFramesBetweenChanges)
+    return false;
+
+  auto newQuality = m_quality;
+  if (m_averageRenderTime > m_frameBudget && m_quality != Quality::Low)
+  {
+    newQuality = static_cast<Quality>(static_cast<uint8_t>(m_quality) - 1);
+  }
+  else if (m_averageRenderTime < m_restoringFrameTime && m_quality != Quality::High &&
+           m_fastFramesCount >= kMinFramesBeforeRestoring)
+  {
+    newQuality = static_cast<Quality>(static_cast<uint8_t>(m_quality) + 1);
+  }
+
+  if (newQuality == m_quality)
+    return false;
+
+  LOG(LINFO, ("Rendering quality is changed to", DebugPrint(newQuality), "average render time",
+              m_averageRenderTime));
+  m_quality = newQuality;
+  m_framesCount = 0;
+  m_fastFramesCount = 0;
+  return true;
+}
+
+std::string DebugPrint(FrameQualityController::Quality quality)
+{
+  switch (quality)
+  {
+  case FrameQualityController::Quality::Low: return "Low";
+  case FrameQualityController::Quality::Medium: return "Medium";
+  case FrameQualityController::Quality::High: return "High";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace df
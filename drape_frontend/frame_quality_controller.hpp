@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace df
+{
+// Lowers the quality of rendering when render times of active frames exceed the budget and
+// restores it when there is enough headroom. The average render time is tracked, the quality is
+// changed step by step and not more often than once per kMinFramesBetweenChanges frames.
+// The quality is restored only after kMinFramesBeforeRestoring fast frames in a row.
+class FrameQualityController
+{
+public:
+  enum class Quality : uint8_t
+  {
+    // Buildings are rendered without offscreen pass, antialiasing is off.
+    Low,
+    // Antialiasing is off.
+    Medium,
+    High
+  };
+
+  static uint32_t constexpr kMinFramesBetweenChanges = 30;
+  static uint32_t constexpr kMinFramesBeforeRestoring = 120;
+
+  // Quality is lowered if the average render time is greater than |frameBudget| and
+  // is restored if it's less than |restoringFrameTime|.
+  FrameQualityController(double frameBudget, double restoringFrameTime);
+
+  // Returns true if quality is changed.
+  bool OnFrameRendered(double renderTime);
+  Quality GetQuality() const { return m_quality; }
+
+private:
+  double const m_frameBudget;
+  double const m_restoringFrameTime;
+
+  Quality m_quality = Quality::High;
+  double m_averageRenderTime = 0.0;
+  uint32_t m_framesCount = 0;
+  uint32_t m_fastFramesCount = 0;
+};
+
+std::string DebugPrint(FrameQualityController::Quality quality);
+}  // namespace df
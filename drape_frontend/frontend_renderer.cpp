@@ -66,8 +66,23 @@ double constexpr kVSyncInterval = 0.06;
 // Metal rendering is fast, so we can decrease sync inverval.
 double constexpr kVSyncIntervalMetal = 0.03;
 
+// Rendering quality is lowered if frames are prepared longer than kFrameRenderBudget and
+// is restored when they are prepared faster than kFrameRenderRestoringTime.
+double constexpr kFrameRenderBudget = 1.0 / 30.0;
+double constexpr kFrameRenderRestoringTime = 1.0 / 60.0;
+
+// Tiles are prefetched along the path which is twice as long as the screen.
+double constexpr kPrefetchedScreensCount = 2.0;
+size_t constexpr kMaxPrefetchedTilesCount = 32;
+
 std::string const kTransitBackgroundColor = "TransitBackground";
 
+std::vector<DepthLayer> const kOverlayLayers = {DepthLayer::OverlayLayer,
+                                                DepthLayer::LocalAdsMarkLayer,
+                                                DepthLayer::NavigationLayer,
+                                                DepthLayer::TransitMarkLayer,
+                                                DepthLayer::RoutingMarkLayer};
+
 template <typename ToDo>
 bool RemoveGroups(ToDo & filter, std::vector<drape_ptr<RenderGroup>> & groups,
                   ref_ptr<dp::OverlayTree> tree)
@@ -140,6 +155,39 @@ private:
 #define DEBUG_LABEL(context, labelText)
 #endif
 
+class FrameStatisticGuard
+{
+public:
+  FrameStatisticGuard()
+  {
+    DrapeMeasurer::Instance().StartFrameRendering();
+  }
+
+  ~FrameStatisticGuard()
+  {
+    DrapeMeasurer::Instance().EndFrameRendering();
+  }
+};
+
+class LayerStatisticGuard
+{
+public:
+  explicit LayerStatisticGuard(DepthLayer layer)
+    : m_layer(layer)
+    , m_startTime(std::chrono::steady_clock::now())
+  {}
+
+  ~LayerStatisticGuard()
+  {
+    DrapeMeasurer::Instance().AddLayerRenderingTime(m_layer,
+                                                    std::chrono::steady_clock::now() - m_startTime);
+  }
+
+private:
+  DepthLayer const m_layer;
+  std::chrono::time_point<std::chrono::steady_clock> const m_startTime;
+};
+
 #if defined(DRAPE_MEASURER) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
 class DrapeMeasurerGuard
 {
@@ -204,6 +252,7 @@ FrontendRenderer::FrontendRenderer(Params && params)
   , m_forceUpdateUserMarks(false)
   , m_postprocessRenderer(new PostprocessRenderer())
   , m_enabledOnStartEffects(params.m_enabledEffects)
+  , m_frameQualityController(kFrameRenderBudget, kFrameRenderRestoringTime)
 #ifdef SCENARIO_ENABLE
   , m_scenarioManager(new ScenarioManager(this))
 #endif
@@ -863,6 +912,16 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
     }
 
   case Message::Type::RegenerateTraffic:
+    {
+      if (!m_trafficEnabled)
+        break;
+      ref_ptr<RegenerateTrafficMessage> msg = message;
+      CHECK(m_context != nullptr, ());
+      m_trafficRenderer->UpdateRenderData(m_context, make_ref(m_gpuProgramManager), msg->GetMwms(),
+                                          msg->GetTiles(), msg->AcceptRenderData());
+      break;
+    }
+
   case Message::Type::SetSimplifiedTrafficColors:
   case Message::Type::SetDisplacementMode:
   case Message::Type::UpdateMetalines:
@@ -1133,7 +1192,16 @@ void FrontendRenderer::AddToRenderGroup(dp::RenderState const & state,
                                         drape_ptr<dp::RenderBucket> && renderBucket,
                                         TileKey const & newTile)
 {
-  RenderLayer & layer = m_layers[static_cast<size_t>(GetDepthLayer(state))];
+  auto const depthLayer = GetDepthLayer(state);
+  RenderLayer & layer = m_layers[static_cast<size_t>(depthLayer)];
+
+  // Overlays of new tiles are placed into the overlay tree incrementally.
+  if (!m_overlayTree->IsNeedUpdate() &&
+      std::find(kOverlayLayers.begin(), kOverlayLayers.end(), depthLayer) != kOverlayLayers.end())
+  {
+    renderBucket->CollectOverlayHandles(make_ref(m_overlayTree));
+  }
+
   for (auto const & g : layer.m_renderGroups)
   {
     if (!g->IsPendingOnDelete() && g->GetState() == state && g->GetTileKey().EqualStrict(newTile))
@@ -1263,7 +1331,7 @@ void FrontendRenderer::ProcessSelection(ref_ptr<SelectObjectMessage> msg)
 
 void FrontendRenderer::BeginUpdateOverlayTree(ScreenBase const & modelView)
 {
-  if (m_overlayTree->Frame())
+  if (m_overlayTree->Frame(modelView))
     m_overlayTree->StartOverlayPlacing(modelView, m_currentZoomLevel);
 }
 
@@ -1275,7 +1343,7 @@ void FrontendRenderer::UpdateOverlayTree(ScreenBase const & modelView, drape_ptr
     renderGroup->Update(modelView);
 }
 
-void FrontendRenderer::EndUpdateOverlayTree()
+void FrontendRenderer::EndUpdateOverlayTree(ScreenBase const & modelView)
 {
   if (m_overlayTree->IsNeedUpdate())
   {
@@ -1295,11 +1363,16 @@ void FrontendRenderer::EndUpdateOverlayTree()
       m_overlaysTracker->FinishTracking();
     }
   }
+  else
+  {
+    m_overlayTree->PlacePendingHandles(modelView);
+  }
 }
 
 void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFrame)
 {
   CHECK(m_context != nullptr, ());
+  FrameStatisticGuard frameStatisticGuard;
 #if defined(DRAPE_MEASURER) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
   DrapeImmediateRenderingMeasurerGuard drapeMeasurerGuard(m_context);
 #endif
@@ -1329,7 +1402,7 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
     Render2dLayer(modelView);
     RenderUserMarksLayer(modelView, DepthLayer::UserLineLayer);
 
-    if (m_buildingsFramebuffer->IsSupported())
+    if (IsBuildingsOffscreenRenderingEnabled())
     {
       RenderTrafficLayer(modelView);
       if (!HasTransitRouteData())
@@ -1414,18 +1487,23 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
 
 void FrontendRenderer::Render2dLayer(ScreenBase const & modelView)
 {
+  LayerStatisticGuard statisticGuard(DepthLayer::GeometryLayer);
   RenderLayer & layer2d = m_layers[static_cast<size_t>(DepthLayer::GeometryLayer)];
   layer2d.Sort(make_ref(m_overlayTree));
 
   CHECK(m_context != nullptr, ());
   DEBUG_LABEL(m_context, "2D Layer");
+  ref_ptr<BaseRenderGroup> prevGroup;
   for (drape_ptr<RenderGroup> const & group : layer2d.m_renderGroups)
-    RenderSingleGroup(m_context, modelView, make_ref(group));
+  {
+    RenderSingleGroup(m_context, modelView, make_ref(group), prevGroup);
+    prevGroup = make_ref(group);
+  }
 }
 
 void FrontendRenderer::PreRender3dLayer(ScreenBase const & modelView)
 {
-  if (!m_buildingsFramebuffer->IsSupported())
+  if (!IsBuildingsOffscreenRenderingEnabled())
     return;
   
   RenderLayer & layer = m_layers[static_cast<size_t>(DepthLayer::Geometry3dLayer)];
@@ -1439,18 +1517,35 @@ void FrontendRenderer::PreRender3dLayer(ScreenBase const & modelView)
   m_viewport.Apply(m_context);
   
   layer.Sort(make_ref(m_overlayTree));
+  ref_ptr<BaseRenderGroup> prevGroup;
   for (drape_ptr<RenderGroup> const & group : layer.m_renderGroups)
-    RenderSingleGroup(m_context, modelView, make_ref(group));
+  {
+    RenderSingleGroup(m_context, modelView, make_ref(group), prevGroup);
+    prevGroup = make_ref(group);
+  }
 }
   
+bool FrontendRenderer::IsBuildingsOffscreenRenderingEnabled() const
+{
+  return m_buildingsFramebuffer->IsSupported() &&
+         m_frameQualityController.GetQuality() != FrameQualityController::Quality::Low;
+}
+
+void FrontendRenderer::ApplyFrameQuality()
+{
+  m_postprocessRenderer->SetAntialiasingAllowed(m_frameQualityController.GetQuality() ==
+                                                FrameQualityController::Quality::High);
+}
+
 void FrontendRenderer::Render3dLayer(ScreenBase const & modelView)
 {
+  LayerStatisticGuard statisticGuard(DepthLayer::Geometry3dLayer);
   RenderLayer & layer = m_layers[static_cast<size_t>(DepthLayer::Geometry3dLayer)];
   if (layer.m_renderGroups.empty())
     return;
 
   DEBUG_LABEL(m_context, "3D Layer");
-  if (m_buildingsFramebuffer->IsSupported())
+  if (IsBuildingsOffscreenRenderingEnabled())
   {
     float const kOpacity = 0.7f;
     m_screenQuadRenderer->RenderTexture(m_context, make_ref(m_gpuProgramManager),
@@ -1464,19 +1559,28 @@ void FrontendRenderer::Render3dLayer(ScreenBase const & modelView)
     m_context->Clear(dp::ClearBits::DepthBit, dp::kClearBitsStoreAll);
     
     layer.Sort(make_ref(m_overlayTree));
+    ref_ptr<BaseRenderGroup> prevGroup;
     for (drape_ptr<RenderGroup> const & group : layer.m_renderGroups)
-      RenderSingleGroup(m_context, modelView, make_ref(group));
+    {
+      RenderSingleGroup(m_context, modelView, make_ref(group), prevGroup);
+      prevGroup = make_ref(group);
+    }
   }
 }
 
 void FrontendRenderer::RenderOverlayLayer(ScreenBase const & modelView)
 {
   CHECK(m_context != nullptr, ());
+  LayerStatisticGuard statisticGuard(DepthLayer::OverlayLayer);
   DEBUG_LABEL(m_context, "Overlay Layer");
   RenderLayer & overlay = m_layers[static_cast<size_t>(DepthLayer::OverlayLayer)];
   BuildOverlayTree(modelView);
+  ref_ptr<BaseRenderGroup> prevGroup;
   for (drape_ptr<RenderGroup> & group : overlay.m_renderGroups)
-    RenderSingleGroup(m_context, modelView, make_ref(group));
+  {
+    RenderSingleGroup(m_context, modelView, make_ref(group), prevGroup);
+    prevGroup = make_ref(group);
+  }
 
   if (GetStyleReader().IsCarNavigationStyle())
     RenderNavigationOverlayLayer(modelView);
@@ -1485,12 +1589,17 @@ void FrontendRenderer::RenderOverlayLayer(ScreenBase const & modelView)
 void FrontendRenderer::RenderNavigationOverlayLayer(ScreenBase const & modelView)
 {
   CHECK(m_context != nullptr, ());
+  LayerStatisticGuard statisticGuard(DepthLayer::NavigationLayer);
   DEBUG_LABEL(m_context, "Navigation Overlay Layer");
   RenderLayer & navOverlayLayer = m_layers[static_cast<size_t>(DepthLayer::NavigationLayer)];
+  ref_ptr<BaseRenderGroup> prevGroup;
   for (auto & group : navOverlayLayer.m_renderGroups)
   {
     if (group->HasOverlayHandles())
-      RenderSingleGroup(m_context, modelView, make_ref(group));
+    {
+      RenderSingleGroup(m_context, modelView, make_ref(group), prevGroup);
+      prevGroup = make_ref(group);
+    }
   }
 }
 
@@ -1507,6 +1616,7 @@ bool FrontendRenderer::HasRouteData() const
 void FrontendRenderer::RenderTransitSchemeLayer(ScreenBase const & modelView)
 {
   CHECK(m_context != nullptr, ());
+  LayerStatisticGuard statisticGuard(DepthLayer::TransitSchemeLayer);
   if (m_transitSchemeEnabled && m_transitSchemeRenderer->IsSchemeVisible(m_currentZoomLevel))
   {
     DEBUG_LABEL(m_context, "Transit Scheme");
@@ -1565,6 +1675,7 @@ void FrontendRenderer::RenderRouteLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderUserMarksLayer(ScreenBase const & modelView, DepthLayer layerId)
 {
+  LayerStatisticGuard statisticGuard(layerId);
   auto & renderGroups = m_layers[static_cast<size_t>(layerId)].m_renderGroups;
   if (renderGroups.empty())
     return;
@@ -1573,8 +1684,12 @@ void FrontendRenderer::RenderUserMarksLayer(ScreenBase const & modelView, DepthL
   DEBUG_LABEL(m_context, "User Marks: " + DebugPrint(layerId));
   m_context->Clear(dp::ClearBits::DepthBit, dp::kClearBitsStoreAll);
 
+  ref_ptr<BaseRenderGroup> prevGroup;
   for (drape_ptr<RenderGroup> & group : renderGroups)
-    RenderSingleGroup(m_context, modelView, make_ref(group));
+  {
+    RenderSingleGroup(m_context, modelView, make_ref(group), prevGroup);
+    prevGroup = make_ref(group);
+  }
 }
 
 void FrontendRenderer::RenderSearchMarksLayer(ScreenBase const & modelView)
@@ -1652,6 +1767,12 @@ void FrontendRenderer::RenderFrame()
 
   RenderScene(modelView, isActiveFrameForScene);
 
+  if (isActiveFrameForScene &&
+      m_frameQualityController.OnFrameRendered(m_frameData.m_timer.ElapsedSeconds()))
+  {
+    ApplyFrameQuality();
+  }
+
   auto const hasForceUpdate = m_forceUpdateScene || m_forceUpdateUserMarks;
   isActiveFrame |= hasForceUpdate;
 #if defined(SCENARIO_ENABLE)
@@ -1677,7 +1798,8 @@ void FrontendRenderer::RenderFrame()
   }
 
   bool const canSuspend = m_frameData.m_inactiveFramesCounter > FrameData::kMaxInactiveFrames;
-  m_frameData.m_forceFullRedrawNextFrame = m_overlayTree->IsNeedUpdate();
+  m_frameData.m_forceFullRedrawNextFrame = m_overlayTree->IsNeedUpdate() ||
+                                           m_overlayTree->HasPendingHandles();
   if (canSuspend)
   {
     // Process a message or wait for a message.
@@ -1724,13 +1846,8 @@ void FrontendRenderer::RenderFrame()
 
 void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
 {
-  static std::vector<DepthLayer> layers = {DepthLayer::OverlayLayer,
-                                           DepthLayer::LocalAdsMarkLayer,
-                                           DepthLayer::NavigationLayer,
-                                           DepthLayer::TransitMarkLayer,
-                                           DepthLayer::RoutingMarkLayer};
   BeginUpdateOverlayTree(modelView);
-  for (auto const & layerId : layers)
+  for (auto const & layerId : kOverlayLayers)
   {
     RenderLayer & overlay = m_layers[static_cast<size_t>(layerId)];
     overlay.Sort(make_ref(m_overlayTree));
@@ -1739,7 +1856,7 @@ void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
   }
   if (m_transitSchemeRenderer->IsSchemeVisible(m_currentZoomLevel) && !HasTransitRouteData())
     m_transitSchemeRenderer->CollectOverlays(make_ref(m_overlayTree), modelView);
-  EndUpdateOverlayTree();
+  EndUpdateOverlayTree(modelView);
 }
 
 void FrontendRenderer::PrepareBucket(dp::RenderState const & state, drape_ptr<dp::RenderBucket> & bucket)
@@ -1757,11 +1874,19 @@ void FrontendRenderer::PrepareBucket(dp::RenderState const & state, drape_ptr<dp
 
 void FrontendRenderer::RenderSingleGroup(ref_ptr<dp::GraphicsContext> context,
                                          ScreenBase const & modelView,
-                                         ref_ptr<BaseRenderGroup> group)
+                                         ref_ptr<BaseRenderGroup> group,
+                                         ref_ptr<BaseRenderGroup> prevGroup)
 {
+  // Groups are sorted by states, so neighbouring tiles usually give runs of groups with
+  // equal states. Debug rects are rendered with another program after every group.
+  bool const applyState = prevGroup == nullptr || m_debugRectRenderer->IsEnabled() ||
+                          prevGroup->GetState() != group->GetState() ||
+                          prevGroup->GetState().GetDepthTestEnabled() !=
+                            group->GetState().GetDepthTestEnabled();
+
   group->UpdateAnimation();
   group->Render(context, make_ref(m_gpuProgramManager), modelView, m_frameValues,
-                make_ref(m_debugRectRenderer));
+                make_ref(m_debugRectRenderer), applyState);
 }
 
 void FrontendRenderer::RefreshProjection(ScreenBase const & screen)
@@ -2357,11 +2482,49 @@ void FrontendRenderer::UpdateScene(ScreenBase const & modelView)
     m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                               make_unique_dp<UpdateReadManagerMessage>(),
                               MessagePriority::UberHighSingleton);
+    PrefetchTiles(modelView);
     m_forceUpdateScene = false;
     m_forceUpdateUserMarks = false;
   }
 }
 
+void FrontendRenderer::PrefetchTiles(ScreenBase const & screen)
+{
+  m2::RectD const & clipRect = screen.ClipRect();
+  double const length = kPrefetchedScreensCount * std::max(clipRect.SizeX(), clipRect.SizeY());
+
+  // Tiles are prefetched along the route while it's followed, otherwise they're prefetched
+  // in the direction of the user while the map follows the user.
+  std::vector<m2::PointD> path;
+  if (m_myPositionController->IsRouteFollowingActive())
+    path = m_routeRenderer->GetPathAhead(length);
+
+  m2::PointD direction;
+  if (path.empty() && m_myPositionController->IsModeChangeViewport() &&
+      m_myPositionController->GetDirection(direction))
+  {
+    m2::PointD const & position = m_myPositionController->Position();
+    path = {position, position + direction * length};
+  }
+
+  std::vector<TileKey> tiles;
+  if (!path.empty() && m_currentZoomLevel > 0)
+  {
+    // Tiles of the current coverage are requested already.
+    double const radius = std::min(clipRect.SizeX(), clipRect.SizeY()) / 2;
+    tiles = GetTilesAlongPath(path, radius, m_currentZoomLevel, m_notFinishedTiles,
+                              kMaxPrefetchedTilesCount);
+  }
+
+  if (tiles == m_prefetchedTiles)
+    return;
+
+  m_prefetchedTiles = tiles;
+  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                            make_unique_dp<PrefetchTilesMessage>(std::move(tiles)),
+                            MessagePriority::Low);
+}
+
 void FrontendRenderer::EmitModelViewChanged(ScreenBase const & modelView) const
 {
   m_modelViewChangedFn(modelView);
@@ -7,6 +7,7 @@
 #include "drape_frontend/backend_renderer.hpp"
 #include "drape_frontend/base_renderer.hpp"
 #include "drape_frontend/drape_api_renderer.hpp"
+#include "drape_frontend/frame_quality_controller.hpp"
 #include "drape_frontend/frame_values.hpp"
 #include "drape_frontend/gps_track_renderer.hpp"
 #include "drape_frontend/my_position_controller.hpp"
@@ -145,8 +146,10 @@ private:
   void OnResize(ScreenBase const & screen);
   void RenderScene(ScreenBase const & modelView, bool activeFrame);
   void PrepareBucket(dp::RenderState const & state, drape_ptr<dp::RenderBucket> & bucket);
+  // |prevGroup| is the group which is rendered just before |group| or nullptr if something else
+  // is rendered between them. The state isn't applied again if the groups have equal states.
   void RenderSingleGroup(ref_ptr<dp::GraphicsContext> context, ScreenBase const & modelView,
-                         ref_ptr<BaseRenderGroup> group);
+                         ref_ptr<BaseRenderGroup> group, ref_ptr<BaseRenderGroup> prevGroup);
   void RefreshProjection(ScreenBase const & screen);
   void RefreshZScale(ScreenBase const & screen);
   void RefreshPivotTransform(ScreenBase const & screen);
@@ -168,6 +171,9 @@ private:
   void RenderUserMarksLayer(ScreenBase const & modelView, DepthLayer layerId);
   void RenderTransitSchemeLayer(ScreenBase const & modelView);
   void RenderTrafficLayer(ScreenBase const & modelView);
+
+  bool IsBuildingsOffscreenRenderingEnabled() const;
+  void ApplyFrameQuality();
   void RenderRouteLayer(ScreenBase const & modelView);
   void RenderSearchMarksLayer(ScreenBase const & modelView);
   void RenderTransitBackground();
@@ -185,6 +191,7 @@ private:
   void EmitModelViewChanged(ScreenBase const & modelView) const;
 
   TTilesCollection ResolveTileKeys(ScreenBase const & screen);
+  void PrefetchTiles(ScreenBase const & screen);
   void ResolveZoomLevel(ScreenBase const & screen);
   void UpdateDisplacementEnabled();
   void CheckIsometryMinScale(ScreenBase const & screen);
@@ -225,7 +232,7 @@ private:
 
   void BeginUpdateOverlayTree(ScreenBase const & modelView);
   void UpdateOverlayTree(ScreenBase const & modelView, drape_ptr<RenderGroup> & renderGroup);
-  void EndUpdateOverlayTree();
+  void EndUpdateOverlayTree(ScreenBase const & modelView);
 
   template<typename TRenderGroup>
   void AddToRenderGroup(dp::RenderState const & state, drape_ptr<dp::RenderBucket> && renderBucket,
@@ -294,6 +301,7 @@ private:
 
   ScreenBase m_lastReadedModelView;
   TTilesCollection m_notFinishedTiles;
+  std::vector<TileKey> m_prefetchedTiles;
 
   int m_currentZoomLevel = -1;
 
@@ -336,6 +344,7 @@ private:
   bool m_isAntialiasingEnabled = false;
   drape_ptr<PostprocessRenderer> m_postprocessRenderer;
   std::vector<PostprocessRenderer::Effect> m_enabledOnStartEffects;
+  FrameQualityController m_frameQualityController;
 
   bool m_isDebugRectRenderingEnabled = false;
   drape_ptr<DebugRectRenderer> m_debugRectRenderer;
@@ -16,6 +16,7 @@
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 namespace df
 {
@@ -74,7 +75,6 @@ GpsTrackRenderer::GpsTrackRenderer(TRenderDataRequestFn const & dataRequestFn)
   , m_radius(0.0f)
 {
   ASSERT(m_dataRequestFn != nullptr, ());
-  m_points.reserve(kAveragePointsCount);
   m_handlesCache.reserve(8);
 }
 
@@ -101,8 +101,7 @@ void GpsTrackRenderer::ClearRenderData()
 void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
                                     std::vector<uint32_t> const & toRemove)
 {
-  bool wasChanged = false;
-  if (!toRemove.empty())
+  if (!toRemove.empty() && !RemovePointsFromStart(toRemove))
   {
     auto removePredicate = [&toRemove](GpsTrackPoint const & pt)
     {
@@ -110,7 +109,7 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     };
     m_points.erase(std::remove_if(m_points.begin(), m_points.end(), removePredicate),
                    m_points.end());
-    wasChanged = true;
+    RebuildChunks();
   }
 
   if (!toAdd.empty())
@@ -118,18 +117,125 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     ASSERT(is_sorted(toAdd.begin(), toAdd.end(), GpsPointsSortPredicate), ());
     if (!m_points.empty())
       ASSERT(GpsPointsSortPredicate(m_points.back(), toAdd.front()), ());
+    size_t const firstIndex = m_firstPointIndex + m_points.size();
     m_points.insert(m_points.end(), toAdd.begin(), toAdd.end());
-    wasChanged = true;
+    AppendPoints(firstIndex);
   }
 
-  if (wasChanged)
+  m_needUpdate = true;
+}
+
+bool GpsTrackRenderer::RemovePointsFromStart(std::vector<uint32_t> const & toRemove)
+{
+  // Usually the oldest points are removed, it doesn't require to rebuild the whole track.
+  size_t count = 0;
+  while (count < m_points.size() &&
+         std::find(toRemove.begin(), toRemove.end(), m_points[count].m_id) != toRemove.end())
   {
-    m_pointsSpline = m2::Spline(m_points.size());
-    for (size_t i = 0; i < m_points.size(); i++)
-      m_pointsSpline.AddPoint(m_points[i].m_point);
+    ++count;
   }
 
-  m_needUpdate = true;
+  for (size_t i = count; i < m_points.size(); ++i)
+  {
+    if (std::find(toRemove.begin(), toRemove.end(), m_points[i].m_id) != toRemove.end())
+      return false;
+  }
+
+  m_points.erase(m_points.begin(), m_points.begin() + count);
+  m_firstPointIndex += count;
+
+  while (!m_chunks.empty() && m_chunks.front().m_pointIndices.back() < m_firstPointIndex)
+    m_chunks.pop_front();
+
+  if (m_chunks.empty())
+  {
+    RebuildChunks();
+    return true;
+  }
+
+  // Rebuild the first chunk from the first remaining point.
+  TrackChunk & front = m_chunks.front();
+  if (front.m_pointIndices.front() < m_firstPointIndex)
+  {
+    size_t const lastIndex = front.m_pointIndices.back();
+    double const endLength = front.m_startLength + front.GetLength();
+
+    TrackChunk chunk;
+    for (size_t i = m_firstPointIndex; i <= lastIndex; ++i)
+    {
+      m2::PointD const & pt = GetPoint(i).m_point;
+      size_t const size = chunk.m_spline.GetSize();
+      chunk.m_spline.AddPoint(pt);
+      if (chunk.m_spline.GetSize() == size)
+        continue;
+      chunk.m_pointIndices.push_back(i);
+      chunk.m_lengths.push_back(size == 0 ? 0.0 : chunk.m_lengths.back() +
+                                                  chunk.m_spline.GetLengths().back());
+      chunk.m_rect.Add(pt);
+    }
+    chunk.m_startLength = endLength - chunk.GetLength();
+    front = std::move(chunk);
+  }
+  return true;
+}
+
+void GpsTrackRenderer::RebuildChunks()
+{
+  m_chunks.clear();
+  AppendPoints(m_firstPointIndex);
+}
+
+void GpsTrackRenderer::AppendPoints(size_t firstIndex)
+{
+  size_t constexpr kChunkPointsCount = 256;
+
+  for (size_t i = firstIndex; i < m_firstPointIndex + m_points.size(); ++i)
+  {
+    if (m_chunks.empty() || m_chunks.back().m_pointIndices.size() >= kChunkPointsCount)
+    {
+      TrackChunk chunk;
+      if (!m_chunks.empty())
+      {
+        // Neighbouring chunks share a point to keep the track continuous.
+        TrackChunk const & prev = m_chunks.back();
+        size_t const index = prev.m_pointIndices.back();
+        m2::PointD const & pt = GetPoint(index).m_point;
+        chunk.m_spline.AddPoint(pt);
+        chunk.m_pointIndices.push_back(index);
+        chunk.m_lengths.push_back(0.0);
+        chunk.m_rect.Add(pt);
+        chunk.m_startLength = prev.m_startLength + prev.GetLength();
+      }
+      m_chunks.push_back(std::move(chunk));
+    }
+
+    TrackChunk & chunk = m_chunks.back();
+    m2::PointD const & pt = GetPoint(i).m_point;
+    size_t const size = chunk.m_spline.GetSize();
+    chunk.m_spline.AddPoint(pt);
+    if (chunk.m_spline.GetSize() == size)
+      continue;
+
+    chunk.m_pointIndices.push_back(i);
+    chunk.m_lengths.push_back(size == 0 ? 0.0 : chunk.m_lengths.back() +
+                                                chunk.m_spline.GetLengths().back());
+    chunk.m_rect.Add(pt);
+  }
+}
+
+double GpsTrackRenderer::GetTrackLength() const
+{
+  if (m_chunks.empty())
+    return 0.0;
+  return m_chunks.back().m_startLength + m_chunks.back().GetLength() -
+         m_chunks.front().m_startLength;
+}
+
+GpsTrackPoint const & GpsTrackRenderer::GetPoint(size_t absIndex) const
+{
+  ASSERT_GREATER_OR_EQUAL(absIndex, m_firstPointIndex, ());
+  ASSERT_LESS(absIndex - m_firstPointIndex, m_points.size(), ());
+  return m_points[absIndex - m_firstPointIndex];
 }
 
 size_t GpsTrackRenderer::GetAvailablePointsCount() const
@@ -144,12 +250,11 @@ size_t GpsTrackRenderer::GetAvailablePointsCount() const
 dp::Color GpsTrackRenderer::CalculatePointColor(size_t pointIndex, m2::PointD const & curPoint,
                                                 double lengthFromStart, double fullLength) const
 {
-  ASSERT_LESS(pointIndex, m_points.size(), ());
-  if (pointIndex + 1 == m_points.size())
+  if (pointIndex + 1 == m_firstPointIndex + m_points.size())
     return dp::Color::Transparent();
 
-  GpsTrackPoint const & start = m_points[pointIndex];
-  GpsTrackPoint const & end = m_points[pointIndex + 1];
+  GpsTrackPoint const & start = GetPoint(pointIndex);
+  GpsTrackPoint const & end = GetPoint(pointIndex + 1);
 
   double startAlpha = kMinDayAlpha;
   double endAlpha = kMaxDayAlpha;
@@ -244,50 +349,19 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
     }
     else
     {
-      m2::Spline::iterator it;
-      it.Attach(m_pointsSpline);
-      while (!it.BeginAgain())
+      double const step = diameterMercator + kDistanceScalar * diameterMercator;
+      double const fullLength = GetTrackLength();
+      for (auto const & chunk : m_chunks)
       {
-        m2::PointD const pt = it.m_pos;
-        m2::RectD pointRect(pt.x - radiusMercator, pt.y - radiusMercator,
-                            pt.x + radiusMercator, pt.y + radiusMercator);
-        if (screen.ClipRect().IsIntersect(pointRect))
-        {
-          dp::Color const color = CalculatePointColor(it.GetIndex(), pt,
-                                                      it.GetLength(), it.GetFullLength());
-          m2::PointD const convertedPt = MapShape::ConvertToLocal(pt, m_pivot, kShapeCoordScalar);
-          m_handlesCache[cacheIndex].first->SetPoint(m_handlesCache[cacheIndex].second,
-                                                     convertedPt, m_radius, color);
-          m_handlesCache[cacheIndex].second++;
-          if (m_handlesCache[cacheIndex].second >= m_handlesCache[cacheIndex].first->GetPointsCount())
-            cacheIndex++;
-
-          if (cacheIndex >= m_handlesCache.size())
-          {
-            m_dataRequestFn(kAveragePointsCount);
-            m_waitForRenderData = true;
-            return;
-          }
-        }
-        it.Advance(diameterMercator + kDistanceScalar * diameterMercator);
+        if (!PlaceChunkPoints(chunk, screen, radiusMercator, step, fullLength, cacheIndex))
+          return;
       }
 
 #ifdef GPS_TRACK_SHOW_RAW_POINTS
       for (size_t i = 0; i < m_points.size(); i++)
       {
-        m2::PointD const convertedPt = MapShape::ConvertToLocal(m_points[i].m_point, m_pivot, kShapeCoordScalar);
-        m_handlesCache[cacheIndex].first->SetPoint(m_handlesCache[cacheIndex].second, convertedPt,
-                                                   m_radius * 1.2, dp::Color(0, 0, 255, 255));
-        m_handlesCache[cacheIndex].second++;
-        if (m_handlesCache[cacheIndex].second >= m_handlesCache[cacheIndex].first->GetPointsCount())
-          cacheIndex++;
-
-        if (cacheIndex >= m_handlesCache.size())
-        {
-          m_dataRequestFn(kAveragePointsCount);
-          m_waitForRenderData = true;
+        if (!PlacePoint(m_points[i].m_point, m_radius * 1.2f, dp::Color(0, 0, 255, 255), cacheIndex))
           return;
-        }
       }
 #endif
     }
@@ -319,6 +393,71 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
   }
 }
 
+bool GpsTrackRenderer::PlaceChunkPoints(TrackChunk const & chunk, ScreenBase const & screen,
+                                        double radiusMercator, double step, double fullLength,
+                                        size_t & cacheIndex)
+{
+  if (chunk.m_spline.GetSize() < 2)
+    return true;
+
+  m2::RectD rect = chunk.m_rect;
+  rect.Inflate(radiusMercator, radiusMercator);
+  if (!screen.ClipRect().IsIntersect(rect))
+    return true;
+
+  // Points are placed with the same step along the whole track, so the first point of the chunk
+  // is shifted by the remainder of the previous chunks.
+  double const startLength = chunk.m_startLength - m_chunks.front().m_startLength;
+  double length = std::ceil(startLength / step) * step - startLength;
+  double const chunkLength = chunk.GetLength();
+  bool const isLastChunk = &chunk == &m_chunks.back();
+
+  m2::Spline::iterator it;
+  it.Attach(chunk.m_spline);
+  if (length > 0.0)
+    it.Advance(length);
+
+  while (!it.BeginAgain())
+  {
+    // The point on the end of the chunk is placed by the next chunk.
+    if (!isLastChunk && length >= chunkLength)
+      break;
+
+    m2::PointD const pt = it.m_pos;
+    m2::RectD pointRect(pt.x - radiusMercator, pt.y - radiusMercator,
+                        pt.x + radiusMercator, pt.y + radiusMercator);
+    if (screen.ClipRect().IsIntersect(pointRect))
+    {
+      dp::Color const color = CalculatePointColor(chunk.m_pointIndices[it.GetIndex()], pt,
+                                                  startLength + length, fullLength);
+      if (!PlacePoint(pt, m_radius, color, cacheIndex))
+        return false;
+    }
+    it.Advance(step);
+    length += step;
+  }
+  return true;
+}
+
+bool GpsTrackRenderer::PlacePoint(m2::PointD const & pt, float radius, dp::Color const & color,
+                                  size_t & cacheIndex)
+{
+  m2::PointD const convertedPt = MapShape::ConvertToLocal(pt, m_pivot, kShapeCoordScalar);
+  m_handlesCache[cacheIndex].first->SetPoint(m_handlesCache[cacheIndex].second,
+                                             convertedPt, radius, color);
+  m_handlesCache[cacheIndex].second++;
+  if (m_handlesCache[cacheIndex].second >= m_handlesCache[cacheIndex].first->GetPointsCount())
+    cacheIndex++;
+
+  if (cacheIndex >= m_handlesCache.size())
+  {
+    m_dataRequestFn(kAveragePointsCount);
+    m_waitForRenderData = true;
+    return false;
+  }
+  return true;
+}
+
 void GpsTrackRenderer::Update()
 {
   m_needUpdate = true;
@@ -327,6 +466,8 @@ void GpsTrackRenderer::Update()
 void GpsTrackRenderer::Clear()
 {
   m_points.clear();
+  m_firstPointIndex = 0;
+  m_chunks.clear();
   m_needUpdate = true;
 }
 }  // namespace df
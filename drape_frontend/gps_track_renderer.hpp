@@ -12,6 +12,7 @@
 #include "geometry/screenbase.hpp"
 #include "geometry/spline.hpp"
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <vector>
@@ -38,15 +39,47 @@ public:
   void ClearRenderData();
 
 private:
+  // Part of the track with a limited number of points. Points are only appended to the last
+  // chunk, so adding of new points doesn't touch the old ones and invisible chunks are skipped
+  // while points are placed.
+  struct TrackChunk
+  {
+    double GetLength() const { return m_lengths.back(); }
+
+    m2::Spline m_spline;
+    // Absolute indices of spline nodes in the track, see m_firstPointIndex.
+    std::vector<size_t> m_pointIndices;
+    // Lengths from the chunk start to spline nodes.
+    std::vector<double> m_lengths;
+    m2::RectD m_rect;
+    // Length of the track before the chunk.
+    double m_startLength = 0.0;
+  };
+
   size_t GetAvailablePointsCount() const;
+
+  void AppendPoints(size_t firstIndex);
+  bool RemovePointsFromStart(std::vector<uint32_t> const & toRemove);
+  void RebuildChunks();
+
+  double GetTrackLength() const;
+  GpsTrackPoint const & GetPoint(size_t absIndex) const;
+
+  bool PlaceChunkPoints(TrackChunk const & chunk, ScreenBase const & screen, double radiusMercator,
+                        double step, double fullLength, size_t & cacheIndex);
+  bool PlacePoint(m2::PointD const & pt, float radius, dp::Color const & color,
+                  size_t & cacheIndex);
+
   dp::Color CalculatePointColor(size_t pointIndex, m2::PointD const & curPoint,
                                 double lengthFromStart, double fullLength) const;
   dp::Color GetColorBySpeed(double speed) const;
 
   TRenderDataRequestFn m_dataRequestFn;
   std::vector<drape_ptr<CirclesPackRenderData>> m_renderData;
-  std::vector<GpsTrackPoint> m_points;
-  m2::Spline m_pointsSpline;
+  std::deque<GpsTrackPoint> m_points;
+  // Absolute index of m_points.front(), it grows when the oldest points are removed.
+  size_t m_firstPointIndex = 0;
+  std::deque<TrackChunk> m_chunks;
   bool m_needUpdate;
   bool m_waitForRenderData;
   std::vector<std::pair<CirclesPackHandle *, size_t>> m_handlesCache;
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "drape_frontend/message.hpp"
 #include "drape_frontend/tile_key.hpp"
 
 #include "drape/graphics_context.hpp"
@@ -8,6 +7,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace dp
@@ -48,58 +48,4 @@ private:
 };
 
 using TMapShapes = std::vector<drape_ptr<MapShape>>;
-
-class MapShapeMessage : public Message
-{
-public:
-  explicit MapShapeMessage(TileKey const & key)
-    : m_tileKey(key)
-  {}
-
-  TileKey const & GetKey() const { return m_tileKey; }
-
-private:
-  TileKey m_tileKey;
-};
-
-class TileReadStartMessage : public MapShapeMessage
-{
-public:
-  explicit TileReadStartMessage(TileKey const & key) : MapShapeMessage(key) {}
-  Type GetType() const override { return Type::TileReadStarted; }
-  bool IsGraphicsContextDependent() const override { return true; }
-};
-
-class TileReadEndMessage : public MapShapeMessage
-{
-public:
-  explicit TileReadEndMessage(TileKey const & key) : MapShapeMessage(key) {}
-  Type GetType() const override { return Type::TileReadEnded; }
-  bool IsGraphicsContextDependent() const override { return true; }
-};
-
-class MapShapeReadedMessage : public MapShapeMessage
-{
-public:
-  MapShapeReadedMessage(TileKey const & key, TMapShapes && shapes)
-    : MapShapeMessage(key), m_shapes(move(shapes))
-  {}
-
-  Type GetType() const override { return Type::MapShapeReaded; }
-  bool IsGraphicsContextDependent() const override { return true; }
-  TMapShapes const & GetShapes() { return m_shapes; }
-
-private:
-  TMapShapes m_shapes;
-};
-
-class OverlayMapShapeReadedMessage : public MapShapeReadedMessage
-{
-public:
-  OverlayMapShapeReadedMessage(TileKey const & key, TMapShapes && shapes)
-    : MapShapeReadedMessage(key, move(shapes))
-  {}
-
-  Type GetType() const override { return Message::Type::OverlayMapShapeReaded; }
-};
 }  // namespace df
@@ -9,17 +9,16 @@ std::string DebugPrint(Message::Type msgType)
   switch (msgType)
   {
   case Message::Type::Unknown: return "Unknown";
-  case Message::Type::TileReadStarted: return "TileReadStarted";
-  case Message::Type::TileReadEnded: return "TileReadEnded";
   case Message::Type::FinishReading: return "FinishReading";
   case Message::Type::FinishTileRead: return "FinishTileRead";
   case Message::Type::FlushTile: return "FlushTile";
   case Message::Type::FlushOverlays: return "FlushOverlays";
-  case Message::Type::MapShapeReaded: return "MapShapeReaded";
-  case Message::Type::OverlayMapShapeReaded: return "OverlayMapShapeReaded";
+  case Message::Type::TileGeometryBatched: return "TileGeometryBatched";
+  case Message::Type::TileOverlaysBatched: return "TileOverlaysBatched";
   case Message::Type::UpdateReadManager: return "UpdateReadManager";
   case Message::Type::InvalidateRect: return "InvalidateRect";
   case Message::Type::InvalidateReadManagerRect: return "InvalidateReadManagerRect";
+  case Message::Type::PrefetchTiles: return "PrefetchTiles";
   case Message::Type::UpdateUserMarkGroup: return "UpdateUserMarkGroup";
   case Message::Type::ClearUserMarkGroup: return "ClearUserMarkGroup";
   case Message::Type::ChangeUserMarkGroupVisibility: return "ChangeUserMarkGroupVisibility";
@@ -10,17 +10,16 @@ public:
   enum class Type
   {
     Unknown,
-    TileReadStarted,
-    TileReadEnded,
     FinishReading,
     FinishTileRead,
     FlushTile,
     FlushOverlays,
-    MapShapeReaded,
-    OverlayMapShapeReaded,
+    TileGeometryBatched,
+    TileOverlaysBatched,
     UpdateReadManager,
     InvalidateRect,
     InvalidateReadManagerRect,
+    PrefetchTiles,
     UpdateUserMarkGroup,
     ClearUserMarkGroup,
     ChangeUserMarkGroupVisibility,
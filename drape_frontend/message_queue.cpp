@@ -5,24 +5,22 @@
 
 namespace df
 {
-MessageQueue::MessageQueue()
-  : m_isWaiting(false)
-{}
-
 MessageQueue::~MessageQueue()
 {
-  CancelWaitImpl();
+  CancelWait();
   ClearQuery();
 }
 
 drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
+  ProcessPushedMessagesImpl();
   if (waitForMessage && m_messages.empty() && m_lowPriorityMessages.empty())
   {
-    m_isWaiting = true;
-    m_condition.wait(lock, [this]() { return !m_isWaiting; });
-    m_isWaiting = false;
+    lock.unlock();
+    m_pushed.Wait();
+    lock.lock();
+    ProcessPushedMessagesImpl();
   }
 
   if (m_messages.empty() && m_lowPriorityMessages.empty())
@@ -42,8 +40,19 @@ drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pushed.Push(TMessageNode(std::move(message), priority));
+}
 
+void MessageQueue::ProcessPushedMessagesImpl()
+{
+  m_pushed.PopAll([this](TMessageNode && node)
+  {
+    AddMessageImpl(std::move(node.first), node.second);
+  });
+}
+
+void MessageQueue::AddMessageImpl(drape_ptr<Message> && message, MessagePriority priority)
+{
   if (m_filter != nullptr && m_filter(make_ref(message)))
     return;
 
@@ -87,8 +96,6 @@ void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority pr
   default:
     ASSERT(false, ("Unknown message priority type"));
   }
-
-  CancelWaitImpl();
 }
 
 void MessageQueue::FilterMessagesImpl()
@@ -115,6 +122,7 @@ void MessageQueue::FilterMessagesImpl()
 void MessageQueue::EnableMessageFiltering(FilterMessageFn && filter)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
+  ProcessPushedMessagesImpl();
   m_filter = std::move(filter);
   FilterMessagesImpl();
 }
@@ -128,34 +136,27 @@ void MessageQueue::DisableMessageFiltering()
 #ifdef DEBUG_MESSAGE_QUEUE
 bool MessageQueue::IsEmpty() const
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.empty() && m_lowPriorityMessages.empty();
+  return GetSize() == 0;
 }
 
 size_t MessageQueue::GetSize() const
 {
+  auto & queue = const_cast<MessageQueue &>(*this);
   std::lock_guard<std::mutex> lock(m_mutex);
+  queue.ProcessPushedMessagesImpl();
   return m_messages.size() + m_lowPriorityMessages.size();
 }
 #endif
 
 void MessageQueue::CancelWait()
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  CancelWaitImpl();
-}
-
-void MessageQueue::CancelWaitImpl()
-{
-  if (m_isWaiting)
-  {
-    m_isWaiting = false;
-    m_condition.notify_all();
-  }
+  m_pushed.Wake();
 }
 
 void MessageQueue::ClearQuery()
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pushed.Clear();
   m_messages.clear();
   m_lowPriorityMessages.clear();
 }
@@ -5,9 +5,8 @@
 #include "drape/drape_diagnostics.hpp"
 #include "drape/pointers.hpp"
 
-#include "base/condition.hpp"
+#include "base/mpsc_queue.hpp"
 
-#include <condition_variable>
 #include <deque>
 #include <functional>
 #include <mutex>
@@ -17,7 +16,7 @@ namespace df
 class MessageQueue
 {
 public:
-  MessageQueue();
+  MessageQueue() = default;
   ~MessageQueue();
 
   // If the queue is empty then it returns nullptr or wait for a message.
@@ -36,13 +35,18 @@ public:
 #endif
 
 private:
+  using TMessageNode = std::pair<drape_ptr<Message>, MessagePriority>;
+
   void FilterMessagesImpl();
-  void CancelWaitImpl();
+  // Moves pushed messages to the queues by their priorities.
+  void ProcessPushedMessagesImpl();
+  void AddMessageImpl(drape_ptr<Message> && message, MessagePriority priority);
 
+  // Producers push messages without locks, they are ordered by priorities on popping.
+  base::MpscQueue<TMessageNode> m_pushed;
+
+  // Guards the queues below and popping from |m_pushed|.
   mutable std::mutex m_mutex;
-  std::condition_variable m_condition;
-  bool m_isWaiting;
-  using TMessageNode = std::pair<drape_ptr<Message>, MessagePriority>;
   std::deque<TMessageNode> m_messages;
   std::deque<drape_ptr<Message>> m_lowPriorityMessages;
   FilterMessageFn m_filter;
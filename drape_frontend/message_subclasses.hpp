@@ -15,6 +15,7 @@
 #include "drape_frontend/render_state_extension.hpp"
 #include "drape_frontend/route_builder.hpp"
 #include "drape_frontend/selection_shape.hpp"
+#include "drape_frontend/tile_batcher.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/traffic_generator.hpp"
 #include "drape_frontend/transit_scheme_builder.hpp"
@@ -159,6 +160,30 @@ private:
 using FlushOverlaysMessage = FlushRenderDataMessage<TOverlaysRenderData,
                                                     Message::Type::FlushOverlays>;
 
+// Render data of a tile which is batched on a reading thread and isn't moved to GPU yet.
+template <typename RenderDataType, Message::Type MessageType>
+class TileBatchedMessage : public BaseTileMessage
+{
+public:
+  TileBatchedMessage(TileKey const & key, RenderDataType && data)
+    : BaseTileMessage(key)
+    , m_data(std::move(data))
+  {}
+
+  Type GetType() const override { return MessageType; }
+  bool IsGraphicsContextDependent() const override { return true; }
+
+  RenderDataType && AcceptRenderData() { return std::move(m_data); }
+
+private:
+  RenderDataType m_data;
+};
+
+using TileGeometryBatchedMessage = TileBatchedMessage<TTileRenderData,
+                                                      Message::Type::TileGeometryBatched>;
+using TileOverlaysBatchedMessage = TileBatchedMessage<TOverlaysRenderData,
+                                                      Message::Type::TileOverlaysBatched>;
+
 class InvalidateRectMessage : public Message
 {
 public:
@@ -203,6 +228,21 @@ private:
   bool m_needRestartReading;
 };
 
+class PrefetchTilesMessage : public Message
+{
+public:
+  explicit PrefetchTilesMessage(std::vector<TileKey> && tiles)
+    : m_tiles(std::move(tiles))
+  {}
+
+  Type GetType() const override { return Type::PrefetchTiles; }
+
+  std::vector<TileKey> const & GetTiles() const { return m_tiles; }
+
+private:
+  std::vector<TileKey> m_tiles;
+};
+
 class ClearUserMarkGroupMessage : public Message
 {
 public:
@@ -952,7 +992,24 @@ private:
 class RegenerateTrafficMessage : public Message
 {
 public:
+  RegenerateTrafficMessage(std::vector<MwmSet::MwmId> && mwms, std::vector<TileKey> && tiles,
+                           std::vector<TrafficRenderData> && renderData)
+    : m_mwms(std::move(mwms))
+    , m_tiles(std::move(tiles))
+    , m_renderData(std::move(renderData))
+  {}
+
   Type GetType() const override { return Type::RegenerateTraffic; }
+  bool IsGraphicsContextDependent() const override { return true; }
+
+  std::vector<MwmSet::MwmId> const & GetMwms() const { return m_mwms; }
+  std::vector<TileKey> const & GetTiles() const { return m_tiles; }
+  std::vector<TrafficRenderData> && AcceptRenderData() { return std::move(m_renderData); }
+
+private:
+  std::vector<MwmSet::MwmId> m_mwms;
+  std::vector<TileKey> m_tiles;
+  std::vector<TrafficRenderData> m_renderData;
 };
 
 class UpdateTrafficMessage : public Message
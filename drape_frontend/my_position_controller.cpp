@@ -16,6 +16,7 @@
 #include "3party/Alohalytics/src/alohalytics.h"
 
 #include <algorithm>
+#include <cmath>
 #include <chrono>
 #include <string>
 #include <vector>
@@ -651,6 +652,16 @@ bool MyPositionController::IsRouteFollowingActive() const
   return IsInRouting() && m_mode == location::FollowAndRotate;
 }
 
+bool MyPositionController::GetDirection(m2::PointD & direction) const
+{
+  if (!m_isDirectionAssigned)
+    return false;
+
+  // Direction is an azimuth which is measured clockwise from the north.
+  direction = m2::PointD(std::sin(m_drawDirection), std::cos(m_drawDirection));
+  return true;
+}
+
 bool MyPositionController::AlmostCurrentPosition(m2::PointD const & pos) const
 {
   double const kPositionEqualityDelta = 1e-5;
@@ -130,6 +130,8 @@ public:
 
   bool IsWaitingForLocation() const;
   m2::PointD GetDrawablePosition();
+  // Returns the unit vector of the current direction or false if the direction is unknown.
+  bool GetDirection(m2::PointD & direction) const;
 
 private:
   void ChangeMode(location::EMyPositionMode newMode);
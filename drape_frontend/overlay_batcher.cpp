@@ -17,22 +17,22 @@ OverlayBatcher::OverlayBatcher(TileKey const & key)
   int const kAverageRenderDataCount = 5;
   m_data.reserve(kAverageRenderDataCount);
 
+  m_batcher.SetPreflushEnabled(false);
   m_batcher.StartSession([this, key](dp::RenderState const & state, drape_ptr<dp::RenderBucket> && bucket)
   {
     FlushGeometry(key, state, std::move(bucket));
   });
 }
 
-void OverlayBatcher::Batch(ref_ptr<dp::GraphicsContext> context, drape_ptr<MapShape> const & shape,
-                           ref_ptr<dp::TextureManager> texMng)
+void OverlayBatcher::Batch(drape_ptr<MapShape> const & shape, ref_ptr<dp::TextureManager> texMng)
 {
   m_batcher.SetFeatureMinZoom(shape->GetFeatureMinZoom());
-  shape->Draw(context, make_ref(&m_batcher), texMng);
+  shape->Draw(nullptr /* context */, make_ref(&m_batcher), texMng);
 }
 
-void OverlayBatcher::Finish(ref_ptr<dp::GraphicsContext> context, TOverlaysRenderData & data)
+void OverlayBatcher::Finish(TOverlaysRenderData & data)
 {
-  m_batcher.EndSession(context);
+  m_batcher.EndSession(nullptr /* context */);
   data.swap(m_data);
 }
 
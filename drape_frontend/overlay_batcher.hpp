@@ -33,13 +33,13 @@ struct OverlayRenderData
 
 using TOverlaysRenderData = std::vector<OverlayRenderData>;
 
+// Overlays are batched on reading threads like the rest of shapes, see TileBatcher.
 class OverlayBatcher
 {
 public:
   explicit OverlayBatcher(TileKey const & key);
-  void Batch(ref_ptr<dp::GraphicsContext> context, drape_ptr<MapShape> const & shape,
-             ref_ptr<dp::TextureManager> texMng);
-  void Finish(ref_ptr<dp::GraphicsContext> context, TOverlaysRenderData & data);
+  void Batch(drape_ptr<MapShape> const & shape, ref_ptr<dp::TextureManager> texMng);
+  void Finish(TOverlaysRenderData & data);
 
 private:
   void FlushGeometry(TileKey const & key, dp::RenderState const & state,
@@ -215,7 +215,7 @@ bool PostprocessRenderer::IsEffectEnabled(Effect effect) const
 
 bool PostprocessRenderer::CanRenderAntialiasing() const
 {
-  if (!IsEffectEnabled(Effect::Antialiasing))
+  if (!IsEffectEnabled(Effect::Antialiasing) || !m_isAntialiasingAllowed)
     return false;
 
   if (!IsSupported(m_edgesFramebuffer) || !IsSupported(m_blendingWeightFramebuffer) ||
@@ -50,6 +50,8 @@ public:
   bool IsEnabled() const;
   void SetEffectEnabled(ref_ptr<dp::GraphicsContext> context, Effect effect, bool enabled);
   bool IsEffectEnabled(Effect effect) const;
+  // Antialiasing is skipped without releasing its framebuffers, e.g. when frames are too slow.
+  void SetAntialiasingAllowed(bool allowed) { m_isAntialiasingAllowed = allowed; }
 
   bool OnFramebufferFallback(ref_ptr<dp::GraphicsContext> context);
   void OnChangedRouteFollowingMode(ref_ptr<dp::GraphicsContext> context, bool isRouteFollowingActive);
@@ -83,6 +85,7 @@ private:
 
   bool m_frameStarted = false;
   bool m_isRouteFollowingActive = false;
+  bool m_isAntialiasingAllowed = true;
 };
 
 class StencilWriterGuard
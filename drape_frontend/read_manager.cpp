@@ -6,6 +6,7 @@
 #include "drape/constants.hpp"
 
 #include "base/buffer_vector.hpp"
+#include "base/math.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
@@ -35,6 +36,31 @@ struct LessCoverageCell
     return l->GetTileKey() < r->GetTileKey();
   }
 };
+
+// Sorts |tiles| in the order of reading: tiles which are closer to the center of the screen
+// are read first. While the viewport moves, the center is shifted in the direction of the
+// motion since the previous coverage, so tiles which are being shown are read before the ones
+// which are going to be hidden.
+template <typename Tiles>
+void SortTilesForReading(ScreenBase const & screen, ScreenBase const & prevScreen, Tiles & tiles)
+{
+  m2::RectD const clipRect = screen.ClipRect();
+  m2::PointD center = clipRect.Center();
+  if (GetDrawTileScale(screen) == GetDrawTileScale(prevScreen))
+  {
+    // Motion is predicted for the time between coverage updates and is limited by the screen.
+    m2::PointD motion = center - prevScreen.ClipRect().Center();
+    motion.x = base::clamp(motion.x, -clipRect.SizeX() / 2, clipRect.SizeX() / 2);
+    motion.y = base::clamp(motion.y, -clipRect.SizeY() / 2, clipRect.SizeY() / 2);
+    center += motion;
+  }
+
+  std::stable_sort(tiles.begin(), tiles.end(), [&center](TileKey const & l, TileKey const & r)
+  {
+    return l.GetGlobalRect().Center().SquaredLength(center) <
+           r.GetGlobalRect().Center().SquaredLength(center);
+  });
+}
 }  // namespace
 
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
@@ -44,15 +70,19 @@ bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l
 }
 
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-                         bool allow3dBuildings, bool trafficEnabled, EngineContext::TIsUGCFn && isUGCFn)
+                         bool allow3dBuildings, bool trafficEnabled, size_t tileShapesCacheSize,
+                         EngineContext::TIsUGCFn && isUGCFn)
   : m_commutator(commutator)
   , m_model(model)
+  , m_shapesCache(tileShapesCacheSize != 0 ? make_unique_dp<TileShapesCache>(tileShapesCacheSize)
+                                           : nullptr)
   , m_have3dBuildings(false)
   , m_allow3dBuildings(allow3dBuildings)
   , m_trafficEnabled(trafficEnabled)
   , m_displacementMode(dp::displacement::kDefaultMode)
   , m_modeChanged(false)
   , m_ugcRenderingEnabled(false)
+  , m_maxPrefetchedTilesCount(tileShapesCacheSize / 2)
   , m_tasksPool(64, ReadMWMTaskFactory(m_model))
   , m_counter(0)
   , m_generationCounter(0)
@@ -91,7 +121,8 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
   ASSERT(dynamic_cast<ReadMWMTask *>(task) != NULL, ());
   auto t = static_cast<ReadMWMTask *>(task);
 
-  // finish tiles
+  // Prefetched tiles aren't shown, so they aren't counted.
+  if (!t->IsPrefetching())
   {
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
 
@@ -139,6 +170,12 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
   if (m_modeChanged || forceUpdate || MustDropAllTiles(screen))
   {
+    // Shapes may be changed unless only the viewport is changed.
+    if (m_shapesCache && (m_modeChanged || forceUpdate))
+    {
+      m_shapesCache->Clear();
+      CancelPrefetching();
+    }
     m_modeChanged = false;
 
     for (auto const & info : m_tileInfos)
@@ -149,7 +186,9 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
+    buffer_vector<TileKey, 8> newTiles(tiles.begin(), tiles.end());
+    SortTilesForReading(screen, m_currentViewport, newTiles);
+    for (auto const & tileKey : newTiles)
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
   else
@@ -179,6 +218,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     if (forceUpdateUserMarks)
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
+    SortTilesForReading(screen, m_currentViewport, newTiles);
     for (auto const & tileKey : newTiles)
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
@@ -188,6 +228,9 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
 void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 {
+  if (m_shapesCache)
+    m_shapesCache->Erase(keyStorage);
+
   TTileSet tilesToErase;
   for (auto const & info : m_tileInfos)
   {
@@ -200,10 +243,83 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
     CancelTileInfo(info);
     m_tileInfos.erase(info);
   }
+
+  for (auto it = m_prefetchedTileInfos.begin(); it != m_prefetchedTileInfos.end();)
+  {
+    if (keyStorage.find((*it)->GetTileKey()) != keyStorage.end())
+    {
+      (*it)->Cancel();
+      it = m_prefetchedTileInfos.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void ReadManager::Prefetch(std::vector<TileKey> const & tiles, ref_ptr<dp::TextureManager> texMng,
+                           ref_ptr<MetalineManager> metalineMng)
+{
+  if (m_shapesCache == nullptr || m_pool == nullptr)
+    return;
+
+  // Tiles of the coverage are read anyway.
+  TTilesCollection requestedTiles;
+  for (auto const & tileKey : tiles)
+  {
+    if (requestedTiles.size() == m_maxPrefetchedTilesCount)
+      break;
+    if (!CheckTileKey(tileKey))
+      requestedTiles.insert(tileKey);
+  }
+
+  TTilesCollection prefetchedTiles;
+  for (auto it = m_prefetchedTileInfos.begin(); it != m_prefetchedTileInfos.end();)
+  {
+    if (requestedTiles.find((*it)->GetTileKey()) == requestedTiles.end())
+    {
+      (*it)->Cancel();
+      it = m_prefetchedTileInfos.erase(it);
+    }
+    else
+    {
+      prefetchedTiles.insert((*it)->GetTileKey());
+      ++it;
+    }
+  }
+
+  for (auto const & tileKey : tiles)
+  {
+    if (requestedTiles.find(tileKey) == requestedTiles.end() ||
+        prefetchedTiles.find(tileKey) != prefetchedTiles.end())
+    {
+      continue;
+    }
+
+    // Tiles which are cached already are skipped by the task.
+    auto tileInfo = std::make_shared<TileInfo>(
+        CreateEngineContext(tileKey, texMng, metalineMng, true /* isPrefetching */));
+    m_prefetchedTileInfos.insert(tileInfo);
+    ReadMWMTask * task = m_tasksPool.Get();
+    task->Init(tileInfo);
+    m_pool->PushBackLowPriority(task);
+  }
+}
+
+void ReadManager::CancelPrefetching()
+{
+  for (auto const & info : m_prefetchedTileInfos)
+    info->Cancel();
+  m_prefetchedTileInfos.clear();
 }
 
 void ReadManager::InvalidateAll()
 {
+  if (m_shapesCache)
+    m_shapesCache->Clear();
+  CancelPrefetching();
+
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
@@ -233,12 +349,7 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                          ref_ptr<MetalineManager> metalineMng)
 {
   ASSERT(m_pool != nullptr, ());
-  auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
-                                               m_commutator, texMng, metalineMng,
-                                               m_customFeaturesContext,
-                                               m_have3dBuildings && m_allow3dBuildings,
-                                               m_trafficEnabled, m_displacementMode,
-                                               m_ugcRenderingEnabled ? m_isUGCFn : nullptr);
+  auto context = CreateEngineContext(tileKey, texMng, metalineMng, false /* isPrefetching */);
   std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
   m_tileInfos.insert(tileInfo);
   ReadMWMTask * task = m_tasksPool.Get();
@@ -251,6 +362,20 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
   m_pool->PushBack(task);
 }
 
+drape_ptr<EngineContext> ReadManager::CreateEngineContext(TileKey const & tileKey,
+                                                         ref_ptr<dp::TextureManager> texMng,
+                                                         ref_ptr<MetalineManager> metalineMng,
+                                                         bool isPrefetching) const
+{
+  return make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
+                                       m_commutator, texMng, metalineMng,
+                                       m_customFeaturesContext,
+                                       m_have3dBuildings && m_allow3dBuildings,
+                                       m_trafficEnabled, m_displacementMode,
+                                       m_ugcRenderingEnabled ? m_isUGCFn : nullptr,
+                                       make_ref(m_shapesCache), isPrefetching);
+}
+
 void ReadManager::CheckFinishedTiles(TTileInfoCollection const & requestedTiles, bool forceUpdateUserMarks)
 {
   if (requestedTiles.empty())
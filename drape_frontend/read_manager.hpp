@@ -3,6 +3,7 @@
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
 #include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
 #include "geometry/screenbase.hpp"
@@ -32,8 +33,10 @@ uint8_t constexpr kReadingThreadsCount = 2;
 class ReadManager
 {
 public:
+  // Shapes of |tileShapesCacheSize| recently read tiles are cached, see TileShapesCache.
   ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-              bool allow3dBuildings, bool trafficEnabled, EngineContext::TIsUGCFn && isUGCFn);
+              bool allow3dBuildings, bool trafficEnabled, size_t tileShapesCacheSize,
+              EngineContext::TIsUGCFn && isUGCFn);
 
   void Start();
   void Stop();
@@ -46,6 +49,12 @@ public:
   void Invalidate(TTilesCollection const & keyStorage);
   void InvalidateAll();
 
+  // Reads |tiles| with the low priority to the shapes cache in the given order, so they are
+  // shown at once when they get into the coverage. Tiles which were requested by the previous
+  // call and aren't requested now are cancelled. Does nothing if the cache is disabled.
+  void Prefetch(std::vector<TileKey> const & tiles, ref_ptr<dp::TextureManager> texMng,
+                ref_ptr<MetalineManager> metalineMng);
+
   bool CheckTileKey(TileKey const & tileKey) const;
   void Allow3dBuildings(bool allow3dBuildings);
 
@@ -68,12 +77,18 @@ private:
 
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
                               ref_ptr<MetalineManager> metalineMng);
+  drape_ptr<EngineContext> CreateEngineContext(TileKey const & tileKey,
+                                               ref_ptr<dp::TextureManager> texMng,
+                                               ref_ptr<MetalineManager> metalineMng,
+                                               bool isPrefetching) const;
+  void CancelPrefetching();
 
   ref_ptr<ThreadsCommutator> m_commutator;
 
   MapDataProvider & m_model;
 
   drape_ptr<threads::ThreadPool> m_pool;
+  drape_ptr<TileShapesCache> m_shapesCache;
 
   ScreenBase m_currentViewport;
   bool m_have3dBuildings;
@@ -91,6 +106,10 @@ private:
 
   using TTileSet = std::set<std::shared_ptr<TileInfo>, LessByTileInfo>;
   TTileSet m_tileInfos;
+  // Prefetched tiles take at most a half of the shapes cache, so they don't evict all the tiles
+  // which were shown recently.
+  size_t const m_maxPrefetchedTilesCount;
+  TTileSet m_prefetchedTileInfos;
 
   dp::ObjectPool<ReadMWMTask, ReadMWMTaskFactory> m_tasksPool;
 
@@ -14,6 +14,7 @@ void ReadMWMTask::Init(std::shared_ptr<TileInfo> const & tileInfo)
 {
   m_tileInfo = tileInfo;
   m_tileKey = tileInfo->GetTileKey();
+  m_isPrefetching = tileInfo->IsPrefetching();
 #ifdef DEBUG
   m_checker = true;
 #endif
@@ -19,10 +19,12 @@ public:
   void Reset() override;
   bool IsCancelled() const override;
   TileKey const & GetTileKey() const { return m_tileKey; }
+  bool IsPrefetching() const { return m_isPrefetching; }
 
 private:
   std::weak_ptr<TileInfo> m_tileInfo;
   TileKey m_tileKey;
+  bool m_isPrefetching = false;
   MapDataProvider & m_model;
 
 #ifdef DEBUG
@@ -71,13 +71,16 @@ void RenderGroup::SetOverlayVisibility(bool isVisible)
 
 void RenderGroup::Render(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng,
                          ScreenBase const & screen, FrameValues const & frameValues,
-                         ref_ptr<DebugRectRenderer> debugRectRenderer)
+                         ref_ptr<DebugRectRenderer> debugRectRenderer, bool applyState)
 {
   auto programPtr = mng->GetProgram(screen.isPerspective() ? m_state.GetProgram3d<gpu::Program>()
                                                            : m_state.GetProgram<gpu::Program>());
   ASSERT(programPtr != nullptr, ());
-  programPtr->Bind();
-  dp::ApplyState(context, programPtr, m_state);
+  if (applyState)
+  {
+    programPtr->Bind();
+    dp::ApplyState(context, programPtr, m_state);
+  }
 
   for(auto & renderBucket : m_renderBuckets)
     renderBucket->GetBuffer()->Build(context, programPtr);
@@ -37,8 +37,11 @@ public:
   TileKey const & GetTileKey() const { return m_tileKey; }
 
   virtual void UpdateAnimation();
+  // If |applyState| is false the program and the state are already applied by the previously
+  // rendered group with the equal state.
   virtual void Render(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng, ScreenBase const & screen,
-                      FrameValues const & frameValues, ref_ptr<DebugRectRenderer> debugRectRenderer) = 0;
+                      FrameValues const & frameValues, ref_ptr<DebugRectRenderer> debugRectRenderer,
+                      bool applyState) = 0;
 
 protected:
   dp::RenderState m_state;
@@ -61,7 +64,8 @@ public:
   void RemoveOverlay(ref_ptr<dp::OverlayTree> tree);
   void SetOverlayVisibility(bool isVisible);
   void Render(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng, ScreenBase const & screen,
-              FrameValues const & frameValues, ref_ptr<DebugRectRenderer> debugRectRenderer) override;
+              FrameValues const & frameValues, ref_ptr<DebugRectRenderer> debugRectRenderer,
+              bool applyState) override;
 
   void AddBucket(drape_ptr<dp::RenderBucket> && bucket);
 
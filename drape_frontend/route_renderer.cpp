@@ -740,6 +740,45 @@ bool RouteRenderer::HasTransitData() const
   return false;
 }
 
+std::vector<m2::PointD> RouteRenderer::GetPathAhead(double length) const
+{
+  std::vector<m2::PointD> path;
+  if (!m_followingEnabled || m_distanceFromBegin < 0.0)
+    return path;
+
+  double remaining = length;
+  for (auto const & subrouteInfo : m_subroutes)
+  {
+    // Distance from the beginning of the subroute to the current position, it's negative
+    // for the subroutes which are ahead.
+    double offset = m_distanceFromBegin - subrouteInfo.m_subroute->m_baseDistance;
+    auto const & points = subrouteInfo.m_subroute->m_polyline.GetPoints();
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+      if (remaining <= 0.0)
+        return path;
+
+      m2::PointD const & p1 = points[i - 1];
+      m2::PointD const & p2 = points[i];
+      double const segmentLength = p1.Length(p2);
+      if (segmentLength == 0.0 || offset >= segmentLength)
+      {
+        offset -= segmentLength;
+        continue;
+      }
+
+      double const from = std::max(offset, 0.0);
+      double const to = std::min(segmentLength, from + remaining);
+      if (path.empty())
+        path.push_back(p1 + (p2 - p1) * (from / segmentLength));
+      path.push_back(p1 + (p2 - p1) * (to / segmentLength));
+      remaining -= to - from;
+      offset = 0.0;
+    }
+  }
+  return path;
+}
+
 bool RouteRenderer::HasData() const
 {
   return !m_subroutes.empty();
@@ -87,6 +87,10 @@ public:
   void UpdateDistanceFromBegin(double distanceFromBegin);
   void SetFollowingEnabled(bool enabled);
 
+  // Returns points of the part of the route which is |length| ahead of the current position.
+  // The path is empty if the route isn't followed.
+  std::vector<m2::PointD> GetPathAhead(double length) const;
+
   void AddPreviewSegment(dp::DrapeID id, PreviewInfo && info);
   void RemovePreviewSegment(dp::DrapeID id);
   void RemoveAllPreviewSegments();
@@ -19,6 +19,7 @@
 
 #include "geometry/clipping.hpp"
 
+#include "base/arena.hpp"
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
@@ -420,12 +421,16 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s,
       if (find(classes.begin(), classes.end(), highwayClass) != classes.end() &&
           zoomLevel >= checkers[i].m_zoomLevel)
       {
-        std::vector<m2::PointD> points;
+        // Scratch memory of the tile, see TileInfo::ReadFeatures().
+        base::ArenaVector<m2::PointD> points;
         points.reserve(f.GetPointsCount());
-        f.ResetGeometry();
+        // Points of the tile are reused when they are the best geometry (on high zoom levels).
+        if (!f.IsBestGeometryParsed())
+          f.ResetGeometry();
         f.ForEachPoint([&points](m2::PointD const & p) { points.emplace_back(p); },
                        FeatureType::BEST_GEOMETRY);
-        ExtractTrafficGeometry(f, checkers[i].m_roadClass, m2::PolylineD(points), oneWay,
+        ExtractTrafficGeometry(f, checkers[i].m_roadClass,
+                               m2::PolylineD(points.begin(), points.end()), oneWay,
                                zoomLevel, m_trafficScalePtoG, m_trafficGeometry);
         break;
       }
@@ -0,0 +1,42 @@
+#include "drape_frontend/tile_batcher.hpp"
+
+#include "drape/texture_manager.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace df
+{
+uint32_t constexpr kBatchSize = 5000;
+
+TileBatcher::TileBatcher()
+  : m_batcher(kBatchSize, kBatchSize)
+{
+  m_batcher.SetPreflushEnabled(false);
+  m_batcher.StartSession([this](dp::RenderState const & state, drape_ptr<dp::RenderBucket> && bucket)
+  {
+    m_data.emplace_back(state, std::move(bucket));
+  });
+}
+
+void TileBatcher::Batch(TMapShapes const & shapes, ref_ptr<dp::TextureManager> texMng,
+                        TTileRenderData & data)
+{
+  for (auto const & shape : shapes)
+  {
+    m_batcher.SetFeatureMinZoom(shape->GetFeatureMinZoom());
+    shape->Draw(nullptr /* context */, make_ref(&m_batcher), texMng);
+  }
+
+  std::move(m_data.begin(), m_data.end(), std::back_inserter(data));
+  m_data.clear();
+}
+
+void TileBatcher::Finish(TTileRenderData & data)
+{
+  m_batcher.EndSession(nullptr /* context */);
+  std::move(m_data.begin(), m_data.end(), std::back_inserter(data));
+  m_data.clear();
+}
+}  // namespace df
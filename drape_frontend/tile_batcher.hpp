@@ -0,0 +1,52 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+
+#include "drape/batcher.hpp"
+#include "drape/pointers.hpp"
+#include "drape/render_bucket.hpp"
+#include "drape/render_state.hpp"
+
+#include "base/macros.hpp"
+
+#include <vector>
+
+namespace dp
+{
+class TextureManager;
+}  // namespace dp
+
+namespace df
+{
+struct TileRenderData
+{
+  dp::RenderState m_state;
+  drape_ptr<dp::RenderBucket> m_bucket;
+
+  TileRenderData(dp::RenderState const & state, drape_ptr<dp::RenderBucket> && bucket)
+    : m_state(state), m_bucket(std::move(bucket))
+  {}
+};
+
+using TTileRenderData = std::vector<TileRenderData>;
+
+// Batches map shapes of a tile on a reading thread. Buffers of the buckets aren't moved to GPU,
+// it's done by the backend renderer, so only uploading is left to the backend thread.
+class TileBatcher
+{
+public:
+  TileBatcher();
+
+  // Buckets which are filled while |shapes| are batched are moved to |data|.
+  void Batch(TMapShapes const & shapes, ref_ptr<dp::TextureManager> texMng,
+             TTileRenderData & data);
+  // Moves the rest of the buckets to |data|.
+  void Finish(TTileRenderData & data);
+
+private:
+  dp::Batcher m_batcher;
+  TTileRenderData m_data;
+
+  DISALLOW_COPY_AND_MOVE(TileBatcher);
+};
+}  // namespace df
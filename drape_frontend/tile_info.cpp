@@ -10,8 +10,10 @@
 
 #include "platform/preferred_languages.hpp"
 
+#include "base/arena.hpp"
 #include "base/scope_guard.hpp"
 #include "base/logging.hpp"
+#include "base/trace.hpp"
 
 #include <algorithm>
 #include <functional>
@@ -32,6 +34,7 @@ m2::RectD TileInfo::GetGlobalRect() const
 
 void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 {
+  TRACE_ZONE("TileInfo::ReadFeatureIndex");
   if (!DoNeedReadIndex())
     return;
 
@@ -55,14 +58,23 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 
 void TileInfo::ReadFeatures(MapDataProvider const & model)
 {
-#if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
-  DrapeMeasurer::Instance().StartTileReading();
-#endif
+  TRACE_ZONE("TileInfo::ReadFeatures");
   m_context->BeginReadTile();
 
   // Reading can be interrupted by exception throwing
   SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
 
+  auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+  if (m_context->FlushCachedShapes(deviceLang))
+    return;
+
+#if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
+  DrapeMeasurer::Instance().StartTileReading();
+#endif
+
+  // Scratch memory which is allocated while the tile is read is released at once.
+  base::Arena::Scope scratch;
+
   ReadFeatureIndex(model);
   CheckCanceled();
 
@@ -71,12 +83,17 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
   if (!m_featureInfo.empty())
   {
     std::sort(m_featureInfo.begin(), m_featureInfo.end());
-    auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
     RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
                       std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
                       model.GetFilter(), make_ref(m_context));
+    TRACE_ZONE("TileInfo::DrawFeatures");
+    TRACE_COUNTER("Tile features", static_cast<int64_t>(m_featureInfo.size()));
     model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
   }
+
+  // Shapes are flushed when the drawer is destroyed unless the reading is cancelled.
+  if (!IsCancelled())
+    m_context->CacheShapes();
 #if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().EndTileReading();
 #endif
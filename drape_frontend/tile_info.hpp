@@ -33,6 +33,7 @@ public:
 
   m2::RectD GetGlobalRect() const;
   TileKey const & GetTileKey() const { return m_context->GetTileKey(); }
+  bool IsPrefetching() const { return m_context->IsPrefetching(); }
   bool operator <(TileInfo const & other) const { return GetTileKey() < other.GetTileKey(); }
 
 private:
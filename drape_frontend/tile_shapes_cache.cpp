@@ -0,0 +1,79 @@
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include "base/assert.hpp"
+
+namespace df
+{
+TileShapesCache::TileShapesCache(size_t maxTilesCount) : m_maxTilesCount(maxTilesCount)
+{
+  CHECK_GREATER(m_maxTilesCount, 0, ());
+}
+
+std::shared_ptr<TileShapesCache::Entry const> TileShapesCache::Find(TileKey const & tileKey,
+                                                                    int8_t deviceLang)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_entries.find(tileKey);
+  if (it == m_entries.end() || it->second.first->m_deviceLang != deviceLang)
+    return nullptr;
+
+  m_order.splice(m_order.begin(), m_order, it->second.second);
+  return it->second.first;
+}
+
+uint64_t TileShapesCache::GetEpoch() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_epoch;
+}
+
+void TileShapesCache::Add(TileKey const & tileKey, uint64_t epoch,
+                          std::shared_ptr<Entry const> && entry)
+{
+  ASSERT(entry, ());
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (epoch != m_epoch)
+    return;
+
+  auto const it = m_entries.find(tileKey);
+  if (it != m_entries.end())
+  {
+    it->second.first = std::move(entry);
+    m_order.splice(m_order.begin(), m_order, it->second.second);
+    return;
+  }
+
+  if (m_entries.size() == m_maxTilesCount)
+  {
+    m_entries.erase(m_order.back());
+    m_order.pop_back();
+  }
+
+  m_order.push_front(tileKey);
+  m_entries.emplace(tileKey, std::make_pair(std::move(entry), m_order.begin()));
+}
+
+void TileShapesCache::Erase(TTilesCollection const & tiles)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // Tiles which are being read now may have the old shapes.
+  ++m_epoch;
+  for (auto const & tileKey : tiles)
+  {
+    auto const it = m_entries.find(tileKey);
+    if (it == m_entries.end())
+      continue;
+
+    m_order.erase(it->second.second);
+    m_entries.erase(it);
+  }
+}
+
+void TileShapesCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_epoch;
+  m_order.clear();
+  m_entries.clear();
+}
+}  // namespace df
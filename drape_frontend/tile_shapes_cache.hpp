@@ -0,0 +1,67 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_utils.hpp"
+#include "drape_frontend/traffic_generator.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace df
+{
+// Cache of map shapes of the recently read tiles. When a tile is shown again, its shapes are
+// drawn by the backend renderer again instead of reading and styling features of the tile.
+// Shapes aren't changed after reading, so they are shared by the cache and the messages.
+//
+// Shapes depend on textures and on the reading mode, so the cache is cleared by ReadManager
+// when tiles are reread for any reason except the viewport change.
+class TileShapesCache
+{
+public:
+  using SharedShapes = std::shared_ptr<TMapShapes const>;
+
+  struct Entry
+  {
+    // Shapes in the order of flushing, overlay shapes are marked by true.
+    std::vector<std::pair<bool, SharedShapes>> m_shapes;
+    TrafficSegmentsGeometry m_trafficGeometry;
+    int8_t m_deviceLang = 0;
+  };
+
+  explicit TileShapesCache(size_t maxTilesCount);
+
+  // All the methods are thread-safe.
+
+  // Returns nullptr if there are no shapes of |tileKey| which are read for |deviceLang|.
+  std::shared_ptr<Entry const> Find(TileKey const & tileKey, int8_t deviceLang);
+
+  // Entries are added only if the cache isn't cleared after |epoch| was got.
+  uint64_t GetEpoch() const;
+  void Add(TileKey const & tileKey, uint64_t epoch, std::shared_ptr<Entry const> && entry);
+
+  void Erase(TTilesCollection const & tiles);
+  void Clear();
+
+private:
+  using Order = std::list<TileKey>;
+
+  size_t const m_maxTilesCount;
+
+  mutable std::mutex m_mutex;
+  // Tiles from the most recently used.
+  Order m_order;
+  std::map<TileKey, std::pair<std::shared_ptr<Entry const>, Order::iterator>> m_entries;
+  uint64_t m_epoch = 0;
+
+  DISALLOW_COPY_AND_MOVE(TileShapesCache);
+};
+}  // namespace df
@@ -7,6 +7,8 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 CoverageResult CalcTilesCoverage(m2::RectD const & rect, int targetZoom,
@@ -53,4 +55,62 @@ TileKey GetTileKeyByPoint(m2::PointD const & pt, int zoom)
   return TileKey(static_cast<int>(floor(pt.x / rectSize)),
                  static_cast<int>(floor(pt.y / rectSize)), zoom);
 }
+
+std::vector<TileKey> GetTilesAlongPath(std::vector<m2::PointD> const & path, double radius,
+                                       int zoom, TTilesCollection const & exceptTiles,
+                                       size_t maxCount)
+{
+  ASSERT_GREATER(zoom, 0, ());
+  std::vector<TileKey> result;
+  if (path.empty() || maxCount == 0)
+    return result;
+
+  int const dataZoom = ClipTileZoomByMaxDataZoom(zoom);
+  double const range = MercatorBounds::maxX - MercatorBounds::minX;
+  double const step = range / (1 << (dataZoom - 1)) / 2;
+
+  TTilesCollection visited;
+  std::vector<TileKey> tiles;
+  auto const addTiles = [&](m2::PointD const & pt)
+  {
+    m2::RectD rect(pt, pt);
+    rect.Inflate(radius, radius);
+
+    tiles.clear();
+    CalcTilesCoverage(rect, dataZoom, [&](int tileX, int tileY)
+    {
+      TileKey const key(tileX, tileY, zoom);
+      if (exceptTiles.find(key) == exceptTiles.end() && visited.insert(key).second)
+        tiles.push_back(key);
+    });
+
+    std::sort(tiles.begin(), tiles.end(), [&pt](TileKey const & l, TileKey const & r)
+    {
+      return l.GetGlobalRect().Center().SquaredLength(pt) <
+             r.GetGlobalRect().Center().SquaredLength(pt);
+    });
+    for (auto const & key : tiles)
+    {
+      if (result.size() == maxCount)
+        return false;
+      result.push_back(key);
+    }
+    return true;
+  };
+
+  // Points of the path are taken with the step of a half of a tile, so no tiles are missed.
+  if (!addTiles(path.front()))
+    return result;
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    double const length = path[i - 1].Length(path[i]);
+    auto const stepsCount = static_cast<size_t>(ceil(length / step));
+    for (size_t j = 1; j <= stepsCount; ++j)
+    {
+      if (!addTiles(path[i - 1] + (path[i] - path[i - 1]) * (static_cast<double>(j) / stepsCount)))
+        return result;
+    }
+  }
+  return result;
+}
 }  // namespace df
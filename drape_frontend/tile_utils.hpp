@@ -2,8 +2,12 @@
 
 #include "drape_frontend/tile_key.hpp"
 
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
 #include <functional>
 #include <set>
+#include <vector>
 
 namespace df
 {
@@ -30,4 +34,10 @@ int ClipTileZoomByMaxDataZoom(int zoom);
 
 // This function returns tile key by point on specific zoom level.
 TileKey GetTileKeyByPoint(m2::PointD const & pt, int zoom);
+
+// This function returns tiles of |zoom| which are closer than |radius| to |path| in the order
+// of the path. Tiles from |exceptTiles| are skipped, at most |maxCount| tiles are returned.
+std::vector<TileKey> GetTilesAlongPath(std::vector<m2::PointD> const & path, double radius,
+                                       int zoom, TTilesCollection const & exceptTiles,
+                                       size_t maxCount);
 }  // namespace df
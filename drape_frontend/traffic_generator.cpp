@@ -133,6 +133,7 @@ void TrafficGenerator::Init()
 void TrafficGenerator::ClearContextDependentResources()
 {
   InvalidateTexturesCache();
+  m_geometryCache.clear();
   m_batchersPool.reset();
   m_circlesBatcher.reset();
 }
@@ -171,20 +172,20 @@ void TrafficGenerator::GenerateSegmentsGeometry(ref_ptr<dp::GraphicsContext> con
 
   for (auto const & geomPair : geometry)
   {
-    auto const coloringIt = coloring.find(geomPair.first);
-    if (coloringIt == coloring.cend() || coloringIt->second == traffic::SpeedGroup::Unknown)
+    auto const speedGroup = coloring.Get(geomPair.first);
+    if (speedGroup == traffic::SpeedGroup::Unknown)
       continue;
 
-    auto const & colorRegion = m_colorsCache[static_cast<size_t>(coloringIt->second)];
-    auto const vOffset = kCoordVOffsets[static_cast<size_t>(coloringIt->second)];
-    auto const minU = kMinCoordU[static_cast<size_t>(coloringIt->second)];
+    auto const & colorRegion = m_colorsCache[static_cast<size_t>(speedGroup)];
+    auto const vOffset = kCoordVOffsets[static_cast<size_t>(speedGroup)];
+    auto const minU = kMinCoordU[static_cast<size_t>(speedGroup)];
 
     TrafficSegmentGeometry const & g = geomPair.second;
     ref_ptr<dp::Batcher> batcher =
       m_batchersPool->GetBatcher(TrafficBatcherKey(mwmId, tileKey, g.m_roadClass));
 
     auto const finalDepth = kRoadClassDepths[static_cast<size_t>(g.m_roadClass)] +
-                            static_cast<float>(coloringIt->second);
+                            static_cast<float>(speedGroup);
 
     int width = 0;
     if (TrafficRenderer::CanBeRenderedAsLine(g.m_roadClass, tileKey.m_zoomLevel, width))
@@ -231,39 +232,87 @@ void TrafficGenerator::GenerateSegmentsGeometry(ref_ptr<dp::GraphicsContext> con
 
 void TrafficGenerator::FlushSegmentsGeometry(ref_ptr<dp::GraphicsContext> context,
                                              TileKey const & tileKey,
-                                             TrafficSegmentsGeometry const & geom,
+                                             TrafficSegmentsGeometry && geom,
                                              ref_ptr<dp::TextureManager> textures)
 {
   FillColorsCache(textures);
 
-  static std::vector<RoadClass> const kRoadClasses = {RoadClass::Class0, RoadClass::Class1,
-                                                      RoadClass::Class2};
-  for (auto const & g : geom)
+  // Tiles of other zoom levels aren't rendered anymore.
+  for (auto it = m_geometryCache.begin(); it != m_geometryCache.end();)
   {
-    auto const & mwmId = g.first;
-    auto coloringIt = m_coloring.find(mwmId);
-    if (coloringIt == m_coloring.cend())
-      continue;
+    if (it->first.m_zoomLevel != tileKey.m_zoomLevel || it->first == tileKey)
+      it = m_geometryCache.erase(it);
+    else
+      ++it;
+  }
+  auto const & cachedGeometry = m_geometryCache.emplace(tileKey, std::move(geom)).first->second;
 
-    for (auto const & roadClass : kRoadClasses)
-      m_batchersPool->ReserveBatcher(TrafficBatcherKey(mwmId, tileKey, roadClass));
+  for (auto const & g : cachedGeometry)
+    FlushMwmGeometry(context, g.first, tileKey, g.second, textures);
 
-    m_circlesBatcher->StartSession([this, mwmId, tileKey](dp::RenderState const & state,
-                                                          drape_ptr<dp::RenderBucket> && renderBucket)
-    {
-      FlushGeometry(TrafficBatcherKey(mwmId, tileKey, RoadClass::Class0), state,
-                    std::move(renderBucket));
-    });
+  context->Flush();
+}
 
-    GenerateSegmentsGeometry(context, mwmId, tileKey, g.second, coloringIt->second, textures);
+std::vector<TrafficRenderData> TrafficGenerator::RegenerateSegmentsGeometry(
+    ref_ptr<dp::GraphicsContext> context, TrafficSegmentsColoring const & coloring,
+    CheckTileFn const & checkTileFn, ref_ptr<dp::TextureManager> textures,
+    std::vector<TileKey> & tiles)
+{
+  std::vector<TrafficRenderData> renderData;
+  FillColorsCache(textures);
 
-    for (auto const & roadClass : kRoadClasses)
-      m_batchersPool->ReleaseBatcher(context, TrafficBatcherKey(mwmId, tileKey, roadClass));
+  m_regeneratedData = &renderData;
+  for (auto it = m_geometryCache.begin(); it != m_geometryCache.end();)
+  {
+    if (!checkTileFn(it->first))
+    {
+      it = m_geometryCache.erase(it);
+      continue;
+    }
 
-    m_circlesBatcher->EndSession(context);
+    tiles.push_back(it->first);
+    for (auto const & c : coloring)
+    {
+      auto const geometryIt = it->second.find(c.first);
+      if (geometryIt != it->second.cend())
+        FlushMwmGeometry(context, c.first, it->first, geometryIt->second, textures);
+    }
+    ++it;
   }
+  m_regeneratedData = nullptr;
 
   context->Flush();
+  return renderData;
+}
+
+void TrafficGenerator::FlushMwmGeometry(ref_ptr<dp::GraphicsContext> context,
+                                        MwmSet::MwmId const & mwmId, TileKey const & tileKey,
+                                        TrafficSegmentsGeometryValue const & geometry,
+                                        ref_ptr<dp::TextureManager> textures)
+{
+  static std::vector<RoadClass> const kRoadClasses = {RoadClass::Class0, RoadClass::Class1,
+                                                      RoadClass::Class2};
+
+  auto coloringIt = m_coloring.find(mwmId);
+  if (coloringIt == m_coloring.cend())
+    return;
+
+  for (auto const & roadClass : kRoadClasses)
+    m_batchersPool->ReserveBatcher(TrafficBatcherKey(mwmId, tileKey, roadClass));
+
+  m_circlesBatcher->StartSession([this, mwmId, tileKey](dp::RenderState const & state,
+                                                        drape_ptr<dp::RenderBucket> && renderBucket)
+  {
+    FlushGeometry(TrafficBatcherKey(mwmId, tileKey, RoadClass::Class0), state,
+                  std::move(renderBucket));
+  });
+
+  GenerateSegmentsGeometry(context, mwmId, tileKey, geometry, coloringIt->second, textures);
+
+  for (auto const & roadClass : kRoadClasses)
+    m_batchersPool->ReleaseBatcher(context, TrafficBatcherKey(mwmId, tileKey, roadClass));
+
+  m_circlesBatcher->EndSession(context);
 }
 
 void TrafficGenerator::UpdateColoring(TrafficSegmentsColoring const & coloring)
@@ -276,11 +325,14 @@ void TrafficGenerator::ClearCache()
 {
   InvalidateTexturesCache();
   m_coloring.clear();
+  m_geometryCache.clear();
 }
 
 void TrafficGenerator::ClearCache(MwmSet::MwmId const & mwmId)
 {
   m_coloring.erase(mwmId);
+  for (auto & g : m_geometryCache)
+    g.second.erase(mwmId);
 }
 
 void TrafficGenerator::InvalidateTexturesCache()
@@ -296,7 +348,10 @@ void TrafficGenerator::FlushGeometry(TrafficBatcherKey const & key, dp::RenderSt
   renderData.m_mwmId = key.m_mwmId;
   renderData.m_tileKey = key.m_tileKey;
   renderData.m_roadClass = key.m_roadClass;
-  m_flushRenderDataFn(std::move(renderData));
+  if (m_regeneratedData != nullptr)
+    m_regeneratedData->push_back(std::move(renderData));
+  else
+    m_flushRenderDataFn(std::move(renderData));
 }
 
 void TrafficGenerator::GenerateSegment(RoadClass roadClass,
@@ -171,9 +171,19 @@ public:
   void ClearContextDependentResources();
 
   void FlushSegmentsGeometry(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKey,
-                             TrafficSegmentsGeometry const & geom, ref_ptr<dp::TextureManager> textures);
+                             TrafficSegmentsGeometry && geom, ref_ptr<dp::TextureManager> textures);
   void UpdateColoring(TrafficSegmentsColoring const & coloring);
 
+  using CheckTileFn = std::function<bool(TileKey const & tileKey)>;
+  // Generates traffic geometry of the mwms from |coloring| again. Geometry of segments is taken
+  // from the tiles which were flushed before, so the tiles aren't read. Only tiles which pass
+  // |checkTileFn| are regenerated and returned in |tiles|, the rest ones are removed from the cache.
+  std::vector<TrafficRenderData> RegenerateSegmentsGeometry(ref_ptr<dp::GraphicsContext> context,
+                                                            TrafficSegmentsColoring const & coloring,
+                                                            CheckTileFn const & checkTileFn,
+                                                            ref_ptr<dp::TextureManager> textures,
+                                                            std::vector<TileKey> & tiles);
+
   void ClearCache();
   void ClearCache(MwmSet::MwmId const & mwmId);
   void InvalidateTexturesCache();
@@ -228,8 +238,16 @@ private:
                                 TrafficSegmentsGeometryValue const & geometry,
                                 traffic::TrafficInfo::Coloring const & coloring,
                                 ref_ptr<dp::TextureManager> texturesMgr);
+  void FlushMwmGeometry(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId,
+                        TileKey const & tileKey, TrafficSegmentsGeometryValue const & geometry,
+                        ref_ptr<dp::TextureManager> textures);
 
   TrafficSegmentsColoring m_coloring;
+  // Segments geometry of flushed tiles of the current zoom level. Generation of tile keys
+  // is the one of the last flushed geometry.
+  std::map<TileKey, TrafficSegmentsGeometry> m_geometryCache;
+  // Render data is collected here instead of flushing during regeneration.
+  std::vector<TrafficRenderData> * m_regeneratedData = nullptr;
 
   std::array<dp::TextureManager::ColorRegion, static_cast<size_t>(traffic::SpeedGroup::Count)> m_colorsCache;
   bool m_colorsCacheValid = false;
@@ -105,15 +105,45 @@ void TrafficRenderer::AddRenderData(ref_ptr<dp::GraphicsContext> context,
 
   // Add new render data.
   m_renderData.emplace_back(std::move(renderData));
-  TrafficRenderData & rd = m_renderData.back();
+  BuildRenderData(context, mng, m_renderData.back());
 
-  auto program = mng->GetProgram(rd.m_state.GetProgram<gpu::Program>());
-  program->Bind();
-  rd.m_bucket->GetBuffer()->Build(context, program);
+  std::sort(m_renderData.begin(), m_renderData.end());
+}
+
+void TrafficRenderer::UpdateRenderData(ref_ptr<dp::GraphicsContext> context,
+                                       ref_ptr<gpu::ProgramManager> mng,
+                                       std::vector<MwmSet::MwmId> const & mwms,
+                                       std::vector<TileKey> const & tiles,
+                                       std::vector<TrafficRenderData> && renderData)
+{
+  // Old data is removed in the same frame when the new one appears to avoid blinking.
+  m_renderData.erase(std::remove_if(m_renderData.begin(), m_renderData.end(),
+                                    [&mwms, &tiles](TrafficRenderData const & rd)
+  {
+    return std::find(mwms.begin(), mwms.end(), rd.m_mwmId) != mwms.end() &&
+           std::find(tiles.begin(), tiles.end(), rd.m_tileKey) != tiles.end();
+  }), m_renderData.end());
+
+  m_renderData.reserve(m_renderData.size() + renderData.size());
+  for (auto & rd : renderData)
+  {
+    m_renderData.emplace_back(std::move(rd));
+    BuildRenderData(context, mng, m_renderData.back());
+  }
 
   std::sort(m_renderData.begin(), m_renderData.end());
 }
 
+// static
+void TrafficRenderer::BuildRenderData(ref_ptr<dp::GraphicsContext> context,
+                                      ref_ptr<gpu::ProgramManager> mng,
+                                      TrafficRenderData & renderData)
+{
+  auto program = mng->GetProgram(renderData.m_state.GetProgram<gpu::Program>());
+  program->Bind();
+  renderData.m_bucket->GetBuffer()->Build(context, program);
+}
+
 void TrafficRenderer::OnUpdateViewport(CoverageResult const & coverage, int currentZoomLevel,
                                        buffer_vector<TileKey, 8> const & tilesToDelete)
 {
@@ -22,6 +22,10 @@ public:
 
   void AddRenderData(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng,
                      TrafficRenderData && renderData);
+  // Replaces render data of |mwms| in |tiles| with the regenerated one.
+  void UpdateRenderData(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng,
+                        std::vector<MwmSet::MwmId> const & mwms, std::vector<TileKey> const & tiles,
+                        std::vector<TrafficRenderData> && renderData);
 
   void RenderTraffic(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng,
                      ScreenBase const & screen, int zoomLevel, float opacity,
@@ -40,6 +44,9 @@ public:
   static bool CanBeRenderedAsLine(RoadClass const & roadClass, int zoomLevel, int & width);
 
 private:
+  static void BuildRenderData(ref_ptr<dp::GraphicsContext> context, ref_ptr<gpu::ProgramManager> mng,
+                              TrafficRenderData & renderData);
+
   static float GetPixelWidth(RoadClass const & roadClass, int zoomLevel);
   static float GetPixelWidthInternal(RoadClass const & roadClass, int zoomLevel);
 
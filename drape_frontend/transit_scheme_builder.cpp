@@ -20,6 +20,10 @@
 
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace std;
 
 namespace df
@@ -73,14 +77,6 @@ struct TransitStaticVertex
   TColor m_color;
 };
 
-struct SchemeSegment
-{
-  glsl::vec2 m_p1;
-  glsl::vec2 m_p2;
-  glsl::vec2 m_tangent;
-  glsl::vec2 m_leftNormal;
-  glsl::vec2 m_rightNormal;
-};
 using TGeometryBuffer = std::vector<TransitStaticVertex>;
 
 dp::BindingInfo const & GetTransitStaticBindingInfo()
@@ -285,23 +281,45 @@ void TransitSchemeBuilder::UpdateSchemes(ref_ptr<dp::GraphicsContext> context,
                                          TransitDisplayInfos const & transitDisplayInfos,
                                          ref_ptr<dp::TextureManager> textures)
 {
+  vector<MwmSet::MwmId> mwmIds;
+  vector<pair<TransitDisplayInfo const *, MwmSchemeData *>> updates;
   for (auto const & mwmInfo : transitDisplayInfos)
   {
     if (!mwmInfo.second)
       continue;
 
-    auto const & mwmId = mwmInfo.first;
-    auto const & transitDisplayInfo = *mwmInfo.second.get();
+    mwmIds.push_back(mwmInfo.first);
+    updates.emplace_back(mwmInfo.second.get(), &m_schemes[mwmInfo.first]);
+  }
+
+  // Only the schemes of the updated mwms are collected, the schemes of the different mwms
+  // are independent, so they are collected in parallel. Batching is left to the backend thread.
+  atomic<size_t> next(0);
+  auto const collectSchemes = [&]() {
+    for (size_t i = next++; i < updates.size(); i = next++)
+    {
+      auto const & transitDisplayInfo = *updates[i].first;
+      MwmSchemeData & scheme = *updates[i].second;
+
+      CollectStops(transitDisplayInfo, mwmIds[i], scheme);
+      CollectLines(transitDisplayInfo, scheme);
+      CollectShapes(transitDisplayInfo, scheme);
 
-    MwmSchemeData & scheme = m_schemes[mwmId];
+      PrepareScheme(scheme);
+    }
+  };
 
-    CollectStops(transitDisplayInfo, mwmId, scheme);
-    CollectLines(transitDisplayInfo, scheme);
-    CollectShapes(transitDisplayInfo, scheme);
+  size_t const threadsCount = min(static_cast<size_t>(thread::hardware_concurrency()),
+                                  updates.size());
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(collectSchemes);
+  collectSchemes();
+  for (auto & t : threads)
+    t.join();
 
-    PrepareScheme(scheme);
+  for (auto const & mwmId : mwmIds)
     BuildScheme(context, mwmId, textures);
-  }
 }
 
 void TransitSchemeBuilder::Clear()
@@ -537,6 +555,26 @@ void TransitSchemeBuilder::PrepareScheme(MwmSchemeData & scheme)
       boundingRect.Add(pt);
   }
   scheme.m_pivot = boundingRect.Center();
+
+  for (auto & shape : scheme.m_shapes)
+  {
+    auto const & path = shape.second.m_polyline;
+    auto & segments = shape.second.m_segments;
+    segments.clear();
+    segments.reserve(path.size() - 1);
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      if (path[i].EqualDxDy(path[i - 1], 1.0e-5))
+        continue;
+
+      SchemeSegment segment;
+      segment.m_p1 = glsl::ToVec2(MapShape::ConvertToLocal(path[i - 1], scheme.m_pivot, kShapeCoordScalar));
+      segment.m_p2 = glsl::ToVec2(MapShape::ConvertToLocal(path[i], scheme.m_pivot, kShapeCoordScalar));
+      CalculateTangentAndNormals(segment.m_p1, segment.m_p2, segment.m_tangent,
+                                 segment.m_leftNormal, segment.m_rightNormal);
+      segments.emplace_back(std::move(segment));
+    }
+  }
 }
 
 void TransitSchemeBuilder::GenerateShapes(ref_ptr<dp::GraphicsContext> context, MwmSet::MwmId const & mwmId)
@@ -582,7 +620,7 @@ void TransitSchemeBuilder::GenerateShapes(ref_ptr<dp::GraphicsContext> context,
         auto const & lineId = coloredLine.second;
         auto const depth = scheme.m_lines.at(lineId).m_depth;
 
-        GenerateLine(context, shape.second.m_polyline, scheme.m_pivot, colorConst, shapeOffset,
+        GenerateLine(context, shape.second.m_segments, colorConst, shapeOffset,
                      kTransitLineHalfWidth, depth, batcher);
         shapeOffset += shapeOffsetIncrement;
       }
@@ -808,33 +846,18 @@ void TransitSchemeBuilder::GenerateMarker(ref_ptr<dp::GraphicsContext> context,
 }
 
 void TransitSchemeBuilder::GenerateLine(ref_ptr<dp::GraphicsContext> context,
-                                        std::vector<m2::PointD> const & path,
-                                        m2::PointD const & pivot, dp::Color const & colorConst,
-                                        float lineOffset, float halfWidth, float depth,
-                                        dp::Batcher & batcher)
+                                        std::vector<SchemeSegment> const & segments,
+                                        dp::Color const & colorConst, float lineOffset,
+                                        float halfWidth, float depth, dp::Batcher & batcher)
 {
   using TV = TransitStaticVertex;
 
   TGeometryBuffer geometry;
   auto const color = glsl::vec4(colorConst.GetRedF(), colorConst.GetGreenF(), colorConst.GetBlueF(), 1.0f /* alpha */);
-  size_t const kAverageSize = path.size() * 6;
-  size_t const kAverageCapSize = 12;
-  geometry.reserve(kAverageSize + kAverageCapSize * 2);
-
-  std::vector<SchemeSegment> segments;
-  segments.reserve(path.size() - 1);
+  geometry.reserve(segments.size() * 6);
 
-  for (size_t i = 1; i < path.size(); ++i)
+  for (auto const & segment : segments)
   {
-    if (path[i].EqualDxDy(path[i - 1], 1.0e-5))
-      continue;
-
-    SchemeSegment segment;
-    segment.m_p1 = glsl::ToVec2(MapShape::ConvertToLocal(path[i - 1], pivot, kShapeCoordScalar));
-    segment.m_p2 = glsl::ToVec2(MapShape::ConvertToLocal(path[i], pivot, kShapeCoordScalar));
-    CalculateTangentAndNormals(segment.m_p1, segment.m_p2, segment.m_tangent,
-                               segment.m_leftNormal, segment.m_rightNormal);
-
     auto const startPivot = glsl::vec3(segment.m_p1, depth);
     auto const endPivot = glsl::vec3(segment.m_p2, depth);
     auto const offset = lineOffset * segment.m_rightNormal;
@@ -845,8 +868,6 @@ void TransitSchemeBuilder::GenerateLine(ref_ptr<dp::GraphicsContext> context,
     geometry.emplace_back(endPivot, TV::TNormal(segment.m_rightNormal * halfWidth - offset, -halfWidth, 0.0), color);
     geometry.emplace_back(startPivot, TV::TNormal(segment.m_leftNormal * halfWidth - offset, halfWidth, 0.0), color);
     geometry.emplace_back(endPivot, TV::TNormal(segment.m_leftNormal * halfWidth - offset, halfWidth, 0.0), color);
-
-    segments.emplace_back(std::move(segment));
   }
 
   dp::AttributeProvider provider(1 /* stream count */, static_cast<uint32_t>(geometry.size()));
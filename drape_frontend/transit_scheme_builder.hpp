@@ -1,6 +1,7 @@
 #pragma once
 
 #include "drape/batcher.hpp"
+#include "drape/glsl_types.hpp"
 #include "drape/render_bucket.hpp"
 #include "drape/render_state.hpp"
 #include "drape/texture_manager.hpp"
@@ -59,11 +60,23 @@ struct LineParams
   float m_depth;
 };
 
+struct SchemeSegment
+{
+  glsl::vec2 m_p1;
+  glsl::vec2 m_p2;
+  glsl::vec2 m_tangent;
+  glsl::vec2 m_leftNormal;
+  glsl::vec2 m_rightNormal;
+};
+
 struct ShapeParams
 {
   std::vector<routing::transit::LineId> m_forwardLines;
   std::vector<routing::transit::LineId> m_backwardLines;
   std::vector<m2::PointD> m_polyline;
+  // Segments of |m_polyline| in the local coordinates of the scheme. They are calculated once
+  // for all the lines of the shape and are reused when the scheme is rebuilt.
+  std::vector<SchemeSegment> m_segments;
 };
 
 struct ShapeInfo
@@ -173,9 +186,9 @@ private:
                       m2::PointD const & pivot, std::vector<m2::PointF> const & markerSizes,
                       ref_ptr<dp::TextureManager> textures, dp::Batcher & batcher);
 
-  void GenerateLine(ref_ptr<dp::GraphicsContext> context, std::vector<m2::PointD> const & path,
-                    m2::PointD const & pivot, dp::Color const & colorConst, float lineOffset,
-                    float halfWidth, float depth, dp::Batcher & batcher);
+  void GenerateLine(ref_ptr<dp::GraphicsContext> context,
+                    std::vector<SchemeSegment> const & segments, dp::Color const & colorConst,
+                    float lineOffset, float halfWidth, float depth, dp::Batcher & batcher);
 
   using TransitSchemes = std::map<MwmSet::MwmId, MwmSchemeData>;
   TransitSchemes m_schemes;
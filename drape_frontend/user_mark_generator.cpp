@@ -8,12 +8,62 @@
 
 #include "indexer/scales.hpp"
 
+#include "base/math.hpp"
+
 #include <algorithm>
+#include <unordered_set>
 
 namespace df
 {
 std::vector<int> const kLineIndexingLevels = {1, 7, 11};
 
+namespace
+{
+// Marks are clustered on zoom levels less than this one.
+int constexpr kMaxClusteringZoomLevel = 10;
+// Tiles with less marks of a group aren't clustered.
+size_t constexpr kMinClusteredMarksCount = 64;
+// The tile is divided into kClusterCellsCount x kClusterCellsCount cells.
+uint32_t constexpr kClusterCellsCount = 8;
+}  // namespace
+
+bool ClusterUserMarks(TileKey const & tileKey, kml::MarkIdCollection const & marksId,
+                      UserMarksRenderCollection const & renderParams,
+                      kml::MarkIdCollection & clusteredIds)
+{
+  clusteredIds.clear();
+  if (tileKey.m_zoomLevel >= kMaxClusteringZoomLevel || marksId.size() < kMinClusteredMarksCount)
+    return false;
+
+  m2::RectD const tileRect = tileKey.GetGlobalRect();
+  double const cellSizeX = tileRect.SizeX() / kClusterCellsCount;
+  double const cellSizeY = tileRect.SizeY() / kClusterCellsCount;
+  auto const getCell = [](double coord, double minCoord, double cellSize)
+  {
+    auto const cell = static_cast<int>((coord - minCoord) / cellSize);
+    return static_cast<uint32_t>(base::clamp(cell, 0, static_cast<int>(kClusterCellsCount) - 1));
+  };
+
+  std::vector<bool> occupiedCells(kClusterCellsCount * kClusterCellsCount, false);
+  for (auto const id : marksId)
+  {
+    auto const it = renderParams.find(id);
+    if (it == renderParams.end() || !it->second->m_isVisible)
+      continue;
+
+    auto const & pivot = it->second->m_pivot;
+    auto const cellX = getCell(pivot.x, tileRect.minX(), cellSizeX);
+    auto const cellY = getCell(pivot.y, tileRect.minY(), cellSizeY);
+    auto const cellIndex = cellY * kClusterCellsCount + cellX;
+    if (occupiedCells[cellIndex] && !it->second->m_justCreated)
+      continue;
+
+    occupiedCells[cellIndex] = true;
+    clusteredIds.push_back(id);
+  }
+  return true;
+}
+
 UserMarkGenerator::UserMarkGenerator(TFlushFn const & flushFn)
   : m_flushFn(flushFn)
 {
@@ -77,36 +127,116 @@ void UserMarkGenerator::SetUserLines(drape_ptr<UserLinesRenderCollection> && lin
 
 void UserMarkGenerator::UpdateIndex(kml::MarkGroupId groupId)
 {
-  for (auto & tileGroups : m_index)
+  auto & groupIndex = m_groupIndexes[groupId];
+
+  std::set<TileKey> changedTiles;
+  UpdateMarksIndex(groupId, groupIndex, changedTiles);
+  UpdateLinesIndex(groupId, groupIndex, changedTiles);
+
+  if (groupIndex.m_marks.empty() && groupIndex.m_lineTiles.empty())
+    m_groupIndexes.erase(groupId);
+
+  CleanIndex(changedTiles);
+}
+
+void UserMarkGenerator::UpdateMarksIndex(kml::MarkGroupId groupId, GroupIndex & groupIndex,
+                                         std::set<TileKey> & changedTiles)
+{
+  std::unordered_set<kml::MarkId> markIds;
+  auto const groupIt = m_groups.find(groupId);
+  if (groupIt != m_groups.end())
+    markIds.insert(groupIt->second->m_markIds.begin(), groupIt->second->m_markIds.end());
+
+  // Removed marks and marks which are moved or changed the min zoom are removed from the index.
+  std::map<TileKey, std::unordered_set<kml::MarkId>> removedMarks;
+  for (auto it = groupIndex.m_marks.begin(); it != groupIndex.m_marks.end();)
   {
-    auto itGroupIndexes = tileGroups.second->find(groupId);
-    if (itGroupIndexes != tileGroups.second->end())
+    bool isRemoved = markIds.find(it->first) == markIds.end();
+    if (!isRemoved)
     {
-      itGroupIndexes->second->m_markIds.clear();
-      itGroupIndexes->second->m_lineIds.clear();
+      auto const paramsIt = m_marks.find(it->first);
+      if (paramsIt != m_marks.end())
+      {
+        auto const & params = *paramsIt->second;
+        isRemoved = params.m_pivot != it->second.m_pivot || params.m_minZoom != it->second.m_minZoom;
+      }
+    }
+
+    if (isRemoved)
+    {
+      ForEachMarkTile(it->second, [&removedMarks, &it](TileKey const & tileKey)
+      {
+        removedMarks[tileKey].insert(it->first);
+      });
+      it = groupIndex.m_marks.erase(it);
+    }
+    else
+    {
+      ++it;
     }
   }
 
-  auto const groupIt = m_groups.find(groupId);
+  for (auto const & tileMarks : removedMarks)
+  {
+    auto groupIDs = FindIdCollection(tileMarks.first, groupId);
+    if (groupIDs == nullptr)
+      continue;
+    auto & ids = groupIDs->m_markIds;
+    auto const & removedIds = tileMarks.second;
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [&removedIds](kml::MarkId id)
+    {
+      return removedIds.find(id) != removedIds.end();
+    }), ids.end());
+    changedTiles.insert(tileMarks.first);
+  }
+
   if (groupIt == m_groups.end())
     return;
 
-  IDCollections & idCollection = *groupIt->second;
-
-  for (auto markId : idCollection.m_markIds)
+  // Marks are added in the order of the group to keep the order of rendering.
+  for (auto markId : groupIt->second->m_markIds)
   {
-    UserMarkRenderParams const & params = *m_marks[markId];
-    for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+    if (groupIndex.m_marks.find(markId) != groupIndex.m_marks.end())
+      continue;
+
+    auto const paramsIt = m_marks.find(markId);
+    if (paramsIt == m_marks.end())
+      continue;
+
+    IndexedMark mark;
+    mark.m_pivot = paramsIt->second->m_pivot;
+    mark.m_minZoom = paramsIt->second->m_minZoom;
+    ForEachMarkTile(mark, [this, groupId, markId, &changedTiles](TileKey const & tileKey)
     {
-      TileKey const tileKey = GetTileKeyByPoint(params.m_pivot, zoomLevel);
-      auto groupIDs = GetIdCollection(tileKey, groupId);
-      groupIDs->m_markIds.push_back(markId);
-    }
+      GetIdCollection(tileKey, groupId)->m_markIds.push_back(markId);
+      changedTiles.insert(tileKey);
+    });
+    groupIndex.m_marks.emplace(markId, mark);
   }
+}
+
+void UserMarkGenerator::UpdateLinesIndex(kml::MarkGroupId groupId, GroupIndex & groupIndex,
+                                         std::set<TileKey> & changedTiles)
+{
+  for (auto const & tileKey : groupIndex.m_lineTiles)
+  {
+    auto groupIDs = FindIdCollection(tileKey, groupId);
+    if (groupIDs != nullptr)
+      groupIDs->m_lineIds.clear();
+    changedTiles.insert(tileKey);
+  }
+  groupIndex.m_lineTiles.clear();
+
+  auto const groupIt = m_groups.find(groupId);
+  if (groupIt == m_groups.end())
+    return;
 
-  for (auto lineId : idCollection.m_lineIds)
+  for (auto lineId : groupIt->second->m_lineIds)
   {
-    UserLineRenderParams const & params = *m_lines[lineId];
+    auto const paramsIt = m_lines.find(lineId);
+    if (paramsIt == m_lines.end())
+      continue;
+    UserLineRenderParams const & params = *paramsIt->second;
 
     int const startZoom = GetNearestLineIndexZoom(params.m_minZoom);
     for (int zoomLevel : kLineIndexingLevels)
@@ -125,13 +255,20 @@ void UserMarkGenerator::UpdateIndex(kml::MarkGroupId groupId)
           TileKey const tileKey(tileX, tileY, zoomLevel);
           auto groupIDs = GetIdCollection(tileKey, groupId);
           groupIDs->m_lineIds.push_back(lineId);
+          groupIndex.m_lineTiles.insert(tileKey);
+          changedTiles.insert(tileKey);
         });
         return true;
       });
     }
   }
+}
 
-  CleanIndex();
+template <typename ToDo>
+void UserMarkGenerator::ForEachMarkTile(IndexedMark const & mark, ToDo && toDo) const
+{
+  for (int zoomLevel = mark.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+    toDo(GetTileKeyByPoint(mark.m_pivot, zoomLevel));
 }
 
 ref_ptr<IDCollections> UserMarkGenerator::GetIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId)
@@ -165,25 +302,39 @@ ref_ptr<IDCollections> UserMarkGenerator::GetIdCollection(TileKey const & tileKe
   return groupIDs;
 }
 
-void UserMarkGenerator::CleanIndex()
+ref_ptr<IDCollections> UserMarkGenerator::FindIdCollection(TileKey const & tileKey,
+                                                           kml::MarkGroupId groupId)
 {
-  for (auto tileIt = m_index.begin(); tileIt != m_index.end();)
-  {
-    if (tileIt->second->empty())
-      tileIt = m_index.erase(tileIt);
-    else
-      ++tileIt;
-  }
+  auto const itTileGroups = m_index.find(tileKey);
+  if (itTileGroups == m_index.end())
+    return nullptr;
+
+  auto const itGroupIDs = itTileGroups->second->find(groupId);
+  if (itGroupIDs == itTileGroups->second->end())
+    return nullptr;
 
-  for (auto & tileGroups : m_index)
+  return make_ref(itGroupIDs->second);
+}
+
+void UserMarkGenerator::CleanIndex(std::set<TileKey> const & tiles)
+{
+  for (auto const & tileKey : tiles)
   {
-    for (auto groupIt = tileGroups.second->begin(); groupIt != tileGroups.second->end();)
+    auto const tileIt = m_index.find(tileKey);
+    if (tileIt == m_index.end())
+      continue;
+
+    auto & tileGroups = *tileIt->second;
+    for (auto groupIt = tileGroups.begin(); groupIt != tileGroups.end();)
     {
       if (groupIt->second->IsEmpty())
-        groupIt = tileGroups.second->erase(groupIt);
+        groupIt = tileGroups.erase(groupIt);
       else
         ++groupIt;
     }
+
+    if (tileGroups.empty())
+      m_index.erase(tileIt);
   }
 }
 
@@ -270,7 +421,12 @@ void UserMarkGenerator::CacheUserMarks(ref_ptr<dp::GraphicsContext> context,
     kml::MarkGroupId groupId = groupPair.first;
     if (m_groupsVisibility.find(groupId) == m_groupsVisibility.end())
       continue;
-    df::CacheUserMarks(context, tileKey, textures, groupPair.second->m_markIds, m_marks, batcher);
+
+    kml::MarkIdCollection clusteredIds;
+    if (ClusterUserMarks(tileKey, groupPair.second->m_markIds, m_marks, clusteredIds))
+      df::CacheUserMarks(context, tileKey, textures, clusteredIds, m_marks, batcher);
+    else
+      df::CacheUserMarks(context, tileKey, textures, groupPair.second->m_markIds, m_marks, batcher);
   }
 }
 
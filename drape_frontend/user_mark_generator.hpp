@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace df
@@ -16,6 +17,13 @@ namespace df
 using MarksIDGroups = std::map<kml::MarkGroupId, drape_ptr<IDCollections>>;
 using MarksIndex = std::map<TileKey, drape_ptr<MarksIDGroups>>;
 
+// Thins out dense user marks on low zoom levels: the tile is divided into cells and only
+// the first visible mark of each cell is kept. Just created marks are always kept to be animated.
+// Returns false and leaves |clusteredIds| empty if the tile doesn't need clustering.
+bool ClusterUserMarks(TileKey const & tileKey, kml::MarkIdCollection const & marksId,
+                      UserMarksRenderCollection const & renderParams,
+                      kml::MarkIdCollection & clusteredIds);
+
 class UserMarkGenerator
 {
 public:
@@ -36,10 +44,32 @@ public:
                                  ref_ptr<dp::TextureManager> textures);
 
 private:
+  struct IndexedMark
+  {
+    m2::PointD m_pivot;
+    int m_minZoom = 1;
+  };
+
+  // Marks and tiles of lines which are in the index for the group.
+  struct GroupIndex
+  {
+    std::unordered_map<kml::MarkId, IndexedMark> m_marks;
+    std::set<TileKey> m_lineTiles;
+  };
+
+  // Only added, removed and moved marks are reindexed, lines of the group are reindexed entirely.
   void UpdateIndex(kml::MarkGroupId groupId);
+  void UpdateMarksIndex(kml::MarkGroupId groupId, GroupIndex & groupIndex,
+                        std::set<TileKey> & changedTiles);
+  void UpdateLinesIndex(kml::MarkGroupId groupId, GroupIndex & groupIndex,
+                        std::set<TileKey> & changedTiles);
+
+  template <typename ToDo>
+  void ForEachMarkTile(IndexedMark const & mark, ToDo && toDo) const;
 
   ref_ptr<IDCollections> GetIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId);
-  void CleanIndex();
+  ref_ptr<IDCollections> FindIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId);
+  void CleanIndex(std::set<TileKey> const & tiles);
 
   int GetNearestLineIndexZoom(int zoom) const;
 
@@ -60,6 +90,7 @@ private:
   UserLinesRenderCollection m_lines;
 
   MarksIndex m_index;
+  std::map<kml::MarkGroupId, GroupIndex> m_groupIndexes;
 
   TFlushFn m_flushFn;
 };
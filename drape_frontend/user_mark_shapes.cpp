@@ -22,6 +22,7 @@
 #include "geometry/clipping.hpp"
 #include "geometry/mercator.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -289,15 +290,26 @@ void GenerateTextShapes(ref_ptr<dp::GraphicsContext> context,
   }
 }
 
-m2::SharedSpline SimplifySpline(UserLineRenderParams const & renderInfo, double sqrScale)
+m2::SharedSpline const & GetSpline(UserLineRenderParams const & renderInfo, int zoomLevel)
+{
+  auto const it = std::lower_bound(renderInfo.m_simplifiedSplines.cbegin(),
+                                   renderInfo.m_simplifiedSplines.cend(), zoomLevel,
+                                   [](std::pair<int, m2::SharedSpline> const & level, int zoom)
+  {
+    return level.first < zoom;
+  });
+  return it != renderInfo.m_simplifiedSplines.cend() ? it->second : renderInfo.m_spline;
+}
+
+m2::SharedSpline SimplifySpline(m2::SharedSpline const & sourceSpline, double sqrScale)
 {
   auto const vs = static_cast<float>(df::VisualParams::Instance().GetVisualScale());
   m2::SharedSpline spline;
-  spline.Reset(new m2::Spline(renderInfo.m_spline->GetSize()));
+  spline.Reset(new m2::Spline(sourceSpline->GetSize()));
 
   static double const kMinSegmentLength = std::pow(4.0 * vs, 2);
   m2::PointD lastAddedPoint;
-  for (auto const & point : renderInfo.m_spline->GetPath())
+  for (auto const & point : sourceSpline->GetPath())
   {
     if (spline->GetSize() > 1 && point.SquaredLength(lastAddedPoint) * sqrScale < kMinSegmentLength)
     {
@@ -521,6 +533,7 @@ void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
       continue;
 
     UserLineRenderParams const & renderInfo = *it->second;
+    m2::SharedSpline spline = GetSpline(renderInfo, tileKey.m_zoomLevel);
 
     m2::RectD const tileRect = tileKey.GetGlobalRect();
 
@@ -528,7 +541,7 @@ void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
     double const maxLength = range / (1 << (tileKey.m_zoomLevel - 1));
 
     bool intersected = false;
-    ProcessSplineSegmentRects(renderInfo.m_spline, maxLength,
+    ProcessSplineSegmentRects(spline, maxLength,
                               [&tileRect, &intersected](m2::RectD const & segmentRect)
     {
       if (segmentRect.IsIntersect(tileRect))
@@ -539,9 +552,8 @@ void CacheUserLines(ref_ptr<dp::GraphicsContext> context, TileKey const & tileKe
     if (!intersected)
       continue;
 
-    m2::SharedSpline spline = renderInfo.m_spline;
     if (simplify)
-      spline = SimplifySpline(renderInfo, sqrScale);
+      spline = SimplifySpline(spline, sqrScale);
 
     auto const clippedSplines = m2::ClipSplineByRect(tileRect, spline);
     for (auto const & clippedSpline : clippedSplines)
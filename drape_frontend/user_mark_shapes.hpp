@@ -10,6 +10,8 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace df
 {
@@ -60,6 +62,8 @@ struct UserLineRenderParams
   DepthLayer m_depthLayer = DepthLayer::UserLineLayer;
   std::vector<LineLayer> m_layers;
   m2::SharedSpline m_spline;
+  // Splines of UserLineMark::GetSimplifiedPoints().
+  std::vector<std::pair<int /* zoomLevel */, m2::SharedSpline>> m_simplifiedSplines;
 };
 
 using UserMarksRenderCollection = std::unordered_map<kml::MarkId, drape_ptr<UserMarkRenderParams>>;
@@ -13,6 +13,7 @@
 
 #include "geometry/polyline2d.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace df
@@ -103,6 +104,12 @@ public:
   virtual float GetDepth(size_t layerIndex) const = 0;
   virtual std::vector<m2::PointD> const & GetPoints() const = 0;
 
+  // Points simplified for zoom levels in ascending order of zoom. A level is drawn at the zooms
+  // which are greater than the zoom of the previous level and not greater than its own zoom.
+  // GetPoints() are drawn at the zooms greater than the zoom of the last level.
+  using SimplifiedPoints = std::vector<std::pair<int /* zoomLevel */, std::vector<m2::PointD>>>;
+  virtual SimplifiedPoints const & GetSimplifiedPoints() const = 0;
+
 private:
   kml::TrackId m_id;
 };
@@ -860,6 +860,9 @@ void EditorTest::ForEachFeatureInMwmRectAndScaleTest()
   TEST_EQUAL(CountFeaturesInRect(mwmId, {6.0, 6.0, 8.0, 8.0}), 1, ());
   TEST_EQUAL(CountFeaturesInRect(mwmId, {8.0, 8.0, 10.0, 10.0}), 1, ());
   TEST_EQUAL(CountFeaturesInRect(mwmId, {0.0, 0.0, 10.0, 10.0}), 2, ());
+  // Features on the border of a rect are inside it.
+  TEST_EQUAL(CountFeaturesInRect(mwmId, {7.0, 7.0, 9.0, 9.0}), 2, ());
+  TEST_EQUAL(CountFeaturesInRect(mwmId, {7.0, 7.0, 7.0, 7.0}), 1, ());
 
   // Finds all features except deleted.
   TEST_EQUAL(CountFeatureTypeInRectByDataSource(m_dataSource, {0.0, 0.0, 2.0, 2.0}), 1, ());
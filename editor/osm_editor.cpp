@@ -206,7 +206,7 @@ void Editor::LoadEdits()
   if (!m_storage->Load(doc))
     return;
 
-  m_features.Set(make_shared<FeaturesContainer>());
+  SetFeatures(make_shared<FeaturesContainer>());
   auto loadedFeatures = make_shared<FeaturesContainer>();
 
   for (auto const & mwm : doc.child(kXmlRootNode).children(kXmlMwmNode))
@@ -233,7 +233,7 @@ void Editor::LoadEdits()
   if (needRewriteEdits)
     SaveTransaction(loadedFeatures);
   else
-    m_features.Set(loadedFeatures);
+    SetFeatures(loadedFeatures);
 }
 
 bool Editor::Save(FeaturesContainer const & features) const
@@ -296,10 +296,17 @@ bool Editor::SaveTransaction(shared_ptr<FeaturesContainer> const & features)
   if (!Save(*features))
     return false;
 
-  m_features.Set(features);
+  SetFeatures(features);
   return true;
 }
 
+void Editor::SetFeatures(shared_ptr<FeaturesContainer const> const & features)
+{
+  // The overlay keeps the snapshot, so the readers of the overlay never see a partial update.
+  m_overlay.Set(make_shared<EditsOverlay>(features));
+  m_features.Set(features);
+}
+
 void Editor::ClearAllLocalEdits()
 {
   CHECK_THREAD_CHECKER(MainThreadChecker, (""));
@@ -338,20 +345,21 @@ void Editor::OnMapDeregistered(platform::LocalCountryFile const & localFile)
 
 FeatureStatus Editor::GetFeatureStatus(MwmSet::MwmId const & mwmId, uint32_t index) const
 {
-  auto const features = m_features.Get();
-  return GetFeatureStatusImpl(*features, mwmId, index);
+  auto const overlay = m_overlay.Get();
+  auto const * featureInfo = overlay->Find(mwmId, index);
+  return featureInfo == nullptr ? FeatureStatus::Untouched : featureInfo->m_status;
 }
 
 FeatureStatus Editor::GetFeatureStatus(FeatureID const & fid) const
 {
-  auto const features = m_features.Get();
-  return GetFeatureStatusImpl(*features, fid.m_mwmId, fid.m_index);
+  return GetFeatureStatus(fid.m_mwmId, fid.m_index);
 }
 
 bool Editor::IsFeatureUploaded(MwmSet::MwmId const & mwmId, uint32_t index) const
 {
-  auto const features = m_features.Get();
-  return IsFeatureUploadedImpl(*features, mwmId, index);
+  auto const overlay = m_overlay.Get();
+  auto const * featureInfo = overlay->Find(mwmId, index);
+  return featureInfo != nullptr && featureInfo->m_uploadStatus == kUploaded;
 }
 
 void Editor::DeleteFeature(FeatureID const & fid)
@@ -515,32 +523,15 @@ bool Editor::RollBackChanges(FeatureID const & fid)
 void Editor::ForEachCreatedFeature(MwmSet::MwmId const & id, FeatureIndexFunctor const & f,
                                    m2::RectD const & rect, int /*scale*/) const
 {
-  auto const features = m_features.Get();
-
-  auto const mwmFound = features->find(id);
-  if (mwmFound == features->cend())
-    return;
-
-  // Process only new (created) features.
-  for (auto const & index : mwmFound->second)
-  {
-    FeatureTypeInfo const & ftInfo = index.second;
-    if (ftInfo.m_status == FeatureStatus::Created)
-    {
-      // Temporary solution because of FeatureType does not have constant getters.
-      // TODO(a): Use constant reference instead of copy.
-      auto feature = ftInfo.m_feature;
-      if (rect.IsPointInside(feature.GetCenter()))
-        f(index.first);
-    }
-  }
+  auto const overlay = m_overlay.Get();
+  overlay->ForEachCreatedFeature(id, rect, f);
 }
 
 bool Editor::GetEditedFeature(MwmSet::MwmId const & mwmId, uint32_t index,
                               FeatureType & outFeature) const
 {
-  auto const features = m_features.Get();
-  auto const * featureInfo = GetFeatureTypeInfo(*features, mwmId, index);
+  auto const overlay = m_overlay.Get();
+  auto const * featureInfo = overlay->Find(mwmId, index);
   if (featureInfo == nullptr)
     return false;
 
@@ -555,8 +546,8 @@ bool Editor::GetEditedFeature(FeatureID const & fid, FeatureType & outFeature) c
 
 bool Editor::GetEditedFeatureStreet(FeatureID const & fid, string & outFeatureStreet) const
 {
-  auto const features = m_features.Get();
-  auto const * featureInfo = GetFeatureTypeInfo(*features, fid.m_mwmId, fid.m_index);
+  auto const overlay = m_overlay.Get();
+  auto const * featureInfo = overlay->Find(fid.m_mwmId, fid.m_index);
   if (featureInfo == nullptr)
     return false;
 
@@ -1310,6 +1301,85 @@ bool Editor::IsFeatureUploadedImpl(FeaturesContainer const & features, MwmSet::M
   return info && info->m_uploadStatus == kUploaded;
 }
 
+Editor::EditsOverlay::EditsOverlay(shared_ptr<FeaturesContainer const> const & features)
+  : m_features(features)
+{
+  for (auto const & mwm : *m_features)
+  {
+    auto & edits = m_mwms[mwm.first];
+    edits.m_features = &mwm.second;
+    for (auto const & index : mwm.second)
+    {
+      if (index.second.m_status == FeatureStatus::Created)
+      {
+        // Temporary solution because of FeatureType does not have constant getters.
+        // TODO(a): Use constant reference instead of copy.
+        auto feature = index.second.m_feature;
+        auto const center = feature.GetCenter();
+        edits.m_created.Add(make_pair(index.first, center), m2::RectD(center, center));
+      }
+
+      // Indexes of the created features are not in the bitmap.
+      if (feature::FakeFeatureIds::IsEditorCreatedFeature(index.first))
+        continue;
+
+      size_t const word = index.first / 64;
+      if (word >= edits.m_edited.size())
+        edits.m_edited.resize(word + 1);
+      edits.m_edited[word] |= uint64_t{1} << (index.first % 64);
+    }
+    edits.m_created.Build();
+  }
+}
+
+Editor::FeatureTypeInfo const * Editor::EditsOverlay::Find(MwmSet::MwmId const & mwmId,
+                                                           uint32_t index) const
+{
+  // Most popular case optimization.
+  if (m_mwms.empty())
+    return nullptr;
+
+  auto const mwm = m_mwms.find(mwmId);
+  if (mwm == m_mwms.cend())
+    return nullptr;
+
+  auto const & edits = mwm->second;
+  if (!feature::FakeFeatureIds::IsEditorCreatedFeature(index))
+  {
+    size_t const word = index / 64;
+    if (word >= edits.m_edited.size() || ((edits.m_edited[word] >> (index % 64)) & 1) == 0)
+      return nullptr;
+  }
+
+  auto const it = edits.m_features->find(index);
+  return it == edits.m_features->cend() ? nullptr : &it->second;
+}
+
+void Editor::EditsOverlay::ForEachCreatedFeature(MwmSet::MwmId const & mwmId,
+                                                 m2::RectD const & rect,
+                                                 FeatureIndexFunctor const & fn) const
+{
+  auto const mwm = m_mwms.find(mwmId);
+  if (mwm == m_mwms.cend() || mwm->second.m_created.IsEmpty())
+    return;
+
+  // The tree doesn't report the points on the border of the rect, so the rect is inflated
+  // and the points are checked exactly.
+  double constexpr kEps = 1e-7;
+  m2::RectD inflated = rect;
+  inflated.Inflate(kEps, kEps);
+
+  vector<uint32_t> indexes;
+  mwm->second.m_created.ForEachInRect(inflated, [&](pair<uint32_t, m2::PointD> const & feature) {
+    if (rect.IsPointInside(feature.second))
+      indexes.push_back(feature.first);
+  });
+
+  sort(indexes.begin(), indexes.end());
+  for (auto const index : indexes)
+    fn(index);
+}
+
 const char * const Editor::kPlaceDoesNotExistMessage =
     "The place has gone or never existed. This is an auto-generated note from MAPS.ME application: "
     "a user reports a POI that is visible on a map (which can be outdated), but cannot be found on "
@@ -13,6 +13,7 @@
 #include "indexer/feature_source.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "geometry/packed_tree4d.hpp"
 #include "geometry/rect2d.hpp"
 
 #include "base/atomic_shared_ptr.hpp"
@@ -209,6 +210,40 @@ private:
 
   using FeaturesContainer = map<MwmSet::MwmId, map<uint32_t, FeatureTypeInfo>>;
 
+  // Lookups for the reads of features through a DataSource, built for every snapshot of
+  // the features. Features of an mwm which are in the editor are marked in a bitmap, so
+  // untouched features aren't searched in the maps, and created features are indexed by centers.
+  class EditsOverlay
+  {
+  public:
+    EditsOverlay() = default;
+    explicit EditsOverlay(shared_ptr<FeaturesContainer const> const & features);
+
+    /// @returns pointer to the info of the feature if it's in the editor, nullptr otherwise.
+    FeatureTypeInfo const * Find(MwmSet::MwmId const & mwmId, uint32_t index) const;
+
+    /// Calls |fn| for the indexes of the created features which are in |rect|, in ascending order.
+    void ForEachCreatedFeature(MwmSet::MwmId const & mwmId, m2::RectD const & rect,
+                               FeatureIndexFunctor const & fn) const;
+
+  private:
+    struct MwmEdits
+    {
+      map<uint32_t, FeatureTypeInfo> const * m_features = nullptr;
+      // Bit |i| is set if the mwm feature |i| is in |m_features|.
+      vector<uint64_t> m_edited;
+      // Indexes and centers of the created features.
+      m4::PackedTree<pair<uint32_t, m2::PointD>> m_created;
+    };
+
+    // The snapshot which |m_mwms| point to.
+    shared_ptr<FeaturesContainer const> m_features;
+    map<MwmSet::MwmId, MwmEdits> m_mwms;
+  };
+
+  /// Sets the snapshot of the features and its overlay.
+  void SetFeatures(shared_ptr<FeaturesContainer const> const & features);
+
   /// @returns false if fails.
   bool Save(FeaturesContainer const & features) const;
   bool SaveTransaction(shared_ptr<FeaturesContainer> const & features);
@@ -255,6 +290,8 @@ private:
 
   /// Deleted, edited and created features.
   base::AtomicSharedPtr<FeaturesContainer> m_features;
+  /// Overlay of |m_features| for the reads of features.
+  base::AtomicSharedPtr<EditsOverlay> m_overlay;
 
   unique_ptr<Delegate> m_delegate;
 
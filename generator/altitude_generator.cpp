@@ -17,17 +17,20 @@
 #include "coding/varint.hpp"
 
 #include "geometry/latlon.hpp"
+#include "geometry/mercator.hpp"
 
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
-#include "base/scope_guard.hpp"
+#include "base/parallel.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include "defines.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -57,6 +60,9 @@ private:
   generator::SrtmTileManager m_srtmManager;
 };
 
+// Altitudes of road features are calculated in parallel. Roads are sorted by the SRTM tile
+// of their first point and the chunks are contiguous ranges of the sorted roads, so every
+// worker touches just a few tiles and the tiles are loaded once.
 class Processor
 {
 public:
@@ -90,15 +96,12 @@ public:
 
   void operator()(FeatureType & f, uint32_t const & id)
   {
-    if (id != m_altitudeAvailabilityBuilder.size())
+    if (id != m_featuresCount)
     {
       LOG(LERROR, ("There's a gap in feature id order."));
       return;
     }
-
-    bool hasAltitude = false;
-    SCOPE_GUARD(altitudeAvailabilityBuilding,
-                [&]() { m_altitudeAvailabilityBuilder.push_back(hasAltitude); });
+    ++m_featuresCount;
 
     if (!routing::IsRoad(feature::TypesHolder(f)))
       return;
@@ -108,27 +111,99 @@ public:
     if (pointsCount == 0)
       return;
 
-    TAltitudes altitudes;
-    TAltitude minFeatureAltitude = kInvalidAltitude;
+    Road road;
+    road.m_featureId = id;
+    road.m_points.reserve(pointsCount);
     for (size_t i = 0; i < pointsCount; ++i)
+      road.m_points.push_back(f.GetPoint(i));
+    m_roads.push_back(std::move(road));
+  }
+
+  // Must be called after all features are processed.
+  void CalcAltitudes()
+  {
+    std::vector<size_t> order(m_roads.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      auto const & l = m_roads[lhs];
+      auto const & r = m_roads[rhs];
+      auto const lTile = GetTile(l.m_points.front());
+      auto const rTile = GetTile(r.m_points.front());
+      return lTile != rTile ? lTile < rTile : l.m_featureId < r.m_featureId;
+    });
+
+    base::ParallelFor(0, order.size(), [&](size_t i) { CalcRoadAltitudes(m_roads[order[i]]); },
+                      kMinRoadsPerChunk);
+
+    // Roads are in the order of feature ids.
+    auto road = m_roads.begin();
+    for (uint32_t id = 0; id < m_featuresCount; ++id)
     {
-      TAltitude const a = m_altitudeGetter.GetAltitude(f.GetPoint(i));
+      bool const hasAltitude = road != m_roads.end() && road->m_featureId == id &&
+                               !road->m_altitudes.empty();
+      m_altitudeAvailabilityBuilder.push_back(hasAltitude);
+      if (road != m_roads.end() && road->m_featureId == id)
+      {
+        if (hasAltitude)
+          AddFeatureAltitudes(*road);
+        ++road;
+      }
+    }
+    CHECK(road == m_roads.end(), ());
+    m_roads.clear();
+  }
+
+  bool HasAltitudeInfo() const { return !m_featureAltitudes.empty(); }
+
+  bool IsFeatureAltitudesSorted()
+  {
+    return std::is_sorted(m_featureAltitudes.begin(), m_featureAltitudes.end(),
+                          base::LessBy(&Processor::FeatureAltitude::m_featureId));
+  }
+
+private:
+  struct Road
+  {
+    uint32_t m_featureId = 0;
+    std::vector<m2::PointD> m_points;
+    // Empty when altitude of one of the points is unknown.
+    TAltitudes m_altitudes;
+  };
+
+  static size_t constexpr kMinRoadsPerChunk = 256;
+
+  // Returns the south-west corner of the one degree SRTM tile of |p|.
+  static std::pair<int, int> GetTile(m2::PointD const & p)
+  {
+    auto const ll = MercatorBounds::ToLatLon(p);
+    return {static_cast<int>(std::floor(ll.lat)), static_cast<int>(std::floor(ll.lon))};
+  }
+
+  void CalcRoadAltitudes(Road & road) const
+  {
+    TAltitudes altitudes;
+    altitudes.reserve(road.m_points.size());
+    for (auto const & p : road.m_points)
+    {
+      TAltitude const a = m_altitudeGetter.GetAltitude(p);
       if (a == kInvalidAltitude)
       {
         // One invalid point invalidates the whole feature.
         return;
       }
-
-      if (minFeatureAltitude == kInvalidAltitude)
-        minFeatureAltitude = a;
-      else
-        minFeatureAltitude = std::min(minFeatureAltitude, a);
-
       altitudes.push_back(a);
     }
 
-    hasAltitude = true;
-    m_featureAltitudes.emplace_back(id, Altitudes(std::move(altitudes)));
+    road.m_altitudes = std::move(altitudes);
+    road.m_points.clear();
+    road.m_points.shrink_to_fit();
+  }
+
+  void AddFeatureAltitudes(Road & road)
+  {
+    TAltitude const minFeatureAltitude =
+        *std::min_element(road.m_altitudes.cbegin(), road.m_altitudes.cend());
+    m_featureAltitudes.emplace_back(road.m_featureId, Altitudes(std::move(road.m_altitudes)));
 
     if (m_minAltitude == kInvalidAltitude)
       m_minAltitude = minFeatureAltitude;
@@ -136,16 +211,9 @@ public:
       m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
   }
 
-  bool HasAltitudeInfo() const { return !m_featureAltitudes.empty(); }
-
-  bool IsFeatureAltitudesSorted()
-  {
-    return std::is_sorted(m_featureAltitudes.begin(), m_featureAltitudes.end(),
-                          base::LessBy(&Processor::FeatureAltitude::m_featureId));
-  }
-
-private:
   AltitudeGetter & m_altitudeGetter;
+  uint32_t m_featuresCount = 0;
+  std::vector<Road> m_roads;
   TFeatureAltitudes m_featureAltitudes;
   succinct::bit_vector_builder m_altitudeAvailabilityBuilder;
   TAltitude m_minAltitude;
@@ -161,6 +229,7 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
     // Preparing altitude information.
     Processor processor(altitudeGetter);
     feature::ForEachFromDat(mwmPath, processor);
+    processor.CalcAltitudes();
 
     if (!processor.HasAltitudeInfo())
     {
@@ -11,6 +11,7 @@ namespace routing
 class AltitudeGetter
 {
 public:
+  // Is called from several threads at once.
   virtual feature::TAltitude GetAltitude(m2::PointD const & p) = 0;
 };
 
@@ -0,0 +1,150 @@
+#include "generator/borders_grid.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace borders
+{
+namespace
+{
+// Cells are widened by this share of their size when marked as crossed by borders, so a
+// border which goes along a side of a cell marks the cells on both sides.
+double const kEps = 1e-6;
+
+// Returns index of the cell in [0, count) which contains |coord|, |offset| widens the cell.
+size_t GetIndex(double coord, double origin, double cellSize, size_t count, double offset)
+{
+  auto const i = floor((coord - origin) / cellSize + offset);
+  return static_cast<size_t>(min(max(i, 0.0), static_cast<double>(count - 1)));
+}
+}  // namespace
+
+// static
+size_t constexpr RegionsGrid::kMaxCellsPerSide;
+
+RegionsGrid::RegionsGrid(Regions const & regions, size_t maxCellsPerSide)
+{
+  CHECK_GREATER(maxCellsPerSide, 0, ());
+
+  size_t pointsCount = 0;
+  regions.ForEach([&](m2::RegionD const & region) {
+    m_rect.Add(region.GetRect());
+    pointsCount += region.GetPointsCount();
+  });
+  if (pointsCount == 0 || m_rect.SizeX() <= 0 || m_rect.SizeY() <= 0)
+    return;
+
+  // A few points of borders per cell side, and square cells.
+  auto const side = min(static_cast<double>(maxCellsPerSide),
+                        max(16.0, 2.0 * sqrt(static_cast<double>(pointsCount))));
+  double const aspect = m_rect.SizeX() / m_rect.SizeY();
+  m_width = static_cast<size_t>(min(static_cast<double>(maxCellsPerSide),
+                                    max(1.0, round(side * sqrt(aspect)))));
+  m_height = static_cast<size_t>(min(static_cast<double>(maxCellsPerSide),
+                                     max(1.0, round(side / sqrt(aspect)))));
+  m_cellWidth = m_rect.SizeX() / m_width;
+  m_cellHeight = m_rect.SizeY() / m_height;
+  m_cells.assign(m_width * m_height, Cell::Outside);
+
+  regions.ForEach([&](m2::RegionD const & region) {
+    auto const & points = region.Data();
+    for (size_t i = 0; i < points.size(); ++i)
+      MarkSegment(points[i], points[(i + 1) % points.size()]);
+  });
+
+  ClassifyCells(regions);
+}
+
+bool RegionsGrid::Contains(Regions const & regions, m2::PointD const & pt) const
+{
+  if (IsEmpty())
+    return ContainsExactly(regions, pt);
+
+  if (!m_rect.IsPointInside(pt))
+    return false;
+
+  auto const x = GetIndex(pt.x, m_rect.minX(), m_cellWidth, m_width, 0.0 /* offset */);
+  auto const y = GetIndex(pt.y, m_rect.minY(), m_cellHeight, m_height, 0.0 /* offset */);
+  switch (At(x, y))
+  {
+  case Cell::Outside: return false;
+  case Cell::Inside: return true;
+  case Cell::Boundary: return ContainsExactly(regions, pt);
+  }
+  CHECK_SWITCH();
+}
+
+double RegionsGrid::GetBoundaryShare() const
+{
+  if (IsEmpty())
+    return 0.0;
+  auto const boundary = count(m_cells.cbegin(), m_cells.cend(), Cell::Boundary);
+  return static_cast<double>(boundary) / m_cells.size();
+}
+
+void RegionsGrid::MarkSegment(m2::PointD const & a, m2::PointD const & b)
+{
+  double const minY = min(a.y, b.y);
+  double const maxY = max(a.y, b.y);
+  auto const fromY = GetIndex(minY, m_rect.minY(), m_cellHeight, m_height, -kEps);
+  auto const toY = GetIndex(maxY, m_rect.minY(), m_cellHeight, m_height, kEps);
+
+  for (size_t y = fromY; y <= toY; ++y)
+  {
+    // Part of the segment inside of the widened row.
+    double const rowMinY = max(minY, m_rect.minY() + (y - kEps) * m_cellHeight);
+    double const rowMaxY = min(maxY, m_rect.minY() + (y + 1 + kEps) * m_cellHeight);
+
+    double x1 = a.x;
+    double x2 = b.x;
+    if (a.y != b.y)
+    {
+      x1 = a.x + (b.x - a.x) * (rowMinY - a.y) / (b.y - a.y);
+      x2 = a.x + (b.x - a.x) * (rowMaxY - a.y) / (b.y - a.y);
+    }
+
+    auto const fromX =
+        GetIndex(min(x1, x2), m_rect.minX(), m_cellWidth, m_width, -kEps);
+    auto const toX = GetIndex(max(x1, x2), m_rect.minX(), m_cellWidth, m_width, kEps);
+    for (size_t x = fromX; x <= toX; ++x)
+      At(x, y) = Cell::Boundary;
+  }
+}
+
+void RegionsGrid::ClassifyCells(Regions const & regions)
+{
+  // Borders don't cross a run of adjacent non-boundary cells in a row, so all cells of the run
+  // are either inside or outside and one point of the run is enough.
+  for (size_t y = 0; y < m_height; ++y)
+  {
+    size_t x = 0;
+    while (x < m_width)
+    {
+      if (At(x, y) == Cell::Boundary)
+      {
+        ++x;
+        continue;
+      }
+
+      m2::PointD const center(m_rect.minX() + (x + 0.5) * m_cellWidth,
+                              m_rect.minY() + (y + 0.5) * m_cellHeight);
+      auto const cell = ContainsExactly(regions, center) ? Cell::Inside : Cell::Outside;
+      for (; x < m_width && At(x, y) != Cell::Boundary; ++x)
+        At(x, y) = cell;
+    }
+  }
+}
+
+bool ContainsExactly(RegionsGrid::Regions const & regions, m2::PointD const & pt)
+{
+  bool contains = false;
+  regions.ForEachInRect(m2::RectD(pt, pt), [&](m2::RegionD const & region) {
+    contains = contains || region.Contains(pt);
+  });
+  return contains;
+}
+}  // namespace borders
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace borders
+{
+// Grid over the limit rect of country regions. Every cell is marked as inside of the regions,
+// outside of them or crossed by their borders, so most points are classified by one lookup
+// and only the points of the boundary cells are checked against the polygons.
+class RegionsGrid
+{
+public:
+  using Regions = m4::Tree<m2::RegionD>;
+
+  static size_t constexpr kMaxCellsPerSide = 512;
+
+  RegionsGrid() = default;
+  explicit RegionsGrid(Regions const & regions, size_t maxCellsPerSide = kMaxCellsPerSide);
+
+  // Returns whether |pt| is inside of one of |regions|, which must be the regions
+  // the grid was built for. Without the grid all points are checked against the polygons.
+  bool Contains(Regions const & regions, m2::PointD const & pt) const;
+
+  bool IsEmpty() const { return m_cells.empty(); }
+  // Share of the cells crossed by borders.
+  double GetBoundaryShare() const;
+
+private:
+  enum class Cell : uint8_t
+  {
+    Outside,
+    Inside,
+    Boundary
+  };
+
+  // Marks the cells which have common points with the segment |a|, |b| as boundary ones.
+  void MarkSegment(m2::PointD const & a, m2::PointD const & b);
+  // Finds whether the cells which aren't crossed by borders are inside.
+  void ClassifyCells(Regions const & regions);
+
+  Cell & At(size_t x, size_t y) { return m_cells[y * m_width + x]; }
+  Cell At(size_t x, size_t y) const { return m_cells[y * m_width + x]; }
+
+  m2::RectD m_rect;
+  size_t m_width = 0;
+  size_t m_height = 0;
+  double m_cellWidth = 0.0;
+  double m_cellHeight = 0.0;
+  std::vector<Cell> m_cells;
+};
+
+// Returns whether |pt| is inside of one of |regions| checking the polygons.
+bool ContainsExactly(RegionsGrid::Regions const & regions, m2::PointD const & pt);
+}  // namespace borders
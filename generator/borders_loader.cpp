@@ -6,6 +6,7 @@
 
 #include "platform/platform.hpp"
 
+#include "storage/countries_raster_index.hpp"
 #include "storage/country_polygon.hpp"
 
 #include "indexer/scales.hpp"
@@ -13,6 +14,8 @@
 #include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
 
 #include "geometry/mercator.hpp"
 #include "geometry/parametrized_segment.hpp"
@@ -61,6 +64,7 @@ public:
     if (!m_polygons.IsEmpty())
     {
       ASSERT_NOT_EQUAL(m_rect, m2::RectD::GetEmptyRect(), ());
+      m_polygons.BuildGrid();
       m_countries.Add(m_polygons, m_rect);
     }
 
@@ -127,6 +131,7 @@ public:
 
     // write polygons as paths
     WriteVarUint(w, borders.size());
+    m_regions.emplace_back();
     for (m2::RegionD const & border : borders)
     {
       vector<m2::PointD> const & in = border.Data();
@@ -138,7 +143,17 @@ public:
       SimplifyNearOptimal(20, in.begin(), in.end(), eps, distFn,
                           AccumulateSkipSmallTrg<decltype(distFn), m2::PointD>(distFn, out, eps));
 
-      serial::SaveOuterPath(out, cp, w);
+      vector<uint8_t> buffer;
+      MemWriter<vector<uint8_t>> writer(buffer);
+      serial::SaveOuterPath(out, cp, writer);
+      w.Write(buffer.data(), buffer.size());
+
+      // The raster index is built by the stored polygons, the ones which are checked at runtime.
+      MemReader reader(buffer.data(), buffer.size());
+      ReaderSource<MemReader> src(reader);
+      vector<m2::PointD> stored;
+      serial::LoadOuterPath(src, cp, stored);
+      m_regions.back().emplace_back(move(stored));
     }
   }
 
@@ -150,10 +165,21 @@ public:
     rw::Write(w, m_polys);
   }
 
+  void WriteRasterIndex()
+  {
+    LOG(LINFO, ("Building countries raster index."));
+    auto const index = storage::CountriesRasterIndex::Build(m_regions);
+    LOG(LINFO, ("Countries raster index nodes:", index.GetNodesCount()));
+
+    FileWriter w = m_writer.GetWriter(PACKED_POLYGONS_RASTER_INDEX_TAG);
+    index.Serialize(w);
+  }
+
 private:
   FilesContainerW m_writer;
 
   vector<storage::CountryDef> m_polys;
+  vector<vector<m2::RegionD>> m_regions;
 };
 
 void GeneratePackedBorders(string const & baseDir)
@@ -161,6 +187,7 @@ void GeneratePackedBorders(string const & baseDir)
   PackedBordersGenerator generator(baseDir);
   ForEachCountry(baseDir, generator);
   generator.WritePolygonsInfo();
+  generator.WriteRasterIndex();
 }
 
 void UnpackBorders(string const & baseDir, string const & targetDir)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "generator/borders_grid.hpp"
+
+#include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 #include "geometry/region2d.hpp"
 #include "geometry/tree4d.hpp"
@@ -22,11 +25,17 @@ namespace borders
     void Clear()
     {
       m_regions.Clear();
+      m_grid = RegionsGrid();
       m_name.clear();
       m_index = -1;
     }
 
+    // Must be called after all regions are added.
+    void BuildGrid() { m_grid = RegionsGrid(m_regions); }
+    bool Contains(m2::PointD const & pt) const { return m_grid.Contains(m_regions, pt); }
+
     RegionsContainer m_regions;
+    RegionsGrid m_grid;
     std::string m_name;
     mutable int m_index;
   };
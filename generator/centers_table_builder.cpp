@@ -17,11 +17,13 @@
 
 namespace indexer
 {
-bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild)
+bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild,
+                                   bool fixedWidth)
 {
   try
   {
     search::CentersTableBuilder builder;
+    builder.SetFixedWidth(fixedWidth);
 
     {
       FilesContainerR rcont(filename);
@@ -8,6 +8,8 @@ class Writer;
 namespace indexer
 {
 // Builds the latest version of the centers table section and writes
-// it to the mwm file.
-bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild = false);
+// it to the mwm file. When |fixedWidth| is set, the table is built in
+// the fixed width format with O(1) access to centers.
+bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild = false,
+                                   bool fixedWidth = false);
 }  // namespace indexer
@@ -1,17 +1,26 @@
 #include "generator/coastlines_generator.hpp"
 
 #include "generator/feature_builder.hpp"
+#include "generator/feature_emitter_iface.hpp"
 
+#include "coding/point_to_integer.hpp"
 #include "coding/pointd_to_pointu.hpp"
 
 #include "geometry/region2d/binary_operators.hpp"
 
-#include "base/string_utils.hpp"
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
+#include "base/string_utils.hpp"
+#include "base/task_scheduler.hpp"
 
+#include <algorithm>
 #include <condition_variable>
 #include <functional>
-#include <thread>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 using namespace std;
@@ -21,7 +30,7 @@ using PointT = m2::PointI;
 using RectT = m2::RectI;
 
 CoastlineFeaturesGenerator::CoastlineFeaturesGenerator(uint32_t coastType)
-  : m_merger(POINT_COORD_BITS), m_coastType(coastType)
+  : m_coastType(coastType)
 {
 }
 
@@ -91,7 +100,7 @@ void CoastlineFeaturesGenerator::operator()(FeatureBuilder1 const & fb)
   if (fb.IsGeometryClosed())
     AddRegionToTree(fb);
   else
-    m_merger(fb);
+    m_ways.push_back(fb);
 }
 
 namespace
@@ -142,10 +151,135 @@ namespace
   };
 }
 
+namespace
+{
+// Merges coastline ways into chains. Ways are indexed by keys of both endpoints, so every
+// step of a chain is one hash map lookup, and taken ways are only marked as used.
+class WaysMerger
+{
+public:
+  explicit WaysMerger(vector<FeatureBuilder1> const & ways)
+    : m_ways(ways), m_priorities(ways.size(), 0.0), m_used(ways.size(), false)
+  {
+    m_index.reserve(2 * ways.size());
+    for (uint32_t i = 0; i < ways.size(); ++i)
+    {
+      auto const & points = ways[i].GetOuterGeometry();
+      for (size_t j = 1; j < points.size(); ++j)
+        m_priorities[i] += points[j - 1].SquaredLength(points[j]);
+
+      m_index[GetKey(points.front())].push_back(i);
+      m_index[GetKey(points.back())].push_back(i);
+    }
+  }
+
+  // Calls |toDo(fb)| for every chain, chains are closed when their ends meet.
+  template <typename ToDo>
+  void ForEachChain(ToDo && toDo)
+  {
+    for (uint32_t i = 0; i < m_ways.size(); ++i)
+    {
+      if (m_used[i])
+        continue;
+      m_used[i] = true;
+
+      // |front| is the part of the chain before the way |i| in the reverse order.
+      Chain back;
+      back.m_points = m_ways[i].GetOuterGeometry();
+      Chain front;
+      front.m_points.push_back(back.m_points.front());
+
+      Extend(back, front.m_points.front());
+      if (GetKey(back.m_points.back()) != GetKey(front.m_points.front()))
+        Extend(front, back.m_points.back());
+
+      vector<m2::PointD> points(front.m_points.rbegin(), front.m_points.rend());
+      points.insert(points.end(), back.m_points.begin() + 1, back.m_points.end());
+      // Ends with equal keys may differ a little, make the chain closed exactly.
+      if (points.size() > 3 && GetKey(points.front()) == GetKey(points.back()))
+        points.back() = points.front();
+
+      // The chain keeps params and ids of the way |i| like FeatureMergeProcessor does.
+      FeatureBuilder1 fb = m_ways[i];
+      fb.ResetGeometry();
+      for (auto const & p : points)
+        fb.AddPoint(p);
+      for (auto const & id : back.m_ids)
+        fb.AddOsmId(id);
+      for (auto const & id : front.m_ids)
+        fb.AddOsmId(id);
+
+      toDo(fb);
+    }
+  }
+
+private:
+  static uint32_t constexpr kNoWay = numeric_limits<uint32_t>::max();
+
+  struct Chain
+  {
+    vector<m2::PointD> m_points;
+    vector<base::GeoObjectId> m_ids;
+  };
+
+  static int64_t GetKey(m2::PointD const & p) { return PointToInt64Obsolete(p, POINT_COORD_BITS); }
+
+  // Returns the longest not used way with an endpoint at |key|, like FeatureMergeProcessor does.
+  uint32_t Take(int64_t key)
+  {
+    auto const it = m_index.find(key);
+    if (it == m_index.end())
+      return kNoWay;
+
+    uint32_t best = kNoWay;
+    for (auto const i : it->second)
+    {
+      if (!m_used[i] && (best == kNoWay || m_priorities[i] > m_priorities[best]))
+        best = i;
+    }
+    if (best != kNoWay)
+      m_used[best] = true;
+    return best;
+  }
+
+  // Appends ways to the end of |chain| while it doesn't reach |stop|.
+  void Extend(Chain & chain, m2::PointD const & stop)
+  {
+    int64_t const stopKey = GetKey(stop);
+    while (true)
+    {
+      int64_t const key = GetKey(chain.m_points.back());
+      if (key == stopKey && chain.m_points.size() > 1)
+        return;
+
+      uint32_t const i = Take(key);
+      if (i == kNoWay)
+        return;
+
+      auto const & points = m_ways[i].GetOuterGeometry();
+      if (GetKey(points.front()) == key)
+        chain.m_points.insert(chain.m_points.end(), points.begin() + 1, points.end());
+      else
+        chain.m_points.insert(chain.m_points.end(), points.rbegin() + 1, points.rend());
+
+      auto const & ids = m_ways[i].GetOsmIds();
+      chain.m_ids.insert(chain.m_ids.end(), ids.begin(), ids.end());
+    }
+  }
+
+  vector<FeatureBuilder1> const & m_ways;
+  vector<double> m_priorities;
+  vector<bool> m_used;
+  unordered_map<int64_t, vector<uint32_t>> m_index;
+};
+}  // namespace
+
 bool CoastlineFeaturesGenerator::Finish()
 {
   DoAddToTree doAdd(*this);
-  m_merger.DoMerge(doAdd);
+  WaysMerger(m_ways).ForEachChain(doAdd);
+  m_ways.clear();
+  m_ways.shrink_to_fit();
 
   if (doAdd.HasNotMergedCoasts())
   {
@@ -188,6 +322,12 @@ public:
         m2::PointU(static_cast<uint32_t>(p.x), static_cast<uint32_t>(p.y)), POINT_COORD_BITS));
   }
 
+  // Returns the coasts clipped by the source rect, they are enough to process its subrects.
+  vector<RegionT> ExtractParts()
+  {
+    return vector<RegionT>(make_move_iterator(m_res.begin() + 1), make_move_iterator(m_res.end()));
+  }
+
   size_t GetPointsCount() const
   {
     size_t count = 0;
@@ -221,10 +361,19 @@ public:
   static int constexpr kMaxPoints = 20000;
 
 protected:
+  using TParts = shared_ptr<vector<RegionT> const>;
+
+  struct Task
+  {
+    TCell m_cell;
+    // Coasts clipped by the parent cell, nullptr for cells of the base scale.
+    TParts m_parts;
+  };
+
   struct Context
   {
     mutex mutexTasks;
-    list<TCell> listTasks;
+    list<Task> listTasks;
     condition_variable listCondVar;
     size_t inWork = 0;
     TProcessResultFunc processResultFunc;
@@ -238,33 +387,30 @@ protected:
   {}
 
 public:
-  static bool Process(size_t numThreads, size_t baseScale, TIndex const & index,
-                      TProcessResultFunc funcResult)
+  static bool Process(size_t baseScale, TIndex const & index, TProcessResultFunc funcResult,
+                      base::TaskScheduler & scheduler)
   {
     Context ctx;
 
     for (size_t i = 0; i < TCell::TotalCellsOnLevel(baseScale); ++i)
-      ctx.listTasks.push_back(TCell::FromBitsAndLevel(i, static_cast<int>(baseScale)));
+      ctx.listTasks.push_back({TCell::FromBitsAndLevel(i, static_cast<int>(baseScale)), nullptr});
 
     ctx.processResultFunc = funcResult;
 
-    vector<RegionInCellSplitter> instances;
-    vector<thread> threads;
-    for (size_t i = 0; i < numThreads; ++i)
-    {
-      instances.emplace_back(RegionInCellSplitter(ctx, index));
-      threads.emplace_back(instances.back());
-    }
-
-    for (auto & thread : threads)
-      thread.join();
+    // Every chunk is a worker loop over the shared queue, the calling thread runs one of them.
+    base::parallel::RunChunks(scheduler.GetWorkersCount() + 1, [&ctx, &index](size_t) {
+      RegionInCellSplitter(ctx, index)();
+    }, scheduler);
 
     // return true if listTask has no error cells
     return ctx.listTasks.empty();
   }
 
-  bool ProcessCell(TCell const & cell)
+  // Returns false and the coasts clipped by the cell in |parts| when the cell should be split.
+  bool ProcessCell(Task const & task, TParts & parts)
   {
+    TCell const & cell = task.m_cell;
+
     // get rect cell
     double minX, minY, maxX, maxY;
     CellIdConverter<MercatorBounds, TCell>::GetCellBounds(cell, minX, minY, maxX, maxY);
@@ -277,11 +423,28 @@ public:
     // Do 'and' with all regions and accumulate the result, including bound region.
     // In 'odd' parts we will have an ocean.
     DoDifference doDiff(rectR);
-    m_index.ForEachInRect(GetLimitRect(rectR), bind<void>(ref(doDiff), placeholders::_1));
+    if (task.m_parts)
+    {
+      // The cell is inside of the parent one, so parts of the parent are clipped instead of
+      // whole coasts which may have millions of points.
+      RectT const rect = rectR.GetRect();
+      for (auto const & r : *task.m_parts)
+      {
+        if (rect.IsIntersect(r.GetRect()))
+          doDiff(r);
+      }
+    }
+    else
+    {
+      m_index.ForEachInRect(GetLimitRect(rectR), bind<void>(ref(doDiff), placeholders::_1));
+    }
 
     // Check if too many points for feature.
     if (cell.Level() < kHighLevel && doDiff.GetPointsCount() >= kMaxPoints)
+    {
+      parts = make_shared<vector<RegionT> const>(doDiff.ExtractParts());
       return false;
+    }
 
     m_ctx.processResultFunc(cell, doDiff);
     return true;
@@ -297,19 +460,20 @@ public:
       if (m_ctx.listTasks.empty())
         break;
 
-      TCell currentCell = m_ctx.listTasks.front();
+      Task currentTask = move(m_ctx.listTasks.front());
       m_ctx.listTasks.pop_front();
       ++m_ctx.inWork;
       lock.unlock();
 
-      bool const done = ProcessCell(currentCell);
+      TParts parts;
+      bool const done = ProcessCell(currentTask, parts);
 
       lock.lock();
       // return to queue not ready cells
       if (!done)
       {
         for (int8_t i = 0; i < TCell::MAX_CHILDREN; ++i)
-          m_ctx.listTasks.push_back(currentCell.Child(i));
+          m_ctx.listTasks.push_back({currentTask.m_cell.Child(i), parts});
       }
       --m_ctx.inWork;
       m_ctx.listCondVar.notify_all();
@@ -319,16 +483,16 @@ public:
 
 void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
 {
-  size_t const maxThreads = thread::hardware_concurrency();
-  CHECK_GREATER(maxThreads, 0, ("Not supported platform"));
-
   mutex featuresMutex;
+  vector<pair<int64_t, FeatureBuilder1>> cellFeatures;
   RegionInCellSplitter::Process(
-      maxThreads, RegionInCellSplitter::kStartLevel, m_tree,
-      [&features, &featuresMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
+      RegionInCellSplitter::kStartLevel, m_tree,
+      [&cellFeatures, &featuresMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
       {
+        int64_t const cellId = cell.ToInt64(RegionInCellSplitter::kHighLevel + 1);
+
         FeatureBuilder1 fb;
-        fb.SetCoastCell(cell.ToInt64(RegionInCellSplitter::kHighLevel + 1));
+        fb.SetCoastCell(cellId);
 
         cellData.AssignGeometry(fb);
         fb.SetArea();
@@ -340,6 +504,17 @@ void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
 
         // save result
         lock_guard<mutex> lock(featuresMutex);
-        features.emplace_back(move(fb));
-      });
+        cellFeatures.emplace_back(cellId, move(fb));
+      },
+      base::TaskScheduler::Instance());
+
+  // Cells are processed in any order, sort them to make the output reproducible.
+  sort(cellFeatures.begin(), cellFeatures.end(),
+       [](pair<int64_t, FeatureBuilder1> const & lhs, pair<int64_t, FeatureBuilder1> const & rhs) {
+         return lhs.first < rhs.first;
+       });
+
+  features.reserve(features.size() + cellFeatures.size());
+  for (auto & cellFeature : cellFeatures)
+    features.emplace_back(move(cellFeature.second));
 }
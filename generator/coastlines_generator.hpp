@@ -1,18 +1,18 @@
 #pragma once
 
-#include "generator/feature_merger.hpp"
+#include "generator/feature_builder.hpp"
 
 #include "indexer/cell_id.hpp"
 
 #include "geometry/tree4d.hpp"
 #include "geometry/region2d.hpp"
 
-
-class FeatureBuilder1;
+#include <vector>
 
 class CoastlineFeaturesGenerator
 {
-  FeatureMergeProcessor m_merger;
+  /// Not closed coastline ways, they are merged in Finish().
+  std::vector<FeatureBuilder1> m_ways;
 
   using TTree = m4::Tree<m2::RegionI>;
   TTree m_tree;
@@ -25,8 +25,10 @@ public:
   void AddRegionToTree(FeatureBuilder1 const & fb);
 
   void operator() (FeatureBuilder1 const & fb);
+  /// Merges not closed ways by their endpoints and adds the closed results to the tree.
   /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
   bool Finish();
 
-  void GetFeatures(vector<FeatureBuilder1> & vecFb);
+  /// Clips coasts by cells on the task scheduler, |vecFb| is sorted by cells.
+  void GetFeatures(std::vector<FeatureBuilder1> & vecFb);
 };
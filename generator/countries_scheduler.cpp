@@ -0,0 +1,54 @@
+#include "generator/countries_scheduler.hpp"
+
+#include "base/assert.hpp"
+#include "base/parallel.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+
+using namespace std;
+
+namespace generator
+{
+vector<bool> ForEachCountryInParallel(vector<string> const & countries,
+                                      function<uint64_t(string const & country)> const & getWeight,
+                                      function<bool(string const & country)> const & fn,
+                                      size_t threadsCount)
+{
+  CHECK_GREATER(threadsCount, 0, ());
+
+  vector<uint64_t> weights;
+  weights.reserve(countries.size());
+  for (auto const & country : countries)
+    weights.push_back(getWeight(country));
+
+  vector<size_t> order(countries.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(),
+              [&weights](size_t lhs, size_t rhs) { return weights[lhs] > weights[rhs]; });
+
+  // Not vector<bool> because its elements can't be written concurrently.
+  vector<uint8_t> results(countries.size(), 0);
+  atomic<size_t> next(0);
+  auto const worker = [&](size_t /* thread */) {
+    for (size_t i = next++; i < order.size(); i = next++)
+      results[order[i]] = fn(countries[order[i]]) ? 1 : 0;
+  };
+
+  threadsCount = min(threadsCount, max(countries.size(), static_cast<size_t>(1)));
+  if (threadsCount == 1)
+  {
+    worker(0);
+  }
+  else
+  {
+    base::TaskScheduler scheduler(threadsCount - 1);
+    base::parallel::RunChunks(threadsCount, worker, scheduler);
+  }
+
+  return vector<bool>(results.begin(), results.end());
+}
+}  // namespace generator
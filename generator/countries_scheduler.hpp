@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Runs independent per-country stages of the generation (final features, index, ...) for many
+// countries in one process. Countries are taken by |threadsCount| threads from a common queue
+// sorted by |getWeight| in descending order, so big countries start first and small ones
+// fill the gaps in the end. The calling thread is one of the threads, state loaded before
+// the call (classificator, borders, ...) is shared by all of them.
+//
+// Returns results of |fn| in the order of |countries|.
+std::vector<bool> ForEachCountryInParallel(
+    std::vector<std::string> const & countries,
+    std::function<uint64_t(std::string const & country)> const & getWeight,
+    std::function<bool(std::string const & country)> const & fn, size_t threadsCount);
+}  // namespace generator
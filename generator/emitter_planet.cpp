@@ -81,18 +81,19 @@ void EmitterPlanet::operator()(FeatureBuilder1 & fb)
     return;
   }
 
-  auto const bookingObjId = m_bookingDataset.FindMatchingObjectId(fb);
-  if (bookingObjId != BookingHotel::InvalidObjectId())
+  // Matching with the booking dataset is the slowest, it's done for all the hotels at once.
+  if (m_bookingDataset.GetStorage().Size() != 0 &&
+      m_bookingDataset.NecessaryMatchingConditionHolds(fb))
   {
-    m_bookingDataset.PreprocessMatchedOsmObject(bookingObjId, fb, [this, bookingObjId](FeatureBuilder1 & fb)
-    {
-      m_skippedElements << "BOOKING\t" << DebugPrint(fb.GetMostGenericOsmId())
-                        << '\t' << bookingObjId.Get() << endl;
-      Emit(fb);
-    });
+    m_bookingCandidates.push_back(fb);
     return;
   }
 
+  EmitNotBooking(fb);
+}
+
+void EmitterPlanet::EmitNotBooking(FeatureBuilder1 & fb)
+{
   auto const opentableObjId = m_opentableDataset.FindMatchingObjectId(fb);
   if (opentableObjId != OpentableRestaurant::InvalidObjectId())
   {
@@ -124,9 +125,36 @@ void EmitterPlanet::EmitCityBoundary(FeatureBuilder1 const & fb, FeatureParams c
   UnionEqualPlacesIds(place);
 }
 
+void EmitterPlanet::EmitBookingCandidates()
+{
+  LOG(LINFO, ("Matching", m_bookingCandidates.size(), "hotels with booking dataset."));
+  auto const ids = m_bookingDataset.FindMatchingObjectIds(m_bookingCandidates);
+  for (size_t i = 0; i < m_bookingCandidates.size(); ++i)
+  {
+    auto & fb = m_bookingCandidates[i];
+    auto const bookingObjId = ids[i];
+    if (bookingObjId == BookingHotel::InvalidObjectId())
+    {
+      EmitNotBooking(fb);
+      continue;
+    }
+
+    m_bookingDataset.PreprocessMatchedOsmObject(bookingObjId, fb, [this, bookingObjId](FeatureBuilder1 & fb)
+    {
+      m_skippedElements << "BOOKING\t" << DebugPrint(fb.GetMostGenericOsmId())
+                        << '\t' << bookingObjId.Get() << endl;
+      Emit(fb);
+    });
+  }
+
+  m_bookingCandidates.clear();
+  m_bookingCandidates.shrink_to_fit();
+}
+
 /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
 bool EmitterPlanet::Finish()
 {
+  EmitBookingCandidates();
   DumpSkippedElements();
 
   // Emit all required booking objects to the map.
@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace generator
 {
@@ -48,6 +49,10 @@ private:
   };
 
   void Emit(FeatureBuilder1 & fb);
+  // Matches the features with the opentable dataset and emits them.
+  void EmitNotBooking(FeatureBuilder1 & fb);
+  // Matches the deferred hotels with the booking dataset in parallel and emits them.
+  void EmitBookingCandidates();
   void DumpSkippedElements();
   uint32_t Type(TypeIndex i) const { return m_types[i]; }
   uint32_t GetPlaceType(FeatureParams const & params) const;
@@ -63,6 +68,8 @@ private:
   std::string m_srcCoastsFile;
   bool m_failOnCoasts;
   BookingDataset m_bookingDataset;
+  // Hotels which are matched with |m_bookingDataset| by Finish().
+  std::vector<FeatureBuilder1> m_bookingCandidates;
   OpentableDataset m_opentableDataset;
   ViatorDataset m_viatorDataset;
   shared_ptr<OsmIdToBoundariesTable> m_boundariesTable;
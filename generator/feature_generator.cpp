@@ -131,7 +131,7 @@ uint32_t FeaturesAndRawGeometryCollector::operator()(FeatureBuilder1 const & fb)
   return featureId;
 }
 
-uint32_t CheckedFilePosCast(FileWriter const & f)
+uint32_t CheckedFilePosCast(Writer const & f)
 {
   uint64_t pos = f.Pos();
   CHECK_LESS_OR_EQUAL(pos, static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()),
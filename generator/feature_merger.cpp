@@ -6,6 +6,10 @@
 
 #include "coding/point_to_integer.hpp"
 
+#include "base/parallel.hpp"
+
+#include <utility>
+
 MergedFeatureBuilder1::MergedFeatureBuilder1(FeatureBuilder1 const & fb)
   : FeatureBuilder1(fb), m_isRound(false)
 {
@@ -273,6 +277,90 @@ void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
     emitter(m_last);
 }
 
+namespace
+{
+class MergedFeaturesCollector : public FeatureEmitterIFace
+{
+public:
+  explicit MergedFeaturesCollector(std::vector<FeatureBuilder1> & features)
+    : m_features(features)
+  {
+  }
+
+  void operator()(FeatureBuilder1 const & fb) override { m_features.push_back(fb); }
+
+private:
+  std::vector<FeatureBuilder1> & m_features;
+};
+}  // namespace
+
+ParallelFeatureMergeProcessor::ParallelFeatureMergeProcessor(uint32_t coordBits)
+: m_coordBits(coordBits)
+{
+}
+
+void ParallelFeatureMergeProcessor::operator() (MergedFeatureBuilder1 * p)
+{
+  std::unique_ptr<MergedFeatureBuilder1> feature(p);
+  auto const types = feature->GetTypes();
+  for (size_t i = 0; i < types.size(); ++i)
+  {
+    MergedFeatureBuilder1 * part =
+        i + 1 == types.size() ? feature.release() : new MergedFeatureBuilder1(*feature);
+    part->SetType(types[i]);
+
+    auto & shard = m_shards[types[i]];
+    if (!shard)
+      shard = std::make_unique<FeatureMergeProcessor>(m_coordBits);
+    (*shard)(part);
+  }
+}
+
+void ParallelFeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
+{
+  std::vector<FeatureMergeProcessor *> shards;
+  for (auto & shard : m_shards)
+    shards.push_back(shard.second.get());
+
+  std::vector<std::vector<FeatureBuilder1>> merged(shards.size());
+  base::ParallelFor(0, shards.size(), [&](size_t i) {
+    MergedFeaturesCollector collector(merged[i]);
+    shards[i]->DoMerge(collector);
+  });
+  m_shards.clear();
+
+  // Features with equal geometry are looked up by their end points.
+  std::vector<FeatureBuilder1> features;
+  std::map<std::pair<m2::PointD, m2::PointD>, std::vector<size_t>> byEnds;
+  for (auto & shard : merged)
+  {
+    for (auto & fb : shard)
+    {
+      auto const & geometry = fb.GetOuterGeometry();
+      auto & candidates = byEnds[std::make_pair(geometry.front(), geometry.back())];
+      auto const it = std::find_if(candidates.begin(), candidates.end(), [&](size_t i) {
+        return features[i].GetOuterGeometry() == geometry;
+      });
+      if (it == candidates.end())
+      {
+        candidates.push_back(features.size());
+        features.push_back(std::move(fb));
+        continue;
+      }
+
+      for (auto const type : fb.GetTypes())
+      {
+        if (!features[*it].HasType(type))
+          features[*it].AddType(type);
+      }
+    }
+    shard.clear();
+  }
+
+  for (auto const & fb : features)
+    emitter(fb);
+}
+
 uint32_t FeatureTypesProcessor::GetType(char const * arr[], size_t n)
 {
   uint32_t const type = classif().GetTypeByPath(std::vector<std::string>(arr, arr + n));
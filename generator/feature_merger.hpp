@@ -2,7 +2,9 @@
 #include "generator/feature_emitter_iface.hpp"
 #include "generator/feature_builder.hpp"
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -84,6 +86,26 @@ public:
   void DoMerge(FeatureEmitterIFace & emitter);
 };
 
+/// Feature merger which merges features of every type independently. Features of different
+/// types are never merged with each other, so types are merged in parallel. Merged features
+/// are emitted in the order of types, hence the output doesn't depend on the number of threads.
+class ParallelFeatureMergeProcessor
+{
+  uint32_t m_coordBits;
+  std::map<uint32_t, std::unique_ptr<FeatureMergeProcessor>> m_shards;
+
+public:
+  explicit ParallelFeatureMergeProcessor(uint32_t coordBits);
+
+  /// Takes ownership of |p|. A feature with several types is added to the shards
+  /// of all its types.
+  void operator() (MergedFeatureBuilder1 * p);
+
+  /// Features with equal geometry merged for different types are emitted as one feature
+  /// with all these types.
+  void DoMerge(FeatureEmitterIFace & emitter);
+};
+
 
 /// Feature types corrector.
 class FeatureTypesProcessor
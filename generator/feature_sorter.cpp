@@ -21,16 +21,19 @@
 #include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/writer.hpp"
 
 #include "geometry/polygon.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
 
 #include "defines.hpp"
 
+#include <algorithm>
 #include <list>
 #include <limits>
 #include <memory>
@@ -134,10 +137,34 @@ public:
 
   void SetBounds(m2::RectD bounds) { m_bounds = bounds; }
 
-  uint32_t operator()(FeatureBuilder2 & fb)
+  // Outer geometry and triangles of a feature for every scale, they are written to the
+  // geometry files by Write().
+  struct FeatureGeometry
   {
-    GeometryHolder holder([this](int i) -> FileWriter & { return *m_geoFile[i]; },
-    [this](int i) -> FileWriter & { return *m_trgFile[i]; }, fb, m_header);
+    vector<vector<char>> m_geo;
+    vector<vector<char>> m_trg;
+    FeatureBuilder2::SupportingData m_buffer;
+  };
+
+  // Simplifies and tesselates the geometry of |fb|. It doesn't change the collector, so the
+  // geometry of different features may be prepared in parallel.
+  FeatureGeometry PrepareGeometry(FeatureBuilder2 & fb) const
+  {
+    FeatureGeometry geometry;
+    geometry.m_geo.resize(m_header.GetScalesCount());
+    geometry.m_trg.resize(m_header.GetScalesCount());
+    vector<MemWriter<vector<char>>> geoWriters;
+    vector<MemWriter<vector<char>>> trgWriters;
+    geoWriters.reserve(m_header.GetScalesCount());
+    trgWriters.reserve(m_header.GetScalesCount());
+    for (size_t i = 0; i < m_header.GetScalesCount(); ++i)
+    {
+      geoWriters.emplace_back(geometry.m_geo[i]);
+      trgWriters.emplace_back(geometry.m_trg[i]);
+    }
+
+    GeometryHolder holder([&geoWriters](int i) -> Writer & { return geoWriters[i]; },
+    [&trgWriters](int i) -> Writer & { return trgWriters[i]; }, fb, m_header);
 
     bool const isLine = fb.IsLine();
     bool const isArea = fb.IsArea();
@@ -211,8 +238,18 @@ public:
       }
     }
 
+    geometry.m_buffer = move(holder.GetBuffer());
+    return geometry;
+  }
+
+  // Appends |geometry| to the geometry files and writes the feature.
+  uint32_t Write(FeatureBuilder2 & fb, FeatureGeometry & geometry)
+  {
+    auto & buffer = geometry.m_buffer;
+    AppendGeometry(buffer.m_ptsMask, geometry.m_geo, m_geoFile, buffer.m_ptsOffset);
+    AppendGeometry(buffer.m_trgMask, geometry.m_trg, m_trgFile, buffer.m_trgOffset);
+
     uint32_t featureId = kInvalidFeatureId;
-    auto & buffer = holder.GetBuffer();
     if (fb.PreSerializeAndRemoveUselessNames(buffer))
     {
       fb.Serialize(buffer, m_header.GetDefGeometryCodingParams());
@@ -276,8 +313,27 @@ private:
 
   bool IsCountry() const { return m_header.GetType() == feature::DataHeader::country; }
 
+  // Offsets of the geometry were taken in the buffers of the feature, they are shifted
+  // by the positions of the files. Offsets are in the order of writing, from the last scale.
+  static void AppendGeometry(uint8_t mask, vector<vector<char>> const & geometry,
+                             TmpFiles & files, vector<uint32_t> & offsets)
+  {
+    size_t offset = 0;
+    for (size_t i = geometry.size(); i > 0; --i)
+    {
+      if ((mask & (1 << (i - 1))) == 0)
+        continue;
+
+      CHECK_LESS(offset, offsets.size(), ());
+      auto & file = *files[i - 1];
+      offsets[offset++] += CheckedFilePosCast(file);
+      file.Write(geometry[i - 1].data(), geometry[i - 1].size());
+    }
+    CHECK_EQUAL(offset, offsets.size(), ());
+  }
+
   void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in,
-                      Points & out)
+                      Points & out) const
   {
     if (isCoast)
     {
@@ -349,6 +405,13 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & na
     // type
     header.SetType(static_cast<DataHeader::MapType>(mapType));
 
+    CHECK(!(info.m_fixedWidthGeometry && info.m_progressiveGeometry),
+          ("Only one geometry layout may be set."));
+    if (info.m_fixedWidthGeometry)
+      header.SetGeometryLayout(DataHeader::GeometryLayout::FixedWidth);
+    else if (info.m_progressiveGeometry)
+      header.SetGeometryLayout(DataHeader::GeometryLayout::Progressive);
+
     // region data
     RegionData regionData;
     if (!ReadRegionData(name, regionData))
@@ -359,16 +422,33 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & na
     {
       FeaturesCollector2 collector(datFilePath, header, regionData, info.m_versionDate);
 
-      for (auto const & point : midPoints.GetVector())
+      // Features are read by batches, geometry of the features of a batch is simplified and
+      // tesselated in parallel, then the features are written in order.
+      size_t constexpr kBatchSize = 1 << 12;
+      auto const & points = midPoints.GetVector();
+      vector<FeatureBuilder1> features;
+      vector<FeaturesCollector2::FeatureGeometry> geometries;
+      for (size_t begin = 0; begin < points.size(); begin += kBatchSize)
       {
-        ReaderSource<FileReader> src(reader);
-        src.Skip(point.second);
+        size_t const end = min(points.size(), begin + kBatchSize);
+        features.clear();
+        features.resize(end - begin);
+        for (size_t i = begin; i < end; ++i)
+        {
+          ReaderSource<FileReader> src(reader);
+          src.Skip(points[i].second);
+          ReadFromSourceRawFormat(src, features[i - begin]);
+        }
 
-        FeatureBuilder1 f;
-        ReadFromSourceRawFormat(src, f);
+        geometries.clear();
+        geometries.resize(features.size());
+        base::ParallelFor(0, features.size(), [&](size_t i) {
+          geometries[i] = collector.PrepareGeometry(GetFeatureBuilder2(features[i]));
+        });
 
-        // emit the feature
-        collector(GetFeatureBuilder2(f));
+        // emit the features
+        for (size_t i = 0; i < features.size(); ++i)
+          collector.Write(GetFeatureBuilder2(features[i]), geometries[i]);
       }
 
       // Update bounds with the limit rect corresponding to region borders.
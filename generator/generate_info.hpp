@@ -8,6 +8,7 @@
 
 #include "defines.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,13 +21,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Sparse
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
   // Directory for .mwm.tmp files.
@@ -55,6 +58,9 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Number of threads translating OSM elements to features in the 2nd pass.
+  size_t m_featuresThreadsCount = 1;
+
   std::vector<std::string> m_bucketNames;
 
   bool m_createWorld = false;
@@ -62,8 +68,15 @@ struct GenerateInfo
   bool m_makeCoasts = false;
   bool m_emitCoasts = false;
   bool m_genAddresses = false;
+  // Write outer geometry in the fixed width layout, see DataHeader::GeometryLayout.
+  bool m_fixedWidthGeometry = false;
+  // Write outer paths of coarser scales as indexes into the best path,
+  // see DataHeader::GeometryLayout.
+  bool m_progressiveGeometry = false;
   bool m_failOnCoasts = false;
   bool m_preloadCache = false;
+  // Store ways in the mapped columnar cache, see cache::WaysColumnarWriter.
+  bool m_columnarWaysCache = false;
   bool m_verbose = false;
 
   GenerateInfo() = default;
@@ -74,6 +87,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -86,6 +101,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "sparse")
+      m_nodeStorageType = NodeStorageType::Sparse;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
@@ -0,0 +1,86 @@
+#include "testing/testing.hpp"
+
+#include "generator/borders_grid.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace borders;
+using namespace std;
+
+namespace
+{
+void AddRegion(RegionsGrid::Regions & regions, vector<m2::PointD> const & points)
+{
+  m2::RegionD const region(points.begin(), points.end());
+  regions.Add(region, region.GetRect());
+}
+
+// Checks the grid against the polygons at random points of |rect| and at the vertices.
+void TestGrid(RegionsGrid::Regions const & regions, m2::RectD const & rect, size_t cellsPerSide)
+{
+  RegionsGrid const grid(regions, cellsPerSide);
+  TEST(!grid.IsEmpty(), ());
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> x(rect.minX(), rect.maxX());
+  uniform_real_distribution<double> y(rect.minY(), rect.maxY());
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    m2::PointD const pt(x(rng), y(rng));
+    TEST_EQUAL(grid.Contains(regions, pt), ContainsExactly(regions, pt), (pt));
+  }
+
+  regions.ForEach([&](m2::RegionD const & region) {
+    for (auto const & pt : region.Data())
+      TEST_EQUAL(grid.Contains(regions, pt), ContainsExactly(regions, pt), (pt));
+  });
+}
+
+UNIT_TEST(RegionsGrid_Star)
+{
+  // A star with many thin rays and a separate island.
+  vector<m2::PointD> star;
+  size_t const kRays = 50;
+  for (size_t i = 0; i < 2 * kRays; ++i)
+  {
+    double const angle = M_PI * i / kRays;
+    double const radius = i % 2 == 0 ? 10.0 : 3.0;
+    star.emplace_back(radius * cos(angle), radius * sin(angle));
+  }
+
+  RegionsGrid::Regions regions;
+  AddRegion(regions, star);
+  AddRegion(regions, {{20, 20}, {25, 20}, {22, 24}});
+
+  for (size_t const cells : {size_t(1), size_t(7), size_t(64), RegionsGrid::kMaxCellsPerSide})
+    TestGrid(regions, m2::RectD(-12, -12, 27, 27), cells);
+}
+
+UNIT_TEST(RegionsGrid_BordersAlongCells)
+{
+  // An L-shaped region whose sides go exactly along the sides of the cells of 4x4 grid.
+  RegionsGrid::Regions regions;
+  AddRegion(regions, {{0, 0}, {4, 0}, {4, 1}, {1, 1}, {1, 4}, {0, 4}});
+  TestGrid(regions, m2::RectD(-1, -1, 5, 5), 4 /* cellsPerSide */);
+
+  RegionsGrid const grid(regions, 4 /* cellsPerSide */);
+  TEST(grid.Contains(regions, {0.5, 3.5}), ());
+  TEST(!grid.Contains(regions, {2.5, 2.5}), ());
+  TEST(!grid.Contains(regions, {10, 10}), ());
+  TEST_LESS(grid.GetBoundaryShare(), 1.0, ());
+}
+
+UNIT_TEST(RegionsGrid_Empty)
+{
+  RegionsGrid::Regions regions;
+  RegionsGrid const grid(regions);
+  TEST(grid.IsEmpty(), ());
+  TEST(!grid.Contains(regions, {0, 0}), ());
+}
+}  // namespace
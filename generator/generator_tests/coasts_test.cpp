@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "generator/coastlines_generator.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/feature_helpers.hpp"
@@ -13,8 +14,11 @@
 #include "indexer/cell_id.hpp"
 #include "indexer/scales.hpp"
 
+#include "base/geo_object_id.hpp"
 #include "base/logging.hpp"
+#include "base/math.hpp"
 
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -24,6 +28,29 @@ namespace
 {
 m2::PointU D2I(double x, double y) { return PointDToPointU(m2::PointD(x, y), POINT_COORD_BITS); }
 
+uint32_t constexpr kCoastType = 1;
+
+FeatureBuilder1 MakeCoast(vector<m2::PointD> const & points, uint64_t wayId)
+{
+  FeatureBuilder1 fb;
+  for (auto const & p : points)
+    fb.AddPoint(p);
+  fb.SetLinear();
+  fb.AddOsmId(base::MakeOsmWay(wayId));
+  return fb;
+}
+
+size_t CountFeaturesWithPolygons(vector<FeatureBuilder1> const & features, size_t polygonsCount)
+{
+  size_t count = 0;
+  for (auto const & fb : features)
+  {
+    if (fb.GetPolygonsCount() == polygonsCount)
+      ++count;
+  }
+  return count;
+}
+
 class ProcessCoastsBase
 {
 public:
@@ -180,6 +207,72 @@ UNIT_TEST(CellID_CheckRectPoints)
   }
 }
 
+UNIT_TEST(Coasts_MergeWays)
+{
+  vector<FeatureBuilder1> features[2];
+  for (auto & fbs : features)
+  {
+    CoastlineFeaturesGenerator generator(kCoastType);
+    // The island of ways, the second one is reversed.
+    generator(MakeCoast({{10, 10}, {20, 10}, {20, 20}}, 1));
+    generator(MakeCoast({{10, 20}, {20, 20}}, 2));
+    generator(MakeCoast({{10, 20}, {10, 10}}, 3));
+    // The closed island.
+    generator(MakeCoast({{-20, -20}, {-10, -20}, {-10, -10}, {-20, -20}}, 4));
+    TEST(generator.Finish(), ());
+
+    generator.GetFeatures(fbs);
+  }
+
+  // One feature per cell of the start level, the islands are in different cells.
+  TEST_EQUAL(features[0].size(), 256, ());
+  TEST_EQUAL(CountFeaturesWithPolygons(features[0], 2), 2, ());
+
+  // Features are ordered by cells.
+  TEST_EQUAL(features[0].size(), features[1].size(), ());
+  for (size_t i = 0; i < features[0].size(); ++i)
+  {
+    TEST(features[0][i].IsCoastCell(), ());
+    TEST(features[0][i].GetGeometry() == features[1][i].GetGeometry(), (i));
+  }
+
+  CoastlineFeaturesGenerator generator(kCoastType);
+  generator(MakeCoast({{10, 10}, {20, 10}, {20, 20}}, 1));
+  generator(MakeCoast({{20, 20}, {10, 20}}, 2));
+  TEST(!generator.Finish(), ());
+}
+
+UNIT_TEST(Coasts_SplitCells)
+{
+  // The island with too many points for one cell, its cell is split into four.
+  size_t const kPointsCount = 30000;
+  m2::PointD const center(11.25, 11.25);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < kPointsCount; ++i)
+  {
+    double const angle = 2 * math::pi * i / kPointsCount;
+    points.emplace_back(center.x + 10 * cos(angle), center.y + 10 * sin(angle));
+  }
+  points.push_back(points.front());
+
+  CoastlineFeaturesGenerator generator(kCoastType);
+  generator(MakeCoast(points, 1));
+  TEST(generator.Finish(), ());
+
+  vector<FeatureBuilder1> features;
+  generator.GetFeatures(features);
+  TEST_EQUAL(features.size(), 256 - 1 + 4, ());
+  TEST_EQUAL(CountFeaturesWithPolygons(features, 2), 4, ());
+
+  size_t pointsCount = 0;
+  for (auto const & fb : features)
+  {
+    if (fb.GetPolygonsCount() == 2)
+      pointsCount += fb.GetPointsCount();
+  }
+  TEST_GREATER_OR_EQUAL(pointsCount, kPointsCount, ());
+}
+
 /*
 UNIT_TEST(WorldCoasts_CheckBounds)
 {
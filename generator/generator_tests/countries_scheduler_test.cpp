@@ -0,0 +1,81 @@
+#include "testing/testing.hpp"
+
+#include "generator/countries_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+vector<string> const kCountries = {"Andorra", "Russia_Moscow", "Malta", "Germany_Berlin",
+                                   "Liechtenstein"};
+
+uint64_t GetWeight(string const & country) { return country.size(); }
+
+UNIT_TEST(CountriesScheduler_BiggestFirst)
+{
+  vector<string> processed;
+  auto const results = ForEachCountryInParallel(kCountries, GetWeight,
+                                                [&processed](string const & country) {
+                                                  processed.push_back(country);
+                                                  return country != "Malta";
+                                                },
+                                                1 /* threadsCount */);
+
+  vector<string> const expected = {"Germany_Berlin", "Russia_Moscow", "Liechtenstein", "Andorra",
+                                   "Malta"};
+  TEST_EQUAL(processed, expected, ());
+  TEST_EQUAL(results, vector<bool>({true, true, false, true, true}), ());
+}
+
+UNIT_TEST(CountriesScheduler_Parallel)
+{
+  vector<string> countries;
+  for (size_t i = 0; i < 100; ++i)
+    countries.push_back(to_string(i));
+
+  mutex mu;
+  vector<string> processed;
+  atomic<size_t> running(0);
+  atomic<size_t> maxRunning(0);
+  auto const results = ForEachCountryInParallel(
+      countries, [](string const & country) { return stoull(country); },
+      [&](string const & country) {
+        auto const now = ++running;
+        for (auto prev = maxRunning.load(); prev < now;)
+          maxRunning.compare_exchange_weak(prev, now);
+        this_thread::sleep_for(chrono::microseconds(100));
+        --running;
+
+        lock_guard<mutex> lock(mu);
+        processed.push_back(country);
+        return stoull(country) % 2 == 0;
+      },
+      4 /* threadsCount */);
+
+  TEST_EQUAL(processed.size(), countries.size(), ());
+  TEST_LESS_OR_EQUAL(maxRunning, 4, ());
+  for (size_t i = 0; i < countries.size(); ++i)
+    TEST_EQUAL(results[i], i % 2 == 0, (i));
+
+  // No country is processed twice.
+  sort(processed.begin(), processed.end());
+  TEST(adjacent_find(processed.begin(), processed.end()) == processed.end(), ());
+}
+
+UNIT_TEST(CountriesScheduler_Empty)
+{
+  auto const results = ForEachCountryInParallel(
+      {}, GetWeight, [](string const &) { return true; }, 4 /* threadsCount */);
+  TEST(results.empty(), ());
+}
+}  // namespace
@@ -78,6 +78,53 @@ UNIT_TEST(FeatureMerger_MultipleTypes)
   emitter.Check(4, 1);
 }
 
+UNIT_TEST(FeatureMerger_ParallelMultipleTypes)
+{
+  classificator::Load();
+
+  P arrPt[] = { P(0, 0), P(1, 1), P(2, 2), P(3, 3) };
+  size_t const count = ARRAY_SIZE(arrPt)-1;
+
+  FeatureBuilder1 arrF[count];
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    arrF[i].SetLinear();
+    arrF[i].AddPoint(arrPt[i]);
+    arrF[i].AddPoint(arrPt[i+1]);
+
+    arrF[i].AddType(0);
+  }
+
+  arrF[0].AddType(1);
+  arrF[1].AddType(1);
+  arrF[0].AddType(2);
+  arrF[1].AddType(2);
+
+  arrF[1].AddType(3);
+  arrF[2].AddType(3);
+  arrF[1].AddType(4);
+  arrF[2].AddType(4);
+
+  ParallelFeatureMergeProcessor processor(POINT_COORD_BITS);
+
+  for (size_t i = 0; i < count; ++i)
+    processor(new MergedFeatureBuilder1(arrF[i]));
+
+  VectorEmitter emitter;
+  processor.DoMerge(emitter);
+
+  // Lines of types 1 and 2 (and of types 3 and 4) are merged independently, but have equal
+  // geometry, so they are emitted as one feature.
+  TEST_EQUAL(emitter.GetSize(), 3, ());
+
+  emitter.Check(0, 1);
+  emitter.Check(1, 1);
+  emitter.Check(2, 1);
+  emitter.Check(3, 1);
+  emitter.Check(4, 1);
+}
+
 UNIT_TEST(FeatureMerger_Branches)
 {
   classificator::Load();
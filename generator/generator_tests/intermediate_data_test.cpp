@@ -21,13 +21,16 @@
 
 #include "base/control_flow.hpp"
 #include "base/macros.hpp"
+#include "base/math.hpp"
 
 #include "defines.hpp"
 
 #include <cstdint>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace generator;
 using namespace cache;  // after generator, because it is generator::cache
@@ -310,4 +313,92 @@ UNIT_TEST(IntermediateData_CameraNodesToWays_test_5)
 
   TestIntermediateData_SpeedCameraNodesToWays(osmSourceXML, trueAnswers, /* number of nodes in xml = */ 1);
 }
+
+UNIT_TEST(IntermediateData_SparsePointStorage)
+{
+  ScopedFile const file("sparse_nodes.dat", ScopedFile::Mode::DoNotCreate);
+  auto const type = GenerateInfo::NodeStorageType::Sparse;
+
+  vector<tuple<uint64_t, double, double>> const points = {
+      {0, 55.75, 37.62},   {1, 55.7501, 37.6199}, {5, -90.0, -180.0}, {127, 90.0, 180.0},
+      {128, 0.0, 0.0},     {1000, 1e-7, -1e-7},   {100000, -33.8688, 151.2093}};
+  {
+    auto writer = CreatePointStorageWriter(type, file.GetFullPath());
+    for (auto const & p : points)
+      writer->AddPoint(get<0>(p), get<1>(p), get<2>(p));
+    TEST_EQUAL(writer->GetNumProcessedPoints(), points.size(), ());
+  }
+
+  auto reader = CreatePointStorageReader(type, file.GetFullPath());
+  double lat;
+  double lon;
+  for (auto const & p : points)
+  {
+    TEST(reader->GetPoint(get<0>(p), lat, lon), (get<0>(p)));
+    TEST(base::AlmostEqualAbs(lat, get<1>(p), 1e-7), (get<0>(p), lat));
+    TEST(base::AlmostEqualAbs(lon, get<2>(p), 1e-7), (get<0>(p), lon));
+  }
+
+  for (uint64_t const id : {2, 126, 129, 999, 1001, 50000, 100001, 1000000})
+    TEST(!reader->GetPoint(id, lat, lon), (id));
+}
+
+UNIT_TEST(IntermediateData_WaysColumnarCache)
+{
+  ScopedFile const file("columnar_ways.dat", ScopedFile::Mode::DoNotCreate);
+
+  vector<pair<uint64_t, vector<uint64_t>>> const ways = {
+      {10, {1, 2, 3}},
+      {20, {}},
+      {30, {0xFFFFFFFFFFFFFFFF, 0, 0xFFFFFFFF, 5}},
+      {1000000, {100, 99, 98, 100}}};
+
+  for (bool const sorted : {true, false})
+  {
+    {
+      WaysColumnarWriter writer(file.GetFullPath());
+      auto const write = [&writer](pair<uint64_t, vector<uint64_t>> const & way) {
+        WayElement e(way.first);
+        e.nodes = way.second;
+        writer.Write(way.first, e);
+      };
+
+      if (sorted)
+      {
+        for (auto const & way : ways)
+          write(way);
+      }
+      else
+      {
+        for (auto it = ways.rbegin(); it != ways.rend(); ++it)
+          write(*it);
+        // The first way with the same id is kept.
+        write({30, {7, 8}});
+      }
+      writer.SaveOffsets();
+    }
+
+    WaysColumnarReader const reader(file.GetFullPath());
+    for (auto const & way : ways)
+    {
+      WayElement e(way.first);
+      TEST(reader.Read(way.first, e), (sorted, way.first));
+      TEST_EQUAL(e.nodes, way.second, (sorted, way.first));
+    }
+
+    for (uint64_t const id : {0, 11, 29, 31, 999999, 1000001})
+    {
+      WayElement e(id);
+      TEST(!reader.Read(id, e), (sorted, id));
+    }
+  }
+
+  {
+    WaysColumnarWriter writer(file.GetFullPath());
+    writer.SaveOffsets();
+  }
+  WaysColumnarReader const empty(file.GetFullPath());
+  WayElement e(1 /* fake osm id */);
+  TEST(!empty.Read(1, e), ());
+}
 }  // namespace
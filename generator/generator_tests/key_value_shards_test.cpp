@@ -0,0 +1,80 @@
+#include "testing/testing.hpp"
+
+#include "generator/generator_tests/common.hpp"
+#include "generator/geo_objects/key_value_shards.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+
+#include "base/scope_guard.hpp"
+#include "base/string_utils.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace generator::geo_objects;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(KeyValueShards_Smoke)
+{
+  auto const path = generator_tests::GetFileName();
+  auto const indexPath = KeyValueShardsWriter::GetIndexPath(path);
+  SCOPE_GUARD(removeStorage, [&]() {
+    Platform::RemoveFileIfExists(path);
+    Platform::RemoveFileIfExists(indexPath);
+  });
+
+  size_t const kShardsCount = 4;
+  base::TaskScheduler scheduler(2 /* workersCount */);
+  {
+    KeyValueShardsWriter writer(path, kShardsCount);
+    // Shard 2 is left empty.
+    for (uint64_t key : {13, 4, 9, 1, 8, 5, 0, 3})
+      writer.Add(key, ("{\"id\":" + strings::to_string(key) + "}").c_str());
+    writer.Add(4, "{\"id\":\"second\"}");
+    writer.Add(static_cast<uint64_t>(-3), "{}");
+    writer.Finish(scheduler);
+  }
+  scheduler.ShutdownAndJoin();
+
+  string storage;
+  FileReader(path).ReadAsString(storage);
+  // Keys are sorted as unsigned numbers in shards.
+  string const expected =
+      "0 {\"id\":0}\n4 {\"id\":4}\n4 {\"id\":\"second\"}\n8 {\"id\":8}\n"
+      "1 {\"id\":1}\n5 {\"id\":5}\n9 {\"id\":9}\n13 {\"id\":13}\n-3 {}\n"
+      "3 {\"id\":3}\n";
+  TEST_EQUAL(storage, expected, ());
+
+  KeyValueShardsIndex const index(indexPath);
+  auto const & shards = index.GetShards();
+  TEST_EQUAL(shards.size(), kShardsCount, ());
+  uint64_t offset = 0;
+  for (auto const & shard : shards)
+  {
+    TEST_EQUAL(shard.m_offset, offset, ());
+    offset += shard.m_size;
+  }
+  TEST_EQUAL(offset, storage.size(), ());
+  TEST_EQUAL(shards[2].m_recordsCount, 0, ());
+  TEST(index.ReadRecords(2).empty(), ());
+
+  auto const records = index.ReadRecords(1);
+  TEST_EQUAL(records.size(), 5, ());
+  for (auto const & record : records)
+  {
+    auto const key = storage.substr(record.second, storage.find(' ', record.second) - record.second);
+    TEST_EQUAL(key, strings::to_string(static_cast<int64_t>(record.first)), ());
+  }
+
+  TEST_EQUAL(index.Find(4), vector<uint64_t>({11, 22}), ());
+  TEST_EQUAL(index.Find(static_cast<uint64_t>(-3)), vector<uint64_t>({storage.size() - 17}), ());
+  TEST(index.Find(7).empty(), ());
+  TEST(index.Find(2).empty(), ());
+}
+}  // namespace
@@ -0,0 +1,119 @@
+#include "testing/testing.hpp"
+
+#include "generator/borders_loader.hpp"
+#include "generator/osm_changes.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+string const kChanges = R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6" generator="test">
+  <create>
+    <node id="1" version="1" lat="10.5" lon="10.5">
+      <tag k="amenity" v="cafe"/>
+    </node>
+    <way id="10" version="1">
+      <nd ref="1"/>
+      <nd ref="2"/>
+    </way>
+  </create>
+  <modify>
+    <node id="2" version="2" lat="-10.5" lon="-10.5"/>
+    <relation id="100" version="3">
+      <member type="way" ref="10" role="outer"/>
+      <member type="node" ref="3" role=""/>
+      <tag k="type" v="multipolygon"/>
+    </relation>
+  </modify>
+  <delete>
+    <node id="3" version="4" lat="30.5" lon="30.5"/>
+  </delete>
+</osmChange>
+)";
+
+struct Change
+{
+  OsmChangeAction m_action;
+  OsmElement m_element;
+};
+
+vector<Change> ReadChanges(string const & xml)
+{
+  istringstream stream(xml);
+  SourceReader reader(stream);
+
+  vector<Change> changes;
+  ProcessOsmChangesFromXML(reader, [&changes](OsmChangeAction action, OsmElement * e) {
+    changes.push_back({action, *e});
+  });
+  return changes;
+}
+
+// Square country with |lat|, |lon| in the center.
+void AddCountry(borders::CountriesContainer & countries, string const & name, double lat,
+                double lon)
+{
+  m2::RectD const rect(MercatorBounds::FromLatLon(lat - 5, lon - 5),
+                       MercatorBounds::FromLatLon(lat + 5, lon + 5));
+  vector<m2::PointD> const points = {rect.LeftBottom(), rect.LeftTop(), rect.RightTop(),
+                                     rect.RightBottom()};
+  borders::CountryPolygons country(name);
+  country.m_regions.Add(borders::Region(points.begin(), points.end()), rect);
+  countries.Add(move(country), rect);
+}
+
+UNIT_TEST(OsmChanges_Read)
+{
+  auto const changes = ReadChanges(kChanges);
+  TEST_EQUAL(changes.size(), 5, ());
+
+  TEST_EQUAL(changes[0].m_action, OsmChangeAction::Create, ());
+  TEST(changes[0].m_element.type == OsmElement::EntityType::Node, ());
+  TEST_EQUAL(changes[0].m_element.id, 1, ());
+  TEST_EQUAL(changes[0].m_element.lat, 10.5, ());
+  TEST_EQUAL(changes[0].m_element.Tags(), vector<OsmElement::Tag>({{"amenity", "cafe"}}), ());
+
+  TEST_EQUAL(changes[1].m_action, OsmChangeAction::Create, ());
+  TEST(changes[1].m_element.type == OsmElement::EntityType::Way, ());
+  TEST_EQUAL(changes[1].m_element.Nodes(), vector<uint64_t>({1, 2}), ());
+
+  TEST_EQUAL(changes[2].m_action, OsmChangeAction::Modify, ());
+  TEST_EQUAL(changes[2].m_element.id, 2, ());
+
+  TEST_EQUAL(changes[3].m_action, OsmChangeAction::Modify, ());
+  TEST(changes[3].m_element.type == OsmElement::EntityType::Relation, ());
+  TEST_EQUAL(changes[3].m_element.Members().size(), 2, ());
+
+  TEST_EQUAL(changes[4].m_action, OsmChangeAction::Delete, ());
+  TEST_EQUAL(changes[4].m_element.id, 3, ());
+}
+
+UNIT_TEST(OsmChanges_AffectedCountries)
+{
+  borders::CountriesContainer countries;
+  AddCountry(countries, "North", 10, 10);
+  AddCountry(countries, "South", -10, -10);
+  AddCountry(countries, "East", 10, 100);
+
+  AffectedCountriesFinder finder(countries, nullptr /* cache */);
+  for (auto const & change : ReadChanges(kChanges))
+    finder(change.m_action, change.m_element);
+
+  // The deleted node isn't known without the cache.
+  TEST_EQUAL(finder.GetCountries(), set<string>({"North", "South"}), ());
+}
+}  // namespace
@@ -0,0 +1,286 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/math.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+// Minimal protobuf writer to build test files.
+class ProtoWriter
+{
+public:
+  void WriteVarint(uint32_t field, uint64_t value)
+  {
+    WriteKey(field, 0 /* wireType */);
+    WriteRawVarint(value);
+  }
+
+  void WriteSVarint(uint32_t field, int64_t value) { WriteVarint(field, ZigZag(value)); }
+
+  void WriteBytes(uint32_t field, string const & bytes)
+  {
+    WriteKey(field, 2 /* wireType */);
+    WriteRawVarint(bytes.size());
+    m_data += bytes;
+  }
+
+  void WritePacked(uint32_t field, vector<uint64_t> const & values)
+  {
+    ProtoWriter packed;
+    for (auto const v : values)
+      packed.WriteRawVarint(v);
+    WriteBytes(field, packed.Get());
+  }
+
+  void WritePackedSigned(uint32_t field, vector<int64_t> const & values)
+  {
+    vector<uint64_t> zigZag;
+    for (auto const v : values)
+      zigZag.push_back(ZigZag(v));
+    WritePacked(field, zigZag);
+  }
+
+  string const & Get() const { return m_data; }
+
+private:
+  static uint64_t ZigZag(int64_t value)
+  {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+
+  void WriteKey(uint32_t field, uint32_t wireType) { WriteRawVarint((field << 3) | wireType); }
+
+  void WriteRawVarint(uint64_t value)
+  {
+    for (; value >= 0x80; value >>= 7)
+      m_data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    m_data.push_back(static_cast<char>(value));
+  }
+
+  string m_data;
+};
+
+string MakeBlob(string const & type, string const & block, bool compress)
+{
+  ProtoWriter blob;
+  if (compress)
+  {
+    string compressed;
+    coding::ZLib::Deflate deflate(coding::ZLib::Deflate::Format::ZLib,
+                                  coding::ZLib::Deflate::Level::BestSpeed);
+    TEST(deflate(block, back_inserter(compressed)), ());
+    blob.WriteVarint(2 /* raw_size */, block.size());
+    blob.WriteBytes(3 /* zlib_data */, compressed);
+  }
+  else
+  {
+    blob.WriteBytes(1 /* raw */, block);
+  }
+
+  ProtoWriter header;
+  header.WriteBytes(1 /* type */, type);
+  header.WriteVarint(3 /* datasize */, blob.Get().size());
+
+  auto const size = static_cast<uint32_t>(header.Get().size());
+  string result = {static_cast<char>(size >> 24), static_cast<char>(size >> 16),
+                   static_cast<char>(size >> 8), static_cast<char>(size)};
+  return result + header.Get() + blob.Get();
+}
+
+string MakeHeader(vector<string> const & features = {"OsmSchema-V0.6", "DenseNodes"})
+{
+  ProtoWriter header;
+  for (auto const & feature : features)
+    header.WriteBytes(4 /* required_features */, feature);
+  header.WriteBytes(16 /* writingprogram */, "test");
+  return MakeBlob("OSMHeader", header.Get(), false /* compress */);
+}
+
+string MakeBlock(vector<string> const & strings, vector<string> const & groups)
+{
+  ProtoWriter table;
+  for (auto const & s : strings)
+    table.WriteBytes(1 /* s */, s);
+
+  ProtoWriter block;
+  block.WriteBytes(1 /* stringtable */, table.Get());
+  for (auto const & group : groups)
+    block.WriteBytes(2 /* primitivegroup */, group);
+  return block.Get();
+}
+
+// Dense nodes with ids |firstId|, |firstId| + 1, ... and without tags.
+string MakeDenseGroup(int64_t firstId, size_t count)
+{
+  vector<int64_t> ids(count, 1);
+  ids[0] = firstId;
+  vector<int64_t> coords(count, 1000);
+  ProtoWriter dense;
+  dense.WritePackedSigned(1 /* id */, ids);
+  dense.WritePackedSigned(8 /* lat */, coords);
+  dense.WritePackedSigned(9 /* lon */, coords);
+
+  ProtoWriter group;
+  group.WriteBytes(2 /* dense */, dense.Get());
+  return group.Get();
+}
+
+vector<OsmElement> ReadAll(string const & data, base::TaskScheduler * scheduler)
+{
+  istringstream ss(data);
+  osm::PbfSource source(
+      [&ss](uint8_t * buffer, size_t size) {
+        return ss.read(reinterpret_cast<char *>(buffer), size).gcount();
+      },
+      scheduler);
+
+  vector<OsmElement> elements;
+  source.ForEach([&elements](OsmElement * e) { elements.push_back(*e); });
+  return elements;
+}
+
+UNIT_TEST(OSM_PBF_Source_Elements)
+{
+  vector<string> const strings = {"",     "amenity", "cafe", "name",  "Кафе",
+                                  "type", "route",   "role", "highway", "road"};
+
+  ProtoWriter dense;
+  dense.WritePackedSigned(1 /* id */, {100, 1, 1});
+  dense.WritePackedSigned(8 /* lat */, {557500000, 100, -200});
+  dense.WritePackedSigned(9 /* lon */, {376200000, -100, 300});
+  // The second node has two tags.
+  dense.WritePacked(10 /* keys_vals */, {0, 1, 2, 3, 4, 0, 0});
+  ProtoWriter denseGroup;
+  denseGroup.WriteBytes(2 /* dense */, dense.Get());
+
+  ProtoWriter node;
+  node.WriteSVarint(1 /* id */, 200);
+  node.WritePacked(2 /* keys */, {1});
+  node.WritePacked(3 /* vals */, {2});
+  node.WriteSVarint(8 /* lat */, 100);
+  node.WriteSVarint(9 /* lon */, -100);
+  ProtoWriter nodeGroup;
+  nodeGroup.WriteBytes(1 /* nodes */, node.Get());
+
+  ProtoWriter way;
+  way.WriteVarint(1 /* id */, 300);
+  way.WritePacked(2 /* keys */, {8});
+  way.WritePacked(3 /* vals */, {9});
+  way.WritePackedSigned(8 /* refs */, {100, 1, 1});
+
+  ProtoWriter relation;
+  relation.WriteVarint(1 /* id */, 400);
+  relation.WritePacked(2 /* keys */, {5});
+  relation.WritePacked(3 /* vals */, {6});
+  relation.WritePacked(8 /* roles_sid */, {7, 0});
+  relation.WritePackedSigned(9 /* memids */, {300, -200});
+  relation.WritePacked(10 /* types */, {1, 0});
+
+  ProtoWriter wayGroup;
+  wayGroup.WriteBytes(3 /* ways */, way.Get());
+  ProtoWriter relationGroup;
+  relationGroup.WriteBytes(4 /* relations */, relation.Get());
+
+  auto const data =
+      MakeHeader() +
+      MakeBlob("OSMData", MakeBlock(strings, {denseGroup.Get(), nodeGroup.Get()}),
+               true /* compress */) +
+      MakeBlob("Unknown", "ignored", false /* compress */) +
+      MakeBlob("OSMData", MakeBlock(strings, {wayGroup.Get(), relationGroup.Get()}),
+               false /* compress */);
+
+  auto const elements = ReadAll(data, nullptr /* scheduler */);
+  TEST_EQUAL(elements.size(), 6, ());
+
+  TEST(elements[0].type == OsmElement::EntityType::Node, ());
+  TEST_EQUAL(elements[0].id, 100, ());
+  TEST(base::AlmostEqualAbs(elements[0].lat, 55.75, 1e-7), ());
+  TEST(base::AlmostEqualAbs(elements[0].lon, 37.62, 1e-7), ());
+  TEST(elements[0].Tags().empty(), ());
+
+  TEST_EQUAL(elements[1].id, 101, ());
+  TEST(base::AlmostEqualAbs(elements[1].lat, 55.75001, 1e-7), ());
+  TEST(base::AlmostEqualAbs(elements[1].lon, 37.61999, 1e-7), ());
+  vector<OsmElement::Tag> const tags = {{"amenity", "cafe"}, {"name", "Кафе"}};
+  TEST_EQUAL(elements[1].Tags(), tags, ());
+
+  TEST_EQUAL(elements[2].id, 102, ());
+  TEST(elements[2].Tags().empty(), ());
+
+  TEST(elements[3].type == OsmElement::EntityType::Node, ());
+  TEST_EQUAL(elements[3].id, 200, ());
+  TEST(base::AlmostEqualAbs(elements[3].lat, 1e-5, 1e-9), ());
+  TEST(base::AlmostEqualAbs(elements[3].lon, -1e-5, 1e-9), ());
+  TEST_EQUAL(elements[3].Tags(), vector<OsmElement::Tag>({{"amenity", "cafe"}}), ());
+
+  TEST(elements[4].type == OsmElement::EntityType::Way, ());
+  TEST_EQUAL(elements[4].id, 300, ());
+  TEST_EQUAL(elements[4].Nodes(), vector<uint64_t>({100, 101, 102}), ());
+  TEST_EQUAL(elements[4].Tags(), vector<OsmElement::Tag>({{"highway", "road"}}), ());
+
+  TEST(elements[5].type == OsmElement::EntityType::Relation, ());
+  TEST_EQUAL(elements[5].id, 400, ());
+  TEST(elements[5].Members() ==
+           vector<OsmElement::Member>({{300, OsmElement::EntityType::Way, "role"},
+                                       {100, OsmElement::EntityType::Node, ""}}),
+       ());
+  TEST_EQUAL(elements[5].Tags(), vector<OsmElement::Tag>({{"type", "route"}}), ());
+}
+
+UNIT_TEST(OSM_PBF_Source_ParallelOrder)
+{
+  size_t const kBlocks = 50;
+  size_t const kNodes = 100;
+
+  auto data = MakeHeader();
+  for (size_t i = 0; i < kBlocks; ++i)
+  {
+    auto const block = MakeBlock({""}, {MakeDenseGroup(static_cast<int64_t>(i * kNodes), kNodes)});
+    data += MakeBlob("OSMData", block, i % 2 == 0 /* compress */);
+  }
+
+  base::TaskScheduler scheduler(4 /* workersCount */);
+  auto const elements = ReadAll(data, &scheduler);
+  TEST_EQUAL(elements.size(), kBlocks * kNodes, ());
+  for (size_t i = 0; i < elements.size(); ++i)
+    TEST_EQUAL(elements[i].id, i, ());
+
+  scheduler.ShutdownAndJoin();
+}
+
+UNIT_TEST(OSM_PBF_Source_Errors)
+{
+  auto const block = MakeBlob("OSMData", MakeBlock({""}, {MakeDenseGroup(1, 10)}),
+                              true /* compress */);
+
+  // Data before the header.
+  TEST_THROW(ReadAll(block, nullptr /* scheduler */), osm::PbfSource::Exception, ());
+
+  // Unsupported required feature.
+  TEST_THROW(ReadAll(MakeHeader({"HistoricalInformation"}) + block, nullptr /* scheduler */),
+             osm::PbfSource::Exception, ());
+
+  // Truncated file.
+  auto const data = MakeHeader() + block;
+  base::TaskScheduler scheduler(2 /* workersCount */);
+  TEST_THROW(ReadAll(data.substr(0, data.size() - 3), &scheduler), osm::PbfSource::Exception, ());
+
+  // Broken block is reported by the decoding task.
+  auto broken = MakeHeader() + MakeBlob("OSMData", "\x0a\x7f", false /* compress */);
+  TEST_THROW(ReadAll(broken, &scheduler), osm::PbfSource::Exception, ());
+  scheduler.ShutdownAndJoin();
+}
+}  // namespace
@@ -224,3 +224,25 @@ UNIT_TEST(RegionsBuilderTest_GetCountryTrees)
   TEST(ExistsName(bankOfNames, "Country_1_Region_5_Subregion_6Country_1_Region_5Country_1"), ());
   TEST(ExistsName(bankOfNames, "Country_1_Region_5_Subregion_7Country_1_Region_5Country_1"), ());
 }
+
+UNIT_TEST(RegionsBuilderTest_GetCountryTreesOneThread)
+{
+  auto const filename = MakeCollectorData();
+  RegionInfo collector(filename);
+
+  std::vector<std::string> bankOfNames[2];
+  for (size_t i = 0; i < ARRAY_SIZE(bankOfNames); ++i)
+  {
+    int const cpuCount = i == 0 ? 1 : -1;
+    RegionsBuilder builder(MakeTestDataSet1(collector),
+                           std::make_unique<Helper>(bankOfNames[i]), cpuCount);
+    for (auto const & tree : builder.GetCountryTrees())
+    {
+      auto const unused = builder.ToIdStringList(tree.second);
+      UNUSED_VALUE(unused);
+    }
+  }
+
+  TEST_EQUAL(bankOfNames[0], bankOfNames[1], ());
+  TEST(ExistsName(bankOfNames[0], "Country_1_Region_5_Subregion_6Country_1_Region_5Country_1"), ());
+}
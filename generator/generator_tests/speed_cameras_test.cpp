@@ -132,7 +132,8 @@ bool CheckCameraMapsEquality(CameraMap const & lhs, CameraMap const & rhs)
   return true;
 }
 
-void TestSpeedCameraSectionBuilding(string const & osmContent, CameraMap const & answer)
+void TestSpeedCameraSectionBuilding(string const & osmContent, CameraMap const & answer,
+                                    size_t featuresThreadsCount = 1)
 {
   GetStyleReader().SetCurrentStyle(MapStyleMerged);
   classificator::Load();
@@ -158,6 +159,7 @@ void TestSpeedCameraSectionBuilding(string const & osmContent, CameraMap const &
   genInfo.m_nodeStorageType = feature::GenerateInfo::NodeStorageType::Index;
   genInfo.m_osmFileName = base::JoinPath(tmpDir, osmRelativePath);
   genInfo.m_osmFileType = feature::GenerateInfo::OsmSourceType::XML;
+  genInfo.m_featuresThreadsCount = featuresThreadsCount;
 
   TEST(GenerateIntermediateData(genInfo), ("Can not generate intermediate data for speed cam"));
 
@@ -380,6 +382,8 @@ UNIT_TEST(SpeedCameraGenerationTest_CameraIsOnePointOfFeature_4)
     {SegmentCoord(1, 1), std::vector<RouteSegment::SpeedCamera>{{0, 100}}}
   };
   TestSpeedCameraSectionBuilding(osmContent, answer);
+  // Features are translated by several threads in the same order.
+  TestSpeedCameraSectionBuilding(osmContent, answer, 4 /* featuresThreadsCount */);
 }
 
 UNIT_TEST(SpeedCameraGenerationTest_CameraIsNearFeature_1)
@@ -2,7 +2,17 @@
 
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "base/parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 using namespace generator;
+using platform::tests_support::ScopedFile;
 
 namespace
 {
@@ -25,4 +35,47 @@ UNIT_TEST(FilenameTests)
   name = GetBase({-34.622358, -58.383654});
   TEST_EQUAL(name, "S35W059", ());
 }
+
+// Writes unpacked tile with all heights equal to |height| except the height at |lat|, |lon|.
+std::string MakeHgt(int16_t height, double lat, double lon, int16_t pointHeight)
+{
+  size_t const kSide = 3601;
+  auto const put = [](std::string & data, size_t ix, int16_t h) {
+    data[2 * ix] = static_cast<char>(static_cast<uint16_t>(h) >> 8);
+    data[2 * ix + 1] = static_cast<char>(h & 0xFF);
+  };
+
+  std::string data(kSide * kSide * 2, 0);
+  for (size_t i = 0; i < kSide * kSide; ++i)
+    put(data, i, height);
+
+  auto const row = static_cast<size_t>((kSide - 1) * (1 - lat));
+  auto const col = static_cast<size_t>((kSide - 1) * lon);
+  put(data, row * kSide + col, pointHeight);
+  return data;
+}
+
+UNIT_TEST(SrtmTileManager_MappedTiles)
+{
+  ScopedFile const n00(GetBase({0.5, 0.5}) + ".hgt", MakeHgt(100, 0.5, 0.25, 1000));
+  ScopedFile const n01(GetBase({1.5, 0.5}) + ".hgt", MakeHgt(-5, 0.0, 0.0, 0));
+
+  SrtmTileManager manager(GetPlatform().WritableDir(), 1 /* maxTilesCount */);
+  TEST_EQUAL(manager.GetHeight({0.5, 0.25}), 1000, ());
+  TEST_EQUAL(manager.GetHeight({0.1, 0.9}), 100, ());
+  TEST_EQUAL(manager.GetHeight({1.5, 0.5}), -5, ());
+  TEST_EQUAL(manager.GetHeight({2.5, 0.5}), feature::kInvalidAltitude, ());
+
+  // The tile stays valid when it's dropped from the cache.
+  auto const tile = manager.GetTile({0.5, 0.5});
+  TEST(tile->IsValid(), ());
+  TEST_EQUAL(manager.GetHeight({1.5, 0.5}), -5, ());
+  TEST_NOT_EQUAL(manager.GetTile({0.5, 0.5}), tile, ());
+  TEST_EQUAL(tile->GetHeight({0.5, 0.25}), 1000, ());
+
+  base::ParallelFor(0, 1000, [&](size_t i) {
+    double const lat = i % 2 == 0 ? 0.5 : 1.5;
+    TEST_EQUAL(manager.GetHeight({lat, 0.5}), i % 2 == 0 ? 100 : -5, ());
+  });
+}
 }  // namespace
@@ -0,0 +1,62 @@
+#include "testing/testing.hpp"
+
+#include "generator/stages_report.hpp"
+
+#include <string>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(StagesReport_ScopedStage)
+{
+  StagesReport report;
+  {
+    StagesReport::ScopedStage stage(report, "search_index", "Country", 10 /* itemsCount */);
+    string buffer(1 << 20, 'a');
+    TEST_EQUAL(buffer.back(), 'a', ());
+  }
+  {
+    StagesReport::ScopedStage stage(report, "preprocess");
+    stage.SetItemsCount(5);
+  }
+
+  auto const stages = report.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+  TEST_EQUAL(stages[0].m_name, "search_index", ());
+  TEST_EQUAL(stages[0].m_country, "Country", ());
+  TEST_EQUAL(stages[0].m_itemsCount, 10, ());
+  TEST_GREATER_OR_EQUAL(stages[0].m_wallSeconds, 0.0, ());
+  TEST_GREATER_OR_EQUAL(stages[0].m_cpuSeconds, 0.0, ());
+  TEST_GREATER(stages[0].m_peakRssBytes, 0, ());
+  TEST(stages[1].m_country.empty(), ());
+  TEST_EQUAL(stages[1].m_itemsCount, 5, ());
+}
+
+UNIT_TEST(StagesReport_ToJSON)
+{
+  StagesReport::Stage stage;
+  stage.m_name = "geometry";
+  stage.m_country = "Country";
+  stage.m_wallSeconds = 2.0;
+  stage.m_cpuSeconds = 3.5;
+  stage.m_peakRssBytes = 1024;
+  stage.m_bytesRead = 10;
+  stage.m_bytesWritten = 20;
+  stage.m_itemsCount = 100;
+
+  TEST_EQUAL(StagesReport::ToJSON(stage),
+             "{\"stage\":\"geometry\",\"country\":\"Country\",\"wall_seconds\":2.0,"
+             "\"cpu_seconds\":3.5,\"peak_rss_bytes\":1024,\"bytes_read\":10,"
+             "\"bytes_written\":20,\"items\":100,\"items_per_second\":50.0}",
+             ());
+
+  stage.m_country.clear();
+  stage.m_itemsCount = 0;
+  TEST_EQUAL(StagesReport::ToJSON(stage),
+             "{\"stage\":\"geometry\",\"wall_seconds\":2.0,\"cpu_seconds\":3.5,"
+             "\"peak_rss_bytes\":1024,\"bytes_read\":10,\"bytes_written\":20}",
+             ());
+}
+}  // namespace
@@ -2,7 +2,13 @@
 
 #include "generator/tesselator.hpp"
 
+#include "geometry/polygon.hpp"
+
 #include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <cmath>
+#include <vector>
 
 using namespace std;
 
@@ -73,3 +79,69 @@ UNIT_TEST(Tesselator_Odd)
 
   TEST_EQUAL(2, RunTest(l), ());
 }
+
+UNIT_TEST(Tesselator_Convex)
+{
+  // Both orientations of a closed and an open contour.
+  vector<vector<P>> const contours = {
+      {P(0, 0), P(4, 0), P(4, 4), P(0, 4)},
+      {P(0, 0), P(0, 4), P(4, 4), P(4, 0), P(0, 0)},
+      {P(0, 0), P(2, -1), P(4, 0), P(5, 2), P(4, 4), P(0, 4)}};
+  for (auto const & contour : contours)
+  {
+    tesselator::TrianglesInfo info;
+    size_t const count = contour.front() == contour.back() ? contour.size() - 1 : contour.size();
+    TEST_EQUAL(tesselator::TesselateInterior({contour}, info), count - 2, (contour));
+
+    double area = 0.0;
+    double const contourOrientation = m2::CrossProduct(contour[1] - contour[0],
+                                                       contour[2] - contour[1]);
+    info.ForEachTriangle([&](P const & p1, P const & p2, P const & p3) {
+      double const s = m2::CrossProduct(p2 - p1, p3 - p1);
+      // Triangles have the orientation of the contour.
+      TEST_GREATER(s * contourOrientation, 0.0, (contour));
+      area += fabs(s) / 2;
+    });
+    TEST(base::AlmostEqualAbs(area, fabs(GetPolygonArea(contour.begin(), contour.end())), 1e-9),
+         (contour));
+  }
+}
+
+UNIT_TEST(Tesselator_NotConvex)
+{
+  // Self-intersecting star has all the turns to the same side.
+  P const star[] = {P(0, 0), P(4, 3), P(-1, 3), P(3, 0), P(2, 5)};
+  TEST_GREATER(RunTess(star, ARRAY_SIZE(star)), 0, ());
+
+  // Collinear points.
+  P const rect[] = {P(0, 0), P(2, 0), P(4, 0), P(4, 4), P(0, 4)};
+  TEST_EQUAL(RunTess(rect, ARRAY_SIZE(rect)), 3, ());
+}
+
+UNIT_TEST(Tesselator_SameShapes)
+{
+  auto const makeShape = [](P const & origin) {
+    vector<P> shape = {P(0, 0), P(3, 0), P(3, 1), P(1, 1), P(1, 3), P(0, 3)};
+    for (auto & p : shape)
+      p += origin;
+    return shape;
+  };
+
+  vector<P> const origins = {P(10, 20), P(30.5, 40.25), P(10, 20)};
+  vector<vector<P>> triangles;
+  for (auto const & origin : origins)
+  {
+    tesselator::TrianglesInfo info;
+    TEST_EQUAL(tesselator::TesselateInterior({makeShape(origin)}, info), 4, (origin));
+
+    triangles.emplace_back();
+    info.ForEachTriangle([&](P const & p1, P const & p2, P const & p3) {
+      for (auto const & p : {p1, p2, p3})
+        triangles.back().push_back(p - origin);
+    });
+  }
+
+  // Translated shapes have the same triangles.
+  TEST_EQUAL(triangles[0], triangles[1], ());
+  TEST_EQUAL(triangles[0], triangles[2], ());
+}
@@ -6,6 +6,7 @@
 #include "generator/check_model.hpp"
 #include "generator/cities_boundaries_builder.hpp"
 #include "generator/city_roads_generator.hpp"
+#include "generator/countries_scheduler.hpp"
 #include "generator/dumper.hpp"
 #include "generator/emitter_factory.hpp"
 #include "generator/feature_generator.hpp"
@@ -14,6 +15,7 @@
 #include "generator/geo_objects/geo_objects.hpp"
 #include "generator/locality_sorter.hpp"
 #include "generator/metalines_builder.hpp"
+#include "generator/osm_changes.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/popular_places_section_builder.hpp"
 #include "generator/regions/collector_region_info.hpp"
@@ -22,6 +24,8 @@
 #include "generator/road_access_generator.hpp"
 #include "generator/routing_index_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/speed_profiles_generator.hpp"
+#include "generator/stages_report.hpp"
 #include "generator/statistics.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
@@ -46,14 +50,22 @@
 #include "platform/platform.hpp"
 
 #include "coding/endianness.hpp"
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/transliteration.hpp"
 
+#include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <limits>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
 
 #include "defines.hpp"
 
@@ -72,6 +84,23 @@ char const * GetDataPathHelp()
       Platform::GetCurrentWorkingDirectory() + "/../../data'.";
   return kHelp.c_str();
 }
+
+// Returns the number of features of |datFile| or zero when it has no offsets table.
+uint64_t GetFeaturesCount(string const & datFile)
+{
+  try
+  {
+    FilesContainerR const cont(datFile);
+    if (!cont.IsExist(FEATURE_OFFSETS_FILE_TAG))
+      return 0;
+    return feature::FeaturesOffsetsTable::Load(cont)->size();
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read features count of", datFile, e.Msg()));
+    return 0;
+  }
+}
 }  // namespace
 
 // Coastlines.
@@ -82,27 +111,53 @@ DEFINE_bool(emit_coasts, false,
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
+DEFINE_string(osm_changes, "",
+              "OsmChange file with the changes since the intermediate data was generated. Only "
+              "the countries affected by the changes and the World are processed by the passes "
+              "after the 2nd one. The affected countries are found before --preprocess.");
+DEFINE_string(affected_countries_output, "",
+              "File to write the countries affected by --osm_changes to, one per line.");
 DEFINE_string(data_path, "", GetDataPathHelp());
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored nodes, ways, relations.");
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
+DEFINE_bool(columnar_ways_cache, false,
+            "Store ways cache in the columnar layout which is mapped instead of being loaded. "
+            "Must be the same for --preprocess and the next passes.");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, "
+              "sparse.");
 DEFINE_uint64(planet_version, base::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
 // Preprocessing and feature generator.
 DEFINE_bool(preprocess, false, "1st pass - create nodes/ways/relations data.");
 DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features.");
+DEFINE_uint64(generate_features_threads_count, 1,
+              "Number of threads translating OSM elements to features in the 2nd pass, "
+              "0 is the number of cores. The result doesn't depend on the number of threads.");
 DEFINE_bool(generate_region_features, false,
             "Generate intermediate features for regions to use in regions index and borders generation.");
 DEFINE_bool(generate_geo_objects_features, false,
             "Generate intermediate features for geo objects to use in geo objects index.");
 DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
+DEFINE_bool(fixed_width_geometry, false,
+            "Write outer geometry and triangles in the fixed width layout which is faster to "
+            "decode but larger. Only the readers which know the layout may read such mwms.");
+DEFINE_bool(progressive_geometry, false,
+            "Write outer paths of coarser scales as indexes of points of the best path instead of "
+            "separate simplified paths. Only the readers which know the layout may read such "
+            "mwms. Conflicts with --fixed_width_geometry.");
+DEFINE_bool(fixed_width_centers, false,
+            "Write the centers table in the fixed width format with O(1) access to centers. "
+            "Only the readers which know the format may read such mwms.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
+DEFINE_uint64(countries_threads_count, 1,
+              "Number of countries whose geometry and index are generated at once in the 3rd and "
+              "4th passes, 0 is the number of cores.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
 DEFINE_bool(generate_geo_objects_index, false,
             "Generate objects and index for server-side reverse geocoder.");
@@ -110,6 +165,9 @@ DEFINE_bool(generate_regions, false,
             "Generate regions index and borders for server-side reverse geocoder.");
 DEFINE_bool(generate_regions_kv, false,
             "Generate regions key-value for server-side reverse geocoder.");
+DEFINE_uint64(locality_index_threads_count, 0,
+              "Number of threads covering objects for geo objects and regions indexes, "
+              "0 is the number of cores.");
 
 DEFINE_bool(dump_cities_boundaries, false, "Dump cities boundaries to a file");
 DEFINE_bool(generate_cities_boundaries, false, "Generate cities boundaries section");
@@ -124,9 +182,17 @@ DEFINE_string(nodes_list_path, "",
 
 // Routing.
 DEFINE_bool(make_routing_index, false, "Make sections with the routing information.");
+DEFINE_bool(make_mapped_routing_index, false,
+            "Make section with the routing graphs which are used in place without decoding.");
 DEFINE_bool(make_cross_mwm, false,
             "Make section for cross mwm routing (for dynamic indexed routing).");
 DEFINE_bool(make_transit_cross_mwm, false, "Make section for cross mwm transit routing.");
+DEFINE_bool(make_routing_landmarks, false,
+            "Make section with landmarks for ALT heuristic of car routing inside mwm.");
+DEFINE_uint64(routing_landmarks_count, 4, "Number of landmarks in section with landmarks.");
+DEFINE_string(speed_profiles_path, "",
+              "Path to csv file with speed profiles of road segments. If set, generates a section "
+              "with time-dependent speeds of roads.");
 DEFINE_bool(disable_cross_mwm_progress, false,
             "Disable log of cross mwm section building progress.");
 DEFINE_string(srtm_path, "",
@@ -181,6 +247,9 @@ DEFINE_string(regions_features, "", "Input tmp.mwm file with regions.");
 
 // Common.
 DEFINE_bool(verbose, false, "Provide more detailed output.");
+DEFINE_bool(stages_report, false,
+            "Append wall and CPU time, peak RSS and I/O of every pass and section builder "
+            "to <data_path>/<output>.stages.jsonl.");
 
 using namespace generator;
 
@@ -226,6 +295,9 @@ int main(int argc, char ** argv)
   genInfo.m_osmFileName = FLAGS_osm_file_name;
   genInfo.m_failOnCoasts = FLAGS_fail_on_coasts;
   genInfo.m_preloadCache = FLAGS_preload_cache;
+  genInfo.m_columnarWaysCache = FLAGS_columnar_ways_cache;
+  genInfo.m_fixedWidthGeometry = FLAGS_fixed_width_geometry;
+  genInfo.m_progressiveGeometry = FLAGS_progressive_geometry;
   genInfo.m_bookingDatafileName = FLAGS_booking_data;
   genInfo.m_opentableDatafileName = FLAGS_opentable_data;
   genInfo.m_viatorDatafileName = FLAGS_viator_data;
@@ -233,15 +305,37 @@ int main(int argc, char ** argv)
   genInfo.m_boundariesTable = make_shared<generator::OsmIdToBoundariesTable>();
 
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
+  genInfo.m_featuresThreadsCount =
+      FLAGS_generate_features_threads_count != 0
+          ? static_cast<size_t>(FLAGS_generate_features_threads_count)
+          : max(thread::hardware_concurrency(), 1U);
 
   if (!FLAGS_node_storage.empty())
     genInfo.SetNodeStorageType(FLAGS_node_storage);
   if (!FLAGS_osm_file_type.empty())
     genInfo.SetOsmFileType(FLAGS_osm_file_type);
 
+  StagesReport report;
+
+  // The intermediate data before the changes is needed to find the old positions.
+  set<string> affectedCountries;
+  if (!FLAGS_osm_changes.empty())
+  {
+    StagesReport::ScopedStage stage(report, "find_affected_countries");
+    affectedCountries = generator::FindAffectedCountries(genInfo, FLAGS_osm_changes);
+    if (!FLAGS_affected_countries_output.empty())
+    {
+      ofstream output(FLAGS_affected_countries_output);
+      for (auto const & country : affectedCountries)
+        output << country << endl;
+      CHECK(output, ("Error writing", FLAGS_affected_countries_output));
+    }
+  }
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
+    StagesReport::ScopedStage stage(report, "preprocess");
     LOG(LINFO, ("Generating intermediate data ...."));
     if (!GenerateIntermediateData(genInfo))
     {
@@ -259,7 +353,8 @@ int main(int argc, char ** argv)
       FLAGS_calc_statistics || FLAGS_type_statistics || FLAGS_dump_types || FLAGS_dump_prefixes ||
       FLAGS_dump_feature_names != "" || FLAGS_check_mwm || FLAGS_srtm_path != "" ||
       FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
-      FLAGS_make_city_roads || FLAGS_generate_traffic_keys || FLAGS_transit_path != "" ||
+      FLAGS_make_mapped_routing_index ||
+      FLAGS_make_routing_landmarks || FLAGS_make_city_roads || FLAGS_generate_traffic_keys || FLAGS_transit_path != "" ||
       FLAGS_ugc_data != "" || FLAGS_popular_places_data != "" || FLAGS_generate_geo_objects_features ||
       FLAGS_geo_objects_key_value != "")
   {
@@ -268,12 +363,16 @@ int main(int argc, char ** argv)
 
   // Load mwm tree only if we need it
   unique_ptr<storage::CountryParentGetter> countryParentGetter;
-  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm)
+  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
+      FLAGS_make_routing_landmarks)
+  {
     countryParentGetter = make_unique<storage::CountryParentGetter>();
+  }
 
   // Generate dat file.
   if (FLAGS_generate_features || FLAGS_make_coasts)
   {
+    StagesReport::ScopedStage stage(report, "generate_features");
     LOG(LINFO, ("Generating final data ..."));
     CHECK(!FLAGS_generate_region_features, ("FLAGS_generate_features and FLAGS_make_coasts should "
                                             "not be used with FLAGS_generate_region_features"));
@@ -317,12 +416,14 @@ int main(int argc, char ** argv)
     genInfo.m_fileName = FLAGS_output;
     if (FLAGS_generate_region_features)
     {
+      StagesReport::ScopedStage stage(report, "generate_region_features");
       if (!GenerateRegionFeatures(genInfo))
         return -1;
     }
 
     if (FLAGS_generate_geo_objects_features)
     {
+      StagesReport::ScopedStage stage(report, "generate_geo_objects_features");
       if (!GenerateGeoObjectsFeatures(genInfo))
         return -1;
     }
@@ -330,6 +431,7 @@ int main(int argc, char ** argv)
 
   if (!FLAGS_geo_objects_key_value.empty())
   {
+    StagesReport::ScopedStage stage(report, "generate_geo_objects");
     if (!geo_objects::GenerateGeoObjects(FLAGS_regions_index, FLAGS_regions_key_value,
                                          FLAGS_geo_objects_features, FLAGS_ids_without_addresses,
                                          FLAGS_geo_objects_key_value, FLAGS_verbose))
@@ -349,8 +451,13 @@ int main(int argc, char ** argv)
 
     auto const locDataFile = base::JoinPath(path, FLAGS_output + LOC_DATA_FILE_EXTENSION);
     auto const outFile = base::JoinPath(path, FLAGS_output + LOC_IDX_FILE_EXTENSION);
+    size_t const localityThreadsCount =
+        FLAGS_locality_index_threads_count != 0
+            ? static_cast<size_t>(FLAGS_locality_index_threads_count)
+            : max(thread::hardware_concurrency(), 1U);
     if (FLAGS_generate_geo_objects_index)
     {
+      StagesReport::ScopedStage stage(report, "generate_geo_objects_index");
       if (!feature::GenerateGeoObjectsData(FLAGS_geo_objects_features, FLAGS_nodes_list_path, locDataFile))
       {
         LOG(LCRITICAL, ("Error generating geo objects data."));
@@ -359,7 +466,7 @@ int main(int argc, char ** argv)
 
       LOG(LINFO, ("Saving geo objects index to", outFile));
 
-      if (!indexer::BuildGeoObjectsIndexFromDataFile(locDataFile, outFile))
+      if (!indexer::BuildGeoObjectsIndexFromDataFile(locDataFile, outFile, localityThreadsCount))
       {
         LOG(LCRITICAL, ("Error generating geo objects index."));
         return -1;
@@ -368,6 +475,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_regions)
     {
+      StagesReport::ScopedStage stage(report, "generate_regions");
       if (!feature::GenerateRegionsData(FLAGS_regions_features, locDataFile))
       {
         LOG(LCRITICAL, ("Error generating regions data."));
@@ -376,7 +484,7 @@ int main(int argc, char ** argv)
 
       LOG(LINFO, ("Saving regions index to", outFile));
 
-      if (!indexer::BuildRegionsIndexFromDataFile(locDataFile, outFile))
+      if (!indexer::BuildRegionsIndexFromDataFile(locDataFile, outFile, localityThreadsCount))
       {
         LOG(LCRITICAL, ("Error generating regions index."));
         return -1;
@@ -391,6 +499,7 @@ int main(int argc, char ** argv)
 
   if (FLAGS_generate_regions_kv)
   {
+    StagesReport::ScopedStage stage(report, "generate_regions_kv");
     CHECK(FLAGS_generate_region_features, ("Option --generate_regions_kv can be used only "
                                            "together with option --generate_region_features."));
     auto const pathInRegionsCollector = genInfo.GetTmpFileName(genInfo.m_fileName,
@@ -406,54 +515,104 @@ int main(int argc, char ** argv)
     }
   }
 
-  // Enumerate over all dat files that were created.
-  size_t const count = genInfo.m_bucketNames.size();
-  for (size_t i = 0; i < count; ++i)
+  if (!FLAGS_osm_changes.empty())
   {
-    string const & country = genInfo.m_bucketNames[i];
-    string const datFile = base::JoinPath(path, country + DATA_FILE_EXTENSION);
-    string const osmToFeatureFilename =
-        genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
-
-    if (FLAGS_generate_geometry)
-    {
-      int mapType = feature::DataHeader::country;
-      if (country == WORLD_FILE_NAME)
-        mapType = feature::DataHeader::world;
-      if (country == WORLD_COASTS_FILE_NAME)
-        mapType = feature::DataHeader::worldcoasts;
-
-      // On error move to the next bucket without index generation.
-
-      LOG(LINFO, ("Generating result features for", country));
-      if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
-        continue;
+    base::EraseIf(genInfo.m_bucketNames, [&affectedCountries](string const & bucket) {
+      return bucket != WORLD_FILE_NAME && bucket != WORLD_COASTS_FILE_NAME &&
+             affectedCountries.count(bucket) == 0;
+    });
+    LOG(LINFO, ("Buckets to regenerate:", genInfo.m_bucketNames));
+  }
 
-      LOG(LINFO, ("Generating offsets table for", datFile));
-      if (!feature::BuildOffsetsTable(datFile))
-        continue;
+  // Geometry and index of the buckets don't depend on each other, so they are generated
+  // for several buckets at once.
+  vector<bool> built(genInfo.m_bucketNames.size(), true);
+  if (FLAGS_generate_geometry || FLAGS_generate_index)
+  {
+    size_t const countriesThreadsCount =
+        FLAGS_countries_threads_count != 0
+            ? static_cast<size_t>(FLAGS_countries_threads_count)
+            : max(thread::hardware_concurrency(), 1U);
+
+    // Bigger buckets take more time, the tmp file isn't available when only the index is built.
+    auto const getWeight = [&](string const & country) {
+      uint64_t size = 0;
+      if (!GetPlatform().GetFileSizeByFullPath(genInfo.GetTmpFileName(country), size))
+        GetPlatform().GetFileSizeByFullPath(base::JoinPath(path, country + DATA_FILE_EXTENSION),
+                                            size);
+      return size;
+    };
+
+    auto const buildGeometryAndIndex = [&](string const & country) {
+      string const datFile = base::JoinPath(path, country + DATA_FILE_EXTENSION);
+      string const osmToFeatureFilename =
+          genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
+
+      if (FLAGS_generate_geometry)
+      {
+        StagesReport::ScopedStage stage(report, "geometry", country);
+        int mapType = feature::DataHeader::country;
+        if (country == WORLD_FILE_NAME)
+          mapType = feature::DataHeader::world;
+        if (country == WORLD_COASTS_FILE_NAME)
+          mapType = feature::DataHeader::worldcoasts;
+
+        // On error move to the next bucket without index generation.
+        LOG(LINFO, ("Generating result features for", country));
+        if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
+          return false;
+
+        LOG(LINFO, ("Generating offsets table for", datFile));
+        if (!feature::BuildOffsetsTable(datFile))
+          return false;
+
+        if (FLAGS_stages_report)
+          stage.SetItemsCount(GetFeaturesCount(datFile));
+
+        if (mapType == feature::DataHeader::country)
+        {
+          string const metalinesFilename =
+              genInfo.GetIntermediateFileName(METALINES_FILENAME);
+
+          LOG(LINFO, ("Processing metalines from", metalinesFilename));
+          if (!feature::WriteMetalinesSection(datFile, metalinesFilename, osmToFeatureFilename))
+            LOG(LCRITICAL, ("Error generating metalines section."));
+        }
+      }
 
-      if (mapType == feature::DataHeader::country)
+      if (FLAGS_generate_index)
       {
-        string const metalinesFilename =
-            genInfo.GetIntermediateFileName(METALINES_FILENAME);
+        StagesReport::ScopedStage stage(report, "index", country,
+                                        FLAGS_stages_report ? GetFeaturesCount(datFile) : 0);
+        LOG(LINFO, ("Generating index for", datFile));
 
-        LOG(LINFO, ("Processing metalines from", metalinesFilename));
-        if (!feature::WriteMetalinesSection(datFile, metalinesFilename, osmToFeatureFilename))
-          LOG(LCRITICAL, ("Error generating metalines section."));
+        if (!indexer::BuildIndexFromDataFile(datFile, FLAGS_intermediate_data_path + country))
+          LOG(LCRITICAL, ("Error generating index."));
       }
-    }
 
-    if (FLAGS_generate_index)
-    {
-      LOG(LINFO, ("Generating index for", datFile));
+      return true;
+    };
 
-      if (!indexer::BuildIndexFromDataFile(datFile, FLAGS_intermediate_data_path + country))
-        LOG(LCRITICAL, ("Error generating index."));
-    }
+    built = generator::ForEachCountryInParallel(genInfo.m_bucketNames, getWeight,
+                                                buildGeometryAndIndex, countriesThreadsCount);
+  }
+
+  // Enumerate over all dat files that were created.
+  size_t const count = genInfo.m_bucketNames.size();
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!built[i])
+      continue;
+
+    string const & country = genInfo.m_bucketNames[i];
+    string const datFile = base::JoinPath(path, country + DATA_FILE_EXTENSION);
+    string const osmToFeatureFilename =
+        genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
+    uint64_t const featuresCount = FLAGS_stages_report ? GetFeaturesCount(datFile) : 0;
 
     if (FLAGS_generate_search_index)
     {
+      StagesReport::ScopedStage stage(report, "search_index", country, featuresCount);
       LOG(LINFO, ("Generating search index for", datFile));
 
       /// @todo Make threads count according to environment (single mwm build or planet build).
@@ -466,12 +625,14 @@ int main(int argc, char ** argv)
         LOG(LCRITICAL, ("Error generating rank table."));
 
       LOG(LINFO, ("Generating centers table for", datFile));
-      if (!indexer::BuildCentersTableFromDataFile(datFile, true /* forceRebuild */))
+      if (!indexer::BuildCentersTableFromDataFile(datFile, true /* forceRebuild */,
+                                                  FLAGS_fixed_width_centers))
         LOG(LCRITICAL, ("Error generating centers table."));
     }
 
     if (FLAGS_generate_cities_boundaries)
     {
+      StagesReport::ScopedStage stage(report, "cities_boundaries", country, featuresCount);
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
       LOG(LINFO, ("Generating cities boundaries for", datFile));
       generator::OsmIdToBoundariesTable table;
@@ -482,13 +643,20 @@ int main(int argc, char ** argv)
     }
 
     if (!FLAGS_srtm_path.empty())
+    {
+      StagesReport::ScopedStage stage(report, "altitudes", country, featuresCount);
       routing::BuildRoadAltitudes(datFile, FLAGS_srtm_path);
+    }
 
     if (!FLAGS_transit_path.empty())
+    {
+      StagesReport::ScopedStage stage(report, "transit", country, featuresCount);
       routing::transit::BuildTransit(path, country, osmToFeatureFilename, FLAGS_transit_path);
+    }
 
     if (FLAGS_generate_cameras)
     {
+      StagesReport::ScopedStage stage(report, "cameras", country, featuresCount);
       string const camerasFilename =
           genInfo.GetIntermediateFileName(CAMERAS_TO_WAYS_FILENAME);
 
@@ -505,6 +673,7 @@ int main(int argc, char ** argv)
         return -1;
       }
 
+      StagesReport::ScopedStage stage(report, "routing_index", country, featuresCount);
       string const restrictionsFilename =
           genInfo.GetIntermediateFileName(RESTRICTIONS_FILENAME);
       string const roadAccessFilename =
@@ -515,8 +684,22 @@ int main(int argc, char ** argv)
       routing::BuildRoutingIndex(datFile, country, *countryParentGetter);
     }
 
+    if (FLAGS_make_mapped_routing_index)
+    {
+      StagesReport::ScopedStage stage(report, "mapped_routing_index", country, featuresCount);
+      routing::BuildMappedRoutingIndex(datFile);
+    }
+
+    if (!FLAGS_speed_profiles_path.empty())
+    {
+      StagesReport::ScopedStage stage(report, "speed_profiles", country, featuresCount);
+      if (!routing::BuildSpeedProfiles(datFile, FLAGS_speed_profiles_path, osmToFeatureFilename))
+        LOG(LCRITICAL, ("Generating speed profiles error."));
+    }
+
     if (FLAGS_make_city_roads)
     {
+      StagesReport::ScopedStage stage(report, "city_roads", country, featuresCount);
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
       LOG(LINFO, ("Generating cities boundaries roads for", datFile));
       generator::OsmIdToBoundariesTable table;
@@ -538,16 +721,41 @@ int main(int argc, char ** argv)
 
       if (FLAGS_make_cross_mwm)
       {
+        StagesReport::ScopedStage stage(report, "cross_mwm", country, featuresCount);
         routing::BuildRoutingCrossMwmSection(path, datFile, country, *countryParentGetter,
                                              osmToFeatureFilename, FLAGS_disable_cross_mwm_progress);
       }
 
       if (FLAGS_make_transit_cross_mwm)
+      {
+        StagesReport::ScopedStage stage(report, "transit_cross_mwm", country, featuresCount);
         routing::BuildTransitCrossMwmSection(path, datFile, country, *countryParentGetter);
+      }
+    }
+
+    if (FLAGS_make_routing_landmarks)
+    {
+      if (!countryParentGetter)
+      {
+        // All the mwms should use proper VehicleModels.
+        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
+                        "countries_obsolete.txt). File must be located in data directory."));
+        return -1;
+      }
+
+      StagesReport::ScopedStage stage(report, "routing_landmarks", country, featuresCount);
+      CHECK_LESS_OR_EQUAL(FLAGS_routing_landmarks_count, numeric_limits<uint16_t>::max(), ());
+      if (!routing::BuildRoutingLandmarksSection(
+              path, datFile, country, *countryParentGetter,
+              static_cast<uint16_t>(FLAGS_routing_landmarks_count)))
+      {
+        LOG(LCRITICAL, ("Generating routing landmarks error."));
+      }
     }
 
     if (!FLAGS_ugc_data.empty())
     {
+      StagesReport::ScopedStage stage(report, "ugc", country, featuresCount);
       if (!BuildUgcMwmSection(FLAGS_ugc_data, datFile, osmToFeatureFilename))
       {
         LOG(LCRITICAL, ("Error generating UGC mwm section."));
@@ -556,6 +764,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_popular_places)
     {
+      StagesReport::ScopedStage stage(report, "popular_places", country, featuresCount);
       if (!BuildPopularPlacesMwmSection(genInfo.m_popularPlacesFilename, datFile,
                                         osmToFeatureFilename))
       {
@@ -565,11 +774,18 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_traffic_keys)
     {
+      StagesReport::ScopedStage stage(report, "traffic_keys", country, featuresCount);
       if (!traffic::GenerateTrafficKeysFromDataFile(datFile))
         LOG(LCRITICAL, ("Error generating traffic keys."));
     }
   }
 
+  if (FLAGS_stages_report)
+  {
+    string const name = FLAGS_output.empty() ? "generator" : FLAGS_output;
+    report.Append(base::JoinPath(path, name + ".stages.jsonl"));
+  }
+
   string const datFile = base::JoinPath(path, FLAGS_output + DATA_FILE_EXTENSION);
 
   if (FLAGS_calc_statistics)
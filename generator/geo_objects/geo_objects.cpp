@@ -1,6 +1,7 @@
 #include "generator/geo_objects/geo_objects.hpp"
 
 #include "generator/feature_builder.hpp"
+#include "generator/geo_objects/key_value_shards.hpp"
 #include "generator/locality_sorter.hpp"
 #include "generator/regions/region_base.hpp"
 
@@ -9,46 +10,44 @@
 #include "indexer/locality_index.hpp"
 #include "indexer/locality_index_builder.hpp"
 
+#include "coding/file_reader.hpp"
 #include "coding/mmap_reader.hpp"
+#include "coding/varint.hpp"
 
 #include "base/geo_object_id.hpp"
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
+#include "base/scope_guard.hpp"
+#include "base/task_scheduler.hpp"
 #include "base/timer.hpp"
 
 #include <cstdint>
 #include <fstream>
 #include <functional>
 #include <future>
+#include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "platform/platform.hpp"
 
 #include <boost/optional.hpp>
 #include "3party/jansson/myjansson.hpp"
 
+using generator::geo_objects::KeyValueShardsWriter;
+
 namespace
 {
-using KeyValue = std::pair<uint64_t, base::Json>;
+using KeyValue = std::pair<uint64_t, base::JSONPtr>;
 using IndexReader = ReaderPtr<Reader>;
+using RegionsIndex = indexer::RegionsIndex<IndexReader>;
+using GeoObjectsIndex = indexer::GeoObjectsIndex<IndexReader>;
 
-bool ParseKey(std::string const & line, int64_t & key)
-{
-  auto const pos = line.find(" ");
-  if (pos == std::string::npos)
-  {
-    LOG(LWARNING, ("Cannot find separator."));
-    return false;
-  }
-
-  if (!strings::to_int64(line.substr(0, pos), key))
-  {
-    LOG(LWARNING, ("Cannot parse id."));
-    return false;
-  }
-
-  return true;
-}
+// Features are read by batches, features of a batch are processed in parallel.
+size_t constexpr kFeaturesBatchSize = 1 << 14;
+// Every shard of the geo objects key-value storage is sorted in memory.
+size_t constexpr kGeoObjectsKvShardsCount = 256;
 
 bool ParseKeyValueLine(std::string const & line, KeyValue & res)
 {
@@ -66,37 +65,23 @@ bool ParseKeyValueLine(std::string const & line, KeyValue & res)
     return false;
   }
 
-  base::Json json;
-  try
+  json_error_t error;
+  base::JSONPtr json(json_loads(line.c_str() + pos + 1, 0, &error));
+  if (!json)
   {
-    json = base::Json(line.substr(pos + 1));
-    if (!json.get())
-      return false;
-  }
-  catch (base::Json::Exception const &)
-  {
-    LOG(LWARNING, ("Cannot create base::Json."));
+    LOG(LWARNING, ("Cannot create json:", error.text));
     return false;
   }
 
-  res = std::make_pair(static_cast<uint64_t>(id), json);
+  res = std::make_pair(static_cast<uint64_t>(id), std::move(json));
   return true;
 }
 
-// An interface for reading key-value storage.
-class KeyValueInterface
-{
-public:
-  virtual ~KeyValueInterface() = default;
-
-  virtual boost::optional<base::Json> Find(uint64_t key) const = 0;
-  virtual size_t Size() const = 0;
-};
-
-// An implementation for reading key-value storage with loading and searching in memory.
-class KeyValueMem : public KeyValueInterface
+// Key-value storage which is loaded into memory and may be read by several threads at once.
+class KeyValueMem
 {
 public:
+  KeyValueMem() = default;
   KeyValueMem(std::istream & stream, std::function<bool(KeyValue const &)> pred =
       [](KeyValue const &) { return true; })
   {
@@ -107,79 +92,78 @@ public:
       if (!ParseKeyValueLine(line, kv) || !pred(kv))
         continue;
 
-      m_map.insert(kv);
+      m_map.insert(std::move(kv));
     }
-
   }
 
-  // KeyValueInterface overrides:
-  boost::optional<base::Json> Find(uint64_t key) const override
+  void Insert(uint64_t key, base::JSONPtr && value) { m_map.emplace(key, std::move(value)); }
+
+  // Values are borrowed: they aren't copied and their reference counters aren't changed,
+  // because the counters of jansson aren't atomic. Returns nullptr when there is no |key|.
+  json_t * Find(uint64_t key) const
   {
-    boost::optional<base::Json> result;
     auto const it = m_map.find(key);
-    if (it != std::end(m_map))
-      result = it->second;
-
-    return result;
+    return it != std::end(m_map) ? it->second.get() : nullptr;
   }
 
-  size_t Size() const override { return m_map.size(); }
+  size_t Size() const { return m_map.size(); }
 
 private:
-  std::unordered_map<uint64_t, base::Json> m_map;
+  std::unordered_map<uint64_t, base::JSONPtr> m_map;
 };
 
-// An implementation for reading key-value storage with loading and searching in disk.
-class KeyValueMap : public KeyValueInterface
+// Geo object which is made on a worker thread and is written by the calling one.
+struct GeoObject
 {
-public:
-  KeyValueMap(std::istream & stream) : m_stream(stream)
-  {
-    std::string line;
-    std::istream::pos_type pos = 0;
-    KeyValue kv;
-    while (std::getline(m_stream, line))
-    {
-      int64_t key;
-      if (!ParseKey(line, key))
-        continue;
+  uint64_t m_id = 0;
+  base::JSONPtr m_json;
+  std::unique_ptr<char, JSONFreeDeleter> m_value;
+};
 
-      m_map.emplace(key, pos);
-      pos = m_stream.tellg();
-    }
+// Reads features of |path| by batches and calls |process(fb, chunk)| for features of a batch
+// on several threads. Every thread gets its own |chunk| in [0, chunksCount), so per-chunk
+// readers need no locks. Then |consume(result)| is called for the results of the batch in
+// the order of the features on the calling thread.
+template <typename Result, typename Process, typename Consume>
+void ForEachFeatureInParallel(std::string const & path, size_t chunksCount, Process && process,
+                              Consume && consume)
+{
+  std::vector<FeatureBuilder1::Buffer> batch;
+  std::vector<Result> results;
+  auto const processBatch = [&]() {
+    results.clear();
+    results.resize(batch.size());
+    base::parallel::RunChunks(chunksCount, [&](size_t chunk) {
+      size_t const to = batch.size() * (chunk + 1) / chunksCount;
+      for (size_t i = batch.size() * chunk / chunksCount; i < to; ++i)
+      {
+        FeatureBuilder1 fb;
+        fb.Deserialize(batch[i]);
+        results[i] = process(fb, chunk);
+      }
+    }, base::TaskScheduler::Instance());
 
-    m_stream.clear();
-  }
+    for (auto & result : results)
+      consume(result);
+    batch.clear();
+  };
 
-  // KeyValueInterface overrides:
-  boost::optional<base::Json> Find(uint64_t key) const override
+  FileReader reader(path);
+  ReaderSource<FileReader> src(reader);
+  while (src.Size() > 0)
   {
-    boost::optional<base::Json> result;
-    auto const it = m_map.find(key);
-    if (it == std::end(m_map))
-      return result;
-
-    m_stream.seekg(it->second);
-    std::string line;
-    if (!std::getline(m_stream, line))
-    {
-      LOG(LERROR, ("Cannot read line."));
-      return result;
-    }
-
-    KeyValue kv;
-    if (ParseKeyValueLine(line, kv))
-      result = kv.second;
-
-    return result;
+    auto const size = ReadVarUint<uint32_t>(src);
+    batch.emplace_back(size);
+    src.Read(batch.back().data(), size);
+    if (batch.size() == kFeaturesBatchSize)
+      processBatch();
   }
 
-  size_t Size() const override { return m_map.size(); }
+  if (!batch.empty())
+    processBatch();
+}
 
-private:
-  std::istream & m_stream;
-  std::unordered_map<uint64_t, std::istream::pos_type> m_map;
-};
+size_t GetChunksCount() { return base::TaskScheduler::Instance().GetWorkersCount() + 1; }
 
 bool IsBuilding(FeatureBuilder1 const & fb)
 {
@@ -192,9 +176,9 @@ bool HasHouse(FeatureBuilder1 const & fb)
   return !fb.GetParams().house.IsEmpty();
 }
 
-bool HouseHasAddress(base::Json json)
+bool HouseHasAddress(json_t * json)
 {
-  auto properties = json_object_get(json.get(), "properties");
+  auto properties = json_object_get(json, "properties");
   auto address = json_object_get(properties, "address");
   std::string const kHouseField = "building";
   char const * key = nullptr;
@@ -219,58 +203,47 @@ std::vector<base::GeoObjectId> SearchObjectsInIndex(FeatureBuilder1 const & fb,
   return ids;
 }
 
-int GetRankFromValue(base::Json json)
+int GetRankFromValue(json_t * json)
 {
   int rank;
-  auto properties = json_object_get(json.get(), "properties");
+  auto properties = json_object_get(json, "properties");
   FromJSONObject(properties, "rank", rank);
   return rank;
 }
 
-base::Json GetDeepestRegion(std::vector<base::GeoObjectId> const & ids,
-                            KeyValueInterface const & regionKv)
+json_t * GetDeepestRegion(std::vector<base::GeoObjectId> const & ids, KeyValueMem const & regionKv)
 {
-  base::Json deepest;
+  json_t * deepest = nullptr;
   int deepestRank = 0;
   for (auto const & id : ids)
   {
-    base::Json temp;
-    auto const res = regionKv.Find(id.GetEncodedId());
-    if (!res)
+    auto const temp = regionKv.Find(id.GetEncodedId());
+    if (!temp)
     {
       LOG(LWARNING, ("Id not found in region key-value storage:", id));
       continue;
     }
 
-    temp = *res;
-    if (!json_is_object(temp.get()))
+    if (!json_is_object(temp))
     {
       LOG(LWARNING, ("Value is not a json object in region key-value storage:", id));
       continue;
     }
 
-    if (!deepest.get())
+    int const tempRank = GetRankFromValue(temp);
+    if (!deepest || deepestRank < tempRank)
     {
-      deepestRank = GetRankFromValue(temp);
       deepest = temp;
-    }
-    else
-    {
-      int tempRank = GetRankFromValue(temp);
-      if (deepestRank < tempRank)
-      {
-        deepest = temp;
-        deepestRank = tempRank;
-      }
+      deepestRank = tempRank;
     }
   }
 
   return deepest;
 }
 
-void UpdateCoordinates(m2::PointD const & point, base::Json json)
+void UpdateCoordinates(m2::PointD const & point, json_t * json)
 {
-  auto geometry = json_object_get(json.get(), "geometry");
+  auto geometry = json_object_get(json, "geometry");
   auto coordinates = json_object_get(geometry, "coordinates");
   if (json_array_size(coordinates) == 2)
   {
@@ -279,12 +252,12 @@ void UpdateCoordinates(m2::PointD const & point, base::Json json)
   }
 }
 
-base::Json AddAddress(FeatureBuilder1 const & fb, base::Json regionJson)
+base::JSONPtr AddAddress(FeatureBuilder1 const & fb, json_t * regionJson)
 {
-  base::Json result = regionJson.GetDeepCopy();
+  base::JSONPtr result(json_deep_copy(regionJson));
   int const kHouseOrPoiRank = 30;
-  ToJSONObject(*result.get(), "rank", kHouseOrPoiRank);
-  UpdateCoordinates(fb.GetLimitRect().Center(), result);
+  ToJSONObject(*result, "rank", kHouseOrPoiRank);
+  UpdateCoordinates(fb.GetLimitRect().Center(), result.get());
   auto properties = json_object_get(result.get(), "properties");
   auto address = json_object_get(properties, "address");
 
@@ -305,31 +278,24 @@ base::Json AddAddress(FeatureBuilder1 const & fb, base::Json regionJson)
   return result;
 }
 
-boost::optional<base::Json>
-FindRegion(FeatureBuilder1 const & fb, indexer::RegionsIndex<IndexReader> const & regionIndex,
-           KeyValueInterface const & regionKv)
+json_t * FindRegion(FeatureBuilder1 const & fb, RegionsIndex const & regionIndex,
+                    KeyValueMem const & regionKv)
 {
-  boost::optional<base::Json> result;
   auto const ids = SearchObjectsInIndex(fb, regionIndex);
-  auto const deepest = GetDeepestRegion(ids, regionKv);
-  if (deepest.get())
-    result = deepest;
-
-  return result;
+  return GetDeepestRegion(ids, regionKv);
 }
 
-std::unique_ptr<char, JSONFreeDeleter>
-MakeGeoObjectValueWithAddress(FeatureBuilder1 const & fb, base::Json json)
+GeoObject MakeGeoObjectWithAddress(FeatureBuilder1 const & fb, json_t * regionJson)
 {
-  auto const jsonWithAddress = AddAddress(fb, json);
-  auto const cstr = json_dumps(jsonWithAddress.get(), JSON_COMPACT);
-  return std::unique_ptr<char, JSONFreeDeleter>(cstr);
+  GeoObject geoObject;
+  geoObject.m_id = fb.GetMostGenericOsmId().GetEncodedId();
+  geoObject.m_json = AddAddress(fb, regionJson);
+  geoObject.m_value.reset(json_dumps(geoObject.m_json.get(), JSON_COMPACT));
+  return geoObject;
 }
 
-boost::optional<base::Json>
-FindHousePoi(FeatureBuilder1 const & fb,
-             indexer::GeoObjectsIndex<IndexReader> const & geoObjectsIndex,
-             KeyValueInterface const & geoObjectsKv)
+json_t * FindHousePoi(FeatureBuilder1 const & fb, GeoObjectsIndex const & geoObjectsIndex,
+                      KeyValueMem const & geoObjectsKv)
 {
   auto const ids = SearchObjectsInIndex(fb, geoObjectsIndex);
   for (auto const & id : ids)
@@ -338,7 +304,7 @@ FindHousePoi(FeatureBuilder1 const & fb,
     if (!house)
       continue;
 
-    auto properties = json_object_get(house->get(), "properties");
+    auto properties = json_object_get(house, "properties");
     auto address = json_object_get(properties, "address");
     std::string const kHouseField = "building";
     char const * key = nullptr;
@@ -350,68 +316,87 @@ FindHousePoi(FeatureBuilder1 const & fb,
     }
   }
 
-  return {};
+  return nullptr;
 }
 
-std::unique_ptr<char, JSONFreeDeleter>
-MakeGeoObjectValueWithoutAddress(FeatureBuilder1 const & fb, base::Json json)
+GeoObject MakeGeoObjectWithoutAddress(FeatureBuilder1 const & fb, json_t * houseJson)
 {
-  auto const jsonWithAddress = json.GetDeepCopy();
-  auto properties = json_object_get(jsonWithAddress.get(), "properties");
+  GeoObject geoObject;
+  geoObject.m_id = fb.GetMostGenericOsmId().GetEncodedId();
+  geoObject.m_json.reset(json_deep_copy(houseJson));
+  auto properties = json_object_get(geoObject.m_json.get(), "properties");
   ToJSONObject(*properties, "name", fb.GetName());
-  UpdateCoordinates(fb.GetLimitRect().Center(), jsonWithAddress);
-  auto const cstr = json_dumps(jsonWithAddress.get(), JSON_COMPACT);
-  return std::unique_ptr<char, JSONFreeDeleter>(cstr);
+  UpdateCoordinates(fb.GetLimitRect().Center(), geoObject.m_json.get());
+  geoObject.m_value.reset(json_dumps(geoObject.m_json.get(), JSON_COMPACT));
+  return geoObject;
 }
 
-boost::optional<indexer::GeoObjectsIndex<IndexReader>>
-MakeTempGeoObjectsIndex(std::string const & pathToGeoObjectsTmpMwm)
+bool BuildTempGeoObjectsIndex(std::string const & pathToGeoObjectsTmpMwm,
+                              std::string const & indexFile)
 {
-  boost::optional<indexer::GeoObjectsIndex<IndexReader>> result;
   auto const dataFile = Platform().TmpPathForFile();
   SCOPE_GUARD(removeDataFile, std::bind(Platform::RemoveFileIfExists, std::cref(dataFile)));
   if (!feature::GenerateGeoObjectsData(pathToGeoObjectsTmpMwm, "" /* nodesFile */, dataFile))
   {
     LOG(LCRITICAL, ("Error generating geo objects data."));
-    return result;
+    return false;
   }
 
-  auto const indexFile = Platform().TmpPathForFile();
-  SCOPE_GUARD(removeIndexFile, std::bind(Platform::RemoveFileIfExists, std::cref(indexFile)));
   if (!indexer::BuildGeoObjectsIndexFromDataFile(dataFile, indexFile))
   {
     LOG(LCRITICAL, ("Error generating geo objects index."));
-    return result;
+    return false;
   }
 
-  result = indexer::ReadIndex<indexer::GeoObjectsIndexBox<IndexReader>, MmapReader>(indexFile);
-  return result;
+  return true;
 }
 
-bool BuildGeoObjectsWithAddresses(indexer::RegionsIndex<IndexReader> const & regionIndex,
-                                  KeyValueInterface const & regionKv,
+// Every chunk of ForEachFeatureInParallel() reads the index with its own reader.
+template <typename IndexBox>
+std::vector<typename IndexBox::IndexType> ReadIndexes(std::string const & path, size_t count)
+{
+  std::vector<typename IndexBox::IndexType> indexes;
+  indexes.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    indexes.emplace_back(indexer::ReadIndex<IndexBox, MmapReader>(path));
+  return indexes;
+}
+
+bool BuildGeoObjectsWithAddresses(std::vector<RegionsIndex> const & regionIndexes,
+                                  KeyValueMem const & regionKv,
                                   std::string const & pathInGeoObjectsTmpMwm,
-                                  std::ostream & streamGeoObjectsKv, bool)
+                                  KeyValueShardsWriter & geoObjectsKvWriter,
+                                  KeyValueMem & geoObjectsKv, bool)
 {
   size_t countGeoObjects = 0;
-  auto const fn = [&](FeatureBuilder1 & fb, uint64_t /* currPos */)
-  {
+  auto const process = [&](FeatureBuilder1 const & fb, size_t chunk) {
+    boost::optional<GeoObject> result;
     if (!(IsBuilding(fb) || HasHouse(fb)))
-      return;
+      return result;
 
-    auto region = FindRegion(fb, regionIndex, regionKv);
+    auto const region = FindRegion(fb, regionIndexes[chunk], regionKv);
     if (!region)
+      return result;
+
+    result = MakeGeoObjectWithAddress(fb, region);
+    return result;
+  };
+
+  auto const consume = [&](boost::optional<GeoObject> & geoObject) {
+    if (!geoObject)
       return;
 
-    auto const value = MakeGeoObjectValueWithAddress(fb, *region);
-    streamGeoObjectsKv << static_cast<int64_t>(fb.GetMostGenericOsmId().GetEncodedId()) << " "
-                       << value.get() << "\n";
+    geoObjectsKvWriter.Add(geoObject->m_id, geoObject->m_value.get());
+    // Houses with addresses are kept to find addresses of POIs.
+    if (HouseHasAddress(geoObject->m_json.get()))
+      geoObjectsKv.Insert(geoObject->m_id, std::move(geoObject->m_json));
     ++countGeoObjects;
   };
 
   try
   {
-    feature::ForEachFromDatRawFormat(pathInGeoObjectsTmpMwm, fn);
+    ForEachFeatureInParallel<boost::optional<GeoObject>>(pathInGeoObjectsTmpMwm,
+                                                         regionIndexes.size(), process, consume);
     LOG(LINFO, ("Added ", countGeoObjects, "geo objects with addresses."));
   }
   catch (Reader::Exception const & e)
@@ -423,35 +408,39 @@ bool BuildGeoObjectsWithAddresses(indexer::RegionsIndex<IndexReader> const & reg
   return true;
 }
 
-bool BuildGeoObjectsWithoutAddresses(indexer::GeoObjectsIndex<IndexReader> const & geoObjectsIndex,
+bool BuildGeoObjectsWithoutAddresses(std::vector<GeoObjectsIndex> const & geoObjectsIndexes,
                                      std::string const & pathInGeoObjectsTmpMwm,
-                                     KeyValueInterface const & geoObjectsKv,
-                                     std::ostream & streamGeoObjectsKv,
+                                     KeyValueMem const & geoObjectsKv,
+                                     KeyValueShardsWriter & geoObjectsKvWriter,
                                      std::ostream & streamIdsWithoutAddress, bool)
 {
   size_t countGeoObjects = 0;
-  auto const fn  = [&](FeatureBuilder1 & fb, uint64_t /* currPos */)
-  {
+  auto const process = [&](FeatureBuilder1 const & fb, size_t chunk) {
+    boost::optional<GeoObject> result;
     if (IsBuilding(fb) || HasHouse(fb))
-      return;
+      return result;
 
-    auto const house = FindHousePoi(fb, geoObjectsIndex, geoObjectsKv);
-    if (!house)
-      return;
+    auto const house = FindHousePoi(fb, geoObjectsIndexes[chunk], geoObjectsKv);
+    if (!house || !HouseHasAddress(house))
+      return result;
 
-    if (!HouseHasAddress(*house))
+    result = MakeGeoObjectWithoutAddress(fb, house);
+    return result;
+  };
+
+  auto const consume = [&](boost::optional<GeoObject> & geoObject) {
+    if (!geoObject)
       return;
 
-    auto const value = MakeGeoObjectValueWithoutAddress(fb, *house);
-    auto const id = static_cast<int64_t>(fb.GetMostGenericOsmId().GetEncodedId());
-    streamGeoObjectsKv << id << " " << value.get() << "\n";
-    streamIdsWithoutAddress << id << "\n";
+    geoObjectsKvWriter.Add(geoObject->m_id, geoObject->m_value.get());
+    streamIdsWithoutAddress << static_cast<int64_t>(geoObject->m_id) << "\n";
     ++countGeoObjects;
   };
 
   try
   {
-    feature::ForEachFromDatRawFormat(pathInGeoObjectsTmpMwm, fn);
+    ForEachFeatureInParallel<boost::optional<GeoObject>>(
+        pathInGeoObjectsTmpMwm, geoObjectsIndexes.size(), process, consume);
     LOG(LINFO, ("Added ", countGeoObjects, "geo objects without addresses."));
   }
   catch (Reader::Exception const & e)
@@ -480,41 +469,47 @@ bool GenerateGeoObjects(std::string const & pathInRegionsIndx,
     LOG(LINFO, ("Finish generating geo objects.", timer.ElapsedSeconds(), "seconds."));
   });
 
-  auto geoObjectIndexFuture = std::async(std::launch::async, MakeTempGeoObjectsIndex,
-                                         pathInGeoObjectsTmpMwm);
-  auto const regionIndex =
-      indexer::ReadIndex<indexer::RegionsIndexBox<IndexReader>, MmapReader>(pathInRegionsIndx);
+  auto const geoObjectsIndexFile = Platform().TmpPathForFile();
+  SCOPE_GUARD(removeGeoObjectsIndexFile, std::bind(Platform::RemoveFileIfExists,
+                                                   std::cref(geoObjectsIndexFile)));
+  auto geoObjectsIndexFuture = std::async(std::launch::async, BuildTempGeoObjectsIndex,
+                                          pathInGeoObjectsTmpMwm, geoObjectsIndexFile);
+  auto const chunksCount = GetChunksCount();
+  auto const regionIndexes =
+      ReadIndexes<indexer::RegionsIndexBox<IndexReader>>(pathInRegionsIndx, chunksCount);
   // Regions key-value storage is small (~150 Mb). We will load everything into memory.
   std::fstream streamRegionKv(pathInRegionsKv);
   KeyValueMem const regionsKv(streamRegionKv);
   LOG(LINFO, ("Size of regions key-value storage:", regionsKv.Size()));
   std::ofstream streamIdsWithoutAddress(pathOutIdsWithoutAddress);
-  std::ofstream streamGeoObjectsKv(pathOutGeoObjectsKv);
-  if (!BuildGeoObjectsWithAddresses(regionIndex, regionsKv, pathInGeoObjectsTmpMwm,
-                                    streamGeoObjectsKv, verbose))
+  // Geo objects key-value storage is big (~80 Gb), it is written by shards.
+  KeyValueShardsWriter geoObjectsKvWriter(pathOutGeoObjectsKv, kGeoObjectsKvShardsCount);
+  // Only houses with addresses are kept in memory.
+  KeyValueMem geoObjectsKv;
+  if (!BuildGeoObjectsWithAddresses(regionIndexes, regionsKv, pathInGeoObjectsTmpMwm,
+                                    geoObjectsKvWriter, geoObjectsKv, verbose))
   {
     return false;
   }
 
   LOG(LINFO, ("Geo objects with addresses were built."));
-  // Regions key-value storage is big (~80 Gb). We will not load the key value into memory.
-  // This can be slow.
-  // todo(maksimandrianov1): Investigate the issue of performance and if necessary improve.
-  std::ifstream tempStream(pathOutGeoObjectsKv);
-  auto const pred = [](KeyValue const & kv) { return HouseHasAddress(kv.second); };
-  KeyValueMem const geoObjectsKv(tempStream, pred);
   LOG(LINFO, ("Size of geo objects key-value storage:", geoObjectsKv.Size()));
-  auto const geoObjectIndex = geoObjectIndexFuture.get();
+  if (!geoObjectsIndexFuture.get())
+    return false;
+
+  auto const geoObjectsIndexes =
+      ReadIndexes<indexer::GeoObjectsIndexBox<IndexReader>>(geoObjectsIndexFile, chunksCount);
   LOG(LINFO, ("Index was built."));
-  if (!geoObjectIndex ||
-      !BuildGeoObjectsWithoutAddresses(*geoObjectIndex, pathInGeoObjectsTmpMwm, geoObjectsKv,
-                                       streamGeoObjectsKv, streamIdsWithoutAddress, verbose))
+  if (!BuildGeoObjectsWithoutAddresses(geoObjectsIndexes, pathInGeoObjectsTmpMwm, geoObjectsKv,
+                                       geoObjectsKvWriter, streamIdsWithoutAddress, verbose))
   {
     return false;
   }
 
+  geoObjectsKvWriter.Finish();
   LOG(LINFO, ("Geo objects without addresses were built."));
-  LOG(LINFO, ("Geo objects key-value storage saved to",  pathOutGeoObjectsKv));
+  LOG(LINFO, ("Geo objects key-value storage saved to", pathOutGeoObjectsKv, "with index",
+              KeyValueShardsWriter::GetIndexPath(pathOutGeoObjectsKv)));
   LOG(LINFO, ("Ids of POIs without addresses saved to", pathOutIdsWithoutAddress));
   return true;
 }
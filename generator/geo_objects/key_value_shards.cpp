@@ -0,0 +1,243 @@
+#include "generator/geo_objects/key_value_shards.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/parallel.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace generator
+{
+namespace geo_objects
+{
+namespace
+{
+// Size of the index header without shards.
+uint64_t constexpr kHeaderSize = 2 * sizeof(uint32_t);
+uint64_t constexpr kShardHeaderSize = 3 * sizeof(uint64_t);
+uint64_t constexpr kRecordSize = 2 * sizeof(uint64_t);
+
+struct Line
+{
+  uint64_t m_key;
+  size_t m_begin;
+  size_t m_size;
+};
+
+// Returns the lines of the shard |data| sorted by keys, lines with equal keys keep their order.
+std::vector<Line> SortLines(std::string const & data)
+{
+  std::vector<Line> lines;
+  size_t begin = 0;
+  while (begin < data.size())
+  {
+    auto const end = data.find('\n', begin);
+    CHECK_NOT_EQUAL(end, std::string::npos, ());
+
+    // Keys are written by the writer itself, so they are always valid.
+    auto const key = static_cast<uint64_t>(std::strtoll(data.data() + begin, nullptr, 10));
+    lines.push_back({key, begin, end + 1 - begin});
+    begin = end + 1;
+  }
+
+  std::stable_sort(lines.begin(), lines.end(),
+                   [](Line const & l, Line const & r) { return l.m_key < r.m_key; });
+  return lines;
+}
+}  // namespace
+
+// static
+uint32_t constexpr KeyValueShardsIndex::kVersion;
+
+KeyValueShardsWriter::KeyValueShardsWriter(std::string const & path, size_t shardsCount)
+  : m_path(path), m_shards(shardsCount)
+{
+  CHECK_GREATER(shardsCount, 0, ());
+  for (size_t i = 0; i < m_shards.size(); ++i)
+  {
+    m_shards[i].m_path = GetShardPath(i);
+    m_shards[i].m_writer = std::make_unique<FileWriter>(m_shards[i].m_path);
+  }
+}
+
+KeyValueShardsWriter::~KeyValueShardsWriter()
+{
+  for (auto & shard : m_shards)
+  {
+    shard.m_writer.reset();
+    uint64_t size;
+    if (base::GetFileSize(shard.m_path, size))
+      base::DeleteFileX(shard.m_path);
+  }
+}
+
+std::string KeyValueShardsWriter::GetShardPath(size_t shard) const
+{
+  return m_path + ".shard" + strings::to_string(shard) + ".tmp";
+}
+
+void KeyValueShardsWriter::Add(uint64_t key, char const * value)
+{
+  auto & shard = m_shards[GetShard(key, m_shards.size())];
+  CHECK(shard.m_writer, ("Add() after Finish()."));
+
+  // Keys are written as signed numbers like in other key-value files of the generator.
+  auto const keyStr = strings::to_string(static_cast<int64_t>(key));
+  auto const valueSize = strlen(value);
+  shard.m_writer->Write(keyStr.data(), keyStr.size());
+  shard.m_writer->Write(" ", 1);
+  shard.m_writer->Write(value, valueSize);
+  shard.m_writer->Write("\n", 1);
+
+  shard.m_size += keyStr.size() + valueSize + 2;
+  ++shard.m_recordsCount;
+}
+
+void KeyValueShardsWriter::Finish(base::TaskScheduler & scheduler)
+{
+  // Sizes of the shards are known, so every shard is written to its place by its own task.
+  std::vector<KeyValueShardsIndex::Shard> headers(m_shards.size());
+  uint64_t offset = 0;
+  uint64_t recordsOffset = kHeaderSize + kShardHeaderSize * m_shards.size();
+  for (size_t i = 0; i < m_shards.size(); ++i)
+  {
+    m_shards[i].m_writer.reset();
+
+    headers[i].m_offset = offset;
+    headers[i].m_size = m_shards[i].m_size;
+    headers[i].m_recordsCount = m_shards[i].m_recordsCount;
+    headers[i].m_recordsOffset = recordsOffset;
+    offset += m_shards[i].m_size;
+    recordsOffset += kRecordSize * m_shards[i].m_recordsCount;
+  }
+
+  auto const indexPath = GetIndexPath(m_path);
+  {
+    // The storage is truncated here and filled by the tasks.
+    FileWriter storage(m_path);
+    FileWriter index(indexPath);
+    WriteToSink(index, KeyValueShardsIndex::kVersion);
+    WriteToSink(index, static_cast<uint32_t>(m_shards.size()));
+    for (auto const & header : headers)
+    {
+      WriteToSink(index, header.m_offset);
+      WriteToSink(index, header.m_size);
+      WriteToSink(index, header.m_recordsCount);
+    }
+  }
+
+  base::ParallelFor(0, m_shards.size(), [&](size_t i) {
+    auto const & header = headers[i];
+    if (header.m_recordsCount == 0)
+      return;
+
+    std::string data;
+    FileReader(m_shards[i].m_path).ReadAsString(data);
+    CHECK_EQUAL(data.size(), header.m_size, (m_shards[i].m_path));
+    auto const lines = SortLines(data);
+    CHECK_EQUAL(lines.size(), header.m_recordsCount, (m_shards[i].m_path));
+
+    std::vector<uint8_t> records;
+    records.reserve(kRecordSize * lines.size());
+    MemWriter<std::vector<uint8_t>> recordsWriter(records);
+
+    FileWriter storage(m_path, FileWriter::OP_WRITE_EXISTING);
+    storage.Seek(header.m_offset);
+    for (auto const & line : lines)
+    {
+      WriteToSink(recordsWriter, line.m_key);
+      WriteToSink(recordsWriter, storage.Pos());
+      storage.Write(data.data() + line.m_begin, line.m_size);
+    }
+
+    FileWriter index(indexPath, FileWriter::OP_WRITE_EXISTING);
+    index.Seek(header.m_recordsOffset);
+    index.Write(records.data(), records.size());
+
+    base::DeleteFileX(m_shards[i].m_path);
+  }, 1 /* minChunkSize */, scheduler);
+}
+
+KeyValueShardsIndex::KeyValueShardsIndex(std::string const & indexPath) : m_indexPath(indexPath)
+{
+  FileReader reader(m_indexPath);
+  ReaderSource<FileReader> src(reader);
+  auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+  if (version != kVersion)
+    MYTHROW(Reader::Exception, ("Unknown version", version, "of", m_indexPath));
+
+  m_shards.resize(ReadPrimitiveFromSource<uint32_t>(src));
+  uint64_t recordsOffset = kHeaderSize + kShardHeaderSize * m_shards.size();
+  for (auto & shard : m_shards)
+  {
+    shard.m_offset = ReadPrimitiveFromSource<uint64_t>(src);
+    shard.m_size = ReadPrimitiveFromSource<uint64_t>(src);
+    shard.m_recordsCount = ReadPrimitiveFromSource<uint64_t>(src);
+    shard.m_recordsOffset = recordsOffset;
+    recordsOffset += kRecordSize * shard.m_recordsCount;
+  }
+
+  if (recordsOffset != reader.Size())
+    MYTHROW(Reader::Exception, ("Wrong size of", m_indexPath));
+}
+
+std::vector<KeyValueShardsIndex::Record> KeyValueShardsIndex::ReadRecords(size_t shard) const
+{
+  CHECK_LESS(shard, m_shards.size(), ());
+  auto const & header = m_shards[shard];
+
+  FileReader reader(m_indexPath);
+  ReaderSource<FileReader> src(reader);
+  src.Skip(header.m_recordsOffset);
+
+  std::vector<Record> records(header.m_recordsCount);
+  for (auto & record : records)
+  {
+    record.first = ReadPrimitiveFromSource<uint64_t>(src);
+    record.second = ReadPrimitiveFromSource<uint64_t>(src);
+  }
+  return records;
+}
+
+std::vector<uint64_t> KeyValueShardsIndex::Find(uint64_t key) const
+{
+  std::vector<uint64_t> offsets;
+  if (m_shards.empty())
+    return offsets;
+
+  auto const & header = m_shards[KeyValueShardsWriter::GetShard(key, m_shards.size())];
+  FileReader reader(m_indexPath);
+  auto const getKey = [&](uint64_t i) {
+    return ReadPrimitiveFromPos<uint64_t>(reader, header.m_recordsOffset + i * kRecordSize);
+  };
+
+  // Binary search of the first record with |key|.
+  uint64_t begin = 0;
+  uint64_t end = header.m_recordsCount;
+  while (begin < end)
+  {
+    auto const middle = begin + (end - begin) / 2;
+    if (getKey(middle) < key)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+
+  for (; begin < header.m_recordsCount && getKey(begin) == key; ++begin)
+  {
+    offsets.push_back(ReadPrimitiveFromPos<uint64_t>(
+        reader, header.m_recordsOffset + begin * kRecordSize + sizeof(uint64_t)));
+  }
+  return offsets;
+}
+}  // namespace geo_objects
+}  // namespace generator
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class FileWriter;
+
+namespace generator
+{
+namespace geo_objects
+{
+// Writer of a key-value storage of "<key> <value>" lines which doesn't fit into memory.
+//
+// Records are distributed over shards by keys and collected in temporary files. Finish() sorts
+// every shard by keys in memory, shards are sorted in parallel and written one after another,
+// so the storage stays readable line by line. The index of the storage is written to
+// "<path>.idx", it has byte ranges of the shards and sorted keys of records of every shard
+// with their offsets. So readers may load shards in parallel or find records without reading
+// the whole storage, see KeyValueShardsIndex.
+class KeyValueShardsWriter
+{
+public:
+  KeyValueShardsWriter(std::string const & path, size_t shardsCount);
+  // Removes the temporary files.
+  ~KeyValueShardsWriter();
+
+  static std::string GetIndexPath(std::string const & path) { return path + ".idx"; }
+  static size_t GetShard(uint64_t key, size_t shardsCount) { return key % shardsCount; }
+
+  // |value| must not contain line breaks.
+  void Add(uint64_t key, char const * value);
+
+  // Writes the storage and its index. Throws Writer::Exception and Reader::Exception.
+  void Finish(base::TaskScheduler & scheduler = base::TaskScheduler::Instance());
+
+private:
+  struct Shard
+  {
+    std::string m_path;
+    std::unique_ptr<FileWriter> m_writer;
+    uint64_t m_size = 0;
+    uint64_t m_recordsCount = 0;
+  };
+
+  std::string GetShardPath(size_t shard) const;
+
+  std::string m_path;
+  std::vector<Shard> m_shards;
+
+  DISALLOW_COPY_AND_MOVE(KeyValueShardsWriter);
+};
+
+// Index of a storage written by KeyValueShardsWriter.
+//
+// Index format (all numbers are little-endian):
+//   uint32 version
+//   uint32 shards count
+//   for every shard: uint64 offset, uint64 size, uint64 records count
+//   for every shard: records count pairs of uint64 key and uint64 offset of the record,
+//                    sorted by keys
+class KeyValueShardsIndex
+{
+public:
+  static uint32_t constexpr kVersion = 0;
+
+  struct Shard
+  {
+    // Byte range of the shard in the storage.
+    uint64_t m_offset = 0;
+    uint64_t m_size = 0;
+    uint64_t m_recordsCount = 0;
+    // Offset of the records of the shard in the index.
+    uint64_t m_recordsOffset = 0;
+  };
+
+  using Record = std::pair<uint64_t, uint64_t>;
+
+  // Throws Reader::Exception.
+  explicit KeyValueShardsIndex(std::string const & indexPath);
+
+  std::vector<Shard> const & GetShards() const { return m_shards; }
+
+  // Returns keys and offsets of the records of |shard| sorted by keys.
+  std::vector<Record> ReadRecords(size_t shard) const;
+  // Returns offsets of the records with |key| in the storage.
+  std::vector<uint64_t> Find(uint64_t key) const;
+
+private:
+  std::string m_indexPath;
+  std::vector<Shard> m_shards;
+};
+}  // namespace geo_objects
+}  // namespace generator
@@ -23,7 +23,7 @@ namespace feature
 class GeometryHolder
 {
 public:
-  using FileGetter = std::function<FileWriter &(int i)>;
+  using FileGetter = std::function<Writer &(int i)>;
   using Points = std::vector<m2::PointD>;
   using Polygons = std::list<Points>;
 
@@ -156,6 +156,19 @@ private:
     // outer path can have 2 points in small scale levels
     ASSERT_GREATER(points.size(), 1, ());
 
+    if (m_header.GetGeometryLayout() == feature::DataHeader::GeometryLayout::Progressive)
+    {
+      // Coarser paths are simplified from the finer ones, so all of them are subsequences
+      // of the best path which is written first.
+      m_current = points;
+      if (!m_bestPoints.empty())
+      {
+        WriteOuterPointsIndexes(points, i);
+        return;
+      }
+      m_bestPoints = points;
+    }
+
     auto cp = m_header.GetGeometryCodingParams(i);
 
     // Optimization: Store first point once in header for outer linear features.
@@ -167,7 +180,33 @@ private:
     auto const pos = feature::CheckedFilePosCast(m_geoFileGetter(i));
     m_buffer.m_ptsOffset.push_back(pos);
 
-    serial::SaveOuterPath(toSave, cp, m_geoFileGetter(i));
+    if (m_header.GetGeometryLayout() == feature::DataHeader::GeometryLayout::FixedWidth)
+      serial::SaveOuterFixedWidth(toSave, cp, m_geoFileGetter(i));
+    else
+      serial::SaveOuterPath(toSave, cp, m_geoFileGetter(i));
+  }
+
+  void WriteOuterPointsIndexes(Points const & points, int i)
+  {
+    std::vector<uint32_t> indexes;
+    indexes.reserve(points.size() - 1);
+    uint32_t j = 0;
+    for (size_t k = 1; k < points.size(); ++k)
+    {
+      for (++j; j < m_bestPoints.size(); ++j)
+      {
+        if (feature::ArePointsEqual(m_bestPoints[j], points[k]))
+          break;
+      }
+
+      CHECK_LESS(j, m_bestPoints.size(), ("Simplified point is not found in the best path."));
+      indexes.push_back(j);
+    }
+
+    m_buffer.m_ptsMask |= (1 << i);
+    auto const pos = feature::CheckedFilePosCast(m_geoFileGetter(i));
+    m_buffer.m_ptsOffset.push_back(pos);
+    serial::SaveOuterPathIndexes(indexes, m_geoFileGetter(i));
   }
 
   void WriteOuterTriangles(Polygons const & polys, int i)
@@ -184,6 +223,23 @@ private:
 
     auto const cp = m_header.GetGeometryCodingParams(i);
 
+    if (m_header.GetGeometryLayout() == feature::DataHeader::GeometryLayout::FixedWidth)
+    {
+      Points triangles;
+      info.ForEachTriangle([&triangles](m2::PointD const & p1, m2::PointD const & p2,
+                                        m2::PointD const & p3) {
+        triangles.push_back(p1);
+        triangles.push_back(p2);
+        triangles.push_back(p3);
+      });
+
+      m_buffer.m_trgMask |= (1 << i);
+      auto const pos = feature::CheckedFilePosCast(m_trgFileGetter(i));
+      m_buffer.m_trgOffset.push_back(pos);
+      serial::SaveOuterTrianglesFixedWidth(triangles, cp, m_trgFileGetter(i));
+      return;
+    }
+
     serial::TrianglesChainSaver saver(cp);
 
     // points conversion
@@ -243,6 +299,8 @@ private:
   FeatureBuilder2::SupportingData m_buffer;
 
   Points m_current;
+  // The best outer path of the progressive layout.
+  Points m_bestPoints;
   bool m_ptsInner, m_trgInner;
 
   feature::DataHeader const & m_header;
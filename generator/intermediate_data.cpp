@@ -1,13 +1,23 @@
 #include "generator/intermediate_data.hpp"
 
-#include <new>
-#include <set>
-#include <string>
+#include "coding/byte_stream.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/succinct_mapper.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <set>
+#include <string>
+
 #include "defines.hpp"
 
 using namespace std;
@@ -69,8 +79,8 @@ public:
   // PointStorageWriterInterface overrides:
   uint64_t GetNumProcessedPoints() const override { return m_numProcessedPoints; }
 
-private:
-  uint64_t m_numProcessedPoints;
+protected:
+  uint64_t m_numProcessedPoints = 0;
 };
 
 // RawFilePointStorageMmapReader -------------------------------------------------------------------
@@ -119,7 +129,6 @@ public:
 
 private:
   FileWriter m_fileWriter;
-  uint64_t m_numProcessedPoints = 0;
 };
 
 // RawMemPointStorageReader ------------------------------------------------------------------------
@@ -179,7 +188,6 @@ public:
 private:
   FileWriter m_fileWriter;
   vector<LatLon> m_data;
-  uint64_t m_numProcessedPoints = 0;
 };
 
 // MapFilePointStorageReader -----------------------------------------------------------------------
@@ -256,8 +264,175 @@ public:
 
 private:
   FileWriter m_fileWriter;
-  uint64_t m_numProcessedPoints = 0;
 };
+
+// Block-sparse storage: node ids are split into blocks of kSparseBlockSize ids. A block is
+// a presence bitmap followed by the zigzag-varint deltas of the coordinates of its present
+// nodes, so empty id ranges cost only their offsets and nearby nodes a few bytes each.
+// The offsets of all blocks and their count are written at the end of the file.
+uint64_t const kSparseBlockSize = 128;
+size_t const kSparseBitmapWords = kSparseBlockSize / 64;
+
+// SparseFilePointStorageMmapReader ----------------------------------------------------------------
+class SparseFilePointStorageMmapReader : public PointStorageReaderInterface
+{
+public:
+  explicit SparseFilePointStorageMmapReader(string const & name) : m_mmapReader(name)
+  {
+    uint64_t const size = m_mmapReader.Size();
+    CHECK_GREATER_OR_EQUAL(size, sizeof(uint64_t), ("Damaged file", name));
+
+    uint8_t const * data = m_mmapReader.Data();
+    memcpy(&m_blocksCount, data + size - sizeof(uint64_t), sizeof(uint64_t));
+    uint64_t const offsetsSize = (m_blocksCount + 1) * sizeof(uint64_t);
+    CHECK_GREATER_OR_EQUAL(size, offsetsSize + sizeof(uint64_t), ("Damaged file", name));
+
+    m_data = data;
+    m_offsets = data + size - sizeof(uint64_t) - offsetsSize;
+  }
+
+  // PointStorageReaderInterface overrides:
+  bool GetPoint(uint64_t id, double & lat, double & lon) const override
+  {
+    uint64_t const block = id / kSparseBlockSize;
+    if (block >= m_blocksCount)
+      return false;
+
+    uint64_t offsets[2];
+    memcpy(offsets, m_offsets + block * sizeof(uint64_t), sizeof(offsets));
+    if (offsets[0] == offsets[1])
+      return false;
+
+    uint64_t bitmap[kSparseBitmapWords];
+    memcpy(bitmap, m_data + offsets[0], sizeof(bitmap));
+
+    uint64_t const bit = id % kSparseBlockSize;
+    uint64_t const word = bitmap[bit / 64];
+    if ((word & (uint64_t{1} << (bit % 64))) == 0)
+      return false;
+
+    // Number of present nodes in the block before |id|.
+    uint64_t rank = bits::PopCount(word & ((uint64_t{1} << (bit % 64)) - 1));
+    for (size_t i = 0; i < bit / 64; ++i)
+      rank += bits::PopCount(bitmap[i]);
+
+    ArrayByteSource src(m_data + offsets[0] + sizeof(bitmap));
+    int64_t lat64 = 0;
+    int64_t lon64 = 0;
+    for (uint64_t i = 0; i <= rank; ++i)
+    {
+      lat64 += ReadVarInt<int64_t>(src);
+      lon64 += ReadVarInt<int64_t>(src);
+    }
+
+    lat = static_cast<double>(lat64) / kValueOrder;
+    lon = static_cast<double>(lon64) / kValueOrder;
+    return true;
+  }
+
+private:
+  MmapReader m_mmapReader;
+  uint8_t const * m_data = nullptr;
+  uint8_t const * m_offsets = nullptr;
+  uint64_t m_blocksCount = 0;
+};
+
+// SparseFilePointStorageWriter --------------------------------------------------------------------
+class SparseFilePointStorageWriter : public PointStorageWriterBase
+{
+public:
+  explicit SparseFilePointStorageWriter(string const & name) : m_fileWriter(name) {}
+
+  ~SparseFilePointStorageWriter()
+  {
+    FlushBlock();
+    m_offsets.push_back(m_fileWriter.Pos());
+    m_fileWriter.Write(m_offsets.data(), m_offsets.size() * sizeof(uint64_t));
+
+    uint64_t const blocksCount = m_offsets.size() - 1;
+    m_fileWriter.Write(&blocksCount, sizeof(blocksCount));
+  }
+
+  // PointStorageWriterInterface overrides:
+  // Nodes must come in ascending order of ids, as they do in OSM files.
+  void AddPoint(uint64_t id, double lat, double lon) override
+  {
+    CHECK(m_numProcessedPoints == 0 || id > m_lastId,
+          ("Node ids must be ascending for sparse storage:", id, "after", m_lastId));
+    m_lastId = id;
+
+    uint64_t const block = id / kSparseBlockSize;
+    if (block != m_offsets.size())
+    {
+      FlushBlock();
+      while (m_offsets.size() < block)
+        m_offsets.push_back(m_fileWriter.Pos());
+    }
+
+    LatLon ll;
+    ToLatLon(lat, lon, ll);
+
+    uint64_t const bit = id % kSparseBlockSize;
+    m_bitmap[bit / 64] |= uint64_t{1} << (bit % 64);
+
+    PushBackByteSink<vector<uint8_t>> sink(m_deltas);
+    WriteVarInt(sink, int64_t{ll.m_lat} - m_last.m_lat);
+    WriteVarInt(sink, int64_t{ll.m_lon} - m_last.m_lon);
+    m_last = ll;
+
+    ++m_numProcessedPoints;
+  }
+
+private:
+  // Writes the block being filled, if any, and records its offset.
+  void FlushBlock()
+  {
+    if (m_deltas.empty())
+      return;
+
+    m_offsets.push_back(m_fileWriter.Pos());
+    m_fileWriter.Write(m_bitmap, sizeof(m_bitmap));
+    m_fileWriter.Write(m_deltas.data(), m_deltas.size());
+
+    fill(begin(m_bitmap), end(m_bitmap), 0);
+    m_deltas.clear();
+    m_last = LatLon();
+  }
+
+  FileWriter m_fileWriter;
+  // Offsets of the written blocks.
+  vector<uint64_t> m_offsets;
+  uint64_t m_bitmap[kSparseBitmapWords] = {};
+  vector<uint8_t> m_deltas;
+  LatLon m_last;
+  uint64_t m_lastId = 0;
+};
+
+// Node ids of a way in the columnar ways cache.
+template <typename Sink>
+void WriteWayNodes(Sink & sink, vector<uint64_t> const & nodes)
+{
+  WriteVarUint(sink, static_cast<uint64_t>(nodes.size()));
+  uint64_t prev = 0;
+  for (auto const node : nodes)
+  {
+    // Deltas wrap around for decreasing ids.
+    WriteVarInt(sink, static_cast<int64_t>(node - prev));
+    prev = node;
+  }
+}
+
+template <typename Source>
+void ReadWayNodes(Source & src, vector<uint64_t> & nodes)
+{
+  nodes.resize(ReadVarUint<uint64_t>(src));
+  uint64_t prev = 0;
+  for (auto & node : nodes)
+  {
+    node = prev + static_cast<uint64_t>(ReadVarInt<int64_t>(src));
+    prev = node;
+  }
+}
 }  // namespace
 
 // IndexFileReader ---------------------------------------------------------------------------------
@@ -344,19 +519,165 @@ OSMElementCacheWriter::OSMElementCacheWriter(string const & name, bool preload)
 
 void OSMElementCacheWriter::SaveOffsets() { m_offsets.WriteAll(); }
 
+// WaysColumnarWriter ------------------------------------------------------------------------------
+WaysColumnarWriter::WaysColumnarWriter(string const & name)
+  : m_name(name)
+  , m_fileWriter(make_unique<FileWriter>(name))
+  , m_offsetsWriter(make_unique<FileWriter>(name + OFFSET_EXT))
+{
+}
+
+void WaysColumnarWriter::Write(Key id, WayElement const & e)
+{
+  if (m_count != 0 && id <= m_lastId)
+    m_sorted = false;
+  m_lastId = m_count == 0 ? id : max(m_lastId, id);
+  ++m_count;
+
+  m_elements.emplace_back(id, m_fileWriter->Pos());
+  if (m_elements.size() > kFlushCount)
+    FlushElements();
+
+  m_data.clear();
+  MemWriter<decltype(m_data)> w(m_data);
+  WriteWayNodes(w, e.nodes);
+  m_fileWriter->Write(m_data.data(), m_data.size());
+}
+
+void WaysColumnarWriter::FlushElements()
+{
+  if (m_elements.empty())
+    return;
+
+  m_offsetsWriter->Write(m_elements.data(), m_elements.size() * sizeof(Element));
+  m_elements.clear();
+}
+
+void WaysColumnarWriter::SaveOffsets()
+{
+  CHECK(m_fileWriter, ("Offsets are already saved."));
+  FlushElements();
+  m_offsetsWriter.reset();
+
+  if (!m_sorted)
+    SortWays();
+
+  auto const dataSize = m_fileWriter->Pos();
+  coding::EliasFanoSequence::Builder ids(m_lastId + 1, m_count);
+  coding::EliasFanoSequence::Builder offsets(dataSize + 1, m_count);
+  {
+    FileReader reader(m_name + OFFSET_EXT);
+    ReaderSource<FileReader> src(reader);
+    for (uint64_t i = 0; i < m_count; ++i)
+    {
+      ids.PushBack(ReadPrimitiveFromSource<uint64_t>(src));
+      offsets.PushBack(ReadPrimitiveFromSource<uint64_t>(src));
+    }
+  }
+  base::DeleteFileX(m_name + OFFSET_EXT);
+
+  WaysColumnarIndex index;
+  coding::EliasFanoSequence(ids).Swap(index.m_ids);
+  coding::EliasFanoSequence(offsets).Swap(index.m_offsets);
+
+  uint64_t bytesWritten = dataSize;
+  coding::WritePadding(*m_fileWriter, bytesWritten);
+  auto const indexOffset = m_fileWriter->Pos();
+  coding::Freeze(index, *m_fileWriter, "WaysColumnarIndex");
+  WriteToSink(*m_fileWriter, indexOffset);
+  m_fileWriter.reset();
+}
+
+void WaysColumnarWriter::SortWays()
+{
+  LOG_SHORT(LINFO, ("Ways aren't ordered by ids, sorting", m_count, "ways."));
+
+  auto const offsetsPath = m_name + OFFSET_EXT;
+  vector<Element> elements(base::checked_cast<size_t>(m_count));
+  FileReader(offsetsPath).Read(0, elements.data(), elements.size() * sizeof(Element));
+  stable_sort(elements.begin(), elements.end(),
+              [](Element const & l, Element const & r) { return l.first < r.first; });
+  elements.erase(unique(elements.begin(), elements.end(),
+                        [](Element const & l, Element const & r) { return l.first == r.first; }),
+                 elements.end());
+
+  m_fileWriter->Flush();
+  auto const sortedPath = m_name + ".sorted";
+  uint64_t dataSize = 0;
+  {
+    FileReader reader(m_name);
+    FileWriter writer(sortedPath);
+    vector<uint64_t> nodes;
+    for (auto & e : elements)
+    {
+      ReaderSource<FileReader> src(reader);
+      src.Skip(e.second);
+      ReadWayNodes(src, nodes);
+
+      e.second = writer.Pos();
+      m_data.clear();
+      MemWriter<decltype(m_data)> w(m_data);
+      WriteWayNodes(w, nodes);
+      writer.Write(m_data.data(), m_data.size());
+    }
+    dataSize = writer.Pos();
+  }
+
+  m_fileWriter.reset();
+  CHECK(base::RenameFileX(sortedPath, m_name), (sortedPath, m_name));
+  m_fileWriter = make_unique<FileWriter>(m_name, FileWriter::OP_WRITE_EXISTING);
+  m_fileWriter->Seek(dataSize);
+
+  FileWriter(offsetsPath).Write(elements.data(), elements.size() * sizeof(Element));
+  m_count = elements.size();
+  m_lastId = elements.empty() ? 0 : elements.back().first;
+  m_sorted = true;
+}
+
+// WaysColumnarReader ------------------------------------------------------------------------------
+WaysColumnarReader::WaysColumnarReader(string const & name) : m_mmapReader(name)
+{
+  auto const size = m_mmapReader.Size();
+  CHECK_GREATER_OR_EQUAL(size, sizeof(uint64_t), ("Damaged file", name));
+  auto const indexOffset = ReadPrimitiveFromPos<uint64_t>(m_mmapReader, size - sizeof(uint64_t));
+  CHECK(indexOffset < size && coding::IsAlign8(indexOffset), ("Damaged file", name));
+  coding::Map(m_index, m_mmapReader.Data() + indexOffset, "WaysColumnarIndex");
+}
+
+bool WaysColumnarReader::Read(Key id, WayElement & e) const
+{
+  auto const & ids = m_index.m_ids;
+  auto const rank = ids.Rank(id);
+  if (rank == ids.Size() || ids.Get(rank) != id)
+  {
+    LOG_SHORT(LWARNING, ("Can't find way", id, "in file", m_mmapReader.GetName()));
+    return false;
+  }
+
+  ArrayByteSource src(m_mmapReader.Data() + m_index.m_offsets.Get(rank));
+  ReadWayNodes(src, e.nodes);
+  return true;
+}
+
 // IntermediateDataReader
 IntermediateDataReader::IntermediateDataReader(shared_ptr<PointStorageReaderInterface> nodes,
                                                feature::GenerateInfo & info) :
     m_nodes(nodes),
-    m_ways(info.GetIntermediateFileName(WAYS_FILE), info.m_preloadCache),
     m_relations(info.GetIntermediateFileName(RELATIONS_FILE), info.m_preloadCache),
     m_nodeToRelations(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT)),
     m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE, ID2REL_EXT))
-{}
+{
+  auto const waysPath = info.GetIntermediateFileName(WAYS_FILE);
+  if (info.m_columnarWaysCache)
+    m_columnarWays = make_unique<WaysColumnarReader>(waysPath);
+  else
+    m_ways = make_unique<OSMElementCacheReader>(waysPath, info.m_preloadCache);
+}
 
 void IntermediateDataReader::LoadIndex()
 {
-  m_ways.LoadOffsets();
+  if (m_ways)
+    m_ways->LoadOffsets();
   m_relations.LoadOffsets();
 
   m_nodeToRelations.ReadAll();
@@ -367,10 +688,16 @@ void IntermediateDataReader::LoadIndex()
 IntermediateDataWriter::IntermediateDataWriter(shared_ptr<PointStorageWriterInterface> nodes,
                                                feature::GenerateInfo & info) :
     m_nodes(nodes),
-    m_ways(info.GetIntermediateFileName(WAYS_FILE), info.m_preloadCache),
     m_relations(info.GetIntermediateFileName(RELATIONS_FILE), info.m_preloadCache),
     m_nodeToRelations(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT)),
-    m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE, ID2REL_EXT)) {}
+    m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE, ID2REL_EXT))
+{
+  auto const waysPath = info.GetIntermediateFileName(WAYS_FILE);
+  if (info.m_columnarWaysCache)
+    m_columnarWays = make_unique<WaysColumnarWriter>(waysPath);
+  else
+    m_ways = make_unique<OSMElementCacheWriter>(waysPath, info.m_preloadCache);
+}
 
 void IntermediateDataWriter::AddRelation(Key id, RelationElement const & e)
 {
@@ -387,7 +714,10 @@ void IntermediateDataWriter::AddRelation(Key id, RelationElement const & e)
 
 void IntermediateDataWriter::SaveIndex()
 {
-  m_ways.SaveOffsets();
+  if (m_columnarWays)
+    m_columnarWays->SaveOffsets();
+  else
+    m_ways->SaveOffsets();
   m_relations.SaveOffsets();
 
   m_nodeToRelations.WriteAll();
@@ -406,6 +736,8 @@ CreatePointStorageReader(feature::GenerateInfo::NodeStorageType type, string con
     return make_shared<MapFilePointStorageReader>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return make_shared<RawMemPointStorageReader>(name);
+  case feature::GenerateInfo::NodeStorageType::Sparse:
+    return make_shared<SparseFilePointStorageMmapReader>(name);
   }
   CHECK_SWITCH();
 }
@@ -421,6 +753,8 @@ CreatePointStorageWriter(feature::GenerateInfo::NodeStorageType type, string con
     return make_shared<MapFilePointStorageWriter>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return make_shared<RawMemPointStorageWriter>(name);
+  case feature::GenerateInfo::NodeStorageType::Sparse:
+    return make_shared<SparseFilePointStorageWriter>(name);
   }
   CHECK_SWITCH();
 }
@@ -7,6 +7,7 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/mmap_reader.hpp"
+#include "coding/succinct_vectors.hpp"
 
 #include "base/assert.hpp"
 #include "base/control_flow.hpp"
@@ -16,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -196,13 +198,84 @@ protected:
   bool m_preload = false;
 };
 
+// Ways cache in the columnar layout, it's used instead of OSMElementCacheWriter/Reader for ways
+// when GenerateInfo::m_columnarWaysCache is set.
+//
+// File format:
+//   for every way in the order of ids: varuint nodes count and varint deltas of node ids,
+//                                      the first node id is a delta from zero
+//   padding to 8 bytes
+//   WaysColumnarIndex frozen by coding::Freeze()
+//   uint64 offset of the index
+//
+// The file is mapped by the reader and ways are decoded in place, so neither offsets nor ways
+// are loaded into memory.
+struct WaysColumnarIndex
+{
+  template <typename TVisitor>
+  void map(TVisitor & visitor)
+  {
+    visitor(m_ids, "m_ids")(m_offsets, "m_offsets");
+  }
+
+  // Strictly increasing way ids.
+  coding::EliasFanoSequence m_ids;
+  // Offsets of the ways in the file.
+  coding::EliasFanoSequence m_offsets;
+};
+
+class WaysColumnarWriter
+{
+public:
+  explicit WaysColumnarWriter(std::string const & name);
+
+  void Write(Key id, WayElement const & e);
+
+  // Writes the index. Ways which were written not in the order of ids are reordered,
+  // only the first one of ways with equal ids is kept.
+  void SaveOffsets();
+
+private:
+  using Element = std::pair<Key, uint64_t>;
+
+  void FlushElements();
+  void SortWays();
+
+  std::string m_name;
+  std::unique_ptr<FileWriter> m_fileWriter;
+  // Ids and offsets of the ways are collected in a temporary file.
+  std::unique_ptr<FileWriter> m_offsetsWriter;
+  std::vector<Element> m_elements;
+  std::vector<uint8_t> m_data;
+  uint64_t m_count = 0;
+  Key m_lastId = 0;
+  bool m_sorted = true;
+};
+
+class WaysColumnarReader
+{
+public:
+  explicit WaysColumnarReader(std::string const & name);
+
+  // Thread-safe.
+  bool Read(Key id, WayElement & e) const;
+
+private:
+  MmapReader m_mmapReader;
+  WaysColumnarIndex m_index;
+};
+
 class IntermediateDataReader
 {
 public:
   IntermediateDataReader(shared_ptr<PointStorageReaderInterface> nodes, feature::GenerateInfo & info);
 
   bool GetNode(Key id, double & lat, double & lon) const { return m_nodes->GetPoint(id, lat, lon); }
-  bool GetWay(Key id, WayElement & e) { return m_ways.Read(id, e); }
+  bool GetWay(Key id, WayElement & e)
+  {
+    return m_columnarWays ? m_columnarWays->Read(id, e) : m_ways->Read(id, e);
+  }
+  bool GetRelation(Key id, RelationElement & e) { return m_relations.Read(id, e); }
   void LoadIndex();
 
   template <typename ToDo>
@@ -264,7 +337,9 @@ private:
   };
 
   std::shared_ptr<PointStorageReaderInterface> m_nodes;
-  cache::OSMElementCacheReader m_ways;
+  // Only one of the ways caches is used.
+  std::unique_ptr<cache::OSMElementCacheReader> m_ways;
+  std::unique_ptr<cache::WaysColumnarReader> m_columnarWays;
   cache::OSMElementCacheReader m_relations;
   cache::IndexFileReader m_nodeToRelations;
   cache::IndexFileReader m_wayToRelations;
@@ -276,7 +351,13 @@ public:
   IntermediateDataWriter(std::shared_ptr<PointStorageWriterInterface> nodes, feature::GenerateInfo & info);
 
   void AddNode(Key id, double lat, double lon) { m_nodes->AddPoint(id, lat, lon); }
-  void AddWay(Key id, WayElement const & e) { m_ways.Write(id, e); }
+  void AddWay(Key id, WayElement const & e)
+  {
+    if (m_columnarWays)
+      m_columnarWays->Write(id, e);
+    else
+      m_ways->Write(id, e);
+  }
 
   void AddRelation(Key id, RelationElement const & e);
   void SaveIndex();
@@ -296,7 +377,9 @@ private:
   }
 
   std::shared_ptr<PointStorageWriterInterface> m_nodes;
-  cache::OSMElementCacheWriter m_ways;
+  // Only one of the ways caches is used.
+  std::unique_ptr<cache::OSMElementCacheWriter> m_ways;
+  std::unique_ptr<cache::WaysColumnarWriter> m_columnarWays;
   cache::OSMElementCacheWriter m_relations;
   cache::IndexFileWriter m_nodeToRelations;
   cache::IndexFileWriter m_wayToRelations;
@@ -1,16 +1,25 @@
 #include "generator/mwm_diff/diff.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
 #include "coding/reader.hpp"
+#include "coding/sha1.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 #include "coding/zlib.hpp"
 
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <iterator>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
@@ -23,9 +32,225 @@ enum Version
 {
   // Format Version 0: bsdiff+gzip.
   VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  // Format Version 1: sections of the new mwm, every section is either copied from the old mwm,
+  // or patched with bsdiff+gzip, or stored with gzip. Data out of sections is stored with gzip.
+  VERSION_V1 = 1,
+  VERSION_LATEST = VERSION_V1
 };
 
+enum class SectionAction : uint8_t
+{
+  // The section is equal to the section of the old mwm with the same tag.
+  Copy = 0,
+  // The section is a bsdiff patch of the section of the old mwm with the same tag.
+  Patch = 1,
+  // There's no such section in the old mwm, its data is stored.
+  Store = 2
+};
+
+struct Section
+{
+  string m_tag;
+  uint64_t m_offset = 0;
+  uint64_t m_size = 0;
+};
+
+// Header entry of a section of the new mwm.
+struct SectionEntry
+{
+  Section m_section;
+  SectionAction m_action = SectionAction::Store;
+  // Hash of the old section for Copy and Patch.
+  coding::SHA1::Hash m_oldHash = {};
+  uint64_t m_payloadOffset = 0;
+  uint64_t m_payloadSize = 0;
+};
+
+using Deflate = coding::ZLib::Deflate;
+using Inflate = coding::ZLib::Inflate;
+
+// Returns false when |path| isn't a files container or its sections overlap.
+bool ReadSections(string const & path, vector<Section> & sections, uint64_t & fileSize)
+{
+  sections.clear();
+  try
+  {
+    FilesContainerR const cont(path);
+    cont.ForEachTag([&](string const & tag) {
+      auto const offsetAndSize = cont.GetAbsoluteOffsetAndSize(tag);
+      sections.push_back({tag, offsetAndSize.first, offsetAndSize.second});
+    });
+    fileSize = cont.GetFileSize();
+  }
+  catch (RootException const &)
+  {
+    return false;
+  }
+
+  sort(sections.begin(), sections.end(), [](Section const & lhs, Section const & rhs) {
+    return lhs.m_offset < rhs.m_offset;
+  });
+
+  uint64_t end = 0;
+  for (auto const & section : sections)
+  {
+    if (section.m_offset < end || section.m_offset + section.m_size > fileSize)
+      return false;
+    end = section.m_offset + section.m_size;
+  }
+  return true;
+}
+
+vector<uint8_t> ReadBytes(FileReader const & reader, uint64_t offset, uint64_t size)
+{
+  vector<uint8_t> result(static_cast<size_t>(size));
+  reader.Read(offset, result.data(), result.size());
+  return result;
+}
+
+vector<uint8_t> DeflateBytes(vector<uint8_t> const & data)
+{
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+  vector<uint8_t> result;
+  deflate(data.data(), data.size(), back_inserter(result));
+  return result;
+}
+
+vector<uint8_t> InflatePayload(string const & diffPath, SectionEntry const & entry)
+{
+  auto const deflated = ReadBytes(FileReader(diffPath), entry.m_payloadOffset, entry.m_payloadSize);
+  Inflate inflate(Inflate::Format::ZLib);
+  vector<uint8_t> result;
+  if (!inflate(deflated.data(), deflated.size(), back_inserter(result)))
+    MYTHROW(Reader::ReadException, ("Can't inflate payload of", entry.m_section.m_tag));
+  return result;
+}
+
+// Copies |oldSection| of |oldMwmPath| to |toPos| of the existing file |newMwmPath|.
+// The hash of the section is calculated on the copied data, so the old mwm is read once.
+// Returns false when the hash isn't equal to |expectedHash|.
+bool CopySection(string const & oldMwmPath, Section const & oldSection, string const & newMwmPath,
+                 uint64_t toPos, coding::SHA1::Hash const & expectedHash)
+{
+  FileReader reader(oldMwmPath);
+  FileWriter writer(newMwmPath, FileWriter::OP_WRITE_EXISTING);
+  writer.Seek(toPos);
+
+  coding::SHA1::Calculator hash;
+  vector<uint8_t> buffer(1 << 16);
+  uint64_t pos = oldSection.m_offset;
+  uint64_t size = oldSection.m_size;
+  while (size != 0)
+  {
+    auto const toCopy = static_cast<size_t>(min<uint64_t>(buffer.size(), size));
+    reader.Read(pos, buffer.data(), toCopy);
+    hash.Update(buffer.data(), toCopy);
+    writer.Write(buffer.data(), toCopy);
+    pos += toCopy;
+    size -= toCopy;
+  }
+  return hash.Finish() == expectedHash;
+}
+
+// Makes the entry and the payload of |newSection|.
+bool MakeSectionDiff(string const & oldMwmPath, string const & newMwmPath,
+                     unordered_map<string, Section> const & oldSections,
+                     Section const & newSection, SectionEntry & entry,
+                     vector<uint8_t> & payload)
+{
+  entry.m_section = newSection;
+
+  FileReader const newReader(newMwmPath);
+  auto const it = oldSections.find(newSection.m_tag);
+  if (it == oldSections.end())
+  {
+    entry.m_action = SectionAction::Store;
+    payload = DeflateBytes(ReadBytes(newReader, newSection.m_offset, newSection.m_size));
+    return true;
+  }
+
+  auto const & oldSection = it->second;
+  entry.m_oldHash = coding::SHA1::Calculate(oldMwmPath, oldSection.m_offset, oldSection.m_size);
+  if (oldSection.m_size == newSection.m_size &&
+      entry.m_oldHash ==
+          coding::SHA1::Calculate(newMwmPath, newSection.m_offset, newSection.m_size))
+  {
+    entry.m_action = SectionAction::Copy;
+    return true;
+  }
+
+  entry.m_action = SectionAction::Patch;
+  FileReader oldReader = FileReader(oldMwmPath).SubReader(oldSection.m_offset, oldSection.m_size);
+  FileReader newSectionReader = newReader.SubReader(newSection.m_offset, newSection.m_size);
+  vector<uint8_t> diffBuf;
+  MemWriter<vector<uint8_t>> diffMemWriter(diffBuf);
+  auto const status = bsdiff::CreateBinaryPatch(oldReader, newSectionReader, diffMemWriter);
+  if (status != bsdiff::BSDiffStatus::OK)
+  {
+    LOG(LERROR, ("Could not create patch of section", newSection.m_tag, "with bsdiff:", status));
+    return false;
+  }
+
+  payload = DeflateBytes(diffBuf);
+  return true;
+}
+
+// Writes the section of |entry| to its place in |newMwmPath|.
+bool ApplySectionDiff(string const & oldMwmPath, string const & newMwmPath,
+                      string const & diffPath,
+                      unordered_map<string, Section> const & oldSections,
+                      SectionEntry const & entry)
+{
+  auto const & section = entry.m_section;
+  if (entry.m_action == SectionAction::Store)
+  {
+    auto const data = InflatePayload(diffPath, entry);
+    if (data.size() != section.m_size)
+      return false;
+
+    FileWriter writer(newMwmPath, FileWriter::OP_WRITE_EXISTING);
+    writer.Seek(section.m_offset);
+    writer.Write(data.data(), data.size());
+    return true;
+  }
+
+  auto const it = oldSections.find(section.m_tag);
+  if (it == oldSections.end())
+  {
+    LOG(LERROR, ("No section", section.m_tag, "in the old mwm."));
+    return false;
+  }
+
+  auto const & oldSection = it->second;
+  if (entry.m_action == SectionAction::Copy)
+  {
+    if (oldSection.m_size != section.m_size)
+      return false;
+
+    if (!CopySection(oldMwmPath, oldSection, newMwmPath, section.m_offset, entry.m_oldHash))
+    {
+      LOG(LERROR, ("Section", section.m_tag, "of the old mwm doesn't match the diff."));
+      return false;
+    }
+    return true;
+  }
+
+  // The old section isn't hashed separately: bsdiff reads it once and checks its CRC32
+  // which is stored in the patch.
+  auto const diffBuf = InflatePayload(diffPath, entry);
+  MemReader diffMemReader(diffBuf.data(), diffBuf.size());
+  FileReader oldReader = FileReader(oldMwmPath).SubReader(oldSection.m_offset, oldSection.m_size);
+  FileWriter writer(newMwmPath, FileWriter::OP_WRITE_EXISTING);
+  writer.Seek(section.m_offset);
+  auto const status = bsdiff::ApplyBinaryPatch(oldReader, writer, diffMemReader);
+  if (status != bsdiff::BSDiffStatus::OK)
+  {
+    LOG(LERROR, ("Could not apply patch of section", section.m_tag, "with bsdiff:", status));
+    return false;
+  }
+  return writer.Pos() == section.m_offset + section.m_size;
+}
+
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
 {
   vector<uint8_t> diffBuf;
@@ -76,6 +301,161 @@ bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
 
   return true;
 }
+
+// The layout of the new mwm is kept, so the result is equal to the new mwm byte to byte.
+//
+// Header:  newFileSize, entriesCount, entries[entriesCount], gapsPayloadSize.
+// Entry:   tag, action, offset, size, old section SHA1, payloadSize.
+// Payload: payloads of the entries in the order of the entries, then the gaps payload
+//          with the data between the sections: offset, size and bytes of every gap.
+bool MakeDiffVersion1(string const & oldMwmPath, string const & newMwmPath,
+                      vector<Section> const & oldSections,
+                      vector<Section> const & newSections, uint64_t newFileSize,
+                      FileWriter & diffFileWriter)
+{
+  unordered_map<string, Section> oldByTag;
+  for (auto const & section : oldSections)
+    oldByTag.emplace(section.m_tag, section);
+
+  vector<SectionEntry> entries(newSections.size());
+  vector<vector<uint8_t>> payloads(newSections.size());
+  atomic<bool> ok(true);
+  base::ParallelFor(0, newSections.size(), [&](size_t i) {
+    if (!MakeSectionDiff(oldMwmPath, newMwmPath, oldByTag, newSections[i], entries[i],
+                         payloads[i]))
+    {
+      ok = false;
+    }
+  });
+  if (!ok)
+    return false;
+
+  vector<uint8_t> gaps;
+  {
+    FileReader const newReader(newMwmPath);
+    MemWriter<vector<uint8_t>> gapsWriter(gaps);
+    uint64_t pos = 0;
+    auto const addGap = [&](uint64_t end) {
+      if (end == pos)
+        return;
+      WriteToSink(gapsWriter, pos);
+      WriteToSink(gapsWriter, end - pos);
+      auto const bytes = ReadBytes(newReader, pos, end - pos);
+      gapsWriter.Write(bytes.data(), bytes.size());
+    };
+    for (auto const & section : newSections)
+    {
+      addGap(section.m_offset);
+      pos = section.m_offset + section.m_size;
+    }
+    addGap(newFileSize);
+  }
+  auto const deflatedGaps = DeflateBytes(gaps);
+
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V1));
+  WriteToSink(diffFileWriter, newFileSize);
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(entries.size()));
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    auto const & entry = entries[i];
+    rw::Write(diffFileWriter, entry.m_section.m_tag);
+    WriteToSink(diffFileWriter, static_cast<uint8_t>(entry.m_action));
+    WriteToSink(diffFileWriter, entry.m_section.m_offset);
+    WriteToSink(diffFileWriter, entry.m_section.m_size);
+    diffFileWriter.Write(entry.m_oldHash.data(), entry.m_oldHash.size());
+    WriteToSink(diffFileWriter, static_cast<uint64_t>(payloads[i].size()));
+  }
+  WriteToSink(diffFileWriter, static_cast<uint64_t>(deflatedGaps.size()));
+
+  for (auto const & payload : payloads)
+    diffFileWriter.Write(payload.data(), payload.size());
+  diffFileWriter.Write(deflatedGaps.data(), deflatedGaps.size());
+  return true;
+}
+
+// Data out of the sections is written first, then the sections are written to their places
+// in parallel.
+bool ApplyDiffVersion1(string const & oldMwmPath, string const & newMwmPath,
+                       string const & diffPath, ReaderSource<FileReader> & diffFileSource)
+{
+  auto const newFileSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+  auto const entriesCount = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
+  vector<SectionEntry> entries(entriesCount);
+  for (auto & entry : entries)
+  {
+    rw::Read(diffFileSource, entry.m_section.m_tag);
+    auto const action = ReadPrimitiveFromSource<uint8_t>(diffFileSource);
+    if (action > static_cast<uint8_t>(SectionAction::Store))
+    {
+      LOG(LERROR, ("Unknown section action in mwm diff:", action));
+      return false;
+    }
+    entry.m_action = static_cast<SectionAction>(action);
+    entry.m_section.m_offset = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+    entry.m_section.m_size = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+    diffFileSource.Read(entry.m_oldHash.data(), entry.m_oldHash.size());
+    entry.m_payloadSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+  }
+
+  SectionEntry gapsEntry;
+  gapsEntry.m_section.m_tag = "gaps";
+  gapsEntry.m_payloadSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+
+  uint64_t payloadOffset = diffFileSource.Pos();
+  for (auto & entry : entries)
+  {
+    entry.m_payloadOffset = payloadOffset;
+    payloadOffset += entry.m_payloadSize;
+  }
+  gapsEntry.m_payloadOffset = payloadOffset;
+
+  vector<Section> oldSections;
+  uint64_t oldFileSize = 0;
+  if (!ReadSections(oldMwmPath, oldSections, oldFileSize))
+  {
+    LOG(LERROR, ("Could not read sections of the old mwm:", oldMwmPath));
+    return false;
+  }
+  unordered_map<string, Section> oldByTag;
+  for (auto const & section : oldSections)
+    oldByTag.emplace(section.m_tag, section);
+
+  {
+    auto const gaps = InflatePayload(diffPath, gapsEntry);
+    MemReader gapsReader(gaps.data(), gaps.size());
+    ReaderSource<MemReader> gapsSource(gapsReader);
+    FileWriter newWriter(newMwmPath);
+    vector<uint8_t> buffer;
+    while (gapsSource.Size() != 0)
+    {
+      auto const offset = ReadPrimitiveFromSource<uint64_t>(gapsSource);
+      buffer.resize(static_cast<size_t>(ReadPrimitiveFromSource<uint64_t>(gapsSource)));
+      gapsSource.Read(buffer.data(), buffer.size());
+      newWriter.Seek(offset);
+      newWriter.Write(buffer.data(), buffer.size());
+    }
+  }
+
+  atomic<bool> ok(true);
+  base::ParallelFor(0, entries.size(), [&](size_t i) {
+    try
+    {
+      if (ok && !ApplySectionDiff(oldMwmPath, newMwmPath, diffPath, oldByTag, entries[i]))
+        ok = false;
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Could not apply diff of section", entries[i].m_section.m_tag, e.Msg()));
+      ok = false;
+    }
+  });
+
+  if (!ok)
+    return false;
+
+  uint64_t size = 0;
+  return base::GetFileSize(newMwmPath, size) && size == newFileSize;
+}
 }  // namespace
 
 namespace generator
@@ -90,9 +470,23 @@ bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const
     FileReader newReader(newMwmPath);
     FileWriter diffFileWriter(diffPath);
 
+    // Files which aren't valid containers are diffed as a whole.
+    vector<Section> oldSections;
+    vector<Section> newSections;
+    uint64_t oldFileSize = 0;
+    uint64_t newFileSize = 0;
+    if (!ReadSections(oldMwmPath, oldSections, oldFileSize) ||
+        !ReadSections(newMwmPath, newSections, newFileSize))
+    {
+      return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    }
+
     switch (VERSION_LATEST)
     {
     case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    case VERSION_V1:
+      return MakeDiffVersion1(oldMwmPath, newMwmPath, oldSections, newSections, newFileSize,
+                              diffFileWriter);
     default:
       LOG(LERROR,
           ("Making mwm diffs with diff format version", VERSION_LATEST, "is not implemented"));
@@ -116,8 +510,6 @@ bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string cons
 {
   try
   {
-    FileReader oldReader(oldMwmPath);
-    FileWriter newWriter(newMwmPath);
     FileReader diffFileReader(diffPath);
 
     ReaderSource<FileReader> diffFileSource(diffFileReader);
@@ -125,7 +517,13 @@ bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string cons
 
     switch (version)
     {
-    case VERSION_V0: return ApplyDiffVersion0(oldReader, newWriter, diffFileSource);
+    case VERSION_V0:
+    {
+      FileReader oldReader(oldMwmPath);
+      FileWriter newWriter(newMwmPath);
+      return ApplyDiffVersion0(oldReader, newWriter, diffFileSource);
+    }
+    case VERSION_V1: return ApplyDiffVersion1(oldMwmPath, newMwmPath, diffPath, diffFileSource);
     default: LOG(LERROR, ("Unknown version format of mwm diff:", version));
     }
   }
@@ -4,12 +4,20 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
 using namespace std;
 
 namespace generator
@@ -41,5 +49,65 @@ UNIT_TEST(IncrementalUpdates_Smoke)
 
   TEST(base::IsEqualFiles(newMwmPath1, newMwmPath2), ());
 }
+
+UNIT_TEST(IncrementalUpdates_Sections)
+{
+  string const dir = GetPlatform().WritableDir();
+  string const oldMwmPath = base::JoinFoldersToPath(dir, "sections-old.mwm");
+  string const newMwmPath1 = base::JoinFoldersToPath(dir, "sections-new1.mwm");
+  string const newMwmPath2 = base::JoinFoldersToPath(dir, "sections-new2.mwm");
+  string const diffPath = base::JoinFoldersToPath(dir, "sections.mwmdiff");
+
+  SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(oldMwmPath);
+    FileWriter::DeleteFileX(newMwmPath1);
+    FileWriter::DeleteFileX(newMwmPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  auto const makeSection = [](size_t size, uint32_t seed) {
+    mt19937 rng(seed);
+    vector<uint8_t> data(size);
+    for (auto & byte : data)
+      byte = static_cast<uint8_t>(rng());
+    return data;
+  };
+
+  auto const writeMwm = [](string const & path,
+                           vector<pair<string, vector<uint8_t>>> const & sections) {
+    FilesContainerW cont(path);
+    for (auto const & section : sections)
+      cont.Write(section.second, section.first);
+    cont.Finish();
+  };
+
+  auto const unchanged = makeSection(100000, 1);
+  auto patched = makeSection(50000, 2);
+  writeMwm(oldMwmPath, {{"unchanged", unchanged}, {"patched", patched}, {"removed", {1, 2, 3}}});
+
+  patched[100] = 0;
+  patched.insert(patched.begin() + 1000, {4, 5, 6});
+  writeMwm(newMwmPath1,
+           {{"added", makeSection(1000, 3)}, {"patched", patched}, {"unchanged", unchanged}});
+
+  TEST(MakeDiff(oldMwmPath, newMwmPath1, diffPath), ());
+  TEST(ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+  TEST(base::IsEqualFiles(newMwmPath1, newMwmPath2), ());
+
+  // The unchanged section isn't stored in the diff.
+  uint64_t diffSize = 0;
+  TEST(base::GetFileSize(diffPath, diffSize), ());
+  TEST_LESS(diffSize, unchanged.size() / 10, ());
+
+  // The diff isn't applied to another version of the old mwm.
+  base::ScopedLogAbortLevelChanger const logAbortLevel(LCRITICAL);
+  auto changed = unchanged;
+  changed[500] ^= 1;
+  writeMwm(oldMwmPath, {{"unchanged", changed}, {"patched", makeSection(50000, 2)}});
+  TEST(!ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+
+  writeMwm(oldMwmPath, {{"unchanged", unchanged}, {"patched", patched}});
+  TEST(!ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+}
 }  // namespace mwm_diff
 }  // namespace generator
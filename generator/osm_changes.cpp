@@ -0,0 +1,212 @@
+#include "generator/osm_changes.hpp"
+
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_source.hpp"
+#include "generator/osm_xml_source.hpp"
+
+#include "coding/parse_xml.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+// Passes the elements of <create>, <modify> and <delete> blocks to XMLSource as if every
+// block was a separate osm file.
+class OsmChangeSource
+{
+public:
+  explicit OsmChangeSource(OsmChangeProcessor const & processor)
+    : m_source([this, &processor](OsmElement * e) { processor(m_action, e); })
+  {
+  }
+
+  void CharData(string const &) {}
+
+  void AddAttr(string const & key, string const & value)
+  {
+    if (m_depth > 2)
+      m_source.AddAttr(key, value);
+  }
+
+  bool Push(string const & tagName)
+  {
+    if (++m_depth < 2)
+      return true;
+
+    if (m_depth == 2)
+    {
+      if (tagName == "create")
+        m_action = OsmChangeAction::Create;
+      else if (tagName == "modify")
+        m_action = OsmChangeAction::Modify;
+      else if (tagName == "delete")
+        m_action = OsmChangeAction::Delete;
+      else
+        LOG(LWARNING, ("Unknown osmChange block:", tagName));
+    }
+    return m_source.Push(tagName);
+  }
+
+  void Pop(string const & tagName)
+  {
+    if (m_depth-- >= 2)
+      m_source.Pop(tagName);
+  }
+
+private:
+  XMLSource m_source;
+  OsmChangeAction m_action = OsmChangeAction::Create;
+  size_t m_depth = 0;
+};
+}  // namespace
+
+string DebugPrint(OsmChangeAction action)
+{
+  switch (action)
+  {
+  case OsmChangeAction::Create: return "create";
+  case OsmChangeAction::Modify: return "modify";
+  case OsmChangeAction::Delete: return "delete";
+  }
+  CHECK_SWITCH();
+}
+
+void ProcessOsmChangesFromXML(SourceReader & stream, OsmChangeProcessor const & processor)
+{
+  OsmChangeSource source(processor);
+  ParseXMLSequence(stream, source);
+}
+
+// AffectedCountriesFinder -------------------------------------------------------------------------
+AffectedCountriesFinder::AffectedCountriesFinder(borders::CountriesContainer const & countries,
+                                                 cache::IntermediateDataReader * cache)
+  : m_countries(countries), m_cache(cache)
+{
+}
+
+void AffectedCountriesFinder::operator()(OsmChangeAction action, OsmElement const & element)
+{
+  switch (element.type)
+  {
+  case OsmElement::EntityType::Node:
+    // The old position is added by AddNode().
+    if (action == OsmChangeAction::Create)
+      m_createdNodes.insert(element.id);
+    if (action != OsmChangeAction::Delete)
+      m_nodes[element.id] = MercatorBounds::FromLatLon(element.lat, element.lon);
+    AddNode(element.id);
+    break;
+
+  case OsmElement::EntityType::Way:
+    // Both the old nodes and the new ones are affected.
+    if (action != OsmChangeAction::Create)
+      AddWay(element.id);
+    if (action != OsmChangeAction::Delete)
+    {
+      m_ways[element.id] = element.Nodes();
+      AddWay(element.id);
+    }
+    break;
+
+  case OsmElement::EntityType::Relation:
+    if (action != OsmChangeAction::Create && m_cache)
+    {
+      RelationElement relation;
+      if (m_cache->GetRelation(element.id, relation))
+      {
+        for (auto const & node : relation.nodes)
+          AddNode(node.first);
+        for (auto const & way : relation.ways)
+          AddWay(way.first);
+      }
+    }
+    for (auto const & member : element.Members())
+    {
+      if (member.type == OsmElement::EntityType::Node)
+        AddNode(member.ref);
+      else if (member.type == OsmElement::EntityType::Way)
+        AddWay(member.ref);
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+void AffectedCountriesFinder::AddPoint(m2::PointD const & point)
+{
+  m2::RectD const rect(point, point);
+  m_countries.ForEachInRect(rect, [&](borders::CountryPolygons const & country) {
+    if (m_affected.count(country.m_name) == 0 && country.Contains(point))
+      m_affected.insert(country.m_name);
+  });
+}
+
+void AffectedCountriesFinder::AddNode(uint64_t id)
+{
+  auto const it = m_nodes.find(id);
+  if (it != m_nodes.cend())
+    AddPoint(it->second);
+
+  // Created nodes aren't in the cache.
+  if (!m_cache || m_createdNodes.count(id) != 0)
+    return;
+
+  double lat;
+  double lon;
+  if (m_cache->GetNode(id, lat, lon))
+    AddPoint(MercatorBounds::FromLatLon(lat, lon));
+}
+
+void AffectedCountriesFinder::AddWay(uint64_t id)
+{
+  auto const it = m_ways.find(id);
+  if (it != m_ways.cend())
+  {
+    for (auto const node : it->second)
+      AddNode(node);
+    return;
+  }
+
+  WayElement way(id);
+  if (m_cache && m_cache->GetWay(id, way))
+  {
+    for (auto const node : way.nodes)
+      AddNode(node);
+  }
+}
+
+set<string> FindAffectedCountries(feature::GenerateInfo & info, string const & changesFile)
+{
+  borders::CountriesContainer countries;
+  CHECK(borders::LoadCountriesList(info.m_targetDir, countries),
+        ("Error loading country polygons files from", info.m_targetDir));
+
+  auto nodes = cache::CreatePointStorageReader(info.m_nodeStorageType,
+                                               info.GetIntermediateFileName(NODES_FILE));
+  cache::IntermediateDataReader cache(nodes, info);
+  cache.LoadIndex();
+
+  AffectedCountriesFinder finder(countries, &cache);
+  SourceReader reader(changesFile);
+  ProcessOsmChangesFromXML(reader, [&finder](OsmChangeAction action, OsmElement * e) {
+    finder(action, *e);
+  });
+
+  LOG(LINFO, ("Changes from", changesFile, "affect", finder.GetCountries().size(), "countries"));
+  return finder.GetCountries();
+}
+}  // namespace generator
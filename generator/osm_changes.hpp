@@ -0,0 +1,81 @@
+#pragma once
+
+#include "generator/borders_loader.hpp"
+#include "generator/osm_element.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace feature
+{
+struct GenerateInfo;
+}  // namespace feature
+
+namespace generator
+{
+namespace cache
+{
+class IntermediateDataReader;
+}  // namespace cache
+
+class SourceReader;
+
+enum class OsmChangeAction
+{
+  Create,
+  Modify,
+  Delete
+};
+
+std::string DebugPrint(OsmChangeAction action);
+
+using OsmChangeProcessor = std::function<void(OsmChangeAction action, OsmElement * element)>;
+
+// Reads an OsmChange file, see https://wiki.openstreetmap.org/wiki/OsmChange.
+void ProcessOsmChangesFromXML(SourceReader & stream, OsmChangeProcessor const & processor);
+
+// Finds the countries whose mwms must be regenerated after the changes: the ones which contain
+// positions of the changed nodes and of the nodes of the changed ways and relations before and
+// after the changes. The positions before the changes are taken from the intermediate data
+// of the planet without the changes.
+//
+// Members of the changed relations which are relations themselves are not followed.
+class AffectedCountriesFinder
+{
+public:
+  // |cache| may be nullptr, only the positions after the changes are used then.
+  AffectedCountriesFinder(borders::CountriesContainer const & countries,
+                          cache::IntermediateDataReader * cache);
+
+  void operator()(OsmChangeAction action, OsmElement const & element);
+
+  std::set<std::string> const & GetCountries() const { return m_affected; }
+
+private:
+  void AddPoint(m2::PointD const & point);
+  void AddNode(uint64_t id);
+  void AddWay(uint64_t id);
+
+  borders::CountriesContainer const & m_countries;
+  cache::IntermediateDataReader * m_cache;
+
+  // Nodes and ways of the changes, elements which come later may refer to them.
+  std::unordered_map<uint64_t, m2::PointD> m_nodes;
+  std::unordered_set<uint64_t> m_createdNodes;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> m_ways;
+
+  std::set<std::string> m_affected;
+};
+
+// Returns the countries affected by the changes from |changesFile| using the borders and the
+// intermediate data of |info|.
+std::set<std::string> FindAffectedCountries(feature::GenerateInfo & info,
+                                            std::string const & changesFile);
+}  // namespace generator
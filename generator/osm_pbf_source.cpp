@@ -0,0 +1,558 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <utility>
+
+using namespace std;
+
+namespace osm
+{
+namespace
+{
+// Limits from the format specification.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+// Number of blobs which are decoded at once per worker.
+size_t constexpr kBlobsPerWorker = 2;
+
+enum class WireType : uint8_t
+{
+  Varint = 0,
+  Fixed64 = 1,
+  Bytes = 2,
+  Fixed32 = 5
+};
+
+// Reader of the protobuf wire format, the messages of the PBF format are simple enough
+// to be decoded without generated code.
+class ProtoReader
+{
+public:
+  ProtoReader(char const * begin, char const * end) : m_cur(begin), m_end(end) {}
+  explicit ProtoReader(string const & s) : ProtoReader(s.data(), s.data() + s.size()) {}
+
+  // Reads the key of the next field. Returns false at the end of the message.
+  bool Next()
+  {
+    if (m_cur == m_end)
+      return false;
+    auto const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<WireType>(key & 0x7);
+    return true;
+  }
+
+  uint32_t GetField() const { return m_field; }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      if (m_cur == m_end)
+        MYTHROW(PbfSource::Exception, ("Unexpected end of a varint."));
+      auto const byte = static_cast<uint8_t>(*m_cur++);
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return value;
+    }
+    MYTHROW(PbfSource::Exception, ("Too long varint."));
+  }
+
+  int64_t ReadSVarint()
+  {
+    auto const value = ReadVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  ProtoReader ReadMessage()
+  {
+    auto const size = ReadVarint();
+    if (size > static_cast<uint64_t>(m_end - m_cur))
+      MYTHROW(PbfSource::Exception, ("Field", m_field, "is out of the message."));
+    ProtoReader message(m_cur, m_cur + size);
+    m_cur += size;
+    return message;
+  }
+
+  string ReadString()
+  {
+    auto const message = ReadMessage();
+    return string(message.m_cur, message.m_end);
+  }
+
+  // Packed repeated fields are also accepted unpacked.
+  template <typename Fn>
+  void ReadPacked(Fn && fn)
+  {
+    if (m_wireType != WireType::Bytes)
+    {
+      fn(*this);
+      return;
+    }
+
+    auto packed = ReadMessage();
+    while (packed.m_cur != packed.m_end)
+      fn(packed);
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+    case WireType::Varint: ReadVarint(); return;
+    case WireType::Fixed64: Advance(8); return;
+    case WireType::Bytes: ReadMessage(); return;
+    case WireType::Fixed32: Advance(4); return;
+    }
+    MYTHROW(PbfSource::Exception, ("Unsupported wire type", static_cast<int>(m_wireType)));
+  }
+
+private:
+  void Advance(size_t size)
+  {
+    if (size > static_cast<size_t>(m_end - m_cur))
+      MYTHROW(PbfSource::Exception, ("Unexpected end of a message."));
+    m_cur += size;
+  }
+
+  char const * m_cur;
+  char const * m_end;
+  uint32_t m_field = 0;
+  WireType m_wireType = WireType::Varint;
+};
+
+struct BlockContext
+{
+  double GetLat(int64_t lat) const { return 1e-9 * (m_latOffset + m_granularity * lat); }
+  double GetLon(int64_t lon) const { return 1e-9 * (m_lonOffset + m_granularity * lon); }
+
+  string const & GetString(uint64_t index) const
+  {
+    if (index >= m_strings.size())
+      MYTHROW(PbfSource::Exception, ("String index", index, "is out of the table."));
+    return m_strings[index];
+  }
+
+  vector<string> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+
+void AddTags(BlockContext const & context, vector<uint32_t> const & keys,
+             vector<uint32_t> const & values, OsmElement & element)
+{
+  if (keys.size() != values.size())
+    MYTHROW(PbfSource::Exception, ("Different numbers of keys and values of", element.id));
+  for (size_t i = 0; i < keys.size(); ++i)
+    element.AddTag(context.GetString(keys[i]), context.GetString(values[i]));
+}
+
+void DecodeNode(BlockContext const & context, ProtoReader node, PbfSource::Elements & elements)
+{
+  OsmElement element;
+  element.type = OsmElement::EntityType::Node;
+  vector<uint32_t> keys;
+  vector<uint32_t> values;
+  while (node.Next())
+  {
+    switch (node.GetField())
+    {
+    case 1: element.id = static_cast<uint64_t>(node.ReadSVarint()); break;
+    case 2:
+      node.ReadPacked([&keys](ProtoReader & r) { keys.push_back(r.ReadVarint()); });
+      break;
+    case 3:
+      node.ReadPacked([&values](ProtoReader & r) { values.push_back(r.ReadVarint()); });
+      break;
+    case 8: element.lat = context.GetLat(node.ReadSVarint()); break;
+    case 9: element.lon = context.GetLon(node.ReadSVarint()); break;
+    default: node.Skip(); break;
+    }
+  }
+  AddTags(context, keys, values, element);
+  elements.push_back(move(element));
+}
+
+void DecodeDenseNodes(BlockContext const & context, ProtoReader dense,
+                      PbfSource::Elements & elements)
+{
+  vector<int64_t> ids;
+  vector<int64_t> lats;
+  vector<int64_t> lons;
+  vector<uint32_t> keysValues;
+  while (dense.Next())
+  {
+    switch (dense.GetField())
+    {
+    case 1: dense.ReadPacked([&ids](ProtoReader & r) { ids.push_back(r.ReadSVarint()); }); break;
+    case 8: dense.ReadPacked([&lats](ProtoReader & r) { lats.push_back(r.ReadSVarint()); }); break;
+    case 9: dense.ReadPacked([&lons](ProtoReader & r) { lons.push_back(r.ReadSVarint()); }); break;
+    case 10:
+      dense.ReadPacked([&keysValues](ProtoReader & r) { keysValues.push_back(r.ReadVarint()); });
+      break;
+    default: dense.Skip(); break;
+    }
+  }
+
+  if (lats.size() != ids.size() || lons.size() != ids.size())
+    MYTHROW(PbfSource::Exception, ("Different numbers of ids and coordinates of dense nodes."));
+
+  // Ids and coordinates are delta coded, tags of the nodes are separated by zeros.
+  int64_t id = 0;
+  int64_t lat = 0;
+  int64_t lon = 0;
+  size_t kv = 0;
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    id += ids[i];
+    lat += lats[i];
+    lon += lons[i];
+
+    OsmElement element;
+    element.type = OsmElement::EntityType::Node;
+    element.id = static_cast<uint64_t>(id);
+    element.lat = context.GetLat(lat);
+    element.lon = context.GetLon(lon);
+
+    while (kv < keysValues.size() && keysValues[kv] != 0)
+    {
+      if (kv + 1 == keysValues.size())
+        MYTHROW(PbfSource::Exception, ("Key without a value of node", element.id));
+      element.AddTag(context.GetString(keysValues[kv]), context.GetString(keysValues[kv + 1]));
+      kv += 2;
+    }
+    ++kv;
+
+    elements.push_back(move(element));
+  }
+}
+
+void DecodeWay(BlockContext const & context, ProtoReader way, PbfSource::Elements & elements)
+{
+  OsmElement element;
+  element.type = OsmElement::EntityType::Way;
+  vector<uint32_t> keys;
+  vector<uint32_t> values;
+  int64_t ref = 0;
+  while (way.Next())
+  {
+    switch (way.GetField())
+    {
+    case 1: element.id = way.ReadVarint(); break;
+    case 2: way.ReadPacked([&keys](ProtoReader & r) { keys.push_back(r.ReadVarint()); }); break;
+    case 3:
+      way.ReadPacked([&values](ProtoReader & r) { values.push_back(r.ReadVarint()); });
+      break;
+    case 8:
+      way.ReadPacked([&](ProtoReader & r) {
+        ref += r.ReadSVarint();
+        element.AddNd(static_cast<uint64_t>(ref));
+      });
+      break;
+    default: way.Skip(); break;
+    }
+  }
+  AddTags(context, keys, values, element);
+  elements.push_back(move(element));
+}
+
+void DecodeRelation(BlockContext const & context, ProtoReader relation,
+                    PbfSource::Elements & elements)
+{
+  OsmElement element;
+  element.type = OsmElement::EntityType::Relation;
+  vector<uint32_t> keys;
+  vector<uint32_t> values;
+  vector<uint32_t> roles;
+  vector<int64_t> ids;
+  vector<uint64_t> types;
+  while (relation.Next())
+  {
+    switch (relation.GetField())
+    {
+    case 1: element.id = relation.ReadVarint(); break;
+    case 2:
+      relation.ReadPacked([&keys](ProtoReader & r) { keys.push_back(r.ReadVarint()); });
+      break;
+    case 3:
+      relation.ReadPacked([&values](ProtoReader & r) { values.push_back(r.ReadVarint()); });
+      break;
+    case 8:
+      relation.ReadPacked([&roles](ProtoReader & r) { roles.push_back(r.ReadVarint()); });
+      break;
+    case 9:
+      relation.ReadPacked([&ids](ProtoReader & r) { ids.push_back(r.ReadSVarint()); });
+      break;
+    case 10:
+      relation.ReadPacked([&types](ProtoReader & r) { types.push_back(r.ReadVarint()); });
+      break;
+    default: relation.Skip(); break;
+    }
+  }
+
+  if (roles.size() != ids.size() || types.size() != ids.size())
+    MYTHROW(PbfSource::Exception, ("Inconsistent members of relation", element.id));
+
+  int64_t id = 0;
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    id += ids[i];
+    auto type = OsmElement::EntityType::Unknown;
+    switch (types[i])
+    {
+    case 0: type = OsmElement::EntityType::Node; break;
+    case 1: type = OsmElement::EntityType::Way; break;
+    case 2: type = OsmElement::EntityType::Relation; break;
+    default: break;
+    }
+    element.AddMember(static_cast<uint64_t>(id), type, context.GetString(roles[i]));
+  }
+  AddTags(context, keys, values, element);
+  elements.push_back(move(element));
+}
+
+void DecodeGroup(BlockContext const & context, ProtoReader group, PbfSource::Elements & elements)
+{
+  while (group.Next())
+  {
+    switch (group.GetField())
+    {
+    case 1: DecodeNode(context, group.ReadMessage(), elements); break;
+    case 2: DecodeDenseNodes(context, group.ReadMessage(), elements); break;
+    case 3: DecodeWay(context, group.ReadMessage(), elements); break;
+    case 4: DecodeRelation(context, group.ReadMessage(), elements); break;
+    default: group.Skip(); break;
+    }
+  }
+}
+}  // namespace
+
+PbfSource::PbfSource(ReadFunc const & reader, base::TaskScheduler * scheduler)
+  : m_reader(reader), m_scheduler(scheduler)
+{
+  if (m_scheduler != nullptr && m_scheduler->GetWorkersCount() == 0)
+    m_scheduler = nullptr;
+}
+
+void PbfSource::ForEach(Processor const & processor)
+{
+  auto const process = [&processor](Elements & elements) {
+    for (auto & element : elements)
+      processor(&element);
+  };
+
+  size_t const maxPending = m_scheduler ? kBlobsPerWorker * m_scheduler->GetWorkersCount() : 0;
+  deque<future<Elements>> pending;
+
+  bool hasHeader = false;
+  Blob blob;
+  while (ReadBlob(blob))
+  {
+    if (blob.m_type == "OSMHeader")
+    {
+      CheckHeader(Decompress(blob.m_data));
+      hasHeader = true;
+      continue;
+    }
+
+    // Unknown blobs must be skipped.
+    if (blob.m_type != "OSMData")
+      continue;
+
+    if (!hasHeader)
+      MYTHROW(Exception, ("OSMData blob before OSMHeader."));
+
+    auto decode = [](string const & data) { return DecodeBlock(Decompress(data)); };
+    if (!m_scheduler)
+    {
+      auto elements = decode(blob.m_data);
+      process(elements);
+      continue;
+    }
+
+    promise<Elements> result;
+    pending.push_back(result.get_future());
+    m_scheduler->Push(
+        [decode, data = move(blob.m_data), result = move(result)]() mutable {
+          try
+          {
+            result.set_value(decode(data));
+          }
+          catch (...)
+          {
+            result.set_exception(current_exception());
+          }
+        },
+        base::TaskScheduler::Priority::Normal);
+
+    for (; pending.size() >= maxPending; pending.pop_front())
+    {
+      auto elements = pending.front().get();
+      process(elements);
+    }
+  }
+
+  for (; !pending.empty(); pending.pop_front())
+  {
+    auto elements = pending.front().get();
+    process(elements);
+  }
+}
+
+// static
+PbfSource::Elements PbfSource::DecodeBlock(string const & block)
+{
+  BlockContext context;
+  vector<ProtoReader> groups;
+  ProtoReader reader(block);
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1:
+    {
+      auto table = reader.ReadMessage();
+      while (table.Next())
+      {
+        if (table.GetField() == 1)
+          context.m_strings.push_back(table.ReadString());
+        else
+          table.Skip();
+      }
+      break;
+    }
+    case 2: groups.push_back(reader.ReadMessage()); break;
+    case 17: context.m_granularity = static_cast<int64_t>(reader.ReadVarint()); break;
+    case 19: context.m_latOffset = static_cast<int64_t>(reader.ReadVarint()); break;
+    case 20: context.m_lonOffset = static_cast<int64_t>(reader.ReadVarint()); break;
+    default: reader.Skip(); break;
+    }
+  }
+
+  // Groups are decoded after the whole block is read because the granularity may follow them.
+  Elements elements;
+  for (auto const & group : groups)
+    DecodeGroup(context, group, elements);
+  return elements;
+}
+
+bool PbfSource::ReadBlob(Blob & blob)
+{
+  uint8_t sizeBytes[4];
+  if (!ReadExactly(sizeBytes, sizeof(sizeBytes)))
+    return false;
+
+  // Size of BlobHeader is in network byte order.
+  uint32_t const headerSize = (static_cast<uint32_t>(sizeBytes[0]) << 24) |
+                              (static_cast<uint32_t>(sizeBytes[1]) << 16) |
+                              (static_cast<uint32_t>(sizeBytes[2]) << 8) | sizeBytes[3];
+  if (headerSize > kMaxBlobHeaderSize)
+    MYTHROW(Exception, ("Too large blob header:", headerSize));
+
+  string header(headerSize, '\0');
+  if (!ReadExactly(&header[0], header.size()))
+    MYTHROW(Exception, ("Unexpected end of a blob header."));
+
+  blob.m_type.clear();
+  uint64_t dataSize = 0;
+  ProtoReader reader(header);
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: blob.m_type = reader.ReadString(); break;
+    case 3: dataSize = reader.ReadVarint(); break;
+    default: reader.Skip(); break;
+    }
+  }
+
+  if (dataSize > kMaxBlobSize)
+    MYTHROW(Exception, ("Too large blob:", dataSize));
+
+  blob.m_data.assign(dataSize, '\0');
+  if (!ReadExactly(&blob.m_data[0], blob.m_data.size()))
+    MYTHROW(Exception, ("Unexpected end of a blob."));
+  return true;
+}
+
+bool PbfSource::ReadExactly(void * buffer, size_t size)
+{
+  auto * data = static_cast<uint8_t *>(buffer);
+  size_t read = 0;
+  while (read < size)
+  {
+    auto const n = m_reader(data + read, size - read);
+    if (n == 0)
+    {
+      if (read != 0)
+        MYTHROW(Exception, ("Unexpected end of the file."));
+      return false;
+    }
+    read += n;
+  }
+  return true;
+}
+
+// static
+string PbfSource::Decompress(string const & blob)
+{
+  string raw;
+  string zlibData;
+  uint64_t rawSize = 0;
+  ProtoReader reader(blob);
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: raw = reader.ReadString(); break;
+    case 2: rawSize = reader.ReadVarint(); break;
+    case 3: zlibData = reader.ReadString(); break;
+    case 4: MYTHROW(Exception, ("LZMA compressed blobs aren't supported."));
+    default: reader.Skip(); break;
+    }
+  }
+
+  if (zlibData.empty())
+    return raw;
+
+  if (rawSize > kMaxBlobSize)
+    MYTHROW(Exception, ("Too large raw blob:", rawSize));
+
+  string block;
+  block.reserve(rawSize);
+  coding::ZLib::Inflate inflate(coding::ZLib::Inflate::Format::ZLib);
+  if (!inflate(zlibData, back_inserter(block)) || block.size() != rawSize)
+    MYTHROW(Exception, ("Can't inflate a blob."));
+  return block;
+}
+
+// static
+void PbfSource::CheckHeader(string const & block)
+{
+  ProtoReader reader(block);
+  while (reader.Next())
+  {
+    if (reader.GetField() != 4)
+    {
+      reader.Skip();
+      continue;
+    }
+
+    auto const feature = reader.ReadString();
+    if (feature != "OsmSchema-V0.6" && feature != "DenseNodes")
+      MYTHROW(Exception, ("Unsupported required feature:", feature));
+  }
+}
+}  // namespace osm
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include "base/exception.hpp"
+#include "base/task_scheduler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osm
+{
+// Reader of OSM PBF files, see https://wiki.openstreetmap.org/wiki/PBF_Format.
+//
+// Blobs are read sequentially by the calling thread, while their decompression and decoding
+// are done by the task scheduler. At most a couple of blobs per worker are decoded at once,
+// and the elements are passed to the processor in the order of the file.
+class PbfSource
+{
+public:
+  DECLARE_EXCEPTION(Exception, RootException);
+
+  using ReadFunc = std::function<size_t(uint8_t * buffer, size_t size)>;
+  using Processor = std::function<void(OsmElement *)>;
+  using Elements = std::vector<OsmElement>;
+
+  // |scheduler| may be nullptr, blobs are decoded by the calling thread then.
+  explicit PbfSource(ReadFunc const & reader,
+                     base::TaskScheduler * scheduler = &base::TaskScheduler::Instance());
+
+  // Throws Exception when the file is malformed or needs unsupported features.
+  void ForEach(Processor const & processor);
+
+  // Decodes an uncompressed OSMData block.
+  static Elements DecodeBlock(std::string const & block);
+
+private:
+  struct Blob
+  {
+    std::string m_type;
+    std::string m_data;
+  };
+
+  // Returns false at the end of the file.
+  bool ReadBlob(Blob & blob);
+  bool ReadExactly(void * buffer, size_t size);
+
+  static std::string Decompress(std::string const & blob);
+  static void CheckHeader(std::string const & block);
+
+  ReadFunc m_reader;
+  base::TaskScheduler * m_scheduler;
+};
+}  // namespace osm
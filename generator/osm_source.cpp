@@ -11,6 +11,7 @@
 #include "generator/node_mixer.hpp"
 #include "generator/osm_element.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/polygonizer.hpp"
 #include "generator/regions/collector_region_info.hpp"
@@ -224,6 +225,24 @@ void ProcessOsmElementsFromO5M(SourceReader & stream, function<void(OsmElement *
   }
 }
 
+void BuildIntermediateDataFromPBF(SourceReader & stream, cache::IntermediateDataWriter & cache,
+                                  TownsDumper & towns, CameraNodeIntermediateDataProcessor & cameras)
+{
+  ProcessOsmElementsFromPBF(stream, [&cache, &cameras, &towns](OsmElement * em) {
+    towns.CheckElement(*em);
+    AddElementToCache(cache, cameras, *em);
+  });
+}
+
+void ProcessOsmElementsFromPBF(SourceReader & stream, function<void(OsmElement *)> processor)
+{
+  osm::PbfSource source([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  });
+  source.ForEach(processor);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -256,6 +275,9 @@ static bool GenerateRaw(feature::GenerateInfo & info, PreEmit const & preEmit,
     case feature::GenerateInfo::OsmSourceType::O5M:
       ProcessOsmElementsFromO5M(reader, fn);
       break;
+    case feature::GenerateInfo::OsmSourceType::PBF:
+      ProcessOsmElementsFromPBF(reader, fn);
+      break;
     }
 
     LOG(LINFO, ("Processing", info.m_osmFileName, "done."));
@@ -368,6 +390,9 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
     case feature::GenerateInfo::OsmSourceType::O5M:
       BuildIntermediateDataFromO5M(reader, cache, towns, cameras);
       break;
+    case feature::GenerateInfo::OsmSourceType::PBF:
+      BuildIntermediateDataFromPBF(reader, cache, towns, cameras);
+      break;
     }
 
     cache.SaveIndex();
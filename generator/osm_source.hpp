@@ -47,4 +47,6 @@ bool GenerateIntermediateData(feature::GenerateInfo & info);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement *)> processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement *)> processor);
+// Blocks of the file are decoded in parallel, the elements are processed in the file order.
+void ProcessOsmElementsFromPBF(SourceReader & stream, std::function<void(OsmElement *)> processor);
 }  // namespace generator
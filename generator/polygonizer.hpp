@@ -78,24 +78,17 @@ namespace feature
 
     struct PointChecker
     {
-      borders::RegionsContainer const & m_regions;
+      borders::CountryPolygons const & m_country;
       bool m_belongs;
 
-      PointChecker(borders::RegionsContainer const & regions)
-        : m_regions(regions), m_belongs(false) {}
+      PointChecker(borders::CountryPolygons const & country)
+        : m_country(country), m_belongs(false) {}
 
       bool operator()(m2::PointD const & pt)
       {
-        m_regions.ForEachInRect(m2::RectD(pt, pt),
-                                std::bind<void>(std::ref(*this), std::placeholders::_1, std::cref(pt)));
+        m_belongs = m_country.Contains(pt);
         return !m_belongs;
       }
-
-      void operator() (borders::Region const & rgn, borders::Region::Value const & point)
-      {
-        if (!m_belongs)
-          m_belongs = rgn.Contains(point);
-      }
     };
 
     class InsertCountriesPtr
@@ -196,7 +189,7 @@ namespace feature
       {
         for (size_t i = 0; i < m_Countries.size(); ++i)
         {
-          PointChecker doCheck(m_Countries[i]->m_regions);
+          PointChecker doCheck(*m_Countries[i]);
           m_fb.ForEachGeometryPoint(doCheck);
 
           if (doCheck.m_belongs)
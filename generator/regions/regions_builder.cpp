@@ -1,6 +1,7 @@
 #include "generator/regions/regions_builder.hpp"
 
 #include "base/assert.hpp"
+#include "base/parallel.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
@@ -9,10 +10,9 @@
 #include <functional>
 #include <numeric>
 #include <queue>
-#include <thread>
 #include <unordered_set>
 
-#include "3party/ThreadPool/ThreadPool.h"
+#include <boost/geometry/index/rtree.hpp>
 
 namespace generator
 {
@@ -115,71 +115,101 @@ Node::PtrList RegionsBuilder::MakeSelectedRegionsByCountry(Region const & countr
   return nodes;
 }
 
-Node::Ptr RegionsBuilder::BuildCountryRegionTree(Region const & country,
-                                                 Regions const & allRegions)
+std::vector<size_t> RegionsBuilder::FindParents(Node::PtrList const & nodes,
+                                                base::TaskScheduler & scheduler)
 {
-  auto nodes = MakeSelectedRegionsByCountry(country, allRegions);
-  while (nodes.size() > 1)
-  {
-    auto itFirstNode = std::rbegin(nodes);
-    auto & firstRegion = (*itFirstNode)->GetData();
-    auto itCurr = itFirstNode + 1;
-    for (; itCurr != std::rend(nodes); ++itCurr)
+  // Only regions whose rects cover the rect of a region may contain it, so candidates are
+  // taken from the R-tree instead of checking all larger regions.
+  using Value = std::pair<BoostRect, size_t>;
+  using Tree = boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>>;
+  std::vector<Value> values;
+  values.reserve(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i)
+    values.emplace_back(nodes[i]->GetData().GetRect(), i);
+  Tree const tree(values.begin(), values.end());
+
+  std::vector<size_t> parents(nodes.size(), kNoParent);
+  base::ParallelFor(1, nodes.size(), [&](size_t i) {
+    auto const & region = nodes[i]->GetData();
+    std::vector<Value> candidates;
+    tree.query(boost::geometry::index::covers(region.GetRect()), std::back_inserter(candidates));
+    // The parent is the smallest of the larger regions which contain the region.
+    std::sort(candidates.begin(), candidates.end(),
+              [](Value const & l, Value const & r) { return l.second > r.second; });
+    for (auto const & candidate : candidates)
     {
-      auto const & currRegion = (*itCurr)->GetData();
+      if (candidate.second >= i)
+        continue;
+
+      auto const & currRegion = nodes[candidate.second]->GetData();
       // If Contains returns false, then we calculate the percent overlap of polygons.
       // We believe that if one polygon overlaps by 98 percent, then we can assume that one
       // contains another.
       auto const kAvaliableOverlapPercentage = 98;
-      if (currRegion.ContainsRect(firstRegion) &&
-          (currRegion.Contains(firstRegion) ||
-           currRegion.CalculateOverlapPercentage(firstRegion) > kAvaliableOverlapPercentage))
+      if (currRegion.Contains(region) ||
+          currRegion.CalculateOverlapPercentage(region) > kAvaliableOverlapPercentage)
       {
-        // In general, we assume that a region with the larger rank has the larger area.
-        // But sometimes it does not. In this case, we will make an inversion.
-        if (firstRegion.GetRank() < currRegion.GetRank())
-        {
-          (*itCurr)->SetParent(*itFirstNode);
-          (*itFirstNode)->AddChild(*itCurr);
-        }
-        else
-        {
-          (*itFirstNode)->SetParent(*itCurr);
-          (*itCurr)->AddChild(*itFirstNode);
-        }
-        // We want to free up memory.
-        firstRegion.DeletePolygon();
-        nodes.pop_back();
+        parents[i] = candidate.second;
         break;
       }
     }
+  }, 1 /* minChunkSize */, scheduler);
 
-    if (itCurr == std::rend(nodes))
-      nodes.pop_back();
-  }
-
-  return nodes.empty() ? std::shared_ptr<Node>() : nodes.front();
+  return parents;
 }
 
-void RegionsBuilder::MakeCountryTrees(Regions const & regions)
+Node::Ptr RegionsBuilder::BuildCountryRegionTree(Region const & country,
+                                                 Regions const & allRegions,
+                                                 base::TaskScheduler & scheduler)
 {
-  std::vector<std::future<Node::Ptr>> results;
+  auto nodes = MakeSelectedRegionsByCountry(country, allRegions);
+  auto const parents = FindParents(nodes, scheduler);
+  // Nodes are linked from the smallest one, as the parents are found with all polygons.
+  for (size_t i = nodes.size(); i > 1; --i)
   {
-    int const cpuCount = m_cpuCount > 0 ? m_cpuCount : std::thread::hardware_concurrency();
-    ASSERT_GREATER(cpuCount, 0, ());
-    ThreadPool threadPool(cpuCount);
-    for (auto const & country : GetCountries())
+    auto const & firstNode = nodes[i - 1];
+    if (parents[i - 1] == kNoParent)
+      continue;
+
+    auto const & currNode = nodes[parents[i - 1]];
+    auto & firstRegion = firstNode->GetData();
+    // In general, we assume that a region with the larger rank has the larger area.
+    // But sometimes it does not. In this case, we will make an inversion.
+    if (firstRegion.GetRank() < currNode->GetData().GetRank())
     {
-      auto result = threadPool.enqueue(&RegionsBuilder::BuildCountryRegionTree, country, regions);
-      results.emplace_back(std::move(result));
+      currNode->SetParent(firstNode);
+      firstNode->AddChild(currNode);
     }
+    else
+    {
+      firstNode->SetParent(currNode);
+      currNode->AddChild(firstNode);
+    }
+    // We want to free up memory.
+    firstRegion.DeletePolygon();
   }
 
-  for (auto & result : results)
-  {
-    auto tree = result.get();
+  return nodes.empty() ? std::shared_ptr<Node>() : nodes.front();
+}
+
+void RegionsBuilder::MakeCountryTrees(Regions const & regions)
+{
+  // The calling thread works too, so |m_cpuCount| threads need one worker less.
+  std::unique_ptr<base::TaskScheduler> ownScheduler;
+  if (m_cpuCount > 0)
+    ownScheduler = std::make_unique<base::TaskScheduler>(static_cast<size_t>(m_cpuCount - 1));
+  auto & scheduler = ownScheduler ? *ownScheduler : base::TaskScheduler::Instance();
+
+  // Countries and regions of a country are processed in parallel, so large countries don't
+  // take a thread for a long time.
+  auto const & countries = GetCountries();
+  std::vector<Node::Ptr> trees(countries.size());
+  base::ParallelFor(0, countries.size(), [&](size_t i) {
+    trees[i] = BuildCountryRegionTree(countries[i], regions, scheduler);
+  }, 1 /* minChunkSize */, scheduler);
+
+  for (auto & tree : trees)
     m_countryTrees.emplace(tree->GetData().GetName(), std::move(tree));
-  }
 }
 
 Node::Ptr RegionsBuilder::GetNormalizedCountryTree(std::string const & name)
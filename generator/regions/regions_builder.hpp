@@ -4,6 +4,9 @@
 #include "generator/regions/region.hpp"
 #include "generator/regions/to_string_policy.hpp"
 
+#include "base/task_scheduler.hpp"
+
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -35,9 +38,16 @@ public:
   Node::Ptr GetNormalizedCountryTree(std::string const & name);
 
 private:
+  static size_t constexpr kNoParent = static_cast<size_t>(-1);
+
   static Node::PtrList MakeSelectedRegionsByCountry(Region const & country,
                                                     Regions const & allRegions);
-  static Node::Ptr BuildCountryRegionTree(Region const & country, Regions const & allRegions);
+  // Returns for every node the index of its parent in |nodes| or kNoParent. |nodes| are sorted
+  // by area in the descending order.
+  static std::vector<size_t> FindParents(Node::PtrList const & nodes,
+                                         base::TaskScheduler & scheduler);
+  static Node::Ptr BuildCountryRegionTree(Region const & country, Regions const & allRegions,
+                                          base::TaskScheduler & scheduler);
   void MakeCountryTrees(Regions const & regions);
 
   std::unique_ptr<ToStringPolicyInterface> m_toStringPolicy;
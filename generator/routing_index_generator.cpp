@@ -11,6 +11,8 @@
 #include "routing/index_graph.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/landmarks.hpp"
+#include "routing/mapped_index_graph_serialization.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/bicycle_model.hpp"
@@ -36,13 +38,20 @@
 #include "base/checked_cast.hpp"
 #include "base/geo_object_id.hpp"
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
+#include "base/task_scheduler.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <queue>
+#include <unordered_set>
 #include <unordered_map>
 #include <vector>
 
@@ -159,6 +168,7 @@ public:
   using Vertex = Segment;
   using Edge = SegmentEdge;
   using Weight = RouteWeight;
+  using VertexHasher = Segment::Hash;
 
   explicit DijkstraWrapper(IndexGraph & graph) : m_graph(graph) {}
 
@@ -356,12 +366,23 @@ void CalcCrossMwmConnectors(
       ", elapsed:", timer.ElapsedSeconds(), "seconds"));
 
   timer.Reset();
-  sort(transitions.begin(), transitions.end(),
-       [&](CrossMwmConnectorSerializer::Transition<CrossMwmId> const & lhs,
-           CrossMwmConnectorSerializer::Transition<CrossMwmId> const & rhs) {
-         return CalcDistanceAlongTheBorders(borders, lhs) <
-                CalcDistanceAlongTheBorders(borders, rhs);
-       });
+  // The distances take a walk along the borders, so they are calculated once per transition
+  // and in parallel rather than in every comparison.
+  vector<double> distances(transitions.size());
+  base::ParallelFor(0, transitions.size(), [&](size_t i) {
+    distances[i] = CalcDistanceAlongTheBorders(borders, transitions[i]);
+  });
+
+  vector<size_t> order(transitions.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(),
+       [&distances](size_t lhs, size_t rhs) { return distances[lhs] < distances[rhs]; });
+
+  vector<CrossMwmConnectorSerializer::Transition<CrossMwmId>> sorted;
+  sorted.reserve(transitions.size());
+  for (auto const i : order)
+    sorted.push_back(move(transitions[i]));
+  transitions = move(sorted);
 
   LOG(LINFO, ("Transition sorted in", timer.ElapsedSeconds(), "seconds"));
 
@@ -383,68 +404,182 @@ void CalcCrossMwmConnectors(
   }
 }
 
-template <typename CrossMwmId>
-void FillWeights(string const & path, string const & mwmFile, string const & country,
-                 CountryParentNameGetterFn const & countryParentNameGetterFn,
-                 bool disableCrossMwmProgress, CrossMwmConnector<CrossMwmId> & connector)
+shared_ptr<VehicleModelInterface> GetVehicleModel(
+    VehicleType vehicleType, string const & country,
+    CountryParentNameGetterFn const & countryParentNameGetterFn)
 {
-  base::Timer timer;
+  switch (vehicleType)
+  {
+  case VehicleType::Pedestrian:
+    return PedestrianModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  case VehicleType::Bicycle:
+    return BicycleModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  case VehicleType::Car:
+    return CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  case VehicleType::Transit:
+  case VehicleType::Count:
+    CHECK(false, ("Can't create vehicle model for", vehicleType));
+    return nullptr;
+  }
+  CHECK_SWITCH();
+}
 
+unique_ptr<IndexGraph> LoadIndexGraph(VehicleType vehicleType, string const & path,
+                                      string const & mwmFile, string const & country,
+                                      CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
   shared_ptr<VehicleModelInterface> vehicleModel =
-      CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
-  IndexGraph graph(
+      GetVehicleModel(vehicleType, country, countryParentNameGetterFn);
+  auto graph = make_unique<IndexGraph>(
       make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel)),
-      EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */));
+      EdgeEstimator::Create(vehicleType, *vehicleModel, nullptr /* trafficStash */));
 
   MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  DeserializeIndexGraph(mwmValue, VehicleType::Car, graph);
+  DeserializeIndexGraph(mwmValue, vehicleType, *graph);
+  return graph;
+}
 
-  map<Segment, map<Segment, RouteWeight>> weights;
-  auto const numEnters = connector.GetEnters().size();
-  size_t foundCount = 0;
-  size_t notFoundCount = 0;
-  for (size_t i = 0; i < numEnters; ++i)
-  {
-    if (!disableCrossMwmProgress && (i % 10 == 0) && (i != 0))
-      LOG(LINFO, ("Building leaps:", i, "/", numEnters, "waves passed"));
+// Waves from the enters are independent, so they are propagated on all workers of |scheduler|.
+// Geometry of IndexGraph is cached and isn't thread-safe, every chunk loads its own graph
+// and takes the enters one by one until all of them are done.
+template <typename CrossMwmId>
+void FillWeights(VehicleType vehicleType, string const & path, string const & mwmFile,
+                 string const & country,
+                 CountryParentNameGetterFn const & countryParentNameGetterFn,
+                 bool disableCrossMwmProgress, CrossMwmConnector<CrossMwmId> & connector,
+                 base::TaskScheduler & scheduler = base::TaskScheduler::Instance())
+{
+  base::Timer timer;
 
-    Segment const & enter = connector.GetEnter(i);
+  auto const & enters = connector.GetEnters();
+  auto const & exits = connector.GetExits();
+  unordered_map<Segment, size_t, Segment::Hash> exitToIdx;
+  for (size_t i = 0; i < exits.size(); ++i)
+    exitToIdx.emplace(exits[i], i);
 
+  auto const numEnters = enters.size();
+  // Weights of the routes from the enter |i| to the exit |j| are at |i| * exits.size() + |j|.
+  vector<double> weights(numEnters * exits.size(), connector::kNoRoute);
+  atomic<size_t> nextEnter(0);
+  atomic<size_t> wavesPassed(0);
+  atomic<size_t> foundCount(0);
+
+  size_t const chunksCount = min(scheduler.GetWorkersCount() + 1, numEnters);
+  base::parallel::RunChunks(chunksCount, [&](size_t /* chunk */) {
+    auto graph = LoadIndexGraph(vehicleType, path, mwmFile, country, countryParentNameGetterFn);
+
+    // The same context is used for all the waves of the chunk to reuse its memory.
     AStarAlgorithm<DijkstraWrapper> astar;
-    DijkstraWrapper wrapper(graph);
+    DijkstraWrapper wrapper(*graph);
     AStarAlgorithm<DijkstraWrapper>::Context context;
-    astar.PropagateWave(wrapper, enter,
-                        [](Segment const & /* vertex */) { return true; } /* visitVertex */,
-                        context);
-
-    for (Segment const & exit : connector.GetExits())
+    size_t found = 0;
+    for (size_t i = nextEnter++; i < numEnters; i = nextEnter++)
     {
-      if (context.HasDistance(exit))
-      {
-        weights[enter][exit] = context.GetDistance(exit);
-        ++foundCount;
-      }
-      else
+      // Distance of a vertex is final when the vertex is visited. So the wave may be stopped
+      // as soon as all the exits are visited.
+      size_t exitsToVisit = exits.size();
+      astar.PropagateWave(wrapper, enters[i],
+                          [&](Segment const & vertex) {
+                            if (exitToIdx.count(vertex) != 0)
+                              --exitsToVisit;
+                            return exitsToVisit != 0;
+                          } /* visitVertex */,
+                          context);
+
+      for (size_t j = 0; j < exits.size(); ++j)
       {
-        ++notFoundCount;
+        if (context.HasDistance(exits[j]))
+        {
+          weights[i * exits.size() + j] = context.GetDistance(exits[j]).ToCrossMwmWeight();
+          ++found;
+        }
       }
+
+      auto const passed = ++wavesPassed;
+      if (!disableCrossMwmProgress && passed % 10 == 0)
+        LOG(LINFO, (vehicleType, "leaps:", passed, "/", numEnters, "waves passed"));
     }
-  }
+    foundCount += found;
+  }, scheduler);
+
+  unordered_map<Segment, size_t, Segment::Hash> enterToIdx;
+  for (size_t i = 0; i < numEnters; ++i)
+    enterToIdx.emplace(enters[i], i);
 
   connector.FillWeights([&](Segment const & enter, Segment const & exit) {
-    auto it0 = weights.find(enter);
-    if (it0 == weights.end())
-      return connector::kNoRoute;
+    auto const enterIt = enterToIdx.find(enter);
+    auto const exitIt = exitToIdx.find(exit);
+    CHECK(enterIt != enterToIdx.cend() && exitIt != exitToIdx.cend(), (enter, exit));
+    return weights[enterIt->second * exits.size() + exitIt->second];
+  });
 
-    auto it1 = it0->second.find(exit);
-    if (it1 == it0->second.end())
-      return connector::kNoRoute;
+  LOG(LINFO, (vehicleType, "leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
+              foundCount.load(), ", not found:", weights.size() - foundCount));
+}
+
+template <typename ToDo>
+void ForEachLandmarksSegment(vector<uint32_t> const & numSegments, ToDo && toDo)
+{
+  for (uint32_t featureId = 0; featureId < numSegments.size(); ++featureId)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx < numSegments[featureId]; ++segmentIdx)
+    {
+      toDo(Segment(kFakeNumMwmId, featureId, segmentIdx, true /* forward */));
+      toDo(Segment(kFakeNumMwmId, featureId, segmentIdx, false /* forward */));
+    }
+  }
+}
 
-    return it1->second.ToCrossMwmWeight();
+// Fills weights of the routes from (|fromLandmark| == true) or to (|fromLandmark| == false)
+// |landmark| with Dijkstra algorithm. |landmarks| weights are used as the distance map.
+// Unlike AStarAlgorithm::PropagateWave() the relaxation is exact, so the weights
+// satisfy the triangle inequality for every edge and give consistent potentials.
+void FillLandmarkWeights(IndexGraph & graph, vector<uint32_t> const & numSegments,
+                         uint16_t landmarkIdx, Segment const & landmark, bool fromLandmark,
+                         Landmarks & landmarks)
+{
+  auto const getWeight = [&](Segment const & segment) {
+    return fromLandmark ? landmarks.GetWeightFromLandmark(landmarkIdx, segment)
+                        : landmarks.GetWeightToLandmark(landmarkIdx, segment);
+  };
+  auto const setWeight = [&](Segment const & segment, double weight) {
+    if (fromLandmark)
+      landmarks.SetWeightFromLandmark(landmarkIdx, segment, weight);
+    else
+      landmarks.SetWeightToLandmark(landmarkIdx, segment, weight);
+  };
+
+  ForEachLandmarksSegment(numSegments, [&](Segment const & segment) {
+    setWeight(segment, Landmarks::kInfiniteWeight);
   });
 
-  LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
-              foundCount, ", not found:", notFoundCount));
+  using State = pair<double, Segment>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  setWeight(landmark, 0.0);
+  queue.emplace(0.0, landmark);
+
+  vector<SegmentEdge> edges;
+  while (!queue.empty())
+  {
+    State const state = queue.top();
+    queue.pop();
+    if (state.first > getWeight(state.second))
+      continue;
+
+    edges.clear();
+    graph.GetEdgeList(state.second, fromLandmark /* isOutgoing */, edges);
+    for (auto const & edge : edges)
+    {
+      Segment const & target = edge.GetTarget();
+      CHECK(landmarks.HasSegment(target), (target));
+      double const weight = state.first + edge.GetWeight().GetWeight();
+      if (weight < getWeight(target))
+      {
+        setWeight(target, weight);
+        queue.emplace(weight, target);
+      }
+    }
+  }
 }
 
 serial::GeometryCodingParams LoadGeometryCodingParams(string const & mwmFile)
@@ -486,6 +621,37 @@ bool BuildRoutingIndex(string const & filename, string const & country,
   }
 }
 
+bool BuildMappedRoutingIndex(string const & filename)
+{
+  LOG(LINFO, ("Building mapped routing index for", filename));
+  try
+  {
+    vector<uint8_t> buffer;
+    {
+      FilesContainerR const cont(filename);
+      if (!cont.IsExist(ROUTING_FILE_TAG))
+      {
+        LOG(LERROR, ("No", ROUTING_FILE_TAG, "section in", filename));
+        return false;
+      }
+
+      MemWriter<vector<uint8_t>> writer(buffer);
+      MappedIndexGraphSerializer::Serialize(cont.GetReader(ROUTING_FILE_TAG), writer);
+    }
+
+    FilesContainerW cont(filename, FileWriter::OP_WRITE_EXISTING);
+    cont.Write(buffer, ROUTING_MAPPED_FILE_TAG);
+    LOG(LINFO, (ROUTING_MAPPED_FILE_TAG, "section created:", buffer.size(), "bytes"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", ROUTING_MAPPED_FILE_TAG, "section:",
+                 e.what()));
+    return false;
+  }
+}
+
 /// \brief Serializes all the cross mwm information to |sectionName| of |mwmFile| including:
 /// * header
 /// * transitions
@@ -518,10 +684,13 @@ void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile,
   CalcCrossMwmConnectors(path, mwmFile, country, countryParentNameGetterFn, osmToFeatureFile,
                          transitions, connectors);
 
-  // We use leaps for cars only. To use leaps for other vehicle types add weights generation
-  // here and change WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
-  FillWeights(path, mwmFile, country, countryParentNameGetterFn, disableCrossMwmProgress,
-              connectors[static_cast<size_t>(VehicleType::Car)]);
+  // Leaps are used for all the vehicle types except transit which has its own section.
+  // See WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
+  for (auto const vehicleType : {VehicleType::Car, VehicleType::Bicycle, VehicleType::Pedestrian})
+  {
+    FillWeights(vehicleType, path, mwmFile, country, countryParentNameGetterFn,
+                disableCrossMwmProgress, connectors[static_cast<size_t>(vehicleType)]);
+  }
 
   CHECK(connectors[static_cast<size_t>(VehicleType::Transit)].IsEmpty(), ());
   SerializeCrossMwm(mwmFile, CROSS_MWM_FILE_TAG, connectors, transitions);
@@ -544,4 +713,95 @@ void BuildTransitCrossMwmSection(string const & path, string const & mwmFile,
   CHECK(connectors[static_cast<size_t>(VehicleType::Car)].IsEmpty(), ());
   SerializeCrossMwm(mwmFile, TRANSIT_CROSS_MWM_FILE_TAG, connectors, transitions);
 }
+
+bool BuildRoutingLandmarksSection(string const & path, string const & mwmFile,
+                                  string const & country,
+                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
+                                  uint16_t numLandmarks)
+{
+  LOG(LINFO, ("Building landmarks section for", country));
+  base::Timer timer;
+  try
+  {
+    shared_ptr<VehicleModelInterface> vehicleModel =
+        CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+    IndexGraph graph(
+        make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel)),
+        EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */));
+
+    // Restrictions and road access are not loaded. They only remove edges, so the bounds
+    // calculated on the graph without them are valid for any restrictions and road access.
+    MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+    FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(VehicleType::Car));
+
+    vector<uint32_t> numSegments;
+    graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & /* road */) {
+      if (featureId >= numSegments.size())
+        numSegments.resize(featureId + 1, 0);
+
+      auto const pointsCount = graph.GetGeometry().GetRoad(featureId).GetPointsCount();
+      numSegments[featureId] = pointsCount < 2 ? 0 : base::checked_cast<uint32_t>(pointsCount - 1);
+    });
+
+    Segment landmark;
+    bool found = false;
+    ForEachLandmarksSegment(numSegments, [&](Segment const & segment) {
+      if (!found)
+        landmark = segment;
+      found = true;
+    });
+
+    if (!found || numLandmarks == 0)
+    {
+      LOG(LINFO, ("No landmarks for", country));
+      return true;
+    }
+
+    Landmarks landmarks(VehicleType::Car, numLandmarks, numSegments);
+
+    // Landmarks are chosen with farthest-point heuristic: the first landmark is the farthest
+    // segment from an arbitrary segment, every next one is the farthest segment
+    // from the landmarks chosen before.
+    FillLandmarkWeights(graph, numSegments, 0 /* landmarkIdx */, landmark, true /* fromLandmark */,
+                        landmarks);
+    for (uint16_t i = 0; i < numLandmarks; ++i)
+    {
+      // Before the first landmark is chosen the first slot keeps weights from the arbitrary segment.
+      uint16_t const numKnown = max<uint16_t>(i, 1);
+      double maxWeight = -1.0;
+      ForEachLandmarksSegment(numSegments, [&](Segment const & segment) {
+        double weight = Landmarks::kInfiniteWeight;
+        for (uint16_t j = 0; j < numKnown; ++j)
+          weight = min(weight, landmarks.GetWeightFromLandmark(j, segment));
+
+        if (weight != Landmarks::kInfiniteWeight && weight > maxWeight)
+        {
+          maxWeight = weight;
+          landmark = segment;
+        }
+      });
+
+      FillLandmarkWeights(graph, numSegments, i, landmark, true /* fromLandmark */, landmarks);
+      FillLandmarkWeights(graph, numSegments, i, landmark, false /* fromLandmark */, landmarks);
+      LOG(LINFO, ("Landmark", i, ":", landmark));
+    }
+
+    FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+    auto writer = cont.GetWriter(LANDMARKS_FILE_TAG);
+    auto const startPos = writer.Pos();
+    landmarks.Serialize(writer);
+    auto const sectionSize = writer.Pos() - startPos;
+
+    LOG(LINFO, ("Landmarks section generated, size:", sectionSize, "bytes, elapsed:",
+                timer.ElapsedSeconds(), "seconds"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", LANDMARKS_FILE_TAG, "section:", e.what()));
+    return false;
+  }
+}
 }  // namespace routing
@@ -11,6 +11,11 @@ using CountryParentNameGetterFn = std::function<std::string(std::string const &)
 bool BuildRoutingIndex(std::string const & filename, std::string const & country,
                        CountryParentNameGetterFn const & countryParentNameGetterFn);
 
+/// \brief Builds ROUTING_MAPPED_FILE_TAG section with graphs of ROUTING_FILE_TAG section
+/// in the layout which is used in place without decoding.
+/// \note Before a call of this method ROUTING_FILE_TAG section should be built.
+bool BuildMappedRoutingIndex(std::string const & filename);
+
 /// \brief Builds CROSS_MWM_FILE_TAG section.
 /// \note Before call of this method
 /// * all features and feature geometry should be generated
@@ -25,4 +30,12 @@ void BuildRoutingCrossMwmSection(std::string const & path, std::string const & m
 void BuildTransitCrossMwmSection(std::string const & path, std::string const & mwmFile,
                                  std::string const & country,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn);
+
+/// \brief Builds LANDMARKS_FILE_TAG section with weights of car routes from and to
+/// |numLandmarks| landmarks for ALT heuristic.
+/// \note Before a call of this method ROUTING_FILE_TAG and city_roads sections should be built.
+bool BuildRoutingLandmarksSection(std::string const & path, std::string const & mwmFile,
+                                  std::string const & country,
+                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
+                                  uint16_t numLandmarks);
 }  // namespace routing
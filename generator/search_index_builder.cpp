@@ -1,10 +1,13 @@
 #include "search_index_builder.hpp"
 
+#include "search/address_points_table.hpp"
 #include "search/common.hpp"
+#include "search/house_to_street_table.hpp"
 #include "search/mwm_context.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/search_index_values.hpp"
 #include "search/search_trie.hpp"
+#include "search/short_prefix_table.hpp"
 #include "search/types_skipper.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -16,6 +19,7 @@
 #include "indexer/feature_visibility.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/ftypes_matcher.hpp"
+#include "indexer/rank_table.hpp"
 #include "indexer/search_delimiters.hpp"
 #include "indexer/search_string_utils.hpp"
 #include "indexer/trie_builder.hpp"
@@ -25,19 +29,23 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
-#include "coding/fixed_bits_ddvector.hpp"
 #include "coding/reader_writer_ops.hpp"
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
+#include "base/task_scheduler.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
 #include <fstream>
+#include <functional>
+#include <iterator>
 #include <map>
 #include <mutex>
 #include <unordered_map>
@@ -313,11 +321,15 @@ public:
   }
 };
 
+// Features are split into ranges whose keys are collected concurrently, every range reads
+// |fileName| by its own because FeaturesVector isn't thread-safe.
 template <typename TKey, typename TValue>
-void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
+void AddFeatureNameIndexPairs(FeaturesVectorTest const & features, string const & fileName,
                               CategoriesHolder const & categoriesHolder,
                               vector<pair<TKey, TValue>> & keyValuePairs)
 {
+  size_t const kMinFeaturesPerChunk = 10000;
+
   feature::DataHeader const & header = features.GetHeader();
 
   ValueBuilder<TValue> valueBuilder;
@@ -326,12 +338,44 @@ void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
   if (header.GetType() == feature::DataHeader::world)
     synonyms.reset(new SynonymsHolder(GetPlatform().WritablePathForFile(SYNONYMS_FILE)));
 
-  features.GetVector().ForEach(FeatureInserter<TKey, TValue>(
-      synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange(), valueBuilder));
+  auto & scheduler = base::TaskScheduler::Instance();
+  size_t const featuresCount = features.GetVector().GetNumFeatures();
+  size_t const chunksCount =
+      base::parallel::GetChunksCount(featuresCount, scheduler.GetWorkersCount(),
+                                     kMinFeaturesPerChunk);
+
+  vector<vector<pair<TKey, TValue>>> chunks(chunksCount);
+  base::parallel::RunChunks(chunksCount, [&](size_t chunk) {
+    FeaturesVectorTest chunkFeatures(fileName);
+    FeatureInserter<TKey, TValue> inserter(synonyms.get(), chunks[chunk], categoriesHolder,
+                                           header.GetScaleRange(), valueBuilder);
+
+    auto const from = static_cast<uint32_t>(featuresCount * chunk / chunksCount);
+    auto const to = static_cast<uint32_t>(featuresCount * (chunk + 1) / chunksCount);
+    for (uint32_t index = from; index < to; ++index)
+    {
+      FeatureType ft;
+      chunkFeatures.GetVector().GetByIndex(index, ft);
+      // Metadata is loaded by the index of the feature.
+      ft.SetID(FeatureID(MwmSet::MwmId(), index));
+      inserter(ft, index);
+    }
+  }, scheduler);
+
+  size_t totalSize = keyValuePairs.size();
+  for (auto const & chunk : chunks)
+    totalSize += chunk.size();
+  keyValuePairs.reserve(totalSize);
+
+  for (auto & chunk : chunks)
+  {
+    move(chunk.begin(), chunk.end(), back_inserter(keyValuePairs));
+    vector<pair<TKey, TValue>>().swap(chunk);
+  }
 }
 
-bool GetStreetIndex(search::MwmContext & ctx, uint32_t featureID, string const & streetName,
-                    uint32_t & result)
+bool GetStreetIndex(search::MwmContext & ctx, FeatureType & ft, string const & streetName,
+                    uint32_t & result, search::ReverseGeocoder::Street & matchedStreet)
 {
   size_t streetIndex = 0;
   strings::UniString const street = search::GetStreetNameAsKey(streetName);
@@ -339,9 +383,6 @@ bool GetStreetIndex(search::MwmContext & ctx, uint32_t featureID, string const &
   bool const hasStreet = !street.empty();
   if (hasStreet)
   {
-    FeatureType ft;
-    VERIFY(ctx.GetFeature(featureID, ft), ());
-
     using TStreet = search::ReverseGeocoder::Street;
     vector<TStreet> streets;
     search::ReverseGeocoder::GetNearbyStreets(ctx, feature::GetCenter(ft), streets);
@@ -350,6 +391,7 @@ bool GetStreetIndex(search::MwmContext & ctx, uint32_t featureID, string const &
     if (streetIndex < streets.size())
     {
       result = base::checked_cast<uint32_t>(streetIndex);
+      matchedStreet = streets[streetIndex];
       return true;
     }
   }
@@ -358,7 +400,21 @@ bool GetStreetIndex(search::MwmContext & ctx, uint32_t featureID, string const &
   return false;
 }
 
-void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t threadsCount)
+// Returns the distance from the center of |ft| to the farthest corner of its limit rect.
+double GetRadiusMeters(FeatureType & ft, m2::PointD const & center)
+{
+  auto const rect = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+  double radius = 0.0;
+  for (auto const & corner :
+       {rect.LeftTop(), rect.RightTop(), rect.RightBottom(), rect.LeftBottom()})
+  {
+    radius = max(radius, MercatorBounds::DistanceOnEarth(center, corner));
+  }
+  return radius;
+}
+
+void BuildAddressTable(FilesContainerR & container, Writer & writer,
+                       Writer & addressPointsWriter, uint32_t threadsCount)
 {
   // Read all street names to memory.
   ReaderSource<ModelReaderPtr> src(container.GetReader(SEARCH_TOKENS_FILE_TAG));
@@ -388,6 +444,8 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t th
   uint32_t const kEmptyResult = uint32_t(-1);
   vector<uint32_t> results(featuresCount, kEmptyResult);
 
+  search::AddressPointsTable::Builder addressPoints;
+
   mutex resMutex;
 
   // Thread working function.
@@ -398,12 +456,32 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t th
 
     for (uint32_t i = beg; i < end; ++i)
     {
+      FeatureType ft;
+      VERIFY(contexts[threadIdx]->GetFeature(i, ft), ());
+
       uint32_t streetIndex;
-      bool const found = GetStreetIndex(*(contexts[threadIdx]), i,
-                                        addrs[i].Get(feature::AddressData::STREET), streetIndex);
+      search::ReverseGeocoder::Street street;
+      bool const found = GetStreetIndex(*(contexts[threadIdx]), ft,
+                                        addrs[i].Get(feature::AddressData::STREET), streetIndex,
+                                        street);
+      string const houseNumber = ft.GetHouseNumber();
+      m2::PointD center;
+      double radius = 0.0;
+      if (!houseNumber.empty())
+      {
+        center = feature::GetCenter(ft);
+        radius = GetRadiusMeters(ft, center);
+      }
 
       lock_guard<mutex> guard(resMutex);
 
+      if (!houseNumber.empty())
+      {
+        addressPoints.Add(center, radius, i, houseNumber,
+                          found ? street.m_id.m_index : search::AddressPointsTable::kNoStreet,
+                          street.m_name);
+      }
+
       if (found)
       {
         results[i] = streetIndex;
@@ -433,18 +511,21 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer, uint32_t th
 
   // Flush results to disk.
   {
-    FixedBitsDDVector<3, FileReader>::Builder<Writer> building2Street(writer);
-    for (auto i : results)
+    search::HouseToStreetTableBuilder building2Street;
+    for (uint32_t i = 0; i < featuresCount; ++i)
     {
-      if (i == kEmptyResult)
-        building2Street.PushBackUndefined();
-      else
-        building2Street.PushBack(i);
+      if (results[i] != kEmptyResult)
+        building2Street.Put(i, results[i]);
     }
+    building2Street.Freeze(writer);
 
-    LOG(LINFO, ("Address: Building -> Street (opt, all)", building2Street.GetCount()));
+    LOG(LINFO, ("Address: Building -> Street (opt, all)", building2Street.GetCount(),
+                featuresCount));
   }
 
+  addressPoints.Serialize(addressPointsWriter);
+  LOG(LINFO, ("Address: Address points", addressPoints.GetNumPoints()));
+
   double matchedPercent = 100;
   if (address > 0)
     matchedPercent = 100.0 * (1.0 - static_cast<double>(missing) / static_cast<double>(address));
@@ -464,22 +545,31 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, ui
     return true;
 
   string const indexFilePath = filename + "." + SEARCH_INDEX_FILE_TAG EXTENSION_TMP;
-  string const addrFilePath = filename + "." + SEARCH_ADDRESS_FILE_TAG EXTENSION_TMP;
+  string const addrFilePath = filename + "." + HOUSE_TO_STREET_FILE_TAG EXTENSION_TMP;
+  string const shortPrefixesFilePath = filename + "." + SHORT_PREFIXES_FILE_TAG EXTENSION_TMP;
+  string const addressPointsFilePath = filename + "." + ADDRESS_POINTS_FILE_TAG EXTENSION_TMP;
   SCOPE_GUARD(indexFileGuard, bind(&FileWriter::DeleteFileX, indexFilePath));
   SCOPE_GUARD(addrFileGuard, bind(&FileWriter::DeleteFileX, addrFilePath));
+  SCOPE_GUARD(shortPrefixesFileGuard, bind(&FileWriter::DeleteFileX, shortPrefixesFilePath));
+  SCOPE_GUARD(addressPointsFileGuard, bind(&FileWriter::DeleteFileX, addressPointsFilePath));
 
   try
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      FileWriter shortPrefixesWriter(shortPrefixesFilePath);
+      BuildSearchIndex(readContainer, writer, shortPrefixesWriter);
       LOG(LINFO, ("Search index size =", writer.Size()));
+      LOG(LINFO, ("Short prefixes table size =", shortPrefixesWriter.Size()));
     }
-    if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
+    bool const hasAddresses = filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME;
+    if (hasAddresses)
     {
       FileWriter writer(addrFilePath);
-      BuildAddressTable(readContainer, writer, threadsCount);
+      FileWriter addressPointsWriter(addressPointsFilePath);
+      BuildAddressTable(readContainer, writer, addressPointsWriter, threadsCount);
       LOG(LINFO, ("Search address table size =", writer.Size()));
+      LOG(LINFO, ("Address points table size =", addressPointsWriter.Size()));
     }
     {
       // The behaviour of generator_tool's generate_search_index
@@ -505,7 +595,19 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, ui
 
       {
         FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
-        writeContainer.Write(addrFilePath, SEARCH_ADDRESS_FILE_TAG);
+        writeContainer.Write(shortPrefixesFilePath, SHORT_PREFIXES_FILE_TAG);
+      }
+
+      if (hasAddresses)
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(addrFilePath, HOUSE_TO_STREET_FILE_TAG);
+      }
+
+      if (hasAddresses)
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(addressPointsFilePath, ADDRESS_POINTS_FILE_TAG);
       }
     }
   }
@@ -523,7 +625,8 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, ui
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter,
+                      Writer & shortPrefixesWriter)
 {
   using Key = strings::UniString;
   using Value = FeatureIndexValue;
@@ -539,12 +642,36 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
   SingleValueSerializer<Value> serializer(codingParams);
 
   vector<pair<Key, Value>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
+  AddFeatureNameIndexPairs(features, container.GetFileName(), categoriesHolder,
+                           searchIndexKeyValuePairs);
+
+  {
+    vector<uint8_t> ranks;
+    search::SearchRankTableBuilder::CalcSearchRanks(container, ranks);
+
+    search::ShortPrefixTable::Builder builder;
+    for (auto const & keyValue : searchIndexKeyValuePairs)
+    {
+      auto const & key = keyValue.first;
+      ASSERT(!key.empty(), ());
+      // Categories and postcodes are not looked up by short prefixes.
+      auto const lang = static_cast<uint8_t>(key[0]);
+      if (lang >= search::kCategoriesLang)
+        continue;
+
+      auto const featureId = base::asserted_cast<uint32_t>(keyValue.second.m_featureId);
+      CHECK_LESS(featureId, ranks.size(), ());
+      builder.Add(lang, Key(key.begin() + 1, key.end()), featureId, ranks[featureId]);
+    }
+    builder.Serialize(shortPrefixesWriter);
+    LOG(LINFO, ("End building short prefixes table:", timer.ElapsedSeconds()));
+  }
 
-  sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
+  base::ParallelSort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end(),
+                     less<pair<Key, Value>>());
   LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
 
-  trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
+  trie::ParallelBuild<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
       indexWriter, serializer, searchIndexKeyValuePairs);
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
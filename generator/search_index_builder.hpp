@@ -14,5 +14,8 @@ namespace indexer
 bool BuildSearchIndexFromDataFile(std::string const & filename, bool forceRebuild,
                                   uint32_t threadsCount);
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+// Also writes to |shortPrefixesWriter| the table of the best ranked features for short
+// prefixes, see search/short_prefix_table.hpp.
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter,
+                      Writer & shortPrefixesWriter);
 }  // namespace indexer
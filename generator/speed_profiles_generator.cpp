@@ -0,0 +1,124 @@
+#include "generator/speed_profiles_generator.hpp"
+
+#include "generator/routing_helpers.hpp"
+
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/geo_object_id.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace
+{
+char constexpr kDelim[] = ", \t\r\n";
+
+bool ParseSpeedProfile(strings::SimpleTokenizer & iter, routing::SpeedProfiles::Profile & profile)
+{
+  for (auto & speedPercent : profile)
+  {
+    uint32_t speed = 0;
+    if (!iter || !strings::to_uint(*iter, speed))
+      return false;
+    ++iter;
+
+    uint32_t constexpr kMaxSpeed = routing::SpeedProfiles::kFreeFlowSpeedPercent;
+    speed = min(max(speed, 1u), kMaxSpeed);
+    speedPercent = static_cast<uint8_t>(speed);
+  }
+  return !iter;
+}
+}  // namespace
+
+namespace routing
+{
+bool BuildSpeedProfiles(string const & dataPath, string const & speedProfilesPath,
+                        string const & osmIdsToFeatureIdsPath)
+{
+  LOG(LINFO, ("Generating speed profiles for", dataPath));
+
+  map<base::GeoObjectId, uint32_t> osmIdToFeatureId;
+  if (!ParseOsmIdToFeatureIdMapping(osmIdsToFeatureIdsPath, osmIdToFeatureId))
+  {
+    LOG(LERROR, ("An error happened while parsing feature id to osm ids mapping from file:",
+                 osmIdsToFeatureIdsPath));
+    return false;
+  }
+
+  ifstream stream(speedProfilesPath);
+  if (!stream)
+  {
+    LOG(LERROR, ("Could not open", speedProfilesPath));
+    return false;
+  }
+
+  SpeedProfiles speedProfiles;
+  map<SpeedProfiles::Profile, uint32_t> profileIds;
+  map<Segment, uint32_t> segmentProfiles;
+
+  string line;
+  for (uint32_t lineNo = 1; getline(stream, line); ++lineNo)
+  {
+    strings::SimpleTokenizer iter(line, kDelim);
+    if (!iter)
+      continue;
+
+    uint64_t osmId = 0;
+    uint32_t segmentIdx = 0;
+    uint32_t forward = 0;
+    if (!strings::to_uint64(*iter, osmId) || !(++iter) || !strings::to_uint(*iter, segmentIdx) ||
+        !(++iter) || !strings::to_uint(*iter, forward) || forward > 1)
+    {
+      LOG(LERROR, ("Error when parsing speed profiles: bad segment at line", lineNo,
+                   "Line contents:", line));
+      return false;
+    }
+    ++iter;
+
+    SpeedProfiles::Profile profile;
+    if (!ParseSpeedProfile(iter, profile))
+    {
+      LOG(LERROR, ("Error when parsing speed profiles: bad speeds at line", lineNo,
+                   "Line contents:", line));
+      return false;
+    }
+
+    // The way may be not a road feature of the mwm.
+    auto const it = osmIdToFeatureId.find(base::MakeOsmWay(osmId));
+    if (it == osmIdToFeatureId.cend())
+      continue;
+
+    auto const emplaced = profileIds.emplace(profile, speedProfiles.GetNumProfiles());
+    if (emplaced.second)
+      speedProfiles.AddProfile(profile);
+
+    Segment const segment(0 /* mwmId */, it->second, segmentIdx, forward == 1);
+    segmentProfiles[segment] = emplaced.first->second;
+  }
+
+  // Segment::operator<() orders segments of one mwm in the order required by SpeedProfiles.
+  for (auto const & segmentProfile : segmentProfiles)
+    speedProfiles.SetProfile(segmentProfile.first, segmentProfile.second);
+
+  LOG(LINFO, ("Speed profiles:", speedProfiles.GetNumProfiles(), "segments:",
+              speedProfiles.GetNumSegments()));
+  if (speedProfiles.IsEmpty())
+    return true;
+
+  FilesContainerW cont(dataPath, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(SPEED_PROFILES_FILE_TAG);
+  speedProfiles.Serialize(writer);
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+namespace routing
+{
+/// \brief Builds SPEED_PROFILES_FILE_TAG section of mwm |dataPath| with speed profiles
+/// of road segments from csv file |speedProfilesPath|. Every line of the file is
+/// <osm way id>,<segment index>,<1 for forward direction and 0 for backward direction>,
+/// <168 speeds in percents of free flow speed for every hour of week starting Monday 00:00>.
+/// Speeds greater than free flow speed are reduced to it. Equal profiles are stored once.
+/// \returns false if the file can't be parsed.
+bool BuildSpeedProfiles(std::string const & dataPath, std::string const & speedProfilesPath,
+                        std::string const & osmIdsToFeatureIdsPath);
+}  // namespace routing
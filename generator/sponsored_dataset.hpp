@@ -3,9 +3,11 @@
 #include "generator/sponsored_object_storage.hpp"
 
 #include "base/newtype.hpp"
+#include "base/task_scheduler.hpp"
 
 #include <functional>
 #include <string>
+#include <vector>
 
 class FeatureBuilder1;
 
@@ -27,6 +29,11 @@ public:
   /// objects from dataset.
   bool NecessaryMatchingConditionHolds(FeatureBuilder1 const & fb) const;
   ObjectId FindMatchingObjectId(FeatureBuilder1 const & e) const;
+  /// Matches |features| in parallel on |scheduler|.
+  /// @return ids of matched objects or kInvalidObjectId in the order of |features|.
+  std::vector<ObjectId> FindMatchingObjectIds(
+      std::vector<FeatureBuilder1> const & features,
+      base::TaskScheduler & scheduler = base::TaskScheduler::Instance()) const;
 
   // Applies changes to a given osm object (for example, remove hotel type)
   // and passes the result to |fn|.
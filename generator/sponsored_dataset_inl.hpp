@@ -10,6 +10,7 @@
 #include "geometry/mercator.hpp"
 
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
@@ -61,4 +62,17 @@ SponsoredDataset<SponsoredObject>::FindMatchingObjectId(FeatureBuilder1 const &
     return FindMatchingObjectIdImpl(fb);
   return Object::InvalidObjectId();
 }
+
+template <typename SponsoredObject>
+std::vector<typename SponsoredDataset<SponsoredObject>::ObjectId>
+SponsoredDataset<SponsoredObject>::FindMatchingObjectIds(
+    std::vector<FeatureBuilder1> const & features, base::TaskScheduler & scheduler) const
+{
+  // The storage and its R-tree are only read, so features are matched independently.
+  std::vector<ObjectId> ids(features.size(), Object::InvalidObjectId());
+  base::ParallelFor(0, features.size(), [&](size_t i) {
+    ids[i] = FindMatchingObjectId(features[i]);
+  }, 1 /* minChunkSize */, scheduler);
+  return ids;
+}
 }  // namespace generator
@@ -1,10 +1,12 @@
 #include "generator/srtm_parser.hpp"
 
 #include "coding/endianness.hpp"
+#include "coding/internal/file_data.hpp"
 #include "coding/zip_reader.hpp"
 
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -41,7 +43,8 @@ SrtmTile::SrtmTile()
   Invalidate();
 }
 
-SrtmTile::SrtmTile(SrtmTile && rhs) : m_data(move(rhs.m_data)), m_valid(rhs.m_valid)
+SrtmTile::SrtmTile(SrtmTile && rhs)
+  : m_data(move(rhs.m_data)), m_mapped(move(rhs.m_mapped)), m_valid(rhs.m_valid)
 {
   rhs.Invalidate();
 }
@@ -51,6 +54,24 @@ void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
   Invalidate();
 
   std::string const base = GetBase(coord);
+
+  // Unpacked tiles are mapped, so only the touched pages are read and they may be
+  // shared with other processes.
+  std::string const hgt = dir + base + ".hgt";
+  uint64_t hgtSize = 0;
+  if (base::GetFileSize(hgt, hgtSize))
+  {
+    if (hgtSize != kSrtmTileSize)
+    {
+      LOG(LWARNING, ("Bad SRTM file size:", hgt, hgtSize));
+      return;
+    }
+
+    m_mapped = std::make_unique<MmapReader>(hgt);
+    m_valid = true;
+    return;
+  }
+
   std::string const cont = dir + base + ".SRTMGL1.hgt.zip";
   std::string file = base + ".hgt";
 
@@ -84,7 +105,7 @@ void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
   m_valid = true;
 }
 
-feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord)
+feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord) const
 {
   if (!IsValid())
     return feature::kInvalidAltitude;
@@ -140,32 +161,72 @@ void SrtmTile::Invalidate()
 {
   m_data.clear();
   m_data.shrink_to_fit();
+  m_mapped.reset();
   m_valid = false;
 }
 
 // SrtmTileManager ---------------------------------------------------------------------------------
-SrtmTileManager::SrtmTileManager(std::string const & dir) : m_dir(dir) {}
+SrtmTileManager::SrtmTileManager(std::string const & dir, size_t maxTilesCount)
+  : m_dir(dir), m_maxTilesCount(std::max(maxTilesCount, static_cast<size_t>(1)))
+{
+}
+
 feature::TAltitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
+{
+  return GetTile(coord)->GetHeight(coord);
+}
+
+std::shared_ptr<SrtmTile const> SrtmTileManager::GetTile(ms::LatLon const & coord)
 {
   std::string const base = SrtmTile::GetBase(coord);
-  auto it = m_tiles.find(base);
-  if (it == m_tiles.end())
+
+  std::promise<TilePtr> promise;
+  std::shared_future<TilePtr> tile;
   {
-    SrtmTile tile;
-    try
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_tiles.find(base);
+    if (it != m_tiles.end())
     {
-      tile.Init(m_dir, coord);
+      m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+      tile = it->second.m_tile;
     }
-    catch (RootException const & e)
+    else
     {
-      LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+      m_lru.push_front(base);
+      it = m_tiles.emplace(base, Entry{promise.get_future().share(), m_lru.begin()}).first;
+
+      while (m_tiles.size() > m_maxTilesCount)
+      {
+        m_tiles.erase(m_lru.back());
+        m_lru.pop_back();
+      }
     }
+  }
+
+  if (tile.valid())
+    return tile.get();
+
+  // The tile is loaded without the lock, so other tiles may be got meanwhile.
+  auto loaded = LoadTile(base, coord);
+  promise.set_value(loaded);
+  return loaded;
+}
 
-    // It's OK to store even invalid tiles and return invalid height
-    // for them later.
-    it = m_tiles.emplace(base, std::move(tile)).first;
+SrtmTileManager::TilePtr SrtmTileManager::LoadTile(std::string const & base,
+                                                   ms::LatLon const & coord) const
+{
+  auto tile = std::make_shared<SrtmTile>();
+  try
+  {
+    tile->Init(m_dir, coord);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
   }
 
-  return it->second.GetHeight(coord);
+  // It's OK to store even invalid tiles and return invalid height
+  // for them later.
+  return tile;
 }
 }  // namespace generator
@@ -4,9 +4,16 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include "coding/mmap_reader.hpp"
+
 #include "base/macros.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -18,39 +25,74 @@ public:
   SrtmTile();
   SrtmTile(SrtmTile && rhs);
 
+  // Maps |dir|/<base>.hgt when the unpacked file exists, otherwise unzips
+  // |dir|/<base>.SRTMGL1.hgt.zip to memory.
   void Init(std::string const & dir, ms::LatLon const & coord);
 
   inline bool IsValid() const { return m_valid; }
   // Returns height in meters at |coord| or kInvalidAltitude.
-  feature::TAltitude GetHeight(ms::LatLon const & coord);
+  feature::TAltitude GetHeight(ms::LatLon const & coord) const;
 
   static std::string GetBase(ms::LatLon coord);
 
 private:
   inline feature::TAltitude const * Data() const
   {
+    if (m_mapped)
+      return reinterpret_cast<feature::TAltitude const *>(m_mapped->Data());
     return reinterpret_cast<feature::TAltitude const *>(m_data.data());
   };
 
-  inline size_t Size() const { return m_data.size() / sizeof(feature::TAltitude); }
+  inline size_t Size() const
+  {
+    return (m_mapped ? m_mapped->Size() : m_data.size()) / sizeof(feature::TAltitude);
+  }
   void Invalidate();
 
   std::string m_data;
+  std::unique_ptr<MmapReader> m_mapped;
   bool m_valid;
 
   DISALLOW_COPY(SrtmTile);
 };
 
+// Cache of SRTM tiles, at most |maxTilesCount| tiles are kept, the least recently used
+// ones are dropped first. A tile is about 25 MB when it's unzipped to memory.
+//
+// *NOTE* All methods are thread-safe. A tile is loaded only once when it's requested
+// by several threads at once, other threads wait for it.
 class SrtmTileManager
 {
 public:
-  SrtmTileManager(std::string const & dir);
+  static size_t constexpr kDefaultMaxTilesCount = 64;
+
+  explicit SrtmTileManager(std::string const & dir,
+                           size_t maxTilesCount = kDefaultMaxTilesCount);
 
   feature::TAltitude GetHeight(ms::LatLon const & coord);
+  // Returns the tile of |coord|, the tile stays valid while it's held even when
+  // it's dropped from the cache.
+  std::shared_ptr<SrtmTile const> GetTile(ms::LatLon const & coord);
 
 private:
+  using TilePtr = std::shared_ptr<SrtmTile const>;
+
+  struct Entry
+  {
+    std::shared_future<TilePtr> m_tile;
+    // Position of the tile's base in |m_lru|.
+    std::list<std::string>::iterator m_lruIt;
+  };
+
+  TilePtr LoadTile(std::string const & base, ms::LatLon const & coord) const;
+
   std::string m_dir;
-  std::unordered_map<std::string, SrtmTile> m_tiles;
+  size_t const m_maxTilesCount;
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, Entry> m_tiles;
+  // Bases of the tiles from the most recently used to the least recently used.
+  std::list<std::string> m_lru;
 
   DISALLOW_COPY(SrtmTileManager);
 };
@@ -0,0 +1,137 @@
+#include "generator/stages_report.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include <sys/resource.h>
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+double ToSeconds(timeval const & tv) { return tv.tv_sec + tv.tv_usec / 1e6; }
+
+void ReadIoCounters(uint64_t & bytesRead, uint64_t & bytesWritten)
+{
+#if defined(OMIM_OS_LINUX)
+  ifstream io("/proc/self/io");
+  string key;
+  uint64_t value = 0;
+  while (io >> key >> value)
+  {
+    if (key == "rchar:")
+      bytesRead = value;
+    else if (key == "wchar:")
+      bytesWritten = value;
+  }
+#endif
+}
+
+uint64_t Delta(uint64_t from, uint64_t to) { return to > from ? to - from : 0; }
+}  // namespace
+
+// static
+ResourceUsage ResourceUsage::GetCurrent()
+{
+  ResourceUsage result;
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    result.m_cpuSeconds = ToSeconds(usage.ru_utime) + ToSeconds(usage.ru_stime);
+#if defined(OMIM_OS_MAC)
+    // Bytes on Mac OS, kilobytes elsewhere.
+    result.m_peakRssBytes = static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    result.m_peakRssBytes = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+
+  ReadIoCounters(result.m_bytesRead, result.m_bytesWritten);
+  return result;
+}
+
+// StagesReport::ScopedStage -----------------------------------------------------------------------
+StagesReport::ScopedStage::ScopedStage(StagesReport & report, string const & name,
+                                       string const & country, uint64_t itemsCount)
+  : m_report(report), m_start(ResourceUsage::GetCurrent())
+{
+  m_stage.m_name = name;
+  m_stage.m_country = country;
+  m_stage.m_itemsCount = itemsCount;
+}
+
+StagesReport::ScopedStage::~ScopedStage()
+{
+  auto const end = ResourceUsage::GetCurrent();
+  m_stage.m_wallSeconds = m_timer.ElapsedSeconds();
+  m_stage.m_cpuSeconds = max(end.m_cpuSeconds - m_start.m_cpuSeconds, 0.0);
+  m_stage.m_peakRssBytes = end.m_peakRssBytes;
+  m_stage.m_bytesRead = Delta(m_start.m_bytesRead, end.m_bytesRead);
+  m_stage.m_bytesWritten = Delta(m_start.m_bytesWritten, end.m_bytesWritten);
+  m_report.Add(m_stage);
+}
+
+// StagesReport ------------------------------------------------------------------------------------
+void StagesReport::Add(Stage const & stage)
+{
+  LOG(LINFO, ("Stage", stage.m_name, stage.m_country, "finished, wall:", stage.m_wallSeconds,
+              "seconds, cpu:", stage.m_cpuSeconds, "seconds, peak rss:", stage.m_peakRssBytes,
+              "bytes"));
+
+  lock_guard<mutex> lock(m_mutex);
+  m_stages.push_back(stage);
+}
+
+vector<StagesReport::Stage> StagesReport::GetStages() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stages;
+}
+
+bool StagesReport::Append(string const & path) const
+{
+  ofstream output(path, ios::app);
+  for (auto const & stage : GetStages())
+    output << ToJSON(stage) << '\n';
+
+  if (!output)
+  {
+    LOG(LWARNING, ("Can't write stages report to", path));
+    return false;
+  }
+  return true;
+}
+
+// static
+string StagesReport::ToJSON(Stage const & stage)
+{
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "stage", stage.m_name);
+  if (!stage.m_country.empty())
+    ToJSONObject(*root, "country", stage.m_country);
+  ToJSONObject(*root, "wall_seconds", stage.m_wallSeconds);
+  ToJSONObject(*root, "cpu_seconds", stage.m_cpuSeconds);
+  ToJSONObject(*root, "peak_rss_bytes", stage.m_peakRssBytes);
+  ToJSONObject(*root, "bytes_read", stage.m_bytesRead);
+  ToJSONObject(*root, "bytes_written", stage.m_bytesWritten);
+  if (stage.m_itemsCount != 0)
+  {
+    ToJSONObject(*root, "items", stage.m_itemsCount);
+    if (stage.m_wallSeconds > 0.0)
+      ToJSONObject(*root, "items_per_second", stage.m_itemsCount / stage.m_wallSeconds);
+  }
+
+  unique_ptr<char, JSONFreeDeleter> buffer(
+      json_dumps(root.get(), JSON_COMPACT | JSON_PRESERVE_ORDER));
+  return buffer.get();
+}
+}  // namespace generator
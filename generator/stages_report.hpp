@@ -0,0 +1,84 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Resource usage of the whole process so far.
+struct ResourceUsage
+{
+  static ResourceUsage GetCurrent();
+
+  // User and system time of all threads.
+  double m_cpuSeconds = 0.0;
+  // High-water mark of the resident set size.
+  uint64_t m_peakRssBytes = 0;
+  // Bytes read and written by syscalls, including reads served by the page cache.
+  // Available on Linux only, zeros elsewhere.
+  uint64_t m_bytesRead = 0;
+  uint64_t m_bytesWritten = 0;
+};
+
+// Per-stage breakdown of generator time and resources, stages are the passes of the generator
+// and the section builders of every country.
+//
+// CPU time and bytes are counted for the whole process. Stages of several countries which
+// are built at once share them, so a stage is charged for the work of its neighbours then.
+//
+// *NOTE* All methods are thread-safe.
+class StagesReport
+{
+public:
+  struct Stage
+  {
+    std::string m_name;
+    // Empty for the passes which aren't bound to a country.
+    std::string m_country;
+    double m_wallSeconds = 0.0;
+    double m_cpuSeconds = 0.0;
+    uint64_t m_peakRssBytes = 0;
+    uint64_t m_bytesRead = 0;
+    uint64_t m_bytesWritten = 0;
+    // Number of elements or features processed by the stage, zero when it's unknown.
+    uint64_t m_itemsCount = 0;
+  };
+
+  // Measures the stage from construction to destruction.
+  class ScopedStage
+  {
+  public:
+    ScopedStage(StagesReport & report, std::string const & name,
+                std::string const & country = std::string(), uint64_t itemsCount = 0);
+    ~ScopedStage();
+
+    void SetItemsCount(uint64_t itemsCount) { m_stage.m_itemsCount = itemsCount; }
+
+  private:
+    StagesReport & m_report;
+    Stage m_stage;
+    base::Timer m_timer;
+    ResourceUsage m_start;
+
+    DISALLOW_COPY_AND_MOVE(ScopedStage);
+  };
+
+  void Add(Stage const & stage);
+  std::vector<Stage> GetStages() const;
+
+  // Appends stages to |path| as JSON lines, one object per stage. Appending keeps the stages
+  // of the previous runs, so all passes of a planet build end up in one file.
+  bool Append(std::string const & path) const;
+
+  static std::string ToJSON(Stage const & stage);
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<Stage> m_stages;
+};
+}  // namespace generator
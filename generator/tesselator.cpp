@@ -7,16 +7,158 @@
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
+#include "base/math.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <string>
+#include <unordered_map>
 
 #include "3party/libtess2/Include/tesselator.h"
 
 namespace tesselator
 {
-int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
+namespace
+{
+// Shapes with more points are rare, so they aren't cached.
+size_t constexpr kMaxCachedShapeSize = 64;
+size_t constexpr kMaxCacheSize = 1 << 16;
+// Grid of the normalized shapes, it's much finer than the grid of the mwm geometry.
+double constexpr kShapeGridSize = 1e-9;
+
+// Triangles are triplets of indices of points.
+using Triangles = std::vector<int>;
+
+void AssignTriangles(PointsT const & points, Triangles const & triangles, TrianglesInfo & info)
+{
+  info.AssignPoints(points.begin(), points.end());
+  info.Reserve(triangles.size() / 3);
+  for (size_t i = 0; i < triangles.size(); i += 3)
+    info.Add(triangles[i], triangles[i + 1], triangles[i + 2]);
+}
+
+// Returns the number of points of |contour| without the last point which repeats the first one.
+size_t GetContourSize(PointsT const & contour)
+{
+  if (contour.size() > 1 && contour.front() == contour.back())
+    return contour.size() - 1;
+  return contour.size();
+}
+
+// Fast path for single strictly convex contours like most of buildings: the contour is
+// triangulated as a fan. Triangles have the orientation of the contour like the ones of libtess2.
+bool TesselateConvex(PolygonsT const & polys, TrianglesInfo & info)
+{
+  if (polys.size() != 1)
+    return false;
+
+  auto const & contour = polys.front();
+  size_t const count = GetContourSize(contour);
+  if (count < 3)
+    return false;
+
+  // All the turns are to the same side and they sum up to one full turn, so the contour
+  // is convex and doesn't intersect itself.
+  double sign = 0.0;
+  double angle = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const & p1 = contour[i];
+    auto const & p2 = contour[(i + 1) % count];
+    auto const & p3 = contour[(i + 2) % count];
+    double const orientation = m2::robust::OrientedS(p1, p2, p3);
+    if (orientation == 0.0 || orientation * sign < 0.0)
+      return false;
+    sign = orientation;
+    angle += atan2(m2::CrossProduct(p2 - p1, p3 - p2), m2::DotProduct(p2 - p1, p3 - p2));
+  }
+
+  if (fabs(fabs(angle) - 2 * math::pi) > 1e-6)
+    return false;
+
+  Triangles triangles;
+  triangles.reserve(3 * (count - 2));
+  for (size_t i = 1; i + 1 < count; ++i)
+  {
+    triangles.push_back(0);
+    triangles.push_back(static_cast<int>(i));
+    triangles.push_back(static_cast<int>(i + 1));
+  }
+
+  AssignTriangles(PointsT(contour.begin(), contour.begin() + count), triangles, info);
+  return true;
+}
+
+// Triangulations of shapes which are equal up to a translation. Triangulations are kept as
+// indices of points of the shapes, so only the ones without new vertices are cached.
+// The cache is shared by all threads.
+class ShapesCache
+{
+public:
+  static ShapesCache & Instance()
+  {
+    static ShapesCache cache;
+    return cache;
+  }
+
+  // Returns false when the shape of |polys| isn't cached.
+  static bool MakeKey(PolygonsT const & polys, std::string & key)
+  {
+    size_t size = 0;
+    for (auto const & contour : polys)
+      size += contour.size();
+    if (size == 0 || size > kMaxCachedShapeSize)
+      return false;
+
+    auto const & origin = polys.front().front();
+    std::vector<int64_t> values;
+    values.reserve(polys.size() + 2 * size);
+    for (auto const & contour : polys)
+    {
+      values.push_back(static_cast<int64_t>(contour.size()));
+      for (auto const & p : contour)
+      {
+        values.push_back(std::llround((p.x - origin.x) / kShapeGridSize));
+        values.push_back(std::llround((p.y - origin.y) / kShapeGridSize));
+      }
+    }
+
+    key.assign(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(int64_t));
+    return true;
+  }
+
+  bool Find(std::string const & key, Triangles & triangles) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_shapes.find(key);
+    if (it == m_shapes.end())
+      return false;
+
+    triangles = it->second;
+    return true;
+  }
+
+  void Add(std::string && key, Triangles && triangles)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_shapes.size() >= kMaxCacheSize)
+      m_shapes.clear();
+    m_shapes.emplace(std::move(key), std::move(triangles));
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, Triangles> m_shapes;
+};
+
+// Returns the number of triangles, |points| are the vertices of the triangles.
+int TesselateWithLibtess(PolygonsT const & polys, PointsT & points, Triangles & triangles)
 {
   int constexpr kCoordinatesPerVertex = 2;
   int constexpr kVerticesInPolygon = 3;
@@ -42,15 +184,64 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
   {
     int const vertexCount = tessGetVertexCount(tess.get());
     TESSreal const * vertices = tessGetVertices(tess.get());
-    m2::PointD const * points = reinterpret_cast<m2::PointD const *>(vertices);
-    info.AssignPoints(points, points + vertexCount);
+    m2::PointD const * begin = reinterpret_cast<m2::PointD const *>(vertices);
+    points.assign(begin, begin + vertexCount);
 
     // Elements are triplets of vertex indices.
     TESSindex const * elements = tessGetElements(tess.get());
-    info.Reserve(elementCount);
-    for (int i = 0; i < elementCount; ++i)
-      info.Add(elements[i * 3], elements[i * 3 + 1], elements[i * 3 + 2]);
+    triangles.assign(elements, elements + 3 * elementCount);
+  }
+  return elementCount;
+}
+
+// Maps |triangles| of |vertices| to the indices of the same points of |polys|.
+// Returns false when libtess2 has added new vertices.
+bool MapToShape(PolygonsT const & polys, PointsT const & vertices, Triangles & triangles)
+{
+  PointsT shape;
+  for (auto const & contour : polys)
+    shape.insert(shape.end(), contour.begin(), contour.end());
+
+  std::vector<int> mapping(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i)
+  {
+    auto const it = std::find(shape.begin(), shape.end(), vertices[i]);
+    if (it == shape.end())
+      return false;
+    mapping[i] = static_cast<int>(std::distance(shape.begin(), it));
   }
+
+  for (auto & index : triangles)
+    index = mapping[index];
+  return true;
+}
+}  // namespace
+
+int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
+{
+  if (TesselateConvex(polys, info))
+    return static_cast<int>(GetContourSize(polys.front())) - 2;
+
+  std::string key;
+  bool const cacheable = ShapesCache::MakeKey(polys, key);
+
+  PointsT points;
+  Triangles triangles;
+  if (cacheable && ShapesCache::Instance().Find(key, triangles))
+  {
+    for (auto const & contour : polys)
+      points.insert(points.end(), contour.begin(), contour.end());
+    AssignTriangles(points, triangles, info);
+    return static_cast<int>(triangles.size() / 3);
+  }
+
+  int const elementCount = TesselateWithLibtess(polys, points, triangles);
+  if (elementCount == 0)
+    return 0;
+
+  AssignTriangles(points, triangles, info);
+  if (cacheable && MapToShape(polys, points, triangles))
+    ShapesCache::Instance().Add(std::move(key), std::move(triangles));
   return elementCount;
 }
 
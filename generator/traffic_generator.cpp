@@ -15,6 +15,8 @@
 #include "coding/file_container.hpp"
 #include "coding/file_writer.hpp"
 
+#include "base/logging.hpp"
+
 #include <vector>
 
 namespace traffic
@@ -29,9 +31,18 @@ bool GenerateTrafficKeysFromDataFile(std::string const & mwmPath)
     std::vector<uint8_t> buf;
     TrafficInfo::SerializeTrafficKeys(keys, buf);
 
+    std::vector<uint8_t> mappedBuf;
+    TrafficInfo::SerializeMappedTrafficKeys(keys, mappedBuf);
+
     FilesContainerW writeContainer(mwmPath, FileWriter::OP_WRITE_EXISTING);
-    FileWriter writer = writeContainer.GetWriter(TRAFFIC_KEYS_FILE_TAG);
-    writer.Write(buf.data(), buf.size());
+    {
+      FileWriter writer = writeContainer.GetWriter(TRAFFIC_KEYS_FILE_TAG);
+      writer.Write(buf.data(), buf.size());
+    }
+    // The section is used in place, so enabling traffic for an mwm costs no decoding.
+    writeContainer.Write(mappedBuf, TRAFFIC_KEYS_MAPPED_FILE_TAG);
+    LOG(LINFO, (TRAFFIC_KEYS_MAPPED_FILE_TAG, "section created:", mappedBuf.size(), "bytes,",
+                keys.size(), "keys"));
   }
   catch (RootException const & e)
   {
@@ -25,9 +25,13 @@
 #include "platform/platform.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 
+#include <map>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "defines.hpp"
@@ -43,6 +47,10 @@ using namespace storage;
 
 namespace
 {
+// Trips of lines depart every line interval in the range.
+Schedule::Time constexpr kServiceStartS = 5 * 3600;
+Schedule::Time constexpr kServiceEndS = 25 * 3600;
+
 void LoadBorders(string const & dir, TCountryId const & countryId, vector<m2::RegionD> & borders)
 {
   string const polyFile = base::JoinPath(dir, BORDERS_DIR, countryId + BORDERS_EXTENSION);
@@ -179,6 +187,90 @@ void ProcessGraph(string const & mwmPath, TCountryId const & countryId,
   data.CheckValidSortedUnique();
 }
 
+void FillSchedule(GraphData const & data, Schedule & schedule)
+{
+  schedule = Schedule();
+
+  map<StopId, Schedule::StopIdx> stopIdxs;
+  for (auto const & stop : data.GetStops())
+    stopIdxs[stop.GetId()] = schedule.AddStop(stop.GetId(), stop.GetPoint());
+
+  // Running times of lines between stops.
+  map<tuple<LineId, StopId, StopId>, Weight> runningTimes;
+  for (auto const & edge : data.GetEdges())
+  {
+    auto const it1 = stopIdxs.find(edge.GetStop1Id());
+    auto const it2 = stopIdxs.find(edge.GetStop2Id());
+    if (it1 == stopIdxs.cend() || it2 == stopIdxs.cend() || edge.GetWeight() == kInvalidWeight)
+      continue;
+
+    if (edge.GetTransfer())
+    {
+      schedule.AddTransfer(it1->second, it2->second,
+                           base::checked_cast<Schedule::Time>(edge.GetWeight()));
+      continue;
+    }
+
+    runningTimes[make_tuple(edge.GetLineId(), edge.GetStop1Id(), edge.GetStop2Id())] =
+        edge.GetWeight();
+  }
+
+  for (auto const & line : data.GetLines())
+  {
+    if (line.GetInterval() == kInvalidWeight || line.GetInterval() <= 0)
+    {
+      LOG(LWARNING, ("Line", line.GetId(), "has no interval and is skipped in the schedule."));
+      continue;
+    }
+
+    for (auto const & range : line.GetStopIds())
+    {
+      vector<Schedule::StopIdx> stops;
+      // Arrivals at stops of the first trip.
+      vector<Schedule::Time> arrivals;
+      for (size_t i = 0; i < range.size(); ++i)
+      {
+        auto const stopIt = stopIdxs.find(range[i]);
+        if (stopIt == stopIdxs.cend())
+          break;
+
+        Schedule::Time arrival = kServiceStartS;
+        if (i != 0)
+        {
+          auto const it = runningTimes.find(make_tuple(line.GetId(), range[i - 1], range[i]));
+          if (it == runningTimes.cend())
+            break;
+          arrival = arrivals.back() + base::checked_cast<Schedule::Time>(it->second);
+        }
+
+        stops.push_back(stopIt->second);
+        arrivals.push_back(arrival);
+      }
+
+      if (stops.size() != range.size() || stops.size() < 2)
+      {
+        LOG(LWARNING, ("Stops of line", line.GetId(), "aren't connected. The line is skipped in "
+                       "the schedule."));
+        continue;
+      }
+
+      auto const interval = base::checked_cast<Schedule::Time>(line.GetInterval());
+      vector<Schedule::Trip> trips;
+      for (Schedule::Time shift = 0; kServiceStartS + shift <= kServiceEndS; shift += interval)
+      {
+        Schedule::Trip trip;
+        trip.reserve(arrivals.size());
+        for (auto const arrival : arrivals)
+          trip.emplace_back(arrival + shift, arrival + shift);
+        trips.push_back(move(trip));
+      }
+      schedule.AddPattern(line.GetId(), stops, trips);
+    }
+  }
+
+  schedule.Build();
+}
+
 void BuildTransit(string const & mwmDir, TCountryId const & countryId,
                   string const & osmIdToFeatureIdsPath, string const & transitDir)
 {
@@ -210,8 +302,17 @@ void BuildTransit(string const & mwmDir, TCountryId const & countryId,
   jointData.CheckValidSortedUnique();
 
   FilesContainerW cont(mwmPath, FileWriter::OP_WRITE_EXISTING);
-  FileWriter writer = cont.GetWriter(TRANSIT_FILE_TAG);
-  jointData.Serialize(writer);
+  {
+    FileWriter writer = cont.GetWriter(TRANSIT_FILE_TAG);
+    jointData.Serialize(writer);
+  }
+
+  Schedule schedule;
+  FillSchedule(jointData, schedule);
+  FileWriter writer = cont.GetWriter(TRANSIT_SCHEDULE_FILE_TAG);
+  schedule.Serialize(writer);
+  LOG(LINFO, ("Transit schedule section for", countryId, "has", schedule.GetNumPatterns(),
+              "patterns."));
 }
 }  // namespace transit
 }  // namespace routing
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "transit/transit_graph_data.hpp"
+#include "transit/transit_schedule.hpp"
 
 #include "storage/index.hpp"
 
@@ -21,6 +22,13 @@ void DeserializeFromJson(OsmIdToFeatureIdsMap const & mapping, std::string const
 void ProcessGraph(std::string const & mwmPath, storage::TCountryId const & countryId,
                   OsmIdToFeatureIdsMap const & osmIdToFeatureIdsMap, GraphData & data);
 
+/// \brief Fills |schedule| with trips of lines of |data| departing every line interval during
+/// the service day. Running times between stops are weights of transit edges and footpaths are
+/// transfer edges.
+/// \note Transit json has no timetables, so the trips are evenly spread. Lines with stops which
+/// aren't connected by edges of the line are skipped.
+void FillSchedule(GraphData const & data, Schedule & schedule);
+
 /// \brief Builds the transit section in the mwm based on transit graph in json which represents
 /// transit graph clipped by the mwm borders.
 /// \param mwmDir relative or full path to a directory where mwm is located.
@@ -28,6 +36,7 @@ void ProcessGraph(std::string const & mwmPath, storage::TCountryId const & count
 /// \param osmIdToFeatureIdsPath is a path to a file with osm id to feature ids mapping.
 /// \param transitDir relative or full path to a directory with json files of transit graphs.
 /// It's assumed that the files have the same name with country ids and extension TRANSIT_FILE_EXTENSION.
+/// The transit schedule section is built along with the transit section.
 /// \note An mwm pointed by |mwmPath| should contain:
 /// * feature geometry
 /// * index graph (ROUTING_FILE_TAG)
@@ -15,12 +15,16 @@
 #include "geometry/point2d.hpp"
 
 #include "base/assert.hpp"
+#include "base/parallel.hpp"
 
 #include <string>
 #include <vector>
 
 namespace generator
 {
+// static
+size_t constexpr TranslatorPlanet::kBatchSize;
+
 TranslatorPlanet::TranslatorPlanet(std::shared_ptr<EmitterInterface> emitter,
                                    cache::IntermediateDataReader & holder,
                                    feature::GenerateInfo const & info) :
@@ -52,48 +56,150 @@ TranslatorPlanet::TranslatorPlanet(std::shared_ptr<EmitterInterface> emitter,
     m_routingTagsProcessor.m_cameraNodeWriter.Open(camerasToWaysFilePath, camerasNodesToWaysFilePath,
                                                    camerasMaxSpeedFilePath);
   }
+
+  // The calling thread is a worker too.
+  if (info.m_featuresThreadsCount > 1)
+  {
+    m_scheduler = std::make_unique<base::TaskScheduler>(info.m_featuresThreadsCount - 1);
+    m_batchSize = kBatchSize;
+  }
 }
 
 void TranslatorPlanet::EmitElement(OsmElement * p)
 {
   CHECK(p, ("Tried to emit a null OsmElement"));
 
-  FeatureParams params;
-  switch (p->type)
-  {
-  case OsmElement::EntityType::Node:
+  m_batch.emplace_back();
+  m_batch.back().m_element = *p;
+  if (m_batch.size() >= m_batchSize)
+    Flush();
+}
+
+bool TranslatorPlanet::Finish()
+{
+  Flush();
+  return m_emitter->Finish();
+}
+
+void TranslatorPlanet::GetNames(std::vector<std::string> & names) const
+{
+  m_emitter->GetNames(names);
+}
+
+void TranslatorPlanet::Flush()
+{
+  auto const forEach = [this](auto && fn) {
+    if (!m_scheduler)
+    {
+      for (auto & e : m_batch)
+        fn(e);
+      return;
+    }
+
+    size_t const kMinChunkSize = 256;
+    base::ParallelFor(0, m_batch.size(), [&](size_t i) { fn(m_batch[i]); }, kMinChunkSize,
+                      *m_scheduler);
+  };
+
+  forEach([this](Element & e) { Prepare(e); });
+
+  // Relations are read by a cache reader which isn't thread-safe, restrictions are written
+  // while tags of relations are added.
+  for (auto & e : m_batch)
   {
-    if (p->m_tags.empty())
-      break;
+    if (!e.m_skip)
+      AddRelationTags(e.m_element);
+  }
 
-    if (!ParseType(p, params))
-      break;
+  forEach([](Element & e) {
+    if (e.m_skip)
+      return;
 
-    m2::PointD const pt = MercatorBounds::FromLatLon(p->lat, p->lon);
-    EmitPoint(pt, params, base::MakeOsmNode(p->id));
+    // Get params from element tags.
+    ftype::GetNameAndType(&e.m_element, e.m_params);
+    e.m_skip = !e.m_params.IsValid();
+  });
+
+  for (auto & e : m_batch)
+  {
+    if (!e.m_skip)
+      Emit(e);
+  }
+  m_batch.clear();
+}
+
+void TranslatorPlanet::Prepare(Element & e) const
+{
+  auto const & p = e.m_element;
+  switch (p.type)
+  {
+  case OsmElement::EntityType::Node:
+  {
+    e.m_skip = p.m_tags.empty();
     break;
   }
   case OsmElement::EntityType::Way:
   {
-    FeatureBuilder1 ft;
-    m2::PointD pt;
     // Parse geometry.
-    for (uint64_t ref : p->Nodes())
+    auto & ft = e.m_feature;
+    m2::PointD pt;
+    for (uint64_t ref : p.Nodes())
     {
       if (!m_cache.GetNode(ref, pt.y, pt.x))
         break;
       ft.AddPoint(pt);
     }
 
-    if (p->Nodes().size() != ft.GetPointsCount())
-      break;
+    e.m_skip = p.Nodes().size() != ft.GetPointsCount() || ft.GetPointsCount() < 2;
+    break;
+  }
+  case OsmElement::EntityType::Relation:
+  {
+    e.m_skip = !p.HasTagValue("type", "multipolygon") && !p.HasTagValue("type", "boundary");
+    break;
+  }
+  default:
+  {
+    e.m_skip = true;
+    break;
+  }
+  }
+}
+
+void TranslatorPlanet::AddRelationTags(OsmElement & p)
+{
+  // Get tags from parent relations.
+  if (p.IsNode())
+  {
+    m_nodeRelations.Reset(p.id, &p);
+    m_cache.ForEachRelationByNodeCached(p.id, m_nodeRelations);
+  }
+  else if (p.IsWay())
+  {
+    m_wayRelations.Reset(p.id, &p);
+    m_cache.ForEachRelationByWayCached(p.id, m_wayRelations);
+  }
+}
 
-    if (ft.GetPointsCount() < 2)
-      break;
+void TranslatorPlanet::Emit(Element & e)
+{
+  auto * p = &e.m_element;
+  auto const & params = e.m_params;
 
-    if (!ParseType(p, params))
-      break;
+  m_routingTagsProcessor.m_cameraNodeWriter.Process(*p, params, m_cache);
+  m_routingTagsProcessor.m_roadAccessWriter.Process(*p);
 
+  switch (p->type)
+  {
+  case OsmElement::EntityType::Node:
+  {
+    m2::PointD const pt = MercatorBounds::FromLatLon(p->lat, p->lon);
+    EmitPoint(pt, params, base::MakeOsmNode(p->id));
+    break;
+  }
+  case OsmElement::EntityType::Way:
+  {
+    auto & ft = e.m_feature;
     ft.SetOsmId(base::MakeOsmWay(p->id));
     bool isCoastline = (m_coastType != 0 && params.IsTypeExist(m_coastType));
 
@@ -112,12 +218,6 @@ void TranslatorPlanet::EmitElement(OsmElement * p)
   }
   case OsmElement::EntityType::Relation:
   {
-    if (!p->HasTagValue("type", "multipolygon") && !p->HasTagValue("type", "boundary"))
-      break;
-
-    if (!ParseType(p, params))
-      break;
-
     HolesRelation helper(m_cache);
     helper.Build(p);
 
@@ -147,40 +247,6 @@ void TranslatorPlanet::EmitElement(OsmElement * p)
   }
 }
 
-bool TranslatorPlanet::Finish()
-{
-  return m_emitter->Finish();
-}
-
-void TranslatorPlanet::GetNames(std::vector<std::string> & names) const
-{
-  m_emitter->GetNames(names);
-}
-
-bool TranslatorPlanet::ParseType(OsmElement * p, FeatureParams & params)
-{
-  // Get tags from parent relations.
-  if (p->IsNode())
-  {
-    m_nodeRelations.Reset(p->id, p);
-    m_cache.ForEachRelationByNodeCached(p->id, m_nodeRelations);
-  }
-  else if (p->IsWay())
-  {
-    m_wayRelations.Reset(p->id, p);
-    m_cache.ForEachRelationByWayCached(p->id, m_wayRelations);
-  }
-
-  // Get params from element tags.
-  ftype::GetNameAndType(p, params);
-  if (!params.IsValid())
-    return false;
-
-  m_routingTagsProcessor.m_cameraNodeWriter.Process(*p, params, m_cache);
-  m_routingTagsProcessor.m_roadAccessWriter.Process(*p);
-  return true;
-}
-
 void TranslatorPlanet::EmitPoint(m2::PointD const & pt, FeatureParams params,
                                  base::GeoObjectId id) const
 {
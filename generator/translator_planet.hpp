@@ -1,21 +1,24 @@
 #pragma once
 
 #include "generator/camera_info_collector.hpp"
+#include "generator/feature_builder.hpp"
 #include "generator/metalines_builder.hpp"
 #include "generator/relation_tags.hpp"
 #include "generator/routing_helpers.hpp"
+#include "generator/osm_element.hpp"
 #include "generator/translator_interface.hpp"
 
 #include "indexer/feature_data.hpp"
 
 #include "base/geo_object_id.hpp"
+#include "base/task_scheduler.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
-struct OsmElement;
-class FeatureBuilder1;
 namespace feature
 {
 struct GenerateInfo;
@@ -30,6 +33,11 @@ class IntermediateDataReader;
 }  // namespace cache
 
 // Osm to feature translator for planet.
+//
+// When GenerateInfo::m_featuresThreadsCount is greater than one, elements are translated in
+// batches: geometry of ways and types of elements are built by worker threads, while
+// everything which reads the cache of relations or writes files is done by the calling thread
+// in the order of elements. So the output doesn't depend on the number of threads.
 class TranslatorPlanet : public TranslatorInterface
 {
 public:
@@ -42,7 +50,23 @@ public:
   void GetNames(std::vector<std::string> & names) const override;
 
 private:
-  bool ParseType(OsmElement * p, FeatureParams & params);
+  struct Element
+  {
+    OsmElement m_element;
+    FeatureParams m_params;
+    // Geometry of a way.
+    FeatureBuilder1 m_feature;
+    bool m_skip = false;
+  };
+
+  static size_t constexpr kBatchSize = 16 * 1024;
+
+  void Flush();
+  // Builds geometry of ways and checks whether the element may become a feature.
+  // Is called by the worker threads.
+  void Prepare(Element & e) const;
+  void AddRelationTags(OsmElement & p);
+  void Emit(Element & e);
   void EmitFeatureBase(FeatureBuilder1 & ft, FeatureParams const & params) const;
   /// @param[in]  params  Pass by value because it can be modified.
   void EmitPoint(m2::PointD const & pt, FeatureParams params, base::GeoObjectId id) const;
@@ -58,5 +82,9 @@ private:
   RelationTagsNode m_nodeRelations;
   RelationTagsWay m_wayRelations;
   feature::MetalinesBuilder m_metalinesBuilder;
+
+  std::unique_ptr<base::TaskScheduler> m_scheduler;
+  std::vector<Element> m_batch;
+  size_t m_batchSize = 1;
 };
 }  // namespace generator
@@ -1,7 +1,12 @@
 #include "generator/ways_merger.hpp"
 
+#include <algorithm>
+
 namespace generator
 {
+// static
+size_t constexpr AreaWayMerger::kNoWay;
+
 AreaWayMerger::AreaWayMerger(cache::IntermediateDataReader & holder) :
   m_holder(holder)
 {
@@ -9,11 +14,76 @@ AreaWayMerger::AreaWayMerger(cache::IntermediateDataReader & holder) :
 
 void AreaWayMerger::AddWay(uint64_t id)
 {
-  auto e = std::make_shared<WayElement>(id);
-  if (m_holder.GetWay(id, *e) && e->IsValid())
+  WayElement e(id);
+  if (m_holder.GetWay(id, e) && e.IsValid())
+    m_ways.push_back(std::move(e));
+}
+
+void AreaWayMerger::BuildIndex()
+{
+  m_used.assign(m_ways.size(), false);
+  m_endpoints.clear();
+  m_endpoints.reserve(2 * m_ways.size());
+  m_starts.clear();
+  m_starts.reserve(2 * m_ways.size());
+  m_nextStart = 0;
+
+  for (size_t i = 0; i < m_ways.size(); ++i)
   {
-    m_map.emplace(e->nodes.front(), e);
-    m_map.emplace(e->nodes.back(), e);
+    for (auto const node : {m_ways[i].nodes.front(), m_ways[i].nodes.back()})
+    {
+      m_endpoints[node].push_back(i);
+      m_starts.emplace_back(node, i);
+    }
   }
+
+  std::stable_sort(m_starts.begin(), m_starts.end(),
+                   [](std::pair<uint64_t, size_t> const & lhs,
+                      std::pair<uint64_t, size_t> const & rhs) {
+                     return lhs.first < rhs.first;
+                   });
+}
+
+void AreaWayMerger::Clear()
+{
+  m_ways.clear();
+  m_used.clear();
+  m_endpoints.clear();
+  m_starts.clear();
+  m_nextStart = 0;
+}
+
+bool AreaWayMerger::TakeFirstWay(size_t & way, uint64_t & node)
+{
+  while (m_nextStart < m_starts.size() && m_used[m_starts[m_nextStart].second])
+    ++m_nextStart;
+
+  if (m_nextStart == m_starts.size())
+    return false;
+
+  node = m_starts[m_nextStart].first;
+  way = m_starts[m_nextStart].second;
+  m_used[way] = true;
+  return true;
+}
+
+size_t AreaWayMerger::TakeWay(uint64_t node)
+{
+  auto const it = m_endpoints.find(node);
+  if (it == m_endpoints.end())
+    return kNoWay;
+
+  // Used ways are dropped lazily, every index is dropped once.
+  auto & ways = it->second;
+  while (!ways.empty() && m_used[ways.back()])
+    ways.pop_back();
+
+  if (ways.empty())
+    return kNoWay;
+
+  auto const way = ways.back();
+  ways.pop_back();
+  m_used[way] = true;
+  return way;
 }
 }  // namespace generator
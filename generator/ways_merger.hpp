@@ -5,78 +5,85 @@
 
 #include "geometry/point2d.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <map>
-#include <memory>
+#include <limits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace generator
 {
+// Assembles rings of multipolygon relations from their ways. Ways are chained by their
+// endpoints through a hash index, so assembling is linear in the number of ways.
 class AreaWayMerger
 {
   using PointSeq = std::vector<m2::PointD>;
-  using WayMap = std::multimap<uint64_t, std::shared_ptr<WayElement>>;
-  using WayMapIterator = WayMap::iterator;
 
 public:
   explicit AreaWayMerger(cache::IntermediateDataReader & holder);
 
   void AddWay(uint64_t id);
 
+  // Calls |toDo(points, ids)| for every closed ring, |ids| are osm ids of the ways of the ring
+  // when |collectID| is true. All the added ways are consumed.
   template <class ToDo>
   void ForEachArea(bool collectID, ToDo toDo)
   {
-    while (!m_map.empty())
-    {
-      // start
-      WayMapIterator i = m_map.begin();
-      uint64_t id = i->first;
+    BuildIndex();
 
+    size_t way;
+    uint64_t id;
+    while (TakeFirstWay(way, id))
+    {
       std::vector<uint64_t> ids;
       PointSeq points;
 
       do
       {
         // process way points
-        std::shared_ptr<WayElement> e = i->second;
+        WayElement & e = m_ways[way];
         if (collectID)
-          ids.push_back(e->m_wayOsmId);
+          ids.push_back(e.m_wayOsmId);
 
-        e->ForEachPointOrdered(id, [this, &points](uint64_t id)
+        e.ForEachPointOrdered(id, [this, &points](uint64_t id)
         {
           m2::PointD pt;
           if (m_holder.GetNode(id, pt.y, pt.x))
             points.push_back(pt);
         });
 
-        m_map.erase(i);
-
         // next 'id' to process
-        id = e->GetOtherEndPoint(id);
-        std::pair<WayMapIterator, WayMapIterator> r = m_map.equal_range(id);
-
-        // finally erase element 'e' and find next way in chain
-        i = r.second;
-        while (r.first != r.second)
-        {
-          if (r.first->second == e)
-            m_map.erase(r.first++);
-          else
-            i = r.first++;
-        }
-
-        if (i == r.second)
-          break;
-      } while (true);
+        id = e.GetOtherEndPoint(id);
+        way = TakeWay(id);
+      } while (way != kNoWay);
 
       if (points.size() > 2 && points.front() == points.back())
         toDo(points, ids);
     }
+
+    Clear();
   }
 
 private:
+  static size_t constexpr kNoWay = std::numeric_limits<size_t>::max();
+
+  void BuildIndex();
+  void Clear();
+
+  // Takes an unused way to start a ring from. Rings are started from the endpoints in the order
+  // of node ids, so the result doesn't depend on hashing.
+  bool TakeFirstWay(size_t & way, uint64_t & node);
+  // Takes the last added unused way which ends at |node|, returns kNoWay when there is none.
+  size_t TakeWay(uint64_t node);
+
   cache::IntermediateDataReader & m_holder;
-  WayMap m_map;
+  std::vector<WayElement> m_ways;
+  std::vector<bool> m_used;
+  // Node id -> indexes of the ways which end at the node, in the order of adding.
+  std::unordered_map<uint64_t, std::vector<size_t>> m_endpoints;
+  // Endpoints of all the ways sorted by node ids.
+  std::vector<std::pair<uint64_t, size_t>> m_starts;
+  size_t m_nextStart = 0;
 };
 }  // namespace generator
@@ -248,7 +248,8 @@ class WorldMapGenerator
 
   EmitterImpl m_worldBucket;
   FeatureTypesProcessor m_typesCorrector;
-  FeatureMergeProcessor m_merger;
+  // Lines are merged by types in parallel.
+  ParallelFeatureMergeProcessor m_merger;
   WaterBoundaryChecker m_boundaryChecker;
   generator::PopularPlaces m_popularPlaces;
 
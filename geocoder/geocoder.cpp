@@ -8,6 +8,9 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
 #include <utility>
 
 using namespace std;
@@ -70,11 +73,23 @@ bool FindParent(vector<geocoder::Geocoder::Layer> const & layers,
 namespace geocoder
 {
 // Geocoder::Context -------------------------------------------------------------------------------
-Geocoder::Context::Context(string const & query)
+Geocoder::Context::Context(string const & query) { SetQuery(query); }
+
+void Geocoder::Context::SetQuery(string const & query)
 {
+  Clear();
+  m_tokens.clear();
   search::NormalizeAndTokenizeString(query, m_tokens);
   m_tokenTypes.assign(m_tokens.size(), Type::Count);
+}
+
+void Geocoder::Context::Clear()
+{
+  m_tokenTypes.assign(m_tokens.size(), Type::Count);
   m_numUsedTokens = 0;
+  m_results.clear();
+  m_layers.clear();
+  m_spans.clear();
 }
 
 vector<Type> & Geocoder::Context::GetTokenTypes() { return m_tokenTypes; }
@@ -131,10 +146,24 @@ vector<Geocoder::Layer> & Geocoder::Context::GetLayers() { return m_layers; }
 
 vector<Geocoder::Layer> const & Geocoder::Context::GetLayers() const { return m_layers; }
 
+vector<vector<vector<Hierarchy::Entry> const *>> & Geocoder::Context::GetSpans()
+{
+  return m_spans;
+}
+
 // Geocoder ----------------------------------------------------------------------------------------
-Geocoder::Geocoder(string pathToJsonHierarchy) : m_hierarchy(pathToJsonHierarchy) {}
+Geocoder::Geocoder(string pathToHierarchy, unsigned loadingThreadsCount)
+  : m_hierarchy(pathToHierarchy, loadingThreadsCount)
+{
+}
 
 void Geocoder::ProcessQuery(string const & query, vector<Result> & results) const
+{
+  Context ctx;
+  ProcessQuery(query, ctx, results);
+}
+
+void Geocoder::ProcessQuery(string const & query, Context & ctx, vector<Result> & results) const
 {
 #if defined(DEBUG)
   base::Timer timer;
@@ -143,13 +172,72 @@ void Geocoder::ProcessQuery(string const & query, vector<Result> & results) cons
   });
 #endif
 
-  Context ctx(query);
+  ctx.SetQuery(query);
+  FillSpans(ctx);
   Go(ctx, Type::Country);
   ctx.FillResults(results);
 }
 
+void Geocoder::ProcessQueries(vector<string> const & queries, unsigned threadsCount,
+                              vector<vector<Result>> & results) const
+{
+  results.assign(queries.size(), {});
+  threadsCount = max(1u, min(threadsCount, static_cast<unsigned>(queries.size())));
+
+  // The queries are taken one by one because their processing times differ a lot.
+  atomic<size_t> next(0);
+  auto const process = [&]() {
+    Context ctx;
+    for (size_t i = next++; i < queries.size(); i = next++)
+      ProcessQuery(queries[i], ctx, results[i]);
+  };
+
+  vector<thread> threads;
+  for (unsigned i = 1; i < threadsCount; ++i)
+    threads.emplace_back(process);
+  process();
+  for (auto & t : threads)
+    t.join();
+}
+
 Hierarchy const & Geocoder::GetHierarchy() const { return m_hierarchy; }
 
+void Geocoder::FillSpans(Context & ctx) const
+{
+  auto & spans = ctx.GetSpans();
+  spans.assign(ctx.GetNumTokens(), {});
+
+  vector<strings::UniString> subquery;
+  vector<uint32_t> candidates;
+  vector<uint32_t> ids;
+  vector<uint32_t> intersection;
+  for (size_t i = 0; i < ctx.GetNumTokens(); ++i)
+  {
+    subquery.clear();
+    for (size_t j = i; j < ctx.GetNumTokens(); ++j)
+    {
+      m_hierarchy.GetAddressIds(ctx.GetToken(j), ids);
+      if (j == i)
+      {
+        candidates.swap(ids);
+      }
+      else
+      {
+        intersection.clear();
+        set_intersection(candidates.begin(), candidates.end(), ids.begin(), ids.end(),
+                         back_inserter(intersection));
+        candidates.swap(intersection);
+      }
+
+      if (candidates.empty())
+        break;
+
+      subquery.push_back(ctx.GetToken(j));
+      spans[i].push_back(m_hierarchy.GetEntries(subquery));
+    }
+  }
+}
+
 void Geocoder::Go(Context & ctx, Type type) const
 {
   if (ctx.GetNumTokens() == 0)
@@ -161,18 +249,15 @@ void Geocoder::Go(Context & ctx, Type type) const
   if (type == Type::Count)
     return;
 
-  vector<strings::UniString> subquery;
   for (size_t i = 0; i < ctx.GetNumTokens(); ++i)
   {
-    subquery.clear();
-    for (size_t j = i; j < ctx.GetNumTokens(); ++j)
+    auto const & spans = ctx.GetSpans()[i];
+    for (size_t j = i; j < ctx.GetNumTokens() && j - i < spans.size(); ++j)
     {
       if (ctx.IsTokenUsed(j))
         break;
 
-      subquery.push_back(ctx.GetToken(j));
-
-      auto const * entries = m_hierarchy.GetEntries(subquery);
+      auto const * entries = spans[j - i];
       if (!entries || entries->empty())
         continue;
 
@@ -45,7 +45,11 @@ public:
   class Context
   {
   public:
-    Context(std::string const & query);
+    Context() = default;
+    explicit Context(std::string const & query);
+
+    // Prepares the context for |query|. The buffers of the previous query are reused.
+    void SetQuery(std::string const & query);
 
     void Clear();
 
@@ -71,6 +75,10 @@ public:
 
     std::vector<Layer> const & GetLayers() const;
 
+    // |GetSpans()[i][k]| is the result of Hierarchy::GetEntries() for the tokens [i, i + k].
+    // The longer subqueries which start at i are not contained in any address.
+    std::vector<std::vector<std::vector<Hierarchy::Entry> const *>> & GetSpans();
+
   private:
     // todo(@m) std::string?
     std::vector<strings::UniString> m_tokens;
@@ -82,15 +90,32 @@ public:
     std::unordered_map<base::GeoObjectId, double> m_results;
 
     std::vector<Layer> m_layers;
+
+    std::vector<std::vector<std::vector<Hierarchy::Entry> const *>> m_spans;
   };
 
-  explicit Geocoder(std::string pathToJsonHierarchy);
+  // |pathToHierarchy| is either a json lines or a binary hierarchy, see Hierarchy.
+  explicit Geocoder(std::string pathToHierarchy, unsigned loadingThreadsCount = 1);
 
   void ProcessQuery(std::string const & query, std::vector<Result> & results) const;
+  // The same as above but with the buffers of |ctx|, a context per thread may be reused
+  // for many queries.
+  void ProcessQuery(std::string const & query, Context & ctx, std::vector<Result> & results) const;
+
+  // Processes |queries| concurrently by |threadsCount| threads, |results[i]| are the results
+  // of |queries[i]|. The hierarchy is shared between the threads, every thread has its own
+  // context.
+  void ProcessQueries(std::vector<std::string> const & queries, unsigned threadsCount,
+                      std::vector<std::vector<Result>> & results) const;
 
   Hierarchy const & GetHierarchy() const;
 
 private:
+  // Looks up the entries of all subqueries once per query. The subqueries which start at
+  // the same token are extended while the intersection of the address ids of their tokens
+  // is not empty, so the number of lookups depends on the query and not on the hierarchy.
+  void FillSpans(Context & ctx) const;
+
   void Go(Context & ctx, Type type) const;
 
   void EmitResult() const;
@@ -1,11 +1,14 @@
 #include "geocoder/geocoder.hpp"
+#include "geocoder/hierarchy.hpp"
 #include "geocoder/result.hpp"
 
 #include "base/string_utils.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -16,6 +19,19 @@ using namespace std;
 DEFINE_string(hierarchy_path, "", "Path to the hierarchy file for the geocoder");
 DEFINE_string(queries_path, "", "Path to the file with queries");
 DEFINE_int32(top, 5, "Number of top results to show for every query, -1 to show all results");
+DEFINE_string(binary_hierarchy_path, "",
+              "If set, the json hierarchy is converted to the binary one which is written to "
+              "this path and nothing else is done");
+DEFINE_int32(threads, 0,
+             "Number of threads to parse the json hierarchy and to process the queries from "
+             "the file, 0 to use all cores");
+
+unsigned GetThreadsCount()
+{
+  if (FLAGS_threads > 0)
+    return static_cast<unsigned>(FLAGS_threads);
+  return max(thread::hardware_concurrency(), 1u);
+}
 
 void PrintResults(vector<Result> const & results)
 {
@@ -36,26 +52,31 @@ void ProcessQueriesFromFile(string const & path)
   ifstream stream(path.c_str());
   CHECK(stream.is_open(), ("Can't open", path));
 
-  Geocoder geocoder(FLAGS_hierarchy_path);
+  Geocoder geocoder(FLAGS_hierarchy_path, GetThreadsCount());
 
-  vector<Result> results;
+  vector<string> queries;
   string s;
   while (getline(stream, s))
   {
     strings::Trim(s);
     if (s.empty())
       continue;
+    queries.push_back(s);
+  }
 
-    cout << s << endl;
-    geocoder.ProcessQuery(s, results);
-    PrintResults(results);
+  vector<vector<Result>> results;
+  geocoder.ProcessQueries(queries, GetThreadsCount(), results);
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    cout << queries[i] << endl;
+    PrintResults(results[i]);
     cout << endl;
   }
 }
 
 void ProcessQueriesFromCommandLine()
 {
-  Geocoder geocoder(FLAGS_hierarchy_path);
+  Geocoder geocoder(FLAGS_hierarchy_path, GetThreadsCount());
 
   string query;
   vector<Result> results;
@@ -78,6 +99,13 @@ int main(int argc, char * argv[])
   google::SetUsageMessage("Geocoder command line interface.");
   google::ParseCommandLineFlags(&argc, &argv, true);
 
+  if (!FLAGS_binary_hierarchy_path.empty())
+  {
+    Hierarchy hierarchy(FLAGS_hierarchy_path, GetThreadsCount());
+    hierarchy.SerializeToBinary(FLAGS_binary_hierarchy_path);
+    return 0;
+  }
+
   if (!FLAGS_queries_path.empty())
   {
     ProcessQueriesFromFile(FLAGS_queries_path);
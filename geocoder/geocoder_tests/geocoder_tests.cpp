@@ -1,6 +1,7 @@
 #include "testing/testing.hpp"
 
 #include "geocoder/geocoder.hpp"
+#include "geocoder/hierarchy.hpp"
 
 #include "indexer/search_string_utils.hpp"
 
@@ -79,4 +80,78 @@ UNIT_TEST(Geocoder_Hierarchy)
              ());
   TEST_EQUAL((*entries)[0].m_address[static_cast<size_t>(Type::Subregion)], Split("florencia"), ());
 }
+
+UNIT_TEST(Geocoder_ProcessQueries)
+{
+  ScopedFile const regionsJsonFile("regions.jsonl", kRegionsData);
+  Geocoder geocoder(regionsJsonFile.GetFullPath());
+
+  vector<string> const queries = {"florencia", "cuba florencia", "florencia somewhere in cuba",
+                                  "havana", "cuba"};
+  vector<vector<Result>> results;
+  geocoder.ProcessQueries(queries, 3 /* threadsCount */, results);
+  TEST_EQUAL(results.size(), queries.size(), ());
+
+  Geocoder::Context ctx;
+  vector<Result> expected;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    geocoder.ProcessQuery(queries[i], ctx, expected);
+    sort(expected.begin(), expected.end(), base::LessBy(&Result::m_osmId));
+    sort(results[i].begin(), results[i].end(), base::LessBy(&Result::m_osmId));
+    TEST_EQUAL(results[i].size(), expected.size(), (queries[i]));
+    for (size_t j = 0; j < expected.size(); ++j)
+      TEST_EQUAL(results[i][j].m_osmId, expected[j].m_osmId, (queries[i]));
+  }
+  TEST(results[3].empty(), ());
+}
+
+UNIT_TEST(Geocoder_AddressIds)
+{
+  ScopedFile const regionsJsonFile("regions.jsonl", kRegionsData);
+  Hierarchy hierarchy(regionsJsonFile.GetFullPath());
+
+  vector<uint32_t> cubaIds;
+  hierarchy.GetAddressIds(strings::MakeUniString("cuba"), cubaIds);
+  TEST_EQUAL(cubaIds.size(), 1, ());
+
+  vector<uint32_t> avilaIds;
+  hierarchy.GetAddressIds(strings::MakeUniString("avila"), avilaIds);
+  TEST_EQUAL(avilaIds.size(), 1, ());
+  TEST_NOT_EQUAL(cubaIds, avilaIds, ());
+
+  vector<uint32_t> ids;
+  hierarchy.GetAddressIds(strings::MakeUniString("havana"), ids);
+  TEST(ids.empty(), ());
+}
+
+UNIT_TEST(Geocoder_BinaryHierarchy)
+{
+  ScopedFile const regionsJsonFile("regions.jsonl", kRegionsData);
+  ScopedFile const regionsBinaryFile("regions.bin", ScopedFile::Mode::DoNotCreate);
+  {
+    Hierarchy hierarchy(regionsJsonFile.GetFullPath(), 2 /* threadsCount */);
+    TEST(!Hierarchy::IsBinary(regionsJsonFile.GetFullPath()), ());
+    hierarchy.SerializeToBinary(regionsBinaryFile.GetFullPath());
+  }
+  TEST(Hierarchy::IsBinary(regionsBinaryFile.GetFullPath()), ());
+
+  Geocoder geocoder(regionsBinaryFile.GetFullPath());
+
+  base::GeoObjectId const florenciaId(0xc00000000059d6b5);
+  base::GeoObjectId const cubaId(0xc00000000004b279);
+
+  TestGeocoder(geocoder, "florencia", {{florenciaId, 1.0}});
+  TestGeocoder(geocoder, "cuba florencia", {{florenciaId, 1.0}, {cubaId, 0.5}});
+  TestGeocoder(geocoder, "florencia somewhere in cuba", {{cubaId, 0.25}, {florenciaId, 0.5}});
+
+  auto const entries = geocoder.GetHierarchy().GetEntries(Split("ciego de avila"));
+  TEST(entries, ());
+  TEST_EQUAL(entries->size(), 1, ());
+  auto const & entry = (*entries)[0];
+  TEST_EQUAL(entry.m_name, "Ciego de Ávila", ());
+  TEST_EQUAL(entry.m_type, Type::Region, ());
+  TEST_EQUAL(entry.m_address[static_cast<size_t>(Type::Country)], Split("cuba"), ());
+  TEST(!geocoder.GetHierarchy().GetEntries(Split("havana")), ());
+}
 }  // namespace geocoder
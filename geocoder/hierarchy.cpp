@@ -2,15 +2,109 @@
 
 #include "indexer/search_string_utils.hpp"
 
+#include "coding/file_writer.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <thread>
 
 using namespace std;
 
+namespace
+{
+// The magic includes the terminating zero, so it takes 8 bytes.
+char const kBinaryMagic[] = "geohier";
+uint32_t constexpr kBinaryVersion = 1;
+// Magic, version, tokens count, keys count, reserved and offsets of four sections.
+uint64_t constexpr kBinaryHeaderSize = sizeof(kBinaryMagic) + 4 * sizeof(uint32_t) + 4 * sizeof(uint64_t);
+
+// Number of json lines which are parsed by a thread at once.
+size_t constexpr kLinesPerThread = 10000;
+
+using Entry = geocoder::Hierarchy::Entry;
+using ParsingStats = geocoder::Hierarchy::ParsingStats;
+
+bool ParseLine(string const & line, Entry & entry, ParsingStats & stats)
+{
+  auto const i = line.find(' ');
+  int64_t encodedId;
+  if (i == string::npos || !strings::to_any(line.substr(0, i), encodedId))
+  {
+    LOG(LWARNING, ("Cannot read osm id. Line:", line));
+    ++stats.m_badOsmIds;
+    return false;
+  }
+
+  // todo(@m) We should really write uints as uints.
+  entry.m_osmId = base::GeoObjectId(static_cast<uint64_t>(encodedId));
+  return entry.DeserializeFromJSON(line.substr(i + 1), stats);
+}
+
+void AddStats(ParsingStats const & from, ParsingStats & to)
+{
+  to.m_numLoaded += from.m_numLoaded;
+  to.m_badJsons += from.m_badJsons;
+  to.m_badOsmIds += from.m_badOsmIds;
+  to.m_duplicateAddresses += from.m_duplicateAddresses;
+  to.m_emptyAddresses += from.m_emptyAddresses;
+  to.m_emptyNames += from.m_emptyNames;
+  to.m_mismatchedNames += from.m_mismatchedNames;
+}
+
+template <typename T>
+T ReadAt(uint8_t const * data, uint64_t pos)
+{
+  T value;
+  memcpy(&value, data + pos, sizeof(value));
+  return value;
+}
+
+uint32_t GetTokenId(strings::UniString const & token, vector<string> const & dictionary)
+{
+  auto const utf8 = strings::ToUtf8(token);
+  auto const it = lower_bound(dictionary.begin(), dictionary.end(), utf8);
+  CHECK(it != dictionary.end() && *it == utf8, (token));
+  return static_cast<uint32_t>(distance(dictionary.begin(), it));
+}
+
+template <typename Sink>
+void WriteTokenIds(Sink & sink, geocoder::Tokens const & tokens,
+                   vector<string> const & dictionary)
+{
+  WriteVarUint(sink, base::asserted_cast<uint32_t>(tokens.size()));
+  for (auto const & token : tokens)
+    WriteVarUint(sink, GetTokenId(token, dictionary));
+}
+
+void AddAddressId(uint32_t addressId, vector<uint32_t> & ids)
+{
+  // A token may be repeated in an address.
+  if (ids.empty() || ids.back() != addressId)
+    ids.push_back(addressId);
+}
+
+template <typename Source>
+void ReadTokenIds(Source & src, vector<uint32_t> & ids)
+{
+  ids.resize(ReadVarUint<uint32_t>(src));
+  for (auto & id : ids)
+    id = ReadVarUint<uint32_t>(src);
+}
+}  // namespace
+
 namespace geocoder
 {
 // Hierarchy::Entry --------------------------------------------------------------------------------
@@ -86,43 +180,89 @@ void Hierarchy::Entry::DeserializeFromJSONImpl(json_t * const root, string const
 }
 
 // Hierarchy ---------------------------------------------------------------------------------------
-Hierarchy::Hierarchy(string const & pathToJsonHierarchy)
+Hierarchy::Hierarchy(string const & pathToHierarchy, unsigned threadsCount)
+{
+  if (IsBinary(pathToHierarchy))
+    MapBinary(pathToHierarchy);
+  else
+    LoadFromJSON(pathToHierarchy, threadsCount);
+}
+
+Hierarchy::~Hierarchy() = default;
+
+// static
+bool Hierarchy::IsBinary(string const & path)
+{
+  ifstream ifs(path, ios::binary);
+  char magic[sizeof(kBinaryMagic)] = {};
+  ifs.read(magic, sizeof(magic));
+  return ifs && memcmp(magic, kBinaryMagic, sizeof(magic)) == 0;
+}
+
+void Hierarchy::LoadFromJSON(string const & path, unsigned threadsCount)
 {
-  ifstream ifs(pathToJsonHierarchy);
+  threadsCount = max(threadsCount, 1u);
+
+  ifstream ifs(path);
   string line;
   ParsingStats stats;
 
-  while (getline(ifs, line))
-  {
-    if (line.empty())
-      continue;
-
-    auto i = line.find(' ');
-    int64_t encodedId;
-    if (i == string::npos || !strings::to_any(line.substr(0, i), encodedId))
+  // Lines are parsed by batches, every thread parses a contiguous part of a batch,
+  // so the entries are added in the order of the lines.
+  vector<string> lines;
+  vector<vector<Entry>> threadEntries(threadsCount);
+  vector<ParsingStats> threadStats(threadsCount);
+  auto const parseLines = [&](size_t thread) {
+    size_t const begin = lines.size() * thread / threadsCount;
+    size_t const end = lines.size() * (thread + 1) / threadsCount;
+    for (size_t i = begin; i < end; ++i)
     {
-      LOG(LWARNING, ("Cannot read osm id. Line:", line));
-      ++stats.m_badOsmIds;
-      continue;
+      Entry entry;
+      if (ParseLine(lines[i], entry, threadStats[thread]))
+        threadEntries[thread].emplace_back(move(entry));
     }
-    line = line.substr(i + 1);
-
-    Entry entry;
-    // todo(@m) We should really write uints as uints.
-    entry.m_osmId = base::GeoObjectId(static_cast<uint64_t>(encodedId));
+  };
 
-    if (!entry.DeserializeFromJSON(line, stats))
-      continue;
+  auto const processLines = [&]() {
+    vector<thread> threads;
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(parseLines, i);
+    parseLines(0);
+    for (auto & t : threads)
+      t.join();
 
-    // The entry is indexed only by its address.
-    // todo(@m) Index it by name too.
-    if (entry.m_type != Type::Count)
+    for (size_t i = 0; i < threadsCount; ++i)
     {
-      ++stats.m_numLoaded;
-      size_t const t = static_cast<size_t>(entry.m_type);
-      m_entries[entry.m_address[t]].emplace_back(entry);
+      for (auto & entry : threadEntries[i])
+      {
+        // The entry is indexed only by its address.
+        // todo(@m) Index it by name too.
+        if (entry.m_type == Type::Count)
+          continue;
+
+        ++stats.m_numLoaded;
+        size_t const t = static_cast<size_t>(entry.m_type);
+        m_entries[entry.m_address[t]].emplace_back(move(entry));
+      }
+      threadEntries[i].clear();
+      AddStats(threadStats[i], stats);
+      threadStats[i] = ParsingStats();
     }
+    lines.clear();
+  };
+
+  while (getline(ifs, line))
+  {
+    if (line.empty())
+      continue;
+
+    lines.emplace_back(move(line));
+    if (lines.size() == kLinesPerThread * threadsCount)
+      processLines();
   }
+  processLines();
+
+  BuildAddressIds();
 
   LOG(LINFO, ("Finished reading the hierarchy. Stats:"));
   LOG(LINFO, ("Entries indexed:", stats.m_numLoaded));
@@ -136,13 +276,316 @@ Hierarchy::Hierarchy(string const & pathToJsonHierarchy)
   LOG(LINFO, ("(End of stats.)"));
 }
 
+void Hierarchy::BuildAddressIds()
+{
+  m_addressIds.clear();
+  uint32_t addressId = 0;
+  for (auto const & kv : m_entries)
+  {
+    for (auto const & token : kv.first)
+      AddAddressId(addressId, m_addressIds[token]);
+    ++addressId;
+  }
+}
+
+void Hierarchy::MapBinary(string const & path)
+{
+  m_binary = make_unique<MmapReader>(path);
+  m_data = m_binary->Data();
+  CHECK_GREATER_OR_EQUAL(m_binary->Size(), kBinaryHeaderSize, (path));
+
+  uint64_t pos = sizeof(kBinaryMagic);
+  auto const version = ReadAt<uint32_t>(m_data, pos);
+  CHECK_EQUAL(version, kBinaryVersion, ("Unknown version of the binary hierarchy", path));
+  pos += sizeof(uint32_t);
+  m_tokensCount = ReadAt<uint32_t>(m_data, pos);
+  pos += sizeof(uint32_t);
+  m_keysCount = ReadAt<uint32_t>(m_data, pos);
+  pos += 2 * sizeof(uint32_t);
+  m_tokenOffsetsPos = ReadAt<uint64_t>(m_data, pos);
+  pos += sizeof(uint64_t);
+  m_keyOffsetsPos = ReadAt<uint64_t>(m_data, pos);
+  pos += sizeof(uint64_t);
+  m_postingOffsetsPos = ReadAt<uint64_t>(m_data, pos);
+  pos += sizeof(uint64_t);
+  m_entriesPos = ReadAt<uint64_t>(m_data, pos);
+
+  m_tokensPos = m_tokenOffsetsPos + (m_tokensCount + 1) * sizeof(uint64_t);
+  m_keysPos = m_keyOffsetsPos + (m_keysCount + 1) * sizeof(uint64_t);
+  m_postingsPos = m_postingOffsetsPos + (m_tokensCount + 1) * sizeof(uint64_t);
+  CHECK_LESS_OR_EQUAL(m_entriesPos, m_binary->Size(), (path));
+
+  LOG(LINFO, ("Mapped the binary hierarchy. Tokens:", m_tokensCount, "addresses:", m_keysCount));
+}
+
+void Hierarchy::SerializeToBinary(string const & path) const
+{
+  CHECK(!m_binary, ("The binary hierarchy can't be serialized again."));
+
+  vector<string> dictionary;
+  for (auto const & kv : m_entries)
+  {
+    for (auto const & entry : kv.second)
+    {
+      for (auto const & token : entry.m_nameTokens)
+        dictionary.push_back(strings::ToUtf8(token));
+      for (auto const & field : entry.m_address)
+      {
+        for (auto const & token : field)
+          dictionary.push_back(strings::ToUtf8(token));
+      }
+    }
+  }
+  sort(dictionary.begin(), dictionary.end());
+  dictionary.erase(unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+  // The addresses of |m_entries| are sorted as UniStrings. The order of utf8 strings is
+  // the same, so the addresses are sorted by token ids too.
+  vector<uint8_t> entriesBuffer;
+  vector<uint8_t> keysBuffer;
+  vector<uint64_t> keyOffsets;
+  vector<vector<uint32_t>> addressIds(dictionary.size());
+  {
+    MemWriter<vector<uint8_t>> entriesWriter(entriesBuffer);
+    MemWriter<vector<uint8_t>> keysWriter(keysBuffer);
+    for (auto const & kv : m_entries)
+    {
+      auto const addressId = static_cast<uint32_t>(keyOffsets.size());
+      for (auto const & token : kv.first)
+        AddAddressId(addressId, addressIds[GetTokenId(token, dictionary)]);
+
+      keyOffsets.push_back(keysWriter.Pos());
+      WriteTokenIds(keysWriter, kv.first, dictionary);
+      WriteVarUint(keysWriter, base::asserted_cast<uint32_t>(kv.second.size()));
+      WriteVarUint(keysWriter, entriesWriter.Pos());
+
+      for (auto const & entry : kv.second)
+      {
+        WriteToSink(entriesWriter, entry.m_osmId.GetEncodedId());
+        WriteToSink(entriesWriter, static_cast<uint8_t>(entry.m_type));
+        rw::Write(entriesWriter, entry.m_name);
+        WriteTokenIds(entriesWriter, entry.m_nameTokens, dictionary);
+        for (size_t i = 0; i < static_cast<size_t>(Type::Count); ++i)
+          WriteTokenIds(entriesWriter, entry.m_address[i], dictionary);
+      }
+    }
+    keyOffsets.push_back(keysWriter.Pos());
+  }
+
+  // The address ids of a token are delta coded.
+  vector<uint8_t> postingsBuffer;
+  vector<uint64_t> postingOffsets;
+  {
+    MemWriter<vector<uint8_t>> postingsWriter(postingsBuffer);
+    for (auto const & ids : addressIds)
+    {
+      postingOffsets.push_back(postingsWriter.Pos());
+      WriteVarUint(postingsWriter, base::asserted_cast<uint32_t>(ids.size()));
+      uint32_t prev = 0;
+      for (auto const id : ids)
+      {
+        WriteVarUint(postingsWriter, id - prev);
+        prev = id;
+      }
+    }
+    postingOffsets.push_back(postingsWriter.Pos());
+  }
+
+  FileWriter writer(path);
+  uint64_t const tokenOffsetsPos = kBinaryHeaderSize;
+  uint64_t tokensSize = 0;
+  for (auto const & token : dictionary)
+    tokensSize += token.size();
+  uint64_t const keyOffsetsPos =
+      tokenOffsetsPos + (dictionary.size() + 1) * sizeof(uint64_t) + tokensSize;
+  uint64_t const postingOffsetsPos =
+      keyOffsetsPos + keyOffsets.size() * sizeof(uint64_t) + keysBuffer.size();
+  uint64_t const entriesPos =
+      postingOffsetsPos + postingOffsets.size() * sizeof(uint64_t) + postingsBuffer.size();
+
+  writer.Write(kBinaryMagic, sizeof(kBinaryMagic));
+  WriteToSink(writer, kBinaryVersion);
+  WriteToSink(writer, base::asserted_cast<uint32_t>(dictionary.size()));
+  WriteToSink(writer, base::asserted_cast<uint32_t>(m_entries.size()));
+  WriteToSink(writer, uint32_t(0) /* reserved */);
+  WriteToSink(writer, tokenOffsetsPos);
+  WriteToSink(writer, keyOffsetsPos);
+  WriteToSink(writer, postingOffsetsPos);
+  WriteToSink(writer, entriesPos);
+  CHECK_EQUAL(writer.Pos(), tokenOffsetsPos, ());
+
+  uint64_t tokenOffset = 0;
+  for (auto const & token : dictionary)
+  {
+    WriteToSink(writer, tokenOffset);
+    tokenOffset += token.size();
+  }
+  WriteToSink(writer, tokenOffset);
+  for (auto const & token : dictionary)
+    writer.Write(token.data(), token.size());
+  CHECK_EQUAL(writer.Pos(), keyOffsetsPos, ());
+
+  for (auto const offset : keyOffsets)
+    WriteToSink(writer, offset);
+  writer.Write(keysBuffer.data(), keysBuffer.size());
+  CHECK_EQUAL(writer.Pos(), postingOffsetsPos, ());
+
+  for (auto const offset : postingOffsets)
+    WriteToSink(writer, offset);
+  writer.Write(postingsBuffer.data(), postingsBuffer.size());
+  CHECK_EQUAL(writer.Pos(), entriesPos, ());
+
+  writer.Write(entriesBuffer.data(), entriesBuffer.size());
+
+  LOG(LINFO, ("Binary hierarchy is written to", path, "tokens:", dictionary.size(),
+              "addresses:", m_entries.size(), "size:", writer.Pos(), "bytes"));
+}
+
 vector<Hierarchy::Entry> const * const Hierarchy::GetEntries(
     vector<strings::UniString> const & tokens) const
 {
+  lock_guard<mutex> lock(m_mutex);
   auto it = m_entries.find(tokens);
   if (it == m_entries.end())
-    return {};
+  {
+    if (!m_binary)
+      return {};
+
+    vector<Entry> entries;
+    DecodeEntries(tokens, entries);
+    it = m_entries.emplace(tokens, move(entries)).first;
+  }
 
+  if (it->second.empty())
+    return {};
   return &it->second;
 }
+
+void Hierarchy::GetAddressIds(strings::UniString const & token, vector<uint32_t> & ids) const
+{
+  ids.clear();
+  if (!m_binary)
+  {
+    auto const it = m_addressIds.find(token);
+    if (it != m_addressIds.end())
+      ids = it->second;
+    return;
+  }
+
+  uint32_t tokenId;
+  if (!FindTokenId(token, tokenId))
+    return;
+
+  auto const begin = ReadAt<uint64_t>(m_data, m_postingOffsetsPos + tokenId * sizeof(uint64_t));
+  auto const end = ReadAt<uint64_t>(m_data, m_postingOffsetsPos + (tokenId + 1) * sizeof(uint64_t));
+  MemReader reader(m_data + m_postingsPos + begin, static_cast<size_t>(end - begin));
+  ReaderSource<MemReader> src(reader);
+  ids.resize(ReadVarUint<uint32_t>(src));
+  uint32_t prev = 0;
+  for (auto & id : ids)
+  {
+    id = prev + ReadVarUint<uint32_t>(src);
+    prev = id;
+  }
+}
+
+bool Hierarchy::DecodeEntries(Tokens const & tokens, vector<Entry> & entries) const
+{
+  entries.clear();
+
+  vector<uint32_t> ids(tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    if (!FindTokenId(tokens[i], ids[i]))
+      return false;
+  }
+
+  // Binary search of the address among the sorted addresses.
+  vector<uint32_t> keyIds;
+  uint32_t lo = 0;
+  uint32_t hi = m_keysCount;
+  while (lo < hi)
+  {
+    uint32_t const mid = lo + (hi - lo) / 2;
+    auto const begin = ReadAt<uint64_t>(m_data, m_keyOffsetsPos + mid * sizeof(uint64_t));
+    auto const end = ReadAt<uint64_t>(m_data, m_keyOffsetsPos + (mid + 1) * sizeof(uint64_t));
+    MemReader reader(m_data + m_keysPos + begin, static_cast<size_t>(end - begin));
+    ReaderSource<MemReader> src(reader);
+    ReadTokenIds(src, keyIds);
+    if (keyIds < ids)
+    {
+      lo = mid + 1;
+      continue;
+    }
+    if (ids < keyIds)
+    {
+      hi = mid;
+      continue;
+    }
+
+    auto const count = ReadVarUint<uint32_t>(src);
+    auto const offset = ReadVarUint<uint64_t>(src);
+    uint64_t const entriesBegin = m_entriesPos + offset;
+    MemReader entriesReader(m_data + entriesBegin,
+                            static_cast<size_t>(m_binary->Size() - entriesBegin));
+    ReaderSource<MemReader> entriesSrc(entriesReader);
+
+    entries.resize(count);
+    vector<uint32_t> tokenIds;
+    auto const readTokens = [&](Tokens & result) {
+      ReadTokenIds(entriesSrc, tokenIds);
+      result.clear();
+      result.reserve(tokenIds.size());
+      for (auto const id : tokenIds)
+        result.push_back(GetToken(id));
+    };
+    for (auto & entry : entries)
+    {
+      entry.m_osmId = base::GeoObjectId(ReadPrimitiveFromSource<uint64_t>(entriesSrc));
+      entry.m_type = static_cast<Type>(ReadPrimitiveFromSource<uint8_t>(entriesSrc));
+      rw::Read(entriesSrc, entry.m_name);
+      readTokens(entry.m_nameTokens);
+      for (size_t i = 0; i < static_cast<size_t>(Type::Count); ++i)
+        readTokens(entry.m_address[i]);
+    }
+    return true;
+  }
+  return false;
+}
+
+bool Hierarchy::FindTokenId(strings::UniString const & token, uint32_t & id) const
+{
+  string const utf8 = strings::ToUtf8(token);
+  uint32_t lo = 0;
+  uint32_t hi = m_tokensCount;
+  while (lo < hi)
+  {
+    uint32_t const mid = lo + (hi - lo) / 2;
+    auto const begin = ReadAt<uint64_t>(m_data, m_tokenOffsetsPos + mid * sizeof(uint64_t));
+    auto const end = ReadAt<uint64_t>(m_data, m_tokenOffsetsPos + (mid + 1) * sizeof(uint64_t));
+    int const cmp = utf8.compare(0, string::npos,
+                                 reinterpret_cast<char const *>(m_data + m_tokensPos + begin),
+                                 static_cast<size_t>(end - begin));
+    if (cmp == 0)
+    {
+      id = mid;
+      return true;
+    }
+    if (cmp < 0)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return false;
+}
+
+strings::UniString Hierarchy::GetToken(uint32_t id) const
+{
+  CHECK_LESS(id, m_tokensCount, ());
+  auto const begin = ReadAt<uint64_t>(m_data, m_tokenOffsetsPos + id * sizeof(uint64_t));
+  auto const end = ReadAt<uint64_t>(m_data, m_tokenOffsetsPos + (id + 1) * sizeof(uint64_t));
+  return strings::MakeUniString(
+      string(reinterpret_cast<char const *>(m_data + m_tokensPos + begin),
+             static_cast<size_t>(end - begin)));
+}
 }  // namespace geocoder
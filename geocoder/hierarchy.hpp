@@ -9,12 +9,16 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "3party/jansson/myjansson.hpp"
 
+class MmapReader;
+
 namespace geocoder
 {
 class Hierarchy
@@ -70,17 +74,70 @@ public:
     std::array<Tokens, static_cast<size_t>(Type::Count) + 1> m_address;
   };
 
-  explicit Hierarchy(std::string const & pathToJsonHierarchy);
+  // Reads the hierarchy from |pathToHierarchy| which is either a json lines file or
+  // a binary hierarchy written by SerializeToBinary(). Json lines are parsed by |threadsCount|
+  // threads. The binary hierarchy is mapped and nothing is parsed on loading: the entries
+  // are decoded when they are requested by GetEntries() for the first time.
+  explicit Hierarchy(std::string const & pathToHierarchy, unsigned threadsCount = 1);
+  ~Hierarchy();
 
   // Returns a pointer to entries whose names exactly match |tokens|
   // (the order matters) or nullptr if there are no such entries.
+  // The pointer is valid during the lifetime of the hierarchy.
   //
   // todo This method (and the whole class, in fact) is in the
   //      prototype stage and may be too slow. Proper indexing should
   //      be implemented to perform this type of queries.a
   std::vector<Entry> const * const GetEntries(std::vector<strings::UniString> const & tokens) const;
 
+  // Returns the sorted ids of the addresses which contain |token|. An address is the key
+  // of GetEntries() and its id is its index among all the addresses sorted by tokens,
+  // so the ids of a query token are intersected to find the addresses which contain
+  // all the tokens of a subquery.
+  void GetAddressIds(strings::UniString const & token, std::vector<uint32_t> & ids) const;
+
+  // Writes the hierarchy which is read from json lines to |path| in the binary format.
+  // The format is:
+  // * header: magic, version and offsets of the sections;
+  // * dictionary of the tokens sorted in utf8, a token is referred by its index;
+  // * index of the addresses: token ids of an address and the position of its entries,
+  //   the addresses are sorted by token ids;
+  // * inverted index: delta coded ids of the addresses which contain a token, by token ids;
+  // * entries: osm id, type, name and token ids of the name and of the address fields.
+  //   The address fields are the links to the parents of the entry.
+  void SerializeToBinary(std::string const & path) const;
+
+  // Returns true if |path| is a binary hierarchy.
+  static bool IsBinary(std::string const & path);
+
 private:
-  std::map<Tokens, std::vector<Entry>> m_entries;
+  void LoadFromJSON(std::string const & path, unsigned threadsCount);
+  void MapBinary(std::string const & path);
+  void BuildAddressIds();
+
+  // Decodes the entries of the binary hierarchy whose address is |tokens|.
+  // Returns false if there are no such entries.
+  bool DecodeEntries(Tokens const & tokens, std::vector<Entry> & entries) const;
+  bool FindTokenId(strings::UniString const & token, uint32_t & id) const;
+  strings::UniString GetToken(uint32_t id) const;
+
+  // Entries by their addresses. For the binary hierarchy it's the cache of the decoded entries,
+  // the addresses without entries are cached with empty vectors.
+  mutable std::map<Tokens, std::vector<Entry>> m_entries;
+  mutable std::mutex m_mutex;
+  // The inverted index of the json hierarchy.
+  std::map<strings::UniString, std::vector<uint32_t>> m_addressIds;
+
+  std::unique_ptr<MmapReader> m_binary;
+  uint8_t const * m_data = nullptr;
+  uint32_t m_tokensCount = 0;
+  uint64_t m_tokenOffsetsPos = 0;
+  uint64_t m_tokensPos = 0;
+  uint32_t m_keysCount = 0;
+  uint64_t m_keyOffsetsPos = 0;
+  uint64_t m_keysPos = 0;
+  uint64_t m_postingOffsetsPos = 0;
+  uint64_t m_postingsPos = 0;
+  uint64_t m_entriesPos = 0;
 };
 }  // namespace geocoder
@@ -233,12 +233,9 @@ public:
     for (int i = 0; i <= m_level; ++i, bits >>= 2)
       res += bits + 1;
 
-    bits = m_bits;
-    for (int i = m_level + 1; i < depth; ++i)
-    {
-      bits <<= 2;
-      res += bits;
-    }
+    // Every cell of the levels from m_level + 1 to depth - 1 is preceded by the subtrees of
+    // the cells which precede it on m_level: m_bits * (4 + 4^2 + ... + 4^(depth - 1 - m_level)).
+    res += m_bits * (TreeSizeForDepth(depth - m_level) - 1);
 
     ASSERT_GREATER(res, 0, (m_bits, m_level));
     ASSERT_LESS_OR_EQUAL(res, TreeSizeForDepth(depth), (m_bits, m_level));
@@ -258,9 +255,14 @@ public:
     {
       bits <<= 2;
       ++level;
-      int64_t subtreeSize = static_cast<int64_t>(TreeSizeForDepth(depth - level));
-      for (--v; v >= subtreeSize; v -= subtreeSize)
-        ++bits;
+      int64_t const subtreeSize = static_cast<int64_t>(TreeSizeForDepth(depth - level));
+      --v;
+      // The child index is the number of the preceding subtrees, it's less than 4.
+      int64_t const child = static_cast<int64_t>(v >= subtreeSize) +
+                            static_cast<int64_t>(v >= 2 * subtreeSize) +
+                            static_cast<int64_t>(v >= 3 * subtreeSize);
+      bits += static_cast<uint64_t>(child);
+      v -= child * subtreeSize;
     }
     return CellId(bits, level);
   }
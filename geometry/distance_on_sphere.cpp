@@ -1,5 +1,7 @@
 #include "geometry/distance_on_sphere.hpp"
 
+#include "geometry/fast_math.hpp"
+
 #include "base/math.hpp"
 
 #include <algorithm>
@@ -7,11 +9,10 @@
 
 using namespace std;
 
+static_assert(sizeof(ms::LatLon) == 2 * sizeof(double), "LatLon must be two packed doubles.");
+
 namespace
 {
-// Earth radius in meters.
-double constexpr kEarthRadiusMeters = 6378000;
-
 // Side of the one-degree square at the equator in meters.
 double constexpr kOneDegreeEquatorLengthMeters = 111319.49079;
 }  // namespace
@@ -47,6 +48,25 @@ double DistanceOnEarth(LatLon const & ll1, LatLon const & ll2)
   return DistanceOnEarth(ll1.lat, ll1.lon, ll2.lat, ll2.lon);
 }
 
+void DistanceOnEarth(LatLon const & from, LatLon const * to, size_t count, double * result)
+{
+  double const lat1 = base::DegToRad(from.lat);
+  double const lon1 = base::DegToRad(from.lon);
+  double const cosLat1 = cos(lat1);
+  fast::ForEachBatch(count, [&](size_t i, auto zero) {
+    using T = decltype(zero);
+    T lat2, lon2;
+    fast::LoadPairs(&to[i].lat, lat2, lon2);
+    lat2 = base::DegToRad(lat2);
+    T const dlat = fast::Sin((lat2 - lat1) * 0.5);
+    T const cosLat2 = fast::Sin(math::pi2 - fast::Abs(lat2));
+    T const y =
+        dlat * dlat + fast::SquaredSin((base::DegToRad(lon2) - lon1) * 0.5) * cosLat1 * cosLat2;
+    T const d = fast::Atan2(fast::Sqrt(y), fast::Sqrt(fast::Max(0.0, 1.0 - y)));
+    fast::Store(2.0 * kEarthRadiusMeters * d, result + i);
+  });
+}
+
 double AreaOnEarth(LatLon const & ll1, LatLon const & ll2, LatLon const & ll3)
 {
   return kOneDegreeEquatorLengthMeters * kOneDegreeEquatorLengthMeters *
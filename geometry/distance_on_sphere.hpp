@@ -4,9 +4,14 @@
 
 #include "base/base.hpp"
 
+#include <cstddef>
+
 // namespace ms - "math on sphere", similar to namespace m2.
 namespace ms
 {
+// Earth radius in meters.
+double constexpr kEarthRadiusMeters = 6378000;
+
 // Distance on unit sphere between (lat1, lon1) and (lat2, lon2).
 // lat1, lat2, lon1, lon2 - in degrees.
 double DistanceOnSphere(double lat1Deg, double lon1Deg, double lat2Deg, double lon2Deg);
@@ -20,5 +25,10 @@ double DistanceOnEarth(double lat1Deg, double lon1Deg, double lat2Deg, double lo
 
 double DistanceOnEarth(LatLon const & ll1, LatLon const & ll2);
 
+// Distances in meters on Earth from |from| to |count| points |to| which are written
+// to |result|. The trigonometric functions are approximated by the vectorized ones
+// of geometry/fast_math.hpp, the error is below 1e-12 of the distance plus 1e-8 meters.
+void DistanceOnEarth(LatLon const & from, LatLon const * to, size_t count, double * result);
+
 double AreaOnEarth(LatLon const & ll1, LatLon const & ll2, LatLon const & ll3);
 }  // namespace ms
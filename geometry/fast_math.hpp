@@ -0,0 +1,245 @@
+#pragma once
+
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Approximations of the elementary functions for the batch conversions and distances
+// (see MercatorBounds and ms::DistanceOnEarth). The functions are templates which are
+// instantiated for double and for the pair of doubles Double2 of SSE2, they have no branches
+// and no calls. The arguments are reduced to small ranges by the exact identities and the Taylor
+// series are cut when the next term is below 1e-16 of the result, so the relative error of every
+// function is a few ulps.
+namespace ms
+{
+namespace fast
+{
+inline double Sqrt(double x) { return std::sqrt(x); }
+inline double Abs(double x) { return std::fabs(x); }
+inline double Min(double x, double y) { return std::min(x, y); }
+inline double Max(double x, double y) { return std::max(x, y); }
+
+inline void Store(double v, double * p) { *p = v; }
+
+// Loads the coordinates of a point from |p|.
+inline void LoadPairs(double const * p, double & first, double & second)
+{
+  first = p[0];
+  second = p[1];
+}
+
+inline void StorePairs(double first, double second, double * p)
+{
+  p[0] = first;
+  p[1] = second;
+}
+
+#if defined(__SSE2__)
+class Double2
+{
+public:
+  Double2() = default;
+  Double2(double v) : m_v(_mm_set1_pd(v)) {}
+  explicit Double2(__m128d v) : m_v(v) {}
+
+  __m128d Get() const { return m_v; }
+
+  Double2 & operator+=(Double2 const & a) { return *this = Double2(_mm_add_pd(m_v, a.m_v)); }
+  Double2 & operator*=(Double2 const & a) { return *this = Double2(_mm_mul_pd(m_v, a.m_v)); }
+  Double2 & operator/=(Double2 const & a) { return *this = Double2(_mm_div_pd(m_v, a.m_v)); }
+
+private:
+  __m128d m_v;
+};
+
+inline Double2 operator+(Double2 const & a, Double2 const & b)
+{
+  return Double2(_mm_add_pd(a.Get(), b.Get()));
+}
+
+inline Double2 operator-(Double2 const & a, Double2 const & b)
+{
+  return Double2(_mm_sub_pd(a.Get(), b.Get()));
+}
+
+inline Double2 operator*(Double2 const & a, Double2 const & b)
+{
+  return Double2(_mm_mul_pd(a.Get(), b.Get()));
+}
+
+inline Double2 operator/(Double2 const & a, Double2 const & b)
+{
+  return Double2(_mm_div_pd(a.Get(), b.Get()));
+}
+
+inline Double2 Sqrt(Double2 const & a) { return Double2(_mm_sqrt_pd(a.Get())); }
+
+inline Double2 Abs(Double2 const & a)
+{
+  return Double2(_mm_andnot_pd(_mm_set1_pd(-0.0), a.Get()));
+}
+
+inline Double2 Min(Double2 const & a, Double2 const & b)
+{
+  return Double2(_mm_min_pd(a.Get(), b.Get()));
+}
+
+inline Double2 Max(Double2 const & a, Double2 const & b)
+{
+  return Double2(_mm_max_pd(a.Get(), b.Get()));
+}
+
+inline void Store(Double2 const & v, double * p) { _mm_storeu_pd(p, v.Get()); }
+
+// Loads the coordinates of two points from |p|: {p[0], p[2]} to |first|
+// and {p[1], p[3]} to |second|.
+inline void LoadPairs(double const * p, Double2 & first, Double2 & second)
+{
+  __m128d const a = _mm_loadu_pd(p);
+  __m128d const b = _mm_loadu_pd(p + 2);
+  first = Double2(_mm_unpacklo_pd(a, b));
+  second = Double2(_mm_unpackhi_pd(a, b));
+}
+
+inline void StorePairs(Double2 const & first, Double2 const & second, double * p)
+{
+  _mm_storeu_pd(p, _mm_unpacklo_pd(first.Get(), second.Get()));
+  _mm_storeu_pd(p + 2, _mm_unpackhi_pd(first.Get(), second.Get()));
+}
+#endif
+
+// Rounds |x| to the nearest integer, |x| < 2^51.
+template <typename T>
+T Round(T const & x)
+{
+  double constexpr kMagic = 6755399441055744.0;  // 2^52 + 2^51.
+  return (x + kMagic) - kMagic;
+}
+
+// sin(x) for |x| <= pi / 2.
+template <typename T>
+T Sin(T const & x)
+{
+  T const x2 = x * x;
+  T r = 1.0 / 51090942171709440000.0;  // 1 / 21!
+  r = r * x2 - 1.0 / 121645100408832000.0;
+  r = r * x2 + 1.0 / 355687428096000.0;
+  r = r * x2 - 1.0 / 1307674368000.0;
+  r = r * x2 + 1.0 / 6227020800.0;
+  r = r * x2 - 1.0 / 39916800.0;
+  r = r * x2 + 1.0 / 362880.0;
+  r = r * x2 - 1.0 / 5040.0;
+  r = r * x2 + 1.0 / 120.0;
+  r = r * x2 - 1.0 / 6.0;
+  return x + x * x2 * r;
+}
+
+// sin(x) ^ 2 for |x| < 2^50.
+template <typename T>
+T SquaredSin(T const & x)
+{
+  // sin ^ 2 has period pi.
+  T const s = Sin(x - math::pi * Round(x / math::pi));
+  return s * s;
+}
+
+// atan2(y, x) for x >= 0 and x, y not both zero.
+template <typename T>
+T Atan2(T const & y, T x)
+{
+  // atan2(y, x) = 2 * atan2(y, x + sqrt(x ^ 2 + y ^ 2)) thrice, so |y / x| <= tan(pi / 16).
+  x += Sqrt(x * x + y * y);
+  x += Sqrt(x * x + y * y);
+  x += Sqrt(x * x + y * y);
+  T const z = y / x;
+  T const z2 = z * z;
+  T r = -1.0 / 21.0;
+  r = r * z2 + 1.0 / 19.0;
+  r = r * z2 - 1.0 / 17.0;
+  r = r * z2 + 1.0 / 15.0;
+  r = r * z2 - 1.0 / 13.0;
+  r = r * z2 + 1.0 / 11.0;
+  r = r * z2 - 1.0 / 9.0;
+  r = r * z2 + 1.0 / 7.0;
+  r = r * z2 - 1.0 / 5.0;
+  r = r * z2 + 1.0 / 3.0;
+  return 8.0 * (z - z * z2 * r);
+}
+
+// atanh(x) for |x| <= sin(86 degrees), the latitude limit of mercator.
+template <typename T>
+T Atanh(T x)
+{
+  // atanh(x) = 2 * atanh(x / (1 + sqrt(1 - x ^ 2))) four times, so |x| <= 0.21.
+  x /= 1.0 + Sqrt(1.0 - x * x);
+  x /= 1.0 + Sqrt(1.0 - x * x);
+  x /= 1.0 + Sqrt(1.0 - x * x);
+  x /= 1.0 + Sqrt(1.0 - x * x);
+  T const x2 = x * x;
+  T r = 1.0 / 21.0;
+  r = r * x2 + 1.0 / 19.0;
+  r = r * x2 + 1.0 / 17.0;
+  r = r * x2 + 1.0 / 15.0;
+  r = r * x2 + 1.0 / 13.0;
+  r = r * x2 + 1.0 / 11.0;
+  r = r * x2 + 1.0 / 9.0;
+  r = r * x2 + 1.0 / 7.0;
+  r = r * x2 + 1.0 / 5.0;
+  r = r * x2 + 1.0 / 3.0;
+  return 16.0 * (x + x * x2 * r);
+}
+
+// exp(x) - 1 for |x| <= pi.
+template <typename T>
+T Expm1(T x)
+{
+  // exp(x) - 1 = (exp(x / 2) - 1) * (exp(x / 2) + 1) thrice, so |x| <= pi / 8.
+  x *= 0.125;
+  T r = 1.0 / 6227020800.0;  // 1 / 13!
+  r = r * x + 1.0 / 479001600.0;
+  r = r * x + 1.0 / 39916800.0;
+  r = r * x + 1.0 / 3628800.0;
+  r = r * x + 1.0 / 362880.0;
+  r = r * x + 1.0 / 40320.0;
+  r = r * x + 1.0 / 5040.0;
+  r = r * x + 1.0 / 720.0;
+  r = r * x + 1.0 / 120.0;
+  r = r * x + 1.0 / 24.0;
+  r = r * x + 1.0 / 6.0;
+  r = r * x + 0.5;
+  T e = x + x * x * r;
+  e *= 2.0 + e;
+  e *= 2.0 + e;
+  e *= 2.0 + e;
+  return e;
+}
+
+// tan(lat / 2) of the mercator |y| in radians, since lat = 2 * atan(tanh(y / 2)).
+template <typename T>
+T MercatorYToHalfLatTan(T const & y)
+{
+  T const e = Expm1(y);
+  return e / (e + 2.0);
+}
+
+// Calls |fn(i, T())| for the elements [0, |count|): by pairs with T = Double2 if there is SSE2
+// and by single elements with T = double for the rest. |fn| processes the elements starting
+// from |i| by the functions above which are overloaded for both types.
+template <typename Fn>
+void ForEachBatch(size_t count, Fn && fn)
+{
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 1 < count; i += 2)
+    fn(i, Double2());
+#endif
+  for (; i < count; ++i)
+    fn(i, double());
+}
+}  // namespace fast
+}  // namespace ms
@@ -90,6 +90,33 @@ UNIT_TEST(CellId_FromInt64)
   TEST_EQUAL(m2::CellId<3>("33"), m2::CellId<3>::FromInt64(21, 3), ());
 }
 
+UNIT_TEST(CellId_Int64_PreOrder)
+{
+  // Cells of every depth are numbered from 1 in pre-order.
+  using Id = m2::CellId<6>;
+  for (int depth = 1; depth <= Id::DEPTH_LEVELS; ++depth)
+  {
+    int64_t expected = 1;
+    vector<Id> stack = {Id::Root()};
+    while (!stack.empty())
+    {
+      Id const id = stack.back();
+      stack.pop_back();
+
+      TEST_EQUAL(id.ToInt64(depth), expected, (id, depth));
+      TEST_EQUAL(Id::FromInt64(expected, depth), id, (id, depth));
+      ++expected;
+
+      if (id.Level() + 1 < depth)
+      {
+        for (int8_t c = 3; c >= 0; --c)
+          stack.push_back(id.Child(c));
+      }
+    }
+    TEST_EQUAL(expected, Id::Root().SubTreeSize(depth) + 1, (depth));
+  }
+}
+
 UNIT_TEST(CellId_XY)
 {
   TEST_EQUAL(m2::CellId<3>("").XY(), make_pair(4U, 4U), ());
@@ -2,6 +2,8 @@
 #include "geometry/distance_on_sphere.hpp"
 #include "base/math.hpp"
 
+#include <vector>
+
 UNIT_TEST(DistanceOnSphere)
 {
   TEST_LESS(fabs(ms::DistanceOnSphere(0, -180, 0, 180)), 1.0e-6, ());
@@ -20,3 +22,25 @@ UNIT_TEST(DistanceOnEarth)
   TEST_LESS(fabs(ms::DistanceOnEarth(47.37, 8.56, 53.91, 27.56) * 0.001 - 1519), 1, ());
   TEST_LESS(fabs(ms::DistanceOnEarth(43, 132, 38, -122.5) * 0.001 - 8302), 1, ());
 }
+
+UNIT_TEST(DistanceOnEarth_Batch)
+{
+  ms::LatLon const from(47.37, 8.56);
+  std::vector<ms::LatLon> to;
+  for (int lat = -90; lat <= 90; lat += 3)
+  {
+    for (int lon = -180; lon <= 180; lon += 11)
+      to.emplace_back(lat, lon);
+  }
+  for (double d = -1e-4; d <= 1e-4; d += 1e-6)
+    to.emplace_back(from.lat + d, from.lon - 0.3 * d);
+  to.emplace_back(-from.lat, from.lon - 180.0);
+
+  std::vector<double> distances(to.size());
+  ms::DistanceOnEarth(from, to.data(), to.size(), distances.data());
+  for (size_t i = 0; i < to.size(); ++i)
+  {
+    double const distance = ms::DistanceOnEarth(from, to[i]);
+    TEST(base::AlmostEqualAbs(distances[i], distance, 1e-12 * distance + 1e-8), (i, to[i]));
+  }
+}
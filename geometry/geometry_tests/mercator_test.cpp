@@ -6,6 +6,7 @@
 #include "base/macros.hpp"
 #include "base/logging.hpp"
 
+#include <vector>
 
 UNIT_TEST(Mercator_Grid)
 {
@@ -81,3 +82,68 @@ UNIT_TEST(Mercator_Sample1)
   LOG(LINFO, (MercatorBounds::XToLon(27.531491200000001385),
               MercatorBounds::YToLat(64.392864299248202542)));
 }
+
+UNIT_TEST(Mercator_Batch)
+{
+  std::vector<m2::PointD> points;
+  std::vector<ms::LatLon> latLons;
+  for (int lat = -90; lat <= 85; lat += 5)
+  {
+    for (int lon = -180; lon <= 180; lon += 7)
+    {
+      latLons.emplace_back(lat + 0.123, lon);
+      points.push_back(MercatorBounds::FromLatLon(latLons.back()));
+    }
+  }
+  latLons.emplace_back(89.9, 0.0);
+  points.push_back(MercatorBounds::FromLatLon(latLons.back()));
+  // Odd count, so the last point isn't processed in a pair.
+  TEST_EQUAL(points.size() % 2, 1, ());
+
+  std::vector<ms::LatLon> batchLatLons(points.size());
+  MercatorBounds::ToLatLon(points.data(), points.size(), batchLatLons.data());
+  std::vector<m2::PointD> batchPoints(latLons.size());
+  MercatorBounds::FromLatLon(latLons.data(), latLons.size(), batchPoints.data());
+  m2::PointD const from = MercatorBounds::FromLatLon(55.75, 37.62);
+  std::vector<double> distances(points.size());
+  MercatorBounds::DistanceOnEarth(from, points.data(), points.size(), distances.data());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    ms::LatLon const latLon = MercatorBounds::ToLatLon(points[i]);
+    TEST(base::AlmostEqualAbs(batchLatLons[i].lat, latLon.lat, 1e-12), (i, latLon));
+    TEST_EQUAL(batchLatLons[i].lon, latLon.lon, (i));
+
+    TEST(base::AlmostEqualAbs(batchPoints[i].y, points[i].y, 1e-10), (i, latLons[i]));
+    TEST_EQUAL(batchPoints[i].x, points[i].x, (i));
+
+    double const distance = MercatorBounds::DistanceOnEarth(from, points[i]);
+    TEST(base::AlmostEqualAbs(distances[i], distance, 1e-12 * distance + 1e-8), (i, latLon));
+  }
+}
+
+UNIT_TEST(Mercator_BatchDistanceOnEarth_Near)
+{
+  m2::PointD const from(27.56, 64.12);
+  std::vector<m2::PointD> points;
+  for (double d = -1e-4; d <= 1e-4; d += 1e-6)
+    points.emplace_back(from.x + d, from.y - 0.7 * d);
+
+  std::vector<double> distances(points.size());
+  MercatorBounds::DistanceOnEarth(from, points.data(), points.size(), distances.data());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    double const distance = MercatorBounds::DistanceOnEarth(from, points[i]);
+    TEST(base::AlmostEqualAbs(distances[i], distance, 1e-12 * distance + 1e-8), (i, distance));
+  }
+
+  // Lengths of the segments of the polyline.
+  distances.resize(points.size() - 1);
+  MercatorBounds::DistanceOnEarth(points.data(), points.data() + 1, distances.size(),
+                                  distances.data());
+  for (size_t i = 0; i < distances.size(); ++i)
+  {
+    double const distance = MercatorBounds::DistanceOnEarth(points[i], points[i + 1]);
+    TEST(base::AlmostEqualAbs(distances[i], distance, 1e-12 * distance + 1e-8), (i, distance));
+  }
+}
@@ -0,0 +1,112 @@
+#include "testing/testing.hpp"
+
+#include "geometry/packed_tree4d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+using R = m2::RectD;
+
+struct Traits
+{
+  m2::RectD LimitRect(m2::RectD const & r) const { return r; }
+};
+
+using PackedTree = m4::PackedTree<R, Traits>;
+
+struct Less
+{
+  bool operator()(R const & lhs, R const & rhs) const
+  {
+    if (lhs.minX() != rhs.minX())
+      return lhs.minX() < rhs.minX();
+    if (lhs.minY() != rhs.minY())
+      return lhs.minY() < rhs.minY();
+    if (lhs.maxX() != rhs.maxX())
+      return lhs.maxX() < rhs.maxX();
+    return lhs.maxY() < rhs.maxY();
+  }
+};
+
+R RandomRect(mt19937 & rng)
+{
+  uniform_real_distribution<double> coord(0.0, 100.0);
+  uniform_real_distribution<double> size(0.0, 5.0);
+  double const x = coord(rng);
+  double const y = coord(rng);
+  return R(x, y, x + size(rng), y + size(rng));
+}
+}  // namespace
+
+UNIT_TEST(PackedTree_Smoke)
+{
+  PackedTree tree;
+  TEST(tree.IsEmpty(), ());
+  tree.Build();
+
+  vector<R> test;
+  tree.ForEachInRect(R(0, 0, 10, 10), base::MakeBackInsertFunctor(test));
+  TEST(test.empty(), ());
+
+  R const arr[] = {R(0, 0, 1, 1), R(1, 1, 2, 2), R(2, 2, 3, 3)};
+  for (auto const & r : arr)
+    tree.Add(r);
+  tree.Build();
+  TEST_EQUAL(tree.GetSize(), 3, ());
+
+  tree.ForEach(base::MakeBackInsertFunctor(test));
+  TEST_EQUAL(test.size(), 3, ());
+
+  test.clear();
+  tree.ForEachInRect(R(1.5, 1.5, 1.5, 1.5), base::MakeBackInsertFunctor(test));
+  TEST_EQUAL(test, vector<R>{arr[1]}, ());
+
+  // Touching rects don't intersect.
+  test.clear();
+  tree.ForEachInRect(R(3, 3, 4, 4), base::MakeBackInsertFunctor(test));
+  TEST(test.empty(), ());
+}
+
+UNIT_TEST(PackedTree_SameAsTree)
+{
+  mt19937 rng(0);
+  m4::Tree<R, Traits> tree;
+  PackedTree packedTree;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    auto const r = RandomRect(rng);
+    tree.Add(r);
+    packedTree.Add(r);
+  }
+  packedTree.Build();
+
+  vector<R> queries;
+  for (size_t i = 0; i < 100; ++i)
+    queries.push_back(RandomRect(rng));
+  queries.push_back(R(-10, -10, 200, 200));
+
+  vector<vector<R>> batchResults(queries.size());
+  packedTree.ForEachInRects(queries,
+                            [&](size_t i, R const & r) { batchResults[i].push_back(r); });
+
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    vector<R> expected;
+    tree.ForEachInRect(queries[i], base::MakeBackInsertFunctor(expected));
+    vector<R> actual;
+    packedTree.ForEachInRect(queries[i], base::MakeBackInsertFunctor(actual));
+
+    sort(expected.begin(), expected.end(), Less());
+    sort(actual.begin(), actual.end(), Less());
+    sort(batchResults[i].begin(), batchResults[i].end(), Less());
+    TEST_EQUAL(actual, expected, (queries[i]));
+    TEST_EQUAL(batchResults[i], expected, (queries[i]));
+  }
+}
@@ -4,6 +4,9 @@
 
 #include "geometry/region2d.hpp"
 
+#include <cmath>
+#include <vector>
+
 namespace
 {
 template <class Region>
@@ -262,3 +265,33 @@ UNIT_TEST(Region_border_intersecion_Test)
   TEST(!region.FindIntersection(P(5.0, 5.0), P(2.0, 2.0), intersection),
        ("This case has no intersection"));
 }
+
+UNIT_TEST(Region_Contains_ManyEdges)
+{
+  // Star with many edges, so the most of them are processed by the SIMD kernels.
+  size_t const count = 101;
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const angle = 2.0 * math::pi * static_cast<double>(i) / static_cast<double>(count);
+    double const radius = i % 2 == 0 ? 10.0 : 5.0;
+    points.emplace_back(radius * cos(angle), radius * sin(angle));
+  }
+  m2::RegionD const region(points);
+
+  TEST(region.Contains(m2::PointD(0.0, 0.0)), ());
+  TEST(region.Contains(m2::PointD(4.0, 1.0)), ());
+  TEST(!region.Contains(m2::PointD(9.9, 9.9)), ());
+  TEST(!region.AtBorder(m2::PointD(0.0, 0.0), 0.01), ());
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const & curr = points[i];
+    auto const & next = points[(i + 1) % count];
+    TEST(region.Contains(curr), (i));
+    TEST(region.AtBorder(curr, 0.01), (i));
+    TEST(region.AtBorder((curr + next) * 0.5, 0.01), (i));
+    TEST(!region.AtBorder(curr * 0.9, 0.01), (i));
+    TEST(!region.Contains(curr * 1.01), (i));
+  }
+}
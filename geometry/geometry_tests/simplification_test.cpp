@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <random>
 #include <vector>
 
 using namespace std;
@@ -146,3 +147,48 @@ UNIT_TEST(Simpfication_DP_DegenerateTrg)
               P(100.1, 450), P(100, 500),   P(0, 600)};
   CheckDPStrict(arr2, ARRAY_SIZE(arr2), 1.0, 4);
 }
+
+UNIT_TEST(Simplification_SameAsGeneric)
+{
+  // The distance isn't m2::SquaredDistanceFromSegmentToPoint, so it's computed point by point.
+  struct GenericDistanceFn
+  {
+    double operator()(P const & a, P const & b, P const & x) const { return DistanceFn()(a, b, x); }
+  };
+
+  // A random walk which is long enough to be simplified in parallel.
+  mt19937 rng(0);
+  normal_distribution<double> step(0.0, 1.0);
+  vector<P> walk = {P(0.0, 0.0)};
+  for (size_t i = 1; i < 200000; ++i)
+    walk.push_back(walk.back() + P(step(rng), step(rng)));
+
+  vector<vector<P>> const polylines = {
+      vector<P>(LargePolylineTestData::m_Data,
+                LargePolylineTestData::m_Data + LargePolylineTestData::m_Size),
+      walk};
+  for (auto const & points : polylines)
+  {
+    for (double const eps : {1e-6, 1e-2, 1.0, 100.0})
+    {
+      vector<P> expected;
+      SimplifyDP(points.begin(), points.end(), eps, GenericDistanceFn(),
+                 base::MakeBackInsertFunctor(expected));
+      vector<P> actual;
+      SimplifyDP(points.begin(), points.end(), eps, DistanceFn(),
+                 base::MakeBackInsertFunctor(actual));
+      TEST_EQUAL(actual, expected, (points.size(), eps));
+
+      if (points.size() > 10000)
+        continue;
+
+      expected.clear();
+      SimplifyNearOptimal(20, points.begin(), points.end(), eps, GenericDistanceFn(),
+                          base::MakeBackInsertFunctor(expected));
+      actual.clear();
+      SimplifyNearOptimal(20, points.begin(), points.end(), eps, DistanceFn(),
+                          base::MakeBackInsertFunctor(actual));
+      TEST_EQUAL(actual, expected, (points.size(), eps));
+    }
+  }
+}
@@ -174,3 +174,25 @@ UNIT_TEST(Tree4D_ReplaceEqual)
   i = find(test.begin(), test.end(), T(1, 1, 2, 2, 2));
   TEST_EQUAL(R(*i), R(0, 0, 3, 3), ());
 }
+
+UNIT_TEST(Tree4D_Balance)
+{
+  Tree theTree;
+
+  // Rects are added in the sorted order, so the tree is degenerated until it's balanced.
+  for (int i = 0; i < 100; ++i)
+    theTree.Add(R(i, i, i + 1, i + 1));
+  theTree.Balance();
+  TEST_EQUAL(theTree.GetSize(), 100, ());
+
+  vector<R> test;
+  theTree.ForEachInRect(R(10.5, 10.5, 10.5, 10.5), base::MakeBackInsertFunctor(test));
+  TEST_EQUAL(test, vector<R>({R(10, 10, 11, 11)}), ());
+
+  test.clear();
+  theTree.ForEachInRect(R(50.5, 50.5, 52.5, 52.5), base::MakeBackInsertFunctor(test));
+  sort(test.begin(), test.end(), [](R const & lhs, R const & rhs) {
+    return lhs.minX() < rhs.minX();
+  });
+  TEST_EQUAL(test, vector<R>({R(50, 50, 51, 51), R(51, 51, 52, 52), R(52, 52, 53, 53)}), ());
+}
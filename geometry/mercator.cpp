@@ -1,12 +1,35 @@
 #include "geometry/mercator.hpp"
 
 #include "geometry/distance_on_sphere.hpp"
+#include "geometry/fast_math.hpp"
 
 #include <algorithm>
 #include <cmath>
 
 using namespace std;
 
+static_assert(sizeof(m2::PointD) == 2 * sizeof(double), "PointD must be two packed doubles.");
+static_assert(sizeof(ms::LatLon) == 2 * sizeof(double), "LatLon must be two packed doubles.");
+
+namespace
+{
+// The haversine formula by t = tan(lat / 2) which is computed from y without atan:
+// cos(lat) = (1 - t^2) / (1 + t^2) and
+// sin((lat2 - lat1) / 2) = (t2 - t1) / sqrt((1 + t1^2) * (1 + t2^2)).
+// |dx| is the difference of the longitudes in degrees.
+template <typename T1, typename T2>
+T2 DistanceOnEarthByHalfLatTans(T1 const & t1, T2 const & t2, T2 const & dx)
+{
+  T1 const q1 = 1.0 + t1 * t1;
+  T2 const q2 = 1.0 + t2 * t2;
+  T2 const dlat = (t2 - t1) / ms::fast::Sqrt(q1 * q2);
+  T2 const cosLats = (1.0 - t1 * t1) * (1.0 - t2 * t2) / (q1 * q2);
+  T2 const y = dlat * dlat + ms::fast::SquaredSin(base::DegToRad(dx) * 0.5) * cosLats;
+  T2 const d = ms::fast::Atan2(ms::fast::Sqrt(y), ms::fast::Sqrt(ms::fast::Max(0.0, 1.0 - y)));
+  return 2.0 * ms::kEarthRadiusMeters * d;
+}
+}  // namespace
+
 double MercatorBounds::minX = -180;
 double MercatorBounds::maxX = 180;
 double MercatorBounds::minY = -180;
@@ -45,11 +68,68 @@ m2::PointD MercatorBounds::GetSmPoint(m2::PointD const & pt, double lonMetresR,
   return FromLatLon(newLat, newLon);
 }
 
+void MercatorBounds::ToLatLon(m2::PointD const * points, size_t count, ms::LatLon * result)
+{
+  ms::fast::ForEachBatch(count, [&](size_t i, auto zero) {
+    using T = decltype(zero);
+    T x, y;
+    ms::fast::LoadPairs(&points[i].x, x, y);
+    T const t = ms::fast::MercatorYToHalfLatTan(base::DegToRad(y));
+    T const lat = base::RadToDeg(2.0 * ms::fast::Atan2(t, T(1.0)));
+    ms::fast::StorePairs(lat, x, &result[i].lat);
+  });
+}
+
+void MercatorBounds::FromLatLon(ms::LatLon const * points, size_t count, m2::PointD * result)
+{
+  double const sinMinLat = sin(base::DegToRad(-86.0));
+  double const sinMaxLat = sin(base::DegToRad(86.0));
+  double const minYCopy = minY;
+  double const maxYCopy = maxY;
+  ms::fast::ForEachBatch(count, [&](size_t i, auto zero) {
+    using T = decltype(zero);
+    T lat, lon;
+    ms::fast::LoadPairs(&points[i].lat, lat, lon);
+    T const s = ms::fast::Sin(base::DegToRad(lat));
+    // Clamps the latitude and y like LatToY().
+    T const y = ms::fast::Atanh(ms::fast::Min(ms::fast::Max(s, sinMinLat), sinMaxLat));
+    T const clampedY = ms::fast::Min(ms::fast::Max(base::RadToDeg(y), minYCopy), maxYCopy);
+    ms::fast::StorePairs(lon, clampedY, &result[i].x);
+  });
+}
+
 double MercatorBounds::DistanceOnEarth(m2::PointD const & p1, m2::PointD const & p2)
 {
   return ms::DistanceOnEarth(ToLatLon(p1), ToLatLon(p2));
 }
 
+void MercatorBounds::DistanceOnEarth(m2::PointD const & from, m2::PointD const * to,
+                                     size_t count, double * result)
+{
+  double const t1 = ms::fast::MercatorYToHalfLatTan(base::DegToRad(from.y));
+  ms::fast::ForEachBatch(count, [&](size_t i, auto zero) {
+    using T = decltype(zero);
+    T x2, y2;
+    ms::fast::LoadPairs(&to[i].x, x2, y2);
+    T const t2 = ms::fast::MercatorYToHalfLatTan(base::DegToRad(y2));
+    ms::fast::Store(DistanceOnEarthByHalfLatTans(t1, t2, x2 - from.x), result + i);
+  });
+}
+
+void MercatorBounds::DistanceOnEarth(m2::PointD const * p1, m2::PointD const * p2, size_t count,
+                                     double * result)
+{
+  ms::fast::ForEachBatch(count, [&](size_t i, auto zero) {
+    using T = decltype(zero);
+    T x1, y1, x2, y2;
+    ms::fast::LoadPairs(&p1[i].x, x1, y1);
+    ms::fast::LoadPairs(&p2[i].x, x2, y2);
+    T const t1 = ms::fast::MercatorYToHalfLatTan(base::DegToRad(y1));
+    T const t2 = ms::fast::MercatorYToHalfLatTan(base::DegToRad(y2));
+    ms::fast::Store(DistanceOnEarthByHalfLatTans(t1, t2, x2 - x1), result + i);
+  });
+}
+
 double MercatorBounds::AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2,
                                    m2::PointD const & p3)
 {
@@ -6,6 +6,8 @@
 
 #include "base/math.hpp"
 
+#include <cstddef>
+
 struct MercatorBounds
 {
   static double minX;
@@ -88,6 +90,14 @@ struct MercatorBounds
     return {YToLat(point.y), XToLon(point.x)};
   }
 
+  /// @name Batch conversions of |count| points to |result|.
+  /// The functions are approximated by the vectorized ones of geometry/fast_math.hpp,
+  /// the error is below 1e-10 degrees.
+  //@{
+  static void ToLatLon(m2::PointD const * points, size_t count, ms::LatLon * result);
+  static void FromLatLon(ms::LatLon const * points, size_t count, m2::PointD * result);
+  //@}
+
   /// Converts lat lon rect to mercator one
   static m2::RectD FromLatLonRect(m2::RectD const & latLonRect)
   {
@@ -104,6 +114,15 @@ struct MercatorBounds
   /// Calculates distance on Earth in meters between two mercator points.
   static double DistanceOnEarth(m2::PointD const & p1, m2::PointD const & p2);
 
+  /// Calculates distances on Earth in meters from |from| to |count| mercator points |to|
+  /// like the batch ms::DistanceOnEarth() but without conversion to lat lon.
+  static void DistanceOnEarth(m2::PointD const & from, m2::PointD const * to, size_t count,
+                              double * result);
+
+  /// Calculates distances on Earth in meters between |p1[i]| and |p2[i]| for i < |count|.
+  static void DistanceOnEarth(m2::PointD const * p1, m2::PointD const * p2, size_t count,
+                              double * result);
+
   /// Calculates area of a triangle on Earth in m² by three mercator points.
   static double AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3);
 };
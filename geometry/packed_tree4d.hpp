@@ -0,0 +1,268 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace m4
+{
+// Static R-tree for the objects which are added once and are only queried later.
+// Unlike m4::Tree the nodes are not allocated one by one: the tree is packed by
+// the Sort-Tile-Recursive bulk loading into the arrays of boxes, one array per level.
+// The boxes of a level are stored by coordinates, so the boxes of a node are tested
+// against a rect in a loop which the compiler vectorizes.
+// The queries have the same semantics as the ones of m4::Tree: the rects which only
+// touch each other don't intersect.
+template <typename T, typename Traits = TraitsDef<T>>
+class PackedTree
+{
+public:
+  // Number of children of a node.
+  static size_t constexpr kNodeSize = 16;
+
+  PackedTree(Traits const & traits = Traits()) : m_traits(traits) {}
+
+  using elem_t = T;
+
+  template <typename U>
+  void Add(U && obj)
+  {
+    Add(std::forward<U>(obj), m_traits.LimitRect(obj));
+  }
+
+  template <typename U>
+  void Add(U && obj, m2::RectD const & rect)
+  {
+    m_values.emplace_back(std::forward<U>(obj));
+    m_rects.push_back(rect);
+    m_levels.clear();
+  }
+
+  // Packs the added objects. It must be called after the last Add() and before the queries.
+  void Build()
+  {
+    m_levels.clear();
+    if (m_values.empty())
+      return;
+
+    std::vector<size_t> order(m_values.size());
+    std::iota(order.begin(), order.end(), 0);
+    SortTileRecursive(order);
+
+    std::vector<T> values;
+    values.reserve(m_values.size());
+    m_levels.emplace_back();
+    m_levels.back().Resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      values.emplace_back(std::move(m_values[order[i]]));
+      m_levels.back().Set(i, m_rects[order[i]]);
+    }
+    m_values = std::move(values);
+    m_rects.clear();
+    m_rects.shrink_to_fit();
+
+    while (m_levels.back().Size() > kNodeSize)
+    {
+      Boxes parents;
+      auto const & children = m_levels.back();
+      parents.Resize((children.Size() + kNodeSize - 1) / kNodeSize);
+      for (size_t i = 0; i < parents.Size(); ++i)
+      {
+        m2::RectD rect;
+        for (size_t j = i * kNodeSize; j < std::min((i + 1) * kNodeSize, children.Size()); ++j)
+          rect.Add(children.Get(j));
+        parents.Set(i, rect);
+      }
+      m_levels.emplace_back(std::move(parents));
+    }
+  }
+
+  template <typename ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (auto const & v : m_values)
+      toDo(v);
+  }
+
+  template <typename ToDo>
+  void ForEachEx(ToDo && toDo) const
+  {
+    CHECK(IsBuilt(), ());
+    for (size_t i = 0; i < m_values.size(); ++i)
+      toDo(m_levels.front().Get(i), m_values[i]);
+  }
+
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    std::vector<Node> stack;
+    ForEachIndexInRect(rect, stack, [&](size_t i) { toDo(m_values[i]); });
+  }
+
+  template <typename ToDo>
+  void ForEachInRectEx(m2::RectD const & rect, ToDo && toDo) const
+  {
+    std::vector<Node> stack;
+    ForEachIndexInRect(rect, stack,
+                       [&](size_t i) { toDo(m_levels.front().Get(i), m_values[i]); });
+  }
+
+  // Calls |toDo(i, obj)| for every object which intersects |rects[i]|.
+  // The buffers are shared between the queries.
+  template <typename ToDo>
+  void ForEachInRects(std::vector<m2::RectD> const & rects, ToDo && toDo) const
+  {
+    std::vector<Node> stack;
+    for (size_t i = 0; i < rects.size(); ++i)
+      ForEachIndexInRect(rects[i], stack, [&](size_t j) { toDo(i, m_values[j]); });
+  }
+
+  bool IsEmpty() const { return m_values.empty(); }
+
+  size_t GetSize() const { return m_values.size(); }
+
+  void Clear()
+  {
+    m_values.clear();
+    m_rects.clear();
+    m_levels.clear();
+  }
+
+private:
+  // Boxes [m_begin, m_end) of |m_level|.
+  struct Node
+  {
+    size_t m_level;
+    size_t m_begin;
+    size_t m_end;
+  };
+
+  class Boxes
+  {
+  public:
+    void Resize(size_t size)
+    {
+      m_minX.resize(size);
+      m_minY.resize(size);
+      m_maxX.resize(size);
+      m_maxY.resize(size);
+    }
+
+    size_t Size() const { return m_minX.size(); }
+
+    void Set(size_t i, m2::RectD const & rect)
+    {
+      m_minX[i] = rect.minX();
+      m_minY[i] = rect.minY();
+      m_maxX[i] = rect.maxX();
+      m_maxY[i] = rect.maxY();
+    }
+
+    m2::RectD Get(size_t i) const { return m2::RectD(m_minX[i], m_minY[i], m_maxX[i], m_maxY[i]); }
+
+    // Sets |hits[i - begin]| for i in [begin, end) to whether the box intersects |rect|.
+    void Intersect(size_t begin, size_t end, m2::RectD const & rect, uint8_t * hits) const
+    {
+      double const minX = rect.minX();
+      double const minY = rect.minY();
+      double const maxX = rect.maxX();
+      double const maxY = rect.maxY();
+      double const * const boxMinX = m_minX.data() + begin;
+      double const * const boxMinY = m_minY.data() + begin;
+      double const * const boxMaxX = m_maxX.data() + begin;
+      double const * const boxMaxY = m_maxY.data() + begin;
+      // No branches, so the loop is vectorized.
+      for (size_t i = 0; i < end - begin; ++i)
+      {
+        hits[i] = static_cast<uint8_t>((boxMaxX[i] > minX) & (boxMinX[i] < maxX) &
+                                       (boxMaxY[i] > minY) & (boxMinY[i] < maxY));
+      }
+    }
+
+  private:
+    std::vector<double> m_minX;
+    std::vector<double> m_minY;
+    std::vector<double> m_maxX;
+    std::vector<double> m_maxY;
+  };
+
+  bool IsBuilt() const { return m_values.empty() || !m_levels.empty(); }
+
+  void SortTileRecursive(std::vector<size_t> & order) const
+  {
+    auto const centerX = [this](size_t i) { return m_rects[i].minX() + m_rects[i].maxX(); };
+    auto const centerY = [this](size_t i) { return m_rects[i].minY() + m_rects[i].maxY(); };
+
+    // The leaves are cut into vertical slices of |sliceSize| objects which are sorted by y.
+    size_t const leavesCount = (order.size() + kNodeSize - 1) / kNodeSize;
+    auto const slicesCount = static_cast<size_t>(std::ceil(std::sqrt(leavesCount)));
+    size_t const sliceSize = slicesCount * kNodeSize;
+
+    std::sort(order.begin(), order.end(),
+              [&](size_t lhs, size_t rhs) { return centerX(lhs) < centerX(rhs); });
+    for (size_t begin = 0; begin < order.size(); begin += sliceSize)
+    {
+      size_t const end = std::min(begin + sliceSize, order.size());
+      std::sort(order.begin() + begin, order.begin() + end,
+                [&](size_t lhs, size_t rhs) { return centerY(lhs) < centerY(rhs); });
+    }
+  }
+
+  template <typename ToDo>
+  void ForEachIndexInRect(m2::RectD const & rect, std::vector<Node> & stack, ToDo && toDo) const
+  {
+    CHECK(IsBuilt(), ("PackedTree::Build() is not called."));
+    if (m_levels.empty())
+      return;
+
+    uint8_t hits[kNodeSize];
+    stack.clear();
+    stack.push_back({m_levels.size() - 1, 0, m_levels.back().Size()});
+    while (!stack.empty())
+    {
+      Node const node = stack.back();
+      stack.pop_back();
+
+      auto const & boxes = m_levels[node.m_level];
+      ASSERT_LESS_OR_EQUAL(node.m_end - node.m_begin, kNodeSize, ());
+      boxes.Intersect(node.m_begin, node.m_end, rect, hits);
+      for (size_t i = node.m_begin; i < node.m_end; ++i)
+      {
+        if (!hits[i - node.m_begin])
+          continue;
+
+        if (node.m_level == 0)
+        {
+          toDo(i);
+          continue;
+        }
+
+        auto const & children = m_levels[node.m_level - 1];
+        stack.push_back({node.m_level - 1, i * kNodeSize,
+                         std::min((i + 1) * kNodeSize, children.Size())});
+      }
+    }
+  }
+
+  Traits m_traits;
+  std::vector<T> m_values;
+  // Rects of the added objects, they are moved to the leaf level by Build().
+  std::vector<m2::RectD> m_rects;
+  // Boxes of the levels from the leaves (the objects) to the root node.
+  std::vector<Boxes> m_levels;
+};
+
+// static
+template <typename T, typename Traits>
+size_t constexpr PackedTree<T, Traits>::kNodeSize;
+}  // namespace m4
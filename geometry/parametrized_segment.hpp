@@ -72,6 +72,8 @@ public:
 
   Point const & GetP0() const { return m_p0; }
   Point const & GetP1() const { return m_p1; }
+  m2::PointD const & GetDirection() const { return m_d; }
+  double GetLength() const { return m_length; }
 
 private:
   Point m_p0;
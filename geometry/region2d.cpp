@@ -0,0 +1,230 @@
+#include "geometry/region2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace m2
+{
+namespace detail
+{
+#if defined(__SSE2__)
+namespace
+{
+static_assert(sizeof(PointD) == 2 * sizeof(double), "PointD must be two packed doubles.");
+
+double constexpr kSquaredPrecision = DefEqualFloat::kPrecision * DefEqualFloat::kPrecision;
+
+// The edges are checked by blocks of the size for AtBorder(), so the points near the beginning
+// of a large border aren't checked against the whole border.
+size_t constexpr kAtBorderBlockSize = 32;
+
+bool IsVertex(PointD const & curr)
+{
+  return fabs(curr.x) < DefEqualFloat::kPrecision && fabs(curr.y) < DefEqualFloat::kPrecision;
+}
+
+// |prev| and |curr| are translated by the point. Returns false if the edge is near-degenerate.
+bool CountCrossing(PointD const & prev, PointD const & curr, uint64_t & rCross, uint64_t & lCross)
+{
+  if (IsVertex(curr))
+    return false;
+
+  bool const rCheck = (curr.y > 0) != (prev.y > 0);
+  bool const lCheck = (curr.y < 0) != (prev.y < 0);
+  if (!rCheck && !lCheck)
+    return true;
+
+  double const cp = CrossProduct(curr, prev);
+  if (fabs(cp) < kSquaredPrecision)
+    return false;
+
+  bool const prevGreaterCurr = prev.y - curr.y > 0.0;
+  if (rCheck && ((cp > 0) == prevGreaterCurr))
+    ++rCross;
+  if (lCheck && ((cp > 0) != prevGreaterCurr))
+    ++lCross;
+  return true;
+}
+
+// |prev| and |curr| are translated by the point.
+bool IsAtEdge(PointD const & prev, PointD const & curr, double squaredDelta)
+{
+  if (IsVertex(curr))
+    return true;
+
+  PointD const d = curr - prev;
+  PointD const diff = -prev;
+  double const squaredLength = d.SquaredLength();
+  double t = squaredLength > 0.0 ? DotProduct(diff, d) / squaredLength : 0.0;
+  t = min(max(t, 0.0), 1.0);
+  return (diff - d * t).SquaredLength() < squaredDelta;
+}
+
+__m128d Abs(__m128d v) { return _mm_andnot_pd(_mm_set1_pd(-0.0), v); }
+
+// Loads the points i - 1, i, i + 1 which are translated by |origin| and returns the edges
+// (i - 1, i) and (i, i + 1) by coordinates.
+void LoadEdges(double const * coords, size_t i, __m128d origin, __m128d & prevX, __m128d & prevY,
+               __m128d & currX, __m128d & currY)
+{
+  __m128d const a = _mm_sub_pd(_mm_loadu_pd(coords + 2 * (i - 1)), origin);
+  __m128d const b = _mm_sub_pd(_mm_loadu_pd(coords + 2 * i), origin);
+  __m128d const c = _mm_sub_pd(_mm_loadu_pd(coords + 2 * (i + 1)), origin);
+  prevX = _mm_unpacklo_pd(a, b);
+  prevY = _mm_unpackhi_pd(a, b);
+  currX = _mm_unpacklo_pd(b, c);
+  currY = _mm_unpackhi_pd(b, c);
+}
+
+__m128d IsVertex(__m128d currX, __m128d currY)
+{
+  __m128d const eps = _mm_set1_pd(DefEqualFloat::kPrecision);
+  return _mm_and_pd(_mm_cmplt_pd(Abs(currX), eps), _mm_cmplt_pd(Abs(currY), eps));
+}
+
+uint64_t Sum(__m128i v)
+{
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), v);
+  return lanes[0] + lanes[1];
+}
+}  // namespace
+#endif
+
+bool ContainsSimd(vector<PointD> const & points, PointD const & pt,
+                  DefEqualFloat const & /* equalF */, bool & inside)
+{
+#if defined(__SSE2__)
+  size_t const numPoints = points.size();
+  if (numPoints < 3)
+    return false;
+
+  double const * const coords = &points[0].x;
+  __m128d const origin = _mm_set_pd(pt.y, pt.x);
+  __m128d const zero = _mm_setzero_pd();
+  __m128d const squaredEps = _mm_set1_pd(kSquaredPrecision);
+  // The lanes of the masks are all ones (-1) for true, so the crossings are subtracted.
+  __m128i rCrossing = _mm_setzero_si128();
+  __m128i lCrossing = _mm_setzero_si128();
+  __m128d degenerate = zero;
+
+  size_t i = 1;
+  for (; i + 1 < numPoints; i += 2)
+  {
+    __m128d prevX, prevY, currX, currY;
+    LoadEdges(coords, i, origin, prevX, prevY, currX, currY);
+
+    __m128d const rCheck = _mm_xor_pd(_mm_cmpgt_pd(currY, zero), _mm_cmpgt_pd(prevY, zero));
+    __m128d const lCheck = _mm_xor_pd(_mm_cmplt_pd(currY, zero), _mm_cmplt_pd(prevY, zero));
+    __m128d const cp = _mm_sub_pd(_mm_mul_pd(currX, prevY), _mm_mul_pd(currY, prevX));
+    __m128d const prevGreaterCurr = _mm_cmpgt_pd(_mm_sub_pd(prevY, currY), zero);
+    __m128d const differ = _mm_xor_pd(_mm_cmpgt_pd(cp, zero), prevGreaterCurr);
+
+    rCrossing = _mm_sub_epi64(rCrossing, _mm_castpd_si128(_mm_andnot_pd(differ, rCheck)));
+    lCrossing = _mm_sub_epi64(lCrossing, _mm_castpd_si128(_mm_and_pd(differ, lCheck)));
+
+    __m128d const onLine =
+        _mm_and_pd(_mm_or_pd(rCheck, lCheck), _mm_cmplt_pd(Abs(cp), squaredEps));
+    degenerate = _mm_or_pd(degenerate, _mm_or_pd(onLine, IsVertex(currX, currY)));
+  }
+
+  if (_mm_movemask_pd(degenerate) != 0)
+    return false;
+
+  uint64_t rCross = Sum(rCrossing);
+  uint64_t lCross = Sum(lCrossing);
+  for (; i < numPoints; ++i)
+  {
+    if (!CountCrossing(points[i - 1] - pt, points[i] - pt, rCross, lCross))
+      return false;
+  }
+  if (!CountCrossing(points[numPoints - 1] - pt, points[0] - pt, rCross, lCross))
+    return false;
+
+  // On the edge if left and right crossings are not of the same parity,
+  // inside if the number of crossings is odd.
+  inside = ((rCross & 1) != (lCross & 1)) || (rCross & 1) != 0;
+  return true;
+#else
+  UNUSED_VALUE(points);
+  UNUSED_VALUE(pt);
+  UNUSED_VALUE(inside);
+  return false;
+#endif
+}
+
+bool AtBorderSimd(vector<PointD> const & points, PointD const & pt, double squaredDelta,
+                  DefEqualFloat const & /* equalF */, bool & atBorder)
+{
+#if defined(__SSE2__)
+  size_t const numPoints = points.size();
+  if (numPoints < 3)
+    return false;
+
+  atBorder = true;
+  if (IsAtEdge(points[numPoints - 1] - pt, points[0] - pt, squaredDelta))
+    return true;
+
+  double const * const coords = &points[0].x;
+  __m128d const origin = _mm_set_pd(pt.y, pt.x);
+  __m128d const zero = _mm_setzero_pd();
+  __m128d const one = _mm_set1_pd(1.0);
+  __m128d const delta = _mm_set1_pd(squaredDelta);
+
+  size_t i = 1;
+  while (i + 1 < numPoints)
+  {
+    __m128d found = zero;
+    size_t const end = min(i + kAtBorderBlockSize, numPoints - 1);
+    for (; i < end; i += 2)
+    {
+      __m128d prevX, prevY, currX, currY;
+      LoadEdges(coords, i, origin, prevX, prevY, currX, currY);
+
+      // The closest point of the edge is prev + d * t, where t is in [0, 1].
+      __m128d const dX = _mm_sub_pd(currX, prevX);
+      __m128d const dY = _mm_sub_pd(currY, prevY);
+      __m128d const squaredLength = _mm_add_pd(_mm_mul_pd(dX, dX), _mm_mul_pd(dY, dY));
+      __m128d const dot =
+          _mm_sub_pd(zero, _mm_add_pd(_mm_mul_pd(prevX, dX), _mm_mul_pd(prevY, dY)));
+      // The lanes of the degenerate edges are zeroed.
+      __m128d t = _mm_and_pd(_mm_cmpgt_pd(squaredLength, zero), _mm_div_pd(dot, squaredLength));
+      t = _mm_min_pd(_mm_max_pd(t, zero), one);
+      __m128d const rX = _mm_add_pd(prevX, _mm_mul_pd(dX, t));
+      __m128d const rY = _mm_add_pd(prevY, _mm_mul_pd(dY, t));
+      __m128d const squaredDist = _mm_add_pd(_mm_mul_pd(rX, rX), _mm_mul_pd(rY, rY));
+
+      found = _mm_or_pd(found, _mm_cmplt_pd(squaredDist, delta));
+      found = _mm_or_pd(found, IsVertex(currX, currY));
+    }
+
+    if (_mm_movemask_pd(found) != 0)
+      return true;
+  }
+
+  for (; i < numPoints; ++i)
+  {
+    if (IsAtEdge(points[i - 1] - pt, points[i] - pt, squaredDelta))
+      return true;
+  }
+
+  atBorder = false;
+  return true;
+#else
+  UNUSED_VALUE(points);
+  UNUSED_VALUE(pt);
+  UNUSED_VALUE(squaredDelta);
+  UNUSED_VALUE(atBorder);
+  return false;
+#endif
+}
+}  // namespace detail
+}  // namespace m2
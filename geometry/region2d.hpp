@@ -80,6 +80,30 @@ struct Traitsype<0>
   typedef DefEqualInt EqualType;
   typedef int64_t BigType;
 };
+
+// SSE2 kernels of Region::Contains() and Region::AtBorder() which process two edges at a time.
+// They are used for the regions of PointD with the default precision and return false when
+// the scalar code must decide: there is no SSE2, or the point is too close to a vertex or
+// to the line of an edge which crosses the horizontal line through the point.
+template <typename Point, typename EqualFn>
+bool ContainsSimd(std::vector<Point> const & /* points */, Point const & /* pt */,
+                  EqualFn const & /* equalF */, bool & /* inside */)
+{
+  return false;
+}
+
+bool ContainsSimd(std::vector<PointD> const & points, PointD const & pt,
+                  DefEqualFloat const & equalF, bool & inside);
+
+template <typename Point, typename EqualFn>
+bool AtBorderSimd(std::vector<Point> const & /* points */, Point const & /* pt */,
+                  double /* squaredDelta */, EqualFn const & /* equalF */, bool & /* atBorder */)
+{
+  return false;
+}
+
+bool AtBorderSimd(std::vector<PointD> const & points, PointD const & pt, double squaredDelta,
+                  DefEqualFloat const & equalF, bool & atBorder);
 }  // namespace detail
 
 template <typename Point>
@@ -194,6 +218,10 @@ public:
     if (!m_rect.IsPointInside(pt))
       return false;
 
+    bool inside = false;
+    if (detail::ContainsSimd(m_points, pt, equalF, inside))
+      return inside;
+
     int rCross = 0; /* number of right edge/ray crossings */
     int lCross = 0; /* number of left edge/ray crossings */
 
@@ -274,6 +302,10 @@ public:
       return false;
 
     const double squaredDelta = delta * delta;
+    bool atBorder = false;
+    if (detail::AtBorderSimd(m_points, pt, squaredDelta, equalF, atBorder))
+      return atBorder;
+
     size_t const numPoints = m_points.size();
 
     Point prev = m_points[numPoints - 1];
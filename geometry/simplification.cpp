@@ -0,0 +1,190 @@
+#include "geometry/simplification.hpp"
+
+#include <atomic>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+// Polylines with more points are simplified in parallel.
+size_t constexpr kParallelMinPointsCount = 1 << 16;
+// The ranges of a parallel simplification which are not longer are processed by one thread.
+size_t constexpr kMinRangeSizePerThread = 1 << 12;
+
+#if defined(__SSE2__)
+__m128d Select(__m128d mask, __m128d a, __m128d b)
+{
+  return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+#endif
+
+struct Part
+{
+  // The range is simplified to |m_indexes| by a thread if |m_deferred|, otherwise |m_indexes|
+  // are found by the first steps of the algorithm.
+  size_t m_first = 0;
+  size_t m_last = 0;
+  bool m_deferred = false;
+  vector<size_t> m_indexes;
+};
+}  // namespace
+
+namespace impl
+{
+pair<double, size_t> MaxSquaredDistance(m2::PointD const * points, size_t first, size_t last)
+{
+  pair<double, size_t> res(0.0, last);
+  if (last <= first + 1)
+    return res;
+
+  // The same arithmetic as m2::ParametrizedSegment::SquaredDistanceToPoint().
+  m2::ParametrizedSegment<m2::PointD> const segment(points[first], points[last]);
+  m2::PointD const & p0 = segment.GetP0();
+  m2::PointD const & p1 = segment.GetP1();
+  m2::PointD const & d = segment.GetDirection();
+  double const length = segment.GetLength();
+
+  size_t i = first + 1;
+#if defined(__SSE2__)
+  static_assert(sizeof(m2::PointD) == 2 * sizeof(double), "PointD must be two packed doubles.");
+
+  __m128d const p0X = _mm_set1_pd(p0.x);
+  __m128d const p0Y = _mm_set1_pd(p0.y);
+  __m128d const p1X = _mm_set1_pd(p1.x);
+  __m128d const p1Y = _mm_set1_pd(p1.y);
+  __m128d const dX = _mm_set1_pd(d.x);
+  __m128d const dY = _mm_set1_pd(d.y);
+  __m128d const len = _mm_set1_pd(length);
+  __m128d const zero = _mm_setzero_pd();
+  __m128d const two = _mm_set1_pd(2.0);
+
+  // The max of the even and odd points from |first| + 1 and their indexes.
+  __m128d maxDist = zero;
+  __m128d maxIndex = _mm_set1_pd(static_cast<double>(last));
+  __m128d index = _mm_set_pd(static_cast<double>(i + 1), static_cast<double>(i));
+  for (; i + 1 < last; i += 2)
+  {
+    __m128d const a = _mm_loadu_pd(&points[i].x);
+    __m128d const b = _mm_loadu_pd(&points[i + 1].x);
+    __m128d const x = _mm_unpacklo_pd(a, b);
+    __m128d const y = _mm_unpackhi_pd(a, b);
+
+    __m128d const diffX = _mm_sub_pd(x, p0X);
+    __m128d const diffY = _mm_sub_pd(y, p0Y);
+    __m128d const t = _mm_add_pd(_mm_mul_pd(dX, diffX), _mm_mul_pd(dY, diffY));
+    __m128d const dist0 = _mm_add_pd(_mm_mul_pd(diffX, diffX), _mm_mul_pd(diffY, diffY));
+    __m128d const diff1X = _mm_sub_pd(x, p1X);
+    __m128d const diff1Y = _mm_sub_pd(y, p1Y);
+    __m128d const dist1 = _mm_add_pd(_mm_mul_pd(diff1X, diff1X), _mm_mul_pd(diff1Y, diff1Y));
+    __m128d const cross = _mm_sub_pd(_mm_mul_pd(diffX, dY), _mm_mul_pd(diffY, dX));
+    __m128d const distCross = _mm_mul_pd(cross, cross);
+
+    __m128d const dist = Select(_mm_cmple_pd(t, zero), dist0,
+                                Select(_mm_cmpge_pd(t, len), dist1, distCross));
+    __m128d const greater = _mm_cmplt_pd(maxDist, dist);
+    maxDist = Select(greater, dist, maxDist);
+    maxIndex = Select(greater, index, maxIndex);
+    index = _mm_add_pd(index, two);
+  }
+
+  double dists[2];
+  double indexes[2];
+  _mm_storeu_pd(dists, maxDist);
+  _mm_storeu_pd(indexes, maxIndex);
+  // Every lane keeps the first of its max points, the first of the lanes maxes is chosen.
+  for (size_t lane = 0; lane < 2; ++lane)
+  {
+    auto const laneIndex = static_cast<size_t>(indexes[lane]);
+    if (res.first < dists[lane] || (res.first == dists[lane] && laneIndex < res.second))
+      res = make_pair(dists[lane], laneIndex);
+  }
+#endif
+
+  for (; i < last; ++i)
+  {
+    double const dist = segment.SquaredDistanceToPoint(points[i]);
+    if (res.first < dist)
+      res = make_pair(dist, i);
+  }
+  return res;
+}
+
+void SimplifyDP(vector<m2::PointD> const & points, double epsilon, vector<size_t> & result)
+{
+  result.clear();
+  if (points.empty())
+    return;
+
+  auto const maxDistFn = [&points](size_t i, size_t j) {
+    return MaxSquaredDistance(points.data(), i, j);
+  };
+
+  size_t const threadsCount = thread::hardware_concurrency();
+  if (points.size() < kParallelMinPointsCount || threadsCount <= 1)
+  {
+    SimplifyDP(0 /* first */, points.size() - 1 /* last */, epsilon, maxDistFn,
+               [&result](size_t i) { result.push_back(i); });
+    return;
+  }
+
+  // The first steps split the polyline until the ranges are short enough to load all
+  // the threads. The parts of the result are kept in order.
+  size_t const maxRangeSize = max(kMinRangeSizePerThread, points.size() / (4 * threadsCount));
+  vector<Part> parts;
+  vector<pair<size_t, size_t>> ranges = {{0, points.size() - 1}};
+  while (!ranges.empty())
+  {
+    auto const range = ranges.back();
+    ranges.pop_back();
+
+    if (range.second - range.first <= maxRangeSize)
+    {
+      parts.emplace_back();
+      parts.back().m_first = range.first;
+      parts.back().m_last = range.second;
+      parts.back().m_deferred = true;
+      continue;
+    }
+
+    auto const maxDist = maxDistFn(range.first, range.second);
+    if (maxDist.second == range.second || maxDist.first < epsilon)
+    {
+      if (parts.empty() || parts.back().m_deferred)
+        parts.emplace_back();
+      parts.back().m_indexes.push_back(range.second);
+    }
+    else
+    {
+      ranges.emplace_back(maxDist.second, range.second);
+      ranges.emplace_back(range.first, maxDist.second);
+    }
+  }
+
+  atomic<size_t> next(0);
+  auto const simplifyParts = [&]() {
+    for (size_t i = next++; i < parts.size(); i = next++)
+    {
+      auto & part = parts[i];
+      if (!part.m_deferred)
+        continue;
+      SimplifyDP(part.m_first, part.m_last, epsilon, maxDistFn,
+                 [&part](size_t j) { part.m_indexes.push_back(j); });
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < min(threadsCount, parts.size()); ++i)
+    threads.emplace_back(simplifyParts);
+  simplifyParts();
+  for (auto & t : threads)
+    t.join();
+
+  for (auto const & part : parts)
+    result.insert(result.end(), part.m_indexes.begin(), part.m_indexes.end());
+}
+}  // namespace impl
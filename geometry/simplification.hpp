@@ -1,5 +1,6 @@
 #pragma once
 
+#include "geometry/parametrized_segment.hpp"
 #include "geometry/point2d.hpp"
 
 #include "base/base.hpp"
@@ -7,8 +8,10 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -41,23 +44,47 @@ std::pair<double, Iter> MaxDistance(Iter first, Iter last, DistanceFn & distFn)
   return res;
 }
 
-// Actual SimplifyDP implementation.
-template <typename DistanceFn, typename Iter, typename Out>
-void SimplifyDP(Iter first, Iter last, double epsilon, DistanceFn & distFn, Out & out)
+// Returns the max of m2::SquaredDistanceFromSegmentToPoint from the segment
+// [points[first], points[last]] to the points between and the index of the point (the first one
+// of the equal ones), or (0, last) if there are no such points. Unlike MaxDistance() with
+// the functor, the segment is parametrized once and the points are evaluated by pairs with SSE2.
+std::pair<double, size_t> MaxSquaredDistance(m2::PointD const * points, size_t first,
+                                             size_t last);
+
+// Douglas-Peucker algorithm for the indexes [first, last], calls |out| for the indexes
+// of the result except |first|. |maxDistFn(i, j)| returns the max distance from the segment
+// [i, j] to the points between and the index of the point like MaxDistance().
+// The ranges which are not processed yet are kept in a stack instead of the recursion,
+// the left range is on the top, so the indexes are emitted in increasing order.
+template <typename MaxDistanceFn, typename Out>
+void SimplifyDP(size_t first, size_t last, double epsilon, MaxDistanceFn && maxDistFn, Out && out)
 {
-  std::pair<double, Iter> maxDist = impl::MaxDistance(first, last, distFn);
-  if (maxDist.second == last || maxDist.first < epsilon)
-  {
-    out(*last);
-  }
-  else
+  std::vector<std::pair<size_t, size_t>> ranges = {{first, last}};
+  while (!ranges.empty())
   {
-    impl::SimplifyDP(first, maxDist.second, epsilon, distFn, out);
-    impl::SimplifyDP(maxDist.second, last, epsilon, distFn, out);
+    auto const range = ranges.back();
+    ranges.pop_back();
+
+    auto const maxDist = maxDistFn(range.first, range.second);
+    if (maxDist.second == range.second || maxDist.first < epsilon)
+    {
+      out(range.second);
+    }
+    else
+    {
+      ranges.emplace_back(maxDist.second, range.second);
+      ranges.emplace_back(range.first, maxDist.second);
+    }
   }
 }
 //@}
 
+// SimplifyDP() of all the |points| by m2::SquaredDistanceFromSegmentToPoint, |result| is filled
+// with the indexes of the result except 0. Long polylines are split by the first steps of
+// the algorithm and the parts are simplified in parallel.
+void SimplifyDP(std::vector<m2::PointD> const & points, double epsilon,
+                std::vector<size_t> & result);
+
 struct SimplifyOptimalRes
 {
   SimplifyOptimalRes() : m_PointCount(-1U) {}
@@ -67,6 +94,56 @@ struct SimplifyOptimalRes
   int32_t m_NextPoint;
   uint32_t m_PointCount;
 };
+
+// Dynamic programming for the indexes [0, n), calls |out| for the indexes of the result.
+// |maxDistFn| is the same as for SimplifyDP().
+template <typename MaxDistanceFn, typename Out>
+void SimplifyNearOptimal(int maxFalseLookAhead, int32_t n, double epsilon,
+                         MaxDistanceFn && maxDistFn, Out && out)
+{
+  std::vector<SimplifyOptimalRes> F(n);
+  F[n - 1] = SimplifyOptimalRes(n, 1);
+  for (int32_t i = n - 2; i >= 0; --i)
+  {
+    for (int32_t falseCount = 0, j = i + 1; j < n && falseCount < maxFalseLookAhead; ++j)
+    {
+      uint32_t const newPointCount = F[j].m_PointCount + 1;
+      if (newPointCount < F[i].m_PointCount)
+      {
+        if (maxDistFn(i, j).first < epsilon)
+        {
+          F[i].m_NextPoint = j;
+          F[i].m_PointCount = newPointCount;
+        }
+        else
+        {
+          ++falseCount;
+        }
+      }
+    }
+  }
+
+  for (int32_t i = 0; i < n; i = F[i].m_NextPoint)
+    out(i);
+}
+
+// The squared distances between m2::PointD are computed by MaxSquaredDistance() for the points
+// which are copied to a vector.
+template <typename DistanceFn>
+bool constexpr IsSquaredDistance()
+{
+  return std::is_same<DistanceFn, m2::SquaredDistanceFromSegmentToPoint<m2::PointD>>::value;
+}
+
+template <typename Iter>
+std::vector<m2::PointD> ToPoints(Iter beg, Iter end)
+{
+  std::vector<m2::PointD> points;
+  points.reserve(static_cast<size_t>(std::distance(beg, end)));
+  for (Iter it = beg; it != end; ++it)
+    points.emplace_back(*it);
+  return points;
+}
 }  // namespace impl
 
 // Douglas-Peucker algorithm for STL-like range [beg, end).
@@ -75,11 +152,26 @@ struct SimplifyOptimalRes
 template <typename DistanceFn, typename Iter, typename Out>
 void SimplifyDP(Iter beg, Iter end, double epsilon, DistanceFn distFn, Out out)
 {
-  if (beg != end)
+  if (beg == end)
+    return;
+
+  out(*beg);
+  if (impl::IsSquaredDistance<DistanceFn>())
   {
-    out(*beg);
-    impl::SimplifyDP(beg, end - 1, epsilon, distFn, out);
+    std::vector<size_t> indexes;
+    impl::SimplifyDP(impl::ToPoints(beg, end), epsilon, indexes);
+    for (size_t const i : indexes)
+      out(*(beg + i));
+    return;
   }
+
+  impl::SimplifyDP(
+      0 /* first */, static_cast<size_t>(std::distance(beg, end)) - 1 /* last */, epsilon,
+      [&](size_t i, size_t j) {
+        auto const res = impl::MaxDistance(beg + i, beg + j, distFn);
+        return std::make_pair(res.first, static_cast<size_t>(std::distance(beg, res.second)));
+      },
+      [&](size_t i) { out(*(beg + i)); });
 }
 
 // Dynamic programming near-optimal simplification.
@@ -100,30 +192,20 @@ void SimplifyNearOptimal(int maxFalseLookAhead, Iter beg, Iter end, double epsil
     return;
   }
 
-  std::vector<impl::SimplifyOptimalRes> F(n);
-  F[n - 1] = impl::SimplifyOptimalRes(n, 1);
-  for (int32_t i = n - 2; i >= 0; --i)
+  auto const outFn = [&](int32_t i) { out(*(beg + i)); };
+  if (impl::IsSquaredDistance<DistanceFn>())
   {
-    for (int32_t falseCount = 0, j = i + 1; j < n && falseCount < maxFalseLookAhead; ++j)
-    {
-      uint32_t const newPointCount = F[j].m_PointCount + 1;
-      if (newPointCount < F[i].m_PointCount)
-      {
-        if (impl::MaxDistance(beg + i, beg + j, distFn).first < epsilon)
-        {
-          F[i].m_NextPoint = j;
-          F[i].m_PointCount = newPointCount;
-        }
-        else
-        {
-          ++falseCount;
-        }
-      }
-    }
+    auto const points = impl::ToPoints(beg, end);
+    impl::SimplifyNearOptimal(
+        maxFalseLookAhead, n, epsilon,
+        [&points](int32_t i, int32_t j) { return impl::MaxSquaredDistance(points.data(), i, j); },
+        outFn);
+    return;
   }
 
-  for (int32_t i = 0; i < n; i = F[i].m_NextPoint)
-    out(*(beg + i));
+  impl::SimplifyNearOptimal(
+      maxFalseLookAhead, n, epsilon,
+      [&](int32_t i, int32_t j) { return impl::MaxDistance(beg + i, beg + j, distFn); }, outFn);
 }
 
 // Additional points filter to use in simplification.
@@ -235,6 +235,10 @@ public:
     m_tree.for_each(GetFunctor(rect, [&toDo](Value const & v) { toDo(v.GetRect(), v.m_val); }));
   }
 
+  // Rebuilds the tree as a balanced one. It's worth calling when a bulk of objects
+  // is added to a tree which is rarely modified later.
+  void Balance() { m_tree.optimise(); }
+
   bool IsEmpty() const { return m_tree.empty(); }
 
   size_t GetSize() const { return m_tree.size(); }
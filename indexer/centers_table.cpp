@@ -2,6 +2,7 @@
 
 #include "indexer/feature_processor.hpp"
 
+#include "coding/bit_streams.hpp"
 #include "coding/endianness.hpp"
 #include "coding/file_container.hpp"
 #include "coding/geometry_coding.hpp"
@@ -14,9 +15,13 @@
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <climits>
+#include <limits>
 #include <unordered_map>
 
 #include "3party/succinct/elias_fano.hpp"
@@ -28,22 +33,32 @@ namespace search
 {
 namespace
 {
+// Maps |cont| to [pos, pos + size) of |reader| and returns the region which |cont| refers to.
+// The data of a mapped reader is used in place unless the endianness mismatches.
 template <typename TCont>
-void EndiannessAwareMap(bool endiannesMismatch, CopiedMemoryRegion & region, TCont & cont)
+unique_ptr<MemoryRegion> EndiannessAwareMap(bool endiannesMismatch, Reader & reader, uint64_t pos,
+                                            uint64_t size, TCont & cont)
 {
   TCont c;
+  unique_ptr<MemoryRegion> region;
   if (endiannesMismatch)
   {
-    coding::ReverseMapVisitor visitor(region.MutableData());
+    vector<uint8_t> data(size);
+    reader.Read(pos, data.data(), data.size());
+    auto copied = make_unique<CopiedMemoryRegion>(move(data));
+    coding::ReverseMapVisitor visitor(copied->MutableData());
     c.map(visitor);
+    region = move(copied);
   }
   else
   {
-    coding::MapVisitor visitor(region.ImmutableData());
+    region = CreateMemoryRegion(reader, pos, size);
+    coding::MapVisitor visitor(region->ImmutableData());
     c.map(visitor);
   }
 
   c.swap(cont);
+  return region;
 }
 
 // V0 of CentersTable.  Has the following format:
@@ -193,21 +208,12 @@ private:
     bool const isDataBigEndian = m_header.m_base.m_endianness == 1;
     bool const endiannesMismatch = isHostBigEndian != isDataBigEndian;
 
-    {
-      uint32_t const idsSize = m_header.m_positionsOffset - sizeof(m_header);
-      vector<uint8_t> data(idsSize);
-      m_reader.Read(sizeof(m_header), data.data(), data.size());
-      m_idsRegion = make_unique<CopiedMemoryRegion>(move(data));
-      EndiannessAwareMap(endiannesMismatch, *m_idsRegion, m_ids);
-    }
+    uint32_t const idsSize = m_header.m_positionsOffset - sizeof(m_header);
+    m_idsRegion = EndiannessAwareMap(endiannesMismatch, m_reader, sizeof(m_header), idsSize, m_ids);
 
-    {
-      uint32_t const offsetsSize = m_header.m_deltasOffset - m_header.m_positionsOffset;
-      vector<uint8_t> data(offsetsSize);
-      m_reader.Read(m_header.m_positionsOffset, data.data(), data.size());
-      m_offsetsRegion = make_unique<CopiedMemoryRegion>(move(data));
-      EndiannessAwareMap(endiannesMismatch, *m_offsetsRegion, m_offsets);
-    }
+    uint32_t const offsetsSize = m_header.m_deltasOffset - m_header.m_positionsOffset;
+    m_offsetsRegion = EndiannessAwareMap(endiannesMismatch, m_reader, m_header.m_positionsOffset,
+                                         offsetsSize, m_offsets);
 
     return true;
   }
@@ -217,14 +223,203 @@ private:
   Reader & m_reader;
   serial::GeometryCodingParams const m_codingParams;
 
-  unique_ptr<CopiedMemoryRegion> m_idsRegion;
-  unique_ptr<CopiedMemoryRegion> m_offsetsRegion;
+  unique_ptr<MemoryRegion> m_idsRegion;
+  unique_ptr<MemoryRegion> m_offsetsRegion;
 
   succinct::rs_bit_vector m_ids;
   succinct::elias_fano m_offsets;
 
   unordered_map<uint32_t, vector<m2::PointU>> m_cache;
 };
+
+// V1 of CentersTable.  Has the following format:
+//
+// File offset (bytes)  Field name          Field size (bytes)
+// 0                    common header       4
+// 4                    values offset       4
+// 8                    end of section      4
+// 12                   min x               4
+// 16                   min y               4
+// 20                   x bits              1
+// 21                   y bits              1
+// 22                   reserved            2
+// 24                   identifiers table   values offset - 24
+// values offset        values              end of section - values offset
+//
+// All offsets and coordinates are in little-endian format.
+//
+// Identifiers table is the same as in V0.
+//
+// Values is a bit stream of fixed width entries, one per set bit of
+// the identifiers table.  Each entry is |x bits| bits of x followed
+// by |y bits| bits of y, where coordinates are quantized with the
+// coding params coord bits and are stored relative to the min x and
+// min y of all the centers.  The widths are chosen per mwm to fit the
+// bounding rect of the centers, so any center is decoded in O(1)
+// without decoding of its neighbours.
+class CentersTableV1 : public CentersTable
+{
+public:
+  struct Header
+  {
+    void Read(Reader & reader)
+    {
+      m_base.Read(reader);
+
+      NonOwningReaderSource source(reader);
+      source.Skip(sizeof(m_base));
+      m_valuesOffset = ReadPrimitiveFromSource<uint32_t>(source);
+      m_endOffset = ReadPrimitiveFromSource<uint32_t>(source);
+      m_minX = ReadPrimitiveFromSource<uint32_t>(source);
+      m_minY = ReadPrimitiveFromSource<uint32_t>(source);
+      m_xBits = ReadPrimitiveFromSource<uint8_t>(source);
+      m_yBits = ReadPrimitiveFromSource<uint8_t>(source);
+      m_reserved = ReadPrimitiveFromSource<uint16_t>(source);
+    }
+
+    void Write(Writer & writer)
+    {
+      m_base.Write(writer);
+
+      WriteToSink(writer, m_valuesOffset);
+      WriteToSink(writer, m_endOffset);
+      WriteToSink(writer, m_minX);
+      WriteToSink(writer, m_minY);
+      WriteToSink(writer, m_xBits);
+      WriteToSink(writer, m_yBits);
+      WriteToSink(writer, m_reserved);
+    }
+
+    bool IsValid() const
+    {
+      if (!m_base.IsValid())
+      {
+        LOG(LERROR, ("Base header is not valid!"));
+        return false;
+      }
+      if (m_valuesOffset < sizeof(Header))
+      {
+        LOG(LERROR, ("Values before header:", m_valuesOffset, sizeof(Header)));
+        return false;
+      }
+      if (m_endOffset < m_valuesOffset)
+      {
+        LOG(LERROR, ("End of section before values:", m_endOffset, m_valuesOffset));
+        return false;
+      }
+      if (m_xBits > 32 || m_yBits > 32)
+      {
+        LOG(LERROR, ("Wrong coordinate widths:", m_xBits, m_yBits));
+        return false;
+      }
+      return true;
+    }
+
+    CentersTable::Header m_base;
+    uint32_t m_valuesOffset = 0;
+    uint32_t m_endOffset = 0;
+    uint32_t m_minX = 0;
+    uint32_t m_minY = 0;
+    uint8_t m_xBits = 0;
+    uint8_t m_yBits = 0;
+    uint16_t m_reserved = 0;
+  };
+
+  static_assert(sizeof(Header) == 24, "Wrong header size.");
+
+  CentersTableV1(Reader & reader, serial::GeometryCodingParams const & codingParams)
+    : m_reader(reader), m_codingParams(codingParams)
+  {
+  }
+
+  // CentersTable overrides:
+  bool Get(uint32_t id, m2::PointD & center) override
+  {
+    if (id >= m_ids.size() || !m_ids[id])
+      return false;
+
+    uint8_t const entryBits = m_header.m_xBits + m_header.m_yBits;
+    uint64_t const bitPos = m_ids.rank(id) * entryBits;
+    uint64_t const entry = ReadBits(bitPos, entryBits);
+
+    m2::PointU const p(
+        m_header.m_minX + static_cast<uint32_t>(entry & bits::GetFullMask(m_header.m_xBits)),
+        m_header.m_minY + static_cast<uint32_t>((entry >> m_header.m_xBits) &
+                                                bits::GetFullMask(m_header.m_yBits)));
+    center = PointUToPointD(p, m_codingParams.GetCoordBits());
+    return true;
+  }
+
+private:
+  // Reads |n| <= 64 bits of values starting from the |bitPos| bit.
+  uint64_t ReadBits(uint64_t bitPos, uint8_t n) const
+  {
+    if (n == 0)
+      return 0;
+
+    uint64_t const begin = bitPos / CHAR_BIT;
+    uint32_t const shift = static_cast<uint32_t>(bitPos % CHAR_BIT);
+    // An entry with its shift takes at most 9 bytes.
+    uint8_t data[9] = {};
+    size_t const size = static_cast<size_t>((shift + n + CHAR_BIT - 1) / CHAR_BIT);
+    m_reader.Read(m_header.m_valuesOffset + begin, data, size);
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i)
+      value |= static_cast<uint64_t>(data[i]) << (i * CHAR_BIT);
+    value >>= shift;
+    if (shift != 0)
+      value |= static_cast<uint64_t>(data[8]) << (64 - shift);
+    return value;
+  }
+
+  // CentersTable overrides:
+  bool Init() override
+  {
+    m_header.Read(m_reader);
+
+    if (!m_header.IsValid())
+      return false;
+
+    bool const isHostBigEndian = IsBigEndianMacroBased();
+    bool const isDataBigEndian = m_header.m_base.m_endianness == 1;
+    bool const endiannesMismatch = isHostBigEndian != isDataBigEndian;
+
+    uint32_t const idsSize = m_header.m_valuesOffset - sizeof(m_header);
+    m_idsRegion = EndiannessAwareMap(endiannesMismatch, m_reader, sizeof(m_header), idsSize, m_ids);
+
+    uint64_t const valuesBits =
+        static_cast<uint64_t>(m_header.m_endOffset - m_header.m_valuesOffset) * CHAR_BIT;
+    if (m_ids.num_ones() * (m_header.m_xBits + m_header.m_yBits) > valuesBits)
+    {
+      LOG(LERROR, ("Not enough values for identifiers:", m_ids.num_ones(), valuesBits));
+      return false;
+    }
+
+    return true;
+  }
+
+private:
+  Header m_header;
+  Reader & m_reader;
+  serial::GeometryCodingParams const m_codingParams;
+
+  unique_ptr<MemoryRegion> m_idsRegion;
+  succinct::rs_bit_vector m_ids;
+};
+
+template <typename Writer>
+void FreezeIds(vector<uint32_t> const & ids, Writer & writer)
+{
+  uint64_t const numBits = ids.empty() ? 0 : ids.back() + 1;
+
+  succinct::bit_vector_builder builder(numBits);
+  for (auto const & id : ids)
+    builder.set(id, true);
+
+  coding::FreezeVisitor<Writer> visitor(writer);
+  succinct::rs_bit_vector(&builder).map(visitor);
+}
 }  // namespace
 
 // CentersTable::Header ----------------------------------------------------------------------------
@@ -253,13 +448,15 @@ unique_ptr<CentersTable> CentersTable::Load(Reader & reader,
                                             serial::GeometryCodingParams const & codingParams)
 {
   uint16_t const version = ReadPrimitiveFromPos<uint16_t>(reader, 0 /* pos */);
-  if (version != 0)
-    return unique_ptr<CentersTable>();
 
-  // Only single version of centers table is supported now.  If you
-  // need to implement new versions of CentersTable, implement
-  // dispatching based on first-four-bytes version.
-  unique_ptr<CentersTable> table = make_unique<CentersTableV0>(reader, codingParams);
+  unique_ptr<CentersTable> table;
+  switch (version)
+  {
+  case 0: table = make_unique<CentersTableV0>(reader, codingParams); break;
+  case 1: table = make_unique<CentersTableV1>(reader, codingParams); break;
+  default: return unique_ptr<CentersTable>();
+  }
+
   if (!table->Init())
     return unique_ptr<CentersTable>();
   return table;
@@ -276,22 +473,21 @@ void CentersTableBuilder::Put(uint32_t featureId, m2::PointD const & center)
 }
 
 void CentersTableBuilder::Freeze(Writer & writer) const
+{
+  if (m_fixedWidth)
+    FreezeV1(writer);
+  else
+    FreezeV0(writer);
+}
+
+void CentersTableBuilder::FreezeV0(Writer & writer) const
 {
   CentersTableV0::Header header;
 
   auto const startOffset = writer.Pos();
   header.Write(writer);
 
-  {
-    uint64_t const numBits = m_ids.empty() ? 0 : m_ids.back() + 1;
-
-    succinct::bit_vector_builder builder(numBits);
-    for (auto const & id : m_ids)
-      builder.set(id, true);
-
-    coding::FreezeVisitor<Writer> visitor(writer);
-    succinct::rs_bit_vector(&builder).map(visitor);
-  }
+  FreezeIds(m_ids, writer);
 
   vector<uint32_t> offsets;
   vector<uint8_t> deltas;
@@ -336,4 +532,49 @@ void CentersTableBuilder::Freeze(Writer & writer) const
   header.Write(writer);
   writer.Seek(endOffset);
 }
+
+void CentersTableBuilder::FreezeV1(Writer & writer) const
+{
+  CentersTableV1::Header header;
+  header.m_base.m_version = 1;
+
+  uint32_t maxX = 0;
+  uint32_t maxY = 0;
+  if (!m_centers.empty())
+  {
+    header.m_minX = header.m_minY = numeric_limits<uint32_t>::max();
+    for (auto const & center : m_centers)
+    {
+      header.m_minX = min(header.m_minX, center.x);
+      header.m_minY = min(header.m_minY, center.y);
+      maxX = max(maxX, center.x);
+      maxY = max(maxY, center.y);
+    }
+  }
+  header.m_xBits = static_cast<uint8_t>(bits::NumUsedBits(maxX - header.m_minX));
+  header.m_yBits = static_cast<uint8_t>(bits::NumUsedBits(maxY - header.m_minY));
+
+  auto const startOffset = writer.Pos();
+  header.Write(writer);
+
+  FreezeIds(m_ids, writer);
+
+  header.m_valuesOffset = base::checked_cast<uint32_t>(writer.Pos() - startOffset);
+  {
+    BitWriter<Writer> bitWriter(writer);
+    for (auto const & center : m_centers)
+    {
+      bitWriter.WriteAtMost32Bits(center.x - header.m_minX, header.m_xBits);
+      bitWriter.WriteAtMost32Bits(center.y - header.m_minY, header.m_yBits);
+    }
+  }
+  header.m_endOffset = base::checked_cast<uint32_t>(writer.Pos() - startOffset);
+
+  auto const endOffset = writer.Pos();
+
+  writer.Seek(startOffset);
+  CHECK_EQUAL(header.m_base.m_endianness, 0, ("|m_endianness| should be set to little-endian."));
+  header.Write(writer);
+  writer.Seek(endOffset);
+}
 }  // namespace search
@@ -68,11 +68,19 @@ public:
     m_codingParams = codingParams;
   }
 
+  // When set, the table is written in the fixed width format, which
+  // gives O(1) access to any center at the cost of the table size.
+  inline void SetFixedWidth(bool fixedWidth) { m_fixedWidth = fixedWidth; }
+
   void Put(uint32_t featureId, m2::PointD const & center);
   void Freeze(Writer & writer) const;
 
 private:
+  void FreezeV0(Writer & writer) const;
+  void FreezeV1(Writer & writer) const;
+
   serial::GeometryCodingParams m_codingParams;
+  bool m_fixedWidth = false;
 
   std::vector<m2::PointU> m_centers;
   std::vector<uint32_t> m_ids;
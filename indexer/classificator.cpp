@@ -2,6 +2,12 @@
 #include "indexer/map_style_reader.hpp"
 #include "indexer/tree_structure.hpp"
 
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "base/bits.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/string_utils.hpp"
@@ -9,11 +15,39 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <numeric>
+#include <unordered_map>
 
 using namespace std;
 
 namespace
 {
+  // The names of the object and its children are written in preorder.
+  template <typename Sink>
+  void WriteTree(Sink & sink, ClassifObject const & obj)
+  {
+    rw::Write(sink, obj.GetName());
+    WriteVarUint(sink, static_cast<uint32_t>(obj.GetObjectsCount()));
+    for (size_t i = 0; i < obj.GetObjectsCount(); ++i)
+      WriteTree(sink, *obj.GetObject(i));
+  }
+
+  template <typename Source, typename ToDo>
+  void ReadTree(Source & src, ToDo & toDo)
+  {
+    string name;
+    rw::Read(src, name);
+    toDo.Name(name);
+
+    auto const count = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      toDo.Start(i);
+      ReadTree(src, toDo);
+      toDo.End();
+    }
+  }
+
   struct less_scales
   {
     bool operator() (drule::Key const & l, int r) const { return l.m_scale < r; }
@@ -169,14 +203,8 @@ namespace ftype
 
   uint8_t get_control_level(uint32_t type)
   {
-    uint8_t count = 0;
-    while (type > 1)
-    {
-      type = type >> bits_count;
-      ++count;
-    }
-
-    return count;
+    // The control bit is the highest one.
+    return type > 1 ? bits::FloorLog(type) / bits_count : 0;
   }
 
   void PushValue(uint32_t & type, uint8_t value)
@@ -369,6 +397,35 @@ void Classificator::ReadClassificator(istream & s)
   tree::LoadTreeAsText(s, policy);
 
   m_root.Sort();
+  m_objects.Build(m_root);
+
+  m_coastType = GetTypeByPath({ "natural", "coastline" });
+}
+
+void Classificator::WriteSnapshot(vector<uint8_t> & buffer) const
+{
+  MemWriter<vector<uint8_t>> writer(buffer);
+  WriteTree(writer, m_root);
+
+  WriteVarUint(writer, m_mapping.GetTypesCount());
+  for (uint32_t i = 0; i < m_mapping.GetTypesCount(); ++i)
+    WriteVarUint(writer, m_mapping.GetType(i));
+}
+
+void Classificator::ReadSnapshot(uint8_t const * data, size_t size)
+{
+  Clear();
+
+  MemReaderWithExceptions reader(data, size);
+  ReaderSource<MemReaderWithExceptions> src(reader);
+  ClassifObject::LoadPolicy policy(&m_root);
+  ReadTree(src, policy);
+  m_objects.Build(m_root);
+
+  vector<uint32_t> types(ReadVarUint<uint32_t>(src));
+  for (auto & type : types)
+    type = ReadVarUint<uint32_t>(src);
+  m_mapping.Load(types);
 
   m_coastType = GetTypeByPath({ "natural", "coastline" });
 }
@@ -428,6 +485,7 @@ void Classificator::ReadTypesMapping(istream & s)
 void Classificator::Clear()
 {
   ClassifObject("world").Swap(m_root);
+  m_objects.Clear();
   m_mapping.Clear();
 }
 
@@ -441,3 +499,178 @@ string Classificator::GetReadableObjectName(uint32_t type) const
   replace(s.begin(), s.end(), '|', '-');
   return s;
 }
+
+void Classificator::CompileDrawRules()
+{
+  m_objects.CompileDrawRules();
+}
+
+// Classificator::ObjectsTable ---------------------------------------------------------------------
+void Classificator::ObjectsTable::Build(ClassifObject const & root)
+{
+  Clear();
+
+  vector<uint32_t> types = {ftype::GetEmptyValue()};
+  unordered_map<uint32_t, pair<ClassifObject const *, string>> objects;
+  objects[ftype::GetEmptyValue()] = make_pair(&root, string());
+  root.ForEachObjectInTree(
+      [&](ClassifObject const * p, uint32_t type) {
+        uint32_t parent = type;
+        ftype::PopValue(parent);
+        string fullName = objects[parent].second + p->GetName() + '|';
+        objects[type] = make_pair(p, move(fullName));
+        types.push_back(type);
+      },
+      ftype::GetEmptyValue());
+
+  // About four types per bucket and 80% of the slots are used.
+  size_t const count = types.size();
+  m_displacements.assign(max(count / 4, size_t(1)), 0);
+  size_t slotsCount = count + count / 4 + 1;
+  while (!TryBuild(types, slotsCount))
+    slotsCount += count / 8 + 1;
+
+  m_objects.assign(slotsCount, nullptr);
+  m_fullNames.assign(slotsCount, string());
+  for (size_t i = 0; i < slotsCount; ++i)
+  {
+    if (m_types[i] == 0)
+      continue;
+    auto & object = objects[m_types[i]];
+    m_objects[i] = object.first;
+    m_fullNames[i] = move(object.second);
+  }
+}
+
+void Classificator::ObjectsTable::Clear()
+{
+  m_displacements.clear();
+  m_types.clear();
+  m_objects.clear();
+  m_fullNames.clear();
+  m_ruleRows.clear();
+  m_ruleOffsets.clear();
+  m_rules.clear();
+}
+
+void Classificator::ObjectsTable::CompileDrawRules()
+{
+  m_ruleRows.assign(m_objects.size(), kNoRules);
+  m_ruleOffsets.assign(1, 0);
+  m_rules.clear();
+
+  drule::KeysT keys;
+  for (size_t i = 0; i < m_objects.size(); ++i)
+  {
+    if (m_objects[i] == nullptr || m_objects[i]->GetDrawingRules().empty())
+      continue;
+
+    m_ruleRows[i] = static_cast<uint32_t>((m_ruleOffsets.size() - 1) /
+                                          (kScalesCount * kGeomTypesCount));
+    for (size_t scale = 0; scale < kScalesCount; ++scale)
+    {
+      for (size_t ft = 0; ft < kGeomTypesCount; ++ft)
+      {
+        keys.clear();
+        m_objects[i]->GetSuitable(static_cast<int>(scale), static_cast<feature::EGeomType>(ft),
+                                  keys);
+        m_rules.insert(m_rules.end(), keys.begin(), keys.end());
+        m_ruleOffsets.push_back(static_cast<uint32_t>(m_rules.size()));
+      }
+    }
+  }
+}
+
+void Classificator::ObjectsTable::GetDrawRules(int slot, int scale, feature::EGeomType ft,
+                                               drule::KeysT & keys) const
+{
+  ASSERT(HasDrawRules(), ());
+  ASSERT(0 <= scale && scale < static_cast<int>(kScalesCount), (scale));
+  ASSERT(ft >= 0 && ft < static_cast<int>(kGeomTypesCount), (ft));
+
+  uint32_t const row = m_ruleRows[slot];
+  if (row == kNoRules)
+    return;
+
+  size_t const i = (row * kScalesCount + scale) * kGeomTypesCount + ft;
+  keys.append(m_rules.begin() + m_ruleOffsets[i], m_rules.begin() + m_ruleOffsets[i + 1]);
+}
+
+int Classificator::ObjectsTable::FindSlot(uint32_t type) const
+{
+  if (type == 0 || m_displacements.empty())
+    return -1;
+
+  uint32_t const displacement = m_displacements[Hash(type, 0) % m_displacements.size()];
+  size_t const slot = Hash(type, displacement) % m_types.size();
+  return m_types[slot] == type ? static_cast<int>(slot) : -1;
+}
+
+// static
+uint32_t Classificator::ObjectsTable::Hash(uint32_t type, uint32_t displacement)
+{
+  // The finalizer of MurmurHash3.
+  uint32_t h = type ^ (displacement * 0x9e3779b9);
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+bool Classificator::ObjectsTable::TryBuild(vector<uint32_t> const & types, size_t slotsCount)
+{
+  uint32_t constexpr kMaxDisplacement = 1 << 16;
+
+  vector<vector<uint32_t>> buckets(m_displacements.size());
+  for (auto const type : types)
+    buckets[Hash(type, 0) % buckets.size()].push_back(type);
+
+  // The largest buckets are placed first while most of the slots are free.
+  vector<size_t> order(buckets.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  m_types.assign(slotsCount, 0);
+  fill(m_displacements.begin(), m_displacements.end(), 0);
+  vector<size_t> slots;
+  for (auto const b : order)
+  {
+    auto const & bucket = buckets[b];
+    if (bucket.empty())
+      break;
+
+    uint32_t displacement = 1;
+    for (; displacement <= kMaxDisplacement; ++displacement)
+    {
+      slots.clear();
+      for (auto const type : bucket)
+      {
+        size_t const slot = Hash(type, displacement) % slotsCount;
+        if (m_types[slot] != 0 || find(slots.begin(), slots.end(), slot) != slots.end())
+          break;
+        slots.push_back(slot);
+      }
+      if (slots.size() == bucket.size())
+        break;
+    }
+
+    if (displacement > kMaxDisplacement)
+      return false;
+
+    m_displacements[b] = displacement;
+    for (size_t i = 0; i < bucket.size(); ++i)
+      m_types[slots[i]] = bucket[i];
+  }
+  return true;
+}
+
+// static
+uint32_t constexpr Classificator::ObjectsTable::kNoRules;
+// static
+size_t constexpr Classificator::ObjectsTable::kScalesCount;
+// static
+size_t constexpr Classificator::ObjectsTable::kGeomTypesCount;
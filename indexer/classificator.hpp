@@ -11,6 +11,7 @@
 #include <bitset>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -79,6 +80,7 @@ public:
 
   std::string const & GetName() const { return m_name; }
   ClassifObject const * GetObject(size_t i) const;
+  size_t GetObjectsCount() const { return m_objs.size(); }
 
   void ConcatChildNames(std::string & s) const;
 
@@ -166,6 +168,12 @@ public:
   //@{
   void ReadClassificator(std::istream & s);
   void ReadTypesMapping(std::istream & s);
+
+  /// Binary snapshot of the tree and the types mapping which is read much faster
+  /// than the text files, see classificator::Load().
+  void WriteSnapshot(std::vector<uint8_t> & buffer) const;
+  /// Throws Reader::Exception if the snapshot is broken.
+  void ReadSnapshot(uint8_t const * data, size_t size);
   //@}
 
   void Clear();
@@ -183,6 +191,9 @@ public:
   //@}
 
   uint32_t GetIndexForType(uint32_t t) const { return m_mapping.GetIndex(t); }
+  /// @returns IndexAndTypeMapping::kInvalidIndex in case of nonexisting type.
+  uint32_t FindIndexForType(uint32_t t) const { return m_mapping.FindIndex(t); }
+  uint32_t GetTypesCount() const { return m_mapping.GetTypesCount(); }
   // Throws std::out_of_range exception.
   uint32_t GetTypeForIndex(uint32_t i) const { return m_mapping.GetType(i); }
   bool IsTypeValid(uint32_t t) const { return m_mapping.HasIndex(t); }
@@ -223,10 +234,64 @@ public:
   /// @return Object name to show in UI (not for debug purposes).
   std::string GetReadableObjectName(uint32_t type) const;
 
+  /// Compiles the drawing rules of all the objects into the table by scales and geometry types.
+  /// It's called when the rules are loaded, see drule::LoadRules().
+  void CompileDrawRules();
+  /// Adds the drawing rules of |type| for |scale| and geometry |ft| to |keys|,
+  /// the same as ClassifObject::GetSuitable() does.
+  void GetDrawRules(uint32_t type, int scale, feature::EGeomType ft, drule::KeysT & keys) const;
+
 private:
+  /// Flat table of all the objects of the tree which is built by ReadClassificator().
+  /// The objects are found by types with a perfect hash (hash and displace): a type is hashed
+  /// to a bucket and the bucket's displacement gives the type's slot, so the lookup is two
+  /// reads of the small arrays and doesn't walk the tree level by level.
+  class ObjectsTable
+  {
+  public:
+    void Build(ClassifObject const & root);
+    void Clear();
+
+    /// @returns -1 if |type| is not in the table.
+    int FindSlot(uint32_t type) const;
+
+    ClassifObject const * GetObject(int slot) const { return m_objects[slot]; }
+    /// @returns the names of the path to the object separated and ended by '|'.
+    std::string const & GetFullName(int slot) const { return m_fullNames[slot]; }
+
+    void CompileDrawRules();
+    bool HasDrawRules() const { return !m_ruleOffsets.empty(); }
+    void GetDrawRules(int slot, int scale, feature::EGeomType ft, drule::KeysT & keys) const;
+
+  private:
+    static uint32_t constexpr kNoRules = std::numeric_limits<uint32_t>::max();
+    static size_t constexpr kScalesCount = scales::UPPER_STYLE_SCALE + 1;
+    static size_t constexpr kGeomTypesCount = 3;
+
+    static uint32_t Hash(uint32_t type, uint32_t displacement);
+
+    bool TryBuild(std::vector<uint32_t> const & types, size_t slotsCount);
+
+    std::vector<uint32_t> m_displacements;
+    // Types, objects and names by slots, the type of an empty slot is 0.
+    std::vector<uint32_t> m_types;
+    std::vector<ClassifObject const *> m_objects;
+    std::vector<std::string> m_fullNames;
+
+    // Rows of the compiled rules by slots, kNoRules for the objects without rules.
+    std::vector<uint32_t> m_ruleRows;
+    // The rules of the row r for the scale s and the geometry type t are
+    // [m_ruleOffsets[i], m_ruleOffsets[i + 1]) of |m_rules|, where
+    // i = (r * kScalesCount + s) * kGeomTypesCount + t.
+    std::vector<uint32_t> m_ruleOffsets;
+    std::vector<drule::Key> m_rules;
+  };
+
   static ClassifObject * AddV(ClassifObject * parent, std::string const & key,
                               std::string const & value);
 
+  ClassifObject const * GetObjectByPath(uint32_t type) const;
+
   /// Return type by path in classificator tree, for example
   /// path = ["natural", "caostline"].
   //@{
@@ -234,6 +299,7 @@ private:
   uint32_t GetTypeByPathImpl(Iter beg, Iter end) const;
 
   ClassifObject m_root;
+  ObjectsTable m_objects;
   IndexAndTypeMapping m_mapping;
   uint32_t m_coastType;
 
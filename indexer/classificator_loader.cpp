@@ -5,17 +5,87 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 #include "coding/reader_streambuf.hpp"
+#include "coding/sha1.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "base/logging.hpp"
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace
 {
+// Snapshot of the classificator in the writable directory, see Classificator::WriteSnapshot().
+char const kSnapshotFile[] = "classificator.snapshot";
+uint32_t constexpr kSnapshotVersion = 0;
+
+// Returns false if there's no snapshot or it was written for other text files.
+bool ReadSnapshot(std::string const & path, coding::SHA1::Hash const & hash)
+{
+  if (!GetPlatform().IsFileExistsByFullPath(path))
+    return false;
+
+  try
+  {
+    MmapReader reader(path);
+    ReaderSource<MmapReader> src(reader);
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kSnapshotVersion)
+      return false;
+
+    coding::SHA1::Hash snapshotHash;
+    src.Read(snapshotHash.data(), snapshotHash.size());
+    if (snapshotHash != hash)
+      return false;
+
+    auto const offset = static_cast<size_t>(src.Pos());
+    classif().ReadSnapshot(reader.Data() + offset, static_cast<size_t>(reader.Size()) - offset);
+    return true;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read classificator snapshot", path, e.Msg()));
+    classif().Clear();
+    return false;
+  }
+}
+
+void WriteSnapshot(std::string const & path, coding::SHA1::Hash const & hash)
+{
+  std::vector<uint8_t> buffer;
+  classif().WriteSnapshot(buffer);
+
+  // The snapshot is written to the temporary file so that a broken file isn't loaded.
+  std::string const tmpPath = path + ".tmp";
+  try
+  {
+    {
+      FileWriter writer(tmpPath);
+      WriteToSink(writer, kSnapshotVersion);
+      writer.Write(hash.data(), hash.size());
+      writer.Write(buffer.data(), buffer.size());
+    }
+
+    if (!base::RenameFileX(tmpPath, path))
+    {
+      LOG(LWARNING, ("Can't rename", tmpPath, "to", path));
+      base::DeleteFileX(tmpPath);
+    }
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write classificator snapshot", path, e.Msg()));
+    base::DeleteFileX(tmpPath);
+  }
+}
+
 void ReadCommon(std::unique_ptr<Reader> classificator,
                 std::unique_ptr<Reader> types)
 {
@@ -38,6 +108,29 @@ void ReadCommon(std::unique_ptr<Reader> classificator,
     c.ReadTypesMapping(s);
   }
 }
+// Reads the classificator and the types from the snapshot if the text files are the same
+// as the ones of the snapshot, otherwise parses the text files and writes the snapshot.
+void ReadClassificatorAndTypes(Platform & p)
+{
+  std::string classificatorText;
+  p.GetReader("classificator.txt")->ReadAsString(classificatorText);
+  std::string typesText;
+  p.GetReader("types.txt")->ReadAsString(typesText);
+
+  coding::SHA1::Calculator calculator;
+  calculator.Update(classificatorText.data(), classificatorText.size());
+  calculator.Update(typesText.data(), typesText.size());
+  auto const hash = calculator.Finish();
+
+  std::string const path = p.WritablePathForFile(kSnapshotFile);
+  if (ReadSnapshot(path, hash))
+    return;
+
+  ReadCommon(std::make_unique<MemReaderWithExceptions>(classificatorText.data(),
+                                                       classificatorText.size()),
+             std::make_unique<MemReaderWithExceptions>(typesText.data(), typesText.size()));
+  WriteSnapshot(path, hash);
+}
 }  // namespace
 
 namespace classificator
@@ -57,8 +150,7 @@ void Load()
     if (mapStyle != MapStyleMerged || originMapStyle == MapStyleMerged)
     {
       GetStyleReader().SetCurrentStyle(mapStyle);
-      ReadCommon(p.GetReader("classificator.txt"),
-                 p.GetReader("types.txt"));
+      ReadClassificatorAndTypes(p);
 
       drule::LoadRules();
     }
@@ -103,6 +103,7 @@ namespace feature
     SaveBytes(w, m_langs);
 
     WriteVarInt(w, static_cast<int32_t>(m_type));
+    WriteToSink(w, static_cast<uint8_t>(m_geometryLayout));
   }
 
   void DataHeader::Load(FilesContainerR const & cont)
@@ -138,6 +139,15 @@ namespace feature
     }
 
     // Place all new serializable staff here.
+
+    // Mwms generated before the layout was introduced have no more data in the header.
+    m_geometryLayout = GeometryLayout::Compact;
+    if (src.Size() > 0)
+    {
+      auto const layout = ReadPrimitiveFromSource<uint8_t>(src);
+      CHECK_LESS_OR_EQUAL(layout, static_cast<uint8_t>(GeometryLayout::Progressive), ());
+      m_geometryLayout = static_cast<GeometryLayout>(layout);
+    }
   }
 
   void DataHeader::LoadV1(ModelReaderPtr const & r)
@@ -157,4 +167,15 @@ namespace feature
 
     m_format = version::Format::v1;
   }
+
+  string DebugPrint(DataHeader::GeometryLayout layout)
+  {
+    switch (layout)
+    {
+    case DataHeader::GeometryLayout::Compact: return "Compact";
+    case DataHeader::GeometryLayout::FixedWidth: return "FixedWidth";
+    case DataHeader::GeometryLayout::Progressive: return "Progressive";
+    }
+    CHECK_SWITCH();
+  }
 }
@@ -85,9 +85,28 @@ namespace feature
     inline void SetType(MapType t) { m_type = t; }
     inline MapType GetType() const { return m_type; }
 
+    /// Layout of the outer geometry and triangles sections.
+    enum class GeometryLayout : uint8_t
+    {
+      /// Varint deltas with predictions, see serial::SaveOuterPath().
+      Compact = 0,
+      /// Fixed width deltas, they are larger but faster to decode,
+      /// see serial::SaveOuterFixedWidth(). Only the readers which know the layout
+      /// may read such mwms.
+      FixedWidth = 1,
+      /// Outer paths of coarser scales are indexes of points of the best path, see
+      /// serial::SaveOuterPathIndexes(). The best path and triangles use the Compact layout.
+      /// Only the readers which know the layout may read such mwms.
+      Progressive = 2
+    };
+
+    inline void SetGeometryLayout(GeometryLayout layout) { m_geometryLayout = layout; }
+    inline GeometryLayout GetGeometryLayout() const { return m_geometryLayout; }
+
   private:
     version::Format m_format;
     MapType m_type;
+    GeometryLayout m_geometryLayout = GeometryLayout::Compact;
 
     /// Use lastFormat as a default value for indexes building.
     /// Pass the valid format from wmw in all other cases.
@@ -95,4 +114,6 @@ namespace feature
     void LoadV1(ModelReaderPtr const & r);
     //@}
   };
+
+  std::string DebugPrint(DataHeader::GeometryLayout layout);
 }
@@ -1,9 +1,14 @@
 #include "indexer/data_source.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
@@ -43,17 +48,15 @@ public:
 
       // Use last coding scale for covering (see index_builder.cpp).
       covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
-      ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG), mwmValue->m_factory);
-
-      // iterate through intervals
-      for (auto const & i : intervals)
-      {
-        index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint32_t index) {
-          if (!checkUnique(index))
-            return;
-          m_fn(index, *src);
-        });
-      }
+      auto const & index = mwmValue->GetScaleIndex();
+
+      // Nodes shared by adjacent intervals are read once.
+      index.ForEachInIntervalsAndScale(intervals.begin(), intervals.end(), scale,
+                                       [&](uint32_t index) {
+                                         if (!checkUnique(index))
+                                           return;
+                                         m_fn(index, *src);
+                                       });
     }
     // Check created features container.
     // Need to do it on a per-mwm basis, because Drape relies on features in a sorted order.
@@ -88,6 +91,74 @@ void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & s
   }
   fn(feature);
 }
+
+// Max number of tasks the covering intervals of an mwm are split into by
+// DataSource::ForEachInRectParallel().
+size_t constexpr kMaxTasksPerMwm = 8;
+
+// Thread-safe set of feature indices of an mwm, needed when features of the mwm are read
+// by several tasks and a feature may be found in intervals of different tasks.
+class ConcurrentUniqueIndexes
+{
+public:
+  explicit ConcurrentUniqueIndexes(size_t numFeatures)
+    : m_numWords((numFeatures + 63) / 64), m_words(new atomic<uint64_t>[m_numWords])
+  {
+    for (size_t i = 0; i < m_numWords; ++i)
+      m_words[i].store(0, memory_order_relaxed);
+  }
+
+  // Returns true if |index| was absent.
+  bool operator()(uint32_t index)
+  {
+    CHECK_LESS(index / 64, m_numWords, ());
+    auto const mask = uint64_t{1} << (index % 64);
+    return (m_words[index / 64].fetch_or(mask, memory_order_relaxed) & mask) == 0;
+  }
+
+private:
+  size_t const m_numWords;
+  unique_ptr<atomic<uint64_t>[]> m_words;
+};
+
+// Runs tasks on a task loop and waits for them.
+class TasksWaiter
+{
+public:
+  explicit TasksWaiter(base::TaskLoop & pool) : m_pool(pool) {}
+
+  ~TasksWaiter()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_numPending == 0; });
+  }
+
+  // Runs |task| on the current thread when the loop is shut down.
+  void Push(base::TaskLoop::Task && task)
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      ++m_numPending;
+    }
+
+    auto wrapped = [this, task]() {
+      task();
+      lock_guard<mutex> lock(m_mutex);
+      if (--m_numPending == 0)
+        m_cv.notify_one();
+    };
+
+    if (!m_pool.Push(wrapped))
+      wrapped();
+  }
+
+private:
+  base::TaskLoop & m_pool;
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  size_t m_numPending = 0;
+};
 }  //  namespace
 
 // FeaturesLoaderGuard ---------------------------------------------------------------------
@@ -151,22 +222,43 @@ WARN_UNUSED_RESULT bool FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint32_t
 // DataSource ----------------------------------------------------------------------------------
 unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const & localFile) const
 {
-  MwmValue value(localFile);
-
-  feature::DataHeader const & h = value.GetHeader();
-  if (!h.IsMWMSuitable())
-    return nullptr;
+  // Maps in resources may be unreachable by a file path, they aren't cached.
+  string const path = localFile.GetPath(MapOptions::Map);
+  uint64_t fileSize = 0;
+  uint64_t modificationTime = 0;
+  bool const isCacheable =
+      m_infoCache &&
+      Platform::GetFileSizeAndModificationTime(path, fileSize, modificationTime);
+
+  MwmInfoCache::Entry entry;
+  if (!isCacheable || !m_infoCache->Find(path, fileSize, modificationTime, entry))
+  {
+    MwmValue value(localFile);
+
+    feature::DataHeader const & h = value.GetHeader();
+    if (!h.IsMWMSuitable())
+      return nullptr;
+
+    entry.m_fileSize = fileSize;
+    entry.m_modificationTime = modificationTime;
+    entry.m_bordersRect = h.GetBounds();
+    pair<int, int> const scaleR = h.GetScaleRange();
+    entry.m_minScale = static_cast<uint8_t>(scaleR.first);
+    entry.m_maxScale = static_cast<uint8_t>(scaleR.second);
+    entry.m_version = value.GetMwmVersion();
+    // Copying to drop the const qualifier.
+    entry.m_data = feature::RegionData(value.GetRegionData());
+
+    if (isCacheable)
+      m_infoCache->Add(path, entry);
+  }
 
   auto info = make_unique<MwmInfoEx>();
-  info->m_bordersRect = h.GetBounds();
-
-  pair<int, int> const scaleR = h.GetScaleRange();
-  info->m_minScale = static_cast<uint8_t>(scaleR.first);
-  info->m_maxScale = static_cast<uint8_t>(scaleR.second);
-  info->m_version = value.GetMwmVersion();
-  // Copying to drop the const qualifier.
-  feature::RegionData regionData(value.GetRegionData());
-  info->m_data = regionData;
+  info->m_bordersRect = entry.m_bordersRect;
+  info->m_minScale = entry.m_minScale;
+  info->m_maxScale = entry.m_maxScale;
+  info->m_version = entry.m_version;
+  info->m_data = move(entry.m_data);
 
   return unique_ptr<MwmInfo>(move(info));
 }
@@ -267,6 +359,97 @@ void DataSource::ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const
   }
 }
 
+void DataSource::ForEachInRectParallel(FeatureCallback const & f, m2::RectD const & rect,
+                                       int scale, base::TaskLoop & pool,
+                                       base::Cancellable const & cancellable) const
+{
+  vector<shared_ptr<MwmInfo>> mwms;
+  GetMwmsInfo(mwms);
+
+  covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
+  // Waits for the tasks before |cov| and |mwms| are destroyed.
+  TasksWaiter waiter(pool);
+
+  for (shared_ptr<MwmInfo> const & info : mwms)
+  {
+    if (cancellable.IsCancelled())
+      break;
+
+    if (info->m_minScale > scale || scale > info->m_maxScale ||
+        !rect.IsIntersect(info->m_bordersRect))
+    {
+      continue;
+    }
+
+    MwmId const mwmId(info);
+    // Non-thread-safe readers of a handle must not be shared by tasks, so the handle is
+    // released and every task takes its own one.
+    auto intervals = make_shared<covering::Intervals>();
+    int mwmScale = scale;
+    bool useBits = false;
+    shared_ptr<ConcurrentUniqueIndexes> unique;
+    {
+      MwmHandle const handle = GetMwmHandleById(mwmId);
+      if (auto const * value = handle.GetValue<MwmValue>())
+      {
+        auto const & header = value->GetHeader();
+        // See ReadMWMFunctor for the scales of covering and of the scale index.
+        auto const lastScale = header.GetLastScale();
+        mwmScale = min(scale, lastScale);
+        *intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
+        useBits = header.GetFormat() >= version::Format::v5;
+        if (useBits && value->m_table && intervals->size() > 1)
+          unique = make_shared<ConcurrentUniqueIndexes>(value->m_table->size());
+      }
+    }
+
+    auto const readIntervals = [this, &f, &cancellable, mwmId, intervals, mwmScale, useBits,
+                                unique](size_t begin, size_t end) {
+      if (cancellable.IsCancelled())
+        return;
+
+      MwmHandle const handle = GetMwmHandleById(mwmId);
+      auto const * value = handle.GetValue<MwmValue>();
+      if (!value)
+        return;
+
+      auto src = (*m_factory)(handle);
+      auto const & index = value->GetScaleIndex();
+      CheckUniqueIndexes checkUnique(useBits);
+      index.ForEachInIntervalsAndScale(
+          intervals->begin() + begin, intervals->begin() + end, mwmScale,
+          [&](uint32_t featureIndex) {
+            if (cancellable.IsCancelled())
+              return;
+            if (unique ? !(*unique)(featureIndex) : !checkUnique(featureIndex))
+              return;
+            ReadFeatureType(f, *src, featureIndex);
+          });
+    };
+
+    size_t const numTasks = unique ? min(intervals->size(), kMaxTasksPerMwm)
+                                   : min<size_t>(intervals->size(), 1);
+    for (size_t i = 0; i < numTasks; ++i)
+    {
+      size_t const begin = intervals->size() * i / numTasks;
+      size_t const end = intervals->size() * (i + 1) / numTasks;
+      waiter.Push([readIntervals, begin, end]() { readIntervals(begin, end); });
+    }
+
+    // Touched (created, edited) features reading.
+    waiter.Push([this, &f, &cancellable, &rect, mwmId, mwmScale]() {
+      if (cancellable.IsCancelled())
+        return;
+
+      MwmHandle const handle = GetMwmHandleById(mwmId);
+      auto src = (*m_factory)(handle);
+      src->ForEachAdditionalFeature(rect, mwmScale, [&](uint32_t i) {
+        ReadFeatureType(f, *src, i);
+      });
+    });
+  }
+}
+
 void DataSource::ReadFeatures(FeatureCallback const & fn, vector<FeatureID> const & features) const
 {
   ASSERT(is_sorted(features.begin(), features.end()), ());
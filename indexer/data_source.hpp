@@ -6,13 +6,16 @@
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/mwm_info_cache.hpp"
 #include "indexer/mwm_set.hpp"
 #include "indexer/scale_index.hpp"
 #include "indexer/unique_index.hpp"
 
 #include "coding/file_container.hpp"
 
+#include "base/cancellable.hpp"
 #include "base/macros.hpp"
+#include "base/task_loop.hpp"
 
 #include <cstdint>
 #include <functional>
@@ -33,6 +36,10 @@ public:
   /// Registers a new map.
   std::pair<MwmId, RegResult> RegisterMap(platform::LocalCountryFile const & localFile);
 
+  /// Maps attributes are taken from |cache| on registration when it's possible and are added
+  /// to it otherwise. Must be set before registration of maps.
+  void SetInfoCache(std::shared_ptr<MwmInfoCache> const & cache) { m_infoCache = cache; }
+
   /// Deregisters a map from internal records.
   ///
   /// \param countryFile A countryFile denoting a map to be deregistered.
@@ -45,6 +52,13 @@ public:
   void ForEachInScale(FeatureCallback const & f, int scale) const;
   void ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const & rect, int scale,
                            MwmId const & id) const;
+  // Same as ForEachInRect() but mwms and ranges of covering intervals of every mwm are read by
+  // separate tasks of |pool|, so |f| is called concurrently from its threads and in no
+  // particular order. Every task reads features with its own mwm handle and FeatureType
+  // instances. Blocks until all the tasks are done, so it must not be called from
+  // threads of |pool|. Pending tasks skip reading when |cancellable| is cancelled.
+  void ForEachInRectParallel(FeatureCallback const & f, m2::RectD const & rect, int scale,
+                             base::TaskLoop & pool, base::Cancellable const & cancellable) const;
   // "features" must be sorted using FeatureID::operator< as predicate.
   void ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID> const & features) const;
 
@@ -70,6 +84,7 @@ private:
   friend class FeaturesLoaderGuard;
 
   std::unique_ptr<FeatureSourceFactory> m_factory;
+  std::shared_ptr<MwmInfoCache> m_infoCache;
 };
 
 // DataSource which operates with features from mwm file and does not support features creation
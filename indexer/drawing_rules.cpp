@@ -115,7 +115,8 @@ void BaseRule::SetSelector(unique_ptr<ISelector> && selector)
 }
 
 RulesHolder::RulesHolder()
-  : m_bgColors(scales::UPPER_STYLE_SCALE+1, DEFAULT_BG_COLOR)
+  : m_rules(scales::UPPER_STYLE_SCALE+1)
+  , m_bgColors(scales::UPPER_STYLE_SCALE+1, DEFAULT_BG_COLOR)
 {}
 
 RulesHolder::~RulesHolder()
@@ -133,7 +134,11 @@ void RulesHolder::Clean()
     v.clear();
   }
 
-  m_rules.clear();
+  for (auto & rules : m_rules)
+  {
+    for (auto & v : rules)
+      v.clear();
+  }
   m_colors.clear();
 }
 
@@ -155,10 +160,10 @@ Key RulesHolder::AddRule(int scale, rule_type_t type, BaseRule * p)
 
 BaseRule const * RulesHolder::Find(Key const & k) const
 {
-  RulesMap::const_iterator i = m_rules.find(k.m_scale);
-  if (i == m_rules.end()) return 0;
+  if (k.m_scale < 0 || static_cast<size_t>(k.m_scale) >= m_rules.size())
+    return 0;
 
-  vector<uint32_t> const & v = (i->second)[k.m_type];
+  vector<uint32_t> const & v = m_rules[k.m_scale][k.m_type];
 
   ASSERT ( k.m_index >= 0, (k.m_index) );
   if (static_cast<size_t>(k.m_index) < v.size())
@@ -526,6 +531,7 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
   CHECK ( doSet.m_cont.ParseFromString(s), ("Error in proto loading!") );
 
   classif().GetMutableRoot()->ForEachObject(ref(doSet));
+  classif().CompileDrawRules();
 
   InitBackgroundColors(doSet.m_cont);
   InitColors(doSet.m_cont);
@@ -72,8 +72,9 @@ namespace drule
     using RuleVec = std::vector<BaseRule*>;
     std::array<RuleVec, count_of_rules> m_container;
 
-    /// scale -> array of rules by type -> index of rule in m_container
-    using RulesMap = std::map<int32_t, std::array<std::vector<uint32_t>, count_of_rules>>;
+    /// scale -> array of rules by type -> index of rule in m_container,
+    /// the scales are [0...scales::UPPER_STYLE_SCALE]
+    using RulesMap = std::vector<std::array<std::vector<uint32_t>, count_of_rules>>;
     RulesMap m_rules;
 
     /// background color for scales in range [0...scales::UPPER_STYLE_SCALE]
@@ -106,15 +107,15 @@ namespace drule
 
     template <class ToDo> void ForEachRule(ToDo toDo)
     {
-      for (RulesMap::const_iterator i = m_rules.begin(); i != m_rules.end(); ++i)
+      for (size_t i = 0; i < m_rules.size(); ++i)
       {
         for (int j = 0; j < count_of_rules; ++j)
         {
-          std::vector<uint32_t> const & v = i->second[j];
+          std::vector<uint32_t> const & v = m_rules[i][j];
           for (size_t k = 0; k < v.size(); ++k)
           {
             // scale, type, rule
-            toDo(i->first, j, v[k], m_container[j][v[k]]);
+            toDo(static_cast<int>(i), j, v[k], m_container[j][v[k]]);
           }
         }
       }
@@ -109,7 +109,8 @@ uint32_t TagSelectorToType(string value)
 class TypeSelector : public ISelector
 {
 public:
-  TypeSelector(uint32_t type, SelectorOperatorType op) : m_type(type)
+  TypeSelector(uint32_t type, SelectorOperatorType op)
+    : m_type(type), m_level(ftype::GetLevel(type))
   {
     m_equals = op == SelectorOperatorEqual;
   }
@@ -119,7 +120,7 @@ public:
     bool found = false;
     ft.ForEachType([&found, this](uint32_t type)
     {
-      ftype::TruncValue(type, ftype::GetLevel(m_type));
+      ftype::TruncValue(type, m_level);
       if (type == m_type)
         found = true;
     });
@@ -128,6 +129,7 @@ public:
 
 private:
   uint32_t m_type;
+  uint8_t m_level;
   bool m_equals;
 };
 
@@ -163,7 +165,7 @@ bool GetRating(FeatureType & ft, double & rating)
 {
   double constexpr kDefaultRating = 0.0;
 
-  string ratingStr = ft.GetMetadata().Get(feature::Metadata::FMD_RATING);
+  string ratingStr = ft.GetMetadataValue(feature::Metadata::FMD_RATING);
   if (ratingStr.empty() || !strings::to_double(ratingStr, rating))
     rating = kDefaultRating;
   return true;
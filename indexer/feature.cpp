@@ -189,8 +189,10 @@ void FeatureType::Deserialize(SharedLoadInfo const * loadInfo, Buffer buffer)
 
   m_offsets.Reset();
   m_ptsSimpMask = 0;
+  m_bestPoints.clear();
   m_limitRect = m2::RectD::GetEmptyRect();
   m_parsed.Reset();
+  m_isBestGeometry = false;
   m_innerStats.MakeZero();
 }
 
@@ -256,7 +258,10 @@ void FeatureType::ParseCommon()
 
   ArrayByteSource source(m_data + m_offsets.m_common);
   uint8_t const h = Header(m_data);
-  m_params.Read(source, h);
+  // Names go first and are parsed on demand in ParseNames().
+  if (h & HEADER_HAS_NAME)
+    source.Advance(ReadVarUint<uint32_t>(source) + 1);
+  m_params.Read(source, static_cast<uint8_t>(h & ~HEADER_HAS_NAME));
 
   if (GetFeatureType() == GEOM_POINT)
   {
@@ -268,6 +273,21 @@ void FeatureType::ParseCommon()
   m_parsed.m_common = true;
 }
 
+void FeatureType::ParseNames()
+{
+  if (m_parsed.m_names)
+    return;
+
+  ParseTypes();
+
+  if (HasName())
+  {
+    ArrayByteSource source(m_data + m_offsets.m_common);
+    m_params.name.Read(source);
+  }
+  m_parsed.m_names = true;
+}
+
 m2::PointD FeatureType::GetCenter()
 {
   ASSERT_EQUAL(GetFeatureType(), feature::GEOM_POINT, ());
@@ -294,6 +314,7 @@ void FeatureType::ReplaceBy(osm::EditableMapObject const & emo)
     m_limitRect.MakeEmpty();
     m_limitRect.Add(m_center);
     m_parsed.m_points = m_parsed.m_triangles = true;
+    m_isBestGeometry = true;
     geoType = feature::GEOM_POINT;
   }
   else
@@ -307,7 +328,7 @@ void FeatureType::ReplaceBy(osm::EditableMapObject const & emo)
     m_params.house.Clear();
   else
     m_params.house.Set(house);
-  m_parsed.m_common = true;
+  m_parsed.m_common = m_parsed.m_names = true;
 
   m_metadata = emo.GetMetadata();
   m_parsed.m_metadata = true;
@@ -415,6 +436,7 @@ void FeatureType::ResetGeometry()
   m_offsets.m_pts.clear();
   m_offsets.m_trg.clear();
   m_ptsSimpMask = 0;
+  m_isBestGeometry = false;
 }
 
 uint32_t FeatureType::ParseGeometry(int scale)
@@ -425,6 +447,8 @@ uint32_t FeatureType::ParseGeometry(int scale)
     CHECK(m_loadInfo, ());
     ParseHeader2();
 
+    // Points of other geometry types don't depend on the scale.
+    m_isBestGeometry = true;
     if ((Header(m_data) & HEADER_GEOTYPE_MASK) == HEADER_GEOM_LINE)
     {
       size_t const count = m_points.size();
@@ -434,14 +458,24 @@ uint32_t FeatureType::ParseGeometry(int scale)
 
         // outer geometry
         int const ind = GetScaleIndex(*m_loadInfo, scale, m_offsets.m_pts);
-        if (ind != -1)
+        m_isBestGeometry =
+            ind == GetScaleIndex(*m_loadInfo, FeatureType::BEST_GEOMETRY, m_offsets.m_pts);
+        if (ind != -1 &&
+            m_loadInfo->GetGeometryLayout() == DataHeader::GeometryLayout::Progressive)
+        {
+          sz = ParseProgressiveGeometry(ind);
+        }
+        else if (ind != -1)
         {
           ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(ind));
           src.Skip(m_offsets.m_pts[ind]);
 
           serial::GeometryCodingParams cp = m_loadInfo->GetGeometryCodingParams(ind);
           cp.SetBasePoint(m_points[0]);
-          serial::LoadOuterPath(src, cp, m_points);
+          if (m_loadInfo->GetGeometryLayout() == DataHeader::GeometryLayout::FixedWidth)
+            serial::LoadOuterFixedWidth(src, cp, m_points);
+          else
+            serial::LoadOuterPath(src, cp, m_points);
 
           sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[ind]);
         }
@@ -455,6 +489,8 @@ uint32_t FeatureType::ParseGeometry(int scale)
 
         int const scaleIndex = GetScaleIndex(*m_loadInfo, scale);
         ASSERT_LESS(scaleIndex, m_loadInfo->GetScalesCount(), ());
+        m_isBestGeometry =
+            scaleIndex == GetScaleIndex(*m_loadInfo, FeatureType::BEST_GEOMETRY);
 
         points.emplace_back(m_points.front());
         for (size_t i = 1; i + 1 < count; ++i)
@@ -475,6 +511,39 @@ uint32_t FeatureType::ParseGeometry(int scale)
   return sz;
 }
 
+uint32_t FeatureType::ParseProgressiveGeometry(int scaleIndex)
+{
+  ASSERT_EQUAL(m_points.size(), 1, ());
+
+  uint32_t sz = 0;
+  if (m_bestPoints.empty())
+  {
+    int const bestIndex =
+        GetScaleIndex(*m_loadInfo, FeatureType::BEST_GEOMETRY, m_offsets.m_pts);
+    ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(bestIndex));
+    src.Skip(m_offsets.m_pts[bestIndex]);
+
+    serial::GeometryCodingParams cp = m_loadInfo->GetGeometryCodingParams(bestIndex);
+    cp.SetBasePoint(m_points[0]);
+    m_bestPoints.push_back(m_points[0]);
+    serial::LoadOuterPath(src, cp, m_bestPoints);
+
+    sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[bestIndex]);
+  }
+
+  // The best path is the only one which is saved with points.
+  if (scaleIndex == GetScaleIndex(*m_loadInfo, FeatureType::BEST_GEOMETRY, m_offsets.m_pts))
+  {
+    m_points.assign(m_bestPoints.begin(), m_bestPoints.end());
+    return sz;
+  }
+
+  ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(scaleIndex));
+  src.Skip(m_offsets.m_pts[scaleIndex]);
+  serial::LoadOuterPathByIndexes(src, m_bestPoints, m_points);
+  return sz + static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[scaleIndex]);
+}
+
 uint32_t FeatureType::ParseTriangles(int scale)
 {
   uint32_t sz = 0;
@@ -492,7 +561,11 @@ uint32_t FeatureType::ParseTriangles(int scale)
         {
           ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetTrianglesReader(ind));
           src.Skip(m_offsets.m_trg[ind]);
-          serial::LoadOuterTriangles(src, m_loadInfo->GetGeometryCodingParams(ind), m_triangles);
+          auto const cp = m_loadInfo->GetGeometryCodingParams(ind);
+          if (m_loadInfo->GetGeometryLayout() == DataHeader::GeometryLayout::FixedWidth)
+            serial::LoadOuterTrianglesFixedWidth(src, cp, m_triangles);
+          else
+            serial::LoadOuterTriangles(src, cp, m_triangles);
 
           sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_trg[ind]);
         }
@@ -505,32 +578,42 @@ uint32_t FeatureType::ParseTriangles(int scale)
   return sz;
 }
 
+bool FeatureType::GetMetadataOffset(uint32_t & offset) const
+{
+  CHECK(m_loadInfo, ());
+  struct TMetadataIndexEntry
+  {
+    uint32_t key;
+    uint32_t value;
+  };
+  DDVector<TMetadataIndexEntry, FilesContainerR::TReader> idx(
+      m_loadInfo->GetMetadataIndexReader());
+
+  auto it = lower_bound(idx.begin(), idx.end(),
+                        TMetadataIndexEntry{static_cast<uint32_t>(m_id.m_index), 0},
+                        [](TMetadataIndexEntry const & v1, TMetadataIndexEntry const & v2) {
+                          return v1.key < v2.key;
+                        });
+
+  if (it == idx.end() || m_id.m_index != it->key)
+    return false;
+
+  offset = it->value;
+  return true;
+}
+
 void FeatureType::ParseMetadata()
 {
   if (m_parsed.m_metadata)
     return;
 
-  CHECK(m_loadInfo, ());
   try
   {
-    struct TMetadataIndexEntry
-    {
-      uint32_t key;
-      uint32_t value;
-    };
-    DDVector<TMetadataIndexEntry, FilesContainerR::TReader> idx(
-        m_loadInfo->GetMetadataIndexReader());
-
-    auto it = lower_bound(idx.begin(), idx.end(),
-                          TMetadataIndexEntry{static_cast<uint32_t>(m_id.m_index), 0},
-                          [](TMetadataIndexEntry const & v1, TMetadataIndexEntry const & v2) {
-                            return v1.key < v2.key;
-                          });
-
-    if (it != idx.end() && m_id.m_index == it->key)
+    uint32_t offset;
+    if (GetMetadataOffset(offset))
     {
       ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetMetadataReader());
-      src.Skip(it->value);
+      src.Skip(offset);
       if (m_loadInfo->GetMWMFormat() >= version::Format::v8)
         m_metadata.Deserialize(src);
       else
@@ -545,14 +628,38 @@ void FeatureType::ParseMetadata()
   m_parsed.m_metadata = true;
 }
 
+string FeatureType::GetMetadataValue(feature::Metadata::EType type)
+{
+  if (m_parsed.m_metadata || m_loadInfo->GetMWMFormat() < version::Format::v8)
+    return GetMetadata().Get(type);
+
+  string value;
+  try
+  {
+    uint32_t offset;
+    if (GetMetadataOffset(offset))
+    {
+      ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetMetadataReader());
+      src.Skip(offset);
+      feature::Metadata::DeserializeValue(src, type, value);
+    }
+  }
+  catch (Reader::OpenException const &)
+  {
+    // now ignore exception because not all mwm have needed sections
+  }
+  return value;
+}
+
 StringUtf8Multilang const & FeatureType::GetNames()
 {
-  ParseCommon();
+  ParseNames();
   return m_params.name;
 }
 
 void FeatureType::SetNames(StringUtf8Multilang const & newNames)
 {
+  m_parsed.m_names = true;
   m_params.name.Clear();
   // Validate passed string to clean up empty names (if any).
   newNames.ForEach([this](int8_t langCode, string const & name) {
@@ -586,7 +693,7 @@ void FeatureType::UpdateHeader(bool commonParsed, bool metadataParsed)
   m_parsed.m_header2 = true;
   m_parsed.m_types = true;
 
-  m_parsed.m_common = commonParsed;
+  m_parsed.m_common = m_parsed.m_names = commonParsed;
   m_parsed.m_metadata = metadataParsed;
 }
 
@@ -632,6 +739,7 @@ namespace
 string FeatureType::DebugString(int scale)
 {
   ParseCommon();
+  ParseNames();
 
   Classificator const & c = classif();
 
@@ -745,7 +853,7 @@ void FeatureType::GetPreferredNames(string & primary, string & secondary)
   if (!mwmInfo)
     return;
 
-  ParseCommon();
+  ParseNames();
 
   auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
   ::GetPreferredNames(mwmInfo->GetRegionData(), GetNames(), deviceLang, false /* allowTranslit */,
@@ -763,7 +871,7 @@ void FeatureType::GetPreferredNames(bool allowTranslit, int8_t deviceLang, strin
   if (!mwmInfo)
     return;
 
-  ParseCommon();
+  ParseNames();
 
   ::GetPreferredNames(mwmInfo->GetRegionData(), GetNames(), deviceLang, allowTranslit,
                       primary, secondary);
@@ -779,7 +887,7 @@ void FeatureType::GetReadableName(string & name)
   if (!mwmInfo)
     return;
 
-  ParseCommon();
+  ParseNames();
 
   auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
   ::GetReadableName(mwmInfo->GetRegionData(), GetNames(), deviceLang, false /* allowTranslit */,
@@ -796,7 +904,7 @@ void FeatureType::GetReadableName(bool allowTranslit, int8_t deviceLang, string
   if (!mwmInfo)
     return;
 
-  ParseCommon();
+  ParseNames();
 
   ::GetReadableName(mwmInfo->GetRegionData(), GetNames(), deviceLang, allowTranslit, name);
 }
@@ -820,7 +928,7 @@ bool FeatureType::GetName(int8_t lang, string & name)
   if (!HasName())
     return false;
 
-  ParseCommon();
+  ParseNames();
   return m_params.name.GetString(lang, name);
 }
 
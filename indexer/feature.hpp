@@ -51,7 +51,7 @@ public:
     if (!HasName())
       return false;
 
-    ParseCommon();
+    ParseNames();
     m_params.name.ForEach(std::forward<T>(fn));
     return true;
   }
@@ -99,6 +99,9 @@ public:
 
   void ResetGeometry();
   uint32_t ParseGeometry(int scale);
+  /// Returns true if the parsed points are the same as the ones of BEST_GEOMETRY,
+  /// so they may be used as the best geometry without resetting and parsing again.
+  bool IsBestGeometryParsed() const { return m_parsed.m_points && m_isBestGeometry; }
   uint32_t ParseTriangles(int scale);
   //@}
 
@@ -180,6 +183,8 @@ public:
   std::string GetRoadNumber();
 
   feature::Metadata & GetMetadata();
+  /// Reads one metadata value without decoding the whole metadata when it's not parsed yet.
+  std::string GetMetadataValue(feature::Metadata::EType type);
 
   /// @name Statistic functions.
   //@{
@@ -213,12 +218,16 @@ private:
   {
     bool m_types = false;
     bool m_common = false;
+    bool m_names = false;
     bool m_header2 = false;
     bool m_points = false;
     bool m_triangles = false;
     bool m_metadata = false;
 
-    void Reset() { m_types = m_common = m_header2 = m_points = m_triangles = m_metadata = false; }
+    void Reset()
+    {
+      m_types = m_common = m_names = m_header2 = m_points = m_triangles = m_metadata = false;
+    }
   };
 
   struct Offsets
@@ -237,10 +246,17 @@ private:
   };
 
   void ParseTypes();
+  /// Parses everything from the common part but names.
   void ParseCommon();
+  void ParseNames();
   void ParseHeader2();
   void ParseMetadata();
+  /// @returns false if the feature has no metadata.
+  bool GetMetadataOffset(uint32_t & offset) const;
   void ParseGeometryAndTriangles(int scale);
+  /// Loads the outer path of |scaleIndex| in the progressive layout.
+  /// @returns the number of the read bytes.
+  uint32_t ParseProgressiveGeometry(int scaleIndex);
 
   uint8_t m_header = 0;
   std::array<uint32_t, feature::kMaxTypesCount> m_types;
@@ -256,6 +272,9 @@ private:
   static const size_t kStaticBufferSize = 32;
   using Points = buffer_vector<m2::PointD, kStaticBufferSize>;
   Points m_points, m_triangles;
+  /// The best outer path of the progressive layout. It isn't reset by ResetGeometry(),
+  /// so paths of other scales are selected from it without decoding.
+  std::vector<m2::PointD> m_bestPoints;
   feature::Metadata m_metadata;
 
   // Non-owning pointer to shared load info. SharedLoadInfo created once per FeaturesVector.
@@ -266,6 +285,7 @@ private:
   ParsedFlags m_parsed;
   Offsets m_offsets;
   uint32_t m_ptsSimpMask = 0;
+  bool m_isBestGeometry = false;
 
   InnerGeomStat m_innerStats;
 };
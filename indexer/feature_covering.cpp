@@ -5,6 +5,11 @@
 
 #include "geometry/covering_utils.hpp"
 
+#include "base/assert.hpp"
+
+#include <sstream>
+#include <tuple>
+
 using namespace std;
 
 namespace
@@ -204,4 +209,115 @@ Intervals SortAndMergeIntervals(Intervals const & v)
   SortAndMergeIntervals(v, res);
   return res;
 }
+
+// CoveringCache::Key ------------------------------------------------------------------------------
+bool CoveringCache::Key::operator<(Key const & rhs) const
+{
+  return make_tuple(m_rect.minX(), m_rect.minY(), m_rect.maxX(), m_rect.maxY(), m_depthLevels,
+                    m_cellDepth) < make_tuple(rhs.m_rect.minX(), rhs.m_rect.minY(),
+                                              rhs.m_rect.maxX(), rhs.m_rect.maxY(),
+                                              rhs.m_depthLevels, rhs.m_cellDepth);
+}
+
+// CoveringCache -----------------------------------------------------------------------------------
+size_t constexpr CoveringCache::kDefaultMaxSizeBytes;
+
+CoveringCache::CoveringCache(size_t maxSizeBytes) : m_maxSizeBytes(maxSizeBytes) {}
+
+// static
+CoveringCache & CoveringCache::Instance()
+{
+  static CoveringCache cache;
+  return cache;
+}
+
+shared_ptr<Intervals const> CoveringCache::Get(Key const & key)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return {};
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void CoveringCache::Put(Key const & key, shared_ptr<Intervals const> intervals)
+{
+  CHECK(intervals, ());
+  size_t const sizeBytes = GetSizeBytes(*intervals);
+  if (sizeBytes > m_maxSizeBytes)
+    return;
+
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it->second);
+
+  while (!m_entries.empty() && m_sizeBytes + sizeBytes > m_maxSizeBytes)
+  {
+    Erase(prev(m_entries.end()));
+    ++m_stats.m_evictions;
+  }
+
+  m_entries.emplace_front(key, move(intervals));
+  m_index.emplace(key, m_entries.begin());
+  m_sizeBytes += sizeBytes;
+}
+
+void CoveringCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+  m_sizeBytes = 0;
+}
+
+CoveringCache::Stats CoveringCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+
+size_t CoveringCache::GetSizeBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_sizeBytes;
+}
+
+size_t CoveringCache::GetNumEntries() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+// static
+size_t CoveringCache::GetSizeBytes(Intervals const & intervals)
+{
+  return sizeof(Key) + sizeof(Intervals) + intervals.size() * sizeof(Interval);
+}
+
+void CoveringCache::Erase(Entries::iterator it)
+{
+  size_t const sizeBytes = GetSizeBytes(*it->second);
+  ASSERT_GREATER_OR_EQUAL(m_sizeBytes, sizeBytes, ());
+  m_sizeBytes -= sizeBytes;
+  m_index.erase(it->first);
+  m_entries.erase(it);
+}
+
+string DebugPrint(CoveringCache::Stats const & stats)
+{
+  ostringstream os;
+  os << "CoveringCache::Stats [";
+  os << "hits: " << stats.m_hits << ", ";
+  os << "misses: " << stats.m_misses << ", ";
+  os << "evictions: " << stats.m_evictions;
+  os << "]";
+  return os.str();
+}
 }
@@ -9,9 +9,16 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/logging.hpp"
+#include "base/macros.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -88,6 +95,70 @@ void CoverViewportAndAppendLowerLevels(m2::RectD const & r, int cellDepth, Inter
   SortAndMergeIntervals(intervals, res);
 }
 
+// Thread-safe LRU cache of the results of CoverViewportAndAppendLowerLevels(). The same rects
+// (map tiles, search viewports) are read again and again, so their coverings are computed once.
+// Rects are keyed by the exact coordinates: the covering of a slightly moved rect may differ
+// even if the rect is within the same cells.
+class CoveringCache
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    m2::RectD m_rect;
+    int m_depthLevels = 0;
+    int m_cellDepth = 0;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  static size_t constexpr kDefaultMaxSizeBytes = 4 * 1024 * 1024;
+
+  explicit CoveringCache(size_t maxSizeBytes = kDefaultMaxSizeBytes);
+
+  // The cache which is used by CoveringGetter.
+  static CoveringCache & Instance();
+
+  // Returns the intervals cached for |key| or nullptr if there is no entry for |key|.
+  std::shared_ptr<Intervals const> Get(Key const & key);
+
+  // Evicts least recently used entries if the cache exceeds the size limit. Intervals
+  // larger than the limit aren't cached.
+  void Put(Key const & key, std::shared_ptr<Intervals const> intervals);
+
+  void Clear();
+
+  Stats GetStats() const;
+  size_t GetSizeBytes() const;
+  size_t GetNumEntries() const;
+
+private:
+  // Most recently used entries are at the front.
+  using Entries = std::list<std::pair<Key, std::shared_ptr<Intervals const>>>;
+
+  static size_t GetSizeBytes(Intervals const & intervals);
+
+  void Erase(Entries::iterator it);
+
+  size_t const m_maxSizeBytes;
+
+  mutable std::mutex m_mutex;
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  size_t m_sizeBytes = 0;
+  Stats m_stats;
+
+  DISALLOW_COPY_AND_MOVE(CoveringCache);
+};
+
+std::string DebugPrint(CoveringCache::Stats const & stats);
+
 enum CoveringMode
 {
   ViewportWithLowLevels = 0,
@@ -119,8 +190,22 @@ public:
       switch (m_mode)
       {
       case ViewportWithLowLevels:
+      {
+        auto & cache = CoveringCache::Instance();
+        CoveringCache::Key key;
+        key.m_rect = m_rect;
+        key.m_depthLevels = DEPTH_LEVELS;
+        key.m_cellDepth = cellDepth;
+        if (auto const intervals = cache.Get(key))
+        {
+          m_res[ind] = *intervals;
+          break;
+        }
+
         CoverViewportAndAppendLowerLevels<DEPTH_LEVELS>(m_rect, cellDepth, m_res[ind]);
+        cache.Put(key, std::make_shared<Intervals const>(m_res[ind]));
         break;
+      }
 
       case LowLevelsOnly:
       {
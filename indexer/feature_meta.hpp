@@ -4,8 +4,8 @@
 #include "coding/reader.hpp"
 
 #include <algorithm>
-#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -17,11 +17,11 @@ protected:
   // TODO: Change uint8_t to appropriate type when FMD_COUNT reaches 256.
   void Set(uint8_t type, std::string const & value)
   {
-    auto found = m_metadata.find(type);
-    if (found == m_metadata.end())
+    auto found = Find(type);
+    if (found == m_metadata.end() || found->first != type)
     {
       if (!value.empty())
-        m_metadata[type] = value;
+        m_metadata.emplace(found, type, value);
     }
     else
     {
@@ -35,14 +35,14 @@ protected:
 public:
   bool Has(uint8_t type) const
   {
-    auto const it = m_metadata.find(type);
-    return it != m_metadata.end();
+    auto const it = Find(type);
+    return it != m_metadata.end() && it->first == type;
   }
 
   std::string Get(uint8_t type) const
   {
-    auto const it = m_metadata.find(type);
-    return (it == m_metadata.end()) ? std::string() : it->second;
+    auto const it = Find(type);
+    return (it == m_metadata.end() || it->first != type) ? std::string() : it->second;
   }
 
   std::vector<uint8_t> GetPresentTypes() const
@@ -75,20 +75,70 @@ public:
   void Deserialize(TSource & src)
   {
     auto const sz = ReadVarUint<uint32_t>(src);
+    m_metadata.reserve(m_metadata.size() + sz);
     for (size_t i = 0; i < sz; ++i)
     {
       auto const key = ReadVarUint<uint32_t>(src);
-      utils::ReadString(src, m_metadata[key]);
+      utils::ReadString(src, FindOrInsert(static_cast<uint8_t>(key)));
     }
   }
 
+  /// Reads the value of |type| from the serialized metadata skipping all other values.
+  /// |src| is left in the middle of the metadata.
+  /// @returns false if there is no such value.
+  template <class TSource>
+  static bool DeserializeValue(TSource & src, uint8_t type, std::string & value)
+  {
+    auto const sz = ReadVarUint<uint32_t>(src);
+    for (size_t i = 0; i < sz; ++i)
+    {
+      auto const key = ReadVarUint<uint32_t>(src);
+      // Keys are serialized in the ascending order.
+      if (key > type)
+        return false;
+
+      if (key == type)
+      {
+        utils::ReadString(src, value);
+        return true;
+      }
+
+      src.Skip(ReadVarUint<uint32_t>(src) + 1);
+    }
+    return false;
+  }
+
   inline bool Equals(MetadataBase const & other) const
   {
     return m_metadata == other.m_metadata;
   }
 
 protected:
-  std::map<uint8_t, std::string> m_metadata;
+  using Entry = std::pair<uint8_t, std::string>;
+  using Entries = std::vector<Entry>;
+
+  Entries::iterator Find(uint8_t type)
+  {
+    return std::lower_bound(m_metadata.begin(), m_metadata.end(), type, LessByType);
+  }
+
+  Entries::const_iterator Find(uint8_t type) const
+  {
+    return std::lower_bound(m_metadata.begin(), m_metadata.end(), type, LessByType);
+  }
+
+  std::string & FindOrInsert(uint8_t type)
+  {
+    auto it = Find(type);
+    if (it == m_metadata.end() || it->first != type)
+      it = m_metadata.emplace(it, type, std::string());
+    return it->second;
+  }
+
+  static bool LessByType(Entry const & entry, uint8_t type) { return entry.first < type; }
+
+  // A few values per feature, sorted by type. It's cheaper than std::map both to fill and to copy.
+  Entries m_metadata;
 };
 
 class Metadata : public MetadataBase
@@ -165,7 +215,7 @@ public:
     {
       src.Read(header, sizeof(header));
       src.Read(buffer, header[1]);
-      m_metadata[header[0] & 0x7F].assign(buffer, header[1]);
+      FindOrInsert(header[0] & 0x7F).assign(buffer, header[1]);
     } while (!(header[0] & 0x80));
   }
 
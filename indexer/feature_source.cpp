@@ -21,7 +21,8 @@ FeatureSource::FeatureSource(MwmSet::MwmHandle const & handle) : m_handle(handle
     return;
 
   auto const & value = *m_handle.GetValue<MwmValue>();
-  m_vector = make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get());
+  m_vector = make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get(),
+                                         &value.m_featuresData);
 }
 
 size_t FeatureSource::GetNumFeatures() const
@@ -38,11 +38,7 @@ void GetMwmLangName(feature::RegionData const & regionData, StringUtf8Multilang
   vector<int8_t> mwmLangCodes;
   regionData.GetLanguages(mwmLangCodes);
 
-  for (auto const code : mwmLangCodes)
-  {
-    if (src.GetString(code, out))
-      return;
-  }
+  src.GetBestString(mwmLangCodes, out);
 }
 
 bool GetTransliteratedName(feature::RegionData const & regionData, StringUtf8Multilang const & src, string & out)
@@ -64,36 +60,15 @@ bool GetTransliteratedName(feature::RegionData const & regionData, StringUtf8Mul
 
 bool GetBestName(StringUtf8Multilang const & src, vector<int8_t> const & priorityList, string & out)
 {
-  auto bestIndex = priorityList.size();
-
-  auto const findAndSet = [](vector<int8_t> const & langs, int8_t const code, string const & name,
-                             size_t & bestIndex, string & outName)
-  {
-    auto const it = find(langs.begin(), langs.end(), code);
-    if (it != langs.end() && bestIndex > static_cast<size_t>(distance(langs.begin(), it)))
-    {
-      bestIndex = distance(langs.begin(), it);
-      outName = name;
-    }
-  };
-
-  src.ForEach([&](int8_t code, string const & name)
-              {
-                if (bestIndex == 0)
-                  return base::ControlFlow::Break;
-
-                findAndSet(priorityList, code, name, bestIndex, out);
-                return base::ControlFlow::Continue;
-              });
+  auto const code = src.GetBestString(priorityList, out);
+  if (code == StrUtf8::kUnsupportedLanguageCode)
+    return false;
 
   // There are many "junk" names in Arabian island.
-  if (bestIndex < priorityList.size() &&
-    priorityList[bestIndex] == StrUtf8::kInternationalCode)
-  {
+  if (code == StrUtf8::kInternationalCode)
     out = out.substr(0, out.find_first_of(','));
-  }
 
-  return bestIndex < priorityList.size();
+  return true;
 }
 
 vector<int8_t> GetSimilarToDeviceLanguages(int8_t deviceLang)
@@ -345,23 +320,14 @@ void GetReadableName(RegionData const & regionData, StringUtf8Multilang const &
 int8_t GetNameForSearchOnBooking(RegionData const & regionData, StringUtf8Multilang const & src,
                                  string & name)
 {
-  if (src.GetString(StringUtf8Multilang::kDefaultCode, name))
-    return StringUtf8Multilang::kDefaultCode;
-
-  vector<int8_t> mwmLangs;
-  regionData.GetLanguages(mwmLangs);
-
-  for (auto mwmLang : mwmLangs)
-  {
-    if (src.GetString(mwmLang, name))
-      return mwmLang;
-  }
-
-  if (src.GetString(StringUtf8Multilang::kEnglishCode, name))
-    return StringUtf8Multilang::kEnglishCode;
-
-  name.clear();
-  return StringUtf8Multilang::kUnsupportedLanguageCode;
+  vector<int8_t> langs = {StringUtf8Multilang::kDefaultCode};
+  regionData.GetLanguages(langs);
+  langs.push_back(StringUtf8Multilang::kEnglishCode);
+
+  auto const code = src.GetBestString(langs, name);
+  if (code == StringUtf8Multilang::kUnsupportedLanguageCode)
+    name.clear();
+  return code;
 }
 
 bool GetPreferredName(StringUtf8Multilang const & src, int8_t deviceLang, string & out)
@@ -28,6 +28,14 @@ typename ToDo::ResultType Classificator::ProcessObjects(uint32_t type, ToDo & to
 }
 
 ClassifObject const * Classificator::GetObject(uint32_t type) const
+{
+  int const slot = m_objects.FindSlot(type);
+  if (slot >= 0)
+    return m_objects.GetObject(slot);
+  return GetObjectByPath(type);
+}
+
+ClassifObject const * Classificator::GetObjectByPath(uint32_t type) const
 {
   ClassifObject const * p = &m_root;
   uint8_t i = 0;
@@ -45,6 +53,10 @@ ClassifObject const * Classificator::GetObject(uint32_t type) const
 
 string Classificator::GetFullObjectName(uint32_t type) const
 {
+  int const slot = m_objects.FindSlot(type);
+  if (slot >= 0)
+    return m_objects.GetFullName(slot);
+
   ClassifObject const * p = &m_root;
   uint8_t i = 0;
   string s;
@@ -61,46 +73,36 @@ string Classificator::GetFullObjectName(uint32_t type) const
   return s;
 }
 
-namespace feature
+void Classificator::GetDrawRules(uint32_t type, int scale, feature::EGeomType ft,
+                                 drule::KeysT & keys) const
 {
+  scale = min(scale, scales::GetUpperStyleScale());
 
-namespace
-{
-  class DrawRuleGetter
+  int const slot = m_objects.FindSlot(type);
+  if (slot >= 0 && m_objects.HasDrawRules())
   {
-    int m_scale;
-    EGeomType m_ft;
-    drule::KeysT & m_keys;
-
-  public:
-    DrawRuleGetter(int scale, EGeomType ft, drule::KeysT & keys)
-      : m_scale(scale), m_ft(ft), m_keys(keys)
-    {
-    }
-
-    typedef bool ResultType;
+    m_objects.GetDrawRules(slot, scale, ft, keys);
+    return;
+  }
 
-    void operator() (ClassifObject const *)
-    {
-    }
-    bool operator() (ClassifObject const * p, bool & res)
-    {
-      res = true;
-      p->GetSuitable(min(m_scale, scales::GetUpperStyleScale()), m_ft, m_keys);
-      return false;
-    }
-  };
+  ClassifObject const * p = GetObject(type);
+  if (p != &m_root)
+  {
+    ASSERT(p, ());
+    p->GetSuitable(scale, ft, keys);
+  }
 }
 
+namespace feature
+{
 pair<int, bool> GetDrawRule(TypesHolder const & types, int level,
                             drule::KeysT & keys)
 {
   ASSERT ( keys.empty(), () );
   Classificator const & c = classif();
 
-  DrawRuleGetter doRules(level, types.GetGeoType(), keys);
   for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+    c.GetDrawRules(t, level, types.GetGeoType(), keys);
 
   return make_pair(types.GetGeoType(), types.Has(c.GetCoastType()));
 }
@@ -112,10 +114,8 @@ void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
   ASSERT ( keys.empty(), () );
   Classificator const & c = classif();
 
-  DrawRuleGetter doRules(level, EGeomType(geoType), keys);
-
   for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+    c.GetDrawRules(t, level, EGeomType(geoType), keys);
 }
 
 void FilterRulesByRuntimeSelector(FeatureType & f, int zoomLevel, drule::KeysT & keys)
@@ -5,11 +5,23 @@
 #include "platform/constants.hpp"
 #include "platform/mwm_version.hpp"
 
+#include "coding/byte_stream.hpp"
+#include "coding/varint.hpp"
+
 
 void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
 {
-  uint32_t offset = 0, size = 0;
   auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  if (m_data)
+  {
+    ASSERT_LESS(ftOffset, m_data->GetSize(), ());
+    ArrayByteSource source(m_data->GetData<char>() + ftOffset);
+    ReadVarUint<uint32_t>(source);
+    ft.Deserialize(&m_loadInfo, source.PtrC());
+    return;
+  }
+
+  uint32_t offset = 0, size = 0;
   m_recordReader.ReadRecord(ftOffset, m_buffer, offset, size);
   ft.Deserialize(&m_loadInfo, &m_buffer[offset]);
 }
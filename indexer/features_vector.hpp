@@ -15,9 +15,16 @@ class FeaturesVector
   DISALLOW_COPY(FeaturesVector);
 
 public:
+  /// @param data is an optional memory-mapped features section of |cont|. When it's valid,
+  /// features are deserialized right from it without copying, so they stay valid as long as
+  /// the mapping does.
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
-                 feature::FeaturesOffsetsTable const * table)
-    : m_loadInfo(cont, header), m_recordReader(m_loadInfo.GetDataReader(), 256), m_table(table)
+                 feature::FeaturesOffsetsTable const * table,
+                 FilesMappingContainer::Handle const * data = nullptr)
+    : m_loadInfo(cont, header)
+    , m_recordReader(m_loadInfo.GetDataReader(), 256)
+    , m_table(table)
+    , m_data(data && data->IsValid() ? data : nullptr)
   {
   }
 
@@ -57,6 +64,7 @@ private:
   VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint> m_recordReader;
   mutable vector<char> m_buffer;
   feature::FeaturesOffsetsTable const * m_table;
+  FilesMappingContainer::Handle const * m_data;
 };
 
 /// Test features vector (reader) that combines all the needed data for stand-alone work.
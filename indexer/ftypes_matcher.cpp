@@ -116,6 +116,13 @@ HighwayClass GetHighwayClass(feature::TypesHolder const & types)
   return HighwayClass::Error;
 }
 
+TypeIndices::TypeIndices(feature::TypesHolder const & types)
+{
+  auto const & c = classif();
+  for (uint32_t t : types)
+    m_types.emplace_back(t, c.FindIndexForType(t));
+}
+
 uint32_t BaseChecker::PrepareToMatch(uint32_t type, uint8_t level)
 {
   ftype::TruncValue(type, level);
@@ -136,6 +143,29 @@ bool BaseChecker::operator()(feature::TypesHolder const & types) const
   return false;
 }
 
+bool BaseChecker::operator()(TypeIndices const & types) const
+{
+  bool matched = false;
+  types.ForEach([&](uint32_t type, uint32_t index) {
+    if (matched)
+      return;
+    if (index < m_matchedIndices.size())
+      matched = m_matchedIndices[index];
+    else
+      matched = IsMatched(type);
+  });
+  return matched;
+}
+
+void BaseChecker::FillMatchedIndices()
+{
+  auto const & c = classif();
+  uint32_t const count = c.GetTypesCount();
+  m_matchedIndices.assign(count, false);
+  for (uint32_t i = 0; i < count; ++i)
+    m_matchedIndices[i] = IsMatched(c.GetTypeForIndex(i));
+}
+
 bool BaseChecker::operator()(FeatureType & ft) const
 {
   return this->operator()(feature::TypesHolder(ft));
@@ -3,6 +3,7 @@
 #include "indexer/feature_data.hpp"
 
 #include "base/base.hpp"
+#include "base/buffer_vector.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
@@ -21,13 +22,37 @@ namespace feature { class TypesHolder; }
 class FeatureType;
 
 #define DECLARE_CHECKER_INSTANCE(CheckerType) static CheckerType const & Instance() { \
-                                              static CheckerType const inst; return inst; }
+  static CheckerType const inst = ftypes::BaseChecker::MakeIndexed(CheckerType()); return inst; }
 
 namespace ftypes
 {
+/// Classificator indices of feature types. Types are mapped to indices once, so every checker
+/// tests them with a single bit test per type.
+class TypeIndices
+{
+public:
+  explicit TypeIndices(feature::TypesHolder const & types);
+
+  /// Calls |fn| with a type and its index, the index is IndexAndTypeMapping::kInvalidIndex
+  /// for types which aren't in the classificator mapping.
+  template <typename Fn>
+  void ForEach(Fn && fn) const
+  {
+    for (auto const & t : m_types)
+      fn(t.first, t.second);
+  }
+
+private:
+  buffer_vector<std::pair<uint32_t, uint32_t>, feature::kMaxTypesCount> m_types;
+};
+
 class BaseChecker
 {
   size_t const m_level;
+  /// Bit per classificator type index, empty until FillMatchedIndices() is called.
+  std::vector<bool> m_matchedIndices;
+
+  void FillMatchedIndices();
 
 protected:
   std::vector<uint32_t> m_types;
@@ -41,9 +66,21 @@ public:
   bool operator()(feature::TypesHolder const & types) const;
   bool operator()(FeatureType & ft) const;
   bool operator()(std::vector<uint32_t> const & types) const;
+  /// Tests types by the bitset of matched type indices, falls back to IsMatched() for types
+  /// without index and for checkers without the bitset.
+  bool operator()(TypeIndices const & types) const;
 
   static uint32_t PrepareToMatch(uint32_t type, uint8_t level);
 
+  /// Returns |checker| with the bitset of matched type indices, which is filled by the final
+  /// checker as IsMatched() is virtual. Classificator must be loaded.
+  template <typename Checker>
+  static Checker MakeIndexed(Checker checker)
+  {
+    checker.FillMatchedIndices();
+    return checker;
+  }
+
   template <typename TFn>
   void ForEachType(TFn && fn) const
   {
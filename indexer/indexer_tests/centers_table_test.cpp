@@ -118,4 +118,50 @@ UNIT_CLASS_TEST(CentersTableTest, Subset)
     }
   }
 }
+
+UNIT_CLASS_TEST(CentersTableTest, FixedWidth)
+{
+  vector<pair<uint32_t, m2::PointD>> const features = {{0, m2::PointD(37.5, 67.5)},
+                                                       {2, m2::PointD(37.6, 67.1)},
+                                                       {3, m2::PointD(38.0, 67.9)},
+                                                       {7, m2::PointD(37.5, 67.9)},
+                                                       {70, m2::PointD(37.9, 67.0)}};
+
+  serial::GeometryCodingParams codingParams;
+
+  TBuffer buffer;
+  {
+    CentersTableBuilder builder;
+
+    builder.SetGeometryCodingParams(codingParams);
+    builder.SetFixedWidth(true);
+    for (auto const & feature : features)
+      builder.Put(feature.first, feature.second);
+
+    MemWriter<TBuffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    auto table = CentersTable::Load(reader, codingParams);
+    TEST(table.get(), ());
+
+    size_t j = 0;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+      m2::PointD actual;
+      if (j != features.size() && i == features[j].first)
+      {
+        TEST(table->Get(i, actual), (i));
+        TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(actual, features[j].second), 1, (i));
+        ++j;
+      }
+      else
+      {
+        TEST(!table->Get(i, actual), (i));
+      }
+    }
+  }
+}
 }  // namespace
@@ -162,3 +162,34 @@ UNIT_TEST(GetHighwayClassTest)
   types4.Add(c.GetTypeByPath({"highway"}));
   TEST_EQUAL(ftypes::GetHighwayClass(types4), ftypes::HighwayClass::Error, ());
 }
+
+UNIT_TEST(TypeIndicesChecker)
+{
+  classificator::Load();
+
+  Classificator const & c = classif();
+
+  auto const testChecker = [&c](ftypes::BaseChecker const & checker) {
+    for (uint32_t i = 0; i < c.GetTypesCount(); ++i)
+    {
+      feature::TypesHolder types;
+      types.Add(c.GetTypeForIndex(i));
+      TEST_EQUAL(checker(types), checker(ftypes::TypeIndices(types)),
+                 (c.GetReadableObjectName(types.GetBestType())));
+    }
+  };
+
+  testChecker(ftypes::IsStreetChecker::Instance());
+  testChecker(ftypes::IsBridgeChecker::Instance());
+  testChecker(ftypes::IsSubwayStationChecker::Instance());
+  testChecker(ftypes::IsLocalityChecker::Instance());
+
+  feature::TypesHolder types;
+  types.Add(c.GetTypeByPath({"highway", "trunk", "bridge"}));
+  types.Add(c.GetTypeByPath({"highway", "tertiary", "tunnel"}));
+  ftypes::TypeIndices const indices(types);
+  TEST(ftypes::IsStreetChecker::Instance()(indices), ());
+  TEST(ftypes::IsBridgeChecker::Instance()(indices), ());
+  TEST(ftypes::IsTunnelChecker::Instance()(indices), ());
+  TEST(!ftypes::IsLinkChecker::Instance()(indices), ());
+}
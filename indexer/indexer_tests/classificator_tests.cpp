@@ -82,3 +82,58 @@ UNIT_CLASS_TEST(TestWithClassificator, Classificator_Subtree)
 
   TEST_EQUAL(expectedTypes, subtreeTypes, ());
 }
+
+UNIT_CLASS_TEST(TestWithClassificator, Classificator_GetObject)
+{
+  Classificator const & c = classif();
+
+  TEST_EQUAL(c.GetObject(ftype::GetEmptyValue()), c.GetRoot(), ());
+
+  size_t count = 0;
+  c.ForEachTree([&](ClassifObject const * p, uint32_t type) {
+    TEST_EQUAL(c.GetObject(type), p, (type));
+
+    string const name = c.GetReadableObjectName(type);
+    TEST_EQUAL(c.GetTypeByReadableObjectName(name), type, (name));
+
+    uint32_t parent = type;
+    ftype::PopValue(parent);
+    TEST_EQUAL(c.GetFullObjectName(type), c.GetFullObjectName(parent) + p->GetName() + '|', ());
+    ++count;
+  });
+  TEST_GREATER(count, 0, ());
+
+  uint32_t const type = c.GetTypeByPath({"amenity", "parking", "private"});
+  TEST_EQUAL(c.GetReadableObjectName(type), "amenity-parking-private", ());
+  TEST_EQUAL(c.GetObject(type)->GetName(), "private", ());
+}
+
+UNIT_CLASS_TEST(TestWithClassificator, Classificator_Snapshot)
+{
+  Classificator const & c = classif();
+
+  vector<uint8_t> buffer;
+  c.WriteSnapshot(buffer);
+
+  Classificator snapshot;
+  snapshot.ReadSnapshot(buffer.data(), buffer.size());
+
+  vector<pair<uint32_t, string>> expected;
+  c.ForEachTree([&](ClassifObject const *, uint32_t type) {
+    expected.emplace_back(type, c.GetReadableObjectName(type));
+  });
+  vector<pair<uint32_t, string>> actual;
+  snapshot.ForEachTree([&](ClassifObject const *, uint32_t type) {
+    actual.emplace_back(type, snapshot.GetReadableObjectName(type));
+  });
+  TEST_EQUAL(actual, expected, ());
+
+  TEST_EQUAL(snapshot.GetCoastType(), c.GetCoastType(), ());
+  TEST_EQUAL(snapshot.GetTypesCount(), c.GetTypesCount(), ());
+  for (uint32_t i = 0; i < c.GetTypesCount(); ++i)
+    TEST_EQUAL(snapshot.GetTypeForIndex(i), c.GetTypeForIndex(i), (i));
+
+  // A broken snapshot isn't read.
+  buffer.resize(buffer.size() / 2);
+  TEST_ANY_THROW(snapshot.ReadSnapshot(buffer.data(), buffer.size()), ());
+}
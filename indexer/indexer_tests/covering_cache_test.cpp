@@ -0,0 +1,84 @@
+#include "testing/testing.hpp"
+
+#include "indexer/cell_id.hpp"
+#include "indexer/feature_covering.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <memory>
+
+using namespace covering;
+using namespace std;
+
+namespace
+{
+CoveringCache::Key MakeKey(m2::RectD const & rect, int cellDepth)
+{
+  CoveringCache::Key key;
+  key.m_rect = rect;
+  key.m_depthLevels = RectId::DEPTH_LEVELS;
+  key.m_cellDepth = cellDepth;
+  return key;
+}
+
+shared_ptr<Intervals const> MakeIntervals(size_t size)
+{
+  auto intervals = make_shared<Intervals>();
+  for (size_t i = 0; i < size; ++i)
+    intervals->emplace_back(2 * i, 2 * i + 1);
+  return intervals;
+}
+}  // namespace
+
+UNIT_TEST(CoveringCache_Smoke)
+{
+  auto const a = MakeKey(m2::RectD(0, 0, 1, 1), 10);
+  auto const b = MakeKey(m2::RectD(0, 0, 1, 2), 10);
+  auto const c = MakeKey(m2::RectD(0, 0, 1, 1), 11);
+
+  // The size of two entries of 10 intervals.
+  CoveringCache cache(2 * (sizeof(CoveringCache::Key) + sizeof(Intervals) + 10 * sizeof(Interval)));
+  TEST(!cache.Get(a), ());
+
+  cache.Put(a, MakeIntervals(10));
+  cache.Put(b, MakeIntervals(10));
+  TEST(cache.Get(a), ());
+  TEST(!cache.Get(c), ());
+
+  // |b| is the least recently used entry.
+  cache.Put(c, MakeIntervals(10));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST(cache.Get(a), ());
+  TEST(!cache.Get(b), ());
+  TEST_EQUAL(*cache.Get(c), *MakeIntervals(10), ());
+
+  // Intervals larger than the limit aren't cached.
+  cache.Put(b, MakeIntervals(100));
+  TEST(!cache.Get(b), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_evictions, 1, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 0, ());
+}
+
+UNIT_TEST(CoveringCache_SameAsCovering)
+{
+  m2::RectD const rect(27.43, 53.83, 27.70, 53.96);
+  int const scale = 15;
+  int const cellDepth = GetCodingDepth<RectId::DEPTH_LEVELS>(scale);
+
+  Intervals expected;
+  CoverViewportAndAppendLowerLevels<RectId::DEPTH_LEVELS>(rect, cellDepth, expected);
+  TEST(!expected.empty(), ());
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    CoveringGetter getter(rect, ViewportWithLowLevels);
+    TEST_EQUAL(getter.Get<RectId::DEPTH_LEVELS>(scale), expected, (i));
+  }
+  TEST(CoveringCache::Instance().Get(MakeKey(rect, cellDepth)), ());
+}
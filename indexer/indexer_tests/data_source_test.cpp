@@ -13,12 +13,16 @@
 #include "platform/platform.hpp"
 
 #include "base/logging.hpp"
+#include "base/cancellable.hpp"
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/worker_thread.hpp"
 
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <vector>
 
 using namespace std;
 using platform::CountryFile;
@@ -101,6 +105,48 @@ UNIT_CLASS_TEST(DataSourceTest, Parse)
   m_dataSource.ForEachInScale([](FeatureType &) { return; }, 15);
 }
 
+UNIT_CLASS_TEST(DataSourceTest, ForEachInRectParallel)
+{
+  auto const result =
+      m_dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  auto const rect = result.first.GetInfo()->m_bordersRect;
+  int const scale = 17;
+
+  vector<FeatureID> expected;
+  m_dataSource.ForEachInRect([&](FeatureType & ft) { expected.push_back(ft.GetID()); }, rect,
+                             scale);
+  sort(expected.begin(), expected.end());
+  TEST(!expected.empty(), ());
+
+  base::WorkerThread pool(4 /* threadsCount */);
+  base::Cancellable cancellable;
+
+  mutex mu;
+  vector<FeatureID> actual;
+  m_dataSource.ForEachInRectParallel(
+      [&](FeatureType & ft) {
+        lock_guard<mutex> lock(mu);
+        actual.push_back(ft.GetID());
+      },
+      rect, scale, pool, cancellable);
+  sort(actual.begin(), actual.end());
+  TEST_EQUAL(expected, actual, ());
+
+  cancellable.Cancel();
+  actual.clear();
+  m_dataSource.ForEachInRectParallel(
+      [&](FeatureType & ft) {
+        lock_guard<mutex> lock(mu);
+        actual.push_back(ft.GetID());
+      },
+      rect, scale, pool, cancellable);
+  TEST(actual.empty(), ());
+
+  pool.ShutdownAndJoin();
+}
+
 UNIT_CLASS_TEST(DataSourceTest, StatusNotifications)
 {
   string const mapsDir = GetPlatform().WritableDir();
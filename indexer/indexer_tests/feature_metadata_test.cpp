@@ -92,6 +92,35 @@ UNIT_TEST(Feature_Serialization)
   }
 }
 
+UNIT_TEST(Feature_Metadata_DeserializeValue)
+{
+  Metadata original;
+  for (auto const & value : kKeyValues)
+    original.Set(value.first, value.second);
+
+  vector<char> buffer;
+  MemWriter<decltype(buffer)> writer(buffer);
+  original.Serialize(writer);
+
+  auto const getValue = [&buffer](Metadata::EType type, string & value) {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    return Metadata::DeserializeValue(src, type, value);
+  };
+
+  for (auto const & value : kKeyValues)
+  {
+    string s;
+    TEST(getValue(value.first, s), (value.first));
+    TEST_EQUAL(s, value.second, ());
+  }
+
+  string s;
+  TEST(!getValue(Metadata::FMD_OPERATOR, s), ());
+  TEST(!getValue(Metadata::FMD_AIRPORT_IATA, s), ());
+  TEST(s.empty(), ());
+}
+
 UNIT_TEST(Feature_Metadata_GetWikipedia)
 {
   Metadata m;
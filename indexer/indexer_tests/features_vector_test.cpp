@@ -1,8 +1,10 @@
 #include "testing/testing.hpp"
 
 #include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/mwm_set.hpp"
+#include "indexer/scales.hpp"
 
 #include "platform/local_country_file.hpp"
 
@@ -71,4 +73,83 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
              });
   TEST_EQUAL(expected, actual, ());
 }
+
+UNIT_TEST(FeaturesVectorTest_BestGeometryParsed)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue<MwmValue>();
+  FeaturesVector features(value->m_cont, value->GetHeader(), value->m_table.get());
+
+  size_t bestCount = 0;
+  for (uint32_t i = 0; i < features.GetNumFeatures(); ++i)
+  {
+    FeatureType ft;
+    features.GetByIndex(i, ft);
+    if (ft.GetFeatureType() != feature::GEOM_LINE)
+      continue;
+
+    ft.ParseGeometry(scales::GetUpperScale());
+    if (!ft.IsBestGeometryParsed())
+      continue;
+    ++bestCount;
+
+    vector<m2::PointD> parsed;
+    ft.ForEachPoint([&parsed](m2::PointD const & p) { parsed.push_back(p); },
+                    FeatureType::BEST_GEOMETRY);
+
+    FeatureType expected;
+    features.GetByIndex(i, expected);
+    vector<m2::PointD> best;
+    expected.ForEachPoint([&best](m2::PointD const & p) { best.push_back(p); },
+                          FeatureType::BEST_GEOMETRY);
+    TEST_EQUAL(parsed, best, (i));
+  }
+  TEST_GREATER(bestCount, 0, ());
+}
+
+UNIT_TEST(FeaturesVectorTest_MappedData)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue<MwmValue>();
+  TEST(value->m_featuresData.IsValid(), ());
+
+  FeaturesVector copied(value->m_cont, value->GetHeader(), value->m_table.get());
+  FeaturesVector mapped(value->m_cont, value->GetHeader(), value->m_table.get(),
+                        &value->m_featuresData);
+  TEST_EQUAL(copied.GetNumFeatures(), mapped.GetNumFeatures(), ());
+
+  for (uint32_t i = 0; i < mapped.GetNumFeatures(); ++i)
+  {
+    FeatureType expected;
+    copied.GetByIndex(i, expected);
+    FeatureType actual;
+    mapped.GetByIndex(i, actual);
+
+    TEST_EQUAL(expected.GetFeatureType(), actual.GetFeatureType(), (i));
+    TEST_EQUAL(expected.GetTypesCount(), actual.GetTypesCount(), (i));
+    TEST_EQUAL(expected.GetLimitRect(FeatureType::BEST_GEOMETRY),
+               actual.GetLimitRect(FeatureType::BEST_GEOMETRY), (i));
+    string expectedName;
+    string actualName;
+    expected.GetReadableName(expectedName);
+    actual.GetReadableName(actualName);
+    TEST_EQUAL(expectedName, actualName, (i));
+  }
+}
 }  // namespace
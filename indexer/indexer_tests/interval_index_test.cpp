@@ -9,6 +9,8 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -28,6 +30,15 @@ struct CellIdFeaturePairForTest
   uint64_t m_cell;
   uint32_t m_value;
 };
+
+// Hides that the data is in memory, to read it as a regular reader does.
+class NonContiguousReader : public MemReader
+{
+public:
+  using MemReader::MemReader;
+
+  uint8_t const * GetContiguousData() const override { return nullptr; }
+};
 }
 
 UNIT_TEST(IntervalIndex_LevelCount)
@@ -286,3 +297,74 @@ UNIT_TEST(IntervalIndex_Simple5)
   }
 }
 
+
+UNIT_TEST(IntervalIndex_ForEachInIntervals)
+{
+  mt19937 rng(0);
+  uint64_t const kKeyEnd = 1 << 24;
+
+  vector<CellIdFeaturePairForTest> data;
+  for (uint32_t i = 0; i < 2000; ++i)
+    data.emplace_back(uniform_int_distribution<uint64_t>(0, kKeyEnd - 1)(rng), i);
+  sort(data.begin(), data.end(),
+       [](CellIdFeaturePairForTest const & lhs, CellIdFeaturePairForTest const & rhs) {
+         return lhs.m_cell < rhs.m_cell;
+       });
+
+  vector<char> serialIndex;
+  MemWriter<vector<char>> writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 24);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  NonContiguousReader nonContiguousReader(&serialIndex[0], serialIndex.size());
+  IntervalIndex<MemReader, uint32_t> index(reader);
+  IntervalIndex<NonContiguousReader, uint32_t> readIndex(nonContiguousReader);
+  IntervalIndex<NonContiguousReader, uint32_t> cachedIndex(nonContiguousReader);
+  cachedIndex.EnableNodeCache(1024);
+
+  for (size_t test = 0; test < 20; ++test)
+  {
+    vector<pair<uint64_t, uint64_t>> intervals;
+    uint64_t beg = 0;
+    while (true)
+    {
+      beg += uniform_int_distribution<uint64_t>(0, kKeyEnd / 8)(rng);
+      uint64_t const end = beg + uniform_int_distribution<uint64_t>(0, kKeyEnd / 16)(rng);
+      if (end > kKeyEnd)
+        break;
+      intervals.emplace_back(beg, end);
+      beg = end;
+    }
+
+    vector<uint32_t> expected;
+    for (auto const & d : data)
+    {
+      for (auto const & interval : intervals)
+      {
+        if (interval.first <= d.m_cell && d.m_cell < interval.second)
+          expected.push_back(d.m_value);
+      }
+    }
+    sort(expected.begin(), expected.end());
+
+    // Intervals may come unsorted, e.g. from the LowLevelsOnly covering.
+    shuffle(intervals.begin(), intervals.end(), rng);
+
+    auto const testIndex = [&](auto const & idx) {
+      vector<uint32_t> values;
+      idx.ForEachInIntervals(base::MakeBackInsertFunctor(values), intervals.begin(),
+                             intervals.end());
+      sort(values.begin(), values.end());
+      TEST_EQUAL(values, expected, (test));
+
+      values.clear();
+      for (auto const & interval : intervals)
+        idx.ForEach(base::MakeBackInsertFunctor(values), interval.first, interval.second);
+      sort(values.begin(), values.end());
+      TEST_EQUAL(values, expected, (test));
+    };
+
+    testIndex(index);
+    testIndex(readIndex);
+    testIndex(cachedIndex);
+  }
+}
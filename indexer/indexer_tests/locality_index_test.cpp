@@ -37,13 +37,13 @@ struct LocalityObjectVector
 
 template <class ObjectsVector, class Writer>
 void BuildGeoObjectsIndex(ObjectsVector const & objects, Writer & writer,
-                          string const & tmpFilePrefix)
+                          string const & tmpFilePrefix, size_t threadsCount = 1)
 {
   auto coverLocality = [](indexer::LocalityObject const & o, int cellDepth) {
     return covering::CoverGeoObject(o, cellDepth);
   };
   return covering::BuildLocalityIndex<ObjectsVector, Writer, kGeoObjectsDepthLevels>(
-      objects, writer, coverLocality, tmpFilePrefix);
+      objects, writer, coverLocality, tmpFilePrefix, threadsCount);
 }
 
 using Ids = set<uint64_t>;
@@ -90,6 +90,57 @@ UNIT_TEST(BuildLocalityIndexTest)
   TEST_EQUAL(GetIds(index, m2::RectD{-0.5, -0.5, 1.5, 1.5}), (Ids{1, 2, 3, 4}), ());
 }
 
+UNIT_TEST(BuildLocalityIndexParallelTest)
+{
+  LocalityObjectVector objects;
+  objects.m_objects.resize(1000);
+  for (size_t i = 0; i < objects.m_objects.size(); ++i)
+    objects.m_objects[i].SetForTests(i + 1, m2::PointD(i % 40 * 0.5, i / 40 * 0.5));
+
+  vector<char> index;
+  {
+    MemWriter<vector<char>> writer(index);
+    BuildGeoObjectsIndex(objects, writer, "tmp");
+  }
+
+  for (size_t threadsCount : {2, 3, 8})
+  {
+    vector<char> parallelIndex;
+    MemWriter<vector<char>> writer(parallelIndex);
+    BuildGeoObjectsIndex(objects, writer, "tmp", threadsCount);
+    TEST_EQUAL(parallelIndex, index, (threadsCount));
+  }
+}
+
+UNIT_TEST(LocalityIndexForEachAtPointsTest)
+{
+  LocalityObjectVector objects;
+  objects.m_objects.resize(4);
+  objects.m_objects[0].SetForTests(1, m2::PointD{0, 0});
+  objects.m_objects[1].SetForTests(2, m2::PointD{1, 0});
+  objects.m_objects[2].SetForTests(3, m2::PointD{1, 1});
+  objects.m_objects[3].SetForTests(4, m2::PointD{0, 1});
+
+  vector<char> localityIndex;
+  MemWriter<vector<char>> writer(localityIndex);
+  BuildGeoObjectsIndex(objects, writer, "tmp");
+  MemReader reader(localityIndex.data(), localityIndex.size());
+
+  indexer::GeoObjectsIndex<MemReader> index(reader);
+
+  vector<m2::PointD> const points = {{1, 1}, {5, 5}, {0, 0}, {1, 0}, {0, 0}};
+  vector<Ids> ids(points.size());
+  index.ForEachAtPoints(
+      [&ids](size_t i, base::GeoObjectId const & id) { ids[i].insert(id.GetEncodedId()); },
+      points);
+
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST_EQUAL(ids[i], GetIds(index, m2::RectD(points[i], points[i])), (points[i]));
+  TEST_EQUAL(ids[0], (Ids{3}), ());
+  TEST_EQUAL(ids[1], Ids(), ());
+  TEST_EQUAL(ids[4], (Ids{1}), ());
+}
+
 UNIT_TEST(LocalityIndexRankTest)
 {
   LocalityObjectVector objects;
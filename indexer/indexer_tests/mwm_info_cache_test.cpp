@@ -0,0 +1,73 @@
+#include "testing/testing.hpp"
+
+#include "indexer/mwm_info_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <string>
+
+using namespace std;
+
+namespace
+{
+MwmInfoCache::Entry MakeEntry(uint64_t fileSize, uint64_t modificationTime)
+{
+  MwmInfoCache::Entry entry;
+  entry.m_fileSize = fileSize;
+  entry.m_modificationTime = modificationTime;
+  entry.m_bordersRect = m2::RectD(-1.5, 2.0, 3.25, 4.0);
+  entry.m_minScale = 1;
+  entry.m_maxScale = 17;
+  entry.m_version.SetFormat(version::Format::lastFormat);
+  entry.m_version.SetSecondsSinceEpoch(1500000000);
+  entry.m_data.Set(feature::RegionData::RD_DRIVING, "l");
+  return entry;
+}
+}  // namespace
+
+UNIT_TEST(MwmInfoCache_SaveLoad)
+{
+  string const path = GetPlatform().WritablePathForFile("mwm_info_cache_test.bin");
+  Platform::RemoveFileIfExists(path);
+  SCOPE_GUARD(deleteFile, [&path]() { Platform::RemoveFileIfExists(path); });
+
+  {
+    MwmInfoCache cache(path);
+    TEST_EQUAL(cache.GetSize(), 0, ());
+    cache.Add("a.mwm", MakeEntry(100 /* fileSize */, 10 /* modificationTime */));
+    cache.Add("b.mwm", MakeEntry(200 /* fileSize */, 20 /* modificationTime */));
+    cache.Save();
+  }
+
+  {
+    MwmInfoCache cache(path);
+    TEST_EQUAL(cache.GetSize(), 2, ());
+
+    MwmInfoCache::Entry entry;
+    TEST(cache.Find("a.mwm", 100 /* fileSize */, 10 /* modificationTime */, entry), ());
+    TEST_EQUAL(entry.m_bordersRect, m2::RectD(-1.5, 2.0, 3.25, 4.0), ());
+    TEST_EQUAL(entry.m_minScale, 1, ());
+    TEST_EQUAL(entry.m_maxScale, 17, ());
+    TEST(entry.m_version.GetFormat() == version::Format::lastFormat, ());
+    TEST_EQUAL(entry.m_version.GetSecondsSinceEpoch(), 1500000000, ());
+    TEST_EQUAL(entry.m_data.Get(feature::RegionData::RD_DRIVING), "l", ());
+
+    // Changed files aren't found.
+    TEST(!cache.Find("a.mwm", 101 /* fileSize */, 10 /* modificationTime */, entry), ());
+    TEST(!cache.Find("a.mwm", 100 /* fileSize */, 11 /* modificationTime */, entry), ());
+    TEST(!cache.Find("c.mwm", 100 /* fileSize */, 10 /* modificationTime */, entry), ());
+
+    // "b.mwm" isn't used and it's dropped.
+    cache.Save();
+  }
+
+  {
+    MwmInfoCache cache(path);
+    TEST_EQUAL(cache.GetSize(), 1, ());
+    MwmInfoCache::Entry entry;
+    TEST(cache.Find("a.mwm", 100 /* fileSize */, 10 /* modificationTime */, entry), ());
+    TEST(!cache.Find("b.mwm", 200 /* fileSize */, 20 /* modificationTime */, entry), ());
+  }
+}
@@ -7,7 +7,9 @@
 #include "base/macros.hpp"
 
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 using namespace std;
 using platform::CountryFile;
@@ -158,3 +160,46 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetStatsTest)
+{
+  TestMwmSet mwmSet;
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("5")).first;
+  TEST(id.IsAlive(), ());
+
+  {
+    MwmSet::MwmHandle const handle0 = mwmSet.GetMwmHandleById(id);
+    MwmSet::MwmHandle const handle1 = mwmSet.GetMwmHandleById(id);
+    TEST(handle0.IsAlive(), ());
+    TEST(handle1.IsAlive(), ());
+    TEST_EQUAL(id.GetInfo()->GetNumRefs(), 2, ());
+  }
+  {
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(id);
+    TEST(handle.IsAlive(), ());
+  }
+
+  auto stats = mwmSet.GetStats();
+  TEST_EQUAL(stats.m_handles, 3, ());
+  TEST_EQUAL(stats.m_createdValues, 2, ());
+  TEST_EQUAL(stats.m_cacheHits, 1, ());
+
+  size_t const kNumThreads = 4;
+  size_t const kNumHandles = 1000;
+  vector<thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i)
+  {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < kNumHandles; ++j)
+        TEST(mwmSet.GetMwmHandleById(id).IsAlive(), ());
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, ());
+  stats = mwmSet.GetStats();
+  TEST_EQUAL(stats.m_handles, 3 + kNumThreads * kNumHandles, ());
+  TEST_EQUAL(stats.m_handles, stats.m_cacheHits + stats.m_createdValues, ());
+  TEST_LESS_OR_EQUAL(stats.m_createdValues, 2 + kNumThreads, ());
+}
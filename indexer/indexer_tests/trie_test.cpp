@@ -9,9 +9,11 @@
 #include "coding/write_to_sink.hpp"
 
 #include "base/logging.hpp"
+#include "base/task_scheduler.hpp"
 
 #include <algorithm>
 #include <cstring>
+#include <random>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -223,3 +225,43 @@ UNIT_TEST(TrieBuilder_Build)
     }
   }
 }
+
+UNIT_TEST(TrieBuilder_ParallelBuild)
+{
+  using Key = buffer_vector<trie::TrieChar, 8>;
+  using Value = uint32_t;
+  using Sink = PushBackByteSink<vector<uint8_t>>;
+
+  mt19937 rng(0);
+  base::TaskScheduler scheduler(3 /* workersCount */);
+  for (size_t test = 0; test < 50; ++test)
+  {
+    vector<pair<Key, Value>> data;
+    size_t const size = rng() % 2000;
+    for (size_t i = 0; i < size; ++i)
+    {
+      Key key(rng() % 5);
+      for (auto & c : key)
+        c = static_cast<trie::TrieChar>(rng() % (test % 2 == 0 ? 3 : 100));
+      data.emplace_back(key, rng() % 10);
+    }
+    sort(data.begin(), data.end());
+
+    SingleValueSerializer<Value> serializer;
+    vector<uint8_t> expected;
+    {
+      Sink sink(expected);
+      trie::Build<Sink, Key, ValueList<Value>, SingleValueSerializer<Value>>(sink, serializer,
+                                                                              data);
+    }
+
+    vector<uint8_t> actual;
+    {
+      Sink sink(actual);
+      trie::ParallelBuild<Sink, Key, ValueList<Value>, SingleValueSerializer<Value>>(
+          sink, serializer, data, scheduler);
+    }
+    TEST_EQUAL(expected, actual, (test));
+  }
+  scheduler.ShutdownAndJoin();
+}
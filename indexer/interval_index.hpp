@@ -7,7 +7,11 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class IntervalIndexBase
 {
@@ -38,7 +42,8 @@ class IntervalIndex : public IntervalIndexBase
   typedef IntervalIndexBase base_t;
 public:
 
-  explicit IntervalIndex(ReaderT const & reader) : m_Reader(reader)
+  explicit IntervalIndex(ReaderT const & reader)
+    : m_Reader(reader), m_Data(m_Reader.GetContiguousData())
   {
     ReaderSource<ReaderT> src(reader);
     src.Read(&m_Header, sizeof(Header));
@@ -53,75 +58,163 @@ public:
     return 1ULL << (m_Header.m_Levels * m_Header.m_BitsPerLevel + m_Header.m_LeafBytes * 8);
   }
 
+  /// Keeps up to |maxBytes| of inner nodes in memory, they are read for every query otherwise.
+  /// Does nothing for contiguous readers, as their nodes are used in place.
+  /// @note The index isn't thread-safe after this call.
+  void EnableNodeCache(size_t maxBytes) { m_NodeCacheLimit = maxBytes; }
+
   template <typename F>
   void ForEach(F const & f, uint64_t beg, uint64_t end) const
   {
-    if (m_Header.m_Levels != 0 && beg != end)
+    std::pair<uint64_t, uint64_t> const interval(beg, end);
+    ForEachInIntervals(f, &interval, &interval + 1);
+  }
+
+  /// Calls |f| for values of keys from [beg, end) intervals in [first, last) in one traversal,
+  /// so a node shared by several intervals is read once.
+  template <typename F, typename It>
+  void ForEachInIntervals(F const & f, It first, It last) const
+  {
+    ForEachKeyValueInIntervals([&f](uint64_t /* key */, Value value) { f(value); }, first, last);
+  }
+
+  /// Same as ForEachInIntervals() but calls |f| with a key and a value. Keys go in the
+  /// ascending order.
+  template <typename F, typename It>
+  void ForEachKeyValueInIntervals(F const & f, It first, It last) const
+  {
+    if (m_Header.m_Levels == 0)
+      return;
+
+    Ranges ranges;
+    uint64_t const keyEnd = KeyEnd();
+    for (; first != last; ++first)
     {
-      // ASSERT_LESS_OR_EQUAL(beg, KeyEnd(), (end));
-      // ASSERT_LESS_OR_EQUAL(end, KeyEnd(), (beg));
-      if (beg > KeyEnd())
-        beg = KeyEnd();
-      if (end > KeyEnd())
-        end = KeyEnd();
-      --end;  // end is inclusive in ForEachImpl().
-      ForEachNode(f, beg, end, m_Header.m_Levels, 0,
-                  m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels]);
+      uint64_t const beg = std::min(static_cast<uint64_t>(first->first), keyEnd);
+      uint64_t const end = std::min(static_cast<uint64_t>(first->second), keyEnd);
+      if (beg < end)
+        ranges.emplace_back(beg, end - 1);
     }
+
+    // Ranges are inclusive, adjacent and overlapping ones are merged.
+    if (!std::is_sorted(ranges.begin(), ranges.end()))
+      std::sort(ranges.begin(), ranges.end());
+    size_t n = 0;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+      if (n != 0 && ranges[i].first <= ranges[n - 1].second + 1)
+        ranges[n - 1].second = std::max(ranges[n - 1].second, ranges[i].second);
+      else
+        ranges[n++] = ranges[i];
+    }
+    ranges.resize(n);
+
+    if (ranges.empty())
+      return;
+
+    ForEachNode(f, ranges.data(), ranges.data() + ranges.size(), 0 /* base */, m_Header.m_Levels,
+                0 /* offset */,
+                m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels]);
   }
 
 private:
+  // Inclusive ranges of keys.
+  using Range = std::pair<uint64_t, uint64_t>;
+  using Ranges = buffer_vector<Range, 32>;
 
-  template <typename F>
-  void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
-                   uint32_t const offset, uint32_t const size) const
+  struct Child
   {
-    buffer_vector<uint8_t, 1024> data;
-    data.resize_no_init(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    Range const * m_first;
+    Range const * m_last;
+    uint64_t m_base;
+    uint32_t m_offset;
+    uint32_t m_size;
+  };
 
-    void const * pEnd = &data[0] + size;
+  // |base| is the first key of the leaf, keys in the leaf are stored relative to it.
+  template <typename F>
+  void ForEachInLeaf(F const & f, Range const * first, Range const * last, uint64_t base,
+                     uint8_t const * data, uint32_t size) const
+  {
+    ArrayByteSource src(data);
+    void const * pEnd = data + size;
     Value value = 0;
     while (src.Ptr() < pEnd)
     {
       uint32_t key = 0;
       src.Read(&key, m_Header.m_LeafBytes);
-      key = SwapIfBigEndianMacroBased(key);
-      if (key > end)
+      uint64_t const k = base + SwapIfBigEndianMacroBased(key);
+      while (first != last && first->second < k)
+        ++first;
+      if (first == last)
         break;
       value += ReadVarInt<int64_t>(src);
-      if (key >= beg)
-        f(value);
+      if (k >= first->first)
+        f(k, value);
     }
   }
 
-  template <typename F>
-  void ForEachNode(F const & f, uint64_t beg, uint64_t end, int level,
-                   uint32_t offset, uint32_t size) const
+  using NodeBuffer = buffer_vector<uint8_t, 576>;
+
+  uint8_t const * ReadNode(uint32_t offset, uint32_t size, NodeBuffer & buffer) const
   {
-    offset += m_LevelOffsets[level];
+    if (m_Data != nullptr)
+      return m_Data + offset;
 
-    if (level == 0)
+    if (m_NodeCacheLimit != 0)
     {
-      ForEachLeaf(f, beg, end, offset, size);
-      return;
+      auto const it = m_NodeCache.find(offset);
+      if (it != m_NodeCache.end())
+        return it->second.data();
     }
 
+    buffer.resize_no_init(size);
+    m_Reader.Read(offset, &buffer[0], size);
+
+    // The upper nodes are read first and they are the most shared ones, so the cache
+    // just stops growing at its limit.
+    if (m_NodeCacheSize + size <= m_NodeCacheLimit)
+    {
+      m_NodeCacheSize += size;
+      return m_NodeCache.emplace(offset, std::vector<uint8_t>(buffer.begin(), buffer.end()))
+          .first->second.data();
+    }
+    return &buffer[0];
+  }
+
+  // |base| is the first key of the node.
+  template <typename F>
+  void ForEachNode(F const & f, Range const * first, Range const * last, uint64_t base, int level,
+                   uint32_t offset, uint32_t size) const
+  {
+    ASSERT_GREATER(level, 0, ());
+    ASSERT(first != last, ());
+    offset += m_LevelOffsets[level];
+
     uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
-    ASSERT_LESS_OR_EQUAL(beg, end, (skipBits));
+    uint64_t const childKeysFF = (1ULL << skipBits) - 1;
+    uint32_t const maxChild = (1U << m_Header.m_BitsPerLevel) - 1;
+    uint32_t const end0 = static_cast<uint32_t>(
+        std::min<uint64_t>(((last - 1)->second - base) >> skipBits, maxChild));
 
-    uint64_t const levelBytesFF = (1ULL << skipBits) - 1;
-    uint32_t const beg0 = static_cast<uint32_t>(beg >> skipBits);
-    uint32_t const end0 = static_cast<uint32_t>(end >> skipBits);
-    ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (beg, end, skipBits));
+    NodeBuffer buffer;
+    uint8_t const * data = ReadNode(offset, size, buffer);
+    ArrayByteSource src(data);
 
-    buffer_vector<uint8_t, 576> data;
-    data.resize_no_init(size);
+    buffer_vector<Child, 16> children;
+    auto const addChild = [&](uint32_t i, uint32_t childOffset, uint32_t childSize) {
+      uint64_t const childBase = base + (static_cast<uint64_t>(i) << skipBits);
+      uint64_t const childLast = childBase + childKeysFF;
+      while (first != last && first->second < childBase)
+        ++first;
+      if (first == last || first->first > childLast)
+        return;
 
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+      Range const * childEnd = first;
+      while (childEnd != last && childEnd->first <= childLast)
+        ++childEnd;
+      children.push_back({first, childEnd, childBase, childOffset, childSize});
+    };
 
     uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
     uint32_t childOffset = offsetAndFlag >> 1;
@@ -134,41 +227,67 @@ private:
       {
         if (bits::GetBit(pBitmap, i))
         {
-          uint32_t childSize = ReadVarUint<uint32_t>(src);
-          if (i >= beg0)
-          {
-            uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
-            uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
-            ForEachNode(f, beg1, end1, level - 1, childOffset, childSize);
-          }
+          uint32_t const childSize = ReadVarUint<uint32_t>(src);
+          addChild(i, childOffset, childSize);
           childOffset += childSize;
         }
       }
-      ASSERT(end0 != (static_cast<uint32_t>(1) << m_Header.m_BitsPerLevel) - 1 ||
-             static_cast<uint8_t const *>(src.Ptr()) - &data[0] == size,
-             (beg, end, beg0, end0, offset, size, src.Ptr(), &data[0]));
     }
     else
     {
-      void const * pEnd = &data[0] + size;
+      void const * pEnd = data + size;
       while (src.Ptr() < pEnd)
       {
         uint8_t const i = src.ReadByte();
         if (i > end0)
           break;
-        uint32_t childSize = ReadVarUint<uint32_t>(src);
-        if (i >= beg0)
-        {
-          uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
-          uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
-          ForEachNode(f, beg1, end1, level - 1, childOffset, childSize);
-        }
+        uint32_t const childSize = ReadVarUint<uint32_t>(src);
+        addChild(i, childOffset, childSize);
         childOffset += childSize;
       }
     }
+
+    if (children.empty())
+      return;
+
+    if (level > 1)
+    {
+      for (auto const & c : children)
+        ForEachNode(f, c.m_first, c.m_last, c.m_base, level - 1, c.m_offset, c.m_size);
+      return;
+    }
+
+    // Leaves of a node are stored one after another, so all needed leaves are read at once.
+    uint32_t const leavesBeg = children.front().m_offset;
+    uint32_t const leavesEnd = children.back().m_offset + children.back().m_size;
+    buffer_vector<uint8_t, 1024> leaves;
+    uint8_t const * leavesData = nullptr;
+    if (m_Data != nullptr)
+    {
+      leavesData = m_Data + m_LevelOffsets[0] + leavesBeg;
+    }
+    else
+    {
+      leaves.resize_no_init(leavesEnd - leavesBeg);
+      if (!leaves.empty())
+        m_Reader.Read(m_LevelOffsets[0] + leavesBeg, &leaves[0], leaves.size());
+      leavesData = leaves.data();
+    }
+
+    for (auto const & c : children)
+    {
+      ForEachInLeaf(f, c.m_first, c.m_last, c.m_base, leavesData + (c.m_offset - leavesBeg),
+                    c.m_size);
+    }
   }
 
   ReaderT m_Reader;
+  // Index data in place when |m_Reader| is contiguous in memory, nullptr otherwise.
+  uint8_t const * m_Data;
   Header m_Header;
   buffer_vector<uint32_t, 7> m_LevelOffsets;
+
+  mutable std::unordered_map<uint32_t, std::vector<uint8_t>> m_NodeCache;
+  mutable size_t m_NodeCacheSize = 0;
+  size_t m_NodeCacheLimit = 0;
 };
@@ -11,12 +11,15 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/geo_object_id.hpp"
+#include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "defines.hpp"
 
@@ -30,6 +33,7 @@ class LocalityIndex
 {
 public:
   using ProcessObject = std::function<void(base::GeoObjectId const &)>;
+  using ProcessObjectAtPoint = std::function<void(size_t pointIndex, base::GeoObjectId const &)>;
 
   LocalityIndex() = default;
   explicit LocalityIndex(Reader const & reader)
@@ -42,14 +46,58 @@ public:
     covering::CoveringGetter cov(rect, covering::CoveringMode::ViewportWithLowLevels);
     covering::Intervals const & intervals = cov.Get<DEPTH_LEVELS>(scales::GetUpperScale());
 
-    for (auto const & i : intervals)
+    m_intervalIndex->ForEachInIntervals(
+        [&processObject](uint64_t storedId) {
+          processObject(LocalityObject::FromStoredId(storedId));
+        },
+        intervals.begin(), intervals.end());
+  }
+
+  // Same as ForEachInRect() for rects of zero size at each of |points|, but the index is
+  // traversed once for all the points, so the nodes shared by close points are read once.
+  // |processObject| gets the index of a point in |points|.
+  void ForEachAtPoints(ProcessObjectAtPoint const & processObject,
+                       std::vector<m2::PointD> const & points) const
+  {
+    struct PointInterval
     {
-      m_intervalIndex->ForEach(
-            [&processObject](uint64_t storedId) {
-        processObject(LocalityObject::FromStoredId(storedId));
-      },
-      i.first, i.second);
+      uint64_t m_beg;
+      uint64_t m_end;
+      size_t m_point;
+    };
+
+    std::vector<PointInterval> pointIntervals;
+    covering::Intervals intervals;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      m2::RectD const rect(points[i], points[i]);
+      covering::CoveringGetter cov(rect, covering::CoveringMode::ViewportWithLowLevels);
+      for (auto const & interval : cov.Get<DEPTH_LEVELS>(scales::GetUpperScale()))
+      {
+        pointIntervals.push_back({static_cast<uint64_t>(interval.first),
+                                  static_cast<uint64_t>(interval.second), i});
+        intervals.push_back(interval);
+      }
     }
+    std::sort(pointIntervals.begin(), pointIntervals.end(),
+              [](PointInterval const & lhs, PointInterval const & rhs) {
+                return lhs.m_beg < rhs.m_beg;
+              });
+
+    // Keys go in the ascending order, so the intervals containing a key are found by a sweep.
+    size_t next = 0;
+    std::vector<PointInterval const *> active;
+    m_intervalIndex->ForEachKeyValueInIntervals(
+        [&](uint64_t key, uint64_t storedId) {
+          while (next < pointIntervals.size() && pointIntervals[next].m_beg <= key)
+            active.push_back(&pointIntervals[next++]);
+          base::EraseIf(active, [key](PointInterval const * p) { return p->m_end <= key; });
+
+          auto const id = LocalityObject::FromStoredId(storedId);
+          for (auto const * p : active)
+            processObject(p->m_point, id);
+        },
+        intervals.begin(), intervals.end());
   }
 
   // Applies |processObject| to at most |topSize| object closest to |center| with maximal distance |sizeM|.
@@ -60,7 +60,7 @@ template <int DEPTH_LEVELS>
 bool BuildLocalityIndexFromDataFile(string const & dataFile,
                                     covering::CoverLocality const & coverLocality,
                                     string const & outFileName,
-                                    string const & localityIndexFileTag)
+                                    string const & localityIndexFileTag, size_t threadsCount)
 {
   try
   {
@@ -70,7 +70,7 @@ bool BuildLocalityIndexFromDataFile(string const & dataFile,
       FileWriter writer(idxFileName);
 
       covering::BuildLocalityIndex<LocalityVector<ModelReaderPtr>, FileWriter, DEPTH_LEVELS>(
-          localities.GetVector(), writer, coverLocality, outFileName);
+          localities.GetVector(), writer, coverLocality, outFileName, threadsCount);
     }
 
     FilesContainerW(outFileName, FileWriter::OP_WRITE_TRUNCATE)
@@ -91,21 +91,25 @@ bool BuildLocalityIndexFromDataFile(string const & dataFile,
 }
 }  // namespace
 
-bool BuildGeoObjectsIndexFromDataFile(string const & dataFile, string const & outFileName)
+bool BuildGeoObjectsIndexFromDataFile(string const & dataFile, string const & outFileName,
+                                      size_t threadsCount)
 {
   auto coverObject = [](indexer::LocalityObject const & o, int cellDepth) {
     return covering::CoverGeoObject(o, cellDepth);
   };
   return BuildLocalityIndexFromDataFile<kGeoObjectsDepthLevels>(dataFile, coverObject, outFileName,
-                                                                GEO_OBJECTS_INDEX_FILE_TAG);
+                                                                GEO_OBJECTS_INDEX_FILE_TAG,
+                                                                threadsCount);
 }
 
-bool BuildRegionsIndexFromDataFile(string const & dataFile, string const & outFileName)
+bool BuildRegionsIndexFromDataFile(string const & dataFile, string const & outFileName,
+                                   size_t threadsCount)
 {
   auto coverRegion = [](indexer::LocalityObject const & o, int cellDepth) {
     return covering::CoverRegion(o, cellDepth);
   };
   return BuildLocalityIndexFromDataFile<kRegionsDepthLevels>(dataFile, coverRegion, outFileName,
-                                                             REGIONS_INDEX_FILE_TAG);
+                                                             REGIONS_INDEX_FILE_TAG,
+                                                             threadsCount);
 }
 }  // namespace indexer
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace covering
@@ -26,9 +27,61 @@ namespace covering
 using CoverLocality =
     std::function<std::vector<int64_t>(indexer::LocalityObject const & o, int cellDepth)>;
 
+// Covers |objects| on |threadsCount| threads. Objects are covered by batches, cells of a batch
+// are added to |sorter| in the order of objects, so the result doesn't depend on |threadsCount|.
+template <class ObjectsVector, class Sorter>
+void CoverLocalities(ObjectsVector const & objects, CoverLocality const & coverLocality,
+                     int cellDepth, size_t threadsCount, Sorter & sorter)
+{
+  if (threadsCount <= 1)
+  {
+    objects.ForEach([&](indexer::LocalityObject const & o) {
+      for (auto const & cell : coverLocality(o, cellDepth))
+        sorter.Add(CellValuePair<uint64_t>(cell, o.GetStoredId()));
+    });
+    return;
+  }
+
+  size_t const batchSize = 256 * threadsCount;
+  std::vector<indexer::LocalityObject> batch;
+  std::vector<std::vector<int64_t>> cells;
+  batch.reserve(batchSize);
+
+  auto const coverBatch = [&]() {
+    cells.assign(batch.size(), {});
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadsCount; ++t)
+    {
+      threads.emplace_back([&, t]() {
+        size_t const beg = batch.size() * t / threadsCount;
+        size_t const end = batch.size() * (t + 1) / threadsCount;
+        for (size_t i = beg; i < end; ++i)
+          cells[i] = coverLocality(batch[i], cellDepth);
+      });
+    }
+    for (auto & thread : threads)
+      thread.join();
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      for (auto const & cell : cells[i])
+        sorter.Add(CellValuePair<uint64_t>(cell, batch[i].GetStoredId()));
+    }
+    batch.clear();
+  };
+
+  objects.ForEach([&](indexer::LocalityObject const & o) {
+    batch.push_back(o);
+    if (batch.size() == batchSize)
+      coverBatch();
+  });
+  coverBatch();
+}
+
 template <class ObjectsVector, class Writer, int DEPTH_LEVELS>
 void BuildLocalityIndex(ObjectsVector const & objects, Writer & writer,
-                        CoverLocality const & coverLocality, string const & tmpFilePrefix)
+                        CoverLocality const & coverLocality, string const & tmpFilePrefix,
+                        size_t threadsCount = 1)
 {
   string const cellsToValueFile = tmpFilePrefix + CELL2LOCALITY_SORTED_EXT + ".all";
   SCOPE_GUARD(cellsToValueFileGuard, bind(&FileWriter::DeleteFileX, cellsToValueFile));
@@ -37,13 +90,10 @@ void BuildLocalityIndex(ObjectsVector const & objects, Writer & writer,
 
     WriterFunctor<FileWriter> out(cellsToValueWriter);
     FileSorter<CellValuePair<uint64_t>, WriterFunctor<FileWriter>> sorter(
-        1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2LOCALITY_TMP_EXT, out);
-    objects.ForEach([&sorter, &coverLocality](indexer::LocalityObject const & o) {
-      std::vector<int64_t> const cells =
-          coverLocality(o, GetCodingDepth<DEPTH_LEVELS>(scales::GetUpperScale()));
-      for (auto const & cell : cells)
-        sorter.Add(CellValuePair<uint64_t>(cell, o.GetStoredId()));
-    });
+        1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2LOCALITY_TMP_EXT, out,
+        std::less<CellValuePair<uint64_t>>(), threadsCount);
+    CoverLocalities(objects, coverLocality, GetCodingDepth<DEPTH_LEVELS>(scales::GetUpperScale()),
+                    threadsCount, sorter);
     sorter.SortAndFinish();
   }
 
@@ -59,10 +109,13 @@ void BuildLocalityIndex(ObjectsVector const & objects, Writer & writer,
 namespace indexer
 {
 // Builds indexer::GeoObjectsIndex for reverse geocoder with |kGeoObjectsDepthLevels| depth levels
-// and saves it to |GEO_OBJECTS_INDEX_FILE_TAG| of |out|.
-bool BuildGeoObjectsIndexFromDataFile(std::string const & dataFile, std::string const & out);
+// and saves it to |GEO_OBJECTS_INDEX_FILE_TAG| of |out|. Objects are covered on |threadsCount|
+// threads.
+bool BuildGeoObjectsIndexFromDataFile(std::string const & dataFile, std::string const & out,
+                                      size_t threadsCount = 1);
 
 // Builds indexer::RegionsIndex for reverse geocoder with |kRegionsDepthLevels| depth levels and
-// saves it to |REGIONS_INDEX_FILE_TAG| of |out|.
-bool BuildRegionsIndexFromDataFile(std::string const & dataFile, std::string const & out);
+// saves it to |REGIONS_INDEX_FILE_TAG| of |out|. Regions are covered on |threadsCount| threads.
+bool BuildRegionsIndexFromDataFile(std::string const & dataFile, std::string const & out,
+                                   size_t threadsCount = 1);
 }  // namespace indexer
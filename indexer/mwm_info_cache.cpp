@@ -0,0 +1,180 @@
+#include "indexer/mwm_info_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+template <typename Sink>
+void WriteDouble(Sink & sink, double value)
+{
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "");
+  memcpy(&bits, &value, sizeof(bits));
+  WriteToSink(sink, bits);
+}
+
+template <typename Source>
+double ReadDouble(Source & src)
+{
+  auto const bits = ReadPrimitiveFromSource<uint64_t>(src);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+}  // namespace
+
+// static
+uint32_t constexpr MwmInfoCache::kVersion;
+
+MwmInfoCache::MwmInfoCache(string const & path) : m_path(path) { Load(); }
+
+bool MwmInfoCache::Find(string const & mwmPath, uint64_t fileSize, uint64_t modificationTime,
+                        Entry & entry) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_entries.find(mwmPath);
+  if (it == m_entries.end())
+    return false;
+
+  auto & cached = it->second;
+  if (cached.m_entry.m_fileSize != fileSize ||
+      cached.m_entry.m_modificationTime != modificationTime)
+  {
+    return false;
+  }
+
+  cached.m_isUsed = true;
+  entry = cached.m_entry;
+  return true;
+}
+
+void MwmInfoCache::Add(string const & mwmPath, Entry const & entry)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto & cached = m_entries[mwmPath];
+  cached.m_entry = entry;
+  cached.m_isUsed = true;
+  m_isChanged = true;
+}
+
+void MwmInfoCache::Save()
+{
+  lock_guard<mutex> lock(m_mutex);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.m_isUsed)
+    {
+      ++it;
+      continue;
+    }
+    it = m_entries.erase(it);
+    m_isChanged = true;
+  }
+
+  if (!m_isChanged)
+    return;
+
+  // The cache is written to the temporary file so that a broken file isn't loaded.
+  string const tmpPath = m_path + ".tmp";
+  try
+  {
+    {
+      FileWriter writer(tmpPath);
+      WriteToSink(writer, kVersion);
+      WriteToSink(writer, static_cast<uint32_t>(m_entries.size()));
+      for (auto const & item : m_entries)
+      {
+        auto const & entry = item.second.m_entry;
+        rw::Write(writer, item.first);
+        WriteToSink(writer, entry.m_fileSize);
+        WriteToSink(writer, entry.m_modificationTime);
+        WriteDouble(writer, entry.m_bordersRect.minX());
+        WriteDouble(writer, entry.m_bordersRect.minY());
+        WriteDouble(writer, entry.m_bordersRect.maxX());
+        WriteDouble(writer, entry.m_bordersRect.maxY());
+        WriteToSink(writer, entry.m_minScale);
+        WriteToSink(writer, entry.m_maxScale);
+        WriteToSink(writer, static_cast<uint32_t>(entry.m_version.GetFormat()));
+        WriteToSink(writer, entry.m_version.GetSecondsSinceEpoch());
+        entry.m_data.Serialize(writer);
+      }
+    }
+
+    if (!base::RenameFileX(tmpPath, m_path))
+    {
+      LOG(LWARNING, ("Can't rename", tmpPath, "to", m_path));
+      base::DeleteFileX(tmpPath);
+      return;
+    }
+    m_isChanged = false;
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write mwm info cache", m_path, e.Msg()));
+    base::DeleteFileX(tmpPath);
+  }
+}
+
+size_t MwmInfoCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+void MwmInfoCache::Load()
+{
+  if (!GetPlatform().IsFileExistsByFullPath(m_path))
+    return;
+
+  try
+  {
+    FileReader reader(m_path);
+    ReaderSource<FileReader> src(reader);
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kVersion)
+      return;
+
+    auto const count = ReadPrimitiveFromSource<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      string mwmPath;
+      rw::Read(src, mwmPath);
+
+      Entry entry;
+      entry.m_fileSize = ReadPrimitiveFromSource<uint64_t>(src);
+      entry.m_modificationTime = ReadPrimitiveFromSource<uint64_t>(src);
+      auto const minX = ReadDouble(src);
+      auto const minY = ReadDouble(src);
+      auto const maxX = ReadDouble(src);
+      auto const maxY = ReadDouble(src);
+      // Empty rect is kept as it is.
+      if (minX <= maxX && minY <= maxY)
+        entry.m_bordersRect = m2::RectD(minX, minY, maxX, maxY);
+      entry.m_minScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_maxScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_version.SetFormat(
+          static_cast<version::Format>(ReadPrimitiveFromSource<uint32_t>(src)));
+      entry.m_version.SetSecondsSinceEpoch(ReadPrimitiveFromSource<uint64_t>(src));
+      entry.m_data.Deserialize(src);
+
+      m_entries[mwmPath].m_entry = move(entry);
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read mwm info cache", m_path, e.Msg()));
+    m_entries.clear();
+  }
+}
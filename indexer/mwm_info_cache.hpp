@@ -0,0 +1,66 @@
+#pragma once
+
+#include "indexer/feature_meta.hpp"
+
+#include "platform/mwm_version.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Persistent cache of the mwm attributes which are read on registration of a map: bounds,
+// scales, version and region data. An entry is valid while the size and the modification time
+// of its file are unchanged, so maps are registered without opening their files and the files
+// are opened on the first handle request.
+class MwmInfoCache
+{
+public:
+  struct Entry
+  {
+    uint64_t m_fileSize = 0;
+    uint64_t m_modificationTime = 0;
+    m2::RectD m_bordersRect;
+    uint8_t m_minScale = 0;
+    uint8_t m_maxScale = 0;
+    version::MwmVersion m_version;
+    feature::RegionData m_data;
+  };
+
+  static uint32_t constexpr kVersion = 0;
+
+  // Loads the cache from |path| if it exists.
+  explicit MwmInfoCache(std::string const & path);
+
+  // Returns false when there's no entry for |mwmPath| or the file was changed.
+  bool Find(std::string const & mwmPath, uint64_t fileSize, uint64_t modificationTime,
+            Entry & entry) const;
+  void Add(std::string const & mwmPath, Entry const & entry);
+
+  // Writes the entries which were found or added since loading. Entries of removed and
+  // updated maps are dropped this way.
+  void Save();
+
+  size_t GetSize() const;
+
+private:
+  struct CachedEntry
+  {
+    Entry m_entry;
+    bool m_isUsed = false;
+  };
+
+  void Load();
+
+  std::string const m_path;
+
+  mutable std::mutex m_mutex;
+  mutable std::unordered_map<std::string, CachedEntry> m_entries;
+  bool m_isChanged = false;
+
+  DISALLOW_COPY_AND_MOVE(MwmInfoCache);
+};
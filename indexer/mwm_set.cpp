@@ -1,6 +1,8 @@
 #include "indexer/mwm_set.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 
 #include "platform/local_country_file_utils.hpp"
@@ -14,12 +16,47 @@
 #include <exception>
 #include <sstream>
 
+#include "std/target_os.hpp"
+
 #include "defines.hpp"
 
 using namespace std;
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
+namespace
+{
+// Returns the reader of the mwm file. The file is mapped when it's possible, so sections
+// of the container are read without copies and their data may be used in place,
+// see CreateMemoryRegion().
+ModelReaderPtr GetMwmReader(LocalCountryFile const & localFile)
+{
+  ModelReaderPtr reader = platform::GetCountryReader(localFile, MapOptions::Map);
+
+  // Whole mwms don't fit into the address space of 32-bit processes.
+  if (sizeof(void *) < sizeof(uint64_t))
+    return reader;
+
+#ifndef OMIM_OS_WINDOWS
+  // Mwms inside of archives, e.g. in resources of an apk, are read as is.
+  auto const * fileReader = dynamic_cast<FileReader const *>(reader.GetPtr());
+  if (fileReader == nullptr || fileReader->GetOffset() != 0)
+    return reader;
+
+  try
+  {
+    return make_unique<MmapReader>(fileReader->GetName());
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LDEBUG, ("Can't map", localFile, e.Msg()));
+  }
+#endif
+
+  return reader;
+}
+}  // namespace
+
 MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
@@ -132,7 +169,9 @@ pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const &
     {
       LOG(LINFO, ("Updating already registered mwm:", name));
       SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
-      info->m_file = localFile;
+      // Values are created from the file out of the lock, so the file of a used mwm is kept.
+      if (info->m_numRefs == 0)
+        info->m_file = localFile;
       result = make_pair(id, RegResult::VersionAlreadyExists);
       return;
     }
@@ -210,7 +249,7 @@ bool MwmSet::DeregisterImpl(CountryFile const & countryFile, EventList & events)
 
 bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 {
-  lock_guard<mutex> lock(m_lock);
+  auto const lock = Lock();
 
   MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
   return id.IsAlive() && id.GetInfo()->IsRegistered();
@@ -218,7 +257,7 @@ bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 
 void MwmSet::GetMwmsInfo(vector<shared_ptr<MwmInfo>> & info) const
 {
-  lock_guard<mutex> lock(m_lock);
+  auto const lock = Lock();
   info.clear();
   info.reserve(m_info.size());
   for (auto const & p : m_info)
@@ -266,37 +305,35 @@ void MwmSet::ProcessEventList(EventList & events)
 }
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValue(MwmId const & id)
-{
-  unique_ptr<MwmSet::MwmValueBase> result;
-  WithEventLog([&](EventList & events)
-               {
-                 result = LockValueImpl(id, events);
-               });
-  return result;
-}
-
-unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
 {
   if (!id.IsAlive())
     return nullptr;
   shared_ptr<MwmInfo> info = id.GetInfo();
 
-  // It's better to return valid "value pointer" even for "out-of-date" files,
-  // because they can be locked for a long time by other algos.
-  //if (!info->IsUpToDate())
-  //  return TMwmValueBasePtr();
+  {
+    auto const lock = Lock();
+    ++m_stats.m_handles;
 
-  ++info->m_numRefs;
+    // It's better to return valid "value pointer" even for "out-of-date" files,
+    // because they can be locked for a long time by other algos.
+    //if (!info->IsUpToDate())
+    //  return TMwmValueBasePtr();
 
-  // Search in cache.
-  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-  {
-    if (it->first == id)
+    // The reference keeps the mwm registered while its value is created.
+    ++info->m_numRefs;
+
+    // Search in cache.
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
     {
-      unique_ptr<MwmValueBase> result = move(it->second);
-      m_cache.erase(it);
-      return result;
+      if (it->first == id)
+      {
+        unique_ptr<MwmValueBase> result = move(it->second);
+        m_cache.erase(it);
+        ++m_stats.m_cacheHits;
+        return result;
+      }
     }
+    ++m_stats.m_createdValues;
   }
 
   try
@@ -306,33 +343,38 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
   catch (Reader::TooManyFilesException const & ex)
   {
     LOG(LERROR, ("Too many open files, can't open:", info->GetCountryName()));
+    auto const lock = Lock();
     --info->m_numRefs;
-    return nullptr;
   }
   catch (exception const & ex)
   {
     LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
-
-    --info->m_numRefs;
-    DeregisterImpl(id, events);
-    return nullptr;
+    WithEventLog([&](EventList & events)
+                 {
+                   --info->m_numRefs;
+                   DeregisterImpl(id, events);
+                 });
   }
+  return nullptr;
 }
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> p)
 {
+  unique_ptr<MwmValueBase> evicted;
   WithEventLog([&](EventList & events)
                {
-                 UnlockValueImpl(id, move(p), events);
+                 evicted = UnlockValueImpl(id, move(p), events);
                });
 }
 
-void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, EventList & events)
+unique_ptr<MwmSet::MwmValueBase> MwmSet::UnlockValueImpl(MwmId const & id,
+                                                        unique_ptr<MwmValueBase> p,
+                                                        EventList & events)
 {
   ASSERT(id.IsAlive(), (id));
   ASSERT(p.get() != nullptr, ());
   if (!id.IsAlive() || !p)
-    return;
+    return p;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
   ASSERT_GREATER(info->m_numRefs, 0, ());
@@ -340,65 +382,68 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, Event
   if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
     VERIFY(DeregisterImpl(id, events), ());
 
-  if (info->IsUpToDate())
-  {
-    /// @todo Probably, it's better to store only "unique by id" free caches here.
-    /// But it's no obvious if we have many threads working with the single mwm.
+  if (!info->IsUpToDate())
+    return p;
 
-    m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
-    {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
-    }
-  }
+  /// @todo Probably, it's better to store only "unique by id" free caches here.
+  /// But it's no obvious if we have many threads working with the single mwm.
+
+  m_cache.push_back(make_pair(id, move(p)));
+  if (m_cache.size() <= m_cacheSize)
+    return nullptr;
+
+  ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
+  unique_ptr<MwmValueBase> evicted = move(m_cache.front().second);
+  m_cache.pop_front();
+  return evicted;
 }
 
 void MwmSet::Clear()
 {
-  lock_guard<mutex> lock(m_lock);
+  auto const lock = Lock();
   ClearCacheImpl(m_cache.begin(), m_cache.end());
   m_info.clear();
 }
 
 void MwmSet::ClearCache()
 {
-  lock_guard<mutex> lock(m_lock);
+  auto const lock = Lock();
   ClearCacheImpl(m_cache.begin(), m_cache.end());
 }
 
+MwmSet::Stats MwmSet::GetStats() const
+{
+  auto const lock = Lock();
+  Stats stats = m_stats;
+  stats.m_contendedLocks = m_numContendedLocks.load(memory_order_relaxed);
+  return stats;
+}
+
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
 {
-  lock_guard<mutex> lock(m_lock);
+  auto const lock = Lock();
   return GetMwmIdByCountryFileImpl(countryFile);
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryFile)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(GetMwmIdByCountryFileImpl(countryFile), events);
-               });
-  return handle;
+  return GetMwmHandleById(GetMwmIdByCountryFile(countryFile));
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(id, events);
-               });
-  return handle;
+  return MwmHandle(*this, id, LockValue(id));
 }
 
-MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & events)
+unique_lock<mutex> MwmSet::Lock() const
 {
-  unique_ptr<MwmValueBase> value;
-  if (id.IsAlive())
-    value = LockValueImpl(id, events);
-  return MwmHandle(*this, id, move(value));
+  unique_lock<mutex> lock(m_lock, try_to_lock);
+  if (!lock.owns_lock())
+  {
+    m_numContendedLocks.fetch_add(1, memory_order_relaxed);
+    lock.lock();
+  }
+  return lock;
 }
 
 void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
@@ -415,9 +460,23 @@ void MwmSet::ClearCache(MwmId const & id)
 // MwmValue ----------------------------------------------------------------------------------------
 
 MwmValue::MwmValue(LocalCountryFile const & localFile)
-  : m_cont(platform::GetCountryReader(localFile, MapOptions::Map)), m_file(localFile)
+  : m_cont(GetMwmReader(localFile)), m_file(localFile)
 {
   m_factory.Load(m_cont);
+
+  // Whole features sections of many mwms don't fit into the address space of 32-bit processes.
+  if (sizeof(void *) < sizeof(uint64_t))
+    return;
+
+  try
+  {
+    FilesMappingContainer const cont(m_cont.GetFileName());
+    m_featuresData.Assign(cont.Map(DATA_FILE_TAG));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LDEBUG, ("Can't map", DATA_FILE_TAG, "section of", localFile, e.Msg()));
+  }
 }
 
 void MwmValue::SetTable(MwmInfoEx & info)
@@ -426,6 +485,7 @@ void MwmValue::SetTable(MwmInfoEx & info)
   if (version < version::Format::v5)
     return;
 
+  lock_guard<mutex> lock(info.m_tableMutex);
   m_table = info.m_table.lock();
   if (!m_table)
   {
@@ -437,6 +497,20 @@ void MwmValue::SetTable(MwmInfoEx & info)
   }
 }
 
+ScaleIndex<ModelReaderPtr> const & MwmValue::GetScaleIndex() const
+{
+  // Enough for the root and the upper levels of every scale tree.
+  size_t constexpr kNodeCacheSize = 16 * 1024;
+
+  if (!m_scaleIndex)
+  {
+    m_scaleIndex =
+        make_unique<ScaleIndex<ModelReaderPtr>>(m_cont.GetReader(INDEX_FILE_TAG), m_factory);
+    m_scaleIndex->EnableNodeCache(kNodeCacheSize);
+  }
+  return *m_scaleIndex;
+}
+
 string DebugPrint(MwmSet::RegResult result)
 {
   switch (result)
@@ -475,3 +549,15 @@ string DebugPrint(MwmSet::Event const & event)
   os << "]";
   return os.str();
 }
+
+string DebugPrint(MwmSet::Stats const & stats)
+{
+  ostringstream os;
+  os << "MwmSet::Stats [";
+  os << "handles: " << stats.m_handles << ", ";
+  os << "cache hits: " << stats.m_cacheHits << ", ";
+  os << "created values: " << stats.m_createdValues << ", ";
+  os << "contended locks: " << stats.m_contendedLocks;
+  os << "]";
+  return os.str();
+}
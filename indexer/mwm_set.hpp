@@ -11,6 +11,7 @@
 #include "indexer/data_factory.hpp"
 #include "indexer/feature_meta.hpp"
 #include "indexer/features_offsets_table.hpp"
+#include "indexer/scale_index.hpp"
 
 #include <atomic>
 #include <deque>
@@ -98,10 +99,11 @@ private:
   // MwmSet's cache. We can't use shared_ptr because of offsets table
   // must be removed as soon as the last corresponding MwmValue is
   // destroyed. Also, note that this value must be used and modified
-  // only in MwmValue::SetTable() method, which, in turn, is called
-  // only in the MwmSet critical section, protected by a lock.  So,
-  // there's an implicit synchronization on this field.
+  // only in MwmValue::SetTable() method under |m_tableMutex|. Values
+  // are created out of the MwmSet critical section, so the mutex is
+  // per mwm and values of different mwms are created concurrently.
   std::weak_ptr<feature::FeaturesOffsetsTable> m_table;
+  std::mutex m_tableMutex;
 };
 
 class MwmSet
@@ -133,7 +135,7 @@ public:
   };
 
 public:
-  explicit MwmSet(size_t cacheSize = 64) : m_cacheSize(cacheSize) {}
+  explicit MwmSet(size_t cacheSize = 64) : m_cacheSize(cacheSize), m_numContendedLocks(0) {}
   virtual ~MwmSet() = default;
 
   class MwmValueBase
@@ -230,6 +232,18 @@ public:
     DISALLOW_COPY_AND_MOVE(EventList);
   };
 
+  // Counters of handle acquisitions and of contention on the lock of the set.
+  struct Stats
+  {
+    uint64_t m_handles = 0;
+    // Number of handles which got a value from the cache.
+    uint64_t m_cacheHits = 0;
+    // Number of values created when the cache had no free value of the mwm.
+    uint64_t m_createdValues = 0;
+    // Number of times the lock of the set was held by another thread when it was taken.
+    uint64_t m_contendedLocks = 0;
+  };
+
   enum class RegResult
   {
     Success,
@@ -309,6 +323,8 @@ public:
 
   void ClearCache();
 
+  Stats GetStats() const;
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -342,25 +358,30 @@ private:
   {
     EventList events;
     {
-      std::lock_guard<std::mutex> lock(m_lock);
+      auto const lock = Lock();
       fn(events);
     }
     ProcessEventList(events);
   }
 
+  // Takes |m_lock| and counts contention on it.
+  std::unique_lock<std::mutex> Lock() const;
+
   // Sets |status| in |info|, adds corresponding event to |event|.
   void SetStatus(MwmInfo & info, MwmInfo::Status status, EventList & events);
 
   // Triggers observers on each event in |events|.
   void ProcessEventList(EventList & events);
 
-  /// @precondition This function is always called under mutex m_lock.
-  MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
-
+  // Takes a free value of the mwm from the cache or creates a new one. Values are created
+  // without holding |m_lock|, as it requires reading of the mwm file.
   std::unique_ptr<MwmValueBase> LockValue(MwmId const & id);
-  std::unique_ptr<MwmValueBase> LockValueImpl(MwmId const & id, EventList & events);
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValueBase> p);
-  void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValueBase> p, EventList & events);
+  // Returns a value evicted from the cache, if any. It's destroyed by the caller
+  // after |m_lock| is released, as it closes the mwm file.
+  std::unique_ptr<MwmValueBase> UnlockValueImpl(MwmId const & id,
+                                                std::unique_ptr<MwmValueBase> p,
+                                                EventList & events);
 
   /// Do the cleaning for [beg, end) without acquiring the mutex.
   /// @precondition This function is always called under mutex m_lock.
@@ -382,6 +403,9 @@ protected:
   mutable std::mutex m_lock;
 
 private:
+  Stats m_stats;
+  mutable std::atomic<uint64_t> m_numContendedLocks;
+
   base::ObserverListSafe<Observer> m_observers;
 }; // class MwmSet
 
@@ -393,6 +417,9 @@ public:
   platform::LocalCountryFile const m_file;
 
   std::shared_ptr<feature::FeaturesOffsetsTable> m_table;
+  // Memory-mapped features section, features are deserialized right from it without
+  // copying. It isn't valid when the mwm can't be mapped, e.g. when it's packed in an archive.
+  FilesMappingContainer::Handle m_featuresData;
 
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
@@ -404,9 +431,17 @@ public:
 
   bool HasSearchIndex() { return m_cont.IsExist(SEARCH_INDEX_FILE_TAG); }
   bool HasGeometryIndex() { return m_cont.IsExist(INDEX_FILE_TAG); }
+
+  /// Geometry index which keeps its upper nodes in memory while the value is cached by MwmSet.
+  /// A value is used by one handle at a time, so the index needs no locking.
+  ScaleIndex<ModelReaderPtr> const & GetScaleIndex() const;
+
+private:
+  mutable std::unique_ptr<ScaleIndex<ModelReaderPtr>> m_scaleIndex;
 }; // class MwmValue
 
 
 std::string DebugPrint(MwmSet::RegResult result);
 std::string DebugPrint(MwmSet::Event::Type type);
 std::string DebugPrint(MwmSet::Event const & event);
+std::string DebugPrint(MwmSet::Stats const & stats);
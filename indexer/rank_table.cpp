@@ -120,8 +120,9 @@ public:
       ReverseFreeze(m_coding, writer, "SimpleDenseCoding");
   }
 
-  // Loads RankTableV0 from a raw memory region.
-  static unique_ptr<RankTableV0> Load(unique_ptr<MappedMemoryRegion> && region)
+  // Loads RankTableV0 from a raw immutable memory region, e.g. mapped
+  // or used in place of a mapped container.
+  static unique_ptr<RankTableV0> Load(unique_ptr<MemoryRegion> && region)
   {
     if (!region.get())
       return unique_ptr<RankTableV0>();
@@ -297,6 +298,14 @@ unique_ptr<RankTable> CreateSearchRankTableIfNotExists(FilesContainerR & rcont)
 // static
 unique_ptr<RankTable> RankTable::Load(FilesContainerR const & rcont, string const & sectionName)
 {
+  if (!rcont.IsExist(sectionName))
+    return unique_ptr<RankTable>();
+
+  // Sections of mapped containers are used in place when they don't need
+  // reverse mapping.
+  auto const reader = rcont.GetReader(sectionName);
+  if (CheckEndianness(reader) == CheckResult::EndiannessMatch)
+    return LoadRankTable(CreateMemoryRegion(*reader.GetPtr(), 0 /* pos */, reader.Size()));
   return LoadRankTable(GetMemoryRegionForTag(rcont, sectionName));
 }
 
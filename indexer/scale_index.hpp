@@ -6,6 +6,7 @@
 #include "coding/var_serial_vector.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -62,6 +63,27 @@ public:
     }
   }
 
+  /// Same as ForEachInIntervalAndScale() for each of intervals in [first, last), but
+  /// every tree is traversed once.
+  template <typename It>
+  void ForEachInIntervalsAndScale(It first, It last, int scale,
+                                  std::function<void(uint32_t)> const & fn) const
+  {
+    auto const scaleBucket = BucketByScale(scale);
+    if (scaleBucket < m_IndexForScale.size())
+    {
+      for (size_t i = 0; i <= scaleBucket; ++i)
+        m_IndexForScale[i]->ForEachInIntervals(fn, first, last);
+    }
+  }
+
+  /// See IntervalIndex::EnableNodeCache(), |maxBytes| is for every scale tree.
+  void EnableNodeCache(size_t maxBytes)
+  {
+    for (auto & index : m_IndexForScale)
+      index->EnableNodeCache(maxBytes);
+  }
+
 private:
   std::vector<std::unique_ptr<IntervalIndex<Reader, uint32_t>>> m_IndexForScale;
 };
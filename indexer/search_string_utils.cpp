@@ -44,7 +44,14 @@ void RemoveNumeroSigns(UniString & s)
 
 UniString NormalizeAndSimplifyString(string const & s)
 {
-  UniString uniString = MakeUniString(s);
+  UniString uniString;
+  NormalizeAndSimplifyString(s, uniString);
+  return uniString;
+}
+
+void NormalizeAndSimplifyString(string const & s, UniString & uniString)
+{
+  MakeUniString(s, uniString);
   for (size_t i = 0; i < uniString.size(); ++i)
   {
     UniChar & c = uniString[i];
@@ -101,8 +108,6 @@ UniString NormalizeAndSimplifyString(string const & s)
 
   RemoveNumeroSigns(uniString);
 
-  return uniString;
-
   /// @todo Restore this logic to distinguish и-й in future.
   /*
   // Just after lower casing is a correct place to avoid normalization for specific chars.
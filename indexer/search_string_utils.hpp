@@ -15,6 +15,8 @@ namespace search
 // This function should be used for all search strings normalization.
 // It does some magic text transformation which greatly helps us to improve our search.
 strings::UniString NormalizeAndSimplifyString(std::string const & s);
+// Same as above but writes to |result| and reuses its buffer.
+void NormalizeAndSimplifyString(std::string const & s, strings::UniString & result);
 
 template <class Delims, typename Fn>
 void SplitUniString(strings::UniString const & uniS, Fn && f, Delims const & delims)
@@ -37,6 +37,8 @@ public:
     return m_header.GetGeometryCodingParams(scaleIndex);
   }
 
+  DataHeader::GeometryLayout GetGeometryLayout() const { return m_header.GetGeometryLayout(); }
+
   int GetScalesCount() const { return static_cast<int>(m_header.GetScalesCount()); }
   int GetScale(int i) const { return m_header.GetScale(i); }
   int GetLastScale() const { return m_header.GetLastScale(); }
@@ -7,10 +7,13 @@
 #include "base/buffer_vector.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/parallel.hpp"
+#include "base/task_scheduler.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -230,23 +233,19 @@ void AppendValue(NodeInfo & node, Value const & value)
     LOG(LERROR, ("Cannot append to a finalized value list."));
 }
 
-template <typename Sink, typename Key, typename ValueList, typename Serializer>
-void Build(Sink & sink, Serializer const & serializer,
-           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+// Adds sorted |[begin, end)| to the trie whose unfinished path is |nodes|, nodes[0] is the root.
+template <typename Sink, typename Serializer, typename Nodes, typename It>
+void AddSorted(Sink & sink, Serializer const & serializer, Nodes & nodes, It begin, It end)
 {
-  using Value = typename ValueList::Value;
-  using NodeInfo = NodeInfo<ValueList>;
+  using KeyValuePair = typename std::iterator_traits<It>::value_type;
 
-  std::vector<NodeInfo> nodes;
-  nodes.emplace_back(sink.Pos(), kDefaultChar);
-
-  Key prevKey;
-  std::pair<Key, Value> prevE;  // e for "element".
+  typename KeyValuePair::first_type prevKey;
+  KeyValuePair prevE;  // e for "element".
 
-  for (auto it = data.begin(); it != data.end(); ++it)
+  for (auto it = begin; it != end; ++it)
   {
     auto e = *it;
-    if (it != data.begin() && e == prevE)
+    if (it != begin && e == prevE)
       continue;
 
     auto const & key = e.first;
@@ -265,6 +264,18 @@ void Build(Sink & sink, Serializer const & serializer,
     prevKey = key;
     std::swap(e, prevE);
   }
+}
+
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void Build(Sink & sink, Serializer const & serializer,
+           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+{
+  using NodeInfo = NodeInfo<ValueList>;
+
+  std::vector<NodeInfo> nodes;
+  nodes.emplace_back(sink.Pos(), kDefaultChar);
+
+  AddSorted(sink, serializer, nodes, data.begin(), data.end());
 
   // Pop all the nodes from the stack.
   PopNodes(sink, serializer, nodes, nodes.size() - 1);
@@ -272,4 +283,55 @@ void Build(Sink & sink, Serializer const & serializer,
   // Write the root.
   WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, nodes.back(), true /* isRoot */);
 }
+
+// The same as Build() but the subtrees of the root's children, i.e. keys with different first
+// chars, are built concurrently in memory and then written to |sink| in order. The result is
+// identical to the one of Build().
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void ParallelBuild(Sink & sink, Serializer const & serializer,
+                   std::vector<std::pair<Key, typename ValueList::Value>> const & data,
+                   base::TaskScheduler & scheduler = base::TaskScheduler::Instance())
+{
+  using NodeInfo = NodeInfo<ValueList>;
+  using Buffer = std::vector<uint8_t>;
+  using It = typename std::vector<std::pair<Key, typename ValueList::Value>>::const_iterator;
+
+  std::vector<NodeInfo> nodes;
+  nodes.emplace_back(sink.Pos(), kDefaultChar);
+
+  // Values of the empty key belong to the root.
+  auto it = std::find_if(data.begin(), data.end(), [](auto const & e) { return !e.first.empty(); });
+  AddSorted(sink, serializer, nodes, data.begin(), it);
+
+  std::vector<std::pair<It, It>> ranges;
+  while (it != data.end())
+  {
+    auto const c = it->first[0];
+    CHECK(ranges.empty() || ranges.back().first->first[0] < c, ("Data must be sorted."));
+    auto const next = std::find_if(it, data.end(), [c](auto const & e) { return e.first[0] != c; });
+    ranges.emplace_back(it, next);
+    it = next;
+  }
+
+  std::vector<Buffer> buffers(ranges.size());
+  std::vector<std::vector<ChildInfo>> children(ranges.size());
+  base::ParallelFor(0, ranges.size(), [&](size_t i) {
+    PushBackByteSink<Buffer> subtreeSink(buffers[i]);
+    std::vector<NodeInfo> subtreeNodes;
+    subtreeNodes.emplace_back(0 /* pos */, kDefaultChar);
+    AddSorted(subtreeSink, serializer, subtreeNodes, ranges[i].first, ranges[i].second);
+    PopNodes(subtreeSink, serializer, subtreeNodes, subtreeNodes.size() - 1);
+    children[i] = std::move(subtreeNodes.back().m_children);
+  }, 1 /* minChunkSize */, scheduler);
+
+  auto & root = nodes.back();
+  for (size_t i = 0; i < ranges.size(); ++i)
+  {
+    sink.Write(buffers[i].data(), buffers[i].size());
+    Buffer().swap(buffers[i]);
+    root.m_children.insert(root.m_children.end(), children[i].begin(), children[i].end());
+  }
+
+  WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, root, true /* isRoot */);
+}
 }  // namespace trie
@@ -6,6 +6,8 @@
 
 using namespace std;
 
+uint32_t constexpr IndexAndTypeMapping::kInvalidIndex;
+
 void IndexAndTypeMapping::Clear()
 {
   m_types.clear();
@@ -35,6 +37,13 @@ void IndexAndTypeMapping::Load(istream & s)
   }
 }
 
+void IndexAndTypeMapping::Load(vector<uint32_t> const & types)
+{
+  Clear();
+  for (uint32_t ind = 0; ind < types.size(); ++ind)
+    Add(ind, types[ind]);
+}
+
 void IndexAndTypeMapping::Add(uint32_t ind, uint32_t type)
 {
   ASSERT_EQUAL ( ind, m_types.size(), () );
@@ -49,3 +58,9 @@ uint32_t IndexAndTypeMapping::GetIndex(uint32_t t) const
   CHECK ( i != m_map.end(), (t, classif().GetFullObjectName(t)) );
   return i->second;
 }
+
+uint32_t IndexAndTypeMapping::FindIndex(uint32_t t) const
+{
+  Map::const_iterator i = m_map.find(t);
+  return i != m_map.end() ? i->second : kInvalidIndex;
+}
@@ -3,15 +3,21 @@
 
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 
 class IndexAndTypeMapping
 {
 public:
+  static uint32_t constexpr kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
   void Clear();
   void Load(std::istream & s);
+  /// Loads the mapping of the indexes to |types|.
+  void Load(std::vector<uint32_t> const & types);
   bool IsLoaded() const { return !m_types.empty(); }
 
   // Throws std::out_of_range exception.
@@ -22,12 +28,15 @@ public:
   }
 
   uint32_t GetIndex(uint32_t t) const;
+  /// @returns kInvalidIndex if |t| isn't mapped.
+  uint32_t FindIndex(uint32_t t) const;
+  uint32_t GetTypesCount() const { return static_cast<uint32_t>(m_types.size()); }
 
   /// For Debug purposes only.
   bool HasIndex(uint32_t t) const { return (m_map.find(t) != m_map.end()); }
 
 private:
-  using Map = std::map<uint32_t, uint32_t>;
+  using Map = std::unordered_map<uint32_t, uint32_t>;
   void Add(uint32_t ind, uint32_t type);
 
   std::vector<uint32_t> m_types;
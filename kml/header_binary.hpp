@@ -10,8 +10,20 @@ namespace kml
 {
 namespace binary
 {
+enum class Version : uint8_t
+{
+  V0 = 0,
+  V1 = 1, // 11th April 2018 (new Point2D storage, added deviceId, feature name -> custom name).
+  V2 = 2, // 25th April 2018 (added serverId).
+  V3 = 3, // 7th May 2018 (persistent feature types).
+  V4 = 4, // 15th October 2018 (offsets index of bookmarks and tracks).
+  Latest = V4
+};
+
 struct Header
 {
+  explicit Header(Version version = Version::Latest) : m_version(version) {}
+
   template <typename Visitor>
   void Visit(Visitor & visitor)
   {
@@ -19,6 +31,8 @@ struct Header
     visitor(m_bookmarksOffset, "bookmarksOffset");
     visitor(m_tracksOffset, "tracksOffset");
     visitor(m_stringsOffset, "stringsOffset");
+    if (m_version >= Version::V4)
+      visitor(m_indexOffset, "indexOffset");
     visitor(m_eosOffset, "eosOffset");
   }
 
@@ -44,10 +58,12 @@ struct Header
     return visitor.m_size;
   }
 
+  Version m_version;
   uint64_t m_categoryOffset = 0;
   uint64_t m_bookmarksOffset = 0;
   uint64_t m_tracksOffset = 0;
   uint64_t m_stringsOffset = 0;
+  uint64_t m_indexOffset = 0;
   uint64_t m_eosOffset = 0;
 };
 }  // namespace binary
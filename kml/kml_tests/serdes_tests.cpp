@@ -125,6 +125,49 @@ char const * kTextKml =
     "</kml>";
 
 std::vector<uint8_t> const kBinKml = {
+  0x04, 0x00, 0x00, 0x1E, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF6, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x68, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6E, 0x02, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x02, 0x01, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0xB7, 0xF5, 0x71,
+  0xFC, 0x8C, 0xFC, 0xC0, 0x02, 0x00, 0x03, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x04, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3,
+  0xC2, 0xFB, 0xF9, 0x01, 0xE3, 0xB9, 0xBB, 0x8E, 0x01, 0xC3, 0xC5, 0xD2, 0xBB, 0x02, 0x00, 0x03,
+  0x01, 0x00, 0x05, 0x01, 0x00, 0x06, 0x01, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB8, 0xBC, 0xED, 0xA7, 0x03, 0x97,
+  0xB0, 0x9A, 0xA7, 0x02, 0xA4, 0xD6, 0xAE, 0xDB, 0x02, 0x00, 0x03, 0x01, 0x00, 0x08, 0x00, 0x01,
+  0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x9C, 0xCD, 0x97, 0xA7, 0x02, 0xFD, 0xC1, 0xAC, 0xDB, 0x02, 0x00, 0x03,
+  0x01, 0x00, 0x0A, 0x01, 0x00, 0x0B, 0x01, 0x00, 0x0C, 0x00, 0x6F, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x07, 0x0E, 0x08, 0x08, 0x1B, 0x1A, 0x1B, 0x41, 0x41, 0x0C, 0x11, 0x0C, 0x37,
+  0x3E, 0x00, 0x01, 0x00, 0x01, 0x06, 0x01, 0x03, 0x09, 0x03, 0x05, 0x05, 0x07, 0x07, 0x07, 0x41,
+  0x09, 0x06, 0x0A, 0x0B, 0x08, 0x8D, 0x01, 0x0D, 0x07, 0x10, 0x0F, 0x08, 0x71, 0x11, 0x05, 0x02,
+  0x13, 0x06, 0x04, 0x15, 0x06, 0x0B, 0x17, 0x07, 0x5E, 0x19, 0x05, 0x0D, 0x1B, 0x07, 0xBA, 0x01,
+  0x1D, 0x08, 0x1C, 0x1F, 0x06, 0x75, 0x21, 0x06, 0x06, 0x23, 0x06, 0x09, 0x27, 0x08, 0x4E, 0x29,
+  0x06, 0x12, 0x2B, 0x07, 0x91, 0x01, 0x2D, 0x08, 0x14, 0x2F, 0x07, 0x73, 0x33, 0x06, 0x05, 0x35,
+  0x07, 0x0C, 0x37, 0x08, 0x63, 0x3B, 0x07, 0xC0, 0x01, 0x3D, 0x08, 0x31, 0x3F, 0x07, 0x77, 0x43,
+  0x07, 0x08, 0x47, 0x08, 0x48, 0x4B, 0x08, 0x90, 0x01, 0x4D, 0x07, 0x13, 0x4F, 0x07, 0x72, 0x57,
+  0x07, 0x62, 0x5B, 0x07, 0xBD, 0x01, 0x5D, 0x07, 0x29, 0x67, 0x07, 0x57, 0x6B, 0x08, 0xA1, 0x01,
+  0x6D, 0x08, 0x18, 0x6F, 0x08, 0x76, 0x75, 0x07, 0x0F, 0x77, 0x07, 0x68, 0x7B, 0x07, 0xD1, 0x01,
+  0x7D, 0x08, 0x3F, 0x7F, 0x07, 0x79, 0x83, 0x01, 0x08, 0xB8, 0x01, 0x8B, 0x01, 0x08, 0x8F, 0x01,
+  0x8F, 0x01, 0x08, 0x74, 0x9D, 0x01, 0x08, 0x25, 0xA7, 0x01, 0x08, 0x59, 0xAD, 0x01, 0x08, 0x17,
+  0xB7, 0x01, 0x08, 0x6D, 0xBD, 0x01, 0x08, 0x3E, 0xC7, 0x01, 0x08, 0x4B, 0xCB, 0x01, 0x08, 0x96,
+  0x01, 0xEB, 0x01, 0x08, 0xB7, 0x01, 0xED, 0x01, 0x08, 0x19, 0xEF, 0x01, 0x08, 0x8A, 0x01, 0xFD,
+  0x01, 0x08, 0x40, 0x83, 0x02, 0x09, 0x0E, 0xA0, 0x02, 0xAF, 0x13, 0xE7, 0xEE, 0xAD, 0x1B, 0x51,
+  0x0F, 0x7D, 0x02, 0x8B, 0xBA, 0xDC, 0x17, 0x6C, 0x0C, 0xE8, 0x3F, 0xF4, 0x7A, 0x70, 0x54, 0x0E,
+  0x25, 0xE5, 0x6D, 0xFE, 0x26, 0xE1, 0xCF, 0xD5, 0xB1, 0x7A, 0xD1, 0x32, 0x1C, 0x8A, 0x5F, 0x54,
+  0xDA, 0xC4, 0x56, 0x9F, 0xFC, 0x54, 0x5C, 0x8A, 0x49, 0x94, 0x65, 0x55, 0x23, 0x49, 0x43, 0x2F,
+  0xE7, 0x51, 0xAE, 0x19, 0xFD, 0x9B, 0xCC, 0x95, 0xE7, 0x2C, 0xCB, 0xDF, 0xCF, 0x74, 0x1A, 0x01,
+  0x0C, 0x4D, 0x54, 0x52, 0x77, 0xB5, 0x8B, 0x51, 0xB3, 0x3C, 0x22, 0x31, 0x30, 0xD4, 0x5E, 0x8D,
+  0x41, 0x3D, 0x11, 0x88, 0x0D, 0xF3, 0x64, 0x9E, 0xFF, 0xD7, 0x70, 0x0F, 0x00, 0x80, 0x3D, 0x00,
+  0x00, 0x00, 0x80, 0x0E, 0xB0, 0x45, 0xA7, 0x9D, 0x65, 0x6B, 0x78, 0xC7, 0xC6, 0xBA, 0x2D, 0x46,
+  0x83, 0x76, 0x08, 0xAC, 0x14, 0x4B, 0x56, 0xA2, 0x09, 0x01, 0x00, 0x0D, 0x04, 0x01, 0x24, 0x2B,
+  0x29, 0x00
+};
+
+std::vector<uint8_t> const kBinKmlV3 = {
   0x03, 0x00, 0x00, 0x1E, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0xED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x00, 0x00, 0x00,
   0x00, 0x00, 0x00, 0x00, 0x60, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
@@ -664,3 +707,63 @@ UNIT_TEST(Kml_Serialization_Text_File)
   }
   TEST_EQUAL(dataFromMemory, data, ());
 }
+
+// 8. Check deserialization of the previous binary version.
+UNIT_TEST(Kml_Deserialization_Bin_V3)
+{
+  kml::FileData dataFromV3;
+  {
+    kml::binary::DeserializerKml des(dataFromV3);
+    MemReader reader(kBinKmlV3.data(), kBinKmlV3.size());
+    des.Deserialize(reader);
+  }
+
+  kml::FileData dataFromBin;
+  {
+    kml::binary::DeserializerKml des(dataFromBin);
+    MemReader reader(kBinKml.data(), kBinKml.size());
+    des.Deserialize(reader);
+  }
+
+  TEST_EQUAL(dataFromV3, dataFromBin, ());
+}
+
+// 9. Check reading of the separate parts of the binary data.
+UNIT_TEST(Kml_Deserialization_Bin_Lazy)
+{
+  kml::FileData data;
+  {
+    kml::binary::DeserializerKml des(data);
+    MemReader reader(kBinKml.data(), kBinKml.size());
+    des.Deserialize(reader);
+  }
+
+  MemReader reader(kBinKml.data(), kBinKml.size());
+  kml::binary::LazyDeserializerKml des(reader);
+  TEST_EQUAL(des.GetDeviceId(), data.m_deviceId, ());
+  TEST_EQUAL(des.GetServerId(), data.m_serverId, ());
+  TEST_EQUAL(des.GetBookmarksCount(), data.m_bookmarksData.size(), ());
+  TEST_EQUAL(des.GetTracksCount(), data.m_tracksData.size(), ());
+
+  kml::CategoryData categoryData;
+  des.DeserializeCategory(categoryData);
+  TEST_EQUAL(categoryData, data.m_categoryData, ());
+
+  // Items are read in the reversed order to check random access.
+  for (size_t i = des.GetBookmarksCount(); i > 0; --i)
+  {
+    kml::BookmarkData bookmarkData;
+    des.DeserializeBookmark(i - 1, bookmarkData);
+    TEST_EQUAL(bookmarkData, data.m_bookmarksData[i - 1], ());
+  }
+  for (size_t i = des.GetTracksCount(); i > 0; --i)
+  {
+    kml::TrackData trackData;
+    des.DeserializeTrack(i - 1, trackData);
+    TEST_EQUAL(trackData, data.m_tracksData[i - 1], ());
+  }
+
+  MemReader readerV3(kBinKmlV3.data(), kBinKmlV3.size());
+  TEST_THROW(kml::binary::LazyDeserializerKml desV3(readerV3),
+             kml::binary::LazyDeserializerKml::DeserializeException, ());
+}
@@ -1,5 +1,7 @@
 #include "kml/serdes_binary.hpp"
 
+#include <type_traits>
+
 namespace kml
 {
 namespace binary
@@ -34,5 +36,80 @@ DeserializerKml::DeserializerKml(FileData & data)
 {
   m_data = {};
 }
+
+LazyDeserializerKml::LazyDeserializerKml(Reader const & reader)
+{
+  NonOwningReaderSource source(reader);
+  auto const v = ReadPrimitiveFromSource<Version>(source);
+  if (v < Version::V4 || v > Version::Latest)
+    MYTHROW(DeserializeException, ("Incorrect file version for lazy reading."));
+
+  rw::Read(source, m_deviceId);
+  rw::Read(source, m_serverId);
+
+  m_doubleBits = ReadPrimitiveFromSource<uint8_t>(source);
+  if (m_doubleBits == 0 || m_doubleBits > 32)
+    MYTHROW(DeserializeException, ("Incorrect double bits count: ", m_doubleBits));
+
+  m_reader = reader.CreateSubReader(source.Pos(), source.Size());
+  {
+    NonOwningReaderSource headerSource(*m_reader);
+    m_header = Header(v);
+    m_header.Deserialize(headerSource);
+  }
+
+  auto const createSubReader = [this](uint64_t startPos, uint64_t endPos) {
+    if (startPos > endPos || endPos > m_reader->Size())
+      MYTHROW(DeserializeException, ("Incorrect section offsets."));
+    return m_reader->CreateSubReader(startPos, endPos - startPos);
+  };
+  m_categoryReader = createSubReader(m_header.m_categoryOffset, m_header.m_bookmarksOffset);
+  m_bookmarksReader = createSubReader(m_header.m_bookmarksOffset, m_header.m_tracksOffset);
+  m_tracksReader = createSubReader(m_header.m_tracksOffset, m_header.m_stringsOffset);
+  m_stringsReader = createSubReader(m_header.m_stringsOffset, m_header.m_indexOffset);
+  m_strings = std::make_unique<coding::BlockedTextStorage<Reader>>(*m_stringsReader);
+
+  auto const indexReader = createSubReader(m_header.m_indexOffset, m_header.m_eosOffset);
+  NonOwningReaderSource indexSource(*indexReader);
+  ReadOffsets(indexSource, m_bookmarksOffsets);
+  ReadOffsets(indexSource, m_tracksOffsets);
+}
+
+void LazyDeserializerKml::DeserializeCategory(CategoryData & data)
+{
+  DeserializeItem(*m_categoryReader, 0 /* offset */, data);
+}
+
+void LazyDeserializerKml::DeserializeBookmark(size_t index, BookmarkData & data)
+{
+  CHECK_LESS(index, m_bookmarksOffsets.size(), ());
+  DeserializeItem(*m_bookmarksReader, m_bookmarksOffsets[index], data);
+}
+
+void LazyDeserializerKml::DeserializeTrack(size_t index, TrackData & data)
+{
+  CHECK_LESS(index, m_tracksOffsets.size(), ());
+  DeserializeItem(*m_tracksReader, m_tracksOffsets[index], data);
+}
+
+template <typename T>
+void LazyDeserializerKml::DeserializeItem(Reader const & reader, uint64_t offset, T & data)
+{
+  data = {};
+  NonOwningReaderSource src(reader);
+  src.Skip(offset);
+  // The category is stored in its own format.
+  using Visitor = std::conditional_t<std::is_same<T, CategoryData>::value,
+                                     CategoryDeserializerVisitor<decltype(src)>,
+                                     BookmarkDeserializerVisitor<decltype(src)>>;
+  Visitor visitor(src, m_doubleBits);
+  visitor(data);
+
+  DeserializedStringCollector<Reader> collector(*m_strings);
+  CollectorVisitor<decltype(collector)> collectorVisitor(collector);
+  collectorVisitor(data);
+  CollectorVisitor<decltype(collector)> clearVisitor(collector, true /* clear index */);
+  clearVisitor(data);
+}
 }  // namespace binary
 }  // namespace kml
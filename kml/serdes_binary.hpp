@@ -10,6 +10,8 @@
 
 #include "platform/platform.hpp"
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -17,14 +19,31 @@ namespace kml
 {
 namespace binary
 {
-enum class Version : uint8_t
+// Offsets of the items are written as deltas, they are relative to the start of the section.
+template <typename Sink>
+void WriteOffsets(Sink & sink, std::vector<uint64_t> const & offsets)
 {
-  V0 = 0,
-  V1 = 1, // 11th April 2018 (new Point2D storage, added deviceId, feature name -> custom name).
-  V2 = 2, // 25th April 2018 (added serverId).
-  V3 = 3, // 7th May 2018 (persistent feature types).
-  Latest = V3
-};
+  WriteVarUint(sink, static_cast<uint32_t>(offsets.size()));
+  uint64_t prev = 0;
+  for (auto const offset : offsets)
+  {
+    WriteVarUint(sink, offset - prev);
+    prev = offset;
+  }
+}
+
+template <typename Source>
+void ReadOffsets(Source & source, std::vector<uint64_t> & offsets)
+{
+  auto const sz = ReadVarUint<uint32_t, Source>(source);
+  offsets.reserve(sz);
+  uint64_t prev = 0;
+  for (uint32_t i = 0; i < sz; ++i)
+  {
+    prev += ReadVarUint<uint64_t, Source>(source);
+    offsets.push_back(prev);
+  }
+}
 
 class SerializerKml
 {
@@ -79,6 +98,10 @@ public:
     header.m_stringsOffset = sink.Pos() - startPos;
     SerializeStrings(sink);
 
+    // Serialize offsets of bookmarks and tracks.
+    header.m_indexOffset = sink.Pos() - startPos;
+    SerializeIndex(sink);
+
     // Fill header.
     header.m_eosOffset = sink.Pos() - startPos;
     sink.Seek(startPos);
@@ -96,15 +119,13 @@ public:
   template <typename Sink>
   void SerializeBookmarks(Sink & sink)
   {
-    BookmarkSerializerVisitor<Sink> visitor(sink, kDoubleBits);
-    visitor(m_data.m_bookmarksData);
+    SerializeItems(sink, m_data.m_bookmarksData, m_bookmarksOffsets);
   }
 
   template <typename Sink>
   void SerializeTracks(Sink & sink)
   {
-    BookmarkSerializerVisitor<Sink> visitor(sink, kDoubleBits);
-    visitor(m_data.m_tracksData);
+    SerializeItems(sink, m_data.m_tracksData, m_tracksOffsets);
   }
 
   // Serializes texts in a compressed storage with block access.
@@ -116,9 +137,36 @@ public:
       writer.Append(str);
   }
 
+  // Serializes offsets of bookmarks and tracks, so they can be read one by one.
+  template <typename Sink>
+  void SerializeIndex(Sink & sink)
+  {
+    WriteOffsets(sink, m_bookmarksOffsets);
+    WriteOffsets(sink, m_tracksOffsets);
+  }
+
 private:
+  // Writes the same data as BookmarkSerializerVisitor does for the vector and remembers
+  // offsets of the items.
+  template <typename Sink, typename T>
+  void SerializeItems(Sink & sink, std::vector<T> const & items, std::vector<uint64_t> & offsets)
+  {
+    auto const startPos = sink.Pos();
+    BookmarkSerializerVisitor<Sink> visitor(sink, kDoubleBits);
+    WriteVarUint(sink, static_cast<uint32_t>(items.size()));
+    offsets.clear();
+    offsets.reserve(items.size());
+    for (auto const & item : items)
+    {
+      offsets.push_back(sink.Pos() - startPos);
+      visitor(item);
+    }
+  }
+
   FileData & m_data;
   std::vector<std::string> m_strings;
+  std::vector<uint64_t> m_bookmarksOffsets;
+  std::vector<uint64_t> m_tracksOffsets;
 };
 
 class DeserializerKml
@@ -135,7 +183,7 @@ public:
     NonOwningReaderSource source(reader);
     auto const v = ReadPrimitiveFromSource<Version>(source);
 
-    if (v != Version::Latest && v != Version::V2)
+    if (v != Version::Latest && v != Version::V3 && v != Version::V2)
       MYTHROW(DeserializeException, ("Incorrect file version."));
 
     // Read device id.
@@ -158,7 +206,7 @@ public:
       MYTHROW(DeserializeException, ("Incorrect double bits count: ", m_doubleBits));
 
     auto subReader = reader.CreateSubReader(source.Pos(), source.Size());
-    InitializeIfNeeded(*subReader);
+    InitializeIfNeeded(*subReader, v);
 
     // Deserialize category.
     {
@@ -206,12 +254,13 @@ public:
 
 private:
   template <typename ReaderType>
-  void InitializeIfNeeded(ReaderType const & reader)
+  void InitializeIfNeeded(ReaderType const & reader, Version version)
   {
     if (m_initialized)
       return;
 
     NonOwningReaderSource source(reader);
+    m_header = Header(version);
     m_header.Deserialize(source);
     m_initialized = true;
   }
@@ -247,7 +296,9 @@ private:
   template <typename ReaderType>
   std::unique_ptr<Reader> CreateStringsSubReader(ReaderType const & reader)
   {
-    return CreateSubReader(reader, m_header.m_stringsOffset, m_header.m_eosOffset);
+    auto const endPos =
+        m_header.m_version >= Version::V4 ? m_header.m_indexOffset : m_header.m_eosOffset;
+    return CreateSubReader(reader, m_header.m_stringsOffset, endPos);
   }
 
   FileData & m_data;
@@ -255,5 +306,42 @@ private:
   uint8_t m_doubleBits = 0;
   bool m_initialized = false;
 };
+
+// Reads the parts of a binary file on demand: the category, separate bookmarks and tracks.
+// Only the strings of the read items are unpacked. The file must be of V4 or later version,
+// |reader| (e.g. MmapReader) must outlive the deserializer.
+class LazyDeserializerKml
+{
+public:
+  using DeserializeException = DeserializerKml::DeserializeException;
+
+  explicit LazyDeserializerKml(Reader const & reader);
+
+  std::string const & GetDeviceId() const { return m_deviceId; }
+  std::string const & GetServerId() const { return m_serverId; }
+  size_t GetBookmarksCount() const { return m_bookmarksOffsets.size(); }
+  size_t GetTracksCount() const { return m_tracksOffsets.size(); }
+
+  void DeserializeCategory(CategoryData & data);
+  void DeserializeBookmark(size_t index, BookmarkData & data);
+  void DeserializeTrack(size_t index, TrackData & data);
+
+private:
+  template <typename T>
+  void DeserializeItem(Reader const & reader, uint64_t offset, T & data);
+
+  std::string m_deviceId;
+  std::string m_serverId;
+  uint8_t m_doubleBits = 0;
+  Header m_header;
+  std::unique_ptr<Reader> m_reader;
+  std::unique_ptr<Reader> m_categoryReader;
+  std::unique_ptr<Reader> m_bookmarksReader;
+  std::unique_ptr<Reader> m_tracksReader;
+  std::unique_ptr<Reader> m_stringsReader;
+  std::unique_ptr<coding::BlockedTextStorage<Reader>> m_strings;
+  std::vector<uint64_t> m_bookmarksOffsets;
+  std::vector<uint64_t> m_tracksOffsets;
+};
 }  // namespace binary
 }  // namespace kml
@@ -1,5 +1,8 @@
 #include "map/benchmark_tools.hpp"
+#include "map/everywhere_search_params.hpp"
 #include "map/framework.hpp"
+#include "map/routing_manager.hpp"
+#include "map/routing_mark.hpp"
 
 #include "drape_frontend/drape_measurer.hpp"
 #include "drape_frontend/scenario_manager.hpp"
@@ -12,12 +15,19 @@
 #include "coding/file_name_utils.hpp"
 #include "coding/reader.hpp"
 
+#include "routing/router.hpp"
+
 #include "geometry/mercator.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include "3party/jansson/myjansson.hpp"
 
 #include <algorithm>
 #include <atomic>
+#include <fstream>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -75,6 +85,265 @@ void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
     });
   });
 }
+struct SearchMeasurement
+{
+  std::string m_query;
+  std::string m_locale;
+  double m_seconds = 0.0;
+  size_t m_resultsCount = 0;
+};
+
+struct RouteMeasurement
+{
+  routing::RouterType m_router = routing::RouterType::Vehicle;
+  m2::PointD m_from;
+  m2::PointD m_to;
+  double m_seconds = 0.0;
+  routing::RouterResultCode m_code = routing::RouterResultCode::NoError;
+};
+
+struct PlacePageMeasurement
+{
+  m2::PointD m_point;
+  double m_seconds = 0.0;
+};
+
+// Scenarios of the framework benchmark, they are run one by one from the gui thread and
+// every scenario fills its measurement.
+struct FrameworkBenchmarkHandle
+{
+  std::vector<SearchMeasurement> m_searches;
+  size_t m_currentSearch = 0;
+  std::vector<RouteMeasurement> m_routes;
+  size_t m_currentRoute = 0;
+  RoutingManager::RouteBuildingCallback m_routeBuildingListener;
+  std::vector<PlacePageMeasurement> m_placePages;
+};
+
+m2::PointD ReadPoint(json_t * node)
+{
+  double lat = 0.0, lon = 0.0;
+  FromJSONObject(node, "lat", lat);
+  FromJSONObject(node, "lon", lon);
+  return MercatorBounds::FromLatLon(lat, lon);
+}
+
+base::JSONPtr PointToJSON(m2::PointD const & pt)
+{
+  auto const latLon = MercatorBounds::ToLatLon(pt);
+  auto node = base::NewJSONObject();
+  ToJSONObject(*node, "lat", latLon.lat);
+  ToJSONObject(*node, "lon", latLon.lon);
+  return node;
+}
+
+bool ParseFrameworkBenchmark(std::string const & data, FrameworkBenchmarkHandle & handle)
+{
+  try
+  {
+    base::Json root(data.c_str());
+
+    json_t * searchNode = json_object_get(root.get(), "search");
+    if (searchNode != nullptr && json_is_array(searchNode))
+    {
+      for (size_t i = 0; i < json_array_size(searchNode); ++i)
+      {
+        SearchMeasurement search;
+        auto * elem = json_array_get(searchNode, i);
+        FromJSONObject(elem, "query", search.m_query);
+        FromJSONObjectOptionalField(elem, "locale", search.m_locale);
+        handle.m_searches.push_back(std::move(search));
+      }
+    }
+
+    json_t * routesNode = json_object_get(root.get(), "routes");
+    if (routesNode != nullptr && json_is_array(routesNode))
+    {
+      for (size_t i = 0; i < json_array_size(routesNode); ++i)
+      {
+        RouteMeasurement route;
+        auto * elem = json_array_get(routesNode, i);
+        std::string router;
+        FromJSONObjectOptionalField(elem, "router", router);
+        if (!router.empty())
+          route.m_router = routing::FromString(router);
+        route.m_from = ReadPoint(base::GetJSONObligatoryField(elem, "from"));
+        route.m_to = ReadPoint(base::GetJSONObligatoryField(elem, "to"));
+        handle.m_routes.push_back(route);
+      }
+    }
+
+    json_t * placePagesNode = json_object_get(root.get(), "placePages");
+    if (placePagesNode != nullptr && json_is_array(placePagesNode))
+    {
+      for (size_t i = 0; i < json_array_size(placePagesNode); ++i)
+      {
+        PlacePageMeasurement placePage;
+        placePage.m_point = ReadPoint(json_array_get(placePagesNode, i));
+        handle.m_placePages.push_back(placePage);
+      }
+    }
+  }
+  catch (base::Json::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't parse framework benchmark:", e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+void WriteFrameworkBenchmarkResults(Framework * framework, FrameworkBenchmarkHandle const & handle)
+{
+  auto const & startup = framework->GetStartupMeasurements();
+
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "cold_start", startup.IsColdStart());
+
+  auto startupNode = base::NewJSONObject();
+  for (auto const & phase : startup.GetPhases())
+    ToJSONObject(*startupNode, phase.first, phase.second);
+  ToJSONObject(*root, "startup", startupNode);
+
+  auto searchNode = base::NewJSONArray();
+  for (auto const & search : handle.m_searches)
+  {
+    auto node = base::NewJSONObject();
+    ToJSONObject(*node, "query", search.m_query);
+    ToJSONObject(*node, "seconds", search.m_seconds);
+    ToJSONObject(*node, "results", search.m_resultsCount);
+    ToJSONArray(*searchNode, node);
+  }
+  ToJSONObject(*root, "search", searchNode);
+
+  auto routesNode = base::NewJSONArray();
+  for (auto const & route : handle.m_routes)
+  {
+    auto node = base::NewJSONObject();
+    ToJSONObject(*node, "router", routing::ToString(route.m_router));
+    ToJSONObject(*node, "from", PointToJSON(route.m_from));
+    ToJSONObject(*node, "to", PointToJSON(route.m_to));
+    ToJSONObject(*node, "seconds", route.m_seconds);
+    ToJSONObject(*node, "code", DebugPrint(route.m_code));
+    ToJSONArray(*routesNode, node);
+  }
+  ToJSONObject(*root, "routes", routesNode);
+
+  auto placePagesNode = base::NewJSONArray();
+  for (auto const & placePage : handle.m_placePages)
+  {
+    auto node = PointToJSON(placePage.m_point);
+    ToJSONObject(*node, "seconds", placePage.m_seconds);
+    ToJSONArray(*placePagesNode, node);
+  }
+  ToJSONObject(*root, "place_pages", placePagesNode);
+
+  std::unique_ptr<char, JSONFreeDeleter> buffer(
+      json_dumps(root.get(), JSON_INDENT(2) | JSON_PRESERVE_ORDER));
+
+  auto const path = base::JoinPath(GetPlatform().WritableDir(), "framework_benchmark_results.json");
+  std::ofstream output(path);
+  output << buffer.get() << '\n';
+  if (!output)
+  {
+    LOG(LWARNING, ("Can't write framework benchmark results to", path));
+    return;
+  }
+  LOG(LINFO, ("Framework benchmark results are written to", path));
+}
+
+void RunPlacePages(Framework * framework, std::shared_ptr<FrameworkBenchmarkHandle> handle)
+{
+  // Place page info is built and shown synchronously, the time includes the notification of UI.
+  for (auto & placePage : handle->m_placePages)
+  {
+    base::Timer timer;
+    framework->ShowFeatureByMercator(placePage.m_point);
+    placePage.m_seconds = timer.ElapsedSeconds();
+    framework->DeactivateMapSelection(true /* notifyUI */);
+  }
+
+  WriteFrameworkBenchmarkResults(framework, *handle);
+}
+
+void RunRoute(Framework * framework, std::shared_ptr<FrameworkBenchmarkHandle> handle)
+{
+  auto & routingManager = framework->GetRoutingManager();
+  if (handle->m_currentRoute >= handle->m_routes.size())
+  {
+    routingManager.SetRouteBuildingListener(handle->m_routeBuildingListener);
+    RunPlacePages(framework, handle);
+    return;
+  }
+
+  auto const & route = handle->m_routes[handle->m_currentRoute];
+  routingManager.SetRouter(route.m_router);
+  routingManager.RemoveRoutePoints();
+
+  RouteMarkData start;
+  start.m_pointType = RouteMarkType::Start;
+  start.m_position = route.m_from;
+  routingManager.AddRoutePoint(std::move(start));
+
+  RouteMarkData finish;
+  finish.m_pointType = RouteMarkType::Finish;
+  finish.m_position = route.m_to;
+  routingManager.AddRoutePoint(std::move(finish));
+
+  auto timer = std::make_shared<base::Timer>();
+  routingManager.SetRouteBuildingListener(
+      [framework, handle, timer](routing::RouterResultCode code, storage::TCountriesVec const &)
+  {
+    auto & route = handle->m_routes[handle->m_currentRoute];
+    route.m_seconds = timer->ElapsedSeconds();
+    route.m_code = code;
+    GetPlatform().RunTask(Platform::Thread::Gui, [framework, handle]()
+    {
+      framework->GetRoutingManager().CloseRouting(true /* removeRoutePoints */);
+      handle->m_currentRoute++;
+      RunRoute(framework, handle);
+    });
+  });
+  routingManager.BuildRoute(0 /* timeoutSec */);
+}
+
+void RunSearch(Framework * framework, std::shared_ptr<FrameworkBenchmarkHandle> handle)
+{
+  if (handle->m_currentSearch >= handle->m_searches.size())
+  {
+    handle->m_routeBuildingListener = framework->GetRoutingManager().GetRouteBuildingListener();
+    RunRoute(framework, handle);
+    return;
+  }
+
+  auto const & search = handle->m_searches[handle->m_currentSearch];
+  auto timer = std::make_shared<base::Timer>();
+
+  search::EverywhereSearchParams params;
+  params.m_query = search.m_query;
+  params.m_inputLocale = search.m_locale;
+  params.m_onResults = [framework, handle, timer](search::Results const & results,
+                                                  std::vector<search::ProductInfo> const &)
+  {
+    if (!results.IsEndMarker())
+      return;
+
+    auto & search = handle->m_searches[handle->m_currentSearch];
+    search.m_seconds = timer->ElapsedSeconds();
+    search.m_resultsCount = results.GetCount();
+    GetPlatform().RunTask(Platform::Thread::Gui, [framework, handle]()
+    {
+      handle->m_currentSearch++;
+      RunSearch(framework, handle);
+    });
+  };
+
+  if (!framework->SearchEverywhere(params))
+  {
+    LOG(LWARNING, ("Search", search.m_query, "is not started"));
+    handle->m_currentSearch++;
+    RunSearch(framework, handle);
+  }
+}
 }  // namespace
 
 namespace benchmark
@@ -203,4 +472,28 @@ void RunGraphicsBenchmark(Framework * framework)
   RunScenario(framework, handle);
 #endif
 }
+
+void RunFrameworkBenchmark(Framework * framework)
+{
+  auto const fn = base::JoinPath(GetPlatform().SettingsDir(), "framework_benchmark.json");
+  if (!GetPlatform().IsFileExistsByFullPath(fn))
+    return;
+
+  std::string benchmarkData;
+  try
+  {
+    ReaderPtr<Reader>(GetPlatform().GetReader(fn)).ReadAsString(benchmarkData);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Error reading framework benchmark file:", e.what()));
+    return;
+  }
+
+  auto handle = std::make_shared<FrameworkBenchmarkHandle>();
+  if (!ParseFrameworkBenchmark(benchmarkData, *handle))
+    return;
+
+  RunSearch(framework, handle);
+}
 }  // namespace benchmark
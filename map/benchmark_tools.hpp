@@ -1,8 +1,33 @@
 #pragma once
 
+#include <string>
+#include <utility>
+#include <vector>
+
 class Framework;
 
 namespace benchmark
 {
+// Durations of the framework startup phases in seconds. The start is cold when there are
+// no caches which were written by the previous launches.
+class StartupMeasurements
+{
+public:
+  void SetColdStart(bool isColdStart) { m_isColdStart = isColdStart; }
+  bool IsColdStart() const { return m_isColdStart; }
+
+  void AddPhase(std::string const & name, double seconds) { m_phases.emplace_back(name, seconds); }
+  std::vector<std::pair<std::string, double>> const & GetPhases() const { return m_phases; }
+
+private:
+  bool m_isColdStart = false;
+  std::vector<std::pair<std::string, double>> m_phases;
+};
+
 void RunGraphicsBenchmark(Framework * framework);
+
+// Runs the search queries, routes and place pages of SettingsDir()/framework_benchmark.json
+// one by one and writes their durations together with the startup phases to
+// WritableDir()/framework_benchmark_results.json.
+void RunFrameworkBenchmark(Framework * framework);
 } //  namespace benchmark
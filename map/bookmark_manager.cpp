@@ -28,6 +28,7 @@
 #include "geometry/transformations.hpp"
 
 #include "base/macros.hpp"
+#include "base/parallel.hpp"
 #include "base/string_utils.hpp"
 
 #include "std/target_os.hpp"
@@ -991,13 +992,21 @@ BookmarkManager::KMLDataCollectionPtr BookmarkManager::LoadBookmarks(
   Platform::FilesList files;
   Platform::GetFilesByExt(dir, ext, files);
 
+  // Files are deserialized in parallel, the results are filtered in the order of files.
+  std::vector<std::unique_ptr<kml::FileData>> kmlDatas(files.size());
+  base::ParallelFor(0, files.size(), [&](size_t i)
+  {
+    if (!m_needTeardown)
+      kmlDatas[i] = LoadKmlFile(base::JoinPath(dir, files[i]), fileType);
+  });
+
   auto collection = std::make_shared<KMLDataCollection>();
   collection->reserve(files.size());
   cloudFilePaths.reserve(files.size());
-  for (auto const & file : files)
+  for (size_t i = 0; i < files.size(); ++i)
   {
-    auto const filePath = base::JoinPath(dir, file);
-    auto kmlData = LoadKmlFile(filePath, fileType);
+    auto const filePath = base::JoinPath(dir, files[i]);
+    auto & kmlData = kmlDatas[i];
     if (kmlData == nullptr)
       continue;
     if (checker && !checker(*kmlData))
@@ -1524,6 +1533,16 @@ void BookmarkManager::CreateCategories(KMLDataCollection && dataCollection, bool
   CHECK_THREAD_CHECKER(m_threadChecker, ());
   kml::GroupIdSet loadedGroups;
 
+  size_t bookmarksCount = 0;
+  size_t tracksCount = 0;
+  for (auto const & data : dataCollection)
+  {
+    bookmarksCount += data.second->m_bookmarksData.size();
+    tracksCount += data.second->m_tracksData.size();
+  }
+  m_bookmarks.reserve(m_bookmarks.size() + bookmarksCount);
+  m_tracks.reserve(m_tracks.size() + tracksCount);
+
   for (auto const & data : dataCollection)
   {
     auto const & fileName = data.first;
@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/optional.hpp>
@@ -35,9 +36,10 @@ class BookmarkManager final
   using UserMarkLayers = std::vector<std::unique_ptr<UserMarkLayer>>;
   using CategoriesCollection = std::map<kml::MarkGroupId, std::unique_ptr<BookmarkCategory>>;
 
-  using MarksCollection = std::map<kml::MarkId, std::unique_ptr<UserMark>>;
-  using BookmarksCollection = std::map<kml::MarkId, std::unique_ptr<Bookmark>>;
-  using TracksCollection = std::map<kml::TrackId, std::unique_ptr<Track>>;
+  // Marks are looked up by id only, so hash maps are used for catalogs with many bookmarks.
+  using MarksCollection = std::unordered_map<kml::MarkId, std::unique_ptr<UserMark>>;
+  using BookmarksCollection = std::unordered_map<kml::MarkId, std::unique_ptr<Bookmark>>;
+  using TracksCollection = std::unordered_map<kml::TrackId, std::unique_ptr<Track>>;
 
 public:
   using KMLDataCollection = std::vector<std::pair<std::string, std::unique_ptr<kml::FileData>>>;
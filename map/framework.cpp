@@ -92,6 +92,7 @@
 
 #include "base/logging.hpp"
 #include "base/math.hpp"
+#include "base/memory_budget.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
@@ -134,6 +135,7 @@ char const kTransitSchemeEnabledKey[] = "TransitSchemeEnabled";
 char const kTrafficSimplifiedColorsKey[] = "TrafficSimplifiedColors";
 char const kLargeFontsSize[] = "LargeFontsSize";
 char const kTranslitMode[] = "TransliterationMode";
+char const kMwmInfoCacheFile[] = "mwm_info_cache.bin";
 
 #if defined(OMIM_METAL_AVAILABLE)
 char const kMetalAllowed[] = "MetalAllowed";
@@ -279,12 +281,21 @@ void Framework::OnViewportChanged(ScreenBase const & screen)
 {
   m_currentModelView = screen;
 
+  // The first viewport comes from the render thread when the first frame is prepared.
+  if (m_firstFrameTimer)
+  {
+    m_startupMeasurements.AddPhase("first_frame", m_firstFrameTimer->ElapsedSeconds());
+    m_firstFrameTimer.reset();
+    benchmark::RunFrameworkBenchmark(this);
+  }
+
   GetSearchAPI().OnViewportChanged(GetCurrentViewport());
 
   GetBookmarkManager().UpdateViewport(m_currentModelView);
   m_trafficManager.UpdateViewport(m_currentModelView);
   m_localAdsManager.UpdateViewport(m_currentModelView);
   m_transitManager.UpdateViewport(m_currentModelView);
+  m_placePageExtrasLoader.Prefetch(m_currentModelView);
 
   if (m_viewportChanged != nullptr)
     m_viewportChanged(screen);
@@ -392,13 +403,18 @@ Framework::Framework(FrameworkParams const & params)
       m_drapeEngine->SetDisplacementMode(mode);
   })
   , m_lastReportedCountry(kInvalidCountryId)
-  , m_popularityLoader(m_model.GetDataSource())
+  , m_placePageExtrasLoader(m_model.GetDataSource(), [this](m2::PointD const & pt) {
+    return GetAddressInfoAtPoint(pt).FormatHouseAndStreet();
+  })
   , m_purchase(std::make_unique<Purchase>())
   , m_tipsApi(static_cast<TipsApi::Delegate &>(*this))
   , m_notificationManager(static_cast<notifications::NotificationManager::Delegate &>(*this))
 {
   CHECK(IsLittleEndian(), ("Only little-endian architectures are supported."));
 
+  base::Timer startupTimer;
+  base::Timer phaseTimer;
+
   // Editor should be initialized from the main thread to set its ThreadChecker.
   // However, search calls editor upon initialization thus setting the lazy editor's ThreadChecker
   // to a wrong thread. So editor should be initialiazed before serach.
@@ -425,8 +441,10 @@ Framework::Framework(FrameworkParams const & params)
   // Wi-Fi string is used in categories that's why does not have core_ prefix
   m_stringsBundle.SetDefaultString("wifi", "WiFi");
 
+  phaseTimer.Reset();
   m_model.InitClassificator();
   m_model.SetOnMapDeregisteredCallback(bind(&Framework::OnMapDeregistered, this, _1));
+  m_startupMeasurements.AddPhase("classificator", phaseTimer.ElapsedSeconds());
   LOG(LDEBUG, ("Classificator initialized"));
 
   m_displayedCategories = make_unique<search::DisplayedCategories>(GetDefaultCategories());
@@ -463,9 +481,16 @@ Framework::Framework(FrameworkParams const & params)
   InitDiscoveryManager();
   InitTaxiEngine();
 
+  auto const mwmInfoCachePath = GetPlatform().WritablePathForFile(kMwmInfoCacheFile);
+  m_startupMeasurements.SetColdStart(!GetPlatform().IsFileExistsByFullPath(mwmInfoCachePath));
+  m_mwmInfoCache = make_shared<MwmInfoCache>(mwmInfoCachePath);
+  m_model.GetDataSource().SetInfoCache(m_mwmInfoCache);
+
   // All members which re-initialize in Migrate() method should be initialized before RegisterAllMaps().
   // Migrate() can be called from RegisterAllMaps().
+  phaseTimer.Reset();
   RegisterAllMaps();
+  m_startupMeasurements.AddPhase("mwm_registration", phaseTimer.ElapsedSeconds());
   LOG(LDEBUG, ("Maps initialized"));
 
   // Need to reload cities boundaries because maps in indexer were updated.
@@ -516,6 +541,8 @@ Framework::Framework(FrameworkParams const & params)
   m_notificationManager.TrimExpired();
   eye::Eye::Instance().TrimExpired();
   eye::Eye::Instance().Subscribe(&m_notificationManager);
+
+  m_startupMeasurements.AddPhase("framework", startupTimer.ElapsedSeconds());
 }
 
 Framework::~Framework()
@@ -609,6 +636,8 @@ void Framework::OnCountryFileDownloaded(storage::TCountryId const & countryId, s
     MwmSet::MwmId const & id = p.first;
     if (id.IsAlive())
       rect = id.GetInfo()->m_bordersRect;
+    if (m_mwmInfoCache)
+      m_mwmInfoCache->Save();
   }
   m_trafficManager.Invalidate();
   m_transitManager.Invalidate();
@@ -647,7 +676,7 @@ void Framework::OnMapDeregistered(platform::LocalCountryFile const & localFile)
   m_localAdsManager.OnMwmDeregistered(localFile);
   m_transitManager.OnMwmDeregistered(localFile);
   m_trafficManager.OnMwmDeregistered(localFile);
-  m_popularityLoader.OnMwmDeregistered(localFile);
+  m_placePageExtrasLoader.OnMwmDeregistered(localFile);
 
   auto action = [this, localFile]
   {
@@ -726,6 +755,9 @@ void Framework::RegisterAllMaps()
     }
   }
 
+  if (m_mwmInfoCache)
+    m_mwmInfoCache->Save();
+
   if (needStatisticsUpdate)
   {
     alohalytics::Stats::Instance().LogEvent("Downloader_Map_list",
@@ -771,7 +803,8 @@ void Framework::ResetBookmarkInfo(Bookmark const & bmk, place_page::Info & info)
   FillPointInfo(bmk.GetPivot(), {} /* customTitle */, info);
 }
 
-void Framework::FillFeatureInfo(FeatureID const & fid, place_page::Info & info) const
+void Framework::FillFeatureInfo(FeatureID const & fid, place_page::Info & info,
+                                bool deferExtras) const
 {
   if (!fid.IsValid())
   {
@@ -787,7 +820,7 @@ void Framework::FillFeatureInfo(FeatureID const & fid, place_page::Info & info)
     return;
   }
 
-  FillInfoFromFeatureType(ft, info);
+  FillInfoFromFeatureType(ft, info, deferExtras);
 
   // Fill countryId for place page info
   uint32_t const placeContinentType = classif().GetTypeByPath({"place", "continent"});
@@ -813,12 +846,13 @@ void Framework::FillFeatureInfo(FeatureID const & fid, place_page::Info & info)
   }
 }
 
-void Framework::FillPointInfo(m2::PointD const & mercator, string const & customTitle, place_page::Info & info) const
+void Framework::FillPointInfo(m2::PointD const & mercator, string const & customTitle,
+                              place_page::Info & info, bool deferExtras) const
 {
   auto feature = GetFeatureAtPoint(mercator);
   if (feature)
   {
-    FillInfoFromFeatureType(*feature, info);
+    FillInfoFromFeatureType(*feature, info, deferExtras);
   }
   else
   {
@@ -833,7 +867,8 @@ void Framework::FillPointInfo(m2::PointD const & mercator, string const & custom
   info.SetMercator(mercator);
 }
 
-void Framework::FillInfoFromFeatureType(FeatureType & ft, place_page::Info & info) const
+void Framework::FillInfoFromFeatureType(FeatureType & ft, place_page::Info & info,
+                                        bool deferExtras) const
 {
   using place_page::SponsoredType;
   auto const featureStatus = osm::Editor::Instance().GetFeatureStatus(ft.GetID());
@@ -842,8 +877,18 @@ void Framework::FillInfoFromFeatureType(FeatureType & ft, place_page::Info & inf
   info.SetFeatureStatus(featureStatus);
   info.SetLocalizedWifiString(m_stringsBundle.GetString("wifi"));
 
-  if (ftypes::IsAddressObjectChecker::Instance()(ft))
-    info.SetAddress(GetAddressInfoAtPoint(feature::GetCenter(ft)).FormatHouseAndStreet());
+  // Address and popularity are slow to get, so on tap they are loaded in background
+  // unless they are already prefetched.
+  PlacePageExtrasLoader::Extras extras;
+  if (!m_placePageExtrasLoader.GetCached(ft.GetID(), extras))
+  {
+    if (deferExtras)
+      info.SetExtrasPending(true);
+    else
+      extras = m_placePageExtrasLoader.Load(ft);
+  }
+  info.SetAddress(extras.m_address);
+  info.SetPopularity(extras.m_popularity);
 
   info.SetFromFeatureType(ft);
 
@@ -931,7 +976,6 @@ void Framework::FillInfoFromFeatureType(FeatureType & ft, place_page::Info & inf
   auto const latlon = MercatorBounds::ToLatLon(feature::GetCenter(ft));
   ASSERT(m_taxiEngine, ());
   info.SetReachableByTaxiProviders(m_taxiEngine->GetProvidersAtPos(latlon));
-  info.SetPopularity(m_popularityLoader.Get(ft.GetID()));
 }
 
 void Framework::FillApiMarkInfo(ApiMarkPoint const & api, place_page::Info & info) const
@@ -1329,6 +1373,7 @@ void Framework::CancelAllSearches()
 void Framework::MemoryWarning()
 {
   LOG(LINFO, ("MemoryWarning"));
+  base::MemoryBudget::Instance().SetPressure(base::MemoryBudget::Pressure::Critical);
   ClearAllCaches();
   SharedBufferManager::instance().clearReserved();
 }
@@ -1369,6 +1414,10 @@ void Framework::EnterForeground()
 
   m_trafficManager.OnEnterForeground();
   m_routingManager.SetAllowSendingPoints(true);
+
+  // The OS reports memory warnings but not their end, so caches grow back after a restart
+  // from the background.
+  base::MemoryBudget::Instance().SetPressure(base::MemoryBudget::Pressure::None);
 }
 
 void Framework::InitCountryInfoGetter()
@@ -1754,6 +1803,14 @@ bool Framework::GetDistanceAndAzimut(m2::PointD const & point,
 
 void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFactory, DrapeCreationParams && params)
 {
+  // Only the first drape engine is measured, it's recreated when the graphics context is lost.
+  bool const isFirstDrapeEngine = !m_isDrapeEngineMeasured;
+  if (isFirstDrapeEngine)
+  {
+    m_isDrapeEngineMeasured = true;
+    m_firstFrameTimer = make_unique<base::Timer>();
+  }
+
   auto idReadFn = [this](df::MapDataProvider::TReadCallback<FeatureID const> const & fn,
                          m2::RectD const & r,
                          int scale) -> void { m_model.ForEachFeatureID(r, fn, scale); };
@@ -1875,6 +1932,9 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
   bool const transitSchemeEnabled = LoadTransitSchemeEnabled();
   m_transitManager.EnableTransitSchemeMode(transitSchemeEnabled);
 
+  if (isFirstDrapeEngine)
+    m_startupMeasurements.AddPhase("drape_init", m_firstFrameTimer->ElapsedSeconds());
+
   benchmark::RunGraphicsBenchmark(this);
 }
 
@@ -2256,6 +2316,20 @@ void Framework::UpdatePlacePageInfoForCurrentSelection()
   SetPlacePageLocation(info);
 
   ActivateMapSelection(false, obj, info);
+  LoadPlacePageExtras(info);
+}
+
+void Framework::LoadPlacePageExtras(place_page::Info const & info)
+{
+  if (!info.AreExtrasPending())
+    return;
+
+  m_placePageExtrasLoader.LoadAsync(info.GetID(), [this](FeatureID const & id)
+  {
+    // The place page is refilled from the cache if the feature is still selected.
+    if (m_lastTapEvent != nullptr && m_selectedFeature == id)
+      UpdatePlacePageInfoForCurrentSelection();
+  });
 }
 
 void Framework::InvalidateUserMarks()
@@ -2325,6 +2399,7 @@ void Framework::OnTapEvent(TapEvent const & tapEvent)
     SetPlacePageLocation(info);
 
     ActivateMapSelection(true, selection, info);
+    LoadPlacePageExtras(info);
   }
   else
   {
@@ -2419,12 +2494,12 @@ df::SelectionShape::ESelectedObject Framework::OnTapEventImpl(TapEvent const & t
   bool showMapSelection = false;
   if (featureTapped.IsValid())
   {
-    FillFeatureInfo(featureTapped, outInfo);
+    FillFeatureInfo(featureTapped, outInfo, true /* deferExtras */);
     showMapSelection = true;
   }
   else if (tapInfo.m_isLong || tapEvent.m_source == TapEvent::Source::Search)
   {
-    FillPointInfo(tapInfo.m_mercator, {} /* customTitle */, outInfo);
+    FillPointInfo(tapInfo.m_mercator, {} /* customTitle */, outInfo, true /* deferExtras */);
     showMapSelection = true;
   }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "map/api_mark_point.hpp"
+#include "map/benchmark_tools.hpp"
 #include "map/booking_filter_params.hpp"
 #include "map/booking_filter_processor.hpp"
 #include "map/bookmark.hpp"
@@ -11,6 +12,7 @@
 #include "map/local_ads_manager.hpp"
 #include "map/mwm_url.hpp"
 #include "map/notifications/notification_manager.hpp"
+#include "map/place_page_extras_loader.hpp"
 #include "map/place_page_info.hpp"
 #include "map/purchase.hpp"
 #include "map/routing_manager.hpp"
@@ -42,7 +44,6 @@
 #include "indexer/data_source.hpp"
 #include "indexer/data_source_helpers.hpp"
 #include "indexer/map_style.hpp"
-#include "indexer/popularity_loader.hpp"
 
 #include "search/city_finder.hpp"
 #include "search/displayed_categories.hpp"
@@ -77,6 +78,7 @@
 #include "base/macros.hpp"
 #include "base/strings_bundle.hpp"
 #include "base/thread_checker.hpp"
+#include "base/timer.hpp"
 
 #include "std/function.hpp"
 #include "std/list.hpp"
@@ -171,6 +173,13 @@ protected:
   StringsBundle m_stringsBundle;
 
   model::FeaturesFetcher m_model;
+  // Attributes of local maps, so that registration of maps doesn't open their files.
+  shared_ptr<MwmInfoCache> m_mwmInfoCache;
+  // Durations of the startup phases, they are reported by the framework benchmark.
+  benchmark::StartupMeasurements m_startupMeasurements;
+  // Runs from the first creation of drape engine till the first frame.
+  unique_ptr<base::Timer> m_firstFrameTimer;
+  bool m_isDrapeEngineMeasured = false;
 
   // The order matters here: DisplayedCategories may be used only
   // after classificator is loaded by |m_model|.
@@ -540,7 +549,7 @@ private:
   void OnUpdateGpsTrackPointsCallback(vector<pair<size_t, location::GpsTrackInfo>> && toAdd,
                                       pair<size_t, size_t> const & toRemove);
 
-  CachingPopularityLoader m_popularityLoader;
+  PlacePageExtrasLoader m_placePageExtrasLoader;
 
 public:
   using TSearchRequest = search::QuerySaver::TSearchRequest;
@@ -673,10 +682,17 @@ private:
 
   bool ParseRoutingDebugCommand(search::SearchParams const & params);
 
-  void FillFeatureInfo(FeatureID const & fid, place_page::Info & info) const;
+  /// @param deferExtras, if true, address and popularity which are not cached yet are not loaded
+  /// and |info| is marked with SetExtrasPending(), see LoadPlacePageExtras().
+  void FillFeatureInfo(FeatureID const & fid, place_page::Info & info,
+                       bool deferExtras = false) const;
   /// @param customTitle, if not empty, overrides any other calculated name.
-  void FillPointInfo(m2::PointD const & mercator, string const & customTitle, place_page::Info & info) const;
-  void FillInfoFromFeatureType(FeatureType & ft, place_page::Info & info) const;
+  void FillPointInfo(m2::PointD const & mercator, string const & customTitle, place_page::Info & info,
+                     bool deferExtras = false) const;
+  void FillInfoFromFeatureType(FeatureType & ft, place_page::Info & info,
+                               bool deferExtras = false) const;
+  /// Loads pending extras of the selected |info| in background and updates the place page.
+  void LoadPlacePageExtras(place_page::Info const & info);
   void FillApiMarkInfo(ApiMarkPoint const & api, place_page::Info & info) const;
   void FillSearchResultInfo(SearchMarkPoint const & smp, place_page::Info & info) const;
   void FillMyPositionInfo(place_page::Info & info, df::TapInfo const & tapInfo) const;
@@ -804,6 +820,12 @@ public:
 private:
   m2::PointD GetDiscoveryViewportCenter() const;
 
+public:
+  benchmark::StartupMeasurements const & GetStartupMeasurements() const
+  {
+    return m_startupMeasurements;
+  }
+
 public:
   /// Routing Manager
   RoutingManager & GetRoutingManager() { return m_routingManager; }
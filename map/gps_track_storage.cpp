@@ -1,7 +1,6 @@
 #include "map/gps_track_storage.hpp"
 
 #include "coding/endianness.hpp"
-#include "coding/internal/file_data.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/cstring.hpp"
@@ -13,19 +12,39 @@ namespace
 {
 
 // Current file format version
-uint32_t constexpr kCurrentVersion = 1;
+uint32_t constexpr kCurrentVersion = 2;
 
-// Header size in bytes, header consists of uint32_t 'version' only
-uint32_t constexpr kHeaderSize = sizeof(uint32_t);
+// Version with not compressed items, such files are converted on opening
+uint32_t constexpr kUncompressedVersion = 1;
 
-// Number of items for batch processing
-size_t constexpr kItemBlockSize = 1000;
+// Header size in bytes, header consists of uint32_t 'version' and uint32_t 'block count'
+uint32_t constexpr kHeaderSize = 2 * sizeof(uint32_t);
 
-// TODO
-// Now GpsInfo written as plain values, but values can be compressed.
+// Header size of the version 1 file, it consists of uint32_t 'version' only
+uint32_t constexpr kUncompressedHeaderSize = sizeof(uint32_t);
 
-// Size of point in bytes to write in file of read from file
-size_t constexpr kPointSize = 8 * sizeof(double) + sizeof(uint8_t);
+// Max number of items in a block
+size_t constexpr kBlockItemCount = 1000;
+
+// Block header consists of uint32_t 'sequence number', uint32_t 'item count',
+// uint32_t 'payload size' and double min and max timestamps of the items
+size_t constexpr kBlockHeaderSize = 3 * sizeof(uint32_t) + 2 * sizeof(double);
+
+// Number of double values in the item
+size_t constexpr kFieldCount = 8;
+
+// Max size of packed item: every double is a byte of the zero bytes counts and up to 8 bytes,
+// and a byte of the source
+size_t constexpr kMaxPackedItemSize = kFieldCount * (1 + sizeof(double)) + sizeof(uint8_t);
+
+// Size of block with header and max payload, blocks have fixed places in the file
+size_t constexpr kBlockSize = kBlockHeaderSize + kBlockItemCount * kMaxPackedItemSize;
+
+// Size of point in bytes in the version 1 file
+size_t constexpr kUncompressedPointSize = kFieldCount * sizeof(double) + sizeof(uint8_t);
+
+// Number of items for batch processing of the version 1 file
+size_t constexpr kItemBatchSize = 1000;
 
 // Writes value in memory in LittleEndian
 template <typename T>
@@ -44,22 +63,108 @@ T MemRead(void const * ptr)
   return SwapIfBigEndianMacroBased(value);
 }
 
-void Pack(char * p, location::GpsInfo const & info)
-{  
-  MemWrite<double>(p + 0 * sizeof(double), info.m_timestamp);
-  MemWrite<double>(p + 1 * sizeof(double), info.m_latitude);
-  MemWrite<double>(p + 2 * sizeof(double), info.m_longitude);
-  MemWrite<double>(p + 3 * sizeof(double), info.m_altitude);
-  MemWrite<double>(p + 4 * sizeof(double), info.m_speedMpS);
-  MemWrite<double>(p + 5 * sizeof(double), info.m_bearing);
-  MemWrite<double>(p + 6 * sizeof(double), info.m_horizontalAccuracy);
-  MemWrite<double>(p + 7 * sizeof(double), info.m_verticalAccuracy);
+void GetFields(location::GpsInfo const & info, uint64_t (&fields)[kFieldCount])
+{
+  double const values[kFieldCount] = {info.m_timestamp, info.m_latitude, info.m_longitude,
+                                      info.m_altitude, info.m_speedMpS, info.m_bearing,
+                                      info.m_horizontalAccuracy, info.m_verticalAccuracy};
+  static_assert(sizeof(fields) == sizeof(values), "");
+  memcpy(fields, values, sizeof(values));
+}
+
+void SetFields(uint64_t const (&fields)[kFieldCount], location::GpsInfo & info)
+{
+  double values[kFieldCount];
+  static_assert(sizeof(fields) == sizeof(values), "");
+  memcpy(values, fields, sizeof(values));
+  info.m_timestamp = values[0];
+  info.m_latitude = values[1];
+  info.m_longitude = values[2];
+  info.m_altitude = values[3];
+  info.m_speedMpS = values[4];
+  info.m_bearing = values[5];
+  info.m_horizontalAccuracy = values[6];
+  info.m_verticalAccuracy = values[7];
+}
+
+// Packs |info| as difference with |prev|, |prev| is nullptr for the first item in a block.
+// Every double is written as xor of its bits with the bits of the previous value: a byte with
+// numbers of the leading and the trailing zero bytes of xor and the rest bytes of xor.
+void Pack(vector<char> & buff, location::GpsInfo const & info, location::GpsInfo const * prev)
+{
+  uint64_t fields[kFieldCount];
+  GetFields(info, fields);
+  uint64_t prevFields[kFieldCount] = {};
+  if (prev)
+    GetFields(*prev, prevFields);
+
+  for (size_t i = 0; i < kFieldCount; ++i)
+  {
+    uint64_t delta = fields[i] ^ prevFields[i];
+    uint8_t leading = 0;
+    while (leading < sizeof(delta) && (delta >> (8 * (sizeof(delta) - 1 - leading))) == 0)
+      ++leading;
+    uint8_t trailing = 0;
+    while (leading + trailing < sizeof(delta) && (delta & 0xFF) == 0)
+    {
+      delta >>= 8;
+      ++trailing;
+    }
+
+    buff.push_back(static_cast<char>((leading << 4) | trailing));
+    for (size_t j = leading + trailing; j < sizeof(delta); ++j)
+    {
+      buff.push_back(static_cast<char>(delta & 0xFF));
+      delta >>= 8;
+    }
+  }
+
   ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
-  uint8_t const source = static_cast<uint8_t>(info.m_source);
-  MemWrite<uint8_t>(p + 8 * sizeof(double), source);
+  buff.push_back(static_cast<char>(info.m_source));
+}
+
+// Unpacks item at |p| which is not farther than |end|, returns the position after the item
+// or nullptr if data is broken.
+char const * Unpack(char const * p, char const * end, location::GpsInfo const * prev,
+                    location::GpsInfo & info)
+{
+  uint64_t fields[kFieldCount] = {};
+  if (prev)
+    GetFields(*prev, fields);
+
+  for (size_t i = 0; i < kFieldCount; ++i)
+  {
+    if (p == end)
+      return nullptr;
+
+    uint8_t const zeroes = static_cast<uint8_t>(*p++);
+    size_t const leading = zeroes >> 4;
+    size_t const trailing = zeroes & 0xF;
+    if (leading + trailing > sizeof(uint64_t))
+      return nullptr;
+
+    size_t const size = sizeof(uint64_t) - leading - trailing;
+    if (static_cast<size_t>(end - p) < size)
+      return nullptr;
+
+    uint64_t delta = 0;
+    for (size_t j = 0; j < size; ++j)
+      delta |= static_cast<uint64_t>(static_cast<uint8_t>(p[j])) << (8 * j);
+    p += size;
+
+    if (size != 0)
+      fields[i] ^= delta << (8 * trailing);
+  }
+
+  if (p == end)
+    return nullptr;
+
+  SetFields(fields, info);
+  info.m_source = static_cast<location::TLocationSource>(static_cast<uint8_t>(*p++));
+  return p;
 }
 
-void Unpack(char const * p, location::GpsInfo & info)
+void UnpackUncompressed(char const * p, location::GpsInfo & info)
 {
   info.m_timestamp = MemRead<double>(p + 0 * sizeof(double));
   info.m_latitude = MemRead<double>(p + 1 * sizeof(double));
@@ -73,30 +178,31 @@ void Unpack(char const * p, location::GpsInfo & info)
   info.m_source = static_cast<location::TLocationSource>(source);
 }
 
-inline size_t GetItemOffset(size_t itemIndex)
+inline size_t GetBlockOffset(size_t blockIndex)
 {
-  return kHeaderSize + itemIndex * kPointSize;
+  return kHeaderSize + blockIndex * kBlockSize;
 }
 
-inline size_t GetItemCount(size_t fileSize)
+inline size_t GetBlockCount(size_t maxItemCount)
 {
-  ASSERT_GREATER_OR_EQUAL(fileSize, kHeaderSize, ());
-  return (fileSize - kHeaderSize) / kPointSize;
+  // One block more to keep maxItemCount items when the oldest block is being overwritten
+  return (maxItemCount + kBlockItemCount - 1) / kBlockItemCount + 1;
 }
 
-inline bool WriteVersion(fstream & f, uint32_t version)
+inline bool WriteHeader(fstream & f, uint32_t blockCount)
 {
-  static_assert(kHeaderSize == sizeof(version), "");
-  version = SwapIfBigEndianMacroBased(version);
-  f.write(reinterpret_cast<char const *>(&version), kHeaderSize);
+  char buff[kHeaderSize];
+  MemWrite<uint32_t>(buff, kCurrentVersion);
+  MemWrite<uint32_t>(buff + sizeof(uint32_t), blockCount);
+  f.write(buff, kHeaderSize);
   return f.good();
 }
 
 inline bool ReadVersion(fstream & f, uint32_t & version)
 {
-  static_assert(kHeaderSize == sizeof(version), "");
-  f.read(reinterpret_cast<char *>(&version), kHeaderSize);
-  version = SwapIfBigEndianMacroBased(version);
+  char buff[sizeof(version)];
+  f.read(buff, sizeof(version));
+  version = MemRead<uint32_t>(buff);
   return f.good();
 }
 
@@ -105,13 +211,16 @@ inline bool ReadVersion(fstream & f, uint32_t & version)
 GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
   : m_filePath(filePath)
   , m_maxItemCount(maxItemCount)
-  , m_itemCount(0)
+  , m_currentBlock(0)
 {
   ASSERT_GREATER(m_maxItemCount, 0, ());
 
+  uint32_t const blockCount = static_cast<uint32_t>(GetBlockCount(m_maxItemCount));
+
   // Open existing file
   m_stream.open(m_filePath, ios::in | ios::out | ios::binary);
 
+  vector<TItem> items;
   if (m_stream)
   {
     uint32_t version = 0;
@@ -120,41 +229,46 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
 
     if (version == kCurrentVersion)
     {
-      // Seek to end to get file size
-      m_stream.seekp(0, ios::end);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
-
-      size_t const fileSize = m_stream.tellp();
-
-      m_itemCount = GetItemCount(fileSize);
-
-      // Set write position after last item position
-      size_t const offset = GetItemOffset(m_itemCount);
-      m_stream.seekp(offset, ios::beg);
+      char buff[sizeof(uint32_t)];
+      m_stream.read(buff, sizeof(buff));
       if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the offset error:", offset, m_filePath));
+        MYTHROW(OpenException, ("Read header error.", m_filePath));
+
+      uint32_t const fileBlockCount = MemRead<uint32_t>(buff);
+      if (!Load(fileBlockCount))
+      {
+        LOG(LWARNING, ("Broken gps track file", m_filePath));
+        m_stream.close();
+      }
+      else if (fileBlockCount != blockCount)
+      {
+        // The ring is rebuilt for the new max item count
+        ForEach([&items](TItem const & item)
+        {
+          items.push_back(item);
+          return true;
+        });
+        m_stream.close();
+      }
+    }
+    else if (version == kUncompressedVersion)
+    {
+      items = ReadUncompressedItems();
+      m_stream.close();
     }
     else
     {
       m_stream.close();
       // TODO: migration for file m_filePath from version 'version' to version 'kCurrentVersion'
-      // TODO: For now we support only one version, but in future migration may be needed.
     }
   }
 
-  if (!m_stream)
+  if (!m_stream.is_open())
   {
-    // Create new file
-    m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
-
-    if (!m_stream)
-      MYTHROW(OpenException, ("Open file error.", m_filePath));
-
-    if (!WriteVersion(m_stream, kCurrentVersion))
-      MYTHROW(OpenException, ("Write version error.", m_filePath));
-
-    m_itemCount = 0;
+    Create();
+    if (items.size() > m_maxItemCount)
+      items.erase(items.begin(), items.end() - m_maxItemCount);
+    Append(items);
   }
 }
 
@@ -165,43 +279,63 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   if (items.empty())
     return;
 
-  bool const needTrunc = (m_itemCount + items.size()) > (m_maxItemCount * 2); // see NOTE in declaration
+  vector<char> payload;
+  size_t payloadOffset = 0;
+  bool hasCurrent = m_currentBlock < m_blocks.size();
+  if (hasCurrent)
+    payloadOffset = m_blocks[m_currentBlock].m_payloadSize;
 
-  if (needTrunc)
-    TruncFile();
-
-  // Write position must be after last item position
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
-
-  vector<char> buff(min(kItemBlockSize, items.size()) * kPointSize);
-  for (size_t i = 0; i < items.size();)
+  for (auto const & item : items)
   {
-    size_t const n = min(items.size() - i, kItemBlockSize);
-
-    for (size_t j = 0; j < n; ++j)
-      Pack(&buff[0] + j * kPointSize, items[i + j]);
-
-    m_stream.write(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(WriteException, ("File:", m_filePath));
+    if (!hasCurrent || m_blocks[m_currentBlock].m_itemCount == kBlockItemCount)
+    {
+      if (hasCurrent)
+      {
+        WritePayload(m_currentBlock, payloadOffset, payload);
+        WriteBlockHeader(m_currentBlock);
+      }
+
+      // Start the next block in the ring, it replaces the oldest one
+      uint32_t const sequence = hasCurrent ? m_blocks[m_currentBlock].m_sequence + 1 : 1;
+      m_currentBlock = hasCurrent ? (m_currentBlock + 1) % m_blocks.size() : 0;
+      hasCurrent = true;
+
+      auto & block = m_blocks[m_currentBlock];
+      block = BlockInfo();
+      block.m_sequence = sequence;
+      // Items of the replaced block are invalidated before its payload is overwritten
+      WriteBlockHeader(m_currentBlock);
+
+      payload.clear();
+      payloadOffset = 0;
+    }
 
-    i += n;
+    auto & block = m_blocks[m_currentBlock];
+    if (block.m_itemCount == 0)
+    {
+      block.m_minTimestamp = item.m_timestamp;
+      block.m_maxTimestamp = item.m_timestamp;
+    }
+    Pack(payload, item, block.m_itemCount == 0 ? nullptr : &m_lastItem);
+    ++block.m_itemCount;
+    block.m_payloadSize = static_cast<uint32_t>(payloadOffset + payload.size());
+    block.m_minTimestamp = min(block.m_minTimestamp, item.m_timestamp);
+    block.m_maxTimestamp = max(block.m_maxTimestamp, item.m_timestamp);
+    m_lastItem = item;
   }
 
+  WritePayload(m_currentBlock, payloadOffset, payload);
+  WriteBlockHeader(m_currentBlock);
+
   m_stream.flush();
   if (!m_stream.good())
     MYTHROW(WriteException, ("File:", m_filePath));
-
-  m_itemCount += items.size();
 }
 
 void GpsTrackStorage::Clear()
 {
   ASSERT(m_stream.is_open(), ());
 
-  m_itemCount = 0;
-
   m_stream.close();
 
   m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
@@ -209,112 +343,235 @@ void GpsTrackStorage::Clear()
   if (!m_stream)
     MYTHROW(WriteException, ("File:", m_filePath));
 
-  if (!WriteVersion(m_stream, kCurrentVersion))
+  if (!WriteHeader(m_stream, static_cast<uint32_t>(m_blocks.size())))
     MYTHROW(WriteException, ("File:", m_filePath));
 
-  // Write position is set to the first item in the file
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(0)), ());
+  fill(m_blocks.begin(), m_blocks.end(), BlockInfo());
+  m_currentBlock = m_blocks.size();
 }
 
 void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
+{
+  ForEachInTimeRange(-numeric_limits<double>::infinity(), numeric_limits<double>::infinity(),
+                     fn);
+}
+
+void GpsTrackStorage::ForEachInTimeRange(double fromTimestamp, double toTimestamp,
+                                         std::function<bool(TItem const & item)> const & fn)
 {
   ASSERT(m_stream.is_open(), ());
 
-  size_t i = GetFirstItemIndex();
+  if (m_currentBlock == m_blocks.size())
+    return;
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
-  if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
+  size_t const itemCount = GetItemCount();
+  // Items older than m_maxItemCount last items, see NOTE in declaration
+  size_t skipCount = itemCount > m_maxItemCount ? itemCount - m_maxItemCount : 0;
 
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  vector<TItem> items;
+  // Blocks from the oldest to the current one
+  for (size_t i = 1; i <= m_blocks.size(); ++i)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const blockIndex = (m_currentBlock + i) % m_blocks.size();
+    auto const & block = m_blocks[blockIndex];
+    if (block.m_sequence == 0)
+      continue;
 
-    m_stream.read(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+    size_t const skip = min(skipCount, static_cast<size_t>(block.m_itemCount));
+    skipCount -= skip;
+    if (skip == block.m_itemCount)
+      continue;
 
-    for (size_t j = 0; j < n; ++j)
-    {      
-      TItem item;
-      Unpack(&buff[0] + j * kPointSize, item);
+    if (block.m_minTimestamp > toTimestamp || block.m_maxTimestamp < fromTimestamp)
+      continue;
+
+    ReadBlock(blockIndex, items);
+    for (size_t j = skip; j < items.size(); ++j)
+    {
+      auto const & item = items[j];
+      if (item.m_timestamp < fromTimestamp || item.m_timestamp > toTimestamp)
+        continue;
       if (!fn(item))
         return;
     }
-
-    i += n;
   }
 }
 
-void GpsTrackStorage::TruncFile()
+void GpsTrackStorage::Create()
 {
-  string const tmpFilePath = m_filePath + ".tmp";
+  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
 
-  // Create a tmp file
-  fstream tmp(tmpFilePath, ios::in | ios::out | ios::binary | ios::trunc);
+  if (!m_stream)
+    MYTHROW(OpenException, ("Open file error.", m_filePath));
 
-  if (!tmp)
-    MYTHROW(WriteException, ("Unable to create temporary file:", tmpFilePath));
+  uint32_t const blockCount = static_cast<uint32_t>(GetBlockCount(m_maxItemCount));
+  if (!WriteHeader(m_stream, blockCount))
+    MYTHROW(OpenException, ("Write header error.", m_filePath));
 
-  if (!WriteVersion(tmp, kCurrentVersion))
-    MYTHROW(WriteException, ("File:", tmpFilePath));
+  m_blocks.assign(blockCount, BlockInfo());
+  m_currentBlock = m_blocks.size();
+}
 
-  size_t i = GetFirstItemIndex();
+bool GpsTrackStorage::Load(uint32_t blockCount)
+{
+  if (blockCount == 0)
+    return false;
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+  m_stream.seekg(0, ios::end);
   if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+  size_t const fileSize = m_stream.tellg();
 
-  size_t newItemCount = 0;
+  m_blocks.assign(blockCount, BlockInfo());
+  m_currentBlock = m_blocks.size();
 
-  // Copy items
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  char buff[kBlockHeaderSize];
+  for (size_t i = 0; i < m_blocks.size(); ++i)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const offset = GetBlockOffset(i);
+    // Blocks are written one by one, so the rest blocks are empty
+    if (offset + kBlockHeaderSize > fileSize)
+      break;
 
-    m_stream.read(&buff[0], n * kPointSize);
+    m_stream.seekg(offset, ios::beg);
+    m_stream.read(buff, kBlockHeaderSize);
     if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+      MYTHROW(OpenException, ("Read block header error.", m_filePath));
+
+    auto & block = m_blocks[i];
+    block.m_sequence = MemRead<uint32_t>(buff);
+    block.m_itemCount = MemRead<uint32_t>(buff + sizeof(uint32_t));
+    block.m_payloadSize = MemRead<uint32_t>(buff + 2 * sizeof(uint32_t));
+    block.m_minTimestamp = MemRead<double>(buff + 3 * sizeof(uint32_t));
+    block.m_maxTimestamp = MemRead<double>(buff + 3 * sizeof(uint32_t) + sizeof(double));
+
+    if (block.m_sequence == 0)
+      continue;
 
-    tmp.write(&buff[0], n * kPointSize);
-    if (!tmp.good())
-      MYTHROW(WriteException, ("File:", tmpFilePath));
+    if (block.m_itemCount > kBlockItemCount ||
+        block.m_payloadSize > kBlockItemCount * kMaxPackedItemSize ||
+        offset + kBlockHeaderSize + block.m_payloadSize > fileSize)
+    {
+      return false;
+    }
+
+    if (m_currentBlock == m_blocks.size() ||
+        block.m_sequence > m_blocks[m_currentBlock].m_sequence)
+    {
+      m_currentBlock = i;
+    }
+  }
+
+  if (m_currentBlock == m_blocks.size())
+    return true;
+
+  // The next items are coded as deltas from the last item of the current block
+  vector<TItem> items;
+  ReadBlock(m_currentBlock, items);
+  if (!items.empty())
+    m_lastItem = items.back();
+  return true;
+}
+
+vector<GpsTrackStorage::TItem> GpsTrackStorage::ReadUncompressedItems()
+{
+  m_stream.seekg(0, ios::end);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+
+  size_t const fileSize = m_stream.tellg();
+  size_t const itemCount = (fileSize - kUncompressedHeaderSize) / kUncompressedPointSize;
+  size_t i = itemCount > m_maxItemCount ? itemCount - m_maxItemCount : 0;
+
+  m_stream.seekg(kUncompressedHeaderSize + i * kUncompressedPointSize, ios::beg);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("File:", m_filePath));
+
+  vector<TItem> items;
+  items.reserve(itemCount - i);
+  vector<char> buff(min(kItemBatchSize, itemCount) * kUncompressedPointSize);
+  while (i < itemCount)
+  {
+    size_t const n = min(itemCount - i, kItemBatchSize);
+
+    m_stream.read(&buff[0], n * kUncompressedPointSize);
+    if (!m_stream.good())
+      MYTHROW(OpenException, ("File:", m_filePath));
+
+    for (size_t j = 0; j < n; ++j)
+    {
+      items.emplace_back();
+      UnpackUncompressed(&buff[0] + j * kUncompressedPointSize, items.back());
+    }
 
     i += n;
-    newItemCount += n;
   }
-  buff.clear();
-  buff.shrink_to_fit();
+  return items;
+}
 
-  tmp.close();
-  m_stream.close();
+void GpsTrackStorage::ReadBlock(size_t blockIndex, vector<TItem> & items)
+{
+  auto const & block = m_blocks[blockIndex];
 
-  // Replace file
-  if (!base::DeleteFileX(m_filePath) ||
-      !base::RenameFileX(tmpFilePath, m_filePath))
+  items.clear();
+  items.reserve(block.m_itemCount);
+  if (block.m_payloadSize == 0)
+    return;
+
+  vector<char> buff(block.m_payloadSize);
+  m_stream.seekg(GetBlockOffset(blockIndex) + kBlockHeaderSize, ios::beg);
+  m_stream.read(&buff[0], buff.size());
+  if (!m_stream.good())
+    MYTHROW(ReadException, ("File:", m_filePath));
+
+  char const * p = buff.data();
+  char const * const end = buff.data() + buff.size();
+  for (uint32_t i = 0; i < block.m_itemCount; ++i)
   {
-    MYTHROW(WriteException, ("File:", m_filePath));
+    TItem item;
+    p = Unpack(p, end, items.empty() ? nullptr : &items.back(), item);
+    if (p == nullptr)
+      MYTHROW(ReadException, ("Broken block", blockIndex, "File:", m_filePath));
+    items.push_back(item);
   }
+}
 
-  // Reopen stream
-  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::ate);
+void GpsTrackStorage::WriteBlockHeader(size_t blockIndex)
+{
+  auto const & block = m_blocks[blockIndex];
 
-  if (!m_stream)
+  char buff[kBlockHeaderSize];
+  MemWrite<uint32_t>(buff, block.m_sequence);
+  MemWrite<uint32_t>(buff + sizeof(uint32_t), block.m_itemCount);
+  MemWrite<uint32_t>(buff + 2 * sizeof(uint32_t), block.m_payloadSize);
+  MemWrite<double>(buff + 3 * sizeof(uint32_t), block.m_minTimestamp);
+  MemWrite<double>(buff + 3 * sizeof(uint32_t) + sizeof(double), block.m_maxTimestamp);
+
+  m_stream.seekp(GetBlockOffset(blockIndex), ios::beg);
+  m_stream.write(buff, kBlockHeaderSize);
+  if (!m_stream.good())
     MYTHROW(WriteException, ("File:", m_filePath));
+}
 
-  m_itemCount = newItemCount;
+void GpsTrackStorage::WritePayload(size_t blockIndex, size_t offset, vector<char> const & payload)
+{
+  if (payload.empty())
+    return;
 
-  // Write position must be after last item position (end of file)
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
+  ASSERT_LESS_OR_EQUAL(offset + payload.size(), kBlockItemCount * kMaxPackedItemSize, ());
+  m_stream.seekp(GetBlockOffset(blockIndex) + kBlockHeaderSize + offset, ios::beg);
+  m_stream.write(payload.data(), payload.size());
+  if (!m_stream.good())
+    MYTHROW(WriteException, ("File:", m_filePath));
 }
 
-size_t GpsTrackStorage::GetFirstItemIndex() const
+size_t GpsTrackStorage::GetItemCount() const
 {
-  return (m_itemCount > m_maxItemCount) ? (m_itemCount - m_maxItemCount) : 0; // see NOTE in declaration
+  size_t count = 0;
+  for (auto const & block : m_blocks)
+  {
+    if (block.m_sequence != 0)
+      count += block.m_itemCount;
+  }
+  return count;
 }
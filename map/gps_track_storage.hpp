@@ -9,6 +9,7 @@
 #include "std/function.hpp"
 #include "std/limits.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 class GpsTrackStorage final
 {
@@ -39,26 +40,45 @@ public:
   /// @exceptions ReadException if read fails.
   void ForEach(std::function<bool(TItem const & item)> const & fn);
 
+  /// Calls functor for each item with timestamp in [fromTimestamp, toTimestamp],
+  /// blocks out of the range are not read.
+  /// @exceptions ReadException if read fails.
+  void ForEachInTimeRange(double fromTimestamp, double toTimestamp,
+                          std::function<bool(TItem const & item)> const & fn);
+
 private:
   DISALLOW_COPY_AND_MOVE(GpsTrackStorage);
 
-  void TruncFile();
-  size_t GetFirstItemIndex() const;
+  struct BlockInfo
+  {
+    uint32_t m_sequence = 0; // 0 for the block which is not written yet
+    uint32_t m_itemCount = 0;
+    uint32_t m_payloadSize = 0;
+    double m_minTimestamp = 0.0;
+    double m_maxTimestamp = 0.0;
+  };
+
+  void Create();
+  bool Load(uint32_t blockCount);
+  vector<TItem> ReadUncompressedItems();
+  void ReadBlock(size_t blockIndex, vector<TItem> & items);
+  void WriteBlockHeader(size_t blockIndex);
+  void WritePayload(size_t blockIndex, size_t offset, vector<char> const & payload);
+  size_t GetItemCount() const;
 
   string const m_filePath;
   size_t const m_maxItemCount;
   fstream m_stream;
-  size_t m_itemCount; // current number of items in file, read note
+  vector<BlockInfo> m_blocks;
+  size_t m_currentBlock; // index of the last written block, m_blocks.size() if there's no one
+  TItem m_lastItem;      // last item of the current block, next items are coded as deltas from it
 
   // NOTE
-  // New items append to the end of file, when file become too big, it is truncated.
-  // Here 'silly window sindrome' is possible: for example max file size is 100k items,
-  // and 99k items are filled, when 2k items is coming, then 98k items is copying to the tmp file
-  // which replaces origin file, and 2k added to the new file. Next time, when 1k items
-  // is comming, then again file truncated. That means that trunc will happens every time.
-  // Similar problem in TCP called 'silly window sindrome'.
-  // To prevent that problem, max file size can be 2 x m_maxItemCount items, when current number of items m_itemCount
-  // exceed 2 x m_maxItemCount, then second half of file - m_maxItemCount items is copying to the tmp file,
-  // which replaces origin file. That means that trunc will happens only then new m_maxItemCount items will be
-  // added but not every time.
+  // The file is a ring of blocks of at most kBlockItemCount items, the blocks have fixed places
+  // in the file. New items are appended to the current block, when it is full, the next block
+  // in the ring is started and the oldest items are dropped without copying the file.
+  // The ring contains one block more than it's needed for m_maxItemCount items,
+  // so at least m_maxItemCount last items are kept and ForEach skips the older ones.
+  // Every double of an item is written as the difference of its bits with the same field
+  // of the previous item in the block, so repeated and close values take a few bytes.
 };
@@ -29,8 +29,10 @@
 
 #include "private.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <limits>
 #include <sstream>
 
 using namespace base;
@@ -57,6 +59,8 @@ double constexpr kMinCheckDistanceInMeters = 5.0;
 double constexpr kMinSearchRadiusInMeters = 20.0;
 double constexpr kMaxAllowableAccuracyInMeters = 20.0;
 uint32_t constexpr kMaxHitCount = 3;
+// Size of the cells of the features grid in mercator, about 200 meters on the equator.
+double constexpr kFeaturesGridCellSize = 0.002;
 
 void SerializeCampaign(FileWriter & writer, std::string const & countryName,
                        LocalAdsManager::Timestamp const & ts,
@@ -493,11 +497,14 @@ void LocalAdsManager::OnMwmDeregistered(platform::LocalCountryFile const & count
   MwmSet::MwmId mwmId;
   {
     std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
-    for (auto const & cachedMwm : m_featuresCache)
+    // Only the first feature of every mwm is checked.
+    for (auto it = m_featuresCache.cbegin(); it != m_featuresCache.cend();
+         it = m_featuresCache.upper_bound(
+             FeatureID(it->first.m_mwmId, std::numeric_limits<uint32_t>::max())))
     {
-      if (cachedMwm.first.m_mwmId.IsDeregistered(countryFile))
+      if (it->first.m_mwmId.IsDeregistered(countryFile))
       {
-        mwmId = cachedMwm.first.m_mwmId;
+        mwmId = it->first.m_mwmId;
         break;
       }
     }
@@ -740,8 +747,11 @@ void LocalAdsManager::UpdateFeaturesCache(FeaturesCache && features)
   df::CustomFeatures customFeatures;
   {
     std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
-    if (!features.empty())
-      m_featuresCache.insert(features.begin(), features.end());
+    for (auto const & entry : features)
+    {
+      if (m_featuresCache.insert(entry).second)
+        m_featuresGrid.Add(entry.first, entry.second.m_position);
+    }
     for (auto const & entry : m_featuresCache)
       customFeatures.insert(std::make_pair(entry.first, entry.second.m_isCustom));
   }
@@ -753,13 +763,13 @@ void LocalAdsManager::ClearLocalAdsForMwm(MwmSet::MwmId const & mwmId)
   // Clear feature cache.
   {
     std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
-    for (auto it = m_featuresCache.begin(); it != m_featuresCache.end();)
-    {
-      if (it->first.m_mwmId == mwmId)
-        it = m_featuresCache.erase(it);
-      else
-        ++it;
-    }
+    // The features of an mwm are a range of the cache.
+    auto const begin = m_featuresCache.lower_bound(FeatureID(mwmId, 0));
+    auto const end = m_featuresCache.upper_bound(
+        FeatureID(mwmId, std::numeric_limits<uint32_t>::max()));
+    for (auto it = begin; it != end; ++it)
+      m_featuresGrid.Remove(it->first, it->second.m_position);
+    m_featuresCache.erase(begin, end);
   }
 
   // Remove custom features in graphics engine.
@@ -820,6 +830,7 @@ void LocalAdsManager::OnSubscriptionChanged(SubscriptionType type, bool isActive
       {
         std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
         m_featuresCache.clear();
+        m_featuresGrid.Clear();
       }
 
       // Clear all graphics.
@@ -858,18 +869,20 @@ void LocalAdsManager::OnLocationUpdate(location::GpsInfo const & info, int zoomL
   {
     std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
     double minDist = numeric_limits<double>::max();
-    for (auto const & pair : m_featuresCache)
-    {
-      auto const & pos = pair.second.m_position;
+    m_featuresGrid.ForEachInRect(searchRect, [&](FeatureID const & featureId) {
+      auto const it = m_featuresCache.find(featureId);
+      ASSERT(it != m_featuresCache.cend(), ());
+      auto const & pos = it->second.m_position;
       if (!searchRect.IsPointInside(pos))
-        continue;
+        return;
       auto const dist = MercatorBounds::DistanceOnEarth(pos, pt);
-      if (dist < radius && dist < minDist)
+      // The features with the same distance are chosen the same way as by the order of the cache.
+      if (dist < radius && (dist < minDist || (dist == minDist && featureId < fid)))
       {
         minDist = dist;
-        fid = pair.first;
+        fid = featureId;
       }
-    }
+    });
   }
 
   m_lastCheckTime = std::chrono::steady_clock::now();
@@ -894,6 +907,52 @@ void LocalAdsManager::OnLocationUpdate(location::GpsInfo const & info, int zoomL
   m_lastFoundFeature = fid;
 }
 
+void LocalAdsManager::FeaturesGrid::Add(FeatureID const & featureId, m2::PointD const & position)
+{
+  m_cells[GetCell(GetCoord(position.x), GetCoord(position.y))].push_back(featureId);
+}
+
+void LocalAdsManager::FeaturesGrid::Remove(FeatureID const & featureId,
+                                           m2::PointD const & position)
+{
+  auto const it = m_cells.find(GetCell(GetCoord(position.x), GetCoord(position.y)));
+  if (it == m_cells.end())
+    return;
+
+  auto & features = it->second;
+  features.erase(std::remove(features.begin(), features.end(), featureId), features.end());
+  if (features.empty())
+    m_cells.erase(it);
+}
+
+template <typename Fn>
+void LocalAdsManager::FeaturesGrid::ForEachInRect(m2::RectD const & rect, Fn && fn) const
+{
+  uint32_t const minX = GetCoord(rect.minX());
+  uint32_t const maxX = GetCoord(rect.maxX());
+  uint32_t const minY = GetCoord(rect.minY());
+  uint32_t const maxY = GetCoord(rect.maxY());
+  for (uint32_t x = minX; x <= maxX; ++x)
+  {
+    for (uint32_t y = minY; y <= maxY; ++y)
+    {
+      auto const it = m_cells.find(GetCell(x, y));
+      if (it == m_cells.end())
+        continue;
+      for (auto const & featureId : it->second)
+        fn(featureId);
+    }
+  }
+}
+
+// static
+uint32_t LocalAdsManager::FeaturesGrid::GetCoord(double mercator)
+{
+  double const coord = (mercator - MercatorBounds::minX) / kFeaturesGridCellSize;
+  return static_cast<uint32_t>(base::clamp(coord, 0.0, static_cast<double>(
+                                                         std::numeric_limits<uint32_t>::max())));
+}
+
 bool LocalAdsManager::BackoffStats::CanRetry() const
 {
   return !m_fileIsAbsent && m_attemptsCount < kMaxDownloadingAttempts &&
@@ -27,6 +27,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace feature
@@ -102,6 +103,25 @@ private:
   };
   using FeaturesCache = std::map<FeatureID, CacheEntry>;
 
+  // Features of the cache by the cells of a uniform grid, so the features near a point
+  // are found without a scan of the whole cache.
+  class FeaturesGrid
+  {
+  public:
+    void Add(FeatureID const & featureId, m2::PointD const & position);
+    void Remove(FeatureID const & featureId, m2::PointD const & position);
+    void Clear() { m_cells.clear(); }
+
+    template <typename Fn>
+    void ForEachInRect(m2::RectD const & rect, Fn && fn) const;
+
+  private:
+    static uint32_t GetCoord(double mercator);
+    static uint64_t GetCell(uint32_t x, uint32_t y) { return (uint64_t{x} << 32) | y; }
+
+    std::unordered_map<uint64_t, std::vector<FeatureID>> m_cells;
+  };
+
   void Start();
 
   void InvalidateImpl();
@@ -154,6 +174,7 @@ private:
   std::mutex m_campaignsMutex;
 
   FeaturesCache m_featuresCache;
+  FeaturesGrid m_featuresGrid;
   mutable std::mutex m_featuresCacheMutex;
 
   ftypes::HashSetMatcher<uint32_t> m_supportedTypes;
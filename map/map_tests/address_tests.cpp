@@ -44,3 +44,39 @@ UNIT_TEST(ReverseGeocoder_Smoke)
   TestAddress(coder, {53.89724, 27.54983}, "проспектнезависимости", "11");
   TestAddress(coder, {53.89745, 27.55835}, "улицакарламаркса", "18А");
 }
+
+UNIT_TEST(ReverseGeocoder_Batch)
+{
+  classificator::Load();
+
+  LocalCountryFile file = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  TEST_EQUAL(dataSource.RegisterMap(file).second, MwmSet::RegResult::Success, ());
+
+  ReverseGeocoder coder(dataSource);
+
+  vector<m2::PointD> points;
+  for (auto const & ll : {ms::LatLon(53.89815, 27.54265), ms::LatLon(53.89953, 27.54189),
+                          ms::LatLon(53.89666, 27.54904), ms::LatLon(53.89724, 27.54983),
+                          ms::LatLon(53.89745, 27.55835), ms::LatLon(53.89816, 27.54266)})
+  {
+    points.push_back(MercatorBounds::FromLatLon(ll));
+  }
+
+  for (size_t numThreads : {1, 4})
+  {
+    vector<ReverseGeocoder::Address> addrs;
+    coder.GetNearbyAddresses(points, addrs, numThreads);
+    TEST_EQUAL(addrs.size(), points.size(), ());
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      ReverseGeocoder::Address addr;
+      coder.GetNearbyAddress(points[i], addr);
+      TEST_EQUAL(addrs[i].m_building.m_id, addr.m_building.m_id, (i, numThreads));
+      TEST_EQUAL(addrs[i].GetStreetName(), addr.GetStreetName(), (i, numThreads));
+      TEST_EQUAL(addrs[i].GetHouseNumber(), addr.GetHouseNumber(), (i, numThreads));
+    }
+  }
+}
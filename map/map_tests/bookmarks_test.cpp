@@ -6,6 +6,7 @@
 
 #include "map/bookmark_helpers.hpp"
 #include "map/framework.hpp"
+#include "map/track.hpp"
 #include "map/user.hpp"
 
 #include "search/result.hpp"
@@ -976,3 +977,27 @@ UNIT_CLASS_TEST(Runner, Bookmarks_BrokenFile)
   auto kmlData = LoadKmlFile(fileName, KmlFileType::Binary);
   TEST(kmlData == nullptr, ());
 }
+
+UNIT_TEST(Bookmarks_TrackSimplification)
+{
+  kml::TrackData data;
+  data.m_id = 1;
+  for (size_t i = 0; i < 10000; ++i)
+    data.m_points.emplace_back(i * 1e-3, (i % 2 == 0 ? 1e-6 : -1e-6) + (i % 1000) * 1e-4);
+  Track const track(std::move(data));
+
+  auto const & points = track.GetPoints();
+  auto const & levels = track.GetSimplifiedPoints();
+  TEST(!levels.empty(), ());
+  for (size_t i = 0; i < levels.size(); ++i)
+  {
+    auto const & level = levels[i].second;
+    auto const & finer = i + 1 < levels.size() ? levels[i + 1].second : points;
+    if (i > 0)
+      TEST_LESS(levels[i - 1].first, levels[i].first, ());
+    TEST_LESS(level.size(), finer.size(), ());
+    TEST_GREATER_OR_EQUAL(level.size(), 2, ());
+    TEST_EQUAL(level.front(), points.front(), ());
+    TEST_EQUAL(level.back(), points.back(), ());
+  }
+}
@@ -184,3 +184,41 @@ UNIT_TEST(GpsTrackStorage_WriteReadWithTrunc)
     TEST_EQUAL(i, 0, ());
   }
 }
+
+UNIT_TEST(GpsTrackStorage_TimeRange)
+{
+  string const filePath = GetGpsTrackFilePath();
+  SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 10000;
+  double const timestamp = 1500000000;
+
+  vector<location::GpsInfo> points;
+  points.reserve(fileMaxItemCount);
+  for (size_t i = 0; i < fileMaxItemCount; ++i)
+    points.emplace_back(Make(timestamp + i, ms::LatLon(55.75 + i * 1e-5, 37.61 - i * 1e-5), 10));
+
+  // Items are appended by small portions as they come from gps
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    for (size_t i = 0; i < points.size(); i += 10)
+      stg.Append(vector<location::GpsInfo>(points.begin() + i, points.begin() + i + 10));
+  }
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+
+    size_t i = 2500;
+    stg.ForEachInTimeRange(timestamp + 2500, timestamp + 7499,
+                           [&](location::GpsInfo const & point)->bool
+    {
+      TEST_EQUAL(point.m_latitude, points[i].m_latitude, ());
+      TEST_EQUAL(point.m_longitude, points[i].m_longitude, ());
+      TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+      ++i;
+      return true;
+    });
+    TEST_EQUAL(i, 7500, ());
+  }
+}
@@ -5,9 +5,9 @@
 #include "storage/country_info_getter.hpp"
 #include "storage/storage.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 
 #include <memory>
 
-std::unique_ptr<m4::Tree<routing::NumMwmId>> MakeNumMwmTree(routing::NumMwmIds const & numMwmIds,
-                                                            storage::CountryInfoGetter const & countryInfoGetter);
+std::unique_ptr<m4::PackedTree<routing::NumMwmId>> MakeNumMwmTree(
+    routing::NumMwmIds const & numMwmIds, storage::CountryInfoGetter const & countryInfoGetter);
@@ -0,0 +1,162 @@
+#include "map/place_page_extras_loader.hpp"
+
+#include "drape_frontend/visual_params.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+size_t const kMaxCacheSize = 512;
+
+// Prefetching is useless when separate POIs can not be tapped.
+double const kPrefetchMinZoom = 16.0;
+double const kPrefetchRectSizeMeters = 300.0;
+size_t const kMaxPrefetchFeatures = 64;
+auto const kPrefetchDelay = chrono::milliseconds(300);
+
+bool IsTappable(FeatureType & ft)
+{
+  return ft.GetFeatureType() == feature::GEOM_POINT ||
+         ftypes::IsAddressObjectChecker::Instance()(ft);
+}
+}  // namespace
+
+PlacePageExtrasLoader::PlacePageExtrasLoader(DataSource const & dataSource,
+                                             GetAddressFn && getAddressFn)
+  : m_dataSource(dataSource)
+  , m_getAddressFn(move(getAddressFn))
+  , m_popularityLoader(dataSource)
+  , m_prefetchGeneration(0)
+{
+}
+
+bool PlacePageExtrasLoader::GetCached(FeatureID const & id, Extras & extras) const
+{
+  lock_guard<mutex> lock(m_cacheMutex);
+  auto const it = m_cache.find(id);
+  if (it == m_cache.end())
+    return false;
+  extras = it->second;
+  return true;
+}
+
+PlacePageExtrasLoader::Extras PlacePageExtrasLoader::Load(FeatureType & ft) const
+{
+  Extras extras;
+  if (ftypes::IsAddressObjectChecker::Instance()(ft))
+    extras.m_address = m_getAddressFn(feature::GetCenter(ft));
+
+  {
+    lock_guard<mutex> lock(m_popularityMutex);
+    extras.m_popularity = m_popularityLoader.Get(ft.GetID());
+  }
+
+  Cache(ft.GetID(), extras);
+  return extras;
+}
+
+void PlacePageExtrasLoader::LoadAsync(FeatureID const & id, OnLoadedFn && onLoaded)
+{
+  ++m_prefetchGeneration;
+
+  GetPlatform().RunTask(Platform::Thread::Background, [this, id, onLoaded = move(onLoaded)]()
+  {
+    Extras extras;
+    if (!GetCached(id, extras))
+    {
+      FeaturesLoaderGuard const guard(m_dataSource, id.m_mwmId);
+      FeatureType ft;
+      if (!guard.GetFeatureByIndex(id.m_index, ft))
+        return;
+      Load(ft);
+    }
+
+    GetPlatform().RunTask(Platform::Thread::Gui, [id, onLoaded]() { onLoaded(id); });
+  });
+}
+
+void PlacePageExtrasLoader::Prefetch(ScreenBase const & screen)
+{
+  uint64_t const generation = ++m_prefetchGeneration;
+  if (df::GetZoomLevel(screen.GetScale()) < kPrefetchMinZoom)
+    return;
+
+  auto const rect =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(screen.GetOrg(), kPrefetchRectSizeMeters);
+  GetPlatform().RunDelayedTask(Platform::Thread::Background, kPrefetchDelay,
+                               [this, rect, generation]() { PrefetchImpl(rect, generation); });
+}
+
+void PlacePageExtrasLoader::OnMwmDeregistered(platform::LocalCountryFile const & localFile)
+{
+  {
+    lock_guard<mutex> lock(m_popularityMutex);
+    m_popularityLoader.OnMwmDeregistered(localFile);
+  }
+
+  lock_guard<mutex> lock(m_cacheMutex);
+  for (auto it = m_cache.begin(); it != m_cache.end();)
+  {
+    if (it->first.m_mwmId.IsDeregistered(localFile))
+      it = m_cache.erase(it);
+    else
+      ++it;
+  }
+}
+
+void PlacePageExtrasLoader::Cache(FeatureID const & id, Extras const & extras) const
+{
+  lock_guard<mutex> lock(m_cacheMutex);
+  if (!m_cache.emplace(id, extras).second)
+    return;
+
+  m_cacheOrder.push_back(id);
+  while (m_cacheOrder.size() > kMaxCacheSize)
+  {
+    // Ids of features erased on mwm deregistration are still in the queue.
+    m_cache.erase(m_cacheOrder.front());
+    m_cacheOrder.pop_front();
+  }
+}
+
+void PlacePageExtrasLoader::PrefetchImpl(m2::RectD const & rect, uint64_t generation)
+{
+  if (generation != m_prefetchGeneration)
+    return;
+
+  vector<FeatureID> ids;
+  m_dataSource.ForEachInRect([&](FeatureType & ft)
+  {
+    if (ids.size() < kMaxPrefetchFeatures && IsTappable(ft))
+      ids.push_back(ft.GetID());
+  }, rect, scales::GetUpperScale());
+
+  Extras extras;
+  for (auto const & id : ids)
+  {
+    if (generation != m_prefetchGeneration)
+      return;
+
+    if (GetCached(id, extras))
+      continue;
+
+    FeaturesLoaderGuard const guard(m_dataSource, id.m_mwmId);
+    FeatureType ft;
+    if (guard.GetFeatureByIndex(id.m_index, ft))
+      Load(ft);
+  }
+}
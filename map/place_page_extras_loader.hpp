@@ -0,0 +1,80 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+#include "indexer/popularity_loader.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+class DataSource;
+class FeatureType;
+
+// Loads parts of place page data which are slow to get: the address of a feature, which needs
+// reverse geocoding, and its popularity, which needs the popularity ranks of the mwm.
+// Loaded data is cached, so the place page of a feature shown again, or of a feature prefetched
+// near the viewport center, is filled immediately.
+//
+// *NOTE* Prefetch() and LoadAsync() must be called on the gui thread. Other methods are
+// thread-safe.
+class PlacePageExtrasLoader
+{
+public:
+  struct Extras
+  {
+    std::string m_address;
+    uint8_t m_popularity = 0;
+  };
+
+  using GetAddressFn = std::function<std::string(m2::PointD const & pt)>;
+  using OnLoadedFn = std::function<void(FeatureID const & id)>;
+
+  PlacePageExtrasLoader(DataSource const & dataSource, GetAddressFn && getAddressFn);
+
+  // Returns true and fills |extras| when extras of |id| are cached.
+  bool GetCached(FeatureID const & id, Extras & extras) const;
+
+  // Loads extras of |ft| on the calling thread and caches them.
+  Extras Load(FeatureType & ft) const;
+
+  // Loads extras of |id| on the background thread and calls |onLoaded| on the gui thread.
+  // Prefetching in progress is cancelled, so a tapped feature does not wait for it.
+  void LoadAsync(FeatureID const & id, OnLoadedFn && onLoaded);
+
+  // Loads extras of features near the center of |screen| on the background thread. The request
+  // is delayed a bit and dropped if the viewport changes again, so nothing is loaded while the
+  // map is being moved.
+  void Prefetch(ScreenBase const & screen);
+
+  void OnMwmDeregistered(platform::LocalCountryFile const & localFile);
+
+private:
+  void Cache(FeatureID const & id, Extras const & extras) const;
+  void PrefetchImpl(m2::RectD const & rect, uint64_t generation);
+
+  DataSource const & m_dataSource;
+  GetAddressFn m_getAddressFn;
+
+  mutable std::mutex m_popularityMutex;
+  CachingPopularityLoader m_popularityLoader;
+
+  mutable std::mutex m_cacheMutex;
+  mutable std::map<FeatureID, Extras> m_cache;
+  // Ids of cached features in order of insertion, the oldest ones are evicted first.
+  mutable std::deque<FeatureID> m_cacheOrder;
+
+  // Incremented on every new request to cancel outdated prefetching.
+  std::atomic<uint64_t> m_prefetchGeneration;
+
+  DISALLOW_COPY_AND_MOVE(PlacePageExtrasLoader);
+};
@@ -220,6 +220,10 @@ public:
   void SetPopularity(uint8_t popularity) { m_popularity = popularity; }
   uint8_t GetPopularity() const { return m_popularity; }
 
+  /// Address and popularity are not filled yet and are being loaded in background.
+  void SetExtrasPending(bool pending) { m_extrasPending = pending; }
+  bool AreExtrasPending() const { return m_extrasPending; }
+
 private:
   std::string FormatSubtitle(bool withType) const;
   void GetPrefferedNames(std::string & primaryName, std::string & secondaryName) const;
@@ -309,6 +313,7 @@ private:
   boost::optional<ftypes::IsHotelChecker::Type> m_hotelType;
 
   uint8_t m_popularity = 0;
+  bool m_extrasPending = false;
 };
 
 namespace rating
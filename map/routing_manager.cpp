@@ -12,6 +12,7 @@
 #include "routing/online_absent_fetcher.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_helpers.hpp"
+#include "routing/traffic_stash.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
 
@@ -415,6 +416,9 @@ void RoutingManager::SetRouterImpl(RouterType type)
                                          m_routingSession, dataSource);
 
   m_routingSession.SetRoutingSettings(GetRoutingSettings(vehicleType));
+  m_routingSession.SetTrafficStash(vehicleType == VehicleType::Car
+                                       ? make_shared<TrafficStash>(m_routingSession, numMwmIds)
+                                       : nullptr);
   m_routingSession.SetRouter(move(router), move(fetcher));
   m_currentRouterType = type;
 }
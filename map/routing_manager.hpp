@@ -131,6 +131,10 @@ public:
   {
     m_routingBuildingCallback = buildingCallback;
   }
+  RouteBuildingCallback const & GetRouteBuildingListener() const
+  {
+    return m_routingBuildingCallback;
+  }
   /// See warning above.
   void SetRouteProgressListener(routing::ProgressCallback const & progressCallback)
   {
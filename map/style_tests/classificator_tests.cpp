@@ -146,6 +146,37 @@ UNIT_TEST(Classificator_DrawingRules)
   });
 }
 
+UNIT_TEST(Classificator_CompiledDrawRules)
+{
+  UnitTestInitPlatform();
+  styles::RunForEveryMapStyle([](MapStyle)
+  {
+    Classificator const & c = classif();
+
+    c.ForEachTree([&c](ClassifObject const * p, uint32_t type)
+    {
+      for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+      {
+        for (auto const geomType : {GEOM_POINT, GEOM_LINE, GEOM_AREA})
+        {
+          drule::KeysT expected;
+          p->GetSuitable(scale, geomType, expected);
+
+          drule::KeysT keys;
+          feature::GetDrawRule({type}, scale, geomType, keys);
+
+          TEST_EQUAL(keys.size(), expected.size(), (c.GetReadableObjectName(type), scale));
+          for (size_t i = 0; i < keys.size(); ++i)
+          {
+            TEST(keys[i] == expected[i], (c.GetReadableObjectName(type), scale));
+            TEST_EQUAL(keys[i].m_priority, expected[i].m_priority, ());
+          }
+        }
+      }
+    });
+  });
+}
+
 namespace
 {
 
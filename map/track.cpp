@@ -2,8 +2,18 @@
 #include "map/bookmark_helpers.hpp"
 #include "map/user_mark_id_storage.hpp"
 
+#include "indexer/scales.hpp"
+
 #include "geometry/distance_on_sphere.hpp"
 #include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/simplification.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// static
+std::array<int, 4> constexpr Track::kSimplificationZooms;
 
 Track::Track(kml::TrackData && data)
   : Base(data.m_id == kml::kInvalidTrackId ? UserMarkIdStorage::Instance().GetNextTrackId() : data.m_id)
@@ -12,6 +22,7 @@ Track::Track(kml::TrackData && data)
 {
   m_data.m_id = GetId();
   ASSERT_GREATER(m_data.m_points.size(), 1, ());
+  Simplify();
 }
 
 string Track::GetName() const
@@ -78,6 +89,28 @@ std::vector<m2::PointD> const & Track::GetPoints() const
   return m_data.m_points;
 }
 
+void Track::Simplify()
+{
+  // Every level is simplified from the finer one, so the line doesn't jump when levels are
+  // switched. Levels which don't drop any point aren't stored, the finer level is drawn instead.
+  m2::SquaredDistanceFromSegmentToPoint<m2::PointD> distFn;
+  m_simplifiedPoints.reserve(kSimplificationZooms.size());
+  std::vector<m2::PointD> const * finer = &m_data.m_points;
+  for (auto it = kSimplificationZooms.crbegin(); it != kSimplificationZooms.crend(); ++it)
+  {
+    std::vector<m2::PointD> coarser;
+    double const eps = std::pow(scales::GetEpsilonForSimplify(*it), 2);
+    SimplifyDP(finer->cbegin(), finer->cend(), eps, distFn,
+               [&coarser](m2::PointD const & p) { coarser.push_back(p); });
+    if (coarser.size() < 2 || coarser.size() == finer->size())
+      continue;
+
+    m_simplifiedPoints.emplace_back(*it, std::move(coarser));
+    finer = &m_simplifiedPoints.back().second;
+  }
+  std::reverse(m_simplifiedPoints.begin(), m_simplifiedPoints.end());
+}
+
 void Track::Attach(kml::MarkGroupId groupId)
 {
   ASSERT(!m_groupID, ());
@@ -4,10 +4,15 @@
 
 #include "drape_frontend/user_marks_provider.hpp"
 
+#include <array>
+
 class Track : public df::UserLineMark
 {
   using Base = df::UserLineMark;
 public:
+  // Zooms the points are simplified for. The whole geometry is drawn at greater zooms.
+  static std::array<int, 4> constexpr kSimplificationZooms = {{5, 8, 11, 14}};
+
   explicit Track(kml::TrackData && data);
 
   bool IsDirty() const override { return m_isDirty; }
@@ -26,6 +31,7 @@ public:
   float GetWidth(size_t layerIndex) const override;
   float GetDepth(size_t layerIndex) const override;
   std::vector<m2::PointD> const & GetPoints() const override;
+  SimplifiedPoints const & GetSimplifiedPoints() const override { return m_simplifiedPoints; }
 
   kml::MarkGroupId GetGroupId() const { return m_groupID; }
 
@@ -33,7 +39,10 @@ public:
   void Detach();
 
 private:
+  void Simplify();
+
   kml::TrackData m_data;
+  SimplifiedPoints m_simplifiedPoints;
   kml::MarkGroupId m_groupID;
   mutable bool m_isDirty = true;
 };
@@ -128,6 +128,7 @@ void TrafficManager::Clear()
   m_activeRoutingMwms.clear();
   m_requestedMwms.clear();
   m_trafficETags.clear();
+  m_lastTrafficInfos.clear();
 }
 
 void TrafficManager::SetDrapeEngine(ref_ptr<df::DrapeEngine> engine)
@@ -249,14 +250,23 @@ void TrafficManager::ThreadRoutine()
       if (!mwm.IsAlive())
         continue;
 
-      traffic::TrafficInfo info(mwm, m_currentDataVersion);
-
       string tag;
+      traffic::TrafficInfo info;
+      bool hasLastInfo = false;
       {
         lock_guard<mutex> lock(m_mutex);
         tag = m_trafficETags[mwm];
+        auto const it = m_lastTrafficInfos.find(mwm);
+        if (it != m_lastTrafficInfos.end())
+        {
+          info = it->second;
+          hasLastInfo = true;
+        }
       }
 
+      if (!hasLastInfo)
+        info = traffic::TrafficInfo(mwm, m_currentDataVersion);
+
       if (info.ReceiveTrafficData(tag))
       {
         OnTrafficDataResponse(move(info));
@@ -374,6 +384,7 @@ void TrafficManager::OnTrafficRequestFailed(traffic::TrafficInfo && info)
 
 void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
 {
+  bool isChanged = true;
   {
     lock_guard<mutex> lock(m_mutex);
 
@@ -386,20 +397,27 @@ void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
     it->second.m_isWaitingForResponse = false;
     it->second.m_lastAvailability = info.GetAvailability();
 
-    if (!info.GetColoring().empty())
+    if (!info.GetColoring().IsEmpty())
     {
       // Update cache.
       size_t constexpr kElementSize = sizeof(traffic::TrafficInfo::RoadSegmentId) + sizeof(traffic::SpeedGroup);
-      size_t const dataSize = info.GetColoring().size() * kElementSize;
+      size_t const dataSize = info.GetColoring().GetSize() * kElementSize;
       m_currentCacheSizeBytes += (dataSize - it->second.m_dataSize);
       it->second.m_dataSize = dataSize;
+
+      // Not modified data and empty deltas are not sent to drape and routing again.
+      auto const lastIt = m_lastTrafficInfos.find(info.GetMwmId());
+      isChanged = lastIt == m_lastTrafficInfos.end() ||
+                  lastIt->second.GetColoring().GetValues() != info.GetColoring().GetValues();
+      m_lastTrafficInfos[info.GetMwmId()] = info;
+
       ShrinkCacheToAllowableSize();
     }
 
     UpdateState();
   }
 
-  if (!info.GetColoring().empty())
+  if (isChanged && !info.GetColoring().IsEmpty())
   {
     m_drapeEngine.SafeCall(&df::DrapeEngine::UpdateTraffic,
                            static_cast<traffic::TrafficInfo const &>(info));
@@ -457,6 +475,7 @@ void TrafficManager::ClearCache(MwmSet::MwmId const & mwmId)
   }
   m_mwmCache.erase(it);
   m_trafficETags.erase(mwmId);
+  m_lastTrafficInfos.erase(mwmId);
   m_activeDrapeMwms.erase(mwmId);
   m_activeRoutingMwms.erase(mwmId);
   m_lastDrapeMwmsByRect.clear();
@@ -175,6 +175,9 @@ private:
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
   map<MwmSet::MwmId, string> m_trafficETags;
+  // The last received traffic of mwms. It's copied for the next request of the mwm,
+  // so the keys are not read again and the values are updated by a delta.
+  map<MwmSet::MwmId, traffic::TrafficInfo> m_lastTrafficInfos;
 
   atomic<bool> m_isPaused;
 
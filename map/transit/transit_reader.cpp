@@ -1,6 +1,7 @@
 #include "map/transit/transit_reader.hpp"
 
 #include "transit/transit_graph_data.hpp"
+#include "transit/transit_graph_data_cache.hpp"
 
 #include "indexer/data_source.hpp"
 #include "indexer/drawing_rules.hpp"
@@ -77,11 +78,10 @@ void ReadTransitTask::Do()
   CHECK(mwmValue.m_cont.IsExist(TRANSIT_FILE_TAG),
         ("No transit section in mwm, but transit route was built with it. mwmId:", m_mwmId));
 
-  auto reader = mwmValue.m_cont.GetReader(TRANSIT_FILE_TAG);
-  CHECK(reader.GetPtr() != nullptr, ());
-
-  transit::GraphData graphData;
-  graphData.DeserializeForRendering(*reader.GetPtr());
+  // The section is shared with the routers which have built the route.
+  auto const transitData = transit::GraphDataCache::Instance().Get(m_mwmId, mwmValue.m_cont);
+  CHECK(transitData, ());
+  auto const & graphData = *transitData;
 
   FillItemsByIdMap(graphData.GetStops(), m_transitInfo->m_stops);
   for (auto const & stop : m_transitInfo->m_stops)
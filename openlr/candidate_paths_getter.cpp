@@ -147,11 +147,24 @@ bool CandidatePathsGetter::GetLineCandidatesForPoints(
     double const distanceToNextPointM =
         (isLastPoint ? points[i - 1] : points[i]).m_distanceToNextPoint;
 
+    // The points are got even if the lines are cached, because the fake edges
+    // of the projections are added to the graph.
     vector<m2::PointD> pointCandidates;
     m_pointsGetter.GetCandidatePoints(MercatorBounds::FromLatLon(points[i].m_latLon),
                                       pointCandidates);
-    GetLineCandidates(points[i], isLastPoint, distanceToNextPointM, pointCandidates,
-                      lineCandidates.back());
+
+    if (auto const * cached = m_cache.Find(points[i], isLastPoint, distanceToNextPointM))
+    {
+      ++m_stats.m_candidatePathsCacheHits;
+      lineCandidates.back() = *cached;
+    }
+    else
+    {
+      ++m_stats.m_candidatePathsCacheMisses;
+      GetLineCandidates(points[i], isLastPoint, distanceToNextPointM, pointCandidates,
+                        lineCandidates.back());
+      m_cache.Add(points[i], isLastPoint, distanceToNextPointM, lineCandidates.back());
+    }
 
     if (lineCandidates.back().empty())
     {
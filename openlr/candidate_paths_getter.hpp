@@ -1,5 +1,6 @@
 #pragma once
 
+#include "openlr/candidates_cache.hpp"
 #include "openlr/graph.hpp"
 #include "openlr/openlr_model.hpp"
 #include "openlr/road_info_getter.hpp"
@@ -21,8 +22,12 @@ class CandidatePathsGetter
 {
 public:
   CandidatePathsGetter(CandidatePointsGetter & pointsGetter, Graph & graph,
-                       RoadInfoGetter & infoGetter, v2::Stats & stat)
-    : m_pointsGetter(pointsGetter), m_graph(graph), m_infoGetter(infoGetter), m_stats(stat)
+                       RoadInfoGetter & infoGetter, CandidatePathsCache & cache, v2::Stats & stat)
+    : m_pointsGetter(pointsGetter)
+    , m_graph(graph)
+    , m_infoGetter(infoGetter)
+    , m_cache(cache)
+    , m_stats(stat)
   {
   }
 
@@ -123,6 +128,7 @@ private:
   CandidatePointsGetter & m_pointsGetter;
   Graph & m_graph;
   RoadInfoGetter & m_infoGetter;
+  CandidatePathsCache & m_cache;
   v2::Stats & m_stats;
 };
 }  // namespace openlr
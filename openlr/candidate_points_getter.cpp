@@ -15,6 +15,13 @@ namespace openlr
 void CandidatePointsGetter::GetJunctionPointCandidates(m2::PointD const & p,
                                                        vector<m2::PointD> & candidates)
 {
+  if (m_cache.Find(p, candidates))
+  {
+    ++m_stats.m_candidatePointsCacheHits;
+    return;
+  }
+  ++m_stats.m_candidatePointsCacheMisses;
+
   // TODO(mgsergio): Get optimal value using experiments on a sample.
   // Or start with small radius and scale it up when there are too few points.
   size_t const kRectSideMeters = 110;
@@ -46,6 +53,7 @@ void CandidatePointsGetter::GetJunctionPointCandidates(m2::PointD const & p,
                    [](m2::PointD const & a, m2::PointD const & b) { return a == b; });
 
   candidates.resize(min(m_maxJunctionCandidates, candidates.size()));
+  m_cache.Add(p, candidates);
 }
 
 void CandidatePointsGetter::EnrichWithProjectionPoints(m2::PointD const & p,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "openlr/candidates_cache.hpp"
 #include "openlr/graph.hpp"
 #include "openlr/stats.hpp"
 
@@ -17,11 +18,14 @@ class CandidatePointsGetter
 {
 public:
   CandidatePointsGetter(size_t const maxJunctionCandidates, size_t const maxProjectionCandidates,
-                        DataSource const & dataSource, Graph & graph)
+                        DataSource const & dataSource, Graph & graph, CandidatePointsCache & cache,
+                        v2::Stats & stat)
     : m_maxJunctionCandidates(maxJunctionCandidates)
     , m_maxProjectionCandidates(maxProjectionCandidates)
     , m_dataSource(dataSource)
     , m_graph(graph)
+    , m_cache(cache)
+    , m_stats(stat)
   {
   }
 
@@ -40,5 +44,7 @@ private:
 
   DataSource const & m_dataSource;
   Graph & m_graph;
+  CandidatePointsCache & m_cache;
+  v2::Stats & m_stats;
 };
 }  // namespace openlr
@@ -0,0 +1,79 @@
+#include "openlr/candidates_cache.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+namespace
+{
+// Mercator units per a step of the quantization, it's about a meter.
+double constexpr kQuantizationStep = 1e-5;
+// The caches are cleared when they grow bigger.
+size_t constexpr kMaxCandidatePoints = 1000000;
+size_t constexpr kMaxCandidatePaths = 100000;
+}  // namespace
+
+namespace openlr
+{
+uint64_t GetQuantizedPointKey(m2::PointD const & p)
+{
+  auto const x = static_cast<uint32_t>(static_cast<int32_t>(llround(p.x / kQuantizationStep)));
+  auto const y = static_cast<uint32_t>(static_cast<int32_t>(llround(p.y / kQuantizationStep)));
+  return (static_cast<uint64_t>(x) << 32) | y;
+}
+
+// CandidatePointsCache ----------------------------------------------------------------------
+bool CandidatePointsCache::Find(m2::PointD const & p, vector<m2::PointD> & candidates) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_candidates.find(GetQuantizedPointKey(p));
+  if (it == m_candidates.cend())
+    return false;
+
+  candidates.insert(candidates.end(), it->second.cbegin(), it->second.cend());
+  return true;
+}
+
+void CandidatePointsCache::Add(m2::PointD const & p, vector<m2::PointD> const & candidates)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_candidates.size() >= kMaxCandidatePoints)
+    m_candidates.clear();
+  m_candidates.emplace(GetQuantizedPointKey(p), candidates);
+}
+
+size_t CandidatePointsCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_candidates.size();
+}
+
+// CandidatePathsCache -----------------------------------------------------------------------
+vector<Graph::EdgeVector> const * CandidatePathsCache::Find(LocationReferencePoint const & p,
+                                                            bool isLastPoint,
+                                                            double distanceToNextPointM) const
+{
+  auto const it = m_candidates.find(MakeKey(p, isLastPoint, distanceToNextPointM));
+  return it == m_candidates.cend() ? nullptr : &it->second;
+}
+
+void CandidatePathsCache::Add(LocationReferencePoint const & p, bool isLastPoint,
+                              double distanceToNextPointM,
+                              vector<Graph::EdgeVector> const & candidates)
+{
+  if (m_candidates.size() >= kMaxCandidatePaths)
+    m_candidates.clear();
+  m_candidates.emplace(MakeKey(p, isLastPoint, distanceToNextPointM), candidates);
+}
+
+// static
+CandidatePathsCache::Key CandidatePathsCache::MakeKey(LocationReferencePoint const & p,
+                                                      bool isLastPoint,
+                                                      double distanceToNextPointM)
+{
+  return make_tuple(GetQuantizedPointKey(MercatorBounds::FromLatLon(p.m_latLon)), p.m_bearing,
+                    p.m_functionalRoadClass, isLastPoint, distanceToNextPointM);
+}
+}  // namespace openlr
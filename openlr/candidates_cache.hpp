@@ -0,0 +1,63 @@
+#pragma once
+
+#include "openlr/graph.hpp"
+#include "openlr/openlr_model.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace openlr
+{
+// Returns a key of |p| which is the same for the points closer than about a meter.
+uint64_t GetQuantizedPointKey(m2::PointD const & p);
+
+// Junction candidates of the location reference points which are shared by the decoding threads.
+// Only coordinates are kept, so the candidates don't depend on the data source of a thread.
+class CandidatePointsCache
+{
+public:
+  CandidatePointsCache() = default;
+
+  // Returns false if there're no candidates for |p|.
+  bool Find(m2::PointD const & p, std::vector<m2::PointD> & candidates) const;
+  void Add(m2::PointD const & p, std::vector<m2::PointD> const & candidates);
+
+  size_t GetSize() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<uint64_t, std::vector<m2::PointD>> m_candidates;
+
+  DISALLOW_COPY_AND_MOVE(CandidatePointsCache);
+};
+
+// Line candidates of the location reference points which are decoded by a thread. The candidates
+// contain the features of the data source of the thread, so the cache isn't shared.
+class CandidatePathsCache
+{
+public:
+  // Returns nullptr if there're no candidates for the point.
+  std::vector<Graph::EdgeVector> const * Find(LocationReferencePoint const & p, bool isLastPoint,
+                                              double distanceToNextPointM) const;
+  void Add(LocationReferencePoint const & p, bool isLastPoint, double distanceToNextPointM,
+           std::vector<Graph::EdgeVector> const & candidates);
+
+  size_t GetSize() const { return m_candidates.size(); }
+
+private:
+  using Key = std::tuple<uint64_t, uint8_t, FunctionalRoadClass, bool, double>;
+
+  static Key MakeKey(LocationReferencePoint const & p, bool isLastPoint,
+                     double distanceToNextPointM);
+
+  std::map<Key, std::vector<Graph::EdgeVector>> m_candidates;
+};
+}  // namespace openlr
@@ -0,0 +1,80 @@
+#include "openlr/decoded_paths_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+namespace
+{
+// Coordinates of the location reference points are given with this precision.
+double constexpr kCoordFactor = 1e5;
+
+template <typename T>
+void Append(string & key, T const & value)
+{
+  key.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+}  // namespace
+
+namespace openlr
+{
+DecodedPathsCache::DecodedPathsCache(size_t capacity) : m_capacity(capacity)
+{
+  CHECK_GREATER(m_capacity, 0, ());
+}
+
+bool DecodedPathsCache::Find(LinearLocationReference const & locRef, Path & path)
+{
+  auto const it = m_index.find(MakeKey(locRef));
+  if (it == m_index.cend())
+    return false;
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  path = it->second->second;
+  return true;
+}
+
+void DecodedPathsCache::Add(LinearLocationReference const & locRef, Path const & path)
+{
+  auto key = MakeKey(locRef);
+  auto const it = m_index.find(key);
+  if (it != m_index.cend())
+  {
+    it->second->second = path;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  if (m_index.size() == m_capacity)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front(move(key), path);
+  m_index.emplace(m_entries.front().first, m_entries.begin());
+}
+
+// static
+string DecodedPathsCache::MakeKey(LinearLocationReference const & locRef)
+{
+  string key;
+  for (auto const & p : locRef.m_points)
+  {
+    Append(key, static_cast<int32_t>(llround(p.m_latLon.lat * kCoordFactor)));
+    Append(key, static_cast<int32_t>(llround(p.m_latLon.lon * kCoordFactor)));
+    Append(key, p.m_bearing);
+    Append(key, p.m_functionalRoadClass);
+    Append(key, p.m_formOfWay);
+    Append(key, p.m_distanceToNextPoint);
+    Append(key, p.m_lfrcnp);
+    Append(key, p.m_againstDrivingDirection);
+  }
+  Append(key, locRef.m_positiveOffsetMeters);
+  Append(key, locRef.m_negativeOffsetMeters);
+  return key;
+}
+}  // namespace openlr
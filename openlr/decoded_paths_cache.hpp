@@ -0,0 +1,38 @@
+#pragma once
+
+#include "openlr/decoded_path.hpp"
+#include "openlr/openlr_model.hpp"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace openlr
+{
+// LRU cache of the decoded paths by location references. Live feeds repeat the same locations
+// all the time, so a location is decoded once while it's in the cache. Empty paths of the
+// locations which weren't decoded are kept too.
+class DecodedPathsCache
+{
+public:
+  explicit DecodedPathsCache(size_t capacity);
+
+  // Returns false if there's no path for |locRef|. The found path becomes the most recently used.
+  bool Find(LinearLocationReference const & locRef, Path & path);
+  void Add(LinearLocationReference const & locRef, Path const & path);
+
+  size_t GetSize() const { return m_index.size(); }
+
+private:
+  using Entries = std::list<std::pair<std::string, Path>>;
+
+  static std::string MakeKey(LinearLocationReference const & locRef);
+
+  size_t const m_capacity;
+  // The most recently used entries go first.
+  Entries m_entries;
+  std::unordered_map<std::string, Entries::iterator> m_index;
+};
+}  // namespace openlr
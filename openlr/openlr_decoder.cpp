@@ -3,6 +3,7 @@
 #include "openlr/cache_line_size.hpp"
 #include "openlr/candidate_paths_getter.hpp"
 #include "openlr/candidate_points_getter.hpp"
+#include "openlr/candidates_cache.hpp"
 #include "openlr/decoded_path.hpp"
 #include "openlr/graph.hpp"
 #include "openlr/helpers.hpp"
@@ -281,8 +282,12 @@ private:
 class SegmentsDecoderV2
 {
 public:
-  SegmentsDecoderV2(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf)
-    : m_dataSource(dataSource), m_graph(dataSource, move(cmf)), m_infoGetter(dataSource)
+  SegmentsDecoderV2(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf,
+                    CandidatePointsCache & pointsCache)
+    : m_dataSource(dataSource)
+    , m_graph(dataSource, move(cmf))
+    , m_infoGetter(dataSource)
+    , m_pointsCache(pointsCache)
   {
   }
 
@@ -303,8 +308,8 @@ public:
     LOG(LDEBUG, ("Decoding segment:", segment.m_segmentId, "with", points.size(), "points"));
 
     CandidatePointsGetter pointsGetter(kMaxJunctionCandidates, kMaxProjectionCandidates, m_dataSource,
-                                       m_graph);
-    CandidatePathsGetter pathsGetter(pointsGetter, m_graph, m_infoGetter, stat);
+                                       m_graph, m_pointsCache, stat);
+    CandidatePathsGetter pathsGetter(pointsGetter, m_graph, m_infoGetter, m_pathsCache, stat);
 
     if (!pathsGetter.GetLineCandidatesForPoints(points, lineCandidates))
       return false;
@@ -362,6 +367,8 @@ private:
   DataSource const & m_dataSource;
   Graph m_graph;
   RoadInfoGetter m_infoGetter;
+  CandidatePointsCache & m_pointsCache;
+  CandidatePathsCache m_pathsCache;
 };
 
 size_t constexpr GetOptimalBatchSize()
@@ -403,10 +410,14 @@ bool OpenLRDecoder::SegmentsFilter::Matches(LinearSegment const & segment) const
 // OpenLRDecoder -----------------------------------------------------------------------------
 OpenLRDecoder::OpenLRDecoder(vector<FrozenDataSource> const & dataSources,
                              CountryParentNameGetter const & countryParentNameGetter)
-  : m_dataSources(dataSources), m_countryParentNameGetter(countryParentNameGetter)
+  : m_dataSources(dataSources)
+  , m_countryParentNameGetter(countryParentNameGetter)
+  , m_candidatePointsCache(make_unique<CandidatePointsCache>())
 {
 }
 
+OpenLRDecoder::~OpenLRDecoder() = default;
+
 void OpenLRDecoder::DecodeV1(vector<LinearSegment> const & segments, uint32_t const numThreads,
                              vector<DecodedPath> & paths)
 {
@@ -416,21 +427,22 @@ void OpenLRDecoder::DecodeV1(vector<LinearSegment> const & segments, uint32_t co
 void OpenLRDecoder::DecodeV2(vector<LinearSegment> const & segments, uint32_t const numThreads,
                              vector<DecodedPath> & paths)
 {
-  Decode<SegmentsDecoderV2, v2::Stats>(segments, numThreads, paths);
+  Decode<SegmentsDecoderV2, v2::Stats>(segments, numThreads, paths, *m_candidatePointsCache);
+  LOG(LINFO, ("Candidate points cache size:", m_candidatePointsCache->GetSize()));
 }
 
-template <typename Decoder, typename Stats>
+template <typename Decoder, typename Stats, typename... Args>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
-                           uint32_t const numThreads, vector<DecodedPath> & paths)
+                           uint32_t const numThreads, vector<DecodedPath> & paths, Args &... args)
 {
-  auto const worker = [&segments, &paths, numThreads, this](size_t threadNum, DataSource const & dataSource,
-                                                            Stats & stat) {
+  auto const worker = [&segments, &paths, numThreads, &args..., this](
+                          size_t threadNum, DataSource const & dataSource, Stats & stat) {
     size_t constexpr kBatchSize = GetOptimalBatchSize();
     size_t constexpr kProgressFrequency = 100;
 
     size_t const numSegments = segments.size();
 
-    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter));
+    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter), args...);
     base::Timer timer;
     for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
     {
@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -19,6 +20,7 @@ struct DecodedPath;
 
 DECLARE_EXCEPTION(DecoderError, RootException);
 
+class CandidatePointsCache;
 class Graph;
 class RoadInfoGetter;
 
@@ -42,6 +44,7 @@ public:
 
   OpenLRDecoder(std::vector<FrozenDataSource> const & dataSources,
                 CountryParentNameGetter const & countryParentNameGetter);
+  ~OpenLRDecoder();
 
   // Maps partner segments to mwm paths. |segments| should be sorted by partner id.
   void DecodeV1(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
@@ -51,11 +54,14 @@ public:
                 std::vector<DecodedPath> & paths);
 
 private:
-  template <typename Decoder, typename Stats>
+  // |args| are passed to the constructor of |Decoder| of every thread.
+  template <typename Decoder, typename Stats, typename... Args>
   void Decode(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
-              std::vector<DecodedPath> & paths);
+              std::vector<DecodedPath> & paths, Args &... args);
 
   std::vector<FrozenDataSource> const & m_dataSources;
   CountryParentNameGetter m_countryParentNameGetter;
+  // Candidates of the points which are shared by the threads of all DecodeV2() calls.
+  std::unique_ptr<CandidatePointsCache> m_candidatePointsCache;
 };
 }  // namespace openlr
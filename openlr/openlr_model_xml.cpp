@@ -5,6 +5,8 @@
 
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/cctype.hpp"
 #include "std/cstring.hpp"
 #include "std/type_traits.hpp"
 
@@ -275,6 +277,100 @@ bool ParseOpenlr(pugi::xml_document const & document, vector<LinearSegment> & se
   return true;
 }
 
+bool SegmentsStreamReader::Read(LinearSegment & segment)
+{
+  string xml;
+  while (ReadSegmentXML(xml))
+  {
+    pugi::xml_document document;
+    auto const result = document.load_buffer(xml.data(), xml.size());
+    if (!result)
+    {
+      LOG(LERROR, ("Can't parse segment:", result.description()));
+      continue;
+    }
+
+    auto const node = document.child("reportSegments");
+    if (NoLocationReferenceButCoordinates(node))
+    {
+      LOG(LWARNING, ("A segment with <coordinates> instead of <optionLinearLocationReference> "
+                     "encounted, skipping..."));
+      continue;
+    }
+
+    segment = LinearSegment();
+    if (!SegmentFromXML(node, segment))
+    {
+      LOG(LERROR, ("Can't parse segment, skipping..."));
+      continue;
+    }
+
+    return true;
+  }
+  return false;
+}
+
+bool SegmentsStreamReader::ReadSegmentXML(string & xml)
+{
+  size_t constexpr kChunkSize = 64 * 1024;
+  string const kOpenTag = "<reportSegments";
+  string const kCloseTag = "</reportSegments>";
+
+  size_t begin = string::npos;
+  while (true)
+  {
+    if (begin == string::npos)
+    {
+      // The segments are not nested, so the first tag which isn't a prefix
+      // of another one opens a segment.
+      for (begin = m_buffer.find(kOpenTag); begin != string::npos;
+           begin = m_buffer.find(kOpenTag, begin + 1))
+      {
+        auto const next = begin + kOpenTag.size();
+        if (next < m_buffer.size() && (m_buffer[next] == '>' || isspace(m_buffer[next])))
+          break;
+      }
+
+      if (begin == string::npos)
+      {
+        // The tail can be a beginning of the tag.
+        auto const tail = min(m_buffer.size(), kOpenTag.size());
+        m_buffer.erase(0, m_buffer.size() - tail);
+      }
+    }
+
+    if (begin != string::npos)
+    {
+      auto const end = m_buffer.find(kCloseTag, begin);
+      if (end != string::npos)
+      {
+        auto const next = end + kCloseTag.size();
+        xml.assign(m_buffer, begin, next - begin);
+        m_buffer.erase(0, next);
+        return true;
+      }
+    }
+
+    // The data which is available is taken without waiting for a full chunk,
+    // so a live feed is parsed as it comes.
+    char chunk[kChunkSize];
+    auto size = static_cast<size_t>(m_stream.readsome(chunk, kChunkSize));
+    if (size == 0)
+    {
+      if (!m_stream.get(chunk[0]))
+        return false;
+      size = 1 + static_cast<size_t>(m_stream.readsome(chunk + 1, kChunkSize - 1));
+    }
+
+    if (begin != string::npos && begin > 0)
+    {
+      m_buffer.erase(0, begin);
+      begin = 0;
+    }
+    m_buffer.append(chunk, size);
+  }
+}
+
 bool SegmentFromXML(pugi::xml_node const & segmentNode, LinearSegment & segment)
 {
   CHECK(segmentNode, ());
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "std/iostream.hpp"
+#include "std/string.hpp"
 #include "std/vector.hpp"
 
 namespace pugi
@@ -15,4 +17,24 @@ struct LinearSegment;
 bool SegmentFromXML(pugi::xml_node const & segmentNode, LinearSegment & segment);
 
 bool ParseOpenlr(pugi::xml_document const & document, vector<LinearSegment> & segments);
+
+// Reads the segments of an OpenLR feed one by one, so the feed isn't kept in memory as a whole
+// and the segments of a live feed are available as they come. Every <reportSegments> element
+// is parsed as a separate document.
+class SegmentsStreamReader
+{
+public:
+  explicit SegmentsStreamReader(istream & stream) : m_stream(stream) {}
+
+  // Reads the next segment, the segments which can't be parsed are skipped.
+  // Returns false when the stream is over.
+  bool Read(LinearSegment & segment);
+
+private:
+  bool ReadSegmentXML(string & xml);
+
+  istream & m_stream;
+  // Data which is read from |m_stream| but isn't parsed yet.
+  string m_buffer;
+};
 }  // namespace openlr
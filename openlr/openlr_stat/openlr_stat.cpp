@@ -12,6 +12,7 @@
 #include "platform/platform.hpp"
 
 #include "openlr/decoded_path.hpp"
+#include "openlr/decoded_paths_cache.hpp"
 #include "openlr/openlr_model.hpp"
 #include "openlr/openlr_model_xml.hpp"
 
@@ -29,11 +30,12 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <iostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-DEFINE_string(input, "", "Path to OpenLR file.");
+DEFINE_string(input, "", "Path to OpenLR file, '-' for stdin in --stream mode.");
 DEFINE_string(spark_output, "", "Path to output file in spark-oriented format");
 DEFINE_string(assessment_output, "", "Path to output file in assessment-tool oriented format");
 
@@ -49,6 +51,12 @@ DEFINE_string(countries_filename, "",
               "Name of countries file which describes mwm tree. Used to get country specific "
               "routing restrictions.");
 DEFINE_int32(algo_version, 0, "Use new decoding algorithm");
+DEFINE_bool(stream, false,
+            "Decode segments by batches as they are read from --input ('-' for stdin) and write "
+            "the results of every batch at once.");
+DEFINE_int32(batch_size, 1000, "Number of segments which are decoded at once in --stream mode.");
+DEFINE_int32(paths_cache_size, 100000,
+             "Number of decoded location references which are kept in --stream mode.");
 
 using namespace openlr;
 
@@ -165,19 +173,150 @@ bool const g_numThreadsDummy =
 bool const g_mwmsPathDummy = google::RegisterFlagValidator(&FLAGS_mwms_path, &ValidateMwmPath);
 bool const g_algoVersion = google::RegisterFlagValidator(&FLAGS_algo_version, &ValidateVersion);
 
+bool ValidatePositive(char const * flagname, int32_t value)
+{
+  if (value <= 0)
+  {
+    printf("Invalid value for --%s: %d, must be positive\n", flagname, static_cast<int>(value));
+    return false;
+  }
+
+  return true;
+}
+
+bool const g_batchSizeDummy = google::RegisterFlagValidator(&FLAGS_batch_size, &ValidatePositive);
+bool const g_pathsCacheSizeDummy =
+    google::RegisterFlagValidator(&FLAGS_paths_cache_size, &ValidatePositive);
+
+void SaveNonMatchedIds(std::ostream & ost, std::vector<DecodedPath> const & paths)
+{
+  for (auto const & p : paths)
+  {
+    if (p.m_path.empty())
+      ost << p.m_segmentId << std::endl;
+  }
+}
+
 void SaveNonMatchedIds(std::string const & filename, std::vector<DecodedPath> const & paths)
 {
   if (filename.empty())
     return;
 
   std::ofstream ofs(filename);
-  for (auto const & p : paths)
+  SaveNonMatchedIds(ofs, paths);
+}
+
+void Decode(OpenLRDecoder & decoder, std::vector<LinearSegment> const & segments,
+            uint32_t const numThreads, std::vector<DecodedPath> & paths)
+{
+  switch (FLAGS_algo_version)
   {
-    if (p.m_path.empty())
-      ofs << p.m_segmentId << std::endl;
+  case 1: decoder.DecodeV1(segments, numThreads, paths); break;
+  case 2: decoder.DecodeV2(segments, numThreads, paths); break;
+  default: ASSERT(false, ("There should be no way to fall here"));
   }
 }
 
+// Decodes the segments of --input by batches of --batch_size. The paths of the location
+// references which were decoded recently are taken from the cache. The results are written
+// after every batch.
+void DecodeStream(OpenLRDecoder & decoder, uint32_t const numThreads)
+{
+  if (!FLAGS_assessment_output.empty())
+  {
+    LOG(LERROR, ("--assessment_output can't be used with --stream."));
+    exit(-1);
+  }
+
+  std::ifstream file;
+  if (FLAGS_input != "-")
+  {
+    file.open(FLAGS_input);
+    if (!file)
+    {
+      LOG(LERROR, ("Can't open file", FLAGS_input));
+      exit(-1);
+    }
+  }
+  else
+  {
+    // Otherwise std::cin isn't buffered and the available data can't be read at once.
+    std::ios::sync_with_stdio(false);
+  }
+  std::istream & input = FLAGS_input == "-" ? std::cin : file;
+
+  std::ofstream nonMatchedIds;
+  if (!FLAGS_non_matched_ids.empty())
+    nonMatchedIds.open(FLAGS_non_matched_ids);
+  std::ofstream sparkOutput;
+  if (!FLAGS_spark_output.empty())
+    sparkOutput.open(FLAGS_spark_output);
+
+  OpenLRDecoder::SegmentsFilter filter(FLAGS_ids_path, FLAGS_multipoints_only);
+  DecodedPathsCache cache(static_cast<size_t>(FLAGS_paths_cache_size));
+  size_t cacheHits = 0;
+
+  std::vector<LinearSegment> batch;
+  auto const decodeBatch = [&]() {
+    if (batch.empty())
+      return;
+
+    std::sort(batch.begin(), batch.end(), base::LessBy(&LinearSegment::m_segmentId));
+
+    std::vector<DecodedPath> paths(batch.size());
+    std::vector<LinearSegment> segments;
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      paths[i].m_segmentId.Set(batch[i].m_segmentId);
+      if (cache.Find(batch[i].m_locationReference, paths[i].m_path))
+      {
+        ++cacheHits;
+        continue;
+      }
+      segments.push_back(batch[i]);
+      indices.push_back(i);
+    }
+
+    if (!segments.empty())
+    {
+      std::vector<DecodedPath> decoded(segments.size());
+      Decode(decoder, segments, numThreads, decoded);
+      for (size_t i = 0; i < segments.size(); ++i)
+      {
+        paths[indices[i]].m_path = std::move(decoded[i].m_path);
+        cache.Add(segments[i].m_locationReference, paths[indices[i]].m_path);
+      }
+    }
+
+    SaveNonMatchedIds(nonMatchedIds, paths);
+    nonMatchedIds.flush();
+    if (sparkOutput.is_open())
+    {
+      WriteAsMappingForSpark(sparkOutput, paths);
+      sparkOutput.flush();
+    }
+
+    LOG(LINFO, ("Batch of", batch.size(), "segments is handled, decoded:", segments.size(),
+                ", paths cache hits:", cacheHits, ", size:", cache.GetSize()));
+    batch.clear();
+  };
+
+  SegmentsStreamReader reader(input);
+  LinearSegment segment;
+  for (int32_t count = 0;
+       (FLAGS_limit == kHandleAllSegments || count < FLAGS_limit) && reader.Read(segment); ++count)
+  {
+    if (!filter.Matches(segment))
+      continue;
+
+    batch.push_back(std::move(segment));
+    if (batch.size() >= static_cast<size_t>(FLAGS_batch_size))
+      decodeBatch();
+  }
+  decodeBatch();
+}
+
 std::vector<LinearSegment> LoadSegments(pugi::xml_document & document)
 {
   std::vector<LinearSegment> segments;
@@ -267,6 +406,12 @@ int main(int argc, char * argv[])
   OpenLRDecoder decoder(dataSources, storage::CountryParentGetter(FLAGS_countries_filename,
                                                               GetPlatform().ResourcesDir()));
 
+  if (FLAGS_stream)
+  {
+    DecodeStream(decoder, numThreads);
+    return 0;
+  }
+
   pugi::xml_document document;
   auto const load_result = document.load_file(FLAGS_input.data());
   if (!load_result)
@@ -278,12 +423,7 @@ int main(int argc, char * argv[])
   auto const segments = LoadSegments(document);
 
   std::vector<DecodedPath> paths(segments.size());
-  switch (FLAGS_algo_version)
-  {
-  case 1: decoder.DecodeV1(segments, numThreads, paths); break;
-  case 2: decoder.DecodeV2(segments, numThreads, paths); break;
-  default: ASSERT(false, ("There should be no way to fall here"));
-  }
+  Decode(decoder, segments, numThreads, paths);
 
   SaveNonMatchedIds(FLAGS_non_matched_ids, paths);
   if (!FLAGS_assessment_output.empty())
@@ -0,0 +1,39 @@
+#include "testing/testing.hpp"
+
+#include "openlr/candidates_cache.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <vector>
+
+using namespace openlr;
+using namespace std;
+
+UNIT_TEST(CandidatePointsCache_Smoke)
+{
+  CandidatePointsCache cache;
+  vector<m2::PointD> candidates;
+  TEST(!cache.Find(m2::PointD(37.5, 67.5), candidates), ());
+
+  cache.Add(m2::PointD(37.5, 67.5), {m2::PointD(37.5001, 67.5), m2::PointD(37.5, 67.5002)});
+  TEST_EQUAL(cache.GetSize(), 1, ());
+
+  // A point which is closer than the quantization step has the same candidates.
+  TEST(cache.Find(m2::PointD(37.500001, 67.500001), candidates), ());
+  TEST_EQUAL(candidates,
+             vector<m2::PointD>({m2::PointD(37.5001, 67.5), m2::PointD(37.5, 67.5002)}), ());
+
+  candidates.clear();
+  TEST(!cache.Find(m2::PointD(37.5001, 67.5), candidates), ());
+  TEST(candidates.empty(), ());
+}
+
+UNIT_TEST(GetQuantizedPointKey_Signs)
+{
+  TEST_NOT_EQUAL(GetQuantizedPointKey(m2::PointD(1.0, 2.0)),
+                 GetQuantizedPointKey(m2::PointD(-1.0, 2.0)), ());
+  TEST_NOT_EQUAL(GetQuantizedPointKey(m2::PointD(1.0, 2.0)),
+                 GetQuantizedPointKey(m2::PointD(1.0, -2.0)), ());
+  TEST_NOT_EQUAL(GetQuantizedPointKey(m2::PointD(1.0, 2.0)),
+                 GetQuantizedPointKey(m2::PointD(2.0, 1.0)), ());
+}
@@ -0,0 +1,94 @@
+#include "testing/testing.hpp"
+
+#include "openlr/decoded_paths_cache.hpp"
+#include "openlr/openlr_model.hpp"
+#include "openlr/openlr_model_xml.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace openlr;
+using namespace std;
+
+namespace
+{
+string MakeSegmentXML(uint32_t id, int32_t firstLat)
+{
+  ostringstream os;
+  os << "<reportSegments>"
+     << "<ReportSegmentID>" << id << "</ReportSegmentID>"
+     << "<segmentLength>100</segmentLength>"
+     << "<olr:locationReference><olr:optionLinearLocationReference>"
+     << "<olr:first>"
+     << "<olr:coordinate><olr:latitude>" << firstLat << "</olr:latitude>"
+     << "<olr:longitude>1747000</olr:longitude></olr:coordinate>"
+     << "<olr:lineProperties><olr:frc olr:code=\"2\"/><olr:fow olr:code=\"3\"/>"
+     << "<olr:bearing><olr:value>10</olr:value></olr:bearing></olr:lineProperties>"
+     << "<olr:pathProperties><olr:lfrcnp olr:code=\"2\"/><olr:dnp><olr:value>100</olr:value>"
+     << "</olr:dnp><olr:againstDrivingDirection>false</olr:againstDrivingDirection>"
+     << "</olr:pathProperties>"
+     << "</olr:first>"
+     << "<olr:last>"
+     << "<olr:coordinate><olr:latitude>50</olr:latitude>"
+     << "<olr:longitude>60</olr:longitude></olr:coordinate>"
+     << "<olr:lineProperties><olr:frc olr:code=\"2\"/><olr:fow olr:code=\"3\"/>"
+     << "<olr:bearing><olr:value>20</olr:value></olr:bearing></olr:lineProperties>"
+     << "</olr:last>"
+     << "</olr:optionLinearLocationReference></olr:locationReference>"
+     << "</reportSegments>\n";
+  return os.str();
+}
+}  // namespace
+
+UNIT_TEST(SegmentsStreamReader_Smoke)
+{
+  stringstream stream;
+  stream << "<Dictionary xmlns:olr=\"http://www.openlr.org/openlr\"><reportSegmentsList>\n"
+         << MakeSegmentXML(1, 2582000) << "<reportSegments><ReportSegmentID>2</ReportSegmentID>"
+         << "<coordinates/></reportSegments>\n"
+         << MakeSegmentXML(3, 2583000) << "</reportSegmentsList></Dictionary>\n";
+
+  SegmentsStreamReader reader(stream);
+  vector<LinearSegment> segments;
+  LinearSegment segment;
+  while (reader.Read(segment))
+    segments.push_back(segment);
+
+  TEST_EQUAL(segments.size(), 2, ());
+  TEST_EQUAL(segments[0].m_segmentId, 1, ());
+  TEST_EQUAL(segments[1].m_segmentId, 3, ());
+  TEST_EQUAL(segments[1].GetLRPs().size(), 2, ());
+  TEST_EQUAL(segments[1].GetLRPs()[0].m_bearing, 10, ());
+  TEST_EQUAL(segments[1].GetLRPs()[0].m_distanceToNextPoint, 100, ());
+  TEST_EQUAL(segments[1].GetLRPs()[1].m_bearing, 20, ());
+}
+
+UNIT_TEST(DecodedPathsCache_Lru)
+{
+  LinearLocationReference refs[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    refs[i].m_points.resize(2);
+    refs[i].m_points[0].m_latLon = ms::LatLon(55.0 + i, 37.0);
+    refs[i].m_points[1].m_latLon = ms::LatLon(55.5, 37.5);
+  }
+
+  DecodedPathsCache cache(2 /* capacity */);
+  Path path;
+  TEST(!cache.Find(refs[0], path), ());
+
+  cache.Add(refs[0], Path());
+  cache.Add(refs[1], Path());
+  // |refs[0]| becomes the most recently used one, so |refs[1]| is removed.
+  TEST(cache.Find(refs[0], path), ());
+  cache.Add(refs[2], Path());
+
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(cache.Find(refs[0], path), ());
+  TEST(!cache.Find(refs[1], path), ());
+  TEST(cache.Find(refs[2], path), ());
+
+  refs[2].m_positiveOffsetMeters = 10;
+  TEST(!cache.Find(refs[2], path), ());
+}
@@ -21,6 +21,10 @@ struct alignas(kCacheLineSize) Stats
     m_noShortestPathFound += s.m_noShortestPathFound;
     m_wrongOffsets += s.m_wrongOffsets;
     m_dnpIsZero += s.m_dnpIsZero;
+    m_candidatePointsCacheHits += s.m_candidatePointsCacheHits;
+    m_candidatePointsCacheMisses += s.m_candidatePointsCacheMisses;
+    m_candidatePathsCacheHits += s.m_candidatePathsCacheHits;
+    m_candidatePathsCacheMisses += s.m_candidatePathsCacheMisses;
   }
 
   void Report() const
@@ -31,6 +35,10 @@ struct alignas(kCacheLineSize) Stats
     LOG(LINFO, ("Wrong distance to next point:", m_dnpIsZero));
     LOG(LINFO, ("Wrong offsets:", m_wrongOffsets));
     LOG(LINFO, ("No shortest path:", m_noShortestPathFound));
+    LOG(LINFO, ("Candidate points cache hits:", m_candidatePointsCacheHits,
+                "misses:", m_candidatePointsCacheMisses));
+    LOG(LINFO, ("Candidate paths cache hits:", m_candidatePathsCacheHits,
+                "misses:", m_candidatePathsCacheMisses));
   }
 
   uint32_t m_routesHandled = 0;
@@ -40,6 +48,10 @@ struct alignas(kCacheLineSize) Stats
   uint32_t m_wrongOffsets = 0;
   // Number of zeroed distance-to-next point values in the input.
   uint32_t m_dnpIsZero = 0;
+  uint32_t m_candidatePointsCacheHits = 0;
+  uint32_t m_candidatePointsCacheMisses = 0;
+  uint32_t m_candidatePathsCacheHits = 0;
+  uint32_t m_candidatePathsCacheMisses = 0;
 };
 }  // namespace V2
 }  // namespace openlr
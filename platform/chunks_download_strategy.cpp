@@ -12,11 +12,17 @@
 namespace downloader
 {
 
-ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls)
+ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls,
+                                               size_t connectionsPerServer)
 {
-  // init servers list
-  for (size_t i = 0; i < urls.size(); ++i)
-    m_servers.push_back(ServerT(urls[i], SERVER_READY));
+  ASSERT_GREATER(connectionsPerServer, 0, ());
+
+  // init servers list, every connection to the server is a separate entry
+  for (size_t connection = 0; connection < connectionsPerServer; ++connection)
+  {
+    for (size_t i = 0; i < urls.size(); ++i)
+      m_servers.push_back(ServerT(urls[i], SERVER_READY));
+  }
 }
 
 pair<ChunksDownloadStrategy::ChunkT *, int>
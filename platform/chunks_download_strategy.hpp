@@ -58,7 +58,10 @@ private:
   pair<ChunkT *, int> GetChunk(RangeT const & range);
 
 public:
-  ChunksDownloadStrategy(vector<string> const & urls);
+  /// @param[in] urls  Servers in the order of preference.
+  /// @param[in] connectionsPerServer  Max number of chunks which are downloaded from
+  /// one server simultaneously. First connections of all servers are used first.
+  ChunksDownloadStrategy(vector<string> const & urls, size_t connectionsPerServer = 1);
 
   /// Init chunks vector for fileSize.
   void InitChunks(int64_t fileSize, int64_t chunkSize, ChunkStatusT status = CHUNK_FREE);
@@ -45,30 +45,41 @@ extern NSString * gBrowserUserAgent;
 
 @implementation Connection
 
-+ (NSData *)sendSynchronousRequest:(NSURLRequest *)request
-                 returningResponse:(NSURLResponse * __autoreleasing *)response
-                             error:(NSError * __autoreleasing *)error
+// All the requests share one session, so the connections to a host are kept alive and reused
+// by the next requests (and HTTP/2 streams are multiplexed over one connection) instead of
+// a new connection and a TLS handshake for every request.
++ (NSURLSession *)session
 {
-  Connection * connection = [[Connection alloc] init];
-  return [connection sendSynchronousRequest:request returningResponse:response error:error];
+  static NSURLSession * session = nil;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSURLSessionConfiguration * config = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    // We handle cookies manually and don't cache responses.
+    config.HTTPCookieStorage = nil;
+    config.HTTPShouldSetCookies = NO;
+    config.URLCache = nil;
+    config.HTTPMaximumConnectionsPerHost = 4;
+    session = [NSURLSession sessionWithConfiguration:config
+                                            delegate:[[Connection alloc] init]
+                                       delegateQueue:nil];
+  });
+  return session;
 }
 
-- (NSData *)sendSynchronousRequest:(NSURLRequest *)request
++ (NSData *)sendSynchronousRequest:(NSURLRequest *)request
                  returningResponse:(NSURLResponse * __autoreleasing *)response
                              error:(NSError * __autoreleasing *)error
 {
-  NSURLSession * session = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration ephemeralSessionConfiguration]
-                                                        delegate:self
-                                                   delegateQueue:nil];
   __block NSData * resultData = nil;
   __block NSURLResponse * resultResponse = nil;
   __block NSError * resultError = nil;
 
   dispatch_group_t group = dispatch_group_create();
   dispatch_group_enter(group);
-  [[session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data,
-                                                            NSURLResponse * _Nullable response,
-                                                            NSError * _Nullable error)
+  [[[Connection session] dataTaskWithRequest:request
+                           completionHandler:^(NSData * _Nullable data,
+                                               NSURLResponse * _Nullable response,
+                                               NSError * _Nullable error)
   {
     resultData = data;
     resultResponse = response;
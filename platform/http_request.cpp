@@ -301,9 +301,9 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
 public:
   FileHttpRequest(vector<string> const & urls, string const & filePath, int64_t fileSize,
                   Callback const & onFinish, Callback const & onProgress,
-                  int64_t chunkSize, bool doCleanProgressFiles)
-    : HttpRequest(onFinish, onProgress), m_strategy(urls), m_filePath(filePath),
-      m_goodChunksCount(0), m_doCleanProgressFiles(doCleanProgressFiles)
+                  int64_t chunkSize, bool doCleanProgressFiles, size_t connectionsPerServer)
+    : HttpRequest(onFinish, onProgress), m_strategy(urls, connectionsPerServer),
+      m_filePath(filePath), m_goodChunksCount(0), m_doCleanProgressFiles(doCleanProgressFiles)
   {
     ASSERT ( !urls.empty(), () );
 
@@ -390,11 +390,13 @@ HttpRequest * HttpRequest::PostJson(string const & url, string const & postData,
 HttpRequest * HttpRequest::GetFile(vector<string> const & urls,
                                    string const & filePath, int64_t fileSize,
                                    Callback const & onFinish, Callback const & onProgress,
-                                   int64_t chunkSize, bool doCleanOnCancel)
+                                   int64_t chunkSize, bool doCleanOnCancel,
+                                   size_t connectionsPerServer)
 {
   try
   {
-    return new FileHttpRequest(urls, filePath, fileSize, onFinish, onProgress, chunkSize, doCleanOnCancel);
+    return new FileHttpRequest(urls, filePath, fileSize, onFinish, onProgress, chunkSize,
+                               doCleanOnCancel, connectionsPerServer);
   }
   catch (FileWriter::Exception const & e)
   {
@@ -67,7 +67,8 @@ public:
                                Callback const & onFinish,
                                Callback const & onProgress = Callback(),
                                int64_t chunkSize = 512 * 1024,
-                               bool doCleanOnCancel = true);
+                               bool doCleanOnCancel = true,
+                               size_t connectionsPerServer = 1);
 };
 
 string DebugPrint(HttpRequest::Status status);
@@ -11,6 +11,7 @@
 #include <QNetworkRequest>
 #include <QSslError>
 #include <QUrl>
+#include <QtGlobal>
 
 HttpThread::HttpThread(string const & url,
                        downloader::IHttpThreadCallback & cb,
@@ -48,7 +49,12 @@ HttpThread::HttpThread(string const & url,
     request.setRawHeader("User-Agent", uid.c_str());
   }
 
-  /// Use single instance for whole app
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+  // The chunks are requested by HTTP/2 streams of one connection when the server supports it.
+  request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+
+  /// Use single instance for whole app, it keeps the connections alive for the next requests.
   static QNetworkAccessManager netManager;
 
   if (pb.empty())
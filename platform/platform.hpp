@@ -231,6 +231,10 @@ public:
   /// @return false if file is not exist
   /// @note Try do not use in client production code
   static bool GetFileSizeByFullPath(std::string const & filePath, uint64_t & size);
+  /// @return false if file is not exist
+  /// @note |modificationTime| is in seconds since epoch.
+  static bool GetFileSizeAndModificationTime(std::string const & filePath, uint64_t & size,
+                                             uint64_t & modificationTime);
   //@}
 
   /// Used to check available free storage space for downloading.
@@ -299,6 +299,62 @@ UNIT_TEST(ChunksDownloadStrategy)
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::EDownloadSucceeded, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategy_ConnectionsPerServer)
+{
+  string const S1 = "UrlOfServer1";
+  string const S2 = "UrlOfServer2";
+
+  typedef pair<int64_t, int64_t> RangeT;
+
+  vector<string> servers;
+  servers.push_back(S1);
+  servers.push_back(S2);
+
+  int64_t const FILE_SIZE = 1000;
+  int64_t const CHUNK_SIZE = 200;
+  ChunksDownloadStrategy strategy(servers, 2 /* connectionsPerServer */);
+  strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+
+  // First connections of all servers are used before the second ones.
+  string s1, s2, s3, s4;
+  RangeT r1, r2, r3, r4;
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s3, r3), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s4, r4), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(s2, S2, ());
+  TEST_EQUAL(s3, S1, ());
+  TEST_EQUAL(s4, S2, ());
+
+  string sEmpty;
+  RangeT rEmpty;
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  // Failed connection doesn't affect other connections to the same server.
+  strategy.ChunkFinished(false, r3);
+  strategy.ChunkFinished(true, r1);
+
+  string s5;
+  RangeT r5;
+  TEST_EQUAL(strategy.NextChunk(s5, r5), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s5, S1, ());
+  TEST_EQUAL(r5, r3, ());
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  strategy.ChunkFinished(true, r2);
+  strategy.ChunkFinished(true, r4);
+  strategy.ChunkFinished(true, r5);
+
+  string s6;
+  RangeT r6;
+  TEST_EQUAL(strategy.NextChunk(s6, r6), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  strategy.ChunkFinished(true, r6);
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::EDownloadSucceeded, ());
+}
+
 UNIT_TEST(ChunksDownloadStrategyFAIL)
 {
   string const S1 = "UrlOfServer1";
@@ -194,6 +194,19 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   else return false;
 }
 
+// static
+bool Platform::GetFileSizeAndModificationTime(string const & filePath, uint64_t & size,
+                                              uint64_t & modificationTime)
+{
+  struct stat s;
+  if (stat(filePath.c_str(), &s) != 0)
+    return false;
+
+  size = static_cast<uint64_t>(s.st_size);
+  modificationTime = static_cast<uint64_t>(s.st_mtime);
+  return true;
+}
+
 Platform::TStorageStatus Platform::GetWritableStorageStatus(uint64_t neededSize) const
 {
   struct statfs st;
@@ -210,3 +210,16 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   }
   return false;
 }
+
+// static
+bool Platform::GetFileSizeAndModificationTime(string const & filePath, uint64_t & size,
+                                              uint64_t & modificationTime)
+{
+  struct _stat64 stats;
+  if (_stat64(filePath.c_str(), &stats) != 0)
+    return false;
+
+  size = static_cast<uint64_t>(stats.st_size);
+  modificationTime = static_cast<uint64_t>(stats.st_mtime);
+  return true;
+}
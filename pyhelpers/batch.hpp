@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Python.h"
+
+namespace
+{
+// Releases the GIL while the object is alive, so the other Python threads run while
+// the native code works. Python objects must not be touched meanwhile.
+class gil_release
+{
+public:
+  gil_release() : m_state(PyEval_SaveThread()) {}
+  ~gil_release() { PyEval_RestoreThread(m_state); }
+
+  gil_release(gil_release const &) = delete;
+  gil_release & operator=(gil_release const &) = delete;
+
+private:
+  PyThreadState * m_state;
+};
+
+// Calls |fn(i)| for every i in [0, |count|) on all the cores. The first exception thrown
+// by |fn| is rethrown when all the threads are finished.
+template <typename Fn>
+void parallel_for(size_t count, Fn && fn)
+{
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto const work = [&]() {
+    for (size_t i = next++; i < count; i = next++)
+    {
+      try
+      {
+        fn(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  };
+
+  size_t const threadsCount =
+      std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)), count);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(work);
+  work();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+}  // namespace
@@ -0,0 +1,192 @@
+#include "software_renderer/render_service.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/map_style_reader.hpp"
+
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+DEFINE_string(outpath, "./", "Path for output files");
+DEFINE_string(datapath, "", "Path to data directory");
+DEFINE_string(mwmpath, "", "Path to mwm files");
+DEFINE_int32(threads, 0, "Number of rendering threads, hardware concurrency by default");
+DEFINE_int32(tile_size, 256, "Size of tiles in pixels");
+DEFINE_double(visual_scale, 1.0, "Visual scale (dpi factor) of images");
+DEFINE_int32(log_cache_size, 10, "Log2 of the number of cached tiles");
+
+using namespace std;
+
+namespace
+{
+// Counts requests which are being rendered to wait for them before exit.
+class PendingRequests
+{
+public:
+  void Add()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    ++m_count;
+  }
+
+  void Done()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      --m_count;
+    }
+    m_condition.notify_all();
+  }
+
+  void Wait()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_count == 0; });
+  }
+
+private:
+  mutex m_mutex;
+  condition_variable m_condition;
+  size_t m_count = 0;
+};
+
+void SaveImage(software_renderer::RenderService::ImagePtr const & image, string const & request,
+               string const & filename)
+{
+  static mutex s_outputMutex;
+  lock_guard<mutex> lock(s_outputMutex);
+
+  if (image == nullptr)
+  {
+    cerr << "Rendering " << request << " is failed." << endl;
+    return;
+  }
+
+  ofstream file(filename, ios::binary);
+  file.write(reinterpret_cast<char const *>(image->m_data.data()), image->m_data.size());
+  cout << "Rendering " << request << " into " << filename << " is finished." << endl;
+}
+
+// Requests are "tile zoom x y" and "rect minLat minLon maxLat maxLon width height".
+bool ProcessRequest(software_renderer::RenderService & service, PendingRequests & pending,
+                    string const & request)
+{
+  istringstream ss(request);
+  string type;
+  ss >> type;
+  if (type == "tile")
+  {
+    uint32_t zoom, x, y;
+    if (!(ss >> zoom >> x >> y) || zoom > 28 || x >= (1u << zoom) || y >= (1u << zoom))
+      return false;
+
+    ostringstream filename;
+    filename << FLAGS_outpath << zoom << "_" << x << "_" << y << ".png";
+    pending.Add();
+    service.RenderTile(x, y, static_cast<uint8_t>(zoom),
+                       [&pending, request, path = filename.str()](
+                           software_renderer::RenderService::ImagePtr const & image) {
+                         SaveImage(image, request, path);
+                         pending.Done();
+                       });
+    return true;
+  }
+
+  if (type == "rect")
+  {
+    static size_t s_counter = 0;
+    double minLat, minLon, maxLat, maxLon;
+    uint32_t width, height;
+    if (!(ss >> minLat >> minLon >> maxLat >> maxLon >> width >> height) || width == 0 ||
+        height == 0)
+    {
+      return false;
+    }
+
+    ostringstream filename;
+    filename << FLAGS_outpath << "rect" << s_counter++ << ".png";
+    pending.Add();
+    m2::RectD const rect(MercatorBounds::FromLatLon(minLat, minLon),
+                         MercatorBounds::FromLatLon(maxLat, maxLon));
+    service.RenderRect(rect, width, height,
+                       [&pending, request, path = filename.str()](
+                           software_renderer::RenderService::ImagePtr const & image) {
+                         SaveImage(image, request, path);
+                         pending.Done();
+                       });
+    return true;
+  }
+
+  return false;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  google::SetUsageMessage(
+      "Renders map tiles and rects which are read from stdin, one request per line:\n"
+      "  tile <zoom> <x> <y>\n"
+      "  rect <minLat> <minLon> <maxLat> <maxLon> <width> <height>");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_datapath.empty())
+    platform.SetResourceDir(FLAGS_datapath);
+
+  if (!FLAGS_mwmpath.empty())
+    platform.SetWritableDirForTests(FLAGS_mwmpath);
+
+  GetStyleReader().SetCurrentStyle(kDefaultMapStyle);
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  vector<platform::LocalCountryFile> mwms;
+  platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
+                                       mwms);
+  for (auto & mwm : mwms)
+  {
+    mwm.SyncWithDisk();
+    auto const result = dataSource.RegisterMap(mwm);
+    if (result.second != MwmSet::RegResult::Success)
+      LOG(LWARNING, ("Can't register map", mwm));
+  }
+
+  software_renderer::RenderService::Params params;
+  params.m_visualScale = FLAGS_visual_scale;
+  params.m_threadsCount = static_cast<size_t>(max(FLAGS_threads, 0));
+  params.m_tileSize = static_cast<uint32_t>(FLAGS_tile_size);
+  params.m_logCacheSize = static_cast<uint32_t>(FLAGS_log_cache_size);
+
+  PendingRequests pending;
+  {
+    software_renderer::RenderService service(dataSource, params);
+    for (string line; getline(cin, line);)
+    {
+      strings::Trim(line);
+      if (line.empty())
+        continue;
+
+      if (!ProcessRequest(service, pending, line))
+        cerr << "Wrong request [" << line << "]" << endl;
+    }
+    pending.Wait();
+  }
+  return 0;
+}
@@ -1,16 +1,21 @@
 #pragma once
 
+#include "routing/base/astar_vertex_storage.hpp"
 #include "routing/base/astar_weight.hpp"
 #include "routing/base/routing_result.hpp"
 
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
+#include "base/scope_guard.hpp"
 
 #include <algorithm>
+#include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 namespace routing
@@ -23,6 +28,11 @@ public:
   using Edge = typename Graph::Edge;
   using Weight = typename Graph::Weight;
 
+  // Storage of per-vertex values. It's a hash table if Graph declares VertexHasher
+  // and std::map otherwise. See astar_vertex_storage.hpp for details.
+  template <typename Value>
+  using VertexStorage = typename AStarVertexStorageSelector<Graph>::template Storage<Value>;
+
   enum class Result
   {
     OK,
@@ -52,6 +62,12 @@ public:
   // before adding the edge to AStar queue.
   // Can be used to clip some path which does not meet restrictions.
   using CheckLengthCallback = std::function<bool(Weight const &)>;
+  // Callback used to recalculate weight of |edge| outgoing from a vertex which is reached
+  // with |distance| from the start. Can be used for time-dependent weights.
+  using AdjustEdgeWeightCallback =
+      std::function<Weight(Edge const & edge, Weight const & distance)>;
+
+  class DestinationTree;
 
   struct Params
   {
@@ -81,6 +97,17 @@ public:
     base::Cancellable const & m_cancellable;
     OnVisitedVertexCallback const m_onVisitedVertexCallback;
     CheckLengthCallback const m_checkLengthCallback;
+    // Used for FindPathBidirectional. If true forward and backward waves are propagated
+    // in two threads simultaneously. In this case |m_graph| and the callbacks are called from
+    // both threads, so they must be thread safe.
+    bool m_parallelWaves = false;
+    // Used for FindPath. May be empty. Recalculated weights must not be less than weights
+    // of edges given by |m_graph| to keep the heuristic consistent. FindPathBidirectional
+    // doesn't support it because distances from the start are unknown for the backward wave.
+    AdjustEdgeWeightCallback m_adjustEdgeWeightCallback;
+    // Used for FindPathBidirectional. If not nullptr and a path is found, it's filled with
+    // the backward wave and the path to be used by AdjustRoute later.
+    DestinationTree * m_destinationTree = nullptr;
   };
 
   struct ParamsForTests
@@ -108,28 +135,89 @@ public:
     base::Cancellable const m_cancellable;
     OnVisitedVertexCallback const m_onVisitedVertexCallback;
     CheckLengthCallback const m_checkLengthCallback;
+    // See Params::m_parallelWaves.
+    bool m_parallelWaves = false;
+    // See Params::m_adjustEdgeWeightCallback.
+    AdjustEdgeWeightCallback m_adjustEdgeWeightCallback;
+    // See Params::m_destinationTree.
+    DestinationTree * m_destinationTree = nullptr;
   };
-  class Context final
+
+  // Limits of alternative paths of FindPathBidirectionalWithAlternatives().
+  struct AlternativesParams
+  {
+    size_t m_maxAlternatives = 2;
+    // An alternative is not longer than the shortest path by |m_maxStretch| times.
+    double m_maxStretch = 1.25;
+    // Not more than |m_maxSharing| part of an alternative's length is shared with the shortest
+    // path and the alternatives chosen before.
+    double m_maxSharing = 0.8;
+    // At least |m_minPlateauShare| part of an alternative's length is its plateau, i.e. a path
+    // which is the shortest one both from the start and to the final vertex. It keeps
+    // alternatives from being the shortest path with short detours.
+    double m_minPlateauShare = 0.2;
+  };
+
+private:
+  // State is what is going to be put in the priority queue. See the
+  // comment for FindPath for more information.
+  struct State
+  {
+    State(Vertex const & vertex, Weight const & distance) : vertex(vertex), distance(distance) {}
+
+    inline bool operator>(State const & rhs) const { return distance > rhs.distance; }
+
+    Vertex vertex;
+    Weight distance;
+  };
+
+  // Priority queue which keeps its memory after Clear().
+  class Queue final : public std::priority_queue<State, std::vector<State>, std::greater<State>>
   {
   public:
+    void Clear() { this->c.clear(); }
+  };
+
+  // Queue and per-vertex values of one wave of bidirectional algorithm.
+  struct Wave
+  {
     void Clear()
     {
-      m_distanceMap.clear();
-      m_parents.clear();
+      m_queue.Clear();
+      m_bestDistance.Clear();
+      m_parent.Clear();
+      m_labeled.clear();
     }
 
-    bool HasDistance(Vertex const & vertex) const
+    Queue m_queue;
+    VertexStorage<Weight> m_bestDistance;
+    VertexStorage<Vertex> m_parent;
+    // Used by parallel bidirectional algorithm only: vertices whose distances were changed
+    // during the current round and adjacency list buffer of the wave's thread.
+    std::vector<Vertex> m_labeled;
+    std::vector<Edge> m_adj;
+  };
+
+public:
+  class Context final
+  {
+  public:
+    void Clear()
     {
-      return m_distanceMap.find(vertex) != m_distanceMap.cend();
+      m_distanceMap.Clear();
+      m_parents.Clear();
+      m_queue.Clear();
     }
 
+    bool HasDistance(Vertex const & vertex) const { return m_distanceMap.Find(vertex) != nullptr; }
+
     Weight GetDistance(Vertex const & vertex) const
     {
-      auto const & it = m_distanceMap.find(vertex);
-      if (it == m_distanceMap.cend())
+      auto const * distance = m_distanceMap.Find(vertex);
+      if (distance == nullptr)
         return kInfiniteDistance;
 
-      return it->second;
+      return *distance;
     }
 
     void SetDistance(Vertex const & vertex, Weight const & distance)
@@ -142,8 +230,59 @@ public:
     void ReconstructPath(Vertex const & v, std::vector<Vertex> & path) const;
 
   private:
-    std::map<Vertex, Weight> m_distanceMap;
-    std::map<Vertex, Vertex> m_parents;
+    friend class AStarAlgorithm;
+
+    VertexStorage<Weight> m_distanceMap;
+    VertexStorage<Vertex> m_parents;
+    Queue m_queue;
+    std::vector<Edge> m_adj;
+  };
+
+  // Memory used by the searches. Keep a workspace between searches to reuse the memory
+  // allocated by the previous ones: a cleared workspace keeps capacities of its queues
+  // and storages. A workspace must not be used by several searches simultaneously.
+  class Workspace final
+  {
+  private:
+    friend class AStarAlgorithm;
+
+    Context m_context;
+    Wave m_forward;
+    Wave m_backward;
+    std::vector<Edge> m_adj;
+  };
+
+  // Shortest paths to the final vertex of a path found by FindPathBidirectional from
+  // the vertices reached by its backward wave and from the vertices of the path.
+  // Every vertex of the tree has its distance to the final vertex and the next vertex
+  // of the path to it. The tree lets AdjustRoute find a path to the same final vertex from
+  // another start without propagating a wave to the final vertex again.
+  class DestinationTree final
+  {
+  public:
+    void Clear()
+    {
+      m_distances.Clear();
+      m_next.Clear();
+    }
+
+    bool IsEmpty() const { return m_distances.GetSize() == 0; }
+    size_t GetSize() const { return m_distances.GetSize(); }
+    Vertex const & GetFinalVertex() const { return m_finalVertex; }
+
+    // Returns nullptr if |vertex| is not in the tree.
+    Weight const * FindDistance(Vertex const & vertex) const { return m_distances.Find(vertex); }
+
+    // Appends the vertices of the path from |vertex| to the final vertex to |path|
+    // except |vertex| itself.
+    void AppendPath(Vertex const & vertex, std::vector<Vertex> & path) const;
+
+  private:
+    friend class AStarAlgorithm;
+
+    Vertex m_finalVertex = Vertex();
+    VertexStorage<Weight> m_distances;
+    VertexStorage<Vertex> m_next;
   };
 
   // VisitVertex returns true: wave will continue
@@ -157,17 +296,49 @@ public:
   void PropagateWave(Graph & graph, Vertex const & startVertex, VisitVertex && visitVertex,
                      Context & context) const;
 
+  // Methods below use |workspace| for all the memory they need.
+  // Overloads without |workspace| use a temporary one.
   template <typename P>
   Result FindPath(P & params, RoutingResult<Vertex, Weight> & result) const;
+  template <typename P>
+  Result FindPath(P & params, RoutingResult<Vertex, Weight> & result,
+                  Workspace & workspace) const;
 
   template <typename P>
   Result FindPathBidirectional(P & params, RoutingResult<Vertex, Weight> & result) const;
+  template <typename P>
+  Result FindPathBidirectional(P & params, RoutingResult<Vertex, Weight> & result,
+                               Workspace & workspace) const;
 
   // Adjust route to the previous one.
   // Expects |params.m_checkLengthCallback| to check wave propagation limit.
   template <typename P>
   typename AStarAlgorithm<Graph>::Result AdjustRoute(P & params,
                                                      RoutingResult<Vertex, Weight> & result) const;
+  template <typename P>
+  typename AStarAlgorithm<Graph>::Result AdjustRoute(P & params,
+                                                     RoutingResult<Vertex, Weight> & result,
+                                                     Workspace & workspace) const;
+  // Finds a path from |params.m_startVertex| to the final vertex of |tree|. The wave from the start
+  // is propagated until it can't find a shorter path through a vertex of |tree|.
+  // |params.m_prevRoute| is not used.
+  // Expects |params.m_checkLengthCallback| to check wave propagation limit.
+  template <typename P>
+  typename AStarAlgorithm<Graph>::Result AdjustRoute(P & params, DestinationTree const & tree,
+                                                     RoutingResult<Vertex, Weight> & result,
+                                                     Workspace & workspace) const;
+
+  // Finds the shortest path from |params.m_startVertex| to |params.m_finalVertex| and up to
+  // |alternatives.m_maxAlternatives| alternative paths with one bidirectional search.
+  // The waves are not stopped when they meet but settle all the vertices of paths which meet
+  // |alternatives.m_maxStretch|. Then plateaus, chains of vertices which are in both shortest
+  // path trees, are found. Every plateau gives a path through it and the longest plateaus give
+  // alternatives. |results| is filled with the shortest path followed by the alternatives.
+  // |params.m_parallelWaves| is ignored.
+  template <typename P>
+  Result FindPathBidirectionalWithAlternatives(
+      P & params, AlternativesParams const & alternatives,
+      std::vector<RoutingResult<Vertex, Weight>> & results, Workspace & workspace) const;
 
 private:
   // Periodicity of switching a wave of bidirectional algorithm.
@@ -195,32 +366,24 @@ private:
     uint32_t count = 0;
   };
 
-  // State is what is going to be put in the priority queue. See the
-  // comment for FindPath for more information.
-  struct State
-  {
-    State(Vertex const & vertex, Weight const & distance) : vertex(vertex), distance(distance) {}
-
-    inline bool operator>(State const & rhs) const { return distance > rhs.distance; }
-
-    Vertex vertex;
-    Weight distance;
-  };
-
   // BidirectionalStepContext keeps all the information that is needed to
   // search starting from one of the two directions. Its main
   // purpose is to make the code that changes directions more readable.
   struct BidirectionalStepContext
   {
     BidirectionalStepContext(bool forward, Vertex const & startVertex, Vertex const & finalVertex,
-                             Graph & graph)
+                             Graph & graph, Wave & wave)
       : forward(forward)
       , startVertex(startVertex)
       , finalVertex(finalVertex)
       , graph(graph)
-      , m_piRT(graph.HeuristicCostEstimate(finalVertex, startVertex))
+      , m_piRT(graph.HeuristicCostEstimate(startVertex, finalVertex))
       , m_piFS(graph.HeuristicCostEstimate(startVertex, finalVertex))
+      , queue(wave.m_queue)
+      , bestDistance(wave.m_bestDistance)
+      , parent(wave.m_parent)
     {
+      wave.Clear();
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
     }
@@ -228,7 +391,9 @@ private:
     Weight TopDistance() const
     {
       ASSERT(!queue.empty(), ());
-      return bestDistance.at(queue.top().vertex);
+      auto const * distance = bestDistance.Find(queue.top().vertex);
+      CHECK(distance, ());
+      return *distance;
     }
 
     // p_f(v) = 0.5*(π_f(v) - π_r(v)) + 0.5*π_r(t)
@@ -237,7 +402,8 @@ private:
     Weight ConsistentHeuristic(Vertex const & v) const
     {
       auto const piF = graph.HeuristicCostEstimate(v, finalVertex);
-      auto const piR = graph.HeuristicCostEstimate(v, startVertex);
+      // π_r(v) estimates the route from |startVertex| to |v|. Heuristics may be asymmetric.
+      auto const piR = graph.HeuristicCostEstimate(startVertex, v);
       if (forward)
       {
         /// @todo careful: with this "return" here and below in the Backward case
@@ -247,7 +413,7 @@ private:
       }
       else
       {
-        // return HeuristicCostEstimate(v, startVertex);
+        // return HeuristicCostEstimate(startVertex, v);
         return 0.5 * (piR - piF + m_piFS);
       }
     }
@@ -267,22 +433,44 @@ private:
     Weight const m_piRT;
     Weight const m_piFS;
 
-    std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
-    std::map<Vertex, Weight> bestDistance;
-    std::map<Vertex, Vertex> parent;
+    Queue & queue;
+    VertexStorage<Weight> & bestDistance;
+    VertexStorage<Vertex> & parent;
     Vertex bestVertex;
 
     Weight pS;
   };
 
-  static void ReconstructPath(Vertex const & v, std::map<Vertex, Vertex> const & parent,
+  static void ReconstructPath(Vertex const & v, VertexStorage<Vertex> const & parent,
                               std::vector<Vertex> & path);
   static void ReconstructPathBidirectional(Vertex const & v, Vertex const & w,
-                                           std::map<Vertex, Vertex> const & parentV,
-                                           std::map<Vertex, Vertex> const & parentW,
+                                           VertexStorage<Vertex> const & parentV,
+                                           VertexStorage<Vertex> const & parentW,
                                            std::vector<Vertex> & path);
+
+  // Fills |tree| with |backwardWave| and the found path |result|. The storages of
+  // |backwardWave| are moved to |tree| without copying, so the wave can't be used after that.
+  static void SaveDestinationTree(BidirectionalStepContext const & forward,
+                                  BidirectionalStepContext const & backward, Wave & backwardWave,
+                                  RoutingResult<Vertex, Weight> const & result,
+                                  DestinationTree & tree);
+
+  // Number of steps which each wave of parallel bidirectional algorithm makes between
+  // synchronizations of the waves.
+  static uint32_t constexpr kParallelRoundSteps = 1024;
+
+  template <typename P>
+  Result FindPathBidirectionalParallel(P & params, RoutingResult<Vertex, Weight> & result,
+                                       Workspace & workspace) const;
+
+  // Makes up to kParallelRoundSteps steps of |context| wave. The method doesn't access
+  // the opposite wave, so it may be called for both waves simultaneously.
+  template <typename P>
+  void PropagateParallelRound(P & params, BidirectionalStepContext & context, Wave & wave) const;
 };
 
+template <typename Graph>
+constexpr uint32_t AStarAlgorithm<Graph>::kParallelRoundSteps;
 template <typename Graph>
 constexpr typename Graph::Weight AStarAlgorithm<Graph>::kEpsilon;
 template <typename Graph>
@@ -300,13 +488,12 @@ void AStarAlgorithm<Graph>::PropagateWave(Graph & graph, Vertex const & startVer
 {
   context.Clear();
 
-  std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
+  auto & queue = context.m_queue;
+  auto & adj = context.m_adj;
 
   context.SetDistance(startVertex, kZeroDistance);
   queue.push(State(startVertex, kZeroDistance));
 
-  std::vector<Edge> adj;
-
   while (!queue.empty())
   {
     State const stateV = queue.top();
@@ -371,6 +558,15 @@ template <typename Graph>
 template <typename P>
 typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPath(
     P & params, RoutingResult<Vertex, Weight> & result) const
+{
+  Workspace workspace;
+  return FindPath(params, result, workspace);
+}
+
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPath(
+    P & params, RoutingResult<Vertex, Weight> & result, Workspace & workspace) const
 {
   result.Clear();
 
@@ -378,7 +574,7 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPath(
   auto const & finalVertex = params.m_finalVertex;
   auto const & startVertex = params.m_startVertex;
 
-  Context context;
+  Context & context = workspace.m_context;
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
   Result resultCode = Result::NoPath;
 
@@ -416,7 +612,12 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPath(
   };
 
   auto const adjustEdgeWeight = [&](Vertex const & vertexV, Edge const & edge) {
-    auto const reducedWeight = fullToReducedLength(vertexV, edge.GetTarget(), edge.GetWeight());
+    auto const weight =
+        params.m_adjustEdgeWeightCallback
+            ? params.m_adjustEdgeWeightCallback(
+                  edge, reducedToFullLength(startVertex, vertexV, context.GetDistance(vertexV)))
+            : edge.GetWeight();
+    auto const reducedWeight = fullToReducedLength(vertexV, edge.GetTarget(), weight);
 
     CHECK_GREATER_OR_EQUAL(reducedWeight, -kEpsilon, ("Invariant violated."));
 
@@ -448,12 +649,27 @@ template <typename P>
 typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectional(
     P & params, RoutingResult<Vertex, Weight> & result) const
 {
+  Workspace workspace;
+  return FindPathBidirectional(params, result, workspace);
+}
+
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectional(
+    P & params, RoutingResult<Vertex, Weight> & result, Workspace & workspace) const
+{
+  CHECK(!params.m_adjustEdgeWeightCallback, ("Bidirectional search doesn't support it."));
+  if (params.m_parallelWaves)
+    return FindPathBidirectionalParallel(params, result, workspace);
+
   auto & graph = params.m_graph;
   auto const & finalVertex = params.m_finalVertex;
   auto const & startVertex = params.m_startVertex;
 
-  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
-  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph,
+                                   workspace.m_forward);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph,
+                                    workspace.m_backward);
 
   bool foundAnyPath = false;
   auto bestPathReducedLength = kZeroDistance;
@@ -472,7 +688,7 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
   BidirectionalStepContext * cur = &forward;
   BidirectionalStepContext * nxt = &backward;
 
-  std::vector<Edge> adj;
+  auto & adj = workspace.m_adj;
 
   // It is not necessary to check emptiness for both queues here
   // because if we have not found a path by the time one of the
@@ -517,6 +733,12 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
         CHECK(!result.m_path.empty(), ());
         if (!cur->forward)
           reverse(result.m_path.begin(), result.m_path.end());
+
+        if (params.m_destinationTree)
+        {
+          SaveDestinationTree(forward, backward, workspace.m_backward, result,
+                              *params.m_destinationTree);
+        }
         return Result::OK;
       }
     }
@@ -549,14 +771,14 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
       if (!params.m_checkLengthCallback(fullLength))
         continue;
 
-      auto const itCur = cur->bestDistance.find(stateW.vertex);
-      if (itCur != cur->bestDistance.end() && newReducedDist >= itCur->second - kEpsilon)
+      auto const * curDistW = cur->bestDistance.Find(stateW.vertex);
+      if (curDistW != nullptr && newReducedDist >= *curDistW - kEpsilon)
         continue;
 
-      auto const itNxt = nxt->bestDistance.find(stateW.vertex);
-      if (itNxt != nxt->bestDistance.end())
+      auto const * nxtDistW = nxt->bestDistance.Find(stateW.vertex);
+      if (nxtDistW != nullptr)
       {
-        auto const distW = itNxt->second;
+        auto const distW = *nxtDistW;
         // Reduced length that the path we've just found has in the original graph:
         // find the reduced length of the path's parts in the reduced forward and backward graphs.
         auto const curPathReducedLength = newReducedDist + distW;
@@ -585,10 +807,216 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectio
   return Result::NoPath;
 }
 
+template <typename Graph>
+template <typename P>
+void AStarAlgorithm<Graph>::PropagateParallelRound(P & params, BidirectionalStepContext & context,
+                                                   Wave & wave) const
+{
+  auto & adj = wave.m_adj;
+  for (uint32_t step = 0; step < kParallelRoundSteps && !context.queue.empty(); ++step)
+  {
+    State const stateV = context.queue.top();
+    context.queue.pop();
+
+    if (stateV.distance > context.bestDistance[stateV.vertex])
+      continue;
+
+    params.m_onVisitedVertexCallback(stateV.vertex,
+                                     context.forward ? context.finalVertex : context.startVertex);
+
+    context.GetAdjacencyList(stateV.vertex, adj);
+    auto const pV = context.ConsistentHeuristic(stateV.vertex);
+    for (auto const & edge : adj)
+    {
+      State stateW(edge.GetTarget(), kZeroDistance);
+      if (stateV.vertex == stateW.vertex)
+        continue;
+
+      auto const weight = edge.GetWeight();
+      auto const pW = context.ConsistentHeuristic(stateW.vertex);
+      auto const reducedWeight = weight + pW - pV;
+
+      CHECK_GREATER_OR_EQUAL(reducedWeight, -kEpsilon, ("Invariant violated."));
+      auto const newReducedDist = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+      auto const fullLength = weight + stateV.distance + context.pS - pV;
+      if (!params.m_checkLengthCallback(fullLength))
+        continue;
+
+      auto const * distW = context.bestDistance.Find(stateW.vertex);
+      if (distW != nullptr && newReducedDist >= *distW - kEpsilon)
+        continue;
+
+      stateW.distance = newReducedDist;
+      context.bestDistance[stateW.vertex] = newReducedDist;
+      context.parent[stateW.vertex] = stateV.vertex;
+      context.queue.push(stateW);
+      wave.m_labeled.push_back(stateW.vertex);
+    }
+  }
+}
+
+// The waves are propagated in rounds. During a round each wave works with its own data only.
+// Between the rounds both waves are stopped and the vertices labeled by one wave during the round
+// are looked up in the other one. That gives the same meeting candidates as the sequential
+// algorithm gets, but up to one round later, so the same stop condition is used.
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectionalParallel(
+    P & params, RoutingResult<Vertex, Weight> & result, Workspace & workspace) const
+{
+  auto & graph = params.m_graph;
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph,
+                                   workspace.m_forward);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph,
+                                    workspace.m_backward);
+
+  forward.bestDistance[startVertex] = kZeroDistance;
+  forward.queue.push(State(startVertex, kZeroDistance));
+
+  backward.bestDistance[finalVertex] = kZeroDistance;
+  backward.queue.push(State(finalVertex, kZeroDistance));
+
+  // Backward wave is propagated by |backwardThread|. Guarded by |mutex|.
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool backwardRoundRequested = false;
+  bool stopBackwardThread = false;
+
+  std::thread backwardThread([&]() {
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return backwardRoundRequested || stopBackwardThread; });
+        if (stopBackwardThread)
+          return;
+      }
+
+      PropagateParallelRound(params, backward, workspace.m_backward);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        backwardRoundRequested = false;
+      }
+      cv.notify_all();
+    }
+  });
+
+  SCOPE_GUARD(stopThreadGuard, [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopBackwardThread = true;
+    }
+    cv.notify_all();
+    backwardThread.join();
+  });
+
+  bool foundAnyPath = false;
+  auto bestPathReducedLength = kZeroDistance;
+  Vertex meetingVertex;
+
+  auto const updateBestPath = [&](std::vector<Vertex> const & labeled,
+                                  BidirectionalStepContext const & cur,
+                                  BidirectionalStepContext const & nxt) {
+    for (auto const & v : labeled)
+    {
+      auto const * nxtDist = nxt.bestDistance.Find(v);
+      if (nxtDist == nullptr)
+        continue;
+
+      auto const * curDist = cur.bestDistance.Find(v);
+      CHECK(curDist, ());
+      auto const length = *curDist + *nxtDist;
+      if (!foundAnyPath || bestPathReducedLength > length)
+      {
+        bestPathReducedLength = length;
+        meetingVertex = v;
+        foundAnyPath = true;
+      }
+    }
+  };
+
+  // Start vertex is labeled by the backward wave already if it's equal to the final vertex.
+  workspace.m_forward.m_labeled.push_back(startVertex);
+
+  while (true)
+  {
+    if (params.m_cancellable.IsCancelled())
+      return Result::Cancelled;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      backwardRoundRequested = true;
+    }
+    cv.notify_all();
+
+    PropagateParallelRound(params, forward, workspace.m_forward);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return !backwardRoundRequested; });
+    }
+
+    // Both waves are stopped here.
+    updateBestPath(workspace.m_forward.m_labeled, forward, backward);
+    updateBestPath(workspace.m_backward.m_labeled, backward, forward);
+    workspace.m_forward.m_labeled.clear();
+    workspace.m_backward.m_labeled.clear();
+
+    // If one of the queues is exhausted all the routes are found already.
+    if (forward.queue.empty() || backward.queue.empty())
+    {
+      if (!foundAnyPath)
+        return Result::NoPath;
+      break;
+    }
+
+    // See the comments to the stop condition in FindPathBidirectional().
+    if (foundAnyPath &&
+        forward.TopDistance() + backward.TopDistance() >= bestPathReducedLength - kEpsilon)
+    {
+      break;
+    }
+  }
+
+  auto const * forwardDist = forward.bestDistance.Find(meetingVertex);
+  auto const * backwardDist = backward.bestDistance.Find(meetingVertex);
+  CHECK(forwardDist && backwardDist, ());
+  auto const bestPathRealLength = *forwardDist + forward.pS -
+                                  forward.ConsistentHeuristic(meetingVertex) + *backwardDist +
+                                  backward.pS - backward.ConsistentHeuristic(meetingVertex);
+  if (!params.m_checkLengthCallback(bestPathRealLength))
+    return Result::NoPath;
+
+  std::vector<Vertex> backwardPath;
+  ReconstructPath(meetingVertex, forward.parent, result.m_path);
+  ReconstructPath(meetingVertex, backward.parent, backwardPath);
+  CHECK(!backwardPath.empty(), ());
+  result.m_path.insert(result.m_path.end(), backwardPath.rbegin() + 1, backwardPath.rend());
+  result.m_distance = bestPathRealLength;
+
+  if (params.m_destinationTree)
+    SaveDestinationTree(forward, backward, workspace.m_backward, result, *params.m_destinationTree);
+  return Result::OK;
+}
+
 template <typename Graph>
 template <typename P>
 typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
     P & params, RoutingResult<Vertex, Weight> & result) const
+{
+  Workspace workspace;
+  return AdjustRoute(params, result, workspace);
+}
+
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
+    P & params, RoutingResult<Vertex, Weight> & result, Workspace & workspace) const
 {
   CHECK(params.m_prevRoute, ());
   auto & graph = params.m_graph;
@@ -615,7 +1043,7 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
     remainingDistance += it->GetWeight();
   }
 
-  Context context;
+  Context & context = workspace.m_context;
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
   auto visitVertex = [&](Vertex const & vertex) {
@@ -682,10 +1110,426 @@ typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
   return Result::OK;
 }
 
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::AdjustRoute(
+    P & params, DestinationTree const & tree, RoutingResult<Vertex, Weight> & result,
+    Workspace & workspace) const
+{
+  CHECK(!tree.IsEmpty(), ());
+  auto & graph = params.m_graph;
+  auto const & startVertex = params.m_startVertex;
+
+  CHECK(params.m_checkLengthCallback != nullptr,
+        ("CheckLengthCallback expected to be set to limit wave propagation."));
+
+  result.Clear();
+
+  bool wasCancelled = false;
+  auto minDistance = kInfiniteDistance;
+  Vertex returnVertex;
+
+  Context & context = workspace.m_context;
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+
+  auto visitVertex = [&](Vertex const & vertex) {
+    if (periodicCancellable.IsCancelled())
+    {
+      wasCancelled = true;
+      return false;
+    }
+
+    params.m_onVisitedVertexCallback(startVertex, vertex);
+
+    auto const distance = context.GetDistance(vertex);
+    // Distances to the final vertex are not negative, so paths through the vertices
+    // which are not visited yet can't be shorter.
+    if (distance >= minDistance)
+      return false;
+
+    auto const * remainingDistance = tree.FindDistance(vertex);
+    if (remainingDistance != nullptr && distance + *remainingDistance < minDistance)
+    {
+      minDistance = distance + *remainingDistance;
+      returnVertex = vertex;
+    }
+
+    return true;
+  };
+
+  auto const adjustEdgeWeight = [](Vertex const & /* vertex */, Edge const & edge) {
+    return edge.GetWeight();
+  };
+
+  auto const filterStates = [&](State const & state) {
+    return params.m_checkLengthCallback(state.distance);
+  };
+
+  PropagateWave(graph, startVertex, visitVertex, adjustEdgeWeight, filterStates, context);
+  if (wasCancelled)
+    return Result::Cancelled;
+
+  if (minDistance == kInfiniteDistance)
+    return Result::NoPath;
+
+  context.ReconstructPath(returnVertex, result.m_path);
+  tree.AppendPath(returnVertex, result.m_path);
+  result.m_distance = minDistance;
+  return Result::OK;
+}
+
+template <typename Graph>
+template <typename P>
+typename AStarAlgorithm<Graph>::Result AStarAlgorithm<Graph>::FindPathBidirectionalWithAlternatives(
+    P & params, AlternativesParams const & alternatives,
+    std::vector<RoutingResult<Vertex, Weight>> & results, Workspace & workspace) const
+{
+  CHECK(!params.m_adjustEdgeWeightCallback, ("Bidirectional search doesn't support it."));
+  CHECK_GREATER_OR_EQUAL(alternatives.m_maxStretch, 1.0, ());
+  results.clear();
+
+  auto & graph = params.m_graph;
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph,
+                                   workspace.m_forward);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph,
+                                    workspace.m_backward);
+
+  bool foundAnyPath = false;
+  auto bestPathReducedLength = kZeroDistance;
+  auto bestPathRealLength = kZeroDistance;
+
+  forward.bestDistance[startVertex] = kZeroDistance;
+  forward.queue.push(State(startVertex, kZeroDistance));
+
+  backward.bestDistance[finalVertex] = kZeroDistance;
+  backward.queue.push(State(finalVertex, kZeroDistance));
+
+  // Reduced length of a path is its real length plus a constant, see ConsistentHeuristic().
+  // So the paths which meet |alternatives.m_maxStretch| have reduced lengths not greater than
+  // the returned one. Reduced distances are not negative, so every vertex of these paths
+  // is settled by both waves when the tops of their queues exceed it.
+  auto const getMaxReducedLength = [&]() {
+    return bestPathReducedLength + (alternatives.m_maxStretch - 1.0) * bestPathRealLength;
+  };
+
+  auto const isWaveFinished = [&](BidirectionalStepContext const & context) {
+    return context.queue.empty() ||
+           (foundAnyPath && context.TopDistance() > getMaxReducedLength());
+  };
+
+  BidirectionalStepContext * cur = &forward;
+  BidirectionalStepContext * nxt = &backward;
+
+  auto & adj = workspace.m_adj;
+
+  uint32_t steps = 0;
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+
+  while (true)
+  {
+    ++steps;
+
+    if (periodicCancellable.IsCancelled())
+      return Result::Cancelled;
+
+    // See the comment about exhausted queues in FindPathBidirectional().
+    if (!foundAnyPath && (cur->queue.empty() || nxt->queue.empty()))
+      return Result::NoPath;
+
+    if (steps % kQueueSwitchPeriod == 0)
+      std::swap(cur, nxt);
+
+    if (isWaveFinished(*cur))
+    {
+      std::swap(cur, nxt);
+      if (isWaveFinished(*cur))
+        break;
+    }
+
+    State const stateV = cur->queue.top();
+    cur->queue.pop();
+
+    if (stateV.distance > cur->bestDistance[stateV.vertex])
+      continue;
+
+    params.m_onVisitedVertexCallback(stateV.vertex,
+                                     cur->forward ? cur->finalVertex : cur->startVertex);
+
+    cur->GetAdjacencyList(stateV.vertex, adj);
+    auto const pV = cur->ConsistentHeuristic(stateV.vertex);
+    for (auto const & edge : adj)
+    {
+      State stateW(edge.GetTarget(), kZeroDistance);
+      if (stateV.vertex == stateW.vertex)
+        continue;
+
+      auto const weight = edge.GetWeight();
+      auto const pW = cur->ConsistentHeuristic(stateW.vertex);
+      auto const reducedWeight = weight + pW - pV;
+
+      CHECK_GREATER_OR_EQUAL(reducedWeight, -kEpsilon, ("Invariant violated."));
+      auto const newReducedDist = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+      auto const fullLength = weight + stateV.distance + cur->pS - pV;
+      if (!params.m_checkLengthCallback(fullLength))
+        continue;
+
+      auto const * curDistW = cur->bestDistance.Find(stateW.vertex);
+      if (curDistW != nullptr && newReducedDist >= *curDistW - kEpsilon)
+        continue;
+
+      auto const * nxtDistW = nxt->bestDistance.Find(stateW.vertex);
+      if (nxtDistW != nullptr)
+      {
+        auto const distW = *nxtDistW;
+        auto const curPathReducedLength = newReducedDist + distW;
+        if (!foundAnyPath || bestPathReducedLength > curPathReducedLength)
+        {
+          bestPathReducedLength = curPathReducedLength;
+
+          bestPathRealLength = stateV.distance + weight + distW;
+          bestPathRealLength += cur->pS - pV;
+          bestPathRealLength += nxt->pS - nxt->ConsistentHeuristic(stateW.vertex);
+
+          foundAnyPath = true;
+        }
+      }
+
+      stateW.distance = newReducedDist;
+      cur->bestDistance[stateW.vertex] = newReducedDist;
+      cur->parent[stateW.vertex] = stateV.vertex;
+      cur->queue.push(stateW);
+    }
+  }
+
+  if (!foundAnyPath || !params.m_checkLengthCallback(bestPathRealLength))
+    return Result::NoPath;
+
+  auto const getRealDistance = [](BidirectionalStepContext const & context,
+                                  Vertex const & vertex) {
+    auto const * distance = context.bestDistance.Find(vertex);
+    CHECK(distance, ());
+    return *distance + context.pS - context.ConsistentHeuristic(vertex);
+  };
+
+  // Vertices of both waves which paths through meet |alternatives.m_maxStretch| and real lengths
+  // of the paths.
+  auto const maxReducedLength = getMaxReducedLength();
+  VertexStorage<Weight> viaLengths;
+  std::vector<Vertex> viaVertices;
+  forward.bestDistance.ForEach([&](Vertex const & vertex, Weight & distance) {
+    auto const * backwardDistance = backward.bestDistance.Find(vertex);
+    if (backwardDistance == nullptr || distance + *backwardDistance > maxReducedLength + kEpsilon)
+      return;
+
+    viaLengths[vertex] = getRealDistance(forward, vertex) + getRealDistance(backward, vertex);
+    viaVertices.push_back(vertex);
+  });
+  CHECK(!viaVertices.empty(), ());
+
+  // |from| -> |to| is an edge of both the forward and the backward shortest path trees.
+  auto const isPlateauEdge = [&](Vertex const & from, Vertex const & to) {
+    auto const * forwardParent = forward.parent.Find(to);
+    auto const * backwardParent = backward.parent.Find(from);
+    return forwardParent != nullptr && *forwardParent == from && backwardParent != nullptr &&
+           *backwardParent == to && viaLengths.Find(from) != nullptr &&
+           viaLengths.Find(to) != nullptr;
+  };
+
+  struct Plateau
+  {
+    Vertex m_via;
+    Weight m_pathLength;
+    Weight m_plateauLength;
+  };
+
+  std::vector<Plateau> plateaus;
+  VertexStorage<bool> onPlateau;
+  for (Vertex const & vertex : viaVertices)
+  {
+    if (onPlateau.Find(vertex) != nullptr)
+      continue;
+
+    onPlateau[vertex] = true;
+    Vertex first = vertex;
+    while (auto const * prev = forward.parent.Find(first))
+    {
+      if (!isPlateauEdge(*prev, first))
+        break;
+      first = *prev;
+      onPlateau[first] = true;
+    }
+
+    Vertex last = vertex;
+    while (auto const * next = backward.parent.Find(last))
+    {
+      if (!isPlateauEdge(last, *next))
+        break;
+      last = *next;
+      onPlateau[last] = true;
+    }
+
+    auto const * pathLength = viaLengths.Find(vertex);
+    CHECK(pathLength, ());
+    plateaus.push_back(
+        {vertex, *pathLength, getRealDistance(forward, last) - getRealDistance(forward, first)});
+  }
+
+  // The shortest path goes first and the longest plateaus follow.
+  auto const shortest = std::min_element(
+      plateaus.begin(), plateaus.end(), [](Plateau const & lhs, Plateau const & rhs) {
+        if (lhs.m_pathLength != rhs.m_pathLength)
+          return lhs.m_pathLength < rhs.m_pathLength;
+        return lhs.m_via < rhs.m_via;
+      });
+  std::iter_swap(plateaus.begin(), shortest);
+  std::sort(plateaus.begin() + 1, plateaus.end(), [](Plateau const & lhs, Plateau const & rhs) {
+    if (lhs.m_plateauLength != rhs.m_plateauLength)
+      return lhs.m_plateauLength > rhs.m_plateauLength;
+    return lhs.m_via < rhs.m_via;
+  });
+
+  // Previous vertices of the vertices of the chosen paths.
+  std::vector<VertexStorage<Vertex>> chosenPaths;
+  std::vector<Vertex> backwardPath;
+  std::vector<Weight> distances;
+  for (Plateau const & plateau : plateaus)
+  {
+    if (results.size() == alternatives.m_maxAlternatives + 1)
+      break;
+
+    bool const isShortest = results.empty();
+    if (!isShortest && plateau.m_plateauLength <
+                           alternatives.m_minPlateauShare * plateau.m_pathLength - kEpsilon)
+    {
+      continue;
+    }
+
+    RoutingResult<Vertex, Weight> result;
+    ReconstructPath(plateau.m_via, forward.parent, result.m_path);
+    distances.clear();
+    for (Vertex const & vertex : result.m_path)
+      distances.push_back(getRealDistance(forward, vertex));
+
+    ReconstructPath(plateau.m_via, backward.parent, backwardPath);
+    CHECK(!backwardPath.empty(), ());
+    for (auto it = backwardPath.rbegin() + 1; it != backwardPath.rend(); ++it)
+    {
+      result.m_path.push_back(*it);
+      distances.push_back(plateau.m_pathLength - getRealDistance(backward, *it));
+    }
+    result.m_distance = plateau.m_pathLength;
+
+    VertexStorage<Vertex> prevVertices;
+    auto sharedLength = kZeroDistance;
+    bool hasLoop = false;
+    for (size_t i = 1; i < result.m_path.size(); ++i)
+    {
+      Vertex const & vertex = result.m_path[i];
+      Vertex const & prevVertex = result.m_path[i - 1];
+      if (prevVertices.Find(vertex) != nullptr)
+      {
+        hasLoop = true;
+        break;
+      }
+      prevVertices[vertex] = prevVertex;
+
+      for (auto const & chosenPath : chosenPaths)
+      {
+        auto const * chosenPrevVertex = chosenPath.Find(vertex);
+        if (chosenPrevVertex != nullptr && *chosenPrevVertex == prevVertex)
+        {
+          sharedLength += distances[i] - distances[i - 1];
+          break;
+        }
+      }
+    }
+
+    // The forward and the backward parts of a path through a plateau may intersect.
+    if (hasLoop)
+      continue;
+
+    if (!isShortest &&
+        sharedLength > alternatives.m_maxSharing * plateau.m_pathLength + kEpsilon)
+    {
+      continue;
+    }
+
+    chosenPaths.push_back(std::move(prevVertices));
+    results.push_back(std::move(result));
+  }
+
+  CHECK(!results.empty(), ());
+  if (params.m_destinationTree)
+  {
+    SaveDestinationTree(forward, backward, workspace.m_backward, results.front(),
+                        *params.m_destinationTree);
+  }
+  return Result::OK;
+}
+
+// static
+template <typename Graph>
+void AStarAlgorithm<Graph>::SaveDestinationTree(BidirectionalStepContext const & forward,
+                                                BidirectionalStepContext const & backward,
+                                                Wave & backwardWave,
+                                                RoutingResult<Vertex, Weight> const & result,
+                                                DestinationTree & tree)
+{
+  tree.Clear();
+  tree.m_finalVertex = backward.finalVertex;
+
+  // Every vertex of the backward wave is labeled from a settled vertex, so the distance of
+  // the vertex is the exact length of the path to the final vertex through its parents.
+  backwardWave.m_bestDistance.ForEach([&backward](Vertex const & vertex, Weight & distance) {
+    distance = distance + backward.pS - backward.ConsistentHeuristic(vertex);
+  });
+  std::swap(tree.m_distances, backwardWave.m_bestDistance);
+  std::swap(tree.m_next, backwardWave.m_parent);
+
+  // Vertices of the path reached by the forward wave only.
+  auto const & path = result.m_path;
+  for (size_t i = 0; i + 1 < path.size(); ++i)
+  {
+    Vertex const & vertex = path[i];
+    if (tree.m_distances.Find(vertex) != nullptr)
+      continue;
+
+    auto const * forwardDistance = forward.bestDistance.Find(vertex);
+    CHECK(forwardDistance, ());
+    auto const distanceFromStart =
+        *forwardDistance + forward.pS - forward.ConsistentHeuristic(vertex);
+    tree.m_distances[vertex] = std::max(result.m_distance - distanceFromStart, kZeroDistance);
+    tree.m_next[vertex] = path[i + 1];
+  }
+}
+
+template <typename Graph>
+void AStarAlgorithm<Graph>::DestinationTree::AppendPath(Vertex const & vertex,
+                                                        std::vector<Vertex> & path) const
+{
+  Vertex cur = vertex;
+  for (size_t i = 0; i < m_next.GetSize(); ++i)
+  {
+    auto const * next = m_next.Find(cur);
+    if (next == nullptr)
+    {
+      CHECK(cur == m_finalVertex, ("The tree doesn't lead to the final vertex."));
+      return;
+    }
+    cur = *next;
+    path.push_back(cur);
+  }
+  CHECK(cur == m_finalVertex, ("The tree has a cycle."));
+}
+
 // static
 template <typename Graph>
 void AStarAlgorithm<Graph>::ReconstructPath(Vertex const & v,
-                                            std::map<Vertex, Vertex> const & parent,
+                                            VertexStorage<Vertex> const & parent,
                                             std::vector<Vertex> & path)
 {
   path.clear();
@@ -693,10 +1537,10 @@ void AStarAlgorithm<Graph>::ReconstructPath(Vertex const & v,
   while (true)
   {
     path.push_back(cur);
-    auto it = parent.find(cur);
-    if (it == parent.end())
+    auto const * next = parent.Find(cur);
+    if (next == nullptr)
       break;
-    cur = it->second;
+    cur = *next;
   }
   reverse(path.begin(), path.end());
 }
@@ -704,8 +1548,8 @@ void AStarAlgorithm<Graph>::ReconstructPath(Vertex const & v,
 // static
 template <typename Graph>
 void AStarAlgorithm<Graph>::ReconstructPathBidirectional(Vertex const & v, Vertex const & w,
-                                                         std::map<Vertex, Vertex> const & parentV,
-                                                         std::map<Vertex, Vertex> const & parentW,
+                                                         VertexStorage<Vertex> const & parentV,
+                                                         VertexStorage<Vertex> const & parentW,
                                                          std::vector<Vertex> & path)
 {
   std::vector<Vertex> pathV;
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace routing
+{
+// Storages of per-vertex values (distances, parents) for AStarAlgorithm.
+// Every storage provides:
+//   Find(v) - returns pointer to the value of |v| or nullptr if there is no value for |v|;
+//   operator[](v) - returns reference to the value of |v|, inserts default value if needed;
+//   Clear() - removes all values;
+//   GetSize() - returns number of stored values;
+//   ForEach(fn) - calls fn(vertex, value) for every stored value in unspecified order,
+//   the value may be changed by |fn|.
+// Pointers returned by Find() and references returned by operator[] are invalidated
+// by the next insertion.
+
+// Fallback storage for any vertex type with operator<.
+template <typename Vertex, typename Value>
+class MapVertexStorage final
+{
+public:
+  Value const * Find(Vertex const & vertex) const
+  {
+    auto const it = m_map.find(vertex);
+    return it == m_map.cend() ? nullptr : &it->second;
+  }
+
+  Value * Find(Vertex const & vertex)
+  {
+    auto const it = m_map.find(vertex);
+    return it == m_map.end() ? nullptr : &it->second;
+  }
+
+  Value & operator[](Vertex const & vertex) { return m_map[vertex]; }
+
+  void Clear() { m_map.clear(); }
+
+  template <typename Fn>
+  void ForEach(Fn && fn)
+  {
+    for (auto & item : m_map)
+      fn(item.first, item.second);
+  }
+
+  size_t GetSize() const { return m_map.size(); }
+
+private:
+  std::map<Vertex, Value> m_map;
+};
+
+// Open-addressing hash table with linear probing. Memory of the table is never released
+// by Clear(): every slot keeps the generation it has been filled in and slots of
+// the previous generations are treated as empty. So Clear() is O(1) and a cleared storage
+// may be refilled without any allocations.
+// |Hasher| may be of poor quality (e.g. std::hash<uint64_t> is identity),
+// the hash value is scrambled before use.
+template <typename Vertex, typename Value, typename Hasher>
+class HashVertexStorage final
+{
+public:
+  HashVertexStorage() = default;
+
+  Value const * Find(Vertex const & vertex) const
+  {
+    if (m_size == 0)
+      return nullptr;
+
+    size_t const mask = m_slots.size() - 1;
+    for (size_t i = GetStartIndex(vertex);; i = (i + 1) & mask)
+    {
+      Slot const & slot = m_slots[i];
+      if (slot.m_generation != m_generation)
+        return nullptr;
+      if (slot.m_vertex == vertex)
+        return &slot.m_value;
+    }
+  }
+
+  Value * Find(Vertex const & vertex)
+  {
+    return const_cast<Value *>(static_cast<HashVertexStorage const *>(this)->Find(vertex));
+  }
+
+  Value & operator[](Vertex const & vertex)
+  {
+    if (Value * value = Find(vertex))
+      return *value;
+
+    if ((m_size + 1) * 2 > m_slots.size())
+      Grow();
+
+    Slot & slot = FindEmptySlot(vertex);
+    slot.m_vertex = vertex;
+    slot.m_value = Value();
+    slot.m_generation = m_generation;
+    ++m_size;
+    return slot.m_value;
+  }
+
+  void Clear()
+  {
+    m_size = 0;
+    ++m_generation;
+    if (m_generation != 0)
+      return;
+
+    // Generation counter is overflowed. All slots must be marked as empty explicitly.
+    for (auto & slot : m_slots)
+      slot.m_generation = 0;
+    m_generation = 1;
+  }
+
+  size_t GetSize() const { return m_size; }
+
+  template <typename Fn>
+  void ForEach(Fn && fn)
+  {
+    if (m_size == 0)
+      return;
+
+    for (auto & slot : m_slots)
+    {
+      if (slot.m_generation == m_generation)
+        fn(static_cast<Vertex const &>(slot.m_vertex), slot.m_value);
+    }
+  }
+
+private:
+  static size_t constexpr kMinCapacity = 1024;
+
+  struct Slot
+  {
+    Vertex m_vertex = Vertex();
+    Value m_value = Value();
+    // Slot is filled iff |m_generation| is equal to HashVertexStorage::m_generation.
+    uint32_t m_generation = 0;
+  };
+
+  size_t GetStartIndex(Vertex const & vertex) const
+  {
+    // Fibonacci hashing: the highest bits of the product are the best mixed ones.
+    uint64_t const hash = static_cast<uint64_t>(Hasher()(vertex)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash >> (64 - m_capacityLog));
+  }
+
+  Slot & FindEmptySlot(Vertex const & vertex)
+  {
+    size_t const mask = m_slots.size() - 1;
+    size_t i = GetStartIndex(vertex);
+    while (m_slots[i].m_generation == m_generation)
+      i = (i + 1) & mask;
+    return m_slots[i];
+  }
+
+  void Grow()
+  {
+    std::vector<Slot> slots(m_slots.empty() ? kMinCapacity : m_slots.size() * 2);
+    m_capacityLog = bits::FloorLog(slots.size());
+    ASSERT_EQUAL(size_t{1} << m_capacityLog, slots.size(), ());
+
+    slots.swap(m_slots);
+    uint32_t const oldGeneration = m_generation;
+    m_generation = 1;
+    for (auto & slot : slots)
+    {
+      if (slot.m_generation != oldGeneration)
+        continue;
+
+      Slot & newSlot = FindEmptySlot(slot.m_vertex);
+      newSlot.m_vertex = slot.m_vertex;
+      newSlot.m_value = slot.m_value;
+      newSlot.m_generation = m_generation;
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_size = 0;
+  uint8_t m_capacityLog = 0;
+  uint32_t m_generation = 1;
+};
+
+template <typename Vertex, typename Value, typename Hasher>
+size_t constexpr HashVertexStorage<Vertex, Value, Hasher>::kMinCapacity;
+
+namespace astar_vertex_storage_details
+{
+template <typename...>
+struct MakeVoid
+{
+  using Type = void;
+};
+}  // namespace astar_vertex_storage_details
+
+// Chooses vertex storage for |Graph|. Graphs which declare |VertexHasher| type
+// get HashVertexStorage, other graphs get MapVertexStorage.
+template <typename Graph, typename = void>
+struct AStarVertexStorageSelector
+{
+  template <typename Value>
+  using Storage = MapVertexStorage<typename Graph::Vertex, Value>;
+};
+
+template <typename Graph>
+struct AStarVertexStorageSelector<
+    Graph, typename astar_vertex_storage_details::MakeVoid<typename Graph::VertexHasher>::Type>
+{
+  template <typename Value>
+  using Storage = HashVertexStorage<typename Graph::Vertex, Value, typename Graph::VertexHasher>;
+};
+}  // namespace routing
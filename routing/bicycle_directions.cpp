@@ -20,9 +20,15 @@
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
+#include "base/math.hpp"
+
 #include <algorithm>
 #include <cstdlib>
+#include <exception>
+#include <map>
+#include <memory>
 #include <numeric>
+#include <thread>
 #include <utility>
 
 namespace
@@ -94,6 +100,126 @@ private:
   double m_routeLength;
 };
 
+// Turn candidates and attributes of path segments are loaded in parallel if a route has at
+// least 2 * kMinJointsPerThread joints.
+size_t constexpr kMinJointsPerThread = 256;
+
+/// \brief Loads road attributes of features. The same features are adjacent to several joints
+/// of a route, so attributes of every feature are loaded once.
+/// \note FeaturesLoaderGuard isn't thread safe, so every thread should use its own loader.
+class RoadAttributesLoader
+{
+public:
+  struct Attributes
+  {
+    bool m_isLoaded = false;
+    ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+    bool m_isLink = false;
+    bool m_onRoundabout = false;
+    string m_name;
+  };
+
+  explicit RoadAttributesLoader(DataSource const & dataSource) : m_dataSource(dataSource) {}
+
+  /// \returns nullptr if the feature can't be loaded.
+  Attributes const * GetAttributes(FeatureID const & featureId)
+  {
+    auto it = m_attributes.find(featureId);
+    if (it == m_attributes.end())
+      it = m_attributes.emplace(featureId, LoadAttributes(featureId)).first;
+    return it->second.m_isLoaded ? &it->second : nullptr;
+  }
+
+private:
+  Attributes LoadAttributes(FeatureID const & featureId)
+  {
+    Attributes attributes;
+    if (!m_loader || featureId.m_mwmId != m_loader->GetId())
+      m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, featureId.m_mwmId);
+
+    FeatureType ft;
+    if (!m_loader->GetFeatureByIndex(featureId.m_index, ft))
+      return attributes;
+
+    attributes.m_isLoaded = true;
+    attributes.m_highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(ft));
+    ASSERT_NOT_EQUAL(attributes.m_highwayClass, ftypes::HighwayClass::Error, ());
+    ASSERT_NOT_EQUAL(attributes.m_highwayClass, ftypes::HighwayClass::Undefined, ());
+    attributes.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
+    attributes.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+    ft.GetName(StringUtf8Multilang::kDefaultCode, attributes.m_name);
+    return attributes;
+  }
+
+  DataSource const & m_dataSource;
+  unique_ptr<FeaturesLoaderGuard> m_loader;
+  map<FeatureID, Attributes> m_attributes;
+};
+
+void LoadPathAttributes(FeatureID const & featureId, RoadAttributesLoader & loader,
+                        LoadedPathSegment & pathSegment)
+{
+  if (!featureId.IsValid())
+    return;
+
+  auto const * attributes = loader.GetAttributes(featureId);
+  if (!attributes)
+    return;
+
+  pathSegment.m_highwayClass = attributes->m_highwayClass;
+  pathSegment.m_isLink = attributes->m_isLink;
+  pathSegment.m_name = attributes->m_name;
+  pathSegment.m_onRoundabout = attributes->m_onRoundabout;
+}
+
+void GetSegmentRangeAndAdjacentEdges(NumMwmIds const & numMwmIds, RoadAttributesLoader & loader,
+                                     IRoadGraph::TEdgeVector const & outgoingEdges,
+                                     Edge const & inEdge, uint32_t startSegId, uint32_t endSegId,
+                                     SegmentRange & segmentRange, TurnCandidates & outgoingTurns)
+{
+  outgoingTurns.isCandidatesAngleValid = true;
+  outgoingTurns.candidates.reserve(outgoingEdges.size());
+  segmentRange = SegmentRange(inEdge.GetFeatureId(), startSegId, endSegId, inEdge.IsForward(),
+                              inEdge.GetStartPoint(), inEdge.GetEndPoint());
+  CHECK(segmentRange.IsCorrect(), ());
+  m2::PointD const & ingoingPoint = inEdge.GetStartJunction().GetPoint();
+  m2::PointD const & junctionPoint = inEdge.GetEndJunction().GetPoint();
+
+  for (auto const & edge : outgoingEdges)
+  {
+    if (edge.IsFake())
+      continue;
+
+    auto const * attributes = loader.GetAttributes(edge.GetFeatureId());
+    if (!attributes)
+      continue;
+
+    double angle = 0;
+
+    if (inEdge.GetFeatureId().m_mwmId == edge.GetFeatureId().m_mwmId)
+    {
+      ASSERT_LESS(MercatorBounds::DistanceOnEarth(junctionPoint, edge.GetStartJunction().GetPoint()),
+                  turns::kFeaturesNearTurnMeters, ());
+      m2::PointD const & outgoingPoint = edge.GetEndJunction().GetPoint();
+      angle = base::RadToDeg(turns::PiMinusTwoVectorsAngle(junctionPoint, ingoingPoint, outgoingPoint));
+    }
+    else
+    {
+      // Note. In case of crossing mwm border
+      // (inEdge.GetFeatureId().m_mwmId != edge.GetFeatureId().m_mwmId)
+      // twins of inEdge.GetFeatureId() are considered as outgoing features.
+      // In this case that turn candidate angle is invalid and
+      // should not be used for turn generation.
+      outgoingTurns.isCandidatesAngleValid = false;
+    }
+    outgoingTurns.candidates.emplace_back(angle, ConvertEdgeToSegment(numMwmIds, edge),
+                                          attributes->m_highwayClass, attributes->m_isLink);
+  }
+
+  if (outgoingTurns.isCandidatesAngleValid)
+    sort(outgoingTurns.candidates.begin(), outgoingTurns.candidates.end(), base::LessBy(&TurnCandidate::m_angle));
+}
+
 /// \brief This method should be called for an internal junction of the route with corresponding
 /// |ingoingEdges|, |outgoingEdges|, |ingoingRouteEdge| and |outgoingRouteEdge|.
 /// \returns false if the junction is an internal point of feature segment and can be considered as
@@ -211,105 +337,109 @@ bool BicycleDirectionsEngine::Generate(IndexRoadGraph const & graph, vector<Junc
   return true;
 }
 
-FeaturesLoaderGuard & BicycleDirectionsEngine::GetLoader(MwmSet::MwmId const & id)
+void BicycleDirectionsEngine::GetEdges(RoadGraphBase const & graph, Junction const & currJunction,
+                                       bool isCurrJunctionFinish, IRoadGraph::TEdgeVector & outgoing,
+                                       IRoadGraph::TEdgeVector & ingoing)
 {
-  if (!m_loader || id != m_loader->GetId())
-    m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id);
-  return *m_loader;
+  // Note. If |currJunction| is a finish the outgoing edges
+  // from finish are not important for turn generation.
+  if (!isCurrJunctionFinish)
+    graph.GetOutgoingEdges(currJunction, outgoing);
+  graph.GetIngoingEdges(currJunction, ingoing);
 }
 
-void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment)
+void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
+    IndexRoadGraph const & graph, vector<Junction> const & path,
+    IRoadGraph::TEdgeVector const & routeEdges, base::Cancellable const & cancellable)
 {
-  if (!featureId.IsValid())
+  vector<JointEdges> joints;
+  GetJointEdges(graph, path, routeEdges, cancellable, joints);
+  if (cancellable.IsCancelled())
     return;
 
-  FeatureType ft;
-  if(!GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index, ft))
-    return;
+  vector<LoadedPathSegment> pathSegments(joints.size());
+  vector<AdjacentEdges> adjacentEdges(joints.size());
+  auto const processJoints = [&](size_t begin, size_t end) {
+    RoadAttributesLoader loader(m_dataSource);
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (cancellable.IsCancelled())
+        return;
+
+      JointEdges & joint = joints[i];
+      LoadedPathSegment & pathSegment = pathSegments[i];
+      adjacentEdges[i] = AdjacentEdges(joint.m_ingoingEdgesCount);
+      GetSegmentRangeAndAdjacentEdges(*m_numMwmIds, loader, joint.m_outgoingEdges, joint.m_inEdge,
+                                      joint.m_startSegId, joint.m_inEdge.GetSegId(),
+                                      pathSegment.m_segmentRange, adjacentEdges[i].m_outgoingTurns);
+      LoadPathAttributes(pathSegment.m_segmentRange.GetFeature(), loader, pathSegment);
+      pathSegment.m_path = move(joint.m_path);
+      // @TODO(bykoianko) |pathSegment.m_weight| should be filled here.
+      pathSegment.m_segments = move(joint.m_segments);
+    }
+  };
+
+  size_t const maxThreads = max(thread::hardware_concurrency(), 1u);
+  size_t const numThreads = base::clamp(joints.size() / kMinJointsPerThread, size_t(1), maxThreads);
+  size_t const chunkSize = (joints.size() + numThreads - 1) / numThreads;
+  // Threads must be joined before an exception leaves the method, so exceptions are rethrown
+  // after all the chunks are processed.
+  vector<exception_ptr> exceptions(numThreads);
+  auto const processChunk = [&](size_t chunk) {
+    try
+    {
+      processJoints(chunk * chunkSize, min((chunk + 1) * chunkSize, joints.size()));
+    }
+    catch (...)
+    {
+      exceptions[chunk] = current_exception();
+    }
+  };
 
-  auto const highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(ft));
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+  vector<thread> threads;
+  for (size_t i = 1; i < numThreads; ++i)
+    threads.emplace_back(processChunk, i);
+  processChunk(0);
+  for (auto & t : threads)
+    t.join();
 
-  pathSegment.m_highwayClass = highwayClass;
-  pathSegment.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
-  ft.GetName(StringUtf8Multilang::kDefaultCode, pathSegment.m_name);
-  pathSegment.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
-}
+  for (auto const & e : exceptions)
+  {
+    if (e)
+      rethrow_exception(e);
+  }
 
-void BicycleDirectionsEngine::GetSegmentRangeAndAdjacentEdges(
-    IRoadGraph::TEdgeVector const & outgoingEdges, Edge const & inEdge, uint32_t startSegId,
-    uint32_t endSegId, SegmentRange & segmentRange, TurnCandidates & outgoingTurns)
-{
-  outgoingTurns.isCandidatesAngleValid = true;
-  outgoingTurns.candidates.reserve(outgoingEdges.size());
-  segmentRange = SegmentRange(inEdge.GetFeatureId(), startSegId, endSegId, inEdge.IsForward(),
-                              inEdge.GetStartPoint(), inEdge.GetEndPoint());
-  CHECK(segmentRange.IsCorrect(), ());
-  m2::PointD const & ingoingPoint = inEdge.GetStartJunction().GetPoint();
-  m2::PointD const & junctionPoint = inEdge.GetEndJunction().GetPoint();
+  if (cancellable.IsCancelled())
+    return;
 
-  for (auto const & edge : outgoingEdges)
+  for (size_t i = 0; i < joints.size(); ++i)
   {
-    if (edge.IsFake())
+    SegmentRange const & segmentRange = pathSegments[i].m_segmentRange;
+    if (segmentRange.IsEmpty())
       continue;
 
-    auto const & outFeatureId = edge.GetFeatureId();
-    FeatureType ft;
-    if (!GetLoader(outFeatureId.m_mwmId).GetFeatureByIndex(outFeatureId.m_index, ft))
-      continue;
-
-    auto const highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(ft));
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+    auto const it = m_adjacentEdges.find(segmentRange);
+    // A route may be built through intermediate points. So it may contain the same |segmentRange|
+    // several times. But in that case |adjacentEdges| corresponding to |segmentRange|
+    // should be the same.
+    ASSERT(it == m_adjacentEdges.cend() || it->second.IsAlmostEqual(adjacentEdges[i]),
+           ("segmentRange:", segmentRange, "corresponds to adjacent edges which aren't equal."));
 
-    bool const isLink = ftypes::IsLinkChecker::Instance()(ft);
-
-    double angle = 0;
-
-    if (inEdge.GetFeatureId().m_mwmId == edge.GetFeatureId().m_mwmId)
-    {
-      ASSERT_LESS(MercatorBounds::DistanceOnEarth(junctionPoint, edge.GetStartJunction().GetPoint()),
-                  turns::kFeaturesNearTurnMeters, ());
-      m2::PointD const & outgoingPoint = edge.GetEndJunction().GetPoint();
-      angle = base::RadToDeg(turns::PiMinusTwoVectorsAngle(junctionPoint, ingoingPoint, outgoingPoint));
-    }
-    else
-    {
-      // Note. In case of crossing mwm border
-      // (inEdge.GetFeatureId().m_mwmId != edge.GetFeatureId().m_mwmId)
-      // twins of inEdge.GetFeatureId() are considered as outgoing features.
-      // In this case that turn candidate angle is invalid and
-      // should not be used for turn generation.
-      outgoingTurns.isCandidatesAngleValid = false;
-    }
-    outgoingTurns.candidates.emplace_back(angle, ConvertEdgeToSegment(*m_numMwmIds, edge),
-                                          highwayClass, isLink);
+    m_adjacentEdges.insert(it, make_pair(segmentRange, move(adjacentEdges[i])));
   }
-
-  if (outgoingTurns.isCandidatesAngleValid)
-    sort(outgoingTurns.candidates.begin(), outgoingTurns.candidates.end(), base::LessBy(&TurnCandidate::m_angle));
-}
-
-void BicycleDirectionsEngine::GetEdges(RoadGraphBase const & graph, Junction const & currJunction,
-                                       bool isCurrJunctionFinish, IRoadGraph::TEdgeVector & outgoing,
-                                       IRoadGraph::TEdgeVector & ingoing)
-{
-  // Note. If |currJunction| is a finish the outgoing edges
-  // from finish are not important for turn generation.
-  if (!isCurrJunctionFinish)
-    graph.GetOutgoingEdges(currJunction, outgoing);
-  graph.GetIngoingEdges(currJunction, ingoing);
+  m_pathSegments = move(pathSegments);
 }
 
-void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
-    IndexRoadGraph const & graph, vector<Junction> const & path,
-    IRoadGraph::TEdgeVector const & routeEdges, base::Cancellable const & cancellable)
+void BicycleDirectionsEngine::GetJointEdges(IndexRoadGraph const & graph,
+                                            vector<Junction> const & path,
+                                            IRoadGraph::TEdgeVector const & routeEdges,
+                                            base::Cancellable const & cancellable,
+                                            vector<JointEdges> & joints)
 {
   size_t const pathSize = path.size();
   CHECK_GREATER(pathSize, 1, ());
   CHECK_EQUAL(routeEdges.size() + 1, pathSize, ());
-  // Filling |m_adjacentEdges|.
+  joints.clear();
   auto constexpr kInvalidSegId = numeric_limits<uint32_t>::max();
   // |startSegId| is a value to keep start segment id of a new instance of LoadedPathSegment.
   uint32_t startSegId = kInvalidSegId;
@@ -351,36 +481,18 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
 
     prevJunctions.push_back(currJunction);
 
-    AdjacentEdges adjacentEdges(ingoingEdges.size());
-    SegmentRange segmentRange;
-    GetSegmentRangeAndAdjacentEdges(outgoingEdges, inEdge, startSegId, inSegId, segmentRange,
-                                    adjacentEdges.m_outgoingTurns);
-
-    size_t const prevJunctionSize = prevJunctions.size();
-    LoadedPathSegment pathSegment;
-    LoadPathAttributes(segmentRange.GetFeature(), pathSegment);
-    pathSegment.m_segmentRange = segmentRange;
-    pathSegment.m_path = move(prevJunctions);
-    // @TODO(bykoianko) |pathSegment.m_weight| should be filled here.
-
     // |prevSegments| contains segments which corresponds to road edges between joints. In case of a fake edge
     // a fake segment is created.
-    CHECK_EQUAL(prevSegments.size() + 1, prevJunctionSize, ());
-    pathSegment.m_segments = move(prevSegments);
-
-    if (!segmentRange.IsEmpty())
-    {
-      auto const it = m_adjacentEdges.find(segmentRange);
-      // A route may be built through intermediate points. So it may contain the same |segmentRange|
-      // several times. But in that case |adjacentEdges| corresponding to |segmentRange|
-      // should be the same.
-      ASSERT(it == m_adjacentEdges.cend() || it->second.IsAlmostEqual(adjacentEdges),
-             ("segmentRange:", segmentRange, "corresponds to adjacent edges which aren't equal."));
-
-      m_adjacentEdges.insert(it, make_pair(segmentRange, move(adjacentEdges)));
-    }
-
-    m_pathSegments.push_back(move(pathSegment));
+    CHECK_EQUAL(prevSegments.size() + 1, prevJunctions.size(), ());
+
+    joints.emplace_back();
+    JointEdges & joint = joints.back();
+    joint.m_inEdge = inEdge;
+    joint.m_startSegId = startSegId;
+    joint.m_outgoingEdges = move(outgoingEdges);
+    joint.m_ingoingEdgesCount = ingoingEdges.size();
+    joint.m_path = move(prevJunctions);
+    joint.m_segments = move(prevSegments);
 
     prevJunctions.clear();
     prevSegments.clear();
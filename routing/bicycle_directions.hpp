@@ -11,6 +11,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace routing
 {
@@ -37,18 +38,29 @@ public:
                 vector<Segment> & segments) override;
 
 private:
-  FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id);
-  void LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment);
-  void GetSegmentRangeAndAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
-                                       Edge const & inEdge, uint32_t startSegId, uint32_t endSegId,
-                                       SegmentRange & segmentRange,
-                                       turns::TurnCandidates & outgoingTurns);
+  /// \brief Route edges between two neighboring joints and edges adjacent to the last joint.
+  /// It's gathered from the road graph only, features are not loaded.
+  struct JointEdges
+  {
+    Edge m_inEdge;
+    uint32_t m_startSegId = 0;
+    IRoadGraph::TEdgeVector m_outgoingEdges;
+    size_t m_ingoingEdgesCount = 0;
+    std::vector<Junction> m_path;
+    std::vector<Segment> m_segments;
+  };
+
   /// \brief The method gathers sequence of segments according to IsJoint() method
   /// and fills |m_adjacentEdges| and |m_pathSegments|.
+  /// \note Walking the road graph isn't thread safe so it's done sequentially. Then features
+  /// are loaded for chunks of joints in parallel for long routes.
   void FillPathSegmentsAndAdjacentEdgesMap(IndexRoadGraph const & graph,
                                            std::vector<Junction> const & path,
                                            IRoadGraph::TEdgeVector const & routeEdges,
                                            base::Cancellable const & cancellable);
+  void GetJointEdges(IndexRoadGraph const & graph, std::vector<Junction> const & path,
+                     IRoadGraph::TEdgeVector const & routeEdges,
+                     base::Cancellable const & cancellable, std::vector<JointEdges> & joints);
 
   void GetEdges(RoadGraphBase const & graph, Junction const & currJunction,
                 bool isCurrJunctionFinish, IRoadGraph::TEdgeVector & outgoing,
@@ -58,6 +70,5 @@ private:
   TUnpackedPathSegments m_pathSegments;
   DataSource const & m_dataSource;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
-  std::unique_ptr<FeaturesLoaderGuard> m_loader;
 };
 }  // namespace routing
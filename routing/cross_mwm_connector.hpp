@@ -169,6 +169,12 @@ public:
   }
 
   bool HasWeights() const { return !m_weights.empty(); }
+  // Returns true if the section has the weights of the connector, they may be not loaded yet.
+  bool WeightsExist() const
+  {
+    return m_weightsLoadState == connector::WeightsLoadState::ReadyToLoad ||
+           m_weightsLoadState == connector::WeightsLoadState::Loaded;
+  }
   bool IsEmpty() const { return m_enters.empty() && m_exits.empty(); }
 
   bool WeightsWereLoaded() const
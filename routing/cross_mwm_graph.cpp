@@ -47,7 +47,7 @@ void CrossMwmGraph::ClosestSegment::Update(double distM, Segment const & bestSeg
 
 // CrossMwmGraph ----------------------------------------------------------------------------------
 CrossMwmGraph::CrossMwmGraph(shared_ptr<NumMwmIds> numMwmIds,
-                             shared_ptr<m4::Tree<NumMwmId>> numMwmTree,
+                             shared_ptr<m4::PackedTree<NumMwmId>> numMwmTree,
                              shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                              VehicleType vehicleType, CourntryRectFn const & countryRectFn,
                              DataSource & dataSource)
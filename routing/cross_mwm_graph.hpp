@@ -9,7 +9,7 @@
 #include "routing_common/num_mwm_id.hpp"
 #include "routing_common/vehicle_model.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 
 #include "base/geo_object_id.hpp"
 #include "base/math.hpp"
@@ -35,7 +35,8 @@ public:
     NoSection,
   };
 
-  CrossMwmGraph(std::shared_ptr<NumMwmIds> numMwmIds, shared_ptr<m4::Tree<NumMwmId>> numMwmTree,
+  CrossMwmGraph(std::shared_ptr<NumMwmIds> numMwmIds,
+                shared_ptr<m4::PackedTree<NumMwmId>> numMwmTree,
                 std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                 VehicleType vehicleType, CourntryRectFn const & countryRectFn,
                 DataSource & dataSource);
@@ -97,6 +98,13 @@ public:
     return m_crossMwmIndexGraph.GetTransitions(numMwmId, isEnter);
   }
 
+  /// \returns true if the cross-mwm section of mwm with id |numMwmId| has the weights
+  /// of the routes between the transitions, i.e. LeapsOnly mode may be used for the mwm.
+  bool WeightsExist(NumMwmId numMwmId)
+  {
+    return CrossMwmSectionExists(numMwmId) && m_crossMwmIndexGraph.WeightsExist(numMwmId);
+  }
+
 private:
   struct ClosestSegment
   {
@@ -150,7 +158,7 @@ private:
 
   DataSource & m_dataSource;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
-  std::shared_ptr<m4::Tree<NumMwmId>> m_numMwmTree;
+  std::shared_ptr<m4::PackedTree<NumMwmId>> m_numMwmTree;
   std::shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
   CourntryRectFn const & m_countryRectFn;
   CrossMwmIndexGraph<base::GeoObjectId> m_crossMwmIndexGraph;
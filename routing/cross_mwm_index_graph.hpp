@@ -154,6 +154,11 @@ public:
     return isEnter ? connector.GetEnters() : connector.GetExits();
   }
 
+  bool WeightsExist(NumMwmId numMwmId)
+  {
+    return GetCrossMwmConnectorWithTransitions(numMwmId).WeightsExist();
+  }
+
 private:
   CrossMwmConnector<CrossMwmId> const & GetCrossMwmConnectorWithWeights(NumMwmId numMwmId)
   {
@@ -1,6 +1,7 @@
 #include "routing/edge_estimator.hpp"
 
 #include "routing/routing_helpers.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "traffic/traffic_info.hpp"
 
@@ -68,7 +69,7 @@ double CalcClimbSegment(Purpose purpose, Segment const & segment, RoadGeometry c
   Junction const & to = road.GetJunction(segment.GetPointId(true /* front */));
   VehicleModelInterface::SpeedKMpH const & speed = road.GetSpeed();
 
-  double const distance = MercatorBounds::DistanceOnEarth(from.GetPoint(), to.GetPoint());
+  double const distance = road.GetSegmentLength(segment.GetSegmentIdx());
   double const speedMpS = KMPH2MPS(purpose == Purpose::Weight ? speed.m_weight : speed.m_eta);
   CHECK_GREATER(speedMpS, 0.0, ());
   double const timeSec = distance / speedMpS;
@@ -169,6 +170,8 @@ public:
   // EdgeEstimator overrides:
   double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road) const override;
   double CalcSegmentETA(Segment const & segment, RoadGeometry const & road) const override;
+  double CalcSegmentWeightWithProfile(Segment const & segment, RoadGeometry const & road,
+                                      uint8_t speedPercent) const override;
   double GetUTurnPenalty() const override;
   bool LeapIsAllowed(NumMwmId mwmId) const override;
 
@@ -193,6 +196,16 @@ double CarEstimator::CalcSegmentETA(Segment const & segment, RoadGeometry const
   return CalcSegment(Purpose::ETA, segment, road);
 }
 
+double CarEstimator::CalcSegmentWeightWithProfile(Segment const & segment,
+                                                  RoadGeometry const & road,
+                                                  uint8_t speedPercent) const
+{
+  // Speed profiles are statistics of the traffic, so the current traffic is not applied.
+  CHECK_GREATER(speedPercent, 0, ());
+  return CalcClimbSegment(Purpose::Weight, segment, road, GetCarClimbPenalty) *
+         static_cast<double>(SpeedProfiles::kFreeFlowSpeedPercent) / speedPercent;
+}
+
 double CarEstimator::GetUTurnPenalty() const
 {
   // Adds 2 minutes penalty for U-turn. The value is quite arbitrary
@@ -205,28 +218,34 @@ bool CarEstimator::LeapIsAllowed(NumMwmId mwmId) const { return !m_trafficStash-
 
 double CarEstimator::CalcSegment(Purpose purpose, Segment const & segment, RoadGeometry const & road) const
 {
-  // Current time estimation are too optimistic.
-  // Need more accurate tuning: traffic lights, traffic jams, road models and so on.
-  // Add some penalty to make estimation of a more realistic.
-  // TODO: make accurate tuning, remove penalty.
-  double constexpr kTimePenalty = 1.8;
-
   double result = CalcClimbSegment(purpose, segment, road, GetCarClimbPenalty);
 
   if (m_trafficStash)
   {
     SpeedGroup const speedGroup = m_trafficStash->GetSpeedGroup(segment);
     ASSERT_LESS(speedGroup, SpeedGroup::Count, ());
-    double const trafficFactor = CalcTrafficFactor(speedGroup);
-    result *= trafficFactor;
-    if (speedGroup != SpeedGroup::Unknown && speedGroup != SpeedGroup::G5)
-      result *= kTimePenalty;
+    result *= CalcCarTrafficFactor(speedGroup);
   }
 
   return result;
 }
 
 // EdgeEstimator -----------------------------------------------------------------------------------
+// static
+double EdgeEstimator::CalcCarTrafficFactor(SpeedGroup speedGroup)
+{
+  // Current time estimation are too optimistic.
+  // Need more accurate tuning: traffic lights, traffic jams, road models and so on.
+  // Add some penalty to make estimation of a more realistic.
+  // TODO: make accurate tuning, remove penalty.
+  double constexpr kTimePenalty = 1.8;
+
+  double const trafficFactor = CalcTrafficFactor(speedGroup);
+  if (speedGroup != SpeedGroup::Unknown && speedGroup != SpeedGroup::G5)
+    return trafficFactor * kTimePenalty;
+  return trafficFactor;
+}
+
 // static
 shared_ptr<EdgeEstimator> EdgeEstimator::Create(VehicleType vehicleType, double maxWeighSpeedKMpH,
                                                 double offroadSpeedKMpH,
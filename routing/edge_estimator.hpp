@@ -5,6 +5,7 @@
 #include "routing/traffic_stash.hpp"
 #include "routing/vehicle_mask.hpp"
 
+#include "traffic/speed_groups.hpp"
 #include "traffic/traffic_cache.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
@@ -14,6 +15,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <cstdint>
 #include <memory>
 
 namespace routing
@@ -39,12 +41,24 @@ public:
 
   virtual double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road) const = 0;
   virtual double CalcSegmentETA(Segment const & segment, RoadGeometry const & road) const = 0;
+  // Estimates time in seconds it takes to go along |segment| when its speed is |speedPercent|
+  // percents of free flow speed according to a speed profile (see SpeedProfiles).
+  // Unless an estimator takes traffic into account the weight doesn't depend on speed profiles.
+  virtual double CalcSegmentWeightWithProfile(Segment const & segment, RoadGeometry const & road,
+                                              uint8_t /* speedPercent */) const
+  {
+    return CalcSegmentWeight(segment, road);
+  }
   virtual double GetUTurnPenalty() const = 0;
   // The leap is the shortcut edge from mwm border enter to exit.
   // Router can't use leaps on some mwms: e.g. mwm with loaded traffic data.
   // Check wherether leap is allowed on specified mwm or not.
   virtual bool LeapIsAllowed(NumMwmId mwmId) const = 0;
 
+  // Returns how many times the car weight of a segment with |speedGroup| traffic is greater
+  // than the weight of the segment without traffic.
+  static double CalcCarTrafficFactor(traffic::SpeedGroup speedGroup);
+
   static std::shared_ptr<EdgeEstimator> Create(VehicleType vehicleType, double maxWeighSpeedKMpH,
                                                double offroadSpeedKMpH,
                                                std::shared_ptr<TrafficStash>);
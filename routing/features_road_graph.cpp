@@ -192,6 +192,22 @@ void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t coun
   finder.MakeResult(vicinities, count);
 }
 
+void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, MwmSet::MwmId const & mwmId,
+                                         uint32_t count,
+                                         vector<pair<Edge, Junction>> & vicinities) const
+{
+  NearestEdgeFinder finder(point);
+
+  GetSegmentIndex(mwmId).ForEachInRect(
+      MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters),
+      [&](RoadSegmentIndex::RoadSegment const & segment) {
+        finder.AddSegment(FeatureID(mwmId, segment.m_featureId), segment.m_segId,
+                          segment.m_start, segment.m_end, segment.m_bidirectional);
+      });
+
+  finder.MakeResult(vicinities, count);
+}
+
 void FeaturesRoadGraph::GetFeatureTypes(FeatureID const & featureId, feature::TypesHolder & types) const
 {
   FeatureType ft;
@@ -238,6 +254,7 @@ void FeaturesRoadGraph::ClearState()
   m_cache.Clear();
   m_vehicleModel.Clear();
   m_mwmLocks.clear();
+  m_segmentIndices.clear();
 }
 
 bool FeaturesRoadGraph::IsRoad(FeatureType & ft) const { return m_vehicleModel.IsRoad(ft); }
@@ -331,4 +348,45 @@ FeaturesRoadGraph::Value const & FeaturesRoadGraph::LockMwm(MwmSet::MwmId const
   return m_mwmLocks.insert(make_pair(move(mwmId), Value(m_dataSource, m_dataSource.GetMwmHandleById(mwmId))))
       .first->second;
 }
+
+RoadSegmentIndex & FeaturesRoadGraph::GetSegmentIndex(MwmSet::MwmId const & mwmId) const
+{
+  ASSERT(mwmId.IsAlive(), ());
+
+  auto const itr = m_segmentIndices.find(mwmId);
+  if (itr != m_segmentIndices.end())
+    return itr->second;
+
+  // Indices of deregistered mwms are not needed anymore.
+  for (auto it = m_segmentIndices.begin(); it != m_segmentIndices.end();)
+    it = it->first.IsAlive() ? next(it) : m_segmentIndices.erase(it);
+
+  auto const loadCell = [this, mwmId](m2::RectD const & rect,
+                                      vector<RoadSegmentIndex::RoadSegment> & segments) {
+    auto const f = [&](FeatureType & ft) {
+      if (!IsRoad(ft))
+        return;
+
+      auto constexpr invalidSpeed = numeric_limits<double>::max();
+      RoadInfo const & roadInfo = GetCachedRoadInfo(ft.GetID(), ft, invalidSpeed);
+      auto const & junctions = roadInfo.m_junctions;
+      for (size_t i = 1; i < junctions.size(); ++i)
+      {
+        if (!rect.IsIntersect(m2::RectD(junctions[i - 1].GetPoint(), junctions[i].GetPoint())))
+          continue;
+
+        RoadSegmentIndex::RoadSegment segment;
+        segment.m_featureId = ft.GetID().m_index;
+        segment.m_segId = static_cast<uint32_t>(i - 1);
+        segment.m_start = junctions[i - 1];
+        segment.m_end = junctions[i];
+        segment.m_bidirectional = roadInfo.m_bidirectional;
+        segments.push_back(segment);
+      }
+    };
+    m_dataSource.ForEachInRectForMWM(f, rect, GetStreetReadScale(), mwmId);
+  };
+
+  return m_segmentIndices.emplace(mwmId, RoadSegmentIndex(loadCell)).first->second;
+}
 }  // namespace routing
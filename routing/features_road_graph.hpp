@@ -1,6 +1,7 @@
 #pragma once
 
 #include "routing/road_graph.hpp"
+#include "routing/road_segment_index.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -82,6 +83,12 @@ public:
 
   bool IsRoad(FeatureType & ft) const;
 
+  /// \brief Finds the closest edges of roads of |mwmId| like FindClosestEdges() does. Segments of
+  /// the roads are kept in a grid index of the mwm which is built lazily, so features are loaded
+  /// only for the first query of a place. Roads of the grid cells around |point| are considered.
+  void FindClosestEdges(m2::PointD const & point, MwmSet::MwmId const & mwmId, uint32_t count,
+                        vector<pair<Edge, Junction>> & vicinities) const;
+
 private:
   friend class CrossFeaturesLoader;
 
@@ -110,12 +117,14 @@ private:
                        RoadInfo & ri) const;
 
   Value const & LockMwm(MwmSet::MwmId const & mwmId) const;
+  RoadSegmentIndex & GetSegmentIndex(MwmSet::MwmId const & mwmId) const;
 
   DataSource const & m_dataSource;
   IRoadGraph::Mode const m_mode;
   mutable RoadInfoCache m_cache;
   mutable CrossCountryVehicleModel m_vehicleModel;
   mutable map<MwmSet::MwmId, Value> m_mwmLocks;
+  mutable map<MwmSet::MwmId, RoadSegmentIndex> m_segmentIndices;
 };
 
 // @returns a distance d such as that for a given point p any edge
@@ -9,6 +9,9 @@
 #include "geometry/mercator.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
 
 #include <algorithm>
 #include <string>
@@ -33,7 +36,26 @@ public:
   // GeometryLoader overrides:
   void Load(uint32_t featureId, RoadGeometry & road) override;
 
+  // Calls |fn| for geometry of every road of the mwm in increasing order of feature ids.
+  template <typename Fn>
+  void ForEachRoad(Fn && fn)
+  {
+    RoadGeometry road;
+    size_t const numFeatures = m_guard.GetNumFeatures();
+    for (uint32_t featureId = 0; featureId < numFeatures; ++featureId)
+    {
+      FeatureType feature;
+      if (!m_guard.GetFeatureByIndex(featureId, feature) || !m_vehicleModel->IsRoad(feature))
+        continue;
+
+      Load(featureId, feature, road);
+      fn(featureId, road);
+    }
+  }
+
 private:
+  void Load(uint32_t featureId, FeatureType & feature, RoadGeometry & road);
+
   shared_ptr<VehicleModelInterface> m_vehicleModel;
   unique_ptr<CityRoads> m_cityRoads;
   FeaturesLoaderGuard m_guard;
@@ -65,6 +87,11 @@ void GeometryLoaderImpl::Load(uint32_t featureId, RoadGeometry & road)
   if (!isFound)
     MYTHROW(RoutingException, ("Feature", featureId, "not found in ", m_country));
 
+  Load(featureId, feature, road);
+}
+
+void GeometryLoaderImpl::Load(uint32_t featureId, FeatureType & feature, RoadGeometry & road)
+{
   feature.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
   feature::TAltitudes const * altitudes = nullptr;
@@ -115,6 +142,8 @@ void FileGeometryLoader::Load(uint32_t featureId, RoadGeometry & road)
 
 namespace routing
 {
+size_t constexpr Geometry::kRoadViewsCount;
+
 // RoadGeometry ------------------------------------------------------------------------------------
 RoadGeometry::RoadGeometry(bool oneWay, double weightSpeedKMpH, double etaSpeedKMpH,
                            Points const & points)
@@ -126,6 +155,7 @@ RoadGeometry::RoadGeometry(bool oneWay, double weightSpeedKMpH, double etaSpeedK
   m_junctions.reserve(points.size());
   for (auto const & point : points)
     m_junctions.emplace_back(point, feature::kDefaultAltitudeMeters);
+  FillSegmentLengths();
 }
 
 void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType & feature,
@@ -133,6 +163,9 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
 {
   CHECK(altitudes == nullptr || altitudes->size() == feature.GetPointsCount(), ());
 
+  m_sharedJunctions = nullptr;
+  m_sharedSegmentLengths = nullptr;
+  m_sharedPointsCount = 0;
   m_valid = vehicleModel.IsRoad(feature);
   m_isOneWay = vehicleModel.IsOneWay(feature);
   m_speed = vehicleModel.GetSpeed(feature, inCity);
@@ -145,6 +178,7 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
     m_junctions.emplace_back(feature.GetPoint(i),
                              altitudes ? (*altitudes)[i] : feature::kDefaultAltitudeMeters);
   }
+  FillSegmentLengths();
 
   if (m_valid && m_speed.m_weight <= 0.0)
   {
@@ -158,6 +192,115 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
   }
 }
 
+void RoadGeometry::FillSegmentLengths()
+{
+  buffer_vector<m2::PointD, 32> points;
+  points.reserve(m_junctions.size());
+  for (auto const & junction : m_junctions)
+    points.push_back(junction.GetPoint());
+
+  m_segmentLengths.resize(points.empty() ? 0 : points.size() - 1);
+  MercatorBounds::DistanceOnEarth(points.data(), points.data() + 1, m_segmentLengths.size(),
+                                  m_segmentLengths.data());
+}
+
+// RoadGeometryStorage -----------------------------------------------------------------------------
+void RoadGeometryStorage::AddRoad(uint32_t featureId, RoadGeometry const & road)
+{
+  CHECK_GREATER_OR_EQUAL(featureId, GetNumFeatures(),
+                         ("Features should be added in increasing order of ids."));
+
+  // Skipped features are invalid roads without junctions.
+  m_offsets.resize(featureId + 1, m_offsets.back());
+  m_speeds.resize(featureId);
+  m_flags.resize(featureId, 0);
+
+  for (uint32_t i = 0; i < road.GetPointsCount(); ++i)
+  {
+    m_junctions.push_back(road.GetJunction(i));
+    m_segmentLengths.push_back(i + 1 < road.GetPointsCount() ? road.GetSegmentLength(i) : 0.0);
+  }
+
+  m_offsets.push_back(base::checked_cast<uint32_t>(m_junctions.size()));
+  m_speeds.push_back(road.GetSpeed());
+  m_flags.push_back((road.IsValid() ? kValid : 0) | (road.IsOneWay() ? kOneWay : 0) |
+                    (road.IsPassThroughAllowed() ? kPassThroughAllowed : 0));
+}
+
+void RoadGeometryStorage::GetRoad(uint32_t featureId, RoadGeometry & road) const
+{
+  road.m_junctions.clear();
+  road.m_segmentLengths.clear();
+  if (featureId >= GetNumFeatures())
+  {
+    // The feature is not a road.
+    road.m_sharedJunctions = nullptr;
+    road.m_sharedSegmentLengths = nullptr;
+    road.m_sharedPointsCount = 0;
+    road.m_speed = {};
+    road.m_isOneWay = false;
+    road.m_valid = false;
+    road.m_isPassThroughAllowed = false;
+    return;
+  }
+
+  uint32_t const begin = m_offsets[featureId];
+  road.m_sharedJunctions = m_junctions.data() + begin;
+  road.m_sharedSegmentLengths = m_segmentLengths.data() + begin;
+  road.m_sharedPointsCount = m_offsets[featureId + 1] - begin;
+  road.m_speed = m_speeds[featureId];
+  uint8_t const flags = m_flags[featureId];
+  road.m_isOneWay = (flags & kOneWay) != 0;
+  road.m_valid = (flags & kValid) != 0;
+  road.m_isPassThroughAllowed = (flags & kPassThroughAllowed) != 0;
+}
+
+// static
+unique_ptr<RoadGeometryStorage> RoadGeometryStorage::Create(
+    DataSource const & dataSource, MwmSet::MwmHandle const & handle,
+    shared_ptr<VehicleModelInterface> vehicleModel, unique_ptr<CityRoads> cityRoads,
+    bool loadAltitudes)
+{
+  CHECK(handle.IsAlive(), ());
+  base::Timer timer;
+  GeometryLoaderImpl loader(dataSource, handle, vehicleModel, move(cityRoads), loadAltitudes);
+
+  auto storage = make_unique<RoadGeometryStorage>();
+  loader.ForEachRoad([&storage](uint32_t featureId, RoadGeometry const & road) {
+    storage->AddRoad(featureId, road);
+  });
+
+  storage->m_offsets.shrink_to_fit();
+  storage->m_junctions.shrink_to_fit();
+  storage->m_segmentLengths.shrink_to_fit();
+  storage->m_speeds.shrink_to_fit();
+  storage->m_flags.shrink_to_fit();
+  LOG(LINFO, ("Road geometry of", handle.GetInfo()->GetCountryName(), "is decoded in",
+              timer.ElapsedSeconds(), "seconds. Roads:", storage->GetNumFeatures(),
+              "junctions:", storage->GetNumJunctions()));
+  return storage;
+}
+
+// SharedRoadGeometry ------------------------------------------------------------------------------
+shared_ptr<RoadGeometryStorage const> SharedRoadGeometry::GetStorage(MwmSet::MwmId const & mwmId,
+                                                                     StorageCreator const & create)
+{
+  // Storage is created under the lock so geometry of an mwm is never decoded twice.
+  lock_guard<mutex> lock(m_mutex);
+  auto & storage = m_storages[mwmId];
+  if (!storage)
+    storage = create();
+
+  CHECK(storage, (mwmId));
+  return storage;
+}
+
+void SharedRoadGeometry::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_storages.clear();
+}
+
 // Geometry ----------------------------------------------------------------------------------------
 Geometry::Geometry(unique_ptr<GeometryLoader> loader)
     : m_loader(move(loader))
@@ -168,8 +311,22 @@ Geometry::Geometry(unique_ptr<GeometryLoader> loader)
   CHECK(m_loader, ());
 }
 
+Geometry::Geometry(shared_ptr<RoadGeometryStorage const> storage)
+  : m_storage(move(storage)), m_roadViews(kRoadViewsCount)
+{
+  CHECK(m_storage, ());
+}
+
 RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
+  if (m_storage)
+  {
+    RoadGeometry & road = m_roadViews[m_nextRoadView];
+    m_nextRoadView = (m_nextRoadView + 1) % kRoadViewsCount;
+    m_storage->GetRoad(featureId, road);
+    return road;
+  }
+
   ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
@@ -7,20 +7,28 @@
 #include "routing_common/vehicle_model.hpp"
 
 #include "indexer/feature_altitude.hpp"
+#include "indexer/mwm_set.hpp"
 
 #include "geometry/point2d.hpp"
 
 #include "base/buffer_vector.hpp"
 #include "base/fifo_cache.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 class DataSource;
 
 namespace routing
 {
+class RoadGeometryStorage;
+
 class RoadGeometry final
 {
 public:
@@ -38,13 +46,26 @@ public:
 
   Junction const & GetJunction(uint32_t junctionId) const
   {
-    ASSERT_LESS(junctionId, m_junctions.size(), ());
-    return m_junctions[junctionId];
+    ASSERT_LESS(junctionId, GetPointsCount(), ());
+    return m_sharedJunctions != nullptr ? m_sharedJunctions[junctionId] : m_junctions[junctionId];
   }
 
   m2::PointD const & GetPoint(uint32_t pointId) const { return GetJunction(pointId).GetPoint(); }
 
-  uint32_t GetPointsCount() const { return static_cast<uint32_t>(m_junctions.size()); }
+  /// \returns length in meters of the segment between points |segmentIdx| and |segmentIdx| + 1.
+  /// \note Lengths of all the segments are computed by a batch when the road is loaded.
+  double GetSegmentLength(uint32_t segmentIdx) const
+  {
+    ASSERT_LESS(segmentIdx + 1, GetPointsCount(), ());
+    return m_sharedSegmentLengths != nullptr ? m_sharedSegmentLengths[segmentIdx]
+                                             : m_segmentLengths[segmentIdx];
+  }
+
+  uint32_t GetPointsCount() const
+  {
+    return m_sharedJunctions != nullptr ? m_sharedPointsCount
+                                        : static_cast<uint32_t>(m_junctions.size());
+  }
 
   // Note. It's possible that car_model was changed after the map was built.
   // For example, the map from 12.2016 contained highway=pedestrian
@@ -54,7 +75,7 @@ public:
 
   bool IsEndPointId(uint32_t pointId) const
   {
-    ASSERT_LESS(pointId, m_junctions.size(), ());
+    ASSERT_LESS(pointId, GetPointsCount(), ());
     return pointId == 0 || pointId + 1 == GetPointsCount();
   }
 
@@ -64,7 +85,17 @@ public:
   }
 
 private:
+  friend class RoadGeometryStorage;
+
+  void FillSegmentLengths();
+
   buffer_vector<Junction, 32> m_junctions;
+  buffer_vector<double, 32> m_segmentLengths;
+  // If the road is a view of RoadGeometryStorage, junctions and segment lengths are kept
+  // by the storage and |m_junctions| and |m_segmentLengths| are empty.
+  Junction const * m_sharedJunctions = nullptr;
+  double const * m_sharedSegmentLengths = nullptr;
+  uint32_t m_sharedPointsCount = 0;
   VehicleModelInterface::SpeedKMpH m_speed;
   bool m_isOneWay = false;
   bool m_valid = false;
@@ -91,16 +122,86 @@ public:
       std::string const & fileName, std::shared_ptr<VehicleModelInterface> vehicleModel);
 };
 
+/// \brief Read-only geometry of all the roads of an mwm which is decoded at once.
+/// Roads are kept in structure-of-arrays layout: junctions of all the roads are stored
+/// in one contiguous vector and attributes of the roads are stored in per-feature vectors.
+/// The storage is not changed after it's filled so it may be shared by Geometry instances
+/// of several threads without any synchronization.
+class RoadGeometryStorage final
+{
+public:
+  /// \brief Adds |road| as the geometry of feature |featureId|.
+  /// \note Features should be added in increasing order of ids. Skipped features are kept
+  /// as invalid roads.
+  void AddRoad(uint32_t featureId, RoadGeometry const & road);
+
+  /// \brief Fills |road| with a view of the geometry of feature |featureId|. The view
+  /// doesn't own junctions and it's valid while the storage is alive.
+  void GetRoad(uint32_t featureId, RoadGeometry & road) const;
+
+  uint32_t GetNumFeatures() const { return static_cast<uint32_t>(m_speeds.size()); }
+  size_t GetNumJunctions() const { return m_junctions.size(); }
+
+  // handle should be alive: it is caller responsibility to check it.
+  static std::unique_ptr<RoadGeometryStorage> Create(
+      DataSource const & dataSource, MwmSet::MwmHandle const & handle,
+      std::shared_ptr<VehicleModelInterface> vehicleModel, std::unique_ptr<CityRoads> cityRoads,
+      bool loadAltitudes);
+
+private:
+  enum Flags : uint8_t
+  {
+    kValid = 1 << 0,
+    kOneWay = 1 << 1,
+    kPassThroughAllowed = 1 << 2,
+  };
+
+  // Junctions of feature |featureId| are m_junctions[m_offsets[featureId]]
+  // ... m_junctions[m_offsets[featureId + 1] - 1].
+  std::vector<uint32_t> m_offsets = {0};
+  std::vector<Junction> m_junctions;
+  // Length of the segment which starts at m_junctions[i], it's zero for the last junctions
+  // of the features.
+  std::vector<double> m_segmentLengths;
+  std::vector<VehicleModelInterface::SpeedKMpH> m_speeds;
+  std::vector<uint8_t> m_flags;
+};
+
+/// \brief Thread-safe collection of road geometry storages of several mwms.
+/// Geometry of an mwm is decoded once and shared by all the IndexGraphLoader instances
+/// which use the collection. So all of them should use the same vehicle models and
+/// the same altitudes loading option.
+class SharedRoadGeometry final
+{
+public:
+  using StorageCreator = std::function<std::unique_ptr<RoadGeometryStorage>()>;
+
+  /// \returns storage of |mwmId|. The storage is created with |create| if it's the first
+  /// request for |mwmId|.
+  std::shared_ptr<RoadGeometryStorage const> GetStorage(MwmSet::MwmId const & mwmId,
+                                                        StorageCreator const & create);
+  void Clear();
+
+private:
+  std::mutex m_mutex;
+  std::map<MwmSet::MwmId, std::shared_ptr<RoadGeometryStorage const>> m_storages;
+};
+
 /// \brief This class supports loading geometry of roads for routing.
 /// \note Loaded information about road geometry is kept in a fixed-size cache |m_featureIdToRoad|.
 /// On the other hand methods GetRoad() and GetPoint() return geometry information by reference.
 /// The reference may be invalid after the next call of GetRoad() or GetPoint() because the cache
 /// item which is referred by returned reference may be evicted. It's done for performance reasons.
+/// If Geometry is created with RoadGeometryStorage no geometry is loaded and no cache is used:
+/// GetRoad() returns views of the storage roads. Views returned by kRoadViewsCount last calls
+/// of GetRoad() are kept alive, so the references are valid for a while like references to
+/// the cache items.
 class Geometry final
 {
 public:
   Geometry() = default;
   explicit Geometry(std::unique_ptr<GeometryLoader> loader);
+  explicit Geometry(std::shared_ptr<RoadGeometryStorage const> storage);
 
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
@@ -114,7 +215,13 @@ public:
   }
 
 private:
+  static size_t constexpr kRoadViewsCount = 64;
+
   std::unique_ptr<GeometryLoader> m_loader;
   std::unique_ptr<FifoCache<uint32_t, RoadGeometry>> m_featureIdToRoad;
+
+  std::shared_ptr<RoadGeometryStorage const> m_storage;
+  std::vector<RoadGeometry> m_roadViews;
+  size_t m_nextRoadView = 0;
 };
 }  // namespace routing
@@ -21,14 +21,22 @@ bool IsUTurn(Segment const & u, Segment const & v)
          u.IsForward() != v.IsForward();
 }
 
-bool IsRestricted(RestrictionVec const & restrictions, Segment const & u, Segment const & v,
+uint64_t GetRestrictionKey(uint32_t featureIdFrom, uint32_t featureIdTo)
+{
+  return (static_cast<uint64_t>(featureIdFrom) << 32) + featureIdTo;
+}
+
+bool IsRestricted(vector<uint64_t> const & restrictions, Segment const & u, Segment const & v,
                   bool isOutgoing)
 {
+  if (restrictions.empty())
+    return false;
+
   uint32_t const featureIdFrom = isOutgoing ? u.GetFeatureId() : v.GetFeatureId();
   uint32_t const featureIdTo = isOutgoing ? v.GetFeatureId() : u.GetFeatureId();
 
   if (!binary_search(restrictions.cbegin(), restrictions.cend(),
-                     Restriction(Restriction::Type::No, {featureIdFrom, featureIdTo})))
+                     GetRestrictionKey(featureIdFrom, featureIdTo)))
   {
     return false;
   }
@@ -83,6 +91,7 @@ void IndexGraph::GetEdgeList(Segment const & segment, bool isOutgoing, vector<Se
 
 void IndexGraph::Build(uint32_t numJoints)
 {
+  m_roadIndex.Build();
   m_jointIndex.Build(m_roadIndex, numJoints);
 }
 
@@ -96,7 +105,20 @@ void IndexGraph::Import(vector<Joint> const & joints)
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
   ASSERT(is_sorted(restrictions.cbegin(), restrictions.cend()), ());
-  m_restrictions = move(restrictions);
+  m_restrictions.clear();
+  for (Restriction const & restriction : restrictions)
+  {
+    // Only restrictions of type No between two features are checked, see IsRestricted().
+    if (restriction.m_type != Restriction::Type::No || restriction.m_featureIds.size() != 2)
+      continue;
+
+    m_restrictions.push_back(
+        GetRestrictionKey(restriction.m_featureIds[0], restriction.m_featureIds[1]));
+  }
+  // Restrictions of one type are sorted by their feature ids lexicographically.
+  ASSERT(is_sorted(m_restrictions.cbegin(), m_restrictions.cend()), ());
+  m_restrictions.shrink_to_fit();
+  restrictions.clear();
 }
 
 void IndexGraph::SetRoadAccess(RoadAccess && roadAccess) { m_roadAccess = move(roadAccess); }
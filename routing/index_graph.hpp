@@ -10,6 +10,8 @@
 #include "routing/road_point.hpp"
 #include "routing/segment.hpp"
 
+#include "coding/memory_region.hpp"
+
 #include "geometry/point2d.hpp"
 
 #include "std/cstdint.hpp"
@@ -27,6 +29,7 @@ public:
   using Vertex = Segment;
   using Edge = SegmentEdge;
   using Weight = RouteWeight;
+  using VertexHasher = Segment::Hash;
 
   IndexGraph() = default;
   IndexGraph(shared_ptr<Geometry> geometry, shared_ptr<EdgeEstimator> estimator);
@@ -38,7 +41,7 @@ public:
 
   Geometry & GetGeometry() { return *m_geometry; }
   bool IsRoad(uint32_t featureId) const { return m_roadIndex.IsRoad(featureId); }
-  RoadJointIds const & GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
+  RoadJointIds GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
 
   RoadAccess::Type GetAccessType(Segment const & segment) const
   {
@@ -52,6 +55,15 @@ public:
   void Build(uint32_t numJoints);
   void Import(vector<Joint> const & joints);
 
+  // Road and joint indexes may be mapped from memory instead of building.
+  // The graph keeps |region| alive while the indexes refer to it.
+  template <typename Visitor>
+  void map(Visitor & visitor)
+  {
+    visitor(m_roadIndex, "roadIndex")(m_jointIndex, "jointIndex");
+  }
+  void SetMappedRegion(unique_ptr<MemoryRegion> && region) { m_mappedRegion = move(region); }
+
   void SetRestrictions(RestrictionVec && restrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
 
@@ -93,7 +105,11 @@ private:
   shared_ptr<EdgeEstimator> m_estimator;
   RoadIndex m_roadIndex;
   JointIndex m_jointIndex;
-  RestrictionVec m_restrictions;
+  // Memory of mapped |m_roadIndex| and |m_jointIndex|. May be nullptr.
+  unique_ptr<MemoryRegion> m_mappedRegion;
+  // Restrictions of type No between two features. Feature ids of a restriction are packed
+  // to one key, see SetRestrictions(). Sorted.
+  vector<uint64_t> m_restrictions;
   RoadAccess m_roadAccess;
 };
 }  // namespace routing
@@ -2,6 +2,7 @@
 
 #include "routing/city_roads.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/mapped_index_graph_serialization.hpp"
 #include "routing/restriction_loader.hpp"
 #include "routing/road_access_serialization.hpp"
 #include "routing/route.hpp"
@@ -11,6 +12,7 @@
 #include "indexer/data_source.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/memory_region.hpp"
 
 #include "base/assert.hpp"
 #include "base/timer.hpp"
@@ -29,12 +31,15 @@ class IndexGraphLoaderImpl final : public IndexGraphLoader
 public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
                        shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-                       shared_ptr<EdgeEstimator> estimator, DataSource & dataSource);
+                       shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
+                       shared_ptr<SharedRoadGeometry> sharedGeometry);
 
   // IndexGraphLoader overrides:
   Geometry & GetGeometry(NumMwmId numMwmId) override;
   IndexGraph & GetIndexGraph(NumMwmId numMwmId) override;
   vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) override;
+  Landmarks const * GetLandmarks(NumMwmId numMwmId) override;
+  SpeedProfiles const * GetSpeedProfiles(NumMwmId numMwmId) override;
   void Clear() override;
 
 private:
@@ -53,8 +58,16 @@ private:
   shared_ptr<NumMwmIds> m_numMwmIds;
   shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
   shared_ptr<EdgeEstimator> m_estimator;
+  // May be nullptr.
+  shared_ptr<SharedRoadGeometry> m_sharedGeometry;
 
   unordered_map<NumMwmId, GraphAttrs> m_graphs;
+  // Landmarks are not removed by Clear() because they are needed by all the leaps of a route.
+  // Value is nullptr if mwm has no suitable landmarks.
+  unordered_map<NumMwmId, unique_ptr<Landmarks>> m_landmarks;
+  // Speed profiles are not removed by Clear() as landmarks. Value is nullptr if mwm has no
+  // speed profiles.
+  unordered_map<NumMwmId, unique_ptr<SpeedProfiles>> m_speedProfiles;
 
   // TODO (@gmoryes) move this field to |GeometryIndexGraph| after @bykoianko PR
   unordered_map<NumMwmId, map<SegmentCoord, vector<RouteSegment::SpeedCamera>>> m_cachedCameras;
@@ -64,13 +77,15 @@ private:
 IndexGraphLoaderImpl::IndexGraphLoaderImpl(
     VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-    shared_ptr<EdgeEstimator> estimator, DataSource & dataSource)
+    shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
+    shared_ptr<SharedRoadGeometry> sharedGeometry)
   : m_vehicleType(vehicleType)
   , m_loadAltitudes(loadAltitudes)
   , m_dataSource(dataSource)
   , m_numMwmIds(numMwmIds)
   , m_vehicleModelFactory(vehicleModelFactory)
   , m_estimator(estimator)
+  , m_sharedGeometry(move(sharedGeometry))
 {
   CHECK(m_numMwmIds, ());
   CHECK(m_vehicleModelFactory, ());
@@ -173,6 +188,83 @@ vector<RouteSegment::SpeedCamera> IndexGraphLoaderImpl::GetSpeedCameraInfo(Segme
   return cameras;
 }
 
+Landmarks const * IndexGraphLoaderImpl::GetLandmarks(NumMwmId numMwmId)
+{
+  auto const it = m_landmarks.find(numMwmId);
+  if (it != m_landmarks.end())
+    return it->second.get();
+
+  auto & landmarks = m_landmarks[numMwmId];
+
+  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
+  MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+
+  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
+  if (!mwmValue.m_cont.IsExist(LANDMARKS_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    base::Timer timer;
+    auto reader = mwmValue.m_cont.GetReader(LANDMARKS_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    landmarks = make_unique<Landmarks>();
+    landmarks->Deserialize(src);
+    LOG(LINFO, (LANDMARKS_FILE_TAG, "section for", file.GetName(), "loaded in",
+                timer.ElapsedSeconds(), "seconds"));
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", LANDMARKS_FILE_TAG, "section.", e.Msg()));
+    landmarks.reset();
+    return nullptr;
+  }
+
+  if (landmarks->GetVehicleType() != m_vehicleType || landmarks->IsEmpty())
+    landmarks.reset();
+
+  return landmarks.get();
+}
+
+SpeedProfiles const * IndexGraphLoaderImpl::GetSpeedProfiles(NumMwmId numMwmId)
+{
+  auto const it = m_speedProfiles.find(numMwmId);
+  if (it != m_speedProfiles.end())
+    return it->second.get();
+
+  auto & speedProfiles = m_speedProfiles[numMwmId];
+
+  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
+  MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+
+  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
+  if (!mwmValue.m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    auto reader = mwmValue.m_cont.GetReader(SPEED_PROFILES_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    speedProfiles = make_unique<SpeedProfiles>();
+    speedProfiles->Deserialize(src);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", SPEED_PROFILES_FILE_TAG, "section.", e.Msg()));
+    speedProfiles.reset();
+    return nullptr;
+  }
+
+  if (speedProfiles->IsEmpty())
+    speedProfiles.reset();
+
+  return speedProfiles.get();
+}
+
 IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateGeometry(NumMwmId numMwmId)
 {
   platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
@@ -184,6 +276,15 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateGeometry(NumMwmId
       m_vehicleModelFactory->GetVehicleModelForCountry(file.GetName());
 
   auto & graph = m_graphs[numMwmId];
+  if (m_sharedGeometry)
+  {
+    graph.m_geometry = make_shared<Geometry>(m_sharedGeometry->GetStorage(handle.GetId(), [&]() {
+      return RoadGeometryStorage::Create(m_dataSource, handle, vehicleModel,
+                                         LoadCityRoads(m_dataSource, handle), m_loadAltitudes);
+    }));
+    return graph;
+  }
+
   graph.m_geometry = make_shared<Geometry>(GeometryLoader::Create(
       m_dataSource, handle, vehicleModel, LoadCityRoads(m_dataSource, handle), m_loadAltitudes));
   return graph;
@@ -209,6 +310,32 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateIndexGraph(
 
 void IndexGraphLoaderImpl::Clear() { m_graphs.clear(); }
 
+// Maps road and joint indexes of |graph| from ROUTING_MAPPED_FILE_TAG section if the mwm has it.
+bool MapIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
+{
+  if (!mwmValue.m_cont.IsExist(ROUTING_MAPPED_FILE_TAG))
+    return false;
+
+  unique_ptr<MemoryRegion> region;
+  try
+  {
+    FilesMappingContainer const cont(mwmValue.m_cont.GetFileName());
+    region = make_unique<MappedMemoryRegion>(cont.Map(ROUTING_MAPPED_FILE_TAG));
+  }
+  catch (Reader::Exception const & e)
+  {
+    // The mwm can't be mapped (e.g. it's not a plain file). Copying of the section
+    // is still much faster than decoding of ROUTING_FILE_TAG section.
+    LOG(LWARNING, ("Can't map", ROUTING_MAPPED_FILE_TAG, "section.", e.Msg()));
+    auto const reader = mwmValue.m_cont.GetReader(ROUTING_MAPPED_FILE_TAG);
+    vector<uint8_t> buffer(static_cast<size_t>(reader.Size()));
+    reader.Read(0 /* pos */, buffer.data(), buffer.size());
+    region = make_unique<CopiedMemoryRegion>(move(buffer));
+  }
+
+  return MappedIndexGraphSerializer::Deserialize(move(region), vehicleType, graph);
+}
+
 bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType,
                            RoadAccess & roadAccess)
 {
@@ -237,17 +364,22 @@ namespace routing
 unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
     VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-    shared_ptr<EdgeEstimator> estimator, DataSource & dataSource)
+    shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
+    shared_ptr<SharedRoadGeometry> sharedGeometry)
 {
   return make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, numMwmIds, vehicleModelFactory,
-                                           estimator, dataSource);
+                                           estimator, dataSource, move(sharedGeometry));
 }
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
 {
-  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
-  ReaderSource<FilesContainerR::TReader> src(reader);
-  IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+  if (!MapIndexGraph(mwmValue, vehicleType, graph))
+  {
+    FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+  }
+
   RestrictionLoader restrictionLoader(mwmValue, graph);
   if (restrictionLoader.HasRestrictions())
     graph.SetRestrictions(restrictionLoader.StealRestrictions());
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "routing/edge_estimator.hpp"
+#include "routing/geometry.hpp"
 #include "routing/index_graph.hpp"
+#include "routing/landmarks.hpp"
 #include "routing/route.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
@@ -26,12 +29,21 @@ public:
 
   // Because several cameras can lie on one segment we return vector of them.
   virtual std::vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) = 0;
+  // Returns landmarks of |numMwmId| for the vehicle type of the loader or nullptr
+  // if the mwm has no suitable landmarks. Clear() doesn't invalidate the returned pointer.
+  virtual Landmarks const * GetLandmarks(NumMwmId numMwmId) = 0;
+  // Returns speed profiles of |numMwmId| or nullptr if the mwm has no speed profiles.
+  // Clear() doesn't invalidate the returned pointer.
+  virtual SpeedProfiles const * GetSpeedProfiles(NumMwmId numMwmId) = 0;
   virtual void Clear() = 0;
 
+  // If |sharedGeometry| is not nullptr geometry of roads is taken from it instead of
+  // being loaded and cached by the loader.
   static std::unique_ptr<IndexGraphLoader> Create(
       VehicleType vehicleType, bool loadAltitudes, std::shared_ptr<NumMwmIds> numMwmIds,
       std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-      std::shared_ptr<EdgeEstimator> estimator, DataSource & dataSource);
+      std::shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
+      std::shared_ptr<SharedRoadGeometry> sharedGeometry);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
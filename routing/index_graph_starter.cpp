@@ -252,6 +252,33 @@ double IndexGraphStarter::CalcSegmentETA(Segment const & segment) const
   return m_graph.CalcSegmentETA(segment);
 }
 
+RouteWeight IndexGraphStarter::CalcEdgeWeightAtTime(SegmentEdge const & edge,
+                                                    double weekTimeS) const
+{
+  Segment const & target = edge.GetTarget();
+  Segment real = target;
+  double partOfReal = 1.0;
+  if (IsFakeSegment(target))
+  {
+    if (!m_fake.FindReal(target, real))
+      return edge.GetWeight();
+
+    auto const & vertex = m_fake.GetVertex(target);
+    auto const partLen = MercatorBounds::DistanceOnEarth(vertex.GetPointFrom(), vertex.GetPointTo());
+    auto const fullLen = MercatorBounds::DistanceOnEarth(GetPoint(real, false /* front */),
+                                                         GetPoint(real, true /* front */));
+    partOfReal = fullLen == 0.0 ? 0.0 : partLen / fullLen;
+  }
+
+  RouteWeight weightAtTime;
+  if (!m_graph.CalcSegmentWeightAtTime(real, weekTimeS, weightAtTime))
+    return edge.GetWeight();
+
+  // Weight of an outgoing edge is weight of its target and penalties, see CalcSegmentWeight()
+  // and IndexGraph::GetNeighboringEdge(). The penalties don't depend on time.
+  return edge.GetWeight() + partOfReal * (weightAtTime - m_graph.CalcSegmentWeight(real));
+}
+
 void IndexGraphStarter::AddEnding(FakeEnding const & thisEnding, FakeEnding const & otherEnding,
                                   bool isStart, bool strictForward, uint32_t & fakeNumerationStart)
 {
@@ -33,6 +33,7 @@ public:
   using Vertex = IndexGraph::Vertex;
   using Edge = IndexGraph::Edge;
   using Weight = IndexGraph::Weight;
+  using VertexHasher = IndexGraph::VertexHasher;
 
   friend class FakeEdgesContainer;
 
@@ -102,6 +103,9 @@ public:
 
   RouteWeight CalcSegmentWeight(Segment const & segment) const;
   double CalcSegmentETA(Segment const & segment) const;
+  // Recalculates weight of outgoing |edge| if its source is left at time of week |weekTimeS|:
+  // weight of the edge target is calculated with speed profiles (see SpeedProfiles).
+  RouteWeight CalcEdgeWeightAtTime(SegmentEdge const & edge, double weekTimeS) const;
 
 private:
   // Start or finish ending information. 
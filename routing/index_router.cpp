@@ -36,11 +36,15 @@
 #include "platform/country_file.hpp"
 #include "platform/mwm_traits.hpp"
 
+#include "base/arena.hpp"
 #include "base/exception.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/trace.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <thread>
 #include <utility>
 
 #include "defines.hpp"
@@ -224,6 +228,13 @@ bool GetLastRealOrPart(IndexGraphStarter const & starter, vector<Segment> const
   }
   return false;
 }
+
+// The mwms which were generated without leaps for the vehicle type have no weights for it.
+bool CrossMwmWeightsExist(WorldGraph & graph, set<NumMwmId> const & mwmIds)
+{
+  return all_of(mwmIds.cbegin(), mwmIds.cend(),
+                [&graph](NumMwmId mwmId) { return graph.CrossMwmWeightsExist(mwmId); });
+}
 }  // namespace
 
 namespace routing
@@ -273,10 +284,14 @@ double IndexRouter::BestEdgeComparator::GetSquaredDist(Edge const & edge) const
 }
 
 // IndexRouter ------------------------------------------------------------------------------------
+// static
+uint32_t constexpr IndexRouter::kNoDepartureTime;
+
 IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
                          CountryParentNameGetterFn const & countryParentNameGetterFn,
                          TCountryFileFn const & countryFileFn, CourntryRectFn const & countryRectFn,
-                         shared_ptr<NumMwmIds> numMwmIds, unique_ptr<m4::Tree<NumMwmId>> numMwmTree,
+                         shared_ptr<NumMwmIds> numMwmIds,
+                         unique_ptr<m4::PackedTree<NumMwmId>> numMwmTree,
                          traffic::TrafficCache const & trafficCache, DataSource & dataSource)
   : m_vehicleType(vehicleType)
   , m_loadAltitudes(loadAltitudes)
@@ -338,6 +353,8 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
     return RouterResultCode::FileTooOld;
   }
 
+  m_stats.Clear();
+
   auto const & startPoint = checkpoints.GetStart();
   auto const & finalPoint = checkpoints.GetFinish();
 
@@ -360,7 +377,9 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
           MercatorBounds::ToLatLon(finalPoint)));
       }
     }
-    return DoCalculateRoute(checkpoints, startDirection, delegate, route);
+    vector<unique_ptr<Route>> alternatives;
+    return DoCalculateRoute(checkpoints, startDirection, 0 /* maxAlternatives */, delegate, route,
+                            alternatives);
   }
   catch (RootException const & e)
   {
@@ -370,11 +389,290 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
   }
 }
 
+RouterResultCode IndexRouter::CalculateRouteWithAlternatives(
+    Checkpoints const & checkpoints, m2::PointD const & startDirection, size_t maxAlternatives,
+    RouterDelegate const & delegate, Route & route, vector<unique_ptr<Route>> & alternatives)
+{
+  alternatives.clear();
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_dataSource, outdatedMwms);
+
+  if (!outdatedMwms.empty())
+  {
+    for (string const & mwm : outdatedMwms)
+      route.AddAbsentCountry(mwm);
+
+    return RouterResultCode::FileTooOld;
+  }
+
+  m_stats.Clear();
+
+  try
+  {
+    return DoCalculateRoute(checkpoints, startDirection, maxAlternatives, delegate, route,
+                            alternatives);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't find path from", MercatorBounds::ToLatLon(checkpoints.GetStart()), "to",
+      MercatorBounds::ToLatLon(checkpoints.GetFinish()), ":\n ", e.what()));
+    alternatives.clear();
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::CalculateRouteMatrix(vector<m2::PointD> const & sources,
+                                                   vector<m2::PointD> const & targets,
+                                                   bool needGeometry, size_t numThreads,
+                                                   RouterDelegate const & delegate,
+                                                   RouteMatrix & matrix)
+{
+  matrix = RouteMatrix(sources.size(), targets.size(), needGeometry);
+
+  try
+  {
+    TrafficStash::Guard guard(m_trafficStash);
+
+    numThreads = max<size_t>(1, min(numThreads, sources.size()));
+    // Threads share geometry of roads to decode it once.
+    auto sharedGeometry = m_sharedRoadGeometry;
+    if (!sharedGeometry && numThreads > 1)
+      sharedGeometry = make_shared<SharedRoadGeometry>();
+
+    vector<unique_ptr<WorldGraph>> graphs;
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+      graphs.push_back(MakeWorldGraph(sharedGeometry));
+      graphs.back()->SetMode(WorldGraph::Mode::NoLeaps);
+    }
+
+    // FindBestSegment() uses |m_roadGraph| which is not thread safe. So all the segments
+    // are found before the waves are started.
+    base::Arena::Scope scratch;
+    base::ArenaVector<Segment> sourceSegments(sources.size());
+    base::ArenaVector<bool> sourceFound(sources.size());
+    set<NumMwmId> mwmIds;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      sourceFound[i] = FindBestSegment(sources[i], m2::PointD::Zero() /* direction */,
+                                       true /* isOutgoing */, *graphs.front(), sourceSegments[i]);
+      if (sourceFound[i])
+        mwmIds.insert(sourceSegments[i].GetMwmId());
+    }
+
+    map<Segment, vector<size_t>> targetSegments;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+      Segment segment;
+      if (FindBestSegment(targets[i], m2::PointD::Zero() /* direction */, false /* isOutgoing */,
+                          *graphs.front(), segment))
+      {
+        targetSegments[segment].push_back(i);
+        mwmIds.insert(segment.GetMwmId());
+      }
+    }
+
+    // Waves must not cover the whole world if some targets are unreachable.
+    set<NumMwmId> allowedMwmIds;
+    for (NumMwmId const mwmId : mwmIds)
+    {
+      m2::RectD const rect = m_countryRectFn(m_numMwmIds->GetFile(mwmId).GetName());
+      m_numMwmTree->ForEachInRect(rect, [&](NumMwmId id) { allowedMwmIds.insert(id); });
+      allowedMwmIds.insert(mwmId);
+    }
+
+    atomic<size_t> nextSource(0);
+    atomic<bool> cancelled(false);
+    atomic<bool> failed(false);
+
+    auto const processSources = [&](WorldGraph & graph) {
+      try
+      {
+        AStarAlgorithm<WorldGraph> algorithm;
+        AStarAlgorithm<WorldGraph>::Context context;
+        vector<Segment> path;
+        for (size_t i = nextSource++; i < sources.size(); i = nextSource++)
+        {
+          if (!sourceFound[i])
+            continue;
+
+          size_t targetsToVisit = targetSegments.size();
+          uint32_t visitCount = 0;
+          auto const visitVertex = [&](Segment const & vertex) {
+            if (++visitCount % kVisitPeriod == 0 && delegate.IsCancelled())
+              cancelled = true;
+            if (cancelled || failed)
+              return false;
+
+            if (targetSegments.count(vertex) != 0)
+              --targetsToVisit;
+            return targetsToVisit != 0;
+          };
+          auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge) {
+            return edge.GetWeight();
+          };
+          auto const filterStates = [&](auto const & state) {
+            return allowedMwmIds.count(state.vertex.GetMwmId()) != 0;
+          };
+          algorithm.PropagateWave(graph, sourceSegments[i], visitVertex, adjustEdgeWeight,
+                                  filterStates, context);
+          if (cancelled || failed)
+            return;
+
+          for (auto const & target : targetSegments)
+          {
+            if (!context.HasDistance(target.first))
+              continue;
+
+            double const weight = context.GetDistance(target.first).GetWeight();
+            if (needGeometry)
+              context.ReconstructPath(target.first, path);
+
+            // Every row of |matrix| is filled by one thread only.
+            for (size_t const j : target.second)
+            {
+              matrix.SetWeight(i, j, weight);
+              if (!needGeometry)
+                continue;
+
+              auto & geometry = matrix.GetGeometry(i, j);
+              geometry.clear();
+              geometry.push_back(graph.GetPoint(path.front(), false /* front */));
+              for (Segment const & segment : path)
+                geometry.push_back(graph.GetPoint(segment, true /* front */));
+            }
+          }
+        }
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Can't calculate route matrix:", e.what()));
+        failed = true;
+      }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 1; i < graphs.size(); ++i)
+      threads.emplace_back(processSources, ref(*graphs[i]));
+    processSources(*graphs.front());
+    for (auto & t : threads)
+      t.join();
+
+    if (failed)
+      return RouterResultCode::InternalError;
+    if (cancelled)
+      return RouterResultCode::Cancelled;
+    return RouterResultCode::NoError;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate route matrix:", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::CalculateIsochrones(m2::PointD const & start,
+                                                  vector<double> const & budgets,
+                                                  double cellSizeM,
+                                                  RouterDelegate const & delegate,
+                                                  vector<Isochrone> & isochrones)
+{
+  isochrones.clear();
+  if (budgets.empty())
+    return RouterResultCode::NoError;
+
+  try
+  {
+    TrafficStash::Guard guard(m_trafficStash);
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraph::Mode::NoLeaps);
+
+    Segment startSegment;
+    if (!FindBestSegment(start, m2::PointD::Zero() /* direction */, true /* isOutgoing */, *graph,
+                         startSegment))
+    {
+      return RouterResultCode::StartPointNotFound;
+    }
+
+    double const maxBudget = *max_element(budgets.cbegin(), budgets.cend());
+    AStarAlgorithm<WorldGraph> algorithm;
+    AStarAlgorithm<WorldGraph>::Context context;
+    // Segments in the order they are settled and the times they are passed at.
+    vector<pair<Segment, double>> reached;
+    uint32_t visitCount = 0;
+    bool cancelled = false;
+    auto const visitVertex = [&](Segment const & vertex) {
+      if (++visitCount % kVisitPeriod == 0 && delegate.IsCancelled())
+      {
+        cancelled = true;
+        return false;
+      }
+
+      double const time = context.GetDistance(vertex).GetWeight();
+      if (time > maxBudget)
+        return false;
+      reached.emplace_back(vertex, time);
+      return true;
+    };
+    algorithm.PropagateWave(*graph, startSegment, visitVertex, context);
+    if (cancelled)
+      return RouterResultCode::Cancelled;
+
+    double const cellSize =
+        MercatorBounds::RectByCenterXYAndSizeInMeters(start, cellSizeM).SizeX();
+    // Every reached segment is sampled up to the point which is reached within the budget.
+    double const sampleStep = cellSize / 2.0;
+    vector<vector<m2::PointD>> points(budgets.size());
+    for (auto const & segmentTime : reached)
+    {
+      Segment const & segment = segmentTime.first;
+      double const finishTime = segmentTime.second;
+      double const startTime =
+          max(0.0, finishTime - graph->CalcSegmentWeight(segment).GetWeight());
+      m2::PointD const from = graph->GetPoint(segment, false /* front */);
+      m2::PointD const to = graph->GetPoint(segment, true /* front */);
+      auto const samplesCount = static_cast<size_t>(from.Length(to) / sampleStep) + 1;
+
+      for (size_t i = 0; i < budgets.size(); ++i)
+      {
+        if (budgets[i] < startTime)
+          continue;
+
+        double const part = finishTime > budgets[i] && finishTime > startTime
+                                ? (budgets[i] - startTime) / (finishTime - startTime)
+                                : 1.0;
+        m2::PointD const end = from + (to - from) * part;
+        for (size_t j = 0; j < samplesCount; ++j)
+          points[i].push_back(from + (end - from) * (static_cast<double>(j) / samplesCount));
+        points[i].push_back(end);
+      }
+    }
+
+    isochrones.resize(budgets.size());
+    for (size_t i = 0; i < budgets.size(); ++i)
+    {
+      isochrones[i].m_budget = budgets[i];
+      isochrones[i].m_polygons = BuildConcaveHulls(points[i], cellSize);
+    }
+    return RouterResultCode::NoError;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate isochrones:", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
 RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                m2::PointD const & startDirection,
-                                               RouterDelegate const & delegate, Route & route)
+                                               size_t maxAlternatives,
+                                               RouterDelegate const & delegate, Route & route,
+                                               vector<unique_ptr<Route>> & alternatives)
 {
+  TRACE_ZONE("IndexRouter::DoCalculateRoute");
   m_lastRoute.reset();
+  m_lastDestinationTree.Clear();
 
   for (auto const & checkpoint : checkpoints.GetPoints())
   {
@@ -399,19 +697,24 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
   auto graph = MakeWorldGraph();
 
   vector<Segment> segments;
+  vector<vector<Segment>> alternativeSubroutes;
 
   Segment startSegment;
   bool startSegmentIsAlmostCodirectionalDirection = false;
-  if (!FindBestSegment(checkpoints.GetPointFrom(), startDirection, true /* isOutgoing */, *graph,
-                       startSegment, startSegmentIsAlmostCodirectionalDirection))
   {
-    return RouterResultCode::StartPointNotFound;
+    RouteCalculationStats::ScopedPhase phase(m_stats, RouteCalculationStats::Phase::NearestEdges);
+    if (!FindBestSegment(checkpoints.GetPointFrom(), startDirection, true /* isOutgoing */, *graph,
+                         startSegment, startSegmentIsAlmostCodirectionalDirection))
+    {
+      return RouterResultCode::StartPointNotFound;
+    }
   }
 
   size_t subrouteSegmentsBegin = 0;
   vector<Route::SubrouteAttrs> subroutes;
   PushPassedSubroutes(checkpoints, subroutes);
   unique_ptr<IndexGraphStarter> starter;
+  double subrouteWeekTimeS = m_departureWeekTimeS;
 
   for (size_t i = checkpoints.GetPassedIdx(); i < checkpoints.GetNumSubroutes(); ++i)
   {
@@ -422,12 +725,16 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
     Segment finishSegment;
     bool dummy = false;
-    if (!FindBestSegment(finishCheckpoint, m2::PointD::Zero() /* direction */,
-                         false /* isOutgoing */, *graph, finishSegment,
-                         dummy /* bestSegmentIsAlmostCodirectional */))
     {
-      return isLastSubroute ? RouterResultCode::EndPointNotFound
-                            : RouterResultCode::IntermediatePointNotFound;
+      RouteCalculationStats::ScopedPhase phase(m_stats,
+                                               RouteCalculationStats::Phase::NearestEdges);
+      if (!FindBestSegment(finishCheckpoint, m2::PointD::Zero() /* direction */,
+                           false /* isOutgoing */, *graph, finishSegment,
+                           dummy /* bestSegmentIsAlmostCodirectional */))
+      {
+        return isLastSubroute ? RouterResultCode::EndPointNotFound
+                              : RouterResultCode::IntermediatePointNotFound;
+      }
     }
 
     bool isStartSegmentStrictForward = (m_vehicleType == VehicleType::Car);
@@ -440,7 +747,12 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                       isStartSegmentStrictForward, *graph);
 
     vector<Segment> subroute;
-    auto const result = CalculateSubroute(checkpoints, i, delegate, subrouteStarter, subroute);
+    // Alternatives of a route with several subroutes would have to be combined from
+    // alternatives of the subroutes, so they are searched for one subroute only.
+    size_t const maxSubrouteAlternatives = isFirstSubroute && isLastSubroute ? maxAlternatives : 0;
+    auto const result = CalculateSubroute(checkpoints, i, delegate, subrouteStarter,
+                                          maxSubrouteAlternatives, subrouteWeekTimeS, subroute,
+                                          alternativeSubroutes);
 
     if (result != RouterResultCode::NoError)
       return result;
@@ -470,6 +782,32 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
   if (redressResult != RouterResultCode::NoError)
     return redressResult;
 
+  for (auto const & alternativeSegments : alternativeSubroutes)
+  {
+    IndexGraphStarter::CheckValidRoute(alternativeSegments);
+
+    vector<Route::SubrouteAttrs> alternativeSubroutesAttrs;
+    PushPassedSubroutes(checkpoints, alternativeSubroutesAttrs);
+    alternativeSubroutesAttrs.emplace_back(starter->GetStartJunction(),
+                                           starter->GetFinishJunction(), 0 /* beginSegmentIdx */,
+                                           alternativeSegments.size());
+
+    auto alternative = make_unique<Route>(route.GetRouterId(), route.GetRouteId());
+    alternative->SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
+    alternative->SetSubroteAttrs(move(alternativeSubroutesAttrs));
+    auto const alternativeResult = RedressRoute(alternativeSegments, delegate, *starter,
+                                                *alternative);
+    if (alternativeResult == RouterResultCode::Cancelled)
+      return alternativeResult;
+
+    if (alternativeResult != RouterResultCode::NoError)
+    {
+      LOG(LWARNING, ("Can't redress an alternative route:", alternativeResult));
+      continue;
+    }
+    alternatives.push_back(move(alternative));
+  }
+
   m_lastRoute = make_unique<SegmentedRoute>(checkpoints.GetStart(), checkpoints.GetFinish(),
                                             route.GetSubroutes());
   for (Segment const & segment : segments)
@@ -484,18 +822,28 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
                                                 size_t subrouteIdx,
                                                 RouterDelegate const & delegate,
                                                 IndexGraphStarter & starter,
-                                                vector<Segment> & subroute)
+                                                size_t maxAlternatives, double & weekTimeS,
+                                                vector<Segment> & subroute,
+                                                vector<vector<Segment>> & alternativeSubroutes)
 {
+  TRACE_ZONE("IndexRouter::CalculateSubroute");
   subroute.clear();
+  alternativeSubroutes.clear();
 
-  // We use leaps for cars only. Other vehicle types do not have weights in their cross-mwm sections.
+  // Transit has no leaps. Pedestrian and bicycle weights are in the cross-mwm sections of
+  // the newer mwms only, so leaps are used for them if the weights exist.
   switch (m_vehicleType)
   {
-    case VehicleType::Pedestrian:
-    case VehicleType::Bicycle:
     case VehicleType::Transit:
       starter.GetGraph().SetMode(WorldGraph::Mode::NoLeaps);
       break;
+    case VehicleType::Pedestrian:
+    case VehicleType::Bicycle:
+      starter.GetGraph().SetMode(AreMwmsNear(starter.GetMwms()) ||
+                                         !CrossMwmWeightsExist(starter.GetGraph(), starter.GetMwms())
+                                     ? WorldGraph::Mode::NoLeaps
+                                     : WorldGraph::Mode::LeapsOnly);
+      break;
     case VehicleType::Car:
       starter.GetGraph().SetMode(AreMwmsNear(starter.GetMwms()) ? WorldGraph::Mode::NoLeaps
                                                                 : WorldGraph::Mode::LeapsOnly);
@@ -539,11 +887,58 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
       starter, starter.GetStartSegment(), starter.GetFinishSegment(), nullptr /* prevRoute */,
       delegate, onVisitJunction, checkLength);
 
+  // The backward wave from the finish is kept for rerouting, see AdjustRoute().
+  bool const isLastSubroute = subrouteIdx + 1 == checkpoints.GetNumSubroutes();
+  if (isLastSubroute && starter.GetGraph().GetMode() == WorldGraph::Mode::NoLeaps)
+    params.m_destinationTree = &m_lastDestinationTree;
+
+  bool const hasDepartureTime = m_departureWeekTimeS != kNoDepartureTime;
+  if (hasDepartureTime && starter.GetGraph().GetMode() != WorldGraph::Mode::LeapsOnly)
+  {
+    double const departureWeekTimeS = weekTimeS;
+    params.m_adjustEdgeWeightCallback = [&starter, departureWeekTimeS](
+                                            SegmentEdge const & edge,
+                                            RouteWeight const & distance) {
+      return starter.CalcEdgeWeightAtTime(edge, departureWeekTimeS + distance.GetWeight());
+    };
+  }
+
   set<NumMwmId> const mwmIds = starter.GetMwms();
-  RouterResultCode const result = FindPath<IndexGraphStarter>(params, mwmIds, routingResult);
+  RouterResultCode result = RouterResultCode::InternalError;
+  {
+    RouteCalculationStats::ScopedPhase phase(
+        m_stats, starter.GetGraph().GetMode() == WorldGraph::Mode::LeapsOnly
+                     ? RouteCalculationStats::Phase::Leaps
+                     : RouteCalculationStats::Phase::AStar);
+    if (maxAlternatives != 0 && !params.m_adjustEdgeWeightCallback &&
+        starter.GetGraph().GetMode() == WorldGraph::Mode::NoLeaps)
+    {
+      AStarAlgorithm<IndexGraphStarter> algorithm;
+      AStarAlgorithm<IndexGraphStarter>::AlternativesParams alternatives;
+      alternatives.m_maxAlternatives = maxAlternatives;
+      vector<RoutingResult<Segment, RouteWeight>> routingResults;
+      result = ConvertTransitResult(
+          mwmIds, ConvertResult<IndexGraphStarter>(algorithm.FindPathBidirectionalWithAlternatives(
+                      params, alternatives, routingResults, GetAStarWorkspace(starter))));
+      if (result == RouterResultCode::NoError)
+      {
+        routingResult = move(routingResults.front());
+        for (size_t i = 1; i < routingResults.size(); ++i)
+          alternativeSubroutes.push_back(move(routingResults[i].m_path));
+      }
+    }
+    else
+    {
+      result = FindPath<IndexGraphStarter>(params, mwmIds, routingResult);
+    }
+  }
+  m_stats.AddVisitedVertices(visitCount);
   if (result != RouterResultCode::NoError)
     return result;
 
+  if (hasDepartureTime)
+    weekTimeS += routingResult.m_distance.GetWeight();
+
   RouterResultCode const leapsResult =
       ProcessLeaps(routingResult.m_path, delegate, starter.GetGraph().GetMode(), starter, subroute);
   if (leapsResult != RouterResultCode::NoError)
@@ -556,6 +951,7 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
                                           m2::PointD const & startDirection,
                                           RouterDelegate const & delegate, Route & route)
 {
+  TRACE_ZONE("IndexRouter::AdjustRoute");
   base::Timer timer;
   TrafficStash::Guard guard(m_trafficStash);
   auto graph = MakeWorldGraph();
@@ -564,10 +960,13 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   Segment startSegment;
   m2::PointD const & pointFrom = checkpoints.GetPointFrom();
   bool bestSegmentIsAlmostCodirectional = false;
-  if (!FindBestSegment(pointFrom, startDirection, true /* isOutgoing */, *graph, startSegment,
-                       bestSegmentIsAlmostCodirectional))
   {
-    return RouterResultCode::StartPointNotFound;
+    RouteCalculationStats::ScopedPhase phase(m_stats, RouteCalculationStats::Phase::NearestEdges);
+    if (!FindBestSegment(pointFrom, startDirection, true /* isOutgoing */, *graph, startSegment,
+                         bestSegmentIsAlmostCodirectional))
+    {
+      return RouterResultCode::StartPointNotFound;
+    }
   }
 
   auto const & lastSubroutes = m_lastRoute->GetSubroutes();
@@ -588,9 +987,15 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   progress.Initialize(starter.GetStartJunction().GetPoint(),
                       starter.GetFinishJunction().GetPoint());
 
+  // The destination tree leads to the finish of the last subroute only. With the tree
+  // the route may return to any road near the previous route, not to the route only.
+  bool const useDestinationTree = !m_lastDestinationTree.IsEmpty() &&
+                                  checkpoints.GetPassedIdx() + 1 == lastSubroutes.size();
+
   vector<SegmentEdge> prevEdges;
   CHECK_LESS_OR_EQUAL(lastSubroute.GetEndSegmentIdx(), steps.size(), ());
-  for (size_t i = lastSubroute.GetBeginSegmentIdx(); i < lastSubroute.GetEndSegmentIdx(); ++i)
+  for (size_t i = lastSubroute.GetBeginSegmentIdx();
+       !useDestinationTree && i < lastSubroute.GetEndSegmentIdx(); ++i)
   {
     auto const & step = steps[i];
     prevEdges.emplace_back(step.GetSegment(), starter.CalcSegmentWeight(step.GetSegment()));
@@ -620,8 +1025,15 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
                                                    {} /* finalVertex */, &prevEdges, delegate,
                                                    onVisitJunction, checkLength);
   RoutingResult<Segment, RouteWeight> result;
-  auto const resultCode =
-      ConvertResult<IndexGraphStarter>(algorithm.AdjustRoute(params, result));
+  RouterResultCode resultCode = RouterResultCode::InternalError;
+  {
+    RouteCalculationStats::ScopedPhase phase(m_stats, RouteCalculationStats::Phase::AStar);
+    resultCode = ConvertResult<IndexGraphStarter>(
+        useDestinationTree
+            ? algorithm.AdjustRoute(params, m_lastDestinationTree, result, m_starterWorkspace)
+            : algorithm.AdjustRoute(params, result, m_starterWorkspace));
+  }
+  m_stats.AddVisitedVertices(visitCount);
   if (resultCode != RouterResultCode::NoError)
     return resultCode;
 
@@ -657,12 +1069,13 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
     return redressResult;
 
   LOG(LINFO, ("Adjust route, elapsed:", timer.ElapsedSeconds(), ", prev start:", checkpoints,
-              ", prev route:", steps.size(), ", new route:", result.m_path.size()));
+              ", prev route:", steps.size(), ", new route:", result.m_path.size(),
+              ", destination tree:", useDestinationTree));
 
   return RouterResultCode::NoError;
 }
 
-unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
+unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph(shared_ptr<SharedRoadGeometry> sharedGeometry)
 {
   auto crossMwmGraph = make_unique<CrossMwmGraph>(
       m_numMwmIds, m_numMwmTree, m_vehicleModelFactory,
@@ -670,7 +1083,8 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
       m_countryRectFn, m_dataSource);
   auto indexGraphLoader = IndexGraphLoader::Create(
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-      m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory, m_estimator, m_dataSource);
+      m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory, m_estimator, m_dataSource,
+      move(sharedGeometry));
   if (m_vehicleType != VehicleType::Transit)
   {
     return make_unique<SingleVehicleWorldGraph>(move(crossMwmGraph), move(indexGraphLoader),
@@ -685,6 +1099,7 @@ bool IndexRouter::FindBestSegment(m2::PointD const & point, m2::PointD const & d
                                   bool isOutgoing, WorldGraph & worldGraph, Segment & bestSegment,
                                   bool & bestSegmentIsAlmostCodirectional) const
 {
+  TRACE_ZONE("IndexRouter::FindBestSegment");
   auto const file = platform::CountryFile(m_countryFileFn(point));
   MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
   if (!handle.IsAlive())
@@ -694,7 +1109,7 @@ bool IndexRouter::FindBestSegment(m2::PointD const & point, m2::PointD const & d
   NumMwmId const numMwmId = m_numMwmIds->GetId(file);
 
   vector<pair<Edge, Junction>> candidates;
-  m_roadGraph.FindClosestEdges(point, kMaxRoadCandidates, candidates);
+  m_roadGraph.FindClosestEdges(point, mwmId, kMaxRoadCandidates, candidates);
 
   auto const getSegmentByEdge = [&numMwmId](Edge const & edge) {
     return Segment(numMwmId, edge.GetFeatureId().m_index, edge.GetSegId(), edge.IsForward());
@@ -737,6 +1152,8 @@ RouterResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
     return RouterResultCode::NoError;
   }
 
+  RouteCalculationStats::ScopedPhase phase(m_stats, RouteCalculationStats::Phase::Leaps);
+  TRACE_ZONE("IndexRouter::ProcessLeaps");
   CHECK_GREATER_OR_EQUAL(input.size(), 4,
                          ("Route in LeapsOnly mode must have at least start and finish leaps."));
 
@@ -847,9 +1264,12 @@ RouterResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
 
 RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
                                            RouterDelegate const & delegate,
-                                           IndexGraphStarter & starter, Route & route) const
+                                           IndexGraphStarter & starter, Route & route)
 {
   CHECK(!segments.empty(), ());
+  RouteCalculationStats::ScopedPhase phase(m_stats,
+                                           RouteCalculationStats::Phase::RouteReconstruction);
+  TRACE_ZONE("IndexRouter::RedressRoute");
   vector<Junction> junctions;
   size_t const numPoints = IndexGraphStarter::GetRouteNumPoints(segments);
   junctions.reserve(numPoints);
@@ -872,8 +1292,12 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
   }
 
   CHECK(m_directionsEngine, ());
-  ReconstructRoute(*m_directionsEngine, roadGraph, m_trafficStash, delegate, junctions, move(times),
-                   route);
+  {
+    RouteCalculationStats::ScopedPhase directionsPhase(m_stats,
+                                                       RouteCalculationStats::Phase::Directions);
+    ReconstructRoute(*m_directionsEngine, roadGraph, m_trafficStash, delegate, junctions,
+                     move(times), route);
+  }
 
   auto & worldGraph = starter.GetGraph();
   for (auto & routeSegment : route.GetRouteSegments())
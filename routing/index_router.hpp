@@ -8,7 +8,11 @@
 #include "routing/edge_estimator.hpp"
 #include "routing/fake_edges_container.hpp"
 #include "routing/features_road_graph.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/isochrone.hpp"
 #include "routing/joint.hpp"
+#include "routing/route_calculation_stats.hpp"
+#include "routing/route_matrix.hpp"
 #include "routing/router.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/segmented_route.hpp"
@@ -19,11 +23,14 @@
 
 #include "indexer/mwm_set.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 
 #include "std/unique_ptr.hpp"
 
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -33,7 +40,6 @@ class DataSource;
 namespace routing
 {
 class IndexGraph;
-class IndexGraphStarter;
 
 class IndexRouter : public IRouter
 {
@@ -65,7 +71,8 @@ public:
   IndexRouter(VehicleType vehicleType, bool loadAltitudes,
               CountryParentNameGetterFn const & countryParentNameGetterFn,
               TCountryFileFn const & countryFileFn, CourntryRectFn const & countryRectFn,
-              shared_ptr<NumMwmIds> numMwmIds, unique_ptr<m4::Tree<NumMwmId>> numMwmTree,
+              shared_ptr<NumMwmIds> numMwmIds,
+              unique_ptr<m4::PackedTree<NumMwmId>> numMwmTree,
               traffic::TrafficCache const & trafficCache, DataSource & dataSource);
 
   std::unique_ptr<WorldGraph> MakeSingleMwmWorldGraph();
@@ -78,19 +85,83 @@ public:
                                   bool adjustToPrevRoute, RouterDelegate const & delegate,
                                   Route & route) override;
 
+  /// \brief Calculates the route like CalculateRoute() does without adjusting it to the previous
+  /// route and up to |maxAlternatives| alternative routes with the same checkpoints.
+  /// The alternatives are found by the same search as the route, see
+  /// AStarAlgorithm::FindPathBidirectionalWithAlternatives(). So only routes of one subroute
+  /// without leaps and departure time have alternatives. Every route of |alternatives| has
+  /// the router name and the id of |route|.
+  RouterResultCode CalculateRouteWithAlternatives(
+      Checkpoints const & checkpoints, m2::PointD const & startDirection, size_t maxAlternatives,
+      RouterDelegate const & delegate, Route & route,
+      std::vector<std::unique_ptr<Route>> & alternatives);
+
+  /// \brief Calculates weights (and geometry if |needGeometry|) of routes from every point of
+  /// |sources| to every point of |targets|. One wave from every source finds routes to all the
+  /// targets. Sources are processed by |numThreads| threads, each of them has its own WorldGraph.
+  /// \note Weights are calculated between the best segments of the points, leaps are not used.
+  /// Waves are limited by the mwms of the points and their neighbours.
+  RouterResultCode CalculateRouteMatrix(std::vector<m2::PointD> const & sources,
+                                        std::vector<m2::PointD> const & targets, bool needGeometry,
+                                        size_t numThreads, RouterDelegate const & delegate,
+                                        RouteMatrix & matrix);
+
+  /// \brief Calculates the areas which are reachable from |start| within every of |budgets|
+  /// (seconds). One wave from the best segment of |start| is propagated up to the largest budget
+  /// and the areas of all the budgets are built from the reached segments, see BuildConcaveHulls().
+  /// |isochrones| follow |budgets|. The reached roads are covered with the margin of |cellSizeM|.
+  /// \note Leaps are not used.
+  RouterResultCode CalculateIsochrones(m2::PointD const & start,
+                                       std::vector<double> const & budgets, double cellSizeM,
+                                       RouterDelegate const & delegate,
+                                       std::vector<Isochrone> & isochrones);
+
+  /// \brief Makes the router take geometry of roads from |sharedGeometry| instead of loading it
+  /// to caches of every WorldGraph. The whole geometry of an mwm is decoded on its first use.
+  /// The collection may be shared by routers of the same vehicle type. nullptr turns caches back.
+  /// \note CalculateRouteMatrix() with several threads always shares geometry between them.
+  void SetSharedRoadGeometry(std::shared_ptr<SharedRoadGeometry> sharedGeometry)
+  {
+    m_sharedRoadGeometry = move(sharedGeometry);
+  }
+
+  /// \brief Makes weights of road segments depend on time they are reached at according to
+  /// speed profiles of mwms (see SpeedProfiles) for routes departing at |weekTimeS|, seconds
+  /// since Monday 00:00 of local time. Such routes are found with unidirectional A*,
+  /// routes with leaps don't use speed profiles.
+  void SetDepartureTime(uint32_t weekTimeS) { m_departureWeekTimeS = weekTimeS; }
+  void ResetDepartureTime() { m_departureWeekTimeS = kNoDepartureTime; }
+
+  /// \brief Returns durations of phases of the last CalculateRoute() call.
+  RouteCalculationStats const & GetLastRouteStats() const { return m_stats; }
+  /// \brief Makes GetLastRouteStats() report numbers of memory allocations with |counter|.
+  void SetAllocationCounter(RouteCalculationStats::AllocationCounter const & counter)
+  {
+    m_stats.SetAllocationCounter(counter);
+  }
+
 private:
+  static uint32_t constexpr kNoDepartureTime = std::numeric_limits<uint32_t>::max();
+
   RouterResultCode DoCalculateRoute(Checkpoints const & checkpoints,
-                                    m2::PointD const & startDirection,
-                                    RouterDelegate const & delegate, Route & route);
+                                    m2::PointD const & startDirection, size_t maxAlternatives,
+                                    RouterDelegate const & delegate, Route & route,
+                                    std::vector<std::unique_ptr<Route>> & alternatives);
+  // |weekTimeS| is time of week the subroute departs at. If departure time is set it's moved
+  // to arrival time of the subroute. |alternativeSubroutes| is filled for a subroute without
+  // leaps and departure time if |maxAlternatives| isn't zero.
   RouterResultCode CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                      RouterDelegate const & delegate, IndexGraphStarter & graph,
-                                     std::vector<Segment> & subroute);
+                                     size_t maxAlternatives, double & weekTimeS,
+                                     std::vector<Segment> & subroute,
+                                     std::vector<std::vector<Segment>> & alternativeSubroutes);
 
   RouterResultCode AdjustRoute(Checkpoints const & checkpoints,
                                m2::PointD const & startDirection,
                                RouterDelegate const & delegate, Route & route);
 
-  std::unique_ptr<WorldGraph> MakeWorldGraph();
+  std::unique_ptr<WorldGraph> MakeWorldGraph() { return MakeWorldGraph(m_sharedRoadGeometry); }
+  std::unique_ptr<WorldGraph> MakeWorldGraph(std::shared_ptr<SharedRoadGeometry> sharedGeometry);
 
   /// \brief Finds the best segment (edge) which may be considered as the start of the finish of the route.
   /// According to current implementation if a segment is near |point| and is almost codirectional
@@ -112,7 +183,7 @@ private:
                                    IndexGraphStarter & starter, std::vector<Segment> & output);
   RouterResultCode RedressRoute(std::vector<Segment> const & segments,
                                 RouterDelegate const & delegate, IndexGraphStarter & starter,
-                                Route & route) const;
+                                Route & route);
 
   bool AreMwmsNear(std::set<NumMwmId> const & mwmIds) const;
   bool DoesTransitSectionExist(NumMwmId numMwmId) const;
@@ -131,19 +202,32 @@ private:
     CHECK_SWITCH();
   }
 
+  AStarAlgorithm<IndexGraphStarter>::Workspace & GetAStarWorkspace(IndexGraphStarter const &)
+  {
+    return m_starterWorkspace;
+  }
+
+  AStarAlgorithm<WorldGraph>::Workspace & GetAStarWorkspace(WorldGraph const &)
+  {
+    return m_worldGraphWorkspace;
+  }
+
   template <typename Graph>
   RouterResultCode FindPath(
       typename AStarAlgorithm<Graph>::Params & params, std::set<NumMwmId> const & mwmIds,
-      RoutingResult<typename Graph::Vertex, typename Graph::Weight> & routingResult) const
+      RoutingResult<typename Graph::Vertex, typename Graph::Weight> & routingResult)
   {
     AStarAlgorithm<Graph> algorithm;
-    if (params.m_graph.GetMode() == WorldGraph::Mode::LeapsOnly)
+    auto & workspace = GetAStarWorkspace(params.m_graph);
+    if (params.m_graph.GetMode() == WorldGraph::Mode::LeapsOnly ||
+        params.m_adjustEdgeWeightCallback)
     {
-      return ConvertTransitResult(mwmIds,
-                                  ConvertResult<Graph>(algorithm.FindPath(params, routingResult)));
+      return ConvertTransitResult(
+          mwmIds, ConvertResult<Graph>(algorithm.FindPath(params, routingResult, workspace)));
     }
     return ConvertTransitResult(
-        mwmIds, ConvertResult<Graph>(algorithm.FindPathBidirectional(params, routingResult)));
+        mwmIds, ConvertResult<Graph>(
+                    algorithm.FindPathBidirectional(params, routingResult, workspace)));
   }
 
   VehicleType m_vehicleType;
@@ -155,7 +239,7 @@ private:
   TCountryFileFn const m_countryFileFn;
   CourntryRectFn const m_countryRectFn;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
-  std::shared_ptr<m4::Tree<NumMwmId>> m_numMwmTree;
+  std::shared_ptr<m4::PackedTree<NumMwmId>> m_numMwmTree;
   std::shared_ptr<TrafficStash> m_trafficStash;
   FeaturesRoadGraph m_roadGraph;
 
@@ -163,5 +247,16 @@ private:
   std::unique_ptr<IDirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  // Backward search tree of the last subroute of |m_lastRoute|. It's used by AdjustRoute()
+  // to reroute to the finish quickly. Empty if the subroute is found without bidirectional A*.
+  AStarAlgorithm<IndexGraphStarter>::DestinationTree m_lastDestinationTree;
+  // May be nullptr.
+  std::shared_ptr<SharedRoadGeometry> m_sharedRoadGeometry;
+  uint32_t m_departureWeekTimeS = kNoDepartureTime;
+  RouteCalculationStats m_stats;
+
+  // A* memory is kept between route requests to avoid reallocations on every request.
+  AStarAlgorithm<IndexGraphStarter>::Workspace m_starterWorkspace;
+  AStarAlgorithm<WorldGraph>::Workspace m_worldGraphWorkspace;
 };
 }  // namespace routing
@@ -0,0 +1,191 @@
+#include "routing/isochrone.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+namespace
+{
+using Cell = pair<int64_t, int64_t>;
+using Vertex = pair<int64_t, int64_t>;
+
+// Returns the cells of the connected area (by the sides of the cells) which contains |start|
+// and removes them from |cells|.
+set<Cell> ExtractComponent(Cell const & start, set<Cell> & cells)
+{
+  set<Cell> component = {start};
+  vector<Cell> queue = {start};
+  cells.erase(start);
+  while (!queue.empty())
+  {
+    Cell const cell = queue.back();
+    queue.pop_back();
+    Cell const neighbours[] = {{cell.first - 1, cell.second}, {cell.first + 1, cell.second},
+                               {cell.first, cell.second - 1}, {cell.first, cell.second + 1}};
+    for (auto const & neighbour : neighbours)
+    {
+      auto const it = cells.find(neighbour);
+      if (it == cells.end())
+        continue;
+      cells.erase(it);
+      component.insert(neighbour);
+      queue.push_back(neighbour);
+    }
+  }
+  return component;
+}
+
+double SignedArea(vector<Vertex> const & loop)
+{
+  double area = 0.0;
+  for (size_t i = 0; i < loop.size(); ++i)
+  {
+    auto const & p = loop[i];
+    auto const & q = loop[(i + 1) % loop.size()];
+    area += static_cast<double>(p.first) * q.second - static_cast<double>(q.first) * p.second;
+  }
+  return area / 2.0;
+}
+
+// Returns the outer border of |component| by the vertices of the grid.
+vector<Vertex> GetOuterBorder(set<Cell> const & component)
+{
+  // The sides of the cells which are on the border, directed counterclockwise around the cells,
+  // so the area is on the left.
+  map<Vertex, vector<Vertex>> sides;
+  size_t sidesCount = 0;
+  auto const addSide = [&](Vertex const & from, Vertex const & to) {
+    sides[from].push_back(to);
+    ++sidesCount;
+  };
+  for (auto const & cell : component)
+  {
+    int64_t const x = cell.first;
+    int64_t const y = cell.second;
+    if (component.count({x, y - 1}) == 0)
+      addSide({x, y}, {x + 1, y});
+    if (component.count({x + 1, y}) == 0)
+      addSide({x + 1, y}, {x + 1, y + 1});
+    if (component.count({x, y + 1}) == 0)
+      addSide({x + 1, y + 1}, {x, y + 1});
+    if (component.count({x - 1, y}) == 0)
+      addSide({x, y + 1}, {x, y});
+  }
+
+  // The sides are chained to loops. At the vertices where the cells touch each other by corners
+  // the right turn is taken, so the outer border isn't split. The outer border is the loop with
+  // the largest area, the holes are clockwise.
+  vector<Vertex> outer;
+  double outerArea = 0.0;
+  while (sidesCount != 0)
+  {
+    auto const firstIt = sides.begin();
+    Vertex const first = firstIt->first;
+    Vertex prev = first;
+    Vertex curr = firstIt->second.back();
+    firstIt->second.pop_back();
+    if (firstIt->second.empty())
+      sides.erase(firstIt);
+    --sidesCount;
+
+    vector<Vertex> loop = {first};
+    while (curr != first)
+    {
+      int64_t const dx = curr.first - prev.first;
+      int64_t const dy = curr.second - prev.second;
+      // The right turn, straight and the left turn.
+      Vertex const candidates[] = {{curr.first + dy, curr.second - dx},
+                                   {curr.first + dx, curr.second + dy},
+                                   {curr.first - dy, curr.second + dx}};
+      auto const it = sides.find(curr);
+      CHECK(it != sides.end(), ("Border of an area is not closed."));
+      auto & nexts = it->second;
+      auto nextIt = nexts.end();
+      for (auto const & candidate : candidates)
+      {
+        nextIt = find(nexts.begin(), nexts.end(), candidate);
+        if (nextIt != nexts.end())
+          break;
+      }
+      CHECK(nextIt != nexts.end(), ("Border of an area is not closed."));
+
+      // Only the vertices where the border turns are kept.
+      if (*nextIt != Vertex(curr.first + dx, curr.second + dy))
+        loop.push_back(curr);
+
+      prev = curr;
+      curr = *nextIt;
+      nexts.erase(nextIt);
+      if (nexts.empty())
+        sides.erase(it);
+      --sidesCount;
+    }
+
+    // The first vertex is kept if the border turns there too.
+    if (loop.size() > 2)
+    {
+      auto const & p = loop.back();
+      auto const & q = loop[1];
+      if ((first.first - p.first) * (q.second - first.second) ==
+          (first.second - p.second) * (q.first - first.first))
+      {
+        loop.erase(loop.begin());
+      }
+    }
+
+    double const area = SignedArea(loop);
+    if (area > outerArea)
+    {
+      outerArea = area;
+      outer = move(loop);
+    }
+  }
+  return outer;
+}
+}  // namespace
+
+vector<vector<m2::PointD>> BuildConcaveHulls(vector<m2::PointD> const & points, double cellSize)
+{
+  CHECK_GREATER(cellSize, 0.0, ());
+  vector<vector<m2::PointD>> hulls;
+  if (points.empty())
+    return hulls;
+
+  // The grid starts at the first point to keep the cell numbers small.
+  m2::PointD const origin = points.front();
+  set<Cell> cells;
+  for (auto const & point : points)
+  {
+    auto const x = static_cast<int64_t>(floor((point.x - origin.x) / cellSize));
+    auto const y = static_cast<int64_t>(floor((point.y - origin.y) / cellSize));
+    for (int64_t dx = -1; dx <= 1; ++dx)
+    {
+      for (int64_t dy = -1; dy <= 1; ++dy)
+        cells.emplace(x + dx, y + dy);
+    }
+  }
+
+  while (!cells.empty())
+  {
+    auto const component = ExtractComponent(*cells.begin(), cells);
+    auto const border = GetOuterBorder(component);
+    hulls.emplace_back();
+    hulls.back().reserve(border.size());
+    for (auto const & vertex : border)
+    {
+      hulls.back().emplace_back(origin.x + vertex.first * cellSize,
+                                origin.y + vertex.second * cellSize);
+    }
+  }
+  return hulls;
+}
+}  // namespace routing
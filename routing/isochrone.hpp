@@ -0,0 +1,24 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include <vector>
+
+namespace routing
+{
+// Area which is reachable from a point within a time budget.
+struct Isochrone
+{
+  // Seconds.
+  double m_budget = 0.0;
+  // Outer borders of the connected parts of the area, counterclockwise, in mercator.
+  std::vector<std::vector<m2::PointD>> m_polygons;
+};
+
+// Returns the outer borders of the areas which cover |points|. The points are put to the cells
+// of the grid of |cellSize| and every point covers its cell with all the neighbouring ones, so
+// the points which are closer than |cellSize| are in one area. The holes of the areas are filled.
+// The borders are counterclockwise and go along the sides of the cells.
+std::vector<std::vector<m2::PointD>> BuildConcaveHulls(std::vector<m2::PointD> const & points,
+                                                       double cellSize);
+}  // namespace routing
@@ -10,38 +10,42 @@ void JointIndex::Build(RoadIndex const & roadIndex, uint32_t numJoints)
   // Call End(numJoints-1) requires more size, so add one more item.
   // Therefore m_offsets.size() == numJoints + 1,
   // And m_offsets.back() == m_points.size()
-  m_offsets.assign(numJoints + 1, 0);
+  vector<uint32_t> offsets(numJoints + 1, 0);
 
   // Calculate sizes.
   // Example for numJoints = 6:
   // 2, 5, 3, 4, 2, 3, 0
-  roadIndex.ForEachRoad([this, numJoints](uint32_t /* featureId */, RoadJointIds const & road) {
-    road.ForEachJoint([this, numJoints](uint32_t /* pointId */, Joint::Id jointId) {
+  roadIndex.ForEachRoad([&offsets, numJoints](uint32_t /* featureId */,
+                                              RoadJointIds const & road) {
+    road.ForEachJoint([&offsets, numJoints](uint32_t /* pointId */, Joint::Id jointId) {
       UNUSED_VALUE(numJoints);
       ASSERT_LESS(jointId, numJoints, ());
-      ++m_offsets[jointId];
+      ++offsets[jointId];
     });
   });
 
   // Fill offsets with end bounds.
   // Example: 2, 7, 10, 14, 16, 19, 19
-  for (size_t i = 1; i < m_offsets.size(); ++i)
-    m_offsets[i] += m_offsets[i - 1];
+  for (size_t i = 1; i < offsets.size(); ++i)
+    offsets[i] += offsets[i - 1];
 
-  m_points.resize(m_offsets.back());
+  vector<RoadPoint> points(offsets.back());
 
   // Now fill points.
   // Offsets after this operation are begin bounds:
   // 0, 2, 7, 10, 14, 16, 19
-  roadIndex.ForEachRoad([this](uint32_t featureId, RoadJointIds const & road) {
-    road.ForEachJoint([this, featureId](uint32_t pointId, Joint::Id jointId) {
-      uint32_t & offset = m_offsets[jointId];
+  roadIndex.ForEachRoad([&offsets, &points](uint32_t featureId, RoadJointIds const & road) {
+    road.ForEachJoint([&offsets, &points, featureId](uint32_t pointId, Joint::Id jointId) {
+      uint32_t & offset = offsets[jointId];
       --offset;
-      m_points[offset] = {featureId, pointId};
+      points[offset] = {featureId, pointId};
     });
   });
 
-  CHECK_EQUAL(m_offsets[0], 0, ());
-  CHECK_EQUAL(m_offsets.back(), m_points.size(), ());
+  CHECK_EQUAL(offsets[0], 0, ());
+  CHECK_EQUAL(offsets.back(), points.size(), ());
+
+  m_offsets.steal(offsets);
+  m_points.steal(points);
 }
 }  // namespace routing
@@ -4,16 +4,21 @@
 #include "routing/road_index.hpp"
 #include "routing/road_point.hpp"
 
+#include "coding/succinct_mapper.hpp"
+
 #include "base/assert.hpp"
 
 #include "std/vector.hpp"
 
+#include <type_traits>
+
 namespace routing
 {
 // JointIndex contains mapping from Joint::Id to RoadPoints.
 //
 // It is vector<Joint> conceptually.
 // Technically Joint entries are joined into the single vector to reduce allocations overheads.
+// The vectors may be mapped from memory instead of building (see map()).
 class JointIndex final
 {
 public:
@@ -36,7 +41,17 @@ public:
 
   void Build(RoadIndex const & roadIndex, uint32_t numJoints);
 
+  template <typename Visitor>
+  void map(Visitor & visitor)
+  {
+    visitor(m_offsets, "offsets")(m_points, "points");
+  }
+
 private:
+  static_assert(sizeof(RoadPoint) == 2 * sizeof(uint32_t) &&
+                    std::is_trivially_copyable<RoadPoint>::value,
+                "RoadPoint is kept in mappable_vector.");
+
   // Begin index for jointId entries.
   uint32_t Begin(Joint::Id jointId) const
   {
@@ -52,7 +67,7 @@ private:
     return m_offsets[nextId];
   }
 
-  vector<uint32_t> m_offsets;
-  vector<RoadPoint> m_points;
+  succinct::mapper::mappable_vector<uint32_t> m_offsets;
+  succinct::mapper::mappable_vector<RoadPoint> m_points;
 };
 }  // namespace routing
@@ -0,0 +1,72 @@
+#include "routing/landmarks.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace routing
+{
+using namespace std;
+
+uint16_t constexpr Landmarks::kLatestVersion;
+double constexpr Landmarks::kInfiniteWeight;
+double constexpr Landmarks::kUnreachableBound;
+uint32_t constexpr Landmarks::kNoEntry;
+size_t constexpr Landmarks::kFromLandmark;
+size_t constexpr Landmarks::kToLandmark;
+
+Landmarks::Landmarks(VehicleType vehicleType, uint16_t numLandmarks,
+                     vector<uint32_t> const & numSegments)
+  : m_vehicleType(vehicleType), m_numLandmarks(numLandmarks)
+{
+  m_featureOffsets.reserve(numSegments.size() + 1);
+  m_featureOffsets.push_back(0);
+  for (uint32_t const num : numSegments)
+  {
+    CHECK_LESS_OR_EQUAL(static_cast<uint64_t>(m_featureOffsets.back()) + num,
+                        numeric_limits<uint32_t>::max() / 2, ("Too many segments."));
+    m_featureOffsets.push_back(m_featureOffsets.back() + num);
+  }
+
+  m_weights.assign(GetNumWeights(), kInfiniteWeight);
+}
+
+double Landmarks::GetLowerBound(Segment const & from, Segment const & to) const
+{
+  uint32_t const fromEntry = GetEntry(from);
+  uint32_t const toEntry = GetEntry(to);
+  if (fromEntry == kNoEntry || toEntry == kNoEntry)
+    return 0.0;
+
+  double const * fromWeights = &m_weights[static_cast<size_t>(fromEntry) * m_numLandmarks * 2];
+  double const * toWeights = &m_weights[static_cast<size_t>(toEntry) * m_numLandmarks * 2];
+
+  // Every landmark gives two bounds. A bound is skipped if it's unknown because of unreachable
+  // landmark. If the bound proves that |to| is unreachable from |from| kUnreachableBound is
+  // returned. Skipping and kUnreachableBound keep the result a consistent potential.
+  double bound = 0.0;
+  for (uint16_t i = 0; i < m_numLandmarks; ++i)
+  {
+    // d(from, to) >= d(L, to) - d(L, from).
+    double const landmarkToFrom = fromWeights[i * 2 + kFromLandmark];
+    double const landmarkToTo = toWeights[i * 2 + kFromLandmark];
+    if (!isinf(landmarkToFrom))
+    {
+      if (isinf(landmarkToTo))
+        return kUnreachableBound;
+      bound = max(bound, landmarkToTo - landmarkToFrom);
+    }
+
+    // d(from, to) >= d(from, L) - d(to, L).
+    double const fromToLandmark = fromWeights[i * 2 + kToLandmark];
+    double const toToLandmark = toWeights[i * 2 + kToLandmark];
+    if (!isinf(toToLandmark))
+    {
+      if (isinf(fromToLandmark))
+        return kUnreachableBound;
+      bound = max(bound, fromToLandmark - toToLandmark);
+    }
+  }
+
+  return min(bound, kUnreachableBound);
+}
+}  // namespace routing
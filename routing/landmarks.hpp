@@ -0,0 +1,161 @@
+#pragma once
+
+#include "routing/segment.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+// Weights (seconds) of the shortest routes from and to a few selected segments (landmarks)
+// for all the road segments of one mwm. Due to the triangle inequality they give lower bounds
+// of route weights (ALT: A*, Landmarks and Triangle inequality):
+// d(a, b) >= d(L, b) - d(L, a) and d(a, b) >= d(a, L) - d(b, L).
+// The lower bounds are consistent A* potentials for routes inside the mwm
+// the landmarks were built for. They are not valid for routes which may leave the mwm.
+class Landmarks final
+{
+public:
+  static uint16_t constexpr kLatestVersion = 0;
+  // Weight of unreachable segment.
+  static double constexpr kInfiniteWeight = std::numeric_limits<double>::infinity();
+  // Lower bound between segments which are proven to be unconnected. It's finite to keep
+  // A* reduced weights computable and it's greater than any real lower bound.
+  static double constexpr kUnreachableBound = 1e8;
+
+  Landmarks() = default;
+
+  // |numSegments[featureId]| is the number of segments of the feature (0 for non-road features).
+  // All the weights are kInfiniteWeight after construction.
+  Landmarks(VehicleType vehicleType, uint16_t numLandmarks,
+            std::vector<uint32_t> const & numSegments);
+
+  VehicleType GetVehicleType() const { return m_vehicleType; }
+  uint16_t GetNumLandmarks() const { return m_numLandmarks; }
+  uint32_t GetNumFeatures() const
+  {
+    return m_featureOffsets.empty() ? 0
+                                    : base::asserted_cast<uint32_t>(m_featureOffsets.size() - 1);
+  }
+  bool IsEmpty() const { return m_numLandmarks == 0; }
+
+  // Returns true if there are weights of |segment|. Mwm id of |segment| is ignored.
+  bool HasSegment(Segment const & segment) const { return GetEntry(segment) != kNoEntry; }
+
+  void SetWeightFromLandmark(uint16_t landmark, Segment const & segment, double weight)
+  {
+    m_weights[GetIndex(landmark, segment, kFromLandmark)] = weight;
+  }
+
+  void SetWeightToLandmark(uint16_t landmark, Segment const & segment, double weight)
+  {
+    m_weights[GetIndex(landmark, segment, kToLandmark)] = weight;
+  }
+
+  double GetWeightFromLandmark(uint16_t landmark, Segment const & segment) const
+  {
+    return m_weights[GetIndex(landmark, segment, kFromLandmark)];
+  }
+
+  double GetWeightToLandmark(uint16_t landmark, Segment const & segment) const
+  {
+    return m_weights[GetIndex(landmark, segment, kToLandmark)];
+  }
+
+  // Returns a lower bound of weight of the route from |from| to |to|.
+  // Returns zero if one of the segments is unknown.
+  double GetLowerBound(Segment const & from, Segment const & to) const;
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kLatestVersion);
+    WriteToSink(sink, static_cast<uint8_t>(m_vehicleType));
+    WriteToSink(sink, m_numLandmarks);
+    WriteToSink(sink, base::checked_cast<uint32_t>(m_featureOffsets.size()));
+    for (uint32_t offset : m_featureOffsets)
+      WriteToSink(sink, offset);
+
+    for (double weight : m_weights)
+    {
+      uint64_t bits = 0;
+      static_assert(sizeof(bits) == sizeof(weight), "");
+      std::memcpy(&bits, &weight, sizeof(bits));
+      WriteToSink(sink, bits);
+    }
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    auto const vehicleType = ReadPrimitiveFromSource<uint8_t>(src);
+    CHECK_LESS(vehicleType, static_cast<uint8_t>(VehicleType::Count), ());
+    m_vehicleType = static_cast<VehicleType>(vehicleType);
+    m_numLandmarks = ReadPrimitiveFromSource<uint16_t>(src);
+
+    m_featureOffsets.resize(ReadPrimitiveFromSource<uint32_t>(src));
+    for (auto & offset : m_featureOffsets)
+      offset = ReadPrimitiveFromSource<uint32_t>(src);
+
+    m_weights.resize(GetNumWeights());
+    for (auto & weight : m_weights)
+    {
+      auto const bits = ReadPrimitiveFromSource<uint64_t>(src);
+      std::memcpy(&weight, &bits, sizeof(weight));
+    }
+  }
+
+private:
+  static uint32_t constexpr kNoEntry = std::numeric_limits<uint32_t>::max();
+  static size_t constexpr kFromLandmark = 0;
+  static size_t constexpr kToLandmark = 1;
+
+  // Returns index of |segment| among all directed segments.
+  uint32_t GetEntry(Segment const & segment) const
+  {
+    uint32_t const featureId = segment.GetFeatureId();
+    if (featureId + 1 >= m_featureOffsets.size())
+      return kNoEntry;
+
+    uint32_t const begin = m_featureOffsets[featureId];
+    if (segment.GetSegmentIdx() >= m_featureOffsets[featureId + 1] - begin)
+      return kNoEntry;
+
+    return (begin + segment.GetSegmentIdx()) * 2 + (segment.IsForward() ? 1 : 0);
+  }
+
+  // Weights of one segment are stored together to make GetLowerBound() cache friendly.
+  size_t GetIndex(uint16_t landmark, Segment const & segment, size_t direction) const
+  {
+    ASSERT_LESS(landmark, m_numLandmarks, ());
+    uint32_t const entry = GetEntry(segment);
+    CHECK_NOT_EQUAL(entry, kNoEntry, (segment));
+    return (static_cast<size_t>(entry) * m_numLandmarks + landmark) * 2 + direction;
+  }
+
+  size_t GetNumWeights() const
+  {
+    size_t const numSegments = m_featureOffsets.empty() ? 0 : m_featureOffsets.back();
+    return numSegments * 2 /* directions of segment */ * m_numLandmarks * 2 /* from and to */;
+  }
+
+  VehicleType m_vehicleType = VehicleType::Car;
+  uint16_t m_numLandmarks = 0;
+  // Segments of feature |featureId| are numbered from m_featureOffsets[featureId]
+  // to m_featureOffsets[featureId + 1].
+  std::vector<uint32_t> m_featureOffsets;
+  std::vector<double> m_weights;
+};
+}  // namespace routing
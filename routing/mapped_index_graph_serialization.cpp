@@ -0,0 +1,79 @@
+#include "routing/mapped_index_graph_serialization.hpp"
+
+#include "base/logging.hpp"
+
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+// static
+uint16_t constexpr MappedIndexGraphSerializer::kLatestVersion;
+vector<VehicleType> const MappedIndexGraphSerializer::kGraphTypes = {
+    VehicleType::Pedestrian, VehicleType::Bicycle, VehicleType::Car};
+
+// static
+bool MappedIndexGraphSerializer::Deserialize(unique_ptr<MemoryRegion> && region,
+                                             VehicleType vehicleType, IndexGraph & graph)
+{
+  CHECK(region, ());
+  uint8_t const * const data = region->ImmutableData();
+  MemReader reader(data, region->Size());
+  ReaderSource<MemReader> src(reader);
+
+  Header header;
+  header.m_version = ReadPrimitiveFromSource<uint16_t>(src);
+  header.m_endianness = ReadPrimitiveFromSource<uint16_t>(src);
+  header.m_numGraphs = ReadPrimitiveFromSource<uint32_t>(src);
+  if (header.m_version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unknown mapped index graph version", header.m_version, ", current version",
+                   kLatestVersion));
+    return false;
+  }
+
+  if (header.m_endianness != Header().m_endianness)
+  {
+    LOG(LWARNING, ("Mapped index graph has another byte order."));
+    return false;
+  }
+
+  if (!coding::IsAlign8(reinterpret_cast<uint64_t>(data)))
+  {
+    LOG(LWARNING, ("Mapped index graph is not aligned."));
+    return false;
+  }
+
+  for (uint32_t i = 0; i < header.m_numGraphs; ++i)
+  {
+    GraphHeader graphHeader;
+    graphHeader.m_vehicleType = ReadPrimitiveFromSource<uint32_t>(src);
+    graphHeader.m_reserved = ReadPrimitiveFromSource<uint32_t>(src);
+    graphHeader.m_offset = ReadPrimitiveFromSource<uint64_t>(src);
+    graphHeader.m_size = ReadPrimitiveFromSource<uint64_t>(src);
+    if (graphHeader.m_vehicleType != static_cast<uint32_t>(vehicleType))
+      continue;
+
+    if (graphHeader.m_offset + graphHeader.m_size > region->Size() ||
+        !coding::IsAlign8(graphHeader.m_offset))
+    {
+      MYTHROW(CorruptedDataException,
+              ("Wrong mapped index graph offset", graphHeader.m_offset, "size", graphHeader.m_size,
+               "section size", region->Size()));
+    }
+
+    uint64_t const bytesRead = coding::Map(graph, data + graphHeader.m_offset, "IndexGraph");
+    if (bytesRead != graphHeader.m_size)
+    {
+      MYTHROW(CorruptedDataException, ("Wrong mapped index graph size", bytesRead, "expected",
+                                       graphHeader.m_size));
+    }
+
+    graph.SetMappedRegion(move(region));
+    return true;
+  }
+
+  return false;
+}
+}  // namespace routing
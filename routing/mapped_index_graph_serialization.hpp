@@ -0,0 +1,109 @@
+#pragma once
+
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_serialization.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/memory_region.hpp"
+#include "coding/reader.hpp"
+#include "coding/succinct_mapper.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace routing
+{
+// Serializer of ROUTING_MAPPED_FILE_TAG section. Unlike ROUTING_FILE_TAG section the graphs
+// are not compressed. The section keeps ready road and joint indexes of pedestrian, bicycle
+// and car graphs which are used in place (e.g. mapped from file, see MmapReader) without any
+// decoding. So loading of a graph is O(1) and the memory pages are shared between processes.
+//
+// Layout of the section, all the values are in host byte order of the generator:
+// Header: uint16_t version, uint16_t endianness (1 for big endian), uint32_t number of graphs.
+// Graph headers: uint32_t vehicle type, uint32_t reserved, uint64_t offset, uint64_t size.
+// Graphs: road and joint indexes frozen with coding::Freeze(). Offsets of the graphs are
+// relative to the section beginning and they are multiples of 8.
+class MappedIndexGraphSerializer final
+{
+public:
+  MappedIndexGraphSerializer() = delete;
+
+  // Builds graphs of all the vehicle types from ROUTING_FILE_TAG section |routingSection|
+  // and serializes them to |sink|.
+  template <typename Reader, typename Sink>
+  static void Serialize(Reader const & routingSection, Sink & sink)
+  {
+    std::vector<GraphHeader> headers;
+    std::vector<std::vector<uint8_t>> graphs;
+    uint64_t offset = sizeof(Header) + kGraphTypes.size() * sizeof(GraphHeader);
+    for (VehicleType const vehicleType : kGraphTypes)
+    {
+      IndexGraph graph;
+      ReaderSource<Reader> src(routingSection);
+      IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+
+      graphs.emplace_back();
+      MemWriter<std::vector<uint8_t>> writer(graphs.back());
+      coding::Freeze(graph, writer, "IndexGraph");
+
+      GraphHeader header;
+      header.m_vehicleType = static_cast<uint32_t>(vehicleType);
+      header.m_offset = offset;
+      header.m_size = graphs.back().size();
+      headers.push_back(header);
+      offset += header.m_size;
+    }
+
+    Header header;
+    header.m_numGraphs = base::checked_cast<uint32_t>(headers.size());
+    WriteToSink(sink, header.m_version);
+    WriteToSink(sink, header.m_endianness);
+    WriteToSink(sink, header.m_numGraphs);
+    for (GraphHeader const & graphHeader : headers)
+    {
+      WriteToSink(sink, graphHeader.m_vehicleType);
+      WriteToSink(sink, graphHeader.m_reserved);
+      WriteToSink(sink, graphHeader.m_offset);
+      WriteToSink(sink, graphHeader.m_size);
+    }
+
+    for (auto const & graph : graphs)
+      sink.Write(graph.data(), graph.size());
+  }
+
+  // Maps road and joint indexes of |vehicleType| from |region| to |graph|. The graph keeps
+  // |region| alive. Returns false if the section can't be used: there's no graph for
+  // |vehicleType|, the section has unknown version or it's written with another byte order.
+  static bool Deserialize(std::unique_ptr<MemoryRegion> && region, VehicleType vehicleType,
+                          IndexGraph & graph);
+
+private:
+  static uint16_t constexpr kLatestVersion = 0;
+  static std::vector<VehicleType> const kGraphTypes;
+
+  struct Header
+  {
+    uint16_t m_version = kLatestVersion;
+    uint16_t m_endianness = IsBigEndianMacroBased() ? 1 : 0;
+    uint32_t m_numGraphs = 0;
+  };
+
+  struct GraphHeader
+  {
+    uint32_t m_vehicleType = 0;
+    uint32_t m_reserved = 0;
+    uint64_t m_offset = 0;
+    uint64_t m_size = 0;
+  };
+
+  static_assert(sizeof(Header) == 8, "Wrong header size of routing_mapped section.");
+  static_assert(sizeof(GraphHeader) == 24, "Wrong graph header size of routing_mapped section.");
+};
+}  // namespace routing
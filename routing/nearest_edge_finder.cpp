@@ -33,35 +33,8 @@ void NearestEdgeFinder::AddInformationSource(FeatureID const & featureId,
     double const d = m_point.SquaredLength(pt);
     if (d < res.m_dist)
     {
-      Junction const & segStart = junctions[i - 1];
-      Junction const & segEnd = junctions[i];
-      feature::TAltitude const startAlt = segStart.GetAltitude();
-      feature::TAltitude const endAlt = segEnd.GetAltitude();
-
-      double const segLenM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), segEnd.GetPoint());
-      feature::TAltitude projPointAlt = feature::kDefaultAltitudeMeters;
-      if (segLenM == 0.0)
-      {
-        projPointAlt = startAlt;
-      }
-      else
-      {
-        double const distFromStartM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), pt);
-        ASSERT_LESS_OR_EQUAL(distFromStartM, segLenM, (featureId));
-        projPointAlt = startAlt + static_cast<feature::TAltitude>((endAlt - startAlt) * distFromStartM / segLenM);
-      }
-
-      res.m_dist = d;
-      res.m_fid = featureId;
-      res.m_segId = static_cast<uint32_t>(i - 1);
-      res.m_segStart = segStart;
-      res.m_segEnd = segEnd;
-      res.m_bidirectional = bidirectional;
-
-      ASSERT_NOT_EQUAL(res.m_segStart.GetAltitude() , feature::kInvalidAltitude, ());
-      ASSERT_NOT_EQUAL(res.m_segEnd.GetAltitude(), feature::kInvalidAltitude, ());
-
-      res.m_projPoint = Junction(pt, projPointAlt);
+      FillCandidate(featureId, static_cast<uint32_t>(i - 1), junctions[i - 1], junctions[i], pt, d,
+                    bidirectional, res);
     }
   }
 
@@ -69,6 +42,63 @@ void NearestEdgeFinder::AddInformationSource(FeatureID const & featureId,
     m_candidates.push_back(res);
 }
 
+void NearestEdgeFinder::AddSegment(FeatureID const & featureId, uint32_t segId,
+                                   Junction const & segStart, Junction const & segEnd,
+                                   bool bidirectional)
+{
+  m2::ParametrizedSegment<m2::PointD> segment(segStart.GetPoint(), segEnd.GetPoint());
+  m2::PointD const pt = segment.ClosestPointTo(m_point);
+  double const d = m_point.SquaredLength(pt);
+
+  auto const it = m_featureToCandidate.find(featureId);
+  if (it == m_featureToCandidate.cend())
+  {
+    m_featureToCandidate.emplace(featureId, m_candidates.size());
+    m_candidates.emplace_back();
+    FillCandidate(featureId, segId, segStart, segEnd, pt, d, bidirectional, m_candidates.back());
+    return;
+  }
+
+  // The first closest segment is chosen as in AddInformationSource().
+  Candidate & res = m_candidates[it->second];
+  if (d < res.m_dist || (d == res.m_dist && segId < res.m_segId))
+    FillCandidate(featureId, segId, segStart, segEnd, pt, d, bidirectional, res);
+}
+
+void NearestEdgeFinder::FillCandidate(FeatureID const & featureId, uint32_t segId,
+                                      Junction const & segStart, Junction const & segEnd,
+                                      m2::PointD const & projPoint, double squaredDist,
+                                      bool bidirectional, Candidate & res) const
+{
+  feature::TAltitude const startAlt = segStart.GetAltitude();
+  feature::TAltitude const endAlt = segEnd.GetAltitude();
+
+  double const segLenM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), segEnd.GetPoint());
+  feature::TAltitude projPointAlt = feature::kDefaultAltitudeMeters;
+  if (segLenM == 0.0)
+  {
+    projPointAlt = startAlt;
+  }
+  else
+  {
+    double const distFromStartM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), projPoint);
+    ASSERT_LESS_OR_EQUAL(distFromStartM, segLenM, (featureId));
+    projPointAlt = startAlt + static_cast<feature::TAltitude>((endAlt - startAlt) * distFromStartM / segLenM);
+  }
+
+  res.m_dist = squaredDist;
+  res.m_fid = featureId;
+  res.m_segId = segId;
+  res.m_segStart = segStart;
+  res.m_segEnd = segEnd;
+  res.m_bidirectional = bidirectional;
+
+  ASSERT_NOT_EQUAL(res.m_segStart.GetAltitude() , feature::kInvalidAltitude, ());
+  ASSERT_NOT_EQUAL(res.m_segEnd.GetAltitude(), feature::kInvalidAltitude, ());
+
+  res.m_projPoint = Junction(projPoint, projPointAlt);
+}
+
 void NearestEdgeFinder::MakeResult(vector<pair<Edge, Junction>> & res, size_t const maxCountFeatures)
 {
   sort(m_candidates.begin(), m_candidates.end(), [](Candidate const & r1, Candidate const & r2)
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -34,8 +35,14 @@ class NearestEdgeFinder
     bool m_bidirectional = true;
   };
 
+  void FillCandidate(FeatureID const & featureId, uint32_t segId, Junction const & segStart,
+                     Junction const & segEnd, m2::PointD const & projPoint, double squaredDist,
+                     bool bidirectional, Candidate & res) const;
+
   m2::PointD const m_point;
   std::vector<Candidate> m_candidates;
+  // Indices of |m_candidates| of features added with AddSegment().
+  std::map<FeatureID, size_t> m_featureToCandidate;
 
 public:
   explicit NearestEdgeFinder(m2::PointD const & point);
@@ -46,6 +53,12 @@ public:
                             IRoadGraph::JunctionVec const & junctions,
                             bool bidirectiona);
 
+  /// Adds segment |segId| from |segStart| to |segEnd| of feature |featureId|. Only the closest
+  /// segment of a feature is kept, so segments of a feature may be added in any order and
+  /// several times. Features should be added with either AddSegment() or AddInformationSource().
+  void AddSegment(FeatureID const & featureId, uint32_t segId, Junction const & segStart,
+                  Junction const & segEnd, bool bidirectional);
+
   void MakeResult(std::vector<std::pair<Edge, Junction>> & res, size_t const maxCountFeatures);
 };
 }  // namespace routing
@@ -27,6 +27,22 @@ void PrintKV(ostringstream & oss, KV const & kvs, size_t maxKVToShow)
   if (kvs.size() > maxKVToShow)
     oss << ", ...";
 }
+
+template <typename Key>
+routing::RoadAccess::Type FindType(vector<pair<Key, routing::RoadAccess::Type>> const & sortedTypes, Key key)
+{
+  if (sortedTypes.empty())
+    return routing::RoadAccess::Type::Yes;
+
+  auto const it = lower_bound(sortedTypes.cbegin(), sortedTypes.cend(), key,
+                              [](pair<Key, routing::RoadAccess::Type> const & item, Key const & k) {
+                                return item.first < k;
+                              });
+  if (it != sortedTypes.cend() && it->first == key)
+    return it->second;
+
+  return routing::RoadAccess::Type::Yes;
+}
 }  // namespace
 
 namespace routing
@@ -34,22 +50,24 @@ namespace routing
 // RoadAccess --------------------------------------------------------------------------------------
 RoadAccess::Type RoadAccess::GetFeatureType(uint32_t featureId) const
 {
-// todo(@m) This may or may not be too slow. Consider profiling this and using
-// a Bloom filter or anything else that is faster than std::map.
-  auto const it = m_featureTypes.find(featureId);
-  if (it != m_featureTypes.cend())
-    return it->second;
-
-  return RoadAccess::Type::Yes;
+  return FindType(m_sortedFeatureTypes, featureId);
 }
 
 RoadAccess::Type RoadAccess::GetPointType(RoadPoint const & point) const
 {
-  auto const it = m_pointTypes.find(point);
-  if (it != m_pointTypes.cend())
-    return it->second;
+  return FindType(m_sortedPointTypes, GetPointKey(point));
+}
+
+void RoadAccess::BuildSortedTypes()
+{
+  m_sortedFeatureTypes.assign(m_featureTypes.cbegin(), m_featureTypes.cend());
+  sort(m_sortedFeatureTypes.begin(), m_sortedFeatureTypes.end());
 
-  return RoadAccess::Type::Yes;
+  m_sortedPointTypes.clear();
+  m_sortedPointTypes.reserve(m_pointTypes.size());
+  for (auto const & kv : m_pointTypes)
+    m_sortedPointTypes.emplace_back(GetPointKey(kv.first), kv.second);
+  sort(m_sortedPointTypes.begin(), m_sortedPointTypes.end());
 }
 
 bool RoadAccess::operator==(RoadAccess const & rhs) const
@@ -59,6 +59,7 @@ public:
   {
     m_featureTypes = std::forward<MF>(mf);
     m_pointTypes = std::forward<MP>(mp);
+    BuildSortedTypes();
   }
 
   void Clear();
@@ -71,14 +72,28 @@ public:
   void SetFeatureTypesForTests(MF && mf)
   {
     m_featureTypes = std::forward<MF>(mf);
+    BuildSortedTypes();
   }
 
 private:
+  static uint64_t GetPointKey(RoadPoint const & point)
+  {
+    return (static_cast<uint64_t>(point.GetFeatureId()) << 32) + point.GetPointId();
+  }
+
+  void BuildSortedTypes();
+
   // If segmentIdx of a key in this map is 0, it means the
   // entire feature has the corresponding access type.
   // Otherwise, the information is about the segment with number (segmentIdx-1).
   std::unordered_map<uint32_t, RoadAccess::Type> m_featureTypes;
   std::unordered_map<RoadPoint, RoadAccess::Type, RoadPoint::Hash> m_pointTypes;
+
+  // |m_featureTypes| and |m_pointTypes| sorted by feature ids and point keys (see GetPointKey())
+  // for lookups on every edge expansion. Types are rare, so binary search in a small contiguous
+  // array is cheaper than hashing and roads of mwms without types cost an emptiness check only.
+  std::vector<std::pair<uint32_t, RoadAccess::Type>> m_sortedFeatureTypes;
+  std::vector<std::pair<uint64_t, RoadAccess::Type>> m_sortedPointTypes;
 };
 
 std::string ToString(RoadAccess::Type type);
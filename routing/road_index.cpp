@@ -2,6 +2,8 @@
 
 #include "routing/routing_exceptions.hpp"
 
+#include "std/numeric.hpp"
+
 namespace routing
 {
 void RoadIndex::Import(vector<Joint> const & joints)
@@ -10,20 +12,50 @@ void RoadIndex::Import(vector<Joint> const & joints)
   {
     Joint const & joint = joints[jointId];
     for (uint32_t i = 0; i < joint.GetSize(); ++i)
-    {
-      RoadPoint const & entry = joint.GetEntry(i);
-      RoadJointIds & roadJoints = m_roads[entry.GetFeatureId()];
-      roadJoints.AddJoint(entry.GetPointId(), jointId);
-    }
+      AddJoint(joint.GetEntry(i), jointId);
   }
 }
 
+void RoadIndex::AddJoint(RoadPoint const & rp, Joint::Id jointId)
+{
+  ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
+
+  vector<Joint::Id> & jointIds = m_addedRoads[rp.GetFeatureId()];
+  uint32_t const pointId = rp.GetPointId();
+  if (pointId >= jointIds.size())
+    jointIds.insert(jointIds.end(), pointId + 1 - jointIds.size(), Joint::kInvalidId);
+
+  ASSERT_EQUAL(jointIds[pointId], Joint::kInvalidId, ());
+  jointIds[pointId] = jointId;
+}
+
+void RoadIndex::Build()
+{
+  uint32_t numFeatures = 0;
+  for (auto const & road : m_addedRoads)
+    numFeatures = max(numFeatures, road.first + 1);
+
+  // offsets[featureId + 1] is the number of joint ids of |featureId| before partial_sum().
+  vector<uint32_t> offsets(numFeatures + 1, 0);
+  for (auto const & road : m_addedRoads)
+    offsets[road.first + 1] = base::checked_cast<uint32_t>(road.second.size());
+  partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  vector<Joint::Id> jointIds(offsets.back(), Joint::kInvalidId);
+  for (auto const & road : m_addedRoads)
+    copy(road.second.cbegin(), road.second.cend(), jointIds.begin() + offsets[road.first]);
+
+  m_numRoads = base::checked_cast<uint32_t>(m_addedRoads.size());
+  m_offsets.steal(offsets);
+  m_jointIds.steal(jointIds);
+  m_addedRoads.clear();
+}
+
 pair<Joint::Id, uint32_t> RoadIndex::FindNeighbor(RoadPoint const & rp, bool forward) const
 {
-  auto const it = m_roads.find(rp.GetFeatureId());
-  if (it == m_roads.cend())
+  if (!IsRoad(rp.GetFeatureId()))
     MYTHROW(RoutingException, ("RoadIndex doesn't contains feature", rp.GetFeatureId()));
 
-  return it->second.FindNeighbor(rp.GetPointId(), forward);
+  return MakeRoad(rp.GetFeatureId()).FindNeighbor(rp.GetPointId(), forward);
 }
 }  // namespace routing
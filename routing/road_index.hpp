@@ -2,6 +2,9 @@
 
 #include "routing/joint.hpp"
 
+#include "coding/succinct_mapper.hpp"
+
+#include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 
 #include "std/algorithm.hpp"
@@ -12,18 +15,18 @@
 
 namespace routing
 {
+// Joint ids of a road indexed by point id. If some point id doesn't match any joint id,
+// the joint id is Joint::kInvalidId.
+// RoadJointIds doesn't own the joint ids, they are kept by RoadIndex.
 class RoadJointIds final
 {
 public:
-  void Init(uint32_t maxPointId)
-  {
-    m_jointIds.clear();
-    m_jointIds.reserve(maxPointId + 1);
-  }
+  RoadJointIds() = default;
+  RoadJointIds(Joint::Id const * jointIds, uint32_t size) : m_jointIds(jointIds), m_size(size) {}
 
   Joint::Id GetJointId(uint32_t pointId) const
   {
-    if (pointId < m_jointIds.size())
+    if (pointId < m_size)
       return m_jointIds[pointId];
 
     return Joint::kInvalidId;
@@ -31,31 +34,20 @@ public:
 
   Joint::Id GetEndingJointId() const
   {
-    if (m_jointIds.empty())
+    if (m_size == 0)
       return Joint::kInvalidId;
 
-    ASSERT_NOT_EQUAL(m_jointIds.back(), Joint::kInvalidId, ());
-    return m_jointIds.back();
-  }
-
-  void AddJoint(uint32_t pointId, Joint::Id jointId)
-  {
-    ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
-
-    if (pointId >= m_jointIds.size())
-      m_jointIds.insert(m_jointIds.end(), pointId + 1 - m_jointIds.size(), Joint::kInvalidId);
-
-    ASSERT_EQUAL(m_jointIds[pointId], Joint::kInvalidId, ());
-    m_jointIds[pointId] = jointId;
+    ASSERT_NOT_EQUAL(m_jointIds[m_size - 1], Joint::kInvalidId, ());
+    return m_jointIds[m_size - 1];
   }
 
   uint32_t GetJointsNumber() const
   {
     uint32_t count = 0;
 
-    for (Joint::Id const jointId : m_jointIds)
+    for (uint32_t pointId = 0; pointId < m_size; ++pointId)
     {
-      if (jointId != Joint::kInvalidId)
+      if (m_jointIds[pointId] != Joint::kInvalidId)
         ++count;
     }
 
@@ -65,7 +57,7 @@ public:
   template <typename F>
   void ForEachJoint(F && f) const
   {
-    for (uint32_t pointId = 0; pointId < m_jointIds.size(); ++pointId)
+    for (uint32_t pointId = 0; pointId < m_size; ++pointId)
     {
       Joint::Id const jointId = m_jointIds[pointId];
       if (jointId != Joint::kInvalidId)
@@ -75,7 +67,7 @@ public:
 
   pair<Joint::Id, uint32_t> FindNeighbor(uint32_t pointId, bool forward) const
   {
-    uint32_t const size = static_cast<uint32_t>(m_jointIds.size());
+    uint32_t const size = m_size;
     pair<Joint::Id, uint32_t> result = make_pair(Joint::kInvalidId, 0);
 
     if (forward)
@@ -107,33 +99,35 @@ public:
   }
 
 private:
-  // Joint ids indexed by point id.
-  // If some point id doesn't match any joint id, this vector contains Joint::kInvalidId.
-  vector<Joint::Id> m_jointIds;
+  Joint::Id const * m_jointIds = nullptr;
+  uint32_t m_size = 0;
 };
 
+// RoadIndex contains mapping from feature id to RoadJointIds.
+//
+// Joints are added by Import(), AddJoint() and PushFromSerializer(). Build() packs them
+// into two flat arrays: the index may be queried after Build() only. The arrays may be mapped
+// from memory instead of building (see map()) because they don't contain any pointers.
 class RoadIndex final
 {
 public:
   void Import(vector<Joint> const & joints);
 
-  void AddJoint(RoadPoint const & rp, Joint::Id jointId)
-  {
-    m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
-  }
+  void AddJoint(RoadPoint const & rp, Joint::Id jointId);
+
+  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp) { AddJoint(rp, jointId); }
 
-  bool IsRoad(uint32_t featureId) const { return m_roads.count(featureId) != 0; }
+  void Build();
 
-  RoadJointIds const & GetRoad(uint32_t featureId) const
+  bool IsRoad(uint32_t featureId) const
   {
-    auto const & it = m_roads.find(featureId);
-    CHECK(it != m_roads.cend(), ("Feature id:", featureId));
-    return it->second;
+    return HasRange(featureId) && m_offsets[featureId] != m_offsets[featureId + 1];
   }
 
-  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
+  RoadJointIds GetRoad(uint32_t featureId) const
   {
-    m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
+    CHECK(IsRoad(featureId), ("Feature id:", featureId));
+    return MakeRoad(featureId);
   }
 
   // Find nearest point with normal joint id.
@@ -143,26 +137,52 @@ public:
   // If there is no nearest point, return {Joint::kInvalidId, 0}
   pair<Joint::Id, uint32_t> FindNeighbor(RoadPoint const & rp, bool forward) const;
 
-  uint32_t GetSize() const { return base::asserted_cast<uint32_t>(m_roads.size()); }
+  uint32_t GetSize() const { return m_numRoads; }
 
   Joint::Id GetJointId(RoadPoint const & rp) const
   {
-    auto const it = m_roads.find(rp.GetFeatureId());
-    if (it == m_roads.end())
+    uint32_t const featureId = rp.GetFeatureId();
+    if (!HasRange(featureId))
       return Joint::kInvalidId;
 
-    return it->second.GetJointId(rp.GetPointId());
+    return MakeRoad(featureId).GetJointId(rp.GetPointId());
   }
 
   template <typename F>
   void ForEachRoad(F && f) const
   {
-    for (auto const & it : m_roads)
-      f(it.first, it.second);
+    for (uint32_t featureId = 0; HasRange(featureId); ++featureId)
+    {
+      if (IsRoad(featureId))
+        f(featureId, MakeRoad(featureId));
+    }
+  }
+
+  template <typename Visitor>
+  void map(Visitor & visitor)
+  {
+    visitor(m_numRoads, "numRoads")(m_offsets, "offsets")(m_jointIds, "jointIds");
   }
 
 private:
-  // Map from feature id to RoadJointIds.
-  unordered_map<uint32_t, RoadJointIds> m_roads;
+  bool HasRange(uint32_t featureId) const
+  {
+    return static_cast<uint64_t>(featureId) + 1 < m_offsets.size();
+  }
+
+  RoadJointIds MakeRoad(uint32_t featureId) const
+  {
+    uint32_t const begin = m_offsets[featureId];
+    return RoadJointIds(m_jointIds.data() + begin, m_offsets[featureId + 1] - begin);
+  }
+
+  // Joint ids of roads which are added but not built yet indexed by point id.
+  unordered_map<uint32_t, vector<Joint::Id>> m_addedRoads;
+
+  uint32_t m_numRoads = 0;
+  // Joint ids of feature |featureId| are m_jointIds[m_offsets[featureId]]
+  // ... m_jointIds[m_offsets[featureId + 1] - 1]. Ranges of non-road features are empty.
+  succinct::mapper::mappable_vector<uint32_t> m_offsets;
+  succinct::mapper::mappable_vector<Joint::Id> m_jointIds;
 };
 }  // namespace routing
@@ -0,0 +1,23 @@
+#include "routing/road_segment_index.hpp"
+
+namespace routing
+{
+using namespace std;
+
+// static
+double constexpr RoadSegmentIndex::kCellSize;
+size_t constexpr RoadSegmentIndex::kMaxNumCells;
+
+vector<RoadSegmentIndex::RoadSegment> const & RoadSegmentIndex::GetCell(int32_t x, int32_t y)
+{
+  uint64_t const key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+                       static_cast<uint32_t>(y);
+  auto const res = m_cells.emplace(key, vector<RoadSegment>());
+  if (res.second)
+  {
+    m2::RectD const rect(x * kCellSize, y * kCellSize, (x + 1) * kCellSize, (y + 1) * kCellSize);
+    m_loader(rect, res.first->second);
+  }
+  return res.first->second;
+}
+}  // namespace routing
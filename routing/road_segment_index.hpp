@@ -0,0 +1,79 @@
+#pragma once
+
+#include "routing/road_graph.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+// Lazily built grid of road segments of one mwm. A cell of the grid is filled with the segments
+// of the roads crossing the cell on the first query of the cell. So following queries around the
+// same places don't load and decode features.
+class RoadSegmentIndex final
+{
+public:
+  struct RoadSegment
+  {
+    uint32_t m_featureId = 0;
+    uint32_t m_segId = 0;
+    Junction m_start;
+    Junction m_end;
+    bool m_bidirectional = true;
+  };
+
+  // Fills |segments| with the segments of roads which intersect |rect|.
+  using CellLoader = std::function<void(m2::RectD const & rect, std::vector<RoadSegment> & segments)>;
+
+  // About 500 meters on the equator.
+  static double constexpr kCellSize = 0.005;
+  // The index is cleared when it gets more cells.
+  static size_t constexpr kMaxNumCells = 256;
+
+  explicit RoadSegmentIndex(CellLoader const & loader) : m_loader(loader) {}
+
+  // Calls |fn| for every segment of the cells intersecting |rect|. A segment crossing several
+  // cells is passed once per cell.
+  template <typename Fn>
+  void ForEachInRect(m2::RectD const & rect, Fn && fn)
+  {
+    int32_t const minX = GetCellCoord(rect.minX());
+    int32_t const maxX = GetCellCoord(rect.maxX());
+    int32_t const minY = GetCellCoord(rect.minY());
+    int32_t const maxY = GetCellCoord(rect.maxY());
+
+    if (m_cells.size() + static_cast<size_t>(maxX - minX + 1) * (maxY - minY + 1) > kMaxNumCells)
+      m_cells.clear();
+
+    for (int32_t x = minX; x <= maxX; ++x)
+    {
+      for (int32_t y = minY; y <= maxY; ++y)
+      {
+        for (RoadSegment const & segment : GetCell(x, y))
+          fn(segment);
+      }
+    }
+  }
+
+  size_t GetNumCells() const { return m_cells.size(); }
+  void Clear() { m_cells.clear(); }
+
+private:
+  static int32_t GetCellCoord(double coord)
+  {
+    return static_cast<int32_t>(std::floor(coord / kCellSize));
+  }
+
+  std::vector<RoadSegment> const & GetCell(int32_t x, int32_t y);
+
+  CellLoader m_loader;
+  std::unordered_map<uint64_t, std::vector<RoadSegment>> m_cells;
+};
+}  // namespace routing
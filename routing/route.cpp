@@ -1,5 +1,7 @@
 #include "routing/route.hpp"
 
+#include "routing/edge_estimator.hpp"
+#include "routing/traffic_stash.hpp"
 #include "routing/turns_generator.hpp"
 
 #include "traffic/speed_groups.hpp"
@@ -119,6 +121,28 @@ double Route::GetCurrentTimeToEndSec() const
                        m_poly.GetDistFromCurPointToRoutePointMeters() / curSegSpeedMPerS);
 }
 
+void Route::UpdateTraffic(TrafficStash const & trafficStash)
+{
+  double prevTimeS = 0.0;
+  double timeFromBeginningS = 0.0;
+  for (auto & routeSegment : m_routeSegments)
+  {
+    double segmentTimeS = routeSegment.GetTimeFromBeginningSec() - prevTimeS;
+    prevTimeS = routeSegment.GetTimeFromBeginningSec();
+
+    SpeedGroup speedGroup = routeSegment.GetTraffic();
+    if (routeSegment.IsRealSegment())
+    {
+      speedGroup = trafficStash.GetSpeedGroup(routeSegment.GetSegment());
+      segmentTimeS *= EdgeEstimator::CalcCarTrafficFactor(speedGroup) /
+                      EdgeEstimator::CalcCarTrafficFactor(routeSegment.GetTraffic());
+    }
+
+    timeFromBeginningS += segmentTimeS;
+    routeSegment.SetTraffic(speedGroup, timeFromBeginningS);
+  }
+}
+
 void Route::GetCurrentStreetName(string & name) const
 {
   GetStreetNameAfterIdx(static_cast<uint32_t>(m_poly.GetCurrentIter().m_ind), name);
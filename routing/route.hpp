@@ -32,6 +32,8 @@ namespace location
 
 namespace routing
 {
+class TrafficStash;
+
 using SubrouteUid = uint64_t;
 SubrouteUid constexpr kInvalidSubrouteId = std::numeric_limits<uint64_t>::max();
 
@@ -96,6 +98,12 @@ public:
   bool HasTransitInfo() const { return m_transitInfo.HasTransitInfo(); }
   TransitInfo const & GetTransitInfo() const { return m_transitInfo.Get(); }
 
+  void SetTraffic(traffic::SpeedGroup traffic, double timeFromBeginningS)
+  {
+    m_traffic = traffic;
+    m_timeFromBeginningS = timeFromBeginningS;
+  }
+
   void SetSpeedCameraInfo(std::vector<SpeedCamera> && data) { m_speedCameras = std::move(data); }
   bool IsRealSegment() const { return m_segment.IsRealSegment(); }
   std::vector<SpeedCamera> const & GetSpeedCams() const { return m_speedCameras; }
@@ -279,6 +287,13 @@ public:
   /// \returns estimated time to reach the route end.
   double GetCurrentTimeToEndSec() const;
 
+  /// \brief Sets the speed groups of |trafficStash| to the real segments of the route and
+  /// recalculates the times of the segments with them. The time of a segment is scaled by
+  /// the ratio of the car traffic factors of the new and the old speed groups, so the route
+  /// ETA follows the traffic without rebuilding the route.
+  /// \note |trafficStash| should contain the traffic, see TrafficStash::Guard.
+  void UpdateTraffic(TrafficStash const & trafficStash);
+
   FollowedPolyline const & GetFollowedPolyline() const { return m_poly; }
 
   std::string const & GetRouterId() const { return m_router; }
@@ -368,6 +383,7 @@ public:
 
   void GetTurnsForTesting(std::vector<turns::TurnItem> & turns) const;
   bool IsRouteId(uint64_t routeId) const { return routeId == m_routeId; }
+  uint64_t GetRouteId() const { return m_routeId; }
 
   /// \returns Length of the route segment with |segIdx| in meters.
   double GetSegLenMeters(size_t segIdx) const;
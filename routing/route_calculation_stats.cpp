@@ -0,0 +1,67 @@
+#include "routing/route_calculation_stats.hpp"
+
+#include "base/assert.hpp"
+
+namespace routing
+{
+using namespace std;
+
+// RouteCalculationStats::ScopedPhase --------------------------------------------------------------
+RouteCalculationStats::ScopedPhase::ScopedPhase(RouteCalculationStats & stats, Phase phase)
+  : m_stats(stats)
+  , m_phase(phase)
+  , m_parent(stats.m_currentPhase)
+  , m_allocations(stats.GetAllocations())
+{
+  CHECK_LESS(m_phase, Phase::Count, ());
+  m_stats.m_currentPhase = this;
+}
+
+RouteCalculationStats::ScopedPhase::~ScopedPhase()
+{
+  double const seconds = m_timer.ElapsedSeconds();
+  uint64_t const allocations = m_stats.GetAllocations() - m_allocations;
+
+  auto & phaseStats = m_stats.m_phases[static_cast<size_t>(m_phase)];
+  phaseStats.m_seconds += seconds - m_nestedSeconds;
+  ++phaseStats.m_calls;
+  phaseStats.m_allocations += allocations - m_nestedAllocations;
+
+  if (m_parent)
+  {
+    m_parent->m_nestedSeconds += seconds;
+    m_parent->m_nestedAllocations += allocations;
+  }
+  m_stats.m_currentPhase = m_parent;
+}
+
+// RouteCalculationStats ---------------------------------------------------------------------------
+void RouteCalculationStats::Clear()
+{
+  CHECK(!m_currentPhase, ("Stats can't be cleared while a phase is measured."));
+  m_phases = {};
+  m_visitedVertices = 0;
+}
+
+double RouteCalculationStats::GetTotalSeconds() const
+{
+  double seconds = 0.0;
+  for (auto const & phase : m_phases)
+    seconds += phase.m_seconds;
+  return seconds;
+}
+
+string DebugPrint(RouteCalculationStats::Phase phase)
+{
+  switch (phase)
+  {
+  case RouteCalculationStats::Phase::NearestEdges: return "NearestEdges";
+  case RouteCalculationStats::Phase::Leaps: return "Leaps";
+  case RouteCalculationStats::Phase::AStar: return "AStar";
+  case RouteCalculationStats::Phase::RouteReconstruction: return "RouteReconstruction";
+  case RouteCalculationStats::Phase::Directions: return "Directions";
+  case RouteCalculationStats::Phase::Count: return "Count";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace routing
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace routing
+{
+// Durations and counters of phases of the last route calculation. Used for benchmarks.
+class RouteCalculationStats final
+{
+public:
+  enum class Phase
+  {
+    NearestEdges,         // Search of the best segments for checkpoints.
+    Leaps,                // A* with leaps and routes through mwms instead of the leaps.
+    AStar,                // A* without leaps.
+    RouteReconstruction,  // Times and other attributes of the route segments.
+    Directions,           // Turns, street names and geometry of the route.
+    Count
+  };
+
+  struct PhaseStats
+  {
+    double m_seconds = 0.0;
+    uint32_t m_calls = 0;
+    // Zero if there's no allocation counter.
+    uint64_t m_allocations = 0;
+  };
+
+  // Returns number of memory allocations done by the process so far.
+  using AllocationCounter = std::function<uint64_t()>;
+
+  // Measures the phase from construction to destruction. Phases may be nested, time and
+  // allocations of a nested phase are excluded from the enclosing phase.
+  class ScopedPhase final
+  {
+  public:
+    ScopedPhase(RouteCalculationStats & stats, Phase phase);
+    ~ScopedPhase();
+
+  private:
+    RouteCalculationStats & m_stats;
+    Phase const m_phase;
+    ScopedPhase * const m_parent;
+    uint64_t const m_allocations;
+    double m_nestedSeconds = 0.0;
+    uint64_t m_nestedAllocations = 0;
+    base::Timer m_timer;
+  };
+
+  void SetAllocationCounter(AllocationCounter const & counter) { m_allocationCounter = counter; }
+
+  // Clears the stats but not the allocation counter.
+  void Clear();
+
+  void AddVisitedVertices(uint64_t count) { m_visitedVertices += count; }
+
+  PhaseStats const & GetPhaseStats(Phase phase) const
+  {
+    return m_phases[static_cast<size_t>(phase)];
+  }
+  uint64_t GetVisitedVertices() const { return m_visitedVertices; }
+  double GetTotalSeconds() const;
+
+private:
+  uint64_t GetAllocations() const { return m_allocationCounter ? m_allocationCounter() : 0; }
+
+  std::array<PhaseStats, static_cast<size_t>(Phase::Count)> m_phases;
+  uint64_t m_visitedVertices = 0;
+  AllocationCounter m_allocationCounter;
+  // The innermost measured phase.
+  ScopedPhase * m_currentPhase = nullptr;
+};
+
+std::string DebugPrint(RouteCalculationStats::Phase phase);
+}  // namespace routing
@@ -0,0 +1,7 @@
+#include "routing/route_matrix.hpp"
+
+namespace routing
+{
+// static
+double constexpr RouteMatrix::kNoRoute;
+}  // namespace routing
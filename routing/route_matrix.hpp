@@ -0,0 +1,65 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+// Weights (seconds) and optionally geometry of routes from every source to every target.
+class RouteMatrix final
+{
+public:
+  static double constexpr kNoRoute = std::numeric_limits<double>::max();
+
+  RouteMatrix() = default;
+  RouteMatrix(size_t numSources, size_t numTargets, bool hasGeometry)
+    : m_numSources(numSources)
+    , m_numTargets(numTargets)
+    , m_weights(numSources * numTargets, kNoRoute)
+  {
+    if (hasGeometry)
+      m_geometry.resize(numSources * numTargets);
+  }
+
+  size_t GetNumSources() const { return m_numSources; }
+  size_t GetNumTargets() const { return m_numTargets; }
+  bool HasGeometry() const { return !m_geometry.empty(); }
+
+  // Returns kNoRoute if there's no route from |source| to |target|.
+  double GetWeight(size_t source, size_t target) const { return m_weights[GetIndex(source, target)]; }
+  void SetWeight(size_t source, size_t target, double weight)
+  {
+    m_weights[GetIndex(source, target)] = weight;
+  }
+
+  std::vector<m2::PointD> const & GetGeometry(size_t source, size_t target) const
+  {
+    ASSERT(HasGeometry(), ());
+    return m_geometry[GetIndex(source, target)];
+  }
+
+  std::vector<m2::PointD> & GetGeometry(size_t source, size_t target)
+  {
+    ASSERT(HasGeometry(), ());
+    return m_geometry[GetIndex(source, target)];
+  }
+
+private:
+  size_t GetIndex(size_t source, size_t target) const
+  {
+    ASSERT_LESS(source, m_numSources, ());
+    ASSERT_LESS(target, m_numTargets, ());
+    return source * m_numTargets + target;
+  }
+
+  size_t m_numSources = 0;
+  size_t m_numTargets = 0;
+  std::vector<double> m_weights;
+  std::vector<std::vector<m2::PointD>> m_geometry;
+};
+}  // namespace routing
@@ -0,0 +1,199 @@
+#include "routing/router_pool.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+// RouterPool::QueuedRequest -----------------------------------------------------------------------
+bool RouterPool::QueuedRequest::operator<(QueuedRequest const & rhs) const
+{
+  return make_tuple(-static_cast<int64_t>(m_request.m_priority), m_request.m_deadline, m_id) <
+         make_tuple(-static_cast<int64_t>(rhs.m_request.m_priority), rhs.m_request.m_deadline,
+                    rhs.m_id);
+}
+
+// RouterPool --------------------------------------------------------------------------------------
+RouterPool::RouterPool(size_t numRouters, RouterFactory const & routerFactory,
+                       ResultCallback const & resultCallback)
+  : m_resultCallback(resultCallback)
+{
+  CHECK_GREATER(numRouters, 0, ());
+  CHECK(routerFactory, ());
+  CHECK(m_resultCallback, ());
+
+  m_workers.reserve(numRouters);
+  for (size_t i = 0; i < numRouters; ++i)
+  {
+    auto worker = make_unique<Worker>();
+    worker->m_router = routerFactory();
+    CHECK(worker->m_router, ());
+    m_workers.push_back(move(worker));
+  }
+
+  // Threads are started when all the workers are created so |m_workers| isn't changed
+  // while the threads read it.
+  for (auto & worker : m_workers)
+    worker->m_thread = threads::SimpleThread(&RouterPool::ThreadFunc, this, ref(*worker));
+}
+
+RouterPool::~RouterPool()
+{
+  set<QueuedRequest> queue;
+  {
+    lock_guard<mutex> lock(m_guard);
+    m_exit = true;
+    for (auto & worker : m_workers)
+    {
+      if (worker->m_delegate)
+        worker->m_delegate->Cancel();
+    }
+    queue.swap(m_queue);
+  }
+  m_cv.notify_all();
+
+  for (auto & worker : m_workers)
+    worker->m_thread.join();
+
+  auto const now = Clock::now();
+  for (auto const & request : queue)
+  {
+    Timings timings;
+    timings.m_queueSec = GetSeconds(now - request.m_enqueueTime);
+    Complete(request.m_id, RouterResultCode::Cancelled, make_shared<Route>("", request.m_id),
+             timings);
+  }
+}
+
+uint64_t RouterPool::CalculateRoute(Request const & request)
+{
+  QueuedRequest queued;
+  queued.m_request = request;
+  queued.m_enqueueTime = Clock::now();
+  {
+    lock_guard<mutex> lock(m_guard);
+    CHECK(!m_exit, ());
+    queued.m_id = ++m_requestCounter;
+    m_queue.insert(queued);
+  }
+  m_cv.notify_one();
+  return queued.m_id;
+}
+
+bool RouterPool::Cancel(uint64_t requestId)
+{
+  QueuedRequest cancelled;
+  {
+    lock_guard<mutex> lock(m_guard);
+    for (auto & worker : m_workers)
+    {
+      if (worker->m_delegate && worker->m_requestId == requestId)
+      {
+        worker->m_delegate->Cancel();
+        return true;
+      }
+    }
+
+    auto const it = find_if(m_queue.cbegin(), m_queue.cend(), [requestId](QueuedRequest const & r) {
+      return r.m_id == requestId;
+    });
+    if (it == m_queue.cend())
+      return false;
+
+    cancelled = *it;
+    m_queue.erase(it);
+  }
+
+  Timings timings;
+  timings.m_queueSec = GetSeconds(Clock::now() - cancelled.m_enqueueTime);
+  Complete(requestId, RouterResultCode::Cancelled, make_shared<Route>("", requestId), timings);
+  return true;
+}
+
+size_t RouterPool::GetQueueSize() const
+{
+  lock_guard<mutex> lock(m_guard);
+  return m_queue.size();
+}
+
+// static
+double RouterPool::GetSeconds(Clock::duration duration)
+{
+  return chrono::duration_cast<chrono::duration<double>>(duration).count();
+}
+
+void RouterPool::ThreadFunc(Worker & worker)
+{
+  while (true)
+  {
+    QueuedRequest request;
+    shared_ptr<DeadlineDelegate> delegate;
+    {
+      unique_lock<mutex> lock(m_guard);
+      worker.m_delegate.reset();
+      m_cv.wait(lock, [this] { return m_exit || !m_queue.empty(); });
+      if (m_exit)
+        return;
+
+      request = *m_queue.cbegin();
+      m_queue.erase(m_queue.cbegin());
+
+      delegate = make_shared<DeadlineDelegate>(request.m_request.m_deadline);
+      worker.m_requestId = request.m_id;
+      worker.m_delegate = delegate;
+    }
+
+    Calculate(worker, request, delegate);
+  }
+}
+
+void RouterPool::Calculate(Worker & worker, QueuedRequest const & request,
+                           shared_ptr<DeadlineDelegate> const & delegate)
+{
+  auto const startTime = Clock::now();
+  Timings timings;
+  timings.m_queueSec = GetSeconds(startTime - request.m_enqueueTime);
+
+  auto route = make_shared<Route>(worker.m_router->GetName(), request.m_id);
+  // Requests with expired deadlines are not calculated to let the queue catch up.
+  if (delegate->IsCancelled())
+  {
+    Complete(request.m_id, RouterResultCode::Cancelled, move(route), timings);
+    return;
+  }
+
+  RouterResultCode code = RouterResultCode::InternalError;
+  try
+  {
+    code = worker.m_router->CalculateRoute(request.m_request.m_checkpoints,
+                                           request.m_request.m_startDirection,
+                                           false /* adjustToPrevRoute */, *delegate, *route);
+  }
+  catch (RootException const & e)
+  {
+    code = RouterResultCode::InternalError;
+    LOG(LERROR, ("Exception happened while calculating route", request.m_id, ":", e.Msg()));
+  }
+
+  timings.m_computeSec = GetSeconds(Clock::now() - startTime);
+  if (code != RouterResultCode::NoError && delegate->IsCancelled())
+    code = RouterResultCode::Cancelled;
+
+  Complete(request.m_id, code, move(route), timings);
+}
+
+void RouterPool::Complete(uint64_t requestId, RouterResultCode code, shared_ptr<Route> route,
+                          Timings const & timings) const
+{
+  LOG(LDEBUG, ("Request", requestId, "is completed with", code, "queue seconds:",
+               timings.m_queueSec, "compute seconds:", timings.m_computeSec));
+  m_resultCallback(requestId, code, move(route), timings);
+}
+}  // namespace routing
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "routing/checkpoints.hpp"
+#include "routing/route.hpp"
+#include "routing/router.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/macros.hpp"
+#include "base/thread.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace routing
+{
+/// Calculates several routes at once with a pool of independent routers. Unlike AsyncRouter
+/// a new request doesn't cancel the previous ones, requests wait in a queue ordered by
+/// priority and deadline until a router is free. Intended for server side embedding, so
+/// callbacks are called on worker threads but not on the GUI thread.
+class RouterPool final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  /// Every router of the pool is created by the factory on construction of the pool.
+  /// Routers may share DataSource, NumMwmIds and other thread-safe data but not graphs or
+  /// caches, e.g. an IndexRouter per worker over one DataSource.
+  using RouterFactory = std::function<std::unique_ptr<IRouter>()>;
+
+  struct Request
+  {
+    Checkpoints m_checkpoints;
+    m2::PointD m_startDirection = m2::PointD::Zero();
+    /// Requests with greater priority are calculated first.
+    int32_t m_priority = 0;
+    /// Calculation is cancelled at the deadline. A request isn't calculated at all if it
+    /// waits in the queue until the deadline.
+    Clock::time_point m_deadline = Clock::time_point::max();
+  };
+
+  struct Timings
+  {
+    /// Time from CalculateRoute() call to the start of the calculation.
+    double m_queueSec = 0.0;
+    /// Time of the calculation. Zero if the request hasn't been calculated.
+    double m_computeSec = 0.0;
+  };
+
+  /// |route| is not null even if the route isn't found. The callback may be called
+  /// from several worker threads at once.
+  using ResultCallback = std::function<void(uint64_t requestId, RouterResultCode code,
+                                            std::shared_ptr<Route> route,
+                                            Timings const & timings)>;
+
+  RouterPool(size_t numRouters, RouterFactory const & routerFactory,
+             ResultCallback const & resultCallback);
+  /// Cancels calculated requests and completes queued requests with
+  /// RouterResultCode::Cancelled.
+  ~RouterPool();
+
+  /// Queues |request| and returns its id.
+  uint64_t CalculateRoute(Request const & request);
+
+  /// Removes the request from the queue or cancels its calculation. The result callback is
+  /// called for the request anyway. Returns false if there's no such queued or calculated
+  /// request.
+  bool Cancel(uint64_t requestId);
+
+  size_t GetNumRouters() const { return m_workers.size(); }
+  size_t GetQueueSize() const;
+
+private:
+  struct QueuedRequest
+  {
+    bool operator<(QueuedRequest const & rhs) const;
+
+    Request m_request;
+    uint64_t m_id = 0;
+    Clock::time_point m_enqueueTime;
+  };
+
+  /// RouterDelegate which is cancelled at the request deadline as well.
+  class DeadlineDelegate final : public RouterDelegate
+  {
+  public:
+    explicit DeadlineDelegate(Clock::time_point deadline) : m_deadline(deadline) {}
+
+    // RouterDelegate overrides:
+    bool IsCancelled() const override
+    {
+      return RouterDelegate::IsCancelled() || Clock::now() >= m_deadline;
+    }
+
+  private:
+    Clock::time_point const m_deadline;
+  };
+
+  struct Worker
+  {
+    std::unique_ptr<IRouter> m_router;
+    threads::SimpleThread m_thread;
+    /// Id and delegate of the calculated request. Guarded by RouterPool::m_guard.
+    uint64_t m_requestId = 0;
+    std::shared_ptr<DeadlineDelegate> m_delegate;
+  };
+
+  static double GetSeconds(Clock::duration duration);
+
+  void ThreadFunc(Worker & worker);
+  void Calculate(Worker & worker, QueuedRequest const & request,
+                 std::shared_ptr<DeadlineDelegate> const & delegate);
+  void Complete(uint64_t requestId, RouterResultCode code, std::shared_ptr<Route> route,
+                Timings const & timings) const;
+
+  ResultCallback const m_resultCallback;
+
+  mutable std::mutex m_guard;
+  std::condition_variable m_cv;
+  bool m_exit = false;
+  uint64_t m_requestCounter = 0;
+  /// Front request is calculated first.
+  std::set<QueuedRequest> m_queue;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  DISALLOW_COPY_AND_MOVE(RouterPool);
+};
+}  // namespace routing
@@ -0,0 +1,318 @@
+#include "routing/checkpoints.hpp"
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/route_calculation_stats.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+
+#include "storage/country_info_getter.hpp"
+#include "storage/country_parent_getter.hpp"
+#include "storage/routing_helpers.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+#include "base/stl_helpers.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "3party/gflags/src/gflags/gflags.h"
+#include "3party/jansson/myjansson.hpp"
+
+DEFINE_string(input, "", "File with routes, one route per line. A route is two or more points "
+                         "listed as latitude and longitude separated by comma. Points are "
+                         "separated by semicolon, e.g. 55.7558,37.6173;55.7963,37.5379");
+DEFINE_string(vehicles, "pedestrian,bicycle,car,transit",
+              "Comma separated vehicle types to build every route with.");
+DEFINE_string(output, "", "Path to the output file with a json object per route calculation. "
+                          "Standard output is used if empty.");
+DEFINE_int32(runs, 1, "Number of calculations of every route with every vehicle type.");
+DEFINE_bool(showHelp, false, "Show help on all flags.");
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+atomic<uint64_t> g_allocations(0);
+
+uint64_t GetAllocations() { return g_allocations.load(memory_order_relaxed); }
+
+using Waypoints = vector<m2::PointD>;
+
+struct Measurement
+{
+  RouterResultCode m_code = RouterResultCode::InternalError;
+  double m_seconds = 0.0;
+};
+
+class Benchmark
+{
+public:
+  Benchmark()
+  {
+    CHECK(m_cig, ());
+
+    classificator::Load();
+    vector<platform::LocalCountryFile> localFiles;
+    platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max(), localFiles);
+
+    for (auto const & localFile : localFiles)
+    {
+      UNUSED_VALUE(m_dataSource.RegisterMap(localFile));
+      auto const & countryFile = localFile.GetCountryFile();
+      auto const mwmId = m_dataSource.GetMwmIdByCountryFile(countryFile);
+      CHECK(mwmId.IsAlive(), ());
+      // We have to exclude minsk-pass because we can't register mwm which is not from
+      // countries.txt.
+      if (mwmId.GetInfo()->GetType() == MwmInfo::COUNTRY && countryFile.GetName() != "minsk-pass")
+        m_numMwmIds->RegisterFile(countryFile);
+    }
+  }
+
+  IndexRouter & GetRouter(VehicleType type)
+  {
+    CHECK_LESS(type, VehicleType::Count, ());
+    auto const & infoGetter = *m_cig;
+    auto & router = m_routers[base::Key(type)];
+    if (router)
+      return *router;
+
+    auto const countryFileGetter = [&infoGetter](m2::PointD const & pt) {
+      return infoGetter.GetRegionCountryId(pt);
+    };
+    auto const getMwmRectByName = [&infoGetter](string const & countryId) {
+      return infoGetter.GetLimitRectForLeaf(countryId);
+    };
+
+    router = make_unique<IndexRouter>(type, false /* load altitudes */, m_cpg, countryFileGetter,
+                                      getMwmRectByName, m_numMwmIds,
+                                      MakeNumMwmTree(*m_numMwmIds, infoGetter), m_trafficCache,
+                                      m_dataSource);
+    router->SetAllocationCounter(&GetAllocations);
+    return *router;
+  }
+
+  RouterDelegate const & GetDelegate() const { return m_delegate; }
+
+private:
+  DISALLOW_COPY_AND_MOVE(Benchmark);
+
+  FrozenDataSource m_dataSource;
+  shared_ptr<NumMwmIds> m_numMwmIds = make_shared<NumMwmIds>();
+  array<unique_ptr<IndexRouter>, base::Key(VehicleType::Count)> m_routers{};
+  storage::CountryParentGetter m_cpg;
+  unique_ptr<storage::CountryInfoGetter> m_cig =
+      storage::CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  traffic::TrafficCache m_trafficCache;
+  RouterDelegate m_delegate;
+};
+
+vector<Waypoints> ReadRoutes(string const & path)
+{
+  ifstream input(path);
+  CHECK(input.is_open(), ("Can't open", path));
+
+  vector<Waypoints> routes;
+  string line;
+  while (getline(input, line))
+  {
+    strings::Trim(line);
+    if (line.empty())
+      continue;
+
+    Waypoints route;
+    strings::Tokenize(line, ";", [&](string const & point) {
+      auto const coords = strings::Tokenize(point, ",");
+      CHECK_EQUAL(coords.size(), 2, ("Incorrect point", point, "of route", line));
+
+      double lat = 0.0;
+      double lon = 0.0;
+      CHECK(strings::to_double(coords[0], lat), ("Incorrect latitude", coords[0]));
+      CHECK(strings::to_double(coords[1], lon), ("Incorrect longitude", coords[1]));
+      CHECK(MercatorBounds::ValidLat(lat), ("Incorrect latitude", lat));
+      CHECK(MercatorBounds::ValidLon(lon), ("Incorrect longitude", lon));
+      route.push_back(MercatorBounds::FromLatLon(lat, lon));
+    });
+    CHECK_GREATER_OR_EQUAL(route.size(), 2, ("Route should have at least two points:", line));
+    routes.push_back(move(route));
+  }
+  return routes;
+}
+
+vector<VehicleType> ParseVehicleTypes(string const & vehicles)
+{
+  vector<VehicleType> types;
+  strings::Tokenize(vehicles, ",", [&types](string const & vehicle) {
+    VehicleType type = VehicleType::Count;
+    FromString(vehicle, type);
+    CHECK_LESS(type, VehicleType::Count, ("Unknown vehicle type", vehicle));
+    types.push_back(type);
+  });
+  return types;
+}
+
+base::JSONPtr SerializeStats(RouteCalculationStats const & stats)
+{
+  auto phases = base::NewJSONObject();
+  for (size_t i = 0; i < static_cast<size_t>(RouteCalculationStats::Phase::Count); ++i)
+  {
+    auto const phase = static_cast<RouteCalculationStats::Phase>(i);
+    auto const & phaseStats = stats.GetPhaseStats(phase);
+
+    auto phaseJson = base::NewJSONObject();
+    ToJSONObject(*phaseJson, "seconds", phaseStats.m_seconds);
+    ToJSONObject(*phaseJson, "calls", phaseStats.m_calls);
+    ToJSONObject(*phaseJson, "allocations", phaseStats.m_allocations);
+    ToJSONObject(*phases, DebugPrint(phase), move(phaseJson));
+  }
+  return phases;
+}
+
+void LogSummary(VehicleType type, vector<Measurement> const & measurements)
+{
+  vector<double> seconds;
+  for (auto const & measurement : measurements)
+  {
+    if (measurement.m_code == RouterResultCode::NoError)
+      seconds.push_back(measurement.m_seconds);
+  }
+
+  if (seconds.empty())
+  {
+    LOG(LINFO, (type, "calculations:", measurements.size(), "no routes are found."));
+    return;
+  }
+
+  sort(seconds.begin(), seconds.end());
+  double sum = 0.0;
+  for (double const s : seconds)
+    sum += s;
+
+  auto const percentile = [&seconds](double p) {
+    return seconds[min(seconds.size() - 1, static_cast<size_t>(p * seconds.size()))];
+  };
+
+  LOG(LINFO, (type, "calculations:", measurements.size(), "found:", seconds.size(),
+              "mean:", sum / seconds.size(), "median:", percentile(0.5), "p95:",
+              percentile(0.95), "max:", seconds.back()));
+}
+}  // namespace
+
+// Every allocation of the process is counted to report allocations of route calculation phases.
+void * operator new(size_t size)
+{
+  g_allocations.fetch_add(1, memory_order_relaxed);
+  if (void * p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw bad_alloc();
+}
+
+void * operator new[](size_t size) { return operator new(size); }
+void operator delete(void * p) noexcept { free(p); }
+void operator delete[](void * p) noexcept { free(p); }
+void operator delete(void * p, size_t) noexcept { free(p); }
+void operator delete[](void * p, size_t) noexcept { free(p); }
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Builds every route of |input| with every vehicle type of |vehicles| "
+                          "with maps of the writable directory and reports durations, visited "
+                          "vertices and allocations of route calculation phases, e.g. "
+                          "-input=routes.txt -vehicles=car,pedestrian -output=stats.jsonl");
+
+  if (argc == 1 || FLAGS_showHelp)
+  {
+    google::ShowUsageWithFlags(argv[0]);
+    return 0;
+  }
+
+  google::ParseCommandLineFlags(&argc, &argv, true /* remove_flags */);
+
+  CHECK(!FLAGS_input.empty(), ("Input file is not set."));
+  CHECK_GREATER(FLAGS_runs, 0, ());
+
+  auto const routes = ReadRoutes(FLAGS_input);
+  auto const vehicleTypes = ParseVehicleTypes(FLAGS_vehicles);
+
+  ofstream outputFile;
+  if (!FLAGS_output.empty())
+  {
+    outputFile.open(FLAGS_output);
+    CHECK(outputFile.is_open(), ("Can't open", FLAGS_output));
+  }
+  ostream & output = FLAGS_output.empty() ? cout : outputFile;
+
+  Benchmark benchmark;
+  for (VehicleType const type : vehicleTypes)
+  {
+    IndexRouter & router = benchmark.GetRouter(type);
+    vector<Measurement> measurements;
+    for (size_t routeIdx = 0; routeIdx < routes.size(); ++routeIdx)
+    {
+      for (int32_t run = 0; run < FLAGS_runs; ++run)
+      {
+        Route route("" /* router */, 0 /* routeId */);
+        base::Timer timer;
+        uint64_t const allocations = GetAllocations();
+
+        Measurement measurement;
+        measurement.m_code = router.CalculateRoute(Checkpoints(Waypoints(routes[routeIdx])),
+                                                   m2::PointD::Zero() /* startDirection */,
+                                                   false /* adjustToPrevRoute */,
+                                                   benchmark.GetDelegate(), route);
+        measurement.m_seconds = timer.ElapsedSeconds();
+        measurements.push_back(measurement);
+
+        auto const & stats = router.GetLastRouteStats();
+        auto json = base::NewJSONObject();
+        ToJSONObject(*json, "vehicle", ToString(type));
+        ToJSONObject(*json, "route", routeIdx);
+        ToJSONObject(*json, "run", run);
+        ToJSONObject(*json, "code", DebugPrint(measurement.m_code));
+        ToJSONObject(*json, "seconds", measurement.m_seconds);
+        ToJSONObject(*json, "allocations", GetAllocations() - allocations);
+        ToJSONObject(*json, "visited_vertices", stats.GetVisitedVertices());
+        if (measurement.m_code == RouterResultCode::NoError)
+        {
+          ToJSONObject(*json, "distance_m", route.GetTotalDistanceMeters());
+          ToJSONObject(*json, "eta_s", route.GetTotalTimeSec());
+        }
+        ToJSONObject(*json, "phases", SerializeStats(stats));
+
+        unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(json.get(), JSON_COMPACT));
+        output << buffer.get() << '\n';
+      }
+    }
+    LogSummary(type, measurements);
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/isochrone.hpp"
+#include "routing/router_delegate.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+m2::RectD GetLimitRect(Isochrone const & isochrone)
+{
+  m2::RectD rect;
+  for (auto const & polygon : isochrone.m_polygons)
+  {
+    for (auto const & point : polygon)
+      rect.Add(point);
+  }
+  return rect;
+}
+
+UNIT_TEST(Isochrones_MoscowCar)
+{
+  auto & components = integration::GetVehicleComponents<VehicleType::Car>();
+  // Vehicle components are always built on IndexRouter.
+  auto & router = static_cast<IndexRouter &>(components.GetRouter());
+
+  m2::PointD const start = MercatorBounds::FromLatLon(55.75100, 37.61790);
+  vector<double> const budgets = {5 * 60, 15 * 60};
+
+  RouterDelegate delegate;
+  vector<Isochrone> isochrones;
+  TEST_EQUAL(router.CalculateIsochrones(start, budgets, 200.0 /* cellSizeM */, delegate,
+                                        isochrones),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(isochrones.size(), budgets.size(), ());
+
+  for (size_t i = 0; i < budgets.size(); ++i)
+  {
+    TEST_EQUAL(isochrones[i].m_budget, budgets[i], ());
+    TEST(!isochrones[i].m_polygons.empty(), (i));
+    TEST(GetLimitRect(isochrones[i]).IsPointInside(start), (i));
+  }
+
+  // The area of the larger budget covers the area of the smaller one.
+  auto const rect = GetLimitRect(isochrones[1]);
+  TEST(rect.IsRectInside(GetLimitRect(isochrones[0])), ());
+
+  // A point which is reached in a few minutes from the start is in the area.
+  TEST(GetLimitRect(isochrones[0]).IsPointInside(MercatorBounds::FromLatLon(55.75500, 37.62400)),
+       ());
+}
+}  // namespace
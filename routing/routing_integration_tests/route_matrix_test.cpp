@@ -0,0 +1,56 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/route_matrix.hpp"
+#include "routing/router_delegate.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(RouteMatrix_MoscowCar)
+{
+  auto & components = integration::GetVehicleComponents<VehicleType::Car>();
+  // Vehicle components are always built on IndexRouter.
+  auto & router = static_cast<IndexRouter &>(components.GetRouter());
+
+  vector<m2::PointD> const points = {MercatorBounds::FromLatLon(55.75100, 37.61790),
+                                     MercatorBounds::FromLatLon(55.66216, 37.63259),
+                                     MercatorBounds::FromLatLon(55.80142, 37.53213)};
+
+  RouterDelegate delegate;
+  RouteMatrix matrix;
+  TEST_EQUAL(router.CalculateRouteMatrix(points, points, true /* needGeometry */,
+                                         2 /* numThreads */, delegate, matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.GetNumSources(), points.size(), ());
+  TEST_EQUAL(matrix.GetNumTargets(), points.size(), ());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    for (size_t j = 0; j < points.size(); ++j)
+    {
+      double const weight = matrix.GetWeight(i, j);
+      TEST_NOT_EQUAL(weight, RouteMatrix::kNoRoute, (i, j));
+      TEST(!matrix.GetGeometry(i, j).empty(), (i, j));
+      if (i == j)
+        continue;
+
+      // Matrix weights don't include the parts of routes from the points to the roads.
+      TRouteResult const routeResult =
+          integration::CalculateRoute(components, points[i], m2::PointD::Zero(), points[j]);
+      TEST_EQUAL(routeResult.second, RouterResultCode::NoError, (i, j));
+      TEST_LESS(weight, routeResult.first->GetTotalTimeSec() * 1.2, (i, j));
+      TEST_GREATER(weight, routeResult.first->GetTotalTimeSec() * 0.8, (i, j));
+    }
+  }
+}
+}  // namespace
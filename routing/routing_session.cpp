@@ -11,6 +11,7 @@
 
 #include "coding/internal/file_data.hpp"
 
+#include <cmath>
 #include <utility>
 
 #include "3party/Alohalytics/src/alohalytics.h"
@@ -35,6 +36,10 @@ double constexpr kRunawayDistanceSensitivityMeters = 0.01;
 double constexpr kCompletionPercentAccuracy = 5;
 
 double constexpr kMinimumETASec = 60.0;
+
+// The route is rebuilt on a traffic change if its time to the end has changed by more than
+// the share and more than kMinimumETASec. Otherwise only the ETA of the route is updated.
+double constexpr kTrafficRebuildTimeShare = 0.1;
 }  // namespace
 
 namespace routing
@@ -140,6 +145,9 @@ void RoutingSession::RemoveRoute()
 void RoutingSession::RebuildRouteOnTrafficUpdate()
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
+  if (UpdateRouteTraffic())
+    return;
+
   m2::PointD startPoint;
 
   {
@@ -169,6 +177,32 @@ void RoutingSession::RebuildRouteOnTrafficUpdate()
                routing::RoutingSession::State::RouteRebuilding, false /* adjustToPrevRoute */);
 }
 
+bool RoutingSession::UpdateRouteTraffic()
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  if (!m_trafficStash || !m_route->IsValid())
+    return false;
+
+  if (m_state != OnRoute && m_state != RouteNotStarted && m_state != RouteNoFollowing)
+    return false;
+
+  double const prevTimeToEndS = m_route->GetCurrentTimeToEndSec();
+  {
+    TrafficStash::Guard guard(m_trafficStash);
+    m_route->UpdateTraffic(*m_trafficStash);
+  }
+  double const timeToEndS = m_route->GetCurrentTimeToEndSec();
+
+  double const diffS = fabs(timeToEndS - prevTimeToEndS);
+  if (diffS > kMinimumETASec && diffS > kTrafficRebuildTimeShare * prevTimeToEndS)
+  {
+    LOG(LINFO, ("Time to the route end has changed from", prevTimeToEndS, "to", timeToEndS,
+                "seconds by traffic. Rebuilding the route."));
+    return false;
+  }
+  return true;
+}
+
 bool RoutingSession::IsActive() const
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
@@ -557,6 +591,12 @@ void RoutingSession::SetRoutingSettings(RoutingSettings const & routingSettings)
   m_routingSettings = routingSettings;
 }
 
+void RoutingSession::SetTrafficStash(shared_ptr<TrafficStash> trafficStash)
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  m_trafficStash = move(trafficStash);
+}
+
 void RoutingSession::SetRoutingCallbacks(ReadyCallback const & buildReadyCallback,
                                          ReadyCallback const & rebuildReadyCallback,
                                          NeedMoreMapsCallback const & needMoreMapsCallback,
@@ -695,13 +735,8 @@ void RoutingSession::OnTrafficInfoClear()
 
 void RoutingSession::OnTrafficInfoAdded(TrafficInfo && info)
 {
-  TrafficInfo::Coloring const & fullColoring = info.GetColoring();
-  auto coloring = make_shared<TrafficInfo::Coloring>();
-  for (auto const & kv : fullColoring)
-  {
-    ASSERT_NOT_EQUAL(kv.second, SpeedGroup::Unknown, ());
-    coloring->insert(kv);
-  }
+  // The copy shares the keys with |info| and copies the speed groups only.
+  auto coloring = make_shared<TrafficInfo::Coloring>(info.GetColoring());
 
   // Note. |coloring| should not be used after this call on gui thread.
   auto const mwmId = info.GetMwmId();
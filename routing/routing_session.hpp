@@ -6,6 +6,7 @@
 #include "routing/routing_callbacks.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/speed_camera.hpp"
+#include "routing/traffic_stash.hpp"
 #include "routing/turns.hpp"
 #include "routing/turns_notification_manager.hpp"
 
@@ -147,6 +148,10 @@ public:
   void ToggleSpeedCameras(bool enable);
 
   void SetRoutingSettings(RoutingSettings const & routingSettings);
+  /// \brief Sets the stash which is used to update the ETA of the route on traffic changes
+  /// without rebuilding it. |trafficStash| should be created with this session as the traffic
+  /// source. If it's nullptr the route is rebuilt on every traffic change.
+  void SetTrafficStash(std::shared_ptr<TrafficStash> trafficStash);
   void SetRoutingCallbacks(ReadyCallback const & buildReadyCallback,
                            ReadyCallback const & rebuildReadyCallback,
                            NeedMoreMapsCallback const & needMoreMapsCallback,
@@ -204,6 +209,10 @@ private:
   /// RemoveRoute removes m_route and resets route attributes (m_state, m_lastDistance, m_moveAwayCounter).
   void RemoveRoute();
   void RebuildRouteOnTrafficUpdate();
+  /// \brief Updates the traffic and the ETA of the current route.
+  /// \returns false if the route should be rebuilt: the route can't be updated or
+  /// its time to the end has changed too much.
+  bool UpdateRouteTraffic();
 
   double GetCompletionPercent() const;
   void PassCheckpoints();
@@ -247,6 +256,7 @@ private:
   turns::sound::NotificationManager m_turnNotificationsMgr;
 
   RoutingSettings m_routingSettings;
+  std::shared_ptr<TrafficStash> m_trafficStash;
 
   ReadyCallback m_buildReadyCallback;
   ReadyCallback m_rebuildReadyCallback;
@@ -1,8 +1,10 @@
 #include "testing/testing.hpp"
 
 #include "routing/base/astar_algorithm.hpp"
+#include "routing/base/astar_vertex_storage.hpp"
 #include "routing/base/routing_result.hpp"
 
+#include "std/functional.hpp"
 #include "std/map.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -60,22 +62,37 @@ private:
   map<unsigned, vector<Edge>> m_adjs;
 };
 
+// The same graph but AStarAlgorithm keeps its per-vertex values in HashVertexStorage.
+class HashedUndirectedGraph : public UndirectedGraph
+{
+public:
+  using VertexHasher = hash<unsigned>;
+};
+
 using TAlgorithm = AStarAlgorithm<UndirectedGraph>;
 
-void TestAStar(UndirectedGraph & graph, vector<unsigned> const & expectedRoute, double const & expectedDistance)
+template <typename Graph>
+void TestAStar(Graph & graph, vector<unsigned> const & expectedRoute, double const & expectedDistance)
 {
-  TAlgorithm algo;
+  using Algorithm = AStarAlgorithm<Graph>;
+  Algorithm algo;
 
-  TAlgorithm::ParamsForTests params(graph, 0u /* startVertex */, 4u /* finishVertex */,
-                                    nullptr /* prevRoute */, {} /* checkLengthCallback */);
+  typename Algorithm::ParamsForTests params(graph, 0u /* startVertex */, 4u /* finishVertex */,
+                                            nullptr /* prevRoute */, {} /* checkLengthCallback */);
 
   RoutingResult<unsigned /* Vertex */, double /* Weight */> actualRoute;
-  TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPath(params, actualRoute), ());
+  TEST_EQUAL(Algorithm::Result::OK, algo.FindPath(params, actualRoute), ());
+  TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
+  TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
+
+  actualRoute.m_path.clear();
+  TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
   TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
 
   actualRoute.m_path.clear();
-  TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
+  params.m_parallelWaves = true;
+  TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
   TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
 }
@@ -96,6 +113,131 @@ UNIT_TEST(AStarAlgorithm_Sample)
   TestAStar(graph, expectedRoute, 23);
 }
 
+UNIT_TEST(AStarAlgorithm_SampleHashStorage)
+{
+  HashedUndirectedGraph graph;
+
+  // Inserts edges in a format: <source, target, weight>.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 5);
+  graph.AddEdge(2, 3, 5);
+  graph.AddEdge(2, 4, 10);
+  graph.AddEdge(3, 4, 3);
+
+  vector<unsigned> const expectedRoute = {0, 1, 2, 3, 4};
+
+  TestAStar(graph, expectedRoute, 23);
+}
+
+UNIT_TEST(AStarAlgorithm_WorkspaceReuse)
+{
+  HashedUndirectedGraph graph;
+
+  // Inserts edges in a format: <source, target, weight>.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 5);
+  graph.AddEdge(2, 3, 5);
+  graph.AddEdge(2, 4, 10);
+  graph.AddEdge(3, 4, 3);
+
+  using Algorithm = AStarAlgorithm<HashedUndirectedGraph>;
+  Algorithm algo;
+  Algorithm::Workspace workspace;
+
+  // Every search must not depend on the state left by the previous ones.
+  for (unsigned finish : {4u, 1u, 3u, 4u})
+  {
+    Algorithm::ParamsForTests params(graph, 0u /* startVertex */, finish /* finishVertex */,
+                                     nullptr /* prevRoute */, {} /* checkLengthCallback */);
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> expected;
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPath(params, expected), ());
+
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> actual;
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPath(params, actual, workspace), ());
+    TEST_EQUAL(expected.m_path, actual.m_path, ());
+    TEST_ALMOST_EQUAL_ULPS(expected.m_distance, actual.m_distance, ());
+
+    actual = {};
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, actual, workspace), ());
+    TEST_EQUAL(expected.m_path, actual.m_path, ());
+    TEST_ALMOST_EQUAL_ULPS(expected.m_distance, actual.m_distance, ());
+  }
+}
+
+UNIT_TEST(AStarAlgorithm_ParallelBidirectional)
+{
+  // Grid |kSize| x |kSize| with pseudo random weights.
+  unsigned constexpr kSize = 60;
+  HashedUndirectedGraph graph;
+  for (unsigned i = 0; i < kSize; ++i)
+  {
+    for (unsigned j = 0; j < kSize; ++j)
+    {
+      unsigned const v = i * kSize + j;
+      if (j + 1 < kSize)
+        graph.AddEdge(v, v + 1, 1 + (v * 7919) % 13);
+      if (i + 1 < kSize)
+        graph.AddEdge(v, v + kSize, 1 + (v * 104729) % 17);
+    }
+  }
+  // Isolated vertex.
+  unsigned const isolated = kSize * kSize;
+
+  using Algorithm = AStarAlgorithm<HashedUndirectedGraph>;
+  Algorithm algo;
+  Algorithm::Workspace workspace;
+  for (auto const & startAndFinish : vector<pair<unsigned, unsigned>>{
+           {0, kSize * kSize - 1}, {kSize - 1, kSize * (kSize - 1)}, {5, 5}, {17, 1234}, {100, 101}})
+  {
+    Algorithm::ParamsForTests params(graph, startAndFinish.first, startAndFinish.second,
+                                     nullptr /* prevRoute */, {} /* checkLengthCallback */);
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> expected;
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPath(params, expected), ());
+
+    params.m_parallelWaves = true;
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> actual;
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, actual, workspace), ());
+    TEST_ALMOST_EQUAL_ULPS(expected.m_distance, actual.m_distance, ());
+    TEST_EQUAL(actual.m_path.front(), startAndFinish.first, ());
+    TEST_EQUAL(actual.m_path.back(), startAndFinish.second, ());
+  }
+
+  Algorithm::ParamsForTests params(graph, 0u /* startVertex */, isolated /* finishVertex */,
+                                   nullptr /* prevRoute */, {} /* checkLengthCallback */);
+  params.m_parallelWaves = true;
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> actual;
+  TEST_EQUAL(Algorithm::Result::NoPath, algo.FindPathBidirectional(params, actual, workspace), ());
+}
+
+UNIT_TEST(HashVertexStorage_Smoke)
+{
+  HashVertexStorage<uint32_t, double, hash<uint32_t>> storage;
+  TEST(storage.Find(0) == nullptr, ());
+
+  uint32_t constexpr kNumVertices = 10000;
+  for (uint32_t i = 0; i < kNumVertices; ++i)
+    storage[i * 1024] = i;
+  TEST_EQUAL(storage.GetSize(), kNumVertices, ());
+
+  for (uint32_t i = 0; i < kNumVertices; ++i)
+  {
+    auto const * value = storage.Find(i * 1024);
+    TEST(value != nullptr, (i));
+    TEST_EQUAL(*value, i, ());
+    TEST(storage.Find(i * 1024 + 1) == nullptr, (i));
+  }
+
+  storage.Clear();
+  TEST_EQUAL(storage.GetSize(), 0, ());
+  TEST(storage.Find(0) == nullptr, ());
+  TEST(storage.Find(1024) == nullptr, ());
+
+  storage[1024] = 5.0;
+  TEST_EQUAL(storage[1024], 5.0, ());
+  TEST_EQUAL(storage[2048], 0.0, ());
+  TEST_EQUAL(storage.GetSize(), 2, ());
+}
+
 UNIT_TEST(AStarAlgorithm_CheckLength)
 {
   UndirectedGraph graph;
@@ -122,6 +264,32 @@ UNIT_TEST(AStarAlgorithm_CheckLength)
   TEST_EQUAL(result, TAlgorithm::Result::NoPath, ());
 }
 
+UNIT_TEST(AStarAlgorithm_AdjustEdgeWeight)
+{
+  UndirectedGraph graph;
+
+  // Inserts edges in a format: <source, target, weight>.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 5);
+  graph.AddEdge(2, 3, 5);
+  graph.AddEdge(2, 4, 10);
+  graph.AddEdge(3, 4, 3);
+
+  TAlgorithm algo;
+  TAlgorithm::ParamsForTests params(graph, 0u /* startVertex */, 4u /* finishVertex */,
+                                    nullptr /* prevRoute */, {} /* checkLengthCallback */);
+  // Edges to vertex 3 are twice heavier if they are reached with distance 15 or more.
+  params.m_adjustEdgeWeightCallback = [](Edge const & edge, double distance) {
+    return edge.GetTarget() == 3 && distance >= 15 ? 2 * edge.GetWeight() : edge.GetWeight();
+  };
+
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> routingResult;
+  TEST_EQUAL(algo.FindPath(params, routingResult), TAlgorithm::Result::OK, ());
+  vector<unsigned> const expectedRoute = {0, 1, 2, 4};
+  TEST_EQUAL(routingResult.m_path, expectedRoute, ());
+  TEST_ALMOST_EQUAL_ULPS(routingResult.m_distance, 25.0, ());
+}
+
 UNIT_TEST(AdjustRoute)
 {
   UndirectedGraph graph;
@@ -189,4 +357,166 @@ UNIT_TEST(AdjustRouteOutOfLimit)
   TEST_EQUAL(code, TAlgorithm::Result::NoPath, ());
   TEST(result.m_path.empty(), ());
 }
+template <typename Graph>
+void TestAdjustRouteWithDestinationTree(Graph & graph, unsigned gridSize, bool parallelWaves)
+{
+  using Algorithm = AStarAlgorithm<Graph>;
+  Algorithm algo;
+  typename Algorithm::Workspace workspace;
+  typename Algorithm::DestinationTree tree;
+
+  unsigned const finish = gridSize * gridSize - 1;
+  typename Algorithm::ParamsForTests params(graph, 0u /* startVertex */, finish,
+                                            nullptr /* prevRoute */, {} /* checkLengthCallback */);
+  params.m_parallelWaves = parallelWaves;
+  params.m_destinationTree = &tree;
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> route;
+  TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, route, workspace), ());
+  TEST(!tree.IsEmpty(), ());
+  TEST_EQUAL(tree.GetFinalVertex(), finish, ());
+  for (unsigned const v : route.m_path)
+    TEST(tree.FindDistance(v), (v));
+  TEST_ALMOST_EQUAL_ULPS(*tree.FindDistance(0u), route.m_distance, ());
+  TEST_EQUAL(*tree.FindDistance(finish), 0.0, ());
+
+  // Paths from the tree are the shortest ones if the wave is not limited.
+  for (unsigned const start : {1u, gridSize + 3, 2 * gridSize, gridSize * (gridSize - 1), finish})
+  {
+    typename Algorithm::ParamsForTests expectedParams(graph, start, finish, nullptr /* prevRoute */,
+                                                      {} /* checkLengthCallback */);
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> expected;
+    TEST_EQUAL(Algorithm::Result::OK, algo.FindPath(expectedParams, expected), ());
+
+    typename Algorithm::ParamsForTests adjustParams(
+        graph, start, {} /* finishVertex */, nullptr /* prevRoute */,
+        [](double /* weight */) { return true; });
+    RoutingResult<unsigned /* Vertex */, double /* Weight */> actual;
+    TEST_EQUAL(Algorithm::Result::OK, algo.AdjustRoute(adjustParams, tree, actual, workspace), ());
+    TEST_ALMOST_EQUAL_ULPS(expected.m_distance, actual.m_distance, (start));
+    TEST_EQUAL(actual.m_path.front(), start, ());
+    TEST_EQUAL(actual.m_path.back(), finish, ());
+  }
+
+  // The wave is limited and the start is far from the tree.
+  typename Algorithm::ParamsForTests farParams(graph, gridSize * gridSize /* isolated */,
+                                               {} /* finishVertex */, nullptr /* prevRoute */,
+                                               [](double weight) { return weight <= 1.0; });
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> noPath;
+  TEST_EQUAL(Algorithm::Result::NoPath, algo.AdjustRoute(farParams, tree, noPath, workspace), ());
+}
+
+UNIT_TEST(AdjustRouteWithDestinationTree)
+{
+  // Grid |kSize| x |kSize| with pseudo random weights and a vertex isolated from it.
+  unsigned constexpr kSize = 20;
+  HashedUndirectedGraph hashedGraph;
+  UndirectedGraph graph;
+  for (unsigned i = 0; i < kSize; ++i)
+  {
+    for (unsigned j = 0; j < kSize; ++j)
+    {
+      unsigned const v = i * kSize + j;
+      if (j + 1 < kSize)
+      {
+        graph.AddEdge(v, v + 1, 1 + (v * 7919) % 13);
+        hashedGraph.AddEdge(v, v + 1, 1 + (v * 7919) % 13);
+      }
+      if (i + 1 < kSize)
+      {
+        graph.AddEdge(v, v + kSize, 1 + (v * 104729) % 17);
+        hashedGraph.AddEdge(v, v + kSize, 1 + (v * 104729) % 17);
+      }
+    }
+  }
+
+  TestAdjustRouteWithDestinationTree(graph, kSize, false /* parallelWaves */);
+  TestAdjustRouteWithDestinationTree(hashedGraph, kSize, false /* parallelWaves */);
+  TestAdjustRouteWithDestinationTree(hashedGraph, kSize, true /* parallelWaves */);
+}
+template <typename Graph>
+void TestAlternativePaths(Graph & graph)
+{
+  // Three roads from 0 to 7 with lengths 10, 11 and 15.
+  graph.AddEdge(0, 1, 3);
+  graph.AddEdge(1, 2, 4);
+  graph.AddEdge(2, 7, 3);
+  graph.AddEdge(0, 3, 3);
+  graph.AddEdge(3, 4, 5);
+  graph.AddEdge(4, 7, 3);
+  graph.AddEdge(0, 5, 3);
+  graph.AddEdge(5, 6, 9);
+  graph.AddEdge(6, 7, 3);
+
+  using Algorithm = AStarAlgorithm<Graph>;
+  Algorithm algo;
+  typename Algorithm::Workspace workspace;
+  typename Algorithm::ParamsForTests params(graph, 0u /* startVertex */, 7u /* finishVertex */,
+                                            nullptr /* prevRoute */, {} /* checkLengthCallback */);
+  typename Algorithm::AlternativesParams alternatives;
+  vector<RoutingResult<unsigned /* Vertex */, double /* Weight */>> results;
+
+  // The longest road is too long.
+  TEST_EQUAL(Algorithm::Result::OK,
+             algo.FindPathBidirectionalWithAlternatives(params, alternatives, results, workspace),
+             ());
+  TEST_EQUAL(results.size(), 2, ());
+  TEST_EQUAL(results[0].m_path, vector<unsigned>({0, 1, 2, 7}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[0].m_distance, 10.0, ());
+  TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 3, 4, 7}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[1].m_distance, 11.0, ());
+
+  // Alternatives with longer plateaus go first.
+  alternatives.m_maxStretch = 1.5;
+  TEST_EQUAL(Algorithm::Result::OK,
+             algo.FindPathBidirectionalWithAlternatives(params, alternatives, results, workspace),
+             ());
+  TEST_EQUAL(results.size(), 3, ());
+  TEST_EQUAL(results[0].m_path, vector<unsigned>({0, 1, 2, 7}), ());
+  TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 5, 6, 7}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[1].m_distance, 15.0, ());
+  TEST_EQUAL(results[2].m_path, vector<unsigned>({0, 3, 4, 7}), ());
+
+  alternatives.m_maxAlternatives = 0;
+  TEST_EQUAL(Algorithm::Result::OK,
+             algo.FindPathBidirectionalWithAlternatives(params, alternatives, results, workspace),
+             ());
+  TEST_EQUAL(results.size(), 1, ());
+  TEST_EQUAL(results[0].m_path, vector<unsigned>({0, 1, 2, 7}), ());
+
+  // The road 0 -> 1 -> 8 -> 10 -> 2 -> 7 of length 11 shares 6 with the shortest one.
+  graph.AddEdge(1, 8, 1);
+  graph.AddEdge(8, 10, 3);
+  graph.AddEdge(10, 2, 1);
+  alternatives = typename Algorithm::AlternativesParams();
+  TEST_EQUAL(Algorithm::Result::OK,
+             algo.FindPathBidirectionalWithAlternatives(params, alternatives, results, workspace),
+             ());
+  TEST_EQUAL(results.size(), 3, ());
+  TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 3, 4, 7}), ());
+  TEST_EQUAL(results[2].m_path, vector<unsigned>({0, 1, 8, 10, 2, 7}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[2].m_distance, 11.0, ());
+
+  alternatives.m_maxSharing = 0.5;
+  TEST_EQUAL(Algorithm::Result::OK,
+             algo.FindPathBidirectionalWithAlternatives(params, alternatives, results, workspace),
+             ());
+  TEST_EQUAL(results.size(), 2, ());
+  TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 3, 4, 7}), ());
+
+  typename Algorithm::ParamsForTests noPathParams(graph, 0u /* startVertex */, 99u /* isolated */,
+                                                  nullptr /* prevRoute */,
+                                                  {} /* checkLengthCallback */);
+  TEST_EQUAL(Algorithm::Result::NoPath,
+             algo.FindPathBidirectionalWithAlternatives(noPathParams, alternatives, results,
+                                                        workspace),
+             ());
+}
+
+UNIT_TEST(AStarAlgorithm_AlternativePaths)
+{
+  UndirectedGraph graph;
+  TestAlternativePaths(graph);
+  HashedUndirectedGraph hashedGraph;
+  TestAlternativePaths(hashedGraph);
+}
 }  // namespace routing_test
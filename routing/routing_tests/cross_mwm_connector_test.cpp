@@ -206,6 +206,7 @@ void TestSerialization(vector<CrossMwmConnectorSerializer::Transition<CrossMwmId
 
   TEST(!connector.WeightsWereLoaded(), ());
   TEST(!connector.HasWeights(), ());
+  TEST(connector.WeightsExist(), ());
 
   {
     MemReader reader(buffer.data(), buffer.size());
@@ -214,6 +215,18 @@ void TestSerialization(vector<CrossMwmConnectorSerializer::Transition<CrossMwmId
   }
   TEST(connector.WeightsWereLoaded(), ());
   TEST(connector.HasWeights(), ());
+  TEST(connector.WeightsExist(), ());
+
+  {
+    // The section has no bicycle weights.
+    auto bicycleConnector = CreateConnector<CrossMwmId>();
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    CrossMwmConnectorSerializer::DeserializeTransitions(VehicleType::Bicycle, bicycleConnector,
+                                                        source);
+    TEST(bicycleConnector.WeightsWereLoaded(), ());
+    TEST(!bicycleConnector.WeightsExist(), ());
+  }
 
   double constexpr eps = 1e-6;
   TEST(AlmostEqualAbs(
@@ -7,6 +7,7 @@
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter.hpp"
 #include "routing/index_router.hpp"
+#include "routing/mapped_index_graph_serialization.hpp"
 #include "routing/routing_helpers.hpp"
 #include "routing/vehicle_mask.hpp"
 
@@ -17,6 +18,7 @@
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
+#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
@@ -608,6 +610,64 @@ UNIT_TEST(SerializeSimpleGraph)
   }
 }
 
+// The same graph as in SerializeSimpleGraph.
+UNIT_TEST(SerializeMappedSimpleGraph)
+{
+  vector<uint8_t> buffer;
+  {
+    IndexGraph graph;
+    vector<Joint> joints = {
+        MakeJoint({{0, 1}, {1, 0}}), MakeJoint({{1, 1}, {2, 0}}),
+    };
+    graph.Import(joints);
+    unordered_map<uint32_t, VehicleMask> masks;
+    masks[0] = kPedestrianMask;
+    masks[1] = kCarMask;
+    masks[2] = kCarMask;
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    IndexGraphSerializer::Serialize(graph, masks, writer);
+  }
+
+  vector<uint8_t> mappedBuffer;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    MemWriter<vector<uint8_t>> writer(mappedBuffer);
+    MappedIndexGraphSerializer::Serialize(reader, writer);
+  }
+
+  for (VehicleType const vehicleType : {VehicleType::Pedestrian, VehicleType::Car})
+  {
+    IndexGraph expected;
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    IndexGraphSerializer::Deserialize(expected, source, GetVehicleMask(vehicleType));
+
+    IndexGraph graph;
+    TEST(MappedIndexGraphSerializer::Deserialize(
+             make_unique<CopiedMemoryRegion>(vector<uint8_t>(mappedBuffer)), vehicleType, graph),
+         (vehicleType));
+
+    TEST_EQUAL(graph.GetNumRoads(), expected.GetNumRoads(), (vehicleType));
+    TEST_EQUAL(graph.GetNumJoints(), expected.GetNumJoints(), (vehicleType));
+    TEST_EQUAL(graph.GetNumPoints(), expected.GetNumPoints(), (vehicleType));
+    for (uint32_t featureId = 0; featureId < 4; ++featureId)
+    {
+      TEST_EQUAL(graph.IsRoad(featureId), expected.IsRoad(featureId), (vehicleType, featureId));
+      for (uint32_t pointId = 0; pointId < 3; ++pointId)
+      {
+        RoadPoint const rp(featureId, pointId);
+        TEST_EQUAL(graph.GetJointId(rp), expected.GetJointId(rp), (vehicleType, featureId, pointId));
+      }
+    }
+  }
+
+  IndexGraph graph;
+  TEST(!MappedIndexGraphSerializer::Deserialize(
+           make_unique<CopiedMemoryRegion>(move(mappedBuffer)), VehicleType::Transit, graph),
+       ());
+}
+
 //      Finish
 // 0.0004    *
 //           ^
@@ -346,7 +346,7 @@ unique_ptr<TransitWorldGraph> BuildWorldGraph(unique_ptr<TestGeometryLoader> geo
   auto transitGraph = make_unique<TransitGraph>(kTestNumMwmId, estimator);
   TransitGraph::GateEndings gateEndings;
   MakeGateEndings(transitData.GetGates(), kTestNumMwmId, *indexGraph, gateEndings);
-  transitGraph->Fill(transitData, gateEndings);
+  transitGraph->Fill(make_shared<transit::GraphData>(transitData), gateEndings);
 
   auto indexLoader = make_unique<TestIndexGraphLoader>();
   indexLoader->AddGraph(kTestNumMwmId, move(indexGraph));
@@ -97,6 +97,8 @@ public:
     return {};
   }
 
+  Landmarks const * GetLandmarks(NumMwmId /* numMwmId */) override { return nullptr; }
+  SpeedProfiles const * GetSpeedProfiles(NumMwmId /* numMwmId */) override { return nullptr; }
   void Clear() override;
 
   void AddGraph(NumMwmId mwmId, unique_ptr<IndexGraph> graph);
@@ -0,0 +1,67 @@
+#include "testing/testing.hpp"
+
+#include "routing/isochrone.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using Polygon = vector<m2::PointD>;
+
+UNIT_TEST(BuildConcaveHulls_Smoke)
+{
+  TEST(BuildConcaveHulls({} /* points */, 1.0 /* cellSize */).empty(), ());
+
+  auto const hulls = BuildConcaveHulls({m2::PointD(0.5, 0.5)}, 1.0 /* cellSize */);
+  TEST_EQUAL(hulls, vector<Polygon>({{{-0.5, -0.5}, {2.5, -0.5}, {2.5, 2.5}, {-0.5, 2.5}}}), ());
+}
+
+UNIT_TEST(BuildConcaveHulls_Components)
+{
+  auto const hulls =
+      BuildConcaveHulls({m2::PointD(0.5, 0.5), m2::PointD(10.5, 0.5)}, 1.0 /* cellSize */);
+  TEST_EQUAL(hulls.size(), 2, ());
+}
+
+UNIT_TEST(BuildConcaveHulls_Concave)
+{
+  // An L-shaped road.
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    points.emplace_back(i + 0.5, 0.5);
+    points.emplace_back(0.5, i + 0.5);
+  }
+
+  auto const hulls = BuildConcaveHulls(points, 1.0 /* cellSize */);
+  TEST_EQUAL(hulls, vector<Polygon>({{{-0.5, -0.5},
+                                      {11.5, -0.5},
+                                      {11.5, 2.5},
+                                      {2.5, 2.5},
+                                      {2.5, 11.5},
+                                      {-0.5, 11.5}}}),
+             ());
+}
+
+UNIT_TEST(BuildConcaveHulls_Hole)
+{
+  // The hole inside a ring road is filled.
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    points.emplace_back(i + 0.5, 0.5);
+    points.emplace_back(i + 0.5, 9.5);
+    points.emplace_back(0.5, i + 0.5);
+    points.emplace_back(9.5, i + 0.5);
+  }
+
+  auto const hulls = BuildConcaveHulls(points, 1.0 /* cellSize */);
+  TEST_EQUAL(hulls,
+             vector<Polygon>({{{-0.5, -0.5}, {11.5, -0.5}, {11.5, 11.5}, {-0.5, 11.5}}}), ());
+}
+}  // namespace
@@ -0,0 +1,104 @@
+#include "testing/testing.hpp"
+
+#include "routing/landmarks.hpp"
+#include "routing/segment.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Segment is (numMwmId, featureId, segmentIdx, isForward).
+Segment const kS0 = {0 /* numMwmId */, 0 /* featureId */, 0 /* segmentIdx */, true /* forward */};
+Segment const kS1 = {0 /* numMwmId */, 0 /* featureId */, 1 /* segmentIdx */, true /* forward */};
+Segment const kS2 = {0 /* numMwmId */, 2 /* featureId */, 0 /* segmentIdx */, false /* forward */};
+Segment const kS3 = {0 /* numMwmId */, 2 /* featureId */, 0 /* segmentIdx */, true /* forward */};
+
+// Two landmarks on the chain kS0 -> kS1 -> kS2 with edge weights 1, 2.
+// kS3 is not connected to the chain.
+Landmarks MakeChainLandmarks()
+{
+  // Feature 1 is not a road.
+  Landmarks landmarks(VehicleType::Car, 2 /* numLandmarks */, {2, 0, 1} /* numSegments */);
+
+  // Landmark 0 is kS0.
+  landmarks.SetWeightFromLandmark(0, kS0, 0.0);
+  landmarks.SetWeightFromLandmark(0, kS1, 1.0);
+  landmarks.SetWeightFromLandmark(0, kS2, 3.0);
+  landmarks.SetWeightToLandmark(0, kS0, 0.0);
+
+  // Landmark 1 is kS2.
+  landmarks.SetWeightToLandmark(1, kS0, 3.0);
+  landmarks.SetWeightToLandmark(1, kS1, 2.0);
+  landmarks.SetWeightToLandmark(1, kS2, 0.0);
+  landmarks.SetWeightFromLandmark(1, kS2, 0.0);
+  return landmarks;
+}
+
+UNIT_TEST(Landmarks_Segments)
+{
+  Landmarks const landmarks = MakeChainLandmarks();
+  TEST_EQUAL(landmarks.GetNumFeatures(), 3, ());
+  TEST_EQUAL(landmarks.GetNumLandmarks(), 2, ());
+
+  TEST(landmarks.HasSegment(kS0), ());
+  TEST(landmarks.HasSegment(kS3), ());
+  TEST(!landmarks.HasSegment({0 /* numMwmId */, 0 /* featureId */, 2 /* segmentIdx */, true}), ());
+  TEST(!landmarks.HasSegment({0 /* numMwmId */, 1 /* featureId */, 0 /* segmentIdx */, true}), ());
+  TEST(!landmarks.HasSegment({0 /* numMwmId */, 3 /* featureId */, 0 /* segmentIdx */, true}), ());
+
+  TEST_EQUAL(landmarks.GetWeightFromLandmark(0, kS2), 3.0, ());
+  TEST_EQUAL(landmarks.GetWeightToLandmark(1, kS1), 2.0, ());
+  TEST_EQUAL(landmarks.GetWeightFromLandmark(1, kS0), Landmarks::kInfiniteWeight, ());
+}
+
+UNIT_TEST(Landmarks_LowerBound)
+{
+  Landmarks const landmarks = MakeChainLandmarks();
+
+  TEST_EQUAL(landmarks.GetLowerBound(kS0, kS2), 3.0, ());
+  TEST_EQUAL(landmarks.GetLowerBound(kS0, kS1), 1.0, ());
+  TEST_EQUAL(landmarks.GetLowerBound(kS1, kS2), 2.0, ());
+  TEST_EQUAL(landmarks.GetLowerBound(kS1, kS1), 0.0, ());
+
+  // kS0 is unreachable from kS2 because kS0 reaches landmark 0 and kS2 doesn't.
+  TEST_EQUAL(landmarks.GetLowerBound(kS2, kS0), Landmarks::kUnreachableBound, ());
+  // Nothing is known about kS3.
+  TEST_EQUAL(landmarks.GetLowerBound(kS3, kS3), 0.0, ());
+  // Unknown segment.
+  TEST_EQUAL(landmarks.GetLowerBound(kS0, {0 /* numMwmId */, 5 /* featureId */, 0, true}), 0.0,
+             ());
+}
+
+UNIT_TEST(Landmarks_Serialization)
+{
+  Landmarks const landmarks = MakeChainLandmarks();
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<decltype(buf)> writer(buf);
+    landmarks.Serialize(writer);
+  }
+
+  Landmarks deserialized;
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> src(memReader);
+  deserialized.Deserialize(src);
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TEST_EQUAL(deserialized.GetVehicleType(), VehicleType::Car, ());
+  TEST_EQUAL(deserialized.GetNumLandmarks(), 2, ());
+  TEST_EQUAL(deserialized.GetNumFeatures(), 3, ());
+  for (Segment const & from : {kS0, kS1, kS2, kS3})
+  {
+    for (Segment const & to : {kS0, kS1, kS2, kS3})
+      TEST_EQUAL(deserialized.GetLowerBound(from, to), landmarks.GetLowerBound(from, to), ());
+  }
+}
+}  // namespace
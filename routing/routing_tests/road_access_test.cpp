@@ -72,6 +72,36 @@ UNIT_TEST(RoadAccess_Serialization)
   }
 }
 
+UNIT_TEST(RoadAccess_Types)
+{
+  RoadAccess roadAccess;
+  TEST_EQUAL(roadAccess.GetFeatureType(1), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(1, 0)), RoadAccess::Type::Yes, ());
+
+  unordered_map<uint32_t, RoadAccess::Type> featureTypes = {
+      {7, RoadAccess::Type::No},
+      {1, RoadAccess::Type::Private},
+      {1000000, RoadAccess::Type::Destination},
+  };
+  unordered_map<RoadPoint, RoadAccess::Type, RoadPoint::Hash> pointTypes = {
+      {RoadPoint(7, 3), RoadAccess::Type::No},
+      {RoadPoint(3, 7), RoadAccess::Type::Private},
+  };
+  roadAccess.SetAccessTypes(move(featureTypes), move(pointTypes));
+
+  TEST_EQUAL(roadAccess.GetFeatureType(1), RoadAccess::Type::Private, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(7), RoadAccess::Type::No, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(1000000), RoadAccess::Type::Destination, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(0), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(3), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetFeatureType(2000000), RoadAccess::Type::Yes, ());
+
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(7, 3)), RoadAccess::Type::No, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(3, 7)), RoadAccess::Type::Private, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(7, 7)), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetPointType(RoadPoint(3, 3)), RoadAccess::Type::Yes, ());
+}
+
 UNIT_TEST(RoadAccess_WayBlocked)
 {
   // Add edges to the graph in the following format: (from, to, weight).
@@ -0,0 +1,88 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+shared_ptr<RoadGeometryStorage const> MakeStorage()
+{
+  auto storage = make_shared<RoadGeometryStorage>();
+  storage->AddRoad(0 /* featureId */,
+                   RoadGeometry(false /* oneWay */, 60.0 /* weightSpeedKMpH */,
+                                50.0 /* etaSpeedKMpH */,
+                                RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}})));
+  // Features 1 and 2 are not roads.
+  storage->AddRoad(3 /* featureId */,
+                   RoadGeometry(true /* oneWay */, 20.0 /* weightSpeedKMpH */,
+                                20.0 /* etaSpeedKMpH */,
+                                RoadGeometry::Points({{1.0, 0.0}, {1.0, 1.0}, {2.0, 1.0}})));
+  return storage;
+}
+
+UNIT_TEST(RoadGeometryStorage_GetRoad)
+{
+  auto const storage = MakeStorage();
+  TEST_EQUAL(storage->GetNumFeatures(), 4, ());
+  TEST_EQUAL(storage->GetNumJunctions(), 5, ());
+
+  RoadGeometry road;
+  storage->GetRoad(3 /* featureId */, road);
+  TEST(road.IsValid(), ());
+  TEST(road.IsOneWay(), ());
+  TEST_EQUAL(road.GetSpeed().m_weight, 20.0, ());
+  TEST_EQUAL(road.GetPointsCount(), 3, ());
+  TEST_EQUAL(road.GetPoint(1), m2::PointD(1.0, 1.0), ());
+  TEST(road.IsEndPointId(2), ());
+  for (uint32_t i = 0; i + 1 < road.GetPointsCount(); ++i)
+  {
+    double const length = MercatorBounds::DistanceOnEarth(road.GetPoint(i), road.GetPoint(i + 1));
+    TEST(base::AlmostEqualAbs(road.GetSegmentLength(i), length, 1e-6), (i));
+  }
+
+  storage->GetRoad(0 /* featureId */, road);
+  TEST(road.IsValid(), ());
+  TEST(!road.IsOneWay(), ());
+  TEST_EQUAL(road.GetSpeed().m_eta, 50.0, ());
+  TEST_EQUAL(road.GetPointsCount(), 2, ());
+  TEST_EQUAL(road.GetPoint(1), m2::PointD(1.0, 0.0), ());
+
+  for (uint32_t const featureId : {1, 2, 10})
+  {
+    storage->GetRoad(featureId, road);
+    TEST(!road.IsValid(), (featureId));
+    TEST_EQUAL(road.GetPointsCount(), 0, (featureId));
+  }
+}
+
+UNIT_TEST(RoadGeometryStorage_SharedGeometry)
+{
+  auto const storage = MakeStorage();
+  Geometry first(storage);
+  Geometry second(storage);
+
+  RoadGeometry const & road = first.GetRoad(3 /* featureId */);
+  // The reference is still valid after a few other requests.
+  for (uint32_t i = 0; i < 10; ++i)
+  {
+    TEST_EQUAL(first.GetRoad(0 /* featureId */).GetPointsCount(), 2, ());
+    TEST_EQUAL(second.GetRoad(3 /* featureId */).GetPointsCount(), 3, ());
+  }
+
+  TEST_EQUAL(road.GetPointsCount(), 3, ());
+  TEST_EQUAL(first.GetPoint(RoadPoint(3 /* featureId */, 2 /* pointId */)), m2::PointD(2.0, 1.0),
+             ());
+  TEST_EQUAL(&road.GetJunction(0), &second.GetRoad(3 /* featureId */).GetJunction(0), ());
+}
+}  // namespace
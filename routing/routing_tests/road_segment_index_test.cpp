@@ -0,0 +1,125 @@
+#include "testing/testing.hpp"
+
+#include "routing/nearest_edge_finder.hpp"
+#include "routing/road_graph.hpp"
+#include "routing/road_segment_index.hpp"
+#include "routing/routing_tests/road_graph_builder.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using RoadSegment = RoadSegmentIndex::RoadSegment;
+
+double constexpr kCellSize = RoadSegmentIndex::kCellSize;
+
+RoadSegment MakeSegment(uint32_t featureId, uint32_t segId, m2::PointD const & start,
+                        m2::PointD const & end)
+{
+  RoadSegment segment;
+  segment.m_featureId = featureId;
+  segment.m_segId = segId;
+  segment.m_start = MakeJunctionForTesting(start);
+  segment.m_end = MakeJunctionForTesting(end);
+  return segment;
+}
+
+UNIT_TEST(RoadSegmentIndex_LazyCells)
+{
+  // The road goes through the centers of cells (0, 0) and (1, 0).
+  m2::PointD const start(0.5 * kCellSize, 0.5 * kCellSize);
+  m2::PointD const end(1.5 * kCellSize, 0.5 * kCellSize);
+
+  vector<m2::RectD> loadedCells;
+  RoadSegmentIndex index([&](m2::RectD const & rect, vector<RoadSegment> & segments) {
+    loadedCells.push_back(rect);
+    if (rect.IsIntersect(m2::RectD(start, end)))
+      segments.push_back(MakeSegment(1 /* featureId */, 0 /* segId */, start, end));
+  });
+
+  size_t numSegments = 0;
+  m2::RectD const rect(0.1 * kCellSize, 0.1 * kCellSize, 0.2 * kCellSize, 0.2 * kCellSize);
+  index.ForEachInRect(rect, [&](RoadSegment const &) { ++numSegments; });
+  TEST_EQUAL(numSegments, 1, ());
+  TEST_EQUAL(loadedCells.size(), 1, ());
+  TEST_EQUAL(index.GetNumCells(), 1, ());
+
+  // The cell is loaded already.
+  index.ForEachInRect(rect, [&](RoadSegment const &) { ++numSegments; });
+  TEST_EQUAL(numSegments, 2, ());
+  TEST_EQUAL(loadedCells.size(), 1, ());
+
+  // The segment crosses both cells and it's passed once per cell.
+  numSegments = 0;
+  m2::RectD const twoCells(0.9 * kCellSize, 0.1 * kCellSize, 1.1 * kCellSize, 0.2 * kCellSize);
+  index.ForEachInRect(twoCells, [&](RoadSegment const &) { ++numSegments; });
+  TEST_EQUAL(numSegments, 2, ());
+  TEST_EQUAL(loadedCells.size(), 2, ());
+  TEST_EQUAL(index.GetNumCells(), 2, ());
+
+  // Negative coordinates.
+  numSegments = 0;
+  m2::RectD const negative(-0.2 * kCellSize, -0.2 * kCellSize, -0.1 * kCellSize, -0.1 * kCellSize);
+  index.ForEachInRect(negative, [&](RoadSegment const &) { ++numSegments; });
+  TEST_EQUAL(numSegments, 0, ());
+  TEST_EQUAL(loadedCells.size(), 3, ());
+  TEST(loadedCells.back().IsPointInside(negative.Center()), ());
+
+  index.Clear();
+  TEST_EQUAL(index.GetNumCells(), 0, ());
+}
+
+UNIT_TEST(RoadSegmentIndex_MaxNumCells)
+{
+  RoadSegmentIndex index([](m2::RectD const &, vector<RoadSegment> &) {});
+  for (size_t i = 0; i < RoadSegmentIndex::kMaxNumCells + 1; ++i)
+  {
+    double const x = (i + 0.5) * kCellSize;
+    index.ForEachInRect(m2::RectD(x, 0.5 * kCellSize, x, 0.5 * kCellSize),
+                        [](RoadSegment const &) {});
+    TEST_LESS_OR_EQUAL(index.GetNumCells(), RoadSegmentIndex::kMaxNumCells, ());
+  }
+  TEST_EQUAL(index.GetNumCells(), 1, ());
+}
+
+UNIT_TEST(NearestEdgeFinder_AddSegment)
+{
+  IRoadGraph::JunctionVec const junctions({MakeJunctionForTesting({0.0, 0.0}),
+                                            MakeJunctionForTesting({1.0, 0.0}),
+                                            MakeJunctionForTesting({1.0, 1.0}),
+                                            MakeJunctionForTesting({2.0, 1.0})});
+  FeatureID const featureId = routing_test::MakeTestFeatureID(7 /* offset */);
+  m2::PointD const point(1.2, 0.6);
+
+  NearestEdgeFinder expectedFinder(point);
+  expectedFinder.AddInformationSource(featureId, junctions, true /* bidirectional */);
+  vector<pair<Edge, Junction>> expected;
+  expectedFinder.MakeResult(expected, 10 /* maxCountFeatures */);
+
+  // Segments in reversed order and duplicated as a grid index passes them.
+  NearestEdgeFinder finder(point);
+  for (size_t i = junctions.size() - 1; i > 0; --i)
+  {
+    for (size_t j = 0; j < 2; ++j)
+    {
+      finder.AddSegment(featureId, static_cast<uint32_t>(i - 1), junctions[i - 1], junctions[i],
+                        true /* bidirectional */);
+    }
+  }
+  vector<pair<Edge, Junction>> actual;
+  finder.MakeResult(actual, 10 /* maxCountFeatures */);
+
+  TEST_EQUAL(actual.size(), 2, ());
+  TEST_EQUAL(actual, expected, ());
+  TEST_EQUAL(actual[0].first.GetSegId(), 1, ());
+}
+}  // namespace
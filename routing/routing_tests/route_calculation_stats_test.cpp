@@ -0,0 +1,57 @@
+#include "testing/testing.hpp"
+
+#include "routing/route_calculation_stats.hpp"
+
+#include <cstdint>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using Phase = RouteCalculationStats::Phase;
+
+UNIT_TEST(RouteCalculationStats_Smoke)
+{
+  uint64_t allocations = 0;
+  RouteCalculationStats stats;
+  stats.SetAllocationCounter([&allocations]() { return allocations; });
+
+  {
+    RouteCalculationStats::ScopedPhase phase(stats, Phase::RouteReconstruction);
+    allocations += 2;
+    {
+      RouteCalculationStats::ScopedPhase nested(stats, Phase::Directions);
+      allocations += 3;
+    }
+    allocations += 1;
+  }
+  {
+    RouteCalculationStats::ScopedPhase phase(stats, Phase::Directions);
+    allocations += 4;
+  }
+  stats.AddVisitedVertices(10);
+  stats.AddVisitedVertices(5);
+
+  // Allocations of the nested phase are excluded from the enclosing one.
+  TEST_EQUAL(stats.GetPhaseStats(Phase::RouteReconstruction).m_calls, 1, ());
+  TEST_EQUAL(stats.GetPhaseStats(Phase::RouteReconstruction).m_allocations, 3, ());
+  TEST_EQUAL(stats.GetPhaseStats(Phase::Directions).m_calls, 2, ());
+  TEST_EQUAL(stats.GetPhaseStats(Phase::Directions).m_allocations, 7, ());
+  TEST_EQUAL(stats.GetPhaseStats(Phase::AStar).m_calls, 0, ());
+  TEST_EQUAL(stats.GetVisitedVertices(), 15, ());
+  TEST_GREATER_OR_EQUAL(stats.GetTotalSeconds(), 0.0, ());
+
+  stats.Clear();
+  TEST_EQUAL(stats.GetPhaseStats(Phase::Directions).m_calls, 0, ());
+  TEST_EQUAL(stats.GetVisitedVertices(), 0, ());
+  TEST_EQUAL(stats.GetTotalSeconds(), 0.0, ());
+
+  // The allocation counter is kept after Clear().
+  {
+    RouteCalculationStats::ScopedPhase phase(stats, Phase::AStar);
+    allocations += 6;
+  }
+  TEST_EQUAL(stats.GetPhaseStats(Phase::AStar).m_allocations, 6, ());
+}
+}  // namespace
@@ -1,17 +1,25 @@
 #include "testing/testing.hpp"
 
 #include "routing/route.hpp"
+#include "routing/edge_estimator.hpp"
 #include "routing/routing_helpers.hpp"
+#include "routing/traffic_stash.hpp"
 #include "routing/turns.hpp"
 
 #include "routing/base/followed_polyline.hpp"
 
+#include "traffic/traffic_cache.hpp"
+#include "traffic/traffic_info.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
 #include "platform/location.hpp"
 
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
 #include "std/set.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
@@ -310,3 +318,39 @@ UNIT_TEST(RouteNameTest)
   route.GetCurrentStreetName(name);
   TEST_EQUAL(name, "Street3", ());
 }
+
+UNIT_TEST(UpdateTrafficTest)
+{
+  Route route("TestRouter", 0 /* route id */);
+
+  route.SetGeometry(kTestGeometry.begin(), kTestGeometry.end());
+  vector<RouteSegment> routeSegments;
+  GetTestRouteSegments(kTestGeometry, kTestTurns2, kTestNames2, kTestTimes2, routeSegments);
+  route.SetRouteSegments(routeSegments);
+  TEST(base::AlmostEqualAbs(route.GetTotalTimeSec(), 15.0, 1e-9), ());
+
+  traffic::TrafficCache trafficCache;
+  TrafficStash trafficStash(trafficCache, make_shared<NumMwmIds>());
+  // The second route segment takes 1 second without traffic.
+  trafficStash.SetColoring(
+      0 /* mwm id */,
+      make_shared<traffic::TrafficInfo::Coloring>(traffic::TrafficInfo::Coloring(
+          {{traffic::TrafficInfo::RoadSegmentId(
+                2 /* feature id */, 0 /* segment idx */,
+                traffic::TrafficInfo::RoadSegmentId::kForwardDirection),
+            traffic::SpeedGroup::G2}})));
+
+  route.UpdateTraffic(trafficStash);
+  double const jamTimeS = EdgeEstimator::CalcCarTrafficFactor(traffic::SpeedGroup::G2);
+  TEST_EQUAL(route.GetTraffic(0), traffic::SpeedGroup::Unknown, ());
+  TEST_EQUAL(route.GetTraffic(1), traffic::SpeedGroup::G2, ());
+  TEST(base::AlmostEqualAbs(route.GetRouteSegments()[1].GetTimeFromBeginningSec(),
+                            5.0 + jamTimeS, 1e-9), ());
+  TEST(base::AlmostEqualAbs(route.GetTotalTimeSec(), 14.0 + jamTimeS, 1e-9), ());
+
+  // The jam has gone.
+  trafficStash.SetColoring(0 /* mwm id */, make_shared<traffic::TrafficInfo::Coloring>());
+  route.UpdateTraffic(trafficStash);
+  TEST_EQUAL(route.GetTraffic(1), traffic::SpeedGroup::Unknown, ());
+  TEST(base::AlmostEqualAbs(route.GetTotalTimeSec(), 15.0, 1e-9), ());
+}
@@ -0,0 +1,173 @@
+#include "testing/testing.hpp"
+
+#include "routing/router_pool.hpp"
+
+#include "routing/checkpoints.hpp"
+#include "routing/route.hpp"
+#include "routing/router.hpp"
+#include "routing/routing_callbacks.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Blocks calculations until Open() is called.
+class Gate
+{
+public:
+  void Open()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_open = true;
+    }
+    m_cv.notify_all();
+  }
+
+  void Wait()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_open; });
+  }
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  bool m_open = false;
+};
+
+class DummyRouter : public IRouter
+{
+public:
+  explicit DummyRouter(Gate & gate) : m_gate(gate) {}
+
+  // IRouter overrides:
+  string GetName() const override { return "Dummy"; }
+  RouterResultCode CalculateRoute(Checkpoints const & checkpoints,
+                                  m2::PointD const & /* startDirection */,
+                                  bool /* adjustToPrevRoute */, RouterDelegate const & delegate,
+                                  Route & /* route */) override
+  {
+    m_gate.Wait();
+    if (delegate.IsCancelled())
+      return RouterResultCode::Cancelled;
+    return checkpoints.GetStart() == checkpoints.GetFinish() ? RouterResultCode::RouteNotFound
+                                                             : RouterResultCode::NoError;
+  }
+
+private:
+  Gate & m_gate;
+};
+
+struct Results
+{
+  void operator()(uint64_t requestId, RouterResultCode code, shared_ptr<Route> route,
+                  RouterPool::Timings const & timings)
+  {
+    TEST(route, ());
+    TEST_GREATER_OR_EQUAL(timings.m_queueSec, 0.0, ());
+    TEST_GREATER_OR_EQUAL(timings.m_computeSec, 0.0, ());
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_ids.push_back(requestId);
+      m_codes.push_back(code);
+    }
+    m_cv.notify_all();
+  }
+
+  void WaitFor(size_t count)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this, count] { return m_ids.size() >= count; });
+  }
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  vector<uint64_t> m_ids;
+  vector<RouterResultCode> m_codes;
+};
+
+RouterPool::Request MakeRequest(m2::PointD const & finish, int32_t priority)
+{
+  RouterPool::Request request;
+  request.m_checkpoints = Checkpoints({0.0, 0.0} /* start */, finish);
+  request.m_priority = priority;
+  return request;
+}
+
+UNIT_TEST(RouterPool_Priorities)
+{
+  Gate gate;
+  Results results;
+  {
+    RouterPool pool(
+        1 /* numRouters */, [&gate]() { return make_unique<DummyRouter>(gate); },
+        [&results](uint64_t id, RouterResultCode code, shared_ptr<Route> route,
+                   RouterPool::Timings const & timings) { results(id, code, route, timings); });
+    TEST_EQUAL(pool.GetNumRouters(), 1, ());
+
+    // The first request occupies the only router so the others are queued.
+    auto const first = pool.CalculateRoute(MakeRequest({1.0, 1.0}, 0 /* priority */));
+    while (pool.GetQueueSize() != 0)
+      this_thread::yield();
+
+    auto const low = pool.CalculateRoute(MakeRequest({1.0, 1.0}, 0 /* priority */));
+    auto const notFound = pool.CalculateRoute(MakeRequest({0.0, 0.0}, 1 /* priority */));
+    auto const high = pool.CalculateRoute(MakeRequest({1.0, 1.0}, 1 /* priority */));
+    auto const cancelled = pool.CalculateRoute(MakeRequest({1.0, 1.0}, 2 /* priority */));
+    TEST_EQUAL(pool.GetQueueSize(), 4, ());
+
+    TEST(pool.Cancel(cancelled), ());
+    TEST(!pool.Cancel(cancelled), ());
+    TEST_EQUAL(pool.GetQueueSize(), 3, ());
+
+    gate.Open();
+    results.WaitFor(5);
+
+    TEST_EQUAL(results.m_ids, vector<uint64_t>({cancelled, first, notFound, high, low}), ());
+    TEST_EQUAL(results.m_codes,
+               vector<RouterResultCode>({RouterResultCode::Cancelled, RouterResultCode::NoError,
+                                         RouterResultCode::RouteNotFound,
+                                         RouterResultCode::NoError, RouterResultCode::NoError}),
+               ());
+  }
+}
+
+UNIT_TEST(RouterPool_Deadlines)
+{
+  Gate gate;
+  Results results;
+  {
+    RouterPool pool(
+        2 /* numRouters */, [&gate]() { return make_unique<DummyRouter>(gate); },
+        [&results](uint64_t id, RouterResultCode code, shared_ptr<Route> route,
+                   RouterPool::Timings const & timings) { results(id, code, route, timings); });
+
+    auto expired = MakeRequest({1.0, 1.0}, 0 /* priority */);
+    expired.m_deadline = RouterPool::Clock::now() - chrono::seconds(1);
+    auto const expiredId = pool.CalculateRoute(expired);
+    results.WaitFor(1);
+
+    TEST_EQUAL(results.m_ids, vector<uint64_t>({expiredId}), ());
+    TEST_EQUAL(results.m_codes, vector<RouterResultCode>({RouterResultCode::Cancelled}), ());
+
+    // Requests which are still queued on destruction are cancelled.
+    for (size_t i = 0; i < 4; ++i)
+      pool.CalculateRoute(MakeRequest({1.0, 1.0}, 0 /* priority */));
+    gate.Open();
+  }
+  TEST_EQUAL(results.m_ids.size(), 5, ());
+}
+}  // namespace
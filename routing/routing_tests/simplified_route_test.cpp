@@ -0,0 +1,120 @@
+#include "testing/testing.hpp"
+
+#include "routing/simplified_route.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// A straight line with small noise and a sharp detour in the middle.
+vector<m2::PointD> MakePolyline()
+{
+  vector<m2::PointD> points;
+  for (size_t i = 0; i <= 1000; ++i)
+  {
+    double const x = 0.001 * i;
+    double y = (i % 2 == 0 ? 1e-7 : -1e-7);
+    if (i >= 490 && i <= 510)
+      y += 0.1 * (10.0 - fabs(static_cast<double>(i) - 500.0)) / 10.0;
+    points.emplace_back(x, y);
+  }
+  return points;
+}
+
+UNIT_TEST(SimplifiedRoute_Levels)
+{
+  auto const points = MakePolyline();
+  SimplifiedRoute const route(points);
+
+  TEST_EQUAL(route.GetNumLevels(), SimplifiedRoute::kZooms.size() + 1, ());
+  TEST_EQUAL(route.GetPointIndices(route.GetNumLevels() - 1).size(), points.size(), ());
+
+  for (size_t level = 0; level < route.GetNumLevels(); ++level)
+  {
+    auto const & indices = route.GetPointIndices(level);
+    TEST_GREATER_OR_EQUAL(indices.size(), 3, (level));
+    TEST_EQUAL(indices.front(), 0, (level));
+    TEST_EQUAL(indices.back(), points.size() - 1, (level));
+    TEST(is_sorted(indices.cbegin(), indices.cend()), (level));
+    // The peak of the detour is kept at every level.
+    TEST(binary_search(indices.cbegin(), indices.cend(), 500), (level));
+
+    if (level == 0)
+      continue;
+
+    // Coarser levels are subsets of finer ones.
+    auto const & finer = route.GetPointIndices(level);
+    auto const & coarser = route.GetPointIndices(level - 1);
+    TEST_LESS_OR_EQUAL(coarser.size(), finer.size(), (level));
+    TEST(includes(finer.cbegin(), finer.cend(), coarser.cbegin(), coarser.cend()), (level));
+  }
+
+  // The noise is dropped at the coarsest level.
+  TEST_LESS(route.GetPointIndices(0).size(), 10, ());
+}
+
+UNIT_TEST(SimplifiedRoute_GetLevel)
+{
+  SimplifiedRoute const route(MakePolyline());
+  auto const & zooms = SimplifiedRoute::kZooms;
+  TEST_EQUAL(route.GetLevel(1), 0, ());
+  TEST_EQUAL(route.GetLevel(zooms[0]), 0, ());
+  TEST_EQUAL(route.GetLevel(zooms[0] + 1), 1, ());
+  TEST_EQUAL(route.GetLevel(zooms.back()), zooms.size() - 1, ());
+  TEST_EQUAL(route.GetLevel(zooms.back() + 1), zooms.size(), ());
+  TEST_EQUAL(route.GetLevel(20), route.GetNumLevels() - 1, ());
+}
+
+UNIT_TEST(RouteGeometry_EncodeDecodeByChunks)
+{
+  SimplifiedRoute const route(MakePolyline());
+  size_t const level = route.GetNumLevels() - 1;
+  auto const & expectedIndices = route.GetPointIndices(level);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    RouteGeometryEncoder encoder(route, level);
+    encoder.WriteHeader(writer);
+    size_t numChunks = 0;
+    while (encoder.WriteChunk(writer, 64 /* maxPoints */))
+      ++numChunks;
+    TEST_EQUAL(numChunks, (expectedIndices.size() + 63) / 64, ());
+  }
+  // Deltas of neighbouring points are much shorter than coordinates.
+  TEST_LESS(buffer.size(), expectedIndices.size() * 8, ());
+
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  RouteGeometryDecoder decoder;
+  decoder.ReadHeader(src);
+  TEST_EQUAL(decoder.GetNumPoints(), expectedIndices.size(), ());
+  TEST_EQUAL(decoder.GetZoom(), SimplifiedRoute::kZooms.back() + 1, ());
+
+  vector<m2::PointD> points;
+  vector<uint32_t> indices;
+  while (!decoder.IsFinished())
+  {
+    size_t const numPoints = points.size();
+    decoder.ReadChunk(src, points, indices);
+    TEST_GREATER(points.size(), numPoints, ());
+  }
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TEST_EQUAL(indices, expectedIndices, ());
+  TEST_EQUAL(points.size(), expectedIndices.size(), ());
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST(points[i].EqualDxDy(route.GetPoint(level, i), 1e-6), (i));
+}
+}  // namespace
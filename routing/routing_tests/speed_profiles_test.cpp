@@ -0,0 +1,133 @@
+#include "testing/testing.hpp"
+
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Segment is (numMwmId, featureId, segmentIdx, isForward).
+Segment const kS0 = {0 /* numMwmId */, 1 /* featureId */, 0 /* segmentIdx */, true /* forward */};
+Segment const kS1 = {0 /* numMwmId */, 1 /* featureId */, 0 /* segmentIdx */, false /* forward */};
+Segment const kS2 = {0 /* numMwmId */, 7 /* featureId */, 3 /* segmentIdx */, true /* forward */};
+
+// Speed is 50% on weekdays from 8:00 to 10:00.
+SpeedProfiles::Profile MakeRushHourProfile()
+{
+  SpeedProfiles::Profile profile;
+  profile.fill(SpeedProfiles::kFreeFlowSpeedPercent);
+  for (uint32_t day = 0; day < 5; ++day)
+  {
+    profile[day * 24 + 8] = 50;
+    profile[day * 24 + 9] = 50;
+  }
+  return profile;
+}
+
+SpeedProfiles MakeSpeedProfiles()
+{
+  SpeedProfiles speedProfiles;
+  uint32_t const rushHour = speedProfiles.AddProfile(MakeRushHourProfile());
+  SpeedProfiles::Profile slow;
+  slow.fill(20);
+  uint32_t const slowId = speedProfiles.AddProfile(slow);
+
+  speedProfiles.SetProfile(kS0, rushHour);
+  speedProfiles.SetProfile(kS2, slowId);
+  return speedProfiles;
+}
+
+UNIT_TEST(SpeedProfiles_WeekTime)
+{
+  uint32_t constexpr kHour = SpeedProfiles::kSecondsPerHour;
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(0.0), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(kHour - 0.5), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(kHour), 1, ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(SpeedProfiles::kSecondsPerWeek - 1.0), 167, ());
+  // Time of week is cyclic.
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(SpeedProfiles::kSecondsPerWeek + 2.5 * kHour), 2, ());
+
+  tm localTime = {};
+  // Sunday 23:59:30.
+  localTime.tm_wday = 0;
+  localTime.tm_hour = 23;
+  localTime.tm_min = 59;
+  localTime.tm_sec = 30;
+  TEST_EQUAL(SpeedProfiles::GetWeekTime(localTime), SpeedProfiles::kSecondsPerWeek - 30, ());
+  // Tuesday 08:15:00.
+  localTime.tm_wday = 2;
+  localTime.tm_hour = 8;
+  localTime.tm_min = 15;
+  localTime.tm_sec = 0;
+  TEST_EQUAL(SpeedProfiles::GetWeekTime(localTime), (24 + 8) * kHour + 15 * 60, ());
+}
+
+UNIT_TEST(SpeedProfiles_Smoke)
+{
+  SpeedProfiles const speedProfiles = MakeSpeedProfiles();
+  TEST_EQUAL(speedProfiles.GetNumProfiles(), 2, ());
+  TEST_EQUAL(speedProfiles.GetNumSegments(), 2, ());
+
+  uint32_t const rushHour = speedProfiles.GetProfileId(kS0);
+  TEST_EQUAL(rushHour, 0, ());
+  TEST_EQUAL(speedProfiles.GetProfileId(kS2), 1, ());
+  // Mwm id is ignored.
+  TEST_EQUAL(speedProfiles.GetProfileId({5 /* numMwmId */, 1, 0, true}), rushHour, ());
+  // Another direction.
+  TEST_EQUAL(speedProfiles.GetProfileId(kS1), SpeedProfiles::kNoProfile, ());
+  TEST_EQUAL(speedProfiles.GetProfileId({0, 7, 2, true}), SpeedProfiles::kNoProfile, ());
+  TEST_EQUAL(speedProfiles.GetProfileId({0, 8, 0, true}), SpeedProfiles::kNoProfile, ());
+
+  uint32_t constexpr kHour = SpeedProfiles::kSecondsPerHour;
+  // Monday 08:30.
+  TEST_EQUAL(speedProfiles.GetSpeedPercent(rushHour, 8.5 * kHour), 50, ());
+  // Monday 10:00.
+  TEST_EQUAL(speedProfiles.GetSpeedPercent(rushHour, 10 * kHour), 100, ());
+  // Saturday 09:00.
+  TEST_EQUAL(speedProfiles.GetSpeedPercent(rushHour, (5 * 24 + 9) * kHour), 100, ());
+  TEST_EQUAL(speedProfiles.GetSpeedPercent(1 /* profileId */, 0.0), 20, ());
+}
+
+UNIT_TEST(SpeedProfiles_Serialization)
+{
+  SpeedProfiles const speedProfiles = MakeSpeedProfiles();
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<decltype(buf)> writer(buf);
+    speedProfiles.Serialize(writer);
+  }
+
+  SpeedProfiles deserialized;
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> src(memReader);
+  deserialized.Deserialize(src);
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TEST_EQUAL(deserialized.GetNumProfiles(), speedProfiles.GetNumProfiles(), ());
+  TEST_EQUAL(deserialized.GetNumSegments(), speedProfiles.GetNumSegments(), ());
+  for (Segment const & segment : {kS0, kS1, kS2})
+  {
+    uint32_t const profileId = speedProfiles.GetProfileId(segment);
+    TEST_EQUAL(deserialized.GetProfileId(segment), profileId, (segment));
+    if (profileId == SpeedProfiles::kNoProfile)
+      continue;
+
+    for (uint32_t hour = 0; hour < SpeedProfiles::kHoursPerWeek; ++hour)
+    {
+      double const weekTimeS = hour * SpeedProfiles::kSecondsPerHour;
+      TEST_EQUAL(deserialized.GetSpeedPercent(profileId, weekTimeS),
+                 speedProfiles.GetSpeedPercent(profileId, weekTimeS), (segment, hour));
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,194 @@
+#include "testing/testing.hpp"
+
+#include "routing/transit_raptor.hpp"
+#include "routing/transit_raptor_router.hpp"
+
+#include "transit/transit_schedule.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using Schedule = transit::Schedule;
+using Time = Schedule::Time;
+using Leg = TransitRaptor::Leg;
+
+uint32_t constexpr kS = 0;
+uint32_t constexpr kX = 1;
+uint32_t constexpr kY = 2;
+uint32_t constexpr kT = 3;
+uint32_t constexpr kZ = 4;
+
+Schedule::Trip MakeTrip(vector<Time> const & times)
+{
+  Schedule::Trip trip;
+  for (Time const time : times)
+    trip.emplace_back(time, time);
+  return trip;
+}
+
+// Line 1 goes S -> X -> T slowly at 100 and 400. Line 2 goes S -> X at 100 and line 3 goes
+// Y -> T fast at 300. X and Y are connected with a footpath. Z is an isolated stop.
+Schedule MakeSchedule()
+{
+  Schedule schedule;
+  for (uint32_t i = 0; i < 5; ++i)
+    schedule.AddStop(100 + i /* stopId */, m2::PointD(0.001 * i, 0.0));
+
+  schedule.AddPattern(1 /* lineId */, {kS, kX, kT},
+                      {MakeTrip({100, 300, 1000}), MakeTrip({400, 600, 1300})});
+  schedule.AddPattern(2 /* lineId */, {kS, kX}, {MakeTrip({100, 200})});
+  schedule.AddPattern(3 /* lineId */, {kY, kT}, {MakeTrip({300, 500})});
+  schedule.AddTransfer(kX, kY, 50 /* durationSec */);
+  schedule.Build();
+  return schedule;
+}
+
+TransitRaptor::Query MakeQuery(uint32_t from, uint32_t to, Time departureTime)
+{
+  TransitRaptor::Query query;
+  query.m_sources.emplace_back(from, 0 /* durationSec */);
+  query.m_targets.emplace_back(to, 0 /* durationSec */);
+  query.m_departureTime = departureTime;
+  return query;
+}
+
+void TestLeg(Leg const & leg, Leg::Type type, uint32_t from, uint32_t to, Time departureTime,
+             Time arrivalTime)
+{
+  TEST_EQUAL(leg.m_type, type, ());
+  if (type != Leg::Type::Access)
+    TEST_EQUAL(leg.m_from, from, ());
+  if (type != Leg::Type::Egress)
+    TEST_EQUAL(leg.m_to, to, ());
+  TEST_EQUAL(leg.m_departureTime, departureTime, ());
+  TEST_EQUAL(leg.m_arrivalTime, arrivalTime, ());
+}
+
+UNIT_TEST(TransitRaptor_ParetoJourneys)
+{
+  Schedule const schedule = MakeSchedule();
+  TransitRaptor raptor(schedule);
+  vector<TransitRaptor::Journey> journeys;
+  raptor.FindJourneys(MakeQuery(kS, kT, 0 /* departureTime */), journeys);
+
+  TEST_EQUAL(journeys.size(), 2, ());
+
+  auto const & direct = journeys[0];
+  TEST_EQUAL(direct.m_numRides, 1, ());
+  TEST_EQUAL(direct.m_arrivalTime, 1000, ());
+  TEST_EQUAL(direct.m_legs.size(), 3, ());
+  TestLeg(direct.m_legs[0], Leg::Type::Access, kS, kS, 0, 0);
+  TestLeg(direct.m_legs[1], Leg::Type::Ride, kS, kT, 100, 1000);
+  TEST_EQUAL(direct.m_legs[1].m_fromPos, 0, ());
+  TEST_EQUAL(direct.m_legs[1].m_toPos, 2, ());
+  TestLeg(direct.m_legs[2], Leg::Type::Egress, kT, kT, 1000, 1000);
+
+  auto const & fast = journeys[1];
+  TEST_EQUAL(fast.m_numRides, 2, ());
+  TEST_EQUAL(fast.m_arrivalTime, 500, ());
+  TEST_EQUAL(fast.m_legs.size(), 5, ());
+  TestLeg(fast.m_legs[0], Leg::Type::Access, kS, kS, 0, 0);
+  TestLeg(fast.m_legs[1], Leg::Type::Ride, kS, kX, 100, 200);
+  TestLeg(fast.m_legs[2], Leg::Type::Transfer, kX, kY, 200, 250);
+  TestLeg(fast.m_legs[3], Leg::Type::Ride, kY, kT, 300, 500);
+  TestLeg(fast.m_legs[4], Leg::Type::Egress, kT, kT, 500, 500);
+}
+
+UNIT_TEST(TransitRaptor_LateDeparture)
+{
+  Schedule const schedule = MakeSchedule();
+  TransitRaptor raptor(schedule);
+  vector<TransitRaptor::Journey> journeys;
+
+  // The trips at 100 are missed.
+  raptor.FindJourneys(MakeQuery(kS, kT, 150 /* departureTime */), journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_arrivalTime, 1300, ());
+  TEST_EQUAL(journeys[0].m_legs[1].m_trip, 1, ());
+
+  // The fast journey needs two rides.
+  auto query = MakeQuery(kS, kT, 0 /* departureTime */);
+  query.m_maxRides = 1;
+  raptor.FindJourneys(query, journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_arrivalTime, 1000, ());
+
+  raptor.FindJourneys(MakeQuery(kS, kT, 500 /* departureTime */), journeys);
+  TEST(journeys.empty(), ());
+}
+
+UNIT_TEST(TransitRaptor_Unreachable)
+{
+  Schedule const schedule = MakeSchedule();
+  TransitRaptor raptor(schedule);
+  vector<TransitRaptor::Journey> journeys;
+  raptor.FindJourneys(MakeQuery(kS, kZ, 0 /* departureTime */), journeys);
+  TEST(journeys.empty(), ());
+
+  // Trips don't go backwards.
+  raptor.FindJourneys(MakeQuery(kT, kS, 0 /* departureTime */), journeys);
+  TEST(journeys.empty(), ());
+}
+
+UNIT_TEST(TransitRaptor_AccessAndEgress)
+{
+  Schedule const schedule = MakeSchedule();
+  TransitRaptor raptor(schedule);
+
+  // Walking to Y and catching line 3 is faster than line 1 from S.
+  TransitRaptor::Query query;
+  query.m_sources.emplace_back(kS, 0 /* durationSec */);
+  query.m_sources.emplace_back(kY, 250 /* durationSec */);
+  query.m_targets.emplace_back(kT, 60 /* durationSec */);
+  query.m_departureTime = 0;
+
+  vector<TransitRaptor::Journey> journeys;
+  raptor.FindJourneys(query, journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_numRides, 1, ());
+  TEST_EQUAL(journeys[0].m_arrivalTime, 560, ());
+  TestLeg(journeys[0].m_legs[0], Leg::Type::Access, kY, kY, 0, 250);
+  TestLeg(journeys[0].m_legs[1], Leg::Type::Ride, kY, kT, 300, 500);
+  TestLeg(journeys[0].m_legs[2], Leg::Type::Egress, kT, kT, 500, 560);
+}
+
+UNIT_TEST(TransitRaptorRouter_AppendJourney)
+{
+  Schedule const schedule = MakeSchedule();
+  TransitRaptor raptor(schedule);
+  vector<TransitRaptor::Journey> journeys;
+  raptor.FindJourneys(MakeQuery(kS, kT, 0 /* departureTime */), journeys);
+  TEST_EQUAL(journeys.size(), 2, ());
+
+  m2::PointD const start(-0.001, 0.0);
+  m2::PointD const finish(0.004, 0.0);
+  vector<Junction> junctions = {Junction(start, 0 /* altitude */)};
+  Route::TTimes times = {{0, 0.0}};
+  TransitRaptorRouter::AppendJourney(schedule, journeys.back(), finish,
+                                     0 /* routeDepartureTime */, junctions, times);
+
+  // Start, S, X, Y, T and finish.
+  vector<m2::PointD> const expectedPoints = {start,
+                                             schedule.GetStopPoint(kS),
+                                             schedule.GetStopPoint(kX),
+                                             schedule.GetStopPoint(kY),
+                                             schedule.GetStopPoint(kT),
+                                             finish};
+  vector<double> const expectedTimes = {0.0, 0.0, 200.0, 250.0, 500.0, 500.0};
+  TEST_EQUAL(junctions.size(), expectedPoints.size(), ());
+  TEST_EQUAL(times.size(), expectedTimes.size(), ());
+  for (size_t i = 0; i < junctions.size(); ++i)
+  {
+    TEST_EQUAL(junctions[i].GetPoint(), expectedPoints[i], (i));
+    TEST_EQUAL(times[i].first, i, ());
+    TEST_EQUAL(times[i].second, expectedTimes[i], (i));
+  }
+}
+}  // namespace
@@ -79,6 +79,19 @@ public:
     return m_mwmId != kFakeNumMwmId && !FakeFeatureIds::IsTransitFeature(m_featureId);
   }
 
+  struct Hash
+  {
+    uint64_t operator()(Segment const & segment) const
+    {
+      uint64_t const featureAndIdx = (static_cast<uint64_t>(segment.m_featureId) << 32) +
+                                     static_cast<uint64_t>(segment.m_segmentIdx);
+      uint64_t const mwmAndDirection = (static_cast<uint64_t>(segment.m_mwmId) << 1) +
+                                       static_cast<uint64_t>(segment.m_forward);
+      // Highest bits of feature id are almost always zero.
+      return featureAndIdx ^ (mwmAndDirection << 47);
+    }
+  };
+
 private:
   uint32_t m_featureId = 0;
   uint32_t m_segmentIdx = 0;
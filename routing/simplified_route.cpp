@@ -0,0 +1,63 @@
+#include "routing/simplified_route.hpp"
+
+#include "indexer/scales.hpp"
+
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/simplification.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+namespace routing
+{
+namespace
+{
+// Point of the route polyline with its index for simplification of indices.
+struct IndexedPoint
+{
+  operator m2::PointD() const { return m_point; }
+
+  m2::PointD m_point;
+  uint32_t m_index = 0;
+};
+}  // namespace
+
+array<int, 5> constexpr SimplifiedRoute::kZooms;
+uint16_t constexpr RouteGeometryEncoder::kLatestVersion;
+
+SimplifiedRoute::SimplifiedRoute(vector<m2::PointD> const & points)
+  : m_points(points), m_levels(kZooms.size() + 1)
+{
+  auto & finest = m_levels.back();
+  finest.resize(m_points.size());
+  for (size_t i = 0; i < finest.size(); ++i)
+    finest[i] = base::asserted_cast<uint32_t>(i);
+
+  vector<IndexedPoint> finer;
+  m2::SquaredDistanceFromSegmentToPoint<m2::PointD> distFn;
+  for (size_t level = kZooms.size(); level > 0; --level)
+  {
+    finer.clear();
+    for (uint32_t const index : m_levels[level])
+      finer.push_back({m_points[index], index});
+
+    double const eps = pow(scales::GetEpsilonForSimplify(kZooms[level - 1]), 2);
+    auto & coarser = m_levels[level - 1];
+    SimplifyDP(finer.cbegin(), finer.cend(), eps, distFn,
+               [&coarser](IndexedPoint const & p) { coarser.push_back(p.m_index); });
+  }
+}
+
+size_t SimplifiedRoute::GetLevel(int zoom) const
+{
+  auto const it = lower_bound(kZooms.cbegin(), kZooms.cend(), zoom);
+  return static_cast<size_t>(distance(kZooms.cbegin(), it));
+}
+
+RouteGeometryEncoder::RouteGeometryEncoder(SimplifiedRoute const & route, size_t level)
+  : m_route(route), m_level(level)
+{
+  CHECK_LESS(m_level, m_route.GetNumLevels(), ());
+}
+}  // namespace routing
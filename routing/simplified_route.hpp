@@ -0,0 +1,155 @@
+#pragma once
+
+#include "coding/geometry_coding.hpp"
+#include "coding/pointd_to_pointu.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+// Route polyline simplified with Douglas-Peucker for several zoom levels. Every level is
+// simplified from the finer one, so points of a coarser level are a subset of points of a finer
+// level and a client may switch levels without jumps of the line. The finest level is the
+// whole polyline.
+class SimplifiedRoute final
+{
+public:
+  // Zooms the levels are simplified for. The last level is not simplified and is used for zooms
+  // greater than the last one.
+  static std::array<int, 5> constexpr kZooms = {{6, 9, 12, 14, 16}};
+
+  explicit SimplifiedRoute(std::vector<m2::PointD> const & points);
+
+  size_t GetNumLevels() const { return m_levels.size(); }
+  // Returns the coarsest level which is detailed enough to be drawn at |zoom|.
+  size_t GetLevel(int zoom) const;
+  // Returns indices of points of the level in the route polyline in increasing order.
+  std::vector<uint32_t> const & GetPointIndices(size_t level) const
+  {
+    ASSERT_LESS(level, m_levels.size(), ());
+    return m_levels[level];
+  }
+  std::vector<m2::PointD> const & GetPoints() const { return m_points; }
+  m2::PointD const & GetPoint(size_t level, size_t i) const
+  {
+    return m_points[GetPointIndices(level)[i]];
+  }
+
+private:
+  std::vector<m2::PointD> m_points;
+  std::vector<std::vector<uint32_t>> m_levels;
+};
+
+// Encodes a level of SimplifiedRoute by chunks of points to stream long routes to clients.
+// Every point is a delta from the previous one in coordinates of POINT_COORD_BITS bits and
+// a delta of its index in the route polyline. The chunks may be decoded one by one as they
+// are received.
+//
+// Layout: header is version, level zoom and number of points, every chunk is number of points
+// in the chunk and the points. All the numbers except version are varints.
+class RouteGeometryEncoder final
+{
+public:
+  static uint16_t constexpr kLatestVersion = 0;
+
+  RouteGeometryEncoder(SimplifiedRoute const & route, size_t level);
+
+  template <typename Sink>
+  void WriteHeader(Sink & sink) const
+  {
+    WriteToSink(sink, kLatestVersion);
+    int const zoom = m_level < SimplifiedRoute::kZooms.size()
+                         ? SimplifiedRoute::kZooms[m_level]
+                         : SimplifiedRoute::kZooms.back() + 1;
+    WriteVarUint(sink, base::asserted_cast<uint32_t>(zoom));
+    WriteVarUint(sink, base::asserted_cast<uint32_t>(m_route.GetPointIndices(m_level).size()));
+  }
+
+  // Writes a chunk of at most |maxPoints| points following the written ones.
+  // Returns false if all the points have been written before the call.
+  template <typename Sink>
+  bool WriteChunk(Sink & sink, size_t maxPoints)
+  {
+    CHECK_GREATER(maxPoints, 0, ());
+    auto const & indices = m_route.GetPointIndices(m_level);
+    if (m_next == indices.size())
+      return false;
+
+    size_t const end = std::min(indices.size(), m_next + maxPoints);
+    WriteVarUint(sink, base::asserted_cast<uint32_t>(end - m_next));
+    for (; m_next < end; ++m_next)
+    {
+      m2::PointU const point =
+          PointDToPointU(m_route.GetPoint(m_level, m_next), POINT_COORD_BITS);
+      coding::EncodePointDelta(sink, m_prevPoint, point);
+      WriteVarUint(sink, indices[m_next] - m_prevIndex);
+      m_prevPoint = point;
+      m_prevIndex = indices[m_next];
+    }
+    return true;
+  }
+
+private:
+  SimplifiedRoute const & m_route;
+  size_t const m_level;
+  size_t m_next = 0;
+  m2::PointU m_prevPoint = m2::PointU::Zero();
+  uint32_t m_prevIndex = 0;
+};
+
+// Decodes a level written by RouteGeometryEncoder.
+class RouteGeometryDecoder final
+{
+public:
+  template <typename Source>
+  void ReadHeader(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, RouteGeometryEncoder::kLatestVersion, ());
+    m_zoom = ReadVarUint<uint32_t>(src);
+    m_numPoints = ReadVarUint<uint32_t>(src);
+    m_numRead = 0;
+    m_prevPoint = m2::PointU::Zero();
+    m_prevIndex = 0;
+  }
+
+  // Appends points of the next chunk and their indices in the route polyline to |points| and
+  // |indices|.
+  template <typename Source>
+  void ReadChunk(Source & src, std::vector<m2::PointD> & points, std::vector<uint32_t> & indices)
+  {
+    auto const numPoints = ReadVarUint<uint32_t>(src);
+    CHECK_LESS_OR_EQUAL(numPoints, m_numPoints - m_numRead, ());
+    for (uint32_t i = 0; i < numPoints; ++i)
+    {
+      m_prevPoint = coding::DecodePointDelta(src, m_prevPoint);
+      m_prevIndex += ReadVarUint<uint32_t>(src);
+      points.push_back(PointUToPointD(m_prevPoint, POINT_COORD_BITS));
+      indices.push_back(m_prevIndex);
+    }
+    m_numRead += numPoints;
+  }
+
+  uint32_t GetZoom() const { return m_zoom; }
+  uint32_t GetNumPoints() const { return m_numPoints; }
+  bool IsFinished() const { return m_numRead == m_numPoints; }
+
+private:
+  uint32_t m_zoom = 0;
+  uint32_t m_numPoints = 0;
+  uint32_t m_numRead = 0;
+  m2::PointU m_prevPoint = m2::PointU::Zero();
+  uint32_t m_prevIndex = 0;
+};
+}  // namespace routing
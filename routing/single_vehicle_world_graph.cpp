@@ -1,5 +1,6 @@
 #include "routing/single_vehicle_world_graph.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace routing
@@ -49,6 +50,12 @@ m2::PointD const & SingleVehicleWorldGraph::GetPoint(Segment const & segment, bo
   return GetJunction(segment, front).GetPoint();
 }
 
+void SingleVehicleWorldGraph::ClearCachedGraphs()
+{
+  m_loader->Clear();
+  m_speedProfileRefs.clear();
+}
+
 bool SingleVehicleWorldGraph::IsOneWay(NumMwmId mwmId, uint32_t featureId)
 {
   return GetRoadGeometry(mwmId, featureId).IsOneWay();
@@ -75,7 +82,19 @@ void SingleVehicleWorldGraph::GetIngoingEdgesList(Segment const & segment,
 
 RouteWeight SingleVehicleWorldGraph::HeuristicCostEstimate(Segment const & from, Segment const & to)
 {
-  return HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+  RouteWeight const estimate =
+      HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+
+  // Landmarks lower bounds are valid for routes which don't leave the mwm only.
+  if (m_mode != Mode::SingleMwm || from.GetMwmId() != to.GetMwmId())
+    return estimate;
+
+  Landmarks const * landmarks = m_loader->GetLandmarks(from.GetMwmId());
+  if (landmarks == nullptr)
+    return estimate;
+
+  // Maximum of consistent heuristics is a consistent heuristic.
+  return RouteWeight(max(estimate.GetWeight(), landmarks->GetLowerBound(from, to)));
 }
 
 RouteWeight SingleVehicleWorldGraph::HeuristicCostEstimate(m2::PointD const & from,
@@ -107,11 +126,29 @@ double SingleVehicleWorldGraph::CalcSegmentETA(Segment const & segment)
   return m_estimator->CalcSegmentETA(segment, GetRoadGeometry(segment.GetMwmId(), segment.GetFeatureId()));
 }
 
+bool SingleVehicleWorldGraph::CalcSegmentWeightAtTime(Segment const & segment, double weekTimeS,
+                                                      RouteWeight & weight)
+{
+  SpeedProfileRef const & profile = GetSpeedProfile(segment);
+  if (profile.m_profiles == nullptr)
+    return false;
+
+  uint8_t const speedPercent = profile.m_profiles->GetSpeedPercent(profile.m_profileId, weekTimeS);
+  weight = RouteWeight(m_estimator->CalcSegmentWeightWithProfile(
+      segment, GetRoadGeometry(segment.GetMwmId(), segment.GetFeatureId()), speedPercent));
+  return true;
+}
+
 bool SingleVehicleWorldGraph::LeapIsAllowed(NumMwmId mwmId) const
 {
   return m_estimator->LeapIsAllowed(mwmId);
 }
 
+bool SingleVehicleWorldGraph::CrossMwmWeightsExist(NumMwmId mwmId)
+{
+  return m_crossMwmGraph->WeightsExist(mwmId);
+}
+
 vector<Segment> const & SingleVehicleWorldGraph::GetTransitions(NumMwmId numMwmId, bool isEnter)
 {
   return m_crossMwmGraph->GetTransitions(numMwmId, isEnter);
@@ -134,4 +171,25 @@ void SingleVehicleWorldGraph::GetTwinsInner(Segment const & segment, bool isOutg
 {
   m_crossMwmGraph->GetTwins(segment, isOutgoing, twins);
 }
+
+SingleVehicleWorldGraph::SpeedProfileRef const & SingleVehicleWorldGraph::GetSpeedProfile(
+    Segment const & segment)
+{
+  auto const it = m_speedProfileRefs.find(segment);
+  if (it != m_speedProfileRefs.end())
+    return it->second;
+
+  auto & profile = m_speedProfileRefs[segment];
+  SpeedProfiles const * profiles = m_loader->GetSpeedProfiles(segment.GetMwmId());
+  if (profiles == nullptr)
+    return profile;
+
+  uint32_t const profileId = profiles->GetProfileId(segment);
+  if (profileId == SpeedProfiles::kNoProfile)
+    return profile;
+
+  profile.m_profiles = profiles;
+  profile.m_profileId = profileId;
+  return profile;
+}
 }  // namespace routing
@@ -8,6 +8,7 @@
 #include "routing/road_graph.hpp"
 #include "routing/route.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/transit_info.hpp"
 #include "routing/world_graph.hpp"
 
@@ -16,6 +17,7 @@
 #include "geometry/point2d.hpp"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace routing
@@ -37,7 +39,7 @@ public:
   m2::PointD const & GetPoint(Segment const & segment, bool front) override;
   bool IsOneWay(NumMwmId mwmId, uint32_t featureId) override;
   bool IsPassThroughAllowed(NumMwmId mwmId, uint32_t featureId) override;
-  void ClearCachedGraphs() override { m_loader->Clear(); }
+  void ClearCachedGraphs() override;
   void SetMode(Mode mode) override { m_mode = mode; }
   Mode GetMode() const override { return m_mode; }
   void GetOutgoingEdgesList(Segment const & segment, std::vector<SegmentEdge> & edges) override;
@@ -48,7 +50,10 @@ public:
   RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const override;
   RouteWeight CalcOffroadWeight(m2::PointD const & from, m2::PointD const & to) const override;
   double CalcSegmentETA(Segment const & segment) override;
+  bool CalcSegmentWeightAtTime(Segment const & segment, double weekTimeS,
+                               RouteWeight & weight) override;
   bool LeapIsAllowed(NumMwmId mwmId) const override;
+  bool CrossMwmWeightsExist(NumMwmId mwmId) override;
   std::vector<Segment> const & GetTransitions(NumMwmId numMwmId, bool isEnter) override;
   std::unique_ptr<TransitInfo> GetTransitInfo(Segment const & segment) override;
   std::vector<RouteSegment::SpeedCamera> GetSpeedCamInfo(Segment const & segment) override;
@@ -63,11 +68,22 @@ private:
   // WorldGraph overrides:
   void GetTwinsInner(Segment const & s, bool isOutgoing, std::vector<Segment> & twins) override;
 
+  struct SpeedProfileRef
+  {
+    // nullptr if the segment has no speed profile.
+    SpeedProfiles const * m_profiles = nullptr;
+    uint32_t m_profileId = SpeedProfiles::kNoProfile;
+  };
+
   RoadGeometry const & GetRoadGeometry(NumMwmId mwmId, uint32_t featureId);
+  SpeedProfileRef const & GetSpeedProfile(Segment const & segment);
 
   std::unique_ptr<CrossMwmGraph> m_crossMwmGraph;
   std::unique_ptr<IndexGraphLoader> m_loader;
   std::shared_ptr<EdgeEstimator> m_estimator;
   Mode m_mode = Mode::NoLeaps;
+  // Time-dependent weights of a route are calculated for every outgoing edge of every visited
+  // segment, so results of speed profile lookups are cached.
+  std::unordered_map<Segment, SpeedProfileRef, Segment::Hash> m_speedProfileRefs;
 };
 }  // namespace routing
@@ -0,0 +1,72 @@
+#include "routing/speed_profiles.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace routing
+{
+using namespace std;
+
+uint16_t constexpr SpeedProfiles::kLatestVersion;
+uint32_t constexpr SpeedProfiles::kHoursPerWeek;
+uint32_t constexpr SpeedProfiles::kSecondsPerHour;
+uint32_t constexpr SpeedProfiles::kSecondsPerWeek;
+uint32_t constexpr SpeedProfiles::kNoProfile;
+uint8_t constexpr SpeedProfiles::kFreeFlowSpeedPercent;
+
+// static
+uint32_t SpeedProfiles::GetWeekTime(tm const & localTime)
+{
+  // tm_wday is days since Sunday.
+  uint32_t const dayOfWeek = static_cast<uint32_t>(localTime.tm_wday + 6) % 7;
+  // tm_sec may be 60 because of leap seconds.
+  uint32_t const hour = static_cast<uint32_t>(localTime.tm_hour);
+  uint32_t const second = static_cast<uint32_t>(min(localTime.tm_sec, 59));
+  return (dayOfWeek * 24 + hour) * kSecondsPerHour +
+         static_cast<uint32_t>(localTime.tm_min) * 60 + second;
+}
+
+// static
+uint32_t SpeedProfiles::GetHourOfWeek(double weekTimeS)
+{
+  ASSERT_GREATER_OR_EQUAL(weekTimeS, 0.0, ());
+  return static_cast<uint32_t>(fmod(weekTimeS, kSecondsPerWeek) / kSecondsPerHour) %
+         kHoursPerWeek;
+}
+
+uint32_t SpeedProfiles::AddProfile(Profile const & profile)
+{
+  for (uint8_t const speedPercent : profile)
+    CHECK(IsValidSpeedPercent(speedPercent), (speedPercent));
+
+  uint32_t const profileId = GetNumProfiles();
+  CHECK_NOT_EQUAL(profileId, kNoProfile, ());
+  m_speedPercents.insert(m_speedPercents.end(), profile.cbegin(), profile.cend());
+  return profileId;
+}
+
+void SpeedProfiles::SetProfile(Segment const & segment, uint32_t profileId)
+{
+  CHECK_LESS(profileId, GetNumProfiles(), ());
+  CHECK_LESS(segment.GetSegmentIdx(), numeric_limits<uint32_t>::max() >> 1, ());
+
+  Entry entry;
+  entry.m_featureId = segment.GetFeatureId();
+  entry.m_segmentKey = GetSegmentKey(segment);
+  entry.m_profileId = profileId;
+  CHECK(m_entries.empty() || m_entries.back() < entry, ("Segments are not sorted:", segment));
+  m_entries.push_back(entry);
+}
+
+uint32_t SpeedProfiles::GetProfileId(Segment const & segment) const
+{
+  Entry key;
+  key.m_featureId = segment.GetFeatureId();
+  key.m_segmentKey = GetSegmentKey(segment);
+  auto const it = lower_bound(m_entries.cbegin(), m_entries.cend(), key);
+  if (it == m_entries.cend() || key < *it)
+    return kNoProfile;
+
+  return it->m_profileId;
+}
+}  // namespace routing
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "routing/segment.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+// Time-dependent speeds of road segments of one mwm. A speed profile is a histogram of speeds
+// of a segment for every hour of week in percents of its free flow speed. Segments with similar
+// traffic share profiles, so the profiles are stored once and segments keep ids of them.
+//
+// Time of week is seconds since Monday 00:00 of local time. It's cyclic: a route which is
+// longer than a week continues with Monday again.
+//
+// Speeds never exceed free flow speed. So weights calculated with profiles are not less
+// than weights without traffic and A* heuristics stay consistent.
+class SpeedProfiles final
+{
+public:
+  static uint16_t constexpr kLatestVersion = 0;
+  static uint32_t constexpr kHoursPerWeek = 7 * 24;
+  static uint32_t constexpr kSecondsPerHour = 60 * 60;
+  static uint32_t constexpr kSecondsPerWeek = kHoursPerWeek * kSecondsPerHour;
+  static uint32_t constexpr kNoProfile = std::numeric_limits<uint32_t>::max();
+  static uint8_t constexpr kFreeFlowSpeedPercent = 100;
+
+  // Speeds in percents of free flow speed, hour 0 is Monday 00:00-01:00.
+  using Profile = std::array<uint8_t, kHoursPerWeek>;
+
+  // Returns time of week of |localTime|.
+  static uint32_t GetWeekTime(std::tm const & localTime);
+  // Returns hour of week of |weekTimeS|. |weekTimeS| may be greater than kSecondsPerWeek.
+  static uint32_t GetHourOfWeek(double weekTimeS);
+
+  // Returns id of the added |profile|. All the speeds of |profile| should be in range
+  // [1, kFreeFlowSpeedPercent].
+  uint32_t AddProfile(Profile const & profile);
+  // Segments should be added in increasing order. Mwm id of |segment| is ignored.
+  void SetProfile(Segment const & segment, uint32_t profileId);
+
+  uint32_t GetNumProfiles() const
+  {
+    return base::asserted_cast<uint32_t>(m_speedPercents.size() / kHoursPerWeek);
+  }
+  uint32_t GetNumSegments() const { return base::asserted_cast<uint32_t>(m_entries.size()); }
+  bool IsEmpty() const { return m_entries.empty(); }
+
+  // Returns kNoProfile if |segment| has no profile. Mwm id of |segment| is ignored.
+  uint32_t GetProfileId(Segment const & segment) const;
+
+  uint8_t GetSpeedPercent(uint32_t profileId, double weekTimeS) const
+  {
+    ASSERT_LESS(profileId, GetNumProfiles(), ());
+    return m_speedPercents[static_cast<size_t>(profileId) * kHoursPerWeek +
+                           GetHourOfWeek(weekTimeS)];
+  }
+
+  // Layout: version, number of profiles, profiles, number of segments and for every segment
+  // delta of feature id, segment index with direction and profile id. All the numbers
+  // except version are varints.
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kLatestVersion);
+    WriteVarUint(sink, GetNumProfiles());
+    sink.Write(m_speedPercents.data(), m_speedPercents.size());
+
+    WriteVarUint(sink, GetNumSegments());
+    uint32_t prevFeatureId = 0;
+    for (Entry const & entry : m_entries)
+    {
+      WriteVarUint(sink, entry.m_featureId - prevFeatureId);
+      WriteVarUint(sink, entry.m_segmentKey);
+      WriteVarUint(sink, entry.m_profileId);
+      prevFeatureId = entry.m_featureId;
+    }
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    auto const numProfiles = ReadVarUint<uint32_t>(src);
+    m_speedPercents.resize(static_cast<size_t>(numProfiles) * kHoursPerWeek);
+    src.Read(m_speedPercents.data(), m_speedPercents.size());
+    for (uint8_t const speedPercent : m_speedPercents)
+      CHECK(IsValidSpeedPercent(speedPercent), (speedPercent));
+
+    m_entries.resize(ReadVarUint<uint32_t>(src));
+    uint32_t featureId = 0;
+    for (Entry & entry : m_entries)
+    {
+      featureId += ReadVarUint<uint32_t>(src);
+      entry.m_featureId = featureId;
+      entry.m_segmentKey = ReadVarUint<uint32_t>(src);
+      entry.m_profileId = ReadVarUint<uint32_t>(src);
+      CHECK_LESS(entry.m_profileId, numProfiles, ());
+    }
+  }
+
+private:
+  struct Entry
+  {
+    bool operator<(Entry const & rhs) const
+    {
+      if (m_featureId != rhs.m_featureId)
+        return m_featureId < rhs.m_featureId;
+      return m_segmentKey < rhs.m_segmentKey;
+    }
+
+    uint32_t m_featureId = 0;
+    // Segment index and direction, see GetSegmentKey().
+    uint32_t m_segmentKey = 0;
+    uint32_t m_profileId = kNoProfile;
+  };
+
+  static uint32_t GetSegmentKey(Segment const & segment)
+  {
+    return (segment.GetSegmentIdx() << 1) + (segment.IsForward() ? 1 : 0);
+  }
+
+  static bool IsValidSpeedPercent(uint8_t speedPercent)
+  {
+    return speedPercent > 0 && speedPercent <= kFreeFlowSpeedPercent;
+  }
+
+  // Sorted by feature id and segment key.
+  std::vector<Entry> m_entries;
+  // kHoursPerWeek speeds of every profile.
+  std::vector<uint8_t> m_speedPercents;
+};
+}  // namespace routing
@@ -20,16 +20,10 @@ traffic::SpeedGroup TrafficStash::GetSpeedGroup(Segment const & segment) const
   if (itMwm == m_mwmToTraffic.cend())
     return traffic::SpeedGroup::Unknown;
 
-  auto const & coloring = itMwm->second;
-  auto const itSeg = coloring->find(traffic::TrafficInfo::RoadSegmentId(
+  return itMwm->second->Get(traffic::TrafficInfo::RoadSegmentId(
       segment.GetFeatureId(), base::asserted_cast<uint16_t>(segment.GetSegmentIdx()),
       segment.IsForward() ? traffic::TrafficInfo::RoadSegmentId::kForwardDirection
                           : traffic::TrafficInfo::RoadSegmentId::kReverseDirection));
-
-  if (itSeg == coloring->cend())
-    return traffic::SpeedGroup::Unknown;
-
-  return itSeg->second;
 }
 
 void TrafficStash::SetColoring(NumMwmId numMwmId,
@@ -5,6 +5,8 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include <algorithm>
+
 namespace routing
 {
 namespace
@@ -94,10 +96,20 @@ RouteWeight TransitGraph::GetTransferPenalty(Segment const & from, Segment const
   // 1. |from| is gate, |to| is edge
   // 2. |from| is transfer, |to| is edge
   // 3. |from| is edge, |to| is edge from another line directly connected to |from|.
-  auto const it = m_transferPenalties.find(lineIdTo);
-  CHECK(it != m_transferPenalties.cend(), ("Segment", to, "belongs to unknown line:", lineIdTo));
-  return RouteWeight(it->second /* weight */, 0 /* nonPassThrougCross */, 0 /* numAccessChanges */,
-                     it->second /* transitTime */);
+  // Line has information about transit interval.
+  // We assume arrival time has uniform distribution with min value |0| and max value |line.GetInterval()|.
+  // Expected value of time to wait transport for particular line is |line.GetInterval() / 2|.
+  // The lines are sorted by their ids.
+  auto const & lines = m_transitData->GetLines();
+  auto const it = lower_bound(lines.cbegin(), lines.cend(), lineIdTo,
+                              [](transit::Line const & line, transit::LineId lineId) {
+                                return line.GetId() < lineId;
+                              });
+  CHECK(it != lines.cend() && it->GetId() == lineIdTo,
+        ("Segment", to, "belongs to unknown line:", lineIdTo));
+  double const penalty = it->GetInterval() / 2;
+  return RouteWeight(penalty /* weight */, 0 /* nonPassThrougCross */, 0 /* numAccessChanges */,
+                     penalty /* transitTime */);
 }
 
 void TransitGraph::GetTransitEdges(Segment const & segment, bool isOutgoing,
@@ -122,16 +134,15 @@ bool TransitGraph::FindReal(Segment const & fake, Segment & real) const
   return m_fake.FindReal(fake, real);
 }
 
-void TransitGraph::Fill(transit::GraphData const & transitData, GateEndings const & gateEndings)
+void TransitGraph::Fill(shared_ptr<transit::GraphData const> transitData,
+                        GateEndings const & gateEndings)
 {
-  // Line has information about transit interval.
-  // We assume arrival time has uniform distribution with min value |0| and max value |line.GetInterval()|.
-  // Expected value of time to wait transport for particular line is |line.GetInterval() / 2|.
-  for (auto const & line : transitData.GetLines())
-    m_transferPenalties[line.GetId()] = line.GetInterval() / 2;
+  CHECK(transitData, ());
+  m_transitData = move(transitData);
+  auto const & data = *m_transitData;
 
   map<transit::StopId, Junction> stopCoords;
-  for (auto const & stop : transitData.GetStops())
+  for (auto const & stop : data.GetStops())
     stopCoords[stop.GetId()] = Junction(stop.GetPoint(), feature::kDefaultAltitudeMeters);
 
   StopToSegmentsMap stopToBack;
@@ -141,7 +152,7 @@ void TransitGraph::Fill(transit::GraphData const & transitData, GateEndings cons
 
   // It's important to add transit edges first to ensure fake segment id for particular edge is edge order
   // in mwm. We use edge fake segments in cross-mwm section and they should be stable.
-  auto const & edges = transitData.GetEdges();
+  auto const & edges = data.GetEdges();
   CHECK_EQUAL(m_fake.GetSize(), 0, ());
   for (size_t i = 0; i < edges.size(); ++i)
   {
@@ -156,7 +167,7 @@ void TransitGraph::Fill(transit::GraphData const & transitData, GateEndings cons
   }
   CHECK_EQUAL(m_fake.GetSize(), edges.size(), ());
 
-  for (auto const & gate : transitData.GetGates())
+  for (auto const & gate : data.GetGates())
   {
     CHECK_NOT_EQUAL(gate.GetWeight(), transit::kInvalidWeight, ("Gate should have valid weight."));
 
@@ -182,21 +193,26 @@ bool TransitGraph::IsGate(Segment const & segment) const
 
 bool TransitGraph::IsEdge(Segment const & segment) const
 {
-  return m_segmentToEdge.count(segment) > 0;
+  if (!m_transitData || !IsTransitSegment(segment))
+    return false;
+
+  auto const index = segment.GetFeatureId() - FakeFeatureIds::kTransitGraphFeaturesStart;
+  return index < m_transitData->GetEdges().size() &&
+         segment == GetTransitSegment(segment.GetFeatureId());
 }
 
 transit::Gate const & TransitGraph::GetGate(Segment const & segment) const
 {
   auto const it = m_segmentToGate.find(segment);
   CHECK(it != m_segmentToGate.cend(), ("Unknown transit segment."));
-  return it->second;
+  return *it->second;
 }
 
 transit::Edge const & TransitGraph::GetEdge(Segment const & segment) const
 {
-  auto const it = m_segmentToEdge.find(segment);
-  CHECK(it != m_segmentToEdge.cend(), ("Unknown transit segment."));
-  return it->second;
+  CHECK(IsEdge(segment), ("Unknown transit segment."));
+  return m_transitData->GetEdges()[segment.GetFeatureId() -
+                                   FakeFeatureIds::kTransitGraphFeaturesStart];
 }
 
 Segment TransitGraph::GetTransitSegment(uint32_t featureId) const
@@ -262,7 +278,7 @@ void TransitGraph::AddGate(transit::Gate const & gate, FakeEnding const & ending
                             FakeVertex::Type::PureFake);
       m_fake.AddVertex(projectionSegment, gateSegment, gateVertex, isEnter /* isOutgoing */,
                        false /* isPartOfReal */, dummy /* realSegment */);
-      m_segmentToGate[gateSegment] = gate;
+      m_segmentToGate[gateSegment] = &gate;
       if (isEnter)
         stopToFront[stopId].insert(gateSegment);
       else
@@ -281,7 +297,6 @@ Segment TransitGraph::AddEdge(transit::Edge const & edge,
   FakeVertex edgeVertex(GetStopJunction(stopCoords, stopFromId),
                         GetStopJunction(stopCoords, stopToId), FakeVertex::Type::PureFake);
   m_fake.AddStandaloneVertex(edgeSegment, edgeVertex);
-  m_segmentToEdge[edgeSegment] = edge;
   stopToBack[stopFromId].insert(edgeSegment);
   stopToFront[stopToId].insert(edgeSegment);
   return edgeSegment;
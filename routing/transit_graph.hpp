@@ -39,7 +39,9 @@ public:
   std::set<Segment> const & GetFake(Segment const & real) const;
   bool FindReal(Segment const & fake, Segment & real) const;
 
-  void Fill(transit::GraphData const & transitData, GateEndings const & gateEndings);
+  // |transitData| may be shared with the other graphs, the graph refers to its gates and edges.
+  void Fill(std::shared_ptr<transit::GraphData const> transitData,
+            GateEndings const & gateEndings);
 
   bool IsGate(Segment const & segment) const;
   bool IsEdge(Segment const & segment) const;
@@ -69,9 +71,10 @@ private:
   NumMwmId const m_mwmId = kFakeNumMwmId;
   std::shared_ptr<EdgeEstimator> m_estimator;
   FakeGraph<Segment, FakeVertex> m_fake;
-  std::map<Segment, transit::Edge> m_segmentToEdge;
-  std::map<Segment, transit::Gate> m_segmentToGate;
-  std::map<transit::LineId, double> m_transferPenalties;
+  std::shared_ptr<transit::GraphData const> m_transitData;
+  // Edge segments are the first segments of |m_fake| in the order of the edges of |m_transitData|,
+  // so the edge of a segment is found by its feature id.
+  std::map<Segment, transit::Gate const *> m_segmentToGate;
 };
 
 void MakeGateEndings(std::vector<transit::Gate> const & gates, NumMwmId mwmId,
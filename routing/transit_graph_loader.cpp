@@ -4,7 +4,7 @@
 #include "routing/routing_exceptions.hpp"
 
 #include "transit/transit_graph_data.hpp"
-#include "transit/transit_serdes.hpp"
+#include "transit/transit_graph_data_cache.hpp"
 #include "transit/transit_types.hpp"
 
 #include "indexer/data_source.hpp"
@@ -14,8 +14,6 @@
 
 #include "coding/file_container.hpp"
 
-#include "base/timer.hpp"
-
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -73,22 +71,14 @@ unique_ptr<TransitGraph> TransitGraphLoaderImpl::CreateTransitGraph(NumMwmId num
   if (!handle.IsAlive())
     MYTHROW(RoutingException, ("Can't get mwm handle for", file));
 
-  base::Timer timer;
   auto graph = make_unique<TransitGraph>(numMwmId, m_estimator);
   MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
-  if (!mwmValue.m_cont.IsExist(TRANSIT_FILE_TAG))
-    return graph;
 
+  shared_ptr<transit::GraphData const> transitData;
   try
   {
-    FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(TRANSIT_FILE_TAG));
-    transit::GraphData transitData;
-    transitData.DeserializeForRouting(*reader.GetPtr());
-
-    TransitGraph::GateEndings gateEndings;
-    MakeGateEndings(transitData.GetGates(), numMwmId, indexGraph, gateEndings);
-
-    graph->Fill(transitData, gateEndings);
+    // The section is shared with the other routers and with the transit rendering.
+    transitData = transit::GraphDataCache::Instance().Get(handle.GetId(), mwmValue.m_cont);
   }
   catch (Reader::OpenException const & e)
   {
@@ -96,8 +86,12 @@ unique_ptr<TransitGraph> TransitGraphLoaderImpl::CreateTransitGraph(NumMwmId num
     throw;
   }
 
-  LOG(LINFO, (TRANSIT_FILE_TAG, "section for", file.GetName(), "loaded in",
-              timer.ElapsedSeconds(), "seconds"));
+  if (!transitData)
+    return graph;
+
+  TransitGraph::GateEndings gateEndings;
+  MakeGateEndings(transitData->GetGates(), numMwmId, indexGraph, gateEndings);
+  graph->Fill(move(transitData), gateEndings);
   return graph;
 }
 
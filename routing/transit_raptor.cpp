@@ -0,0 +1,286 @@
+#include "routing/transit_raptor.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace routing
+{
+TransitRaptor::TransitRaptor(Schedule const & schedule) : m_schedule(schedule) {}
+
+void TransitRaptor::FindJourneys(Query const & query, vector<Journey> & journeys)
+{
+  journeys.clear();
+  Init(query);
+  RelaxTransfers(0 /* round */);
+
+  for (uint32_t round = 0;; ++round)
+  {
+    StopAccess target;
+    Time const arrivalTime = GetFinishArrival(query, round, target);
+    if (arrivalTime < m_bestFinishArrival)
+    {
+      m_bestFinishArrival = arrivalTime;
+      journeys.emplace_back();
+      MakeJourney(query, round, target, arrivalTime, journeys.back());
+    }
+
+    if (round == query.m_maxRides || m_markedStops.empty())
+      break;
+
+    m_labels.push_back(m_labels.back());
+    for (Label & label : m_labels.back())
+      label.m_isImproved = false;
+
+    CollectPatterns();
+    ScanPatterns(round + 1);
+    RelaxTransfers(round + 1);
+  }
+}
+
+void TransitRaptor::Init(Query const & query)
+{
+  uint32_t const numStops = m_schedule.GetNumStops();
+  m_labels.assign(1, vector<Label>(numStops));
+  m_bestArrivals.assign(numStops, Schedule::kInfiniteTime);
+  m_bestFinishArrival = Schedule::kInfiniteTime;
+  m_isMarked.assign(numStops, false);
+  m_markedStops.clear();
+  m_firstMarkedPos.assign(m_schedule.GetNumPatterns(), Schedule::kInvalidIdx);
+  m_patternsToScan.clear();
+
+  for (StopAccess const & source : query.m_sources)
+  {
+    CHECK_LESS(source.m_stop, numStops, ());
+    Label * label = Improve(0 /* round */, source.m_stop,
+                            query.m_departureTime + source.m_durationSec);
+    if (label == nullptr)
+      continue;
+
+    label->m_legType = Leg::Type::Access;
+    MarkStop(source.m_stop);
+  }
+}
+
+void TransitRaptor::CollectPatterns()
+{
+  m_patternsToScan.clear();
+  for (StopIdx const stop : m_markedStops)
+  {
+    m_isMarked[stop] = false;
+    m_schedule.ForEachPattern(stop, [this](Schedule::PatternIdx pattern, uint32_t stopPos) {
+      uint32_t & firstPos = m_firstMarkedPos[pattern];
+      if (firstPos == Schedule::kInvalidIdx)
+        m_patternsToScan.push_back(pattern);
+      firstPos = min(firstPos, stopPos);
+    });
+  }
+  m_markedStops.clear();
+}
+
+void TransitRaptor::ScanPatterns(uint32_t round)
+{
+  ASSERT_GREATER(round, 0, ());
+  vector<Label> const & prevLabels = m_labels[round - 1];
+
+  for (Schedule::PatternIdx const pattern : m_patternsToScan)
+  {
+    uint32_t const numStops = m_schedule.GetNumPatternStops(pattern);
+    Schedule::TripIdx trip = Schedule::kInvalidIdx;
+    uint32_t boardingPos = 0;
+
+    for (uint32_t pos = m_firstMarkedPos[pattern]; pos < numStops; ++pos)
+    {
+      StopIdx const stop = m_schedule.GetPatternStop(pattern, pos);
+      if (trip != Schedule::kInvalidIdx)
+      {
+        Time const arrivalTime = m_schedule.GetStopTime(pattern, trip, pos).m_arrival;
+        // An arrival which isn't earlier than the finish can't be a part of a better journey.
+        if (arrivalTime < m_bestFinishArrival)
+        {
+          Label * label = Improve(round, stop, arrivalTime);
+          if (label != nullptr)
+          {
+            label->m_legType = Leg::Type::Ride;
+            label->m_from = m_schedule.GetPatternStop(pattern, boardingPos);
+            label->m_pattern = pattern;
+            label->m_trip = trip;
+            label->m_boardingPos = boardingPos;
+            label->m_alightingPos = pos;
+            MarkStop(stop);
+          }
+        }
+      }
+
+      // Boarding an earlier trip of the pattern if the stop is reached before its departure.
+      Time const prevArrival = prevLabels[stop].m_arrivalTime;
+      if (prevArrival == Schedule::kInfiniteTime)
+        continue;
+
+      if (trip != Schedule::kInvalidIdx &&
+          prevArrival > m_schedule.GetStopTime(pattern, trip, pos).m_departure)
+      {
+        continue;
+      }
+
+      Schedule::TripIdx const earliestTrip = m_schedule.FindEarliestTrip(pattern, pos, prevArrival);
+      if (earliestTrip != Schedule::kInvalidIdx && earliestTrip != trip)
+      {
+        trip = earliestTrip;
+        boardingPos = pos;
+      }
+    }
+
+    m_firstMarkedPos[pattern] = Schedule::kInvalidIdx;
+  }
+}
+
+void TransitRaptor::RelaxTransfers(uint32_t round)
+{
+  vector<Label> & labels = m_labels[round];
+  // Stops marked by footpaths are appended to |m_markedStops| and aren't relaxed again.
+  size_t const numMarked = m_markedStops.size();
+  for (size_t i = 0; i < numMarked; ++i)
+  {
+    StopIdx const from = m_markedStops[i];
+    if (labels[from].m_legType == Leg::Type::Transfer)
+      continue;
+
+    Time const departureTime = labels[from].m_arrivalTime;
+    m_schedule.ForEachTransfer(from, [&](StopIdx to, Time durationSec) {
+      Time const arrivalTime = departureTime + durationSec;
+      if (arrivalTime >= m_bestFinishArrival)
+        return;
+
+      Label * label = Improve(round, to, arrivalTime);
+      if (label == nullptr)
+        return;
+
+      label->m_legType = Leg::Type::Transfer;
+      label->m_from = from;
+      MarkStop(to);
+    });
+  }
+}
+
+TransitRaptor::Time TransitRaptor::GetFinishArrival(Query const & query, uint32_t round,
+                                                    StopAccess & target) const
+{
+  Time best = Schedule::kInfiniteTime;
+  for (StopAccess const & t : query.m_targets)
+  {
+    CHECK_LESS(t.m_stop, m_schedule.GetNumStops(), ());
+    Time const arrivalTime = m_labels[round][t.m_stop].m_arrivalTime;
+    if (arrivalTime == Schedule::kInfiniteTime)
+      continue;
+
+    if (arrivalTime + t.m_durationSec < best)
+    {
+      best = arrivalTime + t.m_durationSec;
+      target = t;
+    }
+  }
+  return best;
+}
+
+void TransitRaptor::MakeJourney(Query const & query, uint32_t round, StopAccess const & target,
+                                Time arrivalTime, Journey & journey) const
+{
+  journey.m_arrivalTime = arrivalTime;
+  journey.m_numRides = 0;
+  journey.m_legs.clear();
+
+  Leg egress;
+  egress.m_type = Leg::Type::Egress;
+  egress.m_from = target.m_stop;
+  egress.m_departureTime = m_labels[round][target.m_stop].m_arrivalTime;
+  egress.m_arrivalTime = arrivalTime;
+  journey.m_legs.push_back(egress);
+
+  StopIdx stop = target.m_stop;
+  uint32_t r = round;
+  while (true)
+  {
+    // Labels are copied from round to round, so the leg to |stop| is kept by the round
+    // it's improved in.
+    while (r != 0 && !m_labels[r][stop].m_isImproved)
+      --r;
+
+    Label const & label = m_labels[r][stop];
+    Leg leg;
+    leg.m_type = label.m_legType;
+    leg.m_to = stop;
+    leg.m_arrivalTime = label.m_arrivalTime;
+
+    if (label.m_legType == Leg::Type::Access)
+    {
+      CHECK_EQUAL(r, 0, ());
+      leg.m_departureTime = query.m_departureTime;
+      journey.m_legs.push_back(leg);
+      break;
+    }
+
+    leg.m_from = label.m_from;
+    if (label.m_legType == Leg::Type::Ride)
+    {
+      CHECK_GREATER(r, 0, ());
+      leg.m_pattern = label.m_pattern;
+      leg.m_trip = label.m_trip;
+      leg.m_fromPos = label.m_boardingPos;
+      leg.m_toPos = label.m_alightingPos;
+      leg.m_departureTime =
+          m_schedule.GetStopTime(label.m_pattern, label.m_trip, label.m_boardingPos).m_departure;
+      ++journey.m_numRides;
+      // The trip is boarded at a stop reached with one ride less.
+      --r;
+    }
+    else
+    {
+      CHECK(label.m_legType == Leg::Type::Transfer, ());
+      leg.m_departureTime = m_labels[r][label.m_from].m_arrivalTime;
+    }
+
+    journey.m_legs.push_back(leg);
+    stop = label.m_from;
+  }
+
+  reverse(journey.m_legs.begin(), journey.m_legs.end());
+}
+
+void TransitRaptor::MarkStop(StopIdx stop)
+{
+  if (m_isMarked[stop])
+    return;
+
+  m_isMarked[stop] = true;
+  m_markedStops.push_back(stop);
+}
+
+TransitRaptor::Label * TransitRaptor::Improve(uint32_t round, StopIdx stop, Time arrivalTime)
+{
+  // An arrival which is not earlier than the best arrival in the previous rounds is dominated,
+  // the earlier journey has fewer rides.
+  if (arrivalTime >= m_bestArrivals[stop])
+    return nullptr;
+
+  m_bestArrivals[stop] = arrivalTime;
+  Label & label = m_labels[round][stop];
+  label.m_arrivalTime = arrivalTime;
+  label.m_isImproved = true;
+  return &label;
+}
+
+string DebugPrint(TransitRaptor::Leg::Type type)
+{
+  switch (type)
+  {
+  case TransitRaptor::Leg::Type::Access: return "Access";
+  case TransitRaptor::Leg::Type::Ride: return "Ride";
+  case TransitRaptor::Leg::Type::Transfer: return "Transfer";
+  case TransitRaptor::Leg::Type::Egress: return "Egress";
+  }
+  CHECK_SWITCH();
+}
+}  // namespace routing
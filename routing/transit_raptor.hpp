@@ -0,0 +1,128 @@
+#pragma once
+
+#include "transit/transit_schedule.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace routing
+{
+// Round based public transit routing (RAPTOR) over timetables of transit::Schedule.
+// Round k finds the earliest arrivals at stops with k rides at most. Every round scans each
+// pattern which visits a stop improved in the previous round once, and relaxes footpaths
+// from the stops improved by rides. So unlike A* over transit edges there's no priority queue
+// and waits are exact instead of average intervals of lines.
+//
+// Footpaths are not chained, so transfers of a schedule should be transitively closed.
+class TransitRaptor final
+{
+public:
+  using Schedule = transit::Schedule;
+  using Time = Schedule::Time;
+  using StopIdx = Schedule::StopIdx;
+
+  // Walking from the start to a stop or from a stop to the finish.
+  struct StopAccess
+  {
+    StopAccess() = default;
+    StopAccess(StopIdx stop, Time durationSec) : m_stop(stop), m_durationSec(durationSec) {}
+
+    StopIdx m_stop = Schedule::kInvalidIdx;
+    Time m_durationSec = 0;
+  };
+
+  struct Query
+  {
+    std::vector<StopAccess> m_sources;
+    std::vector<StopAccess> m_targets;
+    // Departure from the start.
+    Time m_departureTime = 0;
+    uint32_t m_maxRides = 5;
+  };
+
+  struct Leg
+  {
+    enum class Type
+    {
+      // Walking from the start to |m_to| stop.
+      Access,
+      // Ride from |m_from| stop to |m_to| stop with |m_trip| of |m_pattern|.
+      Ride,
+      // Footpath from |m_from| stop to |m_to| stop.
+      Transfer,
+      // Walking from |m_from| stop to the finish.
+      Egress
+    };
+
+    Type m_type = Type::Access;
+    StopIdx m_from = Schedule::kInvalidIdx;
+    StopIdx m_to = Schedule::kInvalidIdx;
+    Schedule::PatternIdx m_pattern = Schedule::kInvalidIdx;
+    Schedule::TripIdx m_trip = Schedule::kInvalidIdx;
+    // Positions of |m_from| and |m_to| in |m_pattern| for rides.
+    uint32_t m_fromPos = 0;
+    uint32_t m_toPos = 0;
+    Time m_departureTime = 0;
+    Time m_arrivalTime = 0;
+  };
+
+  struct Journey
+  {
+    Time m_arrivalTime = Schedule::kInfiniteTime;
+    uint32_t m_numRides = 0;
+    std::vector<Leg> m_legs;
+  };
+
+  explicit TransitRaptor(Schedule const & schedule);
+
+  // Fills |journeys| with journeys which are pareto optimal by arrival time and number of
+  // rides, sorted by number of rides. So the last journey is the earliest arrival.
+  // |journeys| is empty if the finish is unreachable.
+  void FindJourneys(Query const & query, std::vector<Journey> & journeys);
+
+private:
+  struct Label
+  {
+    Time m_arrivalTime = Schedule::kInfiniteTime;
+    // The fields below are set if the label is improved in the round.
+    bool m_isImproved = false;
+    Leg::Type m_legType = Leg::Type::Access;
+    StopIdx m_from = Schedule::kInvalidIdx;
+    Schedule::PatternIdx m_pattern = Schedule::kInvalidIdx;
+    Schedule::TripIdx m_trip = Schedule::kInvalidIdx;
+    uint32_t m_boardingPos = 0;
+    uint32_t m_alightingPos = 0;
+  };
+
+  void Init(Query const & query);
+  void CollectPatterns();
+  void ScanPatterns(uint32_t round);
+  void RelaxTransfers(uint32_t round);
+  // Returns arrival at the finish with |round| rides at most and the stop it's reached from.
+  Time GetFinishArrival(Query const & query, uint32_t round, StopAccess & target) const;
+  void MakeJourney(Query const & query, uint32_t round, StopAccess const & target,
+                   Time arrivalTime, Journey & journey) const;
+  void MarkStop(StopIdx stop);
+  // Returns the label of |stop| in |round| if |arrivalTime| improves it or nullptr.
+  Label * Improve(uint32_t round, StopIdx stop, Time arrivalTime);
+
+  Schedule const & m_schedule;
+
+  // Labels of every round, |m_labels[k][stop]| is the earliest arrival with k rides at most.
+  std::vector<std::vector<Label>> m_labels;
+  // The earliest arrival at every stop with any number of rides.
+  std::vector<Time> m_bestArrivals;
+  // The earliest arrival at the finish so far. Arrivals at stops which aren't earlier are
+  // useless.
+  Time m_bestFinishArrival = Schedule::kInfiniteTime;
+
+  std::vector<bool> m_isMarked;
+  std::vector<StopIdx> m_markedStops;
+  // The first position of a marked stop in every pattern and the patterns to scan.
+  std::vector<uint32_t> m_firstMarkedPos;
+  std::vector<Schedule::PatternIdx> m_patternsToScan;
+};
+
+std::string DebugPrint(TransitRaptor::Leg::Type type);
+}  // namespace routing
@@ -0,0 +1,259 @@
+#include "routing/transit_raptor_router.hpp"
+
+#include "routing/routing_exceptions.hpp"
+#include "routing/routing_helpers.hpp"
+#include "routing/turns.hpp"
+
+#include "routing_common/pedestrian_model.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/feature_altitude.hpp"
+
+#include "platform/country_file.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/reader.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cmath>
+#include <ctime>
+#include <utility>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace routing
+{
+namespace
+{
+using Schedule = transit::Schedule;
+using Time = TransitRaptorRouter::Time;
+
+Time GetWalkingTime(m2::PointD const & from, m2::PointD const & to)
+{
+  double const speedMpS = KMPH2MPS(PedestrianModel::AllLimitsInstance().GetOffroadSpeed());
+  CHECK_GREATER(speedMpS, 0.0, ());
+  return static_cast<Time>(ceil(MercatorBounds::DistanceOnEarth(from, to) / speedMpS));
+}
+
+Time GetLocalDayTime()
+{
+  time_t const now = ::time(nullptr);
+  tm const * local = localtime(&now);
+  CHECK(local, ());
+  return static_cast<Time>(local->tm_hour * 3600 + local->tm_min * 60 + local->tm_sec);
+}
+
+void AppendPoint(m2::PointD const & point, Time time, Time routeDepartureTime,
+                 vector<Junction> & junctions, Route::TTimes & times)
+{
+  CHECK_GREATER_OR_EQUAL(time, routeDepartureTime, ());
+  times.emplace_back(static_cast<uint32_t>(junctions.size()),
+                     static_cast<double>(time - routeDepartureTime));
+  junctions.emplace_back(point, feature::kDefaultAltitudeMeters);
+}
+}  // namespace
+
+double constexpr TransitRaptorRouter::kMaxWalkingDistanceM;
+TransitRaptorRouter::Time constexpr TransitRaptorRouter::kNoDepartureTime;
+
+TransitRaptorRouter::TransitRaptorRouter(TCountryFileFn const & countryFileFn,
+                                         DataSource & dataSource)
+  : m_countryFileFn(countryFileFn), m_dataSource(dataSource)
+{
+}
+
+void TransitRaptorRouter::ClearState() { m_schedules.clear(); }
+
+RouterResultCode TransitRaptorRouter::CalculateRoute(Checkpoints const & checkpoints,
+                                                     m2::PointD const & /* startDirection */,
+                                                     bool /* adjust */,
+                                                     RouterDelegate const & delegate, Route & route)
+{
+  vector<string> countryNames;
+  for (auto const & checkpoint : checkpoints.GetPoints())
+  {
+    string const countryName = m_countryFileFn(checkpoint);
+    if (countryName.empty())
+    {
+      LOG(LWARNING, ("For point", MercatorBounds::ToLatLon(checkpoint),
+                     "CountryInfoGetter returns an empty CountryFile()."));
+      return RouterResultCode::InternalError;
+    }
+
+    auto const country = platform::CountryFile(countryName);
+    if (!m_dataSource.IsLoaded(country))
+      route.AddAbsentCountry(country.GetName());
+    countryNames.push_back(countryName);
+  }
+
+  if (!route.GetAbsentCountries().empty())
+    return RouterResultCode::NeedMoreMaps;
+
+  Time const routeDepartureTime =
+      m_departureTimeS == kNoDepartureTime ? GetLocalDayTime() : m_departureTimeS;
+
+  vector<Junction> junctions;
+  Route::TTimes times;
+  vector<Route::SubrouteAttrs> subroutes;
+  AppendPoint(checkpoints.GetStart(), routeDepartureTime, routeDepartureTime, junctions, times);
+
+  Time departureTime = routeDepartureTime;
+  vector<TransitRaptor::Journey> journeys;
+  for (size_t i = 0; i < checkpoints.GetNumSubroutes(); ++i)
+  {
+    m2::PointD const & start = checkpoints.GetPoint(i);
+    m2::PointD const & finish = checkpoints.GetPoint(i + 1);
+    if (countryNames[i] != countryNames[i + 1])
+      return RouterResultCode::PointsInDifferentMWM;
+
+    Schedule const * schedule = GetSchedule(countryNames[i]);
+    if (schedule == nullptr)
+      return RouterResultCode::TransitRouteNotFoundNoNetwork;
+
+    // A journey without legs is walking from the start to the finish.
+    TransitRaptor::Journey walking;
+    if (MercatorBounds::DistanceOnEarth(start, finish) <= kMaxWalkingDistanceM)
+      walking.m_arrivalTime = departureTime + GetWalkingTime(start, finish);
+
+    TransitRaptor::Query query;
+    MakeQuery(*schedule, start, finish, departureTime, query);
+    journeys.clear();
+    if (!query.m_sources.empty() && !query.m_targets.empty())
+      TransitRaptor(*schedule).FindJourneys(query, journeys);
+
+    if (delegate.IsCancelled())
+      return RouterResultCode::Cancelled;
+
+    TransitRaptor::Journey const * journey = &walking;
+    if (!journeys.empty() && journeys.back().m_arrivalTime < walking.m_arrivalTime)
+      journey = &journeys.back();
+
+    if (journey->m_arrivalTime == Schedule::kInfiniteTime)
+    {
+      if (query.m_sources.empty() || query.m_targets.empty())
+        return RouterResultCode::TransitRouteNotFoundTooLongPedestrian;
+      return RouterResultCode::RouteNotFound;
+    }
+
+    size_t const beginSegmentIdx = junctions.size() - 1;
+    AppendJourney(*schedule, *journey, finish, routeDepartureTime, junctions, times);
+    subroutes.emplace_back(Junction(start, feature::kDefaultAltitudeMeters),
+                           Junction(finish, feature::kDefaultAltitudeMeters), beginSegmentIdx,
+                           junctions.size() - 1);
+    departureTime = journey->m_arrivalTime;
+  }
+
+  // Points of the route aren't road features, so all the segments are fake.
+  vector<Segment> const segments(junctions.size() - 1);
+  Route::TTurns const turns = {turns::TurnItem(static_cast<uint32_t>(junctions.size() - 1),
+                                               turns::PedestrianDirection::ReachedYourDestination)};
+  vector<RouteSegment> routeSegments;
+  FillSegmentInfo(segments, junctions, turns, Route::TStreets(), times, nullptr /* trafficStash */,
+                  routeSegments);
+  route.SetRouteSegments(move(routeSegments));
+
+  vector<m2::PointD> routeGeometry;
+  JunctionsToPoints(junctions, routeGeometry);
+  route.SetGeometry(routeGeometry.begin(), routeGeometry.end());
+  route.SetSubroteAttrs(move(subroutes));
+
+  if (!route.IsValid())
+    return RouterResultCode::RouteNotFound;
+
+  return RouterResultCode::NoError;
+}
+
+// static
+void TransitRaptorRouter::MakeQuery(Schedule const & schedule, m2::PointD const & start,
+                                    m2::PointD const & finish, Time departureTime,
+                                    TransitRaptor::Query & query)
+{
+  query.m_sources.clear();
+  query.m_targets.clear();
+  query.m_departureTime = departureTime;
+
+  for (Schedule::StopIdx stop = 0; stop < schedule.GetNumStops(); ++stop)
+  {
+    m2::PointD const & point = schedule.GetStopPoint(stop);
+    if (MercatorBounds::DistanceOnEarth(start, point) <= kMaxWalkingDistanceM)
+      query.m_sources.emplace_back(stop, GetWalkingTime(start, point));
+    if (MercatorBounds::DistanceOnEarth(point, finish) <= kMaxWalkingDistanceM)
+      query.m_targets.emplace_back(stop, GetWalkingTime(point, finish));
+  }
+}
+
+// static
+void TransitRaptorRouter::AppendJourney(Schedule const & schedule,
+                                        TransitRaptor::Journey const & journey,
+                                        m2::PointD const & finish, Time routeDepartureTime,
+                                        vector<Junction> & junctions, Route::TTimes & times)
+{
+  CHECK(!junctions.empty(), ());
+  using Leg = TransitRaptor::Leg;
+  for (Leg const & leg : journey.m_legs)
+  {
+    switch (leg.m_type)
+    {
+    case Leg::Type::Access:
+    case Leg::Type::Transfer:
+      AppendPoint(schedule.GetStopPoint(leg.m_to), leg.m_arrivalTime, routeDepartureTime,
+                  junctions, times);
+      break;
+    case Leg::Type::Ride:
+      // Waiting for the trip is a part of the ride to the next stop.
+      for (uint32_t pos = leg.m_fromPos + 1; pos <= leg.m_toPos; ++pos)
+      {
+        AppendPoint(schedule.GetStopPoint(schedule.GetPatternStop(leg.m_pattern, pos)),
+                    schedule.GetStopTime(leg.m_pattern, leg.m_trip, pos).m_arrival,
+                    routeDepartureTime, junctions, times);
+      }
+      break;
+    case Leg::Type::Egress: break;
+    }
+  }
+
+  AppendPoint(finish, journey.m_arrivalTime, routeDepartureTime, junctions, times);
+}
+
+Schedule const * TransitRaptorRouter::GetSchedule(string const & countryName)
+{
+  auto const it = m_schedules.find(countryName);
+  if (it != m_schedules.cend())
+    return it->second.get();
+
+  auto & schedule = m_schedules[countryName];
+
+  platform::CountryFile const file(countryName);
+  MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+
+  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
+  if (!mwmValue.m_cont.IsExist(TRANSIT_SCHEDULE_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    base::Timer timer;
+    auto reader = mwmValue.m_cont.GetReader(TRANSIT_SCHEDULE_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    schedule = make_unique<Schedule>();
+    schedule->Deserialize(src);
+    LOG(LINFO, (TRANSIT_SCHEDULE_FILE_TAG, "section for", file.GetName(), "loaded in",
+                timer.ElapsedSeconds(), "seconds"));
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", TRANSIT_SCHEDULE_FILE_TAG, "section.", e.Msg()));
+    schedule.reset();
+  }
+
+  return schedule.get();
+}
+}  // namespace routing
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "routing/route.hpp"
+#include "routing/router.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/transit_raptor.hpp"
+
+#include "transit/transit_schedule.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class DataSource;
+
+namespace routing
+{
+// Transit router over timetables of TRANSIT_SCHEDULE_FILE_TAG sections. Unlike IndexRouter with
+// VehicleType::Transit it doesn't expand transit edges inside A*: stops near the start and the
+// finish are reached by straight walking and journeys between them are found by TransitRaptor
+// with exact waits. Every subroute should be inside one mwm.
+class TransitRaptorRouter final : public IRouter
+{
+public:
+  using Time = transit::Schedule::Time;
+
+  // Stops further from a checkpoint than the distance aren't reached by walking.
+  static double constexpr kMaxWalkingDistanceM = 1500.0;
+
+  TransitRaptorRouter(TCountryFileFn const & countryFileFn, DataSource & dataSource);
+
+  // IRouter overrides:
+  std::string GetName() const override { return "transit-raptor"; }
+  void ClearState() override;
+  RouterResultCode CalculateRoute(Checkpoints const & checkpoints,
+                                  m2::PointD const & startDirection, bool adjust,
+                                  RouterDelegate const & delegate, Route & route) override;
+
+  /// \brief Makes routes depart at |dayTimeS|, seconds since the start of the service day.
+  /// By default routes depart at local time of the CalculateRoute() call.
+  void SetDepartureTime(Time dayTimeS) { m_departureTimeS = dayTimeS; }
+  void ResetDepartureTime() { m_departureTimeS = kNoDepartureTime; }
+
+  // Fills |query| with stops reached by walking from |start| and to |finish|.
+  static void MakeQuery(transit::Schedule const & schedule, m2::PointD const & start,
+                        m2::PointD const & finish, Time departureTime,
+                        TransitRaptor::Query & query);
+  // Appends points of |journey| from |start| to |finish| with times since |routeDepartureTime|
+  // to |junctions| and |times|. The last point of |junctions| should be |start|.
+  static void AppendJourney(transit::Schedule const & schedule,
+                            TransitRaptor::Journey const & journey, m2::PointD const & finish,
+                            Time routeDepartureTime, std::vector<Junction> & junctions,
+                            Route::TTimes & times);
+
+private:
+  static Time constexpr kNoDepartureTime = transit::Schedule::kInfiniteTime;
+
+  // Returns nullptr if the mwm has no schedule.
+  transit::Schedule const * GetSchedule(std::string const & countryName);
+
+  TCountryFileFn const m_countryFileFn;
+  DataSource & m_dataSource;
+  Time m_departureTimeS = kNoDepartureTime;
+  std::map<std::string, std::unique_ptr<transit::Schedule>> m_schedules;
+};
+}  // namespace routing
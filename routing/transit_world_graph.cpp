@@ -154,6 +154,8 @@ double TransitWorldGraph::CalcSegmentETA(routing::Segment const & segment)
 
 bool TransitWorldGraph::LeapIsAllowed(NumMwmId /* mwmId */) const { return false; }
 
+bool TransitWorldGraph::CrossMwmWeightsExist(NumMwmId /* mwmId */) { return false; }
+
 vector<Segment> const & TransitWorldGraph::GetTransitions(NumMwmId numMwmId, bool isEnter)
 {
   return kEmptyTransitions;
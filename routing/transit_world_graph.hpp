@@ -58,7 +58,14 @@ public:
   RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const override;
   RouteWeight CalcOffroadWeight(m2::PointD const & from, m2::PointD const & to) const override;
   double CalcSegmentETA(Segment const & segment) override;
+  // Transit routes don't use speed profiles.
+  bool CalcSegmentWeightAtTime(Segment const & /* segment */, double /* weekTimeS */,
+                               RouteWeight & /* weight */) override
+  {
+    return false;
+  }
   bool LeapIsAllowed(NumMwmId mwmId) const override;
+  bool CrossMwmWeightsExist(NumMwmId mwmId) override;
   std::vector<Segment> const & GetTransitions(NumMwmId numMwmId, bool isEnter) override;
   std::unique_ptr<TransitInfo> GetTransitInfo(Segment const & segment) override;
   std::vector<RouteSegment::SpeedCamera> GetSpeedCamInfo(Segment const & segment) override;
@@ -24,6 +24,7 @@ public:
   using Vertex = IndexGraph::Vertex;
   using Edge = IndexGraph::Edge;
   using Weight = IndexGraph::Weight;
+  using VertexHasher = IndexGraph::VertexHasher;
 
   enum class Mode
   {
@@ -66,7 +67,13 @@ public:
   virtual RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const = 0;
   virtual RouteWeight CalcOffroadWeight(m2::PointD const & from, m2::PointD const & to) const = 0;
   virtual double CalcSegmentETA(Segment const & segment) = 0;
+  // Calculates |weight| of |segment| entered at time of week |weekTimeS| with speed profiles
+  // (see SpeedProfiles). Returns false if the weight of |segment| doesn't depend on time.
+  virtual bool CalcSegmentWeightAtTime(Segment const & segment, double weekTimeS,
+                                       RouteWeight & weight) = 0;
   virtual bool LeapIsAllowed(NumMwmId mwmId) const = 0;
+  // Checks whether the cross-mwm section of |mwmId| has weights for LeapsOnly mode.
+  virtual bool CrossMwmWeightsExist(NumMwmId mwmId) = 0;
 
   /// \returns transitions for mwm with id |numMwmId|.
   virtual std::vector<Segment> const & GetTransitions(NumMwmId numMwmId, bool isEnter) = 0;
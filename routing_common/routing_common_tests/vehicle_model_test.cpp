@@ -5,9 +5,12 @@
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
 #include "indexer/feature.hpp"
+#include "indexer/ftypes_matcher.hpp"
 
 #include "base/macros.hpp"
 
+#include <set>
+
 using namespace std;
 
 namespace
@@ -183,3 +186,23 @@ UNIT_CLASS_TEST(VehicleModelTest, VehicleModel_SpeedFactor)
   CheckSpeed({residential, unpavedGood}, {{27.0, 44.0}, {30.0, 48.0}});
   CheckSpeed({residential, unpavedBad}, {{9.0, 11.0}, {10.0, 12.0}});
 }
+
+UNIT_CLASS_TEST(VehicleModelTest, VehicleModel_TypesOfMapping)
+{
+  TestVehicleModel vehicleModel;
+  set<uint32_t> const roadTypes = {GetType("highway", "trunk"), GetType("highway", "primary"),
+                                   GetType("highway", "secondary"),
+                                   GetType("highway", "residential"),
+                                   GetType("highway", "service")};
+
+  Classificator const & c = classif();
+  TEST_GREATER(c.GetTypesCount(), 0, ());
+  for (uint32_t index = 0; index < c.GetTypesCount(); ++index)
+  {
+    uint32_t const type = c.GetTypeForIndex(index);
+    bool const isRoad = roadTypes.count(ftypes::BaseChecker::PrepareToMatch(type, 2)) != 0;
+    TEST_EQUAL(vehicleModel.IsRoadType(type), isRoad, (c.GetReadableObjectName(type)));
+  }
+
+  TEST(!vehicleModel.IsRoadType(GetType("highway")), ());
+}
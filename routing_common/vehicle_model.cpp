@@ -8,6 +8,7 @@
 #include "base/math.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <sstream>
 
 using namespace routing;
@@ -30,6 +31,8 @@ VehicleModel::InOutCitySpeedKMpH Max(VehicleModel::InOutCitySpeedKMpH const & lh
 
 namespace routing
 {
+uint8_t constexpr VehicleModel::TypeInfo::kNoIdx;
+
 VehicleModel::AdditionalRoadType::AdditionalRoadType(Classificator const & c,
                                                      AdditionalRoadTags const & tag)
   : m_type(c.GetTypeByPath(tag.m_hwtag))
@@ -49,7 +52,9 @@ VehicleModel::RoadLimits::RoadLimits(VehicleModel::InOutCitySpeedKMpH const & sp
 
 VehicleModel::VehicleModel(Classificator const & c, LimitsInitList const & featureTypeLimits,
                            SurfaceInitList const & featureTypeSurface)
-  : m_maxSpeed({}, {}), m_onewayType(c.GetTypeByPath({"hwtag", "oneway"}))
+  : m_maxSpeed({}, {})
+  , m_classificator(&c)
+  , m_onewayType(c.GetTypeByPath({"hwtag", "oneway"}))
 {
   CHECK_EQUAL(m_surfaceFactors.size(), 4,
               ("If you want to change the size of the container please take into account that it's "
@@ -59,8 +64,10 @@ VehicleModel::VehicleModel(Classificator const & c, LimitsInitList const & featu
   for (auto const & v : featureTypeLimits)
   {
     m_maxSpeed = Max(m_maxSpeed, v.m_speed);
-    m_highwayTypes.emplace(c.GetTypeByPath(v.m_types),
-                           RoadLimits(v.m_speed, v.m_isPassThroughAllowed));
+    CHECK_LESS(m_roadLimits.size(), TypeInfo::kNoIdx, ());
+    auto const limitsIdx = static_cast<uint8_t>(m_roadLimits.size());
+    if (m_highwayTypes.emplace(c.GetTypeByPath(v.m_types), limitsIdx).second)
+      m_roadLimits.emplace_back(v.m_speed, v.m_isPassThroughAllowed);
   }
 
   size_t i = 0;
@@ -75,6 +82,28 @@ VehicleModel::VehicleModel(Classificator const & c, LimitsInitList const & featu
     double const etaFactor = base::clamp(speedFactor.m_eta, 0.0, 1.0);
     m_surfaceFactors[i++] = {c.GetTypeByPath(v.m_types), {weightFactor, etaFactor}};
   }
+
+  m_typeInfos.resize(c.GetTypesCount());
+  for (uint32_t index = 0; index < m_typeInfos.size(); ++index)
+    m_typeInfos[index] = MakeTypeInfo(c.GetTypeForIndex(index));
+}
+
+bool VehicleModel::EqualsForTests(VehicleModel const & rhs) const
+{
+  if (m_highwayTypes.size() != rhs.m_highwayTypes.size())
+    return false;
+
+  for (auto const & kv : m_highwayTypes)
+  {
+    auto const it = rhs.m_highwayTypes.find(kv.first);
+    if (it == rhs.m_highwayTypes.cend() ||
+        !(m_roadLimits[kv.second] == rhs.m_roadLimits[it->second]))
+    {
+      return false;
+    }
+  }
+
+  return (m_addRoadTypes == rhs.m_addRoadTypes) && (m_onewayType == rhs.m_onewayType);
 }
 
 void VehicleModel::SetAdditionalRoadTypes(Classificator const & c,
@@ -82,8 +111,14 @@ void VehicleModel::SetAdditionalRoadTypes(Classificator const & c,
 {
   for (auto const & tag : additionalTags)
   {
+    CHECK_LESS(m_addRoadTypes.size(), TypeInfo::kNoIdx, ());
     m_addRoadTypes.emplace_back(c, tag);
     m_maxSpeed = Max(m_maxSpeed, tag.m_speed);
+
+    // The first of equal additional road types is used as FindRoadType() does.
+    uint32_t const index = c.FindIndexForType(m_addRoadTypes.back().m_type);
+    if (index < m_typeInfos.size() && m_typeInfos[index].m_addRoadIdx == TypeInfo::kNoIdx)
+      m_typeInfos[index].m_addRoadIdx = static_cast<uint8_t>(m_addRoadTypes.size() - 1);
   }
 }
 
@@ -115,22 +150,18 @@ VehicleModel::SpeedKMpH VehicleModel::GetMinTypeSpeed(feature::TypesHolder const
   VehicleModel::SpeedFactor factor;
   for (uint32_t t : types)
   {
-    uint32_t const type = ftypes::BaseChecker::PrepareToMatch(t, 2);
-    auto const itHighway = m_highwayTypes.find(type);
-    if (itHighway != m_highwayTypes.cend())
-      speed = Pick<min>(speed, itHighway->second.GetSpeed(inCity));
+    TypeInfo const info = GetTypeInfo(t);
+    if (info.m_limitsIdx != TypeInfo::kNoIdx)
+      speed = Pick<min>(speed, m_roadLimits[info.m_limitsIdx].GetSpeed(inCity));
 
-    auto const addRoadInfoIter = FindRoadType(t);
-    if (addRoadInfoIter != m_addRoadTypes.cend())
+    if (info.m_addRoadIdx != TypeInfo::kNoIdx)
     {
-      speed = Pick<min>(
-          speed, inCity ? addRoadInfoIter->m_speed.m_inCity : addRoadInfoIter->m_speed.m_outCity);
+      auto const & addRoadSpeed = m_addRoadTypes[info.m_addRoadIdx].m_speed;
+      speed = Pick<min>(speed, inCity ? addRoadSpeed.m_inCity : addRoadSpeed.m_outCity);
     }
 
-    auto const itFactor = find_if(m_surfaceFactors.cbegin(), m_surfaceFactors.cend(),
-                                  [t](TypeFactor const & v) { return v.m_type == t; });
-    if (itFactor != m_surfaceFactors.cend())
-      factor = Pick<min>(factor, itFactor->m_factor);
+    if (info.m_surfaceIdx != TypeInfo::kNoIdx)
+      factor = Pick<min>(factor, m_surfaceFactors[info.m_surfaceIdx].m_factor);
   }
 
   CHECK_LESS_OR_EQUAL(factor.m_weight, 1.0, ());
@@ -186,8 +217,7 @@ bool VehicleModel::IsPassThroughAllowed(FeatureType & f) const
   // Allow pass through additional road types e.g. peer, ferry.
   for (uint32_t t : types)
   {
-    auto const addRoadInfoIter = FindRoadType(t);
-    if (addRoadInfoIter != m_addRoadTypes.cend())
+    if (GetTypeInfo(t).m_addRoadIdx != TypeInfo::kNoIdx)
       return true;
   }
   return HasPassThroughType(types);
@@ -197,10 +227,12 @@ bool VehicleModel::HasPassThroughType(feature::TypesHolder const & types) const
 {
   for (uint32_t t : types)
   {
-    uint32_t const type = ftypes::BaseChecker::PrepareToMatch(t, 2);
-    auto it = m_highwayTypes.find(type);
-    if (it != m_highwayTypes.end() && it->second.IsPassThroughAllowed())
+    TypeInfo const info = GetTypeInfo(t);
+    if (info.m_limitsIdx != TypeInfo::kNoIdx &&
+        m_roadLimits[info.m_limitsIdx].IsPassThroughAllowed())
+    {
       return true;
+    }
   }
 
   return false;
@@ -208,8 +240,8 @@ bool VehicleModel::HasPassThroughType(feature::TypesHolder const & types) const
 
 bool VehicleModel::IsRoadType(uint32_t type) const
 {
-  return FindRoadType(type) != m_addRoadTypes.cend() ||
-         m_highwayTypes.find(ftypes::BaseChecker::PrepareToMatch(type, 2)) != m_highwayTypes.end();
+  TypeInfo const info = GetTypeInfo(type);
+  return info.m_addRoadIdx != TypeInfo::kNoIdx || info.m_limitsIdx != TypeInfo::kNoIdx;
 }
 
 VehicleModelInterface::RoadAvailability VehicleModel::GetRoadAvailability(feature::TypesHolder const & /* types */) const
@@ -224,6 +256,36 @@ vector<VehicleModel::AdditionalRoadType>::const_iterator VehicleModel::FindRoadT
                  [&type](AdditionalRoadType const & t) { return t.m_type == type; });
 }
 
+VehicleModel::TypeInfo VehicleModel::GetTypeInfo(uint32_t type) const
+{
+  uint32_t const index = m_classificator->FindIndexForType(type);
+  if (index < m_typeInfos.size())
+    return m_typeInfos[index];
+
+  // Features of mwms have only types of the classificator mapping but types from other
+  // sources, e.g. the generator, may be absent in it.
+  return MakeTypeInfo(type);
+}
+
+VehicleModel::TypeInfo VehicleModel::MakeTypeInfo(uint32_t type) const
+{
+  TypeInfo info;
+  auto const itHighway = m_highwayTypes.find(ftypes::BaseChecker::PrepareToMatch(type, 2));
+  if (itHighway != m_highwayTypes.cend())
+    info.m_limitsIdx = itHighway->second;
+
+  auto const itAddRoad = FindRoadType(type);
+  if (itAddRoad != m_addRoadTypes.cend())
+    info.m_addRoadIdx = static_cast<uint8_t>(distance(m_addRoadTypes.cbegin(), itAddRoad));
+
+  auto const itFactor = find_if(m_surfaceFactors.cbegin(), m_surfaceFactors.cend(),
+                                [type](TypeFactor const & v) { return v.m_type == type; });
+  if (itFactor != m_surfaceFactors.cend())
+    info.m_surfaceIdx = static_cast<uint8_t>(distance(m_surfaceFactors.cbegin(), itFactor));
+
+  return info;
+}
+
 VehicleModelFactory::VehicleModelFactory(
     CountryParentNameGetterFn const & countryParentNameGetterFn)
   : m_countryParentNameGetterFn(countryParentNameGetterFn)
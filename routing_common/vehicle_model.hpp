@@ -3,6 +3,7 @@
 #include <array>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -179,11 +180,7 @@ public:
     return false;
   }
 
-  bool EqualsForTests(VehicleModel const & rhs) const
-  {
-    return (m_highwayTypes == rhs.m_highwayTypes) && (m_addRoadTypes == rhs.m_addRoadTypes) &&
-           (m_onewayType == rhs.m_onewayType);
-  }
+  bool EqualsForTests(VehicleModel const & rhs) const;
 
 protected:
   /// @returns a special restriction which is set to the feature.
@@ -240,9 +237,28 @@ private:
     SpeedFactor m_factor;
   };
 
+  // Everything the model knows about a classificator type. Indices are kNoIdx if the type
+  // is not a highway, an additional road or a surface type of the model.
+  struct TypeInfo
+  {
+    static uint8_t constexpr kNoIdx = std::numeric_limits<uint8_t>::max();
+
+    uint8_t m_limitsIdx = kNoIdx;   // Index in |m_roadLimits|.
+    uint8_t m_addRoadIdx = kNoIdx;  // Index in |m_addRoadTypes|.
+    uint8_t m_surfaceIdx = kNoIdx;  // Index in |m_surfaceFactors|.
+  };
+
   std::vector<AdditionalRoadType>::const_iterator FindRoadType(uint32_t type) const;
 
-  std::unordered_map<uint32_t, RoadLimits> m_highwayTypes;
+  /// \returns info of |type| from |m_typeInfos| in constant time.
+  TypeInfo GetTypeInfo(uint32_t type) const;
+  TypeInfo MakeTypeInfo(uint32_t type) const;
+
+  Classificator const * m_classificator;
+
+  std::vector<RoadLimits> m_roadLimits;
+  // Mapping 2-arity highway types to indices in |m_roadLimits|.
+  std::unordered_map<uint32_t, uint8_t> m_highwayTypes;
   // Mapping surface types (psurface|paved_good, psurface|paved_bad, psurface|unpaved_good,
   // psurface|unpaved_bad) to surface speed factors.
   // Note. It's an array (not map or unordered_map) because of perfomance reasons.
@@ -250,6 +266,11 @@ private:
 
   std::vector<AdditionalRoadType> m_addRoadTypes;
   uint32_t m_onewayType;
+
+  // Dense table indexed by classificator type index which is built once for the model.
+  // It's used instead of lookups in |m_highwayTypes|, |m_addRoadTypes| and |m_surfaceFactors|
+  // because speeds and road flags are asked for every feature loaded for routing.
+  std::vector<TypeInfo> m_typeInfos;
 };
 
 class VehicleModelFactory : public VehicleModelFactoryInterface
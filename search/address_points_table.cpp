@@ -0,0 +1,259 @@
+#include "search/address_points_table.hpp"
+
+#include "indexer/cell_coverer.hpp"
+#include "indexer/cell_id.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "coding/pointd_to_pointu.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+uint64_t constexpr kHeaderSize = sizeof(uint8_t) + 2 * sizeof(uint32_t);
+uint64_t constexpr kPointSize = 5 * sizeof(uint32_t) + sizeof(uint16_t);
+uint64_t constexpr kStreetSize = 2 * sizeof(uint32_t);
+// Max number of cells the lookup rect is covered by. Points of the cells
+// which are out of the rect are skipped.
+size_t constexpr kMaxNumCoverCells = 32;
+
+using Converter = CellIdConverter<MercatorBounds, RectId>;
+
+int64_t GetCell(m2::PointU const & p)
+{
+  auto const center = PointUToPointD(p, POINT_COORD_BITS);
+  return Converter::ToCellId(center.x, center.y).ToInt64(RectId::DEPTH_LEVELS);
+}
+}  // namespace
+
+// AddressPointsTable::Builder ---------------------------------------------------------------------
+void AddressPointsTable::Builder::Add(m2::PointD const & center, double radiusMeters,
+                                      uint32_t building, string const & houseNumber,
+                                      uint32_t street, string const & streetName)
+{
+  ASSERT(!houseNumber.empty(), (building));
+  ASSERT_GREATER_OR_EQUAL(radiusMeters, 0.0, ());
+
+  Entry entry;
+  entry.m_center = center;
+  entry.m_radiusMeters = radiusMeters;
+  entry.m_building = building;
+  entry.m_houseNumber = houseNumber;
+  entry.m_street = street;
+  m_points.push_back(move(entry));
+
+  if (street != kNoStreet)
+    m_streets.emplace(street, streetName);
+}
+
+void AddressPointsTable::Builder::Prepare(vector<Record> & points,
+                                          vector<pair<uint32_t, uint32_t>> & streets,
+                                          vector<char> & strings) const
+{
+  map<string, uint32_t> offsets;
+  MemWriter<vector<char>> writer(strings);
+  auto const addString = [&](string const & s) {
+    auto const it = offsets.find(s);
+    if (it != offsets.end())
+      return it->second;
+
+    auto const offset = base::checked_cast<uint32_t>(strings.size());
+    WriteVarUint(writer, base::checked_cast<uint32_t>(s.size()));
+    writer.Write(s.data(), s.size());
+    offsets.emplace(s, offset);
+    return offset;
+  };
+
+  map<uint32_t, uint32_t> streetIndices;
+  for (auto const & street : m_streets)
+  {
+    streetIndices[street.first] = base::checked_cast<uint32_t>(streets.size());
+    streets.emplace_back(street.first, addString(street.second));
+  }
+
+  points.clear();
+  points.reserve(m_points.size());
+  for (auto const & entry : m_points)
+  {
+    auto const p = PointDToPointU(entry.m_center, POINT_COORD_BITS);
+
+    Record record;
+    record.m_cell = GetCell(p);
+    record.m_x = p.x;
+    record.m_y = p.y;
+    record.m_building = entry.m_building;
+    if (entry.m_street != kNoStreet)
+      record.m_street = streetIndices[entry.m_street];
+    record.m_houseNumberOffset = addString(entry.m_houseNumber);
+    // The radius is rounded up, an extra meter covers the error of the center coordinates.
+    record.m_radius = static_cast<uint16_t>(
+        min(ceil(entry.m_radiusMeters) + 1.0,
+            static_cast<double>(numeric_limits<uint16_t>::max())));
+    points.push_back(record);
+  }
+
+  sort(points.begin(), points.end(), [](Record const & lhs, Record const & rhs) {
+    if (lhs.m_cell != rhs.m_cell)
+      return lhs.m_cell < rhs.m_cell;
+    return lhs.m_building < rhs.m_building;
+  });
+}
+
+// AddressPointsTable ------------------------------------------------------------------------------
+uint8_t constexpr AddressPointsTable::kLatestVersion;
+uint32_t constexpr AddressPointsTable::kNoStreet;
+
+AddressPointsTable::AddressPointsTable(unique_ptr<Reader> reader, uint32_t numPoints,
+                                       uint32_t numStreets)
+  : m_reader(move(reader)), m_numPoints(numPoints), m_numStreets(numStreets)
+{
+}
+
+// static
+unique_ptr<AddressPointsTable> AddressPointsTable::Load(MwmValue const & value)
+{
+  if (!value.m_cont.IsExist(ADDRESS_POINTS_FILE_TAG))
+    return {};
+
+  auto const reader = value.m_cont.GetReader(ADDRESS_POINTS_FILE_TAG);
+  return Load(reader.GetPtr()->CreateSubReader(0 /* pos */, reader.Size()));
+}
+
+// static
+unique_ptr<AddressPointsTable> AddressPointsTable::Load(unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  if (reader->Size() < kHeaderSize)
+    return {};
+
+  auto const version = ReadPrimitiveFromPos<uint8_t>(*reader, 0 /* pos */);
+  if (version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unknown address points table version:", version));
+    return {};
+  }
+
+  auto const numPoints = ReadPrimitiveFromPos<uint32_t>(*reader, sizeof(uint8_t));
+  auto const numStreets =
+      ReadPrimitiveFromPos<uint32_t>(*reader, sizeof(uint8_t) + sizeof(uint32_t));
+  if (reader->Size() < kHeaderSize + numPoints * kPointSize + numStreets * kStreetSize)
+    return {};
+
+  return unique_ptr<AddressPointsTable>(
+      new AddressPointsTable(move(reader), numPoints, numStreets));
+}
+
+void AddressPointsTable::ForEachInRect(m2::RectD const & rect,
+                                       function<void(Point const &)> const & fn) const
+{
+  vector<RectId> cells;
+  CoverRect<MercatorBounds, RectId>(rect, kMaxNumCoverCells, RectId::DEPTH_LEVELS, cells);
+
+  // Cells of the covering don't intersect, so every point is visited once.
+  vector<pair<int64_t, int64_t>> intervals;
+  for (auto const & cell : cells)
+  {
+    auto const begin = cell.ToInt64(RectId::DEPTH_LEVELS);
+    intervals.emplace_back(begin, begin + cell.SubTreeSize(RectId::DEPTH_LEVELS));
+  }
+  sort(intervals.begin(), intervals.end());
+
+  for (auto const & interval : intervals)
+  {
+    // Binary search for the first point which is not less than the interval begin.
+    uint32_t lo = 0;
+    uint32_t hi = m_numPoints;
+    while (lo < hi)
+    {
+      uint32_t const mid = lo + (hi - lo) / 2;
+      if (ReadCell(mid) < interval.first)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    for (uint32_t i = lo; i < m_numPoints && ReadCell(i) < interval.second; ++i)
+    {
+      auto const point = ReadPoint(i);
+      if (rect.IsPointInside(point.m_center))
+        fn(point);
+    }
+  }
+}
+
+string AddressPointsTable::GetHouseNumber(Point const & point) const
+{
+  return ReadString(point.m_houseNumberOffset);
+}
+
+bool AddressPointsTable::GetStreet(Point const & point, uint32_t & street, string & name) const
+{
+  if (point.m_street == kNoStreet)
+    return false;
+
+  ASSERT_LESS(point.m_street, m_numStreets, ());
+  NonOwningReaderSource src(*m_reader);
+  src.Skip(kHeaderSize + m_numPoints * kPointSize + point.m_street * kStreetSize);
+  street = ReadPrimitiveFromSource<uint32_t>(src);
+  name = ReadString(ReadPrimitiveFromSource<uint32_t>(src));
+  return true;
+}
+
+AddressPointsTable::Point AddressPointsTable::ReadPoint(uint32_t i) const
+{
+  ASSERT_LESS(i, m_numPoints, ());
+  NonOwningReaderSource src(*m_reader);
+  src.Skip(kHeaderSize + i * kPointSize);
+
+  m2::PointU p;
+  p.x = ReadPrimitiveFromSource<uint32_t>(src);
+  p.y = ReadPrimitiveFromSource<uint32_t>(src);
+
+  Point point;
+  point.m_center = PointUToPointD(p, POINT_COORD_BITS);
+  point.m_building = ReadPrimitiveFromSource<uint32_t>(src);
+  point.m_street = ReadPrimitiveFromSource<uint32_t>(src);
+  point.m_houseNumberOffset = ReadPrimitiveFromSource<uint32_t>(src);
+  point.m_radiusMeters = ReadPrimitiveFromSource<uint16_t>(src);
+  return point;
+}
+
+int64_t AddressPointsTable::ReadCell(uint32_t i) const
+{
+  ASSERT_LESS(i, m_numPoints, ());
+  NonOwningReaderSource src(*m_reader);
+  src.Skip(kHeaderSize + i * kPointSize);
+
+  m2::PointU p;
+  p.x = ReadPrimitiveFromSource<uint32_t>(src);
+  p.y = ReadPrimitiveFromSource<uint32_t>(src);
+  return GetCell(p);
+}
+
+string AddressPointsTable::ReadString(uint32_t offset) const
+{
+  NonOwningReaderSource src(*m_reader);
+  src.Skip(kHeaderSize + m_numPoints * kPointSize + m_numStreets * kStreetSize + offset);
+
+  string s(ReadVarUint<uint32_t>(src), '\0');
+  src.Read(&s[0], s.size());
+  return s;
+}
+}  // namespace search
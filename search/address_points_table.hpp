@@ -0,0 +1,146 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/checked_cast.hpp"
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class MwmValue;
+
+namespace search
+{
+// Spatial index of buildings having house numbers together with their streets. It's built
+// by the generator from the house-to-street table, so ReverseGeocoder finds nearby addresses
+// without decoding all the buildings and streets around.
+//
+// Layout: header is version, number of points and number of streets. Points are fixed size
+// records sorted by quadtree cells of their centers: coordinates, building feature index,
+// index of the street in the streets list or kNoStreet, offset of the house number and
+// the radius of the building.
+// Streets are fixed size records: street feature index and offset of the name. Strings are
+// varint lengths followed by utf8 chars, equal strings are stored once.
+class AddressPointsTable
+{
+public:
+  static uint8_t constexpr kLatestVersion = 0;
+  static uint32_t constexpr kNoStreet = std::numeric_limits<uint32_t>::max();
+
+  struct Point
+  {
+    m2::PointD m_center;
+    uint32_t m_building = 0;
+    // Index of the street in the streets list, use GetStreet() to get the street.
+    uint32_t m_street = kNoStreet;
+    uint32_t m_houseNumberOffset = 0;
+    // All the points of the building are not farther than the radius from the center.
+    double m_radiusMeters = 0.0;
+  };
+
+  class Builder
+  {
+  public:
+    // |street| is the feature index of the matched street of the building or kNoStreet.
+    void Add(m2::PointD const & center, double radiusMeters, uint32_t building,
+             std::string const & houseNumber, uint32_t street, std::string const & streetName);
+
+    size_t GetNumPoints() const { return m_points.size(); }
+
+    template <typename Sink>
+    void Serialize(Sink & sink) const
+    {
+      std::vector<Record> points;
+      std::vector<std::pair<uint32_t, uint32_t>> streets;
+      std::vector<char> strings;
+      Prepare(points, streets, strings);
+
+      WriteToSink(sink, kLatestVersion);
+      WriteToSink(sink, base::checked_cast<uint32_t>(points.size()));
+      WriteToSink(sink, base::checked_cast<uint32_t>(streets.size()));
+      for (auto const & p : points)
+      {
+        WriteToSink(sink, p.m_x);
+        WriteToSink(sink, p.m_y);
+        WriteToSink(sink, p.m_building);
+        WriteToSink(sink, p.m_street);
+        WriteToSink(sink, p.m_houseNumberOffset);
+        WriteToSink(sink, p.m_radius);
+      }
+      for (auto const & s : streets)
+      {
+        WriteToSink(sink, s.first);
+        WriteToSink(sink, s.second);
+      }
+      sink.Write(strings.data(), strings.size());
+    }
+
+  private:
+    struct Record
+    {
+      int64_t m_cell = 0;
+      uint32_t m_x = 0;
+      uint32_t m_y = 0;
+      uint32_t m_building = 0;
+      uint32_t m_street = kNoStreet;
+      uint32_t m_houseNumberOffset = 0;
+      uint16_t m_radius = 0;
+    };
+
+    struct Entry
+    {
+      m2::PointD m_center;
+      double m_radiusMeters = 0.0;
+      uint32_t m_building = 0;
+      std::string m_houseNumber;
+      uint32_t m_street = kNoStreet;
+    };
+
+    // Sorts points, numbers streets and lays out strings.
+    void Prepare(std::vector<Record> & points,
+                 std::vector<std::pair<uint32_t, uint32_t>> & streets,
+                 std::vector<char> & strings) const;
+
+    std::vector<Entry> m_points;
+    std::map<uint32_t, std::string> m_streets;
+  };
+
+  // Returns nullptr when there is no table in the mwm or the table has an unknown version.
+  static std::unique_ptr<AddressPointsTable> Load(MwmValue const & value);
+  static std::unique_ptr<AddressPointsTable> Load(std::unique_ptr<Reader> reader);
+
+  // Calls |fn| for every point in |rect|, the order of points is not specified.
+  void ForEachInRect(m2::RectD const & rect, std::function<void(Point const &)> const & fn) const;
+
+  std::string GetHouseNumber(Point const & point) const;
+
+  // Returns false when the building has no matched street.
+  bool GetStreet(Point const & point, uint32_t & street, std::string & name) const;
+
+  uint32_t GetNumPoints() const { return m_numPoints; }
+
+private:
+  AddressPointsTable(std::unique_ptr<Reader> reader, uint32_t numPoints, uint32_t numStreets);
+
+  Point ReadPoint(uint32_t i) const;
+  int64_t ReadCell(uint32_t i) const;
+  std::string ReadString(uint32_t offset) const;
+
+  std::unique_ptr<Reader> m_reader;
+  uint32_t m_numPoints = 0;
+  uint32_t m_numStreets = 0;
+
+  DISALLOW_COPY_AND_MOVE(AddressPointsTable);
+};
+}  // namespace search
@@ -12,6 +12,7 @@
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
 #include <cstddef>
 
 using namespace std;
@@ -22,6 +23,9 @@ namespace bookmarks
 {
 namespace
 {
+// Cosine similarity doesn't exceed this value.
+double constexpr kMaxSimilarity = 1.0;
+
 struct DocVecWrapper
 {
   explicit DocVecWrapper(DocVec const & dv) : m_dv(dv) {}
@@ -100,10 +104,13 @@ void Processor::Erase(Id const & id)
   m_docs.erase(id);
 }
 
-void Processor::Search(QueryParams const & params) const
+void Processor::Search(QueryParams const & params, size_t limit) const
 {
-  set<Id> ids;
-  auto insertId = base::MakeInsertFunctor(ids);
+  if (limit == 0)
+    return;
+
+  vector<Id> ids;
+  auto insertId = base::MakeBackInsertFunctor(ids);
 
   for (size_t i = 0; i < params.GetNumTokens(); ++i)
   {
@@ -115,10 +122,12 @@ void Processor::Search(QueryParams const & params) const
     else
       Retrieve<strings::LevenshteinDFA>(token, insertId);
   }
+  base::SortUnique(ids);
 
   IdfMap idfs(*this, 1.0 /* unknownIdf */);
   auto qv = GetQueryVec(idfs, params);
 
+  // Heap of the best |limit| results, the worst of them is on the top.
   vector<IdInfoPair> idInfos;
   for (auto const & id : ids)
   {
@@ -131,11 +140,30 @@ void Processor::Search(QueryParams const & params) const
     RankingInfo info;
     FillRankingInfo(qv, idfs, doc, info);
 
-    idInfos.emplace_back(id, info);
+    IdInfoPair const idInfo(id, info);
+    if (idInfos.size() < limit)
+    {
+      idInfos.push_back(idInfo);
+      push_heap(idInfos.begin(), idInfos.end());
+    }
+    else if (idInfo < idInfos.front())
+    {
+      pop_heap(idInfos.begin(), idInfos.end());
+      idInfos.back() = idInfo;
+      push_heap(idInfos.begin(), idInfos.end());
+    }
+
+    // Ids are visited in increasing order and ties are broken by ids, so when all
+    // the best results have the max similarity, the rest of ids can't replace them.
+    if (idInfos.size() == limit &&
+        idInfos.front().m_info.m_cosineSimilarity >= kMaxSimilarity)
+    {
+      break;
+    }
   }
 
   BailIfCancelled();
-  sort(idInfos.begin(), idInfos.end());
+  sort_heap(idInfos.begin(), idInfos.end());
 
   for (auto const & idInfo : idInfos)
     m_emitter.AddBookmarkResult(bookmarks::Result(idInfo.m_id));
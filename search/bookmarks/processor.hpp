@@ -10,7 +10,9 @@
 #include "search/query_params.hpp"
 #include "search/utils.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -37,7 +39,9 @@ public:
   void Add(Id const & id, Doc const & doc);
   void Erase(Id const & id);
 
-  void Search(QueryParams const & params) const;
+  // Emits at most |limit| best matching bookmarks ordered by relevance.
+  void Search(QueryParams const & params,
+              size_t limit = std::numeric_limits<size_t>::max()) const;
 
   // IdfMap::Delegate overrides:
   uint64_t GetNumDocs(strings::UniString const & token, bool isPrefix) const override;
@@ -51,7 +55,7 @@ private:
     SearchTrieRequest<DFA> request;
     token.ForEach([&request](strings::UniString const & s)
                   {
-                    request.m_names.emplace_back(BuildLevenshteinDFA(s));
+                    request.m_names.emplace_back(*GetLevenshteinDFA(s));
                   });
     request.m_langs.insert(StringUtf8Multilang::kDefaultCode);
 
@@ -14,6 +14,7 @@
 #include "base/cancellable.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
 
 #include <algorithm>
 
@@ -22,6 +23,11 @@ using namespace std;
 
 namespace search
 {
+namespace
+{
+double constexpr kQueryEps = 1e-9;
+}  // namespace
+
 // CitiesBoundariesTable::Boundaries ---------------------------------------------------------------
 bool CitiesBoundariesTable::Boundaries::HasPoint(m2::PointD const & p) const
 {
@@ -30,6 +36,11 @@ bool CitiesBoundariesTable::Boundaries::HasPoint(m2::PointD const & p) const
 }
 
 // CitiesBoundariesTable ---------------------------------------------------------------------------
+CitiesBoundariesTable::CitiesBoundariesTable(DataSource const & dataSource)
+  : m_dataSource(dataSource), m_data(make_shared<Data>())
+{
+}
+
 bool CitiesBoundariesTable::Load()
 {
   auto handle = FindWorld(m_dataSource);
@@ -40,7 +51,7 @@ bool CitiesBoundariesTable::Load()
   }
 
   // Skip if table was already loaded from this file.
-  if (handle.GetId() == m_mwmId)
+  if (handle.GetId() == m_data->m_mwmId)
     return true;
 
   MwmContext context(move(handle));
@@ -61,8 +72,18 @@ bool CitiesBoundariesTable::Load()
   try
   {
     auto reader = cont.GetReader(CITIES_BOUNDARIES_FILE_TAG);
-    ReaderSource<ReaderPtr<ModelReader>> source(reader);
-    CitiesBoundariesSerDes::Deserialize(source, all, precision);
+    // The section of a mapped mwm is decoded right from the mapped memory.
+    if (auto const * data = reader.GetContiguousData())
+    {
+      MemReader memReader(data, static_cast<size_t>(reader.Size()));
+      ReaderSource<MemReader> source(memReader);
+      CitiesBoundariesSerDes::Deserialize(source, all, precision);
+    }
+    else
+    {
+      ReaderSource<ReaderPtr<ModelReader>> source(reader);
+      CitiesBoundariesSerDes::Deserialize(source, all, precision);
+    }
   }
   catch (Reader::Exception const & e)
   {
@@ -80,40 +101,71 @@ bool CitiesBoundariesTable::Load()
     return false;
   }
 
-  m_mwmId = context.GetId();
-  m_table.clear();
-  m_eps = precision;
+  auto data = make_shared<Data>();
+  data->m_mwmId = context.GetId();
+  data->m_eps = precision;
   size_t boundary = 0;
   localities.ForEach([&](uint64_t fid) {
     ASSERT_LESS(boundary, all.size(), ());
-    m_table[base::asserted_cast<uint32_t>(fid)] = move(all[boundary]);
+    data->m_table[base::asserted_cast<uint32_t>(fid)] = move(all[boundary]);
     ++boundary;
   });
   ASSERT_EQUAL(boundary, all.size(), ());
+
+  for (auto const & kv : data->m_table)
+  {
+    for (auto const & cb : kv.second)
+    {
+      Entry entry;
+      entry.m_fid = kv.first;
+      entry.m_boundary = &cb;
+
+      m2::RectD rect(cb.m_bbox.Min(), cb.m_bbox.Max());
+      rect.Inflate(data->m_eps, data->m_eps);
+      data->m_tree.Add(entry, rect);
+    }
+  }
+  data->m_tree.Build();
+  m_data = move(data);
   return true;
 }
 
 bool CitiesBoundariesTable::Get(FeatureID const & fid, Boundaries & bs) const
 {
-  if (fid.m_mwmId != m_mwmId)
+  if (fid.m_mwmId != m_data->m_mwmId)
     return false;
   return Get(fid.m_index, bs);
 }
 
 bool CitiesBoundariesTable::Get(uint32_t fid, Boundaries & bs) const
 {
-  auto const it = m_table.find(fid);
-  if (it == m_table.end())
+  auto const it = m_data->m_table.find(fid);
+  if (it == m_data->m_table.end())
     return false;
-  bs = Boundaries(it->second, m_eps);
+  bs = Boundaries(it->second, m_data->m_eps);
   return true;
 }
 
+void CitiesBoundariesTable::GetCitiesWithPoint(m2::PointD const & p, vector<uint32_t> & fids) const
+{
+  fids.clear();
+
+  // The tree skips rects which only touch the query rect, so the query rect is slightly
+  // inflated to find boundaries having |p| on their sides.
+  m2::RectD rect(p, p);
+  rect.Inflate(kQueryEps, kQueryEps);
+  m_data->m_tree.ForEachInRect(rect, [&](Entry const & entry) {
+    if (entry.m_boundary->HasPoint(p, m_data->m_eps))
+      fids.push_back(entry.m_fid);
+  });
+  base::SortUnique(fids);
+}
+
 void GetCityBoundariesInRectForTesting(CitiesBoundariesTable const & table, m2::RectD const & rect,
                                        vector<uint32_t> & featureIds)
 {
   featureIds.clear();
-  for (auto const & kv : table.m_table)
+  for (auto const & kv : table.m_data->m_table)
   {
     for (auto const & cb : kv.second)
     {
@@ -5,8 +5,12 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
+#include "geometry/packed_tree4d.hpp"
+
+#include "base/macros.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -76,23 +80,56 @@ public:
     double m_eps = 0.0;
   };
 
-  explicit CitiesBoundariesTable(DataSource const & dataSource) : m_dataSource(dataSource) {}
+  explicit CitiesBoundariesTable(DataSource const & dataSource);
 
   bool Load();
 
-  bool Has(FeatureID const & fid) const { return fid.m_mwmId == m_mwmId && Has(fid.m_index); }
-  bool Has(uint32_t fid) const { return m_table.find(fid) != m_table.end(); }
+  // Makes |*this| use the loaded boundaries of |rhs|. The boundaries are immutable, so
+  // tables of several threads may share them, and |rhs| may be reloaded later.
+  void ShareWith(CitiesBoundariesTable const & rhs) { m_data = rhs.m_data; }
+
+  bool Has(FeatureID const & fid) const
+  {
+    return fid.m_mwmId == m_data->m_mwmId && Has(fid.m_index);
+  }
+  bool Has(uint32_t fid) const { return m_data->m_table.find(fid) != m_data->m_table.end(); }
 
   bool Get(FeatureID const & fid, Boundaries & bs) const;
   bool Get(uint32_t fid, Boundaries & bs) const;
 
-  size_t GetSize() const { return m_table.size(); }
+  // Fills |fids| with sorted ids of cities whose boundaries contain |p|. Bounding boxes
+  // of boundaries are kept in a balanced tree, so only a few boundaries are checked.
+  void GetCitiesWithPoint(m2::PointD const & p, std::vector<uint32_t> & fids) const;
+
+  MwmSet::MwmId const & GetMwmId() const { return m_data->m_mwmId; }
+  size_t GetSize() const { return m_data->m_table.size(); }
 
 private:
+  struct Entry
+  {
+    bool operator==(Entry const & rhs) const
+    {
+      return m_fid == rhs.m_fid && m_boundary == rhs.m_boundary;
+    }
+
+    uint32_t m_fid = 0;
+    // Points to a boundary of |m_table|.
+    indexer::CityBoundary const * m_boundary = nullptr;
+  };
+
+  struct Data
+  {
+    MwmSet::MwmId m_mwmId;
+    std::unordered_map<uint32_t, std::vector<indexer::CityBoundary>> m_table;
+    m4::PackedTree<Entry> m_tree;
+    double m_eps = 0.0;
+  };
+
   DataSource const & m_dataSource;
-  MwmSet::MwmId m_mwmId;
-  std::unordered_map<uint32_t, std::vector<indexer::CityBoundary>> m_table;
-  double m_eps = 0.0;
+  // Never null. A new instance is created on every successful Load().
+  std::shared_ptr<Data const> m_data;
+
+  DISALLOW_COPY_AND_MOVE(CitiesBoundariesTable);
 };
 
 /// \brief Fills |featureIds| with feature ids of city boundaries if bounding rect of
@@ -8,6 +8,7 @@
 
 #include "indexer/categories_holder.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/data_source.hpp"
 #include "indexer/scales.hpp"
 #include "indexer/search_string_utils.hpp"
 
@@ -17,6 +18,7 @@
 #include "geometry/mercator.hpp"
 
 #include "base/logging.hpp"
+#include "base/memory_budget.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 
@@ -24,6 +26,8 @@
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <numeric>
+#include <tuple>
 #include <vector>
 
 using namespace std;
@@ -94,8 +98,20 @@ Engine::Params::Params(string const & locale, size_t numThreads)
 // Engine ------------------------------------------------------------------------------------------
 Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, Params const & params)
-  : m_shutdown(false)
+  : m_dataSource(dataSource)
+  , m_infoGetter(infoGetter)
+  , m_searchData(dataSource)
+  , m_shutdown(false)
 {
+  m_dataSource.AddObserver(m_searchData);
+
+  // Retrieved features are cheap to get again, streets' vicinities are not.
+  auto & budget = base::MemoryBudget::Instance();
+  budget.Register(m_retrievalCache, "search::RetrievalCache", base::MemoryBudget::Priority::Low,
+                  RetrievalCache::kDefaultMaxSizeBytes);
+  budget.Register(m_streetVicinityCache, "search::StreetVicinityCache",
+                  base::MemoryBudget::Priority::Normal, StreetVicinityCache::kDefaultMaxSizeBytes);
+
   InitSuggestions doInit;
   categories.ForEachName(bind<void>(ref(doInit), placeholders::_1));
   doInit.GetSuggests(m_suggests);
@@ -103,7 +119,9 @@ Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
-    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter);
+    auto processor =
+        make_unique<Processor>(dataSource, categories, m_suggests, infoGetter, m_retrievalCache,
+                               m_streetVicinityCache, m_searchData, m_stats);
     processor->SetPreferredLocale(params.m_locale);
     m_contexts[i].m_processor = move(processor);
   }
@@ -118,6 +136,10 @@ Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
 
 Engine::~Engine()
 {
+  auto & budget = base::MemoryBudget::Instance();
+  budget.Unregister(m_retrievalCache);
+  budget.Unregister(m_streetVicinityCache);
+
   {
     lock_guard<mutex> lock(m_mu);
     m_shutdown = true;
@@ -126,6 +148,8 @@ Engine::~Engine()
 
   for (auto & thread : m_threads)
     thread.join();
+
+  m_dataSource.RemoveObserver(m_searchData);
 }
 
 weak_ptr<ProcessorHandle> Engine::Search(SearchParams const & params)
@@ -138,6 +162,63 @@ weak_ptr<ProcessorHandle> Engine::Search(SearchParams const & params)
   return handle;
 }
 
+void Engine::SearchBatch(vector<SearchParams> const & batch, OnBatchResults const & onResults)
+{
+  if (batch.empty())
+    return;
+
+  auto const queries = make_shared<vector<SearchParams>>(batch);
+
+  vector<storage::TCountryId> countries(queries->size());
+  for (size_t i = 0; i < queries->size(); ++i)
+    countries[i] = m_infoGetter.GetRegionCountryId((*queries)[i].m_viewport.Center());
+
+  vector<size_t> order(queries->size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    if (countries[lhs] != countries[rhs])
+      return countries[lhs] < countries[rhs];
+    auto const & l = (*queries)[lhs].m_viewport;
+    auto const & r = (*queries)[rhs].m_viewport;
+    return make_tuple(l.minX(), l.minY(), l.maxX(), l.maxY(), lhs) <
+           make_tuple(r.minX(), r.minY(), r.maxX(), r.maxY(), rhs);
+  });
+
+  // Every thread gets several groups on average, so a long group doesn't hold the others.
+  size_t constexpr kGroupsPerThread = 4;
+  size_t const numGroups = m_contexts.size() * kGroupsPerThread;
+  size_t const maxGroupSize = max<size_t>(1, (order.size() + numGroups - 1) / numGroups);
+
+  auto postGroup = [&](size_t begin, size_t end) {
+    vector<size_t> group(order.begin() + begin, order.begin() + end);
+    PostMessage(Message::TYPE_TASK, [this, queries, group, onResults](Processor & processor) {
+      for (auto const i : group)
+      {
+        auto params = (*queries)[i];
+        auto const onQueryResults = params.m_onResults;
+        params.m_onResults = [onQueryResults, onResults, i](Results const & results) {
+          if (onQueryResults)
+            onQueryResults(results);
+          if (results.IsEndMarker() && onResults)
+            onResults(i, results);
+        };
+        DoSearch(params, make_shared<ProcessorHandle>(), processor);
+      }
+    });
+  };
+
+  size_t begin = 0;
+  for (size_t i = 1; i <= order.size(); ++i)
+  {
+    if (i == order.size() || i - begin == maxGroupSize ||
+        countries[order[i]] != countries[order[begin]])
+    {
+      postGroup(begin, i);
+      begin = i;
+    }
+  }
+}
+
 void Engine::SetLocale(string const & locale)
 {
   PostMessage(Message::TYPE_BROADCAST,
@@ -146,6 +227,9 @@ void Engine::SetLocale(string const & locale)
 
 void Engine::ClearCaches()
 {
+  m_retrievalCache.Clear();
+  m_streetVicinityCache.Clear();
+  m_searchData.Clear();
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
 }
 
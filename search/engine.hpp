@@ -1,8 +1,12 @@
 #pragma once
 
 #include "search/bookmarks/processor.hpp"
+#include "search/mwm_search_data.hpp"
 #include "search/result.hpp"
+#include "search/retrieval_cache.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
+#include "search/street_vicinity_cache.hpp"
 #include "search/suggest.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -94,15 +98,40 @@ public:
          storage::CountryInfoGetter const & infoGetter, Params const & params);
   ~Engine();
 
+  // Called when search of the |index|-th query of a batch is finished. |results| are the
+  // final results of the query. Calls are made on search threads in no particular order.
+  using OnBatchResults = std::function<void(size_t index, Results const & results)>;
+
   // Posts search request to the queue and returns its handle.
   std::weak_ptr<ProcessorHandle> Search(SearchParams const & params);
 
+  // Posts all queries of |batch| to the queue. Queries are grouped by mwms of their viewports
+  // and ordered by viewports, and every group is searched by a single thread, so consecutive
+  // queries reuse caches of the processor (mwm contexts, locality rects, retrieved features).
+  // Groups are split to keep all threads busy. Callbacks of queries are called as usual.
+  // Batch queries can't be cancelled.
+  void SearchBatch(std::vector<SearchParams> const & batch, OnBatchResults const & onResults);
+
   // Sets default locale on all query processors.
   void SetLocale(std::string const & locale);
 
   // Posts request to clear caches to the queue.
   void ClearCaches();
 
+  // Returns hits and misses of the cache of retrieved features shared by all threads.
+  RetrievalCache::Stats GetRetrievalCacheStats() const { return m_retrievalCache.GetStats(); }
+
+  // Returns hits, misses and evictions of the cache of streets' vicinities shared by all threads.
+  StreetVicinityCache::Stats GetStreetVicinityCacheStats() const
+  {
+    return m_streetVicinityCache.GetStats();
+  }
+
+  // Returns latencies of search stages and counters of work done by all threads since
+  // the engine creation or the last ClearSearchStats() call.
+  SearchStats::Snapshot GetSearchStats() const { return m_stats.GetSnapshot(); }
+  void ClearSearchStats() { m_stats.Clear(); }
+
   // Posts request to reload cities boundaries tables.
   void LoadCitiesBoundaries();
 
@@ -162,8 +191,16 @@ private:
   void DoSearch(SearchParams const & params, std::shared_ptr<ProcessorHandle> handle,
                 Processor & processor);
 
+  DataSource & m_dataSource;
+  storage::CountryInfoGetter const & m_infoGetter;
+
   std::vector<Suggest> m_suggests;
 
+  RetrievalCache m_retrievalCache;
+  StreetVicinityCache m_streetVicinityCache;
+  MwmSearchDataCache m_searchData;
+  SearchStats m_stats;
+
   bool m_shutdown;
   std::mutex m_mu;
   std::condition_variable m_cv;
@@ -259,6 +259,11 @@ bool MatchCategoriesInTrie(SearchTrieRequest<DFA> const & request,
 
 // Calls |toDo| with trie root prefix and language code on each
 // language allowed by |request|.
+//
+// NOTE: language codes are the first chars of all keys of the search
+// trie, so every language is a separate subtree of the root and is
+// stored as a contiguous range of the section. Subtrees of languages
+// not allowed by |request| are neither read nor mapped to memory.
 template <typename DFA, typename ValueList, typename ToDo>
 void ForEachLangPrefix(SearchTrieRequest<DFA> const & request,
                        trie::Iterator<ValueList> const & trieRoot, ToDo && toDo)
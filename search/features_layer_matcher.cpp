@@ -14,13 +14,14 @@ namespace search
 int constexpr kMaxApproxStreetDistanceM = 100;
 
 FeaturesLayerMatcher::FeaturesLayerMatcher(DataSource const & dataSource,
+                                           StreetVicinityCache & streetVicinityCache,
                                            base::Cancellable const & cancellable)
   : m_context(nullptr)
   , m_postcodes(nullptr)
   , m_reverseGeocoder(dataSource)
   , m_nearbyStreetsCache("FeatureToNearbyStreets")
   , m_matchingStreetsCache("BuildingToStreet")
-  , m_loader(scales::GetUpperScale(), ReverseGeocoder::kLookupRadiusM)
+  , m_loader(scales::GetUpperScale(), ReverseGeocoder::kLookupRadiusM, streetVicinityCache)
   , m_cancellable(cancellable)
 {
 }
@@ -62,7 +62,8 @@ public:
   static int constexpr kBuildingRadiusMeters = 50;
   static int constexpr kStreetRadiusMeters = 100;
 
-  FeaturesLayerMatcher(DataSource const & dataSource, base::Cancellable const & cancellable);
+  FeaturesLayerMatcher(DataSource const & dataSource, StreetVicinityCache & streetVicinityCache,
+                       base::Cancellable const & cancellable);
   void SetContext(MwmContext * context);
   void SetPostcodes(CBV const * postcodes);
 
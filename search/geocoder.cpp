@@ -1,14 +1,15 @@
 #include "search/geocoder.hpp"
 
 #include "search/cbv.hpp"
-#include "search/dummy_rank_table.hpp"
 #include "search/features_filter.hpp"
 #include "search/features_layer_matcher.hpp"
 #include "search/house_numbers_matcher.hpp"
 #include "search/locality_scorer.hpp"
+#include "search/mwm_search_data.hpp"
 #include "search/pre_ranker.hpp"
 #include "search/processor.hpp"
 #include "search/retrieval.hpp"
+#include "search/short_prefix_table.hpp"
 #include "search/token_slice.hpp"
 #include "search/tracer.hpp"
 #include "search/utils.hpp"
@@ -39,6 +40,7 @@
 #include "base/random.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
@@ -52,8 +54,11 @@
 
 #if defined(DEBUG)
 #include "base/timer.hpp"
+#include "base/trace.hpp"
 #endif
 
+#include <atomic>
+#include <exception>
 #include <memory>
 
 using namespace strings;
@@ -112,59 +117,16 @@ struct ScopedMarkTokens
 // static
 BaseContext::TokenType constexpr ScopedMarkTokens::kUnused;
 
-class LazyRankTable : public RankTable
-{
-public:
-  LazyRankTable(MwmValue const & value) : m_value(value) {}
-
-  uint8_t Get(uint64_t i) const override
-  {
-    EnsureTableLoaded();
-    return m_table->Get(i);
-  }
-
-  uint64_t Size() const override
-  {
-    EnsureTableLoaded();
-    return m_table->Size();
-  }
-
-  RankTable::Version GetVersion() const override
-  {
-    EnsureTableLoaded();
-    return m_table->GetVersion();
-  }
-
-  void Serialize(Writer & writer, bool preserveHostEndiannes) override
-  {
-    EnsureTableLoaded();
-    m_table->Serialize(writer, preserveHostEndiannes);
-  }
-
-private:
-  void EnsureTableLoaded() const
-  {
-    if (m_table)
-      return;
-    m_table = search::RankTable::Load(m_value.m_cont, SEARCH_RANKS_FILE_TAG);
-    if (!m_table)
-      m_table = make_unique<search::DummyRankTable>();
-  }
-
-  MwmValue const & m_value;
-  mutable unique_ptr<search::RankTable> m_table;
-};
-
 class LocalityScorerDelegate : public LocalityScorer::Delegate
 {
 public:
   LocalityScorerDelegate(MwmContext const & context, Geocoder::Params const & params,
-                         base::Cancellable const & cancellable)
+                         MwmSearchDataCache & searchData, base::Cancellable const & cancellable)
     : m_context(context)
     , m_params(params)
+    , m_searchData(searchData)
     , m_cancellable(cancellable)
     , m_retrieval(m_context, m_cancellable)
-    , m_ranks(m_context.m_value)
   {
   }
 
@@ -182,7 +144,12 @@ public:
     }
   }
 
-  uint8_t GetRank(uint32_t featureId) const override { return m_ranks.Get(featureId); }
+  uint8_t GetRank(uint32_t featureId) const override
+  {
+    if (!m_data)
+      m_data = m_searchData.Get(m_context.GetId());
+    return m_data ? m_data->GetRanks().Get(featureId) : 0;
+  }
 
   CBV GetMatchedFeatures(strings::UniString const & token, bool isPrefix) const override
   {
@@ -205,11 +172,13 @@ public:
 private:
   MwmContext const & m_context;
   Geocoder::Params const & m_params;
+  MwmSearchDataCache & m_searchData;
   base::Cancellable const & m_cancellable;
 
   Retrieval m_retrieval;
 
-  LazyRankTable m_ranks;
+  // Loaded on the first request of a rank.
+  mutable shared_ptr<MwmSearchData const> m_data;
 };
 
 void JoinQueryTokens(QueryParams const & params, TokenRange const & range, UniString const & sep,
@@ -334,16 +303,37 @@ size_t OrderCountries(m2::PointD const & position, m2::RectD const & pivot, bool
 }
 }  // namespace
 
+// Geocoder::Worker --------------------------------------------------------------------------------
+struct Geocoder::Worker
+{
+  explicit Worker(Geocoder & geocoder)
+    : m_villagesCache(geocoder.m_cancellable)
+    , m_geocoder(geocoder.m_dataSource, geocoder.m_infoGetter, geocoder.m_categories,
+                 geocoder.m_citiesBoundaries, geocoder.m_preRanker, m_villagesCache,
+                 geocoder.m_retrievalCache, geocoder.m_streetVicinityCache,
+                 geocoder.m_searchData, geocoder.m_cancellable)
+  {
+  }
+
+  VillagesCache m_villagesCache;
+  Geocoder m_geocoder;
+};
+
 // Geocoder::Geocoder ------------------------------------------------------------------------------
 Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
                    CategoriesHolder const & categories,
                    CitiesBoundariesTable const & citiesBoundaries, PreRanker & preRanker,
-                   VillagesCache & villagesCache, base::Cancellable const & cancellable)
+                   VillagesCache & villagesCache, RetrievalCache & retrievalCache,
+                   StreetVicinityCache & streetVicinityCache, MwmSearchDataCache & searchData,
+                   base::Cancellable const & cancellable)
   : m_dataSource(dataSource)
   , m_infoGetter(infoGetter)
   , m_categories(categories)
   , m_streetsCache(cancellable)
   , m_villagesCache(villagesCache)
+  , m_retrievalCache(retrievalCache)
+  , m_streetVicinityCache(streetVicinityCache)
+  , m_searchData(searchData)
   , m_hotelsCache(cancellable)
   , m_foodCache(cancellable)
   , m_hotelsFilter(m_hotelsCache)
@@ -380,7 +370,7 @@ void Geocoder::SetParams(Params const & params)
       m_tokenRequests.emplace_back();
       auto & request = m_tokenRequests.back();
       m_params.GetToken(i).ForEach([&request](UniString const & s) {
-        request.m_names.emplace_back(BuildLevenshteinDFA(s));
+        request.m_names.emplace_back(*GetLevenshteinDFA(s));
       });
       for (auto const & index : m_params.GetTypeIndices(i))
         request.m_categories.emplace_back(FeatureTypeToString(index));
@@ -390,7 +380,7 @@ void Geocoder::SetParams(Params const & params)
     {
       auto & request = m_prefixTokenRequest;
       m_params.GetToken(i).ForEach([&request](UniString const & s) {
-        request.m_names.emplace_back(BuildLevenshteinDFA(s));
+        request.m_names.emplace_back(*GetLevenshteinDFA(s));
       });
       for (auto const & index : m_params.GetTypeIndices(i))
         request.m_categories.emplace_back(FeatureTypeToString(index));
@@ -447,6 +437,7 @@ void Geocoder::ClearCaches()
   m_localityRectsCache.Clear();
 
   m_matchersCache.clear();
+  m_workers.clear();
   m_streetsCache.Clear();
   m_hotelsCache.Clear();
   m_foodCache.Clear();
@@ -469,6 +460,7 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
 
 void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
 {
+  TRACE_ZONE("Geocoder::GoImpl");
   // base::PProf pprof("/tmp/geocoder.prof");
 
   // Tries to find world and fill localities table.
@@ -490,6 +482,9 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
       {
         BaseContext ctx;
         InitBaseContext(ctx);
+
+        TRACE_ZONE("Geocoder::FillLocalities");
+        SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::FillLocalities);
         FillLocalitiesTable(ctx);
       }
 
@@ -511,98 +506,305 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
   size_t const numIntersectingMaps =
       OrderCountries(m_params.m_position, m_params.m_pivot, inViewport, infos);
 
+  size_t numMatchedMaps = 0;
+  if (m_params.m_numThreads > 1 && !m_params.m_tracer)
+  {
+    MatchCountriesInParallel(infos, numIntersectingMaps, inViewport);
+    numMatchedMaps = numIntersectingMaps;
+  }
+
   // MatchAroundPivot() should always be matched in mwms
   // intersecting with position and viewport.
   auto processCountry = [&](size_t index, unique_ptr<MwmContext> context) {
-    ASSERT(context, ());
-    m_context = move(context);
+    MatchCountry(index < numIntersectingMaps /* intersectsPivot */, inViewport, move(context));
+    if (index + 1 >= numIntersectingMaps || m_params.m_updateResultsPerMwm)
+      m_preRanker.UpdateResults(false /* lastUpdate */);
+  };
 
-    SCOPE_GUARD(cleanup, [&]() {
-      LOG(LDEBUG, (m_context->GetName(), "geocoding complete."));
-      m_matcher->OnQueryFinished();
-      m_matcher = nullptr;
-      m_context.reset();
-    });
+  // Iterates through all alive mwms and performs geocoding.
+  ForEachCountry(infos, numMatchedMaps, infos.size(), processCountry);
+}
+
+void Geocoder::MatchCountry(bool intersectsPivot, bool inViewport, unique_ptr<MwmContext> context)
+{
+  ASSERT(context, ());
+  m_context = move(context);
+
+  SCOPE_GUARD(cleanup, [&]() {
+    LOG(LDEBUG, (m_context->GetName(), "geocoding complete."));
+    m_matcher->OnQueryFinished();
+    m_matcher = nullptr;
+    m_context.reset();
+  });
+
+  auto it = m_matchersCache.find(m_context->GetId());
+  if (it == m_matchersCache.end())
+  {
+    it = m_matchersCache
+             .insert(make_pair(m_context->GetId(),
+                               std::make_unique<FeaturesLayerMatcher>(
+                                   m_dataSource, m_streetVicinityCache, m_cancellable)))
+             .first;
+  }
+  m_matcher = it->second.get();
+  m_matcher->SetContext(m_context.get());
+
+  if (m_params.m_stats)
+    m_params.m_stats->Add(SearchStats::Counter::MatchedMwms, 1);
+
+  BaseContext ctx;
+  InitBaseContext(ctx);
 
-    auto it = m_matchersCache.find(m_context->GetId());
-    if (it == m_matchersCache.end())
+  if (inViewport)
+  {
+    auto const viewportCBV =
+        RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RECT_ID_PIVOT);
+    for (auto & features : ctx.m_features)
+      features = features.Intersect(viewportCBV);
+  }
+
+  ctx.m_villages = m_villagesCache.Get(*m_context);
+
+  auto citiesFromWorld = m_cities;
+  FillVillageLocalities(ctx);
+  SCOPE_GUARD(remove_villages, [&]() { m_cities = citiesFromWorld; });
+
+  if (m_params.IsCategorialRequest())
+  {
+    TRACE_ZONE("Geocoder::MatchCategories");
+    SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::MatchCategories);
+    MatchCategories(ctx, intersectsPivot);
+  }
+  else
+  {
     {
-      it = m_matchersCache
-               .insert(make_pair(m_context->GetId(),
-                                 std::make_unique<FeaturesLayerMatcher>(m_dataSource, m_cancellable)))
-               .first;
+      TRACE_ZONE("Geocoder::MatchRegions");
+      SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::MatchRegions);
+      MatchRegions(ctx, Region::TYPE_COUNTRY);
     }
-    m_matcher = it->second.get();
-    m_matcher->SetContext(m_context.get());
-
-    BaseContext ctx;
-    InitBaseContext(ctx);
 
-    if (inViewport)
+    if (intersectsPivot || m_preRanker.NumSentResults() == 0)
     {
-      auto const viewportCBV =
-          RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RECT_ID_PIVOT);
-      for (auto & features : ctx.m_features)
-        features = features.Intersect(viewportCBV);
+      TRACE_ZONE("Geocoder::MatchAroundPivot");
+      SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::MatchAroundPivot);
+      MatchAroundPivot(ctx);
     }
+  }
+}
 
-    ctx.m_villages = m_villagesCache.Get(*m_context);
+void Geocoder::MatchCountriesInParallel(vector<shared_ptr<MwmInfo>> const & infos,
+                                        size_t numIntersectingMaps, bool inViewport)
+{
+  vector<pair<size_t, unique_ptr<MwmContext>>> countries;
+  ForEachCountry(infos, 0 /* begin */, numIntersectingMaps,
+                 [&](size_t index, unique_ptr<MwmContext> context) {
+                   countries.emplace_back(index, move(context));
+                 });
+  if (countries.empty())
+    return;
 
-    auto citiesFromWorld = m_cities;
-    FillVillageLocalities(ctx);
-    SCOPE_GUARD(remove_villages, [&]() { m_cities = citiesFromWorld; });
+  size_t const numWorkers = min(m_params.m_numThreads, countries.size()) - 1;
+  while (m_workers.size() < numWorkers)
+    m_workers.push_back(make_unique<Worker>(*this));
 
-    bool const intersectsPivot = index < numIntersectingMaps;
-    if (m_params.IsCategorialRequest())
+  // Workers match mwms in the same context as this geocoder does.
+  for (size_t i = 0; i < numWorkers; ++i)
+  {
+    auto & geocoder = m_workers[i]->m_geocoder;
+    geocoder.SetParams(m_params);
+    geocoder.m_worldId = m_worldId;
+    geocoder.m_cities = m_cities;
+    for (size_t j = 0; j < Region::TYPE_COUNT; ++j)
+      geocoder.m_regions[j] = m_regions[j];
+  }
+
+  // Mwms are taken by free geocoders one by one, so a long mwm doesn't hold the others.
+  // Results of an mwm are kept apart and are passed to |m_preRanker| in the order of
+  // |countries| to get the same results as sequential matching does.
+  vector<vector<PreRankerResult>> results(countries.size());
+  vector<std::exception_ptr> errors(numWorkers + 1);
+  std::atomic<size_t> next(0);
+  auto matchCountries = [&](Geocoder & geocoder, std::exception_ptr & error) {
+    try
     {
-      MatchCategories(ctx, intersectsPivot);
+      for (size_t i = next++; i < countries.size() && !geocoder.IsDeadlineExceeded(); i = next++)
+      {
+        geocoder.m_results = &results[i];
+        geocoder.MatchCountry(true /* intersectsPivot */, inViewport, move(countries[i].second));
+      }
     }
-    else
+    catch (...)
     {
-      MatchRegions(ctx, Region::TYPE_COUNTRY);
-
-      if (intersectsPivot || m_preRanker.NumSentResults() == 0)
-        MatchAroundPivot(ctx);
+      error = std::current_exception();
+      next = countries.size();
     }
-
-    if (index + 1 >= numIntersectingMaps)
-      m_preRanker.UpdateResults(false /* lastUpdate */);
+    geocoder.m_results = nullptr;
   };
 
-  // Iterates through all alive mwms and performs geocoding.
-  ForEachCountry(infos, processCountry);
+  {
+    vector<threads::SimpleThread> threads;
+    for (size_t i = 0; i < numWorkers; ++i)
+      threads.emplace_back(matchCountries, std::ref(m_workers[i]->m_geocoder),
+                           std::ref(errors[i + 1]));
+    matchCountries(*this, errors[0]);
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  for (auto const & error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  for (auto & countryResults : results)
+  {
+    for (auto & result : countryResults)
+      m_preRanker.Emplace(move(result));
+  }
+
+  if (countries.back().first + 1 >= numIntersectingMaps)
+    m_preRanker.UpdateResults(false /* lastUpdate */);
+}
+
+RetrievalCache::Key Geocoder::MakeRetrievalCacheKey(size_t i) const
+{
+  ASSERT(m_context, ());
+  RetrievalCache::Key key;
+  key.m_mwmId = m_context->GetId();
+  key.m_mwmVersion = m_context->GetInfo()->GetVersion();
+  m_params.GetToken(i).ForEach([&key](UniString const & s) { key.m_tokens.push_back(s); });
+  key.m_types = m_params.GetTypeIndices(i);
+  for (auto const lang : m_params.GetLangs())
+    key.m_langs |= uint64_t{1} << lang;
+  key.m_isPrefix = m_params.IsPrefixToken(i);
+  return key;
 }
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
+  TRACE_ZONE("Geocoder::Retrieval");
+  SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::Retrieval);
   Retrieval retrieval(*m_context, m_cancellable);
 
   ctx.m_tokens.assign(m_params.GetNumTokens(), BaseContext::TOKEN_TYPE_COUNT);
   ctx.m_numTokens = m_params.GetNumTokens();
   ctx.m_features.resize(ctx.m_numTokens);
+  // All the tokens of a categorial request match the same features.
+  CBV categorialFeatures;
+  if (m_params.IsCategorialRequest())
+    categorialFeatures = RetrieveCategorialFeatures(retrieval);
+
   for (size_t i = 0; i < ctx.m_features.size(); ++i)
   {
     if (m_params.IsCategorialRequest())
     {
-      // Implementation-wise, the simplest way to match a feature by
-      // its category bypassing the matching by name is by using a CategoriesCache.
-      CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
-      ctx.m_features[i] = cache.Get(*m_context);
+      ctx.m_features[i] = categorialFeatures;
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      if (RetrieveShortPrefixFeatures(retrieval, i, ctx.m_features[i]))
+        continue;
+      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(
+          m_prefixTokenRequest, MakeRetrievalCacheKey(i), m_retrievalCache);
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(
+          m_tokenRequests[i], MakeRetrievalCacheKey(i), m_retrievalCache);
+    }
+  }
+
+  if (m_params.m_stats)
+  {
+    uint64_t numFeatures = 0;
+    for (auto const & features : ctx.m_features)
+    {
+      if (!features.IsFull())
+        numFeatures += features.PopCount();
     }
+    m_params.m_stats->Add(SearchStats::Counter::RetrievedFeatures, numFeatures);
   }
 
   ctx.m_hotelsFilter = m_hotelsFilter.MakeScopedFilter(*m_context, m_params.m_hotelsFilter);
   ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
 }
 
+bool Geocoder::RetrieveShortPrefixFeatures(Retrieval const & retrieval, size_t i, CBV & features)
+{
+  if (!m_params.m_useShortPrefixTables)
+    return false;
+
+  auto const & token = m_params.GetToken(i);
+  bool allShort = true;
+  token.ForEach([&allShort](UniString const & s) {
+    allShort = allShort && ShortPrefixTable::IsShortPrefix(s);
+  });
+  if (!allShort)
+    return false;
+
+  auto const table = ShortPrefixTable::Load(m_context->m_value);
+  if (!table)
+    return false;
+
+  vector<uint32_t> ids;
+  token.ForEach([&](UniString const & s) {
+    for (auto const lang : m_params.GetLangs())
+      table->GetFeatures(static_cast<uint8_t>(lang), s, ids);
+  });
+  base::SortUnique(ids);
+
+  auto const & editor = osm::Editor::Instance();
+  vector<uint64_t> positions;
+  positions.reserve(ids.size());
+  for (auto const id : ids)
+  {
+    if (editor.GetFeatureStatus(m_context->GetId(), id) != FeatureStatus::Deleted)
+      positions.push_back(id);
+  }
+  features = CBV(coding::CompressedBitVectorBuilder::FromBitPositions(move(positions)));
+
+  // Categories are not in the table, so they are matched in the search index as usual.
+  auto const & typeIndices = m_params.GetTypeIndices(i);
+  if (!typeIndices.empty())
+  {
+    SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> request;
+    for (auto const & index : typeIndices)
+      request.m_categories.emplace_back(FeatureTypeToString(index));
+    request.SetLangs(m_params.GetLangs());
+
+    auto key = MakeRetrievalCacheKey(i);
+    key.m_tokens.clear();
+    features = features.Union(
+        CBV(retrieval.RetrieveAddressFeatures(request, key, m_retrievalCache)));
+  }
+  return true;
+}
+
+CBV Geocoder::RetrieveCategorialFeatures(Retrieval const & retrieval)
+{
+  auto const & c = classif();
+
+  RetrievalCache::Key key;
+  key.m_mwmId = m_context->GetId();
+  key.m_mwmVersion = m_context->GetInfo()->GetVersion();
+
+  CBV features;
+  for (auto const type : m_params.m_preferredTypes)
+  {
+    auto const index = c.GetIndexForType(type);
+
+    // Only categories are matched, names and languages of the request are not needed.
+    SearchTrieRequest<strings::LevenshteinDFA> request;
+    request.m_categories.emplace_back(FeatureTypeToString(index));
+
+    key.m_types = {index};
+    features = features.Union(
+        CBV(retrieval.RetrieveAddressFeatures(request, key, m_retrievalCache)));
+  }
+  return features;
+}
+
 void Geocoder::InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer)
 {
   layer.Clear();
@@ -625,7 +827,7 @@ void Geocoder::FillLocalityCandidates(BaseContext const & ctx, CBV const & filte
     return;
   }
 
-  LocalityScorerDelegate delegate(*m_context, m_params, m_cancellable);
+  LocalityScorerDelegate delegate(*m_context, m_params, m_searchData, m_cancellable);
   LocalityScorer scorer(m_params, delegate);
   scorer.GetTopLocalities(m_context->GetId(), ctx, filter, maxNumLocalities, preLocalities);
 }
@@ -766,10 +968,18 @@ void Geocoder::FillVillageLocalities(BaseContext const & ctx)
 }
 
 template <typename TFn>
-void Geocoder::ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn && fn)
+void Geocoder::ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, size_t begin, size_t end,
+                              TFn && fn)
 {
-  for (size_t i = 0; i < infos.size(); ++i)
+  ASSERT_LESS_OR_EQUAL(end, infos.size(), ());
+  for (size_t i = begin; i < end; ++i)
   {
+    if (IsDeadlineExceeded())
+    {
+      LOG(LDEBUG, ("Deadline is exceeded,", end - i, "mwms are not matched."));
+      return;
+    }
+
     auto const & info = infos[i];
     if (info->GetType() != MwmInfo::COUNTRY && info->GetType() != MwmInfo::WORLD)
       continue;
@@ -1359,7 +1569,10 @@ void Geocoder::EmitResult(BaseContext & ctx, MwmSet::MwmId const & mwmId, uint32
 
   info.m_allTokensUsed = allTokensUsed;
 
-  m_preRanker.Emplace(id, info);
+  if (m_results)
+    m_results->emplace_back(id, info);
+  else
+    m_preRanker.Emplace(id, info);
 
   // ++ctx.m_numEmitted;
 }
@@ -16,9 +16,13 @@
 #include "search/model.hpp"
 #include "search/mwm_context.hpp"
 #include "search/nested_rects_cache.hpp"
+#include "search/intermediate_result.hpp"
 #include "search/pre_ranking_info.hpp"
 #include "search/query_params.hpp"
 #include "search/ranking_utils.hpp"
+#include "search/retrieval_cache.hpp"
+#include "search/search_stats.hpp"
+#include "search/street_vicinity_cache.hpp"
 #include "search/streets_matcher.hpp"
 #include "search/token_range.hpp"
 
@@ -44,6 +48,8 @@
 #include "std/unordered_map.hpp"
 #include "std/vector.hpp"
 
+#include <chrono>
+
 class CategoriesHolder;
 class DataSource;
 class MwmValue;
@@ -57,7 +63,9 @@ namespace search
 {
 class FeaturesFilter;
 class FeaturesLayerMatcher;
+class MwmSearchDataCache;
 class PreRanker;
+class Retrieval;
 class TokenSlice;
 class Tracer;
 
@@ -89,11 +97,30 @@ public:
     vector<uint32_t> m_cuisineTypes;
     vector<uint32_t> m_preferredTypes;
     shared_ptr<Tracer> m_tracer;
+
+    // Number of threads mwms intersecting with the pivot are matched on.
+    // Parallel matching is not used when |m_tracer| is set.
+    size_t m_numThreads = 1;
+
+    // Mwms are not matched after the deadline. An mwm being matched is finished.
+    std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+
+    // When set, results are passed to the pre-ranker after every matched mwm instead of
+    // after all mwms intersecting with the pivot.
+    bool m_updateResultsPerMwm = false;
+
+    // When set, features matching a short prefix token are taken from short prefix tables
+    // of mwms instead of search indices, see short_prefix_table.hpp.
+    bool m_useShortPrefixTables = false;
+
+    // Latencies of matching stages are added to |m_stats|. Not owned, may be nullptr.
+    SearchStats * m_stats = nullptr;
   };
 
   Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
            CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries,
-           PreRanker & preRanker, VillagesCache & villagesCache,
+           PreRanker & preRanker, VillagesCache & villagesCache, RetrievalCache & retrievalCache,
+           StreetVicinityCache & streetVicinityCache, MwmSearchDataCache & searchData,
            base::Cancellable const & cancellable);
   ~Geocoder();
 
@@ -128,6 +155,10 @@ private:
     RECT_ID_COUNT
   };
 
+  // Geocoder with its own caches matching mwms on a separate thread, see
+  // MatchCountriesInParallel().
+  struct Worker;
+
   struct Postcodes
   {
     void Clear()
@@ -145,15 +176,36 @@ private:
 
   void GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport);
 
+  // Performs geocoding in the mwm of |context|.
+  void MatchCountry(bool intersectsPivot, bool inViewport, unique_ptr<MwmContext> context);
+
+  // Performs geocoding in mwms of |infos| intersecting with the pivot on
+  // |m_params.m_numThreads| threads. Results are passed to |m_preRanker| in the
+  // same order as in sequential geocoding.
+  void MatchCountriesInParallel(vector<shared_ptr<MwmInfo>> const & infos,
+                                size_t numIntersectingMaps, bool inViewport);
+
   template <typename Locality>
   using LocalitiesCache = map<TokenRange, vector<Locality>>;
 
   QueryParams::Token const & GetTokens(size_t i) const;
 
+  // Returns a key of |m_retrievalCache| for the |i|-th token in m_context.
+  RetrievalCache::Key MakeRetrievalCacheKey(size_t i) const;
+
   // Creates a cache of posting lists corresponding to features in m_context
   // for each token and saves it to m_addressFeatures.
   void InitBaseContext(BaseContext & ctx);
 
+  // Retrieves features matching the |i|-th token from the short prefix table of m_context.
+  // Returns false if the table can't be used for the token.
+  bool RetrieveShortPrefixFeatures(Retrieval const & retrieval, size_t i, CBV & features);
+
+  // Retrieves features of m_context having any of the preferred types of a categorial request.
+  // Features of every type are cached in |m_retrievalCache| separately, so different
+  // categories having common types share them.
+  CBV RetrieveCategorialFeatures(Retrieval const & retrieval);
+
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
   void FillLocalityCandidates(BaseContext const & ctx,
@@ -164,12 +216,19 @@ private:
 
   void FillVillageLocalities(BaseContext const & ctx);
 
+  // Calls |fn| for alive mwms of |infos| with indices in [|begin|, |end|) until the deadline.
   template <typename TFn>
-  void ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn && fn);
+  void ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, size_t begin, size_t end,
+                      TFn && fn);
 
   // Throws CancelException if cancelled.
   inline void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
 
+  bool IsDeadlineExceeded() const
+  {
+    return std::chrono::steady_clock::now() >= m_params.m_deadline;
+  }
+
   // A fast-path branch for categorial requests.
   void MatchCategories(BaseContext & ctx, bool aroundPivot);
 
@@ -250,6 +309,9 @@ private:
 
   StreetsCache m_streetsCache;
   VillagesCache & m_villagesCache;
+  RetrievalCache & m_retrievalCache;
+  StreetVicinityCache & m_streetVicinityCache;
+  MwmSearchDataCache & m_searchData;
   HotelsCache m_hotelsCache;
   FoodCache m_foodCache;
   hotels_filter::HotelsFilter m_hotelsFilter;
@@ -302,5 +364,11 @@ private:
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
 
   PreRanker & m_preRanker;
+
+  // When it's set, results are collected here instead of |m_preRanker|.
+  vector<PreRankerResult> * m_results = nullptr;
+
+  // Geocoders of threads of MatchCountriesInParallel().
+  vector<unique_ptr<Worker>> m_workers;
 };
 }  // namespace search
@@ -4,17 +4,55 @@
 
 #include "platform/mwm_traits.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/fixed_bits_ddvector.hpp"
+#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
+#include "coding/succinct_mapper.hpp"
+#include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
 
 #include "defines.hpp"
 
+#include "3party/succinct/elias_fano.hpp"
+#include "3party/succinct/elias_fano_compressed_list.hpp"
+
 namespace search
 {
 namespace
 {
+struct Header
+{
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, m_version);
+    WriteToSink(sink, m_endianness);
+    WriteToSink(sink, m_housesSize);
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    m_version = ReadPrimitiveFromSource<uint16_t>(src);
+    m_endianness = ReadPrimitiveFromSource<uint16_t>(src);
+    m_housesSize = ReadPrimitiveFromSource<uint32_t>(src);
+  }
+
+  uint16_t m_version = 0;
+  // Field |m_endianness| is reserved for endianness of the section.
+  uint16_t m_endianness = 0;
+  // Size of the houses set, the list of streets follows it.
+  uint32_t m_housesSize = 0;
+};
+
+static_assert(sizeof(Header) == 8, "Wrong header size of house_to_street section.");
+
 class Fixed3BitsTable : public HouseToStreetTable
 {
 public:
@@ -36,14 +74,65 @@ private:
   unique_ptr<TVector> m_vector;
 };
 
+class EliasFanoTable : public HouseToStreetTable
+{
+public:
+  EliasFanoTable(unique_ptr<MemoryRegion> && region, uint32_t housesSize)
+    : m_region(move(region))
+  {
+    auto const * data = m_region->ImmutableData() + sizeof(Header);
+    {
+      coding::MapVisitor visitor(data);
+      m_houses.map(visitor);
+    }
+    {
+      coding::MapVisitor visitor(data + housesSize);
+      m_streets.map(visitor);
+    }
+  }
+
+  // HouseToStreetTable overrides:
+  bool Get(uint32_t houseId, uint32_t & streetIndex) const override
+  {
+    if (houseId >= m_houses.size() || !m_houses[houseId])
+      return false;
+    streetIndex = static_cast<uint32_t>(m_streets[m_houses.rank(houseId)]);
+    return true;
+  }
+
+private:
+  unique_ptr<MemoryRegion> m_region;
+  succinct::elias_fano m_houses;
+  succinct::elias_fano_compressed_list m_streets;
+};
+
 class DummyTable : public HouseToStreetTable
 {
 public:
   // HouseToStreetTable overrides:
   bool Get(uint32_t /* houseId */, uint32_t & /* streetIndex */) const override { return false; }
 };
+
+unique_ptr<MemoryRegion> GetMemoryRegion(MwmValue const & value)
+{
+  try
+  {
+    FilesMappingContainer const cont(value.m_cont.GetFileName());
+    return make_unique<MappedMemoryRegion>(cont.Map(HOUSE_TO_STREET_FILE_TAG));
+  }
+  catch (Reader::Exception const & e)
+  {
+    // The mwm can't be mapped (e.g. it's not a plain file), so the section is copied.
+    LOG(LWARNING, ("Can't map", HOUSE_TO_STREET_FILE_TAG, "section.", e.Msg()));
+    auto const reader = value.m_cont.GetReader(HOUSE_TO_STREET_FILE_TAG);
+    vector<uint8_t> buffer(static_cast<size_t>(reader.Size()));
+    reader.Read(0 /* pos */, buffer.data(), buffer.size());
+    return make_unique<CopiedMemoryRegion>(move(buffer));
+  }
+}
 }  // namespace
 
+// HouseToStreetTable ------------------------------------------------------------------------------
 unique_ptr<HouseToStreetTable> HouseToStreetTable::Load(MwmValue & value)
 {
   version::MwmTraits traits(value.GetMwmVersion());
@@ -53,7 +142,9 @@ unique_ptr<HouseToStreetTable> HouseToStreetTable::Load(MwmValue & value)
 
   try
   {
-    if (format == version::MwmTraits::HouseToStreetTableFormat::Fixed3BitsDDVector)
+    if (value.m_cont.IsExist(HOUSE_TO_STREET_FILE_TAG))
+      result = Load(GetMemoryRegion(value));
+    else if (format == version::MwmTraits::HouseToStreetTableFormat::Fixed3BitsDDVector)
       result.reset(new Fixed3BitsTable(value));
   }
   catch (Reader::OpenException const & ex)
@@ -66,4 +157,79 @@ unique_ptr<HouseToStreetTable> HouseToStreetTable::Load(MwmValue & value)
   return result;
 }
 
+// static
+unique_ptr<HouseToStreetTable> HouseToStreetTable::Load(unique_ptr<MemoryRegion> && region)
+{
+  CHECK(region, ());
+  if (region->Size() < sizeof(Header))
+    return {};
+
+  Header header;
+  {
+    MemReader reader(region->ImmutableData(), sizeof(Header));
+    ReaderSource<MemReader> src(reader);
+    header.Deserialize(src);
+  }
+
+  if (header.m_version != HouseToStreetTableBuilder::kLatestVersion)
+  {
+    LOG(LWARNING, ("Unknown house to street table version:", header.m_version));
+    return {};
+  }
+
+  return make_unique<EliasFanoTable>(move(region), header.m_housesSize);
+}
+
+// HouseToStreetTableBuilder -----------------------------------------------------------------------
+uint16_t constexpr HouseToStreetTableBuilder::kLatestVersion;
+
+void HouseToStreetTableBuilder::Put(uint32_t houseId, uint32_t streetIndex)
+{
+  m_streets.emplace_back(houseId, streetIndex);
+}
+
+void HouseToStreetTableBuilder::Freeze(Writer & writer) const
+{
+  auto streets = m_streets;
+  sort(streets.begin(), streets.end());
+  CHECK(adjacent_find(streets.begin(), streets.end(),
+                      [](pair<uint32_t, uint32_t> const & lhs,
+                         pair<uint32_t, uint32_t> const & rhs) {
+                        return lhs.first == rhs.first;
+                      }) == streets.end(),
+        ("Houses should be unique."));
+
+  uint64_t const numHouses = streets.empty() ? 0 : streets.back().first + 1;
+  succinct::elias_fano::elias_fano_builder housesBuilder(numHouses, streets.size());
+  vector<uint32_t> indices;
+  indices.reserve(streets.size());
+  for (auto const & street : streets)
+  {
+    housesBuilder.push_back(street.first);
+    indices.push_back(street.second);
+  }
+  succinct::elias_fano houses(&housesBuilder);
+  succinct::elias_fano_compressed_list streetIndices(indices);
+
+  auto const startPos = writer.Pos();
+  Header header;
+  header.m_version = kLatestVersion;
+  header.Serialize(writer);
+
+  auto const housesPos = writer.Pos();
+  {
+    coding::FreezeVisitor<Writer> visitor(writer);
+    houses.map(visitor);
+  }
+  header.m_housesSize = base::checked_cast<uint32_t>(writer.Pos() - housesPos);
+  {
+    coding::FreezeVisitor<Writer> visitor(writer);
+    streetIndices.map(visitor);
+  }
+
+  auto const endPos = writer.Pos();
+  writer.Seek(startPos);
+  header.Serialize(writer);
+  writer.Seek(endPos);
+}
 }  // namespace search
@@ -2,8 +2,12 @@
 
 #include "std/limits.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
 
+class MemoryRegion;
 class MwmValue;
+class Writer;
 
 namespace search
 {
@@ -16,6 +20,10 @@ public:
   /// It's better to construct a table from MwmHandle.
   static unique_ptr<HouseToStreetTable> Load(MwmValue & value);
 
+  // Loads a table of HOUSE_TO_STREET_FILE_TAG section from |region|. Returns nullptr when
+  // the section has an unknown version.
+  static unique_ptr<HouseToStreetTable> Load(unique_ptr<MemoryRegion> && region);
+
   // Returns true and stores to |streetIndex| the index number of the
   // correct street corresponding to the house in the list of streets
   // generated by ReverseGeocoder.  Returns false if there is no such
@@ -23,4 +31,20 @@ public:
   virtual bool Get(uint32_t houseId, uint32_t & streetIndex) const = 0;
 };
 
+// Builds HOUSE_TO_STREET_FILE_TAG section: ids of houses having streets are stored
+// in an Elias-Fano set and their street indices are stored in an Elias-Fano compressed
+// list in the same order. Both structures are mapped from the section as is.
+class HouseToStreetTableBuilder
+{
+public:
+  static uint16_t constexpr kLatestVersion = 0;
+
+  void Put(uint32_t houseId, uint32_t streetIndex);
+  void Freeze(Writer & writer) const;
+
+  size_t GetCount() const { return m_streets.size(); }
+
+private:
+  vector<pair<uint32_t, uint32_t>> m_streets;
+};
 }  // namespace search
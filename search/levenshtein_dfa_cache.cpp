@@ -0,0 +1,83 @@
+#include "search/levenshtein_dfa_cache.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace search
+{
+// static
+size_t constexpr LevenshteinDFACache::kDefaultMaxSizeBytes;
+
+LevenshteinDFACache::LevenshteinDFACache(Builder const & builder, size_t maxSizeBytes)
+  : m_builder(builder), m_maxSizeBytes(maxSizeBytes)
+{
+  CHECK(m_builder, ());
+}
+
+LevenshteinDFACache::DFAPtr LevenshteinDFACache::Get(strings::UniString const & s,
+                                                     size_t maxErrors)
+{
+  Key key(s, maxErrors);
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_dfas.find(key);
+    if (it != m_dfas.end())
+      return it->second;
+  }
+
+  auto const dfa = make_shared<strings::LevenshteinDFA const>(m_builder(s, maxErrors));
+  size_t const sizeBytes = GetSizeBytes(*dfa);
+  if (sizeBytes > m_maxSizeBytes)
+    return dfa;
+
+  lock_guard<mutex> lock(m_mutex);
+  // The DFA may be built by another thread meanwhile.
+  auto const it = m_dfas.find(key);
+  if (it != m_dfas.end())
+    return it->second;
+
+  while (!m_keys.empty() && m_sizeBytes + sizeBytes > m_maxSizeBytes)
+  {
+    auto const jt = m_dfas.find(m_keys.front());
+    ASSERT(jt != m_dfas.end(), ());
+    size_t const evictedSizeBytes = GetSizeBytes(*jt->second);
+    ASSERT_GREATER_OR_EQUAL(m_sizeBytes, evictedSizeBytes, ());
+    m_sizeBytes -= evictedSizeBytes;
+    m_dfas.erase(jt);
+    m_keys.pop_front();
+  }
+
+  m_dfas.emplace(key, dfa);
+  m_keys.push_back(move(key));
+  m_sizeBytes += sizeBytes;
+  return dfa;
+}
+
+void LevenshteinDFACache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_dfas.clear();
+  m_keys.clear();
+  m_sizeBytes = 0;
+}
+
+size_t LevenshteinDFACache::GetSizeBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_sizeBytes;
+}
+
+size_t LevenshteinDFACache::GetNumEntries() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_dfas.size();
+}
+
+// static
+size_t LevenshteinDFACache::GetSizeBytes(strings::LevenshteinDFA const & dfa)
+{
+  // Transitions for every state and every letter of the alphabet dominate the size.
+  return dfa.GetNumStates() * (dfa.GetAlphabetSize() + 2) * sizeof(size_t);
+}
+}  // namespace search
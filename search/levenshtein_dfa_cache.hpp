@@ -0,0 +1,57 @@
+#pragma once
+
+#include "base/levenshtein_dfa.hpp"
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace search
+{
+// Thread-safe cache of DFAs built for tokens. A DFA is built much slower than it is matched,
+// and the same tokens are matched in consecutive queries, by categories and geocoder and in
+// ranking of results. The oldest DFAs are evicted when the cache exceeds its size limit.
+class LevenshteinDFACache
+{
+public:
+  using DFAPtr = std::shared_ptr<strings::LevenshteinDFA const>;
+  using Builder = std::function<strings::LevenshteinDFA(strings::UniString const & s,
+                                                        size_t maxErrors)>;
+
+  static size_t constexpr kDefaultMaxSizeBytes = 4 * 1024 * 1024;
+
+  explicit LevenshteinDFACache(Builder const & builder,
+                               size_t maxSizeBytes = kDefaultMaxSizeBytes);
+
+  // Returns a DFA for |s| with |maxErrors| errors. The DFA is built outside of the lock, so
+  // threads don't wait for each other while building DFAs for different tokens.
+  DFAPtr Get(strings::UniString const & s, size_t maxErrors);
+
+  void Clear();
+
+  size_t GetSizeBytes() const;
+  size_t GetNumEntries() const;
+
+private:
+  using Key = std::pair<strings::UniString, size_t>;
+
+  static size_t GetSizeBytes(strings::LevenshteinDFA const & dfa);
+
+  Builder const m_builder;
+  size_t const m_maxSizeBytes;
+
+  mutable std::mutex m_mutex;
+  std::map<Key, DFAPtr> m_dfas;
+  // Keys in order of insertion.
+  std::deque<Key> m_keys;
+  size_t m_sizeBytes = 0;
+
+  DISALLOW_COPY_AND_MOVE(LevenshteinDFACache);
+};
+}  // namespace search
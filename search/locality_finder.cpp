@@ -12,6 +12,7 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <vector>
 
 using namespace std;
@@ -57,11 +58,9 @@ private:
 class LocalitiesLoader
 {
 public:
-  LocalitiesLoader(MwmContext const & ctx, CitiesBoundariesTable const & boundaries,
-                   Filter const & filter, LocalityFinder::Holder & holder,
+  LocalitiesLoader(MwmContext const & ctx, Filter const & filter, LocalityFinder::Holder & holder,
                    map<MwmSet::MwmId, unordered_set<uint32_t>> & loadedIds)
     : m_ctx(ctx)
-    , m_boundaries(boundaries)
     , m_filter(filter)
     , m_holder(holder)
     , m_loadedIds(loadedIds[m_ctx.GetId()])
@@ -101,17 +100,14 @@ public:
     auto const names = ft.GetNames();
     auto const center = ft.GetCenter();
 
-    CitiesBoundariesTable::Boundaries boundaries;
-    auto const fid = ft.GetID();
-    m_boundaries.Get(fid, boundaries);
-
-    m_holder.Add(LocalityItem(names, center, boundaries, population, fid));
+    // Boundaries are not copied to items, LocalityFinder looks up cities containing
+    // a point in CitiesBoundariesTable instead.
+    m_holder.Add(LocalityItem(names, center, {} /* boundaries */, population, ft.GetID()));
     m_loadedIds.insert(id);
   }
 
 private:
   MwmContext const & m_ctx;
-  CitiesBoundariesTable const & m_boundaries;
   Filter const & m_filter;
 
   LocalityFinder::Holder & m_holder;
@@ -139,9 +135,16 @@ string DebugPrint(LocalityItem const & item)
 // LocalitySelector --------------------------------------------------------------------------------
 LocalitySelector::LocalitySelector(m2::PointD const & p) : m_p(p) {}
 
+LocalitySelector::LocalitySelector(m2::PointD const & p, MwmSet::MwmId const & citiesMwmId,
+                                   vector<uint32_t> && citiesWithPoint)
+  : m_p(p), m_citiesMwmId(citiesMwmId), m_citiesWithPoint(move(citiesWithPoint))
+{
+  ASSERT(is_sorted(m_citiesWithPoint.begin(), m_citiesWithPoint.end()), ());
+}
+
 void LocalitySelector::operator()(LocalityItem const & item)
 {
-  auto const inside = item.m_boundaries.HasPoint(m_p);
+  auto const inside = IsInside(item);
 
   // TODO (@y, @m): replace this naive score by p-values on
   // multivariate Gaussian.
@@ -163,6 +166,16 @@ void LocalitySelector::operator()(LocalityItem const & item)
   }
 }
 
+bool LocalitySelector::IsInside(LocalityItem const & item) const
+{
+  if (item.m_id.m_mwmId == m_citiesMwmId &&
+      binary_search(m_citiesWithPoint.begin(), m_citiesWithPoint.end(), item.m_id.m_index))
+  {
+    return true;
+  }
+  return item.m_boundaries.HasPoint(m_p);
+}
+
 // LocalityFinder::Holder --------------------------------------------------------------------------
 LocalityFinder::Holder::Holder(double radiusMeters) : m_radiusMeters(radiusMeters) {}
 
@@ -248,8 +261,7 @@ void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool lo
         m_ranks = make_unique<DummyRankTable>();
 
       MwmContext ctx(move(handle));
-      ctx.ForEachIndex(crect, LocalitiesLoader(ctx, m_boundariesTable, CityFilter(*m_ranks),
-                                               m_cities, m_loadedIds));
+      ctx.ForEachIndex(crect, LocalitiesLoader(ctx, CityFilter(*m_ranks), m_cities, m_loadedIds));
     }
 
     m_cities.SetCovered(p);
@@ -264,9 +276,8 @@ void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool lo
         return;
 
       MwmContext ctx(move(handle));
-      ctx.ForEachIndex(vrect,
-                       LocalitiesLoader(ctx, m_boundariesTable, VillageFilter(ctx, m_villagesCache),
-                                        m_villages, m_loadedIds));
+      ctx.ForEachIndex(vrect, LocalitiesLoader(ctx, VillageFilter(ctx, m_villagesCache),
+                                               m_villages, m_loadedIds));
     });
 
     m_villages.SetCovered(p);
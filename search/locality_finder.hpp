@@ -19,6 +19,7 @@
 #include <memory>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 class DataSource;
 
@@ -54,6 +55,11 @@ class LocalitySelector
 public:
   LocalitySelector(m2::PointD const & p);
 
+  // |citiesWithPoint| are sorted ids of cities of |citiesMwmId| whose boundaries
+  // contain |p|, boundaries of items of these cities are not checked.
+  LocalitySelector(m2::PointD const & p, MwmSet::MwmId const & citiesMwmId,
+                   std::vector<uint32_t> && citiesWithPoint);
+
   void operator()(LocalityItem const & item);
 
   template <typename Fn>
@@ -66,7 +72,11 @@ public:
   }
 
 private:
+  bool IsInside(LocalityItem const & item) const;
+
   m2::PointD const m_p;
+  MwmSet::MwmId const m_citiesMwmId;
+  std::vector<uint32_t> const m_citiesWithPoint;
 
   bool m_inside = false;
   double m_score = std::numeric_limits<double>::max();
@@ -112,7 +122,10 @@ public:
     LoadVicinity(p, !m_cities.IsCovered(crect) /* loadCities */,
                  !m_villages.IsCovered(vrect) /* loadVillages */);
 
-    LocalitySelector selector(p);
+    std::vector<uint32_t> citiesWithPoint;
+    m_boundariesTable.GetCitiesWithPoint(p, citiesWithPoint);
+
+    LocalitySelector selector(p, m_boundariesTable.GetMwmId(), std::move(citiesWithPoint));
     m_cities.ForEachInVicinity(crect, selector);
     m_villages.ForEachInVicinity(vrect, selector);
 
@@ -45,7 +45,11 @@ public:
 class IsPoiChecker
 {
 public:
-  IsPoiChecker() {}
+  IsPoiChecker()
+    : m_oneLevel(BaseChecker::MakeIndexed(OneLevelPOIChecker()))
+    , m_twoLevel(BaseChecker::MakeIndexed(TwoLevelPOIChecker()))
+  {
+  }
 
   static IsPoiChecker const & Instance()
   {
@@ -53,7 +57,10 @@ public:
     return inst;
   }
 
-  bool operator()(FeatureType & ft) const { return m_oneLevel(ft) || m_twoLevel(ft); }
+  bool operator()(TypeIndices const & types) const
+  {
+    return m_oneLevel(types) || m_twoLevel(types);
+  }
 
 private:
   OneLevelPOIChecker const m_oneLevel;
@@ -69,9 +76,9 @@ public:
     return inst;
   }
 
-  bool operator()(FeatureType & ft) const
+  bool operator()(FeatureType & ft, TypeIndices const & types) const
   {
-    return !ft.GetHouseNumber().empty() || IsBuildingChecker::Instance()(ft);
+    return !ft.GetHouseNumber().empty() || IsBuildingChecker::Instance()(types);
   }
 
 private:
@@ -86,19 +93,22 @@ Model::Type Model::GetType(FeatureType & feature) const
   static auto const & localityChecker = IsLocalityChecker::Instance();
   static auto const & poiChecker = IsPoiChecker::Instance();
 
+  feature::TypesHolder const types(feature);
+  TypeIndices const indices(types);
+
   // Check whether object is POI first to mark POIs with address tags as POI.
-  if (poiChecker(feature))
+  if (poiChecker(indices))
     return TYPE_POI;
 
-  if (buildingChecker(feature))
+  if (buildingChecker(feature, indices))
     return TYPE_BUILDING;
 
-  if (streetChecker(feature))
+  if (streetChecker(indices))
     return TYPE_STREET;
 
-  if (localityChecker(feature))
+  if (localityChecker(indices))
   {
-    auto const type = localityChecker.GetType(feature);
+    auto const type = localityChecker.GetType(types);
     switch (type)
     {
     case NONE: ASSERT(false, ("Unknown locality.")); return TYPE_UNCLASSIFIED;
@@ -113,17 +113,15 @@ private:
   void ForEachIndexImpl(covering::Intervals const & intervals, uint32_t scale, TFn && fn) const
   {
     CheckUniqueIndexes checkUnique(m_value.GetHeader().GetFormat() >= version::Format::v5);
-    for (auto const & i : intervals)
-      m_index.ForEachInIntervalAndScale(i.first, i.second, scale,
-          [&](uint32_t index)
-          {
-            if (checkUnique(index))
-              fn(index);
-          });
+    m_index.ForEachInIntervalsAndScale(intervals.begin(), intervals.end(), scale,
+                                       [&](uint32_t index) {
+                                         if (checkUnique(index))
+                                           fn(index);
+                                       });
   }
 
   FeaturesVector m_vector;
-  ScaleIndex<ModelReaderPtr> m_index;
+  ScaleIndex<ModelReaderPtr> const & m_index;
   unique_ptr<HouseToStreetTable> m_houseToStreetTable;
   LazyCentersTable m_centers;
 
@@ -0,0 +1,130 @@
+#include "search/mwm_search_data.hpp"
+
+#include "search/dummy_rank_table.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "defines.hpp"
+
+#include <utility>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+// Mwms marked to deregister are still alive, but their handles must be released.
+bool IsRegistered(MwmSet::MwmId const & id)
+{
+  return id.IsAlive() && id.GetInfo()->GetStatus() == MwmInfo::STATUS_REGISTERED;
+}
+
+unique_ptr<RankTable> LoadRankTable(MwmValue const & value, string const & tag)
+{
+  auto table = RankTable::Load(value.m_cont, tag);
+  if (!table)
+    table = make_unique<DummyRankTable>();
+  return table;
+}
+}  // namespace
+
+// MwmSearchData -----------------------------------------------------------------------------------
+MwmSearchData::MwmSearchData(MwmSet::MwmHandle && handle)
+  : m_handle(move(handle))
+  , m_ranks(LoadRankTable(*m_handle.GetValue<MwmValue>(), SEARCH_RANKS_FILE_TAG))
+  , m_popularity(LoadRankTable(*m_handle.GetValue<MwmValue>(), POPULARITY_RANKS_FILE_TAG))
+  , m_centers(*m_handle.GetValue<MwmValue>())
+{
+}
+
+bool MwmSearchData::GetCenter(uint32_t id, m2::PointD & center) const
+{
+  lock_guard<mutex> lock(m_centersMutex);
+  return m_centers.Get(id, center);
+}
+
+// MwmSearchDataCache ------------------------------------------------------------------------------
+MwmSearchDataCache::MwmSearchDataCache(DataSource const & dataSource)
+  : m_dataSource(dataSource), m_citiesBoundaries(dataSource)
+{
+}
+
+shared_ptr<MwmSearchData const> MwmSearchDataCache::Get(MwmSet::MwmId const & id)
+{
+  bool const registered = IsRegistered(id);
+
+  Entries stale;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (registered)
+    {
+      auto const it = m_entries.find(id);
+      if (it != m_entries.end())
+        return it->second;
+    }
+    TakeStaleEntries(stale);
+  }
+
+  if (!registered)
+    return {};
+
+  auto handle = m_dataSource.GetMwmHandleById(id);
+  if (!handle.IsAlive())
+    return {};
+
+  auto data = make_shared<MwmSearchData const>(move(handle));
+
+  // Another thread may have loaded the same mwm in the meantime. Then |data| is
+  // destroyed out of the lock.
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.emplace(id, data).first->second;
+}
+
+bool MwmSearchDataCache::LoadCitiesBoundaries(CitiesBoundariesTable & table)
+{
+  lock_guard<mutex> lock(m_citiesBoundariesMutex);
+  if (!m_citiesBoundaries.Load())
+    return false;
+  table.ShareWith(m_citiesBoundaries);
+  return true;
+}
+
+void MwmSearchDataCache::Clear()
+{
+  Entries entries;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    entries.swap(m_entries);
+  }
+}
+
+void MwmSearchDataCache::OnMapUpdated(platform::LocalCountryFile const & /* newFile */,
+                                      platform::LocalCountryFile const & /* oldFile */)
+{
+  Entries stale;
+  lock_guard<mutex> lock(m_mutex);
+  TakeStaleEntries(stale);
+}
+
+void MwmSearchDataCache::OnMapDeregistered(platform::LocalCountryFile const & /* localFile */)
+{
+  Entries stale;
+  lock_guard<mutex> lock(m_mutex);
+  TakeStaleEntries(stale);
+}
+
+void MwmSearchDataCache::TakeStaleEntries(Entries & stale)
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (IsRegistered(it->first))
+    {
+      ++it;
+      continue;
+    }
+    stale.insert(*it);
+    it = m_entries.erase(it);
+  }
+}
+}  // namespace search
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "search/cities_boundaries_table.hpp"
+#include "search/lazy_centers_table.hpp"
+
+#include "indexer/mwm_set.hpp"
+#include "indexer/rank_table.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+class DataSource;
+
+namespace search
+{
+// Immutable search data of an mwm: search ranks, popularity ranks and centers of features.
+// An instance holds a handle to the mwm, so the data may be used by several threads at once
+// while a user holds a pointer to the instance.
+class MwmSearchData
+{
+public:
+  explicit MwmSearchData(MwmSet::MwmHandle && handle);
+
+  MwmSet::MwmId const & GetId() const { return m_handle.GetId(); }
+
+  RankTable const & GetRanks() const { return *m_ranks; }
+  RankTable const & GetPopularity() const { return *m_popularity; }
+
+  // Centers table is decoded lazily, so this method takes a lock.
+  WARN_UNUSED_RESULT bool GetCenter(uint32_t id, m2::PointD & center) const;
+
+private:
+  MwmSet::MwmHandle m_handle;
+  std::unique_ptr<RankTable> m_ranks;
+  std::unique_ptr<RankTable> m_popularity;
+
+  mutable std::mutex m_centersMutex;
+  mutable LazyCentersTable m_centers;
+
+  DISALLOW_COPY_AND_MOVE(MwmSearchData);
+};
+
+// Thread-safe registry of search data shared by all processors of an engine, so rank tables
+// and cities boundaries are loaded once instead of once per search thread.
+//
+// The registry keeps handles of mwms, therefore data of mwms which are updated or
+// deregistered is dropped on MwmSet events, on the next Get() and on Clear().
+class MwmSearchDataCache : public MwmSet::Observer
+{
+public:
+  explicit MwmSearchDataCache(DataSource const & dataSource);
+
+  // Returns search data of the mwm or nullptr if the mwm is not registered.
+  std::shared_ptr<MwmSearchData const> Get(MwmSet::MwmId const & id);
+
+  // Makes |table| share cities boundaries of the World map, which are loaded on the first
+  // call and reloaded when the World map is changed. Returns false if boundaries can't
+  // be loaded.
+  bool LoadCitiesBoundaries(CitiesBoundariesTable & table);
+
+  void Clear();
+
+  // MwmSet::Observer overrides:
+  void OnMapUpdated(platform::LocalCountryFile const & newFile,
+                    platform::LocalCountryFile const & oldFile) override;
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
+private:
+  using Entries = std::map<MwmSet::MwmId, std::shared_ptr<MwmSearchData const>>;
+
+  // Moves entries of mwms which are not registered anymore to |stale|. Handles must be
+  // released out of |m_mutex| because MwmSet may notify observers on release.
+  void TakeStaleEntries(Entries & stale);
+
+  DataSource const & m_dataSource;
+
+  std::mutex m_mutex;
+  Entries m_entries;
+
+  std::mutex m_citiesBoundariesMutex;
+  CitiesBoundariesTable m_citiesBoundaries;
+
+  DISALLOW_COPY_AND_MOVE(MwmSearchDataCache);
+};
+}  // namespace search
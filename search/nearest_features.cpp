@@ -0,0 +1,220 @@
+#include "search/nearest_features.hpp"
+
+#include "search/cancel_exception.hpp"
+#include "search/categories_cache.hpp"
+#include "search/cbv.hpp"
+#include "search/mwm_context.hpp"
+
+#include "indexer/cell_id.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/feature_covering.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+#include <utility>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+using Converter = CellIdConverter<MercatorBounds, RectId>;
+
+double SquaredDistance(m2::PointD const & pivot, m2::RectD const & rect)
+{
+  double const dx = max(max(rect.minX() - pivot.x, pivot.x - rect.maxX()), 0.0);
+  double const dy = max(max(rect.minY() - pivot.y, pivot.y - rect.maxY()), 0.0);
+  return dx * dx + dy * dy;
+}
+
+m2::RectD GetCellRect(RectId const & cell)
+{
+  double minX, minY, maxX, maxY;
+  Converter::GetCellBounds(cell, minX, minY, maxX, maxY);
+  return m2::RectD(minX, minY, maxX, maxY);
+}
+
+struct Mwm
+{
+  explicit Mwm(shared_ptr<MwmInfo> info) : m_info(move(info)) {}
+
+  shared_ptr<MwmInfo> m_info;
+  unique_ptr<MwmContext> m_context;
+  CBV m_features;
+  uint32_t m_scale = 0;
+  int m_cellDepth = 0;
+  int m_leafLevel = 0;
+  // A feature may be in several cells.
+  unordered_set<uint32_t> m_visited;
+};
+
+// An mwm, a cell of an mwm or a feature. The queue keeps the lower bounds of the distances
+// for the mwms and the cells and the exact distances for the features.
+struct Entry
+{
+  // The features go first among the entries at the same distance.
+  enum class Type
+  {
+    Feature,
+    Cell,
+    Mwm
+  };
+
+  bool operator>(Entry const & rhs) const
+  {
+    if (m_squaredDistance != rhs.m_squaredDistance)
+      return m_squaredDistance > rhs.m_squaredDistance;
+    return m_type > rhs.m_type;
+  }
+
+  double m_squaredDistance = 0.0;
+  Type m_type = Type::Feature;
+  size_t m_mwm = 0;
+  RectId m_cell = RectId::Root();
+  uint32_t m_featureId = 0;
+  m2::PointD m_center;
+};
+}  // namespace
+
+// NearestFeaturesFinder ---------------------------------------------------------------------------
+// static
+int constexpr NearestFeaturesFinder::kLeafCellLevel;
+
+NearestFeaturesFinder::NearestFeaturesFinder(DataSource const & dataSource,
+                                             CategoriesCache & categories,
+                                             base::Cancellable const & cancellable)
+  : m_dataSource(dataSource), m_categories(categories), m_cancellable(cancellable)
+{
+}
+
+vector<NearestFeaturesFinder::Result> NearestFeaturesFinder::Find(
+    vector<shared_ptr<MwmInfo>> const & infos, m2::PointD const & pivot, size_t k)
+{
+  vector<Result> results;
+  if (k == 0)
+    return results;
+
+  vector<Mwm> mwms;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> queue;
+
+  for (auto const & info : infos)
+  {
+    Entry entry;
+    entry.m_squaredDistance = SquaredDistance(pivot, info->m_bordersRect);
+    entry.m_type = Entry::Type::Mwm;
+    entry.m_mwm = mwms.size();
+    queue.push(entry);
+    mwms.emplace_back(info);
+  }
+
+  auto const pushCell = [&](size_t mwmIdx, RectId const & cell) {
+    Entry entry;
+    entry.m_squaredDistance = SquaredDistance(pivot, GetCellRect(cell));
+    entry.m_type = Entry::Type::Cell;
+    entry.m_mwm = mwmIdx;
+    entry.m_cell = cell;
+    queue.push(entry);
+  };
+
+  // Reads the features of the cell if |subtree| is false and of the cell with all its
+  // descendants otherwise.
+  auto const readCell = [&](size_t mwmIdx, RectId const & cell, bool subtree) {
+    auto & mwm = mwms[mwmIdx];
+    int64_t const begin = cell.ToInt64(mwm.m_cellDepth);
+    int64_t const end =
+        subtree ? begin + static_cast<int64_t>(cell.SubTreeSize(mwm.m_cellDepth)) : begin + 1;
+    covering::Intervals const intervals = {{begin, end}};
+
+    mwm.m_context->ForEachIndex(intervals, mwm.m_scale, [&](uint32_t featureId) {
+      if (!mwm.m_features.HasBit(featureId) || !mwm.m_visited.insert(featureId).second)
+        return;
+
+      Entry entry;
+      if (!mwm.m_context->GetCenter(featureId, entry.m_center))
+      {
+        FeatureType ft;
+        if (!mwm.m_context->GetFeature(featureId, ft))
+          return;
+        entry.m_center = feature::GetCenter(ft);
+      }
+      entry.m_squaredDistance = (entry.m_center - pivot).SquaredLength();
+      entry.m_type = Entry::Type::Feature;
+      entry.m_mwm = mwmIdx;
+      entry.m_featureId = featureId;
+      queue.push(entry);
+    });
+  };
+
+  // Opens the mwm and puts the cell which covers its borders to the queue. Features of
+  // the ancestors of the cell are large, they are read at once.
+  auto const openMwm = [&](size_t mwmIdx) {
+    auto & mwm = mwms[mwmIdx];
+    auto handle = m_dataSource.GetMwmHandleById(MwmSet::MwmId(mwm.m_info));
+    if (!handle.IsAlive() || !handle.GetValue<MwmValue>()->HasSearchIndex())
+      return;
+
+    mwm.m_context = make_unique<MwmContext>(move(handle));
+    mwm.m_features = m_categories.Get(*mwm.m_context);
+    if (mwm.m_features.IsEmpty())
+      return;
+
+    mwm.m_scale = static_cast<uint32_t>(mwm.m_context->m_value.GetHeader().GetLastScale());
+    mwm.m_cellDepth =
+        covering::GetCodingDepth<RectId::DEPTH_LEVELS>(static_cast<int>(mwm.m_scale));
+    mwm.m_leafLevel = min(kLeafCellLevel, mwm.m_cellDepth - 1);
+
+    auto cell = covering::GetRectIdAsIs<RectId::DEPTH_LEVELS>(mwm.m_info->m_bordersRect);
+    while (cell.Level() > mwm.m_leafLevel)
+      cell = cell.Parent();
+    pushCell(mwmIdx, cell);
+
+    for (auto ancestor = cell; ancestor.Level() > 0;)
+    {
+      ancestor = ancestor.Parent();
+      readCell(mwmIdx, ancestor, false /* subtree */);
+    }
+  };
+
+  while (!queue.empty() && results.size() < k)
+  {
+    BailIfCancelled(m_cancellable);
+
+    Entry const entry = queue.top();
+    queue.pop();
+
+    switch (entry.m_type)
+    {
+    case Entry::Type::Feature:
+      results.emplace_back(FeatureID(mwms[entry.m_mwm].m_context->GetId(), entry.m_featureId),
+                           entry.m_center, sqrt(entry.m_squaredDistance));
+      break;
+    case Entry::Type::Cell:
+    {
+      auto const & cell = entry.m_cell;
+      if (cell.Level() == mwms[entry.m_mwm].m_leafLevel)
+      {
+        readCell(entry.m_mwm, cell, true /* subtree */);
+        break;
+      }
+
+      readCell(entry.m_mwm, cell, false /* subtree */);
+      for (int8_t i = 0; i < 4; ++i)
+        pushCell(entry.m_mwm, cell.Child(i));
+      break;
+    }
+    case Entry::Type::Mwm: openMwm(entry.m_mwm); break;
+    }
+  }
+
+  return results;
+}
+}  // namespace search
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class DataSource;
+class MwmInfo;
+
+namespace search
+{
+class CategoriesCache;
+
+// Finds k features of the categories which are nearest to a pivot, e.g. the nearest fuel
+// stations or ATMs.
+//
+// Unlike the categorial search of Geocoder which retrieves all the features of the categories
+// in the pivot rect and ranks them by distance afterwards, the cells of the scale index are
+// visited best-first in the order of their distance from the pivot. The features of a cell are
+// filtered by the category postings of the search index and are put to the same queue by
+// the distance to their centers from the centers table. A feature is taken from the queue
+// only when no cell is nearer than it, so the search stops as soon as k features are taken.
+//
+// The distances are mercator ones between the pivot and the feature centers. The centers
+// of the point features are within the cells of the features, for the areas and lines
+// the order is exact up to the size of the feature.
+class NearestFeaturesFinder
+{
+public:
+  struct Result
+  {
+    Result() = default;
+    Result(FeatureID const & id, m2::PointD const & center, double distance)
+      : m_id(id), m_center(center), m_distance(distance)
+    {
+    }
+
+    FeatureID m_id;
+    m2::PointD m_center;
+    double m_distance = 0.0;
+  };
+
+  // Features of the cells of this level are read at once, without further descent.
+  static int constexpr kLeafCellLevel = 14;
+
+  NearestFeaturesFinder(DataSource const & dataSource, CategoriesCache & categories,
+                        base::Cancellable const & cancellable);
+
+  // Returns at most |k| features of the mwms from |infos| sorted by the distance from |pivot|.
+  // The mwms are opened only when they are nearer than the found features.
+  // Throws CancelException if the search is cancelled.
+  std::vector<Result> Find(std::vector<std::shared_ptr<MwmInfo>> const & infos,
+                           m2::PointD const & pivot, size_t k);
+
+private:
+  DataSource const & m_dataSource;
+  CategoriesCache & m_categories;
+  base::Cancellable const & m_cancellable;
+
+  DISALLOW_COPY_AND_MOVE(NearestFeaturesFinder);
+};
+}  // namespace search
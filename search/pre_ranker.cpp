@@ -1,22 +1,21 @@
 #include "search/pre_ranker.hpp"
 
-#include "search/dummy_rank_table.hpp"
-#include "search/lazy_centers_table.hpp"
+#include "search/mwm_search_data.hpp"
 #include "search/pre_ranking_info.hpp"
 
-#include "indexer/data_source.hpp"
 #include "indexer/mwm_set.hpp"
-#include "indexer/rank_table.hpp"
 #include "indexer/scales.hpp"
 
 #include "geometry/mercator.hpp"
 #include "geometry/nearby_points_sweeper.hpp"
 
+#include "base/arena.hpp"
 #include "base/random.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <iterator>
 #include <set>
+#include <vector>
 
 using namespace std;
 
@@ -47,8 +46,9 @@ void SweepNearbyResults(double eps, set<FeatureID> const & prevEmit, vector<PreR
 }
 }  // namespace
 
-PreRanker::PreRanker(DataSource const & dataSource, Ranker & ranker)
-  : m_dataSource(dataSource), m_ranker(ranker), m_pivotFeatures(dataSource)
+PreRanker::PreRanker(DataSource const & dataSource, MwmSearchDataCache & searchData,
+                     Ranker & ranker)
+  : m_searchData(searchData), m_ranker(ranker), m_pivotFeatures(dataSource)
 {
 }
 
@@ -71,10 +71,11 @@ void PreRanker::Finish(bool cancelled)
 void PreRanker::FillMissingFieldsInPreResults()
 {
   MwmSet::MwmId mwmId;
-  MwmSet::MwmHandle mwmHandle;
-  unique_ptr<RankTable> ranks = make_unique<DummyRankTable>();
-  unique_ptr<RankTable> popularityRanks = make_unique<DummyRankTable>();
-  unique_ptr<LazyCentersTable> centers;
+  shared_ptr<MwmSearchData const> data;
+
+  // Distances to the loaded centers are computed by a batch after the loop.
+  vector<m2::PointD> loadedCenters;
+  vector<PreRankingInfo *> loadedInfos;
 
   m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
 
@@ -84,38 +85,34 @@ void PreRanker::FillMissingFieldsInPreResults()
     if (id.m_mwmId != mwmId)
     {
       mwmId = id.m_mwmId;
-      mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
-      ranks.reset();
-      centers.reset();
-      if (mwmHandle.IsAlive())
-      {
-        ranks = RankTable::Load(mwmHandle.GetValue<MwmValue>()->m_cont, SEARCH_RANKS_FILE_TAG);
-        popularityRanks = RankTable::Load(mwmHandle.GetValue<MwmValue>()->m_cont,
-                                          POPULARITY_RANKS_FILE_TAG);
-        centers = make_unique<LazyCentersTable>(*mwmHandle.GetValue<MwmValue>());
-      }
-      if (!ranks)
-        ranks = make_unique<DummyRankTable>();
-      if (!popularityRanks)
-        popularityRanks = make_unique<DummyRankTable>();
+      data = m_searchData.Get(mwmId);
     }
 
-    info.m_rank = ranks->Get(id.m_index);
-    info.m_popularity = popularityRanks->Get(id.m_index);
+    if (data)
+    {
+      info.m_rank = data->GetRanks().Get(id.m_index);
+      info.m_popularity = data->GetPopularity().Get(id.m_index);
+    }
 
     m2::PointD center;
-    if (centers && centers->Get(id.m_index, center))
+    if (data && data->GetCenter(id.m_index, center))
     {
-      info.m_distanceToPivot =
-          MercatorBounds::DistanceOnEarth(m_params.m_accuratePivotCenter, center);
       info.m_center = center;
       info.m_centerLoaded = true;
+      loadedCenters.push_back(center);
+      loadedInfos.push_back(&info);
     }
     else
     {
       info.m_distanceToPivot = m_pivotFeatures.GetDistanceToFeatureMeters(id);
     }
   });
+
+  vector<double> distances(loadedCenters.size());
+  MercatorBounds::DistanceOnEarth(m_params.m_accuratePivotCenter, loadedCenters.data(),
+                                  loadedCenters.size(), distances.data());
+  for (size_t i = 0; i < loadedInfos.size(); ++i)
+    loadedInfos[i]->m_distanceToPivot = distances[i];
 }
 
 void PreRanker::Filter(bool viewportSearch)
@@ -221,6 +218,8 @@ void PreRanker::Filter(bool viewportSearch)
 
 void PreRanker::UpdateResults(bool lastUpdate)
 {
+  SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::PreRanking);
+
   FillMissingFieldsInPreResults();
   Filter(m_params.m_viewportSearch);
   m_numSentResults += m_results.size();
@@ -258,7 +257,8 @@ void PreRanker::FilterForViewportSearch()
   size_t const kNumXSlots = 5;
   size_t const kNumYSlots = 5;
   size_t const kNumBuckets = kNumXSlots * kNumYSlots;
-  vector<size_t> buckets[kNumBuckets];
+  base::Arena::Scope scratch;
+  base::ArenaVector<size_t> buckets[kNumBuckets];
 
   double const sizeX = viewport.SizeX();
   double const sizeY = viewport.SizeY();
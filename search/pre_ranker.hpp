@@ -3,6 +3,7 @@
 #include "search/intermediate_result.hpp"
 #include "search/nested_rects_cache.hpp"
 #include "search/ranker.hpp"
+#include "search/search_stats.hpp"
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
@@ -20,6 +21,8 @@ class DataSource;
 
 namespace search
 {
+class MwmSearchDataCache;
+
 // Fast and simple pre-ranker for search results.
 class PreRanker
 {
@@ -51,9 +54,12 @@ public:
 
     bool m_viewportSearch = false;
     bool m_categorialRequest = false;
+
+    // Not owned, may be nullptr.
+    SearchStats * m_stats = nullptr;
   };
 
-  PreRanker(DataSource const & dataSource, Ranker & ranker);
+  PreRanker(DataSource const & dataSource, MwmSearchDataCache & searchData, Ranker & ranker);
 
   void Init(Params const & params);
 
@@ -92,7 +98,7 @@ public:
 private:
   void FilterForViewportSearch();
 
-  DataSource const & m_dataSource;
+  MwmSearchDataCache & m_searchData;
   Ranker & m_ranker;
   vector<PreRankerResult> m_results;
   Params m_params;
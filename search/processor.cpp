@@ -12,6 +12,7 @@
 #include "search/ranking_info.hpp"
 #include "search/ranking_utils.hpp"
 #include "search/search_index_values.hpp"
+#include "search/short_prefix_table.hpp"
 #include "search/utils.hpp"
 
 #include "storage/country_info_getter.hpp"
@@ -50,6 +51,7 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 #include "3party/Alohalytics/src/alohalytics.h"
 #include "3party/open-location-code/openlocationcode.h"
@@ -144,17 +146,22 @@ double const Processor::kMaxViewportRadiusM = 50.0 * 1000;
 
 Processor::Processor(DataSource const & dataSource, CategoriesHolder const & categories,
                      vector<Suggest> const & suggests,
-                     storage::CountryInfoGetter const & infoGetter)
+                     storage::CountryInfoGetter const & infoGetter,
+                     RetrievalCache & retrievalCache, StreetVicinityCache & streetVicinityCache,
+                     MwmSearchDataCache & searchData, SearchStats & stats)
   : m_categories(categories)
   , m_infoGetter(infoGetter)
+  , m_searchData(searchData)
+  , m_stats(stats)
   , m_position(0, 0)
   , m_villagesCache(static_cast<base::Cancellable const &>(*this))
   , m_citiesBoundaries(dataSource)
   , m_keywordsScorer(LanguageTier::LANGUAGE_TIER_COUNT)
   , m_ranker(dataSource, m_citiesBoundaries, infoGetter, m_keywordsScorer, m_emitter, categories,
              suggests, m_villagesCache, static_cast<base::Cancellable const &>(*this))
-  , m_preRanker(dataSource, m_ranker)
+  , m_preRanker(dataSource, searchData, m_ranker)
   , m_geocoder(dataSource, infoGetter, categories, m_citiesBoundaries, m_preRanker, m_villagesCache,
+               retrievalCache, streetVicinityCache, searchData,
                static_cast<base::Cancellable const &>(*this))
   , m_bookmarksProcessor(m_emitter, static_cast<base::Cancellable const &>(*this))
 {
@@ -327,7 +334,7 @@ m2::RectD const & Processor::GetViewport() const
 
 void Processor::LoadCitiesBoundaries()
 {
-  if (m_citiesBoundaries.Load())
+  if (m_searchData.LoadCitiesBoundaries(m_citiesBoundaries))
     LOG(LINFO, ("Loaded cities boundaries"));
   else
     LOG(LWARNING, ("Can't load cities boundaries"));
@@ -401,6 +408,8 @@ void Processor::Search(SearchParams const & params)
     return;
   }
 
+  SearchStats::ScopedTimer timer(&m_stats, SearchStats::Stage::Total);
+
   bool const viewportSearch = params.m_mode == Mode::Viewport;
 
   auto const & viewport = params.m_viewport;
@@ -442,7 +451,7 @@ void Processor::Search(SearchParams const & params)
         m_geocoder.GoEverywhere();
       }
       break;
-    case Mode::Bookmarks: SearchBookmarks(); break;
+    case Mode::Bookmarks: SearchBookmarks(params.m_maxNumResults); break;
     case Mode::Count: ASSERT(false, ("Invalid mode")); break;
     }
   }
@@ -454,6 +463,8 @@ void Processor::Search(SearchParams const & params)
   if (!viewportSearch && !IsCancelled())
     SendStatistics(params, viewport, m_emitter.GetResults());
 
+  m_stats.Add(SearchStats::Counter::EmittedResults, m_emitter.GetResults().GetCount());
+
   // Emit finish marker to client.
   m_geocoder.Finish(IsCancelled());
 }
@@ -498,11 +509,11 @@ void Processor::SearchPlusCode()
   m_emitter.Emit();
 }
 
-void Processor::SearchBookmarks() const
+void Processor::SearchBookmarks(size_t limit) const
 {
   QueryParams params;
   InitParams(params);
-  m_bookmarksProcessor.Search(params);
+  m_bookmarksProcessor.Search(params, limit);
 }
 
 void Processor::InitParams(QueryParams & params) const
@@ -565,6 +576,16 @@ void Processor::InitGeocoder(Geocoder::Params & geocoderParams, SearchParams con
   geocoderParams.m_cuisineTypes = m_cuisineTypes;
   geocoderParams.m_preferredTypes = m_preferredTypes;
   geocoderParams.m_tracer = searchParams.m_tracer;
+  geocoderParams.m_numThreads = searchParams.m_numGeocoderThreads;
+  geocoderParams.m_updateResultsPerMwm = searchParams.m_streamResults;
+  geocoderParams.m_stats = &m_stats;
+  // A single short prefix matches too many features of every mwm, so only the best ranked
+  // ones are taken. It's not done in the viewport where all matched features are shown.
+  geocoderParams.m_useShortPrefixTables = searchParams.m_mode == Mode::Everywhere &&
+                                          m_tokens.empty() &&
+                                          ShortPrefixTable::IsShortPrefix(m_prefix);
+  if (searchParams.m_timeout != SearchParams::TimeDuration::max())
+    geocoderParams.m_deadline = chrono::steady_clock::now() + searchParams.m_timeout;
 
   m_geocoder.SetParams(geocoderParams);
 }
@@ -586,6 +607,7 @@ void Processor::InitPreRanker(Geocoder::Params const & geocoderParams,
   params.m_limit = max(kPreResultsCount, searchParams.m_maxNumResults);
   params.m_viewportSearch = viewportSearch;
   params.m_categorialRequest = geocoderParams.IsCategorialRequest();
+  params.m_stats = &m_stats;
 
   m_preRanker.Init(params);
 }
@@ -615,6 +637,7 @@ void Processor::InitRanker(Geocoder::Params const & geocoderParams,
   params.m_categoryLocales = GetCategoryLocales();
   params.m_accuratePivotCenter = GetPivotPoint(viewportSearch);
   params.m_viewportSearch = viewportSearch;
+  params.m_stats = &m_stats;
 
   m_ranker.Init(params, geocoderParams);
 }
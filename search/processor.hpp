@@ -8,11 +8,15 @@
 #include "search/common.hpp"
 #include "search/emitter.hpp"
 #include "search/geocoder.hpp"
+#include "search/mwm_search_data.hpp"
 #include "search/pre_ranker.hpp"
 #include "search/rank_table_cache.hpp"
 #include "search/ranker.hpp"
+#include "search/retrieval_cache.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
 #include "search/search_trie.hpp"
+#include "search/street_vicinity_cache.hpp"
 #include "search/suggest.hpp"
 #include "search/token_slice.hpp"
 #include "search/utils.hpp"
@@ -63,7 +67,9 @@ public:
   static double const kMaxViewportRadiusM;
 
   Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter);
+            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter,
+            RetrievalCache & retrievalCache, StreetVicinityCache & streetVicinityCache,
+            MwmSearchDataCache & searchData, SearchStats & stats);
 
   void SetViewport(m2::RectD const & viewport);
   void SetPreferredLocale(std::string const & locale);
@@ -82,7 +88,7 @@ public:
   // Tries to parse a plus code from |m_query| and generate a (lat, lon) result.
   void SearchPlusCode();
 
-  void SearchBookmarks() const;
+  void SearchBookmarks(size_t limit) const;
 
   void InitParams(QueryParams & params) const;
 
@@ -117,6 +123,8 @@ protected:
 
   CategoriesHolder const & m_categories;
   storage::CountryInfoGetter const & m_infoGetter;
+  MwmSearchDataCache & m_searchData;
+  SearchStats & m_stats;
 
   std::string m_region;
   std::string m_query;
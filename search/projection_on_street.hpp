@@ -37,6 +37,12 @@ public:
   // |proj|.
   bool GetProjection(m2::PointD const & point, ProjectionOnStreet & proj) const;
 
+  // Returns an estimate of the memory taken by the calculator.
+  size_t GetSizeBytes() const
+  {
+    return sizeof(*this) + m_segments.capacity() * sizeof(m2::ParametrizedSegment<m2::PointD>);
+  }
+
 private:
   vector<m2::ParametrizedSegment<m2::PointD>> m_segments;
 };
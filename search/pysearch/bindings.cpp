@@ -20,11 +20,15 @@
 
 #include "base/assert.hpp"
 
+#include "pyhelpers/batch.hpp"
+
 #include <boost/python.hpp>
 
+#include <condition_variable>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -184,6 +188,11 @@ unique_ptr<storage::CountryInfoGetter> CreateCountryInfoGetter()
 struct Context
 {
   Context() : m_engine(m_dataSource, CreateCountryInfoGetter(), search::Engine::Params{}) {}
+  explicit Context(size_t numThreads)
+    : m_engine(m_dataSource, CreateCountryInfoGetter(),
+               search::Engine::Params("en" /* locale */, numThreads))
+  {
+  }
   // todo(@pimenov) Choose right type for 'm_dataSource'.
   FrozenDataSource m_dataSource;
   search::tests_support::TestSearchEngine m_engine;
@@ -191,7 +200,15 @@ struct Context
 
 struct SearchEngineProxy
 {
-  SearchEngineProxy() : m_context(make_shared<Context>())
+  SearchEngineProxy() : m_context(make_shared<Context>()) { RegisterMaps(); }
+
+  // |numThreads| search threads process the queries of QueryBatch().
+  explicit SearchEngineProxy(size_t numThreads) : m_context(make_shared<Context>(numThreads))
+  {
+    RegisterMaps();
+  }
+
+  void RegisterMaps()
   {
     vector<platform::LocalCountryFile> mwms;
     platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
@@ -231,6 +248,49 @@ struct SearchEngineProxy
     return results;
   }
 
+  // Runs |queries| on all the search threads and returns the list of results for every query.
+  // The GIL is released while the queries run. Results are localized to the locale of the first
+  // query.
+  boost::python::list QueryBatch(boost::python::list const & queries) const
+  {
+    vector<search::SearchParams> batch;
+    for (size_t i = 0; i < boost::python::len(queries); ++i)
+    {
+      Params const & params = boost::python::extract<Params const &>(queries[i]);
+      batch.push_back(MakeSearchParams(params));
+    }
+
+    vector<vector<search::Result>> batchResults(batch.size());
+    if (!batch.empty())
+    {
+      gil_release release;
+      m_context->m_engine.SetLocale(batch.front().m_inputLocale);
+
+      mutex mu;
+      condition_variable cv;
+      size_t finished = 0;
+      m_context->m_engine.SearchBatch(batch, [&](size_t i, search::Results const & results) {
+        lock_guard<mutex> lock(mu);
+        batchResults[i].assign(results.begin(), results.end());
+        ++finished;
+        cv.notify_one();
+      });
+
+      unique_lock<mutex> lock(mu);
+      cv.wait(lock, [&]() { return finished == batch.size(); });
+    }
+
+    boost::python::list results;
+    for (auto const & queryResults : batchResults)
+    {
+      boost::python::list rs;
+      for (auto const & result : queryResults)
+        rs.append(Result(result));
+      results.append(rs);
+    }
+    return results;
+  }
+
   boost::python::list Trace(Params const &params) const
   {
     m_context->m_engine.SetLocale(params.m_locale);
@@ -301,6 +361,8 @@ BOOST_PYTHON_MODULE(pysearch)
       .def("__repr__", &TraceResult::ToString);
 
   class_<SearchEngineProxy>("SearchEngine")
+      .def(init<size_t>())
       .def("query", &SearchEngineProxy::Query)
+      .def("query_batch", &SearchEngineProxy::QueryBatch)
       .def("trace", &SearchEngineProxy::Trace);
 }
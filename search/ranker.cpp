@@ -10,6 +10,7 @@
 #include "search/utils.hpp"
 
 #include "editor/editable_data_source.hpp"
+#include "editor/osm_editor.hpp"
 
 #include "indexer/data_source.hpp"
 #include "indexer/feature_algo.hpp"
@@ -20,11 +21,13 @@
 
 #include "coding/multilang_utf8_string.hpp"
 
+#include "base/arena.hpp"
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 
 #include <boost/optional.hpp>
 
@@ -80,12 +83,12 @@ NameScores GetNameScores(FeatureType & ft, Geocoder::Params const & params,
 
   if (ftypes::IsAirportChecker::Instance()(ft))
   {
-    string const iata = ft.GetMetadata().Get(feature::Metadata::FMD_AIRPORT_IATA);
+    string const iata = ft.GetMetadataValue(feature::Metadata::FMD_AIRPORT_IATA);
     if (!iata.empty())
       UpdateNameScores(iata, sliceNoCategories, bestScores);
   }
 
-  string const op = ft.GetMetadata().Get(feature::Metadata::FMD_OPERATOR);
+  string const op = ft.GetMetadataValue(feature::Metadata::FMD_OPERATOR);
   if (!op.empty())
     UpdateNameScores(op, sliceNoCategories, bestScores);
 
@@ -219,6 +222,34 @@ private:
   ReverseGeocoder::Address m_address;
   bool m_computed = false;
 };
+
+// Sorts |results| by linear model ranks in decreasing order. Ranks are computed once
+// for all the results instead of twice for every comparison.
+void SortByLinearModelRank(vector<RankerResult> & results)
+{
+  vector<RankingInfo const *> infos;
+  infos.reserve(results.size());
+  for (auto const & r : results)
+    infos.push_back(&r.GetRankingInfo());
+
+  vector<double> ranks;
+  RankingInfo::GetLinearModelRanks(infos, ranks);
+
+  base::Arena::Scope scratch;
+  base::ArenaVector<size_t> order(results.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&ranks](size_t lhs, size_t rhs) {
+    if (ranks[lhs] != ranks[rhs])
+      return ranks[lhs] > ranks[rhs];
+    return lhs < rhs;
+  });
+
+  vector<RankerResult> sorted;
+  sorted.reserve(results.size());
+  for (auto const i : order)
+    sorted.push_back(move(results[i]));
+  results.swap(sorted);
+}
 }  // namespace
 
 class RankerResultMaker
@@ -228,27 +259,42 @@ class RankerResultMaker
   Geocoder::Params const & m_params;
   storage::CountryInfoGetter const & m_infoGetter;
 
+  // Loads results. Streets and cities of results are loaded by |m_auxLoader|, so
+  // |m_loader| reads results of an mwm without switching to other mwms.
   unique_ptr<FeaturesLoaderGuard> m_loader;
+  unique_ptr<FeaturesLoaderGuard> m_auxLoader;
 
-  bool LoadFeature(FeatureID const & id, FeatureType & ft)
+  bool LoadFeature(FeatureID const & id, FeatureType & ft, unique_ptr<FeaturesLoaderGuard> & loader)
   {
-    if (!m_loader || m_loader->GetId() != id.m_mwmId)
-      m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id.m_mwmId);
-    if (!m_loader->GetFeatureByIndex(id.m_index, ft))
+    if (!loader || loader->GetId() != id.m_mwmId)
+      loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id.m_mwmId);
+    if (!loader->GetFeatureByIndex(id.m_index, ft))
       return false;
 
     ft.SetID(id);
     return true;
   }
 
-  // For the best performance, incoming ids should be sorted by id.first (mwm file id).
-  bool LoadFeature(FeatureID const & id, FeatureType & ft, m2::PointD & center, string & name,
-                   string & country)
+  // For the best performance, incoming ids should be sorted (see Ranker::MakeRankerResults()).
+  bool LoadFeature(PreRankerResult const & res, FeatureType & ft, m2::PointD & center,
+                   string & name, string & country)
   {
-    if (!LoadFeature(id, ft))
+    auto const & id = res.GetId();
+    if (!LoadFeature(id, ft, m_loader))
       return false;
 
-    center = feature::GetCenter(ft);
+    // The center from the centers table doesn't need the geometry of lines and areas to be
+    // parsed but it's not updated by the editor.
+    auto const & preInfo = res.GetInfo();
+    if (preInfo.m_centerLoaded &&
+        osm::Editor::Instance().GetFeatureStatus(id) == FeatureStatus::Untouched)
+    {
+      center = preInfo.m_center;
+    }
+    else
+    {
+      center = feature::GetCenter(ft);
+    }
     m_ranker.GetBestMatchName(ft, name);
 
     // Country (region) name is a file name if feature isn't from
@@ -285,7 +331,7 @@ class RankerResultMaker
     {
       auto const & mwmId = ft.GetID().m_mwmId;
       FeatureType street;
-      if (LoadFeature(FeatureID(mwmId, preInfo.m_geoParts.m_street), street))
+      if (LoadFeature(FeatureID(mwmId, preInfo.m_geoParts.m_street), street, m_auxLoader))
       {
         auto const type = Model::TYPE_STREET;
         auto const & range = preInfo.m_tokenRange[type];
@@ -299,7 +345,7 @@ class RankerResultMaker
     if (!Model::IsLocalityType(info.m_type) && preInfo.m_cityId.IsValid())
     {
       FeatureType city;
-      if (LoadFeature(preInfo.m_cityId, city))
+      if (LoadFeature(preInfo.m_cityId, city, m_auxLoader))
       {
         auto const type = Model::TYPE_CITY;
         auto const & range = preInfo.m_tokenRange[type];
@@ -358,7 +404,7 @@ public:
     string name;
     string country;
 
-    if (!LoadFeature(preRankerResult.GetId(), ft, center, name, country))
+    if (!LoadFeature(preRankerResult, ft, center, name, country))
       return {};
 
     RankerResult r(ft, center, m_ranker.m_params.m_position /* pivot */, name, country);
@@ -477,6 +523,8 @@ void Ranker::SuggestStrings()
 
 void Ranker::UpdateResults(bool lastUpdate)
 {
+  SearchStats::ScopedTimer timer(m_params.m_stats, SearchStats::Stage::Ranking);
+
   if (!lastUpdate)
     BailIfCancelled();
 
@@ -492,11 +540,7 @@ void Ranker::UpdateResults(bool lastUpdate)
   }
   else
   {
-    // *NOTE* GetLinearModelRank is calculated on the fly
-    // but the model is lightweight enough and the slowdown
-    // is negligible.
-    sort(m_tentativeResults.rbegin(), m_tentativeResults.rend(),
-         base::LessBy(&RankerResult::GetLinearModelRank));
+    SortByLinearModelRank(m_tentativeResults);
     ProcessSuggestions(m_tentativeResults);
   }
 
@@ -555,10 +599,24 @@ void Ranker::LoadCountriesTree() { m_regionInfoGetter.LoadCountriesTree(); }
 void Ranker::MakeRankerResults(Geocoder::Params const & geocoderParams,
                                vector<RankerResult> & results)
 {
+  // Features are read in the order of mwms and offsets in their data sections, which is the
+  // order of feature indices. Then results are filtered in the pre-ranker order.
+  vector<size_t> order(m_preRankerResults.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+    return m_preRankerResults[lhs].GetId() < m_preRankerResults[rhs].GetId();
+  });
+
+  if (m_params.m_stats)
+    m_params.m_stats->Add(SearchStats::Counter::LoadedFeatures, m_preRankerResults.size());
+
+  vector<boost::optional<RankerResult>> rankerResults(m_preRankerResults.size());
   RankerResultMaker maker(*this, m_dataSource, m_infoGetter, geocoderParams);
-  for (auto const & r : m_preRankerResults)
+  for (auto const i : order)
+    rankerResults[i] = maker(m_preRankerResults[i]);
+
+  for (auto & p : rankerResults)
   {
-    auto p = maker(r);
     if (!p)
       continue;
 
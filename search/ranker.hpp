@@ -10,6 +10,7 @@
 #include "search/result.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
 #include "search/suggest.hpp"
 #include "search/utils.hpp"
 
@@ -76,6 +77,9 @@ public:
 
     // The maximum total number of results to be emitted in all batches.
     size_t m_limit = 0;
+
+    // Not owned, may be nullptr.
+    SearchStats * m_stats = nullptr;
   };
 
   Ranker(DataSource const & dataSource, CitiesBoundariesTable const & boundariesTable,
@@ -130,6 +130,57 @@ double RankingInfo::GetLinearModelRank() const
   return result;
 }
 
+// static
+void RankingInfo::GetLinearModelRanks(vector<RankingInfo const *> const & infos,
+                                      vector<double> & ranks)
+{
+  // NOTE: this code must be consistent with GetLinearModelRank(), the same
+  // terms are summed in the same order.
+  size_t const n = infos.size();
+
+  vector<double> distances(n);
+  vector<double> featureRanks(n);
+  vector<double> popularities(n);
+  vector<double> nameScores(n);
+  vector<double> errorsMade(n);
+  vector<double> types(n);
+  vector<double> falseCats(n);
+  vector<double> allTokensUsed(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    auto const & info = *infos[i];
+    distances[i] = info.m_distanceToPivot;
+    featureRanks[i] = info.m_rank;
+    popularities[i] = info.m_popularity;
+    nameScores[i] = kNameScore[info.m_pureCats || info.m_falseCats ? NAME_SCORE_ZERO
+                                                                   : info.m_nameScore];
+    errorsMade[i] = info.GetErrorsMade();
+    types[i] = kType[info.m_type];
+    falseCats[i] = info.m_falseCats;
+    allTokensUsed[i] = info.m_allTokensUsed ? 1 : 0;
+  }
+
+  double const maxRank = numeric_limits<uint8_t>::max();
+
+  ranks.assign(n, 0.0);
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += kDistanceToPivot * (min(distances[i], kMaxDistMeters) / kMaxDistMeters);
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += kRank * (featureRanks[i] / maxRank);
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += kPopularity * (popularities[i] / maxRank);
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += nameScores[i];
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += kErrorsMade * errorsMade[i];
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += types[i];
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += falseCats[i] * kFalseCats;
+  for (size_t i = 0; i < n; ++i)
+    ranks[i] += allTokensUsed[i] * kAllTokensUsed;
+}
+
 size_t RankingInfo::GetErrorsMade() const
 {
   return m_errorsMade.IsValid() ? m_errorsMade.m_errorsMade : 0;
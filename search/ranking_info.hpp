@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <vector>
 
 class FeatureType;
 
@@ -56,6 +57,11 @@ struct RankingInfo
   // correspond to important features.
   double GetLinearModelRank() const;
 
+  // Fills |ranks| with GetLinearModelRank() of |infos|. Features of all the infos are
+  // gathered to arrays first, so the model is evaluated by simple loops over them.
+  static void GetLinearModelRanks(std::vector<RankingInfo const *> const & infos,
+                                  std::vector<double> & ranks);
+
   size_t GetErrorsMade() const;
 };
 
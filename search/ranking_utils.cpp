@@ -94,13 +94,13 @@ bool PrefixMatch(QueryParams::Token const & token, UniString const & text)
 ErrorsMade GetMinErrorsMade(vector<strings::UniString> const & tokens,
                             strings::UniString const & text)
 {
-  auto const dfa = BuildLevenshteinDFA(text);
+  auto const dfa = GetLevenshteinDFA(text);
 
   ErrorsMade errorsMade;
 
   for (auto const & token : tokens)
   {
-    auto it = dfa.Begin();
+    auto it = dfa->Begin();
     strings::DFAMove(it, token.begin(), token.end());
     if (it.Accepts())
       errorsMade = ErrorsMade::Min(errorsMade, ErrorsMade(it.ErrorsMade()));
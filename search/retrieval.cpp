@@ -79,6 +79,13 @@ public:
            binary_search(m_modified.begin(), m_modified.end(), featureIndex);
   }
 
+  template <typename Fn>
+  void ForEachModifiedOrDeletedIndex(Fn && fn) const
+  {
+    for_each(m_deleted.begin(), m_deleted.end(), fn);
+    for_each(m_modified.begin(), m_modified.end(), fn);
+  }
+
   template <typename Fn>
   void ForEachModifiedOrCreated(Fn && fn)
   {
@@ -176,7 +183,7 @@ bool MatchFeatureByNameAndType(FeatureType & ft, SearchTrieRequest<DFA> const &
 
 bool MatchFeatureByPostcode(FeatureType & ft, TokenSlice const & slice)
 {
-  string const postcode = ft.GetMetadata().Get(feature::Metadata::FMD_POSTCODE);
+  string const postcode = ft.GetMetadataValue(feature::Metadata::FMD_POSTCODE);
   vector<UniString> tokens;
   NormalizeAndTokenizeString(postcode, tokens, Delimiters());
   if (slice.Size() > tokens.size())
@@ -220,6 +227,51 @@ unique_ptr<coding::CompressedBitVector> RetrieveAddressFeaturesImpl(
   return SortFeaturesAndBuildCBV(move(features));
 }
 
+template <typename Value, typename DFA>
+unique_ptr<coding::CompressedBitVector> RetrieveCachedAddressFeaturesImpl(
+    Retrieval::TrieRoot<Value> const & root, MwmContext const & context,
+    base::Cancellable const & cancellable, SearchTrieRequest<DFA> const & request,
+    RetrievalCache::Key const & key, RetrievalCache & cache)
+{
+  ASSERT_EQUAL(key.m_mwmId, context.GetId(), ());
+
+  // Only features of the search index are cached, edits are applied to them below.
+  auto trieFeatures = cache.Get(key);
+  if (!trieFeatures)
+  {
+    vector<uint64_t> features;
+    FeaturesCollector collector(cancellable, features);
+    MatchFeaturesInTrie(request, root, [](Value const &) { return true; } /* filter */,
+                        collector);
+    trieFeatures = SortFeaturesAndBuildCBV(move(features));
+    cache.Put(key, *trieFeatures);
+  }
+
+  EditedFeaturesHolder holder(context.GetId());
+
+  vector<uint64_t> editedFeatures;
+  holder.ForEachModifiedOrDeletedIndex(
+      [&editedFeatures](uint32_t index) { editedFeatures.push_back(index); });
+  if (!editedFeatures.empty())
+  {
+    trieFeatures = coding::CompressedBitVector::Subtract(
+        *trieFeatures, *SortFeaturesAndBuildCBV(move(editedFeatures)));
+  }
+
+  vector<uint64_t> matchedFeatures;
+  holder.ForEachModifiedOrCreated([&](FeatureType & ft, uint64_t index) {
+    if (MatchFeatureByNameAndType(ft, request))
+      matchedFeatures.push_back(index);
+  });
+  if (!matchedFeatures.empty())
+  {
+    trieFeatures = coding::CompressedBitVector::Union(
+        *trieFeatures, *SortFeaturesAndBuildCBV(move(matchedFeatures)));
+  }
+
+  return trieFeatures;
+}
+
 template <typename Value>
 unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeaturesImpl(
     Retrieval::TrieRoot<Value> const & root, MwmContext const & context,
@@ -277,6 +329,16 @@ struct RetrieveAddressFeaturesAdaptor
   }
 };
 
+template <typename T>
+struct RetrieveCachedAddressFeaturesAdaptor
+{
+  template <typename... Args>
+  unique_ptr<coding::CompressedBitVector> operator()(Args &&... args)
+  {
+    return RetrieveCachedAddressFeaturesImpl<T>(forward<Args>(args)...);
+  }
+};
+
 template <typename T>
 struct RetrievePostcodeFeaturesAdaptor
 {
@@ -342,6 +404,20 @@ unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
   return Retrieve<RetrieveAddressFeaturesAdaptor>(request);
 }
 
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
+    SearchTrieRequest<LevenshteinDFA> const & request, RetrievalCache::Key const & key,
+    RetrievalCache & cache) const
+{
+  return Retrieve<RetrieveCachedAddressFeaturesAdaptor>(request, key, cache);
+}
+
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
+    SearchTrieRequest<PrefixDFAModifier<LevenshteinDFA>> const & request,
+    RetrievalCache::Key const & key, RetrievalCache & cache) const
+{
+  return Retrieve<RetrieveCachedAddressFeaturesAdaptor>(request, key, cache);
+}
+
 unique_ptr<coding::CompressedBitVector> Retrieval::RetrievePostcodeFeatures(
     TokenSlice const & slice) const
 {
@@ -2,6 +2,7 @@
 
 #include "search/feature_offset_match.hpp"
 #include "search/query_params.hpp"
+#include "search/retrieval_cache.hpp"
 
 #include "platform/mwm_traits.hpp"
 
@@ -49,6 +50,16 @@ public:
   unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
       SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request) const;
 
+  // Same as RetrieveAddressFeatures() but features of the search index are taken from |cache|
+  // if they were retrieved for |key| before. |key| should describe |request|.
+  unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
+      SearchTrieRequest<strings::LevenshteinDFA> const & request, RetrievalCache::Key const & key,
+      RetrievalCache & cache) const;
+
+  unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
+      SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request,
+      RetrievalCache::Key const & key, RetrievalCache & cache) const;
+
   // Retrieves from the search index corresponding to |value| all
   // postcodes matching to |slice|.
   unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeatures(TokenSlice const & slice) const;
@@ -0,0 +1,134 @@
+#include "search/retrieval_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <sstream>
+#include <tuple>
+
+using namespace std;
+
+namespace search
+{
+// RetrievalCache::Key -----------------------------------------------------------------------------
+bool RetrievalCache::Key::operator<(Key const & rhs) const
+{
+  return tie(m_mwmId, m_mwmVersion, m_isPrefix, m_langs, m_tokens, m_types) <
+         tie(rhs.m_mwmId, rhs.m_mwmVersion, rhs.m_isPrefix, rhs.m_langs, rhs.m_tokens,
+             rhs.m_types);
+}
+
+// RetrievalCache ----------------------------------------------------------------------------------
+size_t constexpr RetrievalCache::kDefaultMaxSizeBytes;
+
+RetrievalCache::RetrievalCache(size_t maxSizeBytes) : m_maxSizeBytes(maxSizeBytes) {}
+
+unique_ptr<coding::CompressedBitVector> RetrievalCache::Get(Key const & key)
+{
+  Features features;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_index.find(key);
+    if (it == m_index.end())
+    {
+      ++m_stats.m_misses;
+      return {};
+    }
+
+    ++m_stats.m_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    features = it->second->second;
+  }
+
+  // Features are shared with other threads, so a copy is returned.
+  return features->Clone();
+}
+
+void RetrievalCache::Put(Key const & key, coding::CompressedBitVector const & features)
+{
+  size_t const sizeBytes = GetSizeBytes(features);
+  if (sizeBytes > m_maxSizeBytes)
+    return;
+
+  Features copy = features.Clone();
+
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it->second);
+
+  while (!m_entries.empty() && m_sizeBytes + sizeBytes > m_maxSizeBytes)
+    Erase(prev(m_entries.end()));
+
+  m_entries.emplace_front(key, move(copy));
+  m_index.emplace(key, m_entries.begin());
+  m_sizeBytes += sizeBytes;
+}
+
+void RetrievalCache::SetMaxSizeBytes(size_t maxSizeBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_maxSizeBytes = maxSizeBytes;
+  while (!m_entries.empty() && m_sizeBytes > maxSizeBytes)
+    Erase(prev(m_entries.end()));
+}
+
+void RetrievalCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+  m_sizeBytes = 0;
+}
+
+RetrievalCache::Stats RetrievalCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+
+size_t RetrievalCache::GetSizeBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_sizeBytes;
+}
+
+size_t RetrievalCache::GetNumEntries() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+// static
+size_t RetrievalCache::GetSizeBytes(coding::CompressedBitVector const & features)
+{
+  switch (features.GetStorageStrategy())
+  {
+  case coding::CompressedBitVector::StorageStrategy::Dense:
+    return static_cast<coding::DenseCBV const &>(features).NumBitGroups() * sizeof(uint64_t);
+  case coding::CompressedBitVector::StorageStrategy::Sparse:
+    return static_cast<size_t>(features.PopCount()) * sizeof(uint64_t);
+  case coding::CompressedBitVector::StorageStrategy::Chunked:
+    return static_cast<coding::ChunkedCBV const &>(features).GetSizeBytes();
+  }
+  CHECK_SWITCH();
+}
+
+void RetrievalCache::Erase(Entries::iterator it)
+{
+  size_t const sizeBytes = GetSizeBytes(*it->second);
+  ASSERT_GREATER_OR_EQUAL(m_sizeBytes, sizeBytes, ());
+  m_sizeBytes -= sizeBytes;
+  m_index.erase(it->first);
+  m_entries.erase(it);
+}
+
+string DebugPrint(RetrievalCache::Stats const & stats)
+{
+  ostringstream os;
+  os << "RetrievalCache::Stats [";
+  os << "hits: " << stats.m_hits << ", ";
+  os << "misses: " << stats.m_misses;
+  os << "]";
+  return os.str();
+}
+}  // namespace search
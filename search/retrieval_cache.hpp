@@ -0,0 +1,99 @@
+#pragma once
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/macros.hpp"
+#include "base/memory_budget.hpp"
+#include "base/string_utils.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace search
+{
+// Thread-safe LRU cache of features retrieved from search indices by tokens. It's shared
+// by all processors of an engine, so the same tokens and prefixes of consecutive queries
+// (e.g. while a query is typed) are not matched in the search trie again. Features of
+// types of categorial requests are cached too, one entry per type.
+//
+// Only features of the search index are cached. Edited features are looked up by Retrieval
+// on every request, so the cache doesn't need to be cleared after edits.
+class RetrievalCache : public base::MemoryBudget::Client
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    MwmSet::MwmId m_mwmId;
+    int64_t m_mwmVersion = 0;
+    // The original token and its synonyms.
+    std::vector<strings::UniString> m_tokens;
+    // Type indices of categories matching the token.
+    std::vector<uint32_t> m_types;
+    // Bit mask of languages of the request.
+    uint64_t m_langs = 0;
+    bool m_isPrefix = false;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  static size_t constexpr kDefaultMaxSizeBytes = 16 * 1024 * 1024;
+
+  explicit RetrievalCache(size_t maxSizeBytes = kDefaultMaxSizeBytes);
+
+  // Returns a copy of features cached for |key| or nullptr if there is no entry for |key|.
+  std::unique_ptr<coding::CompressedBitVector> Get(Key const & key);
+
+  // Evicts least recently used entries if the cache exceeds the size limit. Features
+  // larger than the limit aren't cached.
+  void Put(Key const & key, coding::CompressedBitVector const & features);
+
+  void Clear();
+
+  // Evicts least recently used entries if the cache exceeds the new limit.
+  void SetMaxSizeBytes(size_t maxSizeBytes);
+
+  Stats GetStats() const;
+  size_t GetSizeBytes() const;
+  size_t GetNumEntries() const;
+
+  // base::MemoryBudget::Client overrides:
+  void OnBudgetChanged(size_t budgetBytes) override { SetMaxSizeBytes(budgetBytes); }
+
+private:
+  using Features = std::shared_ptr<coding::CompressedBitVector const>;
+  // Most recently used entries are at the front.
+  using Entries = std::list<std::pair<Key, Features>>;
+
+  static size_t GetSizeBytes(coding::CompressedBitVector const & features);
+
+  void Erase(Entries::iterator it);
+
+  std::atomic<size_t> m_maxSizeBytes;
+
+  mutable std::mutex m_mutex;
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  size_t m_sizeBytes = 0;
+  Stats m_stats;
+
+  DISALLOW_COPY_AND_MOVE(RetrievalCache);
+};
+
+std::string DebugPrint(RetrievalCache::Stats const & stats);
+}  // namespace search
@@ -1,9 +1,11 @@
 #include "reverse_geocoder.hpp"
 
+#include "search/address_points_table.hpp"
 #include "search/mwm_context.hpp"
 
 #include "indexer/data_source.hpp"
 
+#include "indexer/cell_id.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/feature_algo.hpp"
 #include "indexer/ftypes_matcher.hpp"
@@ -11,9 +13,14 @@
 #include "indexer/search_string_utils.hpp"
 
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/function.hpp"
 #include "std/limits.hpp"
+#include "std/map.hpp"
+
+#include <exception>
 
 namespace search
 {
@@ -23,6 +30,8 @@ size_t constexpr kSimilarityThresholdPercent = 10;
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+/// Max number of buildings which nearby streets are cached during batch reverse geocoding.
+size_t constexpr kMaxNumCachedStreets = 1024;
 
 using AppendStreet = function<void(FeatureType & ft)>;
 using FillStreets =
@@ -66,8 +75,263 @@ void GetNearbyStreetsImpl(DataSource const & source, MwmSet::MwmId const & id,
 
   sort(streets.begin(), streets.end(), base::LessBy(&ReverseGeocoder::Street::m_distanceMeters));
 }
+
+bool HasEditedFeatures(MwmSet::MwmId const & id)
+{
+  auto const & editor = osm::Editor::Instance();
+  for (auto const status : {FeatureStatus::Deleted, FeatureStatus::Obsolete,
+                            FeatureStatus::Modified, FeatureStatus::Created})
+  {
+    if (!editor.GetFeaturesByStatus(id, status).empty())
+      return true;
+  }
+  return false;
+}
+
+// Looks for the nearest address in address points tables of mwms from |infos|. Buildings are
+// visited in the order of lower bounds of their distances and only the nearest ones are read
+// to get exact distances, so the address is the same as ReverseGeocoder finds by reading all
+// the buildings around. Returns false and doesn't touch |addr| when a table is missing or an
+// mwm has edited features which the table doesn't know about.
+//
+// |getTable| returns the table of an mwm or nullptr, |getFeature| reads a building.
+template <typename GetTable, typename GetFeature>
+bool GetNearbyAddressFromTables(vector<shared_ptr<MwmInfo>> const & infos,
+                                m2::PointD const & center, GetTable && getTable,
+                                GetFeature && getFeature, ReverseGeocoder::Address & addr)
+{
+  struct Candidate
+  {
+    MwmSet::MwmId m_mwmId;
+    AddressPointsTable const * m_table;
+    AddressPointsTable::Point m_point;
+    double m_minDistanceMeters;
+  };
+
+  m2::RectD const rect = GetLookupRect(center, ReverseGeocoder::kLookupRadiusM);
+
+  // Buildings with house numbers are in country mwms only.
+  vector<Candidate> candidates;
+  for (auto const & info : infos)
+  {
+    if (info->GetType() != MwmInfo::COUNTRY || !rect.IsIntersect(info->m_bordersRect))
+      continue;
+
+    MwmSet::MwmId const id(info);
+    if (HasEditedFeatures(id))
+      return false;
+
+    AddressPointsTable const * table = getTable(id);
+    if (!table)
+      return false;
+
+    table->ForEachInRect(rect, [&](AddressPointsTable::Point const & point) {
+      auto const distance = MercatorBounds::DistanceOnEarth(center, point.m_center);
+      candidates.push_back({id, table, point, max(distance - point.m_radiusMeters, 0.0)});
+    });
+  }
+
+  sort(candidates.begin(), candidates.end(), base::LessBy(&Candidate::m_minDistanceMeters));
+
+  // Read buildings are kept in a heap by exact distances. The top of the heap is the nearest
+  // of the remaining buildings when no unread building may be nearer.
+  using Building = pair<ReverseGeocoder::Building, Candidate const *>;
+  auto const fartherThan = [](Building const & lhs, Building const & rhs) {
+    return lhs.first.m_distanceMeters > rhs.first.m_distanceMeters;
+  };
+  vector<Building> heap;
+
+  size_t next = 0;
+  size_t triesCount = 0;
+  while (true)
+  {
+    while (next < candidates.size() &&
+           (heap.empty() ||
+            candidates[next].m_minDistanceMeters <= heap.front().first.m_distanceMeters))
+    {
+      auto const & c = candidates[next++];
+      FeatureType ft;
+      if (!getFeature(FeatureID(c.m_mwmId, c.m_point.m_building), ft))
+        continue;
+
+      ReverseGeocoder::Building const building(ft.GetID(),
+                                               feature::GetMinDistanceMeters(ft, center),
+                                               ft.GetHouseNumber(), feature::GetCenter(ft));
+      heap.emplace_back(building, &c);
+      push_heap(heap.begin(), heap.end(), fartherThan);
+    }
+
+    if (heap.empty())
+      break;
+
+    pop_heap(heap.begin(), heap.end(), fartherThan);
+    auto const nearest = move(heap.back());
+    heap.pop_back();
+
+    auto const & c = *nearest.second;
+    uint32_t street;
+    string name;
+    if (c.m_table->GetStreet(c.m_point, street, name))
+    {
+      addr.m_building = nearest.first;
+      addr.m_street = ReverseGeocoder::Street(FeatureID(c.m_mwmId, street),
+                                              -1.0 /* distMeters */, name);
+      break;
+    }
+
+    if (++triesCount == kMaxNumTriesToApproxAddress)
+      break;
+  }
+  return true;
+}
 }  // namespace
 
+// ReverseGeocoder::BatchContext -------------------------------------------------------------------
+class ReverseGeocoder::BatchContext
+{
+public:
+  explicit BatchContext(DataSource const & dataSource) : m_dataSource(dataSource)
+  {
+    m_dataSource.GetMwmsInfo(m_infos);
+  }
+
+  void GetNearbyAddress(m2::PointD const & center, Address & addr)
+  {
+    auto const getTable = [this](MwmSet::MwmId const & id) { return GetTable(id); };
+    auto const getFeature = [this](FeatureID const & id, FeatureType & ft) {
+      auto const * context = GetContext(id.m_mwmId);
+      return context && context->GetFeature(id.m_index, ft);
+    };
+    if (GetNearbyAddressFromTables(m_infos, center, getTable, getFeature, addr))
+      return;
+
+    vector<Building> buildings;
+    GetNearbyBuildings(center, buildings);
+
+    size_t triesCount = 0;
+    for (auto const & b : buildings)
+    {
+      if (GetNearbyAddress(b, addr) || (++triesCount == kMaxNumTriesToApproxAddress))
+        break;
+    }
+  }
+
+private:
+  // Returns nullptr when the mwm is dead.
+  MwmContext * GetContext(MwmSet::MwmId const & id)
+  {
+    auto it = m_contexts.find(id);
+    if (it == m_contexts.end())
+    {
+      unique_ptr<MwmContext> context;
+      auto handle = m_dataSource.GetMwmHandleById(id);
+      if (handle.IsAlive())
+        context = make_unique<MwmContext>(move(handle));
+      else
+        LOG(LWARNING, ("MWM", id, "is dead"));
+      it = m_contexts.emplace(id, move(context)).first;
+    }
+    return it->second.get();
+  }
+
+  AddressPointsTable const * GetTable(MwmSet::MwmId const & id)
+  {
+    auto it = m_tables.find(id);
+    if (it == m_tables.end())
+    {
+      unique_ptr<AddressPointsTable> table;
+      if (auto const * context = GetContext(id))
+        table = AddressPointsTable::Load(context->m_value);
+      it = m_tables.emplace(id, move(table)).first;
+    }
+    return it->second.get();
+  }
+
+  // Same as ReverseGeocoder::GetNearbyBuildings() but reads features with cached contexts.
+  void GetNearbyBuildings(m2::PointD const & center, vector<Building> & buildings)
+  {
+    m2::RectD const rect = GetLookupRect(center, kLookupRadiusM);
+
+    auto const addBuilding = [&](FeatureType & ft) {
+      if (!ft.GetHouseNumber().empty())
+        buildings.push_back(FromFeature(ft, feature::GetMinDistanceMeters(ft, center)));
+    };
+
+    for (auto const & info : m_infos)
+    {
+      if (info->m_minScale > kQueryScale || kQueryScale > info->m_maxScale ||
+          !rect.IsIntersect(info->m_bordersRect))
+      {
+        continue;
+      }
+
+      auto * context = GetContext(MwmSet::MwmId(info));
+      if (!context)
+        continue;
+
+      context->ForEachFeature(rect, addBuilding);
+      osm::Editor::Instance().ForEachCreatedFeature(context->GetId(),
+                                                    [&](uint32_t index) {
+                                                      FeatureType ft;
+                                                      if (context->GetFeature(index, ft))
+                                                        addBuilding(ft);
+                                                    },
+                                                    rect, kQueryScale);
+    }
+
+    sort(buildings.begin(), buildings.end(), base::LessBy(&Building::m_distanceMeters));
+  }
+
+  bool GetNearbyAddress(Building const & bld, Address & addr)
+  {
+    string street;
+    if (osm::Editor::Instance().GetEditedFeatureStreet(bld.m_id, street))
+    {
+      addr.m_building = bld;
+      addr.m_street.m_name = street;
+      return true;
+    }
+
+    auto * context = GetContext(bld.m_id.m_mwmId);
+    uint32_t ind;
+    if (!context || !context->GetStreetIndex(bld.m_id.m_index, ind))
+      return false;
+
+    auto const & streets = GetNearbyStreets(*context, bld);
+    if (ind < streets.size())
+    {
+      addr.m_building = bld;
+      addr.m_street = streets[ind];
+      return true;
+    }
+
+    LOG(LWARNING, ("Out of bound street index", ind, "for", bld.m_id));
+    return false;
+  }
+
+  vector<Street> const & GetNearbyStreets(MwmContext & context, Building const & bld)
+  {
+    auto it = m_streets.find(bld.m_id);
+    if (it != m_streets.end())
+      return it->second;
+
+    if (m_streets.size() >= kMaxNumCachedStreets)
+      m_streets.clear();
+
+    auto & streets = m_streets[bld.m_id];
+    ReverseGeocoder::GetNearbyStreets(context, bld.m_center, streets);
+    return streets;
+  }
+
+  DataSource const & m_dataSource;
+  vector<shared_ptr<MwmInfo>> m_infos;
+  map<MwmSet::MwmId, unique_ptr<MwmContext>> m_contexts;
+  map<MwmSet::MwmId, unique_ptr<AddressPointsTable>> m_tables;
+  // Nearby streets of buildings, street indices of the house-to-street table refer to them.
+  map<FeatureID, vector<Street>> m_streets;
+};
+
+// ReverseGeocoder ---------------------------------------------------------------------------------
 ReverseGeocoder::ReverseGeocoder(DataSource const & dataSource) : m_dataSource(dataSource) {}
 
 // static
@@ -176,6 +440,33 @@ ReverseGeocoder::GetNearbyOriginalFeatureStreets(FeatureType & ft) const
 
 void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, Address & addr) const
 {
+  {
+    vector<shared_ptr<MwmInfo>> infos;
+    m_dataSource.GetMwmsInfo(infos);
+
+    map<MwmSet::MwmId, pair<unique_ptr<FeaturesLoaderGuard>, unique_ptr<AddressPointsTable>>>
+        mwms;
+    auto const getTable = [&](MwmSet::MwmId const & id) -> AddressPointsTable const * {
+      auto const handle = m_dataSource.GetMwmHandleById(id);
+      if (!handle.IsAlive())
+        return nullptr;
+      auto table = AddressPointsTable::Load(*handle.GetValue<MwmValue>());
+      if (!table)
+        return nullptr;
+      auto & mwm = mwms[id];
+      mwm.first = make_unique<FeaturesLoaderGuard>(m_dataSource, id);
+      mwm.second = move(table);
+      return mwm.second.get();
+    };
+    auto const getFeature = [&](FeatureID const & id, FeatureType & ft) {
+      auto const it = mwms.find(id.m_mwmId);
+      return it != mwms.end() && it->second.first->GetFeatureByIndex(id.m_index, ft);
+    };
+
+    if (GetNearbyAddressFromTables(infos, center, getTable, getFeature, addr))
+      return;
+  }
+
   vector<Building> buildings;
   GetNearbyBuildings(center, buildings);
 
@@ -191,6 +482,64 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, Address & addr
   }
 }
 
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points,
+                                         vector<Address> & addrs, size_t numThreads) const
+{
+  addrs.assign(points.size(), Address());
+  if (points.empty())
+    return;
+
+  // Points are ordered by cells of the quadtree, so consecutive points are close to each other
+  // and every thread takes a compact area.
+  using Converter = CellIdConverter<MercatorBounds, RectId>;
+  vector<pair<int64_t, size_t>> order(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    auto const & p = points[i];
+    order[i] = make_pair(Converter::ToCellId(p.x, p.y).ToInt64(RectId::DEPTH_LEVELS), i);
+  }
+  sort(order.begin(), order.end());
+
+  numThreads = max<size_t>(1, min(numThreads, points.size()));
+  size_t const batchSize = (order.size() + numThreads - 1) / numThreads;
+
+  vector<std::exception_ptr> errors(numThreads);
+  auto const process = [&](size_t begin, size_t end, std::exception_ptr & error) {
+    try
+    {
+      BatchContext context(m_dataSource);
+      for (size_t i = begin; i < end; ++i)
+      {
+        auto const index = order[i].second;
+        context.GetNearbyAddress(points[index], addrs[index]);
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+  };
+
+  {
+    vector<threads::SimpleThread> threads;
+    for (size_t i = 1; i < numThreads; ++i)
+    {
+      size_t const begin = min(i * batchSize, order.size());
+      size_t const end = min(begin + batchSize, order.size());
+      threads.emplace_back(process, begin, end, std::ref(errors[i]));
+    }
+    process(0, min(batchSize, order.size()), errors[0]);
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  for (auto const & error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
 bool ReverseGeocoder::GetExactAddress(FeatureType & ft, Address & addr) const
 {
   if (ft.GetHouseNumber().empty())
@@ -93,12 +93,21 @@ public:
   pair<vector<Street>, uint32_t> GetNearbyOriginalFeatureStreets(FeatureType & ft) const;
 
   /// @return The nearest exact address where building has house number and valid street match.
+  /// Buildings are looked for in address points tables of mwms when all of them have the table
+  /// and have no edits, see search/address_points_table.hpp.
   void GetNearbyAddress(m2::PointD const & center, Address & addr) const;
+  /// Same as GetNearbyAddress() for every point of |points|, |addrs[i]| is the address of
+  /// |points[i]|. Points are processed in the spatial order by |numThreads| threads so
+  /// close points reuse mwm contexts, house-to-street tables and nearby streets.
+  void GetNearbyAddresses(vector<m2::PointD> const & points, vector<Address> & addrs,
+                          size_t numThreads = 1) const;
   /// @param addr (out) the exact address of a feature.
   /// @returns false if  can't extruct address or ft have no house number.
   bool GetExactAddress(FeatureType & ft, Address & addr) const;
 
 private:
+  /// Caches of a single thread of batch reverse geocoding.
+  class BatchContext;
 
   /// Helper class to incapsulate house 2 street table reloading.
   class HouseTable
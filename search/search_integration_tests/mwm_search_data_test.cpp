@@ -0,0 +1,66 @@
+#include "testing/testing.hpp"
+
+#include "search/mwm_search_data.hpp"
+#include "search/search_tests_support/helpers.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/math.hpp"
+
+using namespace generator::tests_support;
+using namespace search::tests_support;
+using namespace std;
+
+namespace search
+{
+namespace
+{
+class MwmSearchDataTest : public SearchTest
+{
+};
+
+UNIT_CLASS_TEST(MwmSearchDataTest, Smoke)
+{
+  TestCafe cafe(m2::PointD(1.0, 2.0));
+  auto const id = BuildCountry("Cafeland", [&](TestMwmBuilder & builder) { builder.Add(cafe); });
+
+  MwmSearchDataCache cache(m_dataSource);
+
+  auto const data = cache.Get(id);
+  TEST(data, ());
+  TEST_EQUAL(data->GetId(), id, ());
+  TEST_EQUAL(cache.Get(id), data, ("Data must be loaded once."));
+
+  m2::PointD center;
+  TEST(data->GetCenter(0 /* id */, center), ());
+  TEST(base::AlmostEqualAbs(center, m2::PointD(1.0, 2.0), 1e-5), (center));
+
+  cache.Clear();
+  auto const reloaded = cache.Get(id);
+  TEST(reloaded, ());
+  TEST_NOT_EQUAL(reloaded, data, ());
+}
+
+UNIT_CLASS_TEST(MwmSearchDataTest, Deregister)
+{
+  TestCafe cafe(m2::PointD(1.0, 2.0));
+  auto const id = BuildCountry("Cafeland", [&](TestMwmBuilder & builder) { builder.Add(cafe); });
+
+  MwmSearchDataCache cache(m_dataSource);
+  TEST(cache.Get(id), ());
+
+  // The cache holds a handle of the mwm, so it's only marked to deregister.
+  DeregisterMap("Cafeland");
+  TEST(id.IsAlive(), ());
+
+  // Stale data is dropped, so the mwm is deregistered.
+  TEST(!cache.Get(id), ());
+  TEST(!id.IsAlive(), ());
+}
+}  // namespace
+}  // namespace search
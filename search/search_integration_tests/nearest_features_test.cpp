@@ -0,0 +1,98 @@
+#include "testing/testing.hpp"
+
+#include "search/categories_cache.hpp"
+#include "search/nearest_features.hpp"
+#include "search/search_tests_support/helpers.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/math.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace generator::tests_support;
+using namespace search::tests_support;
+using namespace std;
+
+namespace search
+{
+namespace
+{
+class NearestFeaturesTest : public SearchTest
+{
+public:
+  vector<NearestFeaturesFinder::Result> Find(m2::PointD const & pivot, size_t k)
+  {
+    vector<shared_ptr<MwmInfo>> infos;
+    m_dataSource.GetMwmsInfo(infos);
+
+    base::Cancellable const cancellable;
+    CategoriesCache cafes({classif().GetTypeByPath({"amenity", "cafe"})}, cancellable);
+    NearestFeaturesFinder finder(m_dataSource, cafes, cancellable);
+    return finder.Find(infos, pivot, k);
+  }
+};
+
+UNIT_CLASS_TEST(NearestFeaturesTest, Smoke)
+{
+  TestCafe cafe1(m2::PointD(0.05, 0.0));
+  TestCafe cafe2(m2::PointD(0.0, 0.1));
+  TestCafe cafe3(m2::PointD(-0.2, 0.0));
+  TestCafe cafe4(m2::PointD(0.3, 0.3));
+  TestHotel hotel(m2::PointD(0.01, 0.01), "hotel", "en");
+  TestCafe farCafe(m2::PointD(10.0, 10.0));
+
+  auto const nearId = BuildCountry("Near", [&](TestMwmBuilder & builder) {
+    builder.Add(cafe4);
+    builder.Add(cafe3);
+    builder.Add(hotel);
+    builder.Add(cafe2);
+    builder.Add(cafe1);
+  });
+  auto const farId = BuildCountry("Far", [&](TestMwmBuilder & builder) { builder.Add(farCafe); });
+
+  auto const matches = [&](NearestFeaturesFinder::Result const & result, MwmSet::MwmId const & id,
+                           TestFeature const & feature) {
+    FeaturesLoaderGuard loader(m_dataSource, id);
+    FeatureType ft;
+    TEST(loader.GetFeatureByIndex(result.m_id.m_index, ft), ());
+    return result.m_id.m_mwmId == id && ExactMatch(id, feature)->Matches(ft);
+  };
+
+  {
+    auto const results = Find(m2::PointD(0.0, 0.0), 3 /* k */);
+    TEST_EQUAL(results.size(), 3, ());
+    TEST(matches(results[0], nearId, cafe1), ());
+    TEST(matches(results[1], nearId, cafe2), ());
+    TEST(matches(results[2], nearId, cafe3), ());
+    TEST(base::AlmostEqualAbs(results[0].m_distance, 0.05, 1e-5), (results[0].m_distance));
+  }
+
+  {
+    auto const results = Find(m2::PointD(0.0, 0.0), 10 /* k */);
+    TEST_EQUAL(results.size(), 5, ());
+    TEST(matches(results[3], nearId, cafe4), ());
+    TEST(matches(results[4], farId, farCafe), ());
+    for (size_t i = 1; i < results.size(); ++i)
+      TEST_LESS_OR_EQUAL(results[i - 1].m_distance, results[i].m_distance, ());
+  }
+
+  {
+    auto const results = Find(m2::PointD(9.0, 9.0), 1 /* k */);
+    TEST_EQUAL(results.size(), 1, ());
+    TEST(matches(results[0], farId, farCafe), ());
+  }
+}
+}  // namespace
+}  // namespace search
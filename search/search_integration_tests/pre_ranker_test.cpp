@@ -5,6 +5,7 @@
 #include "search/emitter.hpp"
 #include "search/intermediate_result.hpp"
 #include "search/model.hpp"
+#include "search/mwm_search_data.hpp"
 #include "search/pre_ranker.hpp"
 #include "search/ranker.hpp"
 #include "search/search_tests_support/helpers.hpp"
@@ -128,7 +129,8 @@ UNIT_CLASS_TEST(PreRankerTest, Smoke)
   TestRanker ranker(m_dataSource, m_engine.GetCountryInfoGetter(), boundariesTable, keywordsScorer,
                     emitter, m_suggests, villagesCache, m_cancellable, results);
 
-  PreRanker preRanker(m_dataSource, ranker);
+  MwmSearchDataCache searchData(m_dataSource);
+  PreRanker preRanker(m_dataSource, searchData, ranker);
   PreRanker::Params params;
   params.m_viewport = kViewport;
   params.m_accuratePivotCenter = kPivot;
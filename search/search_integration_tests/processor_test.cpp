@@ -32,6 +32,10 @@
 #include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
 using namespace generator::tests_support;
 using namespace search::tests_support;
 
@@ -1221,6 +1225,15 @@ UNIT_CLASS_TEST(ProcessorTest, CityBoundaryLoad)
 
   TEST(!boundaries.HasPoint(m2::PointD(0.6, 0.6)), ());
   TEST(!boundaries.HasPoint(m2::PointD(-1, 0.5)), ());
+
+  TEST_EQUAL(table.GetMwmId(), id, ());
+  vector<uint32_t> fids;
+  table.GetCitiesWithPoint(m2::PointD(0.25, 0.25), fids);
+  TEST_EQUAL(fids, vector<uint32_t>({0}), ());
+  table.GetCitiesWithPoint(m2::PointD(0.5, 0.5), fids);
+  TEST_EQUAL(fids, vector<uint32_t>({0}), ());
+  table.GetCitiesWithPoint(m2::PointD(0.6, 0.6), fids);
+  TEST(fids.empty(), ());
 }
 
 UNIT_CLASS_TEST(ProcessorTest, CityBoundarySmoke)
@@ -1604,5 +1617,153 @@ UNIT_CLASS_TEST(ProcessorTest, OperatorTest)
     TEST(ResultsMatch("atm alfa ", "en", rules), ());
   }
 }
+
+UNIT_CLASS_TEST(ProcessorTest, ParallelGeocoding)
+{
+  TestCafe wonderlandCafe(m2::PointD(0.1, 0.1), "Mad Hatter cafe", "en");
+  TestCafe equestriaCafe(m2::PointD(0.3, 0.3), "Mad Hatter cafe", "en");
+  TestCafe narniaCafe(m2::PointD(0.5, 0.5), "Mad Hatter cafe", "en");
+
+  auto const wonderlandId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(wonderlandCafe);
+  });
+  auto const equestriaId = BuildCountry("Equestria", [&](TestMwmBuilder & builder) {
+    builder.Add(equestriaCafe);
+  });
+  auto const narniaId =
+      BuildCountry("Narnia", [&](TestMwmBuilder & builder) { builder.Add(narniaCafe); });
+
+  SearchParams params;
+  params.m_query = "mad hatter";
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(0.6, 0.6));
+  params.m_mode = Mode::Everywhere;
+
+  TestSearchRequest sequential(m_engine, params);
+  sequential.Run();
+
+  params.m_numGeocoderThreads = 4;
+  TestSearchRequest parallel(m_engine, params);
+  parallel.Run();
+
+  TRules const rules = {ExactMatch(wonderlandId, wonderlandCafe),
+                        ExactMatch(equestriaId, equestriaCafe),
+                        ExactMatch(narniaId, narniaCafe)};
+  TEST(ResultsMatch(sequential.Results(), rules), ());
+  TEST(ResultsMatch(parallel.Results(), rules), ());
+
+  auto const & expected = sequential.Results();
+  auto const & actual = parallel.Results();
+  TEST_EQUAL(expected.size(), actual.size(), ());
+  for (size_t i = 0; i < expected.size(); ++i)
+    TEST_EQUAL(expected[i].GetFeatureID(), actual[i].GetFeatureID(), (i));
+}
+
+UNIT_CLASS_TEST(ProcessorTest, StreamResultsAndTimeout)
+{
+  TestCafe wonderlandCafe(m2::PointD(0.1, 0.1), "Mad Hatter cafe", "en");
+  TestCafe equestriaCafe(m2::PointD(0.3, 0.3), "Mad Hatter cafe", "en");
+
+  auto const wonderlandId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(wonderlandCafe);
+  });
+  auto const equestriaId = BuildCountry("Equestria", [&](TestMwmBuilder & builder) {
+    builder.Add(equestriaCafe);
+  });
+
+  SearchParams params;
+  params.m_query = "mad hatter";
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(0.4, 0.4));
+  params.m_mode = Mode::Everywhere;
+
+  TRules const rules = {ExactMatch(wonderlandId, wonderlandCafe),
+                        ExactMatch(equestriaId, equestriaCafe)};
+
+  {
+    params.m_streamResults = true;
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TEST(ResultsMatch(request.Results(), rules), ());
+  }
+
+  {
+    // No mwms are matched after the deadline but the search is finished as usual.
+    params.m_streamResults = false;
+    params.m_timeout = SearchParams::TimeDuration::zero();
+    TestSearchRequest request(m_engine, params);
+    request.Run();
+    TEST(ResultsMatch(request.Results(), TRules{}), ());
+  }
+}
+
+UNIT_CLASS_TEST(ProcessorTest, ShortPrefixes)
+{
+  TestCafe cafe(m2::PointD(0.1, 0.1), "Mad Hatter", "en");
+  TestPOI poi(m2::PointD(0.2, 0.2), "Cheshire Cat", "en");
+
+  auto const countryId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(cafe);
+    builder.Add(poi);
+  });
+
+  SetViewport(m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(0.3, 0.3)));
+
+  TEST(ResultsMatch("ma", TRules{ExactMatch(countryId, cafe)}), ());
+  TEST(ResultsMatch("che", TRules{ExactMatch(countryId, poi)}), ());
+  TEST(ResultsMatch("che", Mode::Viewport, TRules{ExactMatch(countryId, poi)}), ());
+
+  // Categories are not in the short prefixes table but are matched too.
+  TEST(ResultsMatch("caf", TRules{ExactMatch(countryId, cafe)}), ());
+}
+
+UNIT_CLASS_TEST(ProcessorTest, SearchBatch)
+{
+  TestCafe wonderlandCafe(m2::PointD(0.1, 0.1), "Mad Hatter cafe", "en");
+  TestCafe equestriaCafe(m2::PointD(0.3, 0.3), "Sugarcube Corner cafe", "en");
+
+  auto const wonderlandId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(wonderlandCafe);
+  });
+  auto const equestriaId = BuildCountry("Equestria", [&](TestMwmBuilder & builder) {
+    builder.Add(equestriaCafe);
+  });
+
+  vector<string> const queries = {"mad hatter", "sugarcube corner", "mad hatter cafe",
+                                  "sugarcube"};
+  vector<SearchParams> batch;
+  for (auto const & query : queries)
+  {
+    SearchParams params;
+    params.m_query = query;
+    params.m_inputLocale = "en";
+    params.m_viewport = m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(0.4, 0.4));
+    params.m_mode = Mode::Everywhere;
+    batch.push_back(params);
+  }
+
+  mutex mu;
+  condition_variable cv;
+  vector<vector<Result>> results(batch.size());
+  size_t numFinished = 0;
+  m_engine.SearchBatch(batch, [&](size_t index, Results const & r) {
+    lock_guard<mutex> lock(mu);
+    results[index].assign(r.begin(), r.end());
+    ++numFinished;
+    cv.notify_one();
+  });
+
+  {
+    unique_lock<mutex> lock(mu);
+    cv.wait(lock, [&]() { return numFinished == batch.size(); });
+  }
+
+  TRules const wonderlandRules = {ExactMatch(wonderlandId, wonderlandCafe)};
+  TRules const equestriaRules = {ExactMatch(equestriaId, equestriaCafe)};
+  TEST(ResultsMatch(results[0], wonderlandRules), ());
+  TEST(ResultsMatch(results[1], equestriaRules), ());
+  TEST(ResultsMatch(results[2], wonderlandRules), ());
+  TEST(ResultsMatch(results[3], equestriaRules), ());
+}
 }  // namespace
 }  // namespace search
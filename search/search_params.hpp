@@ -6,6 +6,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -26,6 +27,7 @@ struct SearchParams
 
   using OnStarted = function<void()>;
   using OnResults = function<void(Results const &)>;
+  using TimeDuration = std::chrono::steady_clock::duration;
 
   bool IsEqualCommon(SearchParams const & rhs) const;
 
@@ -60,6 +62,19 @@ struct SearchParams
   std::shared_ptr<hotels_filter::Rule> m_hotelsFilter;
 
   std::shared_ptr<Tracer> m_tracer;
+
+  // Number of threads which are used to match mwms near the viewport and the position
+  // within this query. Results don't depend on it.
+  size_t m_numGeocoderThreads = 1;
+
+  // Time after which the geocoder doesn't match new mwms. Features matched before are
+  // ranked and emitted as usual. Not limited by default.
+  TimeDuration m_timeout = TimeDuration::max();
+
+  // Needed to emit results of every mwm as soon as it is matched, e.g. for autocomplete.
+  // Otherwise results are emitted when all mwms intersecting with the viewport and the
+  // position are matched. Later batches of results are appended to the emitted ones.
+  bool m_streamResults = false;
 };
 
 std::string DebugPrint(SearchParams const & params);
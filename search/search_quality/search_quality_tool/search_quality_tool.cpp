@@ -33,6 +33,7 @@
 #include "base/timer.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/cmath.hpp"
 #include "std/cstdio.hpp"
 #include "std/fstream.hpp"
@@ -43,8 +44,12 @@
 #include "std/numeric.hpp"
 #include "std/sstream.hpp"
 #include "std/string.hpp"
+#include "std/target_os.hpp"
+#include "std/thread.hpp"
 #include "std/vector.hpp"
 
+#include <sys/resource.h>
+
 #include "defines.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -64,6 +69,12 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_bool(print_stats, false, "Print latencies of search stages after all the queries");
+DEFINE_bool(throughput, false,
+            "Run the queries concurrently to keep all the engine threads busy and report "
+            "the throughput along with latencies");
+DEFINE_string(latencies_file, "", "File per-query latencies and memory usage will be written to");
+DEFINE_string(compare_with, "", "Latencies file of a previous run to compare the run with");
 
 map<string, m2::RectD> const kViewports = {
     {"default", m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(1.0, 1.0))},
@@ -73,6 +84,11 @@ map<string, m2::RectD> const kViewports = {
 
 string const kDefaultQueriesPathSuffix = "/../search/search_quality/search_quality_tool/queries.txt";
 string const kEmptyResult = "<empty>";
+string const kPeakMemoryKey = "#peak_memory_kb";
+// A query is reported by the comparison of runs when it became that many times slower.
+double const kRegressionFactor = 2.0;
+// Latencies less than this are too noisy to be compared.
+double const kMinComparedLatency = 0.01;
 
 struct CompletenessQuery
 {
@@ -186,6 +202,149 @@ void CalcStatistics(vector<double> const & a, double & avg, double & maximum, do
   stdDev = sqrt(var);
 }
 
+// Returns the |q|-th quantile of |sorted|, q is in [0, 1].
+double GetQuantile(vector<double> const & sorted, double q)
+{
+  if (sorted.empty())
+    return 0.0;
+  auto const rank = static_cast<size_t>(ceil(q * static_cast<double>(sorted.size())));
+  return sorted[min(max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+void PrintQuantiles(string const & name, vector<double> latencies)
+{
+  sort(latencies.begin(), latencies.end());
+  cout << name << " response time: p50 " << GetQuantile(latencies, 0.5) << "s, p90 "
+       << GetQuantile(latencies, 0.9) << "s, p99 " << GetQuantile(latencies, 0.99) << "s"
+       << endl;
+}
+
+// Returns the high-water mark of the resident set size of the process.
+uint64_t GetPeakMemoryKb()
+{
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  // Bytes on Mac OS, kilobytes elsewhere.
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+// Runs all the |requests| and waits for them. When |concurrently| is set, |numThreads| client
+// threads run requests at the same time, so all the engine threads are busy.
+void RunRequests(vector<unique_ptr<TestSearchRequest>> & requests, bool concurrently,
+                 size_t numThreads)
+{
+  if (!concurrently)
+  {
+    for (auto & request : requests)
+      request->Run();
+    return;
+  }
+
+  atomic<size_t> next(0);
+  vector<thread> threads;
+  for (size_t i = 0; i < max<size_t>(numThreads, 1); ++i)
+  {
+    threads.emplace_back([&requests, &next]() {
+      for (size_t j = next++; j < requests.size(); j = next++)
+        requests[j]->Run();
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+}
+
+// Writes lines "<latency in seconds><tab><query>" and the peak memory usage.
+void WriteLatencies(string const & path, vector<string> const & queries,
+                    vector<double> const & responseTimes, uint64_t peakMemoryKb)
+{
+  CHECK_EQUAL(queries.size(), responseTimes.size(), ());
+  ofstream stream(path.c_str());
+  if (!stream.is_open())
+  {
+    LOG(LERROR, ("Can't open file for latencies:", path));
+    return;
+  }
+
+  stream << kPeakMemoryKey << "\t" << peakMemoryKb << endl;
+  for (size_t i = 0; i < queries.size(); ++i)
+    stream << responseTimes[i] << "\t" << queries[i] << endl;
+}
+
+void ReadLatencies(string const & path, map<string, double> & latencies, uint64_t & peakMemoryKb)
+{
+  ifstream stream(path.c_str());
+  CHECK(stream.is_open(), ("Can't open", path));
+
+  peakMemoryKb = 0;
+  string s;
+  while (getline(stream, s))
+  {
+    auto const tab = s.find('\t');
+    if (tab == string::npos)
+      continue;
+
+    auto const first = s.substr(0, tab);
+    auto const second = s.substr(tab + 1);
+    if (first == kPeakMemoryKey)
+    {
+      uint64_t kb;
+      if (strings::to_uint64(second, kb))
+        peakMemoryKb = kb;
+      continue;
+    }
+
+    double latency;
+    if (strings::to_double(first, latency))
+      latencies[second] = latency;
+  }
+}
+
+// Compares the run with the one whose latencies were written to |path|: prints quantiles of
+// latencies of the queries found in both runs, the peak memory usage and the queries which
+// became much slower.
+void CompareLatencies(string const & path, vector<string> const & queries,
+                      vector<double> const & responseTimes, uint64_t peakMemoryKb)
+{
+  map<string, double> previous;
+  uint64_t previousPeakMemoryKb;
+  ReadLatencies(path, previous, previousPeakMemoryKb);
+
+  vector<double> before;
+  vector<double> after;
+  vector<pair<double, string>> regressions;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    auto const it = previous.find(queries[i]);
+    if (it == previous.end())
+      continue;
+    before.push_back(it->second);
+    after.push_back(responseTimes[i]);
+    if (responseTimes[i] >= kMinComparedLatency &&
+        responseTimes[i] > kRegressionFactor * it->second)
+    {
+      regressions.emplace_back(responseTimes[i] - it->second, queries[i]);
+    }
+  }
+
+  cout << endl << "Comparison with " << path << ", " << before.size() << " common queries:"
+       << endl;
+  PrintQuantiles("Previous", before);
+  PrintQuantiles("Current", after);
+  cout << "Peak memory usage: previous " << previousPeakMemoryKb << "KB, current "
+       << peakMemoryKb << "KB" << endl;
+
+  sort(regressions.rbegin(), regressions.rend());
+  cout << "Queries at least " << kRegressionFactor << " times slower: " << regressions.size()
+       << endl;
+  for (auto const & r : regressions)
+    cout << "\t" << r.second << "\t+" << r.first << "s" << endl;
+}
+
 // Unlike strings::Tokenize, this function allows for empty tokens.
 void Split(string const & s, char delim, vector<string> & parts)
 {
@@ -460,10 +619,13 @@ int main(int argc, char * argv[])
     csv << endl;
   }
 
+  base::Timer timer;
+  RunRequests(requests, FLAGS_throughput, static_cast<size_t>(FLAGS_num_threads));
+  double const totalTime = timer.ElapsedSeconds();
+
   vector<double> responseTimes(queries.size());
   for (size_t i = 0; i < queries.size(); ++i)
   {
-    requests[i]->Run();
     auto rt = duration_cast<milliseconds>(requests[i]->ResponseTime()).count();
     responseTimes[i] = static_cast<double>(rt) / 1000;
     PrintTopResults(MakePrefixFree(queries[i]), requests[i]->Results(), FLAGS_top,
@@ -490,6 +652,27 @@ int main(int argc, char * argv[])
   cout << "Maximum response time: " << maxTime << "s" << endl;
   cout << "Average response time: " << averageTime << "s"
        << " (std. dev. " << stdDevTime << "s)" << endl;
+  PrintQuantiles("Quantiles of", responseTimes);
+  if (FLAGS_throughput && totalTime > 0)
+  {
+    cout << "Throughput: " << static_cast<double>(queries.size()) / totalTime << " queries/s"
+         << endl;
+  }
+
+  auto const peakMemoryKb = GetPeakMemoryKb();
+  cout << "Peak memory usage: " << peakMemoryKb << "KB" << endl;
+
+  if (!FLAGS_latencies_file.empty())
+    WriteLatencies(FLAGS_latencies_file, queries, responseTimes, peakMemoryKb);
+  if (!FLAGS_compare_with.empty())
+    CompareLatencies(FLAGS_compare_with, queries, responseTimes, peakMemoryKb);
+
+  if (FLAGS_print_stats)
+  {
+    cout << endl << DebugPrint(engine.GetSearchStats()) << endl;
+    cout << DebugPrint(engine.GetStreetVicinityCacheStats()) << endl;
+    cout << DebugPrint(dataSource.GetStats()) << endl;
+  }
 
   return 0;
 }
@@ -0,0 +1,173 @@
+#include "search/search_stats.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace std;
+
+namespace search
+{
+// SearchStats::Histogram --------------------------------------------------------------------------
+uint64_t SearchStats::Histogram::GetQuantileUs(double q) const
+{
+  ASSERT_GREATER_OR_EQUAL(q, 0.0, ());
+  ASSERT_LESS_OR_EQUAL(q, 1.0, ());
+  if (m_count == 0)
+    return 0;
+
+  auto const rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(q * m_count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i + 1 < kNumBuckets; ++i)
+  {
+    seen += m_buckets[i];
+    if (seen >= rank)
+      return min(uint64_t{1} << i, m_maxUs);
+  }
+  return m_maxUs;
+}
+
+double SearchStats::Histogram::GetMeanUs() const
+{
+  if (m_count == 0)
+    return 0.0;
+  return static_cast<double>(m_totalUs) / static_cast<double>(m_count);
+}
+
+// SearchStats::ScopedTimer ------------------------------------------------------------------------
+SearchStats::ScopedTimer::ScopedTimer(SearchStats * stats, Stage stage)
+  : m_stats(stats), m_stage(stage), m_start(chrono::steady_clock::now())
+{
+}
+
+SearchStats::ScopedTimer::~ScopedTimer()
+{
+  if (m_stats)
+    m_stats->AddLatency(m_stage, chrono::steady_clock::now() - m_start);
+}
+
+// SearchStats -------------------------------------------------------------------------------------
+size_t constexpr SearchStats::kNumBuckets;
+
+SearchStats::SearchStats() { Clear(); }
+
+// static
+size_t SearchStats::GetBucket(uint64_t us)
+{
+  if (us == 0)
+    return 0;
+  return min(static_cast<size_t>(bits::FloorLog(us)) + 1, kNumBuckets - 1);
+}
+
+void SearchStats::AddLatency(Stage stage, chrono::steady_clock::duration duration)
+{
+  ASSERT_LESS(stage, Stage::Count, ());
+  auto const count = chrono::duration_cast<chrono::microseconds>(duration).count();
+  auto const us = static_cast<uint64_t>(max<decltype(count)>(count, 0));
+
+  auto & histogram = m_stages[static_cast<size_t>(stage)];
+  histogram.m_buckets[GetBucket(us)].fetch_add(1, memory_order_relaxed);
+  histogram.m_count.fetch_add(1, memory_order_relaxed);
+  histogram.m_totalUs.fetch_add(us, memory_order_relaxed);
+
+  auto maxUs = histogram.m_maxUs.load(memory_order_relaxed);
+  while (maxUs < us && !histogram.m_maxUs.compare_exchange_weak(maxUs, us, memory_order_relaxed))
+  {
+  }
+}
+
+void SearchStats::Add(Counter counter, uint64_t value)
+{
+  ASSERT_LESS(counter, Counter::Count, ());
+  m_counters[static_cast<size_t>(counter)].fetch_add(value, memory_order_relaxed);
+}
+
+SearchStats::Snapshot SearchStats::GetSnapshot() const
+{
+  Snapshot snapshot;
+  for (size_t i = 0; i < m_stages.size(); ++i)
+  {
+    auto const & from = m_stages[i];
+    auto & to = snapshot.m_stages[i];
+    for (size_t j = 0; j < kNumBuckets; ++j)
+      to.m_buckets[j] = from.m_buckets[j].load(memory_order_relaxed);
+    to.m_count = from.m_count.load(memory_order_relaxed);
+    to.m_totalUs = from.m_totalUs.load(memory_order_relaxed);
+    to.m_maxUs = from.m_maxUs.load(memory_order_relaxed);
+  }
+  for (size_t i = 0; i < m_counters.size(); ++i)
+    snapshot.m_counters[i] = m_counters[i].load(memory_order_relaxed);
+  return snapshot;
+}
+
+void SearchStats::Clear()
+{
+  for (auto & histogram : m_stages)
+  {
+    for (auto & bucket : histogram.m_buckets)
+      bucket.store(0, memory_order_relaxed);
+    histogram.m_count.store(0, memory_order_relaxed);
+    histogram.m_totalUs.store(0, memory_order_relaxed);
+    histogram.m_maxUs.store(0, memory_order_relaxed);
+  }
+  for (auto & counter : m_counters)
+    counter.store(0, memory_order_relaxed);
+}
+
+string DebugPrint(SearchStats::Stage stage)
+{
+  switch (stage)
+  {
+  case SearchStats::Stage::Total: return "Total";
+  case SearchStats::Stage::FillLocalities: return "FillLocalities";
+  case SearchStats::Stage::Retrieval: return "Retrieval";
+  case SearchStats::Stage::MatchCategories: return "MatchCategories";
+  case SearchStats::Stage::MatchRegions: return "MatchRegions";
+  case SearchStats::Stage::MatchAroundPivot: return "MatchAroundPivot";
+  case SearchStats::Stage::PreRanking: return "PreRanking";
+  case SearchStats::Stage::Ranking: return "Ranking";
+  case SearchStats::Stage::Count: return "Count";
+  }
+  CHECK_SWITCH();
+}
+
+string DebugPrint(SearchStats::Counter counter)
+{
+  switch (counter)
+  {
+  case SearchStats::Counter::MatchedMwms: return "MatchedMwms";
+  case SearchStats::Counter::RetrievedFeatures: return "RetrievedFeatures";
+  case SearchStats::Counter::LoadedFeatures: return "LoadedFeatures";
+  case SearchStats::Counter::EmittedResults: return "EmittedResults";
+  case SearchStats::Counter::Count: return "Count";
+  }
+  CHECK_SWITCH();
+}
+
+string DebugPrint(SearchStats::Snapshot const & snapshot)
+{
+  ostringstream os;
+  os << "SearchStats [" << endl;
+  for (size_t i = 0; i < snapshot.m_stages.size(); ++i)
+  {
+    auto const & histogram = snapshot.m_stages[i];
+    os << "  " << DebugPrint(static_cast<SearchStats::Stage>(i)) << ": ";
+    os << "count: " << histogram.m_count << ", ";
+    os << "mean: " << histogram.GetMeanUs() << "us, ";
+    os << "p50: " << histogram.GetQuantileUs(0.5) << "us, ";
+    os << "p90: " << histogram.GetQuantileUs(0.9) << "us, ";
+    os << "p99: " << histogram.GetQuantileUs(0.99) << "us, ";
+    os << "max: " << histogram.m_maxUs << "us" << endl;
+  }
+  for (size_t i = 0; i < snapshot.m_counters.size(); ++i)
+  {
+    os << "  " << DebugPrint(static_cast<SearchStats::Counter>(i)) << ": "
+       << snapshot.m_counters[i] << endl;
+  }
+  os << "]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace search
+{
+// Thread-safe aggregator of latencies of search stages and counters of work done by them.
+// It's shared by all processors of an engine and is updated on the hot path, so only
+// relaxed atomic increments are made there.
+class SearchStats
+{
+public:
+  // Stages may be nested, e.g. MatchRegions includes matching of cities and of features
+  // around them, and Ranking is included in PreRanking.
+  enum class Stage
+  {
+    Total,
+    FillLocalities,
+    Retrieval,
+    MatchCategories,
+    MatchRegions,
+    MatchAroundPivot,
+    PreRanking,
+    Ranking,
+    Count
+  };
+
+  enum class Counter
+  {
+    MatchedMwms,
+    // Sum of numbers of features retrieved from search indices for query tokens.
+    RetrievedFeatures,
+    // Number of features loaded by the ranker.
+    LoadedFeatures,
+    EmittedResults,
+    Count
+  };
+
+  // The i-th bucket counts durations in [2^(i - 1), 2^i) microseconds, the first one counts
+  // durations less than a microsecond and the last one counts all the long durations.
+  static size_t constexpr kNumBuckets = 26;
+
+  struct Histogram
+  {
+    // Returns an upper bound of the |q|-th quantile in microseconds, q is in [0, 1].
+    uint64_t GetQuantileUs(double q) const;
+    double GetMeanUs() const;
+
+    std::array<uint64_t, kNumBuckets> m_buckets = {};
+    uint64_t m_count = 0;
+    uint64_t m_totalUs = 0;
+    uint64_t m_maxUs = 0;
+  };
+
+  struct Snapshot
+  {
+    Histogram const & Get(Stage stage) const { return m_stages[static_cast<size_t>(stage)]; }
+    uint64_t Get(Counter counter) const { return m_counters[static_cast<size_t>(counter)]; }
+
+    std::array<Histogram, static_cast<size_t>(Stage::Count)> m_stages;
+    std::array<uint64_t, static_cast<size_t>(Counter::Count)> m_counters = {};
+  };
+
+  // Adds the duration of a stage to the stats when destroyed.
+  class ScopedTimer
+  {
+  public:
+    ScopedTimer(SearchStats * stats, Stage stage);
+    ~ScopedTimer();
+
+  private:
+    SearchStats * m_stats;
+    Stage const m_stage;
+    std::chrono::steady_clock::time_point const m_start;
+
+    DISALLOW_COPY_AND_MOVE(ScopedTimer);
+  };
+
+  SearchStats();
+
+  static size_t GetBucket(uint64_t us);
+
+  void AddLatency(Stage stage, std::chrono::steady_clock::duration duration);
+  void Add(Counter counter, uint64_t value);
+
+  Snapshot GetSnapshot() const;
+  void Clear();
+
+private:
+  struct AtomicHistogram
+  {
+    std::array<std::atomic<uint64_t>, kNumBuckets> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_totalUs;
+    std::atomic<uint64_t> m_maxUs;
+  };
+
+  std::array<AtomicHistogram, static_cast<size_t>(Stage::Count)> m_stages;
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::Count)> m_counters;
+
+  DISALLOW_COPY_AND_MOVE(SearchStats);
+};
+
+std::string DebugPrint(SearchStats::Stage stage);
+std::string DebugPrint(SearchStats::Counter counter);
+std::string DebugPrint(SearchStats::Snapshot const & snapshot);
+}  // namespace search
@@ -0,0 +1,116 @@
+#include "testing/testing.hpp"
+
+#include "search/address_points_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+unique_ptr<AddressPointsTable> Serialize(AddressPointsTable::Builder const & builder,
+                                         vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Serialize(writer);
+  }
+  return AddressPointsTable::Load(make_unique<MemReader>(buffer.data(), buffer.size()));
+}
+
+vector<uint32_t> GetBuildings(AddressPointsTable const & table, m2::RectD const & rect)
+{
+  vector<uint32_t> buildings;
+  table.ForEachInRect(rect, [&](AddressPointsTable::Point const & point) {
+    buildings.push_back(point.m_building);
+  });
+  sort(buildings.begin(), buildings.end());
+  return buildings;
+}
+
+UNIT_TEST(AddressPointsTable_Smoke)
+{
+  AddressPointsTable::Builder builder;
+  builder.Add(m2::PointD(10.0, 10.0), 5.0 /* radiusMeters */, 1 /* building */, "1",
+              100 /* street */, "Main street");
+  builder.Add(m2::PointD(10.001, 10.0), 0.0 /* radiusMeters */, 2 /* building */, "2",
+              100 /* street */, "Main street");
+  builder.Add(m2::PointD(10.0, 10.002), 0.0 /* radiusMeters */, 3 /* building */, "1",
+              101 /* street */, "Side street");
+  builder.Add(m2::PointD(-50.0, 30.0), 1e6 /* radiusMeters */, 4 /* building */, "7a",
+              AddressPointsTable::kNoStreet, "" /* streetName */);
+
+  vector<uint8_t> buffer;
+  auto const table = Serialize(builder, buffer);
+  TEST(table, ());
+  TEST_EQUAL(table->GetNumPoints(), 4, ());
+
+  auto const around = [](m2::PointD const & center, double sizeM) {
+    return MercatorBounds::RectByCenterXYAndSizeInMeters(center, sizeM);
+  };
+
+  TEST_EQUAL(GetBuildings(*table, around(m2::PointD(10.0, 10.0), 1000)),
+             vector<uint32_t>({1, 2, 3}), ());
+  TEST_EQUAL(GetBuildings(*table, m2::RectD(9.9995, 9.9995, 10.0005, 10.0005)),
+             vector<uint32_t>({1}), ());
+  TEST_EQUAL(GetBuildings(*table, around(m2::PointD(-50.0, 30.0), 10)), vector<uint32_t>({4}),
+             ());
+  TEST(GetBuildings(*table, around(m2::PointD(0.0, 0.0), 1000)).empty(), ());
+  TEST_EQUAL(GetBuildings(*table, MercatorBounds::FullRect()), vector<uint32_t>({1, 2, 3, 4}),
+             ());
+
+  table->ForEachInRect(MercatorBounds::FullRect(), [&](AddressPointsTable::Point const & point) {
+    uint32_t street;
+    string name;
+    switch (point.m_building)
+    {
+    case 1:
+      TEST(base::AlmostEqualAbs(point.m_center, m2::PointD(10.0, 10.0), 1e-5), (point.m_center));
+      TEST_EQUAL(point.m_radiusMeters, 6.0, ());
+      TEST_EQUAL(table->GetHouseNumber(point), "1", ());
+      TEST(table->GetStreet(point, street, name), ());
+      TEST_EQUAL(street, 100, ());
+      TEST_EQUAL(name, "Main street", ());
+      break;
+    case 3:
+      TEST_EQUAL(table->GetHouseNumber(point), "1", ());
+      TEST(table->GetStreet(point, street, name), ());
+      TEST_EQUAL(street, 101, ());
+      TEST_EQUAL(name, "Side street", ());
+      break;
+    case 4:
+      TEST_EQUAL(point.m_radiusMeters, 65535.0, ());
+      TEST_EQUAL(table->GetHouseNumber(point), "7a", ());
+      TEST(!table->GetStreet(point, street, name), ());
+      break;
+    }
+  });
+}
+
+UNIT_TEST(AddressPointsTable_Load)
+{
+  AddressPointsTable::Builder builder;
+  vector<uint8_t> buffer;
+  auto table = Serialize(builder, buffer);
+  TEST(table, ());
+  TEST_EQUAL(table->GetNumPoints(), 0, ());
+  TEST(GetBuildings(*table, MercatorBounds::FullRect()).empty(), ());
+
+  buffer[0] = AddressPointsTable::kLatestVersion + 1;
+  TEST(!AddressPointsTable::Load(make_unique<MemReader>(buffer.data(), buffer.size())), ());
+
+  buffer.resize(1);
+  TEST(!AddressPointsTable::Load(make_unique<MemReader>(buffer.data(), buffer.size())), ());
+}
+}  // namespace
@@ -9,6 +9,8 @@
 
 #include "base/cancellable.hpp"
 
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -29,7 +31,7 @@ public:
 
   void Erase(Id const & id) { m_processor.Erase(id); }
 
-  Ids Search(string const & query)
+  Ids Search(string const & query, size_t limit = numeric_limits<size_t>::max())
   {
     m_emitter.Init([](::search::Results const & /* results */) {} /* onResults */);
 
@@ -48,7 +50,7 @@ public:
       params.InitNoPrefix(tokens.begin(), tokens.end());
     }
 
-    m_processor.Search(params);
+    m_processor.Search(params, limit);
     Ids ids;
     for (auto const & result : m_emitter.GetResults().GetBookmarksResults())
       ids.emplace_back(result.m_id);
@@ -77,4 +79,24 @@ UNIT_CLASS_TEST(BookmarksProcessorTest, Smoke)
   TEST_EQUAL(Search("double r cafe"), Ids({10}), ());
   TEST_EQUAL(Search("dine"), Ids({10}), ());
 }
+
+UNIT_CLASS_TEST(BookmarksProcessorTest, Limit)
+{
+  Add(10, {"Double R Diner" /* name */, "Cherry pie" /* description */});
+  Add(18, {"Double R Diner" /* name */, "" /* description */});
+  Add(20, {"Diner" /* name */, "" /* description */});
+
+  TEST_EQUAL(Search("double r diner"), Ids({18, 10, 20}), ());
+  TEST_EQUAL(Search("double r diner", 2 /* limit */), Ids({18, 10}), ());
+  TEST_EQUAL(Search("double r diner", 1 /* limit */), Ids({18}), ());
+  TEST_EQUAL(Search("double r diner", 0 /* limit */), Ids(), ());
+
+  // Equally relevant bookmarks are ordered by ids.
+  Add(5, {"Double R Diner" /* name */, "" /* description */});
+  TEST_EQUAL(Search("double r diner", 1 /* limit */), Ids({5}), ());
+  TEST_EQUAL(Search("double r diner", 2 /* limit */), Ids({5, 18}), ());
+
+  Erase(5);
+  TEST_EQUAL(Search("double r diner", 1 /* limit */), Ids({18}), ());
+}
 }  // namespace
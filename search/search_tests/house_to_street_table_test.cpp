@@ -0,0 +1,79 @@
+#include "testing/testing.hpp"
+
+#include "search/house_to_street_table.hpp"
+
+#include "coding/memory_region.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+unique_ptr<HouseToStreetTable> Freeze(HouseToStreetTableBuilder const & builder,
+                                      vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+  return HouseToStreetTable::Load(make_unique<CopiedMemoryRegion>(vector<uint8_t>(buffer)));
+}
+
+UNIT_TEST(HouseToStreetTable_Smoke)
+{
+  HouseToStreetTableBuilder builder;
+  builder.Put(10 /* houseId */, 3 /* streetIndex */);
+  builder.Put(0 /* houseId */, 1 /* streetIndex */);
+  builder.Put(7 /* houseId */, 0 /* streetIndex */);
+  builder.Put(100500 /* houseId */, 12345 /* streetIndex */);
+  builder.Put(8 /* houseId */, 3 /* streetIndex */);
+
+  vector<uint8_t> buffer;
+  auto const table = Freeze(builder, buffer);
+  TEST(table, ());
+
+  vector<pair<uint32_t, uint32_t>> const expected = {
+      {0, 1}, {7, 0}, {8, 3}, {10, 3}, {100500, 12345}};
+  for (auto const & e : expected)
+  {
+    uint32_t streetIndex = 0;
+    TEST(table->Get(e.first, streetIndex), (e.first));
+    TEST_EQUAL(streetIndex, e.second, (e.first));
+  }
+
+  uint32_t streetIndex = 0;
+  for (uint32_t houseId : {1, 6, 9, 11, 100499, 100501, 1000000})
+    TEST(!table->Get(houseId, streetIndex), (houseId));
+}
+
+UNIT_TEST(HouseToStreetTable_Load)
+{
+  vector<uint8_t> buffer;
+  {
+    HouseToStreetTableBuilder builder;
+    auto const table = Freeze(builder, buffer);
+    TEST(table, ());
+    uint32_t streetIndex = 0;
+    TEST(!table->Get(0 /* houseId */, streetIndex), ());
+  }
+
+  {
+    HouseToStreetTableBuilder builder;
+    builder.Put(1 /* houseId */, 2 /* streetIndex */);
+    TEST(Freeze(builder, buffer), ());
+
+    buffer[0] = HouseToStreetTableBuilder::kLatestVersion + 1;
+    TEST(!HouseToStreetTable::Load(make_unique<CopiedMemoryRegion>(vector<uint8_t>(buffer))), ());
+
+    buffer.resize(4);
+    TEST(!HouseToStreetTable::Load(make_unique<CopiedMemoryRegion>(vector<uint8_t>(buffer))), ());
+  }
+}
+}  // namespace
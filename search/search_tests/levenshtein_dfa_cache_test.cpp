@@ -0,0 +1,83 @@
+#include "testing/testing.hpp"
+
+#include "search/levenshtein_dfa_cache.hpp"
+
+#include "base/dfa_helpers.hpp"
+#include "base/levenshtein_dfa.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <string>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+bool Accepts(strings::LevenshteinDFA const & dfa, string const & s)
+{
+  auto it = dfa.Begin();
+  strings::DFAMove(it, strings::MakeUniString(s));
+  return it.Accepts();
+}
+
+UNIT_TEST(LevenshteinDFACache_Smoke)
+{
+  size_t numBuilt = 0;
+  LevenshteinDFACache cache([&numBuilt](strings::UniString const & s, size_t maxErrors) {
+    ++numBuilt;
+    return strings::LevenshteinDFA(s, maxErrors);
+  });
+
+  auto const dfa = cache.Get(strings::MakeUniString("london"), 1 /* maxErrors */);
+  TEST(Accepts(*dfa, "london"), ());
+  TEST(Accepts(*dfa, "lodon"), ());
+  TEST(!Accepts(*dfa, "lodn"), ());
+  TEST_EQUAL(numBuilt, 1, ());
+
+  TEST_EQUAL(cache.Get(strings::MakeUniString("london"), 1 /* maxErrors */), dfa, ());
+  TEST_EQUAL(numBuilt, 1, ());
+
+  auto const strict = cache.Get(strings::MakeUniString("london"), 0 /* maxErrors */);
+  TEST_NOT_EQUAL(strict, dfa, ());
+  TEST(!Accepts(*strict, "lodon"), ());
+  TEST_EQUAL(numBuilt, 2, ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 0, ());
+  cache.Get(strings::MakeUniString("london"), 1 /* maxErrors */);
+  TEST_EQUAL(numBuilt, 3, ());
+}
+
+UNIT_TEST(LevenshteinDFACache_Eviction)
+{
+  // Every DFA of a token of two letters without errors has the same size.
+  LevenshteinDFACache probe([](strings::UniString const & s, size_t maxErrors) {
+    return strings::LevenshteinDFA(s, maxErrors);
+  });
+  probe.Get(strings::MakeUniString("ab"), 0 /* maxErrors */);
+  size_t const sizeBytes = probe.GetSizeBytes();
+  TEST_GREATER(sizeBytes, 0, ());
+
+  LevenshteinDFACache cache(
+      [](strings::UniString const & s, size_t maxErrors) {
+        return strings::LevenshteinDFA(s, maxErrors);
+      },
+      2 * sizeBytes /* maxSizeBytes */);
+  auto const ab = cache.Get(strings::MakeUniString("ab"), 0 /* maxErrors */);
+  auto const cd = cache.Get(strings::MakeUniString("cd"), 0 /* maxErrors */);
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  // The oldest DFA is evicted but is still valid for its users.
+  cache.Get(strings::MakeUniString("ef"), 0 /* maxErrors */);
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 2 * sizeBytes, ());
+  TEST(Accepts(*ab, "ab"), ());
+  TEST_NOT_EQUAL(cache.Get(strings::MakeUniString("ab"), 0 /* maxErrors */), ab, ());
+  TEST_EQUAL(cache.Get(strings::MakeUniString("ef"), 0 /* maxErrors */),
+             cache.Get(strings::MakeUniString("ef"), 0 /* maxErrors */), ());
+  TEST(Accepts(*cd, "cd"), ());
+}
+}  // namespace
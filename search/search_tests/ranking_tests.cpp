@@ -1,6 +1,7 @@
 #include "testing/testing.hpp"
 
 #include "search/query_params.hpp"
+#include "search/ranking_info.hpp"
 #include "search/ranking_utils.hpp"
 #include "search/token_range.hpp"
 #include "search/token_slice.hpp"
@@ -13,6 +14,7 @@
 
 #include "std/cstdint.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 using namespace search;
 using namespace strings;
@@ -55,4 +57,46 @@ UNIT_TEST(NameTest_Smoke)
   TEST_EQUAL(GetScore("фото на документы", "фото", TokenRange(0, 1)), NAME_SCORE_PREFIX, ());
   TEST_EQUAL(GetScore("фотоателье", "фото", TokenRange(0, 1)), NAME_SCORE_PREFIX, ());
 }
+
+UNIT_TEST(RankingInfo_LinearModelRanks)
+{
+  vector<RankingInfo> infos;
+  for (double const distance : {0.0, 1000.0, 1e7})
+  {
+    for (int nameScore = 0; nameScore < NAME_SCORE_COUNT; ++nameScore)
+    {
+      for (int type = 0; type < Model::TYPE_COUNT; ++type)
+      {
+        for (int cats = 0; cats < 3; ++cats)
+        {
+          RankingInfo info;
+          info.m_distanceToPivot = distance;
+          info.m_rank = static_cast<uint8_t>(type * 30);
+          info.m_popularity = static_cast<uint8_t>(nameScore * 50);
+          info.m_nameScore = static_cast<NameScore>(nameScore);
+          if (type % 2 == 0)
+            info.m_errorsMade = ErrorsMade(static_cast<size_t>(nameScore));
+          info.m_allTokensUsed = cats != 1;
+          info.m_type = static_cast<Model::Type>(type);
+          info.m_pureCats = cats == 1;
+          info.m_falseCats = cats == 2;
+          infos.push_back(info);
+        }
+      }
+    }
+  }
+
+  vector<RankingInfo const *> ptrs;
+  for (auto const & info : infos)
+    ptrs.push_back(&info);
+
+  vector<double> ranks;
+  RankingInfo::GetLinearModelRanks(ptrs, ranks);
+  TEST_EQUAL(ranks.size(), infos.size(), ());
+  for (size_t i = 0; i < infos.size(); ++i)
+    TEST_EQUAL(ranks[i], infos[i].GetLinearModelRank(), (infos[i]));
+
+  RankingInfo::GetLinearModelRanks({} /* infos */, ranks);
+  TEST(ranks.empty(), ());
+}
 }  // namespace
@@ -0,0 +1,121 @@
+#include "testing/testing.hpp"
+
+#include "search/retrieval_cache.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/memory_budget.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+RetrievalCache::Key MakeKey(string const & token, bool isPrefix = false)
+{
+  RetrievalCache::Key key;
+  key.m_tokens.push_back(strings::MakeUniString(token));
+  key.m_langs = 1;
+  key.m_isPrefix = isPrefix;
+  return key;
+}
+
+unique_ptr<coding::CompressedBitVector> MakeFeatures(vector<uint64_t> const & features)
+{
+  return coding::CompressedBitVectorBuilder::FromBitPositions(features);
+}
+
+vector<uint64_t> GetFeatures(coding::CompressedBitVector const & cbv)
+{
+  vector<uint64_t> features;
+  coding::CompressedBitVectorEnumerator::ForEach(
+      cbv, [&features](uint64_t feature) { features.push_back(feature); });
+  return features;
+}
+
+UNIT_TEST(RetrievalCache_Smoke)
+{
+  RetrievalCache cache;
+  TEST(!cache.Get(MakeKey("cafe")), ());
+
+  cache.Put(MakeKey("cafe"), *MakeFeatures({1, 5, 7}));
+  auto const features = cache.Get(MakeKey("cafe"));
+  TEST(features, ());
+  TEST_EQUAL(GetFeatures(*features), vector<uint64_t>({1, 5, 7}), ());
+
+  // Prefix and full tokens are different keys.
+  TEST(!cache.Get(MakeKey("cafe", true /* isPrefix */)), ());
+
+  auto key = MakeKey("cafe");
+  key.m_langs = 2;
+  TEST(!cache.Get(key), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+
+  cache.Put(MakeKey("cafe"), *MakeFeatures({2}));
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+  TEST_EQUAL(GetFeatures(*cache.Get(MakeKey("cafe"))), vector<uint64_t>({2}), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 0, ());
+  TEST(!cache.Get(MakeKey("cafe")), ());
+}
+
+UNIT_TEST(RetrievalCache_Eviction)
+{
+  // Every entry of features within the first 64 bits takes 8 bytes.
+  RetrievalCache cache(16 /* maxSizeBytes */);
+  cache.Put(MakeKey("a"), *MakeFeatures({1, 2}));
+  cache.Put(MakeKey("b"), *MakeFeatures({3, 4}));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 16, ());
+
+  // "a" becomes the most recently used entry, so "b" is evicted.
+  TEST(cache.Get(MakeKey("a")), ());
+  cache.Put(MakeKey("c"), *MakeFeatures({5, 6}));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST(cache.Get(MakeKey("a")), ());
+  TEST(!cache.Get(MakeKey("b")), ());
+  TEST(cache.Get(MakeKey("c")), ());
+
+  // Features larger than the cache aren't cached.
+  cache.Put(MakeKey("d"), *MakeFeatures({100, 200, 300}));
+  TEST(!cache.Get(MakeKey("d")), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+}
+
+UNIT_TEST(RetrievalCache_MemoryBudget)
+{
+  RetrievalCache cache(16 /* maxSizeBytes */);
+  cache.Put(MakeKey("a"), *MakeFeatures({1, 2}));
+  cache.Put(MakeKey("b"), *MakeFeatures({3, 4}));
+
+  base::MemoryBudget budget(16 /* totalBytes */);
+  TEST(budget.Register(cache, "RetrievalCache", base::MemoryBudget::Priority::Low, 16), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  // The least recently used entry is evicted when the budget is cut.
+  budget.SetPressure(base::MemoryBudget::Pressure::Moderate);
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+  TEST(cache.Get(MakeKey("b")), ());
+
+  budget.SetPressure(base::MemoryBudget::Pressure::Critical);
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+
+  // The cache grows back when the pressure is gone.
+  budget.SetPressure(base::MemoryBudget::Pressure::None);
+  cache.Put(MakeKey("a"), *MakeFeatures({1, 2}));
+  cache.Put(MakeKey("b"), *MakeFeatures({3, 4}));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST(budget.Unregister(cache), ());
+}
+}  // namespace
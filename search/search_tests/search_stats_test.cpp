@@ -0,0 +1,88 @@
+#include "testing/testing.hpp"
+
+#include "search/search_stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+using Stage = SearchStats::Stage;
+using Counter = SearchStats::Counter;
+
+void AddUs(SearchStats & stats, Stage stage, int64_t us)
+{
+  stats.AddLatency(stage, chrono::microseconds(us));
+}
+
+UNIT_TEST(SearchStats_Buckets)
+{
+  TEST_EQUAL(SearchStats::GetBucket(0), 0, ());
+  TEST_EQUAL(SearchStats::GetBucket(1), 1, ());
+  TEST_EQUAL(SearchStats::GetBucket(2), 2, ());
+  TEST_EQUAL(SearchStats::GetBucket(3), 2, ());
+  TEST_EQUAL(SearchStats::GetBucket(4), 3, ());
+  TEST_EQUAL(SearchStats::GetBucket(1000), 10, ());
+  TEST_EQUAL(SearchStats::GetBucket(UINT64_MAX), SearchStats::kNumBuckets - 1, ());
+}
+
+UNIT_TEST(SearchStats_Smoke)
+{
+  SearchStats stats;
+  {
+    auto const snapshot = stats.GetSnapshot();
+    auto const & total = snapshot.Get(Stage::Total);
+    TEST_EQUAL(total.m_count, 0, ());
+    TEST_EQUAL(total.GetQuantileUs(0.5), 0, ());
+    TEST_ALMOST_EQUAL_ULPS(total.GetMeanUs(), 0.0, ());
+  }
+
+  for (int64_t us = 1; us <= 100; ++us)
+    AddUs(stats, Stage::Total, us);
+  AddUs(stats, Stage::Ranking, 5000);
+
+  stats.Add(Counter::EmittedResults, 3);
+  stats.Add(Counter::EmittedResults, 4);
+
+  auto const snapshot = stats.GetSnapshot();
+  auto const & total = snapshot.Get(Stage::Total);
+  TEST_EQUAL(total.m_count, 100, ());
+  TEST_EQUAL(total.m_totalUs, 5050, ());
+  TEST_EQUAL(total.m_maxUs, 100, ());
+  TEST_ALMOST_EQUAL_ULPS(total.GetMeanUs(), 50.5, ());
+
+  // Quantiles are upper bounds of their buckets: 50 is in [32, 64), 99 is in [64, 128).
+  TEST_EQUAL(total.GetQuantileUs(0.5), 64, ());
+  TEST_EQUAL(total.GetQuantileUs(0.99), 100, ());
+  TEST_EQUAL(total.GetQuantileUs(0.0), 2, ());
+
+  auto const & ranking = snapshot.Get(Stage::Ranking);
+  TEST_EQUAL(ranking.m_count, 1, ());
+  TEST_EQUAL(ranking.GetQuantileUs(0.5), 5000, ());
+
+  TEST_EQUAL(snapshot.Get(Stage::Retrieval).m_count, 0, ());
+  TEST_EQUAL(snapshot.Get(Counter::EmittedResults), 7, ());
+  TEST_EQUAL(snapshot.Get(Counter::LoadedFeatures), 0, ());
+
+  stats.Clear();
+  auto const cleared = stats.GetSnapshot();
+  TEST_EQUAL(cleared.Get(Stage::Total).m_count, 0, ());
+  TEST_EQUAL(cleared.Get(Stage::Total).m_maxUs, 0, ());
+  TEST_EQUAL(cleared.Get(Counter::EmittedResults), 0, ());
+}
+
+UNIT_TEST(SearchStats_ScopedTimer)
+{
+  SearchStats stats;
+  {
+    SearchStats::ScopedTimer timer(&stats, Stage::Retrieval);
+  }
+  {
+    SearchStats::ScopedTimer timer(nullptr, Stage::Retrieval);
+  }
+  TEST_EQUAL(stats.GetSnapshot().Get(Stage::Retrieval).m_count, 1, ());
+}
+}  // namespace
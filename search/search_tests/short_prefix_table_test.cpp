@@ -0,0 +1,102 @@
+#include "testing/testing.hpp"
+
+#include "search/short_prefix_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+uint8_t constexpr kEn = 1;
+uint8_t constexpr kRu = 8;
+
+unique_ptr<ShortPrefixTable> Serialize(ShortPrefixTable::Builder const & builder,
+                                       vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Serialize(writer);
+  }
+  return ShortPrefixTable::Load(make_unique<MemReader>(buffer.data(), buffer.size()));
+}
+
+vector<uint32_t> GetFeatures(ShortPrefixTable const & table, uint8_t lang, string const & prefix)
+{
+  vector<uint32_t> features;
+  table.GetFeatures(lang, strings::MakeUniString(prefix), features);
+  return features;
+}
+
+UNIT_TEST(ShortPrefixTable_Smoke)
+{
+  ShortPrefixTable::Builder builder;
+  builder.Add(kEn, strings::MakeUniString("cafe"), 10 /* featureId */, 0 /* rank */);
+  builder.Add(kEn, strings::MakeUniString("cat"), 3 /* featureId */, 0 /* rank */);
+  builder.Add(kEn, strings::MakeUniString("ca"), 3 /* featureId */, 0 /* rank */);
+  builder.Add(kRu, strings::MakeUniString("кафе"), 7 /* featureId */, 0 /* rank */);
+
+  vector<uint8_t> buffer;
+  auto const table = Serialize(builder, buffer);
+  TEST(table, ());
+  TEST_EQUAL(table->GetNumKeys(), 7, ());
+
+  TEST_EQUAL(GetFeatures(*table, kEn, "c"), vector<uint32_t>({3, 10}), ());
+  TEST_EQUAL(GetFeatures(*table, kEn, "ca"), vector<uint32_t>({3, 10}), ());
+  TEST_EQUAL(GetFeatures(*table, kEn, "caf"), vector<uint32_t>({10}), ());
+  TEST_EQUAL(GetFeatures(*table, kEn, "cat"), vector<uint32_t>({3}), ());
+  TEST_EQUAL(GetFeatures(*table, kRu, "каф"), vector<uint32_t>({7}), ());
+
+  TEST(GetFeatures(*table, kRu, "ca").empty(), ());
+  TEST(GetFeatures(*table, kEn, "cb").empty(), ());
+  TEST(GetFeatures(*table, kEn, "").empty(), ());
+  // Long prefixes are not in the table.
+  TEST(GetFeatures(*table, kEn, "cafe").empty(), ());
+}
+
+UNIT_TEST(ShortPrefixTable_BestRanked)
+{
+  ShortPrefixTable::Builder builder;
+  uint32_t const numFeatures = 2 * ShortPrefixTable::kMaxNumFeatures;
+  for (uint32_t i = 0; i < numFeatures; ++i)
+  {
+    auto const rank = static_cast<uint8_t>(i % 2 == 0 ? 0 : 10);
+    builder.Add(kEn, strings::MakeUniString("wonderland"), i /* featureId */, rank);
+  }
+
+  vector<uint8_t> buffer;
+  auto const table = Serialize(builder, buffer);
+  TEST(table, ());
+
+  vector<uint32_t> expected;
+  for (uint32_t i = 1; i < numFeatures; i += 2)
+    expected.push_back(i);
+  TEST_EQUAL(GetFeatures(*table, kEn, "won"), expected, ());
+}
+
+UNIT_TEST(ShortPrefixTable_Load)
+{
+  ShortPrefixTable::Builder builder;
+  vector<uint8_t> buffer;
+  auto table = Serialize(builder, buffer);
+  TEST(table, ());
+  TEST_EQUAL(table->GetNumKeys(), 0, ());
+  TEST(GetFeatures(*table, kEn, "a").empty(), ());
+
+  buffer[0] = ShortPrefixTable::kLatestVersion + 1;
+  TEST(!ShortPrefixTable::Load(make_unique<MemReader>(buffer.data(), buffer.size())), ());
+
+  buffer.resize(1);
+  TEST(!ShortPrefixTable::Load(make_unique<MemReader>(buffer.data(), buffer.size())), ());
+}
+}  // namespace
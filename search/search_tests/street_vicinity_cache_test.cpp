@@ -0,0 +1,91 @@
+#include "testing/testing.hpp"
+
+#include "search/projection_on_street.hpp"
+#include "search/street_vicinity_cache.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+using Street = StreetVicinityCache::Street;
+
+StreetVicinityCache::Key MakeKey(uint32_t featureId)
+{
+  StreetVicinityCache::Key key;
+  key.m_featureId = featureId;
+  key.m_scale = 17;
+  key.m_offsetMeters = 100.0;
+  return key;
+}
+
+shared_ptr<Street const> MakeStreet(vector<uint32_t> const & features)
+{
+  auto street = make_shared<Street>();
+  street->m_features = features;
+  street->m_rect = m2::RectD(0, 0, 1, 1);
+  street->m_calculator = make_unique<ProjectionOnStreetCalculator>(
+      vector<m2::PointD>{m2::PointD(0, 0), m2::PointD(1, 1)});
+  return street;
+}
+
+UNIT_TEST(StreetVicinityCache_Smoke)
+{
+  StreetVicinityCache cache;
+  TEST(!cache.Get(MakeKey(1)), ());
+
+  cache.Put(MakeKey(1), MakeStreet({2, 3, 5}));
+  auto const street = cache.Get(MakeKey(1));
+  TEST(street, ());
+  TEST_EQUAL(street->m_features, vector<uint32_t>({2, 3, 5}), ());
+  TEST(!street->IsEmpty(), ());
+
+  // Streets of different scales are different keys.
+  auto key = MakeKey(1);
+  key.m_scale = 16;
+  TEST(!cache.Get(key), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 0, ());
+  TEST(!cache.Get(MakeKey(1)), ());
+
+  // Evicted or cleared streets are still valid for their users.
+  TEST_EQUAL(street->m_features, vector<uint32_t>({2, 3, 5}), ());
+}
+
+UNIT_TEST(StreetVicinityCache_Eviction)
+{
+  auto const sizeBytes = StreetVicinityCache::GetSizeBytes(*MakeStreet({1, 2}));
+  StreetVicinityCache cache(2 * sizeBytes /* maxSizeBytes */);
+  cache.Put(MakeKey(1), MakeStreet({1, 2}));
+  cache.Put(MakeKey(2), MakeStreet({3, 4}));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetSizeBytes(), 2 * sizeBytes, ());
+
+  // The first street becomes the most recently used entry, so the second one is evicted.
+  TEST(cache.Get(MakeKey(1)), ());
+  cache.Put(MakeKey(3), MakeStreet({5, 6}));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST(cache.Get(MakeKey(1)), ());
+  TEST(!cache.Get(MakeKey(2)), ());
+  TEST(cache.Get(MakeKey(3)), ());
+  TEST_EQUAL(cache.GetStats().m_evictions, 1, ());
+
+  // Streets larger than the cache aren't cached.
+  cache.Put(MakeKey(4), MakeStreet(vector<uint32_t>(100, 0)));
+  TEST(!cache.Get(MakeKey(4)), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+}
+}  // namespace
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class DataSource;
 
@@ -28,6 +29,18 @@ public:
 
   std::weak_ptr<search::ProcessorHandle> Search(search::SearchParams const & params);
 
+  void SearchBatch(std::vector<search::SearchParams> const & batch,
+                   Engine::OnBatchResults const & onResults)
+  {
+    m_engine.SearchBatch(batch, onResults);
+  }
+
+  SearchStats::Snapshot GetSearchStats() const { return m_engine.GetSearchStats(); }
+  StreetVicinityCache::Stats GetStreetVicinityCacheStats() const
+  {
+    return m_engine.GetStreetVicinityCacheStats();
+  }
+
   storage::CountryInfoGetter & GetCountryInfoGetter() { return *m_infoGetter; }
 
 private:
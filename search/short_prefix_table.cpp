@@ -0,0 +1,132 @@
+#include "search/short_prefix_table.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+uint64_t constexpr kHeaderSize = sizeof(uint8_t) + sizeof(uint32_t);
+}  // namespace
+
+// ShortPrefixTable::Key ---------------------------------------------------------------------------
+ShortPrefixTable::Key::Key(uint8_t lang, strings::UniString const & prefix) : m_lang(lang)
+{
+  ASSERT(IsShortPrefix(prefix), (prefix));
+  copy(prefix.begin(), prefix.end(), m_chars.begin());
+}
+
+// ShortPrefixTable::Builder -----------------------------------------------------------------------
+void ShortPrefixTable::Builder::Add(uint8_t lang, strings::UniString const & token,
+                                    uint32_t featureId, uint8_t rank)
+{
+  for (size_t length = 1; length <= min(token.size(), kMaxPrefixLength); ++length)
+  {
+    strings::UniString const prefix(token.begin(), token.begin() + length);
+    auto & features = m_features[Key(lang, prefix)];
+    features.emplace(rank, featureId);
+    if (features.size() > kMaxNumFeatures)
+      features.erase(prev(features.end()));
+  }
+}
+
+// ShortPrefixTable --------------------------------------------------------------------------------
+uint8_t constexpr ShortPrefixTable::kLatestVersion;
+size_t constexpr ShortPrefixTable::kMaxPrefixLength;
+size_t constexpr ShortPrefixTable::kMaxNumFeatures;
+size_t constexpr ShortPrefixTable::kKeySize;
+
+ShortPrefixTable::ShortPrefixTable(unique_ptr<Reader> reader, uint32_t numKeys)
+  : m_reader(move(reader)), m_numKeys(numKeys)
+{
+}
+
+// static
+unique_ptr<ShortPrefixTable> ShortPrefixTable::Load(MwmValue const & value)
+{
+  if (!value.m_cont.IsExist(SHORT_PREFIXES_FILE_TAG))
+    return {};
+
+  auto const reader = value.m_cont.GetReader(SHORT_PREFIXES_FILE_TAG);
+  return Load(reader.GetPtr()->CreateSubReader(0 /* pos */, reader.Size()));
+}
+
+// static
+unique_ptr<ShortPrefixTable> ShortPrefixTable::Load(unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  if (reader->Size() < kHeaderSize)
+    return {};
+
+  auto const version = ReadPrimitiveFromPos<uint8_t>(*reader, 0 /* pos */);
+  if (version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unknown short prefixes table version:", version));
+    return {};
+  }
+
+  auto const numKeys = ReadPrimitiveFromPos<uint32_t>(*reader, sizeof(uint8_t));
+  if (reader->Size() < kHeaderSize + static_cast<uint64_t>(numKeys) * kKeySize)
+    return {};
+
+  return unique_ptr<ShortPrefixTable>(new ShortPrefixTable(move(reader), numKeys));
+}
+
+void ShortPrefixTable::GetFeatures(uint8_t lang, strings::UniString const & prefix,
+                                   vector<uint32_t> & features) const
+{
+  if (!IsShortPrefix(prefix))
+    return;
+
+  Key const key(lang, prefix);
+  uint32_t offset = 0;
+
+  // Binary search for the first key which is not less than |key|.
+  uint32_t lo = 0;
+  uint32_t hi = m_numKeys;
+  while (lo < hi)
+  {
+    uint32_t const mid = lo + (hi - lo) / 2;
+    if (ReadKey(mid, offset) < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (lo == m_numKeys || !(ReadKey(lo, offset) == key))
+    return;
+
+  uint64_t const listsPos = kHeaderSize + static_cast<uint64_t>(m_numKeys) * kKeySize;
+  NonOwningReaderSource src(*m_reader);
+  src.Skip(listsPos + offset);
+
+  auto const numFeatures = ReadVarUint<uint32_t>(src);
+  uint32_t id = 0;
+  for (uint32_t i = 0; i < numFeatures; ++i)
+  {
+    id += ReadVarUint<uint32_t>(src);
+    features.push_back(id);
+  }
+}
+
+ShortPrefixTable::Key ShortPrefixTable::ReadKey(uint32_t i, uint32_t & offset) const
+{
+  ASSERT_LESS(i, m_numKeys, ());
+  NonOwningReaderSource src(*m_reader);
+  src.Skip(kHeaderSize + static_cast<uint64_t>(i) * kKeySize);
+
+  Key key;
+  key.m_lang = ReadPrimitiveFromSource<uint8_t>(src);
+  for (auto & c : key.m_chars)
+    c = ReadPrimitiveFromSource<strings::UniChar>(src);
+  offset = ReadPrimitiveFromSource<uint32_t>(src);
+  return key;
+}
+}  // namespace search
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/checked_cast.hpp"
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+class MwmValue;
+
+namespace search
+{
+// Table of the best ranked features for every short prefix of tokens of feature names in
+// every language of an mwm. Single short prefixes match a large part of an mwm, so queries
+// consisting of such a prefix are answered from the table instead of the search index.
+//
+// Layout: header is version and number of keys, keys are sorted records of fixed size
+// (language, kMaxPrefixLength chars of the prefix padded with zeroes and offset of the
+// features list), every features list is number of features and deltas of sorted feature
+// ids. All the numbers in the lists are varints.
+class ShortPrefixTable
+{
+public:
+  static uint8_t constexpr kLatestVersion = 0;
+  static size_t constexpr kMaxPrefixLength = 3;
+  static size_t constexpr kMaxNumFeatures = 32;
+
+  struct Key
+  {
+    Key() = default;
+    Key(uint8_t lang, strings::UniString const & prefix);
+
+    bool operator<(Key const & rhs) const
+    {
+      if (m_lang != rhs.m_lang)
+        return m_lang < rhs.m_lang;
+      return m_chars < rhs.m_chars;
+    }
+
+    bool operator==(Key const & rhs) const
+    {
+      return m_lang == rhs.m_lang && m_chars == rhs.m_chars;
+    }
+
+    uint8_t m_lang = 0;
+    std::array<strings::UniChar, kMaxPrefixLength> m_chars = {};
+  };
+
+  static size_t constexpr kKeySize =
+      sizeof(uint8_t) + kMaxPrefixLength * sizeof(strings::UniChar) + sizeof(uint32_t);
+
+  class Builder
+  {
+  public:
+    // Adds all short prefixes of |token| including the token itself if it's short.
+    void Add(uint8_t lang, strings::UniString const & token, uint32_t featureId, uint8_t rank);
+
+    template <typename Sink>
+    void Serialize(Sink & sink) const
+    {
+      WriteToSink(sink, kLatestVersion);
+      WriteToSink(sink, base::checked_cast<uint32_t>(m_features.size()));
+
+      std::vector<uint8_t> lists;
+      {
+        MemWriter<std::vector<uint8_t>> writer(lists);
+        for (auto const & entry : m_features)
+        {
+          auto const & key = entry.first;
+          WriteToSink(sink, key.m_lang);
+          for (auto const c : key.m_chars)
+            WriteToSink(sink, c);
+          WriteToSink(sink, base::checked_cast<uint32_t>(lists.size()));
+
+          std::vector<uint32_t> ids;
+          for (auto const & feature : entry.second)
+            ids.push_back(feature.second);
+          std::sort(ids.begin(), ids.end());
+
+          WriteVarUint(writer, base::checked_cast<uint32_t>(ids.size()));
+          uint32_t prev = 0;
+          for (auto const id : ids)
+          {
+            WriteVarUint(writer, id - prev);
+            prev = id;
+          }
+        }
+      }
+      sink.Write(lists.data(), lists.size());
+    }
+
+  private:
+    using RankAndId = std::pair<uint8_t, uint32_t>;
+
+    // Orders features by decreasing ranks, then by increasing ids.
+    struct BetterFeature
+    {
+      bool operator()(RankAndId const & lhs, RankAndId const & rhs) const
+      {
+        if (lhs.first != rhs.first)
+          return lhs.first > rhs.first;
+        return lhs.second < rhs.second;
+      }
+    };
+
+    using Features = std::set<RankAndId, BetterFeature>;
+
+    std::map<Key, Features> m_features;
+  };
+
+  // Returns nullptr when there is no table in the mwm or the table has an unknown version.
+  static std::unique_ptr<ShortPrefixTable> Load(MwmValue const & value);
+  static std::unique_ptr<ShortPrefixTable> Load(std::unique_ptr<Reader> reader);
+
+  static bool IsShortPrefix(strings::UniString const & s)
+  {
+    return !s.empty() && s.size() <= kMaxPrefixLength;
+  }
+
+  // Appends to |features| the best ranked features having a token with |prefix| in |lang|.
+  // Feature ids of a prefix are appended in increasing order.
+  void GetFeatures(uint8_t lang, strings::UniString const & prefix,
+                   std::vector<uint32_t> & features) const;
+
+  uint32_t GetNumKeys() const { return m_numKeys; }
+
+private:
+  ShortPrefixTable(std::unique_ptr<Reader> reader, uint32_t numKeys);
+
+  Key ReadKey(uint32_t i, uint32_t & offset) const;
+
+  std::unique_ptr<Reader> m_reader;
+  uint32_t m_numKeys = 0;
+
+  DISALLOW_COPY_AND_MOVE(ShortPrefixTable);
+};
+}  // namespace search
@@ -0,0 +1,129 @@
+#include "search/street_vicinity_cache.hpp"
+
+#include "search/projection_on_street.hpp"
+
+#include "base/assert.hpp"
+
+#include <sstream>
+#include <tuple>
+
+using namespace std;
+
+namespace search
+{
+// StreetVicinityCache::Key ------------------------------------------------------------------------
+bool StreetVicinityCache::Key::operator<(Key const & rhs) const
+{
+  return tie(m_mwmId, m_mwmVersion, m_featureId, m_scale, m_offsetMeters) <
+         tie(rhs.m_mwmId, rhs.m_mwmVersion, rhs.m_featureId, rhs.m_scale, rhs.m_offsetMeters);
+}
+
+// StreetVicinityCache -----------------------------------------------------------------------------
+size_t constexpr StreetVicinityCache::kDefaultMaxSizeBytes;
+
+StreetVicinityCache::StreetVicinityCache(size_t maxSizeBytes) : m_maxSizeBytes(maxSizeBytes) {}
+
+shared_ptr<StreetVicinityCache::Street const> StreetVicinityCache::Get(Key const & key)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return {};
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void StreetVicinityCache::Put(Key const & key, shared_ptr<Street const> street)
+{
+  CHECK(street, ());
+  size_t const sizeBytes = GetSizeBytes(*street);
+  if (sizeBytes > m_maxSizeBytes)
+    return;
+
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it->second);
+
+  while (!m_entries.empty() && m_sizeBytes + sizeBytes > m_maxSizeBytes)
+  {
+    Erase(prev(m_entries.end()));
+    ++m_stats.m_evictions;
+  }
+
+  m_entries.emplace_front(key, move(street));
+  m_index.emplace(key, m_entries.begin());
+  m_sizeBytes += sizeBytes;
+}
+
+void StreetVicinityCache::SetMaxSizeBytes(size_t maxSizeBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_maxSizeBytes = maxSizeBytes;
+  while (!m_entries.empty() && m_sizeBytes > maxSizeBytes)
+  {
+    Erase(prev(m_entries.end()));
+    ++m_stats.m_evictions;
+  }
+}
+
+void StreetVicinityCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+  m_sizeBytes = 0;
+}
+
+StreetVicinityCache::Stats StreetVicinityCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+
+size_t StreetVicinityCache::GetSizeBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_sizeBytes;
+}
+
+size_t StreetVicinityCache::GetNumEntries() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+// static
+size_t StreetVicinityCache::GetSizeBytes(Street const & street)
+{
+  size_t sizeBytes = sizeof(Street) + street.m_features.size() * sizeof(uint32_t);
+  if (street.m_calculator)
+    sizeBytes += street.m_calculator->GetSizeBytes();
+  return sizeBytes;
+}
+
+void StreetVicinityCache::Erase(Entries::iterator it)
+{
+  size_t const sizeBytes = GetSizeBytes(*it->second);
+  ASSERT_GREATER_OR_EQUAL(m_sizeBytes, sizeBytes, ());
+  m_sizeBytes -= sizeBytes;
+  m_index.erase(it->first);
+  m_entries.erase(it);
+}
+
+string DebugPrint(StreetVicinityCache::Stats const & stats)
+{
+  ostringstream os;
+  os << "StreetVicinityCache::Stats [";
+  os << "hits: " << stats.m_hits << ", ";
+  os << "misses: " << stats.m_misses << ", ";
+  os << "evictions: " << stats.m_evictions;
+  os << "]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "search/street_vicinity_loader.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/macros.hpp"
+#include "base/memory_budget.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace search
+{
+// Thread-safe LRU cache of streets' vicinities. It's shared by all processors of an engine,
+// so features around popular streets are not collected again for every query.
+//
+// Streets are immutable once they are put to the cache, so they may be used by several
+// threads at once. A user of the cache must hold the returned pointer while
+// the street is used, because the entry may be evicted by other threads.
+class StreetVicinityCache : public base::MemoryBudget::Client
+{
+public:
+  using Street = StreetVicinityLoader::Street;
+
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    MwmSet::MwmId m_mwmId;
+    int64_t m_mwmVersion = 0;
+    uint32_t m_featureId = 0;
+    int m_scale = 0;
+    double m_offsetMeters = 0.0;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  static size_t constexpr kDefaultMaxSizeBytes = 8 * 1024 * 1024;
+
+  explicit StreetVicinityCache(size_t maxSizeBytes = kDefaultMaxSizeBytes);
+
+  // Returns a street cached for |key| or nullptr if there is no entry for |key|.
+  std::shared_ptr<Street const> Get(Key const & key);
+
+  // Evicts least recently used entries if the cache exceeds the size limit. Streets
+  // larger than the limit aren't cached.
+  void Put(Key const & key, std::shared_ptr<Street const> street);
+
+  void Clear();
+
+  // Evicts least recently used entries if the cache exceeds the new limit.
+  void SetMaxSizeBytes(size_t maxSizeBytes);
+
+  Stats GetStats() const;
+  size_t GetSizeBytes() const;
+  size_t GetNumEntries() const;
+
+  // base::MemoryBudget::Client overrides:
+  void OnBudgetChanged(size_t budgetBytes) override { SetMaxSizeBytes(budgetBytes); }
+
+  // Returns an estimate of the memory taken by |street|.
+  static size_t GetSizeBytes(Street const & street);
+
+private:
+  // Most recently used entries are at the front.
+  using Entries = std::list<std::pair<Key, std::shared_ptr<Street const>>>;
+
+  void Erase(Entries::iterator it);
+
+  std::atomic<size_t> m_maxSizeBytes;
+
+  mutable std::mutex m_mutex;
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  size_t m_sizeBytes = 0;
+  Stats m_stats;
+
+  DISALLOW_COPY_AND_MOVE(StreetVicinityCache);
+};
+
+std::string DebugPrint(StreetVicinityCache::Stats const & stats);
+}  // namespace search
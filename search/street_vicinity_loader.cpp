@@ -1,5 +1,7 @@
 #include "search/street_vicinity_loader.hpp"
 
+#include "search/street_vicinity_cache.hpp"
+
 #include "indexer/cell_id.hpp"
 #include "indexer/feature_covering.hpp"
 #include "indexer/feature_decl.hpp"
@@ -12,8 +14,13 @@
 
 namespace search
 {
-StreetVicinityLoader::StreetVicinityLoader(int scale, double offsetMeters)
-  : m_context(nullptr), m_scale(scale), m_offsetMeters(offsetMeters), m_cache("Streets")
+StreetVicinityLoader::StreetVicinityLoader(int scale, double offsetMeters,
+                                           StreetVicinityCache & sharedCache)
+  : m_context(nullptr)
+  , m_scale(scale)
+  , m_offsetMeters(offsetMeters)
+  , m_cache("Streets")
+  , m_sharedCache(sharedCache)
 {
 }
 
@@ -34,10 +41,24 @@ StreetVicinityLoader::Street const & StreetVicinityLoader::GetStreet(uint32_t fe
 {
   auto r = m_cache.Get(featureId);
   if (!r.second)
-    return r.first;
-
-  LoadStreet(featureId, r.first);
-  return r.first;
+    return *r.first;
+
+  StreetVicinityCache::Key key;
+  key.m_mwmId = m_context->GetId();
+  key.m_mwmVersion = m_context->GetInfo()->GetVersion();
+  key.m_featureId = featureId;
+  key.m_scale = m_scale;
+  key.m_offsetMeters = m_offsetMeters;
+
+  r.first = m_sharedCache.Get(key);
+  if (!r.first)
+  {
+    auto street = make_shared<Street>();
+    LoadStreet(featureId, *street);
+    r.first = street;
+    m_sharedCache.Put(key, r.first);
+  }
+  return *r.first;
 }
 
 void StreetVicinityLoader::LoadStreet(uint32_t featureId, Street & street)
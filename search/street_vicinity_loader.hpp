@@ -11,13 +11,16 @@
 
 #include "base/macros.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/unordered_map.hpp"
 
 namespace search
 {
 class MwmContext;
+class StreetVicinityCache;
 
-// This class is able to load features in a street's vicinity.
+// This class is able to load features in a street's vicinity. Loaded
+// streets are shared with other loaders via |sharedCache|.
 //
 // NOTE: this class *IS NOT* thread-safe.
 class StreetVicinityLoader
@@ -40,7 +43,7 @@ public:
     DISALLOW_COPY(Street);
   };
 
-  StreetVicinityLoader(int scale, double offsetMeters);
+  StreetVicinityLoader(int scale, double offsetMeters, StreetVicinityCache & sharedCache);
   void SetContext(MwmContext * context);
 
   // Calls |fn| on each index in |sortedIds| where sortedIds[index]
@@ -87,7 +90,10 @@ private:
   int m_scale;
   double const m_offsetMeters;
 
-  Cache<uint32_t, Street> m_cache;
+  // Streets used by the current query. They are held here because entries
+  // of |m_sharedCache| may be evicted by other threads.
+  Cache<uint32_t, shared_ptr<Street const>> m_cache;
+  StreetVicinityCache & m_sharedCache;
 
   DISALLOW_COPY_AND_MOVE(StreetVicinityLoader);
 };
@@ -3,6 +3,7 @@
 #include "search/categories_cache.hpp"
 #include "search/features_filter.hpp"
 #include "search/geometry_cache.hpp"
+#include "search/levenshtein_dfa_cache.hpp"
 #include "search/mwm_context.hpp"
 
 #include "indexer/data_source.hpp"
@@ -50,6 +51,14 @@ strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s)
   return strings::LevenshteinDFA(s, 1 /* prefixSize */, kAllowedMisprints, GetMaxErrorsForToken(s));
 }
 
+shared_ptr<strings::LevenshteinDFA const> GetLevenshteinDFA(strings::UniString const & s)
+{
+  static LevenshteinDFACache cache([](strings::UniString const & s, size_t maxErrors) {
+    return strings::LevenshteinDFA(s, 1 /* prefixSize */, kAllowedMisprints, maxErrors);
+  });
+  return cache.Get(s, GetMaxErrorsForToken(s));
+}
+
 vector<uint32_t> GetCategoryTypes(string const & name, string const & locale,
                                   CategoriesHolder const & categories)
 {
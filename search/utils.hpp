@@ -32,6 +32,9 @@ size_t GetMaxErrorsForToken(strings::UniString const & token);
 
 strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s);
 
+// Returns a DFA built by BuildLevenshteinDFA(|s|) from a cache shared by all threads.
+std::shared_ptr<strings::LevenshteinDFA const> GetLevenshteinDFA(strings::UniString const & s);
+
 template <typename ToDo>
 void ForEachCategoryType(StringSliceBase const & slice, Locales const & locales,
                          CategoriesHolder const & categories, ToDo && todo)
@@ -68,11 +71,9 @@ void ForEachCategoryTypeFuzzy(StringSliceBase const & slice, Locales const & loc
 
   for (size_t i = 0; i < slice.Size(); ++i)
   {
-    // todo(@m, @y). We build dfa twice for each token: here and in geocoder.cpp.
-    // A possible optimization is to build each dfa once and save it. Note that
-    // dfas for the prefix tokens differ, i.e. we ignore slice.IsPrefix(i) here.
+    // Note that dfas for the prefix tokens differ, i.e. we ignore slice.IsPrefix(i) here.
     SearchTrieRequest<strings::LevenshteinDFA> request;
-    request.m_names.push_back(BuildLevenshteinDFA(slice.Get(i)));
+    request.m_names.push_back(*GetLevenshteinDFA(slice.Get(i)));
     request.SetLangs(locales);
 
     MatchFeaturesInTrie(request, iterator, [&](uint32_t /* type */) { return true; } /* filter */,
@@ -6,6 +6,7 @@
 #include "drape/pointers.hpp"
 
 #include <map>
+#include <set>
 #include <string>
 
 namespace gpu
@@ -34,7 +35,8 @@ private:
   drape_ptr<dp::GpuProgram> Get(std::string const & programName,
                                 std::string const & vertexShaderName,
                                 std::string const & fragmentShaderName,
-                                std::map<uint8_t, uint8_t> const & layout);
+                                std::map<uint8_t, uint8_t> const & layout,
+                                std::set<uint8_t> const & packedAttributes);
   
   id<MTLFunction> GetFunction(std::string const & name);
   id<MTLDevice> m_device;
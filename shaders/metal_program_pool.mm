@@ -6,6 +6,7 @@
 #include "base/assert.hpp"
 
 #include <cstdint>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -18,16 +19,22 @@ namespace
 struct ProgramInfo
 {
   using Layout = std::map<uint8_t, uint8_t>;
+  using PackedAttributes = std::set<uint8_t>;
   std::string const m_vertexShaderName;
   std::string const m_fragmentShaderName;
   Layout m_layout;
+  PackedAttributes m_packedAttributes;
   
   // Layout is in the format { buffer0, buffer1, ..., bufferN }.
   // bufferX is a pair { start attribute index, end attribute index }.
+  // Packed attributes are float2 attributes which are stored as normalized ushort2,
+  // see dp::IsPackedAttribute().
   ProgramInfo(std::string && vertexShaderName, std::string && fragmentShaderName,
-              std::vector<std::pair<uint8_t, uint8_t>> const & layout)
+              std::vector<std::pair<uint8_t, uint8_t>> const & layout,
+              PackedAttributes && packedAttributes = {})
     : m_vertexShaderName(std::move(vertexShaderName))
     , m_fragmentShaderName(std::move(fragmentShaderName))
+    , m_packedAttributes(std::move(packedAttributes))
   {
     for (size_t i = 0; i < layout.size(); i++)
     {
@@ -57,11 +64,11 @@ std::array<ProgramInfo, static_cast<size_t>(Program::ProgramsCount)> const kMeta
   ProgramInfo("vsText", "fsTextFixed", {{0, 1}, {2, 3}}),  // TextFixed
   ProgramInfo("vsTextStaticOutlinedGui", "fsTextOutlinedGui", {{0, 2}, {3, 4}}),  // TextStaticOutlinedGui
   ProgramInfo("vsTextOutlinedGui", "fsTextOutlinedGui", {{0, 2}, {3, 4}}),  // TextOutlinedGui
-  ProgramInfo("vsArea", "fsArea", {{0, 1}}),  // Area
-  ProgramInfo("vsArea", "fsArea", {{0, 1}}),  // AreaOutline
+  ProgramInfo("vsArea", "fsArea", {{0, 1}}, {1}),  // Area
+  ProgramInfo("vsArea", "fsArea", {{0, 1}}, {1}),  // AreaOutline
   ProgramInfo("vsArea3d", "fsArea3d", {{0, 2}}),  // Area3d
-  ProgramInfo("vsArea3dOutline", "fsArea", {{0, 1}}),  // Area3dOutline
-  ProgramInfo("vsLine", "fsLine", {{0, 2}}),  // Line
+  ProgramInfo("vsArea3dOutline", "fsArea", {{0, 1}}, {1}),  // Area3dOutline
+  ProgramInfo("vsLine", "fsLine", {{0, 2}}, {2}),  // Line
   ProgramInfo("vsCapJoin", "fsCapJoin", {{0, 2}}),  // CapJoin
   ProgramInfo("vsTransitCircle", "fsTransitCircle", {{0, 2}}),  // TransitCircle
   ProgramInfo("vsDashedLine", "fsDashedLine", {{0, 3}}),  // DashedLine
@@ -158,7 +165,8 @@ void GetBindings(NSArray<MTLArgument *> * arguments, int8_t & uniformsBindingInd
   }
 }
   
-MTLVertexDescriptor * GetVertexDescriptor(id<MTLFunction> vertexShader, ProgramInfo::Layout const & layout)
+MTLVertexDescriptor * GetVertexDescriptor(id<MTLFunction> vertexShader, ProgramInfo::Layout const & layout,
+                                          ProgramInfo::PackedAttributes const & packedAttributes)
 {
   MTLVertexDescriptor * vertexDesc = [[MTLVertexDescriptor alloc] init];
   uint32_t offset = 0;
@@ -177,7 +185,13 @@ MTLVertexDescriptor * GetVertexDescriptor(id<MTLFunction> vertexShader, ProgramI
     }
     MTLVertexAttributeDescriptor * attrDesc = vertexDesc.attributes[attr.attributeIndex];
     attrDesc.format = GetFormatByDataType(attr.attributeType);
-    auto const sz = GetSizeByDataType(attr.attributeType);
+    auto sz = GetSizeByDataType(attr.attributeType);
+    if (packedAttributes.find(attrIndex) != packedAttributes.cend())
+    {
+      CHECK(attr.attributeType == MTLDataTypeFloat2, ("Only float2 attributes can be packed."));
+      attrDesc.format = MTLVertexFormatUShort2Normalized;
+      sz = 2 * sizeof(uint16_t);
+    }
     attrDesc.offset = offset;
     offset += sz;
     sizes[bufferIndex] += sz;
@@ -230,26 +244,29 @@ MetalProgramPool::~MetalProgramPool()
 drape_ptr<dp::GpuProgram> MetalProgramPool::GetSystemProgram(SystemProgram program)
 {
   auto const & info = kMetalSystemProgramsInfo[static_cast<size_t>(program)];
-  return Get(DebugPrint(program), info.m_vertexShaderName, info.m_fragmentShaderName, info.m_layout);
+  return Get(DebugPrint(program), info.m_vertexShaderName, info.m_fragmentShaderName, info.m_layout,
+             info.m_packedAttributes);
 }
   
 drape_ptr<dp::GpuProgram> MetalProgramPool::Get(Program program)
 {
   auto const & info = kMetalProgramsInfo[static_cast<size_t>(program)];
-  return Get(DebugPrint(program), info.m_vertexShaderName, info.m_fragmentShaderName, info.m_layout);
+  return Get(DebugPrint(program), info.m_vertexShaderName, info.m_fragmentShaderName, info.m_layout,
+             info.m_packedAttributes);
 }
   
 drape_ptr<dp::GpuProgram> MetalProgramPool::Get(std::string const & programName,
                                                 std::string const & vertexShaderName,
                                                 std::string const & fragmentShaderName,
-                                                std::map<uint8_t, uint8_t> const & layout)
+                                                std::map<uint8_t, uint8_t> const & layout,
+                                                std::set<uint8_t> const & packedAttributes)
 {
   CHECK(!vertexShaderName.empty(), ());
   CHECK(!fragmentShaderName.empty(), ());
   
   id<MTLFunction> vertexShader = GetFunction(vertexShaderName);
   id<MTLFunction> fragmentShader = GetFunction(fragmentShaderName);
-  MTLVertexDescriptor * vertexDesc = GetVertexDescriptor(vertexShader, layout);
+  MTLVertexDescriptor * vertexDesc = GetVertexDescriptor(vertexShader, layout, packedAttributes);
 
   // Reflect functions.
   MTLRenderPipelineDescriptor * desc = [[MTLRenderPipelineDescriptor alloc] init];
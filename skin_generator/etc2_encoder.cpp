@@ -0,0 +1,332 @@
+#include "etc2_encoder.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace tools
+{
+namespace
+{
+uint32_t constexpr kBlockSize = 4;
+uint32_t constexpr kPixelsInBlock = kBlockSize * kBlockSize;
+uint32_t constexpr kBlockBytes = 16;
+
+// Modifiers of ETC1 colors, the pixel index selects +a, +b, -a, -b.
+int const kEtcModifiers[8][2] = {{2, 8},   {5, 17},  {9, 29},  {13, 42},
+                                 {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+int const kEacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+// Pixels of a block are in column order as in ETC format: pixel i has x = i / 4, y = i % 4.
+struct Block
+{
+  std::array<std::array<int, 3>, kPixelsInBlock> m_colors;
+  std::array<int, kPixelsInBlock> m_alpha;
+};
+
+int Clamp(int value) { return std::min(255, std::max(0, value)); }
+
+void WriteBigEndian(uint64_t value, uint8_t * out)
+{
+  for (int i = 7; i >= 0; --i)
+  {
+    out[i] = static_cast<uint8_t>(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+int GetModifier(int table, int index)
+{
+  int const m = kEtcModifiers[table][index & 1];
+  return index < 2 ? m : -m;
+}
+
+uint64_t EncodeAlpha(Block const & block)
+{
+  auto const minmax = std::minmax_element(block.m_alpha.begin(), block.m_alpha.end());
+  int const minAlpha = *minmax.first;
+  int const maxAlpha = *minmax.second;
+
+  int bestBase = minAlpha;
+  int bestMultiplier = 1;
+  // The table has zero modifier, so a constant alpha is encoded exactly.
+  int bestTable = 13;
+  uint64_t bestError = std::numeric_limits<uint64_t>::max();
+  if (minAlpha != maxAlpha)
+  {
+    for (int table = 0; table < 16; ++table)
+    {
+      int const tableMin = kEacModifiers[table][3];
+      int const span = kEacModifiers[table][7] - tableMin;
+      int const multiplier = static_cast<int>(std::lround(double(maxAlpha - minAlpha) / span));
+      for (int m = std::max(1, multiplier - 1); m <= std::min(15, multiplier + 1); ++m)
+      {
+        int const base = Clamp(minAlpha - tableMin * m);
+        for (int b = std::max(0, base - 1); b <= std::min(255, base + 1); ++b)
+        {
+          uint64_t error = 0;
+          for (int a : block.m_alpha)
+          {
+            int minDiff = std::numeric_limits<int>::max();
+            for (int modifier : kEacModifiers[table])
+              minDiff = std::min(minDiff, std::abs(Clamp(b + modifier * m) - a));
+            error += minDiff * minDiff;
+          }
+          if (error < bestError)
+          {
+            bestError = error;
+            bestBase = b;
+            bestMultiplier = m;
+            bestTable = table;
+          }
+        }
+      }
+    }
+  }
+
+  uint64_t result = (static_cast<uint64_t>(bestBase) << 56) |
+                    (static_cast<uint64_t>(bestMultiplier) << 52) |
+                    (static_cast<uint64_t>(bestTable) << 48);
+  for (uint32_t i = 0; i < kPixelsInBlock; ++i)
+  {
+    int bestIndex = 0;
+    int minDiff = std::numeric_limits<int>::max();
+    for (int index = 0; index < 8; ++index)
+    {
+      int const diff =
+          std::abs(Clamp(bestBase + kEacModifiers[bestTable][index] * bestMultiplier) -
+                   block.m_alpha[i]);
+      if (diff < minDiff)
+      {
+        minDiff = diff;
+        bestIndex = index;
+      }
+    }
+    result |= static_cast<uint64_t>(bestIndex) << (45 - 3 * i);
+  }
+  return result;
+}
+
+struct SubblockEncoding
+{
+  int m_table = 0;
+  std::array<int, kPixelsInBlock> m_indices = {};
+  uint64_t m_error = 0;
+};
+
+bool IsInSubblock(uint32_t pixel, bool flip, int subblock)
+{
+  uint32_t const coord = flip ? pixel % kBlockSize : pixel / kBlockSize;
+  return (coord >= kBlockSize / 2) == (subblock == 1);
+}
+
+// Colors of transparent pixels are less important, but they are still taken into account
+// because of texture filtering.
+int GetWeight(Block const & block, uint32_t pixel) { return block.m_alpha[pixel] + 1; }
+
+SubblockEncoding EncodeSubblock(Block const & block, bool flip, int subblock,
+                                std::array<int, 3> const & base)
+{
+  SubblockEncoding best;
+  best.m_error = std::numeric_limits<uint64_t>::max();
+  for (int table = 0; table < 8; ++table)
+  {
+    SubblockEncoding encoding;
+    encoding.m_table = table;
+    for (uint32_t i = 0; i < kPixelsInBlock; ++i)
+    {
+      if (!IsInSubblock(i, flip, subblock))
+        continue;
+
+      uint64_t minError = std::numeric_limits<uint64_t>::max();
+      for (int index = 0; index < 4; ++index)
+      {
+        uint64_t error = 0;
+        for (size_t c = 0; c < 3; ++c)
+        {
+          int const diff = Clamp(base[c] + GetModifier(table, index)) - block.m_colors[i][c];
+          error += diff * diff;
+        }
+        if (error < minError)
+        {
+          minError = error;
+          encoding.m_indices[i] = index;
+        }
+      }
+      encoding.m_error += minError * GetWeight(block, i);
+    }
+
+    if (encoding.m_error < best.m_error)
+      best = encoding;
+  }
+  return best;
+}
+
+std::array<double, 3> GetAverageColor(Block const & block, bool flip, int subblock)
+{
+  std::array<double, 3> sum = {};
+  double weights = 0.0;
+  for (uint32_t i = 0; i < kPixelsInBlock; ++i)
+  {
+    if (!IsInSubblock(i, flip, subblock))
+      continue;
+    double const w = GetWeight(block, i);
+    for (size_t c = 0; c < 3; ++c)
+      sum[c] += w * block.m_colors[i][c];
+    weights += w;
+  }
+  for (auto & s : sum)
+    s /= weights;
+  return sum;
+}
+
+uint64_t EncodeColors(Block const & block)
+{
+  uint64_t bestResult = 0;
+  uint64_t bestError = std::numeric_limits<uint64_t>::max();
+  for (bool const flip : {false, true})
+  {
+    std::array<std::array<int, 3>, 2> colors4;
+    std::array<std::array<int, 3>, 2> colors5;
+    for (int s = 0; s < 2; ++s)
+    {
+      auto const average = GetAverageColor(block, flip, s);
+      for (size_t c = 0; c < 3; ++c)
+      {
+        colors4[s][c] = static_cast<int>(std::lround(average[c] * 15.0 / 255.0));
+        colors5[s][c] = static_cast<int>(std::lround(average[c] * 31.0 / 255.0));
+      }
+    }
+
+    bool canBeDifferential = true;
+    for (size_t c = 0; c < 3; ++c)
+    {
+      int const diff = colors5[1][c] - colors5[0][c];
+      canBeDifferential = canBeDifferential && diff >= -4 && diff <= 3;
+    }
+
+    for (bool const differential : {false, true})
+    {
+      if (differential && !canBeDifferential)
+        continue;
+
+      std::array<SubblockEncoding, 2> encodings;
+      uint64_t header = 0;
+      for (int s = 0; s < 2; ++s)
+      {
+        std::array<int, 3> base;
+        for (size_t c = 0; c < 3; ++c)
+        {
+          int const v = differential ? colors5[s][c] : colors4[s][c];
+          base[c] = differential ? (v << 3) | (v >> 2) : (v << 4) | v;
+        }
+        encodings[s] = EncodeSubblock(block, flip, s, base);
+      }
+
+      uint64_t const error = encodings[0].m_error + encodings[1].m_error;
+      if (error >= bestError)
+        continue;
+
+      for (size_t c = 0; c < 3; ++c)
+      {
+        uint64_t const channel =
+            differential ? (static_cast<uint64_t>(colors5[0][c]) << 3) |
+                               ((colors5[1][c] - colors5[0][c]) & 0x7)
+                         : (static_cast<uint64_t>(colors4[0][c]) << 4) | colors4[1][c];
+        header |= channel << (56 - 8 * c);
+      }
+      header |= static_cast<uint64_t>(encodings[0].m_table) << 37;
+      header |= static_cast<uint64_t>(encodings[1].m_table) << 34;
+      header |= static_cast<uint64_t>(differential ? 1 : 0) << 33;
+      header |= static_cast<uint64_t>(flip ? 1 : 0) << 32;
+
+      for (uint32_t i = 0; i < kPixelsInBlock; ++i)
+      {
+        int const index = encodings[IsInSubblock(i, flip, 1) ? 1 : 0].m_indices[i];
+        header |= static_cast<uint64_t>(index >> 1) << (16 + i);
+        header |= static_cast<uint64_t>(index & 1) << i;
+      }
+
+      bestError = error;
+      bestResult = header;
+    }
+  }
+  return bestResult;
+}
+
+void WriteUint32(std::ofstream & stream, uint32_t value)
+{
+  uint8_t const bytes[] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                           static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+  stream.write(reinterpret_cast<char const *>(bytes), sizeof(bytes));
+}
+}  // namespace
+
+std::vector<uint8_t> EncodeETC2RGBA8(uint8_t const * rgba, uint32_t width, uint32_t height)
+{
+  CHECK_EQUAL(width % kBlockSize, 0, ());
+  CHECK_EQUAL(height % kBlockSize, 0, ());
+
+  std::vector<uint8_t> result(width * height / kPixelsInBlock * kBlockBytes);
+  uint8_t * out = result.data();
+  for (uint32_t by = 0; by < height; by += kBlockSize)
+  {
+    for (uint32_t bx = 0; bx < width; bx += kBlockSize)
+    {
+      Block block;
+      for (uint32_t i = 0; i < kPixelsInBlock; ++i)
+      {
+        uint8_t const * p = rgba + ((by + i % kBlockSize) * width + bx + i / kBlockSize) * 4;
+        block.m_colors[i] = {{p[0], p[1], p[2]}};
+        block.m_alpha[i] = p[3];
+      }
+
+      WriteBigEndian(EncodeAlpha(block), out);
+      WriteBigEndian(EncodeColors(block), out + 8);
+      out += kBlockBytes;
+    }
+  }
+  return result;
+}
+
+bool WriteKtx(std::string const & fileName, std::vector<uint8_t> const & blocks, uint32_t width,
+              uint32_t height)
+{
+  std::ofstream stream(fileName, std::ios::binary | std::ios::trunc);
+  if (!stream)
+    return false;
+
+  uint8_t const kIdentifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  stream.write(reinterpret_cast<char const *>(kIdentifier), sizeof(kIdentifier));
+  WriteUint32(stream, 0x04030201);  // endianness
+  WriteUint32(stream, 0);           // glType, 0 for compressed textures
+  WriteUint32(stream, 1);           // glTypeSize
+  WriteUint32(stream, 0);           // glFormat, 0 for compressed textures
+  WriteUint32(stream, 0x9278);      // glInternalFormat, GL_COMPRESSED_RGBA8_ETC2_EAC
+  WriteUint32(stream, 0x1908);      // glBaseInternalFormat, GL_RGBA
+  WriteUint32(stream, width);
+  WriteUint32(stream, height);
+  WriteUint32(stream, 0);           // pixelDepth
+  WriteUint32(stream, 0);           // numberOfArrayElements
+  WriteUint32(stream, 1);           // numberOfFaces
+  WriteUint32(stream, 1);           // numberOfMipmapLevels
+  WriteUint32(stream, 0);           // bytesOfKeyValueData
+  WriteUint32(stream, static_cast<uint32_t>(blocks.size()));
+  stream.write(reinterpret_cast<char const *>(blocks.data()), blocks.size());
+  return static_cast<bool>(stream);
+}
+}  // namespace tools
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tools
+{
+// Encodes RGBA8 image to ETC2 RGBA8 (GL_COMPRESSED_RGBA8_ETC2_EAC) format. Colors are encoded
+// in ETC1-compatible modes and alpha is encoded by EAC. Width and height must be multiples of 4,
+// |rgba| contains width * height * 4 bytes. Returns width * height bytes of blocks in row order.
+std::vector<uint8_t> EncodeETC2RGBA8(uint8_t const * rgba, uint32_t width, uint32_t height);
+
+// Writes ETC2 RGBA8 image to KTX 1.1 container. Returns false on write error.
+bool WriteKtx(std::string const & fileName, std::vector<uint8_t> const & blocks, uint32_t width,
+              uint32_t height);
+}  // namespace tools
@@ -1,4 +1,5 @@
 #include "generator.hpp"
+#include "etc2_encoder.hpp"
 
 #include "base/logging.hpp"
 #include "base/math.hpp"
@@ -86,10 +87,33 @@ void correctColors(gil::bgra8_image_t & image)
     }
   }
 }
+
+bool WriteCompressedImage(gil::bgra8_image_t const & image, std::string const & fileName)
+{
+  gil::bgra8c_view_t view = gil::const_view(image);
+  auto const width = static_cast<uint32_t>(view.width());
+  auto const height = static_cast<uint32_t>(view.height());
+
+  std::vector<uint8_t> rgba;
+  rgba.reserve(width * height * 4);
+  for (gil::bgra8c_view_t::y_coord_t y = 0; y < view.height(); ++y)
+  {
+    for (gil::bgra8c_view_t::x_coord_t x = 0; x < view.width(); ++x)
+    {
+      auto const & pixel = view(x, y);
+      rgba.push_back(gil::get_color(pixel, gil::red_t()));
+      rgba.push_back(gil::get_color(pixel, gil::green_t()));
+      rgba.push_back(gil::get_color(pixel, gil::blue_t()));
+      rgba.push_back(gil::get_color(pixel, gil::alpha_t()));
+    }
+  }
+  return WriteKtx(fileName, EncodeETC2RGBA8(rgba.data(), width, height), width, height);
+}
 }
 
-SkinGenerator::SkinGenerator(bool needColorCorrection)
+SkinGenerator::SkinGenerator(bool needColorCorrection, bool needCompressedTexture)
   : m_needColorCorrection(needColorCorrection)
+  , m_needCompressedTexture(needCompressedTexture)
 {}
 
 void SkinGenerator::ProcessSymbols(std::string const & svgDataDir,
@@ -239,6 +263,24 @@ bool SkinGenerator::RenderPages(uint32_t maxSize)
     if (m_needColorCorrection)
       correctColors(gilImage);
     img.save(s.c_str());
+
+    if (m_needCompressedTexture)
+    {
+      // Compressed formats consist of 4x4 blocks, the sizes are powers of 2.
+      if (page.m_width < 4 || page.m_height < 4)
+      {
+        LOG(LINFO, ("Error: The texture is too small to be compressed."));
+        return false;
+      }
+
+      std::string const ktxName = page.m_fileName + ".ktx";
+      LOG(LINFO, ("saving compressed skin image into: ", ktxName));
+      if (!WriteCompressedImage(gilImage, ktxName))
+      {
+        LOG(LINFO, ("Error: Can't write", ktxName));
+        return false;
+      }
+    }
   }
 
   return true;
@@ -54,7 +54,7 @@ public:
     m2::Packer m_packer;
   };
 
-  explicit SkinGenerator(bool needColorCorrection);
+  SkinGenerator(bool needColorCorrection, bool needCompressedTexture);
 
   void ProcessSymbols(std::string const & symbolsDir, std::string const & skinName,
                       std::vector<QSize> const & symbolSizes,
@@ -64,6 +64,7 @@ public:
 
 private:
   bool m_needColorCorrection;
+  bool m_needCompressedTexture;
   QSvgRenderer m_svgRenderer;
   using TSkinPages = std::vector<SkinPageInfo>;
   TSkinPages m_pages;
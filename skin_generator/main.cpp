@@ -27,6 +27,7 @@ DEFINE_int32(searchIconWidth, 24, "width of the search category icon");
 DEFINE_int32(searchIconHeight, 24, "height of the search category icon");
 DEFINE_bool(colorCorrection, false, "apply color correction");
 DEFINE_int32(maxSize, 2048, "max width/height of output textures");
+DEFINE_bool(compressedTexture, false, "write also ETC2 compressed texture symbols<suffix>.ktx");
 
 int main(int argc, char *argv[])
 {
@@ -41,7 +42,7 @@ int main(int argc, char *argv[])
     google::ParseCommandLineFlags(&argc, &argv, true);
     QApplication app(argc, argv);
 
-    tools::SkinGenerator gen(FLAGS_colorCorrection);
+    tools::SkinGenerator gen(FLAGS_colorCorrection, FLAGS_compressedTexture);
 
     std::vector<QSize> symbolSizes;
     symbolSizes.emplace_back(QSize(FLAGS_symbolWidth, FLAGS_symbolHeight));
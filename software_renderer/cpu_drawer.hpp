@@ -11,6 +11,7 @@
 
 #include "std/function.hpp"
 #include "std/list.hpp"
+#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
 
 namespace software_renderer
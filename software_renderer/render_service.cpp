@@ -0,0 +1,198 @@
+#include "software_renderer/render_service.hpp"
+
+#include "software_renderer/cpu_drawer.hpp"
+#include "software_renderer/feature_processor.hpp"
+
+#include "drape_frontend/visual_params.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/drawing_rules.hpp"
+#include "indexer/scales.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace software_renderer
+{
+namespace
+{
+uint64_t GetTileKey(uint32_t x, uint32_t y, uint8_t zoom)
+{
+  // Coordinates of tiles are less than 2^28 for zooms up to 28.
+  return (static_cast<uint64_t>(zoom) << 56) | (static_cast<uint64_t>(x) << 28) | y;
+}
+
+RenderService::ImagePtr Render(CPUDrawer & drawer, DataSource const & dataSource,
+                               m2::RectD const & rect, uint32_t width, uint32_t height,
+                               uint32_t tileSize)
+{
+  ScreenBase screen;
+  screen.OnSize(0, 0, static_cast<int>(width), static_cast<int>(height));
+  screen.SetFromRect(m2::AnyRectD(rect));
+
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, drawer.GetVisualScale());
+  uint32_t const bgColor = drule::rules().GetBgColor(drawScale);
+  drawer.BeginFrame(width, height, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+
+  // Geometry is clipped by the inflated rect, so lines aren't cut at the borders of the image.
+  m2::RectD const renderRect(0, 0, width, height);
+  double const inflationSize = 24 * drawer.GetVisualScale();
+  m2::RectD clipRect;
+  m2::RectD selectRect;
+  screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
+  screen.PtoG(renderRect, selectRect);
+
+  FeatureProcessor doDraw(make_ref(&drawer), clipRect, screen, drawScale);
+  dataSource.ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); }, selectRect,
+                           std::min(scales::GetUpperScale(), drawScale));
+  drawer.Flush();
+
+  auto image = std::make_shared<FrameImage>();
+  drawer.EndFrame(*image);
+  return image;
+}
+}  // namespace
+
+RenderService::RenderService(DataSource const & dataSource, Params const & params)
+  : m_dataSource(dataSource), m_params(params), m_cache(params.m_logCacheSize)
+{
+  size_t threadsCount = m_params.m_threadsCount;
+  if (threadsCount == 0)
+    threadsCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+  m_threads.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_threads.emplace_back(&RenderService::ThreadFunc, this);
+}
+
+RenderService::~RenderService()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_requestsMutex);
+    m_isShutdown = true;
+  }
+  m_requestsCondition.notify_all();
+
+  for (auto & thread : m_threads)
+    thread.join();
+}
+
+void RenderService::RenderTile(uint32_t x, uint32_t y, uint8_t zoom, Callback const & fn)
+{
+  CHECK_LESS(x, 1u << zoom, ());
+  CHECK_LESS(y, 1u << zoom, ());
+
+  Request request;
+  request.m_isTile = true;
+  request.m_tileKey = GetTileKey(x, y, zoom);
+
+  auto const image = FindTile(request.m_tileKey);
+  if (image != nullptr)
+  {
+    fn(image);
+    return;
+  }
+
+  request.m_rect = GetTileRect(x, y, zoom);
+  request.m_width = m_params.m_tileSize;
+  request.m_height = m_params.m_tileSize;
+  request.m_callback = fn;
+  Push(std::move(request));
+}
+
+void RenderService::RenderRect(m2::RectD const & rect, uint32_t width, uint32_t height,
+                               Callback const & fn)
+{
+  Request request;
+  request.m_rect = rect;
+  request.m_width = width;
+  request.m_height = height;
+  request.m_callback = fn;
+  Push(std::move(request));
+}
+
+// static
+m2::RectD RenderService::GetTileRect(uint32_t x, uint32_t y, uint8_t zoom)
+{
+  // Tiles are numbered from the top left corner.
+  double const size = (MercatorBounds::maxX - MercatorBounds::minX) / (1u << zoom);
+  double const minX = MercatorBounds::minX + x * size;
+  double const maxY = MercatorBounds::maxY - y * size;
+  return m2::RectD(minX, maxY - size, minX + size, maxY);
+}
+
+void RenderService::Push(Request && request)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_requestsMutex);
+    CHECK(!m_isShutdown, ());
+    m_requests.push_back(std::move(request));
+  }
+  m_requestsCondition.notify_one();
+}
+
+void RenderService::ThreadFunc()
+{
+  std::string const resPostfix = df::VisualParams::GetResourcePostfix(m_params.m_visualScale);
+  CPUDrawer drawer(CPUDrawer::Params(resPostfix, m_params.m_visualScale));
+
+  while (true)
+  {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(m_requestsMutex);
+      m_requestsCondition.wait(lock, [this] { return m_isShutdown || !m_requests.empty(); });
+      if (m_requests.empty())
+        return;
+
+      request = std::move(m_requests.front());
+      m_requests.pop_front();
+    }
+
+    ImagePtr image;
+    try
+    {
+      image = Render(drawer, m_dataSource, request.m_rect, request.m_width, request.m_height,
+                     m_params.m_tileSize);
+    }
+    catch (std::exception const & e)
+    {
+      LOG(LERROR, ("Rendering of", request.m_rect, "failed:", e.what()));
+    }
+
+    if (image != nullptr && request.m_isTile)
+      CacheTile(request.m_tileKey, image);
+
+    request.m_callback(image);
+  }
+}
+
+RenderService::ImagePtr RenderService::FindTile(uint64_t tileKey)
+{
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  bool found = false;
+  auto & image = m_cache.Find(tileKey, found);
+  if (!found)
+  {
+    // The slot is taken by the key, so the previous image is dropped.
+    image.reset();
+  }
+  return image;
+}
+
+void RenderService::CacheTile(uint64_t tileKey, ImagePtr const & image)
+{
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  bool found = false;
+  m_cache.Find(tileKey, found) = image;
+}
+}  // namespace software_renderer
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "software_renderer/frame_image.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/cache.hpp"
+#include "base/macros.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class DataSource;
+
+namespace software_renderer
+{
+// Long-living service which renders map images with CPUDrawer. Unlike mapshot it doesn't create
+// Framework: the caller keeps mwms registered in |dataSource| and styles loaded for the lifetime
+// of the service. Requests are rendered in parallel, every thread has its own CPUDrawer.
+// Rendered XYZ tiles are cached.
+class RenderService
+{
+public:
+  struct Params
+  {
+    double m_visualScale = 1.0;
+    // Hardware concurrency is used when it's zero.
+    size_t m_threadsCount = 0;
+    // Log2 of the number of cached tiles.
+    uint32_t m_logCacheSize = 10;
+    uint32_t m_tileSize = 256;
+  };
+
+  using ImagePtr = std::shared_ptr<FrameImage const>;
+  // Callbacks are called on the rendering threads, |image| is nullptr if rendering failed.
+  using Callback = std::function<void(ImagePtr const & image)>;
+
+  RenderService(DataSource const & dataSource, Params const & params);
+  // Pending requests are rendered before destruction.
+  ~RenderService();
+
+  // Renders the tile with XYZ (slippy map) coordinates.
+  void RenderTile(uint32_t x, uint32_t y, uint8_t zoom, Callback const & fn);
+  // Renders |rect| in mercator to the image of the given size.
+  void RenderRect(m2::RectD const & rect, uint32_t width, uint32_t height, Callback const & fn);
+
+  // Returns the rect of the XYZ tile in mercator.
+  static m2::RectD GetTileRect(uint32_t x, uint32_t y, uint8_t zoom);
+
+private:
+  struct Request
+  {
+    m2::RectD m_rect;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    // Requests of tiles are cached.
+    bool m_isTile = false;
+    uint64_t m_tileKey = 0;
+    Callback m_callback;
+  };
+
+  void Push(Request && request);
+  void ThreadFunc();
+
+  ImagePtr FindTile(uint64_t tileKey);
+  void CacheTile(uint64_t tileKey, ImagePtr const & image);
+
+  DataSource const & m_dataSource;
+  Params const m_params;
+
+  std::mutex m_requestsMutex;
+  std::condition_variable m_requestsCondition;
+  std::deque<Request> m_requests;
+  bool m_isShutdown = false;
+
+  std::mutex m_cacheMutex;
+  base::Cache<uint64_t, ImagePtr> m_cache;
+
+  std::vector<std::thread> m_threads;
+
+  DISALLOW_COPY_AND_MOVE(RenderService);
+};
+}  // namespace software_renderer
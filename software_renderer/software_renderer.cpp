@@ -34,6 +34,9 @@ namespace software_renderer
 
 #define BLENDER_TYPE agg::comp_op_src_over
 
+// Width of lines in pixels which are stroked without caps and joins.
+double constexpr kHairlineWidth = 1.0;
+
 class agg_symbol_renderer : public ml::text_renderer
 {
   dp::Color m_color;
@@ -192,8 +195,7 @@ void SoftwareRenderer::BeginFrame(uint32_t width, uint32_t height, dp::Color con
 void SoftwareRenderer::DrawSymbol(m2::PointD const & pt, dp::Anchor anchor, IconInfo const & info)
 {
   //@TODO (yershov) implement it
-  typedef TBlendAdaptor<agg::rgba8, agg::order_rgba> blender_t;
-  typedef agg::pixfmt_custom_blend_rgba<blender_t, agg::rendering_buffer> pixel_format_t;
+  typedef agg::pixfmt_custom_blend_rgba<TBlender, agg::rendering_buffer> pixel_format_t;
   agg::rendering_buffer renderbuffer;
 
   m2::RectU const & r = m_symbolsIndex[info.m_name];
@@ -276,6 +278,11 @@ void SoftwareRenderer::DrawPath(PathInfo const & geometry, PenInfo const & info)
   path_t path_adaptor(geometry.m_path, false);
   typedef agg::conv_stroke<path_t> stroke_t;
 
+  // Round caps and joins aren't visible on hairlines but they produce most of stroke vertices.
+  bool const isHairline = info.m_w <= kHairlineWidth;
+  agg::line_cap_e const cap = isHairline ? agg::butt_cap : translateLineCap(info.m_cap);
+  agg::line_join_e const join = isHairline ? agg::bevel_join : translateLineJoin(info.m_join);
+
   if (!info.m_pat.empty())
   {
     agg::conv_dash<path_t> dash(path_adaptor);
@@ -287,16 +294,16 @@ void SoftwareRenderer::DrawPath(PathInfo const & geometry, PenInfo const & info)
 
     agg::conv_stroke<agg::conv_dash<path_t>> stroke(dash);
     stroke.width(info.m_w);
-    stroke.line_cap(translateLineCap(info.m_cap));
-    stroke.line_join(translateLineJoin(info.m_join));
+    stroke.line_cap(cap);
+    stroke.line_join(join);
     rasterizer.add_path(stroke);
   }
   else
   {
     stroke_t stroke(path_adaptor);
     stroke.width(info.m_w);
-    stroke.line_cap(translateLineCap(info.m_cap));
-    stroke.line_join(translateLineJoin(info.m_join));
+    stroke.line_cap(cap);
+    stroke.line_join(join);
     rasterizer.add_path(stroke);
   }
 
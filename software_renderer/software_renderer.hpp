@@ -9,6 +9,7 @@
 #include "software_renderer/circle_info.hpp"
 #include "software_renderer/pen_info.hpp"
 #include "software_renderer/brush_info.hpp"
+#include "software_renderer/span_blender.hpp"
 
 #include "drape/drape_global.hpp"
 
@@ -76,38 +77,8 @@ public:
 
   GlyphCache * GetGlyphCache() const { return m_glyphCache.get(); }
 
-private:
-  template <class TColor, class TOrder>
-  struct TBlendAdaptor
-  {
-    using order_type = TOrder;
-    using color_type = TColor;
-    using TValueType = typename color_type::value_type;
-    using TCalcType = typename color_type::calc_type;
-
-    enum EBaseScale
-    {
-      SCALE_SHIFT = color_type::base_shift,
-      SCALE_MASK = color_type::base_mask
-    };
-
-    static AGG_INLINE void blend_pix(unsigned op, TValueType * p, unsigned cr, unsigned cg,
-                                     unsigned cb, unsigned ca, unsigned cover)
-    {
-      using TBlendTable = agg::comp_op_table_rgba<TColor, TOrder>;
-      if (p[TOrder::A])
-      {
-        TBlendTable::g_comp_op_func[op](p, (cr * ca + SCALE_MASK) >> SCALE_SHIFT, (cg * ca + SCALE_MASK) >> SCALE_SHIFT,
-                                        (cb * ca + SCALE_MASK) >> SCALE_SHIFT, ca, cover);
-      }
-      else
-        TBlendTable::g_comp_op_func[op](p, cr, cg, cb, ca, cover);
-    }
-  };
-
-public:
-  using TBlender = TBlendAdaptor<agg::rgba8, agg::order_rgba>;
-  using TPixelFormat = agg::pixfmt_custom_blend_rgba<TBlender, agg::rendering_buffer>;
+  using TBlender = BlendAdaptor<agg::rgba8, agg::order_rgba>;
+  using TPixelFormat = PixelFormat;
 
   using TBaseRenderer = agg::renderer_base<TPixelFormat>;
   using TPrimitivesRenderer = agg::renderer_primitives<TBaseRenderer>;
@@ -0,0 +1,111 @@
+#include "testing/testing.hpp"
+
+#include "software_renderer/span_blender.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace software_renderer;
+using namespace std;
+
+namespace
+{
+using ReferencePixelFormat = PixelFormat::TBase;
+
+uint32_t constexpr kSize = 512;
+
+struct Frame
+{
+  Frame() : m_data(kSize * kSize * 4) { m_buffer.attach(m_data.data(), kSize, kSize, kSize * 4); }
+
+  vector<uint8_t> m_data;
+  agg::rendering_buffer m_buffer;
+};
+
+// Fills the frame with pixels which are opaque, transparent and semitransparent.
+void FillRandom(Frame & frame, mt19937 & rng)
+{
+  uniform_int_distribution<int> byte(0, 255);
+  for (size_t i = 0; i < frame.m_data.size(); i += 4)
+  {
+    for (size_t j = 0; j < 3; ++j)
+      frame.m_data[i + j] = static_cast<uint8_t>(byte(rng));
+    int const type = byte(rng) % 3;
+    frame.m_data[i + 3] = static_cast<uint8_t>(type == 0 ? 0 : (type == 1 ? 255 : byte(rng)));
+  }
+}
+
+// Covers look like the ones of scanlines: opaque runs with antialiased edges.
+vector<uint8_t> MakeCovers(mt19937 & rng)
+{
+  uniform_int_distribution<int> byte(0, 255);
+  vector<uint8_t> covers(kSize);
+  for (size_t i = 0; i < covers.size(); ++i)
+  {
+    int const type = byte(rng) % 4;
+    covers[i] = static_cast<uint8_t>(type == 0 ? 0 : (type == 1 ? byte(rng) : 255));
+  }
+  return covers;
+}
+
+template <typename PixFmt>
+void Render(Frame & frame, agg::rgba8 const & color, vector<uint8_t> const & covers)
+{
+  PixFmt pixelFormat(frame.m_buffer, agg::comp_op_src_over);
+  for (uint32_t y = 0; y < kSize; ++y)
+  {
+    // Spans of different lengths and offsets check blending of tails.
+    uint32_t const x = y % 7;
+    uint32_t const len = kSize - x - y % 5;
+    pixelFormat.blend_solid_hspan(x, y, len, color, covers.data());
+    pixelFormat.blend_hline(x, y, len / 2, color, covers[y]);
+  }
+}
+
+template <typename PixFmt>
+double RenderBenchmark(agg::rgba8 const & color, vector<uint8_t> const & covers)
+{
+  Frame frame;
+  size_t constexpr kIterations = 100;
+  base::Timer timer;
+  for (size_t i = 0; i < kIterations; ++i)
+    Render<PixFmt>(frame, color, covers);
+  return timer.ElapsedSeconds() / kIterations;
+}
+}  // namespace
+
+UNIT_TEST(SpanBlender_EqualToReference)
+{
+  mt19937 rng(0);
+  vector<agg::rgba8> const colors = {agg::rgba8(0x4C, 0xAF, 0x50), agg::rgba8(0, 0, 0, 0x1A),
+                                     agg::rgba8(0xFF, 0xFF, 0xFF, 0x80), agg::rgba8(10, 20, 30, 0)};
+  for (auto const & color : colors)
+  {
+    Frame reference;
+    FillRandom(reference, rng);
+    Frame frame;
+    frame.m_data = reference.m_data;
+
+    auto const covers = MakeCovers(rng);
+    Render<ReferencePixelFormat>(reference, color, covers);
+    Render<PixelFormat>(frame, color, covers);
+    TEST(reference.m_data == frame.m_data, (color.r, color.g, color.b, color.a));
+  }
+}
+
+UNIT_TEST(SpanBlender_Benchmark)
+{
+  mt19937 rng(0);
+  auto const covers = MakeCovers(rng);
+  for (auto const & color : {agg::rgba8(0x4C, 0xAF, 0x50), agg::rgba8(0, 0, 0, 0x1A)})
+  {
+    double const reference = RenderBenchmark<ReferencePixelFormat>(color, covers);
+    double const optimized = RenderBenchmark<PixelFormat>(color, covers);
+    LOG(LINFO, ("Alpha:", static_cast<int>(color.a), "reference:", reference * 1000, "ms",
+                "optimized:", optimized * 1000, "ms"));
+  }
+}
@@ -0,0 +1,169 @@
+#include "software_renderer/span_blender.hpp"
+
+#include "std/cstring.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace software_renderer
+{
+namespace
+{
+// Color in the order of frame buffer bytes. Premultiplied color is blended over pixels
+// with alpha and plain color over transparent ones, see BlendAdaptor.
+struct SourceColor
+{
+  explicit SourceColor(agg::rgba8 const & c)
+  {
+    m_plain[0] = c.r;
+    m_plain[1] = c.g;
+    m_plain[2] = c.b;
+    m_plain[3] = c.a;
+    for (size_t i = 0; i < 3; ++i)
+      m_premultiplied[i] = static_cast<uint8_t>((m_plain[i] * c.a + 255) >> 8);
+    m_premultiplied[3] = c.a;
+  }
+
+  // Opaque color with full cover replaces the pixel, plain and premultiplied colors are equal.
+  bool IsOpaque() const { return m_plain[3] == 255; }
+
+  uint8_t m_plain[4];
+  uint8_t m_premultiplied[4];
+};
+
+// The same as agg::rgba8::multiply.
+inline uint8_t Multiply(uint32_t a, uint32_t b)
+{
+  uint32_t const t = a * b + 128;
+  return static_cast<uint8_t>(((t >> 8) + t) >> 8);
+}
+
+// agg::comp_op_rgba_src_over over BlendAdaptor.
+inline void BlendPixel(uint8_t * p, SourceColor const & src, uint8_t cover)
+{
+  if (cover == 0)
+    return;
+
+  uint8_t const * c = p[3] != 0 ? src.m_premultiplied : src.m_plain;
+  uint8_t const alpha = Multiply(c[3], cover);
+  for (size_t i = 0; i < 3; ++i)
+    p[i] = static_cast<uint8_t>(p[i] + Multiply(c[i], cover) - Multiply(p[i], alpha));
+  p[3] = static_cast<uint8_t>(p[3] + alpha - Multiply(p[3], alpha));
+}
+
+void FillPixels(uint8_t * p, uint32_t len, SourceColor const & src)
+{
+  uint32_t value;
+  memcpy(&value, src.m_plain, sizeof(value));
+  for (uint32_t i = 0; i < len; ++i, p += 4)
+    memcpy(p, &value, sizeof(value));
+}
+
+#if defined(__SSE2__)
+// Multiply for 8 lanes of 16 bits.
+inline __m128i Multiply(__m128i a, __m128i b)
+{
+  __m128i const t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(t, 8), t), 8);
+}
+
+// Blends two pixels which are unpacked to 16 bit lanes.
+inline __m128i BlendPixels(__m128i dst, __m128i src, __m128i covers)
+{
+  __m128i const s = Multiply(src, covers);
+  __m128i alpha = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+  alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+  // Results are truncated to bytes like in the scalar code.
+  __m128i const r = _mm_sub_epi16(_mm_add_epi16(dst, s), Multiply(dst, alpha));
+  return _mm_and_si128(r, _mm_set1_epi16(0xFF));
+}
+
+// Blends 4 pixels with 4 covers which are packed into |covers|.
+inline void BlendPixels4(uint8_t * p, __m128i plain, __m128i premultiplied, uint32_t covers)
+{
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const dst = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+
+  __m128i const isTransparent =
+      _mm_cmpeq_epi32(_mm_and_si128(dst, _mm_set1_epi32(static_cast<int>(0xFF000000))), zero);
+  __m128i const src = _mm_or_si128(_mm_and_si128(isTransparent, plain),
+                                   _mm_andnot_si128(isTransparent, premultiplied));
+
+  __m128i c = _mm_cvtsi32_si128(static_cast<int>(covers));
+  c = _mm_unpacklo_epi8(c, c);
+  c = _mm_unpacklo_epi16(c, c);
+
+  __m128i const lo = BlendPixels(_mm_unpacklo_epi8(dst, zero), _mm_unpacklo_epi8(src, zero),
+                                 _mm_unpacklo_epi8(c, zero));
+  __m128i const hi = BlendPixels(_mm_unpackhi_epi8(dst, zero), _mm_unpackhi_epi8(src, zero),
+                                 _mm_unpackhi_epi8(c, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_packus_epi16(lo, hi));
+}
+
+inline __m128i LoadColor(uint8_t const * c)
+{
+  uint32_t value;
+  memcpy(&value, c, sizeof(value));
+  return _mm_set1_epi32(static_cast<int>(value));
+}
+#endif
+}  // namespace
+
+void BlendSolidHSpan(uint8_t * dst, uint32_t len, agg::rgba8 const & color, uint8_t const * covers)
+{
+  SourceColor const src(color);
+  bool const isOpaque = src.IsOpaque();
+  uint32_t i = 0;
+
+#if defined(__SSE2__)
+  __m128i const plain = LoadColor(src.m_plain);
+  __m128i const premultiplied = LoadColor(src.m_premultiplied);
+  for (; i + 4 <= len; i += 4)
+  {
+    uint32_t c;
+    memcpy(&c, covers + i, sizeof(c));
+    if (c == 0)
+      continue;
+
+    if (isOpaque && c == 0xFFFFFFFF)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), plain);
+    else
+      BlendPixels4(dst + i * 4, plain, premultiplied, c);
+  }
+#endif
+
+  for (; i < len; ++i)
+  {
+    if (isOpaque && covers[i] == agg::cover_full)
+      FillPixels(dst + i * 4, 1, src);
+    else
+      BlendPixel(dst + i * 4, src, covers[i]);
+  }
+}
+
+void BlendHLine(uint8_t * dst, uint32_t len, agg::rgba8 const & color, uint8_t cover)
+{
+  if (cover == 0)
+    return;
+
+  SourceColor const src(color);
+  if (src.IsOpaque() && cover == agg::cover_full)
+  {
+    FillPixels(dst, len, src);
+    return;
+  }
+
+  uint32_t i = 0;
+#if defined(__SSE2__)
+  __m128i const plain = LoadColor(src.m_plain);
+  __m128i const premultiplied = LoadColor(src.m_premultiplied);
+  uint32_t const covers = cover * 0x01010101u;
+  for (; i + 4 <= len; i += 4)
+    BlendPixels4(dst + i * 4, plain, premultiplied, covers);
+#endif
+
+  for (; i < len; ++i)
+    BlendPixel(dst + i * 4, src, cover);
+}
+}  // namespace software_renderer
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "3party/agg/agg_pixfmt_rgba.h"
+#include "3party/agg/agg_rendering_buffer.h"
+
+#include "std/cstdint.hpp"
+
+namespace software_renderer
+{
+// Blender which composes non-premultiplied colors into the frame buffer. The color is
+// premultiplied only over the pixels which already have alpha.
+template <class TColor, class TOrder>
+struct BlendAdaptor
+{
+  using order_type = TOrder;
+  using color_type = TColor;
+  using TValueType = typename color_type::value_type;
+  using TCalcType = typename color_type::calc_type;
+
+  enum EBaseScale
+  {
+    SCALE_SHIFT = color_type::base_shift,
+    SCALE_MASK = color_type::base_mask
+  };
+
+  static AGG_INLINE void blend_pix(unsigned op, TValueType * p, unsigned cr, unsigned cg,
+                                   unsigned cb, unsigned ca, unsigned cover)
+  {
+    using TBlendTable = agg::comp_op_table_rgba<TColor, TOrder>;
+    if (p[TOrder::A])
+    {
+      TBlendTable::g_comp_op_func[op](p, (cr * ca + SCALE_MASK) >> SCALE_SHIFT, (cg * ca + SCALE_MASK) >> SCALE_SHIFT,
+                                      (cb * ca + SCALE_MASK) >> SCALE_SHIFT, ca, cover);
+    }
+    else
+      TBlendTable::g_comp_op_func[op](p, cr, cg, cb, ca, cover);
+  }
+};
+
+// Blends solid |color| over |len| rgba pixels starting from |dst| with per pixel |covers|.
+// The result is bit exact with BlendAdaptor for agg::comp_op_src_over, but spans are blended
+// with SSE2 when it's available and opaque spans are filled without blending.
+void BlendSolidHSpan(uint8_t * dst, uint32_t len, agg::rgba8 const & color, uint8_t const * covers);
+// The same as BlendSolidHSpan with equal covers.
+void BlendHLine(uint8_t * dst, uint32_t len, agg::rgba8 const & color, uint8_t cover);
+
+// Pixel format of the frame buffer. Solid spans which are the most of rasterized pixels
+// are blended with BlendSolidHSpan and BlendHLine instead of per pixel calls of blend functions.
+class PixelFormat
+  : public agg::pixfmt_custom_blend_rgba<BlendAdaptor<agg::rgba8, agg::order_rgba>,
+                                         agg::rendering_buffer>
+{
+public:
+  using TBase = agg::pixfmt_custom_blend_rgba<BlendAdaptor<agg::rgba8, agg::order_rgba>,
+                                              agg::rendering_buffer>;
+
+  using TBase::TBase;
+
+  void blend_hline(int x, int y, unsigned len, color_type const & c, agg::int8u cover)
+  {
+    if (comp_op() != agg::comp_op_src_over)
+      TBase::blend_hline(x, y, len, c, cover);
+    else
+      BlendHLine(pix_ptr(x, y), len, c, cover);
+  }
+
+  void blend_solid_hspan(int x, int y, unsigned len, color_type const & c,
+                         agg::int8u const * covers)
+  {
+    if (comp_op() != agg::comp_op_src_over)
+      TBase::blend_solid_hspan(x, y, len, c, covers);
+    else
+      BlendSolidHSpan(pix_ptr(x, y), len, c, covers);
+  }
+};
+}  // namespace software_renderer
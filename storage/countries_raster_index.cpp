@@ -0,0 +1,255 @@
+#include "storage/countries_raster_index.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect_intersect.hpp"
+#include "geometry/robust_orientation.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace storage
+{
+namespace
+{
+using RegionId = CountriesRasterIndex::RegionId;
+
+struct Edge
+{
+  Edge(m2::PointD const & a, m2::PointD const & b) : m_a(a), m_b(b) {}
+
+  m2::PointD m_a;
+  m2::PointD m_b;
+};
+
+// Edges of the country which intersect the node and whether the center of the node
+// is inside the country.
+struct Candidate
+{
+  RegionId m_id = 0;
+  bool m_isCenterInside = false;
+  vector<Edge> m_edges;
+};
+
+m2::RectD GetChildRect(m2::RectD const & rect, size_t child)
+{
+  auto const center = rect.Center();
+  return m2::RectD((child & 1) ? center.x : rect.minX(), (child & 2) ? center.y : rect.minY(),
+                   (child & 1) ? rect.maxX() : center.x, (child & 2) ? rect.maxY() : center.y);
+}
+
+size_t GetChild(m2::RectD const & rect, m2::PointD const & pt)
+{
+  auto const center = rect.Center();
+  return (pt.x >= center.x ? 1 : 0) + (pt.y >= center.y ? 2 : 0);
+}
+
+bool IsIntersected(m2::RectD const & rect, Edge const & edge)
+{
+  auto a = edge.m_a;
+  auto b = edge.m_b;
+  return m2::Intersect(rect, a, b);
+}
+
+// Returns true if |edge| crosses the segment (|a|, |b|). Edge points on the line of the segment
+// are considered to be on the same side, so the crossing of a polygon vertex is counted once.
+bool IsCrossed(m2::PointD const & a, m2::PointD const & b, Edge const & edge)
+{
+  bool const sideA = m2::robust::OrientedS(a, b, edge.m_a) > 0.0;
+  bool const sideB = m2::robust::OrientedS(a, b, edge.m_b) > 0.0;
+  if (sideA == sideB)
+    return false;
+
+  return m2::robust::OrientedS(edge.m_a, edge.m_b, a) *
+             m2::robust::OrientedS(edge.m_a, edge.m_b, b) < 0.0;
+}
+
+class Builder
+{
+public:
+  Builder(vector<uint32_t> & nodes, uint8_t maxDepth, uint32_t splitFlag)
+    : m_nodes(nodes), m_maxDepth(maxDepth), m_splitFlag(splitFlag)
+  {
+  }
+
+  void Build(size_t nodeIndex, m2::RectD const & rect, vector<Candidate> && candidates,
+             uint8_t depth)
+  {
+    // Countries which neither intersect nor cover the node are skipped.
+    candidates.erase(remove_if(candidates.begin(), candidates.end(), [](Candidate const & c)
+                     {
+                       return c.m_edges.empty() && !c.m_isCenterInside;
+                     }),
+                     candidates.end());
+
+    if (candidates.empty())
+    {
+      m_nodes[nodeIndex] = CountriesRasterIndex::kOutside;
+      return;
+    }
+
+    // The first covering country wins as in CountryInfoGetterBase::FindFirstCountry().
+    if (candidates.front().m_edges.empty())
+    {
+      m_nodes[nodeIndex] = candidates.front().m_id;
+      return;
+    }
+
+    if (depth == m_maxDepth)
+    {
+      m_nodes[nodeIndex] = CountriesRasterIndex::kBorder;
+      return;
+    }
+
+    auto const childrenIndex = static_cast<uint32_t>(m_nodes.size());
+    CHECK_LESS(childrenIndex, m_splitFlag, ());
+    m_nodes.resize(m_nodes.size() + 4);
+    m_nodes[nodeIndex] = m_splitFlag | childrenIndex;
+
+    auto const center = rect.Center();
+    for (size_t child = 0; child < 4; ++child)
+    {
+      auto const childRect = GetChildRect(rect, child);
+      auto const childCenter = childRect.Center();
+
+      vector<Candidate> childCandidates(candidates.size());
+      for (size_t i = 0; i < candidates.size(); ++i)
+      {
+        auto const & candidate = candidates[i];
+        auto & childCandidate = childCandidates[i];
+        childCandidate.m_id = candidate.m_id;
+
+        // All the edges which cross the segment between centers are in the node.
+        childCandidate.m_isCenterInside = candidate.m_isCenterInside;
+        for (auto const & edge : candidate.m_edges)
+        {
+          if (IsCrossed(center, childCenter, edge))
+            childCandidate.m_isCenterInside = !childCandidate.m_isCenterInside;
+          if (IsIntersected(childRect, edge))
+            childCandidate.m_edges.push_back(edge);
+        }
+      }
+
+      Build(childrenIndex + child, childRect, move(childCandidates), depth + 1);
+    }
+  }
+
+private:
+  vector<uint32_t> & m_nodes;
+  uint8_t const m_maxDepth;
+  uint32_t const m_splitFlag;
+};
+}  // namespace
+
+// static
+CountriesRasterIndex::RegionId constexpr CountriesRasterIndex::kOutside;
+CountriesRasterIndex::RegionId constexpr CountriesRasterIndex::kBorder;
+uint8_t constexpr CountriesRasterIndex::kDefaultMaxDepth;
+uint8_t constexpr CountriesRasterIndex::kVersion;
+uint32_t constexpr CountriesRasterIndex::kSplitFlag;
+
+// static
+CountriesRasterIndex CountriesRasterIndex::Build(vector<vector<m2::RegionD>> const & countries,
+                                                 uint8_t maxDepth)
+{
+  CHECK_LESS(countries.size(), kBorder, ());
+
+  auto const worldRect = MercatorBounds::FullRect();
+  auto const worldCenter = worldRect.Center();
+
+  vector<Candidate> candidates(countries.size());
+  for (size_t id = 0; id < countries.size(); ++id)
+  {
+    auto & candidate = candidates[id];
+    candidate.m_id = static_cast<RegionId>(id);
+    for (auto const & region : countries[id])
+    {
+      candidate.m_isCenterInside = candidate.m_isCenterInside || region.Contains(worldCenter);
+
+      auto const & points = region.Data();
+      for (size_t i = 0; i < points.size(); ++i)
+      {
+        auto const & next = points[(i + 1) % points.size()];
+        if (points[i] != next)
+          candidate.m_edges.emplace_back(points[i], next);
+      }
+    }
+  }
+
+  CountriesRasterIndex index;
+  index.m_nodes.resize(1);
+  Builder(index.m_nodes, maxDepth, kSplitFlag).Build(0 /* nodeIndex */, worldRect,
+                                                     move(candidates), 0 /* depth */);
+  return index;
+}
+
+CountriesRasterIndex::RegionId CountriesRasterIndex::Find(m2::PointD const & pt) const
+{
+  auto rect = MercatorBounds::FullRect();
+  if (m_nodes.empty() || !rect.IsPointInside(pt))
+    return kBorder;
+
+  auto node = m_nodes[0];
+  while ((node & kSplitFlag) != 0)
+  {
+    auto const child = GetChild(rect, pt);
+    rect = GetChildRect(rect, child);
+    node = m_nodes[(node & ~kSplitFlag) + child];
+  }
+  return node;
+}
+
+void CountriesRasterIndex::ForEachInsideRegion(m2::RectD const & rect,
+                                               function<void(RegionId)> const & fn) const
+{
+  if (m_nodes.empty())
+    return;
+  ForEachInsideRegion(0 /* nodeIndex */, MercatorBounds::FullRect(), rect, fn);
+}
+
+void CountriesRasterIndex::ForEachInsideRegion(uint32_t nodeIndex, m2::RectD const & nodeRect,
+                                               m2::RectD const & rect,
+                                               function<void(RegionId)> const & fn) const
+{
+  if (!nodeRect.IsIntersect(rect))
+    return;
+
+  auto const node = m_nodes[nodeIndex];
+  if ((node & kSplitFlag) != 0)
+  {
+    for (uint32_t child = 0; child < 4; ++child)
+      ForEachInsideRegion((node & ~kSplitFlag) + child, GetChildRect(nodeRect, child), rect, fn);
+    return;
+  }
+
+  if (node != kOutside && node != kBorder)
+    fn(node);
+}
+
+// static
+bool CountriesRasterIndex::IsConsistent(vector<uint32_t> const & nodes, size_t regionsCount)
+{
+  if (nodes.empty())
+    return false;
+
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    auto const node = nodes[i];
+    if ((node & kSplitFlag) != 0)
+    {
+      // Children follow the parent, so there are no cycles.
+      size_t const childrenIndex = node & ~kSplitFlag;
+      if (childrenIndex <= i || childrenIndex + 4 > nodes.size())
+        return false;
+    }
+    else if (node != kOutside && node != kBorder && node >= regionsCount)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace storage
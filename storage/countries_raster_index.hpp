@@ -0,0 +1,90 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace storage
+{
+// Quadtree over the mercator world which is built from polygons of packed_polygons.bin.
+// Each leaf is either outside of all countries, inside of the first country which covers it
+// or on a border. Points of inside and outside leaves are resolved without polygons.
+class CountriesRasterIndex
+{
+public:
+  using RegionId = uint32_t;
+
+  // Special results of Find().
+  static RegionId constexpr kOutside = 0x7FFFFFFF;
+  static RegionId constexpr kBorder = 0x7FFFFFFE;
+
+  // Leaves on the max depth are about 40 km wide.
+  static uint8_t constexpr kDefaultMaxDepth = 10;
+  static uint8_t constexpr kVersion = 0;
+
+  // |countries| contains regions of each country in the order of packed_polygons.bin.
+  static CountriesRasterIndex Build(std::vector<std::vector<m2::RegionD>> const & countries,
+                                    uint8_t maxDepth = kDefaultMaxDepth);
+
+  bool IsEmpty() const { return m_nodes.empty(); }
+  size_t GetNodesCount() const { return m_nodes.size(); }
+
+  // Returns id of the first country which contains |pt|, kOutside when there is no such
+  // country or kBorder when polygons must be checked.
+  RegionId Find(m2::PointD const & pt) const;
+
+  // Calls |fn| for ids of countries which cover leaves intersecting |rect|,
+  // ids may be repeated.
+  void ForEachInsideRegion(m2::RectD const & rect, std::function<void(RegionId)> const & fn) const;
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kVersion);
+    WriteVarUint(sink, static_cast<uint32_t>(m_nodes.size()));
+    for (auto const node : m_nodes)
+      WriteVarUint(sink, node);
+  }
+
+  // Returns false and leaves the index empty if the data is unknown or inconsistent
+  // with |regionsCount|.
+  template <typename Source>
+  bool Deserialize(Source & src, size_t regionsCount)
+  {
+    m_nodes.clear();
+    if (ReadPrimitiveFromSource<uint8_t>(src) != kVersion)
+      return false;
+
+    auto const count = ReadVarUint<uint32_t>(src);
+    std::vector<uint32_t> nodes;
+    nodes.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+      nodes.push_back(ReadVarUint<uint32_t>(src));
+
+    if (!IsConsistent(nodes, regionsCount))
+      return false;
+
+    m_nodes.swap(nodes);
+    return true;
+  }
+
+private:
+  // Split nodes keep the index of the first of four children, other nodes are leaves.
+  static uint32_t constexpr kSplitFlag = 0x80000000;
+
+  static bool IsConsistent(std::vector<uint32_t> const & nodes, size_t regionsCount);
+
+  void ForEachInsideRegion(uint32_t nodeIndex, m2::RectD const & nodeRect, m2::RectD const & rect,
+                           std::function<void(RegionId)> const & fn) const;
+
+  std::vector<uint32_t> m_nodes;
+};
+}  // namespace storage
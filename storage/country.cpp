@@ -162,12 +162,11 @@ TMwmSubtreeAttrs LoadGroupSingleMwmsImpl(size_t depth, json_t * node, TCountryId
   return make_pair(mwmCounter, mwmSize);
 }
 
-bool LoadCountriesSingleMwmsImpl(string const & jsonBuffer, StoreSingleMwmInterface & store)
+bool LoadCountriesSingleMwmsImpl(json_t * root, StoreSingleMwmInterface & store)
 {
   try
   {
-    base::Json root(jsonBuffer.c_str());
-    LoadGroupSingleMwmsImpl(0 /* depth */, root.get(), kInvalidCountryId, store);
+    LoadGroupSingleMwmsImpl(0 /* depth */, root, kInvalidCountryId, store);
     return true;
   }
   catch (base::Json::Exception const & e)
@@ -281,13 +280,11 @@ TMwmSubtreeAttrs LoadGroupTwoComponentMwmsImpl(size_t depth, json_t * node,
   return make_pair(countryCounter, countrySize);
 }
 
-bool LoadCountriesTwoComponentMwmsImpl(string const & jsonBuffer,
-                                       StoreTwoComponentMwmInterface & store)
+bool LoadCountriesTwoComponentMwmsImpl(json_t * root, StoreTwoComponentMwmInterface & store)
 {
   try
   {
-    base::Json root(jsonBuffer.c_str());
-    LoadGroupTwoComponentMwmsImpl(0 /* depth */, root.get(), kInvalidCountryId, store);
+    LoadGroupTwoComponentMwmsImpl(0 /* depth */, root, kInvalidCountryId, store);
     return true;
   }
   catch (base::Json::Exception const & e)
@@ -313,7 +310,7 @@ int64_t LoadCountriesFromBuffer(string const & jsonBuffer, TCountryTree & countr
     if (version::IsSingleMwm(version))
     {
       StoreCountriesSingleMwms store(countries, affiliations);
-      if (!LoadCountriesSingleMwmsImpl(jsonBuffer, store))
+      if (!LoadCountriesSingleMwmsImpl(root.get(), store))
         return -1;
       if (mapping)
         *mapping = store.GetMapping();
@@ -321,7 +318,7 @@ int64_t LoadCountriesFromBuffer(string const & jsonBuffer, TCountryTree & countr
     else
     {
       StoreCountriesTwoComponentMwms store(countries, affiliations);
-      if (!LoadCountriesTwoComponentMwmsImpl(jsonBuffer, store))
+      if (!LoadCountriesTwoComponentMwmsImpl(root.get(), store))
         return -1;
     }
   }
@@ -354,12 +351,12 @@ void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryI
     if (isSingleMwm)
     {
       StoreFile2InfoSingleMwms store(id2info);
-      LoadCountriesSingleMwmsImpl(jsonBuffer, store);
+      LoadCountriesSingleMwmsImpl(root.get(), store);
     }
     else
     {
       StoreFile2InfoTwoComponentMwms store(id2info);
-      LoadCountriesTwoComponentMwmsImpl(jsonBuffer, store);
+      LoadCountriesTwoComponentMwmsImpl(root.get(), store);
     }
   }
   catch (base::Json::Exception const & e)
@@ -27,7 +27,8 @@ size_t const kInvalidId = std::numeric_limits<size_t>::max();
 
 struct DoFreeCacheMemory
 {
-  void operator()(std::vector<m2::RegionD> & v) const { std::vector<m2::RegionD>().swap(v); }
+  template <typename Regions>
+  void operator()(Regions & regions) const { regions.reset(); }
 };
 
 class DoCalcUSA
@@ -86,8 +87,24 @@ void CountryInfoGetterBase::RegionIdsToCountryIds(TRegionIdSet const & regions,
     countries.push_back(m_countries[id].m_countryId);
 }
 
+void CountryInfoGetterBase::LoadRasterIndex(FilesContainerR const & polygonsContainer)
+{
+  if (!polygonsContainer.IsExist(PACKED_POLYGONS_RASTER_INDEX_TAG))
+    return;
+
+  ReaderSource<ModelReaderPtr> src(polygonsContainer.GetReader(PACKED_POLYGONS_RASTER_INDEX_TAG));
+  if (!m_rasterIndex.Deserialize(src, m_countries.size()))
+    LOG(LWARNING, ("Countries raster index is skipped, it's inconsistent with polygons."));
+}
+
 CountryInfoGetterBase::TRegionId CountryInfoGetterBase::FindFirstCountry(m2::PointD const & pt) const
 {
+  auto const indexId = m_rasterIndex.Find(pt);
+  if (indexId == CountriesRasterIndex::kOutside)
+    return kInvalidId;
+  if (indexId != CountriesRasterIndex::kBorder)
+    return indexId;
+
   for (size_t id = 0; id < m_countries.size(); ++id)
   {
     if (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegionImpl(id, pt))
@@ -102,6 +119,17 @@ vector<TCountryId> CountryInfoGetter::GetRegionsCountryIdByRect(m2::RectD const
 {
   size_t constexpr kAverageSize = 10;
 
+  // Countries which cover leaves of the raster index intersecting |rect| intersect |rect|.
+  std::vector<bool> isIntersected;
+  if (!rough && !m_rasterIndex.IsEmpty())
+  {
+    isIntersected.resize(m_countries.size(), false);
+    m_rasterIndex.ForEachInsideRegion(rect, [&isIntersected](CountriesRasterIndex::RegionId id)
+    {
+      isIntersected[id] = true;
+    });
+  }
+
   std::vector<TCountryId> result;
   result.reserve(kAverageSize);
   for (size_t id = 0; id < m_countries.size(); ++id)
@@ -112,8 +140,11 @@ vector<TCountryId> CountryInfoGetter::GetRegionsCountryIdByRect(m2::RectD const
     }
     else if (rect.IsIntersect(m_countries[id].m_rect))
     {
-      if (rough || IsIntersectedByRegionImpl(id, rect))
+      if (rough || (!isIntersected.empty() && isIntersected[id]) ||
+          IsIntersectedByRegionImpl(id, rect))
+      {
         result.push_back(m_countries[id].m_countryId);
+      }
     }
   }
   return result;
@@ -252,6 +283,8 @@ CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countr
   for (size_t i = 0; i < countrySz; ++i)
     m_countryIndex[m_countries[i].m_countryId] = i;
 
+  LoadRasterIndex(m_reader);
+
   string buffer;
   countryR.ReadAsString(buffer);
   LoadCountryFile2CountryInfo(buffer, m_id2info, m_isSingleMwm);
@@ -268,14 +301,20 @@ void CountryInfoReader::ClearCachesImpl() const
 template <typename TFn>
 std::result_of_t<TFn(vector<m2::RegionD>)> CountryInfoReader::WithRegion(size_t id, TFn && fn) const
 {
-  std::lock_guard<std::mutex> lock(m_cacheMutex);
-
-  bool isFound = false;
-  std::vector<m2::RegionD> & rgns = m_cache.Find(static_cast<uint32_t>(id), isFound);
+  auto const key = static_cast<uint32_t>(id);
+  Regions regions;
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    bool isFound = false;
+    auto const & cached = m_cache.Find(key, isFound);
+    if (isFound)
+      regions = cached;
+  }
 
-  if (!isFound)
+  // Regions may be absent for a found key when they're loaded by another thread.
+  if (regions == nullptr)
   {
-    rgns.clear();
+    auto loaded = std::make_shared<std::vector<m2::RegionD>>();
     // Load regions from file.
     ReaderSource<ModelReaderPtr> src(m_reader.GetReader(strings::to_string(id)));
 
@@ -284,11 +323,16 @@ std::result_of_t<TFn(vector<m2::RegionD>)> CountryInfoReader::WithRegion(size_t
     {
       std::vector<m2::PointD> points;
       serial::LoadOuterPath(src, serial::GeometryCodingParams(), points);
-      rgns.emplace_back(move(points));
+      loaded->emplace_back(move(points));
     }
+    regions = loaded;
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    bool isFound = false;
+    m_cache.Find(key, isFound) = regions;
   }
 
-  return fn(rgns);
+  return fn(*regions);
 }
 
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "storage/countries_raster_index.hpp"
 #include "storage/country.hpp"
 #include "storage/country_decl.hpp"
 
@@ -12,6 +13,7 @@
 #include "base/cache.hpp"
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
@@ -52,8 +54,14 @@ protected:
   // Returns true when |pt| belongs to a country identified by |id|.
   virtual bool IsBelongToRegionImpl(size_t id, m2::PointD const & pt) const = 0;
 
+  // Loads the raster index of |polygonsContainer| if it's present and consistent with
+  // m_countries.
+  void LoadRasterIndex(FilesContainerR const & polygonsContainer);
+
   // List of all known countries.
   std::vector<CountryDef> m_countries;
+  // Resolves most of points without polygons, may be empty.
+  CountriesRasterIndex m_rasterIndex;
   // m_isSingleMwm == true if the system is currently working with single (small) mwms
   // and false otherwise.
   // @TODO(bykoianko) Init m_isSingleMwm correctly.
@@ -156,8 +164,11 @@ protected:
   template <typename TFn>
   std::result_of_t<TFn(vector<m2::RegionD>)> WithRegion(size_t id, TFn && fn) const;
 
+  using Regions = std::shared_ptr<std::vector<m2::RegionD> const>;
+
   FilesContainerR m_reader;
-  mutable base::Cache<uint32_t, std::vector<m2::RegionD>> m_cache;
+  // Regions are shared, so the mutex isn't locked while they are loaded and checked.
+  mutable base::Cache<uint32_t, Regions> m_cache;
   mutable std::mutex m_cacheMutex;
 };
 
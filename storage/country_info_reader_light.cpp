@@ -33,6 +33,7 @@ CountryInfoReader::CountryInfoReader()
     m_reader = std::make_unique<FilesContainerR>(GetPlatform().GetReader(PACKED_POLYGONS_FILE));
     ReaderSource<ModelReaderPtr> src(m_reader->GetReader(PACKED_POLYGONS_INFO_TAG));
     rw::Read(src, m_countries);
+    LoadRasterIndex(*m_reader);
   }
   catch (FileReader::Exception const & exception)
   {
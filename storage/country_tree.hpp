@@ -3,8 +3,8 @@
 #include "base/assert.hpp"
 
 #include "std/algorithm.hpp"
-#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/unordered_map.hpp"
 #include "std/vector.hpp"
 
 /// \brief This class is developed for using in Storage. It's a implementation of a tree with
@@ -156,7 +156,8 @@ public:
   };
 
 private:
-  using TCountryTreeHashTable = multimap<TKey, Node *>;
+  /// Nodes with the same key in the order of adding, i.e. in DFS order.
+  using TCountryTreeHashTable = unordered_map<TKey, vector<Node *>>;
 
 public:
   bool IsEmpty() const { return m_countryTree == nullptr; }
@@ -188,7 +189,7 @@ public:
     }
 
     ASSERT(added, ());
-    m_countryTreeHashTable.insert(make_pair(value.Name(), added));
+    m_countryTreeHashTable[value.Name()].push_back(added);
     return added->Value();
   }
 
@@ -211,15 +212,11 @@ public:
     if (key == m_countryTree->Value().Name())
       found.push_back(m_countryTree.get());
 
-    auto const range = m_countryTreeHashTable.equal_range(key);
-    if (range.first == range.second)
+    auto const it = m_countryTreeHashTable.find(key);
+    if (it == m_countryTreeHashTable.cend())
       return;
 
-    for_each(range.first, range.second,
-             [&found](typename TCountryTreeHashTable::value_type const & node)
-    {
-      found.push_back(node.second);
-    });
+    found.insert(found.end(), it->second.cbegin(), it->second.cend());
   }
 
   Node const * const FindFirst(TKey const & key) const
@@ -227,11 +224,12 @@ public:
     if (IsEmpty())
       return nullptr;
 
-    vector<Node const *> found;
-    Find(key, found);
-    if (found.empty())
+    auto const it = m_countryTreeHashTable.find(key);
+    if (it == m_countryTreeHashTable.cend())
       return nullptr;
-    return found[0];
+
+    ASSERT(!it->second.empty(), ());
+    return it->second.front();
   }
 
   /// \brief Find only leaves.
@@ -244,10 +242,11 @@ public:
     if (IsEmpty())
       return nullptr;
 
-    vector<Node const *> found;
-    Find(key, found);
+    auto const it = m_countryTreeHashTable.find(key);
+    if (it == m_countryTreeHashTable.cend())
+      return nullptr;
 
-    for (auto node : found)
+    for (auto node : it->second)
     {
       if (node->ChildrenCount() == 0)
         return node;
@@ -26,6 +26,15 @@ public:
 
 namespace storage
 {
+// static
+size_t constexpr HttpMapFilesDownloader::kDefaultConnectionsPerServer;
+
+HttpMapFilesDownloader::HttpMapFilesDownloader(size_t connectionsPerServer)
+  : m_connectionsPerServer(connectionsPerServer)
+{
+  CHECK_GREATER(m_connectionsPerServer, 0, ());
+}
+
 HttpMapFilesDownloader::~HttpMapFilesDownloader()
 {
   CHECK_THREAD_CHECKER(m_checker, ());
@@ -47,7 +56,8 @@ void HttpMapFilesDownloader::DownloadMapFile(vector<string> const & urls, string
   CHECK_THREAD_CHECKER(m_checker, ());
   m_request.reset(downloader::HttpRequest::GetFile(
       urls, path, size, bind(&HttpMapFilesDownloader::OnMapFileDownloaded, this, onDownloaded, _1),
-      bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, onProgress, _1)));
+      bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, onProgress, _1),
+      512 * 1024 /* chunkSize */, true /* doCleanOnCancel */, m_connectionsPerServer));
 
   if (!m_request)
   {
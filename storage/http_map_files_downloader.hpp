@@ -14,6 +14,10 @@ namespace storage
 class HttpMapFilesDownloader : public MapFilesDownloader
 {
 public:
+  static size_t constexpr kDefaultConnectionsPerServer = 2;
+
+  /// @param[in] connectionsPerServer  Max number of simultaneous chunk requests to one server.
+  explicit HttpMapFilesDownloader(size_t connectionsPerServer = kDefaultConnectionsPerServer);
   virtual ~HttpMapFilesDownloader();
 
   // MapFilesDownloader overrides:
@@ -34,6 +38,7 @@ private:
   void OnMapFileDownloadingProgress(TDownloadingProgressCallback const & onProgress,
                                     downloader::HttpRequest & request);
 
+  size_t const m_connectionsPerServer;
   unique_ptr<downloader::HttpRequest> m_request;
 
   DECLARE_THREAD_CHECKER(m_checker);
@@ -6,10 +6,13 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
 #include "base/worker_thread.hpp"
 
 #include "3party/Alohalytics/src/alohalytics.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <utility>
 
@@ -19,7 +22,13 @@ namespace
 {
 auto constexpr kTimeoutInSeconds = 5.0;
 
-void DoPing(string const & url, size_t index, vector<string> & readyUrls)
+struct PingResult
+{
+  string m_url;
+  double m_latencyInSeconds = numeric_limits<double>::max();
+};
+
+void DoPing(string const & url, size_t index, vector<PingResult> & results)
 {
   if (url.empty())
   {
@@ -30,9 +39,11 @@ void DoPing(string const & url, size_t index, vector<string> & readyUrls)
   platform::HttpClient request(url);
   request.SetHttpMethod("HEAD");
   request.SetTimeout(kTimeoutInSeconds);
+  base::Timer timer;
   if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
   {
-    readyUrls[index] = url;
+    results[index].m_url = url;
+    results[index].m_latencyInSeconds = timer.ElapsedSeconds();
   }
   else
   {
@@ -59,16 +70,26 @@ void Pinger::Ping(vector<string> const & urls, Pinger::Pong const & pong)
   auto const size = urls.size();
   CHECK_GREATER(size, 0, ());
 
-  vector<string> readyUrls(size);
+  vector<PingResult> results(size);
   {
     base::WorkerThread t(size);
     for (size_t i = 0; i < size; ++i)
-      t.Push([url = urls[i], &readyUrls, i] { DoPing(url, i, readyUrls); });
+      t.Push([url = urls[i], &results, i] { DoPing(url, i, results); });
 
     t.Shutdown(base::WorkerThread::Exit::ExecPending);
   }
 
-  base::EraseIf(readyUrls, [](auto const & url) { return url.empty(); });
+  // The fastest servers go first, servers with equal latency keep the metaserver order.
+  base::EraseIf(results, [](auto const & result) { return result.m_url.empty(); });
+  stable_sort(results.begin(), results.end(), [](auto const & lhs, auto const & rhs) {
+    return lhs.m_latencyInSeconds < rhs.m_latencyInSeconds;
+  });
+
+  vector<string> readyUrls;
+  readyUrls.reserve(results.size());
+  for (auto & result : results)
+    readyUrls.push_back(move(result.m_url));
+
   SendStatistics(readyUrls.size());
   pong(move(readyUrls));
 }
@@ -11,6 +11,8 @@ class Pinger
 {
 public:
   using Pong = platform::SafeCallback<void(std::vector<std::string> readyUrls)>;
+  // Pings |urls| simultaneously and passes available ones to |pong| ordered by latency,
+  // the fastest first.
   static void Ping(std::vector<std::string> const & urls, Pong const & pong);
 };
 }  // namespace storage
@@ -2,15 +2,16 @@
 
 #include <memory>
 
-std::unique_ptr<m4::Tree<routing::NumMwmId>> MakeNumMwmTree(
+std::unique_ptr<m4::PackedTree<routing::NumMwmId>> MakeNumMwmTree(
     routing::NumMwmIds const & numMwmIds, storage::CountryInfoGetter const & countryInfoGetter)
 {
-  auto tree = std::make_unique<m4::Tree<routing::NumMwmId>>();
+  auto tree = std::make_unique<m4::PackedTree<routing::NumMwmId>>();
 
   numMwmIds.ForEachId([&](routing::NumMwmId numMwmId) {
     auto const & countryName = numMwmIds.GetFile(numMwmId).GetName();
     tree->Add(numMwmId, countryInfoGetter.GetLimitRectForLeaf(countryName));
   });
+  tree->Build();
 
   return tree;
 }
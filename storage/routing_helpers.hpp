@@ -5,10 +5,10 @@
 #include "storage/country_info_getter.hpp"
 #include "storage/storage.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 
 #include <memory>
 
-std::unique_ptr<m4::Tree<routing::NumMwmId>> MakeNumMwmTree(
+std::unique_ptr<m4::PackedTree<routing::NumMwmId>> MakeNumMwmTree(
     routing::NumMwmIds const & numMwmIds, storage::CountryInfoGetter const & countryInfoGetter);
 std::shared_ptr<routing::NumMwmIds> CreateNumMwmIds(storage::Storage const & storage);
@@ -1722,14 +1722,18 @@ void Storage::GetNodeAttrs(TCountryId const & countryId, NodeAttrs & nodeAttrs)
       return;
     visitedLocalNodes.insert(countryId);
 
-    // Downloading mwm information.
-    StatusAndError const statusAndErr = GetNodeStatus(d);
-    ASSERT_NOT_EQUAL(statusAndErr.status, NodeStatus::Undefined, ());
-    if (statusAndErr.status != NodeStatus::NotDownloaded &&
-        statusAndErr.status != NodeStatus::Partly && d.ChildrenCount() == 0)
+    // Downloading mwm information. Status of a group node requires a walk over its subtree,
+    // so it's calculated for leaves only.
+    if (d.ChildrenCount() == 0)
     {
-      nodeAttrs.m_downloadingMwmCounter += 1;
-      nodeAttrs.m_downloadingMwmSize += d.Value().GetSubtreeMwmSizeBytes();
+      StatusAndError const statusAndErr = GetNodeStatus(d);
+      ASSERT_NOT_EQUAL(statusAndErr.status, NodeStatus::Undefined, ());
+      if (statusAndErr.status != NodeStatus::NotDownloaded &&
+          statusAndErr.status != NodeStatus::Partly)
+      {
+        nodeAttrs.m_downloadingMwmCounter += 1;
+        nodeAttrs.m_downloadingMwmSize += d.Value().GetSubtreeMwmSizeBytes();
+      }
     }
 
     // Local mwm information.
@@ -0,0 +1,118 @@
+#include "testing/testing.hpp"
+
+#include "storage/countries_raster_index.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace storage;
+using namespace std;
+
+namespace
+{
+using Index = CountriesRasterIndex;
+
+m2::RegionD MakeRegion(vector<m2::PointD> const & points)
+{
+  return m2::RegionD(points.begin(), points.end());
+}
+
+vector<vector<m2::RegionD>> MakeCountries()
+{
+  // The first country is a triangle with a square island, the second one is a square
+  // overlapped by the triangle.
+  return {{MakeRegion({{-100.0, -100.0}, {100.0, -100.0}, {0.0, 100.0}}),
+           MakeRegion({{120.0, 120.0}, {140.0, 120.0}, {140.0, 140.0}, {120.0, 140.0}})},
+          {MakeRegion({{-50.0, -150.0}, {50.0, -150.0}, {50.0, -50.0}, {-50.0, -50.0}})}};
+}
+
+Index::RegionId FindExactly(vector<vector<m2::RegionD>> const & countries, m2::PointD const & pt)
+{
+  for (size_t id = 0; id < countries.size(); ++id)
+  {
+    for (auto const & region : countries[id])
+    {
+      if (region.Contains(pt))
+        return static_cast<Index::RegionId>(id);
+    }
+  }
+  return Index::kOutside;
+}
+}  // namespace
+
+UNIT_TEST(CountriesRasterIndex_Find)
+{
+  auto const countries = MakeCountries();
+  auto const index = Index::Build(countries, 8 /* maxDepth */);
+  TEST(!index.IsEmpty(), ());
+
+  TEST_EQUAL(index.Find({0.0, 0.0}), 0, ());
+  TEST_EQUAL(index.Find({0.0, -120.0}), 1, ());
+  TEST_EQUAL(index.Find({170.0, 0.0}), Index::kOutside, ());
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-160.0, 160.0);
+  size_t bordersCount = 0;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    m2::PointD const pt(coord(rng), coord(rng));
+    auto const id = index.Find(pt);
+    if (id == Index::kBorder)
+      ++bordersCount;
+    else
+      TEST_EQUAL(id, FindExactly(countries, pt), (pt));
+  }
+  // Only a small part of points needs polygons.
+  TEST_LESS(bordersCount, 1000, ());
+}
+
+UNIT_TEST(CountriesRasterIndex_ForEachInsideRegion)
+{
+  auto const index = Index::Build(MakeCountries(), 8 /* maxDepth */);
+
+  vector<bool> found(2, false);
+  index.ForEachInsideRegion(m2::RectD(125.0, 125.0, 135.0, 135.0),
+                            [&found](Index::RegionId id) { found[id] = true; });
+  TEST_EQUAL(found, vector<bool>({true, false}), ());
+
+  found.assign(2, false);
+  index.ForEachInsideRegion(m2::RectD(-10.0, -140.0, 10.0, 10.0),
+                            [&found](Index::RegionId id) { found[id] = true; });
+  TEST_EQUAL(found, vector<bool>({true, true}), ());
+}
+
+UNIT_TEST(CountriesRasterIndex_Serialization)
+{
+  auto const index = Index::Build(MakeCountries(), 6 /* maxDepth */);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    index.Serialize(writer);
+  }
+
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    Index deserialized;
+    TEST(deserialized.Deserialize(src, 2 /* regionsCount */), ());
+    TEST_EQUAL(deserialized.GetNodesCount(), index.GetNodesCount(), ());
+    TEST_EQUAL(deserialized.Find({0.0, 0.0}), 0, ());
+  }
+
+  {
+    // The index refers to the country which is absent.
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    Index deserialized;
+    TEST(!deserialized.Deserialize(src, 1 /* regionsCount */), ());
+    TEST(deserialized.IsEmpty(), ());
+  }
+}
@@ -4,6 +4,14 @@
 
 namespace
 {
+struct Named
+{
+  Named(int name = 0) : m_name(name) {}
+  int Name() const { return m_name; }
+
+  int m_name;
+};
+
 template <class TNode>
 struct Calculator
 {
@@ -58,3 +66,31 @@ UNIT_TEST(CountryTree_Smoke)
   tree.Child(4).Child(0).ForEachAncestorExceptForTheRoot(c3);
   TEST_EQUAL(c3.count, 1, ());
 }
+
+UNIT_TEST(CountryTree_Find)
+{
+  CountryTree<int, Named> tree;
+  tree.AddAtDepth(0, 0);
+  tree.AddAtDepth(1, 1);
+  tree.AddAtDepth(2, 10);
+  tree.AddAtDepth(2, 11);
+  tree.AddAtDepth(1, 2);
+  tree.AddAtDepth(2, 1);
+  tree.AddAtDepth(3, 12);
+
+  TEST(tree.FindFirst(5) == nullptr, ());
+  TEST_EQUAL(tree.FindFirst(10)->Value().Name(), 10, ());
+
+  // Nodes with the same key are found in the order of adding.
+  vector<CountryTree<int, Named>::Node const *> found;
+  tree.Find(1, found);
+  TEST_EQUAL(found.size(), 2, ());
+  TEST_EQUAL(found[0]->Parent().Value().Name(), 0, ());
+  TEST_EQUAL(found[1]->Parent().Value().Name(), 2, ());
+  TEST_EQUAL(tree.FindFirst(1), found[0], ());
+  TEST(tree.FindFirstLeaf(1) == nullptr, ());
+
+  tree.Clear();
+  TEST(tree.IsEmpty(), ());
+  TEST(tree.FindFirst(10) == nullptr, ());
+}
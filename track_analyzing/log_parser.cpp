@@ -37,7 +37,7 @@ vector<DataPoint> ReadDataPoints(string const & data)
 class PointToMwmId final
 {
 public:
-  PointToMwmId(shared_ptr<m4::Tree<routing::NumMwmId>> mwmTree,
+  PointToMwmId(shared_ptr<m4::PackedTree<routing::NumMwmId>> mwmTree,
                routing::NumMwmIds const & numMwmIds, string const & dataDir)
     : m_mwmTree(mwmTree)
   {
@@ -71,7 +71,7 @@ private:
     return it->second;
   }
 
-  shared_ptr<m4::Tree<routing::NumMwmId>> m_mwmTree;
+  shared_ptr<m4::PackedTree<routing::NumMwmId>> m_mwmTree;
   unordered_map<routing::NumMwmId, vector<m2::RegionD>> m_borders;
 };
 }  // namespace
@@ -79,7 +79,8 @@ private:
 namespace track_analyzing
 {
 LogParser::LogParser(shared_ptr<routing::NumMwmIds> numMwmIds,
-                     unique_ptr<m4::Tree<routing::NumMwmId>> mwmTree, string const & dataDir)
+                     unique_ptr<m4::PackedTree<routing::NumMwmId>> mwmTree,
+                     string const & dataDir)
   : m_numMwmIds(move(numMwmIds)), m_mwmTree(move(mwmTree)), m_dataDir(dataDir)
 {
   CHECK(m_numMwmIds, ());
@@ -87,13 +88,6 @@ LogParser::LogParser(shared_ptr<routing::NumMwmIds> numMwmIds,
 }
 
 void LogParser::Parse(string const & logFile, MwmToTracks & mwmToTracks) const
-{
-  UserToTrack userToTrack;
-  ParseUserTracks(logFile, userToTrack);
-  SplitIntoMwms(userToTrack, mwmToTracks);
-}
-
-void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrack) const
 {
   base::Timer timer;
 
@@ -101,8 +95,12 @@ void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrac
   if (!stream)
     MYTHROW(MessageException, ("Can't open file", logFile, "to parse tracks"));
 
+  PointToMwmId const pointToMwmId(m_mwmTree, *m_numMwmIds, m_dataDir);
+
   std::regex const base_regex(R"(.*(DataV0|CurrentData)\s+aloha_id\s*:\s*(\S+)\s+.*\|(\w+)\|)");
   std::unordered_set<string> usersWithOldVersion;
+  // The mwm of the last point of every user, the next point is looked for in it first.
+  unordered_map<string, routing::NumMwmId> userToMwmId;
   uint64_t linesCount = 0;
   size_t pointsCount = 0;
 
@@ -125,44 +123,25 @@ void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrac
     }
 
     auto const packet = ReadDataPoints(data);
-    if (!packet.empty())
-    {
-      Track & track = userToTrack[userId];
-      track.insert(track.end(), packet.cbegin(), packet.cend());
-    }
-
-    pointsCount += packet.size();
-  };
-
-  LOG(LINFO, ("Tracks parsing finished, elapsed:", timer.ElapsedSeconds(), "seconds, lines:",
-              linesCount, ", points", pointsCount));
-  LOG(LINFO, ("Users with current version:", userToTrack.size(), ", old version:",
-              usersWithOldVersion.size()));
-}
-
-void LogParser::SplitIntoMwms(UserToTrack const & userToTrack, MwmToTracks & mwmToTracks) const
-{
-  base::Timer timer;
-
-  PointToMwmId const pointToMwmId(m_mwmTree, *m_numMwmIds, m_dataDir);
-
-  for (auto const & kv : userToTrack)
-  {
-    string const & user = kv.first;
-    Track const & track = kv.second;
+    if (packet.empty())
+      continue;
 
-    routing::NumMwmId mwmId = routing::kFakeNumMwmId;
-    for (DataPoint const & point : track)
+    auto & mwmId = userToMwmId.emplace(userId, routing::kFakeNumMwmId).first->second;
+    for (DataPoint const & point : packet)
     {
       mwmId = pointToMwmId.FindMwmId(MercatorBounds::FromLatLon(point.m_latLon), mwmId);
       if (mwmId != routing::kFakeNumMwmId)
-        mwmToTracks[mwmId][user].push_back(point);
+        mwmToTracks[mwmId][userId].push_back(point);
       else
-        LOG(LERROR, ("Can't match mwm region for", point.m_latLon, ", user:", user));
+        LOG(LERROR, ("Can't match mwm region for", point.m_latLon, ", user:", userId));
     }
+
+    pointsCount += packet.size();
   }
 
-  LOG(LINFO, ("Data was split into", mwmToTracks.size(), "mwms, elapsed:", timer.ElapsedSeconds(),
-              "seconds"));
+  LOG(LINFO, ("Tracks parsing finished, elapsed:", timer.ElapsedSeconds(), "seconds, lines:",
+              linesCount, ", points", pointsCount, ", mwms:", mwmToTracks.size()));
+  LOG(LINFO, ("Users with current version:", userToMwmId.size(), ", old version:",
+              usersWithOldVersion.size()));
 }
 }  // namespace track_analyzing
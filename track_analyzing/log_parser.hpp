@@ -4,7 +4,7 @@
 
 #include "routing_common/num_mwm_id.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 
 #include <memory>
 #include <string>
@@ -15,16 +15,17 @@ class LogParser final
 {
 public:
   LogParser(std::shared_ptr<routing::NumMwmIds> numMwmIds,
-            std::unique_ptr<m4::Tree<routing::NumMwmId>> mwmTree, std::string const & dataDir);
+            std::unique_ptr<m4::PackedTree<routing::NumMwmId>> mwmTree,
+            std::string const & dataDir);
 
+  // Reads |logFile| line by line, the points of every packet are split into mwms right away,
+  // so only the resulting tracks are kept in memory.
   void Parse(std::string const & logFile, MwmToTracks & mwmToTracks) const;
 
 private:
-  void ParseUserTracks(std::string const & logFile, UserToTrack & userToTrack) const;
-  void SplitIntoMwms(UserToTrack const & userToTrack, MwmToTracks & mwmToTracks) const;
 
   std::shared_ptr<routing::NumMwmIds> m_numMwmIds;
-  std::shared_ptr<m4::Tree<routing::NumMwmId>> m_mwmTree;
+  std::shared_ptr<m4::PackedTree<routing::NumMwmId>> m_mwmTree;
   std::string const m_dataDir;
 };
 }  // namespace track_analyzing
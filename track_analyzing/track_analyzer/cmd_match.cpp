@@ -21,9 +21,11 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -34,69 +36,128 @@ namespace
 {
 using Iter = typename vector<string>::iterator;
 
-void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+// A thread is started for this number of users at least, because every thread loads
+// its own graph.
+size_t constexpr kMinUsersPerThread = 100;
+
+struct MatchingStats
 {
-  base::Timer timer;
+  void Add(TrackMatcher const & matcher)
+  {
+    m_tracksCount += matcher.GetTracksCount();
+    m_pointsCount += matcher.GetPointsCount();
+    m_nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+  }
 
-  uint64_t tracksCount = 0;
-  uint64_t pointsCount = 0;
-  uint64_t nonMatchedPointsCount = 0;
+  void Add(MatchingStats const & stats)
+  {
+    m_tracksCount += stats.m_tracksCount;
+    m_pointsCount += stats.m_pointsCount;
+    m_nonMatchedPointsCount += stats.m_nonMatchedPointsCount;
+  }
 
-  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
-    auto const countryFile = platform::CountryFile(mwmName);
-    auto const mwmId = numMwmIds.GetId(countryFile);
-    TrackMatcher matcher(storage, mwmId, countryFile);
+  uint64_t m_tracksCount = 0;
+  uint64_t m_pointsCount = 0;
+  uint64_t m_nonMatchedPointsCount = 0;
+};
+
+// Matches the tracks of an mwm by |threadsCount| threads. The users are taken by the threads
+// one by one, every thread has its own matcher because the road graph caches the geometry
+// and isn't thread safe. The mwm file is mapped, so its data is shared by the threads.
+MatchingStats MatchMwmTracks(string const & mwmName, NumMwmId mwmId, UserToTrack const & userToTrack,
+                             storage::Storage const & storage, size_t threadsCount,
+                             UserToMatchedTracks & userToMatchedTracks)
+{
+  vector<UserToTrack::const_iterator> users;
+  users.reserve(userToTrack.size());
+  for (auto it = userToTrack.cbegin(); it != userToTrack.cend(); ++it)
+    users.push_back(it);
 
-    auto & userToMatchedTracks = mwmToMatchedTracks[mwmId];
+  threadsCount = max(min(threadsCount, users.size() / kMinUsersPerThread), size_t(1));
 
-    for (auto const & it : userToTrack)
+  vector<vector<MatchedTrack>> matchedTracks(users.size());
+  vector<MatchingStats> stats(threadsCount);
+  atomic<size_t> nextUser(0);
+  auto const countryFile = platform::CountryFile(mwmName);
+
+  auto matchUsers = [&](size_t threadIdx) {
+    TrackMatcher matcher(storage, mwmId, countryFile);
+    for (size_t i = nextUser++; i < users.size(); i = nextUser++)
     {
-      string const & user = it.first;
-      auto & matchedTracks = userToMatchedTracks[user];
+      string const & user = users[i]->first;
       try
       {
-        matcher.MatchTrack(it.second, matchedTracks);
+        matcher.MatchTrack(users[i]->second, matchedTracks[i]);
       }
       catch (RootException const & e)
       {
         LOG(LERROR, ("Can't match track for mwm:", mwmName, ", user:", user));
         LOG(LERROR, ("  ", e.what()));
       }
-
-      if (matchedTracks.empty())
-        userToMatchedTracks.erase(user);
     }
+    stats[threadIdx].Add(matcher);
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(matchUsers, i);
+  matchUsers(0);
+  for (auto & t : threads)
+    t.join();
+
+  for (size_t i = 0; i < users.size(); ++i)
+  {
+    if (!matchedTracks[i].empty())
+      userToMatchedTracks[users[i]->first] = move(matchedTracks[i]);
+  }
+
+  MatchingStats result;
+  for (auto const & s : stats)
+    result.Add(s);
+  return result;
+}
+
+void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
+                 NumMwmIds const & numMwmIds, size_t threadsCount,
+                 MwmToMatchedTracks & mwmToMatchedTracks)
+{
+  base::Timer timer;
+
+  MatchingStats total;
+
+  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
+    auto const mwmId = numMwmIds.GetId(platform::CountryFile(mwmName));
 
-    if (userToMatchedTracks.empty())
-      mwmToMatchedTracks.erase(mwmId);
+    UserToMatchedTracks userToMatchedTracks;
+    MatchingStats const stats = MatchMwmTracks(mwmName, mwmId, userToTrack, storage, threadsCount,
+                                               userToMatchedTracks);
+    if (!userToMatchedTracks.empty())
+      mwmToMatchedTracks[mwmId] = move(userToMatchedTracks);
 
-    tracksCount += matcher.GetTracksCount();
-    pointsCount += matcher.GetPointsCount();
-    nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+    total.Add(stats);
 
-    LOG(LINFO, (numMwmIds.GetFile(mwmId).GetName(), ", users:", userToTrack.size(), ", tracks:",
-                matcher.GetTracksCount(), ", points:", matcher.GetPointsCount(),
-                ", non matched points:", matcher.GetNonMatchedPointsCount()));
+    LOG(LINFO, (mwmName, ", users:", userToTrack.size(), ", tracks:", stats.m_tracksCount,
+                ", points:", stats.m_pointsCount,
+                ", non matched points:", stats.m_nonMatchedPointsCount));
   };
 
   ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
 
-  LOG(LINFO,
-      ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
-       ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
+  LOG(LINFO, ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, threads:",
+              threadsCount, ", tracks:", total.m_tracksCount, ", points:", total.m_pointsCount,
+              ", non matched points:", total.m_nonMatchedPointsCount));
 }
 }  // namespace
 
 namespace track_analyzing
 {
-void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage)
+void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage, size_t threadsCount)
 {
   MwmToTracks mwmToTracks;
   ParseTracks(logFile, numMwmIds, mwmToTracks);
 
   MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
+  MatchTracks(mwmToTracks, storage, *numMwmIds, threadsCount, mwmToMatchedTracks);
 
   FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
@@ -110,7 +171,8 @@ void CmdMatch(string const & logFile, string const & trackFile)
   Storage storage;
   storage.RegisterAllLocalMaps(false /* enableDiffs */);
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
-  CmdMatch(logFile, trackFile, numMwmIds, storage);
+  CmdMatch(logFile, trackFile, numMwmIds, storage,
+           max(static_cast<size_t>(thread::hardware_concurrency()), size_t(1)));
 }
 
 void UnzipAndMatch(Iter begin, Iter end, string const & trackExt)
@@ -149,7 +211,8 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt)
       continue;
     }
 
-    CmdMatch(file, file + trackExt, numMwmIds, storage);
+    // The files are matched in parallel already.
+    CmdMatch(file, file + trackExt, numMwmIds, storage, 1 /* threadsCount */);
     FileWriter::DeleteFileX(file);
   }
 }
@@ -5,7 +5,7 @@
 #include "storage/country_info_getter.hpp"
 #include "storage/routing_helpers.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 
 #include "platform/platform.hpp"
 
@@ -24,7 +24,7 @@ void ParseTracks(string const & logFile, shared_ptr<NumMwmIds> const & numMwmIds
   string const dataDir = platform.WritableDir();
   unique_ptr<CountryInfoGetter> countryInfoGetter =
       CountryInfoReader::CreateCountryInfoReader(platform);
-  unique_ptr<m4::Tree<NumMwmId>> mwmTree = MakeNumMwmTree(*numMwmIds, *countryInfoGetter);
+  unique_ptr<m4::PackedTree<NumMwmId>> mwmTree = MakeNumMwmTree(*numMwmIds, *countryInfoGetter);
 
   LOG(LINFO, ("Parsing", logFile));
   LogParser parser(numMwmIds, move(mwmTree), dataDir);
@@ -11,7 +11,11 @@
 
 #include "geometry/parametrized_segment.hpp"
 
-#include "base/stl_helpers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
 
 using namespace routing;
 using namespace std;
@@ -20,7 +24,15 @@ using namespace track_analyzing;
 namespace
 {
 // Matching range in meters.
-double constexpr kMatchingRange = 20.0;
+double constexpr kMatchingRange = 30.0;
+// Standard deviation of the gps error in meters.
+double constexpr kGpsSigma = 10.0;
+// Scale of the difference of the route and straight distances between points in meters.
+double constexpr kTransitionBeta = 10.0;
+// Number of the most probable candidates which are kept for every step.
+size_t constexpr kBeamWidth = 10;
+// Searches from this number of segments are cached, the cache is dropped when it's full.
+size_t constexpr kMaxDistancesCacheSize = 10000;
 
 // Mercator distance from segment to point in meters.
 double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & segmentEnd,
@@ -31,21 +43,15 @@ double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & seg
   return MercatorBounds::DistanceOnEarth(point, projectionPoint);
 }
 
-double DistanceToSegment(Segment const & segment, m2::PointD const & point, IndexGraph & indexGraph)
+double GetEmissionLogProbability(double distance)
 {
-  return DistanceToSegment(indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(false)),
-                           indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(true)), point);
+  double const x = distance / kGpsSigma;
+  return -0.5 * x * x;
 }
 
-bool EdgesContain(vector<SegmentEdge> const & edges, Segment const & segment)
+double GetTransitionLogProbability(double routeDistance, double straightDistance)
 {
-  for (auto const & edge : edges)
-  {
-    if (edge.GetTarget() == segment)
-      return true;
-  }
-
-  return false;
+  return -fabs(routeDistance - straightDistance) / kTransitionBeta;
 }
 }  // namespace
 
@@ -97,20 +103,20 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
     if (trackBegin >= steps.size())
       break;
 
+    steps[trackBegin].InitProbabilities();
+
     size_t trackEnd = trackBegin;
     for (; trackEnd < steps.size() - 1; ++trackEnd)
     {
       Step & nextStep = steps[trackEnd + 1];
-      Step const & prevStep = steps[trackEnd];
-      nextStep.FillCandidates(prevStep, *m_graph);
-      if (!nextStep.HasCandidates())
+      nextStep.FillCandidatesWithNearbySegments(m_dataSource, *m_graph, *m_vehicleModel, m_mwmId);
+      if (!nextStep.HasCandidates() || !nextStep.FillProbabilities(steps[trackEnd], *this))
         break;
     }
 
-    steps[trackEnd].ChooseNearestSegment();
-
+    size_t candidateIdx = steps[trackEnd].ChooseMostProbableSegment();
     for (size_t i = trackEnd; i > trackBegin; --i)
-      steps[i - 1].ChooseSegment(steps[i], *m_graph);
+      candidateIdx = steps[i - 1].ChooseSegment(candidateIdx);
 
     ++m_tracksCount;
 
@@ -124,6 +130,98 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
 
     trackBegin = trackEnd + 1;
   }
+
+  if (m_distancesCache.size() > kMaxDistancesCacheSize)
+    m_distancesCache.clear();
+}
+
+double TrackMatcher::GetFreeFlowSpeedKMpH(Segment const & segment)
+{
+  // The speed for the time estimation is closer to the real speed on a free road than the speed
+  // for the route weights.
+  return m_graph->GetGeometry().GetRoad(segment.GetFeatureId()).GetSpeed().m_eta;
+}
+
+double TrackMatcher::GetRouteDistance(Candidate const & from, Candidate const & to,
+                                      double maxDistance)
+{
+  if (from.GetSegment() == to.GetSegment())
+    return fabs(to.GetOffset() - from.GetOffset());
+
+  auto const & distances = GetDistancesFrom(from.GetSegment(), maxDistance);
+  auto const it = distances.find(to.GetSegment());
+  if (it == distances.cend())
+    return -1.0;
+
+  return GetSegmentLength(from.GetSegment()) - from.GetOffset() + it->second + to.GetOffset();
+}
+
+map<Segment, double> const & TrackMatcher::GetDistancesFrom(Segment const & from,
+                                                           double maxDistance)
+{
+  auto & entry = m_distancesCache[from];
+  if (entry.m_maxDistance >= maxDistance)
+    return entry.m_distances;
+
+  entry.m_maxDistance = maxDistance;
+  auto & distances = entry.m_distances;
+  distances.clear();
+
+  // Dijkstra search by the lengths of the segments.
+  using State = pair<double, Segment>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  vector<SegmentEdge> edges;
+
+  auto const pushTargets = [&](Segment const & segment, double distance) {
+    edges.clear();
+    m_graph->GetEdgeList(segment, true /* isOutgoing */, edges);
+    for (SegmentEdge const & edge : edges)
+    {
+      Segment const & target = edge.GetTarget();
+      if (segment.IsInverse(target) || target == from)
+        continue;
+
+      auto const it = distances.find(target);
+      if (it != distances.cend() && it->second <= distance)
+        continue;
+
+      distances[target] = distance;
+      queue.emplace(distance, target);
+    }
+  };
+
+  pushTargets(from, 0.0);
+  while (!queue.empty())
+  {
+    State const state = queue.top();
+    queue.pop();
+    if (distances[state.second] < state.first)
+      continue;
+
+    double const distance = state.first + GetSegmentLength(state.second);
+    if (distance <= maxDistance)
+      pushTargets(state.second, distance);
+  }
+
+  return distances;
+}
+
+double TrackMatcher::GetSegmentLength(Segment const & segment)
+{
+  auto & geometry = m_graph->GetGeometry();
+  return MercatorBounds::DistanceOnEarth(geometry.GetPoint(segment.GetRoadPoint(false)),
+                                         geometry.GetPoint(segment.GetRoadPoint(true)));
+}
+
+// TrackMatcher::Candidate -------------------------------------------------------------------------
+TrackMatcher::Candidate::Candidate(Segment segment, m2::PointD const & begin, m2::PointD const & end,
+                                   m2::PointD const & point)
+  : m_segment(segment)
+{
+  m2::ParametrizedSegment<m2::PointD> const parametrized(begin, end);
+  m2::PointD const projectionPoint = parametrized.ClosestPointTo(point);
+  m_distance = MercatorBounds::DistanceOnEarth(point, projectionPoint);
+  m_offset = MercatorBounds::DistanceOnEarth(begin, projectionPoint);
 }
 
 // TrackMatcher::Step ------------------------------------------------------------------------------
@@ -136,6 +234,7 @@ void TrackMatcher::Step::FillCandidatesWithNearbySegments(
     DataSource const & dataSource, IndexGraph const & graph,
     VehicleModelInterface const & vehicleModel, NumMwmId mwmId)
 {
+  m_candidates.clear();
   dataSource.ForEachInRect(
       [&](FeatureType & ft) {
         if (!ft.GetID().IsValid())
@@ -151,19 +250,19 @@ void TrackMatcher::Step::FillCandidatesWithNearbySegments(
 
         for (size_t segIdx = 0; segIdx + 1 < ft.GetPointsCount(); ++segIdx)
         {
-          double const distance =
-              DistanceToSegment(ft.GetPoint(segIdx), ft.GetPoint(segIdx + 1), m_point);
-          if (distance < kMatchingRange)
+          m2::PointD const & begin = ft.GetPoint(segIdx);
+          m2::PointD const & end = ft.GetPoint(segIdx + 1);
+          if (DistanceToSegment(begin, end, m_point) < kMatchingRange)
           {
             AddCandidate(Segment(mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
                                  true /* forward */),
-                         distance, graph);
+                         begin, end, graph);
 
             if (!vehicleModel.IsOneWay(ft))
             {
               AddCandidate(Segment(mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
                                    false /* forward */),
-                           distance, graph);
+                           end, begin, graph);
             }
           }
         }
@@ -172,78 +271,88 @@ void TrackMatcher::Step::FillCandidatesWithNearbySegments(
       scales::GetUpperScale());
 }
 
-void TrackMatcher::Step::FillCandidates(Step const & previousStep, IndexGraph & graph)
+void TrackMatcher::Step::InitProbabilities()
 {
-  vector<SegmentEdge> edges;
-
-  for (Candidate const & candidate : previousStep.m_candidates)
+  for (size_t i = 0; i < m_candidates.size(); ++i)
   {
-    Segment const & segment = candidate.GetSegment();
-    m_candidates.emplace_back(segment, DistanceToSegment(segment, m_point, graph));
-
-    edges.clear();
-    graph.GetEdgeList(segment, true /* isOutgoing */, edges);
-
-    for (SegmentEdge const & edge : edges)
-    {
-      Segment const & target = edge.GetTarget();
-      if (!segment.IsInverse(target))
-        m_candidates.emplace_back(target, DistanceToSegment(target, m_point, graph));
-    }
+    Candidate & candidate = m_candidates[i];
+    candidate.SetLogProbability(GetEmissionLogProbability(candidate.GetDistance()), i);
   }
-
-  base::SortUnique(m_candidates);
-
-  m_candidates.erase(remove_if(m_candidates.begin(), m_candidates.end(),
-                               [&](Candidate const & candidate) {
-                                 return candidate.GetDistance() > kMatchingRange;
-                               }),
-                     m_candidates.end());
 }
 
-void TrackMatcher::Step::ChooseSegment(Step const & nextStep, IndexGraph & indexGraph)
+bool TrackMatcher::Step::FillProbabilities(Step const & previousStep, TrackMatcher & matcher)
 {
-  CHECK(!m_candidates.empty(), ());
-
-  double minDistance = numeric_limits<double>::max();
-
-  vector<SegmentEdge> edges;
-  indexGraph.GetEdgeList(nextStep.m_segment, false /* isOutgoing */, edges);
-  edges.emplace_back(nextStep.m_segment, GetAStarWeightZero<RouteWeight>());
+  double const straightDistance = MercatorBounds::DistanceOnEarth(previousStep.m_point, m_point);
+  double const maxRouteDistance = 3.0 * straightDistance + 2.0 * kMatchingRange;
 
-  for (Candidate const & candidate : m_candidates)
+  vector<Candidate> reachable;
+  for (Candidate & candidate : m_candidates)
   {
-    if (candidate.GetDistance() < minDistance && EdgesContain(edges, candidate.GetSegment()))
+    double bestLogProbability = -numeric_limits<double>::max();
+    size_t bestPrevious = previousStep.m_candidates.size();
+    for (size_t i = 0; i < previousStep.m_candidates.size(); ++i)
     {
-      minDistance = candidate.GetDistance();
-      m_segment = candidate.GetSegment();
+      Candidate const & previous = previousStep.m_candidates[i];
+      double const routeDistance = matcher.GetRouteDistance(previous, candidate, maxRouteDistance);
+      if (routeDistance < 0.0)
+        continue;
+
+      double const logProbability =
+          previous.GetLogProbability() +
+          GetTransitionLogProbability(routeDistance, straightDistance);
+      if (logProbability > bestLogProbability)
+      {
+        bestLogProbability = logProbability;
+        bestPrevious = i;
+      }
     }
+
+    if (bestPrevious == previousStep.m_candidates.size())
+      continue;
+
+    candidate.SetLogProbability(
+        bestLogProbability + GetEmissionLogProbability(candidate.GetDistance()), bestPrevious);
+    reachable.push_back(candidate);
+  }
+
+  if (reachable.size() > kBeamWidth)
+  {
+    nth_element(reachable.begin(), reachable.begin() + kBeamWidth, reachable.end(),
+                [](Candidate const & lhs, Candidate const & rhs) {
+                  return lhs.GetLogProbability() > rhs.GetLogProbability();
+                });
+    reachable.erase(reachable.begin() + kBeamWidth, reachable.end());
   }
 
-  if (minDistance == numeric_limits<double>::max())
-    MYTHROW(MessageException, ("Can't find previous step for", nextStep.m_segment));
+  m_candidates = move(reachable);
+  return !m_candidates.empty();
 }
 
-void TrackMatcher::Step::ChooseNearestSegment()
+size_t TrackMatcher::Step::ChooseMostProbableSegment()
 {
   CHECK(!m_candidates.empty(), ());
 
-  double minDistance = numeric_limits<double>::max();
+  auto const it = max_element(m_candidates.cbegin(), m_candidates.cend(),
+                              [](Candidate const & lhs, Candidate const & rhs) {
+                                return lhs.GetLogProbability() < rhs.GetLogProbability();
+                              });
+  m_segment = it->GetSegment();
+  return it->GetPrevious();
+}
 
-  for (Candidate const & candidate : m_candidates)
-  {
-    if (candidate.GetDistance() < minDistance)
-    {
-      minDistance = candidate.GetDistance();
-      m_segment = candidate.GetSegment();
-    }
-  }
+size_t TrackMatcher::Step::ChooseSegment(size_t candidateIdx)
+{
+  CHECK_LESS(candidateIdx, m_candidates.size(), ());
+
+  Candidate const & candidate = m_candidates[candidateIdx];
+  m_segment = candidate.GetSegment();
+  return candidate.GetPrevious();
 }
 
-void TrackMatcher::Step::AddCandidate(Segment const & segment, double distance,
-                                      IndexGraph const & graph)
+void TrackMatcher::Step::AddCandidate(Segment const & segment, m2::PointD const & begin,
+                                      m2::PointD const & end, IndexGraph const & graph)
 {
   if (graph.GetAccessType(segment) == RoadAccess::Type::Yes)
-    m_candidates.emplace_back(segment, distance);
+    m_candidates.emplace_back(segment, begin, end, m_point);
 }
 }  // namespace track_analyzing
@@ -13,12 +13,19 @@
 
 #include "geometry/point2d.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace track_analyzing
 {
+// Matches tracks to the roads by Hidden Markov Model. The states are the segments near
+// the points, the probability of a point to be observed on a segment depends on the distance
+// to it, the probability of a transition depends on the difference of the route distance
+// between the candidates and the straight distance between the points. The most probable
+// sequence of the segments is found by the Viterbi algorithm, only the most probable candidates
+// of every step are kept.
 class TrackMatcher final
 {
 public:
@@ -31,22 +38,41 @@ public:
   uint64_t GetPointsCount() const { return m_pointsCount; }
   uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
 
+  // Returns the speed on the road of |segment| when it's free in km/h.
+  double GetFreeFlowSpeedKMpH(routing::Segment const & segment);
+
 private:
   class Candidate final
   {
   public:
-    Candidate(routing::Segment segment, double distance) : m_segment(segment), m_distance(distance)
-    {
-    }
+    // |begin| and |end| are the points of |segment| in its direction.
+    Candidate(routing::Segment segment, m2::PointD const & begin, m2::PointD const & end,
+              m2::PointD const & point);
 
     routing::Segment const & GetSegment() const { return m_segment; }
     double GetDistance() const { return m_distance; }
+    double GetOffset() const { return m_offset; }
+    double GetLogProbability() const { return m_logProbability; }
+    size_t GetPrevious() const { return m_previous; }
+    void SetLogProbability(double logProbability, size_t previous)
+    {
+      m_logProbability = logProbability;
+      m_previous = previous;
+    }
+
     bool operator==(Candidate const & candidate) const { return m_segment == candidate.m_segment; }
     bool operator<(Candidate const & candidate) const { return m_segment < candidate.m_segment; }
 
   private:
     routing::Segment m_segment;
+    // Distance from the point to the segment in meters.
     double m_distance;
+    // Distance from the beginning of the segment to the projection of the point in meters.
+    double m_offset;
+    // Logarithm of the probability of the most probable path to the candidate and index
+    // of the candidate of the previous step on the path.
+    double m_logProbability = 0.0;
+    size_t m_previous = 0;
   };
 
   class Step final
@@ -61,13 +87,20 @@ private:
                                           routing::IndexGraph const & graph,
                                           routing::VehicleModelInterface const & vehicleModel,
                                           routing::NumMwmId mwmId);
-    void FillCandidates(Step const & previousStep, routing::IndexGraph & graph);
-    void ChooseSegment(Step const & nextStep, routing::IndexGraph & indexGraph);
-    void ChooseNearestSegment();
+    // Sets the probabilities of the candidates for the first step of a track.
+    void InitProbabilities();
+    // Sets the probabilities of the candidates to be reached from |previousStep| and keeps
+    // kBeamWidth most probable ones. Returns false if no candidate can be reached.
+    bool FillProbabilities(Step const & previousStep, TrackMatcher & matcher);
+    // Chooses the most probable candidate of the last step of a track.
+    size_t ChooseMostProbableSegment();
+    // Chooses the candidate with |candidateIdx|, returns index of its candidate
+    // in the previous step.
+    size_t ChooseSegment(size_t candidateIdx);
 
   private:
-    void AddCandidate(routing::Segment const & segment, double distance,
-                      routing::IndexGraph const & graph);
+    void AddCandidate(routing::Segment const & segment, m2::PointD const & begin,
+                      m2::PointD const & end, routing::IndexGraph const & graph);
 
     DataPoint m_dataPoint;
     m2::PointD m_point;
@@ -75,6 +108,22 @@ private:
     std::vector<Candidate> m_candidates;
   };
 
+  struct DistancesCacheEntry
+  {
+    double m_maxDistance = 0.0;
+    std::map<routing::Segment, double> m_distances;
+  };
+
+  // Returns the length of the shortest path from the projection of the point of |from|
+  // to the projection of the point of |to| in meters or a negative value if |to| can't be reached
+  // within |maxDistance|.
+  double GetRouteDistance(Candidate const & from, Candidate const & to, double maxDistance);
+  // Returns the distances from the end of |from| to the beginnings of the segments which
+  // can be reached within |maxDistance|. The searches are cached.
+  std::map<routing::Segment, double> const & GetDistancesFrom(routing::Segment const & from,
+                                                              double maxDistance);
+  double GetSegmentLength(routing::Segment const & segment);
+
   routing::NumMwmId const m_mwmId;
   FrozenDataSource m_dataSource;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
@@ -82,5 +131,6 @@ private:
   uint64_t m_tracksCount = 0;
   uint64_t m_pointsCount = 0;
   uint64_t m_nonMatchedPointsCount = 0;
+  std::map<routing::Segment, DistancesCacheEntry> m_distancesCache;
 };
 }  // namespace track_analyzing
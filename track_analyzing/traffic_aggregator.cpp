@@ -0,0 +1,190 @@
+#include "track_analyzing/traffic_aggregator.hpp"
+
+#include "track_analyzing/utils.hpp"
+
+#include "coding/reader.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <cmath>
+
+using namespace routing;
+using namespace std;
+using namespace track_analyzing;
+using namespace traffic;
+
+namespace
+{
+// Speeds above are errors of positioning.
+double constexpr kMaxSpeedKMpH = 200.0;
+// A segment has a speed group when the weight of its samples is not less, i.e. when there are
+// two points from the last half-life period or more older ones.
+double constexpr kMinWeight = 2.0;
+
+double GetDecay(uint64_t from, uint64_t to)
+{
+  if (to <= from)
+    return 1.0;
+  return exp2(-static_cast<double>(to - from) / TrafficAggregator::kHalfLifeSeconds);
+}
+
+TrafficInfo::RoadSegmentId ToRoadSegmentId(Segment const & segment)
+{
+  return TrafficInfo::RoadSegmentId(segment.GetFeatureId(), segment.GetSegmentIdx(),
+                                    segment.IsForward()
+                                        ? TrafficInfo::RoadSegmentId::kForwardDirection
+                                        : TrafficInfo::RoadSegmentId::kReverseDirection);
+}
+}  // namespace
+
+namespace track_analyzing
+{
+// static
+size_t constexpr TrafficAggregator::kBatchSize;
+// static
+uint64_t constexpr TrafficAggregator::kMaxGapSeconds;
+// static
+uint64_t constexpr TrafficAggregator::kUserTimeoutSeconds;
+// static
+double constexpr TrafficAggregator::kHalfLifeSeconds;
+
+TrafficAggregator::TrafficAggregator(storage::Storage const & storage, NumMwmId mwmId,
+                                     platform::CountryFile const & countryFile,
+                                     vector<TrafficInfo::RoadSegmentId> && keys)
+  : m_matcher(storage, mwmId, countryFile), m_keys(move(keys)), m_estimates(m_keys.GetSize())
+{
+}
+
+bool TrafficAggregator::AddPacket(string const & user, tracking::Protocol::PacketType type,
+                                  vector<uint8_t> const & payload)
+{
+  if (type == tracking::Protocol::PacketType::AuthV0)
+    return false;
+
+  tracking::Protocol::DataElementsVec points;
+  try
+  {
+    points = tracking::Protocol::DecodeDataPacket(type, payload);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't decode packet of", user, e.Msg()));
+    return false;
+  }
+
+  AddPoints(user, points);
+  return true;
+}
+
+void TrafficAggregator::AddPoints(string const & user, vector<DataPoint> const & points)
+{
+  auto & state = m_users[user];
+  for (auto const & point : points)
+  {
+    if (point.m_timestamp <= state.m_lastTimestamp)
+      continue;
+
+    if (!state.m_points.empty() && point.m_timestamp - state.m_lastTimestamp > kMaxGapSeconds)
+    {
+      Match(state);
+      state.m_points.clear();
+    }
+
+    state.m_points.push_back(point);
+    state.m_lastTimestamp = point.m_timestamp;
+
+    if (state.m_points.size() >= kBatchSize)
+      Match(state);
+  }
+}
+
+void TrafficAggregator::Flush(uint64_t now)
+{
+  for (auto it = m_users.begin(); it != m_users.end();)
+  {
+    auto & state = it->second;
+    Match(state);
+    if (state.m_lastTimestamp + kUserTimeoutSeconds < now)
+      it = m_users.erase(it);
+    else
+      ++it;
+  }
+}
+
+vector<SpeedGroup> TrafficAggregator::GetValues(uint64_t now) const
+{
+  vector<SpeedGroup> values(m_estimates.size(), SpeedGroup::Unknown);
+  for (size_t i = 0; i < m_estimates.size(); ++i)
+  {
+    auto const & estimate = m_estimates[i];
+    if (estimate.m_weight * GetDecay(estimate.m_timestamp, now) < kMinWeight ||
+        estimate.m_freeFlowSpeed <= 0.0)
+    {
+      continue;
+    }
+
+    double const speed = estimate.m_speedSum / estimate.m_weight;
+    values[i] = GetSpeedGroupByPercentage(100.0 * speed / estimate.m_freeFlowSpeed);
+  }
+  return values;
+}
+
+void TrafficAggregator::SerializeValues(uint64_t now, vector<uint8_t> & result) const
+{
+  TrafficInfo::SerializeTrafficValues(GetValues(now), result);
+}
+
+void TrafficAggregator::Match(UserState & state)
+{
+  if (state.m_points.size() < 2)
+    return;
+
+  vector<MatchedTrack> tracks;
+  m_matcher.MatchTrack(state.m_points, tracks);
+
+  for (auto const & track : tracks)
+  {
+    for (size_t i = 1; i < track.size(); ++i)
+    {
+      auto const & prev = track[i - 1];
+      auto const & cur = track[i];
+      auto const & prevPoint = prev.GetDataPoint();
+      auto const & curPoint = cur.GetDataPoint();
+      CHECK_GREATER(curPoint.m_timestamp, prevPoint.m_timestamp, ());
+
+      double const speed =
+          CalcSpeedKMpH(ms::DistanceOnEarth(prevPoint.m_latLon, curPoint.m_latLon),
+                        curPoint.m_timestamp - prevPoint.m_timestamp);
+      if (speed > kMaxSpeedKMpH)
+        continue;
+
+      // The user passed both segments with the speed.
+      AddSpeed(prev.GetSegment(), speed, curPoint.m_timestamp);
+      if (cur.GetSegment() != prev.GetSegment())
+        AddSpeed(cur.GetSegment(), speed, curPoint.m_timestamp);
+    }
+  }
+
+  // The last point starts the next batch.
+  DataPoint const last = state.m_points.back();
+  state.m_points.assign(1, last);
+}
+
+void TrafficAggregator::AddSpeed(Segment const & segment, double speedKMpH, uint64_t timestamp)
+{
+  size_t const pos = m_keys.Find(ToRoadSegmentId(segment));
+  if (pos == TrafficInfo::KeysIndex::kNotFound)
+    return;
+
+  auto & estimate = m_estimates[pos];
+  double const decay = GetDecay(estimate.m_timestamp, timestamp);
+  estimate.m_speedSum = estimate.m_speedSum * decay + speedKMpH;
+  estimate.m_weight = estimate.m_weight * decay + 1.0;
+  estimate.m_timestamp = max(estimate.m_timestamp, timestamp);
+  if (estimate.m_freeFlowSpeed == 0.0)
+    estimate.m_freeFlowSpeed = m_matcher.GetFreeFlowSpeedKMpH(segment);
+}
+}  // namespace track_analyzing
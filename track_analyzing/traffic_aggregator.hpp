@@ -0,0 +1,94 @@
+#pragma once
+
+#include "track_analyzing/track.hpp"
+#include "track_analyzing/track_matcher.hpp"
+
+#include "tracking/protocol.hpp"
+
+#include "traffic/speed_groups.hpp"
+#include "traffic/traffic_info.hpp"
+
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "storage/storage.hpp"
+
+#include "platform/country_file.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace track_analyzing
+{
+// Builds traffic of an mwm from the tracking points which come from the users in real time.
+// The points of every user are map matched by batches, the speeds between the matched points
+// are accumulated to the road segments with exponential decay, so the estimates follow
+// the current traffic. The values are emitted in the format of traffic::TrafficInfo.
+// The class is not thread safe.
+class TrafficAggregator final
+{
+public:
+  // |keys| are the traffic keys of the mwm, see traffic::TrafficInfo::ExtractTrafficKeys().
+  TrafficAggregator(storage::Storage const & storage, routing::NumMwmId mwmId,
+                    platform::CountryFile const & countryFile,
+                    std::vector<traffic::TrafficInfo::RoadSegmentId> && keys);
+
+  // Adds the points of a data packet of the tracking protocol from |user|.
+  // Returns false if the packet can't be decoded.
+  bool AddPacket(std::string const & user, tracking::Protocol::PacketType type,
+                 std::vector<uint8_t> const & payload);
+  // Adds |points| from |user|, the points which are older than the last one of the user are
+  // skipped.
+  void AddPoints(std::string const & user, std::vector<DataPoint> const & points);
+
+  // Matches all buffered points and forgets the users which sent nothing
+  // since |now| - kUserTimeoutSeconds.
+  void Flush(uint64_t now);
+
+  // Returns the speed groups aligned with the keys for the moment |now|. The segments without
+  // enough recent points are traffic::SpeedGroup::Unknown.
+  std::vector<traffic::SpeedGroup> GetValues(uint64_t now) const;
+  // Serializes GetValues(|now|) by traffic::TrafficInfo::SerializeTrafficValues().
+  void SerializeValues(uint64_t now, std::vector<uint8_t> & result) const;
+
+  TrackMatcher const & GetTrackMatcher() const { return m_matcher; }
+
+  // The number of points which are matched in one batch.
+  static size_t constexpr kBatchSize = 16;
+  // Points of a user with a bigger time gap are matched as different tracks.
+  static uint64_t constexpr kMaxGapSeconds = 60;
+  static uint64_t constexpr kUserTimeoutSeconds = 10 * 60;
+  // The weight of a speed sample halves for this time.
+  static double constexpr kHalfLifeSeconds = 5 * 60;
+
+private:
+  struct UserState
+  {
+    // Points which are not matched yet. The last matched point is kept at the beginning,
+    // so the speed between the batches isn't lost.
+    std::vector<DataPoint> m_points;
+    uint64_t m_lastTimestamp = 0;
+  };
+
+  struct Estimate
+  {
+    // Sum of the weighted speeds and sum of the weights at |m_timestamp|.
+    double m_speedSum = 0.0;
+    double m_weight = 0.0;
+    uint64_t m_timestamp = 0;
+    double m_freeFlowSpeed = 0.0;
+  };
+
+  void Match(UserState & state);
+  void AddSpeed(routing::Segment const & segment, double speedKMpH, uint64_t timestamp);
+
+  TrackMatcher m_matcher;
+  traffic::TrafficInfo::KeysIndex const m_keys;
+  std::vector<Estimate> m_estimates;
+  std::unordered_map<std::string, UserState> m_users;
+};
+}  // namespace track_analyzing
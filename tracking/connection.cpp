@@ -1,7 +1,5 @@
 #include "tracking/connection.hpp"
 
-#include "tracking/protocol.hpp"
-
 #include "platform/platform.hpp"
 #include "platform/socket.hpp"
 
@@ -55,12 +53,12 @@ void Connection::Shutdown()
 }
 
 // TODO: implement historical
-bool Connection::Send(boost::circular_buffer<DataPoint> const & points)
+bool Connection::Send(boost::circular_buffer<DataPoint> const & points, Protocol::PacketType type)
 {
   if (!m_socket)
     return false;
 
-  auto packet = Protocol::CreateDataPacket(points, tracking::Protocol::PacketType::CurrentData);
+  auto packet = Protocol::CreateDataPacket(points, type);
   return m_socket->Write(packet.data(), static_cast<uint32_t>(packet.size()));
 }
 }  // namespace tracking
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "tracking/protocol.hpp"
+
 #include "coding/traffic.hpp"
 
 #include "std/cstdint.hpp"
@@ -34,7 +36,7 @@ public:
              bool isHistorical);
   bool Reconnect();
   void Shutdown();
-  bool Send(boost::circular_buffer<DataPoint> const & points);
+  bool Send(boost::circular_buffer<DataPoint> const & points, Protocol::PacketType type);
 
 private:
   unique_ptr<platform::Socket> m_socket;
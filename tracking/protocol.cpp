@@ -1,11 +1,14 @@
 #include "tracking/protocol.hpp"
 
 #include "coding/endianness.hpp"
+#include "coding/reader.hpp"
 #include "coding/writer.hpp"
+#include "coding/zlib.hpp"
 
 #include "base/assert.hpp"
 
 #include "std/cstdint.hpp"
+#include "std/iterator.hpp"
 #include "std/sstream.hpp"
 #include "std/utility.hpp"
 
@@ -19,15 +22,29 @@ vector<uint8_t> CreateDataPacketImpl(Container const & points,
   MemWriter<decltype(buffer)> writer(buffer);
 
   uint32_t version = tracking::Protocol::Encoder::kLatestVersion;
+  bool compress = false;
   switch (type)
   {
   case tracking::Protocol::PacketType::DataV0: version = 0; break;
   case tracking::Protocol::PacketType::DataV1: version = 1; break;
+  case tracking::Protocol::PacketType::DataV2:
+    version = 1;
+    compress = true;
+    break;
   case tracking::Protocol::PacketType::AuthV0: ASSERT(false, ("Not a DATA packet.")); break;
   }
 
   tracking::Protocol::Encoder::SerializeDataPoints(version, writer, points);
 
+  if (compress)
+  {
+    using Deflate = coding::ZLib::Deflate;
+    Deflate const deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+    vector<uint8_t> compressed;
+    CHECK(deflate(buffer.data(), buffer.size(), back_inserter(compressed)), ());
+    buffer.swap(compressed);
+  }
+
   auto packet = tracking::Protocol::CreateHeader(type, static_cast<uint32_t>(buffer.size()));
   packet.insert(packet.end(), begin(buffer), end(buffer));
 
@@ -92,7 +109,8 @@ string Protocol::DecodeAuthPacket(Protocol::PacketType type, vector<uint8_t> con
   {
   case Protocol::PacketType::AuthV0: return string(begin(data), end(data));
   case Protocol::PacketType::DataV0:
-  case Protocol::PacketType::DataV1: ASSERT(false, ("Not an AUTH packet.")); break;
+  case Protocol::PacketType::DataV1:
+  case Protocol::PacketType::DataV2: ASSERT(false, ("Not an AUTH packet.")); break;
   }
   return string();
 }
@@ -111,6 +129,19 @@ Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uin
   case Protocol::PacketType::DataV1:
     Encoder::DeserializeDataPoints(1 /* version */, src, points);
     break;
+  case Protocol::PacketType::DataV2:
+  {
+    using Inflate = coding::ZLib::Inflate;
+    Inflate const inflate(Inflate::Format::ZLib);
+    vector<uint8_t> decompressed;
+    if (!inflate(data.data(), data.size(), back_inserter(decompressed)))
+      MYTHROW(Reader::ReadException, ("Can't inflate data packet of size", data.size()));
+
+    MemReader decompressedReader(decompressed.data(), decompressed.size());
+    ReaderSource<MemReader> decompressedSrc(decompressedReader);
+    Encoder::DeserializeDataPoints(1 /* version */, decompressedSrc, points);
+    break;
+  }
   case Protocol::PacketType::AuthV0: ASSERT(false, ("Not a DATA packet.")); break;
   }
   return points;
@@ -138,6 +169,7 @@ string DebugPrint(Protocol::PacketType type)
   case Protocol::PacketType::AuthV0: return "AuthV0";
   case Protocol::PacketType::DataV0: return "DataV0";
   case Protocol::PacketType::DataV1: return "DataV1";
+  case Protocol::PacketType::DataV2: return "DataV2";
   }
   stringstream ss;
   ss << "Unknown(" << static_cast<uint32_t>(type) << ")";
@@ -2,12 +2,66 @@
 
 #include "coding/traffic.hpp"
 
+#include "pyhelpers/batch.hpp"
 #include "pyhelpers/pair.hpp"
 #include "pyhelpers/vector_uint8.hpp"
 
 #include <boost/python.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
+#include <cstring>
+
+namespace
+{
+template <typename T>
+void AppendBytes(T const & value, vector<uint8_t> & buffer)
+{
+  auto const * bytes = reinterpret_cast<uint8_t const *>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// Decodes |packets| of |type| in parallel with the GIL released. Returns the tuple of bytes
+// (offsets, timestamps, lats, lons, traffic) which are the arrays of native uint64, uint64,
+// double, double and uint8 for numpy.frombuffer(). The points of the i-th packet
+// are [offsets[i], offsets[i + 1]).
+boost::python::tuple DecodeDataPackets(tracking::Protocol::PacketType type,
+                                       boost::python::list const & packets)
+{
+  vector<vector<uint8_t>> data;
+  for (size_t i = 0; i < boost::python::len(packets); ++i)
+    data.push_back(boost::python::extract<vector<uint8_t>>(packets[i]));
+
+  vector<uint8_t> offsets;
+  vector<uint8_t> timestamps;
+  vector<uint8_t> lats;
+  vector<uint8_t> lons;
+  vector<uint8_t> traffic;
+  {
+    gil_release release;
+    vector<tracking::Protocol::DataElementsVec> points(data.size());
+    parallel_for(data.size(), [&](size_t i) {
+      points[i] = tracking::Protocol::DecodeDataPacket(type, data[i]);
+    });
+
+    uint64_t offset = 0;
+    AppendBytes(offset, offsets);
+    for (auto const & packetPoints : points)
+    {
+      for (auto const & point : packetPoints)
+      {
+        AppendBytes(point.m_timestamp, timestamps);
+        AppendBytes(point.m_latLon.lat, lats);
+        AppendBytes(point.m_latLon.lon, lons);
+        traffic.push_back(point.m_traffic);
+      }
+      offset += packetPoints.size();
+      AppendBytes(offset, offsets);
+    }
+  }
+  return boost::python::make_tuple(offsets, timestamps, lats, lons, traffic);
+}
+}  // namespace
+
 
 BOOST_PYTHON_MODULE(pytracking)
 {
@@ -36,6 +90,7 @@ BOOST_PYTHON_MODULE(pytracking)
       .value("AuthV0", Protocol::PacketType::AuthV0)
       .value("DataV0", Protocol::PacketType::DataV0)
       .value("DataV1", Protocol::PacketType::DataV1)
+      .value("DataV2", Protocol::PacketType::DataV2)
       .value("CurrentAuth", Protocol::PacketType::CurrentAuth)
       .value("CurrentData", Protocol::PacketType::CurrentData);
 
@@ -57,5 +112,7 @@ BOOST_PYTHON_MODULE(pytracking)
       .def("DecodeHeader", &Protocol::DecodeHeader)
       .staticmethod("DecodeHeader")
       .def("DecodeDataPacket", &Protocol::DecodeDataPacket)
-      .staticmethod("DecodeDataPacket");
+      .staticmethod("DecodeDataPacket")
+      .def("DecodeDataPackets", &DecodeDataPackets)
+      .staticmethod("DecodeDataPackets");
 }
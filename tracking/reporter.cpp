@@ -1,5 +1,7 @@
 #include "tracking/reporter.hpp"
 
+#include "tracking/protocol.hpp"
+
 #include "platform/location.hpp"
 #include "platform/platform.hpp"
 #include "platform/socket.hpp"
@@ -9,6 +11,7 @@
 #include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/target_os.hpp"
 
 #include <cmath>
@@ -19,6 +22,8 @@ double constexpr kRequiredHorizontalAccuracy = 10.0;
 double constexpr kMinDelaySeconds = 1.0;
 double constexpr kReconnectDelaySeconds = 40.0;
 double constexpr kNotChargingEventPeriod = 5 * 60.0;
+// Points are sent before |m_pushDelay| passes when there are so many new ones.
+size_t constexpr kBatchPointsCount = 32;
 
 static_assert(kMinDelaySeconds != 0, "");
 } // namespace
@@ -34,9 +39,13 @@ milliseconds const Reporter::kPushDelayMs = milliseconds(20000);
 Reporter::Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
                    milliseconds pushDelay)
   : m_allowSendingPoints(true)
+  , m_compressPoints(false)
   , m_realtimeSender(move(socket), host, port, false)
   , m_pushDelay(pushDelay)
-  , m_points(ceil(duration_cast<seconds>(pushDelay).count() + kReconnectDelaySeconds) / kMinDelaySeconds)
+  , m_points(max(static_cast<size_t>(ceil(duration_cast<seconds>(pushDelay).count() +
+                                          kReconnectDelaySeconds) /
+                                     kMinDelaySeconds),
+                 2 * kBatchPointsCount))
   , m_thread([this] { Run(); })
 {
 }
@@ -78,6 +87,9 @@ void Reporter::AddLocation(location::GpsInfo const & info, traffic::SpeedGroup t
   m_input.push_back(
       DataPoint(info.m_timestamp, ms::LatLon(info.m_latitude, info.m_longitude),
                 static_cast<std::underlying_type<traffic::SpeedGroup>::type>(traffic)));
+
+  if (m_input.size() >= kBatchPointsCount)
+    m_cv.notify_one();
 }
 
 void Reporter::Run()
@@ -108,7 +120,10 @@ void Reporter::Run()
 
     auto const passedMs = duration_cast<milliseconds>(steady_clock::now() - startTime);
     if (passedMs < m_pushDelay)
-      m_cv.wait_for(lock, m_pushDelay - passedMs, [this]{return m_isFinished;});
+    {
+      m_cv.wait_for(lock, m_pushDelay - passedMs,
+                    [this] { return m_isFinished || m_input.size() >= kBatchPointsCount; });
+    }
   }
 
   LOG(LINFO, ("Tracking Reporter finished"));
@@ -129,8 +144,11 @@ bool Reporter::SendPoints()
   if (m_points.empty())
     return true;
 
+  auto const packetType =
+      m_compressPoints ? Protocol::PacketType::DataV2 : Protocol::PacketType::CurrentData;
+
   if (m_wasConnected)
-    m_wasConnected = m_realtimeSender.Send(m_points);
+    m_wasConnected = m_realtimeSender.Send(m_points, packetType);
 
   if (m_wasConnected)
     return true;
@@ -145,7 +163,7 @@ bool Reporter::SendPoints()
   if (!m_wasConnected)
     return false;
 
-  m_wasConnected = m_realtimeSender.Send(m_points);
+  m_wasConnected = m_realtimeSender.Send(m_points, packetType);
   return m_wasConnected;
 }
 }  // namespace tracking
@@ -42,6 +42,8 @@ public:
   void AddLocation(location::GpsInfo const & info, traffic::SpeedGroup traffic);
 
   void SetAllowSendingPoints(bool allow) { m_allowSendingPoints = allow; }
+  // Points are sent in Protocol::PacketType::DataV2 packets when |compress| is true.
+  void SetCompressPoints(bool compress) { m_compressPoints = compress; }
 
   inline void SetIdleFunc(function<void()> fn) { m_idleFn = fn; }
 
@@ -50,6 +52,7 @@ private:
   bool SendPoints();
 
   atomic<bool> m_allowSendingPoints;
+  atomic<bool> m_compressPoints;
   Connection m_realtimeSender;
   milliseconds m_pushDelay;
   bool m_wasConnected = false;
@@ -58,7 +61,8 @@ private:
   // Function to be called every |kPushDelayMs| in
   // case no points were sent.
   function<void()> m_idleFn;
-  // Input buffer for incoming points. Worker thread steals it contents.
+  // Input buffer for incoming points. Worker thread steals it contents every |m_pushDelay|
+  // or earlier when there are enough points for a batch.
   vector<DataPoint> m_input;
   // Last collected points, sends periodically to server.
   boost::circular_buffer<DataPoint> m_points;
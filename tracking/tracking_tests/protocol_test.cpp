@@ -2,6 +2,8 @@
 
 #include "tracking/protocol.hpp"
 
+#include "coding/reader.hpp"
+
 using namespace tracking;
 
 UNIT_TEST(Protocol_CreateAuthPacket)
@@ -104,4 +106,25 @@ UNIT_TEST(Protocol_DecodeDataPacket)
 
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV0);
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV1);
+  DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV2);
+}
+
+UNIT_TEST(Protocol_CompressedDataPacket)
+{
+  using Container = Protocol::DataElementsVec;
+
+  // Points of a car which goes with a constant speed are compressed well.
+  Container points;
+  for (uint64_t i = 0; i < 100; ++i)
+    points.push_back(Container::value_type(i, ms::LatLon(55.0 + i * 1e-4, 37.0 + i * 1e-4), 0));
+
+  auto const packetV1 = Protocol::CreateDataPacket(points, Protocol::PacketType::DataV1);
+  auto const packetV2 = Protocol::CreateDataPacket(points, Protocol::PacketType::DataV2);
+  TEST_LESS(packetV2.size(), packetV1.size(), ());
+
+  DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV2);
+
+  vector<uint8_t> const broken = {1, 2, 3};
+  TEST_THROW(Protocol::DecodeDataPacket(Protocol::PacketType::DataV2, broken),
+             Reader::ReadException, ());
 }
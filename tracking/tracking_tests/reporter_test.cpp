@@ -48,6 +48,7 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
     }
     case Packet::DataV0:
     case Packet::DataV1:
+    case Packet::DataV2:
     {
       readSize = 0;
       break;
@@ -15,6 +15,7 @@
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
+#include "pyhelpers/batch.hpp"
 #include "pyhelpers/vector_list_conversion.hpp"
 #include "pyhelpers/vector_uint8.hpp"
 
@@ -50,10 +51,11 @@ string SegmentSpeedsRepr(SegmentSpeeds const & v)
   return ss.str();
 }
 
-traffic::TrafficInfo::Coloring TransformToSpeedGroups(SegmentMapping const & segmentMapping)
+map<traffic::TrafficInfo::RoadSegmentId, traffic::SpeedGroup> TransformToSpeedGroups(
+    SegmentMapping const & segmentMapping)
 {
   double const kEps = 1e-9;
-  traffic::TrafficInfo::Coloring result;
+  map<traffic::TrafficInfo::RoadSegmentId, traffic::SpeedGroup> result;
   for (auto const & kv : segmentMapping)
   {
     double const ws = kv.second.m_weightedSpeed;
@@ -101,6 +103,27 @@ boost::python::list GenerateTrafficKeys(string const & mwmPath)
   return std_vector_to_python_list(result);
 }
 
+// Extracts the keys of |mwmPaths| in parallel with the GIL released. Returns the list of the keys
+// of every mwm serialized for generate_traffic_values_from_binary().
+boost::python::list GenerateTrafficKeysBatch(boost::python::list const & mwmPaths)
+{
+  vector<string> const paths = python_list_to_std_vector<string>(mwmPaths);
+  vector<vector<uint8_t>> blobs(paths.size());
+  {
+    gil_release release;
+    parallel_for(paths.size(), [&](size_t i) {
+      vector<traffic::TrafficInfo::RoadSegmentId> keys;
+      traffic::TrafficInfo::ExtractTrafficKeys(paths[i], keys);
+      traffic::TrafficInfo::SerializeTrafficKeys(keys, blobs[i]);
+    });
+  }
+
+  boost::python::list result;
+  for (auto const & blob : blobs)
+    result.append(blob);
+  return result;
+}
+
 vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId> const & keys,
                                       boost::python::dict const & segmentMappingDict)
 {
@@ -114,20 +137,12 @@ vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId
           extract<SegmentSpeeds>(segmentMappingDict[mappingKeys[i]]);
   }
 
-  traffic::TrafficInfo::Coloring const knownColors = TransformToSpeedGroups(segmentMapping);
+  traffic::TrafficInfo::Coloring const knownColors(TransformToSpeedGroups(segmentMapping));
   traffic::TrafficInfo::Coloring coloring;
   traffic::TrafficInfo::CombineColorings(keys, knownColors, coloring);
 
-  vector<traffic::SpeedGroup> values(coloring.size());
-
-  size_t i = 0;
-  for (auto const & kv : coloring)
-  {
-    ASSERT_EQUAL(kv.first, keys[i], ());
-    values[i] = kv.second;
-    ++i;
-  }
-  ASSERT_EQUAL(i, values.size(), ());
+  auto const & values = coloring.GetValues();
+  ASSERT_EQUAL(keys.size(), values.size(), ());
 
   vector<uint8_t> buf;
   traffic::TrafficInfo::SerializeTrafficValues(values, buf);
@@ -197,6 +212,7 @@ BOOST_PYTHON_MODULE(pytraffic)
 
   def("load_classificator", LoadClassificator);
   def("generate_traffic_keys", GenerateTrafficKeys);
+  def("generate_traffic_keys_batch", GenerateTrafficKeysBatch);
   def("generate_traffic_values_from_list", GenerateTrafficValuesFromList);
   def("generate_traffic_values_from_binary", GenerateTrafficValuesFromBinary);
 }
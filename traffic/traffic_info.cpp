@@ -10,8 +10,12 @@
 
 #include "coding/bit_streams.hpp"
 #include "coding/elias_coder.hpp"
+#include "coding/endianness.hpp"
 #include "coding/file_container.hpp"
+#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
+#include "coding/succinct_mapper.hpp"
+#include "coding/succinct_vectors.hpp"
 #include "coding/url_encode.hpp"
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
@@ -78,6 +82,24 @@ string MakeRemoteURL(string const & name, uint64_t version)
 }
 
 char const kETag[] = "etag";
+// Instance manipulation of RFC 3229 for the deltas of traffic values.
+char const kInstanceManipulation[] = "im";
+char const kValuesDeltaEncoding[] = "mwm-traffic-delta";
+// Status of the response with the result of the instance manipulation.
+int constexpr kIMUsedCode = 226;
+
+uint16_t constexpr kLatestMappedKeysVersion = 0;
+
+// Header of TRAFFIC_KEYS_MAPPED_FILE_TAG section. It's followed by the frozen
+// TrafficInfo::KeysIndex::MappedKeys.
+struct MappedKeysHeader
+{
+  uint16_t m_version = kLatestMappedKeysVersion;
+  uint16_t m_endianness = IsBigEndianMacroBased() ? 1 : 0;
+  uint32_t m_reserved = 0;
+};
+
+static_assert(sizeof(MappedKeysHeader) == 8, "Wrong header size of traffic_mapped section.");
 }  // namespace
 
 // TrafficInfo::RoadSegmentId -----------------------------------------------------------------
@@ -88,11 +110,177 @@ TrafficInfo::RoadSegmentId::RoadSegmentId(uint32_t fid, uint16_t idx, uint8_t di
 {
 }
 
+// TrafficInfo::KeysIndex::MappedKeys ---------------------------------------------------------
+// The keys of a feature go by segment index from zero in one or both directions, so they
+// are defined by the position of the first key of the feature and the number of directions.
+struct TrafficInfo::KeysIndex::MappedKeys
+{
+  MappedKeys() = default;
+  MappedKeys(vector<bool> const & features, vector<uint64_t> const & starts,
+             vector<bool> const & twoWay)
+    : m_features(features), m_starts(starts), m_twoWay(twoWay)
+  {
+  }
+
+  template <typename TVisitor>
+  void map(TVisitor & visitor)
+  {
+    visitor(m_features, "m_features")(m_starts, "m_starts")(m_twoWay, "m_twoWay");
+  }
+
+  // Bits of the feature ids, the bits of the features with keys are set.
+  coding::RankSelectBitmap m_features;
+  // Positions of the first keys of the features with keys, the last one is the number of keys.
+  coding::EliasFanoSequence m_starts;
+  // Bits of the features with keys, the bits of the two-way features are set.
+  coding::RankSelectBitmap m_twoWay;
+};
+
+// TrafficInfo::KeysIndex ---------------------------------------------------------------------
+// static
+size_t const TrafficInfo::KeysIndex::kNotFound = numeric_limits<size_t>::max();
+
+TrafficInfo::KeysIndex::KeysIndex() = default;
+
+TrafficInfo::KeysIndex::~KeysIndex() = default;
+
+TrafficInfo::KeysIndex::KeysIndex(vector<RoadSegmentId> && keys) : m_keys(move(keys))
+{
+  ASSERT(is_sorted(m_keys.begin(), m_keys.end()), ());
+  CHECK_LESS(m_keys.size(), numeric_limits<uint32_t>::max(), ());
+
+  for (size_t i = 0; i < m_keys.size(); ++i)
+  {
+    if (i == 0 || m_keys[i].m_fid != m_keys[i - 1].m_fid)
+      m_featureStarts.push_back(static_cast<uint32_t>(i));
+  }
+  auto const featuresCount = static_cast<uint32_t>(m_featureStarts.size());
+  m_featureStarts.push_back(static_cast<uint32_t>(m_keys.size()));
+  if (featuresCount == 0)
+    return;
+
+  // The table is at most half full.
+  uint8_t bits = 1;
+  while ((size_t(1) << bits) < 2 * static_cast<size_t>(featuresCount))
+    ++bits;
+  m_shift = 64 - bits;
+  m_table.assign(size_t(1) << bits, numeric_limits<uint32_t>::max());
+
+  size_t const mask = m_table.size() - 1;
+  for (uint32_t feature = 0; feature < featuresCount; ++feature)
+  {
+    auto slot = GetSlot(m_keys[m_featureStarts[feature]].m_fid);
+    while (m_table[slot] != numeric_limits<uint32_t>::max())
+      slot = (slot + 1) & mask;
+    m_table[slot] = feature;
+  }
+}
+
+size_t TrafficInfo::KeysIndex::Find(RoadSegmentId const & id) const
+{
+  if (m_mapped)
+  {
+    auto const & features = m_mapped->m_features;
+    if (id.m_fid >= features.Size() || !features.Get(id.m_fid))
+      return kNotFound;
+
+    auto const feature = features.Rank(id.m_fid);
+    size_t const dirsCount = m_mapped->m_twoWay.Get(feature) ? 2 : 1;
+    if (id.m_dir >= dirsCount)
+      return kNotFound;
+
+    auto const pos = m_mapped->m_starts.Get(feature) + id.m_idx * dirsCount + id.m_dir;
+    if (pos >= m_mapped->m_starts.Get(feature + 1))
+      return kNotFound;
+    return static_cast<size_t>(pos);
+  }
+
+  if (m_table.empty())
+    return kNotFound;
+
+  size_t const mask = m_table.size() - 1;
+  for (auto slot = GetSlot(id.m_fid); m_table[slot] != numeric_limits<uint32_t>::max();
+       slot = (slot + 1) & mask)
+  {
+    auto const feature = m_table[slot];
+    size_t const begin = m_featureStarts[feature];
+    if (m_keys[begin].m_fid != id.m_fid)
+      continue;
+
+    // Keys which are extracted from mwm go by segment index from zero with one or
+    // two directions, otherwise the keys of the feature are searched.
+    size_t const end = m_featureStarts[feature + 1];
+    size_t const dirsCount =
+        (end - begin > 1 && m_keys[begin + 1].m_idx == m_keys[begin].m_idx) ? 2 : 1;
+    size_t const pos = begin + id.m_idx * dirsCount + id.m_dir;
+    if (pos < end && m_keys[pos] == id)
+      return pos;
+
+    auto const it = lower_bound(m_keys.begin() + begin, m_keys.begin() + end, id);
+    if (it != m_keys.begin() + end && *it == id)
+      return static_cast<size_t>(distance(m_keys.begin(), it));
+    return kNotFound;
+  }
+  return kNotFound;
+}
+
+size_t TrafficInfo::KeysIndex::GetSize() const
+{
+  if (m_mapped)
+    return static_cast<size_t>(m_mapped->m_starts.Get(m_mapped->m_starts.Size() - 1));
+  return m_keys.size();
+}
+
+size_t TrafficInfo::KeysIndex::GetSlot(uint32_t fid) const
+{
+  // Fibonacci hashing.
+  return static_cast<size_t>((static_cast<uint64_t>(fid) * 0x9E3779B97F4A7C15ULL) >> m_shift);
+}
+
+// TrafficInfo::Coloring ----------------------------------------------------------------------
+TrafficInfo::Coloring::Coloring(shared_ptr<KeysIndex const> const & keys,
+                                vector<SpeedGroup> const & values)
+  : m_keys(keys), m_values(values)
+{
+  CHECK(m_keys, ());
+  CHECK_EQUAL(m_keys->GetSize(), m_values.size(), ());
+}
+
+TrafficInfo::Coloring::Coloring(initializer_list<pair<RoadSegmentId, SpeedGroup>> const & colors)
+  : Coloring(map<RoadSegmentId, SpeedGroup>(colors.begin(), colors.end()))
+{
+}
+
+TrafficInfo::Coloring::Coloring(map<RoadSegmentId, SpeedGroup> const & colors)
+{
+  vector<RoadSegmentId> keys;
+  keys.reserve(colors.size());
+  m_values.reserve(colors.size());
+  for (auto const & kv : colors)
+  {
+    keys.push_back(kv.first);
+    m_values.push_back(kv.second);
+  }
+  m_keys = make_shared<KeysIndex const>(move(keys));
+}
+
+SpeedGroup TrafficInfo::Coloring::Get(RoadSegmentId const & id) const
+{
+  if (!m_keys)
+    return SpeedGroup::Unknown;
+
+  auto const pos = m_keys->Find(id);
+  if (pos == KeysIndex::kNotFound)
+    return SpeedGroup::Unknown;
+  return m_values[pos];
+}
+
 // TrafficInfo --------------------------------------------------------------------------------
 
 // static
 uint8_t const TrafficInfo::kLatestKeysVersion = 0;
 uint8_t const TrafficInfo::kLatestValuesVersion = 0;
+uint8_t const TrafficInfo::kLatestValuesDeltaVersion = 0;
 
 TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion)
   : m_mwmId(mwmId)
@@ -107,6 +295,16 @@ TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion
   try
   {
     FilesContainerR rcont(mwmPath);
+    if (rcont.IsExist(TRAFFIC_KEYS_MAPPED_FILE_TAG))
+    {
+      LOG(LINFO, ("Mapping keys for", mwmId, "from section"));
+      FilesMappingContainer const mcont(mwmPath);
+      m_keys = MapTrafficKeys(
+          make_unique<MappedMemoryRegion>(mcont.Map(TRAFFIC_KEYS_MAPPED_FILE_TAG)));
+      if (m_keys)
+        return;
+    }
+
     if (rcont.IsExist(TRAFFIC_KEYS_FILE_TAG))
     {
       auto reader = rcont.GetReader(TRAFFIC_KEYS_FILE_TAG);
@@ -115,7 +313,9 @@ TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion
       LOG(LINFO, ("Reading keys for", mwmId, "from section"));
       try
       {
-        DeserializeTrafficKeys(buf, m_keys);
+        vector<RoadSegmentId> keys;
+        DeserializeTrafficKeys(buf, keys);
+        m_keys = make_shared<KeysIndex const>(move(keys));
       }
       catch (Reader::Exception const & e)
       {
@@ -151,7 +351,7 @@ TrafficInfo TrafficInfo::BuildForTesting(Coloring && coloring)
 
 void TrafficInfo::SetTrafficKeysForTesting(vector<RoadSegmentId> const & keys)
 {
-  m_keys = keys;
+  m_keys = make_shared<KeysIndex const>(vector<RoadSegmentId>(keys));
   m_availability = Availability::IsAvailable;
 }
 
@@ -162,6 +362,7 @@ bool TrafficInfo::ReceiveTrafficData(string & etag)
   {
   case ServerDataStatus::New:
     return UpdateTrafficData(values);
+  case ServerDataStatus::Delta:
   case ServerDataStatus::NotChanged:
     return true;
   case ServerDataStatus::NotFound:
@@ -173,10 +374,7 @@ bool TrafficInfo::ReceiveTrafficData(string & etag)
 
 SpeedGroup TrafficInfo::GetSpeedGroup(RoadSegmentId const & id) const
 {
-  auto const it = m_coloring.find(id);
-  if (it == m_coloring.cend())
-    return SpeedGroup::Unknown;
-  return it->second;
+  return m_coloring.Get(id);
 }
 
 // static
@@ -205,26 +403,27 @@ void TrafficInfo::CombineColorings(vector<TrafficInfo::RoadSegmentId> const & ke
                                    TrafficInfo::Coloring const & knownColors,
                                    TrafficInfo::Coloring & result)
 {
-  result.clear();
+  vector<SpeedGroup> values;
+  values.reserve(keys.size());
   size_t numKnown = 0;
   size_t numUnknown = 0;
-  size_t numUnexpectedKeys = knownColors.size();
+  size_t numUnexpectedKeys = knownColors.GetSize();
   for (auto const & key : keys)
   {
-    auto it = knownColors.find(key);
-    if (it == knownColors.end())
+    auto const speedGroup = knownColors.Get(key);
+    values.push_back(speedGroup);
+    if (speedGroup == SpeedGroup::Unknown)
     {
-      result[key] = SpeedGroup::Unknown;
       ++numUnknown;
     }
     else
     {
-      result[key] = it->second;
       ASSERT_GREATER(numUnexpectedKeys, 0, ());
       --numUnexpectedKeys;
       ++numKnown;
     }
   }
+  result = Coloring(make_shared<KeysIndex const>(vector<RoadSegmentId>(keys)), values);
 
   LOG(LINFO, ("Road segments: known/unknown/total =", numKnown, numUnknown, numKnown + numUnknown));
   ASSERT_EQUAL(numUnexpectedKeys, 0, ());
@@ -342,6 +541,95 @@ void TrafficInfo::DeserializeTrafficKeys(vector<uint8_t> const & data,
   }
 }
 
+// static
+void TrafficInfo::SerializeMappedTrafficKeys(vector<RoadSegmentId> const & keys,
+                                             vector<uint8_t> & result)
+{
+  vector<bool> features;
+  vector<uint64_t> starts;
+  vector<bool> twoWay;
+  for (size_t i = 0; i < keys.size();)
+  {
+    uint32_t const fid = keys[i].m_fid;
+    CHECK(features.empty() || fid >= features.size(), ("Keys should be sorted."));
+    size_t j = i;
+    while (j < keys.size() && keys[j].m_fid == fid)
+      ++j;
+
+    bool const isTwoWay = j - i > 1 && keys[i + 1].m_idx == keys[i].m_idx;
+    size_t const dirsCount = isTwoWay ? 2 : 1;
+    for (size_t k = i; k < j; ++k)
+    {
+      RoadSegmentId const expected(fid, static_cast<uint16_t>((k - i) / dirsCount),
+                                   static_cast<uint8_t>((k - i) % dirsCount));
+      CHECK_EQUAL(keys[k], expected, ("Keys of a feature should go by segment index."));
+    }
+    CHECK_EQUAL((j - i) % dirsCount, 0, (keys[i]));
+
+    features.resize(static_cast<size_t>(fid) + 1, false);
+    features[fid] = true;
+    starts.push_back(i);
+    twoWay.push_back(isTwoWay);
+    i = j;
+  }
+  starts.push_back(keys.size());
+
+  MemWriter<vector<uint8_t>> writer(result);
+  MappedKeysHeader const header;
+  WriteToSink(writer, header.m_version);
+  WriteToSink(writer, header.m_endianness);
+  WriteToSink(writer, header.m_reserved);
+
+  KeysIndex::MappedKeys mappedKeys(features, starts, twoWay);
+  coding::Freeze(mappedKeys, writer, "MappedKeys");
+}
+
+// static
+shared_ptr<TrafficInfo::KeysIndex const> TrafficInfo::MapTrafficKeys(
+    unique_ptr<MemoryRegion> && region)
+{
+  CHECK(region, ());
+  uint8_t const * const data = region->ImmutableData();
+  MemReaderWithExceptions reader(data, region->Size());
+  ReaderSource<decltype(reader)> src(reader);
+
+  MappedKeysHeader header;
+  header.m_version = ReadPrimitiveFromSource<uint16_t>(src);
+  header.m_endianness = ReadPrimitiveFromSource<uint16_t>(src);
+  header.m_reserved = ReadPrimitiveFromSource<uint32_t>(src);
+  if (header.m_version != kLatestMappedKeysVersion)
+  {
+    LOG(LWARNING, ("Unknown mapped traffic keys version", header.m_version,
+                   ", current version", kLatestMappedKeysVersion));
+    return nullptr;
+  }
+
+  if (header.m_endianness != MappedKeysHeader().m_endianness)
+  {
+    LOG(LWARNING, ("Mapped traffic keys have another byte order."));
+    return nullptr;
+  }
+
+  if (!coding::IsAlign8(reinterpret_cast<uint64_t>(data)))
+  {
+    LOG(LWARNING, ("Mapped traffic keys are not aligned."));
+    return nullptr;
+  }
+
+  auto index = make_shared<KeysIndex>();
+  index->m_mapped = make_unique<KeysIndex::MappedKeys>();
+  uint64_t const bytesRead =
+      coding::Map(*index->m_mapped, data + sizeof(MappedKeysHeader), "MappedKeys");
+  if (sizeof(MappedKeysHeader) + bytesRead != region->Size())
+  {
+    LOG(LWARNING, ("Wrong size of mapped traffic keys", region->Size(), "expected",
+                   sizeof(MappedKeysHeader) + bytesRead));
+    return nullptr;
+  }
+  index->m_region = move(region);
+  return index;
+}
+
 // static
 void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
                                          vector<uint8_t> & result)
@@ -397,6 +685,103 @@ void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
   ASSERT_EQUAL(src.Size(), 0, ());
 }
 
+// static
+void TrafficInfo::SerializeTrafficValuesDelta(vector<SpeedGroup> const & oldValues,
+                                              vector<SpeedGroup> const & newValues,
+                                              vector<uint8_t> & result)
+{
+  CHECK_EQUAL(oldValues.size(), newValues.size(), ());
+
+  vector<uint8_t> runs;
+  MemWriter<vector<uint8_t>> runsWriter(runs);
+  uint32_t runsCount = 0;
+  size_t runEnd = 0;
+  for (size_t i = 0; i < newValues.size(); ++i)
+  {
+    if (oldValues[i] == newValues[i])
+      continue;
+
+    // Unchanged values equal to the changed ones are included to the run,
+    // so that neighbouring changes go in one run.
+    size_t end = i + 1;
+    while (end < newValues.size() && newValues[end] == newValues[i])
+      ++end;
+
+    WriteVarUint(runsWriter, static_cast<uint32_t>(i - runEnd));
+    WriteVarUint(runsWriter, static_cast<uint32_t>(end - i - 1));
+    WriteToSink(runsWriter, static_cast<uint8_t>(newValues[i]));
+    ++runsCount;
+
+    runEnd = end;
+    i = end - 1;
+  }
+
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> memWriter(buf);
+  WriteToSink(memWriter, kLatestValuesDeltaVersion);
+  WriteVarUint(memWriter, static_cast<uint32_t>(newValues.size()));
+  WriteVarUint(memWriter, runsCount);
+  memWriter.Write(runs.data(), runs.size());
+
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  deflate(buf.data(), buf.size(), back_inserter(result));
+}
+
+// static
+void TrafficInfo::ApplyTrafficValuesDelta(vector<uint8_t> const & data,
+                                          vector<SpeedGroup> & values)
+{
+  using Inflate = coding::ZLib::Inflate;
+
+  vector<uint8_t> decompressedData;
+
+  Inflate inflate(Inflate::Format::ZLib);
+  inflate(data.data(), data.size(), back_inserter(decompressedData));
+
+  MemReaderWithExceptions memReader(decompressedData.data(), decompressedData.size());
+  ReaderSource<decltype(memReader)> src(memReader);
+
+  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+  if (version != kLatestValuesDeltaVersion)
+    MYTHROW(Reader::ReadException, ("Unsupported version of traffic values delta:", version));
+
+  auto const n = ReadVarUint<uint32_t>(src);
+  if (n != values.size())
+  {
+    MYTHROW(Reader::ReadException,
+            ("Traffic values delta for", n, "values, expected", values.size()));
+  }
+
+  struct Run
+  {
+    size_t m_begin;
+    size_t m_end;
+    SpeedGroup m_speedGroup;
+  };
+
+  // The runs are read before they are applied, so |values| are not changed by a broken delta.
+  auto const runsCount = ReadVarUint<uint32_t>(src);
+  vector<Run> runs;
+  runs.reserve(min(static_cast<size_t>(runsCount), values.size()));
+  size_t pos = 0;
+  for (uint32_t i = 0; i < runsCount; ++i)
+  {
+    pos += ReadVarUint<uint32_t>(src);
+    size_t const length = static_cast<size_t>(ReadVarUint<uint32_t>(src)) + 1;
+    auto const speedGroup = ReadPrimitiveFromSource<uint8_t>(src);
+    if (pos + length > values.size() || speedGroup >= static_cast<uint8_t>(SpeedGroup::Count))
+      MYTHROW(Reader::ReadException, ("Broken traffic values delta, run", i));
+
+    runs.push_back({pos, pos + length, static_cast<SpeedGroup>(speedGroup)});
+    pos += length;
+  }
+
+  for (auto const & run : runs)
+    fill(values.begin() + run.m_begin, values.begin() + run.m_end, run.m_speedGroup);
+}
+
 // todo(@m) This is a temporary method. Do not refactor it.
 bool TrafficInfo::ReceiveTrafficKeys()
 {
@@ -432,7 +817,7 @@ bool TrafficInfo::ReceiveTrafficKeys()
                 "Version:", info->GetVersion()));
     return false;
   }
-  m_keys.swap(keys);
+  m_keys = make_shared<KeysIndex const>(move(keys));
   return true;
 }
 
@@ -451,21 +836,44 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   if (url.empty())
     return ServerDataStatus::Error;
 
+  // The server may send the changes since the version of |etag| instead of all the values.
+  bool const canApplyDelta = !etag.empty() && !m_coloring.IsEmpty();
+
   platform::HttpClient request(url);
   request.LoadHeaders(true);
   request.SetRawHeader("User-Agent", GetPlatform().GetAppUserAgent());
   request.SetRawHeader("If-None-Match", etag);
+  if (canApplyDelta)
+    request.SetRawHeader("A-IM", kValuesDeltaEncoding);
+
+  if (!request.RunHttpRequest())
+    return ProcessFailure(request, version);
 
-  if (!request.RunHttpRequest() || request.ErrorCode() != 200)
+  bool isDelta = false;
+  if (canApplyDelta && request.ErrorCode() == kIMUsedCode)
+  {
+    auto const & headers = request.GetHeaders();
+    auto const it = headers.find(kInstanceManipulation);
+    isDelta = it != headers.end() && it->second == kValuesDeltaEncoding;
+  }
+
+  if (request.ErrorCode() != 200 && !isDelta)
     return ProcessFailure(request, version);
   try
   {
     string const & response = request.ServerResponse();
     vector<uint8_t> contents(response.cbegin(), response.cend());
-    DeserializeTrafficValues(contents, values);
+    if (isDelta)
+      ApplyTrafficValuesDelta(contents, m_coloring.m_values);
+    else
+      DeserializeTrafficValues(contents, values);
   }
   catch (Reader::Exception const & e)
   {
+    // All the values are requested next time.
+    if (isDelta)
+      etag.clear();
+
     m_availability = Availability::NoData;
     LOG(LWARNING, ("Could not read traffic values received from server. MWM:",
                    info->GetCountryName(), "Version:", info->GetVersion()));
@@ -484,31 +892,29 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
     etag = it->second;
 
   m_availability = Availability::IsAvailable;
-  return ServerDataStatus::New;
+  return isDelta ? ServerDataStatus::Delta : ServerDataStatus::New;
 }
 
 bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
 {
-  m_coloring.clear();
+  m_coloring = Coloring();
 
-  if (m_keys.size() != values.size())
+  size_t const keysCount = m_keys ? m_keys->GetSize() : 0;
+  if (keysCount != values.size())
   {
     LOG(LWARNING,
         ("The number of received traffic values does not correspond to the number of keys:",
-         m_keys.size(), "keys", values.size(), "values."));
+         keysCount, "keys", values.size(), "values."));
     alohalytics::LogEvent(
         "$TrafficUpdateError",
-        alohalytics::TStringMap({{"keysCount", strings::to_string(m_keys.size())},
+        alohalytics::TStringMap({{"keysCount", strings::to_string(keysCount)},
                                  {"valuesCount", strings::to_string(values.size())}}));
     m_availability = Availability::NoData;
     return false;
   }
 
-  for (size_t i = 0; i < m_keys.size(); ++i)
-  {
-    if (values[i] != SpeedGroup::Unknown)
-      m_coloring.emplace(m_keys[i], values[i]);
-  }
+  if (keysCount != 0)
+    m_coloring = Coloring(m_keys, values);
 
   return true;
 }
@@ -5,10 +5,15 @@
 #include "indexer/mwm_set.hpp"
 
 #include "std/cstdint.hpp"
+#include "std/initializer_list.hpp"
 #include "std/map.hpp"
 #include "std/shared_ptr.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
+class MemoryRegion;
+
 namespace platform
 {
 class HttpClient;
@@ -24,6 +29,7 @@ class TrafficInfo
 public:
   static uint8_t const kLatestKeysVersion;
   static uint8_t const kLatestValuesVersion;
+  static uint8_t const kLatestValuesDeltaVersion;
 
   enum class Availability
   {
@@ -73,8 +79,69 @@ public:
     uint8_t m_dir : 1;
   };
 
-  // todo(@m) unordered_map?
-  using Coloring = map<RoadSegmentId, SpeedGroup>;
+  // Positions of the road segments in a sorted list of keys. A segment is found in O(1):
+  // the first key of its feature is got from a hash table of feature ids and the keys
+  // of a feature go by segment index and direction.
+  // The keys of TRAFFIC_KEYS_MAPPED_FILE_TAG section are not decoded at all, the index is
+  // used in place of the mapped section, see MapTrafficKeys().
+  class KeysIndex
+  {
+  public:
+    static size_t const kNotFound;
+
+    KeysIndex();
+    explicit KeysIndex(vector<RoadSegmentId> && keys);
+    ~KeysIndex();
+
+    // Returns the position of |id| in the keys or kNotFound.
+    size_t Find(RoadSegmentId const & id) const;
+
+    size_t GetSize() const;
+
+  private:
+    friend class TrafficInfo;
+
+    struct MappedKeys;
+
+    size_t GetSlot(uint32_t fid) const;
+
+    // The mapped keys. When they are set, the other fields are empty.
+    unique_ptr<MemoryRegion> m_region;
+    unique_ptr<MappedKeys> m_mapped;
+
+    vector<RoadSegmentId> m_keys;
+    // Positions of the first keys of the features, the last one is the number of keys.
+    vector<uint32_t> m_featureStarts;
+    // Open addressing hash table of the indices in |m_featureStarts|.
+    vector<uint32_t> m_table;
+    uint8_t m_shift = 0;
+  };
+
+  // Speed groups of the road segments stored in a dense array aligned with the keys.
+  // Copies share the keys, so copying is a copy of the speed groups.
+  class Coloring
+  {
+  public:
+    Coloring() = default;
+    Coloring(shared_ptr<KeysIndex const> const & keys, vector<SpeedGroup> const & values);
+    // Used for tests and tools where the keys are known only with the speed groups.
+    Coloring(initializer_list<pair<RoadSegmentId, SpeedGroup>> const & colors);
+    explicit Coloring(map<RoadSegmentId, SpeedGroup> const & colors);
+
+    // Returns SpeedGroup::Unknown if there is no |id| among the keys.
+    SpeedGroup Get(RoadSegmentId const & id) const;
+
+    bool IsEmpty() const { return m_values.empty(); }
+    size_t GetSize() const { return m_values.size(); }
+    vector<SpeedGroup> const & GetValues() const { return m_values; }
+
+  private:
+    // TrafficInfo applies deltas of the values in place.
+    friend class TrafficInfo;
+
+    shared_ptr<KeysIndex const> m_keys;
+    vector<SpeedGroup> m_values;
+  };
 
   TrafficInfo() = default;
 
@@ -88,6 +155,8 @@ public:
   // The ETag or entity tag is part of HTTP, the protocol for the World Wide Web.
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
+  // When there is a coloring already, only the changes since the version of |etag|
+  // are requested and applied to the coloring (delta encoding in HTTP, RFC 3229).
   // *NOTE* This method must not be called on the UI thread.
   bool ReceiveTrafficData(string & etag);
 
@@ -102,8 +171,8 @@ public:
   // Extracts RoadSegmentIds from mwm and stores them in a sorted order.
   static void ExtractTrafficKeys(string const & mwmPath, vector<RoadSegmentId> & result);
 
-  // Adds the unknown values to the partially known coloring map |knownColors|
-  // so that the keys of the resulting map are exactly |keys|.
+  // Adds the unknown values to the partially known coloring |knownColors|
+  // so that the keys of the resulting coloring are exactly |keys|. |keys| must be sorted.
   static void CombineColorings(vector<TrafficInfo::RoadSegmentId> const & keys,
                                TrafficInfo::Coloring const & knownColors,
                                TrafficInfo::Coloring & result);
@@ -116,14 +185,36 @@ public:
 
   static void DeserializeTrafficKeys(vector<uint8_t> const & data, vector<RoadSegmentId> & result);
 
+  // Serializes |keys| for TRAFFIC_KEYS_MAPPED_FILE_TAG section. The keys must be sorted and
+  // the keys of every feature must go by segment index from zero in one or both directions,
+  // as ExtractTrafficKeys() returns them.
+  static void SerializeMappedTrafficKeys(vector<RoadSegmentId> const & keys,
+                                         vector<uint8_t> & result);
+
+  // Returns the index which uses the keys serialized by SerializeMappedTrafficKeys() in place
+  // of |region| and keeps |region| alive. Returns nullptr if the keys have unknown version
+  // or another byte order.
+  static shared_ptr<KeysIndex const> MapTrafficKeys(unique_ptr<MemoryRegion> && region);
+
   static void SerializeTrafficValues(vector<SpeedGroup> const & values, vector<uint8_t> & result);
 
   static void DeserializeTrafficValues(vector<uint8_t> const & data, vector<SpeedGroup> & result);
 
+  // Serializes the changes from |oldValues| to |newValues| as runs of equal speed groups,
+  // every run is preceded by the number of values which are skipped before it.
+  static void SerializeTrafficValuesDelta(vector<SpeedGroup> const & oldValues,
+                                          vector<SpeedGroup> const & newValues,
+                                          vector<uint8_t> & result);
+
+  // Applies the delta which is serialized by SerializeTrafficValuesDelta() to |values|.
+  // Throws Reader::Exception and does not change |values| if the delta doesn't fit them.
+  static void ApplyTrafficValuesDelta(vector<uint8_t> const & data, vector<SpeedGroup> & values);
+
 private:
   enum class ServerDataStatus
   {
     New,
+    Delta,
     NotChanged,
     NotFound,
     Error,
@@ -137,7 +228,7 @@ private:
 
   // Tries to read the values of the Coloring map from server into |values|.
   // Returns result of communicating with server as ServerDataStatus.
-  // Otherwise, returns false and does not change m_coloring.
+  // A delta is applied to m_coloring in place, in other cases m_coloring is not changed.
   ServerDataStatus ReceiveTrafficValues(string & etag, vector<SpeedGroup> & values);
 
   // Updates the coloring and changes the availability status if needed.
@@ -148,11 +239,11 @@ private:
   // The mapping from feature segments to speed groups (see speed_groups.hpp).
   Coloring m_coloring;
 
-  // The keys of the coloring map. The values are downloaded periodically
+  // The keys of the coloring. The values are downloaded periodically
   // and combined with the keys to form m_coloring.
   // *NOTE* The values must be received in the exact same order that the
   // keys are saved in.
-  vector<RoadSegmentId> m_keys;
+  shared_ptr<KeysIndex const> m_keys;
 
   MwmSet::MwmId m_mwmId;
   Availability m_availability = Availability::Unknown;
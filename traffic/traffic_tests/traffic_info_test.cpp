@@ -8,8 +8,12 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include "coding/memory_region.hpp"
+#include "coding/reader.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
+#include "std/map.hpp"
 #include "std/vector.hpp"
 
 namespace traffic
@@ -67,7 +71,7 @@ UNIT_TEST(TrafficInfo_RemoteFile)
 
 UNIT_TEST(TrafficInfo_Serialization)
 {
-  TrafficInfo::Coloring coloring = {
+  map<TrafficInfo::RoadSegmentId, SpeedGroup> const coloring = {
       {TrafficInfo::RoadSegmentId(0, 0, 0), SpeedGroup::G0},
 
       {TrafficInfo::RoadSegmentId(1, 0, 0), SpeedGroup::G1},
@@ -111,6 +115,85 @@ UNIT_TEST(TrafficInfo_Serialization)
   }
 }
 
+UNIT_TEST(TrafficInfo_ValuesDelta)
+{
+  vector<SpeedGroup> const oldValues = {
+      SpeedGroup::G0,      SpeedGroup::G1, SpeedGroup::G1,        SpeedGroup::Unknown,
+      SpeedGroup::Unknown, SpeedGroup::G5, SpeedGroup::TempBlock, SpeedGroup::G2,
+  };
+
+  vector<SpeedGroup> const newValues = {
+      SpeedGroup::G0, SpeedGroup::G3,      SpeedGroup::G3,      SpeedGroup::G3,
+      SpeedGroup::G3, SpeedGroup::Unknown, SpeedGroup::TempBlock, SpeedGroup::G4,
+  };
+
+  {
+    vector<uint8_t> buf;
+    TrafficInfo::SerializeTrafficValuesDelta(oldValues, newValues, buf);
+
+    auto values = oldValues;
+    TrafficInfo::ApplyTrafficValuesDelta(buf, values);
+    TEST_EQUAL(values, newValues, ());
+  }
+
+  {
+    vector<uint8_t> buf;
+    TrafficInfo::SerializeTrafficValuesDelta(oldValues, oldValues, buf);
+
+    auto values = oldValues;
+    TrafficInfo::ApplyTrafficValuesDelta(buf, values);
+    TEST_EQUAL(values, oldValues, ());
+  }
+
+  {
+    vector<uint8_t> buf;
+    TrafficInfo::SerializeTrafficValuesDelta(oldValues, newValues, buf);
+
+    // The delta doesn't fit other values.
+    vector<SpeedGroup> values = {SpeedGroup::G0, SpeedGroup::G1};
+    TEST_THROW(TrafficInfo::ApplyTrafficValuesDelta(buf, values), Reader::Exception, ());
+    TEST_EQUAL(values, vector<SpeedGroup>({SpeedGroup::G0, SpeedGroup::G1}), ());
+  }
+}
+
+UNIT_TEST(TrafficInfo_MappedKeys)
+{
+  vector<TrafficInfo::RoadSegmentId> const keys = {
+      TrafficInfo::RoadSegmentId(0, 0, 0),
+
+      TrafficInfo::RoadSegmentId(3, 0, 0), TrafficInfo::RoadSegmentId(3, 0, 1),
+      TrafficInfo::RoadSegmentId(3, 1, 0), TrafficInfo::RoadSegmentId(3, 1, 1),
+
+      TrafficInfo::RoadSegmentId(4, 0, 0), TrafficInfo::RoadSegmentId(4, 1, 0),
+      TrafficInfo::RoadSegmentId(4, 2, 0),
+
+      TrafficInfo::RoadSegmentId(100, 0, 0), TrafficInfo::RoadSegmentId(100, 0, 1),
+  };
+
+  vector<uint8_t> buf;
+  TrafficInfo::SerializeMappedTrafficKeys(keys, buf);
+  auto const index = TrafficInfo::MapTrafficKeys(make_unique<CopiedMemoryRegion>(move(buf)));
+  TEST(index, ());
+  TEST_EQUAL(index->GetSize(), keys.size(), ());
+  for (size_t i = 0; i < keys.size(); ++i)
+    TEST_EQUAL(index->Find(keys[i]), i, (keys[i]));
+
+  size_t const kNotFound = TrafficInfo::KeysIndex::kNotFound;
+  TEST_EQUAL(index->Find(TrafficInfo::RoadSegmentId(0, 0, 1)), kNotFound, ());
+  TEST_EQUAL(index->Find(TrafficInfo::RoadSegmentId(0, 1, 0)), kNotFound, ());
+  TEST_EQUAL(index->Find(TrafficInfo::RoadSegmentId(1, 0, 0)), kNotFound, ());
+  TEST_EQUAL(index->Find(TrafficInfo::RoadSegmentId(3, 2, 0)), kNotFound, ());
+  TEST_EQUAL(index->Find(TrafficInfo::RoadSegmentId(4, 0, 1)), kNotFound, ());
+  TEST_EQUAL(index->Find(TrafficInfo::RoadSegmentId(101, 0, 0)), kNotFound, ());
+
+  vector<SpeedGroup> values(keys.size(), SpeedGroup::G5);
+  values[6] = SpeedGroup::G1;
+  TrafficInfo::Coloring const coloring(index, values);
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(4, 1, 0)), SpeedGroup::G1, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(3, 1, 1)), SpeedGroup::G5, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(2, 0, 0)), SpeedGroup::Unknown, ());
+}
+
 UNIT_TEST(TrafficInfo_UpdateTrafficData)
 {
   vector<TrafficInfo::RoadSegmentId> const keys = {
@@ -137,5 +220,61 @@ UNIT_TEST(TrafficInfo_UpdateTrafficData)
   TEST(info.UpdateTrafficData(values2), ());
   for (size_t i = 0; i < keys.size(); ++i)
     TEST_EQUAL(info.GetSpeedGroup(keys[i]), values2[i], ());
+
+  TEST(!info.UpdateTrafficData({SpeedGroup::G0}), ());
+  TEST(info.GetColoring().IsEmpty(), ());
+  TEST_EQUAL(info.GetSpeedGroup(keys[0]), SpeedGroup::Unknown, ());
+}
+
+UNIT_TEST(TrafficInfo_Coloring)
+{
+  TrafficInfo::Coloring const coloring = {
+      {TrafficInfo::RoadSegmentId(5, 1, 1), SpeedGroup::G5},
+      {TrafficInfo::RoadSegmentId(0, 0, 0), SpeedGroup::G0},
+
+      // A one-way feature.
+      {TrafficInfo::RoadSegmentId(1, 0, 0), SpeedGroup::G1},
+      {TrafficInfo::RoadSegmentId(1, 1, 0), SpeedGroup::G2},
+      {TrafficInfo::RoadSegmentId(1, 2, 0), SpeedGroup::G3},
+
+      {TrafficInfo::RoadSegmentId(5, 0, 0), SpeedGroup::G2},
+      {TrafficInfo::RoadSegmentId(5, 0, 1), SpeedGroup::G4},
+      {TrafficInfo::RoadSegmentId(5, 1, 0), SpeedGroup::Unknown},
+
+      // Segments with gaps.
+      {TrafficInfo::RoadSegmentId(7, 3, 1), SpeedGroup::G1},
+      {TrafficInfo::RoadSegmentId(7, 10, 0), SpeedGroup::TempBlock},
+
+      {TrafficInfo::RoadSegmentId(4294967295, 0, 0), SpeedGroup::TempBlock},
+  };
+
+  TEST_EQUAL(coloring.GetSize(), 11, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(0, 0, 0)), SpeedGroup::G0, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(1, 1, 0)), SpeedGroup::G2, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(1, 2, 0)), SpeedGroup::G3, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(5, 0, 1)), SpeedGroup::G4, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(5, 1, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(5, 1, 1)), SpeedGroup::G5, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(7, 3, 1)), SpeedGroup::G1, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(7, 10, 0)), SpeedGroup::TempBlock, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(4294967295, 0, 0)), SpeedGroup::TempBlock,
+             ());
+
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(1, 0, 1)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(1, 3, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(2, 0, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(coloring.Get(TrafficInfo::RoadSegmentId(7, 3, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(TrafficInfo::Coloring().Get(TrafficInfo::RoadSegmentId(0, 0, 0)),
+             SpeedGroup::Unknown, ());
+
+  TrafficInfo::Coloring combined;
+  TrafficInfo::CombineColorings({TrafficInfo::RoadSegmentId(0, 0, 0),
+                                 TrafficInfo::RoadSegmentId(0, 0, 1),
+                                 TrafficInfo::RoadSegmentId(3, 0, 0)},
+                                TrafficInfo::Coloring({{TrafficInfo::RoadSegmentId(3, 0, 0),
+                                                        SpeedGroup::G3}}),
+                                combined);
+  TEST_EQUAL(combined.GetValues(),
+             vector<SpeedGroup>({SpeedGroup::Unknown, SpeedGroup::Unknown, SpeedGroup::G3}), ());
 }
 }  // namespace traffic
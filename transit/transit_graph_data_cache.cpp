@@ -0,0 +1,66 @@
+#include "transit/transit_graph_data_cache.hpp"
+
+#include "coding/file_container.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace routing
+{
+namespace transit
+{
+// static
+GraphDataCache & GraphDataCache::Instance()
+{
+  static GraphDataCache instance;
+  return instance;
+}
+
+shared_ptr<GraphData const> GraphDataCache::Get(MwmSet::MwmId const & mwmId,
+                                                FilesContainerR const & cont)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_data.find(mwmId);
+    if (it != m_data.cend())
+    {
+      if (auto data = it->second.lock())
+        return data;
+    }
+  }
+
+  if (!cont.IsExist(TRANSIT_FILE_TAG))
+    return nullptr;
+
+  // The section is read without the lock, so the sections of different mwms are read in parallel.
+  base::Timer timer;
+  auto data = make_shared<GraphData>();
+  FilesContainerR::TReader reader(cont.GetReader(TRANSIT_FILE_TAG));
+  data->DeserializeAll(*reader.GetPtr());
+  LOG(LINFO, (TRANSIT_FILE_TAG, "section for", mwmId, "loaded in", timer.ElapsedSeconds(),
+              "seconds"));
+
+  lock_guard<mutex> lock(m_mutex);
+  // The data of the deregistered mwms and the data which is not used any more is dropped.
+  for (auto it = m_data.begin(); it != m_data.end();)
+  {
+    if (it->second.expired() || !it->first.IsAlive())
+      it = m_data.erase(it);
+    else
+      ++it;
+  }
+
+  // The section may be read by another thread meanwhile.
+  auto & cached = m_data[mwmId];
+  if (auto other = cached.lock())
+    return other;
+
+  cached = data;
+  return data;
+}
+}  // namespace transit
+}  // namespace routing
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "transit/transit_graph_data.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+class FilesContainerR;
+
+namespace routing
+{
+namespace transit
+{
+/// \brief Transit sections deserialized from the mwms, which are shared between the routers
+/// and the transit rendering. The whole section of an mwm is read once and is kept while
+/// the data is used by someone.
+class GraphDataCache
+{
+public:
+  static GraphDataCache & Instance();
+
+  /// \returns the data of TRANSIT_FILE_TAG section of |cont| of |mwmId| or nullptr
+  /// if there is no section.
+  /// \note The method may be called from any thread.
+  std::shared_ptr<GraphData const> Get(MwmSet::MwmId const & mwmId, FilesContainerR const & cont);
+
+private:
+  GraphDataCache() = default;
+
+  std::mutex m_mutex;
+  std::map<MwmSet::MwmId, std::weak_ptr<GraphData const>> m_data;
+};
+}  // namespace transit
+}  // namespace routing
@@ -0,0 +1,168 @@
+#include "transit/transit_schedule.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace routing
+{
+namespace transit
+{
+uint16_t constexpr Schedule::kLatestVersion;
+uint32_t constexpr Schedule::kInvalidIdx;
+Schedule::Time constexpr Schedule::kInfiniteTime;
+
+Schedule::StopIdx Schedule::AddStop(StopId stopId, m2::PointD const & point)
+{
+  CHECK_NOT_EQUAL(stopId, kInvalidStopId, ());
+  m_isBuilt = false;
+
+  Stop stop;
+  stop.m_id = stopId;
+  stop.m_point = point;
+  m_stops.push_back(stop);
+  return GetNumStops() - 1;
+}
+
+Schedule::PatternIdx Schedule::AddPattern(LineId lineId, vector<StopIdx> const & stops,
+                                          vector<Trip> const & trips)
+{
+  CHECK_GREATER(stops.size(), 1, ("Pattern of line", lineId, "should have two stops at least."));
+  for (StopIdx const stop : stops)
+    CHECK_LESS(stop, GetNumStops(), ());
+
+  for (size_t i = 0; i < trips.size(); ++i)
+  {
+    CheckTrip(trips[i], stops.size());
+    if (i == 0)
+      continue;
+
+    // Trips which don't overtake each other are sorted by times at every stop.
+    for (size_t j = 0; j < stops.size(); ++j)
+    {
+      CHECK_LESS_OR_EQUAL(trips[i - 1][j].m_departure, trips[i][j].m_departure,
+                          ("Trips of line", lineId, "overtake each other or aren't sorted."));
+      CHECK_LESS_OR_EQUAL(trips[i - 1][j].m_arrival, trips[i][j].m_arrival,
+                          ("Trips of line", lineId, "overtake each other or aren't sorted."));
+    }
+  }
+
+  m_isBuilt = false;
+
+  Pattern pattern;
+  pattern.m_lineId = lineId;
+  pattern.m_firstStop = base::asserted_cast<uint32_t>(m_patternStops.size());
+  pattern.m_numStops = base::asserted_cast<uint32_t>(stops.size());
+  pattern.m_firstStopTime = base::asserted_cast<uint32_t>(m_stopTimes.size());
+  pattern.m_numTrips = base::asserted_cast<uint32_t>(trips.size());
+  m_patterns.push_back(pattern);
+
+  m_patternStops.insert(m_patternStops.end(), stops.cbegin(), stops.cend());
+  for (Trip const & trip : trips)
+    m_stopTimes.insert(m_stopTimes.end(), trip.cbegin(), trip.cend());
+
+  return GetNumPatterns() - 1;
+}
+
+void Schedule::AddTransfer(StopIdx from, StopIdx to, Time durationSec)
+{
+  CHECK_LESS(from, GetNumStops(), ());
+  CHECK_LESS(to, GetNumStops(), ());
+  if (from == to)
+    return;
+
+  m_isBuilt = false;
+
+  Transfer transfer;
+  transfer.m_from = from;
+  transfer.m_to = to;
+  transfer.m_durationSec = durationSec;
+  m_transfers.push_back(transfer);
+}
+
+void Schedule::Build()
+{
+  sort(m_transfers.begin(), m_transfers.end());
+  m_transfers.erase(unique(m_transfers.begin(), m_transfers.end(),
+                           [](Transfer const & lhs, Transfer const & rhs) {
+                             return lhs.m_from == rhs.m_from && lhs.m_to == rhs.m_to;
+                           }),
+                    m_transfers.end());
+
+  m_transferOffsets.assign(m_stops.size() + 1, 0);
+  for (Transfer const & transfer : m_transfers)
+    ++m_transferOffsets[transfer.m_from + 1];
+  for (size_t i = 1; i < m_transferOffsets.size(); ++i)
+    m_transferOffsets[i] += m_transferOffsets[i - 1];
+
+  m_stopPatternOffsets.assign(m_stops.size() + 1, 0);
+  for (StopIdx const stop : m_patternStops)
+    ++m_stopPatternOffsets[stop + 1];
+  for (size_t i = 1; i < m_stopPatternOffsets.size(); ++i)
+    m_stopPatternOffsets[i] += m_stopPatternOffsets[i - 1];
+
+  m_stopPatterns.assign(m_patternStops.size(), StopPattern());
+  vector<uint32_t> filled(m_stopPatternOffsets.cbegin(), m_stopPatternOffsets.cend() - 1);
+  for (PatternIdx pattern = 0; pattern < GetNumPatterns(); ++pattern)
+  {
+    for (uint32_t stopPos = 0; stopPos < GetNumPatternStops(pattern); ++stopPos)
+    {
+      StopPattern & stopPattern = m_stopPatterns[filled[GetPatternStop(pattern, stopPos)]++];
+      stopPattern.m_pattern = pattern;
+      stopPattern.m_stopPos = stopPos;
+    }
+  }
+
+  m_stopsById.resize(m_stops.size());
+  for (StopIdx stop = 0; stop < GetNumStops(); ++stop)
+    m_stopsById[stop] = stop;
+  sort(m_stopsById.begin(), m_stopsById.end(),
+       [this](StopIdx lhs, StopIdx rhs) { return m_stops[lhs].m_id < m_stops[rhs].m_id; });
+
+  m_isBuilt = true;
+}
+
+Schedule::StopIdx Schedule::FindStop(StopId stopId) const
+{
+  ASSERT(m_isBuilt, ());
+  auto const it = lower_bound(m_stopsById.cbegin(), m_stopsById.cend(), stopId,
+                              [this](StopIdx stop, StopId id) { return m_stops[stop].m_id < id; });
+  if (it == m_stopsById.cend() || m_stops[*it].m_id != stopId)
+    return kInvalidIdx;
+
+  return *it;
+}
+
+Schedule::TripIdx Schedule::FindEarliestTrip(PatternIdx pattern, uint32_t stopPos,
+                                             Time time) const
+{
+  Pattern const & p = m_patterns[pattern];
+  ASSERT_LESS(stopPos, p.m_numStops, ());
+
+  // Trips are sorted by departure at every stop.
+  TripIdx begin = 0;
+  TripIdx end = p.m_numTrips;
+  while (begin < end)
+  {
+    TripIdx const middle = begin + (end - begin) / 2;
+    if (GetStopTime(pattern, middle, stopPos).m_departure < time)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  return begin == p.m_numTrips ? kInvalidIdx : begin;
+}
+
+// static
+void Schedule::CheckTrip(Trip const & trip, size_t numStops)
+{
+  CHECK_EQUAL(trip.size(), numStops, ());
+  for (size_t i = 0; i < trip.size(); ++i)
+  {
+    CHECK_LESS_OR_EQUAL(trip[i].m_arrival, trip[i].m_departure, (i));
+    if (i != 0)
+      CHECK_LESS_OR_EQUAL(trip[i - 1].m_departure, trip[i].m_arrival, (i));
+  }
+}
+}  // namespace transit
+}  // namespace routing
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "transit/transit_types.hpp"
+
+#include "coding/pointd_to_pointu.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+namespace transit
+{
+// Timetables of transit of one mwm in a layout for round based routing (RAPTOR).
+//
+// Trips which visit the same sequence of stops are grouped to patterns. Trips of a pattern
+// are sorted by departure and don't overtake each other, so the earliest trip which may be
+// boarded at a stop is found with a binary search. Stop times of all the trips are kept in
+// one flat array: trip after trip, stop after stop inside a trip.
+//
+// Time is seconds since the start of the service day. Trips after midnight have times greater
+// than a day.
+class Schedule final
+{
+public:
+  using Time = uint32_t;
+  using StopIdx = uint32_t;
+  using PatternIdx = uint32_t;
+  using TripIdx = uint32_t;
+
+  static uint16_t constexpr kLatestVersion = 0;
+  static uint32_t constexpr kInvalidIdx = std::numeric_limits<uint32_t>::max();
+  static Time constexpr kInfiniteTime = std::numeric_limits<Time>::max();
+
+  struct StopTime
+  {
+    StopTime() = default;
+    StopTime(Time arrival, Time departure) : m_arrival(arrival), m_departure(departure) {}
+
+    bool operator==(StopTime const & rhs) const
+    {
+      return m_arrival == rhs.m_arrival && m_departure == rhs.m_departure;
+    }
+
+    Time m_arrival = 0;
+    Time m_departure = 0;
+  };
+
+  // Trip times at every stop of a pattern.
+  using Trip = std::vector<StopTime>;
+
+  // Returns index of the added stop. Stops are referred by indices in patterns and transfers.
+  StopIdx AddStop(StopId stopId, m2::PointD const & point);
+  // Adds a pattern of |stops| with |trips|. The trips should be sorted by departure and
+  // shouldn't overtake each other.
+  PatternIdx AddPattern(LineId lineId, std::vector<StopIdx> const & stops,
+                        std::vector<Trip> const & trips);
+  // Adds a footpath from |from| stop to |to| stop. Transfers at the same stop are free and
+  // aren't added.
+  void AddTransfer(StopIdx from, StopIdx to, Time durationSec);
+  // Should be called after all the stops, patterns and transfers are added.
+  void Build();
+
+  uint32_t GetNumStops() const { return base::asserted_cast<uint32_t>(m_stops.size()); }
+  uint32_t GetNumPatterns() const { return base::asserted_cast<uint32_t>(m_patterns.size()); }
+  StopId GetStopId(StopIdx stop) const { return m_stops[stop].m_id; }
+  m2::PointD const & GetStopPoint(StopIdx stop) const { return m_stops[stop].m_point; }
+  // Returns kInvalidIdx if there's no such stop.
+  StopIdx FindStop(StopId stopId) const;
+
+  LineId GetLineId(PatternIdx pattern) const { return m_patterns[pattern].m_lineId; }
+  uint32_t GetNumPatternStops(PatternIdx pattern) const { return m_patterns[pattern].m_numStops; }
+  uint32_t GetNumTrips(PatternIdx pattern) const { return m_patterns[pattern].m_numTrips; }
+  StopIdx GetPatternStop(PatternIdx pattern, uint32_t stopPos) const
+  {
+    ASSERT_LESS(stopPos, m_patterns[pattern].m_numStops, ());
+    return m_patternStops[m_patterns[pattern].m_firstStop + stopPos];
+  }
+  StopTime const & GetStopTime(PatternIdx pattern, TripIdx trip, uint32_t stopPos) const
+  {
+    Pattern const & p = m_patterns[pattern];
+    ASSERT_LESS(trip, p.m_numTrips, ());
+    ASSERT_LESS(stopPos, p.m_numStops, ());
+    return m_stopTimes[p.m_firstStopTime + static_cast<size_t>(trip) * p.m_numStops + stopPos];
+  }
+  // Returns the first trip of |pattern| which departs from |stopPos| not earlier than |time|
+  // or kInvalidIdx.
+  TripIdx FindEarliestTrip(PatternIdx pattern, uint32_t stopPos, Time time) const;
+
+  // Calls |fn(pattern, stopPos)| for every pattern which visits |stop|.
+  template <typename Fn>
+  void ForEachPattern(StopIdx stop, Fn && fn) const
+  {
+    ASSERT(m_isBuilt, ());
+    for (uint32_t i = m_stopPatternOffsets[stop]; i < m_stopPatternOffsets[stop + 1]; ++i)
+      fn(m_stopPatterns[i].m_pattern, m_stopPatterns[i].m_stopPos);
+  }
+
+  // Calls |fn(toStop, durationSec)| for every footpath from |stop|.
+  template <typename Fn>
+  void ForEachTransfer(StopIdx stop, Fn && fn) const
+  {
+    ASSERT(m_isBuilt, ());
+    for (uint32_t i = m_transferOffsets[stop]; i < m_transferOffsets[stop + 1]; ++i)
+      fn(m_transfers[i].m_to, m_transfers[i].m_durationSec);
+  }
+
+  // Layout: version, stops, patterns and transfers. Stop ids and coordinates of stops are
+  // varints. Every pattern is line id, stops and trips. Times of a trip are a delta of the
+  // first departure from the first departure of the previous trip and, for every stop,
+  // running time from the previous stop and dwell time. Transfers are sorted by the stop
+  // they start at, the stop is delta coded. All the numbers except version are varints.
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    CHECK(m_isBuilt, ());
+    WriteToSink(sink, kLatestVersion);
+
+    WriteVarUint(sink, GetNumStops());
+    for (Stop const & stop : m_stops)
+    {
+      WriteVarUint(sink, stop.m_id);
+      m2::PointU const point = PointDToPointU(stop.m_point, POINT_COORD_BITS);
+      WriteVarUint(sink, point.x);
+      WriteVarUint(sink, point.y);
+    }
+
+    WriteVarUint(sink, GetNumPatterns());
+    for (PatternIdx pattern = 0; pattern < GetNumPatterns(); ++pattern)
+    {
+      uint32_t const numStops = GetNumPatternStops(pattern);
+      uint32_t const numTrips = GetNumTrips(pattern);
+      WriteVarUint(sink, GetLineId(pattern));
+      WriteVarUint(sink, numStops);
+      for (uint32_t i = 0; i < numStops; ++i)
+        WriteVarUint(sink, GetPatternStop(pattern, i));
+
+      WriteVarUint(sink, numTrips);
+      Time prevFirstDeparture = 0;
+      for (TripIdx trip = 0; trip < numTrips; ++trip)
+      {
+        Time const firstDeparture = GetStopTime(pattern, trip, 0).m_departure;
+        WriteVarUint(sink, firstDeparture - prevFirstDeparture);
+        prevFirstDeparture = firstDeparture;
+
+        Time prevDeparture = firstDeparture;
+        for (uint32_t i = 0; i < numStops; ++i)
+        {
+          StopTime const & stopTime = GetStopTime(pattern, trip, i);
+          // The first stop arrival may be earlier than the first departure.
+          if (i == 0)
+          {
+            WriteVarUint(sink, firstDeparture - stopTime.m_arrival);
+          }
+          else
+          {
+            WriteVarUint(sink, stopTime.m_arrival - prevDeparture);
+            WriteVarUint(sink, stopTime.m_departure - stopTime.m_arrival);
+          }
+          prevDeparture = stopTime.m_departure;
+        }
+      }
+    }
+
+    WriteVarUint(sink, base::asserted_cast<uint32_t>(m_transfers.size()));
+    StopIdx prevFrom = 0;
+    for (Transfer const & transfer : m_transfers)
+    {
+      WriteVarUint(sink, transfer.m_from - prevFrom);
+      WriteVarUint(sink, transfer.m_to);
+      WriteVarUint(sink, transfer.m_durationSec);
+      prevFrom = transfer.m_from;
+    }
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    *this = Schedule();
+
+    m_stops.resize(ReadVarUint<uint32_t>(src));
+    for (Stop & stop : m_stops)
+    {
+      stop.m_id = ReadVarUint<uint64_t>(src);
+      m2::PointU point;
+      point.x = ReadVarUint<uint32_t>(src);
+      point.y = ReadVarUint<uint32_t>(src);
+      stop.m_point = PointUToPointD(point, POINT_COORD_BITS);
+    }
+
+    m_patterns.resize(ReadVarUint<uint32_t>(src));
+    for (Pattern & pattern : m_patterns)
+    {
+      pattern.m_lineId = ReadVarUint<uint32_t>(src);
+      pattern.m_numStops = ReadVarUint<uint32_t>(src);
+      CHECK_GREATER(pattern.m_numStops, 1, ());
+      pattern.m_firstStop = base::asserted_cast<uint32_t>(m_patternStops.size());
+      for (uint32_t i = 0; i < pattern.m_numStops; ++i)
+      {
+        auto const stop = ReadVarUint<uint32_t>(src);
+        CHECK_LESS(stop, GetNumStops(), ());
+        m_patternStops.push_back(stop);
+      }
+
+      pattern.m_numTrips = ReadVarUint<uint32_t>(src);
+      pattern.m_firstStopTime = base::asserted_cast<uint32_t>(m_stopTimes.size());
+      Time firstDeparture = 0;
+      for (TripIdx trip = 0; trip < pattern.m_numTrips; ++trip)
+      {
+        firstDeparture += ReadVarUint<uint32_t>(src);
+        Time prevDeparture = firstDeparture;
+        for (uint32_t i = 0; i < pattern.m_numStops; ++i)
+        {
+          StopTime stopTime;
+          if (i == 0)
+          {
+            stopTime.m_departure = firstDeparture;
+            stopTime.m_arrival = firstDeparture - ReadVarUint<uint32_t>(src);
+          }
+          else
+          {
+            stopTime.m_arrival = prevDeparture + ReadVarUint<uint32_t>(src);
+            stopTime.m_departure = stopTime.m_arrival + ReadVarUint<uint32_t>(src);
+          }
+          prevDeparture = stopTime.m_departure;
+          m_stopTimes.push_back(stopTime);
+        }
+      }
+    }
+
+    m_transfers.resize(ReadVarUint<uint32_t>(src));
+    StopIdx from = 0;
+    for (Transfer & transfer : m_transfers)
+    {
+      from += ReadVarUint<uint32_t>(src);
+      transfer.m_from = from;
+      transfer.m_to = ReadVarUint<uint32_t>(src);
+      transfer.m_durationSec = ReadVarUint<uint32_t>(src);
+      CHECK_LESS(transfer.m_from, GetNumStops(), ());
+      CHECK_LESS(transfer.m_to, GetNumStops(), ());
+    }
+
+    Build();
+  }
+
+private:
+  struct Stop
+  {
+    StopId m_id = kInvalidStopId;
+    m2::PointD m_point;
+  };
+
+  struct Pattern
+  {
+    LineId m_lineId = kInvalidLineId;
+    // Offset of the first stop in |m_patternStops|.
+    uint32_t m_firstStop = 0;
+    uint32_t m_numStops = 0;
+    // Offset of the first stop time of the first trip in |m_stopTimes|.
+    uint32_t m_firstStopTime = 0;
+    uint32_t m_numTrips = 0;
+  };
+
+  struct StopPattern
+  {
+    PatternIdx m_pattern = kInvalidIdx;
+    uint32_t m_stopPos = 0;
+  };
+
+  struct Transfer
+  {
+    bool operator<(Transfer const & rhs) const
+    {
+      if (m_from != rhs.m_from)
+        return m_from < rhs.m_from;
+      return m_to < rhs.m_to;
+    }
+
+    StopIdx m_from = kInvalidIdx;
+    StopIdx m_to = kInvalidIdx;
+    Time m_durationSec = 0;
+  };
+
+  static void CheckTrip(Trip const & trip, size_t numStops);
+
+  std::vector<Stop> m_stops;
+  std::vector<Pattern> m_patterns;
+  std::vector<StopIdx> m_patternStops;
+  std::vector<StopTime> m_stopTimes;
+  // Sorted by |m_from|.
+  std::vector<Transfer> m_transfers;
+
+  // Built by Build(). Transfers and patterns of stop |i| are in ranges
+  // [offsets[i], offsets[i + 1]) of |m_transfers| and |m_stopPatterns|.
+  std::vector<uint32_t> m_transferOffsets;
+  std::vector<StopPattern> m_stopPatterns;
+  std::vector<uint32_t> m_stopPatternOffsets;
+  // Stop indices sorted by stop ids.
+  std::vector<StopIdx> m_stopsById;
+  bool m_isBuilt = false;
+};
+}  // namespace transit
+}  // namespace routing
@@ -0,0 +1,144 @@
+#include "testing/testing.hpp"
+
+#include "transit/transit_schedule.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace routing;
+using namespace routing::transit;
+using namespace std;
+
+namespace
+{
+using Time = Schedule::Time;
+
+Schedule::Trip MakeTrip(vector<pair<Time, Time>> const & times)
+{
+  Schedule::Trip trip;
+  for (auto const & t : times)
+    trip.emplace_back(t.first, t.second);
+  return trip;
+}
+
+// Stops 10, 20, 30 and 40. Line 1 goes 10 -> 20 -> 30 every 10 minutes from 8:00, line 2 goes
+// 40 -> 20. Stops 20 and 40 are connected with a footpath.
+Schedule MakeSchedule()
+{
+  Schedule schedule;
+  auto const s10 = schedule.AddStop(10 /* stopId */, m2::PointD(0.0, 0.0));
+  auto const s20 = schedule.AddStop(20 /* stopId */, m2::PointD(0.01, 0.0));
+  auto const s30 = schedule.AddStop(30 /* stopId */, m2::PointD(0.02, 0.0));
+  auto const s40 = schedule.AddStop(40 /* stopId */, m2::PointD(0.01, 0.01));
+
+  vector<Schedule::Trip> trips;
+  for (Time start = 8 * 3600; start <= 9 * 3600; start += 600)
+  {
+    trips.push_back(
+        MakeTrip({{start - 30, start}, {start + 120, start + 150}, {start + 300, start + 300}}));
+  }
+  schedule.AddPattern(1 /* lineId */, {s10, s20, s30}, trips);
+  schedule.AddPattern(2 /* lineId */, {s40, s20}, {MakeTrip({{100, 100}, {200, 200}})});
+
+  schedule.AddTransfer(s20, s40, 90 /* durationSec */);
+  schedule.AddTransfer(s40, s20, 90 /* durationSec */);
+  // Transfers at the same stop aren't added.
+  schedule.AddTransfer(s20, s20, 10 /* durationSec */);
+  schedule.Build();
+  return schedule;
+}
+
+void TestEqual(Schedule const & lhs, Schedule const & rhs)
+{
+  TEST_EQUAL(lhs.GetNumStops(), rhs.GetNumStops(), ());
+  for (Schedule::StopIdx stop = 0; stop < lhs.GetNumStops(); ++stop)
+  {
+    TEST_EQUAL(lhs.GetStopId(stop), rhs.GetStopId(stop), ());
+    TEST(lhs.GetStopPoint(stop).EqualDxDy(rhs.GetStopPoint(stop), 1e-6), (stop));
+  }
+
+  TEST_EQUAL(lhs.GetNumPatterns(), rhs.GetNumPatterns(), ());
+  for (Schedule::PatternIdx pattern = 0; pattern < lhs.GetNumPatterns(); ++pattern)
+  {
+    TEST_EQUAL(lhs.GetLineId(pattern), rhs.GetLineId(pattern), ());
+    TEST_EQUAL(lhs.GetNumPatternStops(pattern), rhs.GetNumPatternStops(pattern), ());
+    TEST_EQUAL(lhs.GetNumTrips(pattern), rhs.GetNumTrips(pattern), ());
+    for (uint32_t i = 0; i < lhs.GetNumPatternStops(pattern); ++i)
+    {
+      TEST_EQUAL(lhs.GetPatternStop(pattern, i), rhs.GetPatternStop(pattern, i), ());
+      for (Schedule::TripIdx trip = 0; trip < lhs.GetNumTrips(pattern); ++trip)
+        TEST(lhs.GetStopTime(pattern, trip, i) == rhs.GetStopTime(pattern, trip, i), (trip, i));
+    }
+  }
+
+  for (Schedule::StopIdx stop = 0; stop < lhs.GetNumStops(); ++stop)
+  {
+    vector<pair<Schedule::StopIdx, Time>> lhsTransfers;
+    lhs.ForEachTransfer(stop, [&](Schedule::StopIdx to, Time durationSec) {
+      lhsTransfers.emplace_back(to, durationSec);
+    });
+    vector<pair<Schedule::StopIdx, Time>> rhsTransfers;
+    rhs.ForEachTransfer(stop, [&](Schedule::StopIdx to, Time durationSec) {
+      rhsTransfers.emplace_back(to, durationSec);
+    });
+    TEST_EQUAL(lhsTransfers, rhsTransfers, (stop));
+  }
+}
+
+UNIT_TEST(Schedule_Lookups)
+{
+  Schedule const schedule = MakeSchedule();
+  TEST_EQUAL(schedule.GetNumStops(), 4, ());
+  TEST_EQUAL(schedule.GetNumPatterns(), 2, ());
+  TEST_EQUAL(schedule.GetNumTrips(0 /* pattern */), 7, ());
+
+  TEST_EQUAL(schedule.FindStop(30), 2, ());
+  TEST_EQUAL(schedule.FindStop(25), Schedule::kInvalidIdx, ());
+
+  // Departures from stop 20 are at 8:02:30, 8:12:30 and so on.
+  TEST_EQUAL(schedule.FindEarliestTrip(0 /* pattern */, 1 /* stopPos */, 0 /* time */), 0, ());
+  TEST_EQUAL(schedule.FindEarliestTrip(0, 1, 8 * 3600 + 150), 0, ());
+  TEST_EQUAL(schedule.FindEarliestTrip(0, 1, 8 * 3600 + 151), 1, ());
+  TEST_EQUAL(schedule.FindEarliestTrip(0, 1, 9 * 3600 + 151), Schedule::kInvalidIdx, ());
+
+  vector<pair<Schedule::PatternIdx, uint32_t>> patterns;
+  schedule.ForEachPattern(1 /* stop */, [&](Schedule::PatternIdx pattern, uint32_t stopPos) {
+    patterns.emplace_back(pattern, stopPos);
+  });
+  vector<pair<Schedule::PatternIdx, uint32_t>> const expectedPatterns = {{0, 1}, {1, 1}};
+  TEST_EQUAL(patterns, expectedPatterns, ());
+
+  vector<Schedule::StopIdx> transfers;
+  schedule.ForEachTransfer(1 /* stop */, [&](Schedule::StopIdx to, Time durationSec) {
+    TEST_EQUAL(durationSec, 90, ());
+    transfers.push_back(to);
+  });
+  TEST_EQUAL(transfers, vector<Schedule::StopIdx>({3}), ());
+}
+
+UNIT_TEST(Schedule_Serialization)
+{
+  Schedule const schedule = MakeSchedule();
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    schedule.Serialize(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  Schedule deserialized;
+  deserialized.Deserialize(src);
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TestEqual(schedule, deserialized);
+  TEST_EQUAL(deserialized.FindStop(40), 3, ());
+}
+}  // namespace
@@ -18,11 +18,15 @@
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "base/exception.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <limits>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "3party/Alohalytics/src/alohalytics.h"
 #include "3party/jansson/myjansson.hpp"
@@ -35,7 +39,6 @@ namespace
 {
 string const kIndexFileName = "index.json";
 string const kUGCUpdateFileName = "ugc.update.bin";
-string const kTmpFileExtension = ".tmp";
 
 using Sink = MemWriter<string>;
 
@@ -90,12 +93,10 @@ string SerializeIndexes(ugc::UpdateIndexes const & indexes)
   return string(buffer.get());
 }
 
+// Appends |ugc| to the UGC file and fills |index| of it.
 template <typename UGCUpdate>
-ugc::Storage::SettingResult SetGenericUGCUpdate(UGCUpdate const & ugc,
-                                                FeatureType & featureType,
-                                                ugc::UpdateIndexes & indexes,
-                                                size_t & numberOfDeleted,
-                                                ugc::Version const version)
+ugc::Storage::SettingResult WriteUGCUpdate(UGCUpdate const & ugc, FeatureType & featureType,
+                                           ugc::Version const version, ugc::UpdateIndex & index)
 {
   if (!ugc.IsValid())
     return ugc::Storage::SettingResult::InvalidUGC;
@@ -107,17 +108,7 @@ ugc::Storage::SettingResult SetGenericUGCUpdate(UGCUpdate const & ugc,
   CHECK(optMatchingType, ());
   auto const & c = classif();
   auto const type = c.GetIndexForType(th.GetBestType());
-  for (auto & index : indexes)
-  {
-    if (type == index.m_type && mercator == index.m_mercator && !index.m_deleted)
-    {
-      index.m_deleted = true;
-      ++numberOfDeleted;
-      break;
-    }
-  }
 
-  ugc::UpdateIndex index;
   uint64_t offset;
   if (!GetUGCFileSize(offset))
     offset = 0;
@@ -144,13 +135,29 @@ ugc::Storage::SettingResult SetGenericUGCUpdate(UGCUpdate const & ugc,
     return ugc::Storage::SettingResult::WritingError;
   }
 
-  indexes.emplace_back(move(index));
   return ugc::Storage::SettingResult::Success;
 }
 }  // namespace
 
 namespace ugc
 {
+// Storage::FeatureKey -----------------------------------------------------------------------------
+bool Storage::FeatureKey::operator==(FeatureKey const & rhs) const
+{
+  return m_featureId == rhs.m_featureId && m_dataVersion == rhs.m_dataVersion &&
+         m_mwmName == rhs.m_mwmName;
+}
+
+// Storage::FeatureKeyHash -------------------------------------------------------------------------
+size_t Storage::FeatureKeyHash::operator()(FeatureKey const & key) const
+{
+  size_t seed = hash<string>()(key.m_mwmName);
+  seed ^= hash<int64_t>()(key.m_dataVersion) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed ^= hash<uint32_t>()(key.m_featureId) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+// Storage -----------------------------------------------------------------------------------------
 UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
 {
   if (m_indexes.empty())
@@ -187,7 +194,113 @@ UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
 Storage::SettingResult Storage::SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc)
 {
   auto const feature = GetFeature(id);
-  return SetGenericUGCUpdate(ugc, *feature, m_indexes, m_numberOfDeleted, Version::V1);
+  UpdateIndex index;
+  auto const result = WriteUGCUpdate(ugc, *feature, Version::V1, index);
+  if (result == SettingResult::Success)
+    AddIndex(move(index));
+  return result;
+}
+
+void Storage::AddIndex(UpdateIndex && index)
+{
+  // The first index of the same type at the same point is replaced.
+  auto const range = m_placeToIndex.equal_range(make_pair(index.m_type, index.m_mercator.x));
+  auto replaced = m_indexes.size();
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (m_indexes[it->second].m_mercator == index.m_mercator)
+      replaced = min(replaced, it->second);
+  }
+
+  m_indexes.emplace_back(move(index));
+  AddToLookups(m_indexes.size() - 1);
+
+  if (replaced != m_indexes.size() - 1)
+  {
+    RemoveFromLookups(replaced);
+    m_indexes[replaced].m_deleted = true;
+    ++m_numberOfDeleted;
+  }
+}
+
+void Storage::BuildLookups()
+{
+  m_featureToIndex.clear();
+  m_placeToIndex.clear();
+  m_dataVersions.clear();
+  for (size_t i = 0; i < m_indexes.size(); ++i)
+  {
+    if (!m_indexes[i].m_deleted)
+      AddToLookups(i);
+  }
+}
+
+void Storage::AddToLookups(size_t indexPosition)
+{
+  auto const & index = m_indexes[indexPosition];
+  ASSERT(!index.m_deleted, ());
+
+  FeatureKey key;
+  key.m_mwmName = index.m_mwmName;
+  key.m_dataVersion = index.m_dataVersion;
+  key.m_featureId = index.m_featureId;
+  // The last index of a feature is found if the feature has several ones.
+  m_featureToIndex[key] = indexPosition;
+
+  m_placeToIndex.emplace(make_pair(index.m_type, index.m_mercator.x), indexPosition);
+  ++m_dataVersions[make_pair(index.m_mwmName, index.m_dataVersion)];
+}
+
+void Storage::RemoveFromLookups(size_t indexPosition)
+{
+  auto const & index = m_indexes[indexPosition];
+
+  FeatureKey key;
+  key.m_mwmName = index.m_mwmName;
+  key.m_dataVersion = index.m_dataVersion;
+  key.m_featureId = index.m_featureId;
+  auto const feature = m_featureToIndex.find(key);
+  if (feature != m_featureToIndex.end() && feature->second == indexPosition)
+  {
+    m_featureToIndex.erase(feature);
+    // Another index of the feature is found from the end, as AddToLookups() does.
+    for (size_t i = m_indexes.size(); i > 0; --i)
+    {
+      auto const & other = m_indexes[i - 1];
+      if (i - 1 != indexPosition && !other.m_deleted && other.m_featureId == key.m_featureId &&
+          other.m_dataVersion == key.m_dataVersion && other.m_mwmName == key.m_mwmName)
+      {
+        m_featureToIndex[key] = i - 1;
+        break;
+      }
+    }
+  }
+
+  auto const range = m_placeToIndex.equal_range(make_pair(index.m_type, index.m_mercator.x));
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == indexPosition)
+    {
+      m_placeToIndex.erase(it);
+      break;
+    }
+  }
+
+  auto const version = m_dataVersions.find(make_pair(index.m_mwmName, index.m_dataVersion));
+  CHECK(version != m_dataVersions.end(), ());
+  if (--version->second == 0)
+    m_dataVersions.erase(version);
+}
+
+bool Storage::HasOtherDataVersions(string const & mwmName, int64_t dataVersion) const
+{
+  for (auto it = m_dataVersions.lower_bound(make_pair(mwmName, numeric_limits<int64_t>::min()));
+       it != m_dataVersions.end() && it->first.first == mwmName; ++it)
+  {
+    if (it->first.second != dataVersion)
+      return true;
+  }
+  return false;
 }
 
 void Storage::Load()
@@ -234,6 +347,8 @@ void Storage::Load()
 
   if (version && *version != IndexVersion::Latest)
     Migrate(indexFilePath);
+
+  BuildLookups();
 }
 
 void Storage::Migrate(string const & indexFilePath)
@@ -284,6 +399,19 @@ void Storage::Migrate(string const & indexFilePath)
 
 UpdateIndexes::const_iterator Storage::FindIndex(FeatureID const & id) const
 {
+  FeatureKey key;
+  key.m_mwmName = id.GetMwmName();
+  key.m_dataVersion = id.GetMwmVersion();
+  key.m_featureId = id.m_index;
+  auto const it = m_featureToIndex.find(key);
+  if (it != m_featureToIndex.cend())
+    return m_indexes.begin() + it->second;
+
+  // Ids of features may change between data versions, so the indexes of the other versions
+  // of the mwm are found by the type and the center of the feature.
+  if (!HasOtherDataVersions(key.m_mwmName, key.m_dataVersion))
+    return m_indexes.end();
+
   auto const feature = GetFeature(id);
   auto const mercator = feature::GetCenter(*feature);
   feature::TypesHolder th(*feature);
@@ -297,12 +425,20 @@ UpdateIndexes::const_iterator Storage::FindIndex(uint32_t bestType, m2::PointD c
   auto const & c = classif();
   auto const typeIndex = c.GetIndexForType(bestType);
 
-  return find_if(
-    m_indexes.begin(), m_indexes.end(), [typeIndex, &point](UpdateIndex const & index) -> bool {
-      // We are use 1e-5 eps because of points in mwm have this accuracy.
-      return typeIndex == index.m_type && point.EqualDxDy(index.m_mercator, 1e-5 /* eps */) &&
-             !index.m_deleted;
-    });
+  // We are use 1e-5 eps because of points in mwm have this accuracy.
+  double constexpr kEps = 1e-5;
+  // The range of x is wider than eps, so the rounding errors don't matter, the points are
+  // checked exactly below.
+  auto it = m_placeToIndex.lower_bound(make_pair(typeIndex, point.x - 2 * kEps));
+  auto const end = m_placeToIndex.upper_bound(make_pair(typeIndex, point.x + 2 * kEps));
+  // The first matching index is found.
+  auto result = m_indexes.size();
+  for (; it != end; ++it)
+  {
+    if (point.EqualDxDy(m_indexes[it->second].m_mercator, kEps))
+      result = min(result, it->second);
+  }
+  return m_indexes.begin() + result;
 }
 
 bool Storage::SaveIndex(std::string const & pathToTargetFile /* = "" */) const
@@ -338,44 +474,51 @@ void Storage::DefragmentationImpl(bool force)
   if (!force && m_numberOfDeleted < indexesSize / 2)
     return;
 
-  auto const ugcFilePath = GetUGCFilePath();
-  auto const tmpUGCFilePath = ugcFilePath + kTmpFileExtension;
+  // The updates are appended to the file in the order of the indexes, so the updates before
+  // the first deleted one stay in place and only the rest of the file is compacted.
+  auto const firstDeleted = find_if(m_indexes.cbegin(), m_indexes.cend(),
+                                    [](UpdateIndex const & i) { return i.m_deleted; });
+  if (firstDeleted == m_indexes.cend())
+    return;
 
+  auto const first = static_cast<size_t>(distance(m_indexes.cbegin(), firstDeleted));
+  auto const ugcFilePath = GetUGCFilePath();
+  // The offsets are changed only when the file is compacted.
+  vector<uint64_t> offsets(indexesSize);
+  vector<uint8_t> buf;
   try
   {
-    FileReader r(ugcFilePath);
-    FileWriter w(tmpUGCFilePath, FileWriter::Op::OP_APPEND);
-    uint64_t actualOffset = 0;
-    for (size_t i = 0; i < indexesSize; ++i)
     {
-      auto & index = m_indexes[i];
-      if (index.m_deleted)
-        continue;
-
-      auto const offset = index.m_offset;
-      auto const size = static_cast<size_t>(UGCSizeAtIndex(i));
-      vector<uint8_t> buf;
-      buf.resize(size);
-      r.Read(offset, buf.data(), size);
-      w.Write(buf.data(), size);
-      index.m_offset = actualOffset;
-      actualOffset += size;
+      FileReader r(ugcFilePath);
+      for (size_t i = first; i < indexesSize; ++i)
+      {
+        auto const & index = m_indexes[i];
+        if (index.m_deleted)
+          continue;
+
+        auto const size = static_cast<size_t>(UGCSizeAtIndex(i));
+        offsets[i] = firstDeleted->m_offset + buf.size();
+        buf.resize(buf.size() + size);
+        r.Read(index.m_offset, buf.data() + buf.size() - size, size);
+      }
     }
+
+    base::FileData w(ugcFilePath, base::FileData::OP_WRITE_EXISTING);
+    w.Seek(firstDeleted->m_offset);
+    w.Write(buf.data(), buf.size());
+    w.Flush();
+    w.Truncate(firstDeleted->m_offset + buf.size());
   }
-  catch (FileReader::Exception const & exception)
-  {
-    LOG(LERROR, ("Exception while reading file:", ugcFilePath, "reason:", exception.what()));
-    return;
-  }
-  catch (FileWriter::Exception const & exception)
+  catch (RootException const & exception)
   {
-    LOG(LERROR, ("Exception while writing file:", tmpUGCFilePath, "reason:", exception.what()));
+    LOG(LERROR, ("Exception while compacting file:", ugcFilePath, "reason:", exception.what()));
     return;
   }
 
+  for (size_t i = first; i < indexesSize; ++i)
+    m_indexes[i].m_offset = offsets[i];
   base::EraseIf(m_indexes, [](UpdateIndex const & i) -> bool { return i.m_deleted; });
-  CHECK(base::DeleteFileX(ugcFilePath), ());
-  CHECK(base::RenameFileX(tmpUGCFilePath, ugcFilePath), ());
+  BuildLookups();
 
   m_numberOfDeleted = 0;
 }
@@ -517,7 +660,11 @@ Storage::SettingResult Storage::SetUGCUpdateForTesting(FeatureID const & id,
                                                        v0::UGCUpdate const & ugc)
 {
   auto const feature = GetFeature(id);
-  return SetGenericUGCUpdate(ugc, *feature, m_indexes, m_numberOfDeleted, Version::V0);
+  UpdateIndex index;
+  auto const result = WriteUGCUpdate(ugc, *feature, Version::V0, index);
+  if (result == SettingResult::Success)
+    AddIndex(move(index));
+  return result;
 }
 
 void Storage::LoadForTesting(std::string const & testIndexFilePath)
@@ -539,6 +686,8 @@ void Storage::LoadForTesting(std::string const & testIndexFilePath)
 
   if (m_indexes.front().m_version != IndexVersion::Latest)
     Migrate(testIndexFilePath);
+
+  BuildLookups();
 }
 }  // namespace ugc
 
@@ -6,8 +6,13 @@
 
 #include "base/thread_checker.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 class DataSource;
 class FeatureType;
@@ -50,6 +55,31 @@ public:
   void LoadForTesting(std::string const & testIndexFilePath);
 
 private:
+  // Key of the index of a feature in the hash index.
+  struct FeatureKey
+  {
+    bool operator==(FeatureKey const & rhs) const;
+
+    std::string m_mwmName;
+    int64_t m_dataVersion = 0;
+    uint32_t m_featureId = 0;
+  };
+
+  struct FeatureKeyHash
+  {
+    size_t operator()(FeatureKey const & key) const;
+  };
+
+  // Adds the index of a written UGC update, the previous index of the place is marked as deleted.
+  void AddIndex(UpdateIndex && index);
+
+  // Rebuilds the lookups of the indexes after the positions of the indexes are changed.
+  void BuildLookups();
+  void AddToLookups(size_t indexPosition);
+  void RemoveFromLookups(size_t indexPosition);
+  // Returns true if there are indexes of the other data versions of the mwm.
+  bool HasOtherDataVersions(std::string const & mwmName, int64_t dataVersion) const;
+
   void DefragmentationImpl(bool force);
   uint64_t UGCSizeAtIndex(size_t const indexPosition) const;
   std::unique_ptr<FeatureType> GetFeature(FeatureID const & id) const;
@@ -60,6 +90,13 @@ private:
   DataSource const & m_dataSource;
   UpdateIndexes m_indexes;
   size_t m_numberOfDeleted = 0;
+
+  // The lookups contain positions in |m_indexes| of the indexes which are not deleted.
+  std::unordered_map<FeatureKey, size_t, FeatureKeyHash> m_featureToIndex;
+  // Indexes by type and x of the point, for the lookups of places with an eps.
+  std::multimap<std::pair<uint32_t, double>, size_t> m_placeToIndex;
+  // Numbers of indexes by mwm name and data version.
+  std::map<std::pair<std::string, int64_t>, size_t> m_dataVersions;
 };
 
 inline std::string DebugPrint(Storage::SettingResult const & result)
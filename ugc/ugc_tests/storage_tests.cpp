@@ -255,6 +255,48 @@ UNIT_CLASS_TEST(StorageTest, DuplicatesAndDefragmentationSmoke)
   TEST_EQUAL(first, storage.GetUGCUpdate(railwayId), ());
 }
 
+UNIT_CLASS_TEST(StorageTest, DefragmentationOfTail)
+{
+  auto & builder = MwmBuilder::Builder();
+  m2::PointD const cafePoint(1.0, 1.0);
+  m2::PointD const railwayPoint(2.0, 2.0);
+  builder.Build({TestCafe(cafePoint), TestRailway(railwayPoint)});
+  auto const cafeId = builder.FeatureIdForCafeAtPoint(cafePoint);
+  auto const railwayId = builder.FeatureIdForRailwayAtPoint(railwayPoint);
+  auto const first = MakeTestUGCUpdate(Time(chrono::hours(24 * 300)));
+  auto const second = MakeTestUGCUpdate(Time(chrono::hours(24 * 200)));
+  auto const last = MakeTestUGCUpdate(Time(chrono::hours(24 * 100)));
+  Storage storage(builder.GetDataSource());
+  storage.Load();
+  TEST_EQUAL(storage.SetUGCUpdate(railwayId, first), Storage::SettingResult::Success, ());
+  TEST_EQUAL(storage.SetUGCUpdate(cafeId, first), Storage::SettingResult::Success, ());
+  TEST_EQUAL(storage.SetUGCUpdate(cafeId, second), Storage::SettingResult::Success, ());
+  TEST_EQUAL(storage.SetUGCUpdate(cafeId, last), Storage::SettingResult::Success, ());
+  TEST_EQUAL(storage.GetNumberOfDeletedForTesting(), 2, ());
+
+  auto const & indexes = storage.GetIndexesForTesting();
+  auto const railwayOffset = indexes[0].m_offset;
+  auto const cafeOffset = indexes[1].m_offset;
+  storage.Defragmentation();
+  TEST_EQUAL(indexes.size(), 2, ());
+  TEST_EQUAL(storage.GetNumberOfDeletedForTesting(), 0, ());
+  // The updates before the first deleted one are not moved.
+  TEST_EQUAL(indexes[0].m_offset, railwayOffset, ());
+  TEST_EQUAL(indexes[1].m_offset, cafeOffset, ());
+  TEST_EQUAL(first, storage.GetUGCUpdate(railwayId), ());
+  TEST_EQUAL(last, storage.GetUGCUpdate(cafeId), ());
+
+  auto const & c = classif();
+  TEST(storage.HasUGCForPlace(c.GetTypeByReadableObjectName("amenity-cafe"), cafePoint), ());
+  TEST(storage.HasUGCForPlace(c.GetTypeByReadableObjectName("railway-station"), railwayPoint),
+       ());
+  TEST(!storage.HasUGCForPlace(c.GetTypeByReadableObjectName("amenity-cafe"), railwayPoint), ());
+
+  TEST_EQUAL(storage.SetUGCUpdate(cafeId, second), Storage::SettingResult::Success, ());
+  TEST_EQUAL(second, storage.GetUGCUpdate(cafeId), ());
+  TEST_EQUAL(first, storage.GetUGCUpdate(railwayId), ());
+}
+
 UNIT_CLASS_TEST(StorageTest, DifferentTypes)
 {
   auto & builder = MwmBuilder::Builder();